@@ -34,6 +34,7 @@
 #include "core/config/project_settings.h"
 #include "core/donors.gen.h"
 #include "core/license.gen.h"
+#include "core/os/os.h"
 #include "core/version.h"
 #include "core/version_hash.gen.h"
 
@@ -250,6 +251,33 @@ String Engine::get_shader_cache_path() const {
 	return shader_cache_path;
 }
 
+void Engine::startup_profile_step(const String &p_name) {
+	if (!startup_profiling) {
+		return;
+	}
+	// OS ticks start at zero when the engine starts, so the first step includes everything before it.
+	uint64_t ticks = OS::get_singleton()->get_ticks_usec();
+	StartupStep step;
+	step.name = p_name;
+	step.usec = ticks - startup_profile_ticks;
+	startup_steps.push_back(step);
+	startup_profile_ticks = ticks;
+}
+
+void Engine::print_startup_profile() {
+	if (!startup_profiling || startup_steps.is_empty()) {
+		return;
+	}
+	print_line("Startup profile:");
+	uint64_t total = 0;
+	for (int i = 0; i < startup_steps.size(); i++) {
+		print_line(vformat("%10.2f ms  %s", startup_steps[i].usec / 1000.0, startup_steps[i].name));
+		total += startup_steps[i].usec;
+	}
+	print_line(vformat("%10.2f ms  Total", total / 1000.0));
+	startup_steps.clear();
+}
+
 Engine *Engine::singleton = nullptr;
 
 Engine *Engine::get_singleton() {
@@ -71,11 +71,21 @@ private:
 	Map<StringName, Object *> singleton_ptrs;
 
 	bool editor_hint = false;
+	bool visual_processing = true;
 
 	static Engine *singleton;
 
 	String shader_cache_path;
 
+	struct StartupStep {
+		String name;
+		uint64_t usec = 0;
+	};
+
+	bool startup_profiling = false;
+	uint64_t startup_profile_ticks = 0;
+	Vector<StartupStep> startup_steps;
+
 public:
 	static Engine *get_singleton();
 
@@ -123,6 +133,10 @@ public:
 	_FORCE_INLINE_ bool is_editor_hint() const { return false; }
 #endif
 
+	// Disabled when nothing is displayed (e.g. dedicated servers), nodes then skip work that is only needed to be seen.
+	_FORCE_INLINE_ void set_visual_processing_enabled(bool p_enabled) { visual_processing = p_enabled; }
+	_FORCE_INLINE_ bool is_visual_processing_enabled() const { return visual_processing; }
+
 	Dictionary get_version_info() const;
 	Dictionary get_author_info() const;
 	Array get_copyright_info() const;
@@ -133,6 +147,11 @@ public:
 	void set_shader_cache_path(const String &p_path);
 	String get_shader_cache_path() const;
 
+	// Startup profiling (--startup-profile), each step is timed from the end of the previous one.
+	_FORCE_INLINE_ bool is_startup_profiling() const { return startup_profiling; }
+	void startup_profile_step(const String &p_name);
+	void print_startup_profile();
+
 	bool is_abort_on_gpu_errors_enabled() const;
 	bool is_validation_layers_enabled() const;
 
@@ -302,10 +302,13 @@ struct RemoteDebugger::ServersProfiler {
 		}
 		ServerInfo &srv = server_data[name];
 
-		ServerFunctionInfo fi;
-		fi.name = p_data[1];
-		fi.time = p_data[2];
-		srv.functions.push_back(fi);
+		// The name is followed by any amount of function name and time pairs.
+		for (int i = 1; i + 1 < p_data.size(); i += 2) {
+			ServerFunctionInfo fi;
+			fi.name = p_data[i];
+			fi.time = p_data[i + 1];
+			srv.functions.push_back(fi);
+		}
 	}
 
 	void tick(double p_frame_time, double p_idle_time, double p_physics_time, double p_physics_frame_time) {
@@ -0,0 +1,132 @@
+/*************************************************************************/
+/*  trace_zones.cpp                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "trace_zones.h"
+
+#ifdef TRACE_ZONES_ENABLED
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+
+struct TraceZones::ThreadZones {
+	struct Zone {
+		const char *name = nullptr;
+		uint64_t begin = 0;
+		uint64_t end = 0;
+	};
+
+	Thread::ID thread_id = 0;
+	// Only contended while a capture is being saved.
+	Mutex mutex;
+	LocalVector<Zone> zones;
+};
+
+SafeFlag TraceZones::capturing;
+thread_local TraceZones::ThreadZones *TraceZones::thread_zones = nullptr;
+Mutex TraceZones::threads_mutex;
+LocalVector<TraceZones::ThreadZones *> TraceZones::threads;
+
+TraceZones::ThreadZones *TraceZones::_get_thread_zones() {
+	if (unlikely(!thread_zones)) {
+		thread_zones = memnew(ThreadZones);
+		thread_zones->thread_id = Thread::get_caller_id();
+		MutexLock lock(threads_mutex);
+		threads.push_back(thread_zones);
+	}
+	return thread_zones;
+}
+
+uint64_t TraceZones::get_ticks_usec() {
+	return OS::get_singleton()->get_ticks_usec();
+}
+
+void TraceZones::add_zone(const char *p_name, uint64_t p_begin_usec, uint64_t p_end_usec) {
+	ThreadZones *tz = _get_thread_zones();
+	ThreadZones::Zone zone;
+	zone.name = p_name;
+	zone.begin = p_begin_usec;
+	zone.end = p_end_usec;
+	MutexLock lock(tz->mutex);
+	tz->zones.push_back(zone);
+}
+
+void TraceZones::begin_capture() {
+	capturing.set();
+}
+
+Error TraceZones::end_capture(const String &p_path) {
+	if (!capturing.is_set()) {
+		return ERR_UNCONFIGURED;
+	}
+	capturing.clear();
+
+	Error err;
+	FileAccessRef f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Can't open trace zones file for writing: " + p_path);
+
+	f->store_string("{\"traceEvents\":[\n");
+
+	MutexLock lock(threads_mutex);
+	bool first = true;
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		ThreadZones *tz = threads[i];
+		MutexLock zones_lock(tz->mutex);
+
+		String thread_name = tz->thread_id == Thread::get_main_id() ? String("Main thread") : "Thread " + itos(i);
+		f->store_string(vformat("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", first ? "" : ",\n", i, thread_name));
+		first = false;
+
+		for (uint32_t j = 0; j < tz->zones.size(); j++) {
+			const ThreadZones::Zone &zone = tz->zones[j];
+			// Complete events, timestamps and durations are in microseconds.
+			f->store_string(",\n{\"name\":\"" + String(zone.name) + "\",\"ph\":\"X\",\"pid\":0,\"tid\":" + itos(i) + ",\"ts\":" + itos(zone.begin) + ",\"dur\":" + itos(zone.end - zone.begin) + "}");
+		}
+		tz->zones.clear();
+	}
+
+	f->store_string("\n]}\n");
+	f->close();
+
+	return OK;
+}
+
+void TraceZones::finish() {
+	// Only safe once no other thread records zones anymore.
+	capturing.clear();
+	MutexLock lock(threads_mutex);
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		memdelete(threads[i]);
+	}
+	threads.clear();
+	thread_zones = nullptr;
+}
+
+#endif // TRACE_ZONES_ENABLED
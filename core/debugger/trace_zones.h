@@ -0,0 +1,109 @@
+/*************************************************************************/
+/*  trace_zones.h                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TRACE_ZONES_H
+#define TRACE_ZONES_H
+
+#include "core/typedefs.h"
+
+// Scoped timing zones for engine hot paths, only compiled in with `trace_zones=yes`.
+// Zones are recorded per thread while capturing (see `--trace-zones <file>`) and saved
+// as Chrome trace event JSON, which chrome://tracing and Perfetto open directly and
+// Tracy can import with its `import-chrome` tool.
+
+#ifdef TRACE_ZONES_ENABLED
+
+#include "core/os/mutex.h"
+#include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+class TraceZones {
+	struct ThreadZones;
+
+	static SafeFlag capturing;
+	static thread_local ThreadZones *thread_zones;
+	static Mutex threads_mutex;
+	static LocalVector<ThreadZones *> threads;
+
+	static ThreadZones *_get_thread_zones();
+
+public:
+	_FORCE_INLINE_ static bool is_capturing() { return capturing.is_set(); }
+	static uint64_t get_ticks_usec();
+	// The name must be a string literal, only the pointer is kept.
+	static void add_zone(const char *p_name, uint64_t p_begin_usec, uint64_t p_end_usec);
+
+	static void begin_capture();
+	static Error end_capture(const String &p_path);
+	static void finish();
+};
+
+class TraceZoneScope {
+	const char *name;
+	uint64_t begin = 0;
+	bool active;
+
+public:
+	_FORCE_INLINE_ TraceZoneScope(const char *p_name) {
+		name = p_name;
+		active = TraceZones::is_capturing();
+		if (active) {
+			begin = TraceZones::get_ticks_usec();
+		}
+	}
+	_FORCE_INLINE_ ~TraceZoneScope() {
+		if (active) {
+			TraceZones::add_zone(name, begin, TraceZones::get_ticks_usec());
+		}
+	}
+};
+
+#define _TRACE_ZONE_CONCAT_IMPL(m_a, m_b) m_a##m_b
+#define _TRACE_ZONE_CONCAT(m_a, m_b) _TRACE_ZONE_CONCAT_IMPL(m_a, m_b)
+
+// Times the rest of the enclosing scope.
+#define TRACE_ZONE(m_name) TraceZoneScope _TRACE_ZONE_CONCAT(_trace_zone_, __LINE__)(m_name)
+
+// Records an interval that was already measured with OS::get_ticks_usec().
+#define TRACE_ZONE_ADD(m_name, m_begin_usec, m_end_usec)        \
+	if (TraceZones::is_capturing()) {                           \
+		TraceZones::add_zone(m_name, m_begin_usec, m_end_usec); \
+	} else                                                      \
+		((void)0)
+
+#else
+
+#define TRACE_ZONE(m_name)
+#define TRACE_ZONE_ADD(m_name, m_begin_usec, m_end_usec)
+
+#endif // TRACE_ZONES_ENABLED
+
+#endif // TRACE_ZONES_H
@@ -34,6 +34,7 @@
 #include "core/object/class_db.h"
 #include "core/os/memory.h"
 #include "core/variant/variant.h"
+#include "core/variant/variant_internal.h"
 #include "core/version.h"
 
 // Memory Functions
@@ -771,6 +772,69 @@ static GDNativeTypePtr gdnative_packed_vector3_array_operator_index_const(const
 	return (GDNativeTypePtr)&self->ptr()[p_index];
 }
 
+#define PACKED_ARRAY_TYPES              \
+	PACKED_ARRAY_TYPE(BYTE, uint8_t)    \
+	PACKED_ARRAY_TYPE(INT32, int32_t)   \
+	PACKED_ARRAY_TYPE(INT64, int64_t)   \
+	PACKED_ARRAY_TYPE(FLOAT32, float)   \
+	PACKED_ARRAY_TYPE(FLOAT64, double)  \
+	PACKED_ARRAY_TYPE(STRING, String)   \
+	PACKED_ARRAY_TYPE(VECTOR2, Vector2) \
+	PACKED_ARRAY_TYPE(VECTOR3, Vector3) \
+	PACKED_ARRAY_TYPE(COLOR, Color)
+
+static void *gdnative_packed_array_ptrw(GDNativeTypePtr p_self, GDNativeVariantType p_type, GDNativeInt *r_size) {
+	switch (p_type) {
+#define PACKED_ARRAY_TYPE(m_name, m_type)                 \
+	case GDNATIVE_VARIANT_TYPE_PACKED_##m_name##_ARRAY: { \
+		Vector<m_type> *self = (Vector<m_type> *)p_self;  \
+		if (r_size) {                                     \
+			*r_size = self->size();                       \
+		}                                                 \
+		return self->ptrw();                              \
+	}
+		PACKED_ARRAY_TYPES
+#undef PACKED_ARRAY_TYPE
+		default: {
+			ERR_FAIL_V_MSG(nullptr, "Type is not a packed array.");
+		}
+	}
+}
+
+static const void *gdnative_packed_array_ptr(const GDNativeTypePtr p_self, GDNativeVariantType p_type, GDNativeInt *r_size) {
+	switch (p_type) {
+#define PACKED_ARRAY_TYPE(m_name, m_type)                            \
+	case GDNATIVE_VARIANT_TYPE_PACKED_##m_name##_ARRAY: {            \
+		const Vector<m_type> *self = (const Vector<m_type> *)p_self; \
+		if (r_size) {                                                \
+			*r_size = self->size();                                  \
+		}                                                            \
+		return self->ptr();                                          \
+	}
+		PACKED_ARRAY_TYPES
+#undef PACKED_ARRAY_TYPE
+		default: {
+			ERR_FAIL_V_MSG(nullptr, "Type is not a packed array.");
+		}
+	}
+}
+
+static GDNativeInt gdnative_packed_array_resize(GDNativeTypePtr p_self, GDNativeVariantType p_type, GDNativeInt p_size) {
+	switch (p_type) {
+#define PACKED_ARRAY_TYPE(m_name, m_type)                  \
+	case GDNATIVE_VARIANT_TYPE_PACKED_##m_name##_ARRAY: {  \
+		return ((Vector<m_type> *)p_self)->resize(p_size); \
+	}
+		PACKED_ARRAY_TYPES
+#undef PACKED_ARRAY_TYPE
+		default: {
+			ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "Type is not a packed array.");
+		}
+	}
+}
+
+#undef PACKED_ARRAY_TYPES
+
 static GDNativeVariantPtr gdnative_array_operator_index(GDNativeTypePtr p_self, GDNativeInt p_index) {
 	Array *self = (Array *)p_self;
 	ERR_FAIL_INDEX_V(p_index, self->size(), nullptr);
@@ -783,6 +847,75 @@ static GDNativeVariantPtr gdnative_array_operator_index_const(const GDNativeType
 	return (GDNativeTypePtr)&self[p_index];
 }
 
+#define ARRAY_STRUCT_TYPES                      \
+	ARRAY_STRUCT_TYPE(VECTOR2, Vector2)         \
+	ARRAY_STRUCT_TYPE(VECTOR2I, Vector2i)       \
+	ARRAY_STRUCT_TYPE(RECT2, Rect2)             \
+	ARRAY_STRUCT_TYPE(RECT2I, Rect2i)           \
+	ARRAY_STRUCT_TYPE(VECTOR3, Vector3)         \
+	ARRAY_STRUCT_TYPE(VECTOR3I, Vector3i)       \
+	ARRAY_STRUCT_TYPE(TRANSFORM2D, Transform2D) \
+	ARRAY_STRUCT_TYPE(PLANE, Plane)             \
+	ARRAY_STRUCT_TYPE(QUATERNION, Quaternion)   \
+	ARRAY_STRUCT_TYPE(AABB, AABB)               \
+	ARRAY_STRUCT_TYPE(BASIS, Basis)             \
+	ARRAY_STRUCT_TYPE(TRANSFORM3D, Transform3D) \
+	ARRAY_STRUCT_TYPE(COLOR, Color)
+
+template <class T>
+static GDNativeInt _array_get_typed_elements(const Array *p_self, Variant::Type p_type, GDNativeInt p_from, GDNativeInt p_count, T *r_buffer) {
+	for (GDNativeInt i = 0; i < p_count; i++) {
+		const Variant &v = (*p_self)[p_from + i];
+		if (v.get_type() != p_type) {
+			return i;
+		}
+		r_buffer[i] = *VariantGetInternalPtr<T>::get_ptr(&v);
+	}
+	return p_count;
+}
+
+template <class T>
+static GDNativeInt _array_set_typed_elements(Array *p_self, GDNativeInt p_from, GDNativeInt p_count, const T *p_buffer) {
+	for (GDNativeInt i = 0; i < p_count; i++) {
+		p_self->set(p_from + i, p_buffer[i]);
+	}
+	return p_count;
+}
+
+static GDNativeInt gdnative_array_get_typed_elements(const GDNativeTypePtr p_self, GDNativeVariantType p_type, GDNativeInt p_from, GDNativeInt p_count, GDNativeTypePtr r_buffer) {
+	const Array *self = (const Array *)p_self;
+	ERR_FAIL_COND_V(p_from < 0 || p_count < 0 || p_from + p_count > self->size(), 0);
+	switch (p_type) {
+#define ARRAY_STRUCT_TYPE(m_name, m_type)                                                                     \
+	case GDNATIVE_VARIANT_TYPE_##m_name: {                                                                    \
+		return _array_get_typed_elements<m_type>(self, Variant::m_name, p_from, p_count, (m_type *)r_buffer); \
+	}
+		ARRAY_STRUCT_TYPES
+#undef ARRAY_STRUCT_TYPE
+		default: {
+			ERR_FAIL_V_MSG(0, "Type is not a struct type.");
+		}
+	}
+}
+
+static GDNativeInt gdnative_array_set_typed_elements(GDNativeTypePtr p_self, GDNativeVariantType p_type, GDNativeInt p_from, GDNativeInt p_count, const GDNativeTypePtr p_buffer) {
+	Array *self = (Array *)p_self;
+	ERR_FAIL_COND_V(p_from < 0 || p_count < 0 || p_from + p_count > self->size(), 0);
+	switch (p_type) {
+#define ARRAY_STRUCT_TYPE(m_name, m_type)                                                          \
+	case GDNATIVE_VARIANT_TYPE_##m_name: {                                                         \
+		return _array_set_typed_elements<m_type>(self, p_from, p_count, (const m_type *)p_buffer); \
+	}
+		ARRAY_STRUCT_TYPES
+#undef ARRAY_STRUCT_TYPE
+		default: {
+			ERR_FAIL_V_MSG(0, "Type is not a struct type.");
+		}
+	}
+}
+
+#undef ARRAY_STRUCT_TYPES
+
 /* OBJECT API */
 
 static void gdnative_object_method_bind_call(const GDNativeMethodBindPtr p_method_bind, GDNativeObjectPtr p_instance, const GDNativeVariantPtr *p_args, GDNativeInt p_arg_count, GDNativeVariantPtr r_return, GDNativeCallError *r_error) {
@@ -807,6 +940,13 @@ static void gdnative_object_method_bind_ptrcall(const GDNativeMethodBindPtr p_me
 	mb->ptrcall(o, (const void **)p_args, p_ret);
 }
 
+static void gdnative_object_method_bind_ptrcall_batch(const GDNativeMethodBindPtr p_method_bind, const GDNativeObjectPtr *p_instances, const GDNativeTypePtr *const *p_args, GDNativeTypePtr *r_rets, GDNativeInt p_count) {
+	MethodBind *mb = (MethodBind *)p_method_bind;
+	for (GDNativeInt i = 0; i < p_count; i++) {
+		mb->ptrcall((Object *)p_instances[i], (const void **)p_args[i], r_rets ? r_rets[i] : nullptr);
+	}
+}
+
 static void gdnative_object_destroy(GDNativeObjectPtr p_o) {
 	memdelete((Object *)p_o);
 }
@@ -998,13 +1138,20 @@ void gdnative_setup_interface(GDNativeInterface *p_interface) {
 	gdni.packed_vector3_array_operator_index = gdnative_packed_vector3_array_operator_index;
 	gdni.packed_vector3_array_operator_index_const = gdnative_packed_vector3_array_operator_index_const;
 
+	gdni.packed_array_ptrw = gdnative_packed_array_ptrw;
+	gdni.packed_array_ptr = gdnative_packed_array_ptr;
+	gdni.packed_array_resize = gdnative_packed_array_resize;
+
 	gdni.array_operator_index = gdnative_array_operator_index;
 	gdni.array_operator_index_const = gdnative_array_operator_index_const;
+	gdni.array_get_typed_elements = gdnative_array_get_typed_elements;
+	gdni.array_set_typed_elements = gdnative_array_set_typed_elements;
 
 	/* OBJECT */
 
 	gdni.object_method_bind_call = gdnative_object_method_bind_call;
 	gdni.object_method_bind_ptrcall = gdnative_object_method_bind_ptrcall;
+	gdni.object_method_bind_ptrcall_batch = gdnative_object_method_bind_ptrcall_batch;
 	gdni.object_destroy = gdnative_object_destroy;
 	gdni.global_get_singleton = gdnative_global_get_singleton;
 	gdni.object_get_instance_binding = gdnative_object_get_instance_binding;
@@ -414,13 +414,30 @@ typedef struct {
 	GDNativeTypePtr (*packed_vector3_array_operator_index)(GDNativeTypePtr p_self, GDNativeInt p_index); // p_self should be a PackedVector3Array, returns Vector3 ptr
 	GDNativeTypePtr (*packed_vector3_array_operator_index_const)(const GDNativeTypePtr p_self, GDNativeInt p_index); // p_self should be a PackedVector3Array, returns Vector3 ptr
 
+	/*  Bulk packed array access, p_type is the packed array type of p_self.
+	 * - packed_array_ptrw makes the array unique (copy on write) once and returns its first element, so the
+	 *   whole array can be read and written in place without copies. The pointer is invalidated by resizing.
+	 * - r_size can be NULL, otherwise the element count is written to it.
+	 */
+	void *(*packed_array_ptrw)(GDNativeTypePtr p_self, GDNativeVariantType p_type, GDNativeInt *r_size);
+	const void *(*packed_array_ptr)(const GDNativeTypePtr p_self, GDNativeVariantType p_type, GDNativeInt *r_size);
+	GDNativeInt (*packed_array_resize)(GDNativeTypePtr p_self, GDNativeVariantType p_type, GDNativeInt p_size); // returns an Error code
+
 	GDNativeVariantPtr (*array_operator_index)(GDNativeTypePtr p_self, GDNativeInt p_index); // p_self should be an Array ptr
 	GDNativeVariantPtr (*array_operator_index_const)(const GDNativeTypePtr p_self, GDNativeInt p_index); // p_self should be an Array ptr
 
+	/*  Bulk copy of struct elements (Vector2 to Transform3D and Color) between an Array and a contiguous buffer of p_type.
+	 * - Copies p_count elements starting at p_from, returns how many were copied, stops at the first element of another type.
+	 */
+	GDNativeInt (*array_get_typed_elements)(const GDNativeTypePtr p_self, GDNativeVariantType p_type, GDNativeInt p_from, GDNativeInt p_count, GDNativeTypePtr r_buffer);
+	GDNativeInt (*array_set_typed_elements)(GDNativeTypePtr p_self, GDNativeVariantType p_type, GDNativeInt p_from, GDNativeInt p_count, const GDNativeTypePtr p_buffer);
+
 	/* OBJECT */
 
 	void (*object_method_bind_call)(const GDNativeMethodBindPtr p_method_bind, GDNativeObjectPtr p_instance, const GDNativeVariantPtr *p_args, GDNativeInt p_arg_count, GDNativeVariantPtr r_ret, GDNativeCallError *r_error);
 	void (*object_method_bind_ptrcall)(const GDNativeMethodBindPtr p_method_bind, GDNativeObjectPtr p_instance, const GDNativeTypePtr *p_args, GDNativeTypePtr r_ret);
+	/* Calls the method p_count times, call i uses p_instances[i], p_args[i] and r_rets[i] (r_rets can be NULL for methods without return). */
+	void (*object_method_bind_ptrcall_batch)(const GDNativeMethodBindPtr p_method_bind, const GDNativeObjectPtr *p_instances, const GDNativeTypePtr *const *p_args, GDNativeTypePtr *r_rets, GDNativeInt p_count);
 	void (*object_destroy)(GDNativeObjectPtr p_o);
 	GDNativeObjectPtr (*global_get_singleton)(const char *p_name);
 	void *(*object_get_instance_binding)(GDNativeObjectPtr p_o, void *p_token, const GDNativeInstanceBindingCallbacks *p_callbacks);
@@ -821,7 +821,7 @@ void Input::parse_input_event(const Ref<InputEvent> &p_event) {
 	ERR_FAIL_COND(p_event.is_null());
 
 	if (use_accumulated_input) {
-		if (buffered_events.is_empty() || !buffered_events.back()->get()->accumulate(p_event)) {
+		if (buffered_events.is_empty() || !buffered_events[buffered_events.size() - 1]->accumulate(p_event)) {
 			buffered_events.push_back(p_event);
 		}
 	} else if (use_input_buffering) {
@@ -834,10 +834,13 @@ void Input::parse_input_event(const Ref<InputEvent> &p_event) {
 void Input::flush_buffered_events() {
 	_THREAD_SAFE_METHOD_
 
-	while (buffered_events.front()) {
-		_parse_input_event_impl(buffered_events.front()->get(), false);
-		buffered_events.pop_front();
+	// Events parsed meanwhile are appended and handled in this same flush.
+	while (buffered_events_flushed < buffered_events.size()) {
+		Ref<InputEvent> event = buffered_events[buffered_events_flushed++];
+		_parse_input_event_impl(event, false);
 	}
+	buffered_events.clear();
+	buffered_events_flushed = 0;
 }
 
 bool Input::is_using_input_buffering() {
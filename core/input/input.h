@@ -35,6 +35,7 @@
 #include "core/object/object.h"
 #include "core/os/keyboard.h"
 #include "core/os/thread_safe.h"
+#include "core/templates/local_vector.h"
 
 class Input : public Object {
 	GDCLASS(Input, Object);
@@ -214,7 +215,8 @@ private:
 
 	void _parse_input_event_impl(const Ref<InputEvent> &p_event, bool p_is_emulated);
 
-	List<Ref<InputEvent>> buffered_events;
+	LocalVector<Ref<InputEvent>> buffered_events; // Kept allocated between flushes.
+	uint32_t buffered_events_flushed = 0;
 
 	friend class DisplayServer;
 
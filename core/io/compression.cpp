@@ -269,6 +269,212 @@ int Compression::decompress_dynamic(Vector<uint8_t> *p_dst_vect, int p_max_dst_s
 	return Z_OK;
 }
 
+int Compression::compress_with_dictionary(uint8_t *p_dst, const uint8_t *p_src, int p_src_size, const uint8_t *p_dictionary, int p_dictionary_size) {
+	ZSTD_CCtx *cctx = ZSTD_createCCtx();
+	ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, zstd_level);
+	if (zstd_long_distance_matching) {
+		ZSTD_CCtx_setParameter(cctx, ZSTD_c_enableLongDistanceMatching, 1);
+		ZSTD_CCtx_setParameter(cctx, ZSTD_c_windowLog, zstd_window_log_size);
+	}
+	size_t ret = ZSTD_CCtx_loadDictionary(cctx, p_dictionary, p_dictionary_size);
+	if (!ZSTD_isError(ret)) {
+		ret = ZSTD_compress2(cctx, p_dst, get_max_compressed_buffer_size(p_src_size, MODE_ZSTD), p_src, p_src_size);
+	}
+	ZSTD_freeCCtx(cctx);
+	ERR_FAIL_COND_V_MSG(ZSTD_isError(ret), -1, ZSTD_getErrorName(ret));
+	return ret;
+}
+
+int Compression::decompress_with_dictionary(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, const uint8_t *p_dictionary, int p_dictionary_size) {
+	ZSTD_DCtx *dctx = ZSTD_createDCtx();
+	if (zstd_long_distance_matching) {
+		ZSTD_DCtx_setParameter(dctx, ZSTD_d_windowLogMax, zstd_window_log_size);
+	}
+	size_t ret = ZSTD_DCtx_loadDictionary(dctx, p_dictionary, p_dictionary_size);
+	if (!ZSTD_isError(ret)) {
+		ret = ZSTD_decompressDCtx(dctx, p_dst, p_dst_max_size, p_src, p_src_size);
+	}
+	ZSTD_freeDCtx(dctx);
+	ERR_FAIL_COND_V_MSG(ZSTD_isError(ret), -1, ZSTD_getErrorName(ret));
+	return ret;
+}
+
+Error Compression::Stream::_start(Mode p_mode, bool p_compress, const Vector<uint8_t> &p_dictionary) {
+	clear();
+
+	ERR_FAIL_COND_V_MSG(p_mode == MODE_FASTLZ, ERR_UNAVAILABLE, "FastLZ can't be used as a stream.");
+	ERR_FAIL_COND_V_MSG(p_dictionary.size() && p_mode != MODE_ZSTD, ERR_INVALID_PARAMETER, "Dictionaries are only supported by Zstd.");
+
+	mode = p_mode;
+	compressing = p_compress;
+	stream_end = false;
+
+	if (mode == MODE_ZSTD) {
+		size_t ret = 0;
+		if (compressing) {
+			ZSTD_CCtx *cctx = ZSTD_createCCtx();
+			ERR_FAIL_COND_V(!cctx, ERR_OUT_OF_MEMORY);
+			ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, zstd_level);
+			if (zstd_long_distance_matching) {
+				ZSTD_CCtx_setParameter(cctx, ZSTD_c_enableLongDistanceMatching, 1);
+				ZSTD_CCtx_setParameter(cctx, ZSTD_c_windowLog, zstd_window_log_size);
+			}
+			if (p_dictionary.size()) {
+				ret = ZSTD_CCtx_loadDictionary(cctx, p_dictionary.ptr(), p_dictionary.size());
+			}
+			zstd_context = cctx;
+		} else {
+			ZSTD_DCtx *dctx = ZSTD_createDCtx();
+			ERR_FAIL_COND_V(!dctx, ERR_OUT_OF_MEMORY);
+			if (zstd_long_distance_matching) {
+				ZSTD_DCtx_setParameter(dctx, ZSTD_d_windowLogMax, zstd_window_log_size);
+			}
+			if (p_dictionary.size()) {
+				ret = ZSTD_DCtx_loadDictionary(dctx, p_dictionary.ptr(), p_dictionary.size());
+			}
+			zstd_context = dctx;
+		}
+		if (ZSTD_isError(ret)) {
+			clear();
+			ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, ZSTD_getErrorName(ret));
+		}
+		return OK;
+	}
+
+	int window_bits = mode == MODE_DEFLATE ? 15 : 15 + 16;
+
+	z_stream *strm = memnew(z_stream);
+	strm->zalloc = zipio_alloc;
+	strm->zfree = zipio_free;
+	strm->opaque = Z_NULL;
+	strm->avail_in = 0;
+	strm->next_in = Z_NULL;
+
+	int err;
+	if (compressing) {
+		int level = mode == MODE_DEFLATE ? zlib_level : gzip_level;
+		err = deflateInit2(strm, level, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY);
+	} else {
+		err = inflateInit2(strm, window_bits);
+	}
+	if (err != Z_OK) {
+		memdelete(strm);
+		ERR_FAIL_V(FAILED);
+	}
+
+	zlib_stream = strm;
+	return OK;
+}
+
+Error Compression::Stream::_process(const uint8_t *p_src, int p_src_size, Vector<uint8_t> &r_out, bool p_finish) {
+	ERR_FAIL_COND_V_MSG(!is_started(), ERR_UNCONFIGURED, "The stream must be started first.");
+	ERR_FAIL_COND_V(p_src_size < 0, ERR_INVALID_PARAMETER);
+
+	int out_size = r_out.size();
+
+	if (mode == MODE_ZSTD) {
+		ZSTD_inBuffer in = { p_src, (size_t)p_src_size, 0 };
+		int chunk = compressing ? ZSTD_CStreamOutSize() : ZSTD_DStreamOutSize();
+
+		while (true) {
+			r_out.resize(out_size + chunk);
+			ZSTD_outBuffer out = { r_out.ptrw() + out_size, (size_t)chunk, 0 };
+
+			size_t ret;
+			if (compressing) {
+				ret = ZSTD_compressStream2((ZSTD_CCtx *)zstd_context, &out, &in, p_finish ? ZSTD_e_end : ZSTD_e_continue);
+			} else {
+				ret = ZSTD_decompressStream((ZSTD_DCtx *)zstd_context, &out, &in);
+			}
+			out_size += out.pos;
+
+			if (ZSTD_isError(ret)) {
+				r_out.resize(out_size);
+				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, ZSTD_getErrorName(ret));
+			}
+
+			bool done;
+			if (compressing) {
+				// When ending, zero means everything was flushed.
+				done = p_finish ? ret == 0 : in.pos == in.size;
+			} else {
+				// Zero means a frame was completed, more frames may follow.
+				stream_end = ret == 0;
+				done = in.pos == in.size && out.pos < out.size;
+			}
+			if (done) {
+				break;
+			}
+		}
+	} else {
+		z_stream *strm = (z_stream *)zlib_stream;
+		strm->next_in = (Bytef *)p_src;
+		strm->avail_in = p_src_size;
+
+		while (true) {
+			r_out.resize(out_size + gzip_chunk);
+			strm->next_out = r_out.ptrw() + out_size;
+			strm->avail_out = gzip_chunk;
+
+			int err;
+			if (compressing) {
+				err = deflate(strm, p_finish ? Z_FINISH : Z_NO_FLUSH);
+			} else {
+				err = inflate(strm, Z_NO_FLUSH);
+			}
+			out_size += gzip_chunk - strm->avail_out;
+
+			if (err == Z_STREAM_END) {
+				stream_end = true;
+				break;
+			}
+			// Z_BUF_ERROR only means no progress was possible.
+			if (err != Z_OK && err != Z_BUF_ERROR) {
+				r_out.resize(out_size);
+				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, strm->msg ? String(strm->msg) : String("Compression stream error."));
+			}
+			if (strm->avail_in == 0 && strm->avail_out > 0 && !(compressing && p_finish)) {
+				break;
+			}
+		}
+	}
+
+	r_out.resize(out_size);
+	return OK;
+}
+
+Error Compression::Stream::finish(Vector<uint8_t> &r_out) {
+	Error err = OK;
+	if (compressing) {
+		err = _process(nullptr, 0, r_out, true);
+	} else if (is_started() && !stream_end) {
+		err = ERR_FILE_CORRUPT;
+	}
+	clear();
+	return err;
+}
+
+void Compression::Stream::clear() {
+	if (zstd_context) {
+		if (compressing) {
+			ZSTD_freeCCtx((ZSTD_CCtx *)zstd_context);
+		} else {
+			ZSTD_freeDCtx((ZSTD_DCtx *)zstd_context);
+		}
+		zstd_context = nullptr;
+	}
+	if (zlib_stream) {
+		z_stream *strm = (z_stream *)zlib_stream;
+		if (compressing) {
+			deflateEnd(strm);
+		} else {
+			inflateEnd(strm);
+		}
+		memdelete(strm);
+		zlib_stream = nullptr;
+	}
+}
+
 int Compression::zlib_level = Z_DEFAULT_COMPRESSION;
 int Compression::gzip_level = Z_DEFAULT_COMPRESSION;
 int Compression::zstd_level = 3;
@@ -31,6 +31,7 @@
 #ifndef COMPRESSION_H
 #define COMPRESSION_H
 
+#include "core/error/error_list.h"
 #include "core/templates/vector.h"
 #include "core/typedefs.h"
 
@@ -55,6 +56,40 @@ public:
 	static int decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, Mode p_mode = MODE_ZSTD);
 	static int decompress_dynamic(Vector<uint8_t> *p_dst_vect, int p_max_dst_size, const uint8_t *p_src, int p_src_size, Mode p_mode);
 
+	// Zstd with a dictionary, which mostly helps with many small buffers of similar content.
+	// The dictionary can be trained with the zstd tool (zstd --train) or just be sample content,
+	// the same one must be used to decompress.
+	static int compress_with_dictionary(uint8_t *p_dst, const uint8_t *p_src, int p_src_size, const uint8_t *p_dictionary, int p_dictionary_size);
+	static int decompress_with_dictionary(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, const uint8_t *p_dictionary, int p_dictionary_size);
+
+	// Incremental compression or decompression, for data that doesn't fit in one buffer
+	// or arrives in pieces. Supports MODE_DEFLATE, MODE_GZIP and MODE_ZSTD (the only one
+	// taking a dictionary). The output is appended to r_out as it becomes available.
+	class Stream {
+		Mode mode = MODE_ZSTD;
+		bool compressing = false;
+		bool stream_end = false;
+		void *zlib_stream = nullptr;
+		void *zstd_context = nullptr;
+
+		Error _start(Mode p_mode, bool p_compress, const Vector<uint8_t> &p_dictionary);
+		Error _process(const uint8_t *p_src, int p_src_size, Vector<uint8_t> &r_out, bool p_finish);
+
+	public:
+		Error start_compression(Mode p_mode, const Vector<uint8_t> &p_dictionary = Vector<uint8_t>()) { return _start(p_mode, true, p_dictionary); }
+		Error start_decompression(Mode p_mode, const Vector<uint8_t> &p_dictionary = Vector<uint8_t>()) { return _start(p_mode, false, p_dictionary); }
+		bool is_started() const { return zlib_stream || zstd_context; }
+
+		Error process(const uint8_t *p_src, int p_src_size, Vector<uint8_t> &r_out) { return _process(p_src, p_src_size, r_out, false); }
+		// Writes the remaining output and ends the stream. When decompressing, fails with
+		// ERR_FILE_CORRUPT if the data ended early.
+		Error finish(Vector<uint8_t> &r_out);
+		void clear();
+
+		Stream() {}
+		~Stream() { clear(); }
+	};
+
 	Compression() {}
 };
 
@@ -110,6 +110,12 @@ public:
 	virtual real_t get_real() const;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const; ///< get an array of bytes
+	/**
+	 * Zero-copy read: returns the next p_length bytes in place and moves past them, or nullptr
+	 * (without moving) when they can't be accessed directly; use get_buffer() then.
+	 * The data is read-only and stays valid until the file is closed.
+	 */
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const { return nullptr; }
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -30,6 +30,7 @@
 
 #include "file_access_compressed.h"
 
+#include "core/os/worker_thread_pool.h"
 #include "core/string/print_string.h"
 
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
@@ -58,6 +59,66 @@ void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_
 		}                                                   \
 	}
 
+// Blocks are independent, so they are (de)compressed in parallel when there are many.
+// Tasks grab a few at a time as small blocks compress in microseconds.
+#define BLOCK_TASK_BATCH 4
+// Upper bound for the compressed data read at once when decompressing straight into the destination.
+#define MULTI_BLOCK_READ_SIZE (1 << 20)
+
+void FileAccessCompressed::_compress_block(uint32_t p_index, Vector<uint8_t> *p_blocks) {
+	uint32_t bc = (write_max / block_size) + 1;
+	uint32_t bl = p_index == (bc - 1) ? write_max % block_size : block_size;
+
+	Vector<uint8_t> &cblock = p_blocks[p_index];
+	cblock.resize(Compression::get_max_compressed_buffer_size(bl, cmode));
+	int s = Compression::compress(cblock.ptrw(), &write_ptr[(uint64_t)p_index * block_size], bl, cmode);
+	cblock.resize(MAX(s, 0));
+}
+
+void FileAccessCompressed::_decompress_block(uint32_t p_index, const DecompressJob *p_job) const {
+	const ReadBlock &rb = read_blocks[p_job->first_block + p_index];
+	Compression::decompress(p_job->dst + (uint64_t)p_index * block_size, block_size, p_job->src + (rb.offset - p_job->src_offset), rb.csize, cmode);
+}
+
+void FileAccessCompressed::_decompress_blocks(uint32_t p_first, uint32_t p_count, uint8_t *p_dst) const {
+	// Only ever called for full blocks, never the last one.
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+
+	while (p_count > 0) {
+		uint32_t count = 0;
+		uint64_t csize = 0;
+		while (count < p_count && (count == 0 || csize + read_blocks[p_first + count].csize <= MULTI_BLOCK_READ_SIZE)) {
+			csize += read_blocks[p_first + count].csize;
+			count++;
+		}
+
+		// The compressed blocks are contiguous, read them at once.
+		if ((uint64_t)multi_comp_buffer.size() < csize) {
+			multi_comp_buffer.resize(csize);
+		}
+		f->get_buffer(multi_comp_buffer.ptrw(), csize);
+
+		DecompressJob job;
+		job.src = multi_comp_buffer.ptr();
+		job.src_offset = read_blocks[p_first].offset;
+		job.dst = p_dst;
+		job.first_block = p_first;
+
+		if (pool && pool->get_thread_count() > 0 && count > BLOCK_TASK_BATCH) {
+			WorkerThreadPool::GroupID group = pool->add_template_group_task(this, &FileAccessCompressed::_decompress_block, (const DecompressJob *)&job, count, -1, BLOCK_TASK_BATCH);
+			pool->wait_for_group_task_completion(group);
+		} else {
+			for (uint32_t i = 0; i < count; i++) {
+				_decompress_block(i, &job);
+			}
+		}
+
+		p_first += count;
+		p_count -= count;
+		p_dst += (uint64_t)count * block_size;
+	}
+}
+
 Error FileAccessCompressed::open_after_magic(FileAccess *p_base) {
 	f = p_base;
 	cmode = (Compression::Mode)f->get_32();
@@ -154,22 +215,25 @@ void FileAccessCompressed::close() {
 			f->store_32(0); //compressed sizes, will update later
 		}
 
-		Vector<int> block_sizes;
-		for (uint32_t i = 0; i < bc; i++) {
-			uint32_t bl = i == (bc - 1) ? write_max % block_size : block_size;
-			uint8_t *bp = &write_ptr[i * block_size];
-
-			Vector<uint8_t> cblock;
-			cblock.resize(Compression::get_max_compressed_buffer_size(bl, cmode));
-			int s = Compression::compress(cblock.ptrw(), bp, bl, cmode);
+		Vector<Vector<uint8_t>> cblocks;
+		cblocks.resize(bc);
+		WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+		if (pool && pool->get_thread_count() > 0 && bc > BLOCK_TASK_BATCH) {
+			WorkerThreadPool::GroupID group = pool->add_template_group_task(this, &FileAccessCompressed::_compress_block, cblocks.ptrw(), bc, -1, BLOCK_TASK_BATCH);
+			pool->wait_for_group_task_completion(group);
+		} else {
+			for (uint32_t i = 0; i < bc; i++) {
+				_compress_block(i, cblocks.ptrw());
+			}
+		}
 
-			f->store_buffer(cblock.ptr(), s);
-			block_sizes.push_back(s);
+		for (uint32_t i = 0; i < bc; i++) {
+			f->store_buffer(cblocks[i].ptr(), cblocks[i].size());
 		}
 
 		f->seek(16); //ok write block sizes
 		for (uint32_t i = 0; i < bc; i++) {
-			f->store_32(block_sizes[i]);
+			f->store_32(cblocks[i].size());
 		}
 		f->seek_end();
 		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //magic at the end too
@@ -178,6 +242,7 @@ void FileAccessCompressed::close() {
 
 	} else {
 		comp_buffer.clear();
+		multi_comp_buffer.clear();
 		buffer.clear();
 		read_blocks.clear();
 	}
@@ -296,27 +361,43 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 		return 0;
 	}
 
-	for (uint64_t i = 0; i < p_length; i++) {
-		p_dst[i] = read_ptr[read_pos];
-		read_pos++;
-		if (read_pos >= read_block_size) {
-			read_block++;
+	uint64_t dst_pos = 0;
+	while (true) {
+		uint64_t n = MIN(p_length - dst_pos, read_block_size - read_pos);
+		memcpy(p_dst + dst_pos, read_ptr + read_pos, n);
+		dst_pos += n;
+		read_pos += n;
+		if (read_pos < read_block_size) {
+			break;
+		}
 
-			if (read_block < read_block_count) {
-				//read another block of compressed data
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
-				read_pos = 0;
-
-			} else {
-				read_block--;
-				at_end = true;
-				if (i < p_length - 1) {
-					read_eof = true;
-				}
-				return i;
+		uint32_t next = read_block + 1;
+		if (next >= read_block_count) {
+			at_end = true;
+			if (dst_pos < p_length) {
+				read_eof = true;
 			}
+			return dst_pos;
+		}
+
+		// Full blocks covered by the rest of the request skip the block buffer. The last block
+		// always goes through it, so reaching the end is only handled above.
+		uint32_t direct = MIN((p_length - dst_pos) / block_size, (uint64_t)(read_block_count - 1 - next));
+		if (direct > 0) {
+			_decompress_blocks(next, direct, p_dst + dst_pos);
+			dst_pos += (uint64_t)direct * block_size;
+			next += direct;
+		}
+
+		//read another block of compressed data
+		read_block = next;
+		f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
+		Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
+		read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+		read_pos = 0;
+
+		if (dst_pos == p_length) {
+			break;
 		}
 	}
 
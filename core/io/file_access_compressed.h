@@ -61,8 +61,20 @@ class FileAccessCompressed : public FileAccess {
 
 	String magic = "GCMP";
 	mutable Vector<uint8_t> buffer;
+	mutable Vector<uint8_t> multi_comp_buffer;
 	FileAccess *f = nullptr;
 
+	struct DecompressJob {
+		const uint8_t *src = nullptr;
+		uint64_t src_offset = 0;
+		uint8_t *dst = nullptr;
+		uint32_t first_block = 0;
+	};
+
+	void _compress_block(uint32_t p_index, Vector<uint8_t> *p_blocks);
+	void _decompress_block(uint32_t p_index, const DecompressJob *p_job) const;
+	void _decompress_blocks(uint32_t p_first, uint32_t p_count, uint8_t *p_dst) const;
+
 public:
 	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 4096);
 
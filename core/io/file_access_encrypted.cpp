@@ -251,6 +251,19 @@ uint64_t FileAccessEncrypted::get_buffer(uint8_t *p_dst, uint64_t p_length) cons
 	return to_copy;
 }
 
+const uint8_t *FileAccessEncrypted::get_buffer_view(uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(writing, nullptr, "File has not been opened in read mode.");
+
+	// Already decrypted in memory.
+	if (pos > get_length() || p_length > get_length() - pos) {
+		return nullptr;
+	}
+
+	const uint8_t *view = data.ptr() + pos;
+	pos += p_length;
+	return view;
+}
+
 Error FileAccessEncrypted::get_error() const {
 	return eofed ? ERR_FILE_EOF : OK;
 }
@@ -320,6 +320,18 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::get_buffer_view(uint64_t p_length) const {
+	if (eof || pos > pf.size || p_length > pf.size - pos) {
+		return nullptr;
+	}
+
+	const uint8_t *view = f->get_buffer_view(p_length);
+	if (view) {
+		pos += p_length;
+	}
+	return view;
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
 	FileAccess::set_big_endian(p_big_endian);
 	f->set_big_endian(p_big_endian);
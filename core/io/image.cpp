@@ -34,6 +34,7 @@
 #include "core/io/image_loader.h"
 #include "core/io/resource_loader.h"
 #include "core/math/math_funcs.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_map.h"
 
@@ -461,12 +462,60 @@ int Image::get_mipmap_count() const {
 	}
 }
 
+// Images smaller than this (in written bytes) are processed on the calling thread.
+#define IMAGE_THREADED_MIN_BYTES (256 * 1024)
+// Written bytes handed to a worker at a time.
+#define IMAGE_THREADED_BATCH_BYTES (32 * 1024)
+
+struct _ImageRowsJob {
+	void (*func)(void *, uint32_t, uint32_t) = nullptr;
+	void *userdata = nullptr;
+	uint32_t rows = 0;
+	uint32_t batch = 1;
+};
+
+static void _image_rows_task(void *p_userdata, uint32_t p_index) {
+	_ImageRowsJob *job = (_ImageRowsJob *)p_userdata;
+	uint32_t from = p_index * job->batch;
+	job->func(job->userdata, from, MIN(from + job->batch, job->rows));
+}
+
+// Runs p_func over the destination rows [0, p_rows), split in batches over the WorkerThreadPool when the image is large.
+// Rows must be independent of each other.
+static void _image_process_rows(uint32_t p_rows, uint32_t p_row_bytes, void (*p_func)(void *, uint32_t, uint32_t), void *p_userdata) {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (p_rows < 2 || uint64_t(p_rows) * p_row_bytes < IMAGE_THREADED_MIN_BYTES || !pool || pool->get_thread_count() == 0) {
+		p_func(p_userdata, 0, p_rows);
+		return;
+	}
+
+	_ImageRowsJob job;
+	job.func = p_func;
+	job.userdata = p_userdata;
+	job.rows = p_rows;
+	job.batch = MAX(IMAGE_THREADED_BATCH_BYTES / MAX(p_row_bytes, 1u), 1u);
+
+	WorkerThreadPool::GroupID group = pool->add_native_group_task(&_image_rows_task, &job, (p_rows + job.batch - 1) / job.batch);
+	pool->wait_for_group_task_completion(group);
+}
+
+struct _ImageConvertJob {
+	int width = 0;
+	const uint8_t *src = nullptr;
+	uint8_t *dst = nullptr;
+};
+
 //using template generates perfectly optimized code due to constant expression reduction and unused variable removal present in all compilers
 template <uint32_t read_bytes, bool read_alpha, uint32_t write_bytes, bool write_alpha, bool read_gray, bool write_gray>
-static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p_dst) {
+static void _convert_rows(void *p_userdata, uint32_t p_from_y, uint32_t p_to_y) {
+	const _ImageConvertJob *job = (const _ImageConvertJob *)p_userdata;
+	const int p_width = job->width;
+	const uint8_t *p_src = job->src;
+	uint8_t *p_dst = job->dst;
+
 	uint32_t max_bytes = MAX(read_bytes, write_bytes);
 
-	for (int y = 0; y < p_height; y++) {
+	for (int y = p_from_y; y < (int)p_to_y; y++) {
 		for (int x = 0; x < p_width; x++) {
 			const uint8_t *rofs = &p_src[((y * p_width) + x) * (read_bytes + (read_alpha ? 1 : 0))];
 			uint8_t *wofs = &p_dst[((y * p_width) + x) * (write_bytes + (write_alpha ? 1 : 0))];
@@ -503,6 +552,21 @@ static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p
 	}
 }
 
+// Converting in place (p_src == p_dst) is supported as long as pixels don't grow, it's done front to back on the calling thread.
+template <uint32_t read_bytes, bool read_alpha, uint32_t write_bytes, bool write_alpha, bool read_gray, bool write_gray>
+static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p_dst) {
+	_ImageConvertJob job;
+	job.width = p_width;
+	job.src = p_src;
+	job.dst = p_dst;
+
+	if (p_src == p_dst) {
+		_convert_rows<read_bytes, read_alpha, write_bytes, write_alpha, read_gray, write_gray>(&job, 0, p_height);
+	} else {
+		_image_process_rows(p_height, p_width * (write_bytes + (write_alpha ? 1 : 0)), &_convert_rows<read_bytes, read_alpha, write_bytes, write_alpha, read_gray, write_gray>, &job);
+	}
+}
+
 void Image::convert(Format p_new_format) {
 	if (data.size() == 0) {
 		return;
@@ -534,10 +598,15 @@ void Image::convert(Format p_new_format) {
 		return;
 	}
 
-	Image new_img(width, height, false, p_new_format);
+	// Pixels that don't grow are converted in place, which saves allocating a second buffer.
+	const bool in_place = get_format_pixel_size(p_new_format) <= get_format_pixel_size(format);
+	Image new_img;
+	if (!in_place) {
+		new_img.create(width, height, false, p_new_format);
+	}
 
-	const uint8_t *rptr = data.ptr();
-	uint8_t *wptr = new_img.data.ptrw();
+	uint8_t *wptr = in_place ? data.ptrw() : new_img.data.ptrw();
+	const uint8_t *rptr = in_place ? wptr : data.ptr();
 
 	int conversion_type = format | p_new_format << 8;
 
@@ -636,7 +705,13 @@ void Image::convert(Format p_new_format) {
 
 	bool gen_mipmaps = mipmaps;
 
-	_copy_internals_from(new_img);
+	if (in_place) {
+		format = p_new_format;
+		mipmaps = false;
+		data.resize(width * height * get_format_pixel_size(p_new_format));
+	} else {
+		_copy_internals_from(new_img);
+	}
 
 	if (gen_mipmaps) {
 		generate_mipmaps();
@@ -662,7 +737,7 @@ static double _bicubic_interp_kernel(double x) {
 }
 
 template <int CC, class T>
-static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_y, uint32_t p_to_y) {
 	// get source image size
 	int width = p_src_width;
 	int height = p_src_height;
@@ -677,7 +752,7 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 	int xmax = width - 1;
 	// temporary pointer
 
-	for (uint32_t y = 0; y < p_dst_height; y++) {
+	for (uint32_t y = p_from_y; y < p_to_y; y++) {
 		// Y coordinates
 		oy = (double)y * yfac - 0.5f;
 		oy1 = (int)oy;
@@ -749,7 +824,7 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 }
 
 template <int CC, class T>
-static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_y, uint32_t p_to_y) {
 	enum {
 		FRAC_BITS = 8,
 		FRAC_LEN = (1 << FRAC_BITS),
@@ -757,7 +832,7 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 		FRAC_MASK = FRAC_LEN - 1
 	};
 
-	for (uint32_t i = 0; i < p_dst_height; i++) {
+	for (uint32_t i = p_from_y; i < p_to_y; i++) {
 		// Add 0.5 in order to interpolate based on pixel center
 		uint32_t src_yofs_up_fp = (i + 0.5) * p_src_height * FRAC_LEN / p_dst_height;
 		// Calculate nearest src pixel center above current, and truncate to get y index
@@ -839,8 +914,8 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 }
 
 template <int CC, class T>
-static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
-	for (uint32_t i = 0; i < p_dst_height; i++) {
+static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_y, uint32_t p_to_y) {
+	for (uint32_t i = p_from_y; i < p_to_y; i++) {
 		uint32_t src_yofs = i * p_src_height / p_dst_height;
 		uint32_t y_ofs = src_yofs * p_src_width * CC;
 
@@ -859,6 +934,33 @@ static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict
 	}
 }
 
+struct _ImageScaleJob {
+	const uint8_t *src = nullptr;
+	uint8_t *dst = nullptr;
+	uint32_t src_width = 0;
+	uint32_t src_height = 0;
+	uint32_t dst_width = 0;
+	uint32_t dst_height = 0;
+};
+
+template <void (*scale_func)(const uint8_t *, uint8_t *, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t)>
+static void _scale_rows(void *p_userdata, uint32_t p_from_y, uint32_t p_to_y) {
+	const _ImageScaleJob *job = (const _ImageScaleJob *)p_userdata;
+	scale_func(job->src, job->dst, job->src_width, job->src_height, job->dst_width, job->dst_height, p_from_y, p_to_y);
+}
+
+template <int CC, class T, void (*scale_func)(const uint8_t *, uint8_t *, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t)>
+static void _scale_threaded(const uint8_t *p_src, uint8_t *p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+	_ImageScaleJob job;
+	job.src = p_src;
+	job.dst = p_dst;
+	job.src_width = p_src_width;
+	job.src_height = p_src_height;
+	job.dst_width = p_dst_width;
+	job.dst_height = p_dst_height;
+	_image_process_rows(p_dst_height, p_dst_width * CC * sizeof(T), &_scale_rows<scale_func>, &job);
+}
+
 #define LANCZOS_TYPE 3
 
 static float _lanczos(float p_x) {
@@ -1066,47 +1168,47 @@ void Image::resize(int p_width, int p_height, Interpolation p_interpolation) {
 			if (format >= FORMAT_L8 && format <= FORMAT_RGBA8) {
 				switch (get_format_pixel_size(format)) {
 					case 1:
-						_scale_nearest<1, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<1, uint8_t, _scale_nearest<1, uint8_t>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 					case 2:
-						_scale_nearest<2, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<2, uint8_t, _scale_nearest<2, uint8_t>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 					case 3:
-						_scale_nearest<3, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<3, uint8_t, _scale_nearest<3, uint8_t>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 					case 4:
-						_scale_nearest<4, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<4, uint8_t, _scale_nearest<4, uint8_t>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 				}
 			} else if (format >= FORMAT_RF && format <= FORMAT_RGBAF) {
 				switch (get_format_pixel_size(format)) {
 					case 4:
-						_scale_nearest<1, float>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<1, float, _scale_nearest<1, float>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 					case 8:
-						_scale_nearest<2, float>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<2, float, _scale_nearest<2, float>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 					case 12:
-						_scale_nearest<3, float>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<3, float, _scale_nearest<3, float>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 					case 16:
-						_scale_nearest<4, float>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<4, float, _scale_nearest<4, float>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 				}
 
 			} else if (format >= FORMAT_RH && format <= FORMAT_RGBAH) {
 				switch (get_format_pixel_size(format)) {
 					case 2:
-						_scale_nearest<1, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<1, uint16_t, _scale_nearest<1, uint16_t>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 					case 4:
-						_scale_nearest<2, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<2, uint16_t, _scale_nearest<2, uint16_t>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 					case 6:
-						_scale_nearest<3, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<3, uint16_t, _scale_nearest<3, uint16_t>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 					case 8:
-						_scale_nearest<4, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<4, uint16_t, _scale_nearest<4, uint16_t>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 				}
 			}
@@ -1153,46 +1255,46 @@ void Image::resize(int p_width, int p_height, Interpolation p_interpolation) {
 				if (format >= FORMAT_L8 && format <= FORMAT_RGBA8) {
 					switch (get_format_pixel_size(format)) {
 						case 1:
-							_scale_bilinear<1, uint8_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
+							_scale_threaded<1, uint8_t, _scale_bilinear<1, uint8_t>>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
 							break;
 						case 2:
-							_scale_bilinear<2, uint8_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
+							_scale_threaded<2, uint8_t, _scale_bilinear<2, uint8_t>>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
 							break;
 						case 3:
-							_scale_bilinear<3, uint8_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
+							_scale_threaded<3, uint8_t, _scale_bilinear<3, uint8_t>>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
 							break;
 						case 4:
-							_scale_bilinear<4, uint8_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
+							_scale_threaded<4, uint8_t, _scale_bilinear<4, uint8_t>>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
 							break;
 					}
 				} else if (format >= FORMAT_RF && format <= FORMAT_RGBAF) {
 					switch (get_format_pixel_size(format)) {
 						case 4:
-							_scale_bilinear<1, float>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
+							_scale_threaded<1, float, _scale_bilinear<1, float>>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
 							break;
 						case 8:
-							_scale_bilinear<2, float>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
+							_scale_threaded<2, float, _scale_bilinear<2, float>>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
 							break;
 						case 12:
-							_scale_bilinear<3, float>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
+							_scale_threaded<3, float, _scale_bilinear<3, float>>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
 							break;
 						case 16:
-							_scale_bilinear<4, float>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
+							_scale_threaded<4, float, _scale_bilinear<4, float>>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
 							break;
 					}
 				} else if (format >= FORMAT_RH && format <= FORMAT_RGBAH) {
 					switch (get_format_pixel_size(format)) {
 						case 2:
-							_scale_bilinear<1, uint16_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
+							_scale_threaded<1, uint16_t, _scale_bilinear<1, uint16_t>>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
 							break;
 						case 4:
-							_scale_bilinear<2, uint16_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
+							_scale_threaded<2, uint16_t, _scale_bilinear<2, uint16_t>>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
 							break;
 						case 6:
-							_scale_bilinear<3, uint16_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
+							_scale_threaded<3, uint16_t, _scale_bilinear<3, uint16_t>>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
 							break;
 						case 8:
-							_scale_bilinear<4, uint16_t>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
+							_scale_threaded<4, uint16_t, _scale_bilinear<4, uint16_t>>(src_ptr, w_ptr, src_width, src_height, p_width, p_height);
 							break;
 					}
 				}
@@ -1209,46 +1311,46 @@ void Image::resize(int p_width, int p_height, Interpolation p_interpolation) {
 			if (format >= FORMAT_L8 && format <= FORMAT_RGBA8) {
 				switch (get_format_pixel_size(format)) {
 					case 1:
-						_scale_cubic<1, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<1, uint8_t, _scale_cubic<1, uint8_t>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 					case 2:
-						_scale_cubic<2, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<2, uint8_t, _scale_cubic<2, uint8_t>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 					case 3:
-						_scale_cubic<3, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<3, uint8_t, _scale_cubic<3, uint8_t>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 					case 4:
-						_scale_cubic<4, uint8_t>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<4, uint8_t, _scale_cubic<4, uint8_t>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 				}
 			} else if (format >= FORMAT_RF && format <= FORMAT_RGBAF) {
 				switch (get_format_pixel_size(format)) {
 					case 4:
-						_scale_cubic<1, float>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<1, float, _scale_cubic<1, float>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 					case 8:
-						_scale_cubic<2, float>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<2, float, _scale_cubic<2, float>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 					case 12:
-						_scale_cubic<3, float>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<3, float, _scale_cubic<3, float>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 					case 16:
-						_scale_cubic<4, float>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<4, float, _scale_cubic<4, float>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 				}
 			} else if (format >= FORMAT_RH && format <= FORMAT_RGBAH) {
 				switch (get_format_pixel_size(format)) {
 					case 2:
-						_scale_cubic<1, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<1, uint16_t, _scale_cubic<1, uint16_t>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 					case 4:
-						_scale_cubic<2, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<2, uint16_t, _scale_cubic<2, uint16_t>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 					case 6:
-						_scale_cubic<3, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<3, uint16_t, _scale_cubic<3, uint16_t>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 					case 8:
-						_scale_cubic<4, uint16_t>(r_ptr, w_ptr, width, height, p_width, p_height);
+						_scale_threaded<4, uint16_t, _scale_cubic<4, uint16_t>>(r_ptr, w_ptr, width, height, p_width, p_height);
 						break;
 				}
 			}
@@ -1499,15 +1601,20 @@ bool Image::_can_modify(Format p_format) const {
 template <class Component, int CC, bool renormalize,
 		void (*average_func)(Component &, const Component &, const Component &, const Component &, const Component &),
 		void (*renormalize_func)(Component *)>
-static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint32_t p_width, uint32_t p_height) {
+static void _generate_po2_mipmap_rows(void *p_userdata, uint32_t p_from_row, uint32_t p_to_row) {
+	const _ImageScaleJob *job = (const _ImageScaleJob *)p_userdata;
+	const Component *p_src = (const Component *)job->src;
+	Component *p_dst = (Component *)job->dst;
+	const uint32_t p_width = job->src_width;
+	const uint32_t p_height = job->src_height;
+
 	//fast power of 2 mipmap generation
 	uint32_t dst_w = MAX(p_width >> 1, 1);
-	uint32_t dst_h = MAX(p_height >> 1, 1);
 
 	int right_step = (p_width == 1) ? 0 : CC;
 	int down_step = (p_height == 1) ? 0 : (p_width * CC);
 
-	for (uint32_t i = 0; i < dst_h; i++) {
+	for (uint32_t i = p_from_row; i < p_to_row; i++) {
 		const Component *rup_ptr = &p_src[i * 2 * down_step];
 		const Component *rdown_ptr = rup_ptr + down_step;
 		Component *dst_ptr = &p_dst[i * dst_w * CC];
@@ -1530,6 +1637,20 @@ static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint3
 	}
 }
 
+template <class Component, int CC, bool renormalize,
+		void (*average_func)(Component &, const Component &, const Component &, const Component &, const Component &),
+		void (*renormalize_func)(Component *)>
+static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint32_t p_width, uint32_t p_height) {
+	_ImageScaleJob job;
+	job.src = (const uint8_t *)p_src;
+	job.dst = (uint8_t *)p_dst;
+	job.src_width = p_width;
+	job.src_height = p_height;
+	job.dst_width = MAX(p_width >> 1, 1);
+	job.dst_height = MAX(p_height >> 1, 1);
+	_image_process_rows(job.dst_height, job.dst_width * CC * sizeof(Component), &_generate_po2_mipmap_rows<Component, CC, renormalize, average_func, renormalize_func>, &job);
+}
+
 void Image::shrink_x2() {
 	ERR_FAIL_COND(data.size() == 0);
 
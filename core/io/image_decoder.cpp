@@ -0,0 +1,194 @@
+/*************************************************************************/
+/*  image_decoder.cpp                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "image_decoder.h"
+
+#include "core/io/image_loader.h"
+
+static ImageMemLoadFunc _recognize_buffer(const uint8_t *p_data, int p_size) {
+	if (p_size >= 8 && memcmp(p_data, "\x89PNG\r\n\x1a\n", 8) == 0) {
+		return Image::_png_mem_loader_func;
+	}
+	if (p_size >= 3 && p_data[0] == 0xFF && p_data[1] == 0xD8 && p_data[2] == 0xFF) {
+		return Image::_jpg_mem_loader_func;
+	}
+	if (p_size >= 12 && memcmp(p_data, "RIFF", 4) == 0 && memcmp(p_data + 8, "WEBP", 4) == 0) {
+		return Image::_webp_mem_loader_func;
+	}
+	return nullptr;
+}
+
+Error ImageDecoder::_start(Image::Format p_format, bool p_mipmaps, int p_max_size) {
+	format = p_format;
+	mipmaps = p_mipmaps;
+	max_size = p_max_size;
+	image.unref();
+	error = OK;
+	decode_serial++;
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (pool->get_thread_count() == 0) {
+		// Nothing would run the task until it's waited for, just decode now.
+		_decode(nullptr);
+		return OK;
+	}
+
+	task = pool->add_template_task(this, &ImageDecoder::_decode, nullptr);
+	return OK;
+}
+
+void ImageDecoder::_decode(void *p_userdata) {
+	Ref<Image> decoded;
+	decoded.instantiate();
+	Error err = OK;
+
+	if (!path.is_empty()) {
+		err = ImageLoader::load_image(path, decoded);
+	} else {
+		ImageMemLoadFunc loader = _recognize_buffer(buffer.ptr(), buffer.size());
+		if (!loader) {
+			err = ERR_FILE_UNRECOGNIZED;
+		} else {
+			decoded = loader(buffer.ptr(), buffer.size());
+			if (decoded.is_null() || decoded->is_empty()) {
+				err = ERR_FILE_CORRUPT;
+			}
+		}
+	}
+
+	// The source isn't needed anymore, don't keep it around with the image.
+	buffer.clear();
+
+	if (err == OK) {
+		// Shrink first, there is less to convert and mipmap afterwards.
+		int width = decoded->get_width();
+		int height = decoded->get_height();
+		if (max_size > 0 && (width > max_size || height > max_size) && !decoded->is_compressed()) {
+			float scale = float(max_size) / MAX(width, height);
+			decoded->resize(MAX(1, int(width * scale)), MAX(1, int(height * scale)), Image::INTERPOLATE_BILINEAR);
+		}
+		if (format != Image::FORMAT_MAX && decoded->get_format() != format) {
+			decoded->convert(format);
+		}
+		if (mipmaps && !decoded->has_mipmaps()) {
+			decoded->generate_mipmaps();
+		}
+		image = decoded;
+	}
+	error = err;
+
+	call_deferred(SNAME("_decode_completed"), decode_serial);
+}
+
+void ImageDecoder::_decode_completed(uint32_t p_serial) {
+	if (p_serial != decode_serial) {
+		return; // A new decode started after this one was already waited for.
+	}
+
+	_wait();
+	emit_signal(SNAME("completed"));
+}
+
+void ImageDecoder::_wait() {
+	if (task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+		task = WorkerThreadPool::INVALID_TASK_ID;
+	}
+}
+
+Error ImageDecoder::decode_buffer(const Vector<uint8_t> &p_buffer, Image::Format p_format, bool p_mipmaps, int p_max_size) {
+	ERR_FAIL_COND_V_MSG(is_decoding(), ERR_BUSY, "An image is already being decoded, wait for it to complete first.");
+	ERR_FAIL_COND_V(p_buffer.is_empty(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(p_format < 0 || (p_format > Image::FORMAT_RGBE9995 && p_format != Image::FORMAT_MAX), ERR_INVALID_PARAMETER, "Images can only be decoded to uncompressed formats.");
+	ERR_FAIL_COND_V(p_max_size < 0, ERR_INVALID_PARAMETER);
+
+	buffer = p_buffer;
+	path = String();
+	return _start(p_format, p_mipmaps, p_max_size);
+}
+
+Error ImageDecoder::decode_file(const String &p_path, Image::Format p_format, bool p_mipmaps, int p_max_size) {
+	ERR_FAIL_COND_V_MSG(is_decoding(), ERR_BUSY, "An image is already being decoded, wait for it to complete first.");
+	ERR_FAIL_COND_V(p_path.is_empty(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(p_format < 0 || (p_format > Image::FORMAT_RGBE9995 && p_format != Image::FORMAT_MAX), ERR_INVALID_PARAMETER, "Images can only be decoded to uncompressed formats.");
+	ERR_FAIL_COND_V(p_max_size < 0, ERR_INVALID_PARAMETER);
+
+	buffer.clear();
+	path = p_path;
+	return _start(p_format, p_mipmaps, p_max_size);
+}
+
+bool ImageDecoder::is_decoding() const {
+	return task != WorkerThreadPool::INVALID_TASK_ID;
+}
+
+bool ImageDecoder::is_completed() {
+	if (task == WorkerThreadPool::INVALID_TASK_ID) {
+		return true;
+	}
+	if (!WorkerThreadPool::get_singleton()->is_task_completed(task)) {
+		return false;
+	}
+	_wait();
+	return true;
+}
+
+Error ImageDecoder::wait() {
+	_wait();
+	return error;
+}
+
+Ref<Image> ImageDecoder::get_image() {
+	_wait();
+	return image;
+}
+
+Error ImageDecoder::get_error() {
+	_wait();
+	return error;
+}
+
+void ImageDecoder::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("decode_buffer", "buffer", "format", "mipmaps", "max_size"), &ImageDecoder::decode_buffer, DEFVAL(Image::FORMAT_MAX), DEFVAL(false), DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("decode_file", "path", "format", "mipmaps", "max_size"), &ImageDecoder::decode_file, DEFVAL(Image::FORMAT_MAX), DEFVAL(false), DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("is_decoding"), &ImageDecoder::is_decoding);
+	ClassDB::bind_method(D_METHOD("is_completed"), &ImageDecoder::is_completed);
+	ClassDB::bind_method(D_METHOD("wait"), &ImageDecoder::wait);
+	ClassDB::bind_method(D_METHOD("get_image"), &ImageDecoder::get_image);
+	ClassDB::bind_method(D_METHOD("get_error"), &ImageDecoder::get_error);
+
+	ClassDB::bind_method(D_METHOD("_decode_completed"), &ImageDecoder::_decode_completed);
+
+	ADD_SIGNAL(MethodInfo("completed"));
+}
+
+ImageDecoder::~ImageDecoder() {
+	_wait();
+}
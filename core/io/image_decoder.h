@@ -0,0 +1,77 @@
+/*************************************************************************/
+/*  image_decoder.h                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef IMAGE_DECODER_H
+#define IMAGE_DECODER_H
+
+#include "core/io/image.h"
+#include "core/object/ref_counted.h"
+#include "core/os/worker_thread_pool.h"
+
+// Decodes an image on the WorkerThreadPool, then brings it to its final format, size and mipmaps on the same
+// worker, so the result can be handed to the renderer without further processing on the calling thread.
+class ImageDecoder : public RefCounted {
+	GDCLASS(ImageDecoder, RefCounted);
+
+	Vector<uint8_t> buffer;
+	String path;
+	Image::Format format = Image::FORMAT_MAX;
+	bool mipmaps = false;
+	int max_size = 0;
+
+	Ref<Image> image;
+	Error error = OK;
+
+	WorkerThreadPool::TaskID task = WorkerThreadPool::INVALID_TASK_ID;
+	uint32_t decode_serial = 0;
+
+	Error _start(Image::Format p_format, bool p_mipmaps, int p_max_size);
+	void _decode(void *p_userdata);
+	void _decode_completed(uint32_t p_serial);
+	void _wait();
+
+protected:
+	static void _bind_methods();
+
+public:
+	Error decode_buffer(const Vector<uint8_t> &p_buffer, Image::Format p_format = Image::FORMAT_MAX, bool p_mipmaps = false, int p_max_size = 0);
+	Error decode_file(const String &p_path, Image::Format p_format = Image::FORMAT_MAX, bool p_mipmaps = false, int p_max_size = 0);
+
+	bool is_decoding() const;
+	bool is_completed();
+	Error wait();
+
+	Ref<Image> get_image();
+	Error get_error();
+
+	~ImageDecoder();
+};
+
+#endif // IMAGE_DECODER_H
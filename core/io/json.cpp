@@ -30,6 +30,7 @@
 
 #include "json.h"
 
+#include "core/io/file_access.h"
 #include "core/string/print_string.h"
 
 const char *JSON::tk_name[TK_MAX] = {
@@ -45,73 +46,82 @@ const char *JSON::tk_name[TK_MAX] = {
 	"EOF",
 };
 
-String JSON::_make_indent(const String &p_indent, int p_size) {
-	String indent_text = "";
+void JSON::Writer::flush() {
+	if (file && !buffer.is_empty()) {
+		file->store_string(buffer);
+		buffer.resize(0);
+	}
+}
+
+void JSON::_append_indent(Writer &r_writer, const String &p_indent, int p_size) {
 	if (!p_indent.is_empty()) {
 		for (int i = 0; i < p_size; i++) {
-			indent_text += p_indent;
+			r_writer.append(p_indent);
 		}
 	}
-	return indent_text;
 }
 
-String JSON::_stringify(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, Set<const void *> &p_markers, bool p_full_precision) {
-	String colon = ":";
-	String end_statement = "";
-
-	if (!p_indent.is_empty()) {
-		colon += " ";
-		end_statement += "\n";
-	}
+void JSON::_stringify(Writer &r_writer, const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, Set<const void *> &p_markers, bool p_full_precision) {
+	const char *colon = p_indent.is_empty() ? ":" : ": ";
+	const char *end_statement = p_indent.is_empty() ? "" : "\n";
 
 	switch (p_var.get_type()) {
-		case Variant::NIL:
-			return "null";
-		case Variant::BOOL:
-			return p_var.operator bool() ? "true" : "false";
-		case Variant::INT:
-			return itos(p_var);
+		case Variant::NIL: {
+			r_writer.append("null");
+		} break;
+		case Variant::BOOL: {
+			r_writer.append(p_var.operator bool() ? "true" : "false");
+		} break;
+		case Variant::INT: {
+			r_writer.append(itos(p_var));
+		} break;
 		case Variant::FLOAT: {
 			double num = p_var;
 			if (p_full_precision) {
 				// Store unreliable digits (17) instead of just reliable
 				// digits (14) so that the value can be decoded exactly.
-				return String::num(num, 17 - (int)floor(log10(num)));
+				r_writer.append(String::num(num, 17 - (int)floor(log10(num))));
 			} else {
 				// Store only reliable digits (14) by default.
-				return String::num(num, 14 - (int)floor(log10(num)));
+				r_writer.append(String::num(num, 14 - (int)floor(log10(num))));
 			}
-		}
+		} break;
 		case Variant::PACKED_INT32_ARRAY:
 		case Variant::PACKED_INT64_ARRAY:
 		case Variant::PACKED_FLOAT32_ARRAY:
 		case Variant::PACKED_FLOAT64_ARRAY:
 		case Variant::PACKED_STRING_ARRAY:
 		case Variant::ARRAY: {
-			String s = "[";
-			s += end_statement;
 			Array a = p_var;
 
-			ERR_FAIL_COND_V_MSG(p_markers.has(a.id()), "\"[...]\"", "Converting circular structure to JSON.");
+			if (p_markers.has(a.id())) {
+				r_writer.append("\"[...]\"");
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
 			p_markers.insert(a.id());
 
+			r_writer.append("[");
+			r_writer.append(end_statement);
 			for (int i = 0; i < a.size(); i++) {
 				if (i > 0) {
-					s += ",";
-					s += end_statement;
+					r_writer.append(",");
+					r_writer.append(end_statement);
 				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _stringify(a[i], p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
+				_append_indent(r_writer, p_indent, p_cur_indent + 1);
+				_stringify(r_writer, a[i], p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
 			}
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "]";
+			r_writer.append(end_statement);
+			_append_indent(r_writer, p_indent, p_cur_indent);
+			r_writer.append("]");
 			p_markers.erase(a.id());
-			return s;
-		}
+		} break;
 		case Variant::DICTIONARY: {
-			String s = "{";
-			s += end_statement;
 			Dictionary d = p_var;
 
-			ERR_FAIL_COND_V_MSG(p_markers.has(d.id()), "\"{...}\"", "Converting circular structure to JSON.");
+			if (p_markers.has(d.id())) {
+				r_writer.append("\"{...}\"");
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
 			p_markers.insert(d.id());
 
 			List<Variant> keys;
@@ -121,29 +131,59 @@ String JSON::_stringify(const Variant &p_var, const String &p_indent, int p_cur_
 				keys.sort();
 			}
 
+			r_writer.append("{");
+			r_writer.append(end_statement);
 			bool first_key = true;
 			for (const Variant &E : keys) {
 				if (first_key) {
 					first_key = false;
 				} else {
-					s += ",";
-					s += end_statement;
+					r_writer.append(",");
+					r_writer.append(end_statement);
 				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _stringify(String(E), p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
-				s += colon;
-				s += _stringify(d[E], p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
+				_append_indent(r_writer, p_indent, p_cur_indent + 1);
+				_stringify(r_writer, String(E), p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
+				r_writer.append(colon);
+				_stringify(r_writer, d[E], p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
 			}
 
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "}";
+			r_writer.append(end_statement);
+			_append_indent(r_writer, p_indent, p_cur_indent);
+			r_writer.append("}");
 			p_markers.erase(d.id());
-			return s;
+		} break;
+		default: {
+			r_writer.append("\"");
+			r_writer.append(String(p_var).json_escape());
+			r_writer.append("\"");
 		}
-		default:
-			return "\"" + String(p_var).json_escape() + "\"";
 	}
 }
 
-Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str) {
+// Appends the unescaped text between two escapes (or quotes) of a string token.
+// UTF-8 sequences never contain '"' or '\\', so spans can be decoded on their own.
+static _FORCE_INLINE_ void _json_append_span(String &r_str, const char32_t *p_span, int p_len) {
+	if (p_len > 0) {
+		r_str += String(p_span, p_len);
+	}
+}
+
+static _FORCE_INLINE_ void _json_append_span(String &r_str, const uint8_t *p_span, int p_len) {
+	if (p_len > 0) {
+		r_str += String::utf8((const char *)p_span, p_len);
+	}
+}
+
+static _FORCE_INLINE_ double _json_to_float(const char32_t *p_str, const char32_t **r_end) {
+	return String::to_float(p_str, r_end);
+}
+
+static _FORCE_INLINE_ double _json_to_float(const uint8_t *p_str, const uint8_t **r_end) {
+	return String::to_float((const char *)p_str, (const char **)r_end);
+}
+
+template <class C>
+Error JSON::_get_token(const C *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str) {
 	while (p_len > 0) {
 		switch (p_str[index]) {
 			case '\n': {
@@ -188,14 +228,17 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 			case '"': {
 				index++;
 				String str;
+				int span_start = index;
 				while (true) {
 					if (p_str[index] == 0) {
 						r_err_str = "Unterminated String";
 						return ERR_PARSE_ERROR;
 					} else if (p_str[index] == '"') {
+						_json_append_span(str, &p_str[span_start], index - span_start);
 						index++;
 						break;
 					} else if (p_str[index] == '\\') {
+						_json_append_span(str, &p_str[span_start], index - span_start);
 						//escaped characters...
 						index++;
 						char32_t next = p_str[index];
@@ -304,13 +347,16 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 							} break;
 						}
 
-						str += res;
-
-					} else {
-						if (p_str[index] == '\n') {
-							line++;
+						if (sizeof(C) == 1 && next >= 0x80) {
+							// Escaped non-ASCII character, keep its whole UTF-8 sequence in the next span.
+							span_start = index;
+						} else {
+							str += res;
+							span_start = index + 1;
 						}
-						str += p_str[index];
+
+					} else if (p_str[index] == '\n') {
+						line++;
 					}
 					index++;
 				}
@@ -328,8 +374,8 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 
 				if (p_str[index] == '-' || (p_str[index] >= '0' && p_str[index] <= '9')) {
 					//a number
-					const char32_t *rptr;
-					double number = String::to_float(&p_str[index], &rptr);
+					const C *rptr;
+					double number = _json_to_float(&p_str[index], &rptr);
 					index += (rptr - &p_str[index]);
 					r_token.type = TK_NUMBER;
 					r_token.value = number;
@@ -357,7 +403,8 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 	return ERR_PARSE_ERROR;
 }
 
-Error JSON::_parse_value(Variant &value, Token &token, const char32_t *p_str, int &index, int p_len, int &line, String &r_err_str) {
+template <class C>
+Error JSON::_parse_value(Variant &value, Token &token, const C *p_str, int &index, int p_len, int &line, String &r_err_str) {
 	if (token.type == TK_CURLY_BRACKET_OPEN) {
 		Dictionary d;
 		Error err = _parse_object(d, p_str, index, p_len, line, r_err_str);
@@ -396,7 +443,8 @@ Error JSON::_parse_value(Variant &value, Token &token, const char32_t *p_str, in
 	return OK;
 }
 
-Error JSON::_parse_array(Array &array, const char32_t *p_str, int &index, int p_len, int &line, String &r_err_str) {
+template <class C>
+Error JSON::_parse_array(Array &array, const C *p_str, int &index, int p_len, int &line, String &r_err_str) {
 	Token token;
 	bool need_comma = false;
 
@@ -434,7 +482,8 @@ Error JSON::_parse_array(Array &array, const char32_t *p_str, int &index, int p_
 	return ERR_PARSE_ERROR;
 }
 
-Error JSON::_parse_object(Dictionary &object, const char32_t *p_str, int &index, int p_len, int &line, String &r_err_str) {
+template <class C>
+Error JSON::_parse_object(Dictionary &object, const C *p_str, int &index, int p_len, int &line, String &r_err_str) {
 	bool at_key = true;
 	String key;
 	Token token;
@@ -497,13 +546,13 @@ Error JSON::_parse_object(Dictionary &object, const char32_t *p_str, int &index,
 	return ERR_PARSE_ERROR;
 }
 
-Error JSON::_parse_string(const String &p_json, Variant &r_ret, String &r_err_str, int &r_err_line) {
-	const char32_t *str = p_json.ptr();
+template <class C>
+Error JSON::_parse_text(const C *p_str, int p_len, Variant &r_ret, String &r_err_str, int &r_err_line) {
+	const C *str = p_str;
 	int idx = 0;
-	int len = p_json.length();
+	int len = p_len;
 	Token token;
 	r_err_line = 0;
-	String aux_key;
 
 	Error err = _get_token(str, idx, len, token, r_err_line, r_err_str);
 	if (err) {
@@ -530,11 +579,54 @@ Error JSON::_parse_string(const String &p_json, Variant &r_ret, String &r_err_st
 
 String JSON::stringify(const Variant &p_var, const String &p_indent, bool p_sort_keys, bool p_full_precision) {
 	Set<const void *> markers;
-	return _stringify(p_var, p_indent, 0, p_sort_keys, markers, p_full_precision);
+	Writer writer;
+	_stringify(writer, p_var, p_indent, 0, p_sort_keys, markers, p_full_precision);
+	return writer.buffer;
+}
+
+Error JSON::stringify_to_file(const Variant &p_var, const String &p_path, const String &p_indent, bool p_sort_keys, bool p_full_precision) {
+	Error err;
+	FileAccessRef f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(!f, err, "Can't open file for writing: " + p_path + ".");
+
+	Set<const void *> markers;
+	Writer writer;
+	writer.file = f;
+	_stringify(writer, p_var, p_indent, 0, p_sort_keys, markers, p_full_precision);
+	writer.flush();
+
+	return f->get_error();
 }
 
 Error JSON::parse(const String &p_json_string) {
-	Error err = _parse_string(p_json_string, data, err_str, err_line);
+	Error err = _parse_text(p_json_string.ptr(), p_json_string.length(), data, err_str, err_line);
+	if (err == Error::OK) {
+		err_line = 0;
+	}
+	return err;
+}
+
+Error JSON::parse_utf8(const Vector<uint8_t> &p_json_buffer) {
+	const uint8_t *str = p_json_buffer.ptr();
+	int len = p_json_buffer.size();
+
+	// The parser relies on a null terminator, only copy the buffer when it lacks one.
+	Vector<uint8_t> terminated;
+	if (len == 0 || str[len - 1] != 0) {
+		terminated = p_json_buffer;
+		terminated.push_back(0);
+		str = terminated.ptr();
+	} else {
+		len--;
+	}
+
+	// Skip the byte order mark.
+	if (len >= 3 && str[0] == 0xEF && str[1] == 0xBB && str[2] == 0xBF) {
+		str += 3;
+		len -= 3;
+	}
+
+	Error err = _parse_text(str, len, data, err_str, err_line);
 	if (err == Error::OK) {
 		err_line = 0;
 	}
@@ -543,7 +635,9 @@ Error JSON::parse(const String &p_json_string) {
 
 void JSON::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("stringify", "data", "indent", "sort_keys", "full_precision"), &JSON::stringify, DEFVAL(""), DEFVAL(true), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("stringify_to_file", "data", "path", "indent", "sort_keys", "full_precision"), &JSON::stringify_to_file, DEFVAL(""), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("parse", "json_string"), &JSON::parse);
+	ClassDB::bind_method(D_METHOD("parse_utf8", "json_buffer"), &JSON::parse_utf8);
 
 	ClassDB::bind_method(D_METHOD("get_data"), &JSON::get_data);
 	ClassDB::bind_method(D_METHOD("get_error_line"), &JSON::get_error_line);
@@ -34,6 +34,8 @@
 #include "core/object/ref_counted.h"
 #include "core/variant/variant.h"
 
+class FileAccess;
+
 class JSON : public RefCounted {
 	GDCLASS(JSON, RefCounted);
 
@@ -63,26 +65,57 @@ class JSON : public RefCounted {
 		Variant value;
 	};
 
+	// Output is appended to a single buffer. When writing to a file, the
+	// buffer is flushed whenever it grows past WRITE_FLUSH_SIZE characters.
+	struct Writer {
+		enum {
+			WRITE_FLUSH_SIZE = 65536
+		};
+
+		String buffer;
+		FileAccess *file = nullptr;
+
+		_FORCE_INLINE_ void append(const String &p_text) {
+			buffer += p_text;
+			if (file && buffer.length() >= WRITE_FLUSH_SIZE) {
+				flush();
+			}
+		}
+		_FORCE_INLINE_ void append(const char *p_text) {
+			buffer += p_text;
+		}
+		void flush();
+	};
+
 	Variant data;
 	String err_str;
 	int err_line = 0;
 
 	static const char *tk_name[];
 
-	static String _make_indent(const String &p_indent, int p_size);
-	static String _stringify(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, Set<const void *> &p_markers, bool p_full_precision = false);
-	static Error _get_token(const char32_t *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str);
-	static Error _parse_value(Variant &value, Token &token, const char32_t *p_str, int &index, int p_len, int &line, String &r_err_str);
-	static Error _parse_array(Array &array, const char32_t *p_str, int &index, int p_len, int &line, String &r_err_str);
-	static Error _parse_object(Dictionary &object, const char32_t *p_str, int &index, int p_len, int &line, String &r_err_str);
-	static Error _parse_string(const String &p_json, Variant &r_ret, String &r_err_str, int &r_err_line);
+	static void _append_indent(Writer &r_writer, const String &p_indent, int p_size);
+	static void _stringify(Writer &r_writer, const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, Set<const void *> &p_markers, bool p_full_precision = false);
+
+	// The parser runs either on UTF-32 (C = char32_t) or directly on UTF-8 (C = uint8_t) text, which must be null terminated.
+	template <class C>
+	static Error _get_token(const C *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str);
+	template <class C>
+	static Error _parse_value(Variant &value, Token &token, const C *p_str, int &index, int p_len, int &line, String &r_err_str);
+	template <class C>
+	static Error _parse_array(Array &array, const C *p_str, int &index, int p_len, int &line, String &r_err_str);
+	template <class C>
+	static Error _parse_object(Dictionary &object, const C *p_str, int &index, int p_len, int &line, String &r_err_str);
+	template <class C>
+	static Error _parse_text(const C *p_str, int p_len, Variant &r_ret, String &r_err_str, int &r_err_line);
 
 protected:
 	static void _bind_methods();
 
 public:
 	String stringify(const Variant &p_var, const String &p_indent = "", bool p_sort_keys = true, bool p_full_precision = false);
+	Error stringify_to_file(const Variant &p_var, const String &p_path, const String &p_indent = "", bool p_sort_keys = true, bool p_full_precision = false);
 	Error parse(const String &p_json_string);
+	Error parse_utf8(const Vector<uint8_t> &p_json_buffer);
 
 	inline Variant get_data() const { return data; }
 	inline int get_error_line() const { return err_line; }
@@ -36,6 +36,9 @@
 #include "core/os/time.h"
 #include "core/string/print_string.h"
 
+#include <chrono>
+#include <thread>
+
 #if defined(MINGW_ENABLED) || defined(_MSC_VER)
 #define sprintf sprintf_s
 #endif
@@ -81,12 +84,8 @@ void Logger::log_error(const char *p_function, const char *p_file, int p_line, c
 		err_details = p_code;
 	}
 
-	if (p_editor_notify) {
-		logf_error("%s: %s\n", err_type, err_details);
-	} else {
-		logf_error("USER %s: %s\n", err_type, err_details);
-	}
-	logf_error("   at: %s (%s:%i) - %s\n", p_function, p_file, p_line, p_code);
+	// A single message, so loggers that queue messages keep both lines together.
+	logf_error("%s%s: %s\n   at: %s (%s:%i) - %s\n", p_editor_notify ? "" : "USER ", err_type, err_details, p_function, p_file, p_line, p_code);
 }
 
 void Logger::logf(const char *p_format, ...) {
@@ -222,6 +221,12 @@ void RotatedFileLogger::logv(const char *p_format, va_list p_list, bool p_err) {
 	}
 }
 
+void RotatedFileLogger::flush() {
+	if (file) {
+		file->flush();
+	}
+}
+
 RotatedFileLogger::~RotatedFileLogger() {
 	close_file();
 }
@@ -243,6 +248,11 @@ void StdLogger::logv(const char *p_format, va_list p_list, bool p_err) {
 	}
 }
 
+void StdLogger::flush() {
+	fflush(stdout);
+	fflush(stderr);
+}
+
 CompositeLogger::CompositeLogger(Vector<Logger *> p_loggers) :
 		loggers(p_loggers) {
 }
@@ -270,6 +280,12 @@ void CompositeLogger::log_error(const char *p_function, const char *p_file, int
 	}
 }
 
+void CompositeLogger::flush() {
+	for (int i = 0; i < loggers.size(); ++i) {
+		loggers[i]->flush();
+	}
+}
+
 void CompositeLogger::add_logger(Logger *p_logger) {
 	loggers.push_back(p_logger);
 }
@@ -279,3 +295,222 @@ CompositeLogger::~CompositeLogger() {
 		memdelete(loggers[i]);
 	}
 }
+
+uint64_t AsyncLogger::_get_ticks_usec() {
+	// Not using OS, as the writer thread may still be running while the OS singleton is destroyed.
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool AsyncLogger::_has_pending() const {
+	return slots[dequeue_pos & slot_mask].sequence.load(std::memory_order_seq_cst) == dequeue_pos + 1;
+}
+
+void AsyncLogger::_write_text(const char *p_text, bool p_err) {
+	if (p_err) {
+		target->logf_error("%s", p_text);
+	} else {
+		target->logf("%s", p_text);
+	}
+}
+
+void AsyncLogger::_write_repeats() {
+	if (repeat_count == 0) {
+		return;
+	}
+
+	char text[64];
+	snprintf(text, sizeof(text), "   (previous message repeated %u times)\n", repeat_count);
+	_write_text(text, last_err);
+	repeat_count = 0;
+}
+
+void AsyncLogger::_write_dropped() {
+	uint32_t dropped = dropped_count.get();
+	if (dropped == 0) {
+		return;
+	}
+	dropped_count.sub(dropped);
+
+	_write_repeats();
+	char text[96];
+	snprintf(text, sizeof(text), "   (%u log messages dropped, too many were printed at once)\n", dropped);
+	_write_text(text, true);
+	last_text.clear();
+}
+
+void AsyncLogger::_drain() {
+	while (_has_pending()) {
+		Slot &slot = slots[dequeue_pos & slot_mask];
+
+		if (!slot.dropped) {
+			const char *text = slot.heap_text ? slot.heap_text : slot.text;
+			// Single characters are usually line breaks, which are not worth collapsing.
+			if (slot.length > 1 && slot.length == last_text.size() && slot.err == last_err && memcmp(text, last_text.ptr(), slot.length) == 0) {
+				if (repeat_count == 0) {
+					repeat_since = _get_ticks_usec();
+				}
+				repeat_count++;
+			} else {
+				_write_repeats();
+				_write_text(text, slot.err);
+				last_text.resize(slot.length);
+				memcpy(last_text.ptr(), text, slot.length);
+				last_err = slot.err;
+			}
+		}
+
+		if (slot.heap_text) {
+			Memory::free_static(slot.heap_text);
+			slot.heap_text = nullptr;
+			heap_bytes.sub(slot.length + 1);
+		}
+
+		slot.sequence.store(dequeue_pos + slot_mask + 1, std::memory_order_release);
+		dequeue_pos++;
+	}
+
+	_write_dropped();
+}
+
+void AsyncLogger::_thread_func(void *p_user) {
+	AsyncLogger *logger = (AsyncLogger *)p_user;
+
+	while (!logger->exit.is_set()) {
+		logger->write_mutex.lock();
+		logger->_drain();
+		if (logger->repeat_count > 0 && _get_ticks_usec() - logger->repeat_since >= REPEAT_FLUSH_USEC) {
+			logger->_write_repeats();
+		}
+		bool repeats_pending = logger->repeat_count > 0;
+
+		// Checked after announcing the writer is about to sleep, see logv().
+		logger->writer_sleeping.store(true);
+		bool pending = logger->_has_pending();
+		logger->write_mutex.unlock();
+
+		if (pending) {
+			logger->writer_sleeping.store(false);
+		} else if (repeats_pending) {
+			// Wake up to write the repeat count even if nothing else is printed.
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		} else {
+			logger->semaphore.wait();
+		}
+	}
+}
+
+void AsyncLogger::logv(const char *p_format, va_list p_list, bool p_err) {
+	if (!should_log(p_err)) {
+		return;
+	}
+
+	if (max_messages_per_second > 0) {
+		uint64_t second = _get_ticks_usec() / 1000000;
+		if (rate_second.get() != second) {
+			// Threads racing here may reset the count more than once, letting a few more messages through.
+			rate_second.set(second);
+			rate_count.set(0);
+		}
+		if (rate_count.increment() > max_messages_per_second) {
+			dropped_count.increment();
+			return;
+		}
+	}
+
+	// Reserve a slot, each one holds the position it can be written at, see
+	// https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+	uint32_t pos = enqueue_pos.load(std::memory_order_relaxed);
+	Slot *slot;
+	while (true) {
+		slot = &slots[pos & slot_mask];
+		int32_t diff = int32_t(slot->sequence.load(std::memory_order_acquire) - pos);
+		if (diff == 0) {
+			if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		} else if (diff < 0) {
+			// Full, the writer can't keep up.
+			dropped_count.increment();
+			return;
+		} else {
+			pos = enqueue_pos.load(std::memory_order_relaxed);
+		}
+	}
+
+	va_list list_copy;
+	va_copy(list_copy, p_list);
+	int len = vsnprintf(slot->text, SLOT_TEXT_SIZE, p_format, p_list);
+	slot->err = p_err;
+	slot->dropped = len < 0;
+	slot->length = MAX(len, 0);
+	if (len >= SLOT_TEXT_SIZE) {
+		if (heap_bytes.add(len + 1) <= max_heap_bytes) {
+			slot->heap_text = (char *)Memory::alloc_static(len + 1);
+			vsnprintf(slot->heap_text, len + 1, p_format, list_copy);
+		} else {
+			heap_bytes.sub(len + 1);
+			slot->dropped = true;
+		}
+	}
+	va_end(list_copy);
+
+	if (slot->dropped) {
+		dropped_count.increment();
+	}
+
+	// Sequentially consistent with the writer setting writer_sleeping before checking for
+	// pending messages, so either it sees this message or it gets woken up.
+	slot->sequence.store(pos + 1, std::memory_order_seq_cst);
+	if (writer_sleeping.exchange(false)) {
+		semaphore.post();
+	}
+}
+
+void AsyncLogger::flush() {
+	// Only wait for the lock for a while, as this may be called from a crash handler that
+	// interrupted the writer thread.
+	uint64_t waited = 0;
+	while (write_mutex.try_lock() != OK) {
+		if (waited >= FLUSH_TIMEOUT_USEC) {
+			return;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		waited += 1000;
+	}
+
+	_drain();
+	_write_repeats();
+	target->flush();
+	write_mutex.unlock();
+}
+
+AsyncLogger::AsyncLogger(Logger *p_target, uint32_t p_buffer_size, uint32_t p_max_messages_per_second) :
+		target(p_target),
+		max_messages_per_second(p_max_messages_per_second) {
+	// Half of the memory goes to the queue, the other half to messages too long for a slot.
+	uint32_t slot_count = MAX(p_buffer_size / 2 / sizeof(Slot), (uint32_t)MIN_SLOTS);
+	uint32_t rounded = next_power_of_2(slot_count);
+	slot_count = rounded > slot_count ? rounded >> 1 : rounded;
+	max_heap_bytes = p_buffer_size / 2;
+
+	slots = memnew_arr(Slot, slot_count);
+	slot_mask = slot_count - 1;
+	for (uint32_t i = 0; i < slot_count; i++) {
+		slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	enqueue_pos.store(0);
+	writer_sleeping.store(false);
+
+	thread.start(_thread_func, this);
+}
+
+AsyncLogger::~AsyncLogger() {
+	exit.set();
+	semaphore.post();
+	thread.wait_to_finish();
+
+	flush();
+
+	memdelete(target);
+	memdelete_arr(slots);
+}
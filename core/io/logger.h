@@ -32,10 +32,16 @@
 #define LOGGER_H
 
 #include "core/io/file_access.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 #include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/vector.h"
 
 #include <stdarg.h>
+#include <atomic>
 
 class Logger {
 protected:
@@ -59,6 +65,9 @@ public:
 	void logf(const char *p_format, ...) _PRINTF_FORMAT_ATTRIBUTE_2_3;
 	void logf_error(const char *p_format, ...) _PRINTF_FORMAT_ATTRIBUTE_2_3;
 
+	// Writes out anything buffered. Also called when crashing, so it must not block indefinitely.
+	virtual void flush() {}
+
 	virtual ~Logger() {}
 };
 
@@ -68,6 +77,7 @@ public:
 class StdLogger : public Logger {
 public:
 	virtual void logv(const char *p_format, va_list p_list, bool p_err) _PRINTF_FORMAT_ATTRIBUTE_2_0;
+	virtual void flush();
 	virtual ~StdLogger() {}
 };
 
@@ -92,6 +102,7 @@ public:
 	RotatedFileLogger(const String &p_base_path, int p_max_files = 10);
 
 	virtual void logv(const char *p_format, va_list p_list, bool p_err) _PRINTF_FORMAT_ATTRIBUTE_2_0;
+	virtual void flush();
 
 	virtual ~RotatedFileLogger();
 };
@@ -104,10 +115,81 @@ public:
 
 	virtual void logv(const char *p_format, va_list p_list, bool p_err) _PRINTF_FORMAT_ATTRIBUTE_2_0;
 	virtual void log_error(const char *p_function, const char *p_file, int p_line, const char *p_code, const char *p_rationale, bool p_editor_notify, ErrorType p_type = ERR_ERROR);
+	virtual void flush();
 
 	void add_logger(Logger *p_logger);
 
 	virtual ~CompositeLogger();
 };
 
+/**
+ * Formats messages on the calling thread and queues them, so they are written to the wrapped
+ * logger by a separate thread and printing never waits on console or disk I/O.
+ * The queue is lock-free and bounded: when it is full, or more than the allowed messages per
+ * second arrive, new messages are dropped and the amount dropped is reported later.
+ * Identical messages arriving back to back are written once, followed by a repeat count.
+ */
+class AsyncLogger : public Logger {
+	enum {
+		SLOT_TEXT_SIZE = 240,
+		MIN_SLOTS = 16,
+		REPEAT_FLUSH_USEC = 1000000,
+		FLUSH_TIMEOUT_USEC = 100000,
+	};
+
+	struct Slot {
+		std::atomic<uint32_t> sequence;
+		uint32_t length = 0;
+		bool err = false;
+		bool dropped = false;
+		char *heap_text = nullptr; // For messages that don't fit in text.
+		char text[SLOT_TEXT_SIZE];
+	};
+
+	Logger *target = nullptr;
+
+	Slot *slots = nullptr;
+	uint32_t slot_mask = 0;
+	std::atomic<uint32_t> enqueue_pos;
+	uint32_t dequeue_pos = 0; // Only accessed with write_mutex locked.
+
+	// Long messages are allocated, this caps the memory they use while queued.
+	uint32_t max_heap_bytes = 0;
+	SafeNumeric<uint32_t> heap_bytes;
+
+	uint32_t max_messages_per_second = 0;
+	SafeNumeric<uint64_t> rate_second;
+	SafeNumeric<uint32_t> rate_count;
+	SafeNumeric<uint32_t> dropped_count;
+
+	// Last message written and how many times it arrived again since. Only accessed with write_mutex locked.
+	LocalVector<char> last_text;
+	bool last_err = false;
+	uint32_t repeat_count = 0;
+	uint64_t repeat_since = 0;
+
+	Mutex write_mutex;
+	Semaphore semaphore;
+	std::atomic_bool writer_sleeping;
+	SafeFlag exit;
+	Thread thread;
+
+	bool _has_pending() const;
+	void _write_text(const char *p_text, bool p_err);
+	void _write_repeats();
+	void _write_dropped();
+	void _drain();
+
+	static uint64_t _get_ticks_usec();
+	static void _thread_func(void *p_user);
+
+public:
+	virtual void logv(const char *p_format, va_list p_list, bool p_err) _PRINTF_FORMAT_ATTRIBUTE_2_0;
+	virtual void flush();
+
+	// Takes ownership of p_target. A zero p_max_messages_per_second means no limit.
+	AsyncLogger(Logger *p_target, uint32_t p_buffer_size, uint32_t p_max_messages_per_second = 0);
+	virtual ~AsyncLogger();
+};
+
 #endif // LOGGER_H
@@ -1676,3 +1676,485 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 	return OK;
 }
+
+// Compact encoding.
+//
+// Meant for large, repetitive data such as save games. Every value starts with a
+// one byte tag, integers and lengths are variable length (LEB128, signed values
+// zigzag encoded), strings are stored once and referred to by index afterwards,
+// and dictionaries whose keys are all strings store their key list ("shape") once
+// as well, so repeated records only cost their values. Types without a compact
+// form are embedded in the regular encode_variant() format.
+//
+// String and shape references are written as a varint: 0 introduces a new entry
+// (followed by its contents, it gets the next index), otherwise it's index + 1.
+
+#define COMPACT_VERSION 1
+
+enum {
+	COMPACT_NIL,
+	COMPACT_FALSE,
+	COMPACT_TRUE,
+	COMPACT_INT,
+	COMPACT_FLOAT32,
+	COMPACT_FLOAT64,
+	COMPACT_STRING,
+	COMPACT_STRING_NAME,
+	COMPACT_ARRAY,
+	COMPACT_DICTIONARY,
+	COMPACT_DICTIONARY_SHAPED,
+	COMPACT_PACKED_INT32_ARRAY,
+	COMPACT_PACKED_INT64_ARRAY,
+	COMPACT_PACKED_STRING_ARRAY,
+	COMPACT_VARIANT,
+	COMPACT_MAX
+};
+
+struct CompactShapeHasher {
+	static _FORCE_INLINE_ uint32_t hash(const Vector<uint32_t> &p_shape) { return hash_djb2_buffer((const uint8_t *)p_shape.ptr(), p_shape.size() * sizeof(uint32_t)); }
+};
+
+struct CompactEncoder {
+	LocalVector<uint8_t> data;
+	HashMap<String, uint32_t> strings;
+	HashMap<Vector<uint32_t>, uint32_t, CompactShapeHasher> shapes;
+	bool full_objects = false;
+
+	_FORCE_INLINE_ void put_u8(uint8_t p_byte) {
+		data.push_back(p_byte);
+	}
+
+	void put_varint(uint64_t p_value) {
+		while (p_value >= 0x80) {
+			data.push_back(uint8_t(p_value) | 0x80);
+			p_value >>= 7;
+		}
+		data.push_back(uint8_t(p_value));
+	}
+
+	_FORCE_INLINE_ void put_int(int64_t p_value) {
+		put_varint((uint64_t(p_value) << 1) ^ uint64_t(p_value >> 63));
+	}
+
+	void put_bytes(const uint8_t *p_bytes, uint32_t p_len) {
+		uint32_t ofs = data.size();
+		data.resize(ofs + p_len);
+		memcpy(&data[ofs], p_bytes, p_len);
+	}
+
+	// Returns the index of the string, writing it first if it wasn't seen yet.
+	uint32_t put_string(const String &p_string) {
+		const uint32_t *index = strings.getptr(p_string);
+		if (index) {
+			put_varint(*index + 1);
+			return *index;
+		}
+
+		uint32_t new_index = strings.size();
+		strings[p_string] = new_index;
+		CharString utf8 = p_string.utf8();
+		put_varint(0);
+		put_varint(utf8.length());
+		put_bytes((const uint8_t *)utf8.get_data(), utf8.length());
+		return new_index;
+	}
+
+	Error put_variant(const Variant &p_variant, int p_depth) {
+		ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential inifite recursion detected. Bailing.");
+
+		switch (p_variant.get_type()) {
+			case Variant::NIL: {
+				put_u8(COMPACT_NIL);
+			} break;
+			case Variant::BOOL: {
+				put_u8(bool(p_variant) ? COMPACT_TRUE : COMPACT_FALSE);
+			} break;
+			case Variant::INT: {
+				put_u8(COMPACT_INT);
+				put_int(p_variant);
+			} break;
+			case Variant::FLOAT: {
+				double d = p_variant;
+				float f = d;
+				uint8_t buf[8];
+				if (double(f) == d) {
+					put_u8(COMPACT_FLOAT32);
+					encode_float(f, buf);
+					put_bytes(buf, 4);
+				} else {
+					put_u8(COMPACT_FLOAT64);
+					encode_double(d, buf);
+					put_bytes(buf, 8);
+				}
+			} break;
+			case Variant::STRING: {
+				put_u8(COMPACT_STRING);
+				put_string(p_variant);
+			} break;
+			case Variant::STRING_NAME: {
+				put_u8(COMPACT_STRING_NAME);
+				put_string(p_variant);
+			} break;
+			case Variant::ARRAY: {
+				Array array = p_variant;
+				put_u8(COMPACT_ARRAY);
+				put_varint(array.size());
+				for (int i = 0; i < array.size(); i++) {
+					Error err = put_variant(array[i], p_depth + 1);
+					ERR_FAIL_COND_V(err, err);
+				}
+			} break;
+			case Variant::DICTIONARY: {
+				Dictionary d = p_variant;
+				List<Variant> keys;
+				d.get_key_list(&keys);
+
+				bool string_keys = true;
+				for (const Variant &E : keys) {
+					if (E.get_type() != Variant::STRING) {
+						string_keys = false;
+						break;
+					}
+				}
+
+				if (string_keys && !keys.is_empty()) {
+					put_u8(COMPACT_DICTIONARY_SHAPED);
+
+					// Look the shape up by the indices of its keys, so keys need to be in the table already.
+					Vector<uint32_t> shape;
+					shape.resize(keys.size());
+					uint32_t *shape_w = shape.ptrw();
+					bool known = true;
+					int i = 0;
+					for (const Variant &E : keys) {
+						const uint32_t *index = strings.getptr(E);
+						if (!index) {
+							known = false;
+							break;
+						}
+						shape_w[i++] = *index;
+					}
+
+					const uint32_t *shape_index = known ? shapes.getptr(shape) : nullptr;
+					if (shape_index) {
+						put_varint(*shape_index + 1);
+					} else {
+						put_varint(0);
+						put_varint(keys.size());
+						i = 0;
+						for (const Variant &E : keys) {
+							shape_w[i++] = put_string(E);
+						}
+						uint32_t new_index = shapes.size();
+						shapes[shape] = new_index;
+					}
+
+					for (const Variant &E : keys) {
+						Error err = put_variant(d[E], p_depth + 1);
+						ERR_FAIL_COND_V(err, err);
+					}
+				} else {
+					put_u8(COMPACT_DICTIONARY);
+					put_varint(keys.size());
+					for (const Variant &E : keys) {
+						Error err = put_variant(E, p_depth + 1);
+						ERR_FAIL_COND_V(err, err);
+						err = put_variant(d[E], p_depth + 1);
+						ERR_FAIL_COND_V(err, err);
+					}
+				}
+			} break;
+			case Variant::PACKED_INT32_ARRAY: {
+				Vector<int32_t> array = p_variant;
+				put_u8(COMPACT_PACKED_INT32_ARRAY);
+				put_varint(array.size());
+				for (int i = 0; i < array.size(); i++) {
+					put_int(array[i]);
+				}
+			} break;
+			case Variant::PACKED_INT64_ARRAY: {
+				Vector<int64_t> array = p_variant;
+				put_u8(COMPACT_PACKED_INT64_ARRAY);
+				put_varint(array.size());
+				for (int i = 0; i < array.size(); i++) {
+					put_int(array[i]);
+				}
+			} break;
+			case Variant::PACKED_STRING_ARRAY: {
+				Vector<String> array = p_variant;
+				put_u8(COMPACT_PACKED_STRING_ARRAY);
+				put_varint(array.size());
+				for (int i = 0; i < array.size(); i++) {
+					put_string(array[i]);
+				}
+			} break;
+			default: {
+				int len;
+				Error err = encode_variant(p_variant, nullptr, len, full_objects, p_depth);
+				ERR_FAIL_COND_V(err, err);
+
+				put_u8(COMPACT_VARIANT);
+				put_varint(len);
+				uint32_t ofs = data.size();
+				data.resize(ofs + len);
+				err = encode_variant(p_variant, &data[ofs], len, full_objects, p_depth);
+				ERR_FAIL_COND_V(err, err);
+			} break;
+		}
+
+		return OK;
+	}
+};
+
+struct CompactDecoder {
+	const uint8_t *buf = nullptr;
+	int len = 0;
+	int pos = 0;
+	Vector<String> strings;
+	Vector<Vector<String>> shapes;
+	bool allow_objects = false;
+
+	_FORCE_INLINE_ Error get_u8(uint8_t &r_byte) {
+		ERR_FAIL_COND_V(pos >= len, ERR_INVALID_DATA);
+		r_byte = buf[pos++];
+		return OK;
+	}
+
+	Error get_varint(uint64_t &r_value) {
+		r_value = 0;
+		for (int shift = 0; shift < 64; shift += 7) {
+			uint8_t byte;
+			Error err = get_u8(byte);
+			ERR_FAIL_COND_V(err, err);
+			r_value |= uint64_t(byte & 0x7F) << shift;
+			if (!(byte & 0x80)) {
+				return OK;
+			}
+		}
+		ERR_FAIL_V_MSG(ERR_INVALID_DATA, "Malformed variable length integer.");
+	}
+
+	// Counts and sizes, which can't be larger than what is left to read.
+	Error get_count(int &r_count) {
+		uint64_t value;
+		Error err = get_varint(value);
+		ERR_FAIL_COND_V(err, err);
+		ERR_FAIL_COND_V(value > uint64_t(len - pos), ERR_INVALID_DATA);
+		r_count = value;
+		return OK;
+	}
+
+	Error get_int(int64_t &r_value) {
+		uint64_t value;
+		Error err = get_varint(value);
+		ERR_FAIL_COND_V(err, err);
+		r_value = int64_t(value >> 1) ^ -int64_t(value & 1);
+		return OK;
+	}
+
+	Error get_string(String &r_string) {
+		uint64_t ref;
+		Error err = get_varint(ref);
+		ERR_FAIL_COND_V(err, err);
+
+		if (ref > 0) {
+			ERR_FAIL_COND_V(ref > uint64_t(strings.size()), ERR_INVALID_DATA);
+			r_string = strings[ref - 1];
+			return OK;
+		}
+
+		int size;
+		err = get_count(size);
+		ERR_FAIL_COND_V(err, err);
+		ERR_FAIL_COND_V(r_string.parse_utf8((const char *)&buf[pos], size), ERR_INVALID_DATA);
+		pos += size;
+		strings.push_back(r_string);
+		return OK;
+	}
+
+	Error get_variant(Variant &r_variant, int p_depth) {
+		ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_INVALID_DATA, "Potential inifite recursion detected. Bailing.");
+
+		uint8_t tag;
+		Error err = get_u8(tag);
+		ERR_FAIL_COND_V(err, err);
+
+		switch (tag) {
+			case COMPACT_NIL: {
+				r_variant = Variant();
+			} break;
+			case COMPACT_FALSE:
+			case COMPACT_TRUE: {
+				r_variant = tag == COMPACT_TRUE;
+			} break;
+			case COMPACT_INT: {
+				int64_t value;
+				err = get_int(value);
+				ERR_FAIL_COND_V(err, err);
+				r_variant = value;
+			} break;
+			case COMPACT_FLOAT32: {
+				ERR_FAIL_COND_V(len - pos < 4, ERR_INVALID_DATA);
+				r_variant = decode_float(&buf[pos]);
+				pos += 4;
+			} break;
+			case COMPACT_FLOAT64: {
+				ERR_FAIL_COND_V(len - pos < 8, ERR_INVALID_DATA);
+				r_variant = decode_double(&buf[pos]);
+				pos += 8;
+			} break;
+			case COMPACT_STRING:
+			case COMPACT_STRING_NAME: {
+				String str;
+				err = get_string(str);
+				ERR_FAIL_COND_V(err, err);
+				if (tag == COMPACT_STRING_NAME) {
+					r_variant = StringName(str);
+				} else {
+					r_variant = str;
+				}
+			} break;
+			case COMPACT_ARRAY: {
+				int count;
+				err = get_count(count);
+				ERR_FAIL_COND_V(err, err);
+				Array array;
+				array.resize(count);
+				for (int i = 0; i < count; i++) {
+					Variant value;
+					err = get_variant(value, p_depth + 1);
+					ERR_FAIL_COND_V(err, err);
+					array[i] = value;
+				}
+				r_variant = array;
+			} break;
+			case COMPACT_DICTIONARY: {
+				int count;
+				err = get_count(count);
+				ERR_FAIL_COND_V(err, err);
+				Dictionary d;
+				for (int i = 0; i < count; i++) {
+					Variant key;
+					err = get_variant(key, p_depth + 1);
+					ERR_FAIL_COND_V(err, err);
+					Variant value;
+					err = get_variant(value, p_depth + 1);
+					ERR_FAIL_COND_V(err, err);
+					d[key] = value;
+				}
+				r_variant = d;
+			} break;
+			case COMPACT_DICTIONARY_SHAPED: {
+				uint64_t ref;
+				err = get_varint(ref);
+				ERR_FAIL_COND_V(err, err);
+
+				if (ref == 0) {
+					int count;
+					err = get_count(count);
+					ERR_FAIL_COND_V(err, err);
+					Vector<String> shape;
+					shape.resize(count);
+					for (int i = 0; i < count; i++) {
+						err = get_string(shape.write[i]);
+						ERR_FAIL_COND_V(err, err);
+					}
+					shapes.push_back(shape);
+					ref = shapes.size();
+				}
+				ERR_FAIL_COND_V(ref > uint64_t(shapes.size()), ERR_INVALID_DATA);
+
+				const Vector<String> shape = shapes[ref - 1];
+				Dictionary d;
+				for (int i = 0; i < shape.size(); i++) {
+					Variant value;
+					err = get_variant(value, p_depth + 1);
+					ERR_FAIL_COND_V(err, err);
+					d[shape[i]] = value;
+				}
+				r_variant = d;
+			} break;
+			case COMPACT_PACKED_INT32_ARRAY:
+			case COMPACT_PACKED_INT64_ARRAY: {
+				int count;
+				err = get_count(count);
+				ERR_FAIL_COND_V(err, err);
+				Vector<int64_t> array;
+				array.resize(count);
+				int64_t *w = array.ptrw();
+				for (int i = 0; i < count; i++) {
+					err = get_int(w[i]);
+					ERR_FAIL_COND_V(err, err);
+				}
+				if (tag == COMPACT_PACKED_INT32_ARRAY) {
+					Vector<int32_t> array32;
+					array32.resize(count);
+					int32_t *w32 = array32.ptrw();
+					for (int i = 0; i < count; i++) {
+						w32[i] = w[i];
+					}
+					r_variant = array32;
+				} else {
+					r_variant = array;
+				}
+			} break;
+			case COMPACT_PACKED_STRING_ARRAY: {
+				int count;
+				err = get_count(count);
+				ERR_FAIL_COND_V(err, err);
+				Vector<String> array;
+				array.resize(count);
+				for (int i = 0; i < count; i++) {
+					err = get_string(array.write[i]);
+					ERR_FAIL_COND_V(err, err);
+				}
+				r_variant = array;
+			} break;
+			case COMPACT_VARIANT: {
+				int size;
+				err = get_count(size);
+				ERR_FAIL_COND_V(err, err);
+				err = decode_variant(r_variant, &buf[pos], size, nullptr, allow_objects);
+				ERR_FAIL_COND_V(err, err);
+				pos += size;
+			} break;
+			default: {
+				ERR_FAIL_V_MSG(ERR_INVALID_DATA, "Invalid compact variant tag.");
+			}
+		}
+
+		return OK;
+	}
+};
+
+Error encode_variant_compact(const Variant &p_variant, Vector<uint8_t> &r_buffer, bool p_full_objects) {
+	CompactEncoder encoder;
+	encoder.full_objects = p_full_objects;
+	encoder.put_u8(COMPACT_VERSION);
+	Error err = encoder.put_variant(p_variant, 0);
+	ERR_FAIL_COND_V(err, err);
+
+	r_buffer.resize(encoder.data.size());
+	memcpy(r_buffer.ptrw(), encoder.data.ptr(), encoder.data.size());
+	return OK;
+}
+
+Error decode_variant_compact(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects) {
+	CompactDecoder decoder;
+	decoder.buf = p_buffer;
+	decoder.len = p_len;
+	decoder.allow_objects = p_allow_objects;
+
+	uint8_t version;
+	Error err = decoder.get_u8(version);
+	ERR_FAIL_COND_V(err, err);
+	ERR_FAIL_COND_V_MSG(version != COMPACT_VERSION, ERR_INVALID_DATA, "Unsupported compact variant version.");
+
+	err = decoder.get_variant(r_variant, 0);
+	ERR_FAIL_COND_V(err, err);
+
+	if (r_len) {
+		*r_len = decoder.pos;
+	}
+	return OK;
+}
@@ -40,3 +40,17 @@ NetSocket *NetSocket::create() {
 	ERR_PRINT("Unable to create network socket, platform not supported");
 	return nullptr;
 }
+
+Error NetSocket::recvfrom_batch(Datagram *p_datagrams, int p_count, int &r_received) {
+	r_received = 0;
+	ERR_FAIL_COND_V(p_count < 1, ERR_INVALID_PARAMETER);
+
+	int read = 0;
+	Error err = recvfrom(p_datagrams[0].buffer, p_datagrams[0].length, read, p_datagrams[0].ip, p_datagrams[0].port);
+	if (err != OK) {
+		return err;
+	}
+	p_datagrams[0].length = read;
+	r_received = 1;
+	return OK;
+}
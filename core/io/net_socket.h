@@ -53,6 +53,13 @@ public:
 		TYPE_UDP,
 	};
 
+	struct Datagram {
+		uint8_t *buffer = nullptr;
+		int length = 0; // Size of buffer, set to the size of the received datagram.
+		IPAddress ip;
+		uint16_t port = 0;
+	};
+
 	virtual Error open(Type p_type, IP::Type &ip_type) = 0;
 	virtual void close() = 0;
 	virtual Error bind(IPAddress p_addr, uint16_t p_port) = 0;
@@ -63,6 +70,8 @@ public:
 	virtual Error recvfrom(uint8_t *p_buffer, int p_len, int &r_read, IPAddress &r_ip, uint16_t &r_port, bool p_peek = false) = 0;
 	virtual Error send(const uint8_t *p_buffer, int p_len, int &r_sent) = 0;
 	virtual Error sendto(const uint8_t *p_buffer, int p_len, int &r_sent, IPAddress p_ip, uint16_t p_port) = 0;
+	// Receives up to p_count datagrams with as few system calls as the platform allows, the default receives a single one.
+	virtual Error recvfrom_batch(Datagram *p_datagrams, int p_count, int &r_received);
 	virtual Ref<NetSocket> accept(IPAddress &r_ip, uint16_t &r_port) = 0;
 
 	virtual bool is_open() const = 0;
@@ -105,6 +105,7 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &
 	file->store_32(pack_flags); // flags
 
 	files.clear();
+	stored_contents.clear();
 	ofs = 0;
 
 	return OK;
@@ -133,6 +134,27 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encr
 	}
 	pf.encrypted = p_encrypt;
 
+	// Encrypted files carry their own IV, so copies can also share the stored bytes.
+	String content_key;
+	{
+		unsigned char hash[32];
+		CryptoCore::sha256(data.ptr(), data.size(), hash);
+		content_key = String::hex_encode_buffer(hash, 32) + (p_encrypt ? "e" : "");
+	}
+
+	const uint64_t *stored_ofs = stored_contents.getptr(content_key);
+	if (stored_ofs) {
+		pf.ofs = *stored_ofs;
+		pf.duplicate = true;
+		files.push_back(pf);
+
+		f->close();
+		memdelete(f);
+
+		return OK;
+	}
+	stored_contents.set(content_key, pf.ofs);
+
 	uint64_t _size = pf.size;
 	if (p_encrypt) { // Add encryption overhead.
 		if (_size % 16) { // Pad to encryption block size.
@@ -221,6 +243,11 @@ Error PCKPacker::flush(bool p_verbose) {
 
 	int count = 0;
 	for (int i = 0; i < files.size(); i++) {
+		if (files[i].duplicate) {
+			count += 1;
+			continue;
+		}
+
 		FileAccess *src = FileAccess::open(files[i].src_path, FileAccess::READ);
 		uint64_t to_write = files[i].size;
 
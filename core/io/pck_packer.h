@@ -32,6 +32,7 @@
 #define PCK_PACKER_H
 
 #include "core/object/ref_counted.h"
+#include "core/templates/hash_map.h"
 
 class FileAccess;
 
@@ -53,9 +54,11 @@ class PCKPacker : public RefCounted {
 		uint64_t ofs = 0;
 		uint64_t size = 0;
 		bool encrypted = false;
+		bool duplicate = false; // Same contents as an earlier file, shares its data.
 		Vector<uint8_t> md5;
 	};
 	Vector<File> files;
+	HashMap<String, uint64_t> stored_contents; // SHA-256 of the contents to their offset.
 
 public:
 	Error pck_start(const String &p_file, int p_alignment = 0, const String &p_key = String(), bool p_encrypt_directory = false);
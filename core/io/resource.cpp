@@ -53,40 +53,30 @@ void Resource::set_path(const String &p_path, bool p_take_over) {
 	}
 
 	if (path_cache != "") {
-		ResourceCache::lock.write_lock();
-		ResourceCache::resources.erase(path_cache);
-		ResourceCache::lock.write_unlock();
+		ResourceCache::_erase(path_cache);
 	}
 
 	path_cache = "";
 
-	ResourceCache::lock.read_lock();
-	bool has_path = ResourceCache::resources.has(p_path);
-	ResourceCache::lock.read_unlock();
+	if (p_path != "") {
+		// Checked and inserted under the same lock, so two threads can't both take the path.
+		ResourceCache::Shard &shard = ResourceCache::_get_shard(p_path);
+		shard.lock.write_lock();
 
-	if (has_path) {
-		if (p_take_over) {
-			ResourceCache::lock.write_lock();
-			Resource **res = ResourceCache::resources.getptr(p_path);
-			if (res) {
+		Resource **res = shard.resources.getptr(p_path);
+		if (res) {
+			if (p_take_over) {
 				(*res)->set_name("");
+			} else {
+				shard.lock.write_unlock();
+				ERR_FAIL_MSG("Another resource is loaded from path '" + p_path + "' (possible cyclic resource inclusion).");
 			}
-			ResourceCache::lock.write_unlock();
-		} else {
-			ResourceCache::lock.read_lock();
-			bool exists = ResourceCache::resources.has(p_path);
-			ResourceCache::lock.read_unlock();
-
-			ERR_FAIL_COND_MSG(exists, "Another resource is loaded from path '" + p_path + "' (possible cyclic resource inclusion).");
 		}
-	}
-	path_cache = p_path;
+		shard.resources[p_path] = this;
 
-	if (path_cache != "") {
-		ResourceCache::lock.write_lock();
-		ResourceCache::resources[path_cache] = this;
-		ResourceCache::lock.write_unlock();
+		shard.lock.write_unlock();
 	}
+	path_cache = p_path;
 
 	_resource_path_changed();
 }
@@ -365,7 +355,7 @@ void Resource::set_as_translation_remapped(bool p_remapped) {
 		return;
 	}
 
-	ResourceCache::lock.write_lock();
+	ResourceLoader::remapped_list_lock.write_lock();
 
 	if (p_remapped) {
 		ResourceLoader::remapped_list.add(&remapped_list);
@@ -373,7 +363,7 @@ void Resource::set_as_translation_remapped(bool p_remapped) {
 		ResourceLoader::remapped_list.remove(&remapped_list);
 	}
 
-	ResourceCache::lock.write_unlock();
+	ResourceLoader::remapped_list_lock.write_unlock();
 }
 
 bool Resource::is_translation_remapped() const {
@@ -435,87 +425,116 @@ Resource::Resource() :
 
 Resource::~Resource() {
 	if (path_cache != "") {
-		ResourceCache::lock.write_lock();
-		ResourceCache::resources.erase(path_cache);
-		ResourceCache::lock.write_unlock();
+		ResourceCache::_erase(path_cache);
 	}
 	if (owners.size()) {
 		WARN_PRINT("Resource is still owned.");
 	}
 }
 
-HashMap<String, Resource *> ResourceCache::resources;
+ResourceCache::Shard ResourceCache::shards[ResourceCache::SHARD_COUNT];
 #ifdef TOOLS_ENABLED
 HashMap<String, HashMap<String, String>> ResourceCache::resource_path_cache;
 #endif
 
-RWLock ResourceCache::lock;
 #ifdef TOOLS_ENABLED
 RWLock ResourceCache::path_cache_lock;
 #endif
 
+void ResourceCache::_erase(const String &p_path) {
+	Shard &shard = _get_shard(p_path);
+	shard.lock.write_lock();
+	shard.resources.erase(p_path);
+	shard.lock.write_unlock();
+}
+
 void ResourceCache::clear() {
-	if (resources.size()) {
+	int count = get_cached_resource_count();
+	if (count) {
 		ERR_PRINT("Resources still in use at exit (run with --verbose for details).");
 		if (OS::get_singleton()->is_stdout_verbose()) {
-			const String *K = nullptr;
-			while ((K = resources.next(K))) {
-				Resource *r = resources[*K];
-				print_line(vformat("Resource still in use: %s (%s)", *K, r->get_class()));
+			for (int i = 0; i < SHARD_COUNT; i++) {
+				const String *K = nullptr;
+				while ((K = shards[i].resources.next(K))) {
+					Resource *r = shards[i].resources[*K];
+					print_line(vformat("Resource still in use: %s (%s)", *K, r->get_class()));
+				}
 			}
 		}
 	}
 
-	resources.clear();
+	for (int i = 0; i < SHARD_COUNT; i++) {
+		shards[i].resources.clear();
+	}
 }
 
 void ResourceCache::reload_externals() {
 }
 
 bool ResourceCache::has(const String &p_path) {
-	lock.read_lock();
-	bool b = resources.has(p_path);
-	lock.read_unlock();
+	Shard &shard = _get_shard(p_path);
+	shard.lock.read_lock();
+	bool b = shard.resources.has(p_path);
+	shard.lock.read_unlock();
 
 	return b;
 }
 
 Resource *ResourceCache::get(const String &p_path) {
-	lock.read_lock();
+	Shard &shard = _get_shard(p_path);
+	shard.lock.read_lock();
+
+	Resource **res = shard.resources.getptr(p_path);
+	Resource *r = res ? *res : nullptr;
+
+	shard.lock.read_unlock();
 
-	Resource **res = resources.getptr(p_path);
+	return r;
+}
 
-	lock.read_unlock();
+Ref<Resource> ResourceCache::get_ref(const String &p_path) {
+	Shard &shard = _get_shard(p_path);
+	shard.lock.read_lock();
 
-	if (!res) {
-		return nullptr;
+	Ref<Resource> res;
+	Resource **rptr = shard.resources.getptr(p_path);
+	if (rptr) {
+		// The resource may be getting freed in another thread (it can't be gone while
+		// the lock is held). Then referencing fails, and it's as if it wasn't cached.
+		res = Ref<Resource>(*rptr);
 	}
 
-	return *res;
+	shard.lock.read_unlock();
+
+	return res;
 }
 
 void ResourceCache::get_cached_resources(List<Ref<Resource>> *p_resources) {
-	lock.read_lock();
-	const String *K = nullptr;
-	while ((K = resources.next(K))) {
-		Resource *r = resources[*K];
-		p_resources->push_back(Ref<Resource>(r));
+	for (int i = 0; i < SHARD_COUNT; i++) {
+		Shard &shard = shards[i];
+		shard.lock.read_lock();
+		const String *K = nullptr;
+		while ((K = shard.resources.next(K))) {
+			Resource *r = shard.resources[*K];
+			p_resources->push_back(Ref<Resource>(r));
+		}
+		shard.lock.read_unlock();
 	}
-	lock.read_unlock();
 }
 
 int ResourceCache::get_cached_resource_count() {
-	lock.read_lock();
-	int rc = resources.size();
-	lock.read_unlock();
+	int rc = 0;
+	for (int i = 0; i < SHARD_COUNT; i++) {
+		shards[i].lock.read_lock();
+		rc += shards[i].resources.size();
+		shards[i].lock.read_unlock();
+	}
 
 	return rc;
 }
 
 void ResourceCache::dump(const char *p_file, bool p_short) {
 #ifdef DEBUG_ENABLED
-	lock.read_lock();
-
 	Map<String, int> type_count;
 
 	FileAccess *f = nullptr;
@@ -524,21 +543,28 @@ void ResourceCache::dump(const char *p_file, bool p_short) {
 		ERR_FAIL_COND_MSG(!f, "Cannot create file at path '" + String(p_file) + "'.");
 	}
 
-	const String *K = nullptr;
-	while ((K = resources.next(K))) {
-		Resource *r = resources[*K];
+	for (int i = 0; i < SHARD_COUNT; i++) {
+		Shard &shard = shards[i];
+		shard.lock.read_lock();
 
-		if (!type_count.has(r->get_class())) {
-			type_count[r->get_class()] = 0;
-		}
+		const String *K = nullptr;
+		while ((K = shard.resources.next(K))) {
+			Resource *r = shard.resources[*K];
+
+			if (!type_count.has(r->get_class())) {
+				type_count[r->get_class()] = 0;
+			}
 
-		type_count[r->get_class()]++;
+			type_count[r->get_class()]++;
 
-		if (!p_short) {
-			if (f) {
-				f->store_line(r->get_class() + ": " + r->get_path());
+			if (!p_short) {
+				if (f) {
+					f->store_line(r->get_class() + ": " + r->get_path());
+				}
 			}
 		}
+
+		shard.lock.read_unlock();
 	}
 
 	for (const KeyValue<String, int> &E : type_count) {
@@ -550,8 +576,6 @@ void ResourceCache::dump(const char *p_file, bool p_short) {
 		f->close();
 		memdelete(f);
 	}
-
-	lock.read_unlock();
 #else
 	WARN_PRINT("ResourceCache::dump only with in debug builds.");
 #endif
@@ -153,8 +153,25 @@ typedef Ref<Resource> RES;
 class ResourceCache {
 	friend class Resource;
 	friend class ResourceLoader; //need the lock
-	static RWLock lock;
-	static HashMap<String, Resource *> resources;
+
+	// Split by path hash, each shard with its own lock, so that threads loading
+	// different resources don't all contend on one lock.
+	enum {
+		SHARD_COUNT = 32
+	};
+
+	struct Shard {
+		RWLock lock;
+		HashMap<String, Resource *> resources;
+	};
+
+	static Shard shards[SHARD_COUNT];
+
+	_FORCE_INLINE_ static Shard &_get_shard(const String &p_path) {
+		return shards[p_path.hash() & (SHARD_COUNT - 1)];
+	}
+	static void _erase(const String &p_path);
+
 #ifdef TOOLS_ENABLED
 	static HashMap<String, HashMap<String, String>> resource_path_cache; // Each tscn has a set of resource paths and IDs.
 	static RWLock path_cache_lock;
@@ -167,6 +184,8 @@ public:
 	static void reload_externals();
 	static bool has(const String &p_path);
 	static Resource *get(const String &p_path);
+	// Unlike get(), safe while other threads may free the resource.
+	static Ref<Resource> get_ref(const String &p_path);
 	static void dump(const char *p_file = nullptr, bool p_short = false);
 	static void get_cached_resources(List<Ref<Resource>> *p_resources);
 	static int get_cached_resource_count();
@@ -316,6 +316,12 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 
 					if (using_named_scene_ids) { // New format.
 						ERR_FAIL_INDEX_V((int)index, internal_resources.size(), ERR_PARSE_ERROR);
+						if (lazy_load && !internal_resources[index].loading) {
+							Error err = _load_referenced_internal_resource(index);
+							if (err != OK) {
+								return err;
+							}
+						}
 						path = internal_resources[index].path;
 					} else {
 						path += res_path + "::" + itos(index);
@@ -360,6 +366,12 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 						WARN_PRINT("Broken external resource! (index out of size)");
 						r_v = Variant();
 					} else {
+						if (!external_resources[erindex].loaded) {
+							Error err = _load_external_resource(erindex);
+							if (err != OK) {
+								return err;
+							}
+						}
 						if (external_resources[erindex].cache.is_null()) {
 							//cache not here yet, wait for it?
 							if (use_sub_threads) {
@@ -612,168 +624,200 @@ Ref<Resource> ResourceLoaderBinary::get_resource() {
 	return resource;
 }
 
-Error ResourceLoaderBinary::load() {
-	if (error != OK) {
-		return error;
-	}
-
-	int stage = 0;
+Error ResourceLoaderBinary::_load_external_resource(int p_index) {
+	ExtResource &er = external_resources.write[p_index];
+	er.loaded = true;
 
-	for (int i = 0; i < external_resources.size(); i++) {
-		String path = external_resources[i].path;
+	String path = er.path;
 
-		if (remaps.has(path)) {
-			path = remaps[path];
-		}
+	if (remaps.has(path)) {
+		path = remaps[path];
+	}
 
-		if (path.find("://") == -1 && path.is_relative_path()) {
-			// path is relative to file being loaded, so convert to a resource path
-			path = ProjectSettings::get_singleton()->localize_path(path.get_base_dir().plus_file(external_resources[i].path));
-		}
+	if (path.find("://") == -1 && path.is_relative_path()) {
+		// path is relative to file being loaded, so convert to a resource path
+		path = ProjectSettings::get_singleton()->localize_path(path.get_base_dir().plus_file(er.path));
+	}
 
-		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
+	er.path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
 
-		if (!use_sub_threads) {
-			external_resources.write[i].cache = ResourceLoader::load(path, external_resources[i].type);
+	if (!use_sub_threads) {
+		er.cache = ResourceLoader::load(path, er.type);
 
-			if (external_resources[i].cache.is_null()) {
-				if (!ResourceLoader::get_abort_on_missing_resources()) {
-					ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
-				} else {
-					error = ERR_FILE_MISSING_DEPENDENCIES;
-					ERR_FAIL_V_MSG(error, "Can't load dependency: " + path + ".");
-				}
+		if (er.cache.is_null()) {
+			if (!ResourceLoader::get_abort_on_missing_resources()) {
+				ResourceLoader::notify_dependency_error(local_path, path, er.type);
+			} else {
+				error = ERR_FILE_MISSING_DEPENDENCIES;
+				ERR_FAIL_V_MSG(error, "Can't load dependency: " + path + ".");
 			}
+		}
 
-		} else {
-			Error err = ResourceLoader::load_threaded_request(path, external_resources[i].type, use_sub_threads, ResourceFormatLoader::CACHE_MODE_REUSE, local_path);
-			if (err != OK) {
-				if (!ResourceLoader::get_abort_on_missing_resources()) {
-					ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
-				} else {
-					error = ERR_FILE_MISSING_DEPENDENCIES;
-					ERR_FAIL_V_MSG(error, "Can't load dependency: " + path + ".");
-				}
+	} else {
+		Error err = ResourceLoader::load_threaded_request(path, er.type, use_sub_threads, ResourceFormatLoader::CACHE_MODE_REUSE, local_path);
+		if (err != OK) {
+			if (!ResourceLoader::get_abort_on_missing_resources()) {
+				ResourceLoader::notify_dependency_error(local_path, path, er.type);
+			} else {
+				error = ERR_FILE_MISSING_DEPENDENCIES;
+				ERR_FAIL_V_MSG(error, "Can't load dependency: " + path + ".");
 			}
 		}
-
-		stage++;
 	}
 
-	for (int i = 0; i < internal_resources.size(); i++) {
-		bool main = i == (internal_resources.size() - 1);
+	return OK;
+}
 
-		//maybe it is loaded already
-		String path;
-		String id;
+Error ResourceLoaderBinary::_load_internal_resource(int p_index, bool p_main) {
+	//maybe it is loaded already
+	String path;
+	String id;
 
-		if (!main) {
-			path = internal_resources[i].path;
+	if (!p_main) {
+		path = internal_resources[p_index].path;
 
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				id = path;
-				path = res_path + "::" + path;
+		if (path.begins_with("local://")) {
+			path = path.replace_first("local://", "");
+			id = path;
+			path = res_path + "::" + path;
 
-				internal_resources.write[i].path = path; // Update path.
-			}
+			internal_resources.write[p_index].path = path; // Update path.
+		}
 
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE) {
-				if (ResourceCache::has(path)) {
-					//already loaded, don't do anything
-					stage++;
-					error = OK;
-					continue;
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE) {
+			if (ResourceCache::has(path)) {
+				//already loaded, don't do anything
+				if (lazy_load) {
+					RES cached(ResourceCache::get(path));
+					if (cached.is_valid()) {
+						internal_index_cache[path] = cached;
+					}
 				}
+				return OK;
 			}
-		} else {
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
-				path = res_path;
-			}
 		}
+	} else {
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
+			path = res_path;
+		}
+	}
 
-		uint64_t offset = internal_resources[i].offset;
+	uint64_t offset = internal_resources[p_index].offset;
 
-		f->seek(offset);
+	f->seek(offset);
 
-		String t = get_unicode_string();
+	String t = get_unicode_string();
 
-		RES res;
+	RES res;
 
-		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
-			//use the existing one
-			Resource *r = ResourceCache::get(path);
-			if (r->get_class() == t) {
-				r->reset_state();
-				res = Ref<Resource>(r);
-			}
+	if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
+		//use the existing one
+		Resource *r = ResourceCache::get(path);
+		if (r->get_class() == t) {
+			r->reset_state();
+			res = Ref<Resource>(r);
 		}
+	}
 
-		if (res.is_null()) {
-			//did not replace
-
-			Object *obj = ClassDB::instantiate(t);
-			if (!obj) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
-			}
+	if (res.is_null()) {
+		//did not replace
 
-			Resource *r = Object::cast_to<Resource>(obj);
-			if (!r) {
-				String obj_class = obj->get_class();
-				error = ERR_FILE_CORRUPT;
-				memdelete(obj); //bye
-				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
-			}
+		Object *obj = ClassDB::instantiate(t);
+		if (!obj) {
+			error = ERR_FILE_CORRUPT;
+			ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
+		}
 
-			res = RES(r);
-			if (path != String() && cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
-				r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); //if got here because the resource with same path has different type, replace it
-			}
-			r->set_scene_unique_id(id);
+		Resource *r = Object::cast_to<Resource>(obj);
+		if (!r) {
+			String obj_class = obj->get_class();
+			error = ERR_FILE_CORRUPT;
+			memdelete(obj); //bye
+			ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
 		}
 
-		if (!main) {
-			internal_index_cache[path] = res;
+		res = RES(r);
+		if (path != String() && cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
+			r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); //if got here because the resource with same path has different type, replace it
 		}
+		r->set_scene_unique_id(id);
+	}
 
-		int pc = f->get_32();
+	if (!p_main) {
+		internal_index_cache[path] = res;
+	}
 
-		//set properties
+	int pc = f->get_32();
 
-		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+	//set properties
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
-			}
+	for (int j = 0; j < pc; j++) {
+		StringName name = _get_string();
 
-			Variant value;
+		if (name == StringName()) {
+			error = ERR_FILE_CORRUPT;
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
+		}
 
-			error = parse_variant(value);
-			if (error) {
-				return error;
-			}
+		Variant value;
 
-			res->set(name, value);
+		error = parse_variant(value);
+		if (error) {
+			return error;
 		}
+
+		res->set(name, value);
+	}
 #ifdef TOOLS_ENABLED
-		res->set_edited(false);
+	res->set_edited(false);
 #endif
-		stage++;
+
+	resource_cache.push_back(res);
+
+	if (p_main) {
+		resource = res;
+	}
+
+	return OK;
+}
+
+Error ResourceLoaderBinary::_load_referenced_internal_resource(int p_index) {
+	ERR_FAIL_COND_V_MSG(p_index == internal_resources.size() - 1, ERR_FILE_CORRUPT, "Sub-resource refers to the main resource: " + local_path + ".");
+
+	internal_resources.write[p_index].loading = true;
+	uint64_t pos = f->get_position();
+	Error err = _load_internal_resource(p_index, false);
+	f->seek(pos);
+	return err;
+}
+
+Error ResourceLoaderBinary::load() {
+	if (error != OK) {
+		return error;
+	}
+
+	for (int i = 0; i < external_resources.size(); i++) {
+		error = _load_external_resource(i);
+		if (error != OK) {
+			return error;
+		}
+	}
+
+	for (int i = 0; i < internal_resources.size(); i++) {
+		bool main = i == (internal_resources.size() - 1);
+
+		error = _load_internal_resource(i, main);
+		if (error != OK) {
+			return error;
+		}
 
 		if (progress) {
 			*progress = (i + 1) / float(internal_resources.size());
 		}
 
-		resource_cache.push_back(res);
-
 		if (main) {
 			f->close();
-			resource = res;
 			resource->set_as_translation_remapped(translation_remapped);
-			error = OK;
 			return OK;
 		}
 	}
@@ -781,6 +825,50 @@ Error ResourceLoaderBinary::load() {
 	return ERR_FILE_EOF;
 }
 
+Error ResourceLoaderBinary::load_sub_resource(const String &p_id) {
+	if (error != OK) {
+		return error;
+	}
+
+	// Only decode what the sub-resource refers to, dependencies are loaded the first time they are found.
+	lazy_load = true;
+	use_sub_threads = false;
+
+	if (!using_named_scene_ids) {
+		error = ERR_UNAVAILABLE;
+		f->close();
+		ERR_FAIL_V_MSG(error, "Loading single sub-resources needs a file saved with named scene IDs: " + local_path + ".");
+	}
+
+	String local_id = "local://" + p_id;
+	int index = -1;
+	for (int i = 0; i < internal_resources.size() - 1; i++) { // The last one is the main resource.
+		if (internal_resources[i].path == local_id) {
+			index = i;
+			break;
+		}
+	}
+
+	if (index == -1) {
+		error = ERR_DOES_NOT_EXIST;
+		f->close();
+		ERR_FAIL_V_MSG(error, "Sub-resource '" + p_id + "' not found in: " + local_path + ".");
+	}
+
+	internal_resources.write[index].loading = true;
+	error = _load_internal_resource(index, false);
+	f->close();
+	if (error != OK) {
+		return error;
+	}
+
+	String path = res_path + "::" + p_id;
+	if (internal_index_cache.has(path)) {
+		resource = internal_index_cache[path];
+	}
+	return resource.is_valid() ? OK : ERR_CANT_ACQUIRE_RESOURCE;
+}
+
 void ResourceLoaderBinary::set_translation_remapped(bool p_remapped) {
 	translation_remapped = p_remapped;
 }
@@ -1044,6 +1132,34 @@ RES ResourceFormatLoaderBinary::load(const String &p_path, const String &p_origi
 	return loader.resource;
 }
 
+RES ResourceFormatLoaderBinary::load_sub_resource(const String &p_path, const String &p_id, Error *r_error, CacheMode p_cache_mode) {
+	if (r_error) {
+		*r_error = ERR_FILE_CANT_OPEN;
+	}
+
+	Error err;
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ, &err);
+
+	ERR_FAIL_COND_V_MSG(err != OK, RES(), "Cannot open file '" + p_path + "'.");
+
+	ResourceLoaderBinary loader;
+	loader.cache_mode = p_cache_mode;
+	loader.local_path = ProjectSettings::get_singleton()->localize_path(p_path);
+	loader.res_path = loader.local_path;
+	loader.open(f);
+
+	err = loader.load_sub_resource(p_id);
+
+	if (r_error) {
+		*r_error = err;
+	}
+
+	if (err) {
+		return RES();
+	}
+	return loader.resource;
+}
+
 void ResourceFormatLoaderBinary::get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions) const {
 	if (p_type == "") {
 		get_recognized_extensions(p_extensions);
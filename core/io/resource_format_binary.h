@@ -61,6 +61,7 @@ class ResourceLoaderBinary {
 		String type;
 		ResourceUID::ID uid = ResourceUID::INVALID_ID;
 		RES cache;
+		bool loaded = false;
 	};
 
 	bool using_named_scene_ids = false;
@@ -72,10 +73,12 @@ class ResourceLoaderBinary {
 	struct IntResource {
 		String path;
 		uint64_t offset;
+		bool loading = false;
 	};
 
 	Vector<IntResource> internal_resources;
 	Map<String, RES> internal_index_cache;
+	bool lazy_load = false;
 
 	String get_unicode_string();
 	void _advance_padding(uint32_t p_len);
@@ -88,6 +91,9 @@ class ResourceLoaderBinary {
 	friend class ResourceFormatLoaderBinary;
 
 	Error parse_variant(Variant &r_v);
+	Error _load_external_resource(int p_index);
+	Error _load_internal_resource(int p_index, bool p_main);
+	Error _load_referenced_internal_resource(int p_index);
 
 	Map<String, RES> dependency_cache;
 
@@ -95,6 +101,7 @@ public:
 	void set_local_path(const String &p_local_path);
 	Ref<Resource> get_resource();
 	Error load();
+	Error load_sub_resource(const String &p_id); // Loads a single sub-resource and only what it refers to.
 	void set_translation_remapped(bool p_remapped);
 
 	void set_remaps(const Map<String, String> &p_remaps) { remaps = p_remaps; }
@@ -116,6 +123,8 @@ public:
 	virtual ResourceUID::ID get_resource_uid(const String &p_path) const;
 	virtual void get_dependencies(const String &p_path, List<String> *p_dependencies, bool p_add_types = false);
 	virtual Error rename_dependencies(const String &p_path, const Map<String, String> &p_map);
+
+	static RES load_sub_resource(const String &p_path, const String &p_id, Error *r_error = nullptr, CacheMode p_cache_mode = CACHE_MODE_REUSE);
 };
 
 class ResourceFormatSaverBinaryInstance {
@@ -31,6 +31,7 @@
 #include "resource_loader.h"
 
 #include "core/config/project_settings.h"
+#include "core/debugger/trace_zones.h"
 #include "core/io/file_access.h"
 #include "core/io/resource_importer.h"
 #include "core/os/os.h"
@@ -186,6 +187,8 @@ void ResourceFormatLoader::_bind_methods() {
 ///////////////////////////////////
 
 RES ResourceLoader::_load(const String &p_path, const String &p_original_path, const String &p_type_hint, ResourceFormatLoader::CacheMode p_cache_mode, Error *r_error, bool p_use_sub_threads, float *r_progress) {
+	Memory::TagScope memory_tag(Memory::TAG_RESOURCES);
+
 	bool found = false;
 
 	// Try all loaders and pick the first match for the type hint
@@ -213,15 +216,37 @@ RES ResourceLoader::_load(const String &p_path, const String &p_original_path, c
 	ERR_FAIL_V_MSG(RES(), "No loader found for resource: " + p_path + ".");
 }
 
+// Must be called with thread_load_mutex locked.
+void ResourceLoader::_thread_load_start(ThreadLoadTask *p_task) {
+	thread_load_waiting.erase(p_task);
+	p_task->start_semaphore->post();
+}
+
+// Starts the waiting task with the highest priority, the oldest request among equals.
+void ResourceLoader::_thread_load_start_next() {
+	ThreadLoadTask *next = thread_load_waiting[0];
+	for (uint32_t i = 1; i < thread_load_waiting.size(); i++) {
+		ThreadLoadTask *task = thread_load_waiting[i];
+		if (task->priority > next->priority || (task->priority == next->priority && task->request_order < next->request_order)) {
+			next = task;
+		}
+	}
+	_thread_load_start(next);
+}
+
 void ResourceLoader::_thread_load_function(void *p_userdata) {
 	ThreadLoadTask &load_task = *(ThreadLoadTask *)p_userdata;
 	load_task.loader_id = Thread::get_caller_id();
 
-	if (load_task.semaphore) {
+	if (load_task.start_semaphore) {
 		//this is an actual thread, so wait for Ok from semaphore
-		thread_load_semaphore->wait(); //wait until its ok to start loading
+		load_task.start_semaphore->wait(); //wait until its ok to start loading
+	}
+	if (load_task.cancelled) {
+		load_task.error = ERR_SKIP;
+	} else {
+		load_task.resource = _load(load_task.remapped_path, load_task.remapped_path != load_task.local_path ? load_task.local_path : String(), load_task.type_hint, load_task.cache_mode, &load_task.error, load_task.use_sub_threads, &load_task.progress);
 	}
-	load_task.resource = _load(load_task.remapped_path, load_task.remapped_path != load_task.local_path ? load_task.local_path : String(), load_task.type_hint, load_task.cache_mode, &load_task.error, load_task.use_sub_threads, &load_task.progress);
 
 	load_task.progress = 1.0; //it was fully loaded at this point, so force progress to 1.0
 
@@ -232,21 +257,24 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 		load_task.status = THREAD_LOAD_LOADED;
 	}
 	if (load_task.semaphore) {
-		if (load_task.start_next && thread_waiting_count > 0) {
-			thread_waiting_count--;
+		if (load_task.cancelled) {
+			//never took a loading slot
+		} else if (load_task.start_next && thread_load_waiting.size() > 0) {
 			//thread loading count remains constant, this ends but another one begins
-			thread_load_semaphore->post();
+			_thread_load_start_next();
 		} else {
 			thread_loading_count--; //no threads waiting, just reduce loading count
 		}
 
-		print_lt("END: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_waiting_count) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
+		print_lt("END: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_load_waiting.size()) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
 
 		for (int i = 0; i < load_task.poll_requests; i++) {
 			load_task.semaphore->post();
 		}
 		memdelete(load_task.semaphore);
 		load_task.semaphore = nullptr;
+		memdelete(load_task.start_semaphore);
+		load_task.start_semaphore = nullptr;
 	}
 
 	if (load_task.resource.is_valid()) {
@@ -328,6 +356,10 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 		load_task.type_hint = p_type_hint;
 		load_task.cache_mode = p_cache_mode;
 		load_task.use_sub_threads = p_use_sub_threads;
+		load_task.request_order = thread_load_request_count++;
+		if (p_source_resource != String()) {
+			load_task.priority = thread_load_tasks[p_source_resource].priority; // Dependencies are as urgent as what needs them.
+		}
 
 		{ //must check if resource is already loaded before attempting to load it in a thread
 
@@ -335,23 +367,12 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 				thread_load_mutex->unlock();
 				ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "Attempted to load a resource already being loaded from this thread, cyclic reference?");
 			}
-			//lock first if possible
-			ResourceCache::lock.read_lock();
-
-			//get ptr
-			Resource **rptr = ResourceCache::resources.getptr(local_path);
-
-			if (rptr) {
-				RES res(*rptr);
-				//it is possible this resource was just freed in a thread. If so, this referencing will not work and resource is considered not cached
-				if (res.is_valid()) {
-					//referencing is fine
-					load_task.resource = res;
-					load_task.status = THREAD_LOAD_LOADED;
-					load_task.progress = 1.0;
-				}
+			RES res = ResourceCache::get_ref(local_path);
+			if (res.is_valid()) {
+				load_task.resource = res;
+				load_task.status = THREAD_LOAD_LOADED;
+				load_task.progress = 1.0;
 			}
-			ResourceCache::lock.read_unlock();
 		}
 
 		if (p_source_resource != String()) {
@@ -366,17 +387,20 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 	if (load_task.resource.is_null()) { //needs to be loaded in thread
 
 		load_task.semaphore = memnew(Semaphore);
+		load_task.start_semaphore = memnew(Semaphore);
 		if (thread_loading_count < thread_load_max) {
 			thread_loading_count++;
-			thread_load_semaphore->post(); //we have free threads, so allow one
+			load_task.start_semaphore->post(); //we have free threads, so allow one
 		} else {
-			thread_waiting_count++;
+			thread_load_waiting.push_back(&load_task);
 		}
 
-		print_lt("REQUEST: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_waiting_count) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
+		print_lt("REQUEST: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_load_waiting.size()) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
 
+		Thread::Settings settings;
+		settings.core_class = thread_load_core_class;
 		load_task.thread = memnew(Thread);
-		load_task.thread->start(_thread_load_function, &thread_load_tasks[local_path]);
+		load_task.thread->start(_thread_load_function, &thread_load_tasks[local_path], settings);
 		load_task.loader_id = load_task.thread->get_id();
 	}
 
@@ -456,17 +480,20 @@ RES ResourceLoader::load_threaded_get(const String &p_path, Error *r_error) {
 			// This ensures loading is never blocked and that is also within
 			// the maximum number of active threads.
 
-			if (thread_waiting_count > 0) {
-				thread_waiting_count--;
+			if (thread_load_waiting.size() > 0) {
 				thread_loading_count++;
-				thread_load_semaphore->post();
+				if (thread_load_waiting.find(&load_task) != -1) {
+					_thread_load_start(&load_task); //what we wait for goes first
+				} else {
+					_thread_load_start_next();
+				}
 
 				load_task.start_next = false; //do not start next since we are doing it here
 			}
 
 			thread_suspended_count++;
 
-			print_lt("GET: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_waiting_count) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
+			print_lt("GET: load count: " + itos(thread_loading_count) + " / wait count: " + itos(thread_load_waiting.size()) + " / suspended count: " + itos(thread_suspended_count) + " / active: " + itos(thread_loading_count - thread_suspended_count));
 		}
 
 		thread_load_mutex->unlock();
@@ -504,7 +531,46 @@ RES ResourceLoader::load_threaded_get(const String &p_path, Error *r_error) {
 	return resource;
 }
 
+Error ResourceLoader::load_threaded_set_priority(const String &p_path, int p_priority) {
+	String local_path = _validate_local_path(p_path);
+
+	MutexLock lock(*thread_load_mutex);
+	ThreadLoadTask *load_task = thread_load_tasks.getptr(local_path);
+	ERR_FAIL_COND_V_MSG(!load_task, ERR_INVALID_PARAMETER, "There is no thread loading resource '" + local_path + "'.");
+
+	// Only matters while the task is waiting for a free thread.
+	load_task->priority = p_priority;
+	return OK;
+}
+
+Error ResourceLoader::load_threaded_cancel(const String &p_path) {
+	String local_path = _validate_local_path(p_path);
+
+	MutexLock lock(*thread_load_mutex);
+	ThreadLoadTask *load_task = thread_load_tasks.getptr(local_path);
+	ERR_FAIL_COND_V_MSG(!load_task, ERR_INVALID_PARAMETER, "There is no thread loading resource '" + local_path + "'.");
+
+	if (thread_load_waiting.find(load_task) == -1) {
+		return ERR_BUSY; // Already loading or loaded.
+	}
+
+	load_task->cancelled = true;
+	_thread_load_start(load_task); // Let the thread finish without loading.
+	return OK;
+}
+
+int ResourceLoader::get_threaded_load_pending_count() {
+	if (!thread_load_mutex) {
+		return 0;
+	}
+
+	MutexLock lock(*thread_load_mutex);
+	return thread_loading_count + thread_load_waiting.size();
+}
+
 RES ResourceLoader::load(const String &p_path, const String &p_type_hint, ResourceFormatLoader::CacheMode p_cache_mode, Error *r_error) {
+	TRACE_ZONE("ResourceLoader::load");
+
 	if (r_error) {
 		*r_error = ERR_CANT_OPEN;
 	}
@@ -530,27 +596,16 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, Resour
 		}
 
 		//Is it cached?
-		ResourceCache::lock.read_lock();
-
-		Resource **rptr = ResourceCache::resources.getptr(local_path);
-
-		if (rptr) {
-			RES res(*rptr);
-
-			//it is possible this resource was just freed in a thread. If so, this referencing will not work and resource is considered not cached
-			if (res.is_valid()) {
-				ResourceCache::lock.read_unlock();
-				thread_load_mutex->unlock();
-
-				if (r_error) {
-					*r_error = OK;
-				}
+		RES res = ResourceCache::get_ref(local_path);
+		if (res.is_valid()) {
+			thread_load_mutex->unlock();
 
-				return res; //use cached
+			if (r_error) {
+				*r_error = OK;
 			}
-		}
 
-		ResourceCache::lock.read_unlock();
+			return res; //use cached
+		}
 
 		//load using task (but this thread)
 		ThreadLoadTask load_task;
@@ -906,7 +961,7 @@ String ResourceLoader::path_remap(const String &p_path) {
 }
 
 void ResourceLoader::reload_translation_remaps() {
-	ResourceCache::lock.read_lock();
+	remapped_list_lock.read_lock();
 
 	List<Resource *> to_reload;
 	SelfList<Resource> *E = remapped_list.first();
@@ -916,7 +971,7 @@ void ResourceLoader::reload_translation_remaps() {
 		E = E->next();
 	}
 
-	ResourceCache::lock.read_unlock();
+	remapped_list_lock.read_unlock();
 
 	//now just make sure to not delete any of these resources while changing locale..
 	while (to_reload.front()) {
@@ -1053,14 +1108,11 @@ void ResourceLoader::initialize() {
 	thread_load_mutex = memnew(Mutex);
 	thread_load_max = OS::get_singleton()->get_processor_count();
 	thread_loading_count = 0;
-	thread_waiting_count = 0;
 	thread_suspended_count = 0;
-	thread_load_semaphore = memnew(Semaphore);
 }
 
 void ResourceLoader::finalize() {
 	memdelete(thread_load_mutex);
-	memdelete(thread_load_semaphore);
 }
 
 ResourceLoadErrorNotify ResourceLoader::err_notify = nullptr;
@@ -1074,14 +1126,16 @@ bool ResourceLoader::timestamp_on_load = false;
 
 Mutex *ResourceLoader::thread_load_mutex = nullptr;
 HashMap<String, ResourceLoader::ThreadLoadTask> ResourceLoader::thread_load_tasks;
-Semaphore *ResourceLoader::thread_load_semaphore = nullptr;
+LocalVector<ResourceLoader::ThreadLoadTask *> ResourceLoader::thread_load_waiting;
+uint64_t ResourceLoader::thread_load_request_count = 0;
 
 int ResourceLoader::thread_loading_count = 0;
-int ResourceLoader::thread_waiting_count = 0;
 int ResourceLoader::thread_suspended_count = 0;
 int ResourceLoader::thread_load_max = 0;
+Thread::CoreClass ResourceLoader::thread_load_core_class = Thread::CORE_CLASS_ANY;
 
 SelfList<Resource>::List ResourceLoader::remapped_list;
+RWLock ResourceLoader::remapped_list_lock;
 HashMap<String, Vector<String>> ResourceLoader::translation_remaps;
 HashMap<String, String> ResourceLoader::path_remaps;
 
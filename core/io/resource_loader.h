@@ -36,6 +36,7 @@
 #include "core/object/script_language.h"
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
+#include "core/templates/local_vector.h"
 
 class ResourceFormatLoader : public RefCounted {
 	GDCLASS(ResourceFormatLoader, RefCounted);
@@ -117,6 +118,7 @@ private:
 	friend class Resource;
 
 	static SelfList<Resource>::List remapped_list;
+	static RWLock remapped_list_lock;
 
 	friend class ResourceFormatImporter;
 	friend class ResourceInteractiveLoader;
@@ -131,6 +133,10 @@ private:
 		Thread *thread = nullptr;
 		Thread::ID loader_id = 0;
 		Semaphore *semaphore = nullptr;
+		Semaphore *start_semaphore = nullptr; // Posted when the task is allowed to start loading.
+		int priority = 0;
+		uint64_t request_order = 0;
+		bool cancelled = false;
 		String local_path;
 		String remapped_path;
 		String type_hint;
@@ -150,11 +156,15 @@ private:
 	static void _thread_load_function(void *p_userdata);
 	static Mutex *thread_load_mutex;
 	static HashMap<String, ThreadLoadTask> thread_load_tasks;
-	static Semaphore *thread_load_semaphore;
-	static int thread_waiting_count;
+	static LocalVector<ThreadLoadTask *> thread_load_waiting; // Requested but not started yet, for lack of free threads.
+	static uint64_t thread_load_request_count;
 	static int thread_loading_count;
 	static int thread_suspended_count;
 	static int thread_load_max;
+	static Thread::CoreClass thread_load_core_class;
+
+	static void _thread_load_start(ThreadLoadTask *p_task);
+	static void _thread_load_start_next();
 
 	static float _dependency_get_progress(const String &p_path);
 
@@ -162,6 +172,9 @@ public:
 	static Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false, ResourceFormatLoader::CacheMode p_cache_mode = ResourceFormatLoader::CACHE_MODE_REUSE, const String &p_source_resource = String());
 	static ThreadLoadStatus load_threaded_get_status(const String &p_path, float *r_progress = nullptr);
 	static RES load_threaded_get(const String &p_path, Error *r_error = nullptr);
+	static Error load_threaded_set_priority(const String &p_path, int p_priority);
+	static Error load_threaded_cancel(const String &p_path);
+	static int get_threaded_load_pending_count();
 
 	static RES load(const String &p_path, const String &p_type_hint = "", ResourceFormatLoader::CacheMode p_cache_mode = ResourceFormatLoader::CACHE_MODE_REUSE, Error *r_error = nullptr);
 	static bool exists(const String &p_path, const String &p_type_hint = "");
@@ -181,6 +194,8 @@ public:
 	static void set_timestamp_on_load(bool p_timestamp) { timestamp_on_load = p_timestamp; }
 	static bool get_timestamp_on_load() { return timestamp_on_load; }
 
+	static void set_thread_load_core_class(Thread::CoreClass p_core_class) { thread_load_core_class = p_core_class; }
+
 	static void notify_load_error(const String &p_err) {
 		if (err_notify) {
 			err_notify(err_notify_ud, p_err);
@@ -49,39 +49,45 @@ Error UDPServer::poll() {
 		return ERR_UNCONFIGURED;
 	}
 	Error err;
-	int read;
-	IPAddress ip;
-	uint16_t port;
+	NetSocket::Datagram datagrams[RECV_BATCH_SIZE];
 	while (true) {
-		err = _sock->recvfrom(recv_buffer, sizeof(recv_buffer), read, ip, port);
+		for (int i = 0; i < RECV_BATCH_SIZE; i++) {
+			datagrams[i].buffer = &recv_buffer[i * PACKET_BUFFER_SIZE];
+			datagrams[i].length = PACKET_BUFFER_SIZE;
+		}
+		int received = 0;
+		err = _sock->recvfrom_batch(datagrams, RECV_BATCH_SIZE, received);
 		if (err != OK) {
 			if (err == ERR_BUSY) {
 				break;
 			}
 			return FAILED;
 		}
-		Peer p;
-		p.ip = ip;
-		p.port = port;
-		List<Peer>::Element *E = peers.find(p);
-		if (!E) {
-			E = pending.find(p);
-		}
-		if (E) {
-			E->get().peer->store_packet(ip, port, recv_buffer, read);
-		} else {
-			if (pending.size() >= max_pending_connections) {
-				// Drop connection.
-				continue;
+		for (int i = 0; i < received; i++) {
+			const NetSocket::Datagram &d = datagrams[i];
+			Peer p;
+			p.ip = d.ip;
+			p.port = d.port;
+			List<Peer>::Element *E = peers.find(p);
+			if (!E) {
+				E = pending.find(p);
+			}
+			if (E) {
+				E->get().peer->store_packet(d.ip, d.port, d.buffer, d.length);
+			} else {
+				if (pending.size() >= max_pending_connections) {
+					// Drop connection.
+					continue;
+				}
+				// It's a new peer, add it to the pending list.
+				Peer peer;
+				peer.ip = d.ip;
+				peer.port = d.port;
+				peer.peer = memnew(PacketPeerUDP);
+				peer.peer->connect_shared_socket(_sock, d.ip, d.port, this);
+				peer.peer->store_packet(d.ip, d.port, d.buffer, d.length);
+				pending.push_back(peer);
 			}
-			// It's a new peer, add it to the pending list.
-			Peer peer;
-			peer.ip = ip;
-			peer.port = port;
-			peer.peer = memnew(PacketPeerUDP);
-			peer.peer->connect_shared_socket(_sock, ip, port, this);
-			peer.peer->store_packet(ip, port, recv_buffer, read);
-			pending.push_back(peer);
 		}
 	}
 	return OK;
@@ -39,7 +39,8 @@ class UDPServer : public RefCounted {
 
 protected:
 	enum {
-		PACKET_BUFFER_SIZE = 65536
+		PACKET_BUFFER_SIZE = 65536,
+		RECV_BATCH_SIZE = 8,
 	};
 
 	struct Peer {
@@ -51,7 +52,7 @@ protected:
 			return (ip == p_other.ip && port == p_other.port);
 		}
 	};
-	uint8_t recv_buffer[PACKET_BUFFER_SIZE];
+	uint8_t recv_buffer[PACKET_BUFFER_SIZE * RECV_BATCH_SIZE];
 
 	List<Peer> peers;
 	List<Peer> pending;
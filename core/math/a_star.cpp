@@ -58,10 +58,13 @@ void AStar::add_point(int p_id, const Vector3 &p_pos, real_t p_weight_scale) {
 		pt->id = p_id;
 		pt->pos = p_pos;
 		pt->weight_scale = p_weight_scale;
-		pt->prev_point = nullptr;
-		pt->open_pass = 0;
-		pt->closed_pass = 0;
 		pt->enabled = true;
+		if (free_point_indices.is_empty()) {
+			pt->index = point_index_count++;
+		} else {
+			pt->index = free_point_indices[free_point_indices.size() - 1];
+			free_point_indices.resize(free_point_indices.size() - 1);
+		}
 		points.set(p_id, pt);
 	} else {
 		found_pt->pos = p_pos;
@@ -123,6 +126,7 @@ void AStar::remove_point(int p_id) {
 		(*it.value)->unlinked_neighbours.remove(p->id);
 	}
 
+	free_point_indices.push_back(p->index);
 	memdelete(p);
 	points.remove(p_id);
 	last_free_id = p_id;
@@ -249,6 +253,8 @@ void AStar::clear() {
 	}
 	segments.clear();
 	points.clear();
+	point_index_count = 0;
+	free_point_indices.clear();
 }
 
 int AStar::get_point_count() const {
@@ -319,8 +325,31 @@ Vector3 AStar::get_closest_position_in_segment(const Vector3 &p_point) const {
 	return closest_point;
 }
 
-bool AStar::_solve(Point *begin_point, Point *end_point) {
-	pass++;
+AStar::SearchState *AStar::_alloc_search_state() {
+	SearchState *state = nullptr;
+	{
+		MutexLock lock(search_state_mutex);
+		if (!free_search_states.is_empty()) {
+			state = free_search_states[free_search_states.size() - 1];
+			free_search_states.resize(free_search_states.size() - 1);
+		}
+	}
+	if (!state) {
+		state = memnew(SearchState);
+	}
+	if (state->nodes.size() < point_index_count) {
+		state->nodes.resize(point_index_count);
+	}
+	return state;
+}
+
+void AStar::_free_search_state(SearchState *p_state) {
+	MutexLock lock(search_state_mutex);
+	free_search_states.push_back(p_state);
+}
+
+bool AStar::_solve(SearchState &r_state, Point *begin_point, Point *end_point) {
+	uint64_t pass = ++r_state.pass;
 
 	if (!end_point->enabled) {
 		return false;
@@ -328,15 +357,19 @@ bool AStar::_solve(Point *begin_point, Point *end_point) {
 
 	bool found_route = false;
 
-	Vector<Point *> open_list;
-	SortArray<Point *, SortPoints> sorter;
+	Vector<SearchNode *> open_list;
+	SortArray<SearchNode *, SortPoints> sorter;
 
-	begin_point->g_score = 0;
-	begin_point->f_score = _estimate_cost(begin_point->id, end_point->id);
-	open_list.push_back(begin_point);
+	SearchNode *begin_node = &r_state.nodes[begin_point->index];
+	begin_node->point = begin_point;
+	begin_node->prev = nullptr;
+	begin_node->g_score = 0;
+	begin_node->f_score = _estimate_cost(begin_point->id, end_point->id);
+	open_list.push_back(begin_node);
 
 	while (!open_list.is_empty()) {
-		Point *p = open_list[0]; // The currently processed point
+		SearchNode *n = open_list[0]; // The currently processed point
+		Point *p = n->point;
 
 		if (p == end_point) {
 			found_route = true;
@@ -345,35 +378,37 @@ bool AStar::_solve(Point *begin_point, Point *end_point) {
 
 		sorter.pop_heap(0, open_list.size(), open_list.ptrw()); // Remove the current point from the open list
 		open_list.remove(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed
+		n->closed_pass = pass; // Mark the point as closed
 
 		for (OAHashMap<int, Point *>::Iterator it = p->neighbours.iter(); it.valid; it = p->neighbours.next_iter(it)) {
 			Point *e = *(it.value); // The neighbour point
+			SearchNode *en = &r_state.nodes[e->index];
 
-			if (!e->enabled || e->closed_pass == pass) {
+			if (!e->enabled || en->closed_pass == pass) {
 				continue;
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
+			real_t tentative_g_score = n->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
 
 			bool new_point = false;
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
-				open_list.push_back(e);
+			if (en->open_pass != pass) { // The point wasn't inside the open list.
+				en->open_pass = pass;
+				en->point = e;
+				open_list.push_back(en);
 				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			} else if (tentative_g_score >= en->g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, end_point->id);
+			en->prev = n;
+			en->g_score = tentative_g_score;
+			en->f_score = en->g_score + _estimate_cost(e->id, end_point->id);
 
 			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptrw());
+				sorter.push_heap(0, open_list.size() - 1, 0, en, open_list.ptrw());
 			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptrw());
+				sorter.push_heap(0, open_list.find(en), 0, en, open_list.ptrw());
 			}
 		}
 	}
@@ -433,16 +468,17 @@ Vector<Vector3> AStar::get_point_path(int p_from_id, int p_to_id) {
 	Point *begin_point = a;
 	Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point);
+	SearchState *state = _alloc_search_state();
+	bool found_route = _solve(*state, begin_point, end_point);
 	if (!found_route) {
+		_free_search_state(state);
 		return Vector<Vector3>();
 	}
 
-	Point *p = end_point;
-	int pc = 1; // Begin point
-	while (p != begin_point) {
+	SearchNode *end_node = &state->nodes[end_point->index];
+	int pc = 0;
+	for (SearchNode *n = end_node; n; n = n->prev) {
 		pc++;
-		p = p->prev_point;
 	}
 
 	Vector<Vector3> path;
@@ -451,16 +487,13 @@ Vector<Vector3> AStar::get_point_path(int p_from_id, int p_to_id) {
 	{
 		Vector3 *w = path.ptrw();
 
-		Point *p2 = end_point;
 		int idx = pc - 1;
-		while (p2 != begin_point) {
-			w[idx--] = p2->pos;
-			p2 = p2->prev_point;
+		for (SearchNode *n = end_node; n; n = n->prev) {
+			w[idx--] = n->point->pos;
 		}
-
-		w[0] = p2->pos; // Assign first
 	}
 
+	_free_search_state(state);
 	return path;
 }
 
@@ -482,16 +515,17 @@ Vector<int> AStar::get_id_path(int p_from_id, int p_to_id) {
 	Point *begin_point = a;
 	Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point);
+	SearchState *state = _alloc_search_state();
+	bool found_route = _solve(*state, begin_point, end_point);
 	if (!found_route) {
+		_free_search_state(state);
 		return Vector<int>();
 	}
 
-	Point *p = end_point;
-	int pc = 1; // Begin point
-	while (p != begin_point) {
+	SearchNode *end_node = &state->nodes[end_point->index];
+	int pc = 0;
+	for (SearchNode *n = end_node; n; n = n->prev) {
 		pc++;
-		p = p->prev_point;
 	}
 
 	Vector<int> path;
@@ -500,16 +534,13 @@ Vector<int> AStar::get_id_path(int p_from_id, int p_to_id) {
 	{
 		int *w = path.ptrw();
 
-		p = end_point;
 		int idx = pc - 1;
-		while (p != begin_point) {
-			w[idx--] = p->id;
-			p = p->prev_point;
+		for (SearchNode *n = end_node; n; n = n->prev) {
+			w[idx--] = n->point->id;
 		}
-
-		w[0] = p->id; // Assign first
 	}
 
+	_free_search_state(state);
 	return path;
 }
 
@@ -565,6 +596,9 @@ void AStar::_bind_methods() {
 
 AStar::~AStar() {
 	clear();
+	for (uint32_t i = 0; i < free_search_states.size(); i++) {
+		memdelete(free_search_states[i]);
+	}
 }
 
 /////////////////////////////////////////////////////////////
@@ -707,16 +741,17 @@ Vector<Vector2> AStar2D::get_point_path(int p_from_id, int p_to_id) {
 	AStar::Point *begin_point = a;
 	AStar::Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point);
+	AStar::SearchState *state = astar._alloc_search_state();
+	bool found_route = _solve(*state, begin_point, end_point);
 	if (!found_route) {
+		astar._free_search_state(state);
 		return Vector<Vector2>();
 	}
 
-	AStar::Point *p = end_point;
-	int pc = 1; // Begin point
-	while (p != begin_point) {
+	AStar::SearchNode *end_node = &state->nodes[end_point->index];
+	int pc = 0;
+	for (AStar::SearchNode *n = end_node; n; n = n->prev) {
 		pc++;
-		p = p->prev_point;
 	}
 
 	Vector<Vector2> path;
@@ -725,16 +760,13 @@ Vector<Vector2> AStar2D::get_point_path(int p_from_id, int p_to_id) {
 	{
 		Vector2 *w = path.ptrw();
 
-		AStar::Point *p2 = end_point;
 		int idx = pc - 1;
-		while (p2 != begin_point) {
-			w[idx--] = Vector2(p2->pos.x, p2->pos.y);
-			p2 = p2->prev_point;
+		for (AStar::SearchNode *n = end_node; n; n = n->prev) {
+			w[idx--] = Vector2(n->point->pos.x, n->point->pos.y);
 		}
-
-		w[0] = Vector2(p2->pos.x, p2->pos.y); // Assign first
 	}
 
+	astar._free_search_state(state);
 	return path;
 }
 
@@ -756,16 +788,17 @@ Vector<int> AStar2D::get_id_path(int p_from_id, int p_to_id) {
 	AStar::Point *begin_point = a;
 	AStar::Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point);
+	AStar::SearchState *state = astar._alloc_search_state();
+	bool found_route = _solve(*state, begin_point, end_point);
 	if (!found_route) {
+		astar._free_search_state(state);
 		return Vector<int>();
 	}
 
-	AStar::Point *p = end_point;
-	int pc = 1; // Begin point
-	while (p != begin_point) {
+	AStar::SearchNode *end_node = &state->nodes[end_point->index];
+	int pc = 0;
+	for (AStar::SearchNode *n = end_node; n; n = n->prev) {
 		pc++;
-		p = p->prev_point;
 	}
 
 	Vector<int> path;
@@ -774,21 +807,18 @@ Vector<int> AStar2D::get_id_path(int p_from_id, int p_to_id) {
 	{
 		int *w = path.ptrw();
 
-		p = end_point;
 		int idx = pc - 1;
-		while (p != begin_point) {
-			w[idx--] = p->id;
-			p = p->prev_point;
+		for (AStar::SearchNode *n = end_node; n; n = n->prev) {
+			w[idx--] = n->point->id;
 		}
-
-		w[0] = p->id; // Assign first
 	}
 
+	astar._free_search_state(state);
 	return path;
 }
 
-bool AStar2D::_solve(AStar::Point *begin_point, AStar::Point *end_point) {
-	astar.pass++;
+bool AStar2D::_solve(AStar::SearchState &r_state, AStar::Point *begin_point, AStar::Point *end_point) {
+	uint64_t pass = ++r_state.pass;
 
 	if (!end_point->enabled) {
 		return false;
@@ -796,15 +826,19 @@ bool AStar2D::_solve(AStar::Point *begin_point, AStar::Point *end_point) {
 
 	bool found_route = false;
 
-	Vector<AStar::Point *> open_list;
-	SortArray<AStar::Point *, AStar::SortPoints> sorter;
+	Vector<AStar::SearchNode *> open_list;
+	SortArray<AStar::SearchNode *, AStar::SortPoints> sorter;
 
-	begin_point->g_score = 0;
-	begin_point->f_score = _estimate_cost(begin_point->id, end_point->id);
-	open_list.push_back(begin_point);
+	AStar::SearchNode *begin_node = &r_state.nodes[begin_point->index];
+	begin_node->point = begin_point;
+	begin_node->prev = nullptr;
+	begin_node->g_score = 0;
+	begin_node->f_score = _estimate_cost(begin_point->id, end_point->id);
+	open_list.push_back(begin_node);
 
 	while (!open_list.is_empty()) {
-		AStar::Point *p = open_list[0]; // The currently processed point
+		AStar::SearchNode *n = open_list[0]; // The currently processed point
+		AStar::Point *p = n->point;
 
 		if (p == end_point) {
 			found_route = true;
@@ -813,35 +847,37 @@ bool AStar2D::_solve(AStar::Point *begin_point, AStar::Point *end_point) {
 
 		sorter.pop_heap(0, open_list.size(), open_list.ptrw()); // Remove the current point from the open list
 		open_list.remove(open_list.size() - 1);
-		p->closed_pass = astar.pass; // Mark the point as closed
+		n->closed_pass = pass; // Mark the point as closed
 
 		for (OAHashMap<int, AStar::Point *>::Iterator it = p->neighbours.iter(); it.valid; it = p->neighbours.next_iter(it)) {
 			AStar::Point *e = *(it.value); // The neighbour point
+			AStar::SearchNode *en = &r_state.nodes[e->index];
 
-			if (!e->enabled || e->closed_pass == astar.pass) {
+			if (!e->enabled || en->closed_pass == pass) {
 				continue;
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
+			real_t tentative_g_score = n->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
 
 			bool new_point = false;
 
-			if (e->open_pass != astar.pass) { // The point wasn't inside the open list.
-				e->open_pass = astar.pass;
-				open_list.push_back(e);
+			if (en->open_pass != pass) { // The point wasn't inside the open list.
+				en->open_pass = pass;
+				en->point = e;
+				open_list.push_back(en);
 				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			} else if (tentative_g_score >= en->g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, end_point->id);
+			en->prev = n;
+			en->g_score = tentative_g_score;
+			en->f_score = en->g_score + _estimate_cost(e->id, end_point->id);
 
 			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptrw());
+				sorter.push_heap(0, open_list.size() - 1, 0, en, open_list.ptrw());
 			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptrw());
+				sorter.push_heap(0, open_list.find(en), 0, en, open_list.ptrw());
 			}
 		}
 	}
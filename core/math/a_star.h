@@ -34,6 +34,8 @@
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/oa_hash_map.h"
 
 /**
@@ -50,23 +52,35 @@ class AStar : public RefCounted {
 		Point() {}
 
 		int id = 0;
+		uint32_t index = 0; // Dense, into SearchState::nodes.
 		Vector3 pos;
 		real_t weight_scale = 0;
 		bool enabled = false;
 
 		OAHashMap<int, Point *> neighbours = 4u;
 		OAHashMap<int, Point *> unlinked_neighbours = 4u;
+	};
 
-		// Used for pathfinding.
-		Point *prev_point = nullptr;
+	// Pathfinding data lives in a per query state instead of the points, so
+	// paths can be searched from several threads at once (as long as the graph
+	// isn't modified meanwhile). States are pooled and stamped with pass
+	// numbers, so they never need to be cleared between queries.
+	struct SearchNode {
+		Point *point = nullptr;
+		SearchNode *prev = nullptr;
 		real_t g_score = 0;
 		real_t f_score = 0;
 		uint64_t open_pass = 0;
 		uint64_t closed_pass = 0;
 	};
 
+	struct SearchState {
+		LocalVector<SearchNode> nodes;
+		uint64_t pass = 0;
+	};
+
 	struct SortPoints {
-		_FORCE_INLINE_ bool operator()(const Point *A, const Point *B) const { // Returns true when the Point A is worse than Point B.
+		_FORCE_INLINE_ bool operator()(const SearchNode *A, const SearchNode *B) const { // Returns true when the Point A is worse than Point B.
 			if (A->f_score > B->f_score) {
 				return true;
 			} else if (A->f_score < B->f_score) {
@@ -111,12 +125,18 @@ class AStar : public RefCounted {
 	};
 
 	int last_free_id = 0;
-	uint64_t pass = 1;
+	uint32_t point_index_count = 0;
+	LocalVector<uint32_t> free_point_indices;
 
 	OAHashMap<int, Point *> points;
 	Set<Segment> segments;
 
-	bool _solve(Point *begin_point, Point *end_point);
+	BinaryMutex search_state_mutex;
+	LocalVector<SearchState *> free_search_states;
+
+	SearchState *_alloc_search_state();
+	void _free_search_state(SearchState *p_state);
+	bool _solve(SearchState &r_state, Point *begin_point, Point *end_point);
 
 protected:
 	static void _bind_methods();
@@ -166,7 +186,7 @@ class AStar2D : public RefCounted {
 	GDCLASS(AStar2D, RefCounted);
 	AStar astar;
 
-	bool _solve(AStar::Point *begin_point, AStar::Point *end_point);
+	bool _solve(AStar::SearchState &r_state, AStar::Point *begin_point, AStar::Point *end_point);
 
 protected:
 	static void _bind_methods();
@@ -0,0 +1,570 @@
+/*************************************************************************/
+/*  a_star_grid_2d.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "a_star_grid_2d.h"
+
+#include "core/templates/sort_array.h"
+
+static real_t heuristic_euclidian(const Vector2i &p_from, const Vector2i &p_to) {
+	real_t dx = (real_t)ABS(p_to.x - p_from.x);
+	real_t dy = (real_t)ABS(p_to.y - p_from.y);
+	return (real_t)Math::sqrt(dx * dx + dy * dy);
+}
+
+static real_t heuristic_manhattan(const Vector2i &p_from, const Vector2i &p_to) {
+	real_t dx = (real_t)ABS(p_to.x - p_from.x);
+	real_t dy = (real_t)ABS(p_to.y - p_from.y);
+	return dx + dy;
+}
+
+static real_t heuristic_octile(const Vector2i &p_from, const Vector2i &p_to) {
+	real_t dx = (real_t)ABS(p_to.x - p_from.x);
+	real_t dy = (real_t)ABS(p_to.y - p_from.y);
+	real_t F = Math_SQRT2 - 1;
+	return (dx < dy) ? F * dx + dy : F * dy + dx;
+}
+
+static real_t heuristic_chebyshev(const Vector2i &p_from, const Vector2i &p_to) {
+	real_t dx = (real_t)ABS(p_to.x - p_from.x);
+	real_t dy = (real_t)ABS(p_to.y - p_from.y);
+	return MAX(dx, dy);
+}
+
+static real_t (*heuristics[AStarGrid2D::HEURISTIC_MAX])(const Vector2i &, const Vector2i &) = { heuristic_euclidian, heuristic_manhattan, heuristic_octile, heuristic_chebyshev };
+
+void AStarGrid2D::set_size(const Vector2i &p_size) {
+	ERR_FAIL_COND_MSG(p_size.x < 0 || p_size.y < 0, vformat("Can't set a grid with negative size: %s.", p_size));
+	if (size != p_size) {
+		size = p_size;
+		dirty = true;
+	}
+}
+
+Vector2i AStarGrid2D::get_size() const {
+	return size;
+}
+
+void AStarGrid2D::set_offset(const Vector2 &p_offset) {
+	if (!offset.is_equal_approx(p_offset)) {
+		offset = p_offset;
+		dirty = true;
+	}
+}
+
+Vector2 AStarGrid2D::get_offset() const {
+	return offset;
+}
+
+void AStarGrid2D::set_cell_size(const Vector2 &p_cell_size) {
+	if (!cell_size.is_equal_approx(p_cell_size)) {
+		cell_size = p_cell_size;
+		dirty = true;
+	}
+}
+
+Vector2 AStarGrid2D::get_cell_size() const {
+	return cell_size;
+}
+
+void AStarGrid2D::update() {
+	grid_size = size;
+	solid.resize(size.x * size.y);
+	if (solid.size()) {
+		memset(solid.ptr(), 0, solid.size());
+	}
+	dirty = false;
+}
+
+bool AStarGrid2D::is_dirty() const {
+	return dirty;
+}
+
+bool AStarGrid2D::is_in_bounds(int p_x, int p_y) const {
+	return p_x >= 0 && p_x < grid_size.x && p_y >= 0 && p_y < grid_size.y;
+}
+
+bool AStarGrid2D::is_in_boundsv(const Vector2i &p_id) const {
+	return is_in_bounds(p_id.x, p_id.y);
+}
+
+void AStarGrid2D::set_jumping_enabled(bool p_enabled) {
+	jumping_enabled = p_enabled;
+}
+
+bool AStarGrid2D::is_jumping_enabled() const {
+	return jumping_enabled;
+}
+
+void AStarGrid2D::set_diagonal_mode(DiagonalMode p_diagonal_mode) {
+	ERR_FAIL_INDEX((int)p_diagonal_mode, (int)DIAGONAL_MODE_MAX);
+	diagonal_mode = p_diagonal_mode;
+}
+
+AStarGrid2D::DiagonalMode AStarGrid2D::get_diagonal_mode() const {
+	return diagonal_mode;
+}
+
+void AStarGrid2D::set_default_heuristic(Heuristic p_heuristic) {
+	ERR_FAIL_INDEX((int)p_heuristic, (int)HEURISTIC_MAX);
+	default_heuristic = p_heuristic;
+}
+
+AStarGrid2D::Heuristic AStarGrid2D::get_default_heuristic() const {
+	return default_heuristic;
+}
+
+void AStarGrid2D::set_point_solid(const Vector2i &p_id, bool p_solid) {
+	ERR_FAIL_COND_MSG(dirty, "Grid is not initialized. Call the update method.");
+	ERR_FAIL_COND_MSG(!is_in_boundsv(p_id), vformat("Can't set if point is solid. Point out of bounds (%s/%s, %s/%s).", p_id.x, grid_size.x, p_id.y, grid_size.y));
+	solid[_to_index(p_id.x, p_id.y)] = p_solid;
+}
+
+bool AStarGrid2D::is_point_solid(const Vector2i &p_id) const {
+	ERR_FAIL_COND_V_MSG(dirty, false, "Grid is not initialized. Call the update method.");
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), false, vformat("Can't get if point is solid. Point out of bounds (%s/%s, %s/%s).", p_id.x, grid_size.x, p_id.y, grid_size.y));
+	return solid[_to_index(p_id.x, p_id.y)];
+}
+
+void AStarGrid2D::clear() {
+	size = Vector2i();
+	update();
+}
+
+AStarGrid2D::SearchState *AStarGrid2D::_alloc_search_state() {
+	SearchState *state = nullptr;
+	{
+		MutexLock lock(search_state_mutex);
+		if (!free_search_states.is_empty()) {
+			state = free_search_states[free_search_states.size() - 1];
+			free_search_states.resize(free_search_states.size() - 1);
+		}
+	}
+	if (!state) {
+		state = memnew(SearchState);
+	}
+	if (state->nodes.size() < solid.size()) {
+		state->nodes.resize(solid.size());
+	}
+	return state;
+}
+
+void AStarGrid2D::_free_search_state(SearchState *p_state) {
+	MutexLock lock(search_state_mutex);
+	free_search_states.push_back(p_state);
+}
+
+bool AStarGrid2D::_can_move_diagonally(int64_t p_x, int64_t p_y, int p_dx, int p_dy) const {
+	switch (diagonal_mode) {
+		case DIAGONAL_MODE_ALWAYS:
+			return true;
+		case DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE:
+			return _is_walkable(p_x + p_dx, p_y) || _is_walkable(p_x, p_y + p_dy);
+		case DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES:
+			return _is_walkable(p_x + p_dx, p_y) && _is_walkable(p_x, p_y + p_dy);
+		default:
+			return false;
+	}
+}
+
+// Walks from (p_x, p_y) in the given direction until reaching a jump point: the
+// end, a cell with a forced neighbour, or (moving diagonally) a cell from which a
+// straight jump succeeds. Only used with DIAGONAL_MODE_ALWAYS and
+// DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES, the pruning rules differ between the two.
+uint32_t AStarGrid2D::_jump(int64_t p_x, int64_t p_y, int p_dx, int p_dy, uint32_t p_end) const {
+	int64_t x = p_x;
+	int64_t y = p_y;
+	bool diagonal = p_dx != 0 && p_dy != 0;
+
+	while (true) {
+		if (diagonal && !_can_move_diagonally(x, y, p_dx, p_dy)) {
+			return NO_POINT;
+		}
+		x += p_dx;
+		y += p_dy;
+		if (!_is_walkable(x, y)) {
+			return NO_POINT;
+		}
+
+		uint32_t index = _to_index(x, y);
+		if (index == p_end) {
+			return index;
+		}
+
+		if (diagonal_mode == DIAGONAL_MODE_ALWAYS) {
+			if (diagonal) {
+				if ((_is_walkable(x - p_dx, y + p_dy) && !_is_walkable(x - p_dx, y)) || (_is_walkable(x + p_dx, y - p_dy) && !_is_walkable(x, y - p_dy))) {
+					return index;
+				}
+			} else if (p_dx != 0) {
+				if ((_is_walkable(x + p_dx, y + 1) && !_is_walkable(x, y + 1)) || (_is_walkable(x + p_dx, y - 1) && !_is_walkable(x, y - 1))) {
+					return index;
+				}
+			} else {
+				if ((_is_walkable(x + 1, y + p_dy) && !_is_walkable(x + 1, y)) || (_is_walkable(x - 1, y + p_dy) && !_is_walkable(x - 1, y))) {
+					return index;
+				}
+			}
+		} else if (!diagonal) {
+			// Without corner cutting, diagonal moves have no forced neighbours,
+			// while straight moves are interrupted next to the end of an obstacle.
+			if (p_dx != 0) {
+				if ((_is_walkable(x, y - 1) && !_is_walkable(x - p_dx, y - 1)) || (_is_walkable(x, y + 1) && !_is_walkable(x - p_dx, y + 1))) {
+					return index;
+				}
+			} else {
+				if ((_is_walkable(x - 1, y) && !_is_walkable(x - 1, y - p_dy)) || (_is_walkable(x + 1, y) && !_is_walkable(x + 1, y - p_dy))) {
+					return index;
+				}
+			}
+		}
+
+		if (diagonal && (_jump(x, y, p_dx, 0, p_end) != NO_POINT || _jump(x, y, 0, p_dy, p_end) != NO_POINT)) {
+			return index;
+		}
+	}
+}
+
+void AStarGrid2D::_get_successors(SearchState &r_state, uint32_t p_point, uint32_t p_end, LocalVector<uint32_t> &r_successors) const {
+	static const Vector2i all_directions[8] = { Vector2i(1, 0), Vector2i(-1, 0), Vector2i(0, 1), Vector2i(0, -1), Vector2i(1, 1), Vector2i(-1, 1), Vector2i(1, -1), Vector2i(-1, -1) };
+
+	r_successors.clear();
+
+	Vector2i id = _to_id(p_point);
+	int64_t x = id.x;
+	int64_t y = id.y;
+	bool jumping = jumping_enabled && (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES);
+	uint32_t prev = r_state.nodes[p_point].prev;
+
+	Vector2i directions[8];
+	int direction_count = 0;
+
+	if (jumping && prev != NO_POINT) {
+		// Prune the directions that can be reached more cheaply through the previous point.
+		Vector2i prev_id = _to_id(prev);
+		int dx = CLAMP(id.x - prev_id.x, -1, 1);
+		int dy = CLAMP(id.y - prev_id.y, -1, 1);
+
+		if (dx != 0 && dy != 0) {
+			directions[direction_count++] = Vector2i(0, dy);
+			directions[direction_count++] = Vector2i(dx, 0);
+			directions[direction_count++] = Vector2i(dx, dy);
+			if (diagonal_mode == DIAGONAL_MODE_ALWAYS) {
+				if (!_is_walkable(x - dx, y)) {
+					directions[direction_count++] = Vector2i(-dx, dy);
+				}
+				if (!_is_walkable(x, y - dy)) {
+					directions[direction_count++] = Vector2i(dx, -dy);
+				}
+			}
+		} else if (dx != 0) {
+			directions[direction_count++] = Vector2i(dx, 0);
+			if (diagonal_mode == DIAGONAL_MODE_ALWAYS) {
+				if (!_is_walkable(x, y + 1)) {
+					directions[direction_count++] = Vector2i(dx, 1);
+				}
+				if (!_is_walkable(x, y - 1)) {
+					directions[direction_count++] = Vector2i(dx, -1);
+				}
+			} else {
+				directions[direction_count++] = Vector2i(dx, 1);
+				directions[direction_count++] = Vector2i(dx, -1);
+				directions[direction_count++] = Vector2i(0, 1);
+				directions[direction_count++] = Vector2i(0, -1);
+			}
+		} else {
+			directions[direction_count++] = Vector2i(0, dy);
+			if (diagonal_mode == DIAGONAL_MODE_ALWAYS) {
+				if (!_is_walkable(x + 1, y)) {
+					directions[direction_count++] = Vector2i(1, dy);
+				}
+				if (!_is_walkable(x - 1, y)) {
+					directions[direction_count++] = Vector2i(-1, dy);
+				}
+			} else {
+				directions[direction_count++] = Vector2i(1, dy);
+				directions[direction_count++] = Vector2i(-1, dy);
+				directions[direction_count++] = Vector2i(1, 0);
+				directions[direction_count++] = Vector2i(-1, 0);
+			}
+		}
+	} else {
+		direction_count = diagonal_mode == DIAGONAL_MODE_NEVER ? 4 : 8;
+		for (int i = 0; i < direction_count; i++) {
+			directions[i] = all_directions[i];
+		}
+	}
+
+	for (int i = 0; i < direction_count; i++) {
+		const Vector2i &dir = directions[i];
+		if (jumping) {
+			uint32_t jump_point = _jump(x, y, dir.x, dir.y, p_end);
+			if (jump_point != NO_POINT) {
+				r_successors.push_back(jump_point);
+			}
+		} else if (_is_walkable(x + dir.x, y + dir.y) && (dir.x == 0 || dir.y == 0 || _can_move_diagonally(x, y, dir.x, dir.y))) {
+			r_successors.push_back(_to_index(x + dir.x, y + dir.y));
+		}
+	}
+}
+
+bool AStarGrid2D::_solve(SearchState &r_state, uint32_t p_begin, uint32_t p_end) {
+	uint64_t pass = ++r_state.pass;
+
+	if (solid[p_end]) {
+		return false;
+	}
+
+	SearchNode *nodes = r_state.nodes.ptr();
+	Vector2i end_id = _to_id(p_end);
+
+	LocalVector<uint32_t> open_list;
+	LocalVector<uint32_t> successors;
+	SortArray<uint32_t, SortPoints> sorter;
+	sorter.compare.nodes = nodes;
+
+	nodes[p_begin].prev = NO_POINT;
+	nodes[p_begin].g_score = 0;
+	nodes[p_begin].f_score = _estimate_cost(_to_id(p_begin), end_id);
+	open_list.push_back(p_begin);
+
+	while (!open_list.is_empty()) {
+		uint32_t p = open_list[0]; // The currently processed point
+
+		if (p == p_end) {
+			return true;
+		}
+
+		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list
+		open_list.resize(open_list.size() - 1);
+		nodes[p].closed_pass = pass; // Mark the point as closed
+
+		Vector2i p_id = _to_id(p);
+		_get_successors(r_state, p, p_end, successors);
+
+		for (uint32_t i = 0; i < successors.size(); i++) {
+			uint32_t e = successors[i]; // The neighbour point
+			SearchNode &en = nodes[e];
+
+			if (en.closed_pass == pass) {
+				continue;
+			}
+
+			Vector2i e_id = _to_id(e);
+			real_t tentative_g_score = nodes[p].g_score + _compute_cost(p_id, e_id);
+
+			bool new_point = false;
+
+			if (en.open_pass != pass) { // The point wasn't inside the open list.
+				en.open_pass = pass;
+				open_list.push_back(e);
+				new_point = true;
+			} else if (tentative_g_score >= en.g_score) { // The new path is worse than the previous.
+				continue;
+			}
+
+			en.prev = p;
+			en.g_score = tentative_g_score;
+			en.f_score = en.g_score + _estimate_cost(e_id, end_id);
+
+			if (new_point) { // The position of the new points is already known.
+				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
+			} else {
+				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptr());
+			}
+		}
+	}
+
+	return false;
+}
+
+// Jump points are always on a straight or diagonal line from their predecessor,
+// paths are expanded back to every cell in between.
+int AStarGrid2D::_get_path_length(const SearchState &p_state, uint32_t p_end) const {
+	int length = 1;
+	for (uint32_t p = p_end; p_state.nodes[p].prev != NO_POINT; p = p_state.nodes[p].prev) {
+		Vector2i a = _to_id(p);
+		Vector2i b = _to_id(p_state.nodes[p].prev);
+		length += MAX(ABS(a.x - b.x), ABS(a.y - b.y));
+	}
+	return length;
+}
+
+real_t AStarGrid2D::_estimate_cost(const Vector2i &p_from_id, const Vector2i &p_to_id) {
+	real_t scost;
+	if (GDVIRTUAL_CALL(_estimate_cost, p_from_id, p_to_id, scost)) {
+		return scost;
+	}
+	return heuristics[default_heuristic](p_from_id, p_to_id);
+}
+
+real_t AStarGrid2D::_compute_cost(const Vector2i &p_from_id, const Vector2i &p_to_id) {
+	real_t scost;
+	if (GDVIRTUAL_CALL(_compute_cost, p_from_id, p_to_id, scost)) {
+		return scost;
+	}
+	return heuristics[default_heuristic](p_from_id, p_to_id);
+}
+
+Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vector2i &p_to_id) {
+	ERR_FAIL_COND_V_MSG(dirty, Vector<Vector2>(), "Grid is not initialized. Call the update method.");
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), Vector<Vector2>(), vformat("Can't get point path. Point out of bounds (%s/%s, %s/%s)", p_from_id.x, grid_size.x, p_from_id.y, grid_size.y));
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), Vector<Vector2>(), vformat("Can't get point path. Point out of bounds (%s/%s, %s/%s)", p_to_id.x, grid_size.x, p_to_id.y, grid_size.y));
+
+	uint32_t begin_point = _to_index(p_from_id.x, p_from_id.y);
+	uint32_t end_point = _to_index(p_to_id.x, p_to_id.y);
+
+	if (begin_point == end_point) {
+		Vector<Vector2> ret;
+		ret.push_back(_get_point_position(p_from_id));
+		return ret;
+	}
+
+	SearchState *state = _alloc_search_state();
+	bool found_route = _solve(*state, begin_point, end_point);
+	if (!found_route) {
+		_free_search_state(state);
+		return Vector<Vector2>();
+	}
+
+	Vector<Vector2> path;
+	path.resize(_get_path_length(*state, end_point));
+
+	{
+		Vector2 *w = path.ptrw();
+
+		int idx = path.size() - 1;
+		w[idx] = _get_point_position(p_to_id);
+		for (uint32_t p = end_point; state->nodes[p].prev != NO_POINT; p = state->nodes[p].prev) {
+			Vector2i id = _to_id(p);
+			Vector2i prev_id = _to_id(state->nodes[p].prev);
+			Vector2i step = Vector2i(CLAMP(prev_id.x - id.x, -1, 1), CLAMP(prev_id.y - id.y, -1, 1));
+			while (id != prev_id) {
+				id += step;
+				w[--idx] = _get_point_position(id);
+			}
+		}
+	}
+
+	_free_search_state(state);
+	return path;
+}
+
+Array AStarGrid2D::get_id_path(const Vector2i &p_from_id, const Vector2i &p_to_id) {
+	ERR_FAIL_COND_V_MSG(dirty, Array(), "Grid is not initialized. Call the update method.");
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), Array(), vformat("Can't get id path. Point out of bounds (%s/%s, %s/%s)", p_from_id.x, grid_size.x, p_from_id.y, grid_size.y));
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), Array(), vformat("Can't get id path. Point out of bounds (%s/%s, %s/%s)", p_to_id.x, grid_size.x, p_to_id.y, grid_size.y));
+
+	uint32_t begin_point = _to_index(p_from_id.x, p_from_id.y);
+	uint32_t end_point = _to_index(p_to_id.x, p_to_id.y);
+
+	if (begin_point == end_point) {
+		Array ret;
+		ret.push_back(p_from_id);
+		return ret;
+	}
+
+	SearchState *state = _alloc_search_state();
+	bool found_route = _solve(*state, begin_point, end_point);
+	if (!found_route) {
+		_free_search_state(state);
+		return Array();
+	}
+
+	Array path;
+	path.resize(_get_path_length(*state, end_point));
+
+	int idx = path.size() - 1;
+	path[idx] = p_to_id;
+	for (uint32_t p = end_point; state->nodes[p].prev != NO_POINT; p = state->nodes[p].prev) {
+		Vector2i id = _to_id(p);
+		Vector2i prev_id = _to_id(state->nodes[p].prev);
+		Vector2i step = Vector2i(CLAMP(prev_id.x - id.x, -1, 1), CLAMP(prev_id.y - id.y, -1, 1));
+		while (id != prev_id) {
+			id += step;
+			path[--idx] = id;
+		}
+	}
+
+	_free_search_state(state);
+	return path;
+}
+
+void AStarGrid2D::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_size", "size"), &AStarGrid2D::set_size);
+	ClassDB::bind_method(D_METHOD("get_size"), &AStarGrid2D::get_size);
+	ClassDB::bind_method(D_METHOD("set_offset", "offset"), &AStarGrid2D::set_offset);
+	ClassDB::bind_method(D_METHOD("get_offset"), &AStarGrid2D::get_offset);
+	ClassDB::bind_method(D_METHOD("set_cell_size", "cell_size"), &AStarGrid2D::set_cell_size);
+	ClassDB::bind_method(D_METHOD("get_cell_size"), &AStarGrid2D::get_cell_size);
+	ClassDB::bind_method(D_METHOD("is_in_bounds", "x", "y"), &AStarGrid2D::is_in_bounds);
+	ClassDB::bind_method(D_METHOD("is_in_boundsv", "id"), &AStarGrid2D::is_in_boundsv);
+	ClassDB::bind_method(D_METHOD("is_dirty"), &AStarGrid2D::is_dirty);
+	ClassDB::bind_method(D_METHOD("update"), &AStarGrid2D::update);
+	ClassDB::bind_method(D_METHOD("set_jumping_enabled", "enabled"), &AStarGrid2D::set_jumping_enabled);
+	ClassDB::bind_method(D_METHOD("is_jumping_enabled"), &AStarGrid2D::is_jumping_enabled);
+	ClassDB::bind_method(D_METHOD("set_diagonal_mode", "mode"), &AStarGrid2D::set_diagonal_mode);
+	ClassDB::bind_method(D_METHOD("get_diagonal_mode"), &AStarGrid2D::get_diagonal_mode);
+	ClassDB::bind_method(D_METHOD("set_default_heuristic", "heuristic"), &AStarGrid2D::set_default_heuristic);
+	ClassDB::bind_method(D_METHOD("get_default_heuristic"), &AStarGrid2D::get_default_heuristic);
+	ClassDB::bind_method(D_METHOD("set_point_solid", "id", "solid"), &AStarGrid2D::set_point_solid, DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("is_point_solid", "id"), &AStarGrid2D::is_point_solid);
+	ClassDB::bind_method(D_METHOD("clear"), &AStarGrid2D::clear);
+
+	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id"), &AStarGrid2D::get_point_path);
+	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id"), &AStarGrid2D::get_id_path);
+
+	GDVIRTUAL_BIND(_estimate_cost, "from_id", "to_id")
+	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
+
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2I, "size"), "set_size", "get_size");
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "offset"), "set_offset", "get_offset");
+	ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "cell_size"), "set_cell_size", "get_cell_size");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "jumping_enabled"), "set_jumping_enabled", "is_jumping_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "default_heuristic", PROPERTY_HINT_ENUM, "Euclidean,Manhattan,Octile,Chebyshev"), "set_default_heuristic", "get_default_heuristic");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "diagonal_mode", PROPERTY_HINT_ENUM, "Always,Never,At Least One Walkable,Only If No Obstacles"), "set_diagonal_mode", "get_diagonal_mode");
+
+	BIND_ENUM_CONSTANT(HEURISTIC_EUCLIDEAN);
+	BIND_ENUM_CONSTANT(HEURISTIC_MANHATTAN);
+	BIND_ENUM_CONSTANT(HEURISTIC_OCTILE);
+	BIND_ENUM_CONSTANT(HEURISTIC_CHEBYSHEV);
+	BIND_ENUM_CONSTANT(HEURISTIC_MAX);
+
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_ALWAYS);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_NEVER);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES);
+	BIND_ENUM_CONSTANT(DIAGONAL_MODE_MAX);
+}
+
+AStarGrid2D::~AStarGrid2D() {
+	for (uint32_t i = 0; i < free_search_states.size(); i++) {
+		memdelete(free_search_states[i]);
+	}
+}
@@ -0,0 +1,180 @@
+/*************************************************************************/
+/*  a_star_grid_2d.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef A_STAR_GRID_2D_H
+#define A_STAR_GRID_2D_H
+
+#include "core/object/gdvirtual.gen.inc"
+#include "core/object/ref_counted.h"
+#include "core/object/script_language.h"
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
+
+/**
+	A* pathfinding on a rectangular grid.
+
+	Cells are stored in a flat array (no per point allocation or hashing), and
+	with jumping enabled uniform areas are skipped with Jump Point Search.
+*/
+
+class AStarGrid2D : public RefCounted {
+	GDCLASS(AStarGrid2D, RefCounted);
+
+public:
+	enum Heuristic {
+		HEURISTIC_EUCLIDEAN,
+		HEURISTIC_MANHATTAN,
+		HEURISTIC_OCTILE,
+		HEURISTIC_CHEBYSHEV,
+		HEURISTIC_MAX,
+	};
+
+	enum DiagonalMode {
+		DIAGONAL_MODE_ALWAYS,
+		DIAGONAL_MODE_NEVER,
+		DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE,
+		DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES,
+		DIAGONAL_MODE_MAX,
+	};
+
+private:
+	enum {
+		NO_POINT = 0xFFFFFFFF
+	};
+
+	// Search data, per query like in AStar so paths can be searched
+	// concurrently (as long as the grid isn't modified meanwhile).
+	struct SearchNode {
+		uint32_t prev = NO_POINT;
+		real_t g_score = 0;
+		real_t f_score = 0;
+		uint64_t open_pass = 0;
+		uint64_t closed_pass = 0;
+	};
+
+	struct SearchState {
+		LocalVector<SearchNode> nodes; // One per cell.
+		uint64_t pass = 0;
+	};
+
+	struct SortPoints {
+		const SearchNode *nodes = nullptr;
+		_FORCE_INLINE_ bool operator()(uint32_t A, uint32_t B) const { // Returns true when the point A is worse than point B.
+			if (nodes[A].f_score > nodes[B].f_score) {
+				return true;
+			} else if (nodes[A].f_score < nodes[B].f_score) {
+				return false;
+			} else {
+				return nodes[A].g_score < nodes[B].g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
+			}
+		}
+	};
+
+	Vector2i size;
+	Vector2 offset;
+	Vector2 cell_size = Vector2(1, 1);
+
+	bool dirty = false;
+	bool jumping_enabled = false;
+	DiagonalMode diagonal_mode = DIAGONAL_MODE_ALWAYS;
+	Heuristic default_heuristic = HEURISTIC_EUCLIDEAN;
+
+	LocalVector<uint8_t> solid; // One per cell, row major.
+	Vector2i grid_size; // Size of the grid at the last update().
+
+	BinaryMutex search_state_mutex;
+	LocalVector<SearchState *> free_search_states;
+
+	_FORCE_INLINE_ bool _is_walkable(int64_t p_x, int64_t p_y) const {
+		return p_x >= 0 && p_y >= 0 && p_x < grid_size.x && p_y < grid_size.y && !solid[p_y * grid_size.x + p_x];
+	}
+	_FORCE_INLINE_ uint32_t _to_index(int64_t p_x, int64_t p_y) const { return p_y * grid_size.x + p_x; }
+	_FORCE_INLINE_ Vector2i _to_id(uint32_t p_index) const { return Vector2i(p_index % grid_size.x, p_index / grid_size.x); }
+	_FORCE_INLINE_ Vector2 _get_point_position(const Vector2i &p_id) const { return offset + Vector2(p_id) * cell_size; }
+
+	SearchState *_alloc_search_state();
+	void _free_search_state(SearchState *p_state);
+
+	bool _can_move_diagonally(int64_t p_x, int64_t p_y, int p_dx, int p_dy) const;
+	uint32_t _jump(int64_t p_x, int64_t p_y, int p_dx, int p_dy, uint32_t p_end) const;
+	void _get_successors(SearchState &r_state, uint32_t p_point, uint32_t p_end, LocalVector<uint32_t> &r_successors) const;
+	bool _solve(SearchState &r_state, uint32_t p_begin, uint32_t p_end);
+	int _get_path_length(const SearchState &p_state, uint32_t p_end) const;
+
+protected:
+	static void _bind_methods();
+
+	virtual real_t _estimate_cost(const Vector2i &p_from_id, const Vector2i &p_to_id);
+	virtual real_t _compute_cost(const Vector2i &p_from_id, const Vector2i &p_to_id);
+
+	GDVIRTUAL2RC(real_t, _estimate_cost, Vector2i, Vector2i)
+	GDVIRTUAL2RC(real_t, _compute_cost, Vector2i, Vector2i)
+
+public:
+	void set_size(const Vector2i &p_size);
+	Vector2i get_size() const;
+
+	void set_offset(const Vector2 &p_offset);
+	Vector2 get_offset() const;
+
+	void set_cell_size(const Vector2 &p_cell_size);
+	Vector2 get_cell_size() const;
+
+	void update();
+	bool is_dirty() const;
+
+	bool is_in_bounds(int p_x, int p_y) const;
+	bool is_in_boundsv(const Vector2i &p_id) const;
+
+	void set_jumping_enabled(bool p_enabled);
+	bool is_jumping_enabled() const;
+
+	void set_diagonal_mode(DiagonalMode p_diagonal_mode);
+	DiagonalMode get_diagonal_mode() const;
+
+	void set_default_heuristic(Heuristic p_heuristic);
+	Heuristic get_default_heuristic() const;
+
+	void set_point_solid(const Vector2i &p_id, bool p_solid = true);
+	bool is_point_solid(const Vector2i &p_id) const;
+
+	void clear();
+
+	Vector<Vector2> get_point_path(const Vector2i &p_from_id, const Vector2i &p_to_id);
+	Array get_id_path(const Vector2i &p_from_id, const Vector2i &p_to_id);
+
+	AStarGrid2D() {}
+	~AStarGrid2D();
+};
+
+VARIANT_ENUM_CAST(AStarGrid2D::DiagonalMode);
+VARIANT_ENUM_CAST(AStarGrid2D::Heuristic);
+
+#endif // A_STAR_GRID_2D_H
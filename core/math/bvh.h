@@ -47,9 +47,13 @@
 // implemented in GLES3 but not GLES2. Layer masks are not yet implemented for directional lights.
 
 #include "bvh_tree.h"
+#include "core/templates/thread_work_pool.h"
 
 #define BVHTREE_CLASS BVH_Tree<T, 2, MAX_ITEMS, USE_PAIRS, Bounds, Point>
 
+// below this many changed items, the pairing cull isn't worth spreading over threads
+#define BVH_PARALLEL_PAIRING_THRESHOLD 64
+
 template <class T, bool USE_PAIRS = false, int MAX_ITEMS = 32, class Bounds = AABB, class Point = Vector3>
 class BVH_Manager {
 public:
@@ -271,11 +275,25 @@ public:
 #endif
 	}
 
+	// rebuilds both trees from scratch, e.g. after moving many items at once.
+	// update() already does this by itself after many items have been added.
+	void rebuild() {
+		for (int n = 0; n < BVHTREE_CLASS::NUM_TREES; n++) {
+			tree.rebuild_tree(n);
+		}
+	}
+
 	// this can be called more frequently than per frame if necessary
 	void update_collisions() {
 		_check_for_collisions();
 	}
 
+	// optional, when set the overlap tests of the changed items are spread over the pool.
+	// pair and unpair callbacks are still sent from the calling thread, in the same order as without it.
+	void set_pairing_work_pool(ThreadWorkPool *p_work_pool) {
+		pairing_work_pool = p_work_pool;
+	}
+
 	// prefer calling this directly as type safe
 	void set_pairable(const BVHHandle &p_handle, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask, bool p_force_collision_check = true) {
 		// Returns true if the pairing state has changed.
@@ -324,6 +342,25 @@ public:
 		return params.result_count_overall;
 	}
 
+	// r_hits is scratch memory owned by the caller, each thread needs its own.
+	// the tree must not be modified while concurrent culls are running.
+	int cull_aabb_concurrent(const Bounds &p_aabb, T **p_result_array, int p_result_max, LocalVector<uint32_t, uint32_t, true> &r_hits, int *p_subindex_array = nullptr, uint32_t p_mask = 0xFFFFFFFF) {
+		typename BVHTREE_CLASS::CullParams params;
+
+		params.result_count_overall = 0;
+		params.result_max = p_result_max;
+		params.result_array = p_result_array;
+		params.subindex_array = p_subindex_array;
+		params.mask = p_mask;
+		params.pairable_type = 0;
+		params.test_pairable_only = false;
+		params.abb.from(p_aabb);
+
+		tree.cull_aabb_concurrent(params, r_hits);
+
+		return params.result_count_overall;
+	}
+
 	int cull_segment(const Point &p_from, const Point &p_to, T **p_result_array, int p_result_max, int *p_subindex_array = nullptr, uint32_t p_mask = 0xFFFFFFFF) {
 		typename BVHTREE_CLASS::CullParams params;
 
@@ -342,6 +379,26 @@ public:
 		return params.result_count_overall;
 	}
 
+	// r_hits is scratch memory owned by the caller, each thread needs its own.
+	// the tree must not be modified while concurrent culls are running.
+	int cull_segment_concurrent(const Point &p_from, const Point &p_to, T **p_result_array, int p_result_max, LocalVector<uint32_t, uint32_t, true> &r_hits, int *p_subindex_array = nullptr, uint32_t p_mask = 0xFFFFFFFF) {
+		typename BVHTREE_CLASS::CullParams params;
+
+		params.result_count_overall = 0;
+		params.result_max = p_result_max;
+		params.result_array = p_result_array;
+		params.subindex_array = p_subindex_array;
+		params.mask = p_mask;
+		params.pairable_type = 0;
+
+		params.segment.from = p_from;
+		params.segment.to = p_to;
+
+		tree.cull_segment_concurrent(params, r_hits);
+
+		return params.result_count_overall;
+	}
+
 	int cull_point(const Point &p_point, T **p_result_array, int p_result_max, int *p_subindex_array = nullptr, uint32_t p_mask = 0xFFFFFFFF) {
 		typename BVHTREE_CLASS::CullParams params;
 
@@ -405,6 +462,15 @@ private:
 		params.mask = 0xFFFFFFFF;
 		params.pairable_type = 0;
 
+		// the overlaps only depend on the tree, which pairing doesn't modify, so they can all be found upfront
+		bool parallel = USE_PAIRS && pairing_work_pool && changed_items.size() >= BVH_PARALLEL_PAIRING_THRESHOLD;
+		if (parallel) {
+			if (changed_item_hits.size() < changed_items.size()) {
+				changed_item_hits.resize(changed_items.size());
+			}
+			pairing_work_pool->do_work_batched(changed_items.size(), this, &BVH_Manager::_find_changed_item_hits, (void *)nullptr);
+		}
+
 		for (unsigned int n = 0; n < changed_items.size(); n++) {
 			const BVHHandle &h = changed_items[n];
 
@@ -419,18 +485,24 @@ private:
 
 			uint32_t changed_item_ref_id = h.id();
 
-			// set up the test from this item.
-			// this includes whether to test the non pairable tree,
-			// and the item mask.
-			tree.item_fill_cullparams(h, params);
+			const LocalVector<uint32_t, uint32_t, true> *hits = nullptr;
+			if (parallel) {
+				hits = &changed_item_hits[n];
+			} else {
+				// set up the test from this item.
+				// this includes whether to test the non pairable tree,
+				// and the item mask.
+				tree.item_fill_cullparams(h, params);
 
-			params.abb = abb;
+				params.abb = abb;
 
-			params.result_count_overall = 0; // might not be needed
-			tree.cull_aabb(params, false);
+				params.result_count_overall = 0; // might not be needed
+				tree.cull_aabb(params, false);
+				hits = &tree._cull_hits;
+			}
 
-			for (unsigned int i = 0; i < tree._cull_hits.size(); i++) {
-				uint32_t ref_id = tree._cull_hits[i];
+			for (unsigned int i = 0; i < hits->size(); i++) {
+				uint32_t ref_id = (*hits)[i];
 
 				// don't collide against ourself
 				if (ref_id == changed_item_ref_id) {
@@ -455,6 +527,21 @@ private:
 		_reset();
 	}
 
+	void _find_changed_item_hits(uint32_t p_index, void *p_userdata) {
+		const BVHHandle &h = changed_items[p_index];
+
+		typename BVHTREE_CLASS::CullParams params;
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+
+		tree.item_fill_cullparams(h, params);
+		params.abb.from(tree._pairs[h.id()].expanded_aabb);
+
+		tree.cull_aabb_ref_ids(params, changed_item_hits[p_index]);
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, Bounds &r_aabb) {
 		BVHABB_CLASS abb;
@@ -680,6 +767,10 @@ private:
 	LocalVector<BVHHandle, uint32_t, true> changed_items;
 	uint32_t _tick;
 
+	ThreadWorkPool *pairing_work_pool = nullptr;
+	// overlaps of each changed item when found in parallel, kept between updates to reuse the memory
+	LocalVector<LocalVector<uint32_t, uint32_t, true>> changed_item_hits;
+
 public:
 	BVH_Manager() {
 		_tick = 1; // start from 1 so items with 0 indicate never updated
@@ -161,6 +161,34 @@ struct BVH_ABB {
 		return true;
 	}
 
+	// Batched version of intersects_convex_optimized() over all the boxes of a leaf.
+	// p_abs_normals holds the absolute plane normals, indexed like the hull planes.
+	// Results are accumulated without branching so the loop can be vectorized,
+	// the indices of the boxes that pass are written to r_hits and their number returned.
+	static uint32_t cull_convex_optimized(const BVH_ABB *p_abbs, uint32_t p_count, const ConvexHull &p_hull, const Vector3 *p_abs_normals, const uint32_t *p_plane_ids, uint32_t p_num_planes, uint32_t *r_hits) {
+		uint32_t count = 0;
+
+		for (uint32_t n = 0; n < p_count; n++) {
+			const BVH_ABB &abb = p_abbs[n];
+			Vector3 half_extents = abb.calculate_size() * 0.5;
+			Vector3 centre = abb.min + half_extents;
+
+			bool inside = true;
+			for (uint32_t i = 0; i < p_num_planes; i++) {
+				uint32_t plane_id = p_plane_ids[i];
+				const Plane &p = p_hull.planes[plane_id];
+				// distance of the box corner furthest behind the plane
+				real_t dist = p.normal.dot(centre) - p_abs_normals[plane_id].dot(half_extents);
+				inside &= !(dist > p.d);
+			}
+
+			r_hits[count] = n;
+			count += inside;
+		}
+
+		return count;
+	}
+
 	bool intersects_convex_partial(const ConvexHull &p_hull) const {
 		Bounds bb;
 		to(bb);
@@ -222,6 +250,25 @@ struct BVH_ABB {
 		return true;
 	}
 
+	// Batched version of intersects() over all the boxes of a leaf, see cull_convex_optimized().
+	static uint32_t cull_intersecting(const BVH_ABB *p_abbs, uint32_t p_count, const BVH_ABB &p_o, uint32_t *r_hits) {
+		uint32_t count = 0;
+
+		for (uint32_t n = 0; n < p_count; n++) {
+			const BVH_ABB &abb = p_abbs[n];
+
+			bool hit = true;
+			for (int axis = 0; axis < Point::AXIS_COUNT; ++axis) {
+				hit &= !(p_o.min[axis] > -abb.neg_max[axis]) & !(abb.min[axis] > -p_o.neg_max[axis]);
+			}
+
+			r_hits[count] = n;
+			count += hit;
+		}
+
+		return count;
+	}
+
 	bool is_other_within(const BVH_ABB &p_o) const {
 		if (_any_lessthan(p_o.neg_max, neg_max)) {
 			return false;
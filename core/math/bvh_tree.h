@@ -43,6 +43,7 @@
 #include "core/math/bvh_abb.h"
 #include "core/math/geometry_3d.h"
 #include "core/math/vector3.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/string/print_string.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/pooled_list.h"
@@ -406,6 +407,7 @@ private:
 		return child_node_id;
 	}
 
+#include "bvh_build.inc"
 #include "bvh_cull.inc"
 #include "bvh_debug.inc"
 #include "bvh_integrity.inc"
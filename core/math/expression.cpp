@@ -35,6 +35,7 @@
 #include "core/object/class_db.h"
 #include "core/object/ref_counted.h"
 #include "core/os/os.h"
+#include "core/variant/variant_internal.h"
 #include "core/variant/variant_parser.h"
 
 static bool _is_number(char32_t c) {
@@ -1157,227 +1158,331 @@ bool Expression::_compile_expression() {
 	return false;
 }
 
-bool Expression::_execute(const Array &p_inputs, Object *p_instance, Expression::ENode *p_node, Variant &r_ret, String &r_error_str) {
+int Expression::_add_slot(Variant::Type p_type, bool p_constant, const Variant &p_value) {
+	stack.push_back(p_value);
+	stack_types.push_back(p_type);
+	stack_constant.push_back(p_constant);
+	return stack.size() - 1;
+}
+
+static bool _is_value_type(Variant::Type p_type) {
+	// Folded values and operator results are shared between executions, so they can't be references.
+	return p_type != Variant::OBJECT && p_type != Variant::ARRAY && p_type != Variant::DICTIONARY;
+}
+
+void Expression::_resolve_evaluator(Instruction &r_instruction, Variant::Type p_type_a, Variant::Type p_type_b) const {
+	r_instruction.eval_type_a = p_type_a;
+	r_instruction.eval_type_b = p_type_b;
+	r_instruction.evaluator = nullptr;
+
+	// Validated evaluators skip the checks done by Variant::evaluate(), such as division by zero,
+	// negative shifts or freed objects. These are always evaluated normally.
+	switch (r_instruction.op) {
+		case Variant::OP_DIVIDE:
+		case Variant::OP_MODULE:
+		case Variant::OP_SHIFT_LEFT:
+		case Variant::OP_SHIFT_RIGHT:
+			return;
+		default:
+			break;
+	}
+	if (p_type_a == Variant::OBJECT || p_type_b == Variant::OBJECT) {
+		return;
+	}
+
+	r_instruction.evaluator = Variant::get_validated_operator_evaluator(r_instruction.op, p_type_a, p_type_b);
+	if (r_instruction.evaluator) {
+		r_instruction.eval_type_ret = Variant::get_operator_return_type(r_instruction.op, p_type_a, p_type_b);
+	}
+}
+
+int Expression::_compile_args(const Vector<ENode *> &p_args, int &r_first) {
+	LocalVector<int> slots;
+	for (int i = 0; i < p_args.size(); i++) {
+		slots.push_back(_compile_node(p_args[i]));
+	}
+
+	r_first = program_args.size();
+	for (uint32_t i = 0; i < slots.size(); i++) {
+		program_args.push_back(slots[i]);
+	}
+	if (call_args.size() < slots.size()) {
+		call_args.resize(slots.size());
+	}
+	return slots.size();
+}
+
+int Expression::_compile_node(ENode *p_node) {
+	Instruction instruction;
+
 	switch (p_node->type) {
 		case Expression::ENode::TYPE_INPUT: {
 			const Expression::InputNode *in = static_cast<const Expression::InputNode *>(p_node);
-			if (in->index < 0 || in->index >= p_inputs.size()) {
-				r_error_str = vformat(RTR("Invalid input %i (not passed) in expression"), in->index);
-				return true;
+			for (uint32_t i = 0; i < used_inputs.size(); i++) {
+				if (used_inputs[i].index == in->index) {
+					return used_inputs[i].slot;
+				}
 			}
-			r_ret = p_inputs[in->index];
+			UsedInput input;
+			input.index = in->index;
+			input.slot = _add_slot(Variant::VARIANT_MAX);
+			used_inputs.push_back(input);
+			return input.slot;
 		} break;
 		case Expression::ENode::TYPE_CONSTANT: {
 			const Expression::ConstantNode *c = static_cast<const Expression::ConstantNode *>(p_node);
-			r_ret = c->value;
-
+			return _add_slot(c->value.get_type(), true, c->value);
 		} break;
 		case Expression::ENode::TYPE_SELF: {
-			if (!p_instance) {
-				r_error_str = RTR("self can't be used because instance is null (not passed)");
-				return true;
-			}
-			r_ret = p_instance;
+			instruction.opcode = OPCODE_SELF;
+			instruction.dst = _add_slot(Variant::VARIANT_MAX);
 		} break;
 		case Expression::ENode::TYPE_OPERATOR: {
 			const Expression::OperatorNode *op = static_cast<const Expression::OperatorNode *>(p_node);
 
-			Variant a;
-			bool ret = _execute(p_inputs, p_instance, op->nodes[0], a, r_error_str);
-			if (ret) {
-				return true;
-			}
+			instruction.opcode = OPCODE_OPERATOR;
+			instruction.op = op->op;
+			instruction.a = _compile_node(op->nodes[0]);
+			instruction.b = op->nodes[1] ? _compile_node(op->nodes[1]) : _add_slot(Variant::NIL, true);
 
-			Variant b;
-
-			if (op->nodes[1]) {
-				ret = _execute(p_inputs, p_instance, op->nodes[1], b, r_error_str);
-				if (ret) {
-					return true;
+			if (stack_constant[instruction.a] && stack_constant[instruction.b]) {
+				Variant value;
+				bool valid = true;
+				Variant::evaluate(instruction.op, stack[instruction.a], stack[instruction.b], value, valid);
+				// When invalid, the error is left to execution.
+				if (valid && _is_value_type(value.get_type())) {
+					return _add_slot(value.get_type(), true, value);
 				}
 			}
 
-			bool valid = true;
-			Variant::evaluate(op->op, a, b, r_ret, valid);
-			if (!valid) {
-				r_error_str = vformat(RTR("Invalid operands to operator %s, %s and %s."), Variant::get_operator_name(op->op), Variant::get_type_name(a.get_type()), Variant::get_type_name(b.get_type()));
-				return true;
+			Variant::Type type_a = stack_types[instruction.a];
+			Variant::Type type_b = stack_types[instruction.b];
+			Variant::Type type_ret = Variant::VARIANT_MAX;
+			if (type_a != Variant::VARIANT_MAX && type_b != Variant::VARIANT_MAX) {
+				_resolve_evaluator(instruction, type_a, type_b);
+				if (instruction.evaluator) {
+					type_ret = instruction.eval_type_ret;
+				}
 			}
-
+			instruction.dst = _add_slot(type_ret);
 		} break;
 		case Expression::ENode::TYPE_INDEX: {
 			const Expression::IndexNode *index = static_cast<const Expression::IndexNode *>(p_node);
 
-			Variant base;
-			bool ret = _execute(p_inputs, p_instance, index->base, base, r_error_str);
-			if (ret) {
-				return true;
-			}
-
-			Variant idx;
-
-			ret = _execute(p_inputs, p_instance, index->index, idx, r_error_str);
-			if (ret) {
-				return true;
-			}
-
-			bool valid;
-			r_ret = base.get(idx, &valid);
-			if (!valid) {
-				r_error_str = vformat(RTR("Invalid index of type %s for base type %s"), Variant::get_type_name(idx.get_type()), Variant::get_type_name(base.get_type()));
-				return true;
-			}
-
+			instruction.opcode = OPCODE_INDEX;
+			instruction.a = _compile_node(index->base);
+			instruction.b = _compile_node(index->index);
+			instruction.dst = _add_slot(Variant::VARIANT_MAX);
 		} break;
 		case Expression::ENode::TYPE_NAMED_INDEX: {
 			const Expression::NamedIndexNode *index = static_cast<const Expression::NamedIndexNode *>(p_node);
 
-			Variant base;
-			bool ret = _execute(p_inputs, p_instance, index->base, base, r_error_str);
-			if (ret) {
-				return true;
-			}
-
-			bool valid;
-			r_ret = base.get_named(index->name, valid);
-			if (!valid) {
-				r_error_str = vformat(RTR("Invalid named index '%s' for base type %s"), String(index->name), Variant::get_type_name(base.get_type()));
-				return true;
-			}
-
+			instruction.opcode = OPCODE_NAMED_INDEX;
+			instruction.a = _compile_node(index->base);
+			instruction.name = index->name;
+			instruction.dst = _add_slot(Variant::VARIANT_MAX);
 		} break;
 		case Expression::ENode::TYPE_ARRAY: {
 			const Expression::ArrayNode *array = static_cast<const Expression::ArrayNode *>(p_node);
 
-			Array arr;
-			arr.resize(array->array.size());
-			for (int i = 0; i < array->array.size(); i++) {
-				Variant value;
-				bool ret = _execute(p_inputs, p_instance, array->array[i], value, r_error_str);
-
-				if (ret) {
-					return true;
-				}
-				arr[i] = value;
-			}
-
-			r_ret = arr;
-
+			instruction.opcode = OPCODE_ARRAY;
+			instruction.arg_count = _compile_args(array->array, instruction.arg_first);
+			instruction.dst = _add_slot(Variant::ARRAY);
 		} break;
 		case Expression::ENode::TYPE_DICTIONARY: {
 			const Expression::DictionaryNode *dictionary = static_cast<const Expression::DictionaryNode *>(p_node);
 
-			Dictionary d;
-			for (int i = 0; i < dictionary->dict.size(); i += 2) {
-				Variant key;
-				bool ret = _execute(p_inputs, p_instance, dictionary->dict[i + 0], key, r_error_str);
+			instruction.opcode = OPCODE_DICTIONARY;
+			instruction.arg_count = _compile_args(dictionary->dict, instruction.arg_first);
+			instruction.dst = _add_slot(Variant::DICTIONARY);
+		} break;
+		case Expression::ENode::TYPE_CONSTRUCTOR: {
+			const Expression::ConstructorNode *constructor = static_cast<const Expression::ConstructorNode *>(p_node);
 
-				if (ret) {
-					return true;
-				}
+			instruction.opcode = OPCODE_CONSTRUCTOR;
+			instruction.data_type = constructor->data_type;
+			instruction.arg_count = _compile_args(constructor->arguments, instruction.arg_first);
 
+			bool constant = _is_value_type(constructor->data_type);
+			for (int i = 0; i < instruction.arg_count; i++) {
+				constant = constant && stack_constant[program_args[instruction.arg_first + i]];
+				call_args[i] = &stack[program_args[instruction.arg_first + i]];
+			}
+			if (constant) {
 				Variant value;
-				ret = _execute(p_inputs, p_instance, dictionary->dict[i + 1], value, r_error_str);
-				if (ret) {
-					return true;
+				Callable::CallError ce;
+				Variant::construct(constructor->data_type, value, call_args.ptr(), instruction.arg_count, ce);
+				if (ce.error == Callable::CallError::CALL_OK) {
+					program_args.resize(instruction.arg_first);
+					return _add_slot(value.get_type(), true, value);
 				}
-
-				d[key] = value;
 			}
 
-			r_ret = d;
+			instruction.dst = _add_slot(Variant::VARIANT_MAX);
 		} break;
-		case Expression::ENode::TYPE_CONSTRUCTOR: {
-			const Expression::ConstructorNode *constructor = static_cast<const Expression::ConstructorNode *>(p_node);
+		case Expression::ENode::TYPE_BUILTIN_FUNC: {
+			const Expression::BuiltinFuncNode *bifunc = static_cast<const Expression::BuiltinFuncNode *>(p_node);
 
-			Vector<Variant> arr;
-			Vector<const Variant *> argp;
-			arr.resize(constructor->arguments.size());
-			argp.resize(constructor->arguments.size());
+			// Not folded, as utility functions can have side effects (or be random).
+			instruction.opcode = OPCODE_BUILTIN_FUNC;
+			instruction.name = bifunc->func;
+			instruction.arg_count = _compile_args(bifunc->arguments, instruction.arg_first);
+			instruction.dst = _add_slot(Variant::VARIANT_MAX);
+		} break;
+		case Expression::ENode::TYPE_CALL: {
+			const Expression::CallNode *call = static_cast<const Expression::CallNode *>(p_node);
 
-			for (int i = 0; i < constructor->arguments.size(); i++) {
-				Variant value;
-				bool ret = _execute(p_inputs, p_instance, constructor->arguments[i], value, r_error_str);
+			instruction.opcode = OPCODE_CALL;
+			instruction.a = _compile_node(call->base);
+			instruction.name = call->method;
+			instruction.arg_count = _compile_args(call->arguments, instruction.arg_first);
+			instruction.dst = _add_slot(Variant::VARIANT_MAX);
+		} break;
+	}
 
-				if (ret) {
-					return true;
-				}
-				arr.write[i] = value;
-				argp.write[i] = &arr[i];
-			}
+	program.push_back(instruction);
+	return instruction.dst;
+}
 
-			Callable::CallError ce;
-			Variant::construct(constructor->data_type, r_ret, (const Variant **)argp.ptr(), argp.size(), ce);
+void Expression::_compile_program() {
+	program.clear();
+	program_args.clear();
+	used_inputs.clear();
+	stack.clear();
+	stack_types.clear();
+	stack_constant.clear();
+	call_args.clear();
 
-			if (ce.error != Callable::CallError::CALL_OK) {
-				r_error_str = vformat(RTR("Invalid arguments to construct '%s'"), Variant::get_type_name(constructor->data_type));
-				return true;
-			}
+	result_slot = _compile_node(root);
 
-		} break;
-		case Expression::ENode::TYPE_BUILTIN_FUNC: {
-			const Expression::BuiltinFuncNode *bifunc = static_cast<const Expression::BuiltinFuncNode *>(p_node);
+	stack_types.reset();
+	stack_constant.reset();
+}
 
-			Vector<Variant> arr;
-			Vector<const Variant *> argp;
-			arr.resize(bifunc->arguments.size());
-			argp.resize(bifunc->arguments.size());
+bool Expression::_execute(const Variant *const *p_inputs, int p_input_count, Object *p_instance, Variant &r_ret, String &r_error_str) {
+	Variant *s = stack.ptr();
 
-			for (int i = 0; i < bifunc->arguments.size(); i++) {
-				Variant value;
-				bool ret = _execute(p_inputs, p_instance, bifunc->arguments[i], value, r_error_str);
-				if (ret) {
-					return true;
-				}
-				arr.write[i] = value;
-				argp.write[i] = &arr[i];
-			}
+	for (uint32_t i = 0; i < used_inputs.size(); i++) {
+		const UsedInput &input = used_inputs[i];
+		if (input.index >= p_input_count) {
+			r_error_str = vformat(RTR("Invalid input %i (not passed) in expression"), input.index);
+			return true;
+		}
+		s[input.slot] = *p_inputs[input.index];
+	}
 
-			r_ret = Variant(); //may not return anything
-			Callable::CallError ce;
-			Variant::call_utility_function(bifunc->func, &r_ret, (const Variant **)argp.ptr(), argp.size(), ce);
-			if (ce.error != Callable::CallError::CALL_OK) {
-				r_error_str = "Builtin Call Failed. " + Variant::get_call_error_text(bifunc->func, (const Variant **)argp.ptr(), argp.size(), ce);
-				return true;
-			}
+	const Variant **argp = call_args.ptr();
 
-		} break;
-		case Expression::ENode::TYPE_CALL: {
-			const Expression::CallNode *call = static_cast<const Expression::CallNode *>(p_node);
+	for (uint32_t ip = 0; ip < program.size(); ip++) {
+		Instruction &ins = program[ip];
+		Variant &dst = s[ins.dst];
 
-			Variant base;
-			bool ret = _execute(p_inputs, p_instance, call->base, base, r_error_str);
+		for (int i = 0; i < ins.arg_count; i++) {
+			argp[i] = &s[program_args[ins.arg_first + i]];
+		}
 
-			if (ret) {
-				return true;
-			}
+		switch (ins.opcode) {
+			case OPCODE_OPERATOR: {
+				const Variant &a = s[ins.a];
+				const Variant &b = s[ins.b];
 
-			Vector<Variant> arr;
-			Vector<const Variant *> argp;
-			arr.resize(call->arguments.size());
-			argp.resize(call->arguments.size());
+				if (unlikely(a.get_type() != ins.eval_type_a || b.get_type() != ins.eval_type_b)) {
+					_resolve_evaluator(ins, a.get_type(), b.get_type());
+				}
 
-			for (int i = 0; i < call->arguments.size(); i++) {
-				Variant value;
-				ret = _execute(p_inputs, p_instance, call->arguments[i], value, r_error_str);
+				if (ins.evaluator) {
+					// Evaluators can write in place, the previous result may still be referenced.
+					if (dst.get_type() != ins.eval_type_ret || !_is_value_type(ins.eval_type_ret)) {
+						VariantInternal::initialize(&dst, ins.eval_type_ret);
+					}
+					ins.evaluator(&a, &b, &dst);
+				} else {
+					bool valid = true;
+					Variant::evaluate(ins.op, a, b, dst, valid);
+					if (!valid) {
+						r_error_str = vformat(RTR("Invalid operands to operator %s, %s and %s."), Variant::get_operator_name(ins.op), Variant::get_type_name(a.get_type()), Variant::get_type_name(b.get_type()));
+						return true;
+					}
+				}
+			} break;
+			case OPCODE_INDEX: {
+				const Variant &base = s[ins.a];
+				const Variant &idx = s[ins.b];
+
+				bool valid;
+				dst = base.get(idx, &valid);
+				if (!valid) {
+					r_error_str = vformat(RTR("Invalid index of type %s for base type %s"), Variant::get_type_name(idx.get_type()), Variant::get_type_name(base.get_type()));
+					return true;
+				}
+			} break;
+			case OPCODE_NAMED_INDEX: {
+				const Variant &base = s[ins.a];
 
-				if (ret) {
+				bool valid;
+				dst = base.get_named(ins.name, valid);
+				if (!valid) {
+					r_error_str = vformat(RTR("Invalid named index '%s' for base type %s"), String(ins.name), Variant::get_type_name(base.get_type()));
 					return true;
 				}
-				arr.write[i] = value;
-				argp.write[i] = &arr[i];
-			}
+			} break;
+			case OPCODE_ARRAY: {
+				// Always a new array, the previous result may still be referenced.
+				Array arr;
+				arr.resize(ins.arg_count);
+				for (int i = 0; i < ins.arg_count; i++) {
+					arr[i] = *argp[i];
+				}
+				dst = arr;
+			} break;
+			case OPCODE_DICTIONARY: {
+				Dictionary d;
+				for (int i = 0; i < ins.arg_count; i += 2) {
+					d[*argp[i + 0]] = *argp[i + 1];
+				}
+				dst = d;
+			} break;
+			case OPCODE_CONSTRUCTOR: {
+				Callable::CallError ce;
+				Variant::construct(ins.data_type, dst, argp, ins.arg_count, ce);
 
-			Callable::CallError ce;
-			base.call(call->method, (const Variant **)argp.ptr(), argp.size(), r_ret, ce);
+				if (ce.error != Callable::CallError::CALL_OK) {
+					r_error_str = vformat(RTR("Invalid arguments to construct '%s'"), Variant::get_type_name(ins.data_type));
+					return true;
+				}
+			} break;
+			case OPCODE_BUILTIN_FUNC: {
+				dst = Variant(); //may not return anything
+				Callable::CallError ce;
+				Variant::call_utility_function(ins.name, &dst, argp, ins.arg_count, ce);
+				if (ce.error != Callable::CallError::CALL_OK) {
+					r_error_str = "Builtin Call Failed. " + Variant::get_call_error_text(ins.name, argp, ins.arg_count, ce);
+					return true;
+				}
+			} break;
+			case OPCODE_CALL: {
+				// Called on a copy, the base may be an input or a constant.
+				Variant base = s[ins.a];
 
-			if (ce.error != Callable::CallError::CALL_OK) {
-				r_error_str = vformat(RTR("On call to '%s':"), String(call->method));
-				return true;
-			}
+				Callable::CallError ce;
+				base.call(ins.name, argp, ins.arg_count, dst, ce);
 
-		} break;
+				if (ce.error != Callable::CallError::CALL_OK) {
+					r_error_str = vformat(RTR("On call to '%s':"), String(ins.name));
+					return true;
+				}
+			} break;
+			case OPCODE_SELF: {
+				if (!p_instance) {
+					r_error_str = RTR("self can't be used because instance is null (not passed)");
+					return true;
+				}
+				dst = p_instance;
+			} break;
+		}
 	}
+
+	r_ret = s[result_slot];
 	return false;
 }
 
@@ -1405,6 +1510,13 @@ Error Expression::parse(const String &p_expression, const Vector<String> &p_inpu
 		return ERR_INVALID_PARAMETER;
 	}
 
+	_compile_program();
+
+	// The program doesn't refer to the tree.
+	memdelete(nodes);
+	nodes = nullptr;
+	root = nullptr;
+
 	return OK;
 }
 
@@ -1412,9 +1524,16 @@ Variant Expression::execute(Array p_inputs, Object *p_base, bool p_show_error) {
 	ERR_FAIL_COND_V_MSG(error_set, Variant(), "There was previously a parse error: " + error_str + ".");
 
 	execution_error = false;
+
+	int input_count = p_inputs.size();
+	const Variant **inputs = (const Variant **)alloca(sizeof(Variant *) * input_count);
+	for (int i = 0; i < input_count; i++) {
+		inputs[i] = &p_inputs[i];
+	}
+
 	Variant output;
 	String error_txt;
-	bool err = _execute(p_inputs, p_base, root, output, error_txt);
+	bool err = _execute(inputs, input_count, p_base, output, error_txt);
 	if (err) {
 		execution_error = true;
 		error_str = error_txt;
@@ -1424,6 +1543,56 @@ Variant Expression::execute(Array p_inputs, Object *p_base, bool p_show_error) {
 	return output;
 }
 
+Array Expression::execute_batch(Array p_inputs, Object *p_base, bool p_show_error) {
+	ERR_FAIL_COND_V_MSG(error_set, Array(), "There was previously a parse error: " + error_str + ".");
+
+	execution_error = false;
+
+	// One array of values per input, all of the same size.
+	int input_count = p_inputs.size();
+	uint64_t count = 0;
+	for (int i = 0; i < input_count; i++) {
+		const Variant &values = p_inputs[i];
+		ERR_FAIL_COND_V_MSG(!values.is_array(), Array(), vformat("Input %d is not an array.", i));
+		if (i == 0) {
+			count = values.get_indexed_size();
+		} else {
+			ERR_FAIL_COND_V_MSG(values.get_indexed_size() != count, Array(), vformat("Input %d doesn't have the same size as the first input.", i));
+		}
+	}
+
+	const Variant **inputs = (const Variant **)alloca(sizeof(Variant *) * input_count);
+	LocalVector<Variant> unpacked;
+	unpacked.resize(input_count);
+
+	Array results;
+	results.resize(count);
+
+	for (uint64_t n = 0; n < count; n++) {
+		for (int i = 0; i < input_count; i++) {
+			const Variant &values = p_inputs[i];
+			if (values.get_type() == Variant::ARRAY) {
+				inputs[i] = &(*VariantGetInternalPtr<Array>::get_ptr(&values))[n];
+			} else {
+				bool valid, oob;
+				unpacked[i] = values.get_indexed(n, valid, oob);
+				inputs[i] = &unpacked[i];
+			}
+		}
+
+		String error_txt;
+		bool err = _execute(inputs, input_count, p_base, results[n], error_txt);
+		if (err) {
+			execution_error = true;
+			error_str = error_txt;
+			ERR_FAIL_COND_V_MSG(p_show_error, Array(), error_str);
+			return Array();
+		}
+	}
+
+	return results;
+}
+
 bool Expression::has_execute_failed() const {
 	return execution_error;
 }
@@ -1435,6 +1604,7 @@ String Expression::get_error_text() const {
 void Expression::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("parse", "expression", "input_names"), &Expression::parse, DEFVAL(Vector<String>()));
 	ClassDB::bind_method(D_METHOD("execute", "inputs", "base_instance", "show_error"), &Expression::execute, DEFVAL(Array()), DEFVAL(Variant()), DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("execute_batch", "inputs", "base_instance", "show_error"), &Expression::execute_batch, DEFVAL(Variant()), DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("has_execute_failed"), &Expression::has_execute_failed);
 	ClassDB::bind_method(D_METHOD("get_error_text"), &Expression::get_error_text);
 }
@@ -32,6 +32,7 @@
 #define EXPRESSION_H
 
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 
 class Expression : public RefCounted {
 	GDCLASS(Expression, RefCounted);
@@ -255,8 +256,61 @@ private:
 
 	Vector<String> input_names;
 
+	// After parsing, the tree is compiled to a flat list of instructions. Every instruction writes
+	// its result to its own slot in the stack, which also holds the used inputs and the constants
+	// (including the ones folded at compile time).
+	enum Opcode {
+		OPCODE_OPERATOR,
+		OPCODE_INDEX,
+		OPCODE_NAMED_INDEX,
+		OPCODE_ARRAY,
+		OPCODE_DICTIONARY,
+		OPCODE_CONSTRUCTOR,
+		OPCODE_BUILTIN_FUNC,
+		OPCODE_CALL,
+		OPCODE_SELF,
+	};
+
+	struct Instruction {
+		Opcode opcode = OPCODE_OPERATOR;
+		int dst = 0;
+		int a = 0; // Operand, or base.
+		int b = 0; // Second operand, or index.
+		int arg_first = 0; // In program_args.
+		int arg_count = 0;
+		Variant::Operator op = Variant::OP_MAX;
+		Variant::Type data_type = Variant::NIL;
+		StringName name;
+
+		// Validated evaluator for the operand types seen last (or known at compile time).
+		Variant::Type eval_type_a = Variant::VARIANT_MAX;
+		Variant::Type eval_type_b = Variant::VARIANT_MAX;
+		Variant::Type eval_type_ret = Variant::NIL;
+		Variant::ValidatedOperatorEvaluator evaluator = nullptr;
+	};
+
+	struct UsedInput {
+		int index = 0;
+		int slot = 0;
+	};
+
+	LocalVector<Instruction> program;
+	LocalVector<int> program_args;
+	LocalVector<UsedInput> used_inputs;
+	LocalVector<Variant> stack;
+	LocalVector<Variant::Type> stack_types; // Only while compiling, VARIANT_MAX when not known.
+	LocalVector<bool> stack_constant; // Only while compiling.
+	LocalVector<const Variant *> call_args;
+	int result_slot = 0;
+
+	int _add_slot(Variant::Type p_type, bool p_constant = false, const Variant &p_value = Variant());
+	void _resolve_evaluator(Instruction &r_instruction, Variant::Type p_type_a, Variant::Type p_type_b) const;
+	int _compile_args(const Vector<ENode *> &p_args, int &r_first);
+	int _compile_node(ENode *p_node);
+	void _compile_program();
+
 	bool execution_error = false;
-	bool _execute(const Array &p_inputs, Object *p_instance, Expression::ENode *p_node, Variant &r_ret, String &r_error_str);
+	bool _execute(const Variant *const *p_inputs, int p_input_count, Object *p_instance, Variant &r_ret, String &r_error_str);
 
 protected:
 	static void _bind_methods();
@@ -264,6 +318,7 @@ protected:
 public:
 	Error parse(const String &p_expression, const Vector<String> &p_input_names = Vector<String>());
 	Variant execute(Array p_inputs = Array(), Object *p_base = nullptr, bool p_show_error = true);
+	Array execute_batch(Array p_inputs, Object *p_base = nullptr, bool p_show_error = true);
 	bool has_execute_failed() const;
 	String get_error_text() const;
 
@@ -41,6 +41,62 @@
 Error MultiplayerReplicator::_sync_all_default(const ResourceUID::ID &p_scene_id, int p_peer) {
 	ERR_FAIL_COND_V(!replications.has(p_scene_id), ERR_INVALID_PARAMETER);
 	SceneConfig &cfg = replications[p_scene_id];
+	const uint8_t seq = cfg.sync_recv++;
+	SyncSnapshot &snapshot = cfg.sync_history[seq % SYNC_HISTORY_SIZE];
+	snapshot.valid = true;
+	snapshot.seq = seq;
+	snapshot.state.clear();
+	if (tracked_objects.has(p_scene_id)) {
+		for (const ObjectID &obj_id : tracked_objects[p_scene_id]) {
+			Object *obj = ObjectDB::get_instance(obj_id);
+			if (obj) {
+				List<Variant> state;
+				Error err = _get_state(cfg.sync_properties, obj, state);
+				ERR_CONTINUE(err);
+				snapshot.state[obj_id] = state;
+			}
+		}
+	}
+	// Default implementation do not send empty updates.
+	if (snapshot.state.is_empty()) {
+		return OK;
+	}
+
+	Set<int> peers;
+	if (p_peer > 0) {
+		peers.insert(p_peer);
+	} else {
+		peers = multiplayer->get_connected_peers();
+		if (p_peer < 0) {
+			peers.erase(-p_peer);
+		}
+	}
+	for (Set<int>::Element *E = peers.front(); E; E = E->next()) {
+		// Send the changes since the last state the peer acknowledged, if we still have it.
+		const SyncSnapshot *baseline = nullptr;
+		const Map<int, uint8_t>::Element *A = cfg.sync_acks.find(E->get());
+		if (A && uint8_t(seq - A->get()) < SYNC_HISTORY_SIZE) {
+			const SyncSnapshot &acked = cfg.sync_history[A->get() % SYNC_HISTORY_SIZE];
+			if (acked.valid && acked.seq == A->get()) {
+				baseline = &acked;
+			}
+		}
+		const List<ObjectID> *objects = &tracked_objects[p_scene_id];
+		if (cfg.visibility_filter.is_valid()) {
+			const Map<int, List<ObjectID>>::Element *V = cfg.peer_objects.find(E->get());
+			if (!V) {
+				continue; // Sees nothing.
+			}
+			objects = &V->get();
+		}
+		Error err = baseline ? _send_sync_delta(p_scene_id, E->get(), *objects, snapshot, *baseline) : _send_sync_full(p_scene_id, E->get(), *objects, snapshot);
+		ERR_CONTINUE(err);
+	}
+	return OK;
+}
+
+Error MultiplayerReplicator::_send_sync_full(const ResourceUID::ID &p_scene_id, int p_peer, const List<ObjectID> &p_objects, const SyncSnapshot &p_snapshot) {
+	const SceneConfig &cfg = replications[p_scene_id];
 	int full_size = 0;
 	bool same_size = true;
 	int last_size = 0;
@@ -48,29 +104,24 @@ Error MultiplayerReplicator::_sync_all_default(const ResourceUID::ID &p_scene_id
 	struct EncodeInfo {
 		int size = 0;
 		bool raw = false;
-		List<Variant> state;
 	};
 	Map<ObjectID, struct EncodeInfo> state;
-	if (tracked_objects.has(p_scene_id)) {
-		for (const ObjectID &obj_id : tracked_objects[p_scene_id]) {
-			Object *obj = ObjectDB::get_instance(obj_id);
-			if (obj) {
-				struct EncodeInfo info;
-				Error err = _get_state(cfg.sync_properties, obj, info.state);
-				ERR_CONTINUE(err);
-				err = _encode_state(info.state, nullptr, info.size, &info.raw);
-				ERR_CONTINUE(err);
-				state[obj_id] = info;
-				full_size += info.size;
-				if (last_size && info.size != last_size) {
-					same_size = false;
-				}
-				all_raw = all_raw && info.raw;
-				last_size = info.size;
-			}
+	for (const ObjectID &obj_id : p_objects) {
+		const Map<ObjectID, List<Variant>>::Element *S = p_snapshot.state.find(obj_id);
+		if (!S) {
+			continue;
+		}
+		struct EncodeInfo info;
+		Error err = _encode_state(S->get(), nullptr, info.size, &info.raw);
+		ERR_CONTINUE(err);
+		state[obj_id] = info;
+		full_size += info.size;
+		if (last_size && info.size != last_size) {
+			same_size = false;
 		}
+		all_raw = all_raw && info.raw;
+		last_size = info.size;
 	}
-	// Default implementation do not send empty updates.
 	if (!full_size) {
 		return OK;
 	}
@@ -91,25 +142,23 @@ Error MultiplayerReplicator::_sync_all_default(const ResourceUID::ID &p_scene_id
 	ptr[0] = MultiplayerAPI::NETWORK_COMMAND_SYNC | (same_size ? BYTE_OR_ZERO_FLAG : 0);
 	ofs = 1;
 	ofs += encode_uint64(p_scene_id, &ptr[ofs]);
-	ptr[ofs] = cfg.sync_recv++;
+	ptr[ofs] = p_snapshot.seq;
 	ofs += 1;
 	ofs += encode_uint16(state.size(), &ptr[ofs]);
 	if (same_size) {
 		ofs += encode_uint16(last_size + (all_raw ? 1 << 15 : 0), &ptr[ofs]);
 	}
-	for (const ObjectID &obj_id : tracked_objects[p_scene_id]) {
+	for (const ObjectID &obj_id : p_objects) {
 		if (!state.has(obj_id)) {
 			continue;
 		}
 		struct EncodeInfo &info = state[obj_id];
-		Object *obj = ObjectDB::get_instance(obj_id);
-		ERR_CONTINUE(!obj);
 		int size = 0;
 		if (!same_size) {
 			// We need to encode the size of every object.
 			ofs += encode_uint16(info.size + (info.raw ? 1 << 15 : 0), &ptr[ofs]);
 		}
-		Error err = _encode_state(info.state, &ptr[ofs], size, &info.raw);
+		Error err = _encode_state(p_snapshot.state[obj_id], &ptr[ofs], size, &info.raw);
 		ERR_CONTINUE(err);
 		ofs += size;
 	}
@@ -120,6 +169,93 @@ Error MultiplayerReplicator::_sync_all_default(const ResourceUID::ID &p_scene_id
 	return peer->put_packet(ptr, ofs);
 }
 
+Error MultiplayerReplicator::_send_sync_delta(const ResourceUID::ID &p_scene_id, int p_peer, const List<ObjectID> &p_objects, const SyncSnapshot &p_snapshot, const SyncSnapshot &p_baseline) {
+	const SceneConfig &cfg = replications[p_scene_id];
+	const int mask_size = (cfg.sync_properties.size() + 7) / 8;
+
+	// Every instance gets a bit mask of the properties that changed since the baseline, followed by their values.
+	LocalVector<uint8_t> masks;
+	masks.resize(p_objects.size() * mask_size);
+	memset(masks.ptr(), 0, masks.size());
+	int size = SYNC_CMD_OFFSET + 1 + 2 + 1;
+	int obj_idx = 0;
+	for (const ObjectID &obj_id : p_objects) {
+		const Map<ObjectID, List<Variant>>::Element *S = p_snapshot.state.find(obj_id);
+		if (!S) {
+			continue;
+		}
+		const Map<ObjectID, List<Variant>>::Element *B = p_baseline.state.find(obj_id);
+		const List<Variant>::Element *base = B ? B->get().front() : nullptr;
+		uint8_t *mask = &masks[obj_idx * mask_size];
+		size += mask_size;
+		int prop_idx = 0;
+		for (const List<Variant>::Element *V = S->get().front(); V; V = V->next()) {
+			if (!base || !(base->get() == V->get())) {
+				mask[prop_idx / 8] |= 1 << (prop_idx % 8);
+				int vlen = 0;
+				Error err = multiplayer->encode_and_compress_variant(V->get(), nullptr, vlen);
+				ERR_FAIL_COND_V(err, err);
+				size += vlen;
+			}
+			if (base) {
+				base = base->next();
+			}
+			prop_idx++;
+		}
+		obj_idx++;
+	}
+
+	MAKE_ROOM(size);
+	uint8_t *ptr = packet_cache.ptrw();
+	ptr[0] = MultiplayerAPI::NETWORK_COMMAND_SYNC | SYNC_DELTA_FLAG;
+	int ofs = 1;
+	ofs += encode_uint64(p_scene_id, &ptr[ofs]);
+	ptr[ofs] = p_snapshot.seq;
+	ofs += 1;
+	ofs += encode_uint16(obj_idx, &ptr[ofs]);
+	ptr[ofs] = p_baseline.seq;
+	ofs += 1;
+	obj_idx = 0;
+	for (const ObjectID &obj_id : p_objects) {
+		const Map<ObjectID, List<Variant>>::Element *S = p_snapshot.state.find(obj_id);
+		if (!S) {
+			continue;
+		}
+		const uint8_t *mask = &masks[obj_idx * mask_size];
+		memcpy(&ptr[ofs], mask, mask_size);
+		ofs += mask_size;
+		int prop_idx = 0;
+		for (const List<Variant>::Element *V = S->get().front(); V; V = V->next()) {
+			if (mask[prop_idx / 8] & (1 << (prop_idx % 8))) {
+				int vlen = 0;
+				multiplayer->encode_and_compress_variant(V->get(), &ptr[ofs], vlen);
+				ofs += vlen;
+			}
+			prop_idx++;
+		}
+		obj_idx++;
+	}
+	ERR_FAIL_COND_V(ofs != size, ERR_BUG);
+	Ref<MultiplayerPeer> peer = multiplayer->get_multiplayer_peer();
+	peer->set_target_peer(p_peer);
+	peer->set_transfer_channel(0);
+	peer->set_transfer_mode(Multiplayer::TRANSFER_MODE_UNRELIABLE);
+	return peer->put_packet(ptr, ofs);
+}
+
+Error MultiplayerReplicator::_send_sync_ack(const ResourceUID::ID &p_scene_id, uint8_t p_seq) {
+	MAKE_ROOM(SYNC_CMD_OFFSET + 1);
+	uint8_t *ptr = packet_cache.ptrw();
+	ptr[0] = MultiplayerAPI::NETWORK_COMMAND_SYNC | SYNC_ACK_FLAG;
+	encode_uint64(p_scene_id, &ptr[1]);
+	ptr[SYNC_CMD_OFFSET] = p_seq;
+	Ref<MultiplayerPeer> peer = multiplayer->get_multiplayer_peer();
+	peer->set_target_peer(1);
+	peer->set_transfer_channel(0);
+	peer->set_transfer_mode(Multiplayer::TRANSFER_MODE_UNRELIABLE);
+	return peer->put_packet(ptr, SYNC_CMD_OFFSET + 1);
+}
+
 void MultiplayerReplicator::_process_default_sync(const ResourceUID::ID &p_id, const uint8_t *p_packet, int p_packet_len) {
 	ERR_FAIL_COND_MSG(p_packet_len < SYNC_CMD_OFFSET + 5, "Invalid spawn packet received");
 	ERR_FAIL_COND_MSG(!replications.has(p_id), "Invalid spawn ID received " + itos(p_id));
@@ -143,6 +279,10 @@ void MultiplayerReplicator::_process_default_sync(const ResourceUID::ID &p_id, c
 		return;
 	}
 #endif
+	if (p_packet[0] & SYNC_DELTA_FLAG) {
+		_process_delta_sync(p_id, time, &p_packet[ofs], p_packet_len - ofs);
+		return;
+	}
 	int data_size = 0;
 	bool raw = false;
 	if (same_size) {
@@ -153,8 +293,15 @@ void MultiplayerReplicator::_process_default_sync(const ResourceUID::ID &p_id, c
 		ofs += 2;
 		ERR_FAIL_COND(p_packet_len - ofs < data_size * count);
 	}
+	// Keep what we received, later updates only carry the changes from it.
+	SyncSnapshot &snapshot = cfg.sync_history[time % SYNC_HISTORY_SIZE];
+	snapshot.valid = false;
+	snapshot.seq = time;
+	snapshot.state.clear();
+	bool complete = true;
 	for (const ObjectID &obj_id : tracked_objects[p_id]) {
 		Object *obj = ObjectDB::get_instance(obj_id);
+		complete = complete && obj;
 		ERR_CONTINUE(!obj);
 		if (!same_size) {
 			// This is slow and wasteful.
@@ -165,10 +312,77 @@ void MultiplayerReplicator::_process_default_sync(const ResourceUID::ID &p_id, c
 			ERR_FAIL_COND(p_packet_len - ofs < data_size);
 		}
 		int size = 0;
-		Error err = _decode_state(cfg.sync_properties, obj, &p_packet[ofs], data_size, size, raw);
+		List<Variant> state;
+		Error err = _decode_state(cfg.sync_properties, obj, &p_packet[ofs], data_size, size, raw, &state);
 		ofs += data_size;
+		complete = complete && err == OK && size == data_size;
 		ERR_CONTINUE(err);
 		ERR_CONTINUE(size != data_size);
+		snapshot.state[obj_id] = state;
+	}
+	if (complete) {
+		snapshot.valid = true;
+		_send_sync_ack(p_id, time);
+	}
+}
+
+void MultiplayerReplicator::_process_delta_sync(const ResourceUID::ID &p_id, uint8_t p_seq, const uint8_t *p_packet, int p_packet_len) {
+	SceneConfig &cfg = replications[p_id];
+	ERR_FAIL_COND_MSG(p_packet_len < 1, "Invalid sync packet received");
+	const uint8_t baseline_seq = p_packet[0];
+	int ofs = 1;
+	const SyncSnapshot &baseline = cfg.sync_history[baseline_seq % SYNC_HISTORY_SIZE];
+	// We only ever acknowledge complete states, the server should not reference anything else.
+	ERR_FAIL_COND_MSG(!baseline.valid || baseline.seq != baseline_seq || baseline_seq == p_seq, "Received a sync update for an unknown state.");
+
+	const int prop_count = cfg.sync_properties.size();
+	const int mask_size = (prop_count + 7) / 8;
+	SyncSnapshot snapshot;
+	snapshot.seq = p_seq;
+	bool complete = true;
+	Vector<Variant> values;
+	values.resize(prop_count);
+	for (const ObjectID &obj_id : tracked_objects[p_id]) {
+		ERR_FAIL_COND_MSG(p_packet_len - ofs < mask_size, "Invalid packet received. Size too small.");
+		const uint8_t *mask = &p_packet[ofs];
+		ofs += mask_size;
+		const Map<ObjectID, List<Variant>>::Element *B = baseline.state.find(obj_id);
+		const List<Variant>::Element *base = B ? B->get().front() : nullptr;
+		bool obj_complete = true;
+		for (int i = 0; i < prop_count; i++) {
+			if (mask[i / 8] & (1 << (i % 8))) {
+				ERR_FAIL_COND_MSG(ofs >= p_packet_len, "Invalid packet received. Size too small.");
+				int vlen;
+				Error err = multiplayer->decode_and_decompress_variant(values.write[i], &p_packet[ofs], p_packet_len - ofs, &vlen);
+				ERR_FAIL_COND_MSG(err != OK, "Invalid packet received. Unable to decode state variable.");
+				ofs += vlen;
+			} else if (base) {
+				values.write[i] = base->get();
+			} else {
+				obj_complete = false;
+			}
+			if (base) {
+				base = base->next();
+			}
+		}
+		Object *obj = ObjectDB::get_instance(obj_id);
+		if (!obj || !obj_complete) {
+			complete = false;
+			continue;
+		}
+		List<Variant> &state = snapshot.state[obj_id];
+		int i = 0;
+		for (const StringName &prop : cfg.sync_properties) {
+			obj->set(prop, values[i]);
+			state.push_back(values[i]);
+			i++;
+		}
+	}
+	ERR_FAIL_COND_MSG(ofs != p_packet_len, "Buffer has trailing bytes.");
+	if (complete) {
+		snapshot.valid = true;
+		cfg.sync_history[p_seq % SYNC_HISTORY_SIZE] = snapshot;
+		_send_sync_ack(p_id, p_seq);
 	}
 }
 
@@ -339,6 +553,20 @@ void MultiplayerReplicator::process_sync(int p_from, const uint8_t *p_packet, in
 	ERR_FAIL_COND_MSG(p_packet_len < SPAWN_CMD_OFFSET, "Invalid spawn packet received");
 	ResourceUID::ID id = decode_uint64(&p_packet[1]);
 	ERR_FAIL_COND_MSG(!replications.has(id), "Invalid spawn ID received " + itos(id));
+	if (p_packet[0] & SYNC_ACK_FLAG) {
+		ERR_FAIL_COND_MSG(p_packet_len != SYNC_CMD_OFFSET + 1, "Invalid sync ack received");
+		ERR_FAIL_COND(!multiplayer->is_server());
+		SceneConfig &cfg = replications[id];
+		const uint8_t seq = p_packet[SYNC_CMD_OFFSET];
+		Map<int, uint8_t>::Element *E = cfg.sync_acks.find(p_from);
+		if (!E) {
+			cfg.sync_acks[p_from] = seq;
+		} else if (int8_t(seq - E->get()) > 0) {
+			// Acknowledgements are unreliable too, ignore the ones that arrive late.
+			E->get() = seq;
+		}
+		return;
+	}
 	const SceneConfig &cfg = replications[id];
 	if (cfg.on_sync_receive.is_valid()) {
 		Array objs;
@@ -407,7 +635,7 @@ Error MultiplayerReplicator::_encode_state(const List<Variant> &p_variants, uint
 	return OK;
 }
 
-Error MultiplayerReplicator::_decode_state(const List<StringName> &p_properties, Object *p_obj, const uint8_t *p_buffer, int p_len, int &r_len, bool p_raw) {
+Error MultiplayerReplicator::_decode_state(const List<StringName> &p_properties, Object *p_obj, const uint8_t *p_buffer, int p_len, int &r_len, bool p_raw, List<Variant> *r_state) {
 	r_len = 0;
 	int argc = p_properties.size();
 	if (argc == 0 && p_raw) {
@@ -421,6 +649,9 @@ Error MultiplayerReplicator::_decode_state(const List<StringName> &p_properties,
 		pba.resize(p_len);
 		memcpy(pba.ptrw(), p_buffer, p_len);
 		p_obj->set(p_properties[0], pba);
+		if (r_state) {
+			r_state->push_back(pba);
+		}
 		return OK;
 	}
 
@@ -441,6 +672,9 @@ Error MultiplayerReplicator::_decode_state(const List<StringName> &p_properties,
 	int i = 0;
 	for (const StringName &prop : p_properties) {
 		p_obj->set(prop, args[i]);
+		if (r_state) {
+			r_state->push_back(args[i]);
+		}
 		i += 1;
 	}
 	return OK;
@@ -637,14 +871,29 @@ void MultiplayerReplicator::scene_enter_exit_notify(const String &p_scene, Node
 		if (cfg.mode == REPLICATION_MODE_SERVER && multiplayer->is_server()) {
 			replicated_nodes[p_node->get_instance_id()] = id;
 			_track(id, p_node);
-			spawn(id, p_node, 0);
+			if (cfg.visibility_filter.is_valid()) {
+				update_visibility(id, p_node);
+			} else {
+				spawn(id, p_node, 0);
+			}
 		}
 		emit_signal(SNAME("replicated_instance_added"), id, p_node);
 	} else {
 		if (cfg.mode == REPLICATION_MODE_SERVER && multiplayer->is_server() && replicated_nodes.has(p_node->get_instance_id())) {
 			replicated_nodes.erase(p_node->get_instance_id());
 			_untrack(id, p_node);
-			despawn(id, p_node, 0);
+			if (cfg.visibility_filter.is_valid()) {
+				const Map<ObjectID, Set<int>>::Element *V = cfg.visible_peers.find(p_node->get_instance_id());
+				if (V) {
+					const Set<int> peers = V->get();
+					for (const int &P : peers) {
+						_set_visible_for(id, p_node, P, false);
+					}
+				}
+				replications[id].visible_peers.erase(p_node->get_instance_id());
+			} else {
+				despawn(id, p_node, 0);
+			}
 		}
 		emit_signal(SNAME("replicated_instance_removed"), id, p_node);
 	}
@@ -657,8 +906,106 @@ void MultiplayerReplicator::spawn_all(int p_peer) {
 		ERR_CONTINUE(!obj);
 		Node *node = Object::cast_to<Node>(obj);
 		ERR_CONTINUE(!node);
-		spawn(E.value, node, p_peer);
+		if (replications[E.value].visibility_filter.is_valid()) {
+			_set_visible_for(E.value, node, p_peer, _is_visible_for(replications[E.value], node, p_peer));
+		} else {
+			spawn(E.value, node, p_peer);
+		}
+	}
+}
+
+void MultiplayerReplicator::remove_peer(int p_peer) {
+	for (KeyValue<ResourceUID::ID, SceneConfig> &E : replications) {
+		E.value.sync_acks.erase(p_peer);
+		E.value.peer_objects.erase(p_peer);
+		for (KeyValue<ObjectID, Set<int>> &V : E.value.visible_peers) {
+			V.value.erase(p_peer);
+		}
+	}
+}
+
+bool MultiplayerReplicator::_is_visible_for(const SceneConfig &p_cfg, Object *p_obj, int p_peer) {
+	Variant args[2] = { p_peer, p_obj };
+	const Variant *argp[2] = { &args[0], &args[1] };
+	Callable::CallError ce;
+	Variant ret;
+	p_cfg.visibility_filter.call(argp, 2, ret, ce);
+	ERR_FAIL_COND_V_MSG(ce.error != Callable::CallError::CALL_OK, false, "Visibility filter failed");
+	return ret;
+}
+
+void MultiplayerReplicator::_set_visible_for(const ResourceUID::ID &p_scene_id, Object *p_obj, int p_peer, bool p_visible) {
+	SceneConfig &cfg = replications[p_scene_id];
+	const ObjectID obj_id = p_obj->get_instance_id();
+	Set<int> &peers = cfg.visible_peers[obj_id];
+	if (peers.has(p_peer) == p_visible) {
+		return;
+	}
+	if (p_visible) {
+		peers.insert(p_peer);
+		cfg.peer_objects[p_peer].push_back(obj_id);
+		spawn(p_scene_id, p_obj, p_peer);
+	} else {
+		peers.erase(p_peer);
+		Map<int, List<ObjectID>>::Element *E = cfg.peer_objects.find(p_peer);
+		if (E) {
+			E->get().erase(obj_id);
+		}
+		despawn(p_scene_id, p_obj, p_peer);
+	}
+}
+
+Error MultiplayerReplicator::visibility_config(const ResourceUID::ID &p_id, const Callable &p_filter) {
+	ERR_FAIL_COND_V(!replications.has(p_id), ERR_UNCONFIGURED);
+	SceneConfig &cfg = replications[p_id];
+	ERR_FAIL_COND_V_MSG(cfg.mode != REPLICATION_MODE_SERVER, ERR_INVALID_PARAMETER, "Visibility filters are only supported by the default server mode implementation.");
+	ERR_FAIL_COND_V_MSG(tracked_objects.has(p_id) && !tracked_objects[p_id].is_empty(), ERR_BUSY, "Visibility must be configured before any instance of the scene is replicated.");
+	cfg.visibility_filter = p_filter;
+	cfg.visible_peers.clear();
+	cfg.peer_objects.clear();
+	return OK;
+}
+
+Error MultiplayerReplicator::update_visibility(const ResourceUID::ID &p_scene_id, Object *p_obj, int p_peer) {
+	ERR_FAIL_COND_V(!replications.has(p_scene_id), ERR_INVALID_PARAMETER);
+	const SceneConfig &cfg = replications[p_scene_id];
+	ERR_FAIL_COND_V_MSG(!cfg.visibility_filter.is_valid(), ERR_UNCONFIGURED, "No visibility filter configured, see visibility_config().");
+	ERR_FAIL_COND_V_MSG(!multiplayer->has_multiplayer_peer() || !multiplayer->is_server(), ERR_UNAVAILABLE, "Visibility can only be updated by the server.");
+	if (!tracked_objects.has(p_scene_id)) {
+		return OK;
+	}
+	Set<int> peers;
+	if (p_peer > 0) {
+		peers.insert(p_peer);
+	} else {
+		peers = multiplayer->get_connected_peers();
+	}
+	// Only the given instance, when there is one, so callers can update what actually moved.
+	for (const ObjectID &obj_id : tracked_objects[p_scene_id]) {
+		if (p_obj && p_obj->get_instance_id() != obj_id) {
+			continue;
+		}
+		Object *obj = ObjectDB::get_instance(obj_id);
+		ERR_CONTINUE(!obj);
+		for (const int &P : peers) {
+			_set_visible_for(p_scene_id, obj, P, _is_visible_for(cfg, obj, P));
+		}
 	}
+	return OK;
+}
+
+const Set<int> *MultiplayerReplicator::get_visible_peers(const Node *p_node) const {
+	const Map<ObjectID, ResourceUID::ID>::Element *R = replicated_nodes.find(p_node->get_instance_id());
+	if (!R) {
+		return nullptr;
+	}
+	const SceneConfig &cfg = replications[R->get()];
+	if (!cfg.visibility_filter.is_valid()) {
+		return nullptr;
+	}
+	const Map<ObjectID, Set<int>>::Element *V = cfg.visible_peers.find(R->key());
+	static const Set<int> none;
+	return V ? &V->get() : &none;
 }
 
 void MultiplayerReplicator::poll() {
@@ -762,6 +1109,14 @@ Error MultiplayerReplicator::send_sync(int p_peer_id, const ResourceUID::ID &p_s
 void MultiplayerReplicator::clear() {
 	tracked_objects.clear();
 	replicated_nodes.clear();
+	for (KeyValue<ResourceUID::ID, SceneConfig> &E : replications) {
+		for (int i = 0; i < SYNC_HISTORY_SIZE; i++) {
+			E.value.sync_history[i] = SyncSnapshot();
+		}
+		E.value.sync_acks.clear();
+		E.value.visible_peers.clear();
+		E.value.peer_objects.clear();
+	}
 }
 
 void MultiplayerReplicator::_bind_methods() {
@@ -775,6 +1130,8 @@ void MultiplayerReplicator::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("sync_all", "scene_id", "peer_id"), &MultiplayerReplicator::sync_all, DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("track", "scene_id", "object"), &MultiplayerReplicator::track);
 	ClassDB::bind_method(D_METHOD("untrack", "scene_id", "object"), &MultiplayerReplicator::untrack);
+	ClassDB::bind_method(D_METHOD("visibility_config", "scene_id", "filter"), &MultiplayerReplicator::visibility_config);
+	ClassDB::bind_method(D_METHOD("update_visibility", "scene_id", "object", "peer_id"), &MultiplayerReplicator::update_visibility, DEFVAL(Variant()), DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("encode_state", "scene_id", "object", "initial"), &MultiplayerReplicator::encode_state, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("decode_state", "scene_id", "object", "data", "initial"), &MultiplayerReplicator::decode_state, DEFVAL(true));
 
@@ -52,6 +52,17 @@ public:
 		REPLICATION_MODE_CUSTOM,
 	};
 
+	enum {
+		SYNC_HISTORY_SIZE = 32, // Must stay below 128, sequence numbers are a single byte.
+	};
+
+	// The state of all the tracked instances sent (or received) with a given sync sequence.
+	struct SyncSnapshot {
+		bool valid = false;
+		uint8_t seq = 0;
+		Map<ObjectID, List<Variant>> state;
+	};
+
 	struct SceneConfig {
 		ReplicationMode mode;
 		uint64_t sync_interval = 0;
@@ -63,6 +74,13 @@ public:
 		Callable on_spawn_despawn_receive;
 		Callable on_sync_send;
 		Callable on_sync_receive;
+		// Default sync, instances are sent as changes from the last state each peer acknowledged.
+		SyncSnapshot sync_history[SYNC_HISTORY_SIZE];
+		Map<int, uint8_t> sync_acks;
+		// Default server mode, with a filter instances are only spawned and synced to the peers that can see them.
+		Callable visibility_filter;
+		Map<ObjectID, Set<int>> visible_peers;
+		Map<int, List<ObjectID>> peer_objects; // In spawn order, which is also the order of the instances on the peer.
 	};
 
 protected:
@@ -75,6 +93,8 @@ private:
 
 	enum {
 		BYTE_OR_ZERO_FLAG = 1 << BYTE_OR_ZERO_SHIFT,
+		SYNC_DELTA_FLAG = 1 << MultiplayerAPI::CMD_FLAG_1_SHIFT,
+		SYNC_ACK_FLAG = 1 << MultiplayerAPI::CMD_FLAG_2_SHIFT,
 	};
 
 	MultiplayerAPI *multiplayer = nullptr;
@@ -86,7 +106,7 @@ private:
 	// Encoding
 	Error _get_state(const List<StringName> &p_properties, const Object *p_obj, List<Variant> &r_variant);
 	Error _encode_state(const List<Variant> &p_variants, uint8_t *p_buffer, int &r_len, bool *r_raw = nullptr);
-	Error _decode_state(const List<StringName> &p_cfg, Object *p_obj, const uint8_t *p_buffer, int p_len, int &r_len, bool p_raw = false);
+	Error _decode_state(const List<StringName> &p_cfg, Object *p_obj, const uint8_t *p_buffer, int p_len, int &r_len, bool p_raw = false, List<Variant> *r_state = nullptr);
 
 	// Spawn
 	Error _spawn_despawn(ResourceUID::ID p_scene_id, Object *p_obj, int p_peer, bool p_spawn);
@@ -96,10 +116,18 @@ private:
 
 	// Sync
 	void _process_default_sync(const ResourceUID::ID &p_id, const uint8_t *p_packet, int p_packet_len);
+	void _process_delta_sync(const ResourceUID::ID &p_id, uint8_t p_seq, const uint8_t *p_packet, int p_packet_len);
 	Error _sync_all_default(const ResourceUID::ID &p_scene_id, int p_peer);
+	Error _send_sync_full(const ResourceUID::ID &p_scene_id, int p_peer, const List<ObjectID> &p_objects, const SyncSnapshot &p_snapshot);
+	Error _send_sync_delta(const ResourceUID::ID &p_scene_id, int p_peer, const List<ObjectID> &p_objects, const SyncSnapshot &p_snapshot, const SyncSnapshot &p_baseline);
+	Error _send_sync_ack(const ResourceUID::ID &p_scene_id, uint8_t p_seq);
 	void _track(const ResourceUID::ID &p_scene_id, Object *p_object);
 	void _untrack(const ResourceUID::ID &p_scene_id, Object *p_object);
 
+	// Visibility
+	bool _is_visible_for(const SceneConfig &p_cfg, Object *p_obj, int p_peer);
+	void _set_visible_for(const ResourceUID::ID &p_scene_id, Object *p_obj, int p_peer, bool p_visible);
+
 public:
 	void clear();
 
@@ -121,11 +149,18 @@ public:
 	void track(const ResourceUID::ID &p_scene_id, Object *p_object);
 	void untrack(const ResourceUID::ID &p_scene_id, Object *p_object);
 
+	// Visibility
+	Error visibility_config(const ResourceUID::ID &p_id, const Callable &p_filter);
+	Error update_visibility(const ResourceUID::ID &p_scene_id, Object *p_object = nullptr, int p_peer = 0);
+	// Peers that can see the node, or nullptr if its visibility isn't filtered.
+	const Set<int> *get_visible_peers(const Node *p_node) const;
+
 	// Used by MultiplayerAPI
 	void spawn_all(int p_peer);
 	void process_spawn_despawn(int p_from, const uint8_t *p_packet, int p_packet_len, bool p_spawn);
 	void process_sync(int p_from, const uint8_t *p_packet, int p_packet_len);
 	void scene_enter_exit_notify(const String &p_scene, Node *p_node, bool p_enter);
+	void remove_peer(int p_peer);
 	void poll();
 
 	MultiplayerReplicator(MultiplayerAPI *p_multiplayer) {
@@ -33,6 +33,7 @@
 #include "core/debugger/engine_debugger.h"
 #include "core/io/marshalls.h"
 #include "core/multiplayer/multiplayer_api.h"
+#include "core/multiplayer/multiplayer_replicator.h"
 #include "scene/main/node.h"
 
 #ifdef DEBUG_ENABLED
@@ -59,6 +60,28 @@ int get_packet_len(uint32_t p_node_target, int p_packet_len) {
 	}
 }
 
+// Types whose encoded size never exceeds FIXED_ARG_SIZE_MAX.
+static bool _is_fixed_size_arg(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::NIL:
+		case Variant::BOOL:
+		case Variant::INT:
+		case Variant::FLOAT:
+		case Variant::VECTOR2:
+		case Variant::VECTOR2I:
+		case Variant::RECT2:
+		case Variant::RECT2I:
+		case Variant::VECTOR3:
+		case Variant::VECTOR3I:
+		case Variant::PLANE:
+		case Variant::QUATERNION:
+		case Variant::COLOR:
+			return true;
+		default:
+			return false;
+	}
+}
+
 const Multiplayer::RPCConfig _get_rpc_config(const Node *p_node, const StringName &p_method, uint16_t &r_id) {
 	const Vector<Multiplayer::RPCConfig> node_config = p_node->get_node_rpc_methods();
 	for (int i = 0; i < node_config.size(); i++) {
@@ -253,10 +276,14 @@ void RPCManager::_process_rpc(Node *p_node, const uint16_t p_rpc_method_id, int
 		p_offset += 1;
 	}
 
-	Vector<Variant> args;
-	Vector<const Variant *> argp;
-	args.resize(argc);
-	argp.resize(argc);
+	Variant stack_args[STACK_ARGS_MAX];
+	Vector<Variant> heap_args;
+	Variant *args = stack_args;
+	if (argc > STACK_ARGS_MAX) {
+		heap_args.resize(argc);
+		args = heap_args.ptrw();
+	}
+	const Variant **argp = (const Variant **)alloca(sizeof(Variant *) * argc);
 
 #ifdef DEBUG_ENABLED
 	_profile_node_data("in_rpc", p_node->get_instance_id());
@@ -267,27 +294,27 @@ void RPCManager::_process_rpc(Node *p_node, const uint16_t p_rpc_method_id, int
 		const int len = p_packet_len - p_offset;
 		pure_data.resize(len);
 		memcpy(pure_data.ptrw(), &p_packet[p_offset], len);
-		args.write[0] = pure_data;
-		argp.write[0] = &args[0];
+		args[0] = pure_data;
+		argp[0] = &args[0];
 		p_offset += len;
 	} else {
 		for (int i = 0; i < argc; i++) {
 			ERR_FAIL_COND_MSG(p_offset >= p_packet_len, "Invalid packet received. Size too small.");
 
 			int vlen;
-			Error err = multiplayer->decode_and_decompress_variant(args.write[i], &p_packet[p_offset], p_packet_len - p_offset, &vlen);
+			Error err = multiplayer->decode_and_decompress_variant(args[i], &p_packet[p_offset], p_packet_len - p_offset, &vlen);
 			ERR_FAIL_COND_MSG(err != OK, "Invalid packet received. Unable to decode RPC argument.");
 
-			argp.write[i] = &args[i];
+			argp[i] = &args[i];
 			p_offset += vlen;
 		}
 	}
 
 	Callable::CallError ce;
 
-	p_node->call(config.name, (const Variant **)argp.ptr(), argc, ce);
+	p_node->call(config.name, argp, argc, ce);
 	if (ce.error != Callable::CallError::CALL_OK) {
-		String error = Variant::get_call_error_text(p_node, config.name, (const Variant **)argp.ptr(), argc, ce);
+		String error = Variant::get_call_error_text(p_node, config.name, argp, argc, ce);
 		error = "RPC - " + error;
 		ERR_PRINT(error);
 	}
@@ -396,10 +423,17 @@ void RPCManager::_send_rpc(Node *p_from, int p_to, uint16_t p_rpc_id, const Mult
 		ofs += 1;
 		for (int i = 0; i < p_argcount; i++) {
 			int len(0);
-			Error err = multiplayer->encode_and_compress_variant(*p_arg[i], nullptr, len);
-			ERR_FAIL_COND_MSG(err != OK, "Unable to encode RPC argument. THIS IS LIKELY A BUG IN THE ENGINE!");
-			MAKE_ROOM(ofs + len);
-			multiplayer->encode_and_compress_variant(*p_arg[i], &(packet_cache.write[ofs]), len);
+			if (_is_fixed_size_arg(p_arg[i]->get_type())) {
+				// No need for a size pass.
+				MAKE_ROOM(ofs + FIXED_ARG_SIZE_MAX);
+				Error err = multiplayer->encode_and_compress_variant(*p_arg[i], &(packet_cache.write[ofs]), len);
+				ERR_FAIL_COND_MSG(err != OK, "Unable to encode RPC argument. THIS IS LIKELY A BUG IN THE ENGINE!");
+			} else {
+				Error err = multiplayer->encode_and_compress_variant(*p_arg[i], nullptr, len);
+				ERR_FAIL_COND_MSG(err != OK, "Unable to encode RPC argument. THIS IS LIKELY A BUG IN THE ENGINE!");
+				MAKE_ROOM(ofs + len);
+				multiplayer->encode_and_compress_variant(*p_arg[i], &(packet_cache.write[ofs]), len);
+			}
 			ofs += len;
 		}
 	}
@@ -419,21 +453,30 @@ void RPCManager::_send_rpc(Node *p_from, int p_to, uint16_t p_rpc_id, const Mult
 	peer->set_transfer_channel(p_config.channel);
 	peer->set_transfer_mode(p_config.transfer_mode);
 
-	if (has_all_peers) {
+	// Unreliable broadcasts on replicated nodes only go to the peers that can see them.
+	const Set<int> *visible_peers = nullptr;
+	if (p_to <= 0 && p_config.transfer_mode != Multiplayer::TRANSFER_MODE_RELIABLE) {
+		visible_peers = multiplayer->get_replicator()->get_visible_peers(p_from);
+	}
+
+	if (has_all_peers && !visible_peers) {
 		// They all have verified paths, so send fast.
 		peer->set_target_peer(p_to); // To all of you.
 		peer->put_packet(packet_cache.ptr(), ofs); // A message with love.
 	} else {
-		// Unreachable because the node ID is never compressed if the peers doesn't know it.
-		CRASH_COND(node_id_compression != NETWORK_NODE_ID_COMPRESSION_32);
-
-		// Not all verified path, so send one by one.
-
-		// Append path at the end, since we will need it for some packets.
-		CharString pname = String(from_path).utf8();
-		int path_len = encode_cstring(pname.get_data(), nullptr);
-		MAKE_ROOM(ofs + path_len);
-		encode_cstring(pname.get_data(), &(packet_cache.write[ofs]));
+		int path_len = 0;
+		if (!has_all_peers) {
+			// Unreachable because the node ID is never compressed if the peers doesn't know it.
+			CRASH_COND(node_id_compression != NETWORK_NODE_ID_COMPRESSION_32);
+
+			// Not all verified path, so send one by one.
+
+			// Append path at the end, since we will need it for some packets.
+			CharString pname = String(from_path).utf8();
+			path_len = encode_cstring(pname.get_data(), nullptr);
+			MAKE_ROOM(ofs + path_len);
+			encode_cstring(pname.get_data(), &(packet_cache.write[ofs]));
+		}
 
 		for (const int &P : multiplayer->get_connected_peers()) {
 			if (p_to < 0 && P == -p_to) {
@@ -444,11 +487,16 @@ void RPCManager::_send_rpc(Node *p_from, int p_to, uint16_t p_rpc_id, const Mult
 				continue; // Continue, not for this peer.
 			}
 
-			bool confirmed = multiplayer->is_cache_confirmed(from_path, P);
+			if (visible_peers && !visible_peers->has(P)) {
+				continue; // Continue, can't see the node.
+			}
 
 			peer->set_target_peer(P); // To this one specifically.
 
-			if (confirmed) {
+			if (has_all_peers) {
+				// Already compressed, send as is.
+				peer->put_packet(packet_cache.ptr(), ofs);
+			} else if (multiplayer->is_cache_confirmed(from_path, P)) {
 				// This one confirmed path, so use id.
 				encode_uint32(psc_id, &(packet_cache.write[1]));
 				peer->put_packet(packet_cache.ptr(), ofs);
@@ -67,6 +67,13 @@ private:
 		BYTE_ONLY_OR_NO_ARGS_FLAG = (1 << BYTE_ONLY_OR_NO_ARGS_SHIFT),
 	};
 
+	enum {
+		// Arguments of most RPCs are decoded on the stack, without allocating.
+		STACK_ARGS_MAX = 8,
+		// Upper bound of the encoded size of the fixed size types, which can be encoded in a single pass.
+		FIXED_ARG_SIZE_MAX = 40,
+	};
+
 	MultiplayerAPI *multiplayer = nullptr;
 	Vector<uint8_t> packet_cache;
 
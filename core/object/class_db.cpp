@@ -541,6 +541,20 @@ Object *ClassDB::instantiate(const StringName &p_class) {
 	return ti->creation_func();
 }
 
+Object *(*ClassDB::get_creation_func(const StringName &p_class))() {
+	OBJTYPE_RLOCK;
+	ClassInfo *ti = classes.getptr(p_class);
+	if (!ti || ti->disabled || ti->native_extension) {
+		return nullptr;
+	}
+#ifdef TOOLS_ENABLED
+	if (ti->api == API_EDITOR) {
+		return nullptr;
+	}
+#endif
+	return ti->creation_func;
+}
+
 Object *ClassDB::construct_object(Object *(*p_create_func)(), ObjectNativeExtension *p_extension) {
 	if (p_extension) {
 		initializing_with_extension = true;
@@ -709,18 +723,69 @@ bool ClassDB::get_method_info(const StringName &p_class, const StringName &p_met
 }
 
 MethodBind *ClassDB::get_method(const StringName &p_class, const StringName &p_name) {
-	OBJTYPE_RLOCK;
+	auto resolve = [](ClassInfo *p_type, const StringName &p_method) -> MethodBind * {
+		while (p_type) {
+			MethodBind **method = p_type->method_map.getptr(p_method);
+			if (method && *method) {
+				return *method;
+			}
+			p_type = p_type->inherits_ptr;
+		}
+		return nullptr;
+	};
 
-	ClassInfo *type = classes.getptr(p_class);
+	MethodBind *found = nullptr;
+	{
+		OBJTYPE_RLOCK;
+
+		ClassInfo *type = classes.getptr(p_class);
+		if (!type) {
+			return nullptr;
+		}
 
-	while (type) {
 		MethodBind **method = type->method_map.getptr(p_name);
+		if (!method) {
+			method = type->method_cache.getptr(p_name);
+		}
 		if (method && *method) {
 			return *method;
 		}
-		type = type->inherits_ptr;
+
+		found = resolve(type->inherits_ptr, p_name);
+		if (!found) {
+			return nullptr;
+		}
+	}
+
+	// Remember inherited methods, so calls on derived classes don't walk the
+	// hierarchy every time. Resolve again, something may have changed while unlocked.
+	OBJTYPE_WLOCK;
+	ClassInfo *type = classes.getptr(p_class);
+	if (type) {
+		found = resolve(type, p_name);
+		if (found) {
+			type->method_cache[p_name] = found;
+		}
+	}
+	return found;
+}
+
+void ClassDB::_clear_method_caches() {
+	const StringName *k = nullptr;
+	while ((k = classes.next(k))) {
+		classes[*k].method_cache.clear();
+	}
+}
+
+void ClassDB::_method_bound(ClassInfo *p_type, const StringName &p_name) {
+	// Binding a method that hides an inherited one may turn cached results stale
+	// in any derived class. This doesn't happen with engine classes, so keep it simple.
+	for (ClassInfo *t = p_type->inherits_ptr; t; t = t->inherits_ptr) {
+		if (t->method_map.has(p_name)) {
+			_clear_method_caches();
+			return;
+		}
 	}
-	return nullptr;
 }
 
 void ClassDB::bind_integer_constant(const StringName &p_class, const StringName &p_enum, const StringName &p_name, int p_constant) {
@@ -1177,45 +1242,61 @@ bool ClassDB::set_property(Object *p_object, const StringName &p_property, const
 	while (check) {
 		const PropertySetGet *psg = check->property_setget.getptr(p_property);
 		if (psg) {
-			if (!psg->setter) {
-				if (r_valid) {
-					*r_valid = false;
-				}
-				return true; //return true but do nothing
-			}
+			set_property_setget(p_object, psg, p_value, r_valid);
+			return true;
+		}
 
-			Callable::CallError ce;
+		check = check->inherits_ptr;
+	}
 
-			if (psg->index >= 0) {
-				Variant index = psg->index;
-				const Variant *arg[2] = { &index, &p_value };
-				//p_object->call(psg->setter,arg,2,ce);
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 2, ce);
-				} else {
-					p_object->call(psg->setter, arg, 2, ce);
-				}
+	return false;
+}
 
-			} else {
-				const Variant *arg[1] = { &p_value };
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 1, ce);
-				} else {
-					p_object->call(psg->setter, arg, 1, ce);
-				}
-			}
+const ClassDB::PropertySetGet *ClassDB::get_property_setget(const StringName &p_class, const StringName &p_property) {
+	OBJTYPE_RLOCK;
+	ClassInfo *check = classes.getptr(p_class);
+	while (check) {
+		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
+			return psg;
+		}
+		check = check->inherits_ptr;
+	}
+	return nullptr;
+}
 
-			if (r_valid) {
-				*r_valid = ce.error == Callable::CallError::CALL_OK;
-			}
+void ClassDB::set_property_setget(Object *p_object, const PropertySetGet *p_setget, const Variant &p_value, bool *r_valid) {
+	if (!p_setget->setter) {
+		if (r_valid) {
+			*r_valid = false;
+		}
+		return; //do nothing
+	}
 
-			return true;
+	Callable::CallError ce;
+
+	if (p_setget->index >= 0) {
+		Variant index = p_setget->index;
+		const Variant *arg[2] = { &index, &p_value };
+		//p_object->call(psg->setter,arg,2,ce);
+		if (p_setget->_setptr) {
+			p_setget->_setptr->call(p_object, arg, 2, ce);
+		} else {
+			p_object->call(p_setget->setter, arg, 2, ce);
 		}
 
-		check = check->inherits_ptr;
+	} else {
+		const Variant *arg[1] = { &p_value };
+		if (p_setget->_setptr) {
+			p_setget->_setptr->call(p_object, arg, 1, ce);
+		} else {
+			p_object->call(p_setget->setter, arg, 1, ce);
+		}
 	}
 
-	return false;
+	if (r_valid) {
+		*r_valid = ce.error == Callable::CallError::CALL_OK;
+	}
 }
 
 bool ClassDB::get_property(Object *p_object, const StringName &p_property, Variant &r_value) {
@@ -1401,6 +1482,7 @@ void ClassDB::bind_method_custom(const StringName &p_class, MethodBind *p_method
 #endif
 
 	type->method_map[p_method->get_name()] = p_method;
+	_method_bound(type, p_method->get_name());
 }
 
 MethodBind *ClassDB::bind_methodfi(uint32_t p_flags, MethodBind *p_bind, const MethodDefinition &method_name, const Variant **p_defs, int p_defcount) {
@@ -1442,6 +1524,7 @@ MethodBind *ClassDB::bind_methodfi(uint32_t p_flags, MethodBind *p_bind, const M
 #endif
 
 	type->method_map[mdname] = p_bind;
+	_method_bound(type, mdname);
 
 	Vector<Variant> defvals;
 
@@ -1674,6 +1757,7 @@ void ClassDB::register_extension_class(ObjectNativeExtension *p_extension) {
 void ClassDB::unregister_extension_class(const StringName &p_class) {
 	ERR_FAIL_COND(!classes.has(p_class));
 	classes.erase(p_class);
+	_clear_method_caches();
 }
 
 RWLock ClassDB::lock;
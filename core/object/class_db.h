@@ -98,6 +98,7 @@ public:
 		ObjectNativeExtension *native_extension = nullptr;
 
 		HashMap<StringName, MethodBind *> method_map;
+		HashMap<StringName, MethodBind *> method_cache; // Inherited methods resolved by get_method().
 		HashMap<StringName, int> constant_map;
 		HashMap<StringName, List<StringName>> enum_map;
 		HashMap<StringName, MethodInfo> signal_map;
@@ -139,6 +140,8 @@ public:
 	static APIType current_api;
 
 	static void _add_class2(const StringName &p_class, const StringName &p_inherits);
+	static void _clear_method_caches();
+	static void _method_bound(ClassInfo *p_type, const StringName &p_name);
 
 	static HashMap<StringName, HashMap<StringName, Variant>> default_values;
 	static Set<StringName> default_values_cached;
@@ -211,6 +214,8 @@ public:
 	static bool is_parent_class(const StringName &p_class, const StringName &p_inherits);
 	static bool can_instantiate(const StringName &p_class);
 	static Object *instantiate(const StringName &p_class);
+	// Constructor that can be called directly instead of instantiate(), or nullptr if the class needs the full checks (extension, editor only, disabled...).
+	static Object *(*get_creation_func(const StringName &p_class))();
 	static Object *construct_object(Object *(*p_create_func)(), ObjectNativeExtension *p_extension);
 	static void instance_get_native_extension_data(ObjectNativeExtension **r_extension, GDExtensionClassInstancePtr *r_extension_instance, Object *p_base);
 
@@ -339,6 +344,9 @@ public:
 	static void get_property_list(const StringName &p_class, List<PropertyInfo> *p_list, bool p_no_inheritance = false, const Object *p_validator = nullptr);
 	static bool get_property_info(const StringName &p_class, const StringName &p_property, PropertyInfo *r_info, bool p_no_inheritance = false, const Object *p_validator = nullptr);
 	static bool set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid = nullptr);
+	// Resolved setter for repeated set_property() calls on objects of exactly p_class, or nullptr.
+	static const PropertySetGet *get_property_setget(const StringName &p_class, const StringName &p_property);
+	static void set_property_setget(Object *p_object, const PropertySetGet *p_setget, const Variant &p_value, bool *r_valid = nullptr);
 	static bool get_property(Object *p_object, const StringName &p_property, Variant &r_value);
 	static bool has_property(const StringName &p_class, const StringName &p_property, bool p_no_inheritance = false);
 	static int get_property_index(const StringName &p_class, const StringName &p_property, bool *r_is_valid = nullptr);
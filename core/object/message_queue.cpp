@@ -32,14 +32,120 @@
 
 #include "core/config/project_settings.h"
 #include "core/core_string_names.h"
+#include "core/debugger/trace_zones.h"
 #include "core/object/script_language.h"
 
 MessageQueue *MessageQueue::singleton = nullptr;
+thread_local MessageQueue::ThreadQueue *MessageQueue::thread_queue = nullptr;
+thread_local uint32_t MessageQueue::thread_queue_generation = 0;
+uint32_t MessageQueue::generation = 0;
 
 MessageQueue *MessageQueue::get_singleton() {
 	return singleton;
 }
 
+MessageQueue::ThreadQueue *MessageQueue::_get_thread_queue() {
+	if (likely(thread_queue && thread_queue_generation == generation)) {
+		return thread_queue;
+	}
+
+	MutexLock lock(queues_mutex);
+
+	ThreadQueue *queue = nullptr;
+	for (uint32_t i = 0; i < queues.size(); i++) {
+		if (!queues[i]->in_use) {
+			queue = queues[i];
+			break;
+		}
+	}
+	if (!queue) {
+		queue = memnew(ThreadQueue);
+		queues.push_back(queue);
+	}
+	queue->in_use = true;
+
+	thread_queue = queue;
+	thread_queue_generation = generation;
+	return queue;
+}
+
+void MessageQueue::release_thread_queue() {
+	if (!thread_queue) {
+		return;
+	}
+	if (singleton && thread_queue_generation == generation) {
+		// Messages still pending in it are flushed as usual.
+		MutexLock lock(singleton->queues_mutex);
+		thread_queue->in_use = false;
+	}
+	thread_queue = nullptr;
+}
+
+// Must be called with the queue locked.
+MessageQueue::Message *MessageQueue::_alloc_message(ThreadQueue *p_queue, uint32_t p_size) {
+	Page *page = p_queue->last;
+	if (!page || page->used + p_size > page->size) {
+		if (p_queue->spare && p_size <= PAGE_SIZE) {
+			page = p_queue->spare;
+			p_queue->spare = page->next;
+			p_queue->spare_count--;
+			page->next = nullptr;
+		} else {
+			uint32_t size = MAX(uint32_t(PAGE_SIZE), p_size);
+			page = memnew_placement(memalloc(sizeof(Page) + size), Page);
+			page->size = size;
+		}
+
+		if (p_queue->last) {
+			p_queue->last->next = page;
+		} else {
+			p_queue->first = page;
+		}
+		p_queue->last = page;
+	}
+
+	Message *msg = memnew_placement(page->get_data() + page->used, Message);
+	page->used += p_size;
+	p_queue->used += p_size;
+	msg->order = next_order.postincrement();
+	return msg;
+}
+
+void MessageQueue::_free_page(ThreadQueue *p_queue, Page *p_page) {
+	if (p_page->size == PAGE_SIZE) {
+		p_queue->lock.lock();
+		if (p_queue->spare_count < MAX_SPARE_PAGES) {
+			p_page->used = 0;
+			p_page->next = p_queue->spare;
+			p_queue->spare = p_page;
+			p_queue->spare_count++;
+			p_page = nullptr;
+		}
+		p_queue->lock.unlock();
+	}
+	if (p_page) {
+		memfree(p_page);
+	}
+}
+
+uint32_t MessageQueue::_get_message_size(const Message *p_message) {
+	uint32_t size = sizeof(Message);
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		size += sizeof(Variant) * p_message->args;
+	}
+	return size;
+}
+
+void MessageQueue::_destroy_message(Message *p_message) {
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		Variant *args = (Variant *)(p_message + 1);
+		for (int i = 0; i < p_message->args; i++) {
+			args[i].~Variant();
+		}
+	}
+	p_message->~Message();
+}
+
 Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
 	return push_callable(Callable(p_id, p_method), p_args, p_argcount, p_show_error);
 }
@@ -60,56 +166,32 @@ Error MessageQueue::push_call(ObjectID p_id, const StringName &p_method, VARIANT
 }
 
 Error MessageQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	_THREAD_SAFE_METHOD_
-
-	uint8_t room_needed = sizeof(Message) + sizeof(Variant);
+	ThreadQueue *queue = _get_thread_queue();
+	queue->lock.lock();
 
-	if ((buffer_end + room_needed) >= buffer_size) {
-		String type;
-		if (ObjectDB::get_instance(p_id)) {
-			type = ObjectDB::get_instance(p_id)->get_class();
-		}
-		print_line("Failed set: " + type + ":" + p_prop + " target ID: " + itos(p_id));
-		statistics();
-		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
-	}
-
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	Message *msg = _alloc_message(queue, sizeof(Message) + sizeof(Variant));
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
 	msg->type = TYPE_SET;
 
-	buffer_end += sizeof(Message);
-
-	Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-	buffer_end += sizeof(Variant);
-	*v = p_value;
+	memnew_placement(msg + 1, Variant(p_value));
 
+	queue->lock.unlock();
 	return OK;
 }
 
 Error MessageQueue::push_notification(ObjectID p_id, int p_notification) {
-	_THREAD_SAFE_METHOD_
-
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
 
-	uint8_t room_needed = sizeof(Message);
-
-	if ((buffer_end + room_needed) >= buffer_size) {
-		print_line("Failed notification: " + itos(p_notification) + " target ID: " + itos(p_id));
-		statistics();
-		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
-	}
-
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	ThreadQueue *queue = _get_thread_queue();
+	queue->lock.lock();
 
+	Message *msg = _alloc_message(queue, sizeof(Message));
 	msg->type = TYPE_NOTIFICATION;
 	msg->callable = Callable(p_id, CoreStringNames::get_singleton()->notification); //name is meaningless but callable needs it
-	//msg->target;
 	msg->notification = p_notification;
 
-	buffer_end += sizeof(Message);
-
+	queue->lock.unlock();
 	return OK;
 }
 
@@ -126,17 +208,10 @@ Error MessageQueue::push_set(Object *p_object, const StringName &p_prop, const V
 }
 
 Error MessageQueue::push_callable(const Callable &p_callable, const Variant **p_args, int p_argcount, bool p_show_error) {
-	_THREAD_SAFE_METHOD_
-
-	int room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
+	ThreadQueue *queue = _get_thread_queue();
+	queue->lock.lock();
 
-	if ((buffer_end + room_needed) >= buffer_size) {
-		print_line("Failed method: " + p_callable);
-		statistics();
-		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
-	}
-
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	Message *msg = _alloc_message(queue, sizeof(Message) + sizeof(Variant) * p_argcount);
 	msg->args = p_argcount;
 	msg->callable = p_callable;
 	msg->type = TYPE_CALL;
@@ -144,14 +219,12 @@ Error MessageQueue::push_callable(const Callable &p_callable, const Variant **p_
 		msg->type |= FLAG_SHOW_ERROR;
 	}
 
-	buffer_end += sizeof(Message);
-
+	Variant *args = (Variant *)(msg + 1);
 	for (int i = 0; i < p_argcount; i++) {
-		Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-		buffer_end += sizeof(Variant);
-		*v = *p_args[i];
+		memnew_placement(&args[i], Variant(*p_args[i]));
 	}
 
+	queue->lock.unlock();
 	return OK;
 }
 
@@ -175,56 +248,66 @@ void MessageQueue::statistics() {
 	Map<int, int> notify_count;
 	Map<Callable, int> call_count;
 	int null_count = 0;
+	uint32_t total_bytes = 0;
 
-	uint32_t read_pos = 0;
-	while (read_pos < buffer_end) {
-		Message *message = (Message *)&buffer[read_pos];
+	MutexLock lock(queues_mutex);
 
-		Object *target = message->callable.get_object();
+	for (uint32_t i = 0; i < queues.size(); i++) {
+		ThreadQueue *queue = queues[i];
+		queue->lock.lock();
+		total_bytes += queue->used;
 
-		if (target != nullptr) {
-			switch (message->type & FLAG_MASK) {
-				case TYPE_CALL: {
-					if (!call_count.has(message->callable)) {
-						call_count[message->callable] = 0;
-					}
+		for (Page *page = queue->first; page; page = page->next) {
+			uint32_t read_pos = 0;
+			while (read_pos < page->used) {
+				Message *message = (Message *)(page->get_data() + read_pos);
 
-					call_count[message->callable]++;
+				Object *target = message->callable.get_object();
 
-				} break;
-				case TYPE_NOTIFICATION: {
-					if (!notify_count.has(message->notification)) {
-						notify_count[message->notification] = 0;
-					}
+				if (target != nullptr) {
+					switch (message->type & FLAG_MASK) {
+						case TYPE_CALL: {
+							if (!call_count.has(message->callable)) {
+								call_count[message->callable] = 0;
+							}
 
-					notify_count[message->notification]++;
+							call_count[message->callable]++;
 
-				} break;
-				case TYPE_SET: {
-					StringName t = message->callable.get_method();
-					if (!set_count.has(t)) {
-						set_count[t] = 0;
-					}
+						} break;
+						case TYPE_NOTIFICATION: {
+							if (!notify_count.has(message->notification)) {
+								notify_count[message->notification] = 0;
+							}
 
-					set_count[t]++;
+							notify_count[message->notification]++;
 
-				} break;
-			}
+						} break;
+						case TYPE_SET: {
+							StringName t = message->callable.get_method();
+							if (!set_count.has(t)) {
+								set_count[t] = 0;
+							}
 
-		} else {
-			//object was deleted
-			print_line("Object was deleted while awaiting a callback");
+							set_count[t]++;
 
-			null_count++;
-		}
+						} break;
+					}
+
+				} else {
+					//object was deleted
+					print_line("Object was deleted while awaiting a callback");
 
-		read_pos += sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			read_pos += sizeof(Variant) * message->args;
+					null_count++;
+				}
+
+				read_pos += _get_message_size(message);
+			}
 		}
+
+		queue->lock.unlock();
 	}
 
-	print_line("TOTAL BYTES: " + itos(buffer_end));
+	print_line("TOTAL BYTES: " + itos(total_bytes));
 	print_line("NULL count: " + itos(null_count));
 
 	for (const KeyValue<StringName, int> &E : set_count) {
@@ -262,77 +345,138 @@ void MessageQueue::_call_function(const Callable &p_callable, const Variant *p_a
 }
 
 void MessageQueue::flush() {
-	if (buffer_end > buffer_max_used) {
-		buffer_max_used = buffer_end;
-	}
-
-	uint32_t read_pos = 0;
-
-	//using reverse locking strategy
-	_THREAD_SAFE_LOCK_
-
-	if (flushing) {
-		_THREAD_SAFE_UNLOCK_
-		ERR_FAIL_COND(flushing); //already flushing, you did something odd
-	}
+	ERR_FAIL_COND(flushing); //already flushing, you did something odd
+	TRACE_ZONE("MessageQueue::flush");
 	flushing = true;
 
-	while (read_pos < buffer_end) {
-		//lock on each iteration, so a call can re-add itself to the message queue
+	// Messages pushed while flushing are taken in the next round, so a call can re-add itself.
+	flush_cursors.clear();
+	while (true) {
+		// Only messages stamped before this point run in this round. Their pushes are complete once the queue
+		// locks below are taken, since the order is stamped under that lock. Later ones may be taken from some
+		// queues but not from others, so they are kept for the next round to run in push order.
+		uint64_t round_end = next_order.get();
+		uint32_t used = 0;
+
+		queues_mutex.lock();
+		for (uint32_t i = 0; i < queues.size(); i++) {
+			ThreadQueue *queue = queues[i];
+			queue->lock.lock();
+			if (queue->first) {
+				FlushCursor *cursor = nullptr;
+				for (uint32_t j = 0; j < flush_cursors.size(); j++) {
+					if (flush_cursors[j].queue == queue) {
+						cursor = &flush_cursors[j];
+						break;
+					}
+				}
+				if (!cursor) {
+					flush_cursors.push_back(FlushCursor());
+					cursor = &flush_cursors[flush_cursors.size() - 1];
+					cursor->queue = queue;
+				}
+
+				// Pages left from the last round come first, they hold older messages.
+				if (cursor->page) {
+					cursor->last->next = queue->first;
+				} else {
+					cursor->page = queue->first;
+					cursor->offset = 0;
+				}
+				cursor->last = queue->last;
+
+				used += queue->used;
+				queue->first = nullptr;
+				queue->last = nullptr;
+				queue->used = 0;
+			}
+			queue->lock.unlock();
+		}
+		queues_mutex.unlock();
 
-		Message *message = (Message *)&buffer[read_pos];
+		bool pending = false;
+		for (uint32_t i = 0; i < flush_cursors.size(); i++) {
+			if (flush_cursors[i].page) {
+				pending = true;
+				break;
+			}
+		}
+		if (!pending) {
+			break;
+		}
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
+		if (used > buffer_max_used) {
+			buffer_max_used = used;
+			if (used > warning_size && !size_warned) {
+				size_warned = true;
+				WARN_PRINT("The message queue holds more than " + itos(warning_size / 1024) + " KiB of deferred calls, check for deferred calls that queue themselves up every frame.");
+			}
 		}
 
-		//pre-advance so this function is reentrant
-		read_pos += advance;
+		while (true) {
+			// Oldest message first, each thread queue is already in order.
+			FlushCursor *cursor = nullptr;
+			uint64_t cursor_order = round_end;
+			for (uint32_t i = 0; i < flush_cursors.size(); i++) {
+				FlushCursor &c = flush_cursors[i];
+				if (c.page) {
+					uint64_t order = ((Message *)(c.page->get_data() + c.offset))->order;
+					if (order < cursor_order) {
+						cursor = &c;
+						cursor_order = order;
+					}
+				}
+			}
+			if (!cursor) {
+				break;
+			}
 
-		_THREAD_SAFE_UNLOCK_
+			Message *message = (Message *)(cursor->page->get_data() + cursor->offset);
+			Page *page = cursor->page;
+			flushed_count++;
+			cursor->offset += _get_message_size(message);
+			if (cursor->offset >= page->used) {
+				cursor->page = page->next;
+				cursor->offset = 0;
+			} else {
+				page = nullptr; // Still being read.
+			}
 
-		Object *target = message->callable.get_object();
+			Object *target = message->callable.get_object();
 
-		if (target != nullptr) {
-			switch (message->type & FLAG_MASK) {
-				case TYPE_CALL: {
-					Variant *args = (Variant *)(message + 1);
+			if (target != nullptr) {
+				switch (message->type & FLAG_MASK) {
+					case TYPE_CALL: {
+						Variant *args = (Variant *)(message + 1);
 
-					// messages don't expect a return value
+						// messages don't expect a return value
 
-					_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
+						_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
 
-				} break;
-				case TYPE_NOTIFICATION: {
-					// messages don't expect a return value
-					target->notification(message->notification);
+					} break;
+					case TYPE_NOTIFICATION: {
+						// messages don't expect a return value
+						target->notification(message->notification);
 
-				} break;
-				case TYPE_SET: {
-					Variant *arg = (Variant *)(message + 1);
-					// messages don't expect a return value
-					target->set(message->callable.get_method(), *arg);
+					} break;
+					case TYPE_SET: {
+						Variant *arg = (Variant *)(message + 1);
+						// messages don't expect a return value
+						target->set(message->callable.get_method(), *arg);
 
-				} break;
+					} break;
+				}
 			}
-		}
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int i = 0; i < message->args; i++) {
-				args[i].~Variant();
+			_destroy_message(message);
+
+			if (page) {
+				_free_page(cursor->queue, page);
 			}
 		}
-
-		message->~Message();
-
-		_THREAD_SAFE_LOCK_
 	}
 
-	buffer_end = 0; // reset buffer
 	flushing = false;
-	_THREAD_SAFE_UNLOCK_
 }
 
 bool MessageQueue::is_flushing() const {
@@ -342,33 +486,39 @@ bool MessageQueue::is_flushing() const {
 MessageQueue::MessageQueue() {
 	ERR_FAIL_COND_MSG(singleton != nullptr, "A MessageQueue singleton already exists.");
 	singleton = this;
+	generation++;
 
-	buffer_size = GLOBAL_DEF_RST("memory/limits/message_queue/max_size_kb", DEFAULT_QUEUE_SIZE_KB);
+	warning_size = GLOBAL_DEF_RST("memory/limits/message_queue/max_size_kb", DEFAULT_QUEUE_SIZE_KB);
 	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/message_queue/max_size_kb", PropertyInfo(Variant::INT, "memory/limits/message_queue/max_size_kb", PROPERTY_HINT_RANGE, "1024,4096,1,or_greater"));
-	buffer_size *= 1024;
-	buffer = memnew_arr(uint8_t, buffer_size);
+	warning_size *= 1024;
 }
 
 MessageQueue::~MessageQueue() {
-	uint32_t read_pos = 0;
-
-	while (read_pos < buffer_end) {
-		Message *message = (Message *)&buffer[read_pos];
-		Variant *args = (Variant *)(message + 1);
-		int argc = message->args;
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			for (int i = 0; i < argc; i++) {
-				args[i].~Variant();
+	for (uint32_t i = 0; i < queues.size(); i++) {
+		ThreadQueue *queue = queues[i];
+
+		Page *page = queue->first;
+		while (page) {
+			uint32_t read_pos = 0;
+			while (read_pos < page->used) {
+				Message *message = (Message *)(page->get_data() + read_pos);
+				read_pos += _get_message_size(message);
+				_destroy_message(message);
 			}
+			Page *next = page->next;
+			memfree(page);
+			page = next;
 		}
-		message->~Message();
 
-		read_pos += sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			read_pos += sizeof(Variant) * message->args;
+		page = queue->spare;
+		while (page) {
+			Page *next = page->next;
+			memfree(page);
+			page = next;
 		}
+
+		memdelete(queue);
 	}
 
 	singleton = nullptr;
-	memdelete_arr(buffer);
 }
@@ -32,13 +32,21 @@
 #define MESSAGE_QUEUE_H
 
 #include "core/object/class_db.h"
+#include "core/os/mutex.h"
+#include "core/os/spin_lock.h"
 #include "core/os/thread_safe.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
+// Every thread pushes into its own queue, so deferred calls from several threads
+// don't contend with each other. Messages are stamped with a global push order,
+// which flush() merges the queues by, so calls run in the order they were pushed
+// across all threads.
 class MessageQueue {
-	_THREAD_SAFE_CLASS_
-
 	enum {
-		DEFAULT_QUEUE_SIZE_KB = 4096
+		DEFAULT_QUEUE_SIZE_KB = 4096,
+		PAGE_SIZE = 65536,
+		MAX_SPARE_PAGES = 4,
 	};
 
 	enum {
@@ -52,6 +60,7 @@ class MessageQueue {
 
 	struct Message {
 		Callable callable;
+		uint64_t order; // Push order across all the thread queues.
 		int16_t type;
 		union {
 			int16_t notification;
@@ -59,10 +68,50 @@ class MessageQueue {
 		};
 	};
 
-	uint8_t *buffer;
-	uint32_t buffer_end = 0;
+	struct Page {
+		Page *next = nullptr;
+		uint32_t size = 0;
+		uint32_t used = 0;
+
+		_FORCE_INLINE_ uint8_t *get_data() { return reinterpret_cast<uint8_t *>(this + 1); }
+	};
+
+	struct ThreadQueue {
+		SpinLock lock; // Only contended while flushing.
+		Page *first = nullptr;
+		Page *last = nullptr;
+		Page *spare = nullptr;
+		uint32_t spare_count = 0;
+		uint32_t used = 0;
+		bool in_use = false; // Owned by a running thread, free ones are handed to new threads.
+	};
+
+	struct FlushCursor {
+		ThreadQueue *queue = nullptr;
+		Page *page = nullptr; // Next message to run, null once the taken pages are all read.
+		Page *last = nullptr;
+		uint32_t offset = 0;
+	};
+
+	static thread_local ThreadQueue *thread_queue;
+	static thread_local uint32_t thread_queue_generation;
+	static uint32_t generation;
+
+	BinaryMutex queues_mutex;
+	LocalVector<ThreadQueue *> queues;
+	SafeNumeric<uint64_t> next_order;
+	LocalVector<FlushCursor> flush_cursors;
+
 	uint32_t buffer_max_used = 0;
-	uint32_t buffer_size;
+	uint32_t warning_size = 0;
+	uint64_t flushed_count = 0;
+	bool size_warned = false;
+
+	ThreadQueue *_get_thread_queue();
+	Message *_alloc_message(ThreadQueue *p_queue, uint32_t p_size);
+	void _free_page(ThreadQueue *p_queue, Page *p_page);
+	static uint32_t _get_message_size(const Message *p_message);
+	static void _destroy_message(Message *p_message);
 
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
@@ -89,7 +138,12 @@ public:
 
 	bool is_flushing() const;
 
+	// Called by threads when they end, their queue is then reused by the next thread.
+	static void release_thread_queue();
+
 	int get_max_buffer_usage() const;
+	// Messages flushed since the queue was created.
+	uint64_t get_flushed_count() const { return flushed_count; }
 
 	MessageQueue();
 	~MessageQueue();
@@ -35,6 +35,7 @@
 #include "core/object/class_db.h"
 #include "core/object/message_queue.h"
 #include "core/object/script_language.h"
+#include "core/os/frame_allocator.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
 #include "core/string/translation.h"
@@ -837,6 +838,14 @@ Variant Object::call(const StringName &p_method, const Variant **p_args, int p_a
 	return ret;
 }
 
+Variant Object::call_method_bind(MethodBind *p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
+	r_error.error = Callable::CallError::CALL_OK;
+
+	OBJ_DEBUG_LOCK
+
+	return p_method->call(this, p_args, p_argcount, r_error);
+}
+
 void Object::notification(int p_notification, bool p_reversed) {
 	_notificationv(p_notification, p_reversed);
 
@@ -1059,11 +1068,10 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
 
 	OBJ_DEBUG_LOCK
 
-	Vector<const Variant *> bind_mem;
-
 	Error err = OK;
 
 	for (int i = 0; i < ssize; i++) {
+		FrameAllocator::Scope bind_scope;
 		const Connection &c = slot_map.getv(i).conn;
 
 		Object *target = c.callable.get_object();
@@ -1077,17 +1085,17 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
 
 		if (c.binds.size()) {
 			//handle binds
-			bind_mem.resize(p_argcount + c.binds.size());
+			argc = p_argcount + c.binds.size();
+			const Variant **bind_mem = FrameAllocator::alloc_array<const Variant *>(argc);
 
 			for (int j = 0; j < p_argcount; j++) {
-				bind_mem.write[j] = p_args[j];
+				bind_mem[j] = p_args[j];
 			}
 			for (int j = 0; j < c.binds.size(); j++) {
-				bind_mem.write[p_argcount + j] = &c.binds[j];
+				bind_mem[p_argcount + j] = &c.binds[j];
 			}
 
-			args = (const Variant **)bind_mem.ptr();
-			argc = bind_mem.size();
+			args = bind_mem;
 		}
 
 		if (c.flags & CONNECT_DEFERRED) {
@@ -1139,21 +1147,6 @@ Error Object::emit_signal(const StringName &p_name, const Variant **p_args, int
 	return err;
 }
 
-Error Object::emit_signal(const StringName &p_name, VARIANT_ARG_DECLARE) {
-	VARIANT_ARGPTRS;
-
-	int argc = 0;
-
-	for (int i = 0; i < VARIANT_ARG_MAX; i++) {
-		if (argptr[i]->get_type() == Variant::NIL) {
-			break;
-		}
-		argc++;
-	}
-
-	return emit_signal(p_name, argptr, argc);
-}
-
 void Object::_add_user_signal(const String &p_name, const Array &p_args) {
 	// this version of add_user_signal is meant to be used from scripts or external apis
 	// without access to ADD_SIGNAL in bind_methods
@@ -1912,9 +1905,10 @@ void postinitialize_handler(Object *p_object) {
 void ObjectDB::debug_objects(DebugFunc p_func) {
 	spin_lock.lock();
 
-	for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-		if (object_slots[i].validator) {
-			p_func(object_slots[i].object);
+	for (uint32_t i = 0, count = slot_count, max = slot_max; i < max && count != 0; i++) {
+		ObjectSlot &object_slot = _get_slot(i);
+		if (object_slot.validator.load(std::memory_order_relaxed)) {
+			p_func(object_slot.object.load(std::memory_order_relaxed));
 			count--;
 		}
 	}
@@ -1925,45 +1919,87 @@ void Object::get_argument_options(const StringName &p_function, int p_idx, List<
 }
 
 SpinLock ObjectDB::spin_lock;
-uint32_t ObjectDB::slot_count = 0;
-uint32_t ObjectDB::slot_max = 0;
-ObjectDB::ObjectSlot *ObjectDB::object_slots = nullptr;
-uint64_t ObjectDB::validator_counter = 0;
+std::atomic<uint32_t> ObjectDB::slot_count(0);
+std::atomic<uint32_t> ObjectDB::slot_max(0);
+ObjectDB::ObjectSlot *ObjectDB::slot_pages[SLOT_PAGE_MAX] = {};
+LocalVector<uint32_t> ObjectDB::free_slots;
+std::atomic<uint64_t> ObjectDB::validator_counter(0);
+thread_local ObjectDB::SlotCache ObjectDB::slot_cache;
 
 int ObjectDB::get_object_count() {
-	return slot_count;
+	return slot_count.load(std::memory_order_relaxed);
 }
 
-ObjectID ObjectDB::add_instance(Object *p_object) {
+void ObjectDB::_refill_slot_cache() {
+	const uint32_t wanted = SLOT_CACHE_MAX / 2;
+
 	spin_lock.lock();
-	if (unlikely(slot_count == slot_max)) {
-		CRASH_COND(slot_count == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
 
-		uint32_t new_slot_max = slot_max > 0 ? slot_max * 2 : 1;
-		object_slots = (ObjectSlot *)memrealloc(object_slots, sizeof(ObjectSlot) * new_slot_max);
-		for (uint32_t i = slot_max; i < new_slot_max; i++) {
-			object_slots[i].object = nullptr;
-			object_slots[i].is_ref_counted = false;
-			object_slots[i].next_free = i;
-			object_slots[i].validator = 0;
+	while (slot_cache.count < wanted && free_slots.size()) {
+		slot_cache.slots[slot_cache.count++] = free_slots[free_slots.size() - 1];
+		free_slots.resize(free_slots.size() - 1);
+	}
+
+	uint32_t max = slot_max.load(std::memory_order_relaxed);
+	while (slot_cache.count < wanted) {
+		if (unlikely((max & SLOT_PAGE_MASK) == 0)) {
+			if (unlikely(max == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS))) {
+				if (slot_cache.count) {
+					break; // Use up what is left first.
+				}
+				spin_lock.unlock();
+				CRASH_NOW_MSG("Out of ObjectDB slots.");
+			}
+
+			ObjectSlot *page = (ObjectSlot *)memalloc(sizeof(ObjectSlot) * SLOT_PAGE_SIZE);
+			for (uint32_t i = 0; i < SLOT_PAGE_SIZE; i++) {
+				memnew_placement(&page[i].validator, std::atomic<uint64_t>(0));
+				memnew_placement(&page[i].object, std::atomic<Object *>(nullptr));
+			}
+			slot_pages[max >> SLOT_PAGE_BITS] = page;
 		}
-		slot_max = new_slot_max;
+		slot_cache.slots[slot_cache.count++] = max++;
 	}
 
-	uint32_t slot = object_slots[slot_count].next_free;
-	if (object_slots[slot].object != nullptr) {
-		spin_lock.unlock();
-		ERR_FAIL_COND_V(object_slots[slot].object != nullptr, ObjectID());
+	// Publishes the new pages to get_instance().
+	slot_max.store(max, std::memory_order_release);
+
+	spin_lock.unlock();
+}
+
+void ObjectDB::_return_slots(uint32_t p_count) {
+	spin_lock.lock();
+	for (uint32_t i = 0; i < p_count; i++) {
+		free_slots.push_back(slot_cache.slots[--slot_cache.count]);
 	}
-	object_slots[slot].object = p_object;
-	object_slots[slot].is_ref_counted = p_object->is_ref_counted();
-	validator_counter = (validator_counter + 1) & OBJECTDB_VALIDATOR_MASK;
-	if (unlikely(validator_counter == 0)) {
-		validator_counter = 1;
+	spin_lock.unlock();
+}
+
+void ObjectDB::release_thread_slots() {
+	if (slot_cache.count) {
+		_return_slots(slot_cache.count);
+	}
+}
+
+ObjectID ObjectDB::add_instance(Object *p_object) {
+	if (unlikely(slot_cache.count == 0)) {
+		_refill_slot_cache();
 	}
-	object_slots[slot].validator = validator_counter;
+	uint32_t slot = slot_cache.slots[--slot_cache.count];
+
+	ObjectSlot &object_slot = _get_slot(slot);
+	ERR_FAIL_COND_V(object_slot.object.load(std::memory_order_relaxed) != nullptr, ObjectID());
+
+	uint64_t validator;
+	do {
+		validator = (validator_counter.fetch_add(1, std::memory_order_relaxed) + 1) & OBJECTDB_VALIDATOR_MASK;
+	} while (unlikely(validator == 0));
+
+	// Both stores are release, see get_instance() for why the object one needs it too.
+	object_slot.object.store(p_object, std::memory_order_release);
+	object_slot.validator.store(validator, std::memory_order_release);
 
-	uint64_t id = validator_counter;
+	uint64_t id = validator;
 	id <<= OBJECTDB_SLOT_MAX_COUNT_BITS;
 	id |= uint64_t(slot);
 
@@ -1971,9 +2007,7 @@ ObjectID ObjectDB::add_instance(Object *p_object) {
 		id |= OBJECTDB_REFERENCE_BIT;
 	}
 
-	slot_count++;
-
-	spin_lock.unlock();
+	slot_count.fetch_add(1, std::memory_order_relaxed);
 
 	return ObjectID(id);
 }
@@ -1982,33 +2016,27 @@ void ObjectDB::remove_instance(Object *p_object) {
 	uint64_t t = p_object->get_instance_id();
 	uint32_t slot = t & OBJECTDB_SLOT_MAX_COUNT_MASK; //slot is always valid on valid object
 
-	spin_lock.lock();
+	ObjectSlot &object_slot = _get_slot(slot);
 
 #ifdef DEBUG_ENABLED
 
-	if (object_slots[slot].object != p_object) {
-		spin_lock.unlock();
-		ERR_FAIL_COND(object_slots[slot].object != p_object);
-	}
+	ERR_FAIL_COND(object_slot.object.load(std::memory_order_relaxed) != p_object);
 	{
 		uint64_t validator = (t >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
-		if (object_slots[slot].validator != validator) {
-			spin_lock.unlock();
-			ERR_FAIL_COND(object_slots[slot].validator != validator);
-		}
+		ERR_FAIL_COND(object_slot.validator.load(std::memory_order_relaxed) != validator);
 	}
 
 #endif
-	//decrease slot count
-	slot_count--;
-	//set the free slot properly
-	object_slots[slot_count].next_free = slot;
 	//invalidate, so checks against it fail
-	object_slots[slot].validator = 0;
-	object_slots[slot].is_ref_counted = false;
-	object_slots[slot].object = nullptr;
+	object_slot.object.store(nullptr, std::memory_order_release);
+	object_slot.validator.store(0, std::memory_order_release);
 
-	spin_lock.unlock();
+	slot_count.fetch_sub(1, std::memory_order_relaxed);
+
+	if (unlikely(slot_cache.count == SLOT_CACHE_MAX)) {
+		_return_slots(SLOT_CACHE_MAX / 2);
+	}
+	slot_cache.slots[slot_cache.count++] = slot;
 }
 
 void ObjectDB::setup() {
@@ -2028,9 +2056,11 @@ void ObjectDB::cleanup() {
 			MethodBind *resource_get_path = ClassDB::get_method("Resource", "get_path");
 			Callable::CallError call_error;
 
-			for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-				if (object_slots[i].validator) {
-					Object *obj = object_slots[i].object;
+			for (uint32_t i = 0, count = slot_count, max = slot_max; i < max && count != 0; i++) {
+				ObjectSlot &object_slot = _get_slot(i);
+				uint64_t validator = object_slot.validator.load(std::memory_order_relaxed);
+				if (validator) {
+					Object *obj = object_slot.object.load(std::memory_order_relaxed);
 
 					String extra_info;
 					if (obj->is_class("Node")) {
@@ -2040,7 +2070,7 @@ void ObjectDB::cleanup() {
 						extra_info = " - Resource path: " + String(resource_get_path->call(obj, nullptr, 0, call_error));
 					}
 
-					uint64_t id = uint64_t(i) | (uint64_t(object_slots[i].validator) << OBJECTDB_VALIDATOR_BITS) | (object_slots[i].is_ref_counted ? OBJECTDB_REFERENCE_BIT : 0);
+					uint64_t id = uint64_t(i) | (validator << OBJECTDB_VALIDATOR_BITS) | (obj->is_ref_counted() ? OBJECTDB_REFERENCE_BIT : 0);
 					print_line("Leaked instance: " + String(obj->get_class()) + ":" + itos(id) + extra_info);
 
 					count--;
@@ -2051,7 +2081,11 @@ void ObjectDB::cleanup() {
 		spin_lock.unlock();
 	}
 
-	if (object_slots) {
-		memfree(object_slots);
+	for (uint32_t i = 0; i < SLOT_PAGE_MAX && slot_pages[i]; i++) {
+		memfree(slot_pages[i]);
+		slot_pages[i] = nullptr;
 	}
+	slot_max = 0;
+	free_slots.reset();
+	slot_cache.count = 0;
 }
@@ -37,6 +37,7 @@
 #include "core/os/spin_lock.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/map.h"
 #include "core/templates/safe_refcount.h"
 #include "core/templates/set.h"
@@ -748,6 +749,8 @@ public:
 	Variant callv(const StringName &p_method, const Array &p_args);
 	virtual Variant call(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	Variant call(const StringName &p_name, VARIANT_ARG_LIST); // C++ helper
+	// Same as call(), for a bind already resolved for this object's class. The script instance is not tried.
+	Variant call_method_bind(MethodBind *p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 
 	void notification(int p_notification, bool p_reversed = false);
 	virtual String to_string();
@@ -781,8 +784,18 @@ public:
 	void set_script_and_instance(const Variant &p_script, ScriptInstance *p_instance); //some script languages can't control instance creation, so this function eases the process
 
 	void add_user_signal(const MethodInfo &p_signal);
-	Error emit_signal(const StringName &p_name, VARIANT_ARG_LIST);
 	Error emit_signal(const StringName &p_name, const Variant **p_args, int p_argcount);
+	// Boxes exactly the arguments given, on the stack. Unlike VARIANT_ARG_LIST
+	// there are no defaults to construct, and null arguments are passed as is.
+	template <class... VarArgs>
+	_FORCE_INLINE_ Error emit_signal(const StringName &p_name, VarArgs... p_args) {
+		Variant args[sizeof...(p_args) + 1] = { p_args..., Variant() }; // +1 keeps the array valid without arguments.
+		const Variant *argptrs[sizeof...(p_args) + 1];
+		for (uint32_t i = 0; i < sizeof...(p_args); i++) {
+			argptrs[i] = &args[i];
+		}
+		return emit_signal(p_name, sizeof...(p_args) == 0 ? nullptr : (const Variant **)argptrs, (int)sizeof...(p_args));
+	}
 	bool has_signal(const StringName &p_name) const;
 	void get_signal_list(List<MethodInfo> *p_signals) const;
 	void get_signal_connection_list(const StringName &p_signal, List<Connection> *p_connections) const;
@@ -849,18 +862,38 @@ class ObjectDB {
 #define OBJECTDB_SLOT_MAX_COUNT_MASK ((uint64_t(1) << OBJECTDB_SLOT_MAX_COUNT_BITS) - 1)
 #define OBJECTDB_REFERENCE_BIT (uint64_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS + OBJECTDB_VALIDATOR_BITS))
 
+	// Slots live in fixed pages that never move, so lookups can read them without locking.
+	// A slot's validator is zero while free, it's cleared before the object pointer when
+	// freeing and set after it when allocating.
 	struct ObjectSlot { //128 bits per slot
-		uint64_t validator : OBJECTDB_VALIDATOR_BITS;
-		uint64_t next_free : OBJECTDB_SLOT_MAX_COUNT_BITS;
-		uint64_t is_ref_counted : 1;
-		Object *object;
+		std::atomic<uint64_t> validator;
+		std::atomic<Object *> object;
+	};
+
+	enum {
+		SLOT_PAGE_BITS = 12,
+		SLOT_PAGE_SIZE = 1 << SLOT_PAGE_BITS,
+		SLOT_PAGE_MASK = SLOT_PAGE_SIZE - 1,
+		SLOT_PAGE_MAX = (1 << OBJECTDB_SLOT_MAX_COUNT_BITS) / SLOT_PAGE_SIZE,
+		SLOT_CACHE_MAX = 64, // Free slots kept by each thread, taken from and returned to the shared list in halves.
+	};
+
+	struct SlotCache {
+		uint32_t slots[SLOT_CACHE_MAX];
+		uint32_t count = 0;
 	};
 
-	static SpinLock spin_lock;
-	static uint32_t slot_count;
-	static uint32_t slot_max;
-	static ObjectSlot *object_slots;
-	static uint64_t validator_counter;
+	static SpinLock spin_lock; // Protects the shared free list and the page allocation.
+	static std::atomic<uint32_t> slot_count;
+	static std::atomic<uint32_t> slot_max;
+	static ObjectSlot *slot_pages[SLOT_PAGE_MAX];
+	static LocalVector<uint32_t> free_slots;
+	static std::atomic<uint64_t> validator_counter;
+	static thread_local SlotCache slot_cache;
+
+	static void _refill_slot_cache();
+	static void _return_slots(uint32_t p_count);
+	_ALWAYS_INLINE_ static ObjectSlot &_get_slot(uint32_t p_slot) { return slot_pages[p_slot >> SLOT_PAGE_BITS][p_slot & SLOT_PAGE_MASK]; }
 
 	friend class Object;
 	friend void unregister_core_types();
@@ -879,23 +912,34 @@ public:
 		uint64_t id = p_instance_id;
 		uint32_t slot = id & OBJECTDB_SLOT_MAX_COUNT_MASK;
 
-		ERR_FAIL_COND_V(slot >= slot_max, nullptr); //this should never happen unless RID is corrupted
-
-		spin_lock.lock();
+		ERR_FAIL_COND_V(slot >= slot_max.load(std::memory_order_acquire), nullptr); //this should never happen unless RID is corrupted
 
 		uint64_t validator = (id >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
+		if (unlikely(validator == 0)) {
+			return nullptr;
+		}
 
-		if (unlikely(object_slots[slot].validator != validator)) {
-			spin_lock.unlock();
+		ObjectSlot &object_slot = _get_slot(slot);
+		if (unlikely(object_slot.validator.load(std::memory_order_acquire) != validator)) {
 			return nullptr;
 		}
 
-		Object *object = object_slots[slot].object;
+		Object *object = object_slot.object.load(std::memory_order_acquire);
 
-		spin_lock.unlock();
+		// The slot may have been freed and reused meanwhile, validators are never repeated so checking again is enough.
+		// Slots are always written object first, then validator, both with release stores. So if the acquire load
+		// above read a pointer stored by a later add_instance(), it also synchronized with the validator being
+		// cleared by the remove_instance() before it, and this load can't see the old validator anymore.
+		if (unlikely(object_slot.validator.load(std::memory_order_relaxed) != validator)) {
+			return nullptr;
+		}
 
 		return object;
 	}
+
+	// Called by threads when they end, so the free slots they hold go back to the shared list.
+	static void release_thread_slots();
+
 	static void debug_objects(DebugFunc p_func);
 	static int get_object_count();
 };
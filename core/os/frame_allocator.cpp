@@ -0,0 +1,99 @@
+/*************************************************************************/
+/*  frame_allocator.cpp                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "frame_allocator.h"
+
+thread_local FrameAllocator::Chunk *FrameAllocator::current = nullptr;
+thread_local uint32_t FrameAllocator::scope_depth = 0;
+
+void *FrameAllocator::_alloc_from_next_chunk(size_t p_bytes) {
+	CRASH_COND_MSG(scope_depth == 0, "FrameAllocator used outside of a FrameAllocator::Scope.");
+
+	// Chunks after the current one are spare, no open scope points to them.
+	Chunk *next = current ? current->next : nullptr;
+	if (!next || next->size < p_bytes) {
+		// Too small for this request, drop them.
+		while (next) {
+			Chunk *after = next->next;
+			memfree(next);
+			next = after;
+		}
+
+		size_t size = MAX(size_t(CHUNK_SIZE), p_bytes);
+		next = (Chunk *)memalloc(HEADER_SIZE + size);
+		memnew_placement(next, Chunk);
+		next->size = size;
+		next->prev = current;
+		if (current) {
+			current->next = next;
+		}
+	}
+
+	next->used = p_bytes;
+	current = next;
+	return next->get_data();
+}
+
+void FrameAllocator::trim() {
+	if (!current) {
+		return;
+	}
+
+	if (scope_depth == 0) {
+		while (current->prev) {
+			current = current->prev;
+		}
+		current->used = 0;
+	}
+
+	Chunk *spare = current->next;
+	current->next = nullptr;
+	while (spare) {
+		Chunk *after = spare->next;
+		memfree(spare);
+		spare = after;
+	}
+}
+
+void FrameAllocator::release_thread_memory() {
+	ERR_FAIL_COND_MSG(scope_depth != 0, "Can't release the FrameAllocator memory of a thread while a scope is open.");
+	if (!current) {
+		return;
+	}
+
+	while (current->prev) {
+		current = current->prev;
+	}
+	while (current) {
+		Chunk *after = current->next;
+		memfree(current);
+		current = after;
+	}
+}
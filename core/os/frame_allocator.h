@@ -0,0 +1,118 @@
+/*************************************************************************/
+/*  frame_allocator.h                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef FRAME_ALLOCATOR_H
+#define FRAME_ALLOCATOR_H
+
+#include "core/os/memory.h"
+
+#include <type_traits>
+
+// Thread-local bump allocator for short lived temporaries, like copies made
+// to iterate something that may change meanwhile.
+//
+// Memory is only handed back in LIFO order, by FrameAllocator::Scope going out
+// of scope, so nothing allocated here may outlive the scope it was obtained in.
+// Chunks stay around for reuse, and are trimmed once per frame by Main::iteration(),
+// so steady state usage doesn't touch the heap at all.
+
+class FrameAllocator {
+	enum {
+		CHUNK_SIZE = 64 * 1024,
+		ALIGN = 16,
+	};
+
+	struct Chunk {
+		Chunk *prev = nullptr;
+		Chunk *next = nullptr;
+		size_t size = 0;
+		size_t used = 0;
+
+		uint8_t *get_data() { return (uint8_t *)this + HEADER_SIZE; }
+	};
+
+	static constexpr size_t HEADER_SIZE = (sizeof(Chunk) + ALIGN - 1) & ~size_t(ALIGN - 1);
+
+	static thread_local Chunk *current;
+	static thread_local uint32_t scope_depth;
+
+	static void *_alloc_from_next_chunk(size_t p_bytes);
+
+public:
+	class Scope {
+		Chunk *chunk;
+		size_t used;
+
+	public:
+		_FORCE_INLINE_ Scope() {
+			chunk = current;
+			used = chunk ? chunk->used : 0;
+			scope_depth++;
+		}
+		_FORCE_INLINE_ ~Scope() {
+			if (chunk) {
+				chunk->used = used;
+				current = chunk;
+			} else if (current) {
+				// The thread had no memory when the scope started, rewind to the first chunk.
+				while (current->prev) {
+					current = current->prev;
+				}
+				current->used = 0;
+			}
+			scope_depth--;
+		}
+	};
+
+	// Only valid inside a Scope.
+	_FORCE_INLINE_ static void *alloc(size_t p_bytes) {
+		size_t bytes = (p_bytes + ALIGN - 1) & ~size_t(ALIGN - 1);
+		Chunk *chunk = current;
+		if (likely(chunk && chunk->size - chunk->used >= bytes)) {
+			uint8_t *mem = chunk->get_data() + chunk->used;
+			chunk->used += bytes;
+			return mem;
+		}
+		return _alloc_from_next_chunk(bytes);
+	}
+
+	template <class T>
+	_FORCE_INLINE_ static T *alloc_array(size_t p_count) {
+		static_assert(std::is_trivially_destructible<T>::value, "FrameAllocator never runs destructors.");
+		return (T *)alloc(sizeof(T) * p_count);
+	}
+
+	// Frees the chunks the calling thread isn't using, except the first one.
+	static void trim();
+	// Frees every chunk of the calling thread, use when it's about to exit.
+	static void release_thread_memory();
+};
+
+#endif // FRAME_ALLOCATOR_H
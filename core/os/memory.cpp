@@ -36,6 +36,19 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#ifdef MIMALLOC_ENABLED
+#include <mimalloc.h>
+
+// Thread caching allocator, avoids contending on the libc heap locks when many threads allocate.
+#define MEMORY_BACKEND_MALLOC mi_malloc
+#define MEMORY_BACKEND_REALLOC mi_realloc
+#define MEMORY_BACKEND_FREE mi_free
+#else
+#define MEMORY_BACKEND_MALLOC malloc
+#define MEMORY_BACKEND_REALLOC realloc
+#define MEMORY_BACKEND_FREE free
+#endif
+
 void *operator new(size_t p_size, const char *p_description) {
 	return Memory::alloc_static(p_size, false);
 }
@@ -61,10 +74,17 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 #ifdef DEBUG_ENABLED
 SafeNumeric<uint64_t> Memory::mem_usage;
 SafeNumeric<uint64_t> Memory::max_usage;
-#endif
-
 SafeNumeric<uint64_t> Memory::alloc_count;
 
+SafeNumeric<uint64_t> Memory::tag_usage[TAG_MAX];
+SafeNumeric<uint64_t> Memory::tag_max_usage[TAG_MAX];
+thread_local uint8_t Memory::current_tag = TAG_CORE;
+
+// The size stored before each allocation keeps its tag in the highest byte.
+#define MEMORY_TAG_SHIFT 56
+#define MEMORY_SIZE_MASK ((uint64_t(1) << MEMORY_TAG_SHIFT) - 1)
+#endif
+
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 #ifdef DEBUG_ENABLED
 	bool prepad = true;
@@ -72,11 +92,13 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 	bool prepad = p_pad_align;
 #endif
 
-	void *mem = malloc(p_bytes + (prepad ? PAD_ALIGN : 0));
+	void *mem = MEMORY_BACKEND_MALLOC(p_bytes + (prepad ? PAD_ALIGN : 0));
 
 	ERR_FAIL_COND_V(!mem, nullptr);
 
+#ifdef DEBUG_ENABLED
 	alloc_count.increment();
+#endif
 
 	if (prepad) {
 		uint64_t *s = (uint64_t *)mem;
@@ -85,8 +107,13 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 		uint8_t *s8 = (uint8_t *)mem;
 
 #ifdef DEBUG_ENABLED
+		uint8_t tag = current_tag;
+		*s |= uint64_t(tag) << MEMORY_TAG_SHIFT;
+
 		uint64_t new_mem_usage = mem_usage.add(p_bytes);
 		max_usage.exchange_if_greater(new_mem_usage);
+		uint64_t new_tag_usage = tag_usage[tag].add(p_bytes);
+		tag_max_usage[tag].exchange_if_greater(new_tag_usage);
 #endif
 		return s8 + PAD_ALIGN;
 	} else {
@@ -112,31 +139,37 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 		uint64_t *s = (uint64_t *)mem;
 
 #ifdef DEBUG_ENABLED
-		if (p_bytes > *s) {
-			uint64_t new_mem_usage = mem_usage.add(p_bytes - *s);
+		uint64_t old_bytes = *s & MEMORY_SIZE_MASK;
+		uint8_t tag = *s >> MEMORY_TAG_SHIFT;
+		if (p_bytes > old_bytes) {
+			uint64_t new_mem_usage = mem_usage.add(p_bytes - old_bytes);
 			max_usage.exchange_if_greater(new_mem_usage);
+			uint64_t new_tag_usage = tag_usage[tag].add(p_bytes - old_bytes);
+			tag_max_usage[tag].exchange_if_greater(new_tag_usage);
 		} else {
-			mem_usage.sub(*s - p_bytes);
+			mem_usage.sub(old_bytes - p_bytes);
+			tag_usage[tag].sub(old_bytes - p_bytes);
 		}
 #endif
 
 		if (p_bytes == 0) {
-			free(mem);
+			MEMORY_BACKEND_FREE(mem);
 			return nullptr;
 		} else {
-			*s = p_bytes;
-
-			mem = (uint8_t *)realloc(mem, p_bytes + PAD_ALIGN);
+			mem = (uint8_t *)MEMORY_BACKEND_REALLOC(mem, p_bytes + PAD_ALIGN);
 			ERR_FAIL_COND_V(!mem, nullptr);
 
 			s = (uint64_t *)mem;
 
 			*s = p_bytes;
+#ifdef DEBUG_ENABLED
+			*s |= uint64_t(tag) << MEMORY_TAG_SHIFT;
+#endif
 
 			return mem + PAD_ALIGN;
 		}
 	} else {
-		mem = (uint8_t *)realloc(mem, p_bytes);
+		mem = (uint8_t *)MEMORY_BACKEND_REALLOC(mem, p_bytes);
 
 		ERR_FAIL_COND_V(mem == nullptr && p_bytes > 0, nullptr);
 
@@ -155,19 +188,22 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 	bool prepad = p_pad_align;
 #endif
 
+#ifdef DEBUG_ENABLED
 	alloc_count.decrement();
+#endif
 
 	if (prepad) {
 		mem -= PAD_ALIGN;
 
 #ifdef DEBUG_ENABLED
 		uint64_t *s = (uint64_t *)mem;
-		mem_usage.sub(*s);
+		mem_usage.sub(*s & MEMORY_SIZE_MASK);
+		tag_usage[*s >> MEMORY_TAG_SHIFT].sub(*s & MEMORY_SIZE_MASK);
 #endif
 
-		free(mem);
+		MEMORY_BACKEND_FREE(mem);
 	} else {
-		free(mem);
+		MEMORY_BACKEND_FREE(mem);
 	}
 }
 
@@ -191,6 +227,38 @@ uint64_t Memory::get_mem_max_usage() {
 #endif
 }
 
+uint64_t Memory::get_tag_mem_usage(Tag p_tag) {
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, 0);
+#ifdef DEBUG_ENABLED
+	return tag_usage[p_tag].get();
+#else
+	return 0;
+#endif
+}
+
+uint64_t Memory::get_tag_mem_max_usage(Tag p_tag) {
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, 0);
+#ifdef DEBUG_ENABLED
+	return tag_max_usage[p_tag].get();
+#else
+	return 0;
+#endif
+}
+
+const char *Memory::get_tag_name(Tag p_tag) {
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, "");
+	static const char *names[TAG_MAX] = {
+		"core",
+		"scene",
+		"physics",
+		"rendering",
+		"audio",
+		"script",
+		"resources",
+	};
+	return names[p_tag];
+}
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
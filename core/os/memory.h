@@ -42,15 +42,52 @@
 #endif
 
 class Memory {
+public:
+	// Subsystem charged for the allocations made by a thread, see TagScope.
+	enum Tag {
+		TAG_CORE,
+		TAG_SCENE,
+		TAG_PHYSICS,
+		TAG_RENDERING,
+		TAG_AUDIO,
+		TAG_SCRIPT,
+		TAG_RESOURCES,
+		TAG_MAX
+	};
+
+private:
 	Memory();
 #ifdef DEBUG_ENABLED
 	static SafeNumeric<uint64_t> mem_usage;
 	static SafeNumeric<uint64_t> max_usage;
-#endif
-
 	static SafeNumeric<uint64_t> alloc_count;
 
+	static SafeNumeric<uint64_t> tag_usage[TAG_MAX];
+	static SafeNumeric<uint64_t> tag_max_usage[TAG_MAX];
+	static thread_local uint8_t current_tag;
+#endif
+
 public:
+	// Charges the allocations made on this thread to a subsystem while in scope.
+	// The memory stays charged to it when freed or reallocated from elsewhere.
+	// Only tracked in debug builds, like the rest of the memory usage.
+	class TagScope {
+#ifdef DEBUG_ENABLED
+		uint8_t previous;
+#endif
+
+	public:
+#ifdef DEBUG_ENABLED
+		_FORCE_INLINE_ TagScope(Tag p_tag) {
+			previous = current_tag;
+			current_tag = p_tag;
+		}
+		_FORCE_INLINE_ ~TagScope() { current_tag = previous; }
+#else
+		_FORCE_INLINE_ TagScope(Tag p_tag) {}
+#endif
+	};
+
 	static void *alloc_static(size_t p_bytes, bool p_pad_align = false);
 	static void *realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align = false);
 	static void free_static(void *p_ptr, bool p_pad_align = false);
@@ -58,6 +95,9 @@ public:
 	static uint64_t get_mem_available();
 	static uint64_t get_mem_usage();
 	static uint64_t get_mem_max_usage();
+	static uint64_t get_tag_mem_usage(Tag p_tag);
+	static uint64_t get_tag_mem_max_usage(Tag p_tag);
+	static const char *get_tag_name(Tag p_tag);
 };
 
 class DefaultAllocator {
@@ -75,6 +75,17 @@ void OS::add_logger(Logger *p_logger) {
 	}
 }
 
+void OS::enable_async_logging(uint32_t p_buffer_size, uint32_t p_max_messages_per_second) {
+	// Loggers added from now on are not wrapped and keep writing directly.
+	Vector<Logger *> loggers;
+	loggers.push_back(memnew(AsyncLogger(_logger, p_buffer_size, p_max_messages_per_second)));
+	_logger = memnew(CompositeLogger(loggers));
+}
+
+void OS::flush_logs() {
+	_logger->flush();
+}
+
 void OS::print_error(const char *p_function, const char *p_file, int p_line, const char *p_code, const char *p_rationale, bool p_editor_notify, Logger::ErrorType p_type) {
 	if (!_stderr_enabled) {
 		return;
@@ -358,6 +369,50 @@ int OS::get_processor_count() const {
 	return 1;
 }
 
+Vector<OS::ProcessorInfo> OS::_query_processor_topology() const {
+	Vector<ProcessorInfo> topology;
+	topology.resize(MAX(get_processor_count(), 1));
+	for (int i = 0; i < topology.size(); i++) {
+		topology.write[i].core = i;
+	}
+	return topology;
+}
+
+const Vector<OS::ProcessorInfo> &OS::get_processor_topology() const {
+	if (processor_topology.is_empty()) {
+		processor_topology = _query_processor_topology();
+	}
+	return processor_topology;
+}
+
+int OS::get_physical_core_count() const {
+	int count = 0;
+	for (const ProcessorInfo &info : get_processor_topology()) {
+		count = MAX(count, info.core + 1);
+	}
+	return count;
+}
+
+int OS::get_processor_core_class_count() const {
+	int count = 0;
+	for (const ProcessorInfo &info : get_processor_topology()) {
+		count = MAX(count, info.core_class + 1);
+	}
+	return count;
+}
+
+uint64_t OS::get_processor_core_class_mask(int p_core_class) const {
+	const Vector<ProcessorInfo> &topology = get_processor_topology();
+	uint64_t mask = 0;
+	// Affinity masks can only address the first 64 logical processors.
+	for (int i = 0; i < MIN(topology.size(), 64); i++) {
+		if (topology[i].core_class == p_core_class) {
+			mask |= uint64_t(1) << i;
+		}
+	}
+	return mask;
+}
+
 bool OS::can_use_threads() const {
 #ifdef NO_THREADS
 	return false;
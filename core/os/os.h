@@ -81,6 +81,12 @@ public:
 		RENDER_SEPARATE_THREAD
 	};
 
+	struct ProcessorInfo {
+		int core = 0; // Physical core, logical processors sharing it are SMT siblings.
+		int core_class = 0; // 0 for the fastest cores, higher for more efficient and slower ones.
+		int cache_domain = 0; // Logical processors sharing the last level cache.
+	};
+
 protected:
 	friend class Main;
 	// Needed by tests to setup command-line args.
@@ -91,6 +97,7 @@ protected:
 
 	// Functions used by Main to initialize/deinitialize the OS.
 	void add_logger(Logger *p_logger);
+	void enable_async_logging(uint32_t p_buffer_size, uint32_t p_max_messages_per_second);
 
 	virtual void initialize() = 0;
 	virtual void initialize_joypads() = 0;
@@ -105,11 +112,17 @@ protected:
 
 	virtual bool _check_internal_feature_support(const String &p_feature) = 0;
 
+	mutable Vector<ProcessorInfo> processor_topology;
+
+	// Called once by get_processor_topology(), the default assumes all processors are distinct, identical cores.
+	virtual Vector<ProcessorInfo> _query_processor_topology() const;
+
 public:
 	typedef int64_t ProcessID;
 
 	static OS *get_singleton();
 
+	void flush_logs();
 	void print_error(const char *p_function, const char *p_file, int p_line, const char *p_code, const char *p_rationale, bool p_editor_notify = false, Logger::ErrorType p_type = Logger::ERR_ERROR);
 	void print(const char *p_format, ...) _PRINTF_FORMAT_ATTRIBUTE_2_3;
 	void printerr(const char *p_format, ...) _PRINTF_FORMAT_ATTRIBUTE_2_3;
@@ -279,6 +292,13 @@ public:
 
 	virtual int get_processor_count() const;
 
+	// One entry per logical processor, in the order used by thread affinity masks.
+	// Queried once and cached, Main does so during setup before starting threads.
+	const Vector<ProcessorInfo> &get_processor_topology() const;
+	int get_physical_core_count() const;
+	int get_processor_core_class_count() const;
+	uint64_t get_processor_core_class_mask(int p_core_class) const;
+
 	virtual String get_unique_id() const;
 
 	virtual bool can_use_threads() const;
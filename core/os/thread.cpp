@@ -32,7 +32,22 @@
 
 #include "thread.h"
 
+#include "core/object/message_queue.h"
 #include "core/object/script_language.h"
+#include "core/os/frame_allocator.h"
+#include "core/os/os.h"
+
+uint64_t Thread::get_core_class_affinity_mask(CoreClass p_core_class) {
+	if (p_core_class == CORE_CLASS_ANY || !OS::get_singleton()) {
+		return 0;
+	}
+
+	int class_count = OS::get_singleton()->get_processor_core_class_count();
+	if (class_count < 2) {
+		return 0;
+	}
+	return OS::get_singleton()->get_processor_core_class_mask(p_core_class == CORE_CLASS_PERFORMANCE ? 0 : class_count - 1);
+}
 
 #if !defined(NO_THREADS)
 
@@ -42,6 +57,7 @@ Error (*Thread::set_name_func)(const String &) = nullptr;
 void (*Thread::set_priority_func)(Thread::Priority) = nullptr;
 void (*Thread::init_func)() = nullptr;
 void (*Thread::term_func)() = nullptr;
+Error (*Thread::set_affinity_func)(uint64_t) = nullptr;
 
 uint64_t Thread::_thread_id_hash(const std::thread::id &p_t) {
 	static std::hash<std::thread::id> hasher;
@@ -55,11 +71,13 @@ void Thread::_set_platform_funcs(
 		Error (*p_set_name_func)(const String &),
 		void (*p_set_priority_func)(Thread::Priority),
 		void (*p_init_func)(),
-		void (*p_term_func)()) {
+		void (*p_term_func)(),
+		Error (*p_set_affinity_func)(uint64_t)) {
 	Thread::set_name_func = p_set_name_func;
 	Thread::set_priority_func = p_set_priority_func;
 	Thread::init_func = p_init_func;
 	Thread::term_func = p_term_func;
+	Thread::set_affinity_func = p_set_affinity_func;
 }
 
 void Thread::callback(Thread *p_self, const Settings &p_settings, Callback p_callback, void *p_userdata) {
@@ -67,12 +85,19 @@ void Thread::callback(Thread *p_self, const Settings &p_settings, Callback p_cal
 	if (set_priority_func) {
 		set_priority_func(p_settings.priority);
 	}
+	uint64_t affinity_mask = p_settings.affinity_mask ? p_settings.affinity_mask : get_core_class_affinity_mask(p_settings.core_class);
+	if (affinity_mask && set_affinity_func) {
+		set_affinity_func(affinity_mask);
+	}
 	if (init_func) {
 		init_func();
 	}
 	ScriptServer::thread_enter(); //scripts may need to attach a stack
 	p_callback(p_userdata);
 	ScriptServer::thread_exit();
+	FrameAllocator::release_thread_memory();
+	MessageQueue::release_thread_queue();
+	ObjectDB::release_thread_slots();
 	if (term_func) {
 		term_func();
 	}
@@ -114,6 +139,15 @@ Error Thread::set_name(const String &p_name) {
 	return ERR_UNAVAILABLE;
 }
 
+Error Thread::set_affinity(uint64_t p_mask) {
+	ERR_FAIL_COND_V(p_mask == 0, ERR_INVALID_PARAMETER);
+	if (set_affinity_func) {
+		return set_affinity_func(p_mask);
+	}
+
+	return ERR_UNAVAILABLE;
+}
+
 Thread::Thread() {
 	caller_id = _thread_id_hash(std::this_thread::get_id());
 }
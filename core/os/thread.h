@@ -58,9 +58,25 @@ public:
 		PRIORITY_HIGH
 	};
 
+	// Kind of processors a thread prefers on CPUs mixing fast and efficient cores.
+	// Has no effect on CPUs where all the cores are the same.
+	enum CoreClass {
+		CORE_CLASS_ANY,
+		CORE_CLASS_PERFORMANCE,
+		CORE_CLASS_EFFICIENCY,
+	};
+
 	struct Settings {
 		Priority priority;
-		Settings() { priority = PRIORITY_NORMAL; }
+		CoreClass core_class;
+		// Logical processors the thread may run on, one bit per entry of OS::get_processor_topology().
+		// Takes precedence over core_class when not zero.
+		uint64_t affinity_mask;
+		Settings() {
+			priority = PRIORITY_NORMAL;
+			core_class = CORE_CLASS_ANY;
+			affinity_mask = 0;
+		}
 	};
 
 private:
@@ -81,6 +97,7 @@ private:
 	static void (*set_priority_func)(Thread::Priority);
 	static void (*init_func)();
 	static void (*term_func)();
+	static Error (*set_affinity_func)(uint64_t);
 #endif
 
 public:
@@ -88,7 +105,11 @@ public:
 			Error (*p_set_name_func)(const String &),
 			void (*p_set_priority_func)(Thread::Priority),
 			void (*p_init_func)() = nullptr,
-			void (*p_term_func)() = nullptr);
+			void (*p_term_func)() = nullptr,
+			Error (*p_set_affinity_func)(uint64_t) = nullptr);
+
+	// Mask of the logical processors of the given class, or 0 (no restriction) if the CPU has a single class.
+	static uint64_t get_core_class_affinity_mask(CoreClass p_core_class);
 
 #if !defined(NO_THREADS)
 	_FORCE_INLINE_ ID get_id() const { return id; }
@@ -98,6 +119,8 @@ public:
 	_FORCE_INLINE_ static ID get_main_id() { return main_thread_id; }
 
 	static Error set_name(const String &p_name);
+	// Restricts the calling thread to the logical processors in the mask.
+	static Error set_affinity(uint64_t p_mask);
 
 	void start(Thread::Callback p_callback, void *p_user, const Settings &p_settings = Settings());
 	bool is_started() const;
@@ -114,6 +137,7 @@ public:
 	_FORCE_INLINE_ static ID get_main_id() { return 0; }
 
 	static Error set_name(const String &p_name) { return ERR_UNAVAILABLE; }
+	static Error set_affinity(uint64_t p_mask) { return ERR_UNAVAILABLE; }
 
 	void start(Thread::Callback p_callback, void *p_user, const Settings &p_settings = Settings()) {}
 	bool is_started() const { return false; }
@@ -0,0 +1,473 @@
+/*************************************************************************/
+/*  worker_thread_pool.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "worker_thread_pool.h"
+
+#include "core/debugger/trace_zones.h"
+#include "core/os/os.h"
+
+WorkerThreadPool *WorkerThreadPool::singleton = nullptr;
+thread_local int WorkerThreadPool::current_thread_index = -1;
+
+/* WorkQueue */
+
+void WorkerThreadPool::WorkQueue::push_back(Task *p_task) {
+	lock.lock();
+	tasks.push_back(p_task);
+	lock.unlock();
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::WorkQueue::pop_back() {
+	Task *task = nullptr;
+	lock.lock();
+	if (tasks.size() > front) {
+		task = tasks[tasks.size() - 1];
+		tasks.resize(tasks.size() - 1);
+		if (tasks.size() == front) {
+			tasks.clear();
+			front = 0;
+		}
+	}
+	lock.unlock();
+	return task;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::WorkQueue::pop_front() {
+	Task *task = nullptr;
+	lock.lock();
+	if (tasks.size() > front) {
+		task = tasks[front++];
+		if (tasks.size() == front) {
+			tasks.clear();
+			front = 0;
+		}
+	}
+	lock.unlock();
+	return task;
+}
+
+bool WorkerThreadPool::WorkQueue::is_empty() {
+	lock.lock();
+	bool empty = tasks.size() == front;
+	lock.unlock();
+	return empty;
+}
+
+/* Scheduling */
+
+void WorkerThreadPool::_push_task(Task *p_task) {
+	if (current_thread_index >= 0) {
+		threads[current_thread_index].queue.push_back(p_task);
+	} else {
+		shared_queue.push_back(p_task);
+	}
+
+	if (sleeping_threads.get() > 0) {
+		task_available_semaphore.post();
+	}
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_fetch_task() {
+	Task *task = nullptr;
+
+	// Own deque first, newest task first (it's the most likely to be hot in cache).
+	if (current_thread_index >= 0) {
+		task = threads[current_thread_index].queue.pop_back();
+		if (task) {
+			return task;
+		}
+	}
+
+	task = shared_queue.pop_front();
+	if (task) {
+		return task;
+	}
+
+	if (thread_count == 0) {
+		return nullptr;
+	}
+
+	// Steal the oldest task from someone else, starting from a rotating victim to spread contention.
+	uint32_t start = steal_seed.increment();
+	for (uint32_t i = 0; i < thread_count; i++) {
+		uint32_t victim = (start + i) % thread_count;
+		if (int(victim) == current_thread_index) {
+			continue;
+		}
+		task = threads[victim].queue.pop_front();
+		if (task) {
+			return task;
+		}
+	}
+
+	return nullptr;
+}
+
+bool WorkerThreadPool::_has_pending_tasks() {
+	if (!shared_queue.is_empty()) {
+		return true;
+	}
+	for (uint32_t i = 0; i < thread_count; i++) {
+		if (!threads[i].queue.is_empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void WorkerThreadPool::_process_task(Task *p_task) {
+	TRACE_ZONE("WorkerThreadPool task");
+
+	if (p_task->group) {
+		Group *group = p_task->group;
+		while (true) {
+			uint32_t from = group->index.postadd(group->batch_size);
+			if (from >= group->max) {
+				break;
+			}
+			uint32_t to = MIN(from + group->batch_size, group->max);
+			for (uint32_t work_index = from; work_index < to; work_index++) {
+				if (group->native_func) {
+					group->native_func(group->native_func_userdata, work_index);
+				} else {
+					group->template_userdata->callback_indexed(work_index);
+				}
+			}
+		}
+	} else {
+		if (p_task->native_func) {
+			p_task->native_func(p_task->native_func_userdata);
+		} else {
+			p_task->template_userdata->callback();
+		}
+	}
+
+	_complete_task(p_task);
+}
+
+void WorkerThreadPool::_complete_task(Task *p_task) {
+	if (p_task->group) {
+		Group *group = p_task->group;
+		task_mutex.lock();
+		task_allocator.free(p_task);
+		if (group->finished.increment() == group->tasks_used) {
+			group->completed = true;
+			for (uint32_t i = 0; i < group->waiting; i++) {
+				group->done_semaphore.post();
+			}
+		}
+		task_mutex.unlock();
+		return;
+	}
+
+	if (p_task->template_userdata) {
+		memdelete(p_task->template_userdata);
+		p_task->template_userdata = nullptr;
+	}
+
+	task_mutex.lock();
+	p_task->completed = true;
+	for (uint32_t i = 0; i < p_task->dependents.size(); i++) {
+		Task *dependent = p_task->dependents[i];
+		dependent->pending_dependencies--;
+		if (dependent->pending_dependencies == 0) {
+			_push_task(dependent);
+		}
+	}
+	p_task->dependents.clear();
+	for (uint32_t i = 0; i < p_task->waiting; i++) {
+		p_task->done_semaphore.post();
+	}
+	task_mutex.unlock();
+}
+
+void WorkerThreadPool::_thread_function(void *p_user) {
+	ThreadData *thread = static_cast<ThreadData *>(p_user);
+	current_thread_index = thread->index;
+	WorkerThreadPool *pool = singleton;
+
+	while (true) {
+		Task *task = pool->_fetch_task();
+		if (task) {
+			pool->_process_task(task);
+			continue;
+		}
+
+		// Announce we're going to sleep before checking one last time, so a concurrent
+		// push either sees us sleeping (and posts) or we see its task.
+		pool->sleeping_threads.increment();
+		if (pool->exit_threads.load()) {
+			pool->sleeping_threads.decrement();
+			break;
+		}
+		if (pool->_has_pending_tasks()) {
+			pool->sleeping_threads.decrement();
+			continue;
+		}
+		pool->task_available_semaphore.wait();
+		pool->sleeping_threads.decrement();
+	}
+}
+
+/* Tasks */
+
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(BaseTemplateUserdata *p_template_userdata, void (*p_func)(void *), void *p_userdata, const TaskID *p_dependencies, uint32_t p_dependency_count) {
+	task_mutex.lock();
+	Task *task = task_allocator.alloc();
+	TaskID id = last_task++;
+	task->self = id;
+	task->template_userdata = p_template_userdata;
+	task->native_func = p_func;
+	task->native_func_userdata = p_userdata;
+	tasks.set(id, task);
+
+	for (uint32_t i = 0; i < p_dependency_count; i++) {
+		Task **dependency = tasks.getptr(p_dependencies[i]);
+		if (!dependency || (*dependency)->completed) {
+			continue; // Already done (and maybe even released), nothing to wait for.
+		}
+		(*dependency)->dependents.push_back(task);
+		task->pending_dependencies++;
+	}
+
+	if (task->pending_dependencies == 0) {
+		_push_task(task);
+	}
+	task_mutex.unlock();
+
+	return id;
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, const TaskID *p_dependencies, uint32_t p_dependency_count) {
+	return _add_task(nullptr, p_func, p_userdata, p_dependencies, p_dependency_count);
+}
+
+bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
+	MutexLock<BinaryMutex> lock(task_mutex);
+	Task *const *task = tasks.getptr(p_task_id);
+	ERR_FAIL_COND_V_MSG(!task, false, "Invalid Task ID.");
+	return (*task)->completed;
+}
+
+void WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
+	task_mutex.lock();
+	Task **taskp = tasks.getptr(p_task_id);
+	if (!taskp) {
+		task_mutex.unlock();
+		ERR_FAIL_MSG("Invalid Task ID."); // Invalid or already waited for.
+	}
+	Task *task = *taskp;
+
+	while (!task->completed) {
+		task_mutex.unlock();
+
+		// Help with whatever is pending instead of blocking, the awaited task may even be in our own deque.
+		Task *other = _fetch_task();
+		if (other) {
+			_process_task(other);
+			task_mutex.lock();
+			continue;
+		}
+
+		task_mutex.lock();
+		if (task->completed) {
+			break;
+		}
+		// Nothing to do right now, the task (or what it depends on) is being processed elsewhere.
+		task->waiting++;
+		task_mutex.unlock();
+		task->done_semaphore.wait();
+		task_mutex.lock();
+		task->waiting--;
+	}
+
+	tasks.erase(p_task_id);
+	task_allocator.free(task);
+	task_mutex.unlock();
+}
+
+/* Groups */
+
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(BaseTemplateUserdata *p_template_userdata, void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, uint32_t p_batch_size) {
+	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
+	p_batch_size = MAX(p_batch_size, 1u);
+	if (p_tasks < 0) {
+		p_tasks = thread_count + 1; // The waiting thread helps too.
+	}
+	// No point in having more tasks than batches.
+	p_tasks = CLAMP(p_tasks, 1, MAX(int((p_elements + p_batch_size - 1) / p_batch_size), 1));
+
+	task_mutex.lock();
+	Group *group = group_allocator.alloc();
+	GroupID id = last_task++;
+	group->self = id;
+	group->template_userdata = p_template_userdata;
+	group->native_func = p_func;
+	group->native_func_userdata = p_userdata;
+	group->index.set(0);
+	group->max = p_elements;
+	group->batch_size = p_batch_size;
+	group->finished.set(0);
+	group->tasks_used = p_tasks;
+	groups.set(id, group);
+
+	for (int i = 0; i < p_tasks; i++) {
+		Task *task = task_allocator.alloc();
+		task->group = group;
+		_push_task(task);
+	}
+	task_mutex.unlock();
+
+	return id;
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, uint32_t p_batch_size) {
+	return _add_group_task(nullptr, p_func, p_userdata, p_elements, p_tasks, p_batch_size);
+}
+
+bool WorkerThreadPool::is_group_task_completed(GroupID p_group) const {
+	MutexLock<BinaryMutex> lock(task_mutex);
+	Group *const *group = groups.getptr(p_group);
+	ERR_FAIL_COND_V_MSG(!group, false, "Invalid Group ID.");
+	return (*group)->completed;
+}
+
+bool WorkerThreadPool::is_group_task_dispatched(GroupID p_group) const {
+	MutexLock<BinaryMutex> lock(task_mutex);
+	Group *const *group = groups.getptr(p_group);
+	ERR_FAIL_COND_V_MSG(!group, true, "Invalid Group ID.");
+	return (*group)->index.get() >= (*group)->max;
+}
+
+uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
+	MutexLock<BinaryMutex> lock(task_mutex);
+	Group *const *group = groups.getptr(p_group);
+	ERR_FAIL_COND_V_MSG(!group, 0, "Invalid Group ID.");
+	return MIN((*group)->index.get(), (*group)->max);
+}
+
+void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
+	task_mutex.lock();
+	Group **groupp = groups.getptr(p_group);
+	if (!groupp) {
+		task_mutex.unlock();
+		ERR_FAIL_MSG("Invalid Group ID."); // Invalid or already waited for.
+	}
+	Group *group = *groupp;
+
+	while (!group->completed) {
+		task_mutex.unlock();
+
+		Task *other = _fetch_task();
+		if (other) {
+			_process_task(other);
+			task_mutex.lock();
+			continue;
+		}
+
+		task_mutex.lock();
+		if (group->completed) {
+			break;
+		}
+		group->waiting++;
+		task_mutex.unlock();
+		group->done_semaphore.wait();
+		task_mutex.lock();
+		group->waiting--;
+	}
+
+	groups.erase(p_group);
+	if (group->template_userdata) {
+		memdelete(group->template_userdata);
+	}
+	group_allocator.free(group);
+	task_mutex.unlock();
+}
+
+/* Lifecycle */
+
+void WorkerThreadPool::init(int p_thread_count, Thread::CoreClass p_core_class) {
+	ERR_FAIL_COND(threads != nullptr);
+	Thread::Settings settings;
+	settings.affinity_mask = Thread::get_core_class_affinity_mask(p_core_class);
+	if (p_thread_count < 0) {
+		if (settings.affinity_mask) {
+			p_thread_count = 0;
+			for (uint64_t mask = settings.affinity_mask; mask; mask &= mask - 1) {
+				p_thread_count++;
+			}
+		} else {
+			p_thread_count = OS::get_singleton()->get_processor_count();
+		}
+	}
+
+	exit_threads.store(false);
+	thread_count = p_thread_count;
+	if (thread_count == 0) {
+		return;
+	}
+
+	threads = memnew_arr(ThreadData, thread_count);
+	for (uint32_t i = 0; i < thread_count; i++) {
+		threads[i].index = i;
+		threads[i].thread.start(&WorkerThreadPool::_thread_function, &threads[i], settings);
+	}
+}
+
+void WorkerThreadPool::finish() {
+	if (threads == nullptr) {
+		thread_count = 0;
+		return;
+	}
+
+	exit_threads.store(true);
+	for (uint32_t i = 0; i < thread_count; i++) {
+		task_available_semaphore.post();
+	}
+	for (uint32_t i = 0; i < thread_count; i++) {
+		threads[i].thread.wait_to_finish();
+	}
+
+	memdelete_arr(threads);
+	threads = nullptr;
+	thread_count = 0;
+
+	ERR_FAIL_COND_MSG(tasks.size() || groups.size(), "Tasks or groups were never waited for in WorkerThreadPool.");
+}
+
+WorkerThreadPool::WorkerThreadPool() {
+	singleton = this;
+	exit_threads.store(false);
+}
+
+WorkerThreadPool::~WorkerThreadPool() {
+	finish();
+	singleton = nullptr;
+}
@@ -0,0 +1,215 @@
+/*************************************************************************/
+/*  worker_thread_pool.h                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef WORKER_THREAD_POOL_H
+#define WORKER_THREAD_POOL_H
+
+#include "core/os/memory.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/spin_lock.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/paged_allocator.h"
+#include "core/templates/safe_refcount.h"
+
+#include <atomic>
+
+// Engine-wide work-stealing scheduler.
+//
+// Every worker thread owns a deque. Tasks submitted from a worker (nested
+// submission) go to the back of its own deque and are popped LIFO by the
+// owner, while idle workers steal from the front of the other deques.
+// Tasks submitted from any other thread go to a shared queue.
+//
+// Threads waiting for a task or a group don't block while there is pending
+// work; they run other tasks in the meantime. This keeps nested waits from
+// deadlocking and lets the pool run with zero worker threads (everything is
+// then executed by whoever waits).
+//
+// Every task and group must be waited for exactly once, which also releases it.
+
+class WorkerThreadPool {
+public:
+	typedef int64_t TaskID;
+	typedef int64_t GroupID;
+
+	enum {
+		INVALID_TASK_ID = -1
+	};
+
+private:
+	struct BaseTemplateUserdata {
+		virtual void callback() {}
+		virtual void callback_indexed(uint32_t p_index) {}
+		virtual ~BaseTemplateUserdata() {}
+	};
+
+	template <class C, class M, class U>
+	struct TaskUserData : public BaseTemplateUserdata {
+		C *instance;
+		M method;
+		U userdata;
+		virtual void callback() override {
+			(instance->*method)(userdata);
+		}
+	};
+
+	template <class C, class M, class U>
+	struct GroupUserData : public BaseTemplateUserdata {
+		C *instance;
+		M method;
+		U userdata;
+		virtual void callback_indexed(uint32_t p_index) override {
+			(instance->*method)(p_index, userdata);
+		}
+	};
+
+	struct Group {
+		GroupID self = INVALID_TASK_ID;
+		BaseTemplateUserdata *template_userdata = nullptr;
+		void (*native_func)(void *, uint32_t) = nullptr;
+		void *native_func_userdata = nullptr;
+		SafeNumeric<uint32_t> index;
+		uint32_t max = 0;
+		uint32_t batch_size = 1;
+		SafeNumeric<uint32_t> finished;
+		uint32_t tasks_used = 0;
+		bool completed = false; // Protected by task_mutex.
+		uint32_t waiting = 0; // Protected by task_mutex.
+		Semaphore done_semaphore;
+	};
+
+	struct Task {
+		TaskID self = INVALID_TASK_ID;
+		BaseTemplateUserdata *template_userdata = nullptr;
+		void (*native_func)(void *) = nullptr;
+		void *native_func_userdata = nullptr;
+		Group *group = nullptr;
+		uint32_t pending_dependencies = 0; // Protected by task_mutex.
+		LocalVector<Task *> dependents; // Protected by task_mutex.
+		bool completed = false; // Protected by task_mutex.
+		uint32_t waiting = 0; // Protected by task_mutex.
+		Semaphore done_semaphore;
+	};
+
+	struct WorkQueue {
+		SpinLock lock;
+		LocalVector<Task *> tasks;
+		uint32_t front = 0;
+
+		void push_back(Task *p_task);
+		Task *pop_back();
+		Task *pop_front();
+		bool is_empty();
+	};
+
+	struct ThreadData {
+		uint32_t index = 0;
+		Thread thread;
+		WorkQueue queue;
+	};
+
+	static WorkerThreadPool *singleton;
+	static thread_local int current_thread_index;
+
+	ThreadData *threads = nullptr;
+	uint32_t thread_count = 0;
+	std::atomic<bool> exit_threads;
+
+	WorkQueue shared_queue;
+	SafeNumeric<uint32_t> sleeping_threads;
+	Semaphore task_available_semaphore;
+	SafeNumeric<uint32_t> steal_seed;
+
+	BinaryMutex task_mutex;
+	PagedAllocator<Task> task_allocator;
+	PagedAllocator<Group> group_allocator;
+	HashMap<TaskID, Task *> tasks;
+	HashMap<GroupID, Group *> groups;
+	TaskID last_task = 1;
+
+	static void _thread_function(void *p_user);
+
+	void _push_task(Task *p_task);
+	Task *_fetch_task();
+	bool _has_pending_tasks();
+	void _process_task(Task *p_task);
+	void _complete_task(Task *p_task);
+
+	TaskID _add_task(BaseTemplateUserdata *p_template_userdata, void (*p_func)(void *), void *p_userdata, const TaskID *p_dependencies, uint32_t p_dependency_count);
+	GroupID _add_group_task(BaseTemplateUserdata *p_template_userdata, void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, uint32_t p_batch_size);
+
+public:
+	template <class C, class M, class U>
+	TaskID add_template_task(C *p_instance, M p_method, U p_userdata, const TaskID *p_dependencies = nullptr, uint32_t p_dependency_count = 0) {
+		TaskUserData<C, M, U> *ud = memnew((TaskUserData<C, M, U>));
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_task(ud, nullptr, nullptr, p_dependencies, p_dependency_count);
+	}
+	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, const TaskID *p_dependencies = nullptr, uint32_t p_dependency_count = 0);
+
+	bool is_task_completed(TaskID p_task_id) const;
+	void wait_for_task_completion(TaskID p_task_id);
+
+	// Calls the method once for every index in [0, p_elements), spread over p_tasks tasks (-1 means one per thread, including the waiting one).
+	// Tasks grab p_batch_size consecutive indices at a time, use more than one when the work per index is tiny.
+	template <class C, class M, class U>
+	GroupID add_template_group_task(C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, uint32_t p_batch_size = 1) {
+		GroupUserData<C, M, U> *ud = memnew((GroupUserData<C, M, U>));
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_group_task(ud, nullptr, nullptr, p_elements, p_tasks, p_batch_size);
+	}
+	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, uint32_t p_batch_size = 1);
+
+	bool is_group_task_completed(GroupID p_group) const;
+	bool is_group_task_dispatched(GroupID p_group) const;
+	uint32_t get_group_processed_element_count(GroupID p_group) const;
+	void wait_for_group_task_completion(GroupID p_group);
+
+	_FORCE_INLINE_ int get_thread_count() const { return thread_count; }
+	// Index of the calling worker thread, or -1 when not called from a worker.
+	_FORCE_INLINE_ static int get_thread_index() { return current_thread_index; }
+
+	static WorkerThreadPool *get_singleton() { return singleton; }
+	// A negative p_thread_count uses one thread per logical processor of p_core_class.
+	void init(int p_thread_count = -1, Thread::CoreClass p_core_class = Thread::CORE_CLASS_ANY);
+	void finish();
+
+	WorkerThreadPool();
+	~WorkerThreadPool();
+};
+
+#endif // WORKER_THREAD_POOL_H
@@ -45,6 +45,7 @@
 #include "core/io/config_file.h"
 #include "core/io/dtls_server.h"
 #include "core/io/http_client.h"
+#include "core/io/image_decoder.h"
 #include "core/io/image_loader.h"
 #include "core/io/json.h"
 #include "core/io/marshalls.h"
@@ -62,6 +63,7 @@
 #include "core/io/udp_server.h"
 #include "core/io/xml_parser.h"
 #include "core/math/a_star.h"
+#include "core/math/a_star_grid_2d.h"
 #include "core/math/expression.h"
 #include "core/math/geometry_2d.h"
 #include "core/math/geometry_3d.h"
@@ -74,6 +76,7 @@
 #include "core/object/undo_redo.h"
 #include "core/os/main_loop.h"
 #include "core/os/time.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/string/optimized_translation.h"
 #include "core/string/translation.h"
 
@@ -108,6 +111,8 @@ extern void unregister_global_constants();
 
 static ResourceUID *resource_uid = nullptr;
 
+static WorkerThreadPool *worker_thread_pool = nullptr;
+
 void register_core_types() {
 	//consistency check
 	static_assert(sizeof(Callable) <= 16);
@@ -117,6 +122,8 @@ void register_core_types() {
 	StringName::setup();
 	ResourceLoader::initialize();
 
+	worker_thread_pool = memnew(WorkerThreadPool);
+
 	register_global_constants();
 
 	Variant::register_types();
@@ -145,6 +152,7 @@ void register_core_types() {
 	GDREGISTER_CLASS(WeakRef);
 	GDREGISTER_CLASS(Resource);
 	GDREGISTER_CLASS(Image);
+	GDREGISTER_CLASS(ImageDecoder);
 
 	GDREGISTER_CLASS(Shortcut);
 	GDREGISTER_VIRTUAL_CLASS(InputEvent);
@@ -228,6 +236,7 @@ void register_core_types() {
 	GDREGISTER_VIRTUAL_CLASS(PackedDataContainerRef);
 	GDREGISTER_CLASS(AStar);
 	GDREGISTER_CLASS(AStar2D);
+	GDREGISTER_CLASS(AStarGrid2D);
 	GDREGISTER_CLASS(EncodedObjectAsID);
 	GDREGISTER_CLASS(RandomNumberGenerator);
 
@@ -269,6 +278,13 @@ void register_core_settings() {
 
 	GLOBAL_DEF("network/ssl/certificate_bundle_override", "");
 	ProjectSettings::get_singleton()->set_custom_property_info("network/ssl/certificate_bundle_override", PropertyInfo(Variant::STRING, "network/ssl/certificate_bundle_override", PROPERTY_HINT_FILE, "*.crt"));
+
+	GLOBAL_DEF_RST("threading/worker_pool/max_threads", -1);
+	ProjectSettings::get_singleton()->set_custom_property_info("threading/worker_pool/max_threads", PropertyInfo(Variant::INT, "threading/worker_pool/max_threads", PROPERTY_HINT_RANGE, "-1,256,1"));
+	GLOBAL_DEF_RST("threading/worker_pool/core_class", Thread::CORE_CLASS_ANY);
+	ProjectSettings::get_singleton()->set_custom_property_info("threading/worker_pool/core_class", PropertyInfo(Variant::INT, "threading/worker_pool/core_class", PROPERTY_HINT_ENUM, "Any,Performance,Efficiency"));
+	GLOBAL_DEF_RST("threading/resource_loader/core_class", Thread::CORE_CLASS_ANY);
+	ProjectSettings::get_singleton()->set_custom_property_info("threading/resource_loader/core_class", PropertyInfo(Variant::INT, "threading/resource_loader/core_class", PROPERTY_HINT_ENUM, "Any,Performance,Efficiency"));
 }
 
 void register_core_singletons() {
@@ -320,6 +336,9 @@ void unregister_core_types() {
 
 	memdelete(native_extension_manager);
 
+	// Everything using the pool is gone by now.
+	memdelete(worker_thread_pool);
+
 	memdelete(resource_uid);
 	memdelete(_resource_loader);
 	memdelete(_resource_saver);
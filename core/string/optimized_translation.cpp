@@ -191,6 +191,7 @@ bool OptimizedTranslation::_set(const StringName &p_name, const Variant &p_value
 	} else {
 		return false;
 	}
+	_messages_changed();
 
 	return true;
 }
@@ -46,7 +46,11 @@ class StringName {
 	enum {
 		STRING_TABLE_BITS = 16,
 		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_MASK = STRING_TABLE_LEN - 1,
+		// Each lock guards the buckets whose index matches it in the low bits.
+		STRING_TABLE_LOCK_BITS = 6,
+		STRING_TABLE_LOCK_COUNT = 1 << STRING_TABLE_LOCK_BITS,
+		STRING_TABLE_LOCK_MASK = STRING_TABLE_LOCK_COUNT - 1
 	};
 
 	struct _Data {
@@ -78,7 +82,8 @@ class StringName {
 	friend void register_core_types();
 	friend void unregister_core_types();
 	friend class Main;
-	static Mutex mutex;
+	static Mutex table_locks[STRING_TABLE_LOCK_COUNT];
+	_FORCE_INLINE_ static Mutex &_get_table_lock(uint32_t p_idx) { return table_locks[p_idx & STRING_TABLE_LOCK_MASK]; }
 	static void setup();
 	static void cleanup();
 	static bool configured;
@@ -820,6 +820,8 @@ static const char *locale_renames[][2] = {
 
 ///////////////////////////////////////////////
 
+SafeNumeric<uint32_t> Translation::change_count;
+
 Dictionary Translation::_get_messages() const {
 	Dictionary d;
 	for (const KeyValue<StringName, StringName> &E : translation_map) {
@@ -846,6 +848,7 @@ void Translation::_set_messages(const Dictionary &p_messages) {
 	for (const Variant &E : keys) {
 		translation_map[E] = p_messages[E];
 	}
+	_messages_changed();
 }
 
 void Translation::set_locale(const String &p_locale) {
@@ -860,6 +863,7 @@ void Translation::set_locale(const String &p_locale) {
 	} else {
 		locale = univ_locale;
 	}
+	_messages_changed();
 
 	if (OS::get_singleton()->get_main_loop() && TranslationServer::get_singleton()->get_loaded_locales().has(this)) {
 		OS::get_singleton()->get_main_loop()->notification(MainLoop::NOTIFICATION_TRANSLATION_CHANGED);
@@ -868,12 +872,14 @@ void Translation::set_locale(const String &p_locale) {
 
 void Translation::add_message(const StringName &p_src_text, const StringName &p_xlated_text, const StringName &p_context) {
 	translation_map[p_src_text] = p_xlated_text;
+	_messages_changed();
 }
 
 void Translation::add_plural_message(const StringName &p_src_text, const Vector<String> &p_plural_xlated_texts, const StringName &p_context) {
 	WARN_PRINT("Translation class doesn't handle plural messages. Calling add_plural_message() on a Translation instance is probably a mistake. \nUse a derived Translation class that handles plurals, such as TranslationPO class");
 	ERR_FAIL_COND_MSG(p_plural_xlated_texts.is_empty(), "Parameter vector p_plural_xlated_texts passed in is empty.");
 	translation_map[p_src_text] = p_plural_xlated_texts[0];
+	_messages_changed();
 }
 
 StringName Translation::get_message(const StringName &p_src_text, const StringName &p_context) const {
@@ -910,6 +916,7 @@ void Translation::erase_message(const StringName &p_src_text, const StringName &
 	}
 
 	translation_map.erase(p_src_text);
+	_messages_changed();
 }
 
 void Translation::get_message_list(List<StringName> *r_messages) const {
@@ -1051,6 +1058,8 @@ String TranslationServer::get_language_code(const String &p_locale) {
 }
 
 void TranslationServer::set_locale(const String &p_locale) {
+	_wait_for_message_cache_warm();
+
 	String univ_locale = standardize_locale(p_locale);
 
 	if (!is_locale_valid(univ_locale)) {
@@ -1067,6 +1076,9 @@ void TranslationServer::set_locale(const String &p_locale) {
 		locale = univ_locale;
 	}
 
+	// Keep what was translated so far around, it is likely to be needed in the new locale too.
+	_invalidate_message_cache(true);
+
 	if (OS::get_singleton()->get_main_loop()) {
 		OS::get_singleton()->get_main_loop()->notification(MainLoop::NOTIFICATION_TRANSLATION_CHANGED);
 	}
@@ -1125,10 +1137,12 @@ Vector<String> TranslationServer::get_all_locale_names() {
 }
 
 void TranslationServer::add_translation(const Ref<Translation> &p_translation) {
+	_invalidate_message_cache();
 	translations.insert(p_translation);
 }
 
 void TranslationServer::remove_translation(const Ref<Translation> &p_translation) {
+	_invalidate_message_cache();
 	translations.erase(p_translation);
 }
 
@@ -1157,6 +1171,7 @@ Ref<Translation> TranslationServer::get_translation_object(const String &p_local
 }
 
 void TranslationServer::clear() {
+	_invalidate_message_cache();
 	translations.clear();
 }
 
@@ -1169,11 +1184,7 @@ StringName TranslationServer::translate(const StringName &p_message, const Strin
 
 	ERR_FAIL_COND_V_MSG(locale.length() < 2, p_message, "Could not translate message as configured locale '" + locale + "' is invalid.");
 
-	StringName res = _get_message_from_translations(p_message, p_context, locale, false);
-
-	if (!res && fallback.length() >= 2) {
-		res = _get_message_from_translations(p_message, p_context, fallback, false);
-	}
+	StringName res = _get_message(p_message, p_context);
 
 	if (!res) {
 		return pseudolocalization_enabled ? pseudolocalize(p_message) : p_message;
@@ -1192,11 +1203,19 @@ StringName TranslationServer::translate_plural(const StringName &p_message, cons
 
 	ERR_FAIL_COND_V_MSG(locale.length() < 2, p_message, "Could not translate message as configured locale '" + locale + "' is invalid.");
 
-	StringName res = _get_message_from_translations(p_message, p_context, locale, true, p_message_plural, p_n);
+	message_cache_lock.read_lock();
+	if (message_cache_dirty || message_cache_change_count != Translation::get_change_count()) {
+		message_cache_lock.read_unlock();
+		_update_message_cache();
+		message_cache_lock.read_lock();
+	}
+
+	StringName res = _get_message_from_translations(locale_translations, p_message, p_context, true, p_message_plural, p_n);
 
-	if (!res && fallback.length() >= 2) {
-		res = _get_message_from_translations(p_message, p_context, fallback, true, p_message_plural, p_n);
+	if (!res) {
+		res = _get_message_from_translations(fallback_translations, p_message, p_context, true, p_message_plural, p_n);
 	}
+	message_cache_lock.read_unlock();
 
 	if (!res) {
 		if (p_n == 1) {
@@ -1208,36 +1227,153 @@ StringName TranslationServer::translate_plural(const StringName &p_message, cons
 	return res;
 }
 
-StringName TranslationServer::_get_message_from_translations(const StringName &p_message, const StringName &p_context, const String &p_locale, bool plural, const String &p_message_plural, int p_n) const {
+void TranslationServer::_collect_translations(const String &p_locale, LocalVector<const Translation *> &r_translations) const {
 	// Locale can be of the form 'll_CC', i.e. language code and regional code,
 	// e.g. 'en_US', 'en_GB', etc. It might also be simply 'll', e.g. 'en'.
 	// To find the relevant translation, we look for those with locale starting
 	// with the language code, and then if any is an exact match for the long
 	// form. If not found, we fall back to a near match (another locale with
-	// same language code).
+	// same language code). Exact matches are listed first, so the first one
+	// with a message wins, and near matches are only used after them.
 
 	// Note: ResourceLoader::_path_remap reproduces this locale near matching
 	// logic, so be sure to propagate changes there when changing things here.
 
-	StringName res;
+	r_translations.clear();
+	if (p_locale.length() < 2) {
+		return;
+	}
+
 	String lang = get_language_code(p_locale);
-	bool near_match = false;
 
 	for (const Set<Ref<Translation>>::Element *E = translations.front(); E; E = E->next()) {
 		const Ref<Translation> &t = E->get();
-		ERR_FAIL_COND_V(t.is_null(), p_message);
+		ERR_CONTINUE(t.is_null());
+		if (t->get_locale() == p_locale) {
+			r_translations.push_back(t.ptr());
+		}
+	}
+
+	for (const Set<Ref<Translation>>::Element *E = translations.front(); E; E = E->next()) {
+		const Ref<Translation> &t = E->get();
+		ERR_CONTINUE(t.is_null());
 		String l = t->get_locale();
+		if (l != p_locale && get_language_code(l) == lang) {
+			r_translations.push_back(t.ptr());
+		}
+	}
+}
+
+void TranslationServer::_update_message_cache() const {
+	message_cache_lock.write_lock();
 
-		bool exact_match = (l == p_locale);
-		if (!exact_match) {
-			if (near_match) {
-				continue; // Only near-match once, but keep looking for exact matches.
+	uint32_t change_count = Translation::get_change_count();
+	if (message_cache_dirty || message_cache_change_count != change_count) {
+		_collect_translations(locale, locale_translations);
+		_collect_translations(fallback, fallback_translations);
+
+		message_cache_enabled = true;
+		for (const Set<Ref<Translation>>::Element *E = translations.front(); E; E = E->next()) {
+			if (E->get().is_valid() && E->get()->get_script_instance()) {
+				message_cache_enabled = false;
+				break;
 			}
-			if (get_language_code(l) != lang) {
-				continue; // Language code does not match.
+		}
+
+		message_cache.clear();
+		message_cache_change_count = change_count;
+		message_cache_generation++;
+		message_cache_dirty = false;
+	}
+
+	message_cache_lock.write_unlock();
+}
+
+void TranslationServer::_invalidate_message_cache(bool p_warm) {
+	_wait_for_message_cache_warm();
+
+	message_cache_lock.write_lock();
+
+	if (p_warm && message_cache_enabled && !message_cache_dirty) {
+		const MessageKey *K = nullptr;
+		while ((K = message_cache.next(K))) {
+			message_cache_warm_keys.push_back(*K);
+		}
+	}
+	message_cache_dirty = true;
+
+	message_cache_lock.write_unlock();
+
+	if (!message_cache_warm_keys.is_empty() && WorkerThreadPool::get_singleton()) {
+		message_cache_warm_task = WorkerThreadPool::get_singleton()->add_template_task(this, &TranslationServer::_warm_message_cache, nullptr);
+	} else {
+		message_cache_warm_keys.clear();
+	}
+}
+
+void TranslationServer::_wait_for_message_cache_warm() {
+	if (message_cache_warm_task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(message_cache_warm_task);
+		message_cache_warm_task = WorkerThreadPool::INVALID_TASK_ID;
+	}
+}
+
+void TranslationServer::_warm_message_cache(void *p_userdata) {
+	// Runs while the caller keeps translating, the translation set can't change until the task is waited for.
+	for (uint32_t i = 0; i < message_cache_warm_keys.size(); i++) {
+		_get_message(message_cache_warm_keys[i].message, message_cache_warm_keys[i].context);
+	}
+	message_cache_warm_keys.clear();
+}
+
+StringName TranslationServer::_get_message(const StringName &p_message, const StringName &p_context) const {
+	MessageKey key;
+	key.message = p_message;
+	key.context = p_context;
+
+	message_cache_lock.read_lock();
+	if (message_cache_dirty || message_cache_change_count != Translation::get_change_count()) {
+		message_cache_lock.read_unlock();
+		_update_message_cache();
+		message_cache_lock.read_lock();
+	}
+
+	if (message_cache_enabled) {
+		const StringName *cached = message_cache.getptr(key);
+		if (cached) {
+			StringName res = *cached;
+			message_cache_lock.read_unlock();
+			return res;
+		}
+	}
+
+	StringName res = _get_message_from_translations(locale_translations, p_message, p_context, false);
+	if (!res) {
+		res = _get_message_from_translations(fallback_translations, p_message, p_context, false);
+	}
+
+	bool cache = message_cache_enabled;
+	uint32_t generation = message_cache_generation;
+	message_cache_lock.read_unlock();
+
+	if (cache) {
+		message_cache_lock.write_lock();
+		// Skip if the cache was rebuilt meanwhile, the result could be stale.
+		if (generation == message_cache_generation) {
+			if (message_cache.size() >= MESSAGE_CACHE_MAX_SIZE) {
+				message_cache.clear();
 			}
+			message_cache.set(key, res);
 		}
+		message_cache_lock.write_unlock();
+	}
+
+	return res;
+}
 
+StringName TranslationServer::_get_message_from_translations(const LocalVector<const Translation *> &p_translations, const StringName &p_message, const StringName &p_context, bool plural, const String &p_message_plural, int p_n) const {
+	for (uint32_t i = 0; i < p_translations.size(); i++) {
+		const Translation *t = p_translations[i];
 		StringName r;
 		if (!plural) {
 			r = t->get_message(p_message, p_context);
@@ -1245,19 +1381,12 @@ StringName TranslationServer::_get_message_from_translations(const StringName &p
 			r = t->get_plural_message(p_message, p_message_plural, p_n, p_context);
 		}
 
-		if (!r) {
-			continue;
-		}
-		res = r;
-
-		if (exact_match) {
-			break;
-		} else {
-			near_match = true;
+		if (r) {
+			return r;
 		}
 	}
 
-	return res;
+	return StringName();
 }
 
 TranslationServer *TranslationServer::singleton = nullptr;
@@ -1293,6 +1422,7 @@ void TranslationServer::setup() {
 		set_locale(OS::get_singleton()->get_locale());
 	}
 
+	_invalidate_message_cache();
 	fallback = GLOBAL_DEF("internationalization/locale/fallback", "en");
 	pseudolocalization_enabled = GLOBAL_DEF("internationalization/pseudolocalization/use_pseudolocalization", false);
 	pseudolocalization_accents_enabled = GLOBAL_DEF("internationalization/pseudolocalization/replace_with_accents", true);
@@ -1608,3 +1738,7 @@ TranslationServer::TranslationServer() {
 		locale_name_map.insert(locale_list[i], String::utf8(locale_names[i]));
 	}
 }
+
+TranslationServer::~TranslationServer() {
+	_wait_for_message_cache_warm();
+}
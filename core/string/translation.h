@@ -34,6 +34,11 @@
 #include "core/io/resource.h"
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/script_language.h"
+#include "core/os/rw_lock.h"
+#include "core/os/worker_thread_pool.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 class Translation : public Resource {
 	GDCLASS(Translation, Resource);
@@ -47,9 +52,14 @@ class Translation : public Resource {
 	virtual Dictionary _get_messages() const;
 	virtual void _set_messages(const Dictionary &p_messages);
 
+	static SafeNumeric<uint32_t> change_count;
+
 protected:
 	static void _bind_methods();
 
+	// Must be called whenever messages or the locale change, so the lookups cached by TranslationServer are discarded.
+	static void _messages_changed() { change_count.increment(); }
+
 	GDVIRTUAL2RC(StringName, _get_message, StringName, StringName);
 	GDVIRTUAL4RC(StringName, _get_plural_message, StringName, StringName, int, StringName);
 
@@ -65,6 +75,8 @@ public:
 	virtual void get_message_list(List<StringName> *r_messages) const;
 	virtual int get_message_count() const;
 
+	static uint32_t get_change_count() { return change_count.get(); }
+
 	Translation() {}
 };
 
@@ -105,7 +117,44 @@ class TranslationServer : public Object {
 	static TranslationServer *singleton;
 	bool _load_translations(const String &p_from);
 
-	StringName _get_message_from_translations(const StringName &p_message, const StringName &p_context, const String &p_locale, bool plural, const String &p_message_plural = "", int p_n = 0) const;
+	// Results of translate() for the current locale, misses included (as empty StringNames). Keys hash with the
+	// precomputed StringName hashes, so repeated lookups neither walk the translations nor decompress messages.
+	struct MessageKey {
+		StringName message;
+		StringName context;
+
+		bool operator==(const MessageKey &p_key) const { return message == p_key.message && context == p_key.context; }
+	};
+
+	struct MessageKeyHasher {
+		static _FORCE_INLINE_ uint32_t hash(const MessageKey &p_key) { return hash_djb2_one_32(p_key.context.hash(), p_key.message.hash()); }
+	};
+
+	enum {
+		MESSAGE_CACHE_MAX_SIZE = 65536
+	};
+
+	mutable RWLock message_cache_lock;
+	mutable HashMap<MessageKey, StringName, MessageKeyHasher> message_cache;
+	mutable LocalVector<const Translation *> locale_translations; // Exact locale matches first, then language code matches.
+	mutable LocalVector<const Translation *> fallback_translations;
+	mutable bool message_cache_dirty = true;
+	mutable bool message_cache_enabled = true; // Scripted translations may return anything at any time, so they are never cached.
+	mutable uint32_t message_cache_change_count = 0;
+	mutable uint32_t message_cache_generation = 0;
+
+	// After a locale switch, the messages used so far are looked up again for the new locale on the worker pool.
+	LocalVector<MessageKey> message_cache_warm_keys;
+	WorkerThreadPool::TaskID message_cache_warm_task = WorkerThreadPool::INVALID_TASK_ID;
+
+	void _collect_translations(const String &p_locale, LocalVector<const Translation *> &r_translations) const;
+	void _update_message_cache() const;
+	void _invalidate_message_cache(bool p_warm = false);
+	void _wait_for_message_cache_warm();
+	void _warm_message_cache(void *p_userdata);
+	StringName _get_message(const StringName &p_message, const StringName &p_context) const;
+
+	StringName _get_message_from_translations(const LocalVector<const Translation *> &p_translations, const StringName &p_message, const StringName &p_context, bool plural, const String &p_message_plural = "", int p_n = 0) const;
 
 	static void _bind_methods();
 
@@ -158,6 +207,7 @@ public:
 	void load_translations();
 
 	TranslationServer();
+	~TranslationServer();
 };
 
 #endif // TRANSLATION_H
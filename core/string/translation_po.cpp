@@ -109,6 +109,7 @@ void TranslationPO::_set_messages(const Dictionary &p_messages) {
 
 		translation_map[ctx] = temp_map;
 	}
+	_messages_changed();
 }
 
 Vector<String> TranslationPO::_get_message_list() const {
@@ -198,6 +199,7 @@ void TranslationPO::add_message(const StringName &p_src_text, const StringName &
 	} else {
 		map_id_str[p_src_text].push_back(p_xlated_text);
 	}
+	_messages_changed();
 }
 
 void TranslationPO::add_plural_message(const StringName &p_src_text, const Vector<String> &p_plural_xlated_texts, const StringName &p_context) {
@@ -213,6 +215,7 @@ void TranslationPO::add_plural_message(const StringName &p_src_text, const Vecto
 	for (int i = 0; i < p_plural_xlated_texts.size(); i++) {
 		map_id_str[p_src_text].push_back(p_plural_xlated_texts[i]);
 	}
+	_messages_changed();
 }
 
 int TranslationPO::get_plural_forms() const {
@@ -269,6 +272,7 @@ void TranslationPO::erase_message(const StringName &p_src_text, const StringName
 	}
 
 	translation_map[p_context].erase(p_src_text);
+	_messages_changed();
 }
 
 void TranslationPO::get_message_list(List<StringName> *r_messages) const {
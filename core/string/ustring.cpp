@@ -37,6 +37,7 @@
 #include "core/string/print_string.h"
 #include "core/string/translation.h"
 #include "core/string/ucaps.h"
+#include "core/templates/hashfuncs.h"
 #include "core/variant/variant.h"
 
 #include <stdio.h>
@@ -2531,8 +2532,8 @@ done:
 #define READING_EXP 3
 #define READING_DONE 4
 
-double String::to_float(const char *p_str) {
-	return built_in_strtod<char>(p_str);
+double String::to_float(const char *p_str, const char **r_end) {
+	return built_in_strtod<char>(p_str, (char **)r_end);
 }
 
 double String::to_float(const char32_t *p_str, const char32_t **r_end) {
@@ -2614,92 +2615,47 @@ double String::to_float() const {
 	return built_in_strtod<char32_t>(get_data());
 }
 
-uint32_t String::hash(const char *p_cstr) {
-	uint32_t hashv = 5381;
-	uint32_t c;
-
-	while ((c = *p_cstr++)) {
-		hashv = ((hashv << 5) + hashv) + c; /* hash * 33 + c */
+template <class T>
+static _FORCE_INLINE_ int _hash_strlen(const T *p_cstr) {
+	const T *end = p_cstr;
+	while (*end) {
+		end++;
 	}
+	return end - p_cstr;
+}
 
-	return hashv;
+uint32_t String::hash(const char *p_cstr) {
+	return hash_djb2_units<uint32_t>(p_cstr, strlen(p_cstr));
 }
 
 uint32_t String::hash(const char *p_cstr, int p_len) {
-	uint32_t hashv = 5381;
-	for (int i = 0; i < p_len; i++) {
-		hashv = ((hashv << 5) + hashv) + p_cstr[i]; /* hash * 33 + c */
-	}
-
-	return hashv;
+	return hash_djb2_units<uint32_t>(p_cstr, p_len);
 }
 
 uint32_t String::hash(const wchar_t *p_cstr, int p_len) {
-	uint32_t hashv = 5381;
-	for (int i = 0; i < p_len; i++) {
-		hashv = ((hashv << 5) + hashv) + p_cstr[i]; /* hash * 33 + c */
-	}
-
-	return hashv;
+	return hash_djb2_units<uint32_t>(p_cstr, p_len);
 }
 
 uint32_t String::hash(const wchar_t *p_cstr) {
-	uint32_t hashv = 5381;
-	uint32_t c;
-
-	while ((c = *p_cstr++)) {
-		hashv = ((hashv << 5) + hashv) + c; /* hash * 33 + c */
-	}
-
-	return hashv;
+	return hash_djb2_units<uint32_t>(p_cstr, _hash_strlen(p_cstr));
 }
 
 uint32_t String::hash(const char32_t *p_cstr, int p_len) {
-	uint32_t hashv = 5381;
-	for (int i = 0; i < p_len; i++) {
-		hashv = ((hashv << 5) + hashv) + p_cstr[i]; /* hash * 33 + c */
-	}
-
-	return hashv;
+	return hash_djb2_units<uint32_t>(p_cstr, p_len);
 }
 
 uint32_t String::hash(const char32_t *p_cstr) {
-	uint32_t hashv = 5381;
-	uint32_t c;
-
-	while ((c = *p_cstr++)) {
-		hashv = ((hashv << 5) + hashv) + c; /* hash * 33 + c */
-	}
-
-	return hashv;
+	return hash_djb2_units<uint32_t>(p_cstr, _hash_strlen(p_cstr));
 }
 
 uint32_t String::hash() const {
-	/* simple djb2 hashing */
-
-	const char32_t *chr = get_data();
-	uint32_t hashv = 5381;
-	uint32_t c;
-
-	while ((c = *chr++)) {
-		hashv = ((hashv << 5) + hashv) + c; /* hash * 33 + c */
-	}
-
-	return hashv;
+	/* simple djb2 hashing, the length is known so there is no need to look for the terminator */
+	return hash_djb2_units<uint32_t>(get_data(), length());
 }
 
 uint64_t String::hash64() const {
 	/* simple djb2 hashing */
-
-	const char32_t *chr = get_data();
-	uint64_t hashv = 5381;
-	uint64_t c;
-
-	while ((c = *chr++)) {
-		hashv = ((hashv << 5) + hashv) + c; /* hash * 33 + c */
-	}
-
-	return hashv;
+	return hash_djb2_units<uint64_t>(get_data(), length());
 }
 
 String String::md5_text() const {
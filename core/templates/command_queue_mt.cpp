@@ -33,6 +33,93 @@
 #include "core/config/project_settings.h"
 #include "core/os/os.h"
 
+thread_local uint32_t CommandQueueMT::producer_slot = UINT32_MAX;
+SafeNumeric<uint32_t> CommandQueueMT::producer_slot_counter;
+SafeNumeric<uint64_t> CommandQueueMT::total_wait_count;
+
+void CommandQueueMT::_grow_buffer(CommandBuffer &p_buffer, uint64_t p_min_capacity) {
+	uint64_t capacity = MAX(p_buffer.capacity, (uint64_t)MIN_COMMAND_MEM_SIZE_KB * 1024);
+	while (capacity < p_min_capacity) {
+		capacity <<= 1;
+	}
+	p_buffer.data = (uint8_t *)memrealloc(p_buffer.data, capacity);
+	CRASH_COND_MSG(!p_buffer.data, "Out of memory");
+	p_buffer.capacity = capacity;
+}
+
+void CommandQueueMT::_flush() {
+	MutexLock<Mutex> flush_lock(flush_mutex);
+	if (flushing) {
+		// Flushing again from a command being flushed, what it pushed is left for the next flush.
+		return;
+	}
+	flushing = true;
+
+	// Take all the slots at once, so the snapshot holds exactly the commands with a
+	// ticket lower than the current one and the order between slots is preserved.
+	for (uint32_t i = 0; i < PRODUCER_SLOTS; i++) {
+		slots[i].lock.lock();
+	}
+	for (uint32_t i = 0; i < PRODUCER_SLOTS; i++) {
+		CommandBuffer tmp = slots[i].buffer;
+		slots[i].buffer = flush_buffers[i];
+		flush_buffers[i] = tmp;
+	}
+	for (uint32_t i = 0; i < PRODUCER_SLOTS; i++) {
+		slots[i].lock.unlock();
+	}
+
+	uint32_t active[PRODUCER_SLOTS];
+	uint64_t read_ptr[PRODUCER_SLOTS];
+	uint32_t active_count = 0;
+	for (uint32_t i = 0; i < PRODUCER_SLOTS; i++) {
+		if (flush_buffers[i].size > 0) {
+			read_ptr[active_count] = 0;
+			active[active_count++] = i;
+		}
+	}
+
+	while (active_count > 0) {
+		// Pick the oldest command among the slots, usually there is only one.
+		uint32_t next = 0;
+		if (active_count > 1) {
+			uint64_t next_ticket = UINT64_MAX;
+			for (uint32_t i = 0; i < active_count; i++) {
+				uint64_t cmd_ticket = *(uint64_t *)&flush_buffers[active[i]].data[read_ptr[i] + 8];
+				if (cmd_ticket < next_ticket) {
+					next_ticket = cmd_ticket;
+					next = i;
+				}
+			}
+		}
+
+		CommandBuffer &buffer = flush_buffers[active[next]];
+		uint64_t size = *(uint64_t *)&buffer.data[read_ptr[next]];
+		CommandBase *cmd = reinterpret_cast<CommandBase *>(&buffer.data[read_ptr[next] + COMMAND_HEADER_SIZE]);
+
+		cmd->call(); //execute the function
+		cmd->post(); //release in case it needs sync/ret
+		cmd->~CommandBase(); //should be done, so erase the command
+		pending_commands.decrement();
+
+		read_ptr[next] += size + COMMAND_HEADER_SIZE;
+		if (read_ptr[next] >= buffer.size) {
+			buffer.size = 0;
+			active_count--;
+			active[next] = active[active_count];
+			read_ptr[next] = read_ptr[active_count];
+		}
+	}
+
+	flushing = false;
+}
+
+void CommandQueueMT::reset_stats() {
+	max_pending_commands.set(pending_commands.get());
+	stall_count.set(0);
+	sync_wait_count.set(0);
+}
+
 void CommandQueueMT::lock() {
 	mutex.lock();
 }
@@ -80,4 +167,12 @@ CommandQueueMT::~CommandQueueMT() {
 	if (sync) {
 		memdelete(sync);
 	}
+	for (uint32_t i = 0; i < PRODUCER_SLOTS; i++) {
+		if (slots[i].buffer.data) {
+			memfree(slots[i].buffer.data);
+		}
+		if (flush_buffers[i].data) {
+			memfree(flush_buffers[i].data);
+		}
+	}
 }
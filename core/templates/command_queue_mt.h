@@ -34,8 +34,9 @@
 #include "core/os/memory.h"
 #include "core/os/mutex.h"
 #include "core/os/semaphore.h"
+#include "core/os/spin_lock.h"
 #include "core/string/print_string.h"
-#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/simple_type.h"
 #include "core/typedefs.h"
 
@@ -250,11 +251,12 @@
 #define DECL_PUSH(N)                                                         \
 	template <class T, class M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>       \
 	void push(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
-		CMD_TYPE(N) *cmd = allocate_and_lock<CMD_TYPE(N)>();                 \
+		ProducerSlot *slot;                                                  \
+		CMD_TYPE(N) *cmd = allocate_and_lock<CMD_TYPE(N)>(slot);             \
 		cmd->instance = p_instance;                                          \
 		cmd->method = p_method;                                              \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                 \
-		unlock();                                                            \
+		unlock_slot(slot);                                                   \
 		if (sync)                                                            \
 			sync->post();                                                    \
 	}
@@ -265,15 +267,18 @@
 	template <class T, class M, COMMA_SEP_LIST(TYPE_PARAM, N) COMMA(N) class R>                \
 	void push_and_ret(T *p_instance, M p_method, COMMA_SEP_LIST(PARAM, N) COMMA(N) R *r_ret) { \
 		SyncSemaphore *ss = _alloc_sync_sem();                                                 \
-		CMD_RET_TYPE(N) *cmd = allocate_and_lock<CMD_RET_TYPE(N)>();                           \
+		ProducerSlot *slot;                                                                    \
+		CMD_RET_TYPE(N) *cmd = allocate_and_lock<CMD_RET_TYPE(N)>(slot);                       \
 		cmd->instance = p_instance;                                                            \
 		cmd->method = p_method;                                                                \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                                   \
 		cmd->ret = r_ret;                                                                      \
 		cmd->sync_sem = ss;                                                                    \
-		unlock();                                                                              \
+		unlock_slot(slot);                                                                     \
 		if (sync)                                                                              \
 			sync->post();                                                                      \
+		sync_wait_count.increment();                                                           \
+		total_wait_count.increment();                                                          \
 		ss->sem.wait();                                                                        \
 		ss->in_use = false;                                                                    \
 	}
@@ -284,14 +289,17 @@
 	template <class T, class M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>                \
 	void push_and_sync(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
 		SyncSemaphore *ss = _alloc_sync_sem();                                        \
-		CMD_SYNC_TYPE(N) *cmd = allocate_and_lock<CMD_SYNC_TYPE(N)>();                \
+		ProducerSlot *slot;                                                           \
+		CMD_SYNC_TYPE(N) *cmd = allocate_and_lock<CMD_SYNC_TYPE(N)>(slot);            \
 		cmd->instance = p_instance;                                                   \
 		cmd->method = p_method;                                                       \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                          \
 		cmd->sync_sem = ss;                                                           \
-		unlock();                                                                     \
+		unlock_slot(slot);                                                            \
 		if (sync)                                                                     \
 			sync->post();                                                             \
+		sync_wait_count.increment();                                                  \
+		total_wait_count.increment();                                                 \
 		ss->sem.wait();                                                               \
 		ss->in_use = false;                                                           \
 	}
@@ -332,55 +340,90 @@ class CommandQueueMT {
 	/***** BASE *******/
 
 	enum {
-		DEFAULT_COMMAND_MEM_SIZE_KB = 256,
-		SYNC_SEMAPHORES = 8
+		MIN_COMMAND_MEM_SIZE_KB = 4,
+		SYNC_SEMAPHORES = 8,
+		PRODUCER_SLOTS = 8,
+		COMMAND_HEADER_SIZE = 16, // Command size and ticket.
 	};
 
-	LocalVector<uint8_t> command_mem;
+	struct CommandBuffer {
+		uint8_t *data = nullptr;
+		uint64_t size = 0;
+		uint64_t capacity = 0;
+	};
+
+	// Producers write to the slot assigned to their thread (round robin, so the
+	// first threads to push never share one). A slot is only ever contended by
+	// threads sharing it and by the consumer swapping its buffer out, so pushing
+	// never waits on other producers or on commands being executed.
+	struct ProducerSlot {
+		SpinLock lock;
+		CommandBuffer buffer;
+	};
+
+	ProducerSlot slots[PRODUCER_SLOTS];
+	CommandBuffer flush_buffers[PRODUCER_SLOTS]; // Only touched by the flushing thread.
+	bool flushing = false;
+
+	// Commands are tagged with a ticket, so the flush can replay them in the order
+	// they were pushed even across slots.
+	SafeNumeric<uint64_t> ticket;
+
+	SafeNumeric<uint32_t> pending_commands;
+	SafeNumeric<uint32_t> max_pending_commands;
+	SafeNumeric<uint64_t> stall_count;
+	SafeNumeric<uint64_t> sync_wait_count;
+	static SafeNumeric<uint64_t> total_wait_count;
+
 	SyncSemaphore sync_sems[SYNC_SEMAPHORES];
 	Mutex mutex;
+	Mutex flush_mutex;
 	Semaphore *sync = nullptr;
 
-	template <class T>
-	T *allocate() {
-		// alloc size is size+T+safeguard
-		uint32_t alloc_size = ((sizeof(T) + 8 - 1) & ~(8 - 1));
-		uint64_t size = command_mem.size();
-		command_mem.resize(size + alloc_size + 8);
-		*(uint64_t *)&command_mem[size] = alloc_size;
-		T *cmd = memnew_placement(&command_mem[size + 8], T);
-		return cmd;
-	}
+	static thread_local uint32_t producer_slot;
+	static SafeNumeric<uint32_t> producer_slot_counter;
 
-	template <class T>
-	T *allocate_and_lock() {
-		lock();
-		T *ret = allocate<T>();
-		return ret;
+	_FORCE_INLINE_ ProducerSlot *_get_producer_slot() {
+		if (unlikely(producer_slot == UINT32_MAX)) {
+			producer_slot = producer_slot_counter.postincrement() % PRODUCER_SLOTS;
+		}
+		return &slots[producer_slot];
 	}
 
-	void _flush() {
-		lock();
-
-		uint64_t read_ptr = 0;
-		uint64_t limit = command_mem.size();
+	void _grow_buffer(CommandBuffer &p_buffer, uint64_t p_min_capacity);
 
-		while (read_ptr < limit) {
-			uint64_t size = *(uint64_t *)&command_mem[read_ptr];
-			read_ptr += 8;
-			CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[read_ptr]);
-
-			cmd->call(); //execute the function
-			cmd->post(); //release in case it needs sync/ret
-			cmd->~CommandBase(); //should be done, so erase the command
+	template <class T>
+	T *allocate_and_lock(ProducerSlot *&r_slot) {
+		r_slot = _get_producer_slot();
+		if (unlikely(!r_slot->lock.try_lock())) {
+			// Someone else (most likely the consumer swapping buffers) has it.
+			stall_count.increment();
+			total_wait_count.increment();
+			r_slot->lock.lock();
+		}
 
-			read_ptr += size;
+		// alloc size is size+T+safeguard
+		uint32_t alloc_size = ((sizeof(T) + 8 - 1) & ~(8 - 1));
+		CommandBuffer &buffer = r_slot->buffer;
+		uint64_t size = buffer.size;
+		if (unlikely(size + alloc_size + COMMAND_HEADER_SIZE > buffer.capacity)) {
+			_grow_buffer(buffer, size + alloc_size + COMMAND_HEADER_SIZE);
 		}
+		buffer.size += alloc_size + COMMAND_HEADER_SIZE;
+		*(uint64_t *)&buffer.data[size] = alloc_size;
+		*(uint64_t *)&buffer.data[size + 8] = ticket.postincrement();
+		T *cmd = memnew_placement(&buffer.data[size + COMMAND_HEADER_SIZE], T);
+		return cmd;
+	}
 
-		command_mem.clear();
-		unlock();
+	_FORCE_INLINE_ void unlock_slot(ProducerSlot *p_slot) {
+		// Counted before unlocking, so the consumer never sees the command before it's counted.
+		max_pending_commands.exchange_if_greater(pending_commands.increment());
+		p_slot->lock.unlock();
 	}
 
+	void _flush();
+
 	void lock();
 	void unlock();
 	void wait_for_flush();
@@ -400,7 +443,7 @@ public:
 	SPACE_SEP_LIST(DECL_PUSH_AND_SYNC, 15)
 
 	_FORCE_INLINE_ void flush_if_pending() {
-		if (unlikely(command_mem.size() > 0)) {
+		if (unlikely(pending_commands.get() > 0)) {
 			_flush();
 		}
 	}
@@ -414,6 +457,19 @@ public:
 		_flush();
 	}
 
+	// Counters to find out if the consumer is falling behind.
+	// Commands pushed but not executed yet.
+	uint32_t get_pending_command_count() const { return pending_commands.get(); }
+	// Highest amount of pending commands since the last reset.
+	uint32_t get_max_pending_command_count() const { return max_pending_commands.get(); }
+	// Times a producer had to wait for its slot.
+	uint64_t get_stall_count() const { return stall_count.get(); }
+	// Times a producer had to wait for the consumer to run a synchronous command.
+	uint64_t get_sync_wait_count() const { return sync_wait_count.get(); }
+	// Stalls and synchronous waits of all the queues, never reset.
+	static uint64_t get_total_wait_count() { return total_wait_count.get(); }
+	void reset_stats();
+
 	CommandQueueMT(bool p_sync);
 	~CommandQueueMT();
 };
@@ -36,6 +36,7 @@
 #include "core/templates/safe_refcount.h"
 
 #include <string.h>
+#include <utility>
 
 template <class T>
 class Vector;
@@ -125,12 +126,29 @@ private:
 
 public:
 	void operator=(const CowData<T> &p_from) { _ref(p_from); }
+	void operator=(CowData<T> &&p_from) {
+		if (_ptr == p_from._ptr) {
+			return;
+		}
+
+		_unref(_ptr);
+		_ptr = p_from._ptr;
+		p_from._ptr = nullptr;
+	}
 
 	_FORCE_INLINE_ T *ptrw() {
 		_copy_on_write();
 		return (T *)_get_data();
 	}
 
+	// For data the caller knows isn't shared, skips the copy on write check (debug builds verify it).
+	_FORCE_INLINE_ T *ptrw_unique() {
+#ifdef DEBUG_ENABLED
+		CRASH_COND_MSG(_ptr && _get_refcount()->get() > 1, "Writing to shared data without copying it first.");
+#endif
+		return (T *)_get_data();
+	}
+
 	_FORCE_INLINE_ const T *ptr() const {
 		return _get_data();
 	}
@@ -194,6 +212,10 @@ public:
 	_FORCE_INLINE_ CowData() {}
 	_FORCE_INLINE_ ~CowData();
 	_FORCE_INLINE_ CowData(CowData<T> &p_from) { _ref(p_from); };
+	_FORCE_INLINE_ CowData(CowData<T> &&p_from) {
+		_ptr = p_from._ptr;
+		p_from._ptr = nullptr;
+	}
 };
 
 template <class T>
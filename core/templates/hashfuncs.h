@@ -43,31 +43,42 @@
  * Hashing functions
  */
 
+/**
+ * DJB2 over a buffer of known length, four units per step.
+ *
+ * h * 33^4 + c0 * 33^3 + c1 * 33^2 + c2 * 33 + c3 is exactly what four steps of
+ * the classic loop compute, but the units are combined independently of the
+ * running hash, so the dependency chain is one multiply-add per four units
+ * instead of one shift-add per unit. H and the unit conversion (p_data[i] to H)
+ * are up to the caller, results match the one unit per step loop bit for bit.
+ */
+template <class H, class T>
+static _FORCE_INLINE_ H hash_djb2_units(const T *p_data, int p_len, H p_prev = 5381) {
+	H hash = p_prev;
+	int i = 0;
+
+	for (; i + 4 <= p_len; i += 4) {
+		H block = H(p_data[i]) * H(35937) + H(p_data[i + 1]) * H(1089) + H(p_data[i + 2]) * H(33) + H(p_data[i + 3]);
+		hash = hash * H(1185921) + block;
+	}
+	for (; i < p_len; i++) {
+		hash = ((hash << 5) + hash) + H(p_data[i]); /* hash * 33 + c */
+	}
+
+	return hash;
+}
+
 /**
  * DJB2 Hash function
  * @param C String
  * @return 32-bits hashcode
  */
 static inline uint32_t hash_djb2(const char *p_cstr) {
-	const unsigned char *chr = (const unsigned char *)p_cstr;
-	uint32_t hash = 5381;
-	uint32_t c;
-
-	while ((c = *chr++)) {
-		hash = ((hash << 5) + hash) + c; /* hash * 33 + c */
-	}
-
-	return hash;
+	return hash_djb2_units<uint32_t>((const unsigned char *)p_cstr, strlen(p_cstr));
 }
 
 static inline uint32_t hash_djb2_buffer(const uint8_t *p_buff, int p_len, uint32_t p_prev = 5381) {
-	uint32_t hash = p_prev;
-
-	for (int i = 0; i < p_len; i++) {
-		hash = ((hash << 5) + hash) + p_buff[i]; /* hash * 33 + c */
-	}
-
-	return hash;
+	return hash_djb2_units<uint32_t>(p_buff, p_len, p_prev);
 }
 
 static inline uint32_t hash_djb2_one_32(uint32_t p_in, uint32_t p_prev = 5381) {
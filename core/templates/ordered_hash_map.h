@@ -31,6 +31,7 @@
 #ifndef ORDERED_HASH_MAP_H
 #define ORDERED_HASH_MAP_H
 
+#include "core/os/memory.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/list.h"
 #include "core/templates/pair.h"
@@ -42,18 +43,150 @@
  * former is more frequently used and is more coherent with the rest of the
  * codebase.
  * Deletion during iteration is safe and will preserve the order.
+ *
+ * Elements live in a list, so their addresses are stable. They are indexed by
+ * an open addressing table (Robin Hood hashing, linear probing and backward
+ * shift deletion, as in OAHashMap) holding only the hash and the element, so
+ * lookups don't chase chains of nodes and inserting only allocates the element.
  */
-template <class K, class V, class Hasher = HashMapHasherDefault, class Comparator = HashMapComparatorDefault<K>, uint8_t MIN_HASH_TABLE_POWER = 3, uint8_t RELATIONSHIP = 8>
+template <class K, class V, class Hasher = HashMapHasherDefault, class Comparator = HashMapComparatorDefault<K>, uint8_t MIN_HASH_TABLE_POWER = 3>
 class OrderedHashMap {
-	typedef List<Pair<const K *, V>> InternalList;
-	typedef HashMap<K, typename InternalList::Element *, Hasher, Comparator, MIN_HASH_TABLE_POWER, RELATIONSHIP> InternalMap;
+	typedef List<Pair<K, V>> InternalList;
+
+	static const uint32_t EMPTY_HASH = 0;
 
 	InternalList list;
-	InternalMap map;
+
+	uint32_t *hashes = nullptr;
+	typename InternalList::Element **elements = nullptr;
+	uint32_t capacity = 0; // Always a power of two.
+
+	_FORCE_INLINE_ uint32_t _hash(const K &p_key) const {
+		uint32_t hash = Hasher::hash(p_key);
+
+		if (hash == EMPTY_HASH) {
+			hash = EMPTY_HASH + 1;
+		}
+
+		return hash;
+	}
+
+	_FORCE_INLINE_ uint32_t _get_probe_length(uint32_t p_pos, uint32_t p_hash) const {
+		return (p_pos - p_hash) & (capacity - 1);
+	}
+
+	bool _lookup_pos(const K &p_key, uint32_t &r_pos) const {
+		if (capacity == 0) {
+			return false;
+		}
+
+		uint32_t hash = _hash(p_key);
+		uint32_t pos = hash & (capacity - 1);
+		uint32_t distance = 0;
+
+		while (true) {
+			if (hashes[pos] == EMPTY_HASH) {
+				return false;
+			}
+
+			if (distance > _get_probe_length(pos, hashes[pos])) {
+				return false;
+			}
+
+			if (hashes[pos] == hash && Comparator::compare(elements[pos]->get().first, p_key)) {
+				r_pos = pos;
+				return true;
+			}
+
+			pos = (pos + 1) & (capacity - 1);
+			distance++;
+		}
+	}
+
+	void _insert_with_hash(uint32_t p_hash, typename InternalList::Element *p_element) {
+		uint32_t hash = p_hash;
+		typename InternalList::Element *element = p_element;
+		uint32_t distance = 0;
+		uint32_t pos = hash & (capacity - 1);
+
+		while (true) {
+			if (hashes[pos] == EMPTY_HASH) {
+				hashes[pos] = hash;
+				elements[pos] = element;
+				return;
+			}
+
+			// Not an empty slot, let's check the probing length of the existing one.
+			uint32_t existing_probe_len = _get_probe_length(pos, hashes[pos]);
+			if (existing_probe_len < distance) {
+				SWAP(hash, hashes[pos]);
+				SWAP(element, elements[pos]);
+				distance = existing_probe_len;
+			}
+
+			pos = (pos + 1) & (capacity - 1);
+			distance++;
+		}
+	}
+
+	void _erase_pos(uint32_t p_pos) {
+		uint32_t pos = p_pos;
+		uint32_t next_pos = (pos + 1) & (capacity - 1);
+
+		while (hashes[next_pos] != EMPTY_HASH && _get_probe_length(next_pos, hashes[next_pos]) != 0) {
+			hashes[pos] = hashes[next_pos];
+			elements[pos] = elements[next_pos];
+			pos = next_pos;
+			next_pos = (next_pos + 1) & (capacity - 1);
+		}
+
+		hashes[pos] = EMPTY_HASH;
+		elements[pos] = nullptr;
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+		uint32_t old_capacity = capacity;
+		uint32_t *old_hashes = hashes;
+		typename InternalList::Element **old_elements = elements;
+
+		capacity = p_new_capacity;
+		hashes = static_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
+		elements = static_cast<typename InternalList::Element **>(Memory::alloc_static(sizeof(typename InternalList::Element *) * capacity));
+
+		for (uint32_t i = 0; i < capacity; i++) {
+			hashes[i] = EMPTY_HASH;
+			elements[i] = nullptr;
+		}
+
+		if (old_capacity == 0) {
+			return;
+		}
+
+		for (uint32_t i = 0; i < old_capacity; i++) {
+			if (old_hashes[i] != EMPTY_HASH) {
+				_insert_with_hash(old_hashes[i], old_elements[i]);
+			}
+		}
+
+		Memory::free_static(old_hashes);
+		Memory::free_static(old_elements);
+	}
+
+	void _free_index() {
+		if (capacity == 0) {
+			return;
+		}
+
+		Memory::free_static(hashes);
+		Memory::free_static(elements);
+		hashes = nullptr;
+		elements = nullptr;
+		capacity = 0;
+	}
 
 public:
 	class Element {
-		friend class OrderedHashMap<K, V, Hasher, Comparator, MIN_HASH_TABLE_POWER, RELATIONSHIP>;
+		friend class OrderedHashMap<K, V, Hasher, Comparator, MIN_HASH_TABLE_POWER>;
 
 		typename InternalList::Element *list_element = nullptr;
 		typename InternalList::Element *prev_element = nullptr;
@@ -105,7 +238,7 @@ public:
 
 		const K &key() const {
 			CRASH_COND(!list_element);
-			return *(list_element->get().first);
+			return list_element->get().first;
 		}
 
 		V &value() {
@@ -130,7 +263,7 @@ public:
 	};
 
 	class ConstElement {
-		friend class OrderedHashMap<K, V, Hasher, Comparator, MIN_HASH_TABLE_POWER, RELATIONSHIP>;
+		friend class OrderedHashMap<K, V, Hasher, Comparator, MIN_HASH_TABLE_POWER>;
 
 		const typename InternalList::Element *list_element = nullptr;
 
@@ -171,7 +304,7 @@ public:
 
 		const K &key() const {
 			CRASH_COND(!list_element);
-			return *(list_element->get().first);
+			return list_element->get().first;
 		}
 
 		const V &value() const {
@@ -186,52 +319,62 @@ public:
 	};
 
 	ConstElement find(const K &p_key) const {
-		typename InternalList::Element *const *list_element = map.getptr(p_key);
-		if (list_element) {
-			return ConstElement(*list_element);
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			return ConstElement(elements[pos]);
 		}
 		return ConstElement(nullptr);
 	}
 
 	Element find(const K &p_key) {
-		typename InternalList::Element **list_element = map.getptr(p_key);
-		if (list_element) {
-			return Element(*list_element);
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			return Element(elements[pos]);
 		}
 		return Element(nullptr);
 	}
 
 	Element insert(const K &p_key, const V &p_value) {
-		typename InternalList::Element **list_element = map.getptr(p_key);
-		if (list_element) {
-			(*list_element)->get().second = p_value;
-			return Element(*list_element);
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			elements[pos]->get().second = p_value;
+			return Element(elements[pos]);
 		}
-		typename InternalList::Element *new_element = list.push_back(Pair<const K *, V>(nullptr, p_value));
-		typename InternalMap::Element *e = map.set(p_key, new_element);
-		new_element->get().first = &e->key();
+
+		// Keep the load factor under 3/4.
+		if (capacity == 0 || (uint32_t)list.size() + 1 > capacity - (capacity >> 2)) {
+			_resize_and_rehash(MAX(capacity << 1, 1u << MIN_HASH_TABLE_POWER));
+		}
+
+		typename InternalList::Element *new_element = list.push_back(Pair<K, V>(p_key, p_value));
+		_insert_with_hash(_hash(p_key), new_element);
 
 		return Element(new_element);
 	}
 
 	void erase(Element &p_element) {
-		map.erase(p_element.key());
+		uint32_t pos = 0;
+		if (_lookup_pos(p_element.key(), pos)) {
+			_erase_pos(pos);
+		}
 		list.erase(p_element.list_element);
 		p_element.list_element = nullptr;
 	}
 
 	bool erase(const K &p_key) {
-		typename InternalList::Element **list_element = map.getptr(p_key);
-		if (list_element) {
-			list.erase(*list_element);
-			map.erase(p_key);
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			typename InternalList::Element *list_element = elements[pos];
+			_erase_pos(pos);
+			list.erase(list_element);
 			return true;
 		}
 		return false;
 	}
 
 	inline bool has(const K &p_key) const {
-		return map.has(p_key);
+		uint32_t pos = 0;
+		return _lookup_pos(p_key, pos);
 	}
 
 	const V &operator[](const K &p_key) const {
@@ -273,7 +416,7 @@ public:
 	}
 
 	void clear() {
-		map.clear();
+		_free_index();
 		list.clear();
 	}
 
@@ -294,6 +437,10 @@ public:
 	}
 
 	_FORCE_INLINE_ OrderedHashMap() {}
+
+	~OrderedHashMap() {
+		_free_index();
+	}
 };
 
 #endif // ORDERED_HASH_MAP_H
@@ -0,0 +1,511 @@
+/*************************************************************************/
+/*  parallel_algorithms.h                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef PARALLEL_ALGORITHMS_H
+#define PARALLEL_ALGORITHMS_H
+
+#include "core/os/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/sort_array.h"
+
+// Parallel versions of common array algorithms, running on the WorkerThreadPool. The input is split in
+// at most one chunk per worker thread (plus the calling one, which helps while waiting), inputs too
+// small to be worth it run serially on the calling thread.
+
+#define PARALLEL_MIN_CHUNK_SIZE 2048
+
+template <class F>
+void _parallel_chunk_callback(void *p_userdata, uint32_t p_chunk) {
+	(*(F *)p_userdata)(p_chunk);
+}
+
+// Calls p_func(chunk) for every chunk in [0, p_chunks) on the worker threads and waits for all of them.
+template <class F>
+void parallel_for_chunks(uint32_t p_chunks, F &p_func) {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (p_chunks <= 1 || !pool || pool->get_thread_count() == 0) {
+		for (uint32_t i = 0; i < p_chunks; i++) {
+			p_func(i);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group = pool->add_native_group_task(&_parallel_chunk_callback<F>, &p_func, p_chunks);
+	pool->wait_for_group_task_completion(group);
+}
+
+// How many chunks p_size elements are split in, 1 when not worth going parallel.
+inline uint32_t parallel_get_chunk_count(uint32_t p_size) {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	uint32_t threads = pool ? pool->get_thread_count() + 1 : 1;
+	return CLAMP(p_size / PARALLEL_MIN_CHUNK_SIZE, 1u, threads);
+}
+
+inline uint32_t parallel_get_chunk_begin(uint32_t p_chunk, uint32_t p_chunks, uint32_t p_size) {
+	return uint32_t(uint64_t(p_size) * p_chunk / p_chunks);
+}
+
+template <class T>
+struct _ParallelCopyChunk {
+	const T *src;
+	T *dst;
+	uint32_t size;
+	uint32_t chunks;
+
+	void operator()(uint32_t p_chunk) {
+		uint32_t to = parallel_get_chunk_begin(p_chunk + 1, chunks, size);
+		for (uint32_t i = parallel_get_chunk_begin(p_chunk, chunks, size); i < to; i++) {
+			dst[i] = src[i];
+		}
+	}
+};
+
+/* SORT */
+
+// Sorts every chunk with SortArray, then merges pairs of sorted runs in parallel until one is left.
+// Like SortArray, it is not stable.
+template <class T, class Comparator = _DefaultComparator<T>, bool Validate = SORT_ARRAY_VALIDATE_ENABLED>
+class ParallelSortArray {
+	struct SortChunk {
+		const Comparator *compare;
+		T *array;
+		uint32_t size;
+		uint32_t chunks;
+
+		void operator()(uint32_t p_chunk) {
+			uint32_t from = parallel_get_chunk_begin(p_chunk, chunks, size);
+			uint32_t to = parallel_get_chunk_begin(p_chunk + 1, chunks, size);
+			SortArray<T, Comparator, Validate> sorter;
+			sorter.compare = *compare;
+			sorter.sort(array + from, to - from);
+		}
+	};
+
+	struct MergeRuns {
+		const Comparator *compare;
+		const T *src;
+		T *dst;
+		const uint32_t *bounds;
+		uint32_t runs;
+
+		void operator()(uint32_t p_pair) {
+			uint32_t from = bounds[p_pair * 2];
+			uint32_t middle = bounds[MIN(p_pair * 2 + 1, runs)];
+			uint32_t to = bounds[MIN(p_pair * 2 + 2, runs)];
+
+			uint32_t a = from;
+			uint32_t b = middle;
+			uint32_t w = from;
+			while (a < middle && b < to) {
+				if ((*compare)(src[b], src[a])) {
+					dst[w++] = src[b++];
+				} else {
+					dst[w++] = src[a++];
+				}
+			}
+			while (a < middle) {
+				dst[w++] = src[a++];
+			}
+			while (b < to) {
+				dst[w++] = src[b++];
+			}
+		}
+	};
+
+public:
+	Comparator compare;
+
+	void sort(T *p_array, uint32_t p_size) {
+		uint32_t chunks = parallel_get_chunk_count(p_size);
+		if (chunks == 1) {
+			SortArray<T, Comparator, Validate> sorter;
+			sorter.compare = compare;
+			sorter.sort(p_array, p_size);
+			return;
+		}
+
+		SortChunk sort_chunk = { &compare, p_array, p_size, chunks };
+		parallel_for_chunks(chunks, sort_chunk);
+
+		LocalVector<uint32_t> bounds;
+		bounds.resize(chunks + 1);
+		for (uint32_t i = 0; i <= chunks; i++) {
+			bounds[i] = parallel_get_chunk_begin(i, chunks, p_size);
+		}
+
+		LocalVector<T> temp;
+		temp.resize(p_size);
+		T *src = p_array;
+		T *dst = temp.ptr();
+
+		uint32_t runs = chunks;
+		while (runs > 1) {
+			uint32_t pairs = (runs + 1) / 2;
+			MergeRuns merge = { &compare, src, dst, bounds.ptr(), runs };
+			parallel_for_chunks(pairs, merge);
+
+			for (uint32_t i = 0; i < pairs; i++) {
+				bounds[i] = bounds[i * 2];
+			}
+			bounds[pairs] = p_size;
+
+			runs = pairs;
+			SWAP(src, dst);
+		}
+
+		if (src != p_array) {
+			_ParallelCopyChunk<T> copy_chunk = { src, p_array, p_size, chunks };
+			parallel_for_chunks(chunks, copy_chunk);
+		}
+	}
+};
+
+// Stable LSD radix sort by an unsigned 64 bits key, 8 bits per pass. KeyGetter returns the key of an
+// element. Passes where all the keys have the same digit are skipped, so keys using few bits are cheaper.
+template <class T, class KeyGetter>
+class ParallelRadixSort {
+	enum {
+		RADIX_BITS = 8,
+		RADIX_SIZE = 1 << RADIX_BITS,
+		RADIX_PASSES = 64 / RADIX_BITS,
+	};
+
+	struct CountAllDigits {
+		const KeyGetter *get_key;
+		const T *array;
+		uint32_t *counts; // RADIX_PASSES * RADIX_SIZE per chunk.
+		uint32_t size;
+		uint32_t chunks;
+
+		void operator()(uint32_t p_chunk) {
+			uint32_t *chunk_counts = counts + p_chunk * RADIX_PASSES * RADIX_SIZE;
+			uint32_t to = parallel_get_chunk_begin(p_chunk + 1, chunks, size);
+			for (uint32_t i = parallel_get_chunk_begin(p_chunk, chunks, size); i < to; i++) {
+				uint64_t key = (*get_key)(array[i]);
+				for (uint32_t j = 0; j < RADIX_PASSES; j++) {
+					chunk_counts[j * RADIX_SIZE + ((key >> (j * RADIX_BITS)) & (RADIX_SIZE - 1))]++;
+				}
+			}
+		}
+	};
+
+	struct CountDigits {
+		const KeyGetter *get_key;
+		const T *array;
+		uint32_t *counts; // RADIX_SIZE per chunk.
+		uint32_t size;
+		uint32_t chunks;
+		uint32_t shift;
+
+		void operator()(uint32_t p_chunk) {
+			uint32_t *chunk_counts = counts + p_chunk * RADIX_SIZE;
+			uint32_t to = parallel_get_chunk_begin(p_chunk + 1, chunks, size);
+			for (uint32_t i = parallel_get_chunk_begin(p_chunk, chunks, size); i < to; i++) {
+				chunk_counts[((*get_key)(array[i]) >> shift) & (RADIX_SIZE - 1)]++;
+			}
+		}
+	};
+
+	struct Scatter {
+		const KeyGetter *get_key;
+		const T *src;
+		T *dst;
+		uint32_t *offsets; // RADIX_SIZE per chunk.
+		uint32_t size;
+		uint32_t chunks;
+		uint32_t shift;
+
+		void operator()(uint32_t p_chunk) {
+			uint32_t *chunk_offsets = offsets + p_chunk * RADIX_SIZE;
+			uint32_t to = parallel_get_chunk_begin(p_chunk + 1, chunks, size);
+			for (uint32_t i = parallel_get_chunk_begin(p_chunk, chunks, size); i < to; i++) {
+				dst[chunk_offsets[((*get_key)(src[i]) >> shift) & (RADIX_SIZE - 1)]++] = src[i];
+			}
+		}
+	};
+
+public:
+	KeyGetter get_key;
+
+	void sort(T *p_array, uint32_t p_size) {
+		if (p_size < 2) {
+			return;
+		}
+
+		uint32_t chunks = parallel_get_chunk_count(p_size);
+
+		// The amount of each digit does not change between passes, count them all at once to find the
+		// passes that can be skipped.
+		LocalVector<uint32_t> counts;
+		counts.resize(chunks * RADIX_PASSES * RADIX_SIZE);
+		memset(counts.ptr(), 0, counts.size() * sizeof(uint32_t));
+		CountAllDigits count_all = { &get_key, p_array, counts.ptr(), p_size, chunks };
+		parallel_for_chunks(chunks, count_all);
+
+		bool skip_pass[RADIX_PASSES];
+		for (uint32_t j = 0; j < RADIX_PASSES; j++) {
+			skip_pass[j] = false;
+			for (uint32_t d = 0; d < RADIX_SIZE; d++) {
+				uint32_t total = 0;
+				for (uint32_t c = 0; c < chunks; c++) {
+					total += counts[(c * RADIX_PASSES + j) * RADIX_SIZE + d];
+				}
+				if (total == p_size) {
+					skip_pass[j] = true;
+					break;
+				}
+			}
+		}
+
+		LocalVector<T> temp;
+		LocalVector<uint32_t> offsets;
+		offsets.resize(chunks * RADIX_SIZE);
+		T *src = p_array;
+		T *dst = nullptr;
+
+		for (uint32_t j = 0; j < RADIX_PASSES; j++) {
+			if (skip_pass[j]) {
+				continue;
+			}
+			if (temp.is_empty()) {
+				temp.resize(p_size);
+				dst = temp.ptr();
+			}
+
+			uint32_t shift = j * RADIX_BITS;
+			memset(offsets.ptr(), 0, offsets.size() * sizeof(uint32_t));
+			CountDigits count = { &get_key, src, offsets.ptr(), p_size, chunks, shift };
+			parallel_for_chunks(chunks, count);
+
+			// Digit major, so elements keep their order within each digit.
+			uint32_t offset = 0;
+			for (uint32_t d = 0; d < RADIX_SIZE; d++) {
+				for (uint32_t c = 0; c < chunks; c++) {
+					uint32_t amount = offsets[c * RADIX_SIZE + d];
+					offsets[c * RADIX_SIZE + d] = offset;
+					offset += amount;
+				}
+			}
+
+			Scatter scatter = { &get_key, src, dst, offsets.ptr(), p_size, chunks, shift };
+			parallel_for_chunks(chunks, scatter);
+
+			SWAP(src, dst);
+		}
+
+		if (src != p_array) {
+			_ParallelCopyChunk<T> copy_chunk = { src, p_array, p_size, chunks };
+			parallel_for_chunks(chunks, copy_chunk);
+		}
+	}
+};
+
+/* SCAN, REDUCE AND PARTITION */
+
+template <class T>
+struct _ParallelSumChunk {
+	const T *src;
+	T *sums;
+	uint32_t size;
+	uint32_t chunks;
+
+	void operator()(uint32_t p_chunk) {
+		uint32_t to = parallel_get_chunk_begin(p_chunk + 1, chunks, size);
+		T sum = T();
+		for (uint32_t i = parallel_get_chunk_begin(p_chunk, chunks, size); i < to; i++) {
+			sum += src[i];
+		}
+		sums[p_chunk] = sum;
+	}
+};
+
+template <class T>
+struct _ParallelScanChunk {
+	const T *src;
+	T *dst;
+	const T *offsets;
+	uint32_t size;
+	uint32_t chunks;
+
+	void operator()(uint32_t p_chunk) {
+		uint32_t to = parallel_get_chunk_begin(p_chunk + 1, chunks, size);
+		T sum = offsets[p_chunk];
+		for (uint32_t i = parallel_get_chunk_begin(p_chunk, chunks, size); i < to; i++) {
+			T value = src[i];
+			dst[i] = sum;
+			sum += value;
+		}
+	}
+};
+
+// Exclusive prefix sum of p_src into p_dst (which can be the same array), returns the total.
+template <class T>
+T parallel_prefix_sum(const T *p_src, T *p_dst, uint32_t p_size) {
+	uint32_t chunks = parallel_get_chunk_count(p_size);
+
+	LocalVector<T> offsets;
+	offsets.resize(chunks);
+	_ParallelSumChunk<T> sum_chunk = { p_src, offsets.ptr(), p_size, chunks };
+	parallel_for_chunks(chunks, sum_chunk);
+
+	T total = T();
+	for (uint32_t i = 0; i < chunks; i++) {
+		T sum = offsets[i];
+		offsets[i] = total;
+		total += sum;
+	}
+
+	_ParallelScanChunk<T> scan_chunk = { p_src, p_dst, offsets.ptr(), p_size, chunks };
+	parallel_for_chunks(chunks, scan_chunk);
+
+	return total;
+}
+
+template <class T, class R>
+struct _ParallelReduceChunk {
+	const T *array;
+	T *results;
+	const T *identity;
+	const R *reduce;
+	uint32_t size;
+	uint32_t chunks;
+
+	void operator()(uint32_t p_chunk) {
+		uint32_t to = parallel_get_chunk_begin(p_chunk + 1, chunks, size);
+		T result = *identity;
+		for (uint32_t i = parallel_get_chunk_begin(p_chunk, chunks, size); i < to; i++) {
+			result = (*reduce)(result, array[i]);
+		}
+		results[p_chunk] = result;
+	}
+};
+
+// Combines all the elements with p_reduce(a, b), which must be associative, starting from p_identity.
+template <class T, class R>
+T parallel_reduce(const T *p_array, uint32_t p_size, const T &p_identity, const R &p_reduce) {
+	uint32_t chunks = parallel_get_chunk_count(p_size);
+
+	LocalVector<T> results;
+	results.resize(chunks);
+	_ParallelReduceChunk<T, R> reduce_chunk = { p_array, results.ptr(), &p_identity, &p_reduce, p_size, chunks };
+	parallel_for_chunks(chunks, reduce_chunk);
+
+	T result = p_identity;
+	for (uint32_t i = 0; i < chunks; i++) {
+		result = p_reduce(result, results[i]);
+	}
+	return result;
+}
+
+template <class T, class P>
+struct _ParallelCountChunk {
+	const T *array;
+	uint32_t *counts;
+	const P *predicate;
+	uint32_t size;
+	uint32_t chunks;
+
+	void operator()(uint32_t p_chunk) {
+		uint32_t to = parallel_get_chunk_begin(p_chunk + 1, chunks, size);
+		uint32_t count = 0;
+		for (uint32_t i = parallel_get_chunk_begin(p_chunk, chunks, size); i < to; i++) {
+			if ((*predicate)(array[i])) {
+				count++;
+			}
+		}
+		counts[p_chunk] = count;
+	}
+};
+
+template <class T, class P>
+struct _ParallelPartitionChunk {
+	const T *src;
+	T *dst;
+	const uint32_t *true_offsets;
+	const uint32_t *false_offsets;
+	const P *predicate;
+	uint32_t size;
+	uint32_t chunks;
+
+	void operator()(uint32_t p_chunk) {
+		uint32_t to = parallel_get_chunk_begin(p_chunk + 1, chunks, size);
+		uint32_t true_offset = true_offsets[p_chunk];
+		uint32_t false_offset = false_offsets[p_chunk];
+		for (uint32_t i = parallel_get_chunk_begin(p_chunk, chunks, size); i < to; i++) {
+			if ((*predicate)(src[i])) {
+				dst[true_offset++] = src[i];
+			} else {
+				dst[false_offset++] = src[i];
+			}
+		}
+	}
+};
+
+// Stable partition: moves the elements for which p_predicate is true to the front, keeping the order of
+// both groups, and returns how many there are. The predicate may be called more than once per element.
+template <class T, class P>
+uint32_t parallel_partition(T *p_array, uint32_t p_size, const P &p_predicate) {
+	uint32_t chunks = parallel_get_chunk_count(p_size);
+
+	LocalVector<uint32_t> true_offsets;
+	true_offsets.resize(chunks);
+	_ParallelCountChunk<T, P> count_chunk = { p_array, true_offsets.ptr(), &p_predicate, p_size, chunks };
+	parallel_for_chunks(chunks, count_chunk);
+
+	uint32_t true_total = 0;
+	for (uint32_t i = 0; i < chunks; i++) {
+		true_total += true_offsets[i];
+	}
+
+	LocalVector<uint32_t> false_offsets;
+	false_offsets.resize(chunks);
+	uint32_t true_offset = 0;
+	uint32_t false_offset = true_total;
+	for (uint32_t i = 0; i < chunks; i++) {
+		uint32_t count = true_offsets[i];
+		uint32_t chunk_size = parallel_get_chunk_begin(i + 1, chunks, p_size) - parallel_get_chunk_begin(i, chunks, p_size);
+		true_offsets[i] = true_offset;
+		false_offsets[i] = false_offset;
+		true_offset += count;
+		false_offset += chunk_size - count;
+	}
+
+	LocalVector<T> temp;
+	temp.resize(p_size);
+	_ParallelPartitionChunk<T, P> partition_chunk = { p_array, temp.ptr(), true_offsets.ptr(), false_offsets.ptr(), &p_predicate, p_size, chunks };
+	parallel_for_chunks(chunks, partition_chunk);
+
+	_ParallelCopyChunk<T> copy_chunk = { temp.ptr(), p_array, p_size, chunks };
+	parallel_for_chunks(chunks, copy_chunk);
+
+	return true_total;
+}
+
+#endif // PARALLEL_ALGORITHMS_H
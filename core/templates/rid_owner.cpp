@@ -31,3 +31,5 @@
 #include "rid_owner.h"
 
 SafeNumeric<uint64_t> RID_AllocBase::base_id{ 1 };
+SafeNumeric<uint32_t> RID_AllocBase::shard_counter;
+thread_local uint32_t RID_AllocBase::thread_shard = UINT32_MAX;
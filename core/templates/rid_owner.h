@@ -35,16 +35,20 @@
 #include "core/os/spin_lock.h"
 #include "core/string/print_string.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/oa_hash_map.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
 #include "core/templates/set.h"
 
 #include <stdio.h>
+#include <atomic>
 #include <typeinfo>
 
 class RID_AllocBase {
 	static SafeNumeric<uint64_t> base_id;
+	static SafeNumeric<uint32_t> shard_counter;
+	static thread_local uint32_t thread_shard;
 
 protected:
 	static RID _make_from_id(uint64_t p_id) {
@@ -63,75 +67,186 @@ protected:
 		return base_id.increment();
 	}
 
+	// Threads are spread round robin over the shards of thread safe allocators.
+	static uint32_t _get_thread_shard() {
+		if (unlikely(thread_shard == UINT32_MAX)) {
+			thread_shard = shard_counter.postincrement();
+		}
+		return thread_shard;
+	}
+
 public:
 	virtual ~RID_AllocBase() {}
 };
 
+// When THREAD_SAFE, lookups (get_or_null, owns) take no lock. Chunks never move,
+// chunk tables are replaced rather than reallocated when growing (the old ones stay
+// alive until the allocator is destroyed) and validators are atomic.
+// Creating and freeing RIDs goes through small per-thread shards of free indices,
+// which only touch the global free list (under spin_lock) once every SHARD_BATCH RIDs.
 template <class T, bool THREAD_SAFE = false>
 class RID_Alloc : public RID_AllocBase {
-	T **chunks = nullptr;
+	typedef std::atomic<uint32_t> Validator;
+
+	enum {
+		SHARD_COUNT = 8,
+		SHARD_BATCH = 64,
+	};
+
+	struct Shard {
+		SpinLock lock;
+		uint32_t free_count = 0;
+		uint32_t free_indices[SHARD_BATCH * 2];
+	};
+
+	static constexpr std::memory_order LOAD_ORDER = THREAD_SAFE ? std::memory_order_acquire : std::memory_order_relaxed;
+	static constexpr std::memory_order STORE_ORDER = THREAD_SAFE ? std::memory_order_release : std::memory_order_relaxed;
+
+	std::atomic<T **> chunks = { nullptr };
+	std::atomic<Validator **> validator_chunks = { nullptr };
 	uint32_t **free_list_chunks = nullptr;
-	uint32_t **validator_chunks = nullptr;
+	uint32_t chunk_table_size = 0;
+	LocalVector<void *> retired_tables;
 
 	uint32_t elements_in_chunk;
-	uint32_t max_alloc = 0;
-	uint32_t alloc_count = 0;
+	std::atomic<uint32_t> max_alloc = { 0 };
+	uint32_t alloc_count = 0; // Indices taken from the global free list, includes the ones cached in shards.
+	SafeNumeric<uint32_t> rid_count;
 
 	const char *description = nullptr;
 
 	SpinLock spin_lock;
+	Shard shards[THREAD_SAFE ? SHARD_COUNT : 1];
 
-	_FORCE_INLINE_ RID _allocate_rid() {
-		if (THREAD_SAFE) {
-			spin_lock.lock();
+	_FORCE_INLINE_ Validator &_get_validator(uint32_t p_index) const {
+		return validator_chunks.load(LOAD_ORDER)[p_index / elements_in_chunk][p_index % elements_in_chunk];
+	}
+
+	template <class C>
+	void _grow_table(std::atomic<C **> &r_table, uint32_t p_new_size) {
+		C **old_table = r_table.load(std::memory_order_relaxed);
+		C **new_table = (C **)memalloc(sizeof(C *) * p_new_size);
+		for (uint32_t i = 0; i < chunk_table_size; i++) {
+			new_table[i] = old_table[i];
+		}
+		r_table.store(new_table, std::memory_order_release);
+		if (old_table) {
+			if (THREAD_SAFE) {
+				retired_tables.push_back(old_table); // May still be read by a lookup.
+			} else {
+				memfree(old_table);
+			}
 		}
+	}
 
-		if (alloc_count == max_alloc) {
+	// Global free list, needs spin_lock when THREAD_SAFE.
+	uint32_t _pop_free_index() {
+		uint32_t current_max = max_alloc.load(std::memory_order_relaxed);
+		if (alloc_count == current_max) {
 			//allocate a new chunk
-			uint32_t chunk_count = alloc_count == 0 ? 0 : (max_alloc / elements_in_chunk);
-
-			//grow chunks
-			chunks = (T **)memrealloc(chunks, sizeof(T *) * (chunk_count + 1));
-			chunks[chunk_count] = (T *)memalloc(sizeof(T) * elements_in_chunk); //but don't initialize
+			uint32_t chunk_count = current_max / elements_in_chunk;
+
+			//grow chunk tables
+			if (chunk_count == chunk_table_size) {
+				uint32_t new_size = chunk_table_size == 0 ? 1 : chunk_table_size * 2;
+				_grow_table(chunks, new_size);
+				_grow_table(validator_chunks, new_size);
+				free_list_chunks = (uint32_t **)memrealloc(free_list_chunks, sizeof(uint32_t *) * new_size);
+				chunk_table_size = new_size;
+			}
 
-			//grow validators
-			validator_chunks = (uint32_t **)memrealloc(validator_chunks, sizeof(uint32_t *) * (chunk_count + 1));
-			validator_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
-			//grow free lists
-			free_list_chunks = (uint32_t **)memrealloc(free_list_chunks, sizeof(uint32_t *) * (chunk_count + 1));
-			free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
+			chunks.load(std::memory_order_relaxed)[chunk_count] = (T *)memalloc(sizeof(T) * elements_in_chunk); //but don't initialize
+			Validator *validators = (Validator *)memalloc(sizeof(Validator) * elements_in_chunk);
+			uint32_t *free_list = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
 
 			//initialize
 			for (uint32_t i = 0; i < elements_in_chunk; i++) {
 				// Don't initialize chunk.
-				validator_chunks[chunk_count][i] = 0xFFFFFFFF;
-				free_list_chunks[chunk_count][i] = alloc_count + i;
+				memnew_placement(&validators[i], Validator(0xFFFFFFFF));
+				free_list[i] = current_max + i;
 			}
 
-			max_alloc += elements_in_chunk;
+			validator_chunks.load(std::memory_order_relaxed)[chunk_count] = validators;
+			free_list_chunks[chunk_count] = free_list;
+
+			// Publish the chunk before lookups can accept its indices.
+			max_alloc.store(current_max + elements_in_chunk, std::memory_order_release);
 		}
 
 		uint32_t free_index = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
+		alloc_count++;
+		return free_index;
+	}
 
-		uint32_t free_chunk = free_index / elements_in_chunk;
-		uint32_t free_element = free_index % elements_in_chunk;
+	void _push_free_index(uint32_t p_index) {
+		alloc_count--;
+		free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = p_index;
+	}
+
+	_FORCE_INLINE_ RID _allocate_rid() {
+		uint32_t free_index;
+
+		if (THREAD_SAFE) {
+			Shard &shard = shards[_get_thread_shard() % SHARD_COUNT];
+			shard.lock.lock();
+			if (shard.free_count == 0) {
+				spin_lock.lock();
+				for (uint32_t i = 0; i < SHARD_BATCH; i++) {
+					shard.free_indices[shard.free_count++] = _pop_free_index();
+				}
+				spin_lock.unlock();
+			}
+			free_index = shard.free_indices[--shard.free_count];
+			shard.lock.unlock();
+		} else {
+			free_index = _pop_free_index();
+		}
 
 		uint32_t validator = (uint32_t)(_gen_id() & 0x7FFFFFFF);
 		uint64_t id = validator;
 		id <<= 32;
 		id |= free_index;
 
-		validator_chunks[free_chunk][free_element] = validator;
+		_get_validator(free_index).store(validator | 0x80000000, STORE_ORDER); //mark uninitialized bit
 
-		validator_chunks[free_chunk][free_element] |= 0x80000000; //mark uninitialized bit
+		rid_count.increment();
 
-		alloc_count++;
+		return _make_from_id(id);
+	}
 
+	_FORCE_INLINE_ void _release_index(uint32_t p_index) {
 		if (THREAD_SAFE) {
-			spin_lock.unlock();
+			Shard &shard = shards[_get_thread_shard() % SHARD_COUNT];
+			shard.lock.lock();
+			if (shard.free_count == SHARD_BATCH * 2) {
+				spin_lock.lock();
+				for (uint32_t i = 0; i < SHARD_BATCH; i++) {
+					_push_free_index(shard.free_indices[--shard.free_count]);
+				}
+				spin_lock.unlock();
+			}
+			shard.free_indices[shard.free_count++] = p_index;
+			shard.lock.unlock();
+		} else {
+			_push_free_index(p_index);
 		}
+	}
 
-		return _make_from_id(id);
+	// Index of the p_index-th initialized RID. The free list doesn't keep live indices in order when THREAD_SAFE, so scan the validators.
+	uint32_t _find_index(uint32_t p_index) {
+		uint32_t current_max = max_alloc.load(LOAD_ORDER);
+		uint32_t found = 0;
+		for (uint32_t i = 0; i < current_max; i++) {
+			uint32_t validator = _get_validator(i).load(LOAD_ORDER);
+			if (validator & 0x80000000) {
+				continue; // Free or uninitialized.
+			}
+			if (found == p_index) {
+				return i;
+			}
+			found++;
+		}
+		return UINT32_MAX;
 	}
 
 public:
@@ -155,16 +270,10 @@ public:
 		if (p_rid == RID()) {
 			return nullptr;
 		}
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
 
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		if (unlikely(idx >= max_alloc.load(LOAD_ORDER))) {
 			return nullptr;
 		}
 
@@ -173,41 +282,29 @@ public:
 
 		uint32_t validator = uint32_t(id >> 32);
 
+		Validator &current = _get_validator(idx);
+		uint32_t current_validator = current.load(LOAD_ORDER);
+
 		if (unlikely(p_initialize)) {
-			if (unlikely(!(validator_chunks[idx_chunk][idx_element] & 0x80000000))) {
-				if (THREAD_SAFE) {
-					spin_lock.unlock();
-				}
+			if (unlikely(!(current_validator & 0x80000000))) {
 				ERR_FAIL_V_MSG(nullptr, "Initializing already initialized RID");
 			}
 
-			if (unlikely((validator_chunks[idx_chunk][idx_element] & 0x7FFFFFFF) != validator)) {
-				if (THREAD_SAFE) {
-					spin_lock.unlock();
-				}
+			if (unlikely((current_validator & 0x7FFFFFFF) != validator)) {
 				ERR_FAIL_V_MSG(nullptr, "Attempting to initialize the wrong RID");
 				return nullptr;
 			}
 
-			validator_chunks[idx_chunk][idx_element] &= 0x7FFFFFFF; //initialized
+			current.store(validator, STORE_ORDER); //initialized
 
-		} else if (unlikely(validator_chunks[idx_chunk][idx_element] != validator)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
-			if ((validator_chunks[idx_chunk][idx_element] & 0x80000000) && validator_chunks[idx_chunk][idx_element] != 0xFFFFFFFF) {
+		} else if (unlikely(current_validator != validator)) {
+			if ((current_validator & 0x80000000) && current_validator != 0xFFFFFFFF) {
 				ERR_FAIL_V_MSG(nullptr, "Attempting to use an uninitialized RID");
 			}
 			return nullptr;
 		}
 
-		T *ptr = &chunks[idx_chunk][idx_element];
-
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
-
-		return ptr;
+		return &chunks.load(LOAD_ORDER)[idx_chunk][idx_element];
 	}
 	void initialize_rid(RID p_rid) {
 		T *mem = get_or_null(p_rid, true);
@@ -221,44 +318,21 @@ public:
 	}
 
 	_FORCE_INLINE_ bool owns(const RID &p_rid) {
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		if (unlikely(idx >= max_alloc.load(LOAD_ORDER))) {
 			return false;
 		}
 
-		uint32_t idx_chunk = idx / elements_in_chunk;
-		uint32_t idx_element = idx % elements_in_chunk;
-
 		uint32_t validator = uint32_t(id >> 32);
 
-		bool owned = (validator_chunks[idx_chunk][idx_element] & 0x7FFFFFFF) == validator;
-
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
-
-		return owned;
+		return (_get_validator(idx).load(LOAD_ORDER) & 0x7FFFFFFF) == validator;
 	}
 
 	_FORCE_INLINE_ void free(const RID &p_rid) {
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		if (unlikely(idx >= max_alloc.load(LOAD_ORDER))) {
 			ERR_FAIL();
 		}
 
@@ -266,73 +340,82 @@ public:
 		uint32_t idx_element = idx % elements_in_chunk;
 
 		uint32_t validator = uint32_t(id >> 32);
-		if (unlikely(validator_chunks[idx_chunk][idx_element] & 0x80000000)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+
+		Validator &current = _get_validator(idx);
+		uint32_t current_validator = current.load(LOAD_ORDER);
+		if (unlikely(current_validator & 0x80000000)) {
 			ERR_FAIL_MSG("Attempted to free an uninitialized or invalid RID");
-		} else if (unlikely(validator_chunks[idx_chunk][idx_element] != validator)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		} else if (unlikely(current_validator != validator)) {
 			ERR_FAIL();
 		}
 
-		chunks[idx_chunk][idx_element].~T();
-		validator_chunks[idx_chunk][idx_element] = 0xFFFFFFFF; // go invalid
+		// Go invalid first, so only one of several threads freeing the same RID gets to destroy it.
+		if (unlikely(!current.compare_exchange_strong(current_validator, 0xFFFFFFFF, std::memory_order_acq_rel))) {
+			ERR_FAIL_MSG("Attempted to free an uninitialized or invalid RID");
+		}
 
-		alloc_count--;
-		free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = idx;
+		chunks.load(LOAD_ORDER)[idx_chunk][idx_element].~T();
 
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
+		rid_count.decrement();
+		_release_index(idx);
 	}
 
 	_FORCE_INLINE_ uint32_t get_rid_count() const {
-		return alloc_count;
+		return rid_count.get();
 	}
 
 	_FORCE_INLINE_ T *get_ptr_by_index(uint32_t p_index) {
-		ERR_FAIL_UNSIGNED_INDEX_V(p_index, alloc_count, nullptr);
+		ERR_FAIL_UNSIGNED_INDEX_V(p_index, get_rid_count(), nullptr);
+		uint32_t idx;
 		if (THREAD_SAFE) {
 			spin_lock.lock();
-		}
-		uint64_t idx = free_list_chunks[p_index / elements_in_chunk][p_index % elements_in_chunk];
-		T *ptr = &chunks[idx / elements_in_chunk][idx % elements_in_chunk];
-		if (THREAD_SAFE) {
+			idx = _find_index(p_index);
 			spin_lock.unlock();
+			ERR_FAIL_COND_V(idx == UINT32_MAX, nullptr);
+		} else {
+			idx = free_list_chunks[p_index / elements_in_chunk][p_index % elements_in_chunk];
 		}
-		return ptr;
+		return &chunks.load(LOAD_ORDER)[idx / elements_in_chunk][idx % elements_in_chunk];
 	}
 
 	_FORCE_INLINE_ RID get_rid_by_index(uint32_t p_index) {
-		ERR_FAIL_INDEX_V(p_index, alloc_count, RID());
+		ERR_FAIL_INDEX_V(p_index, get_rid_count(), RID());
+		uint32_t idx;
 		if (THREAD_SAFE) {
 			spin_lock.lock();
-		}
-		uint64_t idx = free_list_chunks[p_index / elements_in_chunk][p_index % elements_in_chunk];
-		uint64_t validator = validator_chunks[idx / elements_in_chunk][idx % elements_in_chunk];
-
-		RID rid = _make_from_id((validator << 32) | idx);
-		if (THREAD_SAFE) {
+			idx = _find_index(p_index);
 			spin_lock.unlock();
+			ERR_FAIL_COND_V(idx == UINT32_MAX, RID());
+		} else {
+			idx = free_list_chunks[p_index / elements_in_chunk][p_index % elements_in_chunk];
 		}
-		return rid;
+		uint64_t validator = _get_validator(idx).load(LOAD_ORDER);
+
+		return _make_from_id((validator << 32) | idx);
 	}
 
 	void get_owned_list(List<RID> *p_owned) {
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = validator_chunks[i / elements_in_chunk][i % elements_in_chunk];
+		uint32_t current_max = max_alloc.load(LOAD_ORDER);
+		for (size_t i = 0; i < current_max; i++) {
+			uint64_t validator = _get_validator(i).load(LOAD_ORDER);
 			if (validator != 0xFFFFFFFF) {
 				p_owned->push_back(_make_from_id((validator << 32) | i));
 			}
 		}
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
+	}
+
+	// Calls p_func with a pointer to every initialized element, in a single pass over the validators.
+	// Prefer it to looping over get_ptr_by_index(), which has to scan for the index when THREAD_SAFE.
+	// Elements must not be freed by other threads while this runs.
+	template <class F>
+	void for_each_owned(F p_func) {
+		uint32_t current_max = max_alloc.load(LOAD_ORDER);
+		for (uint32_t i = 0; i < current_max; i++) {
+			uint32_t validator = _get_validator(i).load(LOAD_ORDER);
+			if (validator & 0x80000000) {
+				continue; // Free or uninitialized.
+			}
+			p_func(&chunks.load(LOAD_ORDER)[i / elements_in_chunk][i % elements_in_chunk]);
 		}
 	}
 
@@ -345,39 +428,45 @@ public:
 	}
 
 	~RID_Alloc() {
-		if (alloc_count) {
+		uint32_t current_max = max_alloc.load(std::memory_order_acquire);
+		uint32_t leaked = rid_count.get();
+		if (leaked) {
 			if (description) {
-				print_error("ERROR: " + itos(alloc_count) + " RID allocations of type '" + description + "' were leaked at exit.");
+				print_error("ERROR: " + itos(leaked) + " RID allocations of type '" + description + "' were leaked at exit.");
 			} else {
 #ifdef NO_SAFE_CAST
-				print_error("ERROR: " + itos(alloc_count) + " RID allocations of type 'unknown' were leaked at exit.");
+				print_error("ERROR: " + itos(leaked) + " RID allocations of type 'unknown' were leaked at exit.");
 #else
-				print_error("ERROR: " + itos(alloc_count) + " RID allocations of type '" + typeid(T).name() + "' were leaked at exit.");
+				print_error("ERROR: " + itos(leaked) + " RID allocations of type '" + typeid(T).name() + "' were leaked at exit.");
 #endif
 			}
 
-			for (size_t i = 0; i < max_alloc; i++) {
-				uint64_t validator = validator_chunks[i / elements_in_chunk][i % elements_in_chunk];
+			for (size_t i = 0; i < current_max; i++) {
+				uint32_t validator = _get_validator(i).load(std::memory_order_relaxed);
 				if (validator & 0x80000000) {
 					continue; //uninitialized
 				}
-				if (validator != 0xFFFFFFFF) {
-					chunks[i / elements_in_chunk][i % elements_in_chunk].~T();
-				}
+				chunks.load(std::memory_order_relaxed)[i / elements_in_chunk][i % elements_in_chunk].~T();
 			}
 		}
 
-		uint32_t chunk_count = max_alloc / elements_in_chunk;
+		T **chunk_table = chunks.load(std::memory_order_relaxed);
+		Validator **validator_table = validator_chunks.load(std::memory_order_relaxed);
+		uint32_t chunk_count = current_max / elements_in_chunk;
 		for (uint32_t i = 0; i < chunk_count; i++) {
-			memfree(chunks[i]);
-			memfree(validator_chunks[i]);
+			memfree(chunk_table[i]);
+			memfree(validator_table[i]);
 			memfree(free_list_chunks[i]);
 		}
 
-		if (chunks) {
-			memfree(chunks);
+		if (chunk_table) {
+			memfree(chunk_table);
 			memfree(free_list_chunks);
-			memfree(validator_chunks);
+			memfree(validator_table);
+		}
+
+		for (uint32_t i = 0; i < retired_tables.size(); i++) {
+			memfree(retired_tables[i]);
 		}
 	}
 };
@@ -437,6 +526,11 @@ public:
 		return alloc.get_owned_list(p_owned);
 	}
 
+	template <class F>
+	_FORCE_INLINE_ void for_each_owned(F p_func) {
+		alloc.for_each_owned([&p_func](T **p_ptr) { p_func(*p_ptr); });
+	}
+
 	void set_description(const char *p_descrption) {
 		alloc.set_description(p_descrption);
 	}
@@ -497,6 +591,11 @@ public:
 		return alloc.get_owned_list(p_owned);
 	}
 
+	template <class F>
+	_FORCE_INLINE_ void for_each_owned(F p_func) {
+		alloc.for_each_owned(p_func);
+	}
+
 	void set_description(const char *p_descrption) {
 		alloc.set_description(p_descrption);
 	}
@@ -129,6 +129,15 @@ public:
 		return -1;
 	}
 
+	// Returns the next p_size elements to read in place, or nullptr if they wrap around the end of the buffer.
+	const T *get_read_ptr(int p_size) const {
+		ERR_FAIL_COND_V(data_left() < p_size, nullptr);
+		if (read_pos + p_size > size()) {
+			return nullptr;
+		}
+		return data.ptr() + read_pos;
+	}
+
 	inline int advance_read(int p_n) {
 		p_n = MIN(p_n, data_left());
 		inc(read_pos, p_n);
@@ -154,13 +163,14 @@ public:
 		int pos = write_pos;
 		int to_write = p_size;
 		int src = 0;
+		T *w = data.ptrw();
 		while (to_write) {
 			int end = pos + to_write;
 			end = MIN(end, size());
 			int total = end - pos;
 
 			for (int i = 0; i < total; i++) {
-				data.write[pos + i] = p_buf[src++];
+				w[pos + i] = p_buf[src++];
 			}
 			to_write -= total;
 			pos = 0;
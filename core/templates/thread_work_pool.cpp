@@ -32,48 +32,70 @@
 
 #include "core/os/os.h"
 
-void ThreadWorkPool::_thread_function(void *p_user) {
-	ThreadData *thread = static_cast<ThreadData *>(p_user);
-	while (true) {
-		thread->start.wait();
-		if (thread->exit.load()) {
-			break;
-		}
-		thread->work->work();
-		thread->completed.post();
+void ThreadWorkPool::init(int p_thread_count) {
+	ERR_FAIL_COND(thread_count != 0);
+	if (p_thread_count < 0) {
+		WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+		p_thread_count = pool ? pool->get_thread_count() : OS::get_singleton()->get_processor_count();
 	}
+
+	// Callers size per-thread data with this, so always report at least one.
+	thread_count = MAX(p_thread_count, 1);
 }
 
-void ThreadWorkPool::init(int p_thread_count) {
-	ERR_FAIL_COND(threads != nullptr);
-	if (p_thread_count < 0) {
-		p_thread_count = OS::get_singleton()->get_processor_count();
+// Aim for batches of about this much work, so fetching the next one is cheap in comparison.
+#define BATCHED_TARGET_NSEC 20000
+// Below this total amount of work, dispatching to other threads costs more than it saves.
+#define BATCHED_SERIAL_THRESHOLD_NSEC 50000
+
+uint32_t ThreadWorkPool::_get_batch_size(uint32_t p_elements) const {
+	if (p_elements <= 1) {
+		return MAX(p_elements, 1u);
 	}
 
-	thread_count = p_thread_count;
-	threads = memnew_arr(ThreadData, thread_count);
+	if (batched_element_cost == 0) {
+		// No measurement yet, just give each thread a few batches to balance with.
+		return MAX(p_elements / (thread_count * 8), 1u);
+	}
 
-	for (uint32_t i = 0; i < thread_count; i++) {
-		threads[i].exit.store(false);
-		threads[i].thread.start(&ThreadWorkPool::_thread_function, &threads[i]);
+	if (batched_element_cost * p_elements < BATCHED_SERIAL_THRESHOLD_NSEC) {
+		return p_elements;
 	}
+
+	uint64_t batch_size = MAX(BATCHED_TARGET_NSEC / batched_element_cost, (uint64_t)1);
+	// Keep at least one batch per thread.
+	batch_size = MIN(batch_size, (uint64_t)MAX(p_elements / thread_count, 1u));
+	return batch_size;
 }
 
-void ThreadWorkPool::finish() {
-	if (threads == nullptr) {
+uint64_t ThreadWorkPool::_begin_batched_timing() const {
+	return OS::get_singleton()->get_ticks_usec();
+}
+
+void ThreadWorkPool::_end_batched_timing(uint64_t p_begin, uint32_t p_elements, bool p_serial) {
+	if (p_elements == 0) {
 		return;
 	}
 
-	for (uint32_t i = 0; i < thread_count; i++) {
-		threads[i].exit.store(true);
-		threads[i].start.post();
+	uint64_t elapsed = (OS::get_singleton()->get_ticks_usec() - p_begin) * 1000;
+	if (!p_serial) {
+		// Elapsed time was shared among the threads (plus the caller).
+		elapsed *= thread_count + 1;
 	}
-	for (uint32_t i = 0; i < thread_count; i++) {
-		threads[i].thread.wait_to_finish();
+	uint64_t cost = MAX(elapsed / p_elements, (uint64_t)1);
+
+	if (batched_element_cost == 0) {
+		batched_element_cost = cost;
+	} else {
+		batched_element_cost = (batched_element_cost * 3 + cost) / 4;
 	}
+}
 
-	memdelete_arr(threads);
-	threads = nullptr;
+void ThreadWorkPool::finish() {
+	if (current_group != WorkerThreadPool::INVALID_TASK_ID) {
+		end_work();
+	}
+	thread_count = 0;
 }
 
 ThreadWorkPool::~ThreadWorkPool() {
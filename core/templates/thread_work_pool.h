@@ -31,99 +31,71 @@
 #ifndef THREAD_WORK_POOL_H
 #define THREAD_WORK_POOL_H
 
-#include "core/os/memory.h"
-#include "core/os/semaphore.h"
-#include "core/os/thread.h"
+#include "core/os/worker_thread_pool.h"
 
-#include <atomic>
+// Compatibility layer over WorkerThreadPool. Every instance used to own its own
+// threads and could only run a single job at a time, now jobs from different
+// instances (and from WorkerThreadPool users) share the engine worker threads.
 
 class ThreadWorkPool {
-	std::atomic<uint32_t> index;
-
-	struct BaseWork {
-		std::atomic<uint32_t> *index = nullptr;
-		uint32_t max_elements = 0;
-		virtual void work() = 0;
-		virtual ~BaseWork() = default;
-	};
-
-	template <class C, class M, class U>
-	struct Work : public BaseWork {
-		C *instance;
-		M method;
-		U userdata;
-		virtual void work() {
-			while (true) {
-				uint32_t work_index = index->fetch_add(1, std::memory_order_relaxed);
-				if (work_index >= max_elements) {
-					break;
-				}
-				(instance->*method)(work_index, userdata);
-			}
-		}
-	};
-
-	struct ThreadData {
-		Thread thread;
-		Semaphore start;
-		Semaphore completed;
-		std::atomic<bool> exit;
-		BaseWork *work;
-	};
-
-	ThreadData *threads = nullptr;
 	uint32_t thread_count = 0;
-	BaseWork *current_work = nullptr;
+	WorkerThreadPool::GroupID current_group = WorkerThreadPool::INVALID_TASK_ID;
+	uint32_t current_elements = 0;
+
+	// Estimated cost of one element in do_work_batched(), in nanoseconds (0 means unknown yet).
+	uint64_t batched_element_cost = 0;
 
-	static void _thread_function(void *p_user);
+	uint32_t _get_batch_size(uint32_t p_elements) const;
+	uint64_t _begin_batched_timing() const;
+	void _end_batched_timing(uint64_t p_begin, uint32_t p_elements, bool p_serial);
 
 public:
 	template <class C, class M, class U>
 	void begin_work(uint32_t p_elements, C *p_instance, M p_method, U p_userdata) {
-		ERR_FAIL_COND(!threads); //never initialized
-		ERR_FAIL_COND(current_work != nullptr);
-
-		index.store(0, std::memory_order_release);
+		ERR_FAIL_COND(thread_count == 0); //never initialized
+		ERR_FAIL_COND(current_group != WorkerThreadPool::INVALID_TASK_ID);
 
-		Work<C, M, U> *w = memnew((Work<C, M, U>));
-		w->instance = p_instance;
-		w->userdata = p_userdata;
-		w->method = p_method;
-		w->index = &index;
-		w->max_elements = p_elements;
+		current_elements = p_elements;
 
-		current_work = w;
-
-		for (uint32_t i = 0; i < thread_count; i++) {
-			threads[i].work = w;
-			threads[i].start.post();
+		WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+		if (!pool || pool->get_thread_count() == 0) {
+			// Nobody to hand the work to, do it right away so polling users don't spin forever.
+			for (uint32_t i = 0; i < p_elements; i++) {
+				(p_instance->*p_method)(i, p_userdata);
+			}
+			current_group = 0;
+			return;
 		}
+
+		current_group = pool->add_template_group_task(p_instance, p_method, p_userdata, p_elements, thread_count);
 	}
 
 	bool is_working() const {
-		return current_work != nullptr;
+		return current_group != WorkerThreadPool::INVALID_TASK_ID;
 	}
 
 	bool is_done_dispatching() const {
-		ERR_FAIL_COND_V(current_work == nullptr, true);
-		return index.load(std::memory_order_acquire) >= current_work->max_elements;
+		ERR_FAIL_COND_V(current_group == WorkerThreadPool::INVALID_TASK_ID, true);
+		if (current_group == 0) {
+			return true;
+		}
+		return WorkerThreadPool::get_singleton()->is_group_task_dispatched(current_group);
 	}
 
 	uint32_t get_work_index() const {
-		ERR_FAIL_COND_V(current_work == nullptr, 0);
-		uint32_t idx = index.load(std::memory_order_acquire);
-		return MIN(idx, current_work->max_elements);
+		ERR_FAIL_COND_V(current_group == WorkerThreadPool::INVALID_TASK_ID, 0);
+		if (current_group == 0) {
+			return current_elements;
+		}
+		return WorkerThreadPool::get_singleton()->get_group_processed_element_count(current_group);
 	}
 
 	void end_work() {
-		ERR_FAIL_COND(current_work == nullptr);
-		for (uint32_t i = 0; i < thread_count; i++) {
-			threads[i].completed.wait();
-			threads[i].work = nullptr;
+		ERR_FAIL_COND(current_group == WorkerThreadPool::INVALID_TASK_ID);
+		if (current_group != 0) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(current_group);
 		}
-
-		memdelete(current_work);
-		current_work = nullptr;
+		current_group = WorkerThreadPool::INVALID_TASK_ID;
 	}
 
 	template <class C, class M, class U>
@@ -132,10 +104,37 @@ public:
 		end_work();
 	}
 
+	// Like do_work(), but meant for many tiny elements: threads take ranges of
+	// indices sized from the per-element cost measured on previous calls, and
+	// the work runs serially on the caller when it's too small to be worth
+	// splitting. The estimate is kept per pool, so don't share a pool between
+	// different kinds of batched jobs.
+	template <class C, class M, class U>
+	void do_work_batched(uint32_t p_elements, C *p_instance, M p_method, U p_userdata) {
+		ERR_FAIL_COND(thread_count == 0); //never initialized
+		ERR_FAIL_COND(current_group != WorkerThreadPool::INVALID_TASK_ID);
+
+		uint64_t begin = _begin_batched_timing();
+		uint32_t batch_size = _get_batch_size(p_elements);
+
+		WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+		bool serial = batch_size >= p_elements || !pool || pool->get_thread_count() == 0;
+		if (serial) {
+			for (uint32_t i = 0; i < p_elements; i++) {
+				(p_instance->*p_method)(i, p_userdata);
+			}
+		} else {
+			WorkerThreadPool::GroupID group = pool->add_template_group_task(p_instance, p_method, p_userdata, p_elements, thread_count, batch_size);
+			pool->wait_for_group_task_completion(group);
+		}
+
+		_end_batched_timing(begin, p_elements, serial);
+	}
+
 	_FORCE_INLINE_ int get_thread_count() const { return thread_count; }
 	void init(int p_thread_count = -1);
 	void finish();
 	~ThreadWorkPool();
 };
 
-#endif // THREAD_POOL_H
+#endif // THREAD_WORK_POOL_H
@@ -36,11 +36,158 @@
 #include "core/io/marshalls.h"
 #include "core/io/resource.h"
 #include "core/math/math_funcs.h"
+#include "core/os/spin_lock.h"
 #include "core/string/print_string.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant_parser.h"
 #include "scene/gui/control.h"
 #include "scene/main/node.h"
 
+// Free blocks are chained through their first bytes. Each thread allocates from and
+// frees to its own shard, shards only touch the shared list (under spin_lock) to
+// exchange whole batches, so blocks moving from one thread to another can't make
+// a shard grow without bounds.
+// Pages are never released, Variants in static storage may outlive the pools.
+template <size_t SIZE>
+class VariantPool {
+	static_assert(SIZE >= sizeof(void *) * 2, "Pool blocks must fit the free list links.");
+
+	enum {
+		SHARD_COUNT = 8,
+		BATCH_SIZE = 64,
+		PAGE_BLOCKS = 256,
+	};
+
+	struct FreeBlock {
+		FreeBlock *next;
+		FreeBlock *next_batch; // Only used by the first block of batches in the shared list.
+	};
+
+	struct alignas(64) Shard {
+		SpinLock lock;
+		FreeBlock *free_list = nullptr;
+		uint32_t free_count = 0;
+	};
+
+	Shard shards[SHARD_COUNT];
+	SpinLock spin_lock;
+	FreeBlock *batches = nullptr; // Full batches of BATCH_SIZE blocks.
+
+	static SafeNumeric<uint32_t> shard_counter;
+	static thread_local uint32_t thread_shard;
+
+	static _FORCE_INLINE_ uint32_t _get_thread_shard() {
+		if (unlikely(thread_shard == UINT32_MAX)) {
+			thread_shard = shard_counter.postincrement() % SHARD_COUNT;
+		}
+		return thread_shard;
+	}
+
+	void _refill(Shard &p_shard) {
+		spin_lock.lock();
+		FreeBlock *batch = batches;
+		if (batch) {
+			batches = batch->next_batch;
+			spin_lock.unlock();
+			p_shard.free_list = batch;
+			p_shard.free_count = BATCH_SIZE;
+			return;
+		}
+		spin_lock.unlock();
+
+		// Carve a new page, the blocks the shard doesn't keep go to the shared list.
+		uint8_t *page = (uint8_t *)memalloc(SIZE * PAGE_BLOCKS);
+		for (uint32_t i = 0; i < PAGE_BLOCKS; i++) {
+			FreeBlock *block = (FreeBlock *)(page + i * SIZE);
+			block->next = (i % BATCH_SIZE) == BATCH_SIZE - 1 ? nullptr : (FreeBlock *)(page + (i + 1) * SIZE);
+		}
+		p_shard.free_list = (FreeBlock *)page;
+		p_shard.free_count = BATCH_SIZE;
+
+		spin_lock.lock();
+		for (uint32_t i = BATCH_SIZE; i < PAGE_BLOCKS; i += BATCH_SIZE) {
+			FreeBlock *first = (FreeBlock *)(page + i * SIZE);
+			first->next_batch = batches;
+			batches = first;
+		}
+		spin_lock.unlock();
+	}
+
+public:
+	_FORCE_INLINE_ void *alloc() {
+		Shard &shard = shards[_get_thread_shard()];
+		shard.lock.lock();
+		if (unlikely(shard.free_count == 0)) {
+			_refill(shard);
+		}
+		FreeBlock *block = shard.free_list;
+		shard.free_list = block->next;
+		shard.free_count--;
+		shard.lock.unlock();
+		return block;
+	}
+
+	_FORCE_INLINE_ void free(void *p_mem) {
+		Shard &shard = shards[_get_thread_shard()];
+		FreeBlock *block = (FreeBlock *)p_mem;
+		shard.lock.lock();
+		if (unlikely(shard.free_count == BATCH_SIZE * 2)) {
+			// Hand the oldest half over, the most recently freed blocks are still warm.
+			FreeBlock *last = shard.free_list;
+			for (uint32_t i = 1; i < BATCH_SIZE; i++) {
+				last = last->next;
+			}
+			FreeBlock *batch = last->next;
+			last->next = nullptr;
+			shard.free_count = BATCH_SIZE;
+
+			spin_lock.lock();
+			batch->next_batch = batches;
+			batches = batch;
+			spin_lock.unlock();
+		}
+		block->next = shard.free_list;
+		shard.free_list = block;
+		shard.free_count++;
+		shard.lock.unlock();
+	}
+};
+
+template <size_t SIZE>
+SafeNumeric<uint32_t> VariantPool<SIZE>::shard_counter;
+template <size_t SIZE>
+thread_local uint32_t VariantPool<SIZE>::thread_shard = UINT32_MAX;
+
+// Constant initialized and trivially destructible, so the pools are usable from other
+// static initializers and still valid while static Variants are destroyed.
+VariantPool<sizeof(Variant::Pools::BucketSmall)> Variant::Pools::bucket_small;
+VariantPool<sizeof(Variant::Pools::BucketMedium)> Variant::Pools::bucket_medium;
+VariantPool<sizeof(Variant::Pools::BucketLarge)> Variant::Pools::bucket_large;
+
+void *Variant::Pools::alloc_small() {
+	return bucket_small.alloc();
+}
+
+void *Variant::Pools::alloc_medium() {
+	return bucket_medium.alloc();
+}
+
+void *Variant::Pools::alloc_large() {
+	return bucket_large.alloc();
+}
+
+void Variant::Pools::free_small(void *p_mem) {
+	bucket_small.free(p_mem);
+}
+
+void Variant::Pools::free_medium(void *p_mem) {
+	bucket_medium.free(p_mem);
+}
+
+void Variant::Pools::free_large(void *p_mem) {
+	bucket_large.free(p_mem);
+}
+
 String Variant::get_type_name(Variant::Type p_type) {
 	switch (p_type) {
 		case NIL: {
@@ -1078,7 +1225,7 @@ void Variant::reference(const Variant &p_variant) {
 			memnew_placement(_data._mem, Rect2i(*reinterpret_cast<const Rect2i *>(p_variant._data._mem)));
 		} break;
 		case TRANSFORM2D: {
-			_data._transform2d = memnew(Transform2D(*p_variant._data._transform2d));
+			_data._transform2d = memnew_placement(Pools::alloc_small(), Transform2D(*p_variant._data._transform2d));
 		} break;
 		case VECTOR3: {
 			memnew_placement(_data._mem, Vector3(*reinterpret_cast<const Vector3 *>(p_variant._data._mem)));
@@ -1091,18 +1238,18 @@ void Variant::reference(const Variant &p_variant) {
 		} break;
 
 		case AABB: {
-			_data._aabb = memnew(::AABB(*p_variant._data._aabb));
+			_data._aabb = memnew_placement(Pools::alloc_small(), ::AABB(*p_variant._data._aabb));
 		} break;
 		case QUATERNION: {
 			memnew_placement(_data._mem, Quaternion(*reinterpret_cast<const Quaternion *>(p_variant._data._mem)));
 
 		} break;
 		case BASIS: {
-			_data._basis = memnew(Basis(*p_variant._data._basis));
+			_data._basis = memnew_placement(Pools::alloc_medium(), Basis(*p_variant._data._basis));
 
 		} break;
 		case TRANSFORM3D: {
-			_data._transform3d = memnew(Transform3D(*p_variant._data._transform3d));
+			_data._transform3d = memnew_placement(Pools::alloc_large(), Transform3D(*p_variant._data._transform3d));
 		} break;
 
 		// misc types
@@ -1282,16 +1429,16 @@ void Variant::_clear_internal() {
 		RECT2
 		*/
 		case TRANSFORM2D: {
-			memdelete(_data._transform2d);
+			Pools::free_small(_data._transform2d);
 		} break;
 		case AABB: {
-			memdelete(_data._aabb);
+			Pools::free_small(_data._aabb);
 		} break;
 		case BASIS: {
-			memdelete(_data._basis);
+			Pools::free_medium(_data._basis);
 		} break;
 		case TRANSFORM3D: {
-			memdelete(_data._transform3d);
+			Pools::free_large(_data._transform3d);
 		} break;
 
 			// misc types
@@ -2418,12 +2565,12 @@ Variant::Variant(const Plane &p_plane) {
 
 Variant::Variant(const ::AABB &p_aabb) {
 	type = AABB;
-	_data._aabb = memnew(::AABB(p_aabb));
+	_data._aabb = memnew_placement(Pools::alloc_small(), ::AABB(p_aabb));
 }
 
 Variant::Variant(const Basis &p_matrix) {
 	type = BASIS;
-	_data._basis = memnew(Basis(p_matrix));
+	_data._basis = memnew_placement(Pools::alloc_medium(), Basis(p_matrix));
 }
 
 Variant::Variant(const Quaternion &p_quaternion) {
@@ -2433,12 +2580,12 @@ Variant::Variant(const Quaternion &p_quaternion) {
 
 Variant::Variant(const Transform3D &p_transform) {
 	type = TRANSFORM3D;
-	_data._transform3d = memnew(Transform3D(p_transform));
+	_data._transform3d = memnew_placement(Pools::alloc_large(), Transform3D(p_transform));
 }
 
 Variant::Variant(const Transform2D &p_transform) {
 	type = TRANSFORM2D;
-	_data._transform2d = memnew(Transform2D(p_transform));
+	_data._transform2d = memnew_placement(Pools::alloc_small(), Transform2D(p_transform));
 }
 
 Variant::Variant(const Color &p_color) {
@@ -2569,6 +2716,51 @@ Variant::Variant(const Vector<Color> &p_color_array) {
 	_data.packed_array = PackedArrayRef<Color>::create(p_color_array);
 }
 
+Variant::Variant(Vector<uint8_t> &&p_byte_array) {
+	type = PACKED_BYTE_ARRAY;
+	_data.packed_array = PackedArrayRef<uint8_t>::create(std::move(p_byte_array));
+}
+
+Variant::Variant(Vector<int32_t> &&p_int32_array) {
+	type = PACKED_INT32_ARRAY;
+	_data.packed_array = PackedArrayRef<int32_t>::create(std::move(p_int32_array));
+}
+
+Variant::Variant(Vector<int64_t> &&p_int64_array) {
+	type = PACKED_INT64_ARRAY;
+	_data.packed_array = PackedArrayRef<int64_t>::create(std::move(p_int64_array));
+}
+
+Variant::Variant(Vector<float> &&p_float32_array) {
+	type = PACKED_FLOAT32_ARRAY;
+	_data.packed_array = PackedArrayRef<float>::create(std::move(p_float32_array));
+}
+
+Variant::Variant(Vector<double> &&p_float64_array) {
+	type = PACKED_FLOAT64_ARRAY;
+	_data.packed_array = PackedArrayRef<double>::create(std::move(p_float64_array));
+}
+
+Variant::Variant(Vector<String> &&p_string_array) {
+	type = PACKED_STRING_ARRAY;
+	_data.packed_array = PackedArrayRef<String>::create(std::move(p_string_array));
+}
+
+Variant::Variant(Vector<Vector3> &&p_vector3_array) {
+	type = PACKED_VECTOR3_ARRAY;
+	_data.packed_array = PackedArrayRef<Vector3>::create(std::move(p_vector3_array));
+}
+
+Variant::Variant(Vector<Vector2> &&p_vector2_array) {
+	type = PACKED_VECTOR2_ARRAY;
+	_data.packed_array = PackedArrayRef<Vector2>::create(std::move(p_vector2_array));
+}
+
+Variant::Variant(Vector<Color> &&p_color_array) {
+	type = PACKED_COLOR_ARRAY;
+	_data.packed_array = PackedArrayRef<Color>::create(std::move(p_color_array));
+}
+
 Variant::Variant(const Vector<Face3> &p_face_array) {
 	Vector<Vector3> vertices;
 	int face_count = p_face_array.size();
@@ -2612,6 +2804,18 @@ Variant::Variant(const Vector<StringName> &p_array) {
 	*this = v;
 }
 
+void Variant::operator=(Variant &&p_variant) {
+	if (unlikely(this == &p_variant)) {
+		return;
+	}
+
+	Variant moved(std::move(p_variant)); // The source might be owned by what this holds, take it out first.
+	clear();
+	type = moved.type;
+	memcpy(&_data, &moved._data, sizeof(_data));
+	moved.type = NIL;
+}
+
 void Variant::operator=(const Variant &p_variant) {
 	if (unlikely(this == &p_variant)) {
 		return;
@@ -2771,6 +2975,13 @@ Variant::Variant(const Variant &p_variant) {
 	reference(p_variant);
 }
 
+Variant::Variant(Variant &&p_variant) {
+	// Every type can be relocated as is, the source is left empty.
+	type = p_variant.type;
+	memcpy(&_data, &p_variant._data, sizeof(_data));
+	p_variant.type = NIL;
+}
+
 uint32_t Variant::hash() const {
 	switch (type) {
 		case NIL: {
@@ -67,6 +67,9 @@ typedef Vector<Vector2> PackedVector2Array;
 typedef Vector<Vector3> PackedVector3Array;
 typedef Vector<Color> PackedColorArray;
 
+template <size_t SIZE>
+class VariantPool;
+
 class Variant {
 public:
 	// If this changes the table in variant_op must be updated
@@ -177,6 +180,9 @@ private:
 		static _FORCE_INLINE_ PackedArrayRef<T> *create(const Vector<T> &p_from) {
 			return memnew(PackedArrayRef<T>(p_from));
 		}
+		static _FORCE_INLINE_ PackedArrayRef<T> *create(Vector<T> &&p_from) {
+			return memnew(PackedArrayRef<T>(std::move(p_from)));
+		}
 
 		static _FORCE_INLINE_ const Vector<T> &get_array(PackedArrayRefBase *p_base) {
 			return static_cast<PackedArrayRef<T> *>(p_base)->array;
@@ -189,12 +195,50 @@ private:
 			array = p_from;
 			refcount.init();
 		}
+		_FORCE_INLINE_ PackedArrayRef(Vector<T> &&p_from) :
+				array(std::move(p_from)) {
+			refcount.init();
+		}
 		_FORCE_INLINE_ PackedArrayRef() {
 			refcount.init();
 		}
 	};
 
 	/* end of array helpers */
+
+	// Storage for the math types too big to live in _data. Blocks are recycled
+	// through free lists sharded by thread, so hot paths creating lots of
+	// transforms don't go through the general purpose allocator.
+	struct Pools {
+		union BucketSmall {
+			BucketSmall() {}
+			~BucketSmall() {}
+			Transform2D _transform2d;
+			::AABB _aabb;
+		};
+		union BucketMedium {
+			BucketMedium() {}
+			~BucketMedium() {}
+			Basis _basis;
+		};
+		union BucketLarge {
+			BucketLarge() {}
+			~BucketLarge() {}
+			Transform3D _transform3d;
+		};
+
+		static void *alloc_small();
+		static void *alloc_medium();
+		static void *alloc_large();
+		static void free_small(void *p_mem);
+		static void free_medium(void *p_mem);
+		static void free_large(void *p_mem);
+
+		static VariantPool<sizeof(BucketSmall)> bucket_small;
+		static VariantPool<sizeof(BucketMedium)> bucket_medium;
+		static VariantPool<sizeof(BucketLarge)> bucket_large;
+	};
+
 	_ALWAYS_INLINE_ ObjData &_get_obj();
 	_ALWAYS_INLINE_ const ObjData &_get_obj() const;
 
@@ -421,6 +465,17 @@ public:
 	Variant(const Vector<String> &p_string_array);
 	Variant(const Vector<Vector3> &p_vector3_array);
 	Variant(const Vector<Color> &p_color_array);
+
+	// Take the array over without touching its reference count.
+	Variant(Vector<uint8_t> &&p_byte_array);
+	Variant(Vector<int32_t> &&p_int32_array);
+	Variant(Vector<int64_t> &&p_int64_array);
+	Variant(Vector<float> &&p_float32_array);
+	Variant(Vector<double> &&p_float64_array);
+	Variant(Vector<String> &&p_string_array);
+	Variant(Vector<Vector3> &&p_vector3_array);
+	Variant(Vector<Vector2> &&p_vector2_array);
+	Variant(Vector<Color> &&p_color_array);
 	Variant(const Vector<Face3> &p_face_array);
 
 	Variant(const Vector<Variant> &p_array);
@@ -678,11 +733,13 @@ public:
 	static void construct_from_string(const String &p_string, Variant &r_value, ObjectConstruct p_obj_construct = nullptr, void *p_construct_ud = nullptr);
 
 	void operator=(const Variant &p_variant); // only this is enough for all the other types
+	void operator=(Variant &&p_variant);
 
 	static void register_types();
 	static void unregister_types();
 
 	Variant(const Variant &p_variant);
+	Variant(Variant &&p_variant);
 	_FORCE_INLINE_ Variant() {}
 	_FORCE_INLINE_ ~Variant() {
 		clear();
@@ -873,6 +873,145 @@ struct _VariantCall {
 		return len;
 	}
 
+	// Bulk math on packed float arrays. The loops work on plain pointers so the compiler can vectorize them,
+	// reductions keep four partial results to avoid depending on the previous iteration.
+
+	template <class T>
+	static void func_PackedFloatArray_add(Vector<T> *p_instance, const Vector<T> &p_values) {
+		const int size = p_instance->size();
+		ERR_FAIL_COND_MSG(p_values.size() != size, "Both arrays must have the same size.");
+		const T *r = p_values.ptr();
+		T *w = p_instance->ptrw();
+		for (int i = 0; i < size; i++) {
+			w[i] += r[i];
+		}
+	}
+
+	template <class T>
+	static void func_PackedFloatArray_add_scalar(Vector<T> *p_instance, double p_value) {
+		const int size = p_instance->size();
+		const T value = p_value;
+		T *w = p_instance->ptrw();
+		for (int i = 0; i < size; i++) {
+			w[i] += value;
+		}
+	}
+
+	template <class T>
+	static void func_PackedFloatArray_multiply(Vector<T> *p_instance, const Vector<T> &p_values) {
+		const int size = p_instance->size();
+		ERR_FAIL_COND_MSG(p_values.size() != size, "Both arrays must have the same size.");
+		const T *r = p_values.ptr();
+		T *w = p_instance->ptrw();
+		for (int i = 0; i < size; i++) {
+			w[i] *= r[i];
+		}
+	}
+
+	template <class T>
+	static void func_PackedFloatArray_multiply_scalar(Vector<T> *p_instance, double p_value) {
+		const int size = p_instance->size();
+		const T value = p_value;
+		T *w = p_instance->ptrw();
+		for (int i = 0; i < size; i++) {
+			w[i] *= value;
+		}
+	}
+
+	template <class T>
+	static void func_PackedFloatArray_fma(Vector<T> *p_instance, const Vector<T> &p_multiplier, const Vector<T> &p_addend) {
+		const int size = p_instance->size();
+		ERR_FAIL_COND_MSG(p_multiplier.size() != size || p_addend.size() != size, "All arrays must have the same size.");
+		const T *m = p_multiplier.ptr();
+		const T *a = p_addend.ptr();
+		T *w = p_instance->ptrw();
+		for (int i = 0; i < size; i++) {
+			w[i] = w[i] * m[i] + a[i];
+		}
+	}
+
+	template <class T>
+	static double func_PackedFloatArray_dot(Vector<T> *p_instance, const Vector<T> &p_values) {
+		const int size = p_instance->size();
+		ERR_FAIL_COND_V_MSG(p_values.size() != size, 0.0, "Both arrays must have the same size.");
+		const T *a = p_instance->ptr();
+		const T *b = p_values.ptr();
+		double partial[4] = { 0.0, 0.0, 0.0, 0.0 };
+		int i = 0;
+		for (; i + 4 <= size; i += 4) {
+			partial[0] += double(a[i + 0]) * double(b[i + 0]);
+			partial[1] += double(a[i + 1]) * double(b[i + 1]);
+			partial[2] += double(a[i + 2]) * double(b[i + 2]);
+			partial[3] += double(a[i + 3]) * double(b[i + 3]);
+		}
+		for (; i < size; i++) {
+			partial[0] += double(a[i]) * double(b[i]);
+		}
+		return (partial[0] + partial[1]) + (partial[2] + partial[3]);
+	}
+
+	template <class T>
+	static double func_PackedFloatArray_sum(Vector<T> *p_instance) {
+		const int size = p_instance->size();
+		const T *r = p_instance->ptr();
+		double partial[4] = { 0.0, 0.0, 0.0, 0.0 };
+		int i = 0;
+		for (; i + 4 <= size; i += 4) {
+			partial[0] += r[i + 0];
+			partial[1] += r[i + 1];
+			partial[2] += r[i + 2];
+			partial[3] += r[i + 3];
+		}
+		for (; i < size; i++) {
+			partial[0] += r[i];
+		}
+		return (partial[0] + partial[1]) + (partial[2] + partial[3]);
+	}
+
+	template <class T, bool IS_MIN>
+	static _FORCE_INLINE_ T _packed_float_array_pick(T p_a, T p_b) {
+		return IS_MIN ? MIN(p_a, p_b) : MAX(p_a, p_b);
+	}
+
+	template <class T, bool IS_MIN>
+	static double _packed_float_array_min_max(const Vector<T> *p_instance) {
+		const int size = p_instance->size();
+		if (size == 0) {
+			return 0.0;
+		}
+		const T *r = p_instance->ptr();
+		T partial[4] = { r[0], r[0], r[0], r[0] };
+		int i = 0;
+		for (; i + 4 <= size; i += 4) {
+			partial[0] = _packed_float_array_pick<T, IS_MIN>(partial[0], r[i + 0]);
+			partial[1] = _packed_float_array_pick<T, IS_MIN>(partial[1], r[i + 1]);
+			partial[2] = _packed_float_array_pick<T, IS_MIN>(partial[2], r[i + 2]);
+			partial[3] = _packed_float_array_pick<T, IS_MIN>(partial[3], r[i + 3]);
+		}
+		for (; i < size; i++) {
+			partial[0] = _packed_float_array_pick<T, IS_MIN>(partial[0], r[i]);
+		}
+		return _packed_float_array_pick<T, IS_MIN>(_packed_float_array_pick<T, IS_MIN>(partial[0], partial[1]), _packed_float_array_pick<T, IS_MIN>(partial[2], partial[3]));
+	}
+
+	template <class T>
+	static double func_PackedFloatArray_min(Vector<T> *p_instance) {
+		return _packed_float_array_min_max<T, true>(p_instance);
+	}
+
+	template <class T>
+	static double func_PackedFloatArray_max(Vector<T> *p_instance) {
+		return _packed_float_array_min_max<T, false>(p_instance);
+	}
+
+	static void func_PackedVector3Array_transform(PackedVector3Array *p_instance, const Transform3D &p_transform) {
+		const int size = p_instance->size();
+		Vector3 *w = p_instance->ptrw();
+		for (int i = 0; i < size; i++) {
+			w[i] = p_transform.xform(w[i]);
+		}
+	}
+
 	static void func_Callable_call(Variant *v, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
 		Callable *callable = VariantGetInternalPtr<Callable>::get_ptr(v);
 		callable->call(p_args, p_argcount, r_ret, r_error);
@@ -1950,6 +2089,16 @@ static void _register_variant_builtin_methods() {
 	bind_method(PackedFloat32Array, bsearch, sarray("value", "before"), varray(true));
 	bind_method(PackedFloat32Array, duplicate, sarray(), varray());
 
+	bind_functionnc(PackedFloat32Array, add, _VariantCall::func_PackedFloatArray_add<float>, sarray("values"), varray());
+	bind_functionnc(PackedFloat32Array, add_scalar, _VariantCall::func_PackedFloatArray_add_scalar<float>, sarray("value"), varray());
+	bind_functionnc(PackedFloat32Array, multiply, _VariantCall::func_PackedFloatArray_multiply<float>, sarray("values"), varray());
+	bind_functionnc(PackedFloat32Array, multiply_scalar, _VariantCall::func_PackedFloatArray_multiply_scalar<float>, sarray("value"), varray());
+	bind_functionnc(PackedFloat32Array, fma, _VariantCall::func_PackedFloatArray_fma<float>, sarray("multiplier", "addend"), varray());
+	bind_function(PackedFloat32Array, dot, _VariantCall::func_PackedFloatArray_dot<float>, sarray("values"), varray());
+	bind_function(PackedFloat32Array, sum, _VariantCall::func_PackedFloatArray_sum<float>, sarray(), varray());
+	bind_function(PackedFloat32Array, min, _VariantCall::func_PackedFloatArray_min<float>, sarray(), varray());
+	bind_function(PackedFloat32Array, max, _VariantCall::func_PackedFloatArray_max<float>, sarray(), varray());
+
 	/* Float64 Array */
 
 	bind_method(PackedFloat64Array, size, sarray(), varray());
@@ -1970,6 +2119,16 @@ static void _register_variant_builtin_methods() {
 	bind_method(PackedFloat64Array, bsearch, sarray("value", "before"), varray(true));
 	bind_method(PackedFloat64Array, duplicate, sarray(), varray());
 
+	bind_functionnc(PackedFloat64Array, add, _VariantCall::func_PackedFloatArray_add<double>, sarray("values"), varray());
+	bind_functionnc(PackedFloat64Array, add_scalar, _VariantCall::func_PackedFloatArray_add_scalar<double>, sarray("value"), varray());
+	bind_functionnc(PackedFloat64Array, multiply, _VariantCall::func_PackedFloatArray_multiply<double>, sarray("values"), varray());
+	bind_functionnc(PackedFloat64Array, multiply_scalar, _VariantCall::func_PackedFloatArray_multiply_scalar<double>, sarray("value"), varray());
+	bind_functionnc(PackedFloat64Array, fma, _VariantCall::func_PackedFloatArray_fma<double>, sarray("multiplier", "addend"), varray());
+	bind_function(PackedFloat64Array, dot, _VariantCall::func_PackedFloatArray_dot<double>, sarray("values"), varray());
+	bind_function(PackedFloat64Array, sum, _VariantCall::func_PackedFloatArray_sum<double>, sarray(), varray());
+	bind_function(PackedFloat64Array, min, _VariantCall::func_PackedFloatArray_min<double>, sarray(), varray());
+	bind_function(PackedFloat64Array, max, _VariantCall::func_PackedFloatArray_max<double>, sarray(), varray());
+
 	/* String Array */
 
 	bind_method(PackedStringArray, size, sarray(), varray());
@@ -2029,6 +2188,7 @@ static void _register_variant_builtin_methods() {
 	bind_method(PackedVector3Array, sort, sarray(), varray());
 	bind_method(PackedVector3Array, bsearch, sarray("value", "before"), varray(true));
 	bind_method(PackedVector3Array, duplicate, sarray(), varray());
+	bind_functionnc(PackedVector3Array, transform, _VariantCall::func_PackedVector3Array_transform, sarray("transform"), varray());
 
 	/* Color Array */
 
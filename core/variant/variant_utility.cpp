@@ -680,6 +680,15 @@ struct VariantUtilityFunctions {
 		return barr;
 	}
 
+	static inline PackedByteArray var2bytes_compact(const Variant &p_var) {
+		PackedByteArray barr;
+		Error err = encode_variant_compact(p_var, barr, false);
+		if (err != OK) {
+			return PackedByteArray();
+		}
+		return barr;
+	}
+
 	static inline Variant bytes2var(const PackedByteArray &p_arr) {
 		Variant ret;
 		{
@@ -704,6 +713,15 @@ struct VariantUtilityFunctions {
 		return ret;
 	}
 
+	static inline Variant bytes2var_compact(const PackedByteArray &p_arr) {
+		Variant ret;
+		Error err = decode_variant_compact(ret, p_arr.ptr(), p_arr.size(), nullptr, false);
+		if (err != OK) {
+			return Variant();
+		}
+		return ret;
+	}
+
 	static inline int64_t hash(const Variant &p_arr) {
 		return p_arr.hash();
 	}
@@ -1261,6 +1279,9 @@ void Variant::_register_variant_utility_functions() {
 	FUNCBINDR(var2bytes_with_objects, sarray("variable"), Variant::UTILITY_FUNC_TYPE_GENERAL);
 	FUNCBINDR(bytes2var_with_objects, sarray("bytes"), Variant::UTILITY_FUNC_TYPE_GENERAL);
 
+	FUNCBINDR(var2bytes_compact, sarray("variable"), Variant::UTILITY_FUNC_TYPE_GENERAL);
+	FUNCBINDR(bytes2var_compact, sarray("bytes"), Variant::UTILITY_FUNC_TYPE_GENERAL);
+
 	FUNCBINDR(hash, sarray("variable"), Variant::UTILITY_FUNC_TYPE_GENERAL);
 
 	FUNCBINDR(instance_from_id, sarray("instance_id"), Variant::UTILITY_FUNC_TYPE_GENERAL);
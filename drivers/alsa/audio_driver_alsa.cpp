@@ -174,7 +174,7 @@ Error AudioDriverALSA::init() {
 
 	Error err = init_device();
 	if (err == OK) {
-		thread.start(AudioDriverALSA::thread_func, this);
+		thread.start(AudioDriverALSA::thread_func, this, get_thread_settings());
 	}
 
 	return err;
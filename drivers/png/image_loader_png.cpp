@@ -38,6 +38,15 @@
 
 Error ImageLoaderPNG::load_image(Ref<Image> p_image, FileAccess *f, bool p_force_linear, float p_scale) {
 	const uint64_t buffer_size = f->get_length();
+
+	// Decode straight from the file mapping when there is one, instead of copying the file first.
+	const uint8_t *view = f->get_buffer_view(buffer_size);
+	if (view) {
+		Error err = PNGDriverCommon::png_to_image(view, buffer_size, p_force_linear, p_image);
+		f->close();
+		return err;
+	}
+
 	Vector<uint8_t> file_buffer;
 	Error err = file_buffer.resize(buffer_size);
 	if (err) {
@@ -337,7 +337,7 @@ Error AudioDriverPulseAudio::init() {
 	}
 
 	init_device();
-	thread.start(AudioDriverPulseAudio::thread_func, this);
+	thread.start(AudioDriverPulseAudio::thread_func, this, get_thread_settings());
 
 	return OK;
 }
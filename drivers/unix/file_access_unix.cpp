@@ -41,6 +41,7 @@
 #include <errno.h>
 
 #if defined(UNIX_ENABLED)
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 
@@ -70,7 +71,19 @@ void FileAccessUnix::check_errors() const {
 	}
 }
 
+void FileAccessUnix::_unmap() {
+#if defined(UNIX_ENABLED)
+	if (map) {
+		munmap((void *)map, map_size);
+	}
+#endif
+	map = nullptr;
+	map_size = 0;
+	map_failed = false;
+}
+
 Error FileAccessUnix::_open(const String &p_path, int p_mode_flags) {
+	_unmap();
 	if (f) {
 		fclose(f);
 	}
@@ -153,6 +166,7 @@ void FileAccessUnix::close() {
 		return;
 	}
 
+	_unmap();
 	fclose(f);
 	f = nullptr;
 
@@ -248,6 +262,43 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 };
 
+const uint8_t *FileAccessUnix::get_buffer_view(uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(!f, nullptr, "File must be opened before use.");
+
+#if defined(UNIX_ENABLED)
+	if (flags != READ) {
+		return nullptr; // Writes may still be in the stdio buffer.
+	}
+
+	if (!map && !map_failed) {
+		struct stat st;
+		if (fstat(fileno(f), &st) == 0 && st.st_size > 0 && (uint64_t)(size_t)st.st_size == (uint64_t)st.st_size) {
+			void *mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+			if (mapped != MAP_FAILED) {
+				map = (const uint8_t *)mapped;
+				map_size = st.st_size;
+			}
+		}
+		map_failed = map == nullptr;
+	}
+	if (!map) {
+		return nullptr;
+	}
+
+	int64_t pos = ftello(f);
+	if (pos < 0 || (uint64_t)pos > map_size || p_length > map_size - pos) {
+		return nullptr;
+	}
+	if (fseeko(f, pos + p_length, SEEK_SET)) {
+		check_errors();
+		return nullptr;
+	}
+	return map + pos;
+#else
+	return nullptr;
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
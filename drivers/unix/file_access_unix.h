@@ -49,6 +49,12 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	// Whole file mapping for get_buffer_view(), created on first use.
+	mutable const uint8_t *map = nullptr;
+	mutable uint64_t map_size = 0;
+	mutable bool map_failed = false;
+	void _unmap();
+
 	static FileAccess *create_libc();
 
 public:
@@ -70,6 +76,7 @@ public:
 
 	virtual uint8_t get_8() const; ///< get a byte
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const;
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const;
 
 	virtual Error get_error() const; ///< get last error
 
@@ -593,6 +593,51 @@ Error NetSocketPosix::recvfrom(uint8_t *p_buffer, int p_len, int &r_read, IPAddr
 	return OK;
 }
 
+Error NetSocketPosix::recvfrom_batch(Datagram *p_datagrams, int p_count, int &r_received) {
+#if defined(__linux__)
+	ERR_FAIL_COND_V(!is_open(), ERR_UNCONFIGURED);
+	ERR_FAIL_COND_V(p_count < 1, ERR_INVALID_PARAMETER);
+
+	r_received = 0;
+	p_count = MIN(p_count, (int)RECV_BATCH_MAX);
+
+	struct mmsghdr msgs[RECV_BATCH_MAX];
+	struct iovec iovecs[RECV_BATCH_MAX];
+	struct sockaddr_storage addrs[RECV_BATCH_MAX];
+	memset(msgs, 0, sizeof(struct mmsghdr) * p_count);
+	for (int i = 0; i < p_count; i++) {
+		iovecs[i].iov_base = p_datagrams[i].buffer;
+		iovecs[i].iov_len = p_datagrams[i].length;
+		msgs[i].msg_hdr.msg_name = &addrs[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+		msgs[i].msg_hdr.msg_iov = &iovecs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	// Only the first datagram may block, the call returns with whatever is queued after it.
+	int received = ::recvmmsg(_sock, msgs, p_count, MSG_WAITFORONE, nullptr);
+
+	if (received < 0) {
+		NetError err = _get_socket_error();
+		if (err == ERR_NET_WOULD_BLOCK) {
+			return ERR_BUSY;
+		}
+
+		return FAILED;
+	}
+
+	for (int i = 0; i < received; i++) {
+		p_datagrams[i].length = msgs[i].msg_len;
+		_set_ip_port(&addrs[i], &p_datagrams[i].ip, &p_datagrams[i].port);
+	}
+	r_received = received;
+
+	return OK;
+#else
+	return NetSocket::recvfrom_batch(p_datagrams, p_count, r_received);
+#endif
+}
+
 Error NetSocketPosix::send(const uint8_t *p_buffer, int p_len, int &r_sent) {
 	ERR_FAIL_COND_V(!is_open(), ERR_UNCONFIGURED);
 
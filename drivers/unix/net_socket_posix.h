@@ -59,6 +59,10 @@ private:
 		ERR_NET_OTHER,
 	};
 
+	enum {
+		RECV_BATCH_MAX = 32,
+	};
+
 	NetError _get_socket_error() const;
 	void _set_socket(SOCKET_TYPE p_sock, IP::Type p_ip_type, bool p_is_stream);
 	_FORCE_INLINE_ Error _change_multicast_group(IPAddress p_ip, String p_if_name, bool p_add);
@@ -85,6 +89,7 @@ public:
 	virtual Error recvfrom(uint8_t *p_buffer, int p_len, int &r_read, IPAddress &r_ip, uint16_t &r_port, bool p_peek = false);
 	virtual Error send(const uint8_t *p_buffer, int p_len, int &r_sent);
 	virtual Error sendto(const uint8_t *p_buffer, int p_len, int &r_sent, IPAddress p_ip, uint16_t p_port);
+	virtual Error recvfrom_batch(Datagram *p_datagrams, int p_count, int &r_received);
 	virtual Ref<NetSocket> accept(IPAddress &r_ip, uint16_t &r_port);
 
 	virtual bool is_open() const;
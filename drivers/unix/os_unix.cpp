@@ -35,6 +35,7 @@
 #include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
 #include "core/debugger/script_debugger.h"
+#include "core/templates/hash_map.h"
 #include "drivers/unix/dir_access_unix.h"
 #include "drivers/unix/file_access_unix.h"
 #include "drivers/unix/net_socket_posix.h"
@@ -458,6 +459,138 @@ int OS_Unix::get_processor_count() const {
 	return sysconf(_SC_NPROCESSORS_CONF);
 }
 
+#ifdef __linux__
+static bool _read_sysfs_line(const char *p_path, char *r_buffer, int p_size) {
+	FILE *f = fopen(p_path, "r");
+	if (!f) {
+		return false;
+	}
+	bool read = fgets(r_buffer, p_size, f) != nullptr;
+	fclose(f);
+	return read;
+}
+
+static int64_t _read_sysfs_int(const char *p_path, int64_t p_default) {
+	char buffer[64];
+	if (!_read_sysfs_line(p_path, buffer, sizeof(buffer))) {
+		return p_default;
+	}
+	return strtoll(buffer, nullptr, 10);
+}
+
+// Parses processor lists like "0-3,8,10-11".
+static Vector<int> _parse_cpu_list(const char *p_list) {
+	Vector<int> cpus;
+	const char *c = p_list;
+	while (*c >= '0' && *c <= '9') {
+		char *end;
+		int from = strtol(c, &end, 10);
+		int to = from;
+		if (*end == '-') {
+			to = strtol(end + 1, &end, 10);
+		}
+		for (int i = from; i <= to; i++) {
+			cpus.push_back(i);
+		}
+		c = *end == ',' ? end + 1 : end;
+	}
+	return cpus;
+}
+#endif
+
+Vector<OS::ProcessorInfo> OS_Unix::_query_processor_topology() const {
+	Vector<ProcessorInfo> topology = OS::_query_processor_topology();
+
+#ifdef __linux__
+	// Also covers Android.
+	const int count = topology.size();
+	char path[128];
+	char buffer[1024];
+
+	HashMap<int64_t, int> cores;
+	HashMap<int, int> cache_domains;
+	Vector<int64_t> capacities;
+	capacities.resize(count);
+
+	for (int i = 0; i < count; i++) {
+		ProcessorInfo &info = topology.write[i];
+
+		// Physical cores and cache domains are numbered in order of appearance.
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", i);
+		int64_t package = _read_sysfs_int(path, 0);
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/core_id", i);
+		int64_t core = _read_sysfs_int(path, -1);
+		int64_t core_key = core < 0 ? -(i + 1) : ((package << 32) | core);
+		if (!cores.has(core_key)) {
+			int index = cores.size();
+			cores[core_key] = index;
+		}
+		info.core = cores[core_key];
+
+		// The last level cache is identified by the first processor sharing it.
+		int cache_key = i;
+		int cache_level = 0;
+		for (int index = 0;; index++) {
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/level", i, index);
+			int level = _read_sysfs_int(path, -1);
+			if (level < 0) {
+				break;
+			}
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/shared_cpu_list", i, index);
+			if (level >= cache_level && _read_sysfs_line(path, buffer, sizeof(buffer))) {
+				Vector<int> shared = _parse_cpu_list(buffer);
+				if (!shared.is_empty()) {
+					cache_key = shared[0];
+					cache_level = level;
+				}
+			}
+		}
+		if (!cache_domains.has(cache_key)) {
+			int index = cache_domains.size();
+			cache_domains[cache_key] = index;
+		}
+		info.cache_domain = cache_domains[cache_key];
+
+		// ARM reports the relative capacity of big and little cores, otherwise use the maximum frequency.
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpu_capacity", i);
+		capacities.write[i] = _read_sysfs_int(path, -1);
+		if (capacities[i] < 0) {
+			snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", i);
+			capacities.write[i] = _read_sysfs_int(path, 0);
+		}
+	}
+
+	if (_read_sysfs_line("/sys/devices/cpu_atom/cpus", buffer, sizeof(buffer))) {
+		// Intel hybrid CPUs list their efficiency cores, which is more reliable than frequencies.
+		for (int cpu : _parse_cpu_list(buffer)) {
+			if (cpu < count) {
+				topology.write[cpu].core_class = 1;
+			}
+		}
+	} else {
+		// Cores within 15% of the fastest one of a class belong to it, so small per core
+		// frequency differences (favored cores) don't create extra classes.
+		Vector<int64_t> sorted = capacities;
+		sorted.sort();
+		int64_t class_start = sorted.is_empty() ? 0 : sorted[sorted.size() - 1];
+		int core_class = 0;
+		HashMap<int64_t, int> classes;
+		for (int i = sorted.size() - 1; i >= 0; i--) {
+			if (sorted[i] * 100 < class_start * 85) {
+				core_class++;
+				class_start = sorted[i];
+			}
+			classes[sorted[i]] = core_class;
+		}
+		for (int i = 0; i < count; i++) {
+			topology.write[i].core_class = classes[capacities[i]];
+		}
+	}
+#endif
+
+	return topology;
+}
+
 String OS_Unix::get_user_data_dir() const {
 	String appname = get_safe_dir_name(ProjectSettings::get_singleton()->get("application/config/name"));
 	if (appname != "") {
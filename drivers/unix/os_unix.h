@@ -47,6 +47,8 @@ protected:
 
 	virtual void finalize_core() override;
 
+	virtual Vector<ProcessorInfo> _query_processor_topology() const override;
+
 	String stdin_buf;
 
 public:
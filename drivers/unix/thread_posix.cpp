@@ -39,6 +39,15 @@
 #include <pthread_np.h>
 #endif
 
+#if defined(__APPLE__)
+#include <pthread/qos.h>
+#elif defined(__linux__)
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 static Error set_name(const String &p_name) {
 #ifdef PTHREAD_NO_RENAME
 	return ERR_UNAVAILABLE;
@@ -69,8 +78,52 @@ static Error set_name(const String &p_name) {
 #endif // PTHREAD_NO_RENAME
 }
 
+static void set_priority(Thread::Priority p_priority) {
+#if defined(__APPLE__)
+	// Quality of service classes also decide whether Apple Silicon runs the thread on performance or efficiency cores.
+	qos_class_t qos_class = QOS_CLASS_DEFAULT;
+	switch (p_priority) {
+		case Thread::PRIORITY_LOW:
+			qos_class = QOS_CLASS_UTILITY;
+			break;
+		case Thread::PRIORITY_NORMAL:
+			qos_class = QOS_CLASS_DEFAULT;
+			break;
+		case Thread::PRIORITY_HIGH:
+			qos_class = QOS_CLASS_USER_INTERACTIVE;
+			break;
+	}
+	pthread_set_qos_class_self_np(qos_class, 0);
+#elif defined(__linux__)
+	// Linux threads have their own nice value. Raising the priority needs privileges, so it may fail
+	// and the thread keeps the default one.
+	if (p_priority != Thread::PRIORITY_NORMAL) {
+		setpriority(PRIO_PROCESS, syscall(SYS_gettid), p_priority == Thread::PRIORITY_LOW ? 5 : -5);
+	}
+#endif
+}
+
+#if defined(__linux__)
+static Error set_affinity(uint64_t p_mask) {
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (int i = 0; i < 64; i++) {
+		if (p_mask & (uint64_t(1) << i)) {
+			CPU_SET(i, &set);
+		}
+	}
+	// On Linux, zero means the calling thread.
+	return sched_setaffinity(0, sizeof(set), &set) == 0 ? OK : ERR_INVALID_PARAMETER;
+}
+#endif
+
 void init_thread_posix() {
-	Thread::_set_platform_funcs(&set_name, nullptr);
+#if defined(__linux__)
+	Thread::_set_platform_funcs(&set_name, &set_priority, nullptr, nullptr, &set_affinity);
+#else
+	// Affinity is only supported on Linux, Apple platforms place threads according to their priority instead.
+	Thread::_set_platform_funcs(&set_name, &set_priority);
+#endif
 }
 
 #endif
@@ -1513,6 +1513,7 @@ Error RenderingDeviceVulkan::_staging_buffer_allocate(uint32_t p_amount, uint32_
 						} else {
 							//flush EVERYTHING including setup commands. IF not immediate, also need to flush the draw commands
 							_flush(true);
+							staging_buffer_flush_count.increment();
 
 							//clear the whole staging buffer
 							for (int i = 0; i < staging_buffer_blocks.size(); i++) {
@@ -1556,6 +1557,7 @@ Error RenderingDeviceVulkan::_staging_buffer_allocate(uint32_t p_amount, uint32_
 					continue; //and try again
 				} else {
 					_flush(false);
+					staging_buffer_flush_count.increment();
 
 					for (int i = 0; i < staging_buffer_blocks.size(); i++) {
 						//clear all blocks but the ones from this frame
@@ -1592,7 +1594,7 @@ Error RenderingDeviceVulkan::_buffer_update(Buffer *p_buffer, size_t p_offset, c
 		uint32_t block_write_offset;
 		uint32_t block_write_amount;
 
-		Error err = _staging_buffer_allocate(MIN(to_submit, staging_buffer_block_size), p_required_align, block_write_offset, block_write_amount, p_use_draw_command_buffer);
+		Error err = _staging_buffer_allocate(MIN(to_submit, staging_buffer_block_size), p_required_align, block_write_offset, block_write_amount, true, p_use_draw_command_buffer);
 		if (err) {
 			return err;
 		}
@@ -2293,6 +2295,50 @@ Error RenderingDeviceVulkan::texture_update(RID p_texture, uint32_t p_layer, con
 	return _texture_update(p_texture, p_layer, p_data, p_post_barrier, false);
 }
 
+void RenderingDeviceVulkan::_copy_image_region(const uint8_t *p_src, uint8_t *p_dst, DataFormat p_format, uint32_t p_x, uint32_t p_y, uint32_t p_region_w, uint32_t p_region_h, uint32_t p_width) {
+	uint32_t block_w, block_h;
+	get_compressed_image_format_block_dimensions(p_format, block_w, block_h);
+
+	if (block_w != 1 || block_h != 1) {
+		//compressed image (blocks)
+		//must copy a block region
+
+		uint32_t block_size = get_compressed_image_format_block_byte_size(p_format);
+		//re-create current variables in blocky format
+		uint32_t xb = p_x / block_w;
+		uint32_t yb = p_y / block_h;
+		uint32_t wb = p_width / block_w;
+		uint32_t region_wb = p_region_w / block_w;
+		uint32_t region_hb = p_region_h / block_h;
+		for (uint32_t xr = 0; xr < region_wb; xr++) {
+			for (uint32_t yr = 0; yr < region_hb; yr++) {
+				uint32_t src_offset = ((yr + yb) * wb + xr + xb) * block_size;
+				uint32_t dst_offset = (yr * region_wb + xr) * block_size;
+				//copy block
+				for (uint32_t i = 0; i < block_size; i++) {
+					p_dst[dst_offset + i] = p_src[src_offset + i];
+				}
+			}
+		}
+
+	} else {
+		//regular image (pixels)
+		//must copy a pixel region
+
+		uint32_t pixel_size = get_image_format_pixel_size(p_format);
+		for (uint32_t xr = 0; xr < p_region_w; xr++) {
+			for (uint32_t yr = 0; yr < p_region_h; yr++) {
+				uint32_t src_offset = ((yr + p_y) * p_width + xr + p_x) * pixel_size;
+				uint32_t dst_offset = (yr * p_region_w + xr) * pixel_size;
+				//copy block
+				for (uint32_t i = 0; i < pixel_size; i++) {
+					p_dst[dst_offset + i] = p_src[src_offset + i];
+				}
+			}
+		}
+	}
+}
+
 Error RenderingDeviceVulkan::_texture_update(RID p_texture, uint32_t p_layer, const Vector<uint8_t> &p_data, uint32_t p_post_barrier, bool p_use_setup_queue) {
 	_THREAD_SAFE_METHOD_
 
@@ -2410,44 +2456,7 @@ Error RenderingDeviceVulkan::_texture_update(RID p_texture, uint32_t p_layer, co
 					ERR_FAIL_COND_V(region_w % block_w, ERR_BUG);
 					ERR_FAIL_COND_V(region_h % block_h, ERR_BUG);
 
-					if (block_w != 1 || block_h != 1) {
-						//compressed image (blocks)
-						//must copy a block region
-
-						uint32_t block_size = get_compressed_image_format_block_byte_size(texture->format);
-						//re-create current variables in blocky format
-						uint32_t xb = x / block_w;
-						uint32_t yb = y / block_h;
-						uint32_t wb = width / block_w;
-						//uint32_t hb = height / block_h;
-						uint32_t region_wb = region_w / block_w;
-						uint32_t region_hb = region_h / block_h;
-						for (uint32_t xr = 0; xr < region_wb; xr++) {
-							for (uint32_t yr = 0; yr < region_hb; yr++) {
-								uint32_t src_offset = ((yr + yb) * wb + xr + xb) * block_size;
-								uint32_t dst_offset = (yr * region_wb + xr) * block_size;
-								//copy block
-								for (uint32_t i = 0; i < block_size; i++) {
-									write_ptr[dst_offset + i] = read_ptr[src_offset + i];
-								}
-							}
-						}
-
-					} else {
-						//regular image (pixels)
-						//must copy a pixel region
-
-						for (uint32_t xr = 0; xr < region_w; xr++) {
-							for (uint32_t yr = 0; yr < region_h; yr++) {
-								uint32_t src_offset = ((yr + y) * width + xr + x) * pixel_size;
-								uint32_t dst_offset = (yr * region_w + xr) * pixel_size;
-								//copy block
-								for (uint32_t i = 0; i < pixel_size; i++) {
-									write_ptr[dst_offset + i] = read_ptr[src_offset + i];
-								}
-							}
-						}
-					}
+					_copy_image_region(read_ptr, write_ptr, texture->format, x, y, region_w, region_h, width);
 
 					{ //unmap
 						vmaUnmapMemory(allocator, staging_buffer_blocks[staging_buffer_current].allocation);
@@ -2598,6 +2607,98 @@ Vector<uint8_t> RenderingDeviceVulkan::_texture_get_data_from_image(Texture *tex
 	return image_data;
 }
 
+uint32_t RenderingDeviceVulkan::_texture_copy_to_buffer(Texture *tex, uint32_t p_layer, Buffer *r_buffer) {
+	//compute total image size
+	uint32_t width, height, depth;
+	uint32_t buffer_size = get_image_format_required_size(tex->format, tex->width, tex->height, tex->depth, tex->mipmaps, &width, &height, &depth);
+
+	//allocate buffer
+	VkCommandBuffer command_buffer = frames[frame].draw_command_buffer; //makes more sense to retrieve
+	Buffer &tmp_buffer = *r_buffer;
+	_buffer_allocate(&tmp_buffer, buffer_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
+
+	{ //Source image barrier
+		VkImageMemoryBarrier image_memory_barrier;
+		image_memory_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		image_memory_barrier.pNext = nullptr;
+		image_memory_barrier.srcAccessMask = 0;
+		image_memory_barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		image_memory_barrier.oldLayout = tex->layout;
+		image_memory_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+		image_memory_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		image_memory_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		image_memory_barrier.image = tex->image;
+		image_memory_barrier.subresourceRange.aspectMask = tex->barrier_aspect_mask;
+		image_memory_barrier.subresourceRange.baseMipLevel = 0;
+		image_memory_barrier.subresourceRange.levelCount = tex->mipmaps;
+		image_memory_barrier.subresourceRange.baseArrayLayer = p_layer;
+		image_memory_barrier.subresourceRange.layerCount = 1;
+
+		vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &image_memory_barrier);
+	}
+
+	uint32_t computed_w = tex->width;
+	uint32_t computed_h = tex->height;
+	uint32_t computed_d = tex->depth;
+
+	uint32_t prev_size = 0;
+	uint32_t offset = 0;
+	for (uint32_t i = 0; i < tex->mipmaps; i++) {
+		VkBufferImageCopy buffer_image_copy;
+
+		uint32_t image_size = get_image_format_required_size(tex->format, tex->width, tex->height, tex->depth, i + 1);
+		uint32_t size = image_size - prev_size;
+		prev_size = image_size;
+
+		buffer_image_copy.bufferOffset = offset;
+		buffer_image_copy.bufferImageHeight = 0;
+		buffer_image_copy.bufferRowLength = 0;
+		buffer_image_copy.imageSubresource.aspectMask = tex->read_aspect_mask;
+		buffer_image_copy.imageSubresource.baseArrayLayer = p_layer;
+		buffer_image_copy.imageSubresource.layerCount = 1;
+		buffer_image_copy.imageSubresource.mipLevel = i;
+		buffer_image_copy.imageOffset.x = 0;
+		buffer_image_copy.imageOffset.y = 0;
+		buffer_image_copy.imageOffset.z = 0;
+		buffer_image_copy.imageExtent.width = computed_w;
+		buffer_image_copy.imageExtent.height = computed_h;
+		buffer_image_copy.imageExtent.depth = computed_d;
+
+		vkCmdCopyImageToBuffer(command_buffer, tex->image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, tmp_buffer.buffer, 1, &buffer_image_copy);
+
+		computed_w = MAX(1, computed_w >> 1);
+		computed_h = MAX(1, computed_h >> 1);
+		computed_d = MAX(1, computed_d >> 1);
+		offset += size;
+	}
+
+	{ //restore src
+		VkImageMemoryBarrier image_memory_barrier;
+		image_memory_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		image_memory_barrier.pNext = nullptr;
+		image_memory_barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		image_memory_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		if (tex->usage_flags & TEXTURE_USAGE_STORAGE_BIT) {
+			image_memory_barrier.dstAccessMask |= VK_ACCESS_SHADER_WRITE_BIT;
+		}
+		image_memory_barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		image_memory_barrier.newLayout = tex->layout;
+		image_memory_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		image_memory_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		image_memory_barrier.image = tex->image;
+		image_memory_barrier.subresourceRange.aspectMask = tex->barrier_aspect_mask;
+		image_memory_barrier.subresourceRange.baseMipLevel = 0;
+		image_memory_barrier.subresourceRange.levelCount = tex->mipmaps;
+		image_memory_barrier.subresourceRange.baseArrayLayer = p_layer;
+		image_memory_barrier.subresourceRange.layerCount = 1;
+
+		vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &image_memory_barrier);
+	}
+
+	return buffer_size;
+}
+
 Vector<uint8_t> RenderingDeviceVulkan::texture_get_data(RID p_texture, uint32_t p_layer) {
 	_THREAD_SAFE_METHOD_
 
@@ -2619,93 +2720,8 @@ Vector<uint8_t> RenderingDeviceVulkan::texture_get_data(RID p_texture, uint32_t
 		//does not need anything fancy, map and read.
 		return _texture_get_data_from_image(tex, tex->image, tex->allocation, p_layer);
 	} else {
-		//compute total image size
-		uint32_t width, height, depth;
-		uint32_t buffer_size = get_image_format_required_size(tex->format, tex->width, tex->height, tex->depth, tex->mipmaps, &width, &height, &depth);
-
-		//allocate buffer
-		VkCommandBuffer command_buffer = frames[frame].draw_command_buffer; //makes more sense to retrieve
 		Buffer tmp_buffer;
-		_buffer_allocate(&tmp_buffer, buffer_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
-
-		{ //Source image barrier
-			VkImageMemoryBarrier image_memory_barrier;
-			image_memory_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-			image_memory_barrier.pNext = nullptr;
-			image_memory_barrier.srcAccessMask = 0;
-			image_memory_barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-			image_memory_barrier.oldLayout = tex->layout;
-			image_memory_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-
-			image_memory_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-			image_memory_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-			image_memory_barrier.image = tex->image;
-			image_memory_barrier.subresourceRange.aspectMask = tex->barrier_aspect_mask;
-			image_memory_barrier.subresourceRange.baseMipLevel = 0;
-			image_memory_barrier.subresourceRange.levelCount = tex->mipmaps;
-			image_memory_barrier.subresourceRange.baseArrayLayer = p_layer;
-			image_memory_barrier.subresourceRange.layerCount = 1;
-
-			vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &image_memory_barrier);
-		}
-
-		uint32_t computed_w = tex->width;
-		uint32_t computed_h = tex->height;
-		uint32_t computed_d = tex->depth;
-
-		uint32_t prev_size = 0;
-		uint32_t offset = 0;
-		for (uint32_t i = 0; i < tex->mipmaps; i++) {
-			VkBufferImageCopy buffer_image_copy;
-
-			uint32_t image_size = get_image_format_required_size(tex->format, tex->width, tex->height, tex->depth, i + 1);
-			uint32_t size = image_size - prev_size;
-			prev_size = image_size;
-
-			buffer_image_copy.bufferOffset = offset;
-			buffer_image_copy.bufferImageHeight = 0;
-			buffer_image_copy.bufferRowLength = 0;
-			buffer_image_copy.imageSubresource.aspectMask = tex->read_aspect_mask;
-			buffer_image_copy.imageSubresource.baseArrayLayer = p_layer;
-			buffer_image_copy.imageSubresource.layerCount = 1;
-			buffer_image_copy.imageSubresource.mipLevel = i;
-			buffer_image_copy.imageOffset.x = 0;
-			buffer_image_copy.imageOffset.y = 0;
-			buffer_image_copy.imageOffset.z = 0;
-			buffer_image_copy.imageExtent.width = computed_w;
-			buffer_image_copy.imageExtent.height = computed_h;
-			buffer_image_copy.imageExtent.depth = computed_d;
-
-			vkCmdCopyImageToBuffer(command_buffer, tex->image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, tmp_buffer.buffer, 1, &buffer_image_copy);
-
-			computed_w = MAX(1, computed_w >> 1);
-			computed_h = MAX(1, computed_h >> 1);
-			computed_d = MAX(1, computed_d >> 1);
-			offset += size;
-		}
-
-		{ //restore src
-			VkImageMemoryBarrier image_memory_barrier;
-			image_memory_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-			image_memory_barrier.pNext = nullptr;
-			image_memory_barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-			image_memory_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-			if (tex->usage_flags & TEXTURE_USAGE_STORAGE_BIT) {
-				image_memory_barrier.dstAccessMask |= VK_ACCESS_SHADER_WRITE_BIT;
-			}
-			image_memory_barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-			image_memory_barrier.newLayout = tex->layout;
-			image_memory_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-			image_memory_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-			image_memory_barrier.image = tex->image;
-			image_memory_barrier.subresourceRange.aspectMask = tex->barrier_aspect_mask;
-			image_memory_barrier.subresourceRange.baseMipLevel = 0;
-			image_memory_barrier.subresourceRange.levelCount = tex->mipmaps;
-			image_memory_barrier.subresourceRange.baseArrayLayer = p_layer;
-			image_memory_barrier.subresourceRange.layerCount = 1;
-
-			vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &image_memory_barrier);
-		}
+		uint32_t buffer_size = _texture_copy_to_buffer(tex, p_layer, &tmp_buffer);
 
 		_flush(true);
 
@@ -4932,6 +4948,13 @@ Vector<uint8_t> RenderingDeviceVulkan::shader_compile_binary_from_spirv(const Ve
 	return ret;
 }
 
+bool RenderingDeviceVulkan::_is_descriptor_partially_bound(VkDescriptorType p_type, uint32_t p_count) const {
+	if (!device_capabilities.supports_descriptor_indexing || p_count <= 1) {
+		return false;
+	}
+	return p_type == VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE || p_type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+}
+
 RID RenderingDeviceVulkan::shader_create_from_bytecode(const Vector<uint8_t> &p_shader_binary) {
 	const uint8_t *binptr = p_shader_binary.ptr();
 	uint32_t binsize = p_shader_binary.size();
@@ -5180,6 +5203,25 @@ RID RenderingDeviceVulkan::shader_create_from_bytecode(const Vector<uint8_t> &p_
 			layout_create_info.bindingCount = set_bindings[i].size();
 			layout_create_info.pBindings = set_bindings[i].ptr();
 
+			//texture arrays are partially bound when supported, so they can be used as bindless tables
+			Vector<VkDescriptorBindingFlagsEXT> binding_flags;
+			bool has_partially_bound = false;
+			for (int j = 0; j < set_bindings[i].size(); j++) {
+				const VkDescriptorSetLayoutBinding &binding = set_bindings[i][j];
+				bool partially_bound = _is_descriptor_partially_bound(binding.descriptorType, binding.descriptorCount);
+				binding_flags.push_back(partially_bound ? VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT : 0);
+				has_partially_bound = has_partially_bound || partially_bound;
+			}
+
+			VkDescriptorSetLayoutBindingFlagsCreateInfoEXT binding_flags_create_info;
+			if (has_partially_bound) {
+				binding_flags_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+				binding_flags_create_info.pNext = nullptr;
+				binding_flags_create_info.bindingCount = binding_flags.size();
+				binding_flags_create_info.pBindingFlags = binding_flags.ptr();
+				layout_create_info.pNext = &binding_flags_create_info;
+			}
+
 			VkDescriptorSetLayout layout;
 			VkResult res = vkCreateDescriptorSetLayout(device, &layout_create_info, nullptr, &layout);
 			if (res) {
@@ -5266,6 +5308,7 @@ RID RenderingDeviceVulkan::shader_create_from_bytecode(const Vector<uint8_t> &p_
 		ERR_FAIL_V_MSG(RID(), error_text);
 	}
 
+	shader_create_count.increment();
 	return shader_owner.make_rid(shader);
 }
 
@@ -5585,7 +5628,11 @@ RID RenderingDeviceVulkan::uniform_set_create(const Vector<Uniform> &p_uniforms,
 
 			} break;
 			case UNIFORM_TYPE_SAMPLER_WITH_TEXTURE: {
-				if (uniform.ids.size() != set_uniform.length * 2) {
+				if (_is_descriptor_partially_bound(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, set_uniform.length)) {
+					if (uniform.ids.size() == 0 || uniform.ids.size() > set_uniform.length * 2 || (uniform.ids.size() & 1)) {
+						ERR_FAIL_V_MSG(RID(), "SamplerTexture (binding: " + itos(uniform.binding) + ") is a partially bound array of (" + itos(set_uniform.length) + ") sampler&texture elements, so it should be provided between one and that many sampler,texture ID pairs (IDs provided: " + itos(uniform.ids.size()) + ").");
+					}
+				} else if (uniform.ids.size() != set_uniform.length * 2) {
 					if (set_uniform.length > 1) {
 						ERR_FAIL_V_MSG(RID(), "SamplerTexture (binding: " + itos(uniform.binding) + ") is an array of (" + itos(set_uniform.length) + ") sampler&texture elements, so it should provided twice the amount of IDs (sampler,texture pairs) to satisfy it (IDs provided: " + itos(uniform.ids.size()) + ").");
 					} else {
@@ -5641,7 +5688,11 @@ RID RenderingDeviceVulkan::uniform_set_create(const Vector<Uniform> &p_uniforms,
 
 			} break;
 			case UNIFORM_TYPE_TEXTURE: {
-				if (uniform.ids.size() != set_uniform.length) {
+				if (_is_descriptor_partially_bound(VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, set_uniform.length)) {
+					if (uniform.ids.size() == 0 || uniform.ids.size() > set_uniform.length) {
+						ERR_FAIL_V_MSG(RID(), "Texture (binding: " + itos(uniform.binding) + ") is a partially bound array of (" + itos(set_uniform.length) + ") textures, so it should be provided between one and that many texture IDs (IDs provided: " + itos(uniform.ids.size()) + ").");
+					}
+				} else if (uniform.ids.size() != set_uniform.length) {
 					if (set_uniform.length > 1) {
 						ERR_FAIL_V_MSG(RID(), "Texture (binding: " + itos(uniform.binding) + ") is an array of (" + itos(set_uniform.length) + ") textures, so it should be provided equal number of texture IDs to satisfy it (IDs provided: " + itos(uniform.ids.size()) + ").");
 					} else {
@@ -6118,6 +6169,554 @@ Vector<uint8_t> RenderingDeviceVulkan::buffer_get_data(RID p_buffer) {
 	return buffer_data;
 }
 
+/*************************/
+/**** ASYNC TRANSFERS ****/
+/*************************/
+
+void RenderingDeviceVulkan::_transfer_retire_completed() {
+	// Batches complete in submission order, so stop at the first one still in flight.
+	while (transfer_batch_submitted > 0) {
+		TransferBatch &batch = transfer_batches[transfer_batch_first];
+		if (vkGetFenceStatus(device, batch.fence) != VK_SUCCESS) {
+			break;
+		}
+
+		transfer_ring_tail = batch.ring_end;
+		transfer_completed_id = batch.id;
+		transfer_batch_first = (transfer_batch_first + 1) % TRANSFER_BATCH_MAX;
+		transfer_batch_submitted--;
+	}
+}
+
+void RenderingDeviceVulkan::_transfer_submit_pending() {
+	// Requires both the device and the transfer mutex to be locked.
+	if (!transfer_batch_open) {
+		return;
+	}
+
+	TransferBatch &batch = transfer_batches[(transfer_batch_first + transfer_batch_submitted) % TRANSFER_BATCH_MAX];
+
+	{
+		// Make the uploads visible to everything submitted after this batch.
+		VkMemoryBarrier mem_barrier;
+		mem_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		mem_barrier.pNext = nullptr;
+		mem_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		mem_barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+		vkCmdPipelineBarrier(batch.command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &mem_barrier, 0, nullptr, 0, nullptr);
+	}
+
+	VkResult err = vkEndCommandBuffer(batch.command_buffer);
+	ERR_FAIL_COND_MSG(err, "vkEndCommandBuffer failed with error " + itos(err) + ".");
+
+	err = vkResetFences(device, 1, &batch.fence);
+	ERR_FAIL_COND_MSG(err, "vkResetFences failed with error " + itos(err) + ".");
+
+	VkSubmitInfo submit_info;
+	submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submit_info.pNext = nullptr;
+	submit_info.waitSemaphoreCount = 0;
+	submit_info.pWaitSemaphores = nullptr;
+	submit_info.pWaitDstStageMask = nullptr;
+	submit_info.commandBufferCount = 1;
+	submit_info.pCommandBuffers = &batch.command_buffer;
+	submit_info.signalSemaphoreCount = 0;
+	submit_info.pSignalSemaphores = nullptr;
+
+	err = vkQueueSubmit(context->get_graphics_queue(), 1, &submit_info, batch.fence);
+	ERR_FAIL_COND_MSG(err, "vkQueueSubmit failed with error " + itos(err) + ".");
+
+	batch.ring_end = transfer_ring_head;
+	transfer_batch_submitted++;
+	transfer_batch_open = false;
+}
+
+Error RenderingDeviceVulkan::_transfer_submit_from_frame_thread() {
+	// The batch being recorded is only submitted by this thread on the next swap, so waiting for it would never return.
+	// Submit it right away instead, after flushing the frame so it stays ordered after it (this is what the regular
+	// staging buffer does when it runs out of blocks). Locks are always taken device first, then transfers.
+	transfer_mutex.unlock();
+	_THREAD_SAFE_LOCK_
+	transfer_mutex.lock();
+
+	Error err = OK;
+	if (transfer_batch_open) {
+		if (draw_list || compute_list) {
+			err = ERR_BUSY;
+		} else {
+			_flush(true);
+			_transfer_submit_pending();
+		}
+	}
+
+	_THREAD_SAFE_UNLOCK_
+
+	ERR_FAIL_COND_V_MSG(err, err, "Async transfers ran out of staging space while creating a draw or compute list, increase the async ring size or upload from another thread.");
+	return OK;
+}
+
+bool RenderingDeviceVulkan::_transfer_try_allocate(uint32_t p_amount, uint32_t p_required_align, uint32_t &r_offset) {
+	_transfer_retire_completed();
+
+	if (!transfer_batch_open && transfer_batch_submitted == TRANSFER_BATCH_MAX) {
+		return false; // No batch left to record into.
+	}
+
+	uint64_t write_from = transfer_ring_head;
+	uint32_t ring_offset = write_from % transfer_ring_size;
+	{
+		uint32_t align_remainder = ring_offset % p_required_align;
+		if (align_remainder != 0) {
+			write_from += p_required_align - align_remainder;
+			ring_offset += p_required_align - align_remainder;
+		}
+	}
+
+	if (ring_offset + p_amount > transfer_ring_size) {
+		// Does not fit before the end, skip to the beginning of the ring.
+		write_from = write_from - ring_offset + transfer_ring_size;
+		ring_offset = 0;
+	}
+
+	if (write_from + p_amount - transfer_ring_tail > transfer_ring_size) {
+		return false; // Would overwrite data still being transferred.
+	}
+
+	if (!transfer_batch_open) {
+		TransferBatch &batch = transfer_batches[(transfer_batch_first + transfer_batch_submitted) % TRANSFER_BATCH_MAX];
+
+		VkCommandBufferBeginInfo cmdbuf_begin;
+		cmdbuf_begin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		cmdbuf_begin.pNext = nullptr;
+		cmdbuf_begin.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		cmdbuf_begin.pInheritanceInfo = nullptr;
+
+		VkResult err = vkResetCommandBuffer(batch.command_buffer, 0);
+		ERR_FAIL_COND_V_MSG(err, false, "vkResetCommandBuffer failed with error " + itos(err) + ".");
+		err = vkBeginCommandBuffer(batch.command_buffer, &cmdbuf_begin);
+		ERR_FAIL_COND_V_MSG(err, false, "vkBeginCommandBuffer failed with error " + itos(err) + ".");
+
+		{
+			// Don't overwrite anything earlier frames may still be using.
+			VkMemoryBarrier mem_barrier;
+			mem_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+			mem_barrier.pNext = nullptr;
+			mem_barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+			mem_barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+			vkCmdPipelineBarrier(batch.command_buffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &mem_barrier, 0, nullptr, 0, nullptr);
+		}
+
+		batch.id = ++transfer_last_id;
+		transfer_batch_open = true;
+	}
+
+	transfer_ring_head = write_from + p_amount;
+	r_offset = ring_offset;
+	return true;
+}
+
+Error RenderingDeviceVulkan::_transfer_allocate(uint32_t p_amount, uint32_t p_required_align, uint32_t &r_offset) {
+	// Called with the transfer mutex locked, it is released while waiting for room.
+	ERR_FAIL_COND_V_MSG(p_amount > transfer_ring_size / 2, ERR_INVALID_PARAMETER,
+			"Async transfer region (" + itos(p_amount) + " bytes) is too large for the async staging ring, increase its size.");
+
+	while (!_transfer_try_allocate(p_amount, p_required_align, r_offset)) {
+		if (transfer_batch_submitted == 0 && Thread::get_caller_id() == frame_thread) {
+			Error err = _transfer_submit_from_frame_thread();
+			if (err) {
+				return err;
+			}
+			continue;
+		}
+
+		transfer_mutex.unlock();
+		OS::get_singleton()->delay_usec(500);
+		transfer_mutex.lock();
+	}
+
+	return OK;
+}
+
+void RenderingDeviceVulkan::_transfer_image_barrier(VkCommandBuffer p_command_buffer, const Texture &p_texture, uint32_t p_layer, bool p_to_transfer) {
+	VkImageMemoryBarrier image_memory_barrier;
+	image_memory_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	image_memory_barrier.pNext = nullptr;
+	image_memory_barrier.srcAccessMask = p_to_transfer ? 0 : VK_ACCESS_TRANSFER_WRITE_BIT;
+	image_memory_barrier.dstAccessMask = p_to_transfer ? VK_ACCESS_TRANSFER_WRITE_BIT : (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT);
+	image_memory_barrier.oldLayout = p_to_transfer ? p_texture.layout : VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	image_memory_barrier.newLayout = p_to_transfer ? VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL : p_texture.layout;
+
+	image_memory_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	image_memory_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	image_memory_barrier.image = p_texture.image;
+	image_memory_barrier.subresourceRange.aspectMask = p_texture.barrier_aspect_mask;
+	image_memory_barrier.subresourceRange.baseMipLevel = 0;
+	image_memory_barrier.subresourceRange.levelCount = p_texture.mipmaps;
+	image_memory_barrier.subresourceRange.baseArrayLayer = p_layer;
+	image_memory_barrier.subresourceRange.layerCount = 1;
+
+	if (p_to_transfer) {
+		vkCmdPipelineBarrier(p_command_buffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &image_memory_barrier);
+	} else {
+		vkCmdPipelineBarrier(p_command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &image_memory_barrier);
+	}
+}
+
+RenderingDevice::TransferID RenderingDeviceVulkan::buffer_update_async(RID p_buffer, uint32_t p_offset, uint32_t p_size, const void *p_data) {
+	ERR_FAIL_COND_V_MSG(local_device.is_valid(), INVALID_ID, "Async transfers are not supported on local devices.");
+	ERR_FAIL_COND_V(p_size == 0, INVALID_ID);
+
+	VkBuffer dst_buffer = VK_NULL_HANDLE;
+	{
+		_THREAD_SAFE_METHOD_
+
+		VkPipelineStageFlags dst_stage_mask = 0;
+		VkAccessFlags dst_access = 0;
+		Buffer *buffer = _get_buffer_from_owner(p_buffer, dst_stage_mask, dst_access, BARRIER_MASK_ALL);
+		if (!buffer) {
+			ERR_FAIL_V_MSG(INVALID_ID, "Buffer argument is not a valid buffer of any type.");
+		}
+
+		ERR_FAIL_COND_V_MSG(p_offset + p_size > buffer->size, INVALID_ID,
+				"Attempted to write buffer (" + itos((p_offset + p_size) - buffer->size) + " bytes) past the end.");
+
+		dst_buffer = buffer->buffer;
+	}
+
+	// The device is not locked from here on, only the transfers while each chunk is written.
+	const uint8_t *r = (const uint8_t *)p_data;
+	uint32_t submit_from = 0;
+	TransferID transfer = INVALID_ID;
+
+	while (submit_from < p_size) {
+		uint32_t amount = MIN(p_size - submit_from, (uint32_t)TRANSFER_CHUNK_SIZE);
+
+		MutexLock lock(transfer_mutex);
+
+		uint32_t ring_offset;
+		Error err = _transfer_allocate(amount, 32, ring_offset);
+		ERR_FAIL_COND_V(err, INVALID_ID);
+
+		memcpy(transfer_ring_ptr + ring_offset, r + submit_from, amount);
+
+		TransferBatch &batch = transfer_batches[(transfer_batch_first + transfer_batch_submitted) % TRANSFER_BATCH_MAX];
+
+		VkBufferCopy region;
+		region.srcOffset = ring_offset;
+		region.dstOffset = p_offset + submit_from;
+		region.size = amount;
+
+		vkCmdCopyBuffer(batch.command_buffer, transfer_ring_buffer, dst_buffer, 1, &region);
+
+		transfer = batch.id;
+		submit_from += amount;
+	}
+
+	return transfer;
+}
+
+RenderingDevice::TransferID RenderingDeviceVulkan::texture_update_async(RID p_texture, uint32_t p_layer, const Vector<uint8_t> &p_data) {
+	ERR_FAIL_COND_V_MSG(local_device.is_valid(), INVALID_ID, "Async transfers are not supported on local devices.");
+
+	Texture texture;
+	{
+		_THREAD_SAFE_METHOD_
+
+		Texture *src_texture = texture_owner.get_or_null(p_texture);
+		ERR_FAIL_COND_V(!src_texture, INVALID_ID);
+
+		if (src_texture->owner != RID()) {
+			src_texture = texture_owner.get_or_null(src_texture->owner);
+			ERR_FAIL_COND_V(!src_texture, INVALID_ID); //this is a bug
+		}
+
+		ERR_FAIL_COND_V_MSG(!(src_texture->usage_flags & TEXTURE_USAGE_CAN_UPDATE_BIT), INVALID_ID,
+				"Texture requires the TEXTURE_USAGE_CAN_UPDATE_BIT in order to be updatable.");
+
+		// Copied, so the device doesn't need to stay locked while uploading.
+		texture = *src_texture;
+	}
+
+	uint32_t layer_count = texture.layers;
+	if (texture.type == TEXTURE_TYPE_CUBE || texture.type == TEXTURE_TYPE_CUBE_ARRAY) {
+		layer_count *= 6;
+	}
+	ERR_FAIL_COND_V(p_layer >= layer_count, INVALID_ID);
+
+	uint32_t width, height;
+	uint32_t required_size = get_image_format_required_size(texture.format, texture.width, texture.height, texture.depth, texture.mipmaps, &width, &height);
+	uint32_t required_align = get_compressed_image_format_block_byte_size(texture.format);
+	if (required_align == 1) {
+		required_align = get_image_format_pixel_size(texture.format);
+	}
+	if ((required_align % 4) != 0) { //alignment rules are really strange
+		required_align *= 4;
+	}
+
+	ERR_FAIL_COND_V_MSG(required_size != (uint32_t)p_data.size(), INVALID_ID,
+			"Required size for texture update (" + itos(required_size) + ") does not match data supplied size (" + itos(p_data.size()) + ").");
+
+	uint32_t region_size = texture_upload_region_size_px;
+	uint32_t pixel_size = get_image_format_pixel_size(texture.format);
+	uint32_t block_w, block_h;
+	get_compressed_image_format_block_dimensions(texture.format, block_w, block_h);
+
+	const uint8_t *r = p_data.ptr();
+
+	// Regions are written in chunks, the layout transitions are repeated for every chunk because the batch may be
+	// submitted while the transfer mutex is released in between.
+	TransferID transfer = INVALID_ID;
+	VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+	bool chunk_open = false;
+	uint32_t chunk_written = 0;
+
+	transfer_mutex.lock();
+
+	uint32_t mipmap_offset = 0;
+
+	uint32_t logic_width = texture.width;
+	uint32_t logic_height = texture.height;
+
+	for (uint32_t mm_i = 0; mm_i < texture.mipmaps; mm_i++) {
+		uint32_t depth;
+		uint32_t image_total = get_image_format_required_size(texture.format, texture.width, texture.height, texture.depth, mm_i + 1, &width, &height, &depth);
+
+		const uint8_t *read_ptr_mipmap = r + mipmap_offset;
+		uint32_t image_size = image_total - mipmap_offset;
+
+		for (uint32_t z = 0; z < depth; z++) { //for 3D textures, depth may be > 0
+
+			const uint8_t *read_ptr = read_ptr_mipmap + image_size * z / depth;
+
+			for (uint32_t x = 0; x < width; x += region_size) {
+				for (uint32_t y = 0; y < height; y += region_size) {
+					uint32_t region_w = MIN(region_size, width - x);
+					uint32_t region_h = MIN(region_size, height - y);
+
+					uint32_t region_logic_w = MIN(region_size, logic_width - x);
+					uint32_t region_logic_h = MIN(region_size, logic_height - y);
+
+					uint32_t to_allocate = region_w * region_h * pixel_size;
+					to_allocate >>= get_compressed_image_format_pixel_rshift(texture.format);
+
+					uint32_t ring_offset;
+					bool allocated = false;
+
+					if (chunk_open) {
+						if (chunk_written < TRANSFER_CHUNK_SIZE) {
+							allocated = _transfer_try_allocate(to_allocate, required_align, ring_offset);
+						}
+						if (!allocated) {
+							// Close the chunk and give the frame thread a chance to submit.
+							_transfer_image_barrier(command_buffer, texture, p_layer, false);
+							chunk_open = false;
+							transfer_mutex.unlock();
+							OS::get_singleton()->yield();
+							transfer_mutex.lock();
+						}
+					}
+
+					if (!allocated) {
+						Error err = _transfer_allocate(to_allocate, required_align, ring_offset);
+						if (err) {
+							transfer_mutex.unlock();
+							ERR_FAIL_V(INVALID_ID);
+						}
+					}
+
+					if (!chunk_open) {
+						TransferBatch &batch = transfer_batches[(transfer_batch_first + transfer_batch_submitted) % TRANSFER_BATCH_MAX];
+						command_buffer = batch.command_buffer;
+						transfer = batch.id;
+						_transfer_image_barrier(command_buffer, texture, p_layer, true);
+						chunk_open = true;
+						chunk_written = 0;
+					}
+
+					if (region_w % block_w || region_h % block_h) {
+						_transfer_image_barrier(command_buffer, texture, p_layer, false);
+						transfer_mutex.unlock();
+						ERR_FAIL_V(INVALID_ID);
+					}
+
+					_copy_image_region(read_ptr, transfer_ring_ptr + ring_offset, texture.format, x, y, region_w, region_h, width);
+
+					VkBufferImageCopy buffer_image_copy;
+					buffer_image_copy.bufferOffset = ring_offset;
+					buffer_image_copy.bufferRowLength = 0; //tightly packed
+					buffer_image_copy.bufferImageHeight = 0; //tightly packed
+
+					buffer_image_copy.imageSubresource.aspectMask = texture.read_aspect_mask;
+					buffer_image_copy.imageSubresource.mipLevel = mm_i;
+					buffer_image_copy.imageSubresource.baseArrayLayer = p_layer;
+					buffer_image_copy.imageSubresource.layerCount = 1;
+
+					buffer_image_copy.imageOffset.x = x;
+					buffer_image_copy.imageOffset.y = y;
+					buffer_image_copy.imageOffset.z = z;
+
+					buffer_image_copy.imageExtent.width = region_logic_w;
+					buffer_image_copy.imageExtent.height = region_logic_h;
+					buffer_image_copy.imageExtent.depth = 1;
+
+					vkCmdCopyBufferToImage(command_buffer, transfer_ring_buffer, texture.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &buffer_image_copy);
+
+					chunk_written += to_allocate;
+				}
+			}
+		}
+
+		mipmap_offset = image_total;
+		logic_width = MAX(1, logic_width >> 1);
+		logic_height = MAX(1, logic_height >> 1);
+	}
+
+	if (chunk_open) {
+		_transfer_image_barrier(command_buffer, texture, p_layer, false);
+	}
+
+	transfer_mutex.unlock();
+
+	return transfer;
+}
+
+bool RenderingDeviceVulkan::transfer_is_complete(TransferID p_transfer) {
+	MutexLock lock(transfer_mutex);
+	ERR_FAIL_COND_V(p_transfer <= 0 || p_transfer > transfer_last_id, false);
+
+	_transfer_retire_completed();
+	return p_transfer <= transfer_completed_id;
+}
+
+void RenderingDeviceVulkan::transfer_wait(TransferID p_transfer) {
+	MutexLock lock(transfer_mutex);
+	ERR_FAIL_COND(p_transfer <= 0 || p_transfer > transfer_last_id);
+
+	while (true) {
+		_transfer_retire_completed();
+		if (p_transfer <= transfer_completed_id) {
+			break;
+		}
+
+		if (transfer_batch_open && transfer_batch_submitted == 0 && Thread::get_caller_id() == frame_thread) {
+			// Only the open batch is left and it would not be submitted while this thread waits.
+			if (_transfer_submit_from_frame_thread() != OK) {
+				break;
+			}
+			continue;
+		}
+
+		transfer_mutex.unlock();
+		OS::get_singleton()->delay_usec(100);
+		transfer_mutex.lock();
+	}
+}
+
+Error RenderingDeviceVulkan::buffer_get_data_async(RID p_buffer, const Callable &p_callback) {
+	_THREAD_SAFE_METHOD_
+
+	ERR_FAIL_COND_V_MSG(draw_list != nullptr, ERR_INVALID_PARAMETER,
+			"Buffers can't be read back while a draw list is active.");
+	ERR_FAIL_COND_V_MSG(compute_list != nullptr, ERR_INVALID_PARAMETER,
+			"Buffers can't be read back while a compute list is active.");
+
+	VkPipelineShaderStageCreateFlags src_stage_mask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+	VkAccessFlags src_access_mask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	Buffer *buffer = _get_buffer_from_owner(p_buffer, src_stage_mask, src_access_mask, BARRIER_MASK_ALL);
+	if (!buffer) {
+		ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "Buffer is either invalid or this type of buffer can't be retrieved. Only Index and Vertex buffers allow retrieving.");
+	}
+
+	// Unlike buffer_get_data(), the copy goes after everything already recorded this frame, so it sees
+	// the results of previous draw and compute lists.
+	_buffer_memory_barrier(buffer->buffer, 0, buffer->size, src_stage_mask, VK_PIPELINE_STAGE_TRANSFER_BIT, src_access_mask, VK_ACCESS_TRANSFER_READ_BIT, true);
+
+	Frame::Readback readback;
+	readback.size = buffer->size;
+	readback.callback = p_callback;
+	_buffer_allocate(&readback.buffer, buffer->size, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
+
+	VkBufferCopy region;
+	region.srcOffset = 0;
+	region.dstOffset = 0;
+	region.size = buffer->size;
+	vkCmdCopyBuffer(frames[frame].draw_command_buffer, buffer->buffer, readback.buffer.buffer, 1, &region);
+
+	frames[frame].readbacks.push_back(readback);
+
+	return OK;
+}
+
+Error RenderingDeviceVulkan::texture_get_data_async(RID p_texture, uint32_t p_layer, const Callable &p_callback) {
+	_THREAD_SAFE_METHOD_
+
+	Texture *tex = texture_owner.get_or_null(p_texture);
+	ERR_FAIL_COND_V(!tex, ERR_INVALID_PARAMETER);
+
+	ERR_FAIL_COND_V_MSG(tex->bound, ERR_CANT_ACQUIRE_RESOURCE,
+			"Texture can't be retrieved while a render pass that uses it is being created. Ensure render pass is finalized (and that it was created with RENDER_PASS_CONTENTS_FINISH) to unbind this texture.");
+	ERR_FAIL_COND_V_MSG(!(tex->usage_flags & TEXTURE_USAGE_CAN_COPY_FROM_BIT), ERR_INVALID_PARAMETER,
+			"Texture requires the TEXTURE_USAGE_CAN_COPY_FROM_BIT in order to be retrieved.");
+	ERR_FAIL_COND_V_MSG(draw_list != nullptr, ERR_INVALID_PARAMETER,
+			"Textures can't be read back while a draw list is active.");
+	ERR_FAIL_COND_V_MSG(compute_list != nullptr, ERR_INVALID_PARAMETER,
+			"Textures can't be read back while a compute list is active.");
+
+	uint32_t layer_count = tex->layers;
+	if (tex->type == TEXTURE_TYPE_CUBE || tex->type == TEXTURE_TYPE_CUBE_ARRAY) {
+		layer_count *= 6;
+	}
+	ERR_FAIL_COND_V(p_layer >= layer_count, ERR_INVALID_PARAMETER);
+
+	if (tex->usage_flags & TEXTURE_USAGE_CPU_READ_BIT) {
+		//already mappable, no need to wait for a frame
+		Variant data = _texture_get_data_from_image(tex, tex->image, tex->allocation, p_layer);
+		const Variant *args[1] = { &data };
+		p_callback.call_deferred(args, 1);
+		return OK;
+	}
+
+	// The copy only waits on the layout transition, make sure earlier draw and compute writes are visible.
+	_full_barrier(true);
+
+	Frame::Readback readback;
+	readback.callback = p_callback;
+	readback.size = _texture_copy_to_buffer(tex, p_layer, &readback.buffer);
+
+	frames[frame].readbacks.push_back(readback);
+
+	return OK;
+}
+
+void RenderingDeviceVulkan::_readbacks_resolve(int p_frame, bool p_notify) {
+	// The frame fence was waited on, so the copies are done and the memory can be mapped.
+	while (frames[p_frame].readbacks.front()) {
+		Frame::Readback &readback = frames[p_frame].readbacks.front()->get();
+
+		if (p_notify) {
+			void *buffer_mem;
+			VkResult vkerr = vmaMapMemory(allocator, readback.buffer.allocation, &buffer_mem);
+			if (vkerr) {
+				ERR_PRINT("vmaMapMemory failed with error " + itos(vkerr) + ".");
+			} else {
+				Vector<uint8_t> buffer_data;
+				buffer_data.resize(readback.size);
+				memcpy(buffer_data.ptrw(), buffer_mem, readback.size);
+				vmaUnmapMemory(allocator, readback.buffer.allocation);
+
+				Variant data = buffer_data;
+				const Variant *args[1] = { &data };
+				readback.callback.call_deferred(args, 1);
+			}
+		}
+
+		_buffer_free(&readback.buffer);
+		frames[p_frame].readbacks.pop_front();
+	}
+}
+
 /*************************/
 /**** RENDER PIPELINE ****/
 /*************************/
@@ -6513,8 +7112,10 @@ RID RenderingDeviceVulkan::render_pipeline_create(RID p_shader, FramebufferForma
 	graphics_pipeline_create_info.basePipelineIndex = 0;
 
 	RenderPipeline pipeline;
-	VkResult err = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &graphics_pipeline_create_info, nullptr, &pipeline.pipeline);
+	VkResult err = vkCreateGraphicsPipelines(device, pipeline_cache, 1, &graphics_pipeline_create_info, nullptr, &pipeline.pipeline);
 	ERR_FAIL_COND_V_MSG(err, RID(), "vkCreateGraphicsPipelines failed with error " + itos(err) + " for shader '" + shader->name + "'.");
+	pipeline_cache_dirty = true;
+	pipeline_create_count.increment();
 
 	pipeline.set_formats = shader->set_formats;
 	pipeline.push_constant_stages = shader->push_constant.push_constants_vk_stage;
@@ -6625,8 +7226,10 @@ RID RenderingDeviceVulkan::compute_pipeline_create(RID p_shader, const Vector<Pi
 	}
 
 	ComputePipeline pipeline;
-	VkResult err = vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &compute_pipeline_create_info, nullptr, &pipeline.pipeline);
+	VkResult err = vkCreateComputePipelines(device, pipeline_cache, 1, &compute_pipeline_create_info, nullptr, &pipeline.pipeline);
 	ERR_FAIL_COND_V_MSG(err, RID(), "vkCreateComputePipelines failed with error " + itos(err) + ".");
+	pipeline_cache_dirty = true;
+	pipeline_create_count.increment();
 
 	pipeline.set_formats = shader->set_formats;
 	pipeline.push_constant_stages = shader->push_constant.push_constants_vk_stage;
@@ -7384,7 +7987,7 @@ void RenderingDeviceVulkan::draw_list_set_push_constant(DrawListID p_list, const
 #endif
 }
 
-void RenderingDeviceVulkan::draw_list_draw(DrawListID p_list, bool p_use_indices, uint32_t p_instances, uint32_t p_procedural_vertices) {
+void RenderingDeviceVulkan::draw_list_draw(DrawListID p_list, bool p_use_indices, uint32_t p_instances, uint32_t p_procedural_vertices, uint32_t p_first_instance) {
 	DrawList *dl = _get_draw_list_ptr(p_list);
 	ERR_FAIL_COND(!dl);
 #ifdef DEBUG_ENABLED
@@ -7465,7 +8068,7 @@ void RenderingDeviceVulkan::draw_list_draw(DrawListID p_list, bool p_use_indices
 		ERR_FAIL_COND_MSG((to_draw % dl->validation.pipeline_primitive_divisor) != 0,
 				"Index amount (" + itos(to_draw) + ") must be a multiple of the amount of indices required by the render primitive (" + itos(dl->validation.pipeline_primitive_divisor) + ").");
 #endif
-		vkCmdDrawIndexed(dl->command_buffer, to_draw, p_instances, dl->validation.index_array_offset, 0, 0);
+		vkCmdDrawIndexed(dl->command_buffer, to_draw, p_instances, dl->validation.index_array_offset, 0, p_first_instance);
 	} else {
 		uint32_t to_draw;
 
@@ -7491,7 +8094,89 @@ void RenderingDeviceVulkan::draw_list_draw(DrawListID p_list, bool p_use_indices
 				"Vertex amount (" + itos(to_draw) + ") must be a multiple of the amount of vertices required by the render primitive (" + itos(dl->validation.pipeline_primitive_divisor) + ").");
 #endif
 
-		vkCmdDraw(dl->command_buffer, to_draw, p_instances, 0, 0);
+		vkCmdDraw(dl->command_buffer, to_draw, p_instances, 0, p_first_instance);
+	}
+}
+
+void RenderingDeviceVulkan::draw_list_draw_indirect(DrawListID p_list, bool p_use_indices, RID p_buffer, uint32_t p_offset, uint32_t p_draw_count, uint32_t p_stride) {
+	DrawList *dl = _get_draw_list_ptr(p_list);
+	ERR_FAIL_COND(!dl);
+
+	Buffer *buffer = storage_buffer_owner.get_or_null(p_buffer);
+	ERR_FAIL_COND(!buffer);
+
+	ERR_FAIL_COND_MSG(!(buffer->usage & STORAGE_BUFFER_USAGE_DISPATCH_INDIRECT), "Buffer provided was not created to do indirect draws.");
+
+	uint32_t command_size = p_use_indices ? sizeof(VkDrawIndexedIndirectCommand) : sizeof(VkDrawIndirectCommand);
+	if (p_stride == 0) {
+		p_stride = command_size;
+	}
+	ERR_FAIL_COND_MSG(p_draw_count == 0, "At least one draw is required.");
+	ERR_FAIL_COND_MSG(p_stride < command_size || (p_stride % 4) != 0, "Stride must be a multiple of 4 and at least the size of a draw command (" + itos(command_size) + ").");
+	ERR_FAIL_COND_MSG(p_draw_count > 1 && !context->get_physical_device_features().multiDrawIndirect, "More than one draw per indirect command requires multiDrawIndirect support.");
+	ERR_FAIL_COND_MSG(p_offset + (p_draw_count - 1) * p_stride + command_size > buffer->size, "Draw commands go past the end of buffer.");
+
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_COND_MSG(!dl->validation.active, "Submitted Draw Lists can no longer be modified.");
+#endif
+
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_COND_MSG(!dl->validation.pipeline_active,
+			"No render pipeline was set before attempting to draw.");
+	if (dl->validation.pipeline_vertex_format != INVALID_ID) {
+		//pipeline uses vertices, validate format
+		ERR_FAIL_COND_MSG(dl->validation.vertex_format == INVALID_ID,
+				"No vertex array was bound, and render pipeline expects vertices.");
+		//make sure format is right
+		ERR_FAIL_COND_MSG(dl->validation.pipeline_vertex_format != dl->validation.vertex_format,
+				"The vertex format used to create the pipeline does not match the vertex format bound.");
+	}
+
+	if (dl->validation.pipeline_push_constant_size > 0) {
+		//using push constants, check that they were supplied
+		ERR_FAIL_COND_MSG(!dl->validation.pipeline_push_constant_supplied,
+				"The shader in this pipeline requires a push constant to be set before drawing, but it's not present.");
+	}
+
+	if (p_use_indices) {
+		ERR_FAIL_COND_MSG(!dl->validation.index_array_size,
+				"Draw command requested indices, but no index buffer was set.");
+
+		ERR_FAIL_COND_MSG(dl->validation.pipeline_uses_restart_indices != dl->validation.index_buffer_uses_restart_indices,
+				"The usage of restart indices in index buffer does not match the render primitive in the pipeline.");
+	}
+#endif
+
+	//Bind descriptor sets
+
+	for (uint32_t i = 0; i < dl->state.set_count; i++) {
+		if (dl->state.sets[i].pipeline_expected_format == 0) {
+			continue; //nothing expected by this pipeline
+		}
+#ifdef DEBUG_ENABLED
+		if (dl->state.sets[i].pipeline_expected_format != dl->state.sets[i].uniform_set_format) {
+			if (dl->state.sets[i].uniform_set_format == 0) {
+				ERR_FAIL_MSG("Uniforms were never supplied for set (" + itos(i) + ") at the time of drawing, which are required by the pipeline");
+			} else if (uniform_set_owner.owns(dl->state.sets[i].uniform_set)) {
+				UniformSet *us = uniform_set_owner.get_or_null(dl->state.sets[i].uniform_set);
+				ERR_FAIL_MSG("Uniforms supplied for set (" + itos(i) + "):\n" + _shader_uniform_debug(us->shader_id, us->shader_set) + "\nare not the same format as required by the pipeline shader. Pipeline shader requires the following bindings:\n" + _shader_uniform_debug(dl->state.pipeline_shader));
+			} else {
+				ERR_FAIL_MSG("Uniforms supplied for set (" + itos(i) + ", which was was just freed) are not the same format as required by the pipeline shader. Pipeline shader requires the following bindings:\n" + _shader_uniform_debug(dl->state.pipeline_shader));
+			}
+		}
+#endif
+		if (!dl->state.sets[i].bound) {
+			//All good, see if this requires re-binding
+			vkCmdBindDescriptorSets(dl->command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, dl->state.pipeline_layout, i, 1, &dl->state.sets[i].descriptor_set, 0, nullptr);
+			dl->state.sets[i].bound = true;
+		}
+	}
+
+	// Vertex counts, instance counts and offsets come from the buffer, so they can't be validated here.
+	if (p_use_indices) {
+		vkCmdDrawIndexedIndirect(dl->command_buffer, buffer->buffer, p_offset, p_draw_count, p_stride);
+	} else {
+		vkCmdDrawIndirect(dl->command_buffer, buffer->buffer, p_offset, p_draw_count, p_stride);
 	}
 }
 
@@ -7594,22 +8279,7 @@ Error RenderingDeviceVulkan::_draw_list_allocate(const Rect2i &p_viewport, uint3
 				VkResult res = vkCreateCommandPool(device, &cmd_pool_info, nullptr, &split_draw_list_allocators.write[i].command_pool);
 				ERR_FAIL_COND_V_MSG(res, ERR_CANT_CREATE, "vkCreateCommandPool failed with error " + itos(res) + ".");
 
-				for (int j = 0; j < frame_count; j++) {
-					VkCommandBuffer command_buffer;
-
-					VkCommandBufferAllocateInfo cmdbuf;
-					//no command buffer exists, create it.
-					cmdbuf.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-					cmdbuf.pNext = nullptr;
-					cmdbuf.commandPool = split_draw_list_allocators[i].command_pool;
-					cmdbuf.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
-					cmdbuf.commandBufferCount = 1;
-
-					VkResult err = vkAllocateCommandBuffers(device, &cmdbuf, &command_buffer);
-					ERR_FAIL_COND_V_MSG(err, ERR_CANT_CREATE, "vkAllocateCommandBuffers failed with error " + itos(err) + ".");
-
-					split_draw_list_allocators.write[i].command_buffers.push_back(command_buffer);
-				}
+				split_draw_list_allocators.write[i].frames.resize(frame_count);
 			}
 		}
 		draw_list = memnew_arr(DrawList, p_splits);
@@ -7618,7 +8288,28 @@ Error RenderingDeviceVulkan::_draw_list_allocate(const Rect2i &p_viewport, uint3
 
 		for (uint32_t i = 0; i < p_splits; i++) {
 			//take a command buffer and initialize it
-			VkCommandBuffer command_buffer = split_draw_list_allocators[i].command_buffers[frame];
+			SplitDrawListAllocator::FrameCommandBuffers &frame_buffers = split_draw_list_allocators.write[i].frames[frame];
+			if (frame_buffers.used == frame_buffers.command_buffers.size()) {
+				VkCommandBuffer new_command_buffer;
+
+				VkCommandBufferAllocateInfo cmdbuf;
+				//no free command buffer for this frame, create it.
+				cmdbuf.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+				cmdbuf.pNext = nullptr;
+				cmdbuf.commandPool = split_draw_list_allocators[i].command_pool;
+				cmdbuf.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+				cmdbuf.commandBufferCount = 1;
+
+				VkResult err = vkAllocateCommandBuffers(device, &cmdbuf, &new_command_buffer);
+				if (err) {
+					memdelete_arr(draw_list);
+					draw_list = nullptr;
+					ERR_FAIL_V_MSG(ERR_CANT_CREATE, "vkAllocateCommandBuffers failed with error " + itos(err) + ".");
+				}
+
+				frame_buffers.command_buffers.push_back(new_command_buffer);
+			}
+			VkCommandBuffer command_buffer = frame_buffers.command_buffers[frame_buffers.used++];
 
 			VkCommandBufferInheritanceInfo inheritance_info;
 			inheritance_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
@@ -8287,11 +8978,11 @@ void RenderingDeviceVulkan::barrier(uint32_t p_from, uint32_t p_to) {
 	uint32_t dst_access_flags = 0;
 	if (p_to & BARRIER_MASK_COMPUTE) {
 		dst_barrier_flags |= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-		dst_access_flags |= VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+		dst_access_flags |= VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_UNIFORM_READ_BIT;
 	}
 	if (p_to & BARRIER_MASK_RASTER) {
 		dst_barrier_flags |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
-		dst_access_flags |= VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+		dst_access_flags |= VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
 	}
 	if (p_to & BARRIER_MASK_TRANSFER) {
 		dst_barrier_flags |= VK_PIPELINE_STAGE_TRANSFER_BIT;
@@ -8520,6 +9211,99 @@ String RenderingDeviceVulkan::get_device_pipeline_cache_uuid() const {
 	return context->get_device_pipeline_cache_uuid();
 }
 
+uint64_t RenderingDeviceVulkan::get_present_wait_time_usec() const {
+	return context->get_present_wait_time_usec();
+}
+
+uint64_t RenderingDeviceVulkan::get_refresh_cycle_duration_usec() const {
+	return context->get_refresh_cycle_duration_usec(DisplayServer::MAIN_WINDOW_ID);
+}
+
+bool RenderingDeviceVulkan::_pipeline_cache_is_compatible(const Vector<uint8_t> &p_data) {
+	// Drivers are not required to validate foreign data, so check the header (VK_PIPELINE_CACHE_HEADER_VERSION_ONE) here.
+	const uint32_t header_size = sizeof(uint32_t) * 4 + VK_UUID_SIZE;
+	if (p_data.size() < (int)header_size) {
+		return false;
+	}
+
+	const uint8_t *r = p_data.ptr();
+	if (decode_uint32(&r[0]) < header_size || decode_uint32(&r[4]) != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) {
+		return false;
+	}
+
+	VkPhysicalDeviceProperties props;
+	vkGetPhysicalDeviceProperties(context->get_physical_device(), &props);
+	return decode_uint32(&r[8]) == props.vendorID && decode_uint32(&r[12]) == props.deviceID && memcmp(&r[16], props.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+void RenderingDeviceVulkan::set_pipeline_cache_path(const String &p_path) {
+	_THREAD_SAFE_METHOD_
+
+	pipeline_cache_path = p_path;
+	if (p_path.is_empty() || pipeline_cache == VK_NULL_HANDLE) {
+		return;
+	}
+
+	Vector<uint8_t> data;
+	if (FileAccess::exists(p_path)) {
+		data = FileAccess::get_file_as_array(p_path);
+	}
+
+	if (!_pipeline_cache_is_compatible(data)) {
+		if (!data.is_empty()) {
+			print_verbose("Pipeline cache at '" + p_path + "' was created by another device or driver, ignoring it.");
+		}
+		// Save at least once so the file matches this device.
+		pipeline_cache_dirty = true;
+		return;
+	}
+
+	VkPipelineCacheCreateInfo cache_info;
+	cache_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	cache_info.pNext = nullptr;
+	cache_info.flags = 0;
+	cache_info.initialDataSize = data.size();
+	cache_info.pInitialData = data.ptr();
+
+	VkPipelineCache loaded_cache;
+	VkResult err = vkCreatePipelineCache(device, &cache_info, nullptr, &loaded_cache);
+	ERR_FAIL_COND_MSG(err, "vkCreatePipelineCache failed with error " + itos(err) + " when loading '" + p_path + "'.");
+
+	// Keep whatever was compiled before the path was set.
+	err = vkMergePipelineCaches(device, loaded_cache, 1, &pipeline_cache);
+	if (err) {
+		vkDestroyPipelineCache(device, loaded_cache, nullptr);
+		ERR_FAIL_MSG("vkMergePipelineCaches failed with error " + itos(err) + ".");
+	}
+
+	vkDestroyPipelineCache(device, pipeline_cache, nullptr);
+	pipeline_cache = loaded_cache;
+
+	print_verbose("Loaded pipeline cache from '" + p_path + "' (" + itos(data.size()) + " bytes).");
+}
+
+void RenderingDeviceVulkan::_save_pipeline_cache() {
+	if (pipeline_cache == VK_NULL_HANDLE || pipeline_cache_path.is_empty() || !pipeline_cache_dirty) {
+		return;
+	}
+
+	size_t data_size = 0;
+	VkResult err = vkGetPipelineCacheData(device, pipeline_cache, &data_size, nullptr);
+	ERR_FAIL_COND_MSG(err, "vkGetPipelineCacheData failed with error " + itos(err) + ".");
+
+	Vector<uint8_t> data;
+	data.resize(data_size);
+	err = vkGetPipelineCacheData(device, pipeline_cache, &data_size, data.ptrw());
+	ERR_FAIL_COND_MSG(err, "vkGetPipelineCacheData failed with error " + itos(err) + ".");
+
+	FileAccessRef f = FileAccess::open(pipeline_cache_path, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(!f, "Can't save pipeline cache to '" + pipeline_cache_path + "'.");
+	f->store_buffer(data.ptr(), data_size);
+	f->close();
+
+	pipeline_cache_dirty = false;
+}
+
 void RenderingDeviceVulkan::_finalize_command_bufers() {
 	if (draw_list) {
 		ERR_PRINT("Found open draw list at the end of the frame, this should never happen (further drawing will likely not work).");
@@ -8536,9 +9320,17 @@ void RenderingDeviceVulkan::_finalize_command_bufers() {
 }
 
 void RenderingDeviceVulkan::_begin_frame() {
+	//hand over readbacks copied the last time this frame was used
+	_readbacks_resolve(frame, true);
+
 	//erase pending resources
 	_free_pending_resources(frame);
 
+	//secondary command buffers recorded for this frame are no longer in use
+	for (int i = 0; i < split_draw_list_allocators.size(); i++) {
+		split_draw_list_allocators.write[i].frames[frame].used = 0;
+	}
+
 	//create setup command buffer and set as the setup buffer
 
 	{
@@ -8592,6 +9384,13 @@ void RenderingDeviceVulkan::swap_buffers() {
 	//swap buffers
 	context->swap_buffers();
 
+	{
+		// Uploads recorded during this frame go right after it.
+		MutexLock lock(transfer_mutex);
+		_transfer_submit_pending();
+	}
+	frame_thread = Thread::get_caller_id();
+
 	frame = (frame + 1) % frame_count;
 
 	_begin_frame();
@@ -8813,6 +9612,7 @@ void RenderingDeviceVulkan::initialize(VulkanContext *p_context, bool p_local_de
 		// get info about further features
 		VulkanContext::MultiviewCapabilities multiview_capabilies = p_context->get_multiview_capabilities();
 		device_capabilities.supports_multiview = multiview_capabilies.is_supported && multiview_capabilies.max_view_count > 1;
+		device_capabilities.supports_descriptor_indexing = p_context->get_descriptor_indexing_capabilities().is_supported;
 	}
 
 	context = p_context;
@@ -8941,6 +9741,71 @@ void RenderingDeviceVulkan::initialize(VulkanContext *p_context, bool p_local_de
 		ERR_CONTINUE(err != OK);
 	}
 
+	if (!p_local_device) {
+		// Async transfers get their own ring, which stays mapped, and a batch pool.
+		transfer_ring_size = GLOBAL_DEF("rendering/vulkan/staging_buffer/async_ring_size_mb", 64);
+		transfer_ring_size = CLAMP(transfer_ring_size, 4u, 2048u);
+		transfer_ring_size *= 1024 * 1024;
+
+		VkBufferCreateInfo bufferInfo;
+		bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferInfo.pNext = nullptr;
+		bufferInfo.flags = 0;
+		bufferInfo.size = transfer_ring_size;
+		bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+		bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		bufferInfo.queueFamilyIndexCount = 0;
+		bufferInfo.pQueueFamilyIndices = nullptr;
+
+		VmaAllocationCreateInfo allocInfo;
+		allocInfo.flags = 0;
+		allocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+		allocInfo.requiredFlags = 0;
+		allocInfo.preferredFlags = 0;
+		allocInfo.memoryTypeBits = 0;
+		allocInfo.pool = nullptr;
+		allocInfo.pUserData = nullptr;
+
+		VkResult err = vmaCreateBuffer(allocator, &bufferInfo, &allocInfo, &transfer_ring_buffer, &transfer_ring_allocation, nullptr);
+		ERR_FAIL_COND_MSG(err, "vmaCreateBuffer failed with error " + itos(err) + ".");
+
+		void *data_ptr = nullptr;
+		err = vmaMapMemory(allocator, transfer_ring_allocation, &data_ptr);
+		ERR_FAIL_COND_MSG(err, "vmaMapMemory failed with error " + itos(err) + ".");
+		transfer_ring_ptr = (uint8_t *)data_ptr;
+
+		VkCommandPoolCreateInfo cmd_pool_info;
+		cmd_pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		cmd_pool_info.pNext = nullptr;
+		cmd_pool_info.queueFamilyIndex = p_context->get_graphics_queue_family_index();
+		cmd_pool_info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+
+		err = vkCreateCommandPool(device, &cmd_pool_info, nullptr, &transfer_command_pool);
+		ERR_FAIL_COND_MSG(err, "vkCreateCommandPool failed with error " + itos(err) + ".");
+
+		for (uint32_t i = 0; i < TRANSFER_BATCH_MAX; i++) {
+			VkCommandBufferAllocateInfo cmdbuf;
+			cmdbuf.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+			cmdbuf.pNext = nullptr;
+			cmdbuf.commandPool = transfer_command_pool;
+			cmdbuf.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+			cmdbuf.commandBufferCount = 1;
+
+			err = vkAllocateCommandBuffers(device, &cmdbuf, &transfer_batches[i].command_buffer);
+			ERR_CONTINUE_MSG(err, "vkAllocateCommandBuffers failed with error " + itos(err) + ".");
+
+			VkFenceCreateInfo fence_info;
+			fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+			fence_info.pNext = nullptr;
+			fence_info.flags = 0;
+
+			err = vkCreateFence(device, &fence_info, nullptr, &transfer_batches[i].fence);
+			ERR_CONTINUE_MSG(err, "vkCreateFence failed with error " + itos(err) + ".");
+		}
+
+		frame_thread = Thread::get_caller_id();
+	}
+
 	max_descriptors_per_pool = GLOBAL_DEF("rendering/vulkan/descriptor_pools/max_descriptors_per_pool", 64);
 
 	//check to make sure DescriptorPoolKey is good
@@ -8951,6 +9816,22 @@ void RenderingDeviceVulkan::initialize(VulkanContext *p_context, bool p_local_de
 	draw_list_split = false;
 
 	compute_list = nullptr;
+
+	{
+		//start with an empty pipeline cache, a path may be set later to load a saved one
+		VkPipelineCacheCreateInfo cache_info;
+		cache_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		cache_info.pNext = nullptr;
+		cache_info.flags = 0;
+		cache_info.initialDataSize = 0;
+		cache_info.pInitialData = nullptr;
+
+		VkResult err = vkCreatePipelineCache(device, &cache_info, nullptr, &pipeline_cache);
+		if (err) {
+			ERR_PRINT("vkCreatePipelineCache failed with error " + itos(err) + ", pipelines will not be cached.");
+			pipeline_cache = VK_NULL_HANDLE;
+		}
+	}
 }
 
 template <class T>
@@ -9231,6 +10112,8 @@ int RenderingDeviceVulkan::limit_get(Limit p_limit) {
 			return limits.maxComputeWorkGroupSize[1];
 		case LIMIT_MAX_COMPUTE_WORKGROUP_SIZE_Z:
 			return limits.maxComputeWorkGroupSize[2];
+		case LIMIT_MAX_BINDLESS_TEXTURES:
+			return device_capabilities.supports_descriptor_indexing ? limits.maxPerStageDescriptorSampledImages : 0;
 
 		default:
 			ERR_FAIL_V(0);
@@ -9246,6 +10129,12 @@ void RenderingDeviceVulkan::finalize() {
 
 	_free_rids(render_pipeline_owner, "Pipeline");
 	_free_rids(compute_pipeline_owner, "Compute");
+
+	_save_pipeline_cache();
+	if (pipeline_cache != VK_NULL_HANDLE) {
+		vkDestroyPipelineCache(device, pipeline_cache, nullptr);
+		pipeline_cache = VK_NULL_HANDLE;
+	}
 	_free_rids(uniform_set_owner, "UniformSet");
 	_free_rids(texture_buffer_owner, "TextureBuffer");
 	_free_rids(storage_buffer_owner, "StorageBuffer");
@@ -9286,6 +10175,7 @@ void RenderingDeviceVulkan::finalize() {
 	//free everything pending
 	for (int i = 0; i < frame_count; i++) {
 		int f = (frame + i) % frame_count;
+		_readbacks_resolve(f, false);
 		_free_pending_resources(f);
 		vkDestroyCommandPool(device, frames[i].command_pool, nullptr);
 		vkDestroyQueryPool(device, frames[i].timestamp_pool, nullptr);
@@ -9305,6 +10195,19 @@ void RenderingDeviceVulkan::finalize() {
 	for (int i = 0; i < staging_buffer_blocks.size(); i++) {
 		vmaDestroyBuffer(allocator, staging_buffer_blocks[i].buffer, staging_buffer_blocks[i].allocation);
 	}
+
+	if (transfer_ring_buffer != VK_NULL_HANDLE) {
+		// Everything submitted was waited for by the flush above.
+		for (uint32_t i = 0; i < TRANSFER_BATCH_MAX; i++) {
+			if (transfer_batches[i].fence != VK_NULL_HANDLE) {
+				vkDestroyFence(device, transfer_batches[i].fence, nullptr);
+			}
+		}
+		vkDestroyCommandPool(device, transfer_command_pool, nullptr);
+		vmaUnmapMemory(allocator, transfer_ring_allocation);
+		vmaDestroyBuffer(allocator, transfer_ring_buffer, transfer_ring_allocation);
+	}
+
 	vmaDestroyAllocator(allocator);
 
 	while (vertex_formats.size()) {
@@ -31,6 +31,7 @@
 #ifndef RENDERING_DEVICE_VULKAN_H
 #define RENDERING_DEVICE_VULKAN_H
 
+#include "core/os/thread.h"
 #include "core/os/thread_safe.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/oa_hash_map.h"
@@ -161,6 +162,7 @@ class RenderingDeviceVulkan : public RenderingDevice {
 
 	Vector<uint8_t> _texture_get_data_from_image(Texture *tex, VkImage p_image, VmaAllocation p_allocation, uint32_t p_layer, bool p_2d = false);
 	Error _texture_update(RID p_texture, uint32_t p_layer, const Vector<uint8_t> &p_data, uint32_t p_post_barrier, bool p_use_setup_queue);
+	void _copy_image_region(const uint8_t *p_src, uint8_t *p_dst, DataFormat p_format, uint32_t p_x, uint32_t p_y, uint32_t p_region_w, uint32_t p_region_h, uint32_t p_width);
 
 	/*****************/
 	/**** SAMPLER ****/
@@ -209,6 +211,61 @@ class RenderingDeviceVulkan : public RenderingDevice {
 	Error _staging_buffer_allocate(uint32_t p_amount, uint32_t p_required_align, uint32_t &r_alloc_offset, uint32_t &r_alloc_size, bool p_can_segment = true, bool p_on_draw_command_buffer = false);
 	Error _insert_staging_block();
 
+	/*************************/
+	/**** ASYNC TRANSFERS ****/
+	/*************************/
+
+	// Async uploads use a separate ring buffer, which stays mapped, and are
+	// recorded into transfer batches instead of the frame command buffers.
+	// The batch being recorded is submitted to the graphics queue right after
+	// the frame, so it is ordered after anything the frame did with the
+	// resources (including their creation) and before the next frame.
+	//
+	// Ring space is only reclaimed once the batch that used it signals its
+	// fence. When the ring (or the batch pool) is full, the calling thread
+	// waits for the GPU instead of flushing, so loading threads block but
+	// the frame does not.
+	//
+	// Transfer IDs are the batch IDs, which grow monotonically and complete
+	// in order, so a single counter tells what has been completed.
+
+	enum {
+		TRANSFER_BATCH_MAX = 8,
+		TRANSFER_CHUNK_SIZE = 1024 * 1024, // Written per lock, so the frame thread never waits long to submit.
+	};
+
+	struct TransferBatch {
+		VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+		VkFence fence = VK_NULL_HANDLE;
+		TransferID id = 0;
+		uint64_t ring_end = 0;
+	};
+
+	Mutex transfer_mutex;
+	VkCommandPool transfer_command_pool = VK_NULL_HANDLE;
+	TransferBatch transfer_batches[TRANSFER_BATCH_MAX];
+	uint32_t transfer_batch_first = 0; // Oldest submitted batch.
+	uint32_t transfer_batch_submitted = 0;
+	bool transfer_batch_open = false; // The batch after the submitted ones is being recorded.
+	TransferID transfer_last_id = 0;
+	TransferID transfer_completed_id = 0;
+
+	VkBuffer transfer_ring_buffer = VK_NULL_HANDLE;
+	VmaAllocation transfer_ring_allocation = nullptr;
+	uint8_t *transfer_ring_ptr = nullptr;
+	uint32_t transfer_ring_size = 0;
+	uint64_t transfer_ring_head = 0; // Both grow monotonically, the offset is taken modulo the size.
+	uint64_t transfer_ring_tail = 0;
+
+	Thread::ID frame_thread = 0; // Thread that swaps buffers, it can't wait for the next frame.
+
+	void _transfer_retire_completed();
+	void _transfer_submit_pending();
+	Error _transfer_submit_from_frame_thread();
+	bool _transfer_try_allocate(uint32_t p_amount, uint32_t p_required_align, uint32_t &r_offset);
+	Error _transfer_allocate(uint32_t p_amount, uint32_t p_required_align, uint32_t &r_offset);
+	static void _transfer_image_barrier(VkCommandBuffer p_command_buffer, const Texture &p_texture, uint32_t p_layer, bool p_to_transfer);
+
 	struct Buffer {
 		uint32_t size = 0;
 		uint32_t usage = 0;
@@ -227,6 +284,8 @@ class RenderingDeviceVulkan : public RenderingDevice {
 	void _memory_barrier(VkPipelineStageFlags p_src_stage_mask, VkPipelineStageFlags p_dst_stage_mask, VkAccessFlags p_src_access, VkAccessFlags p_dst_sccess, bool p_sync_with_draw);
 	void _buffer_memory_barrier(VkBuffer buffer, uint64_t p_from, uint64_t p_size, VkPipelineStageFlags p_src_stage_mask, VkPipelineStageFlags p_dst_stage_mask, VkAccessFlags p_src_access, VkAccessFlags p_dst_sccess, bool p_sync_with_draw);
 
+	uint32_t _texture_copy_to_buffer(Texture *tex, uint32_t p_layer, Buffer *r_buffer);
+
 	/*********************/
 	/**** FRAMEBUFFER ****/
 	/*********************/
@@ -594,6 +653,10 @@ class RenderingDeviceVulkan : public RenderingDevice {
 	// in a game is limited.
 	Map<UniformSetFormat, uint32_t> uniform_set_format_cache;
 
+	// With descriptor indexing, texture arrays are created as partially bound,
+	// so uniform sets can fill only part of them (bindless texture tables).
+	bool _is_descriptor_partially_bound(VkDescriptorType p_type, uint32_t p_count) const;
+
 	// Shaders in Vulkan are just pretty much
 	// precompiled blocks of SPIR-V bytecode. They
 	// are most likely not really compiled to host
@@ -800,6 +863,17 @@ class RenderingDeviceVulkan : public RenderingDevice {
 
 	RID_Owner<ComputePipeline, true> compute_pipeline_owner;
 
+	// All pipelines are created through a driver pipeline cache.
+	// When a path is given, it's loaded from disk and stored back
+	// on finalize, so pipelines already seen compile much faster.
+
+	VkPipelineCache pipeline_cache = VK_NULL_HANDLE;
+	String pipeline_cache_path;
+	bool pipeline_cache_dirty = false;
+
+	bool _pipeline_cache_is_compatible(const Vector<uint8_t> &p_data);
+	void _save_pipeline_cache();
+
 	/*******************/
 	/**** DRAW LIST ****/
 	/*******************/
@@ -816,8 +890,15 @@ class RenderingDeviceVulkan : public RenderingDevice {
 	// each needs its own command pool.
 
 	struct SplitDrawListAllocator {
+		// A split draw list can be begun several times in a frame (opaque, alpha, each shadow pass...).
+		// vkCmdExecuteCommands only references the secondary buffers, so every use in a frame needs its own.
+		struct FrameCommandBuffers {
+			LocalVector<VkCommandBuffer> command_buffers;
+			uint32_t used = 0;
+		};
+
 		VkCommandPool command_pool = VK_NULL_HANDLE;
-		Vector<VkCommandBuffer> command_buffers; //one for each frame
+		LocalVector<FrameCommandBuffers> frames; //one for each frame
 	};
 
 	Vector<SplitDrawListAllocator> split_draw_list_allocators;
@@ -983,6 +1064,15 @@ class RenderingDeviceVulkan : public RenderingDevice {
 		List<RenderPipeline> render_pipelines_to_dispose_of;
 		List<ComputePipeline> compute_pipelines_to_dispose_of;
 
+		//async readbacks copied during this frame, resolved when it is cycled
+		struct Readback {
+			Buffer buffer;
+			uint32_t size = 0;
+			Callable callback;
+		};
+
+		List<Readback> readbacks;
+
 		VkCommandPool command_pool = VK_NULL_HANDLE;
 		VkCommandBuffer setup_command_buffer = VK_NULL_HANDLE; //used at the beginning of every frame for set-up
 		VkCommandBuffer draw_command_buffer = VK_NULL_HANDLE; //used at the beginning of every frame for set-up
@@ -1014,6 +1104,7 @@ class RenderingDeviceVulkan : public RenderingDevice {
 	bool local_device_processing = false;
 
 	void _free_pending_resources(int p_frame);
+	void _readbacks_resolve(int p_frame, bool p_notify);
 
 	VmaAllocator allocator = nullptr;
 
@@ -1112,6 +1203,14 @@ public:
 	virtual Error buffer_clear(RID p_buffer, uint32_t p_offset, uint32_t p_size, uint32_t p_post_barrier = BARRIER_MASK_ALL);
 	virtual Vector<uint8_t> buffer_get_data(RID p_buffer);
 
+	virtual TransferID buffer_update_async(RID p_buffer, uint32_t p_offset, uint32_t p_size, const void *p_data);
+	virtual TransferID texture_update_async(RID p_texture, uint32_t p_layer, const Vector<uint8_t> &p_data);
+	virtual bool transfer_is_complete(TransferID p_transfer);
+	virtual void transfer_wait(TransferID p_transfer);
+
+	virtual Error buffer_get_data_async(RID p_buffer, const Callable &p_callback);
+	virtual Error texture_get_data_async(RID p_texture, uint32_t p_layer, const Callable &p_callback);
+
 	/*************************/
 	/**** RENDER PIPELINE ****/
 	/*************************/
@@ -1150,7 +1249,8 @@ public:
 	virtual void draw_list_set_line_width(DrawListID p_list, float p_width);
 	virtual void draw_list_set_push_constant(DrawListID p_list, const void *p_data, uint32_t p_data_size);
 
-	virtual void draw_list_draw(DrawListID p_list, bool p_use_indices, uint32_t p_instances = 1, uint32_t p_procedural_vertices = 0);
+	virtual void draw_list_draw(DrawListID p_list, bool p_use_indices, uint32_t p_instances = 1, uint32_t p_procedural_vertices = 0, uint32_t p_first_instance = 0);
+	virtual void draw_list_draw_indirect(DrawListID p_list, bool p_use_indices, RID p_buffer, uint32_t p_offset = 0, uint32_t p_draw_count = 1, uint32_t p_stride = 0);
 
 	virtual void draw_list_enable_scissor(DrawListID p_list, const Rect2 &p_rect);
 	virtual void draw_list_disable_scissor(DrawListID p_list);
@@ -1226,6 +1326,9 @@ public:
 	virtual String get_device_vendor_name() const;
 	virtual String get_device_name() const;
 	virtual String get_device_pipeline_cache_uuid() const;
+	virtual uint64_t get_present_wait_time_usec() const;
+	virtual uint64_t get_refresh_cycle_duration_usec() const;
+	virtual void set_pipeline_cache_path(const String &p_path);
 
 	virtual uint64_t get_driver_resource(DriverResource p_resource, RID p_rid = RID(), uint64_t p_index = 0);
 
@@ -32,6 +32,7 @@
 
 #include "core/config/engine.h"
 #include "core/config/project_settings.h"
+#include "core/os/os.h"
 #include "core/string/ustring.h"
 #include "core/version.h"
 #include "servers/rendering/rendering_device.h"
@@ -498,6 +499,7 @@ String VulkanContext::SubgroupCapabilities::supported_operations_desc() const {
 Error VulkanContext::_check_capabilities() {
 	// https://www.khronos.org/registry/vulkan/specs/1.2-extensions/man/html/VK_KHR_multiview.html
 	// https://www.khronos.org/blog/vulkan-subgroup-tutorial
+	// https://www.khronos.org/registry/vulkan/specs/1.2-extensions/man/html/VK_EXT_descriptor_indexing.html
 
 	// for Vulkan 1.0 vkGetPhysicalDeviceProperties2 is not available, including not in the loader we compile against on Android.
 
@@ -510,6 +512,10 @@ Error VulkanContext::_check_capabilities() {
 	multiview_capabilities.tessellation_shader_is_supported = false;
 	multiview_capabilities.max_view_count = 0;
 	multiview_capabilities.max_instance_count = 0;
+	descriptor_indexing_capabilities.is_supported = false;
+	descriptor_indexing_capabilities.partially_bound_is_supported = false;
+	descriptor_indexing_capabilities.sampled_image_non_uniform_indexing_is_supported = false;
+	descriptor_indexing_capabilities.runtime_descriptor_array_is_supported = false;
 	subgroup_capabilities.size = 0;
 	subgroup_capabilities.supportedStages = 0;
 	subgroup_capabilities.supportedOperations = 0;
@@ -527,6 +533,14 @@ Error VulkanContext::_check_capabilities() {
 		multiview_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTIVIEW_FEATURES;
 		multiview_features.pNext = nullptr;
 
+		// only query descriptor indexing if the extension was found, the structure is unknown otherwise
+		VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptor_indexing_features = {};
+		descriptor_indexing_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+		descriptor_indexing_features.pNext = nullptr;
+		if (descriptor_indexing_extension_found) {
+			multiview_features.pNext = &descriptor_indexing_features;
+		}
+
 		VkPhysicalDeviceFeatures2 device_features;
 		device_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
 		device_features.pNext = &multiview_features;
@@ -535,6 +549,14 @@ Error VulkanContext::_check_capabilities() {
 		multiview_capabilities.is_supported = multiview_features.multiview;
 		multiview_capabilities.geometry_shader_is_supported = multiview_features.multiviewGeometryShader;
 		multiview_capabilities.tessellation_shader_is_supported = multiview_features.multiviewTessellationShader;
+
+		if (descriptor_indexing_extension_found) {
+			descriptor_indexing_capabilities.partially_bound_is_supported = descriptor_indexing_features.descriptorBindingPartiallyBound;
+			descriptor_indexing_capabilities.sampled_image_non_uniform_indexing_is_supported = descriptor_indexing_features.shaderSampledImageArrayNonUniformIndexing;
+			descriptor_indexing_capabilities.runtime_descriptor_array_is_supported = descriptor_indexing_features.runtimeDescriptorArray;
+			// all three are needed to index a large, sparsely filled texture array from shaders
+			descriptor_indexing_capabilities.is_supported = descriptor_indexing_capabilities.partially_bound_is_supported && descriptor_indexing_capabilities.sampled_image_non_uniform_indexing_is_supported && descriptor_indexing_capabilities.runtime_descriptor_array_is_supported;
+		}
 	}
 
 	// check extended properties
@@ -583,6 +605,12 @@ Error VulkanContext::_check_capabilities() {
 			print_verbose("- Vulkan multiview not supported");
 		}
 
+		if (descriptor_indexing_capabilities.is_supported) {
+			print_verbose("- Vulkan descriptor indexing supported");
+		} else {
+			print_verbose("- Vulkan descriptor indexing not supported");
+		}
+
 		print_verbose("- Vulkan subgroup:");
 		print_verbose("  size: " + itos(subgroup_capabilities.size));
 		print_verbose("  stages: " + subgroup_capabilities.supported_stages_desc());
@@ -784,6 +812,11 @@ Error VulkanContext::_create_physical_device() {
 				// if multiview is supported, enable it
 				extension_names[enabled_extension_count++] = VK_KHR_MULTIVIEW_EXTENSION_NAME;
 			}
+			if (!strcmp(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME, device_extensions[i].extensionName) && (vulkan_major > 1 || vulkan_minor >= 1)) {
+				// descriptor indexing depends on VK_KHR_maintenance3, which is core since Vulkan 1.1
+				descriptor_indexing_extension_found = true;
+				extension_names[enabled_extension_count++] = VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME;
+			}
 			if (enabled_extension_count >= MAX_EXTENSIONS) {
 				free(device_extensions);
 				ERR_FAIL_V_MSG(ERR_BUG, "Enabled extension count reaches MAX_EXTENSIONS, BUG");
@@ -1007,6 +1040,18 @@ Error VulkanContext::_create_device() {
 		sdevice.pNext = &multiview_features;
 	}
 
+	VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptor_indexing_features = {};
+	if (descriptor_indexing_capabilities.is_supported) {
+		// only enable what partially bound texture arrays need, update after bind is not used
+		descriptor_indexing_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+		descriptor_indexing_features.pNext = (void *)sdevice.pNext;
+		descriptor_indexing_features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+		descriptor_indexing_features.descriptorBindingPartiallyBound = VK_TRUE;
+		descriptor_indexing_features.runtimeDescriptorArray = VK_TRUE;
+
+		sdevice.pNext = &descriptor_indexing_features;
+	}
+
 	err = vkCreateDevice(gpu, &sdevice, nullptr, &device);
 	ERR_FAIL_COND_V(err, ERR_CANT_CREATE);
 
@@ -1488,6 +1533,14 @@ Error VulkanContext::_update_swap_chain(Window *window) {
 	err = fpCreateSwapchainKHR(device, &swapchain_ci, nullptr, &window->swapchain);
 	ERR_FAIL_COND_V(err, ERR_CANT_CREATE);
 
+	window->refresh_cycle_usec = 0;
+	if (VK_GOOGLE_display_timing_enabled) {
+		VkRefreshCycleDurationGOOGLE refresh_cycle;
+		if (fpGetRefreshCycleDurationGOOGLE(device, window->swapchain, &refresh_cycle) == VK_SUCCESS) {
+			window->refresh_cycle_usec = refresh_cycle.refreshDuration / 1000;
+		}
+	}
+
 	uint32_t sp_image_count;
 	err = fpGetSwapchainImagesKHR(device, window->swapchain, &sp_image_count, nullptr);
 	ERR_FAIL_COND_V(err, ERR_CANT_CREATE);
@@ -1751,6 +1804,8 @@ Error VulkanContext::prepare_buffers() {
 
 	VkResult err;
 
+	uint64_t wait_begin = OS::get_singleton()->get_ticks_usec();
+
 	// Ensure no more than FRAME_LAG renderings are outstanding
 	vkWaitForFences(device, 1, &fences[frame_index], VK_TRUE, UINT64_MAX);
 	vkResetFences(device, 1, &fences[frame_index]);
@@ -1789,6 +1844,7 @@ Error VulkanContext::prepare_buffers() {
 		} while (err != VK_SUCCESS);
 	}
 
+	present_wait_usec = OS::get_singleton()->get_ticks_usec() - wait_begin;
 	buffers_prepared = true;
 
 	return OK;
@@ -1992,7 +2048,11 @@ Error VulkanContext::swap_buffers() {
 	static int total_frames = 0;
 	total_frames++;
 	//	print_line("current buffer:  " + itos(current_buffer));
+	uint64_t present_begin = OS::get_singleton()->get_ticks_usec();
 	err = fpQueuePresentKHR(present_queue, &present);
+	present_wait_usec += OS::get_singleton()->get_ticks_usec() - present_begin;
+	last_present_wait_usec.set(present_wait_usec);
+	present_wait_usec = 0;
 
 	frame_index += 1;
 	frame_index %= FRAME_LAG;
@@ -2071,6 +2131,17 @@ RID VulkanContext::local_device_create() {
 			/*ppEnabledExtensionNames */ (const char *const *)extension_names,
 			/*pEnabledFeatures */ &physical_device_features, // If specific features are required, pass them in here
 		};
+
+		VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptor_indexing_features = {};
+		if (descriptor_indexing_capabilities.is_supported) {
+			descriptor_indexing_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+			descriptor_indexing_features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+			descriptor_indexing_features.descriptorBindingPartiallyBound = VK_TRUE;
+			descriptor_indexing_features.runtimeDescriptorArray = VK_TRUE;
+
+			sdevice.pNext = &descriptor_indexing_features;
+		}
+
 		err = vkCreateDevice(gpu, &sdevice, nullptr, &ld.device);
 		ERR_FAIL_COND_V(err, RID());
 	}
@@ -2201,6 +2272,11 @@ DisplayServer::VSyncMode VulkanContext::get_vsync_mode(DisplayServer::WindowID p
 	return windows[p_window].vsync_mode;
 }
 
+uint64_t VulkanContext::get_refresh_cycle_duration_usec(DisplayServer::WindowID p_window) const {
+	ERR_FAIL_COND_V(!windows.has(p_window), 0);
+	return windows[p_window].refresh_cycle_usec;
+}
+
 void VulkanContext::set_vsync_mode(DisplayServer::WindowID p_window, DisplayServer::VSyncMode p_mode) {
 	ERR_FAIL_COND_MSG(!windows.has(p_window), "Could not set VSync mode for window with WindowID " + itos(p_window) + " because it does not exist.");
 	windows[p_window].vsync_mode = p_mode;
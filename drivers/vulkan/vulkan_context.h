@@ -36,6 +36,7 @@
 #include "core/string/ustring.h"
 #include "core/templates/map.h"
 #include "core/templates/rid_owner.h"
+#include "core/templates/safe_refcount.h"
 #include "servers/display_server.h"
 
 #ifdef USE_VOLK
@@ -66,6 +67,13 @@ public:
 		uint32_t max_instance_count;
 	};
 
+	struct DescriptorIndexingCapabilities {
+		bool is_supported;
+		bool partially_bound_is_supported;
+		bool sampled_image_non_uniform_indexing_is_supported;
+		bool runtime_descriptor_array_is_supported;
+	};
+
 private:
 	enum {
 		MAX_EXTENSIONS = 128,
@@ -88,6 +96,8 @@ private:
 	uint32_t vulkan_patch = 0;
 	SubgroupCapabilities subgroup_capabilities;
 	MultiviewCapabilities multiview_capabilities;
+	DescriptorIndexingCapabilities descriptor_indexing_capabilities;
+	bool descriptor_indexing_extension_found = false;
 
 	String device_vendor;
 	String device_name;
@@ -96,6 +106,10 @@ private:
 
 	bool buffers_prepared = false;
 
+	// Time the CPU spent blocked on the frame fence, image acquisition and present.
+	uint64_t present_wait_usec = 0;
+	SafeNumeric<uint64_t> last_present_wait_usec;
+
 	// Present queue.
 	bool queues_initialized = false;
 	uint32_t graphics_queue_family_index = 0;
@@ -132,6 +146,7 @@ private:
 		DisplayServer::VSyncMode vsync_mode = DisplayServer::VSYNC_ENABLED;
 		VkCommandPool present_cmd_pool = VK_NULL_HANDLE; // For separate present queue.
 		VkRenderPass render_pass = VK_NULL_HANDLE;
+		uint64_t refresh_cycle_usec = 0; // From VK_GOOGLE_display_timing, 0 if unknown.
 	};
 
 	struct LocalDevice {
@@ -239,6 +254,8 @@ public:
 	uint32_t get_vulkan_minor() const { return vulkan_minor; };
 	SubgroupCapabilities get_subgroup_capabilities() const { return subgroup_capabilities; };
 	MultiviewCapabilities get_multiview_capabilities() const { return multiview_capabilities; };
+	DescriptorIndexingCapabilities get_descriptor_indexing_capabilities() const { return descriptor_indexing_capabilities; };
+	const VkPhysicalDeviceFeatures &get_physical_device_features() const { return physical_device_features; };
 
 	VkDevice get_device();
 	VkPhysicalDevice get_physical_device();
@@ -283,6 +300,9 @@ public:
 	void set_vsync_mode(DisplayServer::WindowID p_window, DisplayServer::VSyncMode p_mode);
 	DisplayServer::VSyncMode get_vsync_mode(DisplayServer::WindowID p_window = 0) const;
 
+	uint64_t get_present_wait_time_usec() const { return last_present_wait_usec.get(); }
+	uint64_t get_refresh_cycle_duration_usec(DisplayServer::WindowID p_window = 0) const;
+
 	VulkanContext();
 	virtual ~VulkanContext();
 };
@@ -521,7 +521,7 @@ Error AudioDriverWASAPI::init() {
 	exit_thread = false;
 	thread_exited = false;
 
-	thread.start(thread_func, this);
+	thread.start(thread_func, this, get_thread_settings());
 
 	return OK;
 }
@@ -41,6 +41,7 @@
 #include <windows.h>
 
 #include <errno.h>
+#include <io.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <tchar.h>
@@ -58,6 +59,19 @@ void FileAccessWindows::check_errors() const {
 	}
 }
 
+void FileAccessWindows::_unmap() {
+	if (map) {
+		UnmapViewOfFile(map);
+	}
+	if (map_handle) {
+		CloseHandle(map_handle);
+	}
+	map_handle = nullptr;
+	map = nullptr;
+	map_size = 0;
+	map_failed = false;
+}
+
 Error FileAccessWindows::_open(const String &p_path, int p_mode_flags) {
 	path_src = p_path;
 	path = fix_path(p_path);
@@ -139,6 +153,7 @@ void FileAccessWindows::close() {
 		return;
 	}
 
+	_unmap();
 	fclose(f);
 	f = nullptr;
 
@@ -271,6 +286,46 @@ uint64_t FileAccessWindows::get_buffer(uint8_t *p_dst, uint64_t p_length) const
 	return read;
 };
 
+const uint8_t *FileAccessWindows::get_buffer_view(uint64_t p_length) const {
+	ERR_FAIL_COND_V(!f, nullptr);
+
+	if (flags != READ) {
+		return nullptr; // Writes may still be in the stdio buffer.
+	}
+
+	if (!map && !map_failed) {
+		HANDLE file_handle = (HANDLE)_get_osfhandle(_fileno(f));
+		LARGE_INTEGER size;
+		if (file_handle != INVALID_HANDLE_VALUE && GetFileSizeEx(file_handle, &size) && size.QuadPart > 0 && (uint64_t)(SIZE_T)size.QuadPart == (uint64_t)size.QuadPart) {
+			map_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (map_handle) {
+				map = (const uint8_t *)MapViewOfFile(map_handle, FILE_MAP_READ, 0, 0, 0);
+				if (map) {
+					map_size = size.QuadPart;
+				} else {
+					CloseHandle(map_handle);
+					map_handle = nullptr;
+				}
+			}
+		}
+		map_failed = map == nullptr;
+	}
+	if (!map) {
+		return nullptr;
+	}
+
+	int64_t pos = _ftelli64(f);
+	if (pos < 0 || (uint64_t)pos > map_size || p_length > map_size - pos) {
+		return nullptr;
+	}
+	if (_fseeki64(f, pos + p_length, SEEK_SET)) {
+		check_errors();
+		return nullptr;
+	}
+	prev_op = 0;
+	return map + pos;
+}
+
 Error FileAccessWindows::get_error() const {
 	return last_error;
 }
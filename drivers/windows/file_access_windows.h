@@ -48,6 +48,13 @@ class FileAccessWindows : public FileAccess {
 	String path_src;
 	String save_path;
 
+	// Whole file mapping for get_buffer_view(), created on first use.
+	mutable void *map_handle = nullptr;
+	mutable const uint8_t *map = nullptr;
+	mutable uint64_t map_size = 0;
+	mutable bool map_failed = false;
+	void _unmap();
+
 public:
 	virtual Error _open(const String &p_path, int p_mode_flags); ///< open a file
 	virtual void close(); ///< close a file
@@ -65,6 +72,7 @@ public:
 
 	virtual uint8_t get_8() const; ///< get a byte
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const;
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const;
 
 	virtual Error get_error() const; ///< get last error
 
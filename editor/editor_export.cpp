@@ -60,6 +60,7 @@ static int _get_pad(int p_alignment, int p_n) {
 }
 
 #define PCK_PADDING 16
+#define PACK_QUEUE_MAX_BYTES (64 * 1024 * 1024) // Converted files waiting to be written to the pack.
 
 bool EditorExportPreset::_set(const StringName &p_name, const Variant &p_value) {
 	if (values.has(p_name)) {
@@ -306,70 +307,149 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 
 	PackData *pd = (PackData *)p_userdata;
 
-	SavedData sd;
-	sd.path_utf8 = p_path.utf8();
-	sd.ofs = pd->f->get_position();
-	sd.size = p_data.size();
-	sd.encrypted = false;
+	PackData::QueuedFile qf;
+	qf.saved.path_utf8 = p_path.utf8();
+	qf.saved.size = p_data.size();
+	qf.saved.encrypted = false;
 
 	for (int i = 0; i < p_enc_in_filters.size(); ++i) {
 		if (p_path.matchn(p_enc_in_filters[i]) || p_path.replace("res://", "").matchn(p_enc_in_filters[i])) {
-			sd.encrypted = true;
+			qf.saved.encrypted = true;
 			break;
 		}
 	}
 
 	for (int i = 0; i < p_enc_ex_filters.size(); ++i) {
 		if (p_path.matchn(p_enc_ex_filters[i]) || p_path.replace("res://", "").matchn(p_enc_ex_filters[i])) {
-			sd.encrypted = false;
+			qf.saved.encrypted = false;
 			break;
 		}
 	}
 
-	FileAccessEncrypted *fae = nullptr;
-	FileAccess *ftmp = pd->f;
-
-	if (sd.encrypted) {
-		fae = memnew(FileAccessEncrypted);
-		ERR_FAIL_COND_V(!fae, ERR_SKIP);
-
-		Error err = fae->open_and_parse(ftmp, p_key, FileAccessEncrypted::MODE_WRITE_AES256, false);
-		ERR_FAIL_COND_V(err != OK, ERR_SKIP);
-		ftmp = fae;
+	qf.data = p_data;
+	if (qf.saved.encrypted) {
+		qf.key = p_key;
 	}
 
-	// Store file content.
-	ftmp->store_buffer(p_data.ptr(), p_data.size());
+	pd->mutex.lock();
+	while (pd->queued_bytes > 0 && pd->queued_bytes + p_data.size() > PACK_QUEUE_MAX_BYTES && pd->error == OK) {
+		pd->mutex.unlock();
+		pd->done_semaphore.wait();
+		pd->mutex.lock();
+	}
+	Error err = pd->error;
+	if (err == OK) {
+		pd->queue.push_back(qf);
+		pd->queued_bytes += p_data.size();
+	}
+	pd->mutex.unlock();
 
-	if (fae) {
-		fae->release();
-		memdelete(fae);
+	if (err != OK) {
+		return err;
 	}
+	pd->work_semaphore.post();
 
-	int pad = _get_pad(PCK_PADDING, pd->f->get_position());
-	for (int i = 0; i < pad; i++) {
-		pd->f->store_8(Math::rand() % 256);
+	if (pd->ep->step(TTR("Storing File:") + " " + p_path, 2 + p_file * 100 / p_total, false)) {
+		return ERR_SKIP;
 	}
 
+	return OK;
+}
+
+Error EditorExportPlatform::_store_pack_file(PackData *p_pd, PackData::QueuedFile &p_file) {
+	SavedData &sd = p_file.saved;
+	const Vector<uint8_t> &data = p_file.data;
+
 	// Store MD5 of original file.
 	{
 		unsigned char hash[16];
-		CryptoCore::md5(p_data.ptr(), p_data.size(), hash);
+		CryptoCore::md5(data.ptr(), data.size(), hash);
 		sd.md5.resize(16);
 		for (int i = 0; i < 16; i++) {
 			sd.md5.write[i] = hash[i];
 		}
 	}
 
-	pd->file_ofs.push_back(sd);
+	// Encrypted files carry their own IV, so copies can also share the stored bytes.
+	String content_key;
+	{
+		unsigned char hash[32];
+		CryptoCore::sha256(data.ptr(), data.size(), hash);
+		content_key = String::hex_encode_buffer(hash, 32) + (sd.encrypted ? "e" : "");
+	}
+
+	const uint64_t *stored_ofs = p_pd->stored_contents.getptr(content_key);
+	if (stored_ofs) {
+		sd.ofs = *stored_ofs;
+	} else {
+		sd.ofs = p_pd->f->get_position();
 
-	if (pd->ep->step(TTR("Storing File:") + " " + p_path, 2 + p_file * 100 / p_total, false)) {
-		return ERR_SKIP;
+		FileAccessEncrypted *fae = nullptr;
+		FileAccess *ftmp = p_pd->f;
+
+		if (sd.encrypted) {
+			fae = memnew(FileAccessEncrypted);
+			ERR_FAIL_COND_V(!fae, ERR_SKIP);
+
+			Error err = fae->open_and_parse(ftmp, p_file.key, FileAccessEncrypted::MODE_WRITE_AES256, false);
+			ERR_FAIL_COND_V(err != OK, ERR_SKIP);
+			ftmp = fae;
+		}
+
+		// Store file content.
+		ftmp->store_buffer(data.ptr(), data.size());
+
+		if (fae) {
+			fae->release();
+			memdelete(fae);
+		}
+
+		int pad = _get_pad(PCK_PADDING, p_pd->f->get_position());
+		for (int i = 0; i < pad; i++) {
+			p_pd->f->store_8(Math::rand() % 256);
+		}
+
+		p_pd->stored_contents.set(content_key, sd.ofs);
 	}
 
+	MutexLock lock(p_pd->mutex);
+	p_pd->file_ofs.push_back(sd);
+
 	return OK;
 }
 
+void EditorExportPlatform::_pack_writer_thread(void *p_userdata) {
+	PackData *pd = (PackData *)p_userdata;
+
+	while (true) {
+		pd->work_semaphore.wait();
+
+		pd->mutex.lock();
+		if (pd->queue.is_empty()) {
+			// Posted once more after the last file, all done.
+			pd->mutex.unlock();
+			break;
+		}
+		PackData::QueuedFile qf = pd->queue.front()->get();
+		pd->queue.pop_front();
+		Error err = pd->error;
+		pd->mutex.unlock();
+
+		if (err == OK) {
+			err = _store_pack_file(pd, qf);
+		}
+
+		pd->mutex.lock();
+		pd->queued_bytes -= qf.data.size();
+		if (err != OK) {
+			pd->error = err;
+		}
+		pd->mutex.unlock();
+
+		pd->done_semaphore.post();
+	}
+}
+
 Error EditorExportPlatform::_save_zip_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key) {
 	ERR_FAIL_COND_V_MSG(p_total < 1, ERR_PARAMETER_RANGE_ERROR, "Must select at least one file to export.");
 
@@ -1123,9 +1203,16 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, c
 	pd.ep = &ep;
 	pd.f = ftmp;
 	pd.so_files = p_so_files;
+	pd.writer.start(_pack_writer_thread, &pd);
 
 	Error err = export_project_files(p_preset, _save_pack_file, &pd, _add_shared_object);
 
+	pd.work_semaphore.post(); // Lets the writer exit once the queue is empty.
+	pd.writer.wait_to_finish();
+	if (err == OK) {
+		err = pd.error;
+	}
+
 	memdelete(ftmp); //close tmp file
 
 	if (err != OK) {
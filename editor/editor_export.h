@@ -33,6 +33,10 @@
 
 #include "core/io/dir_access.h"
 #include "core/io/resource.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
 #include "scene/main/node.h"
 #include "scene/main/timer.h"
 #include "scene/resources/texture.h"
@@ -186,6 +190,25 @@ private:
 		Vector<SavedData> file_ofs;
 		EditorProgress *ep = nullptr;
 		Vector<SharedObject> *so_files = nullptr;
+
+		// Files are hashed, encrypted and written on a separate thread, in export order, while the
+		// next ones are being converted. Exporting waits when too much data is queued.
+		struct QueuedFile {
+			SavedData saved;
+			Vector<uint8_t> data;
+			Vector<uint8_t> key;
+		};
+
+		Thread writer;
+		Mutex mutex;
+		Semaphore work_semaphore;
+		Semaphore done_semaphore;
+		List<QueuedFile> queue;
+		uint64_t queued_bytes = 0;
+		Error error = OK;
+
+		// Offset of every distinct content already stored, by SHA-256, so identical files are stored once.
+		HashMap<String, uint64_t> stored_contents;
 	};
 
 	struct ZipData {
@@ -203,6 +226,8 @@ private:
 
 	void gen_debug_flags(Vector<String> &r_flags, int p_flags);
 	static Error _save_pack_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key);
+	static Error _store_pack_file(PackData *p_pd, PackData::QueuedFile &p_file);
+	static void _pack_writer_thread(void *p_userdata);
 	static Error _save_zip_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key);
 
 	void _edit_files_with_filter(DirAccess *da, const Vector<String> &p_filters, Set<String> &r_list, bool exclude);
@@ -37,6 +37,7 @@
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/os/os.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/variant/variant_parser.h"
 #include "editor_node.h"
 #include "editor_resource_preview.h"
@@ -699,6 +700,28 @@ EditorFileSystem::ScanProgress EditorFileSystem::ScanProgress::get_sub(int p_cur
 	return sp;
 }
 
+void EditorFileSystem::_import_check_task(uint32_t p_index, ImportCheck *p_checks) {
+	ImportCheck &check = p_checks[p_index];
+
+	check.modification_time = FileAccess::get_modified_time(check.path);
+	bool has_import_file = FileAccess::exists(check.path + ".import");
+	check.import_modification_time = has_import_file ? FileAccess::get_modified_time(check.path + ".import") : 0;
+
+	check.up_to_date = check.cached && check.modification_time == check.cached_modification_time && (has_import_file || !check.require_import_file) && check.import_modification_time == check.cached_import_modification_time && !_test_for_reimport(check.path, true);
+}
+
+void EditorFileSystem::_run_import_checks(Vector<ImportCheck> &r_checks) {
+	// Stat'ing the files and parsing their .import file is most of the time spent scanning an unchanged project.
+	if (r_checks.size() < 16) {
+		for (int i = 0; i < r_checks.size(); i++) {
+			_import_check_task(i, r_checks.ptrw());
+		}
+	} else {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &EditorFileSystem::_import_check_task, r_checks.ptrw(), r_checks.size());
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+}
+
 void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess *da, const ScanProgress &p_progress) {
 	List<String> dirs;
 	List<String> files;
@@ -778,6 +801,26 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess
 		p_progress.update(idx, total);
 	}
 
+	Vector<ImportCheck> import_checks;
+	for (List<String>::Element *E = files.front(); E; E = E->next()) {
+		String ext = E->get().get_extension().to_lower();
+		if (!valid_extensions.has(ext) || !import_extensions.has(ext)) {
+			continue;
+		}
+
+		ImportCheck check;
+		check.path = cd.plus_file(E->get());
+		FileCache *fc = file_cache.getptr(check.path);
+		if (fc) {
+			check.cached = true;
+			check.cached_modification_time = fc->modification_time;
+			check.cached_import_modification_time = fc->import_modification_time;
+		}
+		import_checks.push_back(check);
+	}
+	_run_import_checks(import_checks);
+	int import_check_idx = 0;
+
 	for (List<String>::Element *E = files.front(); E; E = E->next(), idx++) {
 		String ext = E->get().get_extension().to_lower();
 		if (!valid_extensions.has(ext)) {
@@ -790,16 +833,10 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess
 		String path = cd.plus_file(fi->file);
 
 		FileCache *fc = file_cache.getptr(path);
-		uint64_t mt = FileAccess::get_modified_time(path);
 
 		if (import_extensions.has(ext)) {
 			//is imported
-			uint64_t import_mt = 0;
-			if (FileAccess::exists(path + ".import")) {
-				import_mt = FileAccess::get_modified_time(path + ".import");
-			}
-
-			if (fc && fc->modification_time == mt && fc->import_modification_time == import_mt && !_test_for_reimport(path, true)) {
+			if (import_checks[import_check_idx++].up_to_date) {
 				fi->type = fc->type;
 				fi->uid = fc->uid;
 				fi->deps = fc->deps;
@@ -848,6 +885,7 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess
 				scan_actions.push_back(ia);
 			}
 		} else {
+			uint64_t mt = FileAccess::get_modified_time(path);
 			if (fc && fc->modification_time == mt) {
 				//not imported, so just update type if changed
 				fi->type = fc->type;
@@ -1021,6 +1059,23 @@ void EditorFileSystem::_scan_fs_changes(EditorFileSystemDirectory *p_dir, const
 		da->list_dir_end();
 	}
 
+	Vector<ImportCheck> import_checks;
+	for (int i = 0; i < p_dir->files.size(); i++) {
+		if ((updated_dir && !p_dir->files[i]->verified) || !import_extensions.has(p_dir->files[i]->file.get_extension().to_lower())) {
+			continue;
+		}
+
+		ImportCheck check;
+		check.path = cd.plus_file(p_dir->files[i]->file);
+		check.cached = true;
+		check.require_import_file = true;
+		check.cached_modification_time = p_dir->files[i]->modified_time;
+		check.cached_import_modification_time = p_dir->files[i]->import_modified_time;
+		import_checks.push_back(check);
+	}
+	_run_import_checks(import_checks);
+	int import_check_idx = 0;
+
 	for (int i = 0; i < p_dir->files.size(); i++) {
 		if (updated_dir && !p_dir->files[i]->verified) {
 			//this file was removed, add action to remove it
@@ -1035,26 +1090,9 @@ void EditorFileSystem::_scan_fs_changes(EditorFileSystemDirectory *p_dir, const
 		String path = cd.plus_file(p_dir->files[i]->file);
 
 		if (import_extensions.has(p_dir->files[i]->file.get_extension().to_lower())) {
-			//check here if file must be imported or not
-
-			uint64_t mt = FileAccess::get_modified_time(path);
-
-			bool reimport = false;
-
-			if (mt != p_dir->files[i]->modified_time) {
-				reimport = true; //it was modified, must be reimported.
-			} else if (!FileAccess::exists(path + ".import")) {
-				reimport = true; //no .import file, obviously reimport
-			} else {
-				uint64_t import_mt = FileAccess::get_modified_time(path + ".import");
-				if (import_mt != p_dir->files[i]->import_modified_time) {
-					reimport = true;
-				} else if (_test_for_reimport(path, true)) {
-					reimport = true;
-				}
-			}
+			//check here if file must be imported or not, done above by _run_import_checks()
 
-			if (reimport) {
+			if (!import_checks[import_check_idx++].up_to_date) {
 				ItemAction ia;
 				ia.action = ItemAction::ACTION_FILE_TEST_REIMPORT;
 				ia.dir = p_dir;
@@ -214,6 +214,22 @@ class EditorFileSystem : public Node {
 
 	bool _test_for_reimport(const String &p_path, bool p_only_imported_files);
 
+	/* Used to check imported files for changes in parallel while scanning */
+	struct ImportCheck {
+		String path;
+		bool cached = false;
+		bool require_import_file = false;
+		uint64_t cached_modification_time = 0;
+		uint64_t cached_import_modification_time = 0;
+
+		uint64_t modification_time = 0;
+		uint64_t import_modification_time = 0;
+		bool up_to_date = false;
+	};
+
+	void _import_check_task(uint32_t p_index, ImportCheck *p_checks);
+	void _run_import_checks(Vector<ImportCheck> &r_checks);
+
 	bool reimport_on_missing_imported_files;
 
 	Vector<String> _get_dependencies(const String &p_path);
@@ -31,6 +31,7 @@
 #include "resource_importer_scene.h"
 
 #include "core/io/resource_saver.h"
+#include "core/os/worker_thread_pool.h"
 #include "editor/editor_node.h"
 
 #include "editor/import/scene_import_settings.h"
@@ -950,6 +951,13 @@ Node *ResourceImporterScene::_post_fix_node(Node *p_node, Node *p_root, Map<Ref<
 				}
 			}
 		}
+
+		bool use_compression = node_settings["compression/enabled"];
+		int anim_compression_page_size = node_settings["compression/page_size"];
+
+		if (use_compression) {
+			_compress_animations(ap, anim_compression_page_size);
+		}
 	}
 
 	return p_node;
@@ -1149,6 +1157,18 @@ void ResourceImporterScene::_optimize_animations(AnimationPlayer *anim, float p_
 	}
 }
 
+void ResourceImporterScene::_compress_animations(AnimationPlayer *anim, int p_page_size_kb) {
+	List<StringName> anim_names;
+	anim->get_animation_list(&anim_names);
+	for (const StringName &E : anim_names) {
+		Ref<Animation> a = anim->get_animation(E);
+		if (a->get_path().is_resource_file()) {
+			continue; // Saved to its own file, keep it editable.
+		}
+		a->compress(p_page_size_kb * 1024);
+	}
+}
+
 void ResourceImporterScene::get_internal_import_options(InternalImportCategory p_category, List<ImportOption> *r_options) const {
 	switch (p_category) {
 		case INTERNAL_IMPORT_CATEGORY_NODE: {
@@ -1212,6 +1232,8 @@ void ResourceImporterScene::get_internal_import_options(InternalImportCategory p
 			r_options->push_back(ImportOption(PropertyInfo(Variant::FLOAT, "optimizer/max_linear_error"), 0.05));
 			r_options->push_back(ImportOption(PropertyInfo(Variant::FLOAT, "optimizer/max_angular_error"), 0.01));
 			r_options->push_back(ImportOption(PropertyInfo(Variant::FLOAT, "optimizer/max_angle"), 22));
+			r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "compression/enabled", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), false));
+			r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "compression/page_size", PROPERTY_HINT_RANGE, "4,512,1"), 8));
 			r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "import_tracks/position", PROPERTY_HINT_ENUM, "IfPresent,IfPresentForAll,Never"), 1));
 			r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "import_tracks/rotation", PROPERTY_HINT_ENUM, "IfPresent,IfPresentForAll,Never"), 1));
 			r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "import_tracks/scale", PROPERTY_HINT_ENUM, "IfPresent,IfPresentForAll,Never"), 1));
@@ -1324,6 +1346,10 @@ bool ResourceImporterScene::get_internal_option_visibility(InternalImportCategor
 				return false;
 			}
 
+			if (p_option.begins_with("animation/compression/") && p_option != "animation/compression/enabled" && !bool(p_options["animation/compression/enabled"])) {
+				return false;
+			}
+
 			if (p_option.begins_with("animation/slice_")) {
 				int max_slice = p_options["animation/slices/amount"];
 				int slice = p_option.get_slice("/", 1).get_slice("_", 1).to_int() - 1;
@@ -1484,92 +1510,109 @@ Ref<Animation> ResourceImporterScene::import_animation_from_other_importer(Edito
 	return importer->import_animation(p_path, p_flags, p_bake_fps);
 }
 
-void ResourceImporterScene::_generate_meshes(Node *p_node, const Dictionary &p_mesh_data, bool p_generate_lods, bool p_create_shadow_meshes, LightBakeMode p_light_bake_mode, float p_lightmap_texel_size, const Vector<uint8_t> &p_src_lightmap_cache, Vector<Vector<uint8_t>> &r_lightmap_caches) {
+void ResourceImporterScene::_gather_mesh_settings(Node *p_node, const Dictionary &p_mesh_data, bool p_generate_lods, bool p_create_shadow_meshes, LightBakeMode p_light_bake_mode, Map<Ref<ImporterMesh>, MeshGenerateSettings> &r_mesh_settings) {
 	ImporterMeshInstance3D *src_mesh_node = Object::cast_to<ImporterMeshInstance3D>(p_node);
-	if (src_mesh_node) {
-		//is mesh
-		MeshInstance3D *mesh_node = memnew(MeshInstance3D);
-		mesh_node->set_name(src_mesh_node->get_name());
-		mesh_node->set_transform(src_mesh_node->get_transform());
-		mesh_node->set_skin(src_mesh_node->get_skin());
-		mesh_node->set_skeleton_path(src_mesh_node->get_skeleton_path());
-		if (src_mesh_node->get_mesh().is_valid()) {
-			Ref<ArrayMesh> mesh;
-			if (!src_mesh_node->get_mesh()->has_mesh()) {
-				//do mesh processing
+	if (src_mesh_node && src_mesh_node->get_mesh().is_valid() && !src_mesh_node->get_mesh()->has_mesh() && !r_mesh_settings.has(src_mesh_node->get_mesh())) {
+		MeshGenerateSettings settings;
+		settings.generate_lods = p_generate_lods;
+		settings.create_shadow_meshes = p_create_shadow_meshes;
+		settings.bake_lightmaps = p_light_bake_mode == LIGHT_BAKE_STATIC_LIGHTMAPS;
 
-				bool generate_lods = p_generate_lods;
-				float split_angle = 25.0f;
-				float merge_angle = 60.0f;
-				bool create_shadow_meshes = p_create_shadow_meshes;
-				bool bake_lightmaps = p_light_bake_mode == LIGHT_BAKE_STATIC_LIGHTMAPS;
-				String save_to_file;
+		String mesh_id;
+
+		if (src_mesh_node->get_mesh()->has_meta("import_id")) {
+			mesh_id = src_mesh_node->get_mesh()->get_meta("import_id");
+		} else {
+			mesh_id = src_mesh_node->get_mesh()->get_name();
+		}
 
-				String mesh_id;
+		if (mesh_id != String() && p_mesh_data.has(mesh_id)) {
+			Dictionary mesh_settings = p_mesh_data[mesh_id];
 
-				if (src_mesh_node->get_mesh()->has_meta("import_id")) {
-					mesh_id = src_mesh_node->get_mesh()->get_meta("import_id");
-				} else {
-					mesh_id = src_mesh_node->get_mesh()->get_name();
+			if (mesh_settings.has("generate/shadow_meshes")) {
+				int shadow_meshes = mesh_settings["generate/shadow_meshes"];
+				if (shadow_meshes == MESH_OVERRIDE_ENABLE) {
+					settings.create_shadow_meshes = true;
+				} else if (shadow_meshes == MESH_OVERRIDE_DISABLE) {
+					settings.create_shadow_meshes = false;
 				}
+			}
 
-				if (mesh_id != String() && p_mesh_data.has(mesh_id)) {
-					Dictionary mesh_settings = p_mesh_data[mesh_id];
+			if (mesh_settings.has("generate/lightmap_uv")) {
+				int lightmap_uv = mesh_settings["generate/lightmap_uv"];
+				if (lightmap_uv == MESH_OVERRIDE_ENABLE) {
+					settings.bake_lightmaps = true;
+				} else if (lightmap_uv == MESH_OVERRIDE_DISABLE) {
+					settings.bake_lightmaps = false;
+				}
+			}
 
-					if (mesh_settings.has("generate/shadow_meshes")) {
-						int shadow_meshes = mesh_settings["generate/shadow_meshes"];
-						if (shadow_meshes == MESH_OVERRIDE_ENABLE) {
-							create_shadow_meshes = true;
-						} else if (shadow_meshes == MESH_OVERRIDE_DISABLE) {
-							create_shadow_meshes = false;
-						}
-					}
+			if (mesh_settings.has("generate/lods")) {
+				int lods = mesh_settings["generate/lods"];
+				if (lods == MESH_OVERRIDE_ENABLE) {
+					settings.generate_lods = true;
+				} else if (lods == MESH_OVERRIDE_DISABLE) {
+					settings.generate_lods = false;
+				}
+			}
 
-					if (mesh_settings.has("generate/lightmap_uv")) {
-						int lightmap_uv = mesh_settings["generate/lightmap_uv"];
-						if (lightmap_uv == MESH_OVERRIDE_ENABLE) {
-							bake_lightmaps = true;
-						} else if (lightmap_uv == MESH_OVERRIDE_DISABLE) {
-							bake_lightmaps = false;
-						}
-					}
+			if (mesh_settings.has("lods/normal_split_angle")) {
+				settings.split_angle = mesh_settings["lods/normal_split_angle"];
+			}
 
-					if (mesh_settings.has("generate/lods")) {
-						int lods = mesh_settings["generate/lods"];
-						if (lods == MESH_OVERRIDE_ENABLE) {
-							generate_lods = true;
-						} else if (lods == MESH_OVERRIDE_DISABLE) {
-							generate_lods = false;
-						}
-					}
+			if (mesh_settings.has("lods/normal_merge_angle")) {
+				settings.merge_angle = mesh_settings["lods/normal_merge_angle"];
+			}
 
-					if (mesh_settings.has("lods/normal_split_angle")) {
-						split_angle = mesh_settings["lods/normal_split_angle"];
-					}
+			if (mesh_settings.has("save_to_file/enabled") && bool(mesh_settings["save_to_file/enabled"]) && mesh_settings.has("save_to_file/path")) {
+				settings.save_to_file = mesh_settings["save_to_file/path"];
+				if (!settings.save_to_file.is_resource_file()) {
+					settings.save_to_file = "";
+				}
+			}
 
-					if (mesh_settings.has("lods/normal_merge_angle")) {
-						merge_angle = mesh_settings["lods/normal_merge_angle"];
-					}
+			for (int i = 0; i < post_importer_plugins.size(); i++) {
+				post_importer_plugins.write[i]->internal_process(EditorScenePostImportPlugin::INTERNAL_IMPORT_CATEGORY_MESH, nullptr, src_mesh_node, src_mesh_node->get_mesh(), mesh_settings);
+			}
+		}
 
-					if (mesh_settings.has("save_to_file/enabled") && bool(mesh_settings["save_to_file/enabled"]) && mesh_settings.has("save_to_file/path")) {
-						save_to_file = mesh_settings["save_to_file/path"];
-						if (!save_to_file.is_resource_file()) {
-							save_to_file = "";
-						}
-					}
+		r_mesh_settings[src_mesh_node->get_mesh()] = settings;
+	}
 
-					for (int i = 0; i < post_importer_plugins.size(); i++) {
-						post_importer_plugins.write[i]->internal_process(EditorScenePostImportPlugin::INTERNAL_IMPORT_CATEGORY_MESH, nullptr, src_mesh_node, src_mesh_node->get_mesh(), mesh_settings);
-					}
-				}
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		_gather_mesh_settings(p_node->get_child(i), p_mesh_data, p_generate_lods, p_create_shadow_meshes, p_light_bake_mode, r_mesh_settings);
+	}
+}
 
-				if (generate_lods) {
-					src_mesh_node->get_mesh()->generate_lods(merge_angle, split_angle);
-				}
+void ResourceImporterScene::_generate_mesh_task(uint32_t p_index, MeshGenerateTask *p_tasks) {
+	MeshGenerateTask &task = p_tasks[p_index];
 
-				if (create_shadow_meshes) {
-					src_mesh_node->get_mesh()->create_shadow_mesh();
-				}
+	if (task.settings->generate_lods) {
+		task.mesh->generate_lods(task.settings->merge_angle, task.settings->split_angle);
+	}
+
+	if (task.settings->create_shadow_meshes) {
+		task.mesh->create_shadow_mesh();
+	}
+}
+
+void ResourceImporterScene::_generate_meshes(Node *p_node, const Map<Ref<ImporterMesh>, MeshGenerateSettings> &p_mesh_settings, LightBakeMode p_light_bake_mode, float p_lightmap_texel_size, const Vector<uint8_t> &p_src_lightmap_cache, Vector<Vector<uint8_t>> &r_lightmap_caches) {
+	ImporterMeshInstance3D *src_mesh_node = Object::cast_to<ImporterMeshInstance3D>(p_node);
+	if (src_mesh_node) {
+		//is mesh
+		MeshInstance3D *mesh_node = memnew(MeshInstance3D);
+		mesh_node->set_name(src_mesh_node->get_name());
+		mesh_node->set_transform(src_mesh_node->get_transform());
+		mesh_node->set_skin(src_mesh_node->get_skin());
+		mesh_node->set_skeleton_path(src_mesh_node->get_skeleton_path());
+		if (src_mesh_node->get_mesh().is_valid()) {
+			Ref<ArrayMesh> mesh;
+			const Map<Ref<ImporterMesh>, MeshGenerateSettings>::Element *E = p_mesh_settings.find(src_mesh_node->get_mesh());
+			if (!src_mesh_node->get_mesh()->has_mesh() && E) {
+				//do mesh processing, LODs and shadow meshes are already generated
+
+				bool bake_lightmaps = E->get().bake_lightmaps;
+				const String &save_to_file = E->get().save_to_file;
 
 				if (bake_lightmaps) {
 					Transform3D xf;
@@ -1649,7 +1692,7 @@ void ResourceImporterScene::_generate_meshes(Node *p_node, const Dictionary &p_m
 	}
 
 	for (int i = 0; i < p_node->get_child_count(); i++) {
-		_generate_meshes(p_node->get_child(i), p_mesh_data, p_generate_lods, p_create_shadow_meshes, p_light_bake_mode, p_lightmap_texel_size, p_src_lightmap_cache, r_lightmap_caches);
+		_generate_meshes(p_node->get_child(i), p_mesh_settings, p_light_bake_mode, p_lightmap_texel_size, p_src_lightmap_cache, r_lightmap_caches);
 	}
 }
 
@@ -1985,7 +2028,26 @@ Error ResourceImporterScene::import(const String &p_source_file, const String &p
 	if (subresources.has("meshes")) {
 		mesh_data = subresources["meshes"];
 	}
-	_generate_meshes(scene, mesh_data, gen_lods, create_shadow_meshes, LightBakeMode(light_bake_mode), lightmap_texel_size, src_lightmap_cache, mesh_lightmap_caches);
+
+	Map<Ref<ImporterMesh>, MeshGenerateSettings> mesh_settings;
+	_gather_mesh_settings(scene, mesh_data, gen_lods, create_shadow_meshes, LightBakeMode(light_bake_mode), mesh_settings);
+
+	// LOD and shadow mesh generation only touch their own mesh, so unique meshes are processed in parallel.
+	Vector<MeshGenerateTask> mesh_tasks;
+	for (Map<Ref<ImporterMesh>, MeshGenerateSettings>::Element *E = mesh_settings.front(); E; E = E->next()) {
+		if (E->get().generate_lods || E->get().create_shadow_meshes) {
+			MeshGenerateTask task;
+			task.mesh = E->key();
+			task.settings = &E->get();
+			mesh_tasks.push_back(task);
+		}
+	}
+	if (mesh_tasks.size()) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &ResourceImporterScene::_generate_mesh_task, mesh_tasks.ptrw(), mesh_tasks.size());
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+
+	_generate_meshes(scene, mesh_settings, LightBakeMode(light_bake_mode), lightmap_texel_size, src_lightmap_cache, mesh_lightmap_caches);
 
 	if (mesh_lightmap_caches.size()) {
 		FileAccessRef f = FileAccess::open(p_source_file + ".unwrap_cache", FileAccess::WRITE);
@@ -195,7 +195,24 @@ class ResourceImporterScene : public ResourceImporter {
 	};
 
 	void _replace_owner(Node *p_node, Node *p_scene, Node *p_new_owner);
-	void _generate_meshes(Node *p_node, const Dictionary &p_mesh_data, bool p_generate_lods, bool p_create_shadow_meshes, LightBakeMode p_light_bake_mode, float p_lightmap_texel_size, const Vector<uint8_t> &p_src_lightmap_cache, Vector<Vector<uint8_t>> &r_lightmap_caches);
+
+	struct MeshGenerateSettings {
+		bool generate_lods = false;
+		float split_angle = 25.0f;
+		float merge_angle = 60.0f;
+		bool create_shadow_meshes = false;
+		bool bake_lightmaps = false;
+		String save_to_file;
+	};
+
+	struct MeshGenerateTask {
+		Ref<ImporterMesh> mesh;
+		const MeshGenerateSettings *settings = nullptr;
+	};
+
+	void _gather_mesh_settings(Node *p_node, const Dictionary &p_mesh_data, bool p_generate_lods, bool p_create_shadow_meshes, LightBakeMode p_light_bake_mode, Map<Ref<ImporterMesh>, MeshGenerateSettings> &r_mesh_settings);
+	void _generate_mesh_task(uint32_t p_index, MeshGenerateTask *p_tasks);
+	void _generate_meshes(Node *p_node, const Map<Ref<ImporterMesh>, MeshGenerateSettings> &p_mesh_settings, LightBakeMode p_light_bake_mode, float p_lightmap_texel_size, const Vector<uint8_t> &p_src_lightmap_cache, Vector<Vector<uint8_t>> &r_lightmap_caches);
 	void _add_shapes(Node *p_node, const Vector<Ref<Shape3D>> &p_shapes);
 
 	enum AnimationImportTracks {
@@ -261,6 +278,7 @@ public:
 	Ref<Animation> _save_animation_to_file(Ref<Animation> anim, bool p_save_to_file, String p_save_to_path, bool p_keep_custom_tracks);
 	void _create_clips(AnimationPlayer *anim, const Array &p_clips, bool p_bake_all);
 	void _optimize_animations(AnimationPlayer *anim, float p_max_lin_error, float p_max_ang_error, float p_max_angle);
+	void _compress_animations(AnimationPlayer *anim, int p_page_size_kb);
 
 	Node *pre_import(const String &p_source_file);
 	virtual Error import(const String &p_source_file, const String &p_save_path, const Map<StringName, Variant> &p_options, List<String> *r_platform_variants, List<String> *r_gen_files = nullptr, Variant *r_metadata = nullptr) override;
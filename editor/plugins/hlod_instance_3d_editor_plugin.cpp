@@ -0,0 +1,77 @@
+/*************************************************************************/
+/*  hlod_instance_3d_editor_plugin.cpp                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "hlod_instance_3d_editor_plugin.h"
+
+void HLODInstance3DEditorPlugin::_bake() {
+	if (!hlod_instance) {
+		return;
+	}
+
+	if (hlod_instance->bake() == HLODInstance3D::BAKE_ERROR_NO_MESHES) {
+		EditorNode::get_singleton()->show_warning(TTR("No meshes to bake.\nMake sure the HLODInstance3D has at least one indexed, unskinned MeshInstance3D child whose visual layers are part of its Bake Mask property."));
+	}
+}
+
+void HLODInstance3DEditorPlugin::edit(Object *p_object) {
+	HLODInstance3D *s = Object::cast_to<HLODInstance3D>(p_object);
+	if (!s) {
+		return;
+	}
+
+	hlod_instance = s;
+}
+
+bool HLODInstance3DEditorPlugin::handles(Object *p_object) const {
+	return p_object->is_class("HLODInstance3D");
+}
+
+void HLODInstance3DEditorPlugin::make_visible(bool p_visible) {
+	if (p_visible) {
+		bake->show();
+	} else {
+		bake->hide();
+	}
+}
+
+HLODInstance3DEditorPlugin::HLODInstance3DEditorPlugin(EditorNode *p_node) {
+	editor = p_node;
+	bake = memnew(Button);
+	bake->set_flat(true);
+	bake->set_icon(editor->get_gui_base()->get_theme_icon(SNAME("Bake"), SNAME("EditorIcons")));
+	bake->set_text(TTR("Bake HLOD"));
+	bake->hide();
+	bake->connect("pressed", callable_mp(this, &HLODInstance3DEditorPlugin::_bake));
+	add_control_to_container(CONTAINER_SPATIAL_EDITOR_MENU, bake);
+	hlod_instance = nullptr;
+}
+
+HLODInstance3DEditorPlugin::~HLODInstance3DEditorPlugin() {
+}
@@ -0,0 +1,115 @@
+/*************************************************************************/
+/*  frame_pacer.cpp                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "frame_pacer.h"
+
+#include "core/config/engine.h"
+#include "core/os/os.h"
+#include "servers/display_server.h"
+#include "servers/rendering/rendering_device.h"
+
+uint64_t FramePacer::_get_frame_interval_usec() const {
+	const int target_fps = Engine::get_singleton()->get_target_fps();
+	if (target_fps > 0) {
+		return 1000000 / target_fps;
+	}
+
+	if (DisplayServer::get_singleton()->window_get_vsync_mode(DisplayServer::MAIN_WINDOW_ID) == DisplayServer::VSYNC_DISABLED) {
+		// Frames go out as soon as they are done, there is nothing to pace against.
+		return 0;
+	}
+
+	RenderingDevice *rd = RenderingDevice::get_singleton();
+	if (rd && rd->get_refresh_cycle_duration_usec() > 0) {
+		return rd->get_refresh_cycle_duration_usec();
+	}
+
+	// VSync bound frames are spaced by the refresh cycle, the shortest recent spacing is the best guess.
+	uint64_t interval = 0;
+	for (int i = 0; i < history_count; i++) {
+		if (interval == 0 || period_usec[i] < interval) {
+			interval = period_usec[i];
+		}
+	}
+	return interval;
+}
+
+void FramePacer::begin_frame(uint64_t p_ticks_usec) {
+	frame_begin_usec = p_ticks_usec;
+}
+
+void FramePacer::end_frame(uint64_t p_ticks_usec) {
+	RenderingDevice *rd = RenderingDevice::get_singleton();
+	const uint64_t blocked = rd ? rd->get_present_wait_time_usec() : 0;
+	const uint64_t elapsed = p_ticks_usec - frame_begin_usec;
+
+	if (frame_end_usec > 0) {
+		work_usec[history_pos] = elapsed > blocked ? elapsed - blocked : 0;
+		period_usec[history_pos] = p_ticks_usec - frame_end_usec;
+		history_pos = (history_pos + 1) % HISTORY_SIZE;
+		history_count = MIN(history_count + 1, HISTORY_SIZE);
+	}
+	frame_end_usec = p_ticks_usec;
+}
+
+void FramePacer::delay() {
+	if (history_count == 0) {
+		return;
+	}
+
+	const uint64_t interval = _get_frame_interval_usec();
+	if (interval == 0) {
+		return;
+	}
+
+	// Pace by the slowest recent frame, running late costs a whole refresh while running early only
+	// costs the margin.
+	uint64_t expected_work = 0;
+	for (int i = 0; i < history_count; i++) {
+		expected_work = MAX(expected_work, work_usec[i]);
+	}
+	expected_work += SAFETY_MARGIN_USEC;
+	if (expected_work >= interval) {
+		// Frames can't keep up, starting them right away already gives the lowest latency.
+		return;
+	}
+
+	const uint64_t wake_usec = frame_end_usec + interval - expected_work;
+	const uint64_t current_usec = OS::get_singleton()->get_ticks_usec();
+	if (wake_usec > current_usec) {
+		OS::get_singleton()->delay_usec(wake_usec - current_usec);
+	}
+}
+
+void FramePacer::reset() {
+	history_pos = 0;
+	history_count = 0;
+	frame_end_usec = 0;
+}
@@ -0,0 +1,65 @@
+/*************************************************************************/
+/*  frame_pacer.h                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include "core/typedefs.h"
+
+// Low latency frame pacing. Instead of sleeping after a frame is drawn, sleeps right before the next
+// one starts, so input is sampled as late as possible while the frame is still ready for the next
+// refresh (or the next target FPS tick).
+class FramePacer {
+	static const int HISTORY_SIZE = 32;
+	// Covers the scheduler waking up late and small frame time spikes.
+	static const uint64_t SAFETY_MARGIN_USEC = 1000;
+
+	// CPU time of the last frames, not counting the time blocked waiting for the GPU and presentation.
+	uint64_t work_usec[HISTORY_SIZE] = {};
+	// Time between the ends of the last frames, used to guess the refresh cycle when it's not reported.
+	uint64_t period_usec[HISTORY_SIZE] = {};
+	int history_pos = 0;
+	int history_count = 0;
+
+	uint64_t frame_begin_usec = 0;
+	uint64_t frame_end_usec = 0;
+
+	uint64_t _get_frame_interval_usec() const;
+
+public:
+	void begin_frame(uint64_t p_ticks_usec);
+	void end_frame(uint64_t p_ticks_usec);
+	// Sleeps until the next frame has to start to be ready in time.
+	void delay();
+	// Forgets the history, e.g. after frames that were not drawn.
+	void reset();
+};
+
+#endif // FRAME_PACER_H
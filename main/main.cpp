@@ -34,6 +34,7 @@
 #include "core/core_string_names.h"
 #include "core/crypto/crypto.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/trace_zones.h"
 #include "core/extension/extension_api_dump.h"
 #include "core/input/input.h"
 #include "core/input/input_map.h"
@@ -45,16 +46,20 @@
 #include "core/io/ip.h"
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
+#include "core/os/frame_allocator.h"
 #include "core/os/os.h"
 #include "core/os/time.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/register_core_types.h"
 #include "core/string/translation.h"
 #include "core/version.h"
 #include "core/version_hash.gen.h"
 #include "drivers/register_driver_types.h"
 #include "main/app_icon.gen.h"
+#include "main/frame_pacer.h"
 #include "main/main_timer_sync.h"
 #include "main/performance.h"
+#include "main/scene_benchmark.h"
 #include "main/splash.gen.h"
 #include "main/splash_editor.gen.h"
 #include "modules/modules_enabled.gen.h"
@@ -172,9 +177,17 @@ static bool debug_collisions = false;
 static bool debug_navigation = false;
 #endif
 static int frame_delay = 0;
+static bool low_latency_frame_pacing = false;
+static bool physics_interpolation = false;
 static bool disable_render_loop = false;
 static int fixed_fps = -1;
 static bool print_fps = false;
+#ifdef TRACE_ZONES_ENABLED
+static String trace_zones_path;
+#endif
+static String benchmark_scene;
+static int benchmark_frames = 600;
+static String benchmark_output_path;
 #ifdef TOOLS_ENABLED
 static bool dump_extension_api = false;
 #endif
@@ -182,6 +195,10 @@ bool profile_gpu = false;
 
 /* Helper methods */
 
+static void _load_text_support_data(void *p_userdata) {
+	TextServerManager::get_singleton()->get_primary_interface()->load_support_data(String());
+}
+
 // Used by Mono module, should likely be registered in Engine singleton instead
 // FIXME: This is also not 100% accurate, `project_manager` is only true when it was requested,
 // but not if e.g. we fail to load and project and fallback to the manager.
@@ -362,7 +379,19 @@ void Main::print_help(const char *p_binary) {
 	OS::get_singleton()->print("  --disable-crash-handler                      Disable crash handler when supported by the platform code.\n");
 	OS::get_singleton()->print("  --fixed-fps <fps>                            Force a fixed number of frames per second. This setting disables real-time synchronization.\n");
 	OS::get_singleton()->print("  --print-fps                                  Print the frames per second to the stdout.\n");
+	OS::get_singleton()->print("  --startup-profile                            Print the time taken by each step of the engine startup to the stdout.\n");
+#ifdef TRACE_ZONES_ENABLED
+	OS::get_singleton()->print("  --trace-zones <file>                         Record the engine timing zones of every thread and save them as Chrome trace JSON on exit.\n");
+#endif
 	OS::get_singleton()->print("  --profile-gpu                                Show a simple profile of the tasks that took more time during frame rendering.\n");
+	OS::get_singleton()->print("  --benchmark-scene <name>                     Run a standard benchmark scene instead of the project, then quit. The scene is one of:\n");
+	OS::get_singleton()->print("                                                 ");
+	for (int i = 0; i < SceneBenchmark::SCENE_MAX; i++) {
+		OS::get_singleton()->print("%s%s", i > 0 ? ", " : "", SceneBenchmark::get_scene_name(SceneBenchmark::Scene(i)));
+	}
+	OS::get_singleton()->print(".\n");
+	OS::get_singleton()->print("  --benchmark-frames <frames>                  Number of frames measured by --benchmark-scene after warming up (default: 600).\n");
+	OS::get_singleton()->print("  --benchmark-output <file>                    Save the --benchmark-scene results as JSON instead of printing them.\n");
 	OS::get_singleton()->print("\n");
 
 	OS::get_singleton()->print("Standalone tools:\n");
@@ -404,6 +433,10 @@ Error Main::test_setup() {
 
 	globals = memnew(ProjectSettings);
 
+	register_core_settings(); // Here globals are present.
+
+	WorkerThreadPool::get_singleton()->init();
+
 	GLOBAL_DEF("debug/settings/crash_handler/message",
 			String("Please include this when reporting the bug on https://github.com/godotengine/godot/issues"));
 	GLOBAL_DEF_RST("rendering/occlusion_culling/bvh_build_quality", 2);
@@ -1052,8 +1085,49 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			}
 		} else if (I->get() == "--print-fps") {
 			print_fps = true;
+		} else if (I->get() == "--startup-profile") {
+			engine->startup_profiling = true;
+#ifdef TRACE_ZONES_ENABLED
+		} else if (I->get() == "--trace-zones") {
+			if (I->next()) {
+				trace_zones_path = I->next()->get();
+				TraceZones::begin_capture();
+				N = I->next()->next();
+			} else {
+				OS::get_singleton()->print("Missing trace zones file argument, aborting.\n");
+				goto error;
+			}
+#endif
 		} else if (I->get() == "--profile-gpu") {
 			profile_gpu = true;
+		} else if (I->get() == "--benchmark-scene") {
+			if (I->next()) {
+				benchmark_scene = I->next()->get();
+				if (SceneBenchmark::find_scene(benchmark_scene) == SceneBenchmark::SCENE_MAX) {
+					OS::get_singleton()->print("Unknown benchmark scene '%s', aborting.\n", benchmark_scene.utf8().get_data());
+					goto error;
+				}
+				N = I->next()->next();
+			} else {
+				OS::get_singleton()->print("Missing benchmark scene argument, aborting.\n");
+				goto error;
+			}
+		} else if (I->get() == "--benchmark-frames") {
+			if (I->next()) {
+				benchmark_frames = I->next()->get().to_int();
+				N = I->next()->next();
+			} else {
+				OS::get_singleton()->print("Missing benchmark frames argument, aborting.\n");
+				goto error;
+			}
+		} else if (I->get() == "--benchmark-output") {
+			if (I->next()) {
+				benchmark_output_path = I->next()->get();
+				N = I->next()->next();
+			} else {
+				OS::get_singleton()->print("Missing benchmark output file argument, aborting.\n");
+				goto error;
+			}
 		} else if (I->get() == "--disable-crash-handler") {
 			OS::get_singleton()->disable_crash_handler();
 		} else if (I->get() == "--skip-breakpoints") {
@@ -1116,6 +1190,14 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 
 	ResourceUID::get_singleton()->load_from_cache(); // load UUIDs from cache.
 
+	engine->startup_profile_step("Core types, command line and project settings");
+
+	// Worker threads are started once the project settings are known.
+	// Query the processor topology before any thread may need it.
+	OS::get_singleton()->get_processor_topology();
+	WorkerThreadPool::get_singleton()->init(GLOBAL_GET("threading/worker_pool/max_threads"), Thread::CoreClass(int(GLOBAL_GET("threading/worker_pool/core_class"))));
+	ResourceLoader::set_thread_load_core_class(Thread::CoreClass(int(GLOBAL_GET("threading/resource_loader/core_class"))));
+
 	GLOBAL_DEF("memory/limits/multithreaded_server/rid_pool_prealloc", 60);
 	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/multithreaded_server/rid_pool_prealloc",
 			PropertyInfo(Variant::INT,
@@ -1168,7 +1250,7 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 
 	if (!project_manager && !editor) {
 		// If we didn't find a project, we fall back to the project manager.
-		project_manager = !found_project && !cmdline_tool;
+		project_manager = !found_project && !cmdline_tool && benchmark_scene.is_empty();
 	}
 #endif
 
@@ -1194,6 +1276,28 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 		OS::get_singleton()->add_logger(memnew(RotatedFileLogger(base_path, max_files)));
 	}
 
+	GLOBAL_DEF("debug/async_logging/enabled", false);
+	GLOBAL_DEF("debug/async_logging/buffer_size_kb", 1024);
+	ProjectSettings::get_singleton()->set_custom_property_info("debug/async_logging/buffer_size_kb",
+			PropertyInfo(Variant::INT,
+					"debug/async_logging/buffer_size_kb",
+					PROPERTY_HINT_RANGE,
+					"16,65536,1,or_greater"));
+	GLOBAL_DEF("debug/async_logging/max_messages_per_second", 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("debug/async_logging/max_messages_per_second",
+			PropertyInfo(Variant::INT,
+					"debug/async_logging/max_messages_per_second",
+					PROPERTY_HINT_RANGE,
+					"0,100000,1,or_greater"));
+#ifndef NO_THREADS
+	if (GLOBAL_GET("debug/async_logging/enabled")) {
+		// Wraps the loggers added so far, including the file logger.
+		int buffer_size = GLOBAL_GET("debug/async_logging/buffer_size_kb");
+		int max_messages_per_second = GLOBAL_GET("debug/async_logging/max_messages_per_second");
+		OS::get_singleton()->enable_async_logging(MAX(buffer_size, 16) * 1024, MAX(max_messages_per_second, 0));
+	}
+#endif
+
 	if (main_args.size() == 0 && String(GLOBAL_GET("application/run/main_scene")) == "") {
 #ifdef TOOLS_ENABLED
 		if (!editor && !project_manager) {
@@ -1369,17 +1473,35 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 	{
 		window_vsync_mode = DisplayServer::VSyncMode(int(GLOBAL_DEF("display/window/vsync/vsync_mode", DisplayServer::VSyncMode::VSYNC_ENABLED)));
 	}
+	if (!benchmark_scene.is_empty()) {
+		// Frame times should not be limited by the display.
+		window_vsync_mode = DisplayServer::VSYNC_DISABLED;
+	}
 	Engine::get_singleton()->set_physics_ticks_per_second(GLOBAL_DEF_BASIC("physics/common/physics_ticks_per_second", 60));
 	ProjectSettings::get_singleton()->set_custom_property_info("physics/common/physics_ticks_per_second",
 			PropertyInfo(Variant::INT, "physics/common/physics_ticks_per_second",
 					PROPERTY_HINT_RANGE, "1,1000,1"));
+	if (!benchmark_scene.is_empty() && fixed_fps == -1) {
+		// Advance a fixed time per frame, with no frame delay, so runs are reproducible.
+		fixed_fps = Engine::get_singleton()->get_physics_ticks_per_second();
+	}
 	Engine::get_singleton()->set_physics_jitter_fix(GLOBAL_DEF("physics/common/physics_jitter_fix", 0.5));
+	physics_interpolation = GLOBAL_DEF("physics/common/physics_interpolation", false) && !editor && !project_manager;
 	Engine::get_singleton()->set_target_fps(GLOBAL_DEF("debug/settings/fps/force_fps", 0));
 	ProjectSettings::get_singleton()->set_custom_property_info("debug/settings/fps/force_fps",
 			PropertyInfo(Variant::INT,
 					"debug/settings/fps/force_fps",
 					PROPERTY_HINT_RANGE, "0,1000,1"));
 
+	for (int i = 0; i < Memory::TAG_MAX; i++) {
+		String budget_setting = vformat("debug/settings/memory_budget/%s_mb", Memory::get_tag_name(Memory::Tag(i)));
+		GLOBAL_DEF(budget_setting, 0);
+		ProjectSettings::get_singleton()->set_custom_property_info(budget_setting,
+				PropertyInfo(Variant::INT,
+						budget_setting,
+						PROPERTY_HINT_RANGE, "0,65536,1,or_greater"));
+	}
+
 	GLOBAL_DEF("debug/settings/stdout/print_fps", false);
 	GLOBAL_DEF("debug/settings/stdout/print_gpu_profile", false);
 	GLOBAL_DEF("debug/settings/stdout/verbose_stdout", false);
@@ -1396,6 +1518,7 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 						PROPERTY_HINT_RANGE,
 						"0,100,1,or_greater")); // No negative numbers
 	}
+	low_latency_frame_pacing = GLOBAL_DEF("application/run/low_latency_frame_pacing", false);
 
 	OS::get_singleton()->set_low_processor_usage_mode(GLOBAL_DEF("application/run/low_processor_mode", false));
 	OS::get_singleton()->set_low_processor_usage_mode_sleep_usec(
@@ -1413,6 +1536,8 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 
 	message_queue = memnew(MessageQueue);
 
+	engine->startup_profile_step("Core settings");
+
 	if (p_second_phase) {
 		return setup2();
 	}
@@ -1526,10 +1651,21 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 		}
 	}
 
+#ifdef TOOLS_ENABLED
+	if (!editor && !project_manager && display_server->get_name() == "headless") {
+#else
+	if (display_server->get_name() == "headless") {
+#endif
+		// Nothing will ever be seen, let nodes skip what they only do for display.
+		Engine::get_singleton()->set_visual_processing_enabled(false);
+	}
+
 	if (display_server->has_feature(DisplayServer::FEATURE_ORIENTATION)) {
 		display_server->screen_set_orientation(window_orientation);
 	}
 
+	engine->startup_profile_step("Display server");
+
 	/* Initialize Pen Tablet Driver */
 
 	{
@@ -1569,6 +1705,8 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 		rendering_server->set_print_gpu_profile(true);
 	}
 
+	engine->startup_profile_step("Rendering server");
+
 #ifdef UNIX_ENABLED
 	// Print warning after initializing the renderer but before initializing audio.
 	if (OS::get_singleton()->get_environment("USER") == "root" && !OS::get_singleton()->has_environment("GODOT_SILENCE_ROOT_WARNING")) {
@@ -1593,6 +1731,8 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 	audio_server = memnew(AudioServer);
 	audio_server->init();
 
+	engine->startup_profile_step("Joypads, audio driver and audio server");
+
 	// also init our xr_server from here
 	xr_server = memnew(XRServer);
 
@@ -1626,6 +1766,8 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 
 	register_server_types();
 
+	engine->startup_profile_step("Server types");
+
 	MAIN_PRINT("Main: Load Boot Image");
 
 	Color clear = GLOBAL_DEF("rendering/environment/defaults/default_clear_color", Color(0.3, 0.3, 0.3));
@@ -1729,6 +1871,8 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 		id->set_emulate_mouse_from_touch(bool(GLOBAL_DEF("input_devices/pointing/emulate_mouse_from_touch", true)));
 	}
 
+	engine->startup_profile_step("Boot splash and input settings");
+
 	MAIN_PRINT("Main: Load Translations and Remaps");
 
 	translation_server->setup(); //register translations, load them, etc.
@@ -1740,6 +1884,8 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 
 	ResourceLoader::load_path_remaps();
 
+	engine->startup_profile_step("Translations and remaps");
+
 	MAIN_PRINT("Main: Load TextServer");
 
 	/* Enum text drivers */
@@ -1791,22 +1937,34 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 		return ERR_CANT_CREATE;
 	}
 
+	// Support data (e.g. ICU) is loaded on a worker thread while types and modules are registered.
+	// Text servers lock around their methods, so shaping text meanwhile just waits for it.
+	WorkerThreadPool::TaskID text_support_data_task = WorkerThreadPool::get_singleton()->add_native_task(&_load_text_support_data, nullptr);
+
+	engine->startup_profile_step("Text server");
+
 	MAIN_PRINT("Main: Load Scene Types");
 
 	register_scene_types();
 
+	engine->startup_profile_step("Scene types");
+
 #ifdef TOOLS_ENABLED
 	ClassDB::set_current_api(ClassDB::API_EDITOR);
 	EditorNode::register_editor_types();
 
 	ClassDB::set_current_api(ClassDB::API_CORE);
 
+	engine->startup_profile_step("Editor types");
 #endif
 
 	MAIN_PRINT("Main: Load Modules");
 
 	register_platform_apis();
-	register_module_types();
+
+	engine->startup_profile_step("Platform APIs");
+
+	register_module_types(); // Profiles each module on its own.
 
 	GLOBAL_DEF("display/mouse_cursor/custom_image", String());
 	GLOBAL_DEF("display/mouse_cursor/custom_image_hotspot", Vector2());
@@ -1835,11 +1993,17 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 
 	register_driver_types();
 
+	engine->startup_profile_step("Cursor, camera, physics and navigation servers, drivers");
+
 	// This loads global classes, so it must happen before custom loaders and savers are registered
 	ScriptServer::init_languages();
 
+	engine->startup_profile_step("Script languages");
+
 	audio_server->load_default_bus_layout();
 
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(text_support_data_task);
+
 	if (use_debug_profiler && EngineDebugger::is_active()) {
 		// Start the "scripts" profiler, used in local debugging.
 		// We could add more, and make the CLI arg require a comma-separated list of profilers.
@@ -1863,11 +2027,14 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 	print_verbose("EDITOR API HASH: " + uitos(ClassDB::get_api_hash(ClassDB::API_EDITOR)));
 	MAIN_PRINT("Main: Done");
 
+	engine->startup_profile_step("Bus layout and global shader uniforms");
+
 	return OK;
 }
 
 // everything the main loop needs to know about frame timings
 static MainTimerSync main_timer_sync;
+static FramePacer frame_pacer;
 
 bool Main::start() {
 	ERR_FAIL_COND_V(!_start_success, false);
@@ -2044,12 +2211,12 @@ bool Main::start() {
 	}
 #endif
 
-	if (script == "" && game_path == "" && String(GLOBAL_GET("application/run/main_scene")) != "") {
+	if (script == "" && game_path == "" && benchmark_scene.is_empty() && String(GLOBAL_GET("application/run/main_scene")) != "") {
 		game_path = GLOBAL_GET("application/run/main_scene");
 	}
 
 #ifdef TOOLS_ENABLED
-	if (!editor && !project_manager && !cmdline_tool && script == "" && game_path == "") {
+	if (!editor && !project_manager && !cmdline_tool && script == "" && game_path == "" && benchmark_scene.is_empty()) {
 		// If we end up here, it means we didn't manage to detect what we want to run.
 		// Let's throw an error gently. The code leading to this is pretty brittle so
 		// this might end up triggered by valid usage, in which case we'll have to
@@ -2391,7 +2558,9 @@ bool Main::start() {
 			// Load SSL Certificates from Project Settings (or builtin).
 			Crypto::load_default_certificates(GLOBAL_DEF("network/ssl/certificate_bundle_override", ""));
 
-			if (game_path != "") {
+			if (!benchmark_scene.is_empty()) {
+				sml->add_current_scene(memnew(SceneBenchmark(SceneBenchmark::find_scene(benchmark_scene), benchmark_frames, benchmark_output_path)));
+			} else if (game_path != "") {
 				Node *scene = nullptr;
 				Ref<PackedScene> scenedata = ResourceLoader::load(local_game_path);
 				if (scenedata.is_valid()) {
@@ -2461,6 +2630,9 @@ bool Main::start() {
 
 	OS::get_singleton()->set_main_loop(main_loop);
 
+	engine->startup_profile_step("Main loop and main scene");
+	engine->print_startup_profile();
+
 	return true;
 }
 
@@ -2489,17 +2661,42 @@ bool Main::is_iterating() {
 static uint64_t physics_process_max = 0;
 static uint64_t process_max = 0;
 
+#ifdef DEBUG_ENABLED
+// Warns once every time a subsystem goes over its memory budget.
+static void _check_memory_budgets() {
+	static bool over_budget[Memory::TAG_MAX] = {};
+
+	for (int i = 0; i < Memory::TAG_MAX; i++) {
+		Memory::Tag tag = Memory::Tag(i);
+		uint64_t budget = uint64_t(int(GLOBAL_GET(vformat("debug/settings/memory_budget/%s_mb", Memory::get_tag_name(tag))))) * 1024 * 1024;
+		uint64_t usage = Memory::get_tag_mem_usage(tag);
+		bool over = budget > 0 && usage > budget;
+		if (over && !over_budget[i]) {
+			WARN_PRINT(vformat("Memory used by %s (%s) is over its budget (%s).", Memory::get_tag_name(tag), String::humanize_size(usage), String::humanize_size(budget)));
+		}
+		over_budget[i] = over;
+	}
+}
+#endif
+
 bool Main::iteration() {
 	//for now do not error on this
 	//ERR_FAIL_COND_V(iterating, false);
 
 	iterating++;
 
+	TRACE_ZONE("Main::iteration");
+
 	const uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 	Engine::get_singleton()->_frame_ticks = ticks;
 	main_timer_sync.set_cpu_ticks_usec(ticks);
 	main_timer_sync.set_fixed_fps(fixed_fps);
 
+	const bool frame_pacing = low_latency_frame_pacing && fixed_fps == -1 && !Engine::get_singleton()->is_editor_hint();
+	if (frame_pacing) {
+		frame_pacer.begin_frame(ticks);
+	}
+
 	const uint64_t ticks_elapsed = ticks - last_ticks;
 
 	const int physics_ticks_per_second = Engine::get_singleton()->get_physics_ticks_per_second();
@@ -2508,6 +2705,10 @@ bool Main::iteration() {
 	const double time_scale = Engine::get_singleton()->get_time_scale();
 
 	MainFrameTime advance = main_timer_sync.advance(physics_step, physics_ticks_per_second);
+	if (frame_pacing) {
+		// A burst of catch-up steps makes the frame late and the next one early, spread them instead.
+		main_timer_sync.spread_physics_steps(advance, physics_ticks_per_second / 4);
+	}
 	double process_step = advance.process_step;
 	double scaled_step = process_step * time_scale;
 
@@ -2515,6 +2716,7 @@ bool Main::iteration() {
 	Engine::get_singleton()->_physics_interpolation_fraction = advance.interpolation_fraction;
 
 	uint64_t physics_process_ticks = 0;
+	uint64_t physics_process_total_ticks = 0;
 	uint64_t process_ticks = 0;
 
 	frame += ticks_elapsed;
@@ -2533,6 +2735,13 @@ bool Main::iteration() {
 	XRServer::get_singleton()->_process();
 
 	for (int iters = 0; iters < advance.physics_steps; ++iters) {
+		TRACE_ZONE("Main::iteration physics step");
+
+		if (physics_interpolation) {
+			// The transforms published by the previous step become the ones to interpolate from.
+			RenderingServer::get_singleton()->tick();
+		}
+
 		if (Input::get_singleton()->is_using_input_buffering() && agile_input_event_flushing) {
 			Input::get_singleton()->flush_buffered_events();
 		}
@@ -2565,6 +2774,7 @@ bool Main::iteration() {
 		message_queue->flush();
 
 		physics_process_ticks = MAX(physics_process_ticks, OS::get_singleton()->get_ticks_usec() - physics_begin); // keep the largest one for reference
+		physics_process_total_ticks += OS::get_singleton()->get_ticks_usec() - physics_begin;
 		physics_process_max = MAX(OS::get_singleton()->get_ticks_usec() - physics_begin, physics_process_max);
 		Engine::get_singleton()->_physics_frames++;
 
@@ -2584,6 +2794,10 @@ bool Main::iteration() {
 
 	RenderingServer::get_singleton()->sync(); //sync if still drawing from previous frames.
 
+	if (physics_interpolation) {
+		RenderingServer::get_singleton()->set_physics_interpolation_fraction(advance.interpolation_fraction);
+	}
+
 	if (DisplayServer::get_singleton()->can_any_window_draw() &&
 			RenderingServer::get_singleton()->is_render_loop_enabled()) {
 		if ((!force_redraw_requested) && OS::get_singleton()->is_in_low_processor_usage_mode()) {
@@ -2600,6 +2814,7 @@ bool Main::iteration() {
 
 	process_ticks = OS::get_singleton()->get_ticks_usec() - process_begin;
 	process_max = MAX(process_ticks, process_max);
+	TRACE_ZONE_ADD("Main::iteration process and draw", process_begin, process_begin + process_ticks);
 	uint64_t frame_time = OS::get_singleton()->get_ticks_usec() - ticks;
 
 	for (int i = 0; i < ScriptServer::get_language_count(); i++) {
@@ -2612,6 +2827,10 @@ bool Main::iteration() {
 		EngineDebugger::get_singleton()->iteration(frame_time, process_ticks, physics_process_ticks, physics_step);
 	}
 
+	if (SceneBenchmark::get_singleton()) {
+		SceneBenchmark::get_singleton()->record_frame(frame_time, process_ticks, physics_process_total_ticks);
+	}
+
 	frames++;
 	Engine::get_singleton()->_process_frames++;
 
@@ -2627,15 +2846,23 @@ bool Main::iteration() {
 		Engine::get_singleton()->_fps = frames;
 		performance->set_process_time(USEC_TO_SEC(process_max));
 		performance->set_physics_process_time(USEC_TO_SEC(physics_process_max));
+		performance->update_counters();
 		process_max = 0;
 		physics_process_max = 0;
 
+#ifdef DEBUG_ENABLED
+		_check_memory_budgets();
+#endif
+
 		frame %= 1000000;
 		frames = 0;
 	}
 
 	iterating--;
 
+	// Give back the temporary memory a busy frame may have needed.
+	FrameAllocator::trim();
+
 	// Needed for OSs using input buffering regardless accumulation (like Android)
 	if (Input::get_singleton()->is_using_input_buffering() && !agile_input_event_flushing) {
 		Input::get_singleton()->flush_buffered_events();
@@ -2645,7 +2872,15 @@ bool Main::iteration() {
 		return exit;
 	}
 
-	OS::get_singleton()->add_frame_delay(DisplayServer::get_singleton()->window_can_draw());
+	if (frame_pacing && DisplayServer::get_singleton()->window_can_draw() &&
+			!OS::get_singleton()->is_in_low_processor_usage_mode() && Engine::get_singleton()->get_frame_delay() == 0) {
+		// Sleep now, before the next frame polls input, rather than after drawing it.
+		frame_pacer.end_frame(OS::get_singleton()->get_ticks_usec());
+		frame_pacer.delay();
+	} else {
+		frame_pacer.reset();
+		OS::get_singleton()->add_frame_delay(DisplayServer::get_singleton()->window_can_draw());
+	}
 
 #ifdef TOOLS_ENABLED
 	if (auto_build_solutions) {
@@ -2682,6 +2917,13 @@ void Main::cleanup(bool p_force) {
 
 	EngineDebugger::deinitialize();
 
+#ifdef TRACE_ZONES_ENABLED
+	if (!trace_zones_path.is_empty()) {
+		TraceZones::end_capture(trace_zones_path);
+		trace_zones_path = String();
+	}
+#endif
+
 	ResourceLoader::remove_custom_loaders();
 	ResourceSaver::remove_custom_savers();
 
@@ -2789,6 +3031,11 @@ void Main::cleanup(bool p_force) {
 
 	unregister_core_driver_types();
 	unregister_core_types();
+	FrameAllocator::release_thread_memory();
+
+#ifdef TRACE_ZONES_ENABLED
+	TraceZones::finish();
+#endif
 
 	OS::get_singleton()->finalize_core();
 }
@@ -266,3 +266,13 @@ MainFrameTime MainTimerSync::advance(double p_physics_step, int p_physics_ticks_
 
 	return advance_checked(p_physics_step, p_physics_ticks_per_second, cpu_process_step);
 }
+
+void MainTimerSync::spread_physics_steps(MainFrameTime &r_time, int p_max_deferred) {
+	const int steps = r_time.physics_steps + deferred_physics_steps;
+	// average steps per frame over the control window, rounded up, plus one for catching up.
+	// a single long frame barely moves the average, so it can't raise the limit much by itself
+	const int max_steps = (typical_physics_steps[CONTROL_STEPS - 1] + CONTROL_STEPS - 1) / CONTROL_STEPS + 1;
+
+	r_time.physics_steps = MIN(steps, max_steps);
+	deferred_physics_steps = MIN(steps - r_time.physics_steps, p_max_deferred);
+}
@@ -66,6 +66,9 @@ class MainTimerSync {
 
 	int fixed_fps = 0;
 
+	// physics steps held back by spread_physics_steps, run in the following frames
+	int deferred_physics_steps = 0;
+
 protected:
 	// returns the fraction of p_physics_step required for the timer to overshoot
 	// before advance_core considers changing the physics_steps return from
@@ -97,6 +100,10 @@ public:
 
 	// advance one frame, return timesteps to take
 	MainFrameTime advance(double p_physics_step, int p_physics_ticks_per_second);
+
+	// limit the physics steps of a frame to slightly above the typical count, catching up over the next
+	// frames instead of all at once. at most p_max_deferred steps are held back, the rest is dropped
+	void spread_physics_steps(MainFrameTime &r_time, int p_max_deferred);
 };
 
 #endif // MAIN_TIMER_SYNC_H
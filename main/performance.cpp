@@ -30,13 +30,17 @@
 
 #include "performance.h"
 
+#include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
 #include "core/os/os.h"
+#include "core/templates/command_queue_mt.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
 #include "servers/audio_server.h"
+#include "servers/navigation_server_3d.h"
 #include "servers/physics_server_2d.h"
 #include "servers/physics_server_3d.h"
+#include "servers/rendering/rendering_device.h"
 #include "servers/rendering_server.h"
 
 Performance *Performance::singleton = nullptr;
@@ -73,6 +77,28 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(PHYSICS_3D_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(PHYSICS_3D_ISLAND_COUNT);
 	BIND_ENUM_CONSTANT(AUDIO_OUTPUT_LATENCY);
+	BIND_ENUM_CONSTANT(MEMORY_CORE);
+	BIND_ENUM_CONSTANT(MEMORY_CORE_MAX);
+	BIND_ENUM_CONSTANT(MEMORY_SCENE);
+	BIND_ENUM_CONSTANT(MEMORY_SCENE_MAX);
+	BIND_ENUM_CONSTANT(MEMORY_PHYSICS);
+	BIND_ENUM_CONSTANT(MEMORY_PHYSICS_MAX);
+	BIND_ENUM_CONSTANT(MEMORY_RENDERING);
+	BIND_ENUM_CONSTANT(MEMORY_RENDERING_MAX);
+	BIND_ENUM_CONSTANT(MEMORY_AUDIO);
+	BIND_ENUM_CONSTANT(MEMORY_AUDIO_MAX);
+	BIND_ENUM_CONSTANT(MEMORY_SCRIPT);
+	BIND_ENUM_CONSTANT(MEMORY_SCRIPT_MAX);
+	BIND_ENUM_CONSTANT(MEMORY_RESOURCES);
+	BIND_ENUM_CONSTANT(MEMORY_RESOURCES_MAX);
+	BIND_ENUM_CONSTANT(SERVER_COMMAND_QUEUE_WAITS);
+	BIND_ENUM_CONSTANT(OBJECT_MESSAGES_FLUSHED);
+	BIND_ENUM_CONSTANT(RESOURCE_PENDING_THREADED_LOADS);
+	BIND_ENUM_CONSTANT(RENDER_SHADER_COMPILATIONS);
+	BIND_ENUM_CONSTANT(RENDER_PIPELINE_COMPILATIONS);
+	BIND_ENUM_CONSTANT(RENDER_STAGING_BUFFER_FLUSHES);
+	BIND_ENUM_CONSTANT(AUDIO_MIX_DEADLINE_MISSES);
+	BIND_ENUM_CONSTANT(NAVIGATION_PATH_QUERY_TIME);
 
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
@@ -112,6 +138,28 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"physics_3d/collision_pairs",
 		"physics_3d/islands",
 		"audio/driver/output_latency",
+		"memory/core",
+		"memory/core_max",
+		"memory/scene",
+		"memory/scene_max",
+		"memory/physics",
+		"memory/physics_max",
+		"memory/rendering",
+		"memory/rendering_max",
+		"memory/audio",
+		"memory/audio_max",
+		"memory/script",
+		"memory/script_max",
+		"memory/resources",
+		"memory/resources_max",
+		"server/command_queue_waits",
+		"object/messages_flushed",
+		"resources/pending_threaded_loads",
+		"video/shader_compilations",
+		"video/pipeline_compilations",
+		"video/staging_buffer_flushes",
+		"audio/mix_deadline_misses",
+		"navigation/path_query_time",
 
 	};
 
@@ -166,6 +214,50 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return PhysicsServer3D::get_singleton()->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT);
 		case AUDIO_OUTPUT_LATENCY:
 			return AudioServer::get_singleton()->get_output_latency();
+		case MEMORY_CORE:
+			return Memory::get_tag_mem_usage(Memory::TAG_CORE);
+		case MEMORY_CORE_MAX:
+			return Memory::get_tag_mem_max_usage(Memory::TAG_CORE);
+		case MEMORY_SCENE:
+			return Memory::get_tag_mem_usage(Memory::TAG_SCENE);
+		case MEMORY_SCENE_MAX:
+			return Memory::get_tag_mem_max_usage(Memory::TAG_SCENE);
+		case MEMORY_PHYSICS:
+			return Memory::get_tag_mem_usage(Memory::TAG_PHYSICS);
+		case MEMORY_PHYSICS_MAX:
+			return Memory::get_tag_mem_max_usage(Memory::TAG_PHYSICS);
+		case MEMORY_RENDERING:
+			return Memory::get_tag_mem_usage(Memory::TAG_RENDERING);
+		case MEMORY_RENDERING_MAX:
+			return Memory::get_tag_mem_max_usage(Memory::TAG_RENDERING);
+		case MEMORY_AUDIO:
+			return Memory::get_tag_mem_usage(Memory::TAG_AUDIO);
+		case MEMORY_AUDIO_MAX:
+			return Memory::get_tag_mem_max_usage(Memory::TAG_AUDIO);
+		case MEMORY_SCRIPT:
+			return Memory::get_tag_mem_usage(Memory::TAG_SCRIPT);
+		case MEMORY_SCRIPT_MAX:
+			return Memory::get_tag_mem_max_usage(Memory::TAG_SCRIPT);
+		case MEMORY_RESOURCES:
+			return Memory::get_tag_mem_usage(Memory::TAG_RESOURCES);
+		case MEMORY_RESOURCES_MAX:
+			return Memory::get_tag_mem_max_usage(Memory::TAG_RESOURCES);
+		case SERVER_COMMAND_QUEUE_WAITS:
+			return _counter_deltas[COUNTER_COMMAND_QUEUE_WAITS];
+		case OBJECT_MESSAGES_FLUSHED:
+			return _counter_deltas[COUNTER_MESSAGES_FLUSHED];
+		case RESOURCE_PENDING_THREADED_LOADS:
+			return ResourceLoader::get_threaded_load_pending_count();
+		case RENDER_SHADER_COMPILATIONS:
+			return _counter_deltas[COUNTER_SHADER_COMPILATIONS];
+		case RENDER_PIPELINE_COMPILATIONS:
+			return _counter_deltas[COUNTER_PIPELINE_COMPILATIONS];
+		case RENDER_STAGING_BUFFER_FLUSHES:
+			return _counter_deltas[COUNTER_STAGING_BUFFER_FLUSHES];
+		case AUDIO_MIX_DEADLINE_MISSES:
+			return _counter_deltas[COUNTER_AUDIO_MIX_DEADLINE_MISSES];
+		case NAVIGATION_PATH_QUERY_TIME:
+			return USEC_TO_SEC(_counter_deltas[COUNTER_NAVIGATION_PATH_QUERY_USEC]);
 
 		default: {
 		}
@@ -201,6 +293,28 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_TIME,
 
 	};
 
@@ -215,6 +329,37 @@ void Performance::set_physics_process_time(double p_pt) {
 	_physics_process_time = p_pt;
 }
 
+uint64_t Performance::_get_counter_total(Counter p_counter) const {
+	switch (p_counter) {
+		case COUNTER_COMMAND_QUEUE_WAITS:
+			return CommandQueueMT::get_total_wait_count();
+		case COUNTER_MESSAGES_FLUSHED:
+			return MessageQueue::get_singleton() ? MessageQueue::get_singleton()->get_flushed_count() : 0;
+		case COUNTER_SHADER_COMPILATIONS:
+			return RenderingDevice::get_singleton() ? RenderingDevice::get_singleton()->get_shader_create_count() : 0;
+		case COUNTER_PIPELINE_COMPILATIONS:
+			return RenderingDevice::get_singleton() ? RenderingDevice::get_singleton()->get_pipeline_create_count() : 0;
+		case COUNTER_STAGING_BUFFER_FLUSHES:
+			return RenderingDevice::get_singleton() ? RenderingDevice::get_singleton()->get_staging_buffer_flush_count() : 0;
+		case COUNTER_AUDIO_MIX_DEADLINE_MISSES:
+			return AudioServer::get_singleton() ? AudioServer::get_singleton()->get_mix_deadline_miss_count() : 0;
+		case COUNTER_NAVIGATION_PATH_QUERY_USEC:
+			return NavigationServer3D::get_singleton() ? NavigationServer3D::get_singleton()->get_path_query_time_usec() : 0;
+		default: {
+		}
+	}
+
+	return 0;
+}
+
+void Performance::update_counters() {
+	for (int i = 0; i < COUNTER_MAX; i++) {
+		uint64_t total = _get_counter_total(Counter(i));
+		_counter_deltas[i] = total - _counter_totals[i];
+		_counter_totals[i] = total;
+	}
+}
+
 void Performance::add_custom_monitor(const StringName &p_id, const Callable &p_callable, const Vector<Variant> &p_args) {
 	ERR_FAIL_COND_MSG(has_custom_monitor(p_id), "Custom monitor with id '" + String(p_id) + "' already exists.");
 	_monitor_map.insert(p_id, MonitorCall(p_callable, p_args));
@@ -48,6 +48,23 @@ class Performance : public Object {
 	double _process_time;
 	double _physics_process_time;
 
+	// Cumulative counters kept by the servers, monitored as their increase over the last second.
+	enum Counter {
+		COUNTER_COMMAND_QUEUE_WAITS,
+		COUNTER_MESSAGES_FLUSHED,
+		COUNTER_SHADER_COMPILATIONS,
+		COUNTER_PIPELINE_COMPILATIONS,
+		COUNTER_STAGING_BUFFER_FLUSHES,
+		COUNTER_AUDIO_MIX_DEADLINE_MISSES,
+		COUNTER_NAVIGATION_PATH_QUERY_USEC,
+		COUNTER_MAX
+	};
+
+	uint64_t _counter_totals[COUNTER_MAX] = {};
+	uint64_t _counter_deltas[COUNTER_MAX] = {};
+
+	uint64_t _get_counter_total(Counter p_counter) const;
+
 	class MonitorCall {
 		Callable _callable;
 		Vector<Variant> _arguments;
@@ -87,6 +104,28 @@ public:
 		PHYSICS_3D_ISLAND_COUNT,
 		//physics
 		AUDIO_OUTPUT_LATENCY,
+		MEMORY_CORE,
+		MEMORY_CORE_MAX,
+		MEMORY_SCENE,
+		MEMORY_SCENE_MAX,
+		MEMORY_PHYSICS,
+		MEMORY_PHYSICS_MAX,
+		MEMORY_RENDERING,
+		MEMORY_RENDERING_MAX,
+		MEMORY_AUDIO,
+		MEMORY_AUDIO_MAX,
+		MEMORY_SCRIPT,
+		MEMORY_SCRIPT_MAX,
+		MEMORY_RESOURCES,
+		MEMORY_RESOURCES_MAX,
+		SERVER_COMMAND_QUEUE_WAITS,
+		OBJECT_MESSAGES_FLUSHED,
+		RESOURCE_PENDING_THREADED_LOADS,
+		RENDER_SHADER_COMPILATIONS,
+		RENDER_PIPELINE_COMPILATIONS,
+		RENDER_STAGING_BUFFER_FLUSHES,
+		AUDIO_MIX_DEADLINE_MISSES,
+		NAVIGATION_PATH_QUERY_TIME,
 		MONITOR_MAX
 	};
 
@@ -103,6 +142,8 @@ public:
 
 	void set_process_time(double p_pt);
 	void set_physics_process_time(double p_pt);
+	// Called once per second, along with the process times.
+	void update_counters();
 
 	void add_custom_monitor(const StringName &p_id, const Callable &p_callable, const Vector<Variant> &p_args);
 	void remove_custom_monitor(const StringName &p_id);
@@ -0,0 +1,515 @@
+/*************************************************************************/
+/*  scene_benchmark.cpp                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "scene_benchmark.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/json.h"
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "core/math/random_pcg.h"
+#include "core/object/script_language.h"
+#include "core/os/os.h"
+#include "core/templates/command_queue_mt.h"
+#include "core/templates/sort_array.h"
+#include "core/version.h"
+#include "scene/3d/camera_3d.h"
+#include "scene/3d/collision_shape_3d.h"
+#include "scene/3d/light_3d.h"
+#include "scene/3d/multimesh_instance_3d.h"
+#include "scene/3d/navigation_agent_3d.h"
+#include "scene/3d/navigation_region_3d.h"
+#include "scene/3d/physics_body_3d.h"
+#include "scene/gui/button.h"
+#include "scene/gui/grid_container.h"
+#include "scene/gui/scroll_container.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/viewport.h"
+#include "scene/resources/box_shape_3d.h"
+#include "scene/resources/navigation_mesh.h"
+#include "scene/resources/packed_scene.h"
+#include "scene/resources/primitive_meshes.h"
+#include "scene/resources/world_boundary_shape_3d.h"
+#include "servers/navigation_server_3d.h"
+#include "servers/rendering/rendering_device.h"
+#include "servers/rendering_server.h"
+
+SceneBenchmark *SceneBenchmark::singleton = nullptr;
+
+static const char *scene_names[SceneBenchmark::SCENE_MAX] = {
+	"physics_bodies",
+	"multimesh",
+	"script_nodes",
+	"navigation_agents",
+	"ui_controls",
+	"resource_load",
+};
+
+static const int PHYSICS_BODY_COUNT = 10000;
+static const int MULTIMESH_INSTANCE_COUNT = 100000;
+static const int SCRIPT_NODE_COUNT = 5000;
+static const int NAVIGATION_AGENT_COUNT = 3000;
+static const int NAVIGATION_GRID_SIZE = 64;
+static const real_t NAVIGATION_CELL_SIZE = 2.0;
+static const int UI_CONTROL_COUNT = 20000;
+static const int RESOURCE_NODE_COUNT = 5000;
+static const char *RESOURCE_DIR = "user://scene_benchmark";
+
+const char *SceneBenchmark::get_scene_name(Scene p_scene) {
+	ERR_FAIL_INDEX_V(p_scene, SCENE_MAX, "");
+	return scene_names[p_scene];
+}
+
+SceneBenchmark::Scene SceneBenchmark::find_scene(const String &p_name) {
+	for (int i = 0; i < SCENE_MAX; i++) {
+		if (p_name == scene_names[i]) {
+			return Scene(i);
+		}
+	}
+	return SCENE_MAX;
+}
+
+void SceneBenchmark::_add_camera(const Vector3 &p_position, const Vector3 &p_target) {
+	camera_pivot = memnew(Node3D);
+	add_child(camera_pivot);
+	camera_pivot->set_position(p_target);
+
+	Camera3D *camera = memnew(Camera3D);
+	camera_pivot->add_child(camera);
+	camera->look_at_from_position(p_position - p_target, Vector3());
+	camera->set_far(1000);
+
+	DirectionalLight3D *light = memnew(DirectionalLight3D);
+	add_child(light);
+	light->look_at_from_position(Vector3(), Vector3(-1, -2, -1));
+}
+
+void SceneBenchmark::_build_physics_bodies() {
+	StaticBody3D *floor = memnew(StaticBody3D);
+	CollisionShape3D *floor_shape = memnew(CollisionShape3D);
+	Ref<WorldBoundaryShape3D> boundary;
+	boundary.instantiate();
+	floor_shape->set_shape(boundary);
+	floor->add_child(floor_shape);
+	add_child(floor);
+
+	Ref<BoxShape3D> box;
+	box.instantiate();
+	box->set_size(Vector3(1, 1, 1));
+
+	// Stacked layers of boxes, offset so they topple into each other when landing.
+	const int side = 25;
+	for (int i = 0; i < PHYSICS_BODY_COUNT; i++) {
+		int layer = i / (side * side);
+		int x = i % side;
+		int z = (i / side) % side;
+		RigidDynamicBody3D *body = memnew(RigidDynamicBody3D);
+		CollisionShape3D *shape = memnew(CollisionShape3D);
+		shape->set_shape(box);
+		body->add_child(shape);
+		body->set_position(Vector3((x - side / 2) * 1.5 + (layer % 2) * 0.5, 2 + layer * 1.5, (z - side / 2) * 1.5));
+		add_child(body);
+	}
+
+	_add_camera(Vector3(0, 30, 60), Vector3());
+}
+
+void SceneBenchmark::_build_multimesh() {
+	Ref<BoxMesh> mesh;
+	mesh.instantiate();
+	mesh->set_size(Vector3(0.2, 0.2, 0.2));
+
+	Ref<MultiMesh> multimesh;
+	multimesh.instantiate();
+	multimesh->set_transform_format(MultiMesh::TRANSFORM_3D);
+	multimesh->set_instance_count(MULTIMESH_INSTANCE_COUNT);
+	multimesh->set_mesh(mesh);
+
+	const int side_x = 50;
+	const int side_y = 40;
+	for (int i = 0; i < MULTIMESH_INSTANCE_COUNT; i++) {
+		Vector3 position(i % side_x, (i / side_x) % side_y, i / (side_x * side_y));
+		multimesh->set_instance_transform(i, Transform3D(Basis(), (position - Vector3(side_x, side_y, side_x) * 0.5) * 0.5));
+	}
+
+	MultiMeshInstance3D *instance = memnew(MultiMeshInstance3D);
+	instance->set_multimesh(multimesh);
+	add_child(instance);
+
+	_add_camera(Vector3(0, 10, 30), Vector3());
+}
+
+void SceneBenchmark::_build_script_nodes() {
+	Ref<Script> script = Object::cast_to<Script>(ClassDB::instantiate("GDScript"));
+	ERR_FAIL_COND_MSG(script.is_null(), "The script_nodes benchmark scene requires the GDScript module.");
+
+	script->set_source_code(
+			"extends Node\n"
+			"var value := 0.0\n"
+			"var count := 0\n"
+			"func _process(delta):\n"
+			"\tvalue += delta * 2.0\n"
+			"\tif value > 1.0:\n"
+			"\t\tvalue -= 1.0\n"
+			"\t\tcount += 1\n");
+	Error err = script->reload();
+	ERR_FAIL_COND_MSG(err != OK, "Failed to compile the script_nodes benchmark script.");
+
+	for (int i = 0; i < SCRIPT_NODE_COUNT; i++) {
+		Node *node = memnew(Node);
+		node->set_script(script);
+		add_child(node);
+	}
+}
+
+Vector3 SceneBenchmark::_random_agent_target() {
+	// Deterministic, so every run walks the same paths.
+	agent_seed = agent_seed * 1664525 + 1013904223;
+	real_t x = (agent_seed >> 16) % (NAVIGATION_GRID_SIZE * 10) / 10.0;
+	agent_seed = agent_seed * 1664525 + 1013904223;
+	real_t z = (agent_seed >> 16) % (NAVIGATION_GRID_SIZE * 10) / 10.0;
+	return Vector3(x, 0, z) * NAVIGATION_CELL_SIZE;
+}
+
+void SceneBenchmark::_build_navigation_agents() {
+	Ref<NavigationMesh> navigation_mesh;
+	navigation_mesh.instantiate();
+
+	Vector<Vector3> vertices;
+	for (int z = 0; z <= NAVIGATION_GRID_SIZE; z++) {
+		for (int x = 0; x <= NAVIGATION_GRID_SIZE; x++) {
+			vertices.push_back(Vector3(x, 0, z) * NAVIGATION_CELL_SIZE);
+		}
+	}
+	navigation_mesh->set_vertices(vertices);
+
+	const int row = NAVIGATION_GRID_SIZE + 1;
+	for (int z = 0; z < NAVIGATION_GRID_SIZE; z++) {
+		for (int x = 0; x < NAVIGATION_GRID_SIZE; x++) {
+			Vector<int> polygon;
+			polygon.push_back(z * row + x);
+			polygon.push_back(z * row + x + 1);
+			polygon.push_back((z + 1) * row + x + 1);
+			polygon.push_back((z + 1) * row + x);
+			navigation_mesh->add_polygon(polygon);
+		}
+	}
+
+	NavigationRegion3D *region = memnew(NavigationRegion3D);
+	region->set_navigation_mesh(navigation_mesh);
+	add_child(region);
+
+	for (int i = 0; i < NAVIGATION_AGENT_COUNT; i++) {
+		Node3D *body = memnew(Node3D);
+		body->set_position(_random_agent_target());
+		add_child(body);
+
+		NavigationAgent3D *agent = memnew(NavigationAgent3D);
+		agent->set_max_speed(4.0);
+		agent->set_radius(0.5);
+		body->add_child(agent);
+		agent->set_target_location(_random_agent_target());
+		agents.push_back(agent);
+	}
+
+	real_t center = NAVIGATION_GRID_SIZE * NAVIGATION_CELL_SIZE * 0.5;
+	_add_camera(Vector3(center, 80, center * 3), Vector3(center, 0, center));
+}
+
+void SceneBenchmark::_build_ui_controls() {
+	ScrollContainer *scroll = memnew(ScrollContainer);
+	add_child(scroll);
+	scroll->set_anchors_and_offsets_preset(Control::PRESET_WIDE);
+
+	GridContainer *grid = memnew(GridContainer);
+	grid->set_columns(100);
+	scroll->add_child(grid);
+
+	for (int i = 0; i < UI_CONTROL_COUNT; i++) {
+		Button *button = memnew(Button);
+		button->set_text(itos(i));
+		grid->add_child(button);
+		buttons.push_back(button);
+	}
+}
+
+void SceneBenchmark::_build_resource_load() {
+	DirAccessRef dir = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	Error err = dir->make_dir_recursive(RESOURCE_DIR);
+	ERR_FAIL_COND_MSG(err != OK, "Cannot create the resource_load benchmark directory.");
+
+	// A large texture, a dense mesh and a scene with many nodes, saved in the binary format.
+	Ref<Image> image;
+	image.instantiate();
+	image->create(2048, 2048, true, Image::FORMAT_RGBA8);
+	image->fill(Color(0.5, 0.25, 0.75));
+	resource_paths.push_back(String(RESOURCE_DIR).plus_file("image.res"));
+	ResourceSaver::save(resource_paths[0], image);
+
+	Ref<SphereMesh> sphere;
+	sphere.instantiate();
+	sphere->set_radial_segments(512);
+	sphere->set_rings(256);
+	Ref<ArrayMesh> mesh;
+	mesh.instantiate();
+	mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, sphere->get_mesh_arrays());
+	resource_paths.push_back(String(RESOURCE_DIR).plus_file("mesh.res"));
+	ResourceSaver::save(resource_paths[1], mesh);
+
+	Node3D *root = memnew(Node3D);
+	for (int i = 0; i < RESOURCE_NODE_COUNT; i++) {
+		Node3D *node = memnew(Node3D);
+		node->set_name("Node" + itos(i));
+		node->set_position(Vector3(i, 0, 0));
+		root->add_child(node);
+		node->set_owner(root);
+	}
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	packed_scene->pack(root);
+	memdelete(root);
+	resource_paths.push_back(String(RESOURCE_DIR).plus_file("scene.scn"));
+	ResourceSaver::save(resource_paths[2], packed_scene);
+}
+
+void SceneBenchmark::_update_frame(double p_delta) {
+	if (camera_pivot) {
+		camera_pivot->rotate_y(p_delta * 0.5);
+	}
+
+	switch (scene) {
+		case SCENE_NAVIGATION_AGENTS: {
+			for (uint32_t i = 0; i < agents.size(); i++) {
+				NavigationAgent3D *agent = agents[i];
+				if (agent->is_navigation_finished()) {
+					agent->set_target_location(_random_agent_target());
+					continue;
+				}
+				Node3D *body = Object::cast_to<Node3D>(agent->get_parent());
+				Vector3 position = body->get_global_transform().origin;
+				Vector3 velocity = (agent->get_next_location() - position).normalized() * agent->get_max_speed();
+				agent->set_velocity(velocity);
+				body->set_position(position + velocity * p_delta);
+			}
+		} break;
+		case SCENE_UI_CONTROLS: {
+			// Changing a button size makes the grid sort its children again.
+			Button *button = buttons[frame_count % buttons.size()];
+			button->set_text(button->get_text() + "+");
+		} break;
+		case SCENE_RESOURCE_LOAD: {
+			if (!resource_paths.is_empty()) {
+				RES resource = ResourceLoader::load(resource_paths[frame_count % resource_paths.size()], "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+				ERR_FAIL_COND(resource.is_null());
+			}
+		} break;
+		default: {
+		}
+	}
+}
+
+SceneBenchmark::Counters SceneBenchmark::_read_counters() const {
+	Counters counters;
+	counters.navigation_path_query_usec = NavigationServer3D::get_singleton()->get_path_query_time_usec();
+	if (RenderingDevice::get_singleton()) {
+		counters.shader_compilations = RenderingDevice::get_singleton()->get_shader_create_count();
+		counters.pipeline_compilations = RenderingDevice::get_singleton()->get_pipeline_create_count();
+	}
+	counters.command_queue_waits = CommandQueueMT::get_total_wait_count();
+	return counters;
+}
+
+static Dictionary _get_time_stats(const LocalVector<uint64_t> &p_times) {
+	Dictionary stats;
+	if (p_times.is_empty()) {
+		return stats;
+	}
+
+	LocalVector<uint64_t> sorted = p_times;
+	SortArray<uint64_t> sorter;
+	sorter.sort(sorted.ptr(), sorted.size());
+
+	uint64_t total = 0;
+	for (uint32_t i = 0; i < sorted.size(); i++) {
+		total += sorted[i];
+	}
+
+	// Nearest rank percentiles.
+	const int percentiles[] = { 50, 90, 95, 99 };
+	stats["mean"] = double(total) / sorted.size();
+	for (int percentile : percentiles) {
+		uint32_t rank = MAX((sorted.size() * percentile + 99) / 100, 1u);
+		stats["p" + itos(percentile)] = sorted[rank - 1];
+	}
+	stats["max"] = sorted[sorted.size() - 1];
+	return stats;
+}
+
+void SceneBenchmark::_finish() {
+	Counters counters = _read_counters();
+
+	Dictionary result;
+	result["scene"] = get_scene_name(scene);
+	result["engine_version"] = VERSION_FULL_BUILD;
+	result["video_adapter"] = RS::get_singleton()->get_video_adapter_name();
+	result["frames"] = measured_frames;
+	result["warmup_frames"] = warmup_frames;
+	result["setup_usec"] = setup_usec;
+
+	Dictionary timings;
+	timings["frame_usec"] = _get_time_stats(times.frame);
+	timings["process_usec"] = _get_time_stats(times.process);
+	timings["physics_usec"] = _get_time_stats(times.physics);
+	timings["render_cpu_usec"] = _get_time_stats(times.render_cpu);
+	timings["render_gpu_usec"] = _get_time_stats(times.render_gpu);
+	result["timings"] = timings;
+
+	Dictionary totals;
+	totals["navigation_path_query_usec"] = counters.navigation_path_query_usec - counters_begin.navigation_path_query_usec;
+	totals["shader_compilations"] = counters.shader_compilations - counters_begin.shader_compilations;
+	totals["pipeline_compilations"] = counters.pipeline_compilations - counters_begin.pipeline_compilations;
+	totals["command_queue_waits"] = counters.command_queue_waits - counters_begin.command_queue_waits;
+	result["totals"] = totals;
+
+	Dictionary memory;
+	memory["static"] = Memory::get_mem_usage();
+	memory["static_max"] = Memory::get_mem_max_usage();
+	memory["video"] = RS::get_singleton()->get_rendering_info(RS::RENDERING_INFO_VIDEO_MEM_USED);
+	for (int i = 0; i < Memory::TAG_MAX; i++) {
+		memory[Memory::get_tag_name(Memory::Tag(i))] = Memory::get_tag_mem_usage(Memory::Tag(i));
+	}
+	result["memory"] = memory;
+	result["objects"] = ObjectDB::get_object_count();
+	result["nodes"] = get_tree()->get_node_count();
+
+	if (output_path.is_empty()) {
+		print_line(vformat("Benchmark scene %s: %d frames after %d warmup frames, setup took %d msec.", get_scene_name(scene), measured_frames, warmup_frames, setup_usec / 1000));
+		Array keys = timings.keys();
+		for (int i = 0; i < keys.size(); i++) {
+			Dictionary stats = timings[keys[i]];
+			if (stats.is_empty()) {
+				continue;
+			}
+			print_line(vformat("  %-16s mean %8.1f  p50 %8d  p99 %8d  max %8d", keys[i], stats["mean"], stats["p50"], stats["p99"], stats["max"]));
+		}
+		print_line(vformat("  Static memory: %s, video memory: %s.", String::humanize_size(memory["static"]), String::humanize_size(memory["video"])));
+	} else {
+		JSON json;
+		Error err = json.stringify_to_file(result, output_path, "\t");
+		ERR_FAIL_COND_MSG(err != OK, "Cannot save the benchmark results to '" + output_path + "'.");
+	}
+
+	for (int i = 0; i < resource_paths.size(); i++) {
+		DirAccess::remove_file_or_error(resource_paths[i]);
+	}
+}
+
+void SceneBenchmark::record_frame(uint64_t p_frame_usec, uint64_t p_process_usec, uint64_t p_physics_usec) {
+	frame_count++;
+	if (frame_count <= warmup_frames) {
+		if (frame_count == warmup_frames) {
+			counters_begin = _read_counters();
+		}
+		return;
+	}
+	if (frame_count > warmup_frames + measured_frames) {
+		return;
+	}
+
+	times.frame.push_back(p_frame_usec);
+	times.process.push_back(p_process_usec);
+	times.physics.push_back(p_physics_usec);
+
+	RID viewport = get_viewport()->get_viewport_rid();
+	times.render_cpu.push_back(RS::get_singleton()->viewport_get_measured_render_time_cpu(viewport) * 1000.0);
+	times.render_gpu.push_back(RS::get_singleton()->viewport_get_measured_render_time_gpu(viewport) * 1000.0);
+
+	if (frame_count == warmup_frames + measured_frames) {
+		_finish();
+		get_tree()->quit();
+	}
+}
+
+void SceneBenchmark::_notification(int p_what) {
+	switch (p_what) {
+		case NOTIFICATION_READY: {
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			switch (scene) {
+				case SCENE_PHYSICS_BODIES:
+					_build_physics_bodies();
+					break;
+				case SCENE_MULTIMESH:
+					_build_multimesh();
+					break;
+				case SCENE_SCRIPT_NODES:
+					_build_script_nodes();
+					break;
+				case SCENE_NAVIGATION_AGENTS:
+					_build_navigation_agents();
+					break;
+				case SCENE_UI_CONTROLS:
+					_build_ui_controls();
+					break;
+				case SCENE_RESOURCE_LOAD:
+					_build_resource_load();
+					break;
+				default: {
+				}
+			}
+			setup_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+			RS::get_singleton()->viewport_set_measure_render_time(get_viewport()->get_viewport_rid(), true);
+			set_process(true);
+			set_physics_process(scene == SCENE_NAVIGATION_AGENTS);
+		} break;
+		case NOTIFICATION_PROCESS: {
+			if (scene != SCENE_NAVIGATION_AGENTS) {
+				_update_frame(get_process_delta_time());
+			}
+		} break;
+		case NOTIFICATION_PHYSICS_PROCESS: {
+			_update_frame(get_physics_process_delta_time());
+		} break;
+	}
+}
+
+SceneBenchmark::SceneBenchmark(Scene p_scene, int p_frames, const String &p_output_path) {
+	singleton = this;
+	scene = p_scene;
+	measured_frames = MAX(p_frames, 1);
+	output_path = p_output_path;
+	set_name("SceneBenchmark");
+}
+
+SceneBenchmark::~SceneBenchmark() {
+	if (singleton == this) {
+		singleton = nullptr;
+	}
+}
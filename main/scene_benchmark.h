@@ -0,0 +1,120 @@
+/*************************************************************************/
+/*  scene_benchmark.h                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef SCENE_BENCHMARK_H
+#define SCENE_BENCHMARK_H
+
+#include "core/templates/local_vector.h"
+#include "scene/main/node.h"
+
+class Button;
+class NavigationAgent3D;
+class Node3D;
+
+// Builds one of the standard benchmark scenes, run with `--benchmark-scene <name>`. Frames
+// are timed by Main::iteration() through record_frame(), after the warmup frames the
+// frame time percentiles, per subsystem timings and memory usage are printed or saved as
+// JSON with `--benchmark-output`, and the engine quits.
+class SceneBenchmark : public Node {
+	GDCLASS(SceneBenchmark, Node);
+
+public:
+	enum Scene {
+		SCENE_PHYSICS_BODIES,
+		SCENE_MULTIMESH,
+		SCENE_SCRIPT_NODES,
+		SCENE_NAVIGATION_AGENTS,
+		SCENE_UI_CONTROLS,
+		SCENE_RESOURCE_LOAD,
+		SCENE_MAX
+	};
+
+private:
+	static SceneBenchmark *singleton;
+
+	struct FrameTimes {
+		LocalVector<uint64_t> frame;
+		LocalVector<uint64_t> process;
+		LocalVector<uint64_t> physics;
+		LocalVector<uint64_t> render_cpu;
+		LocalVector<uint64_t> render_gpu;
+	};
+
+	struct Counters {
+		uint64_t navigation_path_query_usec = 0;
+		uint64_t shader_compilations = 0;
+		uint64_t pipeline_compilations = 0;
+		uint64_t command_queue_waits = 0;
+	};
+
+	Scene scene = SCENE_MAX;
+	int warmup_frames = 60;
+	int measured_frames = 600;
+	int frame_count = 0;
+	String output_path;
+	uint64_t setup_usec = 0;
+	FrameTimes times;
+	Counters counters_begin;
+
+	LocalVector<NavigationAgent3D *> agents;
+	uint32_t agent_seed = 0;
+	LocalVector<Button *> buttons;
+	Vector<String> resource_paths;
+	Node3D *camera_pivot = nullptr;
+
+	void _build_physics_bodies();
+	void _build_multimesh();
+	void _build_script_nodes();
+	void _build_navigation_agents();
+	void _build_ui_controls();
+	void _build_resource_load();
+	void _add_camera(const Vector3 &p_position, const Vector3 &p_target);
+	Vector3 _random_agent_target();
+
+	void _update_frame(double p_delta);
+	Counters _read_counters() const;
+	void _finish();
+
+protected:
+	void _notification(int p_what);
+
+public:
+	static const char *get_scene_name(Scene p_scene);
+	static Scene find_scene(const String &p_name);
+	static SceneBenchmark *get_singleton() { return singleton; }
+
+	// Called once per frame with the frame time and the time spent in process and physics, in microseconds.
+	void record_frame(uint64_t p_frame_usec, uint64_t p_process_usec, uint64_t p_physics_usec);
+
+	SceneBenchmark(Scene p_scene, int p_frames, const String &p_output_path);
+	~SceneBenchmark();
+};
+
+#endif // SCENE_BENCHMARK_H
@@ -281,6 +281,7 @@ def write_modules(modules):
                 preregister_cpp += "#endif\n"
                 register_cpp += "#ifdef MODULE_" + name.upper() + "_ENABLED\n"
                 register_cpp += "\tregister_" + name + "_types();\n"
+                register_cpp += '\tEngine::get_singleton()->startup_profile_step("Module: ' + name + '");\n'
                 register_cpp += "#endif\n"
                 unregister_cpp += "#ifdef MODULE_" + name.upper() + "_ENABLED\n"
                 unregister_cpp += "\tunregister_" + name + "_types();\n"
@@ -292,6 +293,7 @@ def write_modules(modules):
 /* THIS FILE IS GENERATED DO NOT EDIT */
 #include "register_module_types.h"
 
+#include "core/config/engine.h"
 #include "modules/modules_enabled.gen.h"
 
 %s
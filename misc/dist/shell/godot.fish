@@ -75,6 +75,10 @@ complete -c godot -l disable-render-loop -d "Disable render loop so rendering on
 complete -c godot -l disable-crash-handler -d "Disable crash handler when supported by the platform code"
 complete -c godot -l fixed-fps -d "Force a fixed number of frames per second (this setting disables real-time synchronization)" -x
 complete -c godot -l print-fps -d "Print the frames per second to the stdout"
+complete -c godot -l startup-profile -d "Print the time taken by each step of the engine startup to the stdout"
+complete -c godot -l benchmark-scene -d "Run a standard benchmark scene instead of the project, then quit" -x -a "physics_bodies multimesh script_nodes navigation_agents ui_controls resource_load"
+complete -c godot -l benchmark-frames -d "Number of frames measured by --benchmark-scene after warming up" -x
+complete -c godot -l benchmark-output -d "Save the --benchmark-scene results as JSON instead of printing them" -r
 
 # Standalone tools:
 complete -c godot -s s -l script -d "Run a script" -r
@@ -30,7 +30,15 @@
 
 #include "register_types.h"
 
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/crypto/crypto_core.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
 #include "core/os/os.h"
+#include "core/os/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "servers/rendering_server.h"
 #include "texture_basisu.h"
 
@@ -150,6 +158,130 @@ static Vector<uint8_t> basis_universal_packer(const Ref<Image> &p_image, Image::
 }
 #endif // TOOLS_ENABLED
 
+struct BasisTranscodeJob {
+	struct Level {
+		uint32_t offset = 0;
+		uint32_t count = 0; // Blocks, or pixels for uncompressed formats.
+	};
+
+	const basist::basisu_transcoder *transcoder = nullptr;
+	const uint8_t *src = nullptr;
+	uint32_t src_size = 0;
+	uint8_t *dst = nullptr;
+	basist::transcoder_texture_format format = basist::transcoder_texture_format::cTFTotalTextureFormats;
+	LocalVector<Level> levels;
+	SafeFlag failed;
+};
+
+static void _basis_transcode_level(void *p_userdata, uint32_t p_level) {
+	BasisTranscodeJob *job = (BasisTranscodeJob *)p_userdata;
+	const BasisTranscodeJob::Level &level = job->levels[p_level];
+
+	// The transcoder's own state is only safe to use from one thread at a time.
+	basist::basisu_transcoder_state state;
+	if (!job->transcoder->transcode_image_level(job->src, job->src_size, 0, p_level, job->dst + level.offset, level.count, job->format, 0, 0, &state)) {
+		job->failed.set();
+	}
+}
+
+// Transcoded textures can be cached on the device, so only the first load pays for transcoding.
+// Entries are keyed by the MD5 of the Basis data and the target format, which depends on the GPU.
+
+#define BASIS_CACHE_MAGIC "GBTC"
+#define BASIS_CACHE_VERSION 1
+
+static Mutex cache_dir_mutex;
+static bool cache_dir_initialized = false;
+static String cache_dir;
+
+static String _get_transcoded_cache_path(const Vector<uint8_t> &p_buffer, Image::Format p_format) {
+	{
+		MutexLock lock(cache_dir_mutex);
+		if (!cache_dir_initialized) {
+			cache_dir_initialized = true;
+			if (GLOBAL_GET("rendering/textures/basis_universal/cache_transcoded_textures")) {
+				String dir = Engine::get_singleton()->get_shader_cache_path();
+				if (dir == String()) {
+					dir = "user://";
+				}
+				dir = dir.plus_file("basis_cache");
+				DirAccessRef da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+				String abs_dir = ProjectSettings::get_singleton()->globalize_path(dir);
+				if (da->make_dir_recursive(abs_dir) == OK) {
+					cache_dir = abs_dir;
+				} else {
+					ERR_PRINT("Can't create Basis Universal cache folder, transcoded textures won't be cached: " + dir);
+				}
+			}
+		}
+		if (cache_dir.is_empty()) {
+			return String();
+		}
+	}
+
+	unsigned char hash[16];
+	ERR_FAIL_COND_V(CryptoCore::md5(p_buffer.ptr(), p_buffer.size(), hash) != OK, String());
+	return cache_dir.plus_file(String::hex_encode_buffer(hash, 16) + "_" + itos(p_format) + ".bin");
+}
+
+static Ref<Image> _load_transcoded_cache(const String &p_path, Image::Format p_format) {
+	FileAccessRef f = FileAccess::open(p_path, FileAccess::READ);
+	if (!f) {
+		return Ref<Image>();
+	}
+
+	uint8_t magic[4];
+	f->get_buffer(magic, 4);
+	if (memcmp(magic, BASIS_CACHE_MAGIC, 4) != 0 || f->get_32() != BASIS_CACHE_VERSION || f->get_32() != uint32_t(p_format)) {
+		return Ref<Image>();
+	}
+
+	uint32_t width = f->get_32();
+	uint32_t height = f->get_32();
+	bool mipmaps = f->get_32() != 0;
+	uint32_t data_size = f->get_32();
+	if (width == 0 || height == 0 || width > Image::MAX_WIDTH || height > Image::MAX_HEIGHT || data_size != uint32_t(Image::get_image_data_size(width, height, p_format, mipmaps))) {
+		return Ref<Image>();
+	}
+
+	Vector<uint8_t> data;
+	data.resize(data_size);
+	if (f->get_buffer(data.ptrw(), data_size) != data_size) {
+		return Ref<Image>(); // Truncated, it will be written again.
+	}
+
+	Ref<Image> image;
+	image.instantiate();
+	image->create(width, height, mipmaps, p_format, data);
+	return image;
+}
+
+static void _save_transcoded_cache(const String &p_path, const Ref<Image> &p_image) {
+	// Write to a temporary file first, so an interrupted write or a concurrent load never sees a partial entry.
+	String temp_path = p_path + "." + itos(Thread::get_caller_id()) + ".tmp";
+	{
+		FileAccessRef f = FileAccess::open(temp_path, FileAccess::WRITE);
+		if (!f) {
+			return;
+		}
+
+		Vector<uint8_t> data = p_image->get_data();
+		f->store_buffer((const uint8_t *)BASIS_CACHE_MAGIC, 4);
+		f->store_32(BASIS_CACHE_VERSION);
+		f->store_32(p_image->get_format());
+		f->store_32(p_image->get_width());
+		f->store_32(p_image->get_height());
+		f->store_32(p_image->has_mipmaps() ? 1 : 0);
+		f->store_32(data.size());
+		f->store_buffer(data.ptr(), data.size());
+	}
+
+	DirAccessRef da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	if (da->rename(temp_path, p_path) != OK) {
+		da->remove(temp_path);
+	}
+}
+
 static Ref<Image> basis_universal_unpacker(const Vector<uint8_t> &p_buffer) {
 	Ref<Image> image;
 
@@ -223,6 +355,16 @@ static Ref<Image> basis_universal_unpacker(const Vector<uint8_t> &p_buffer) {
 		} break;
 	}
 
+	ERR_FAIL_COND_V(imgfmt == Image::FORMAT_MAX, image);
+
+	String cache_path = _get_transcoded_cache_path(p_buffer, imgfmt);
+	if (!cache_path.is_empty()) {
+		image = _load_transcoded_cache(cache_path, imgfmt);
+		if (image.is_valid()) {
+			return image;
+		}
+	}
+
 	ptr += 4;
 	size -= 4;
 
@@ -233,36 +375,53 @@ static Ref<Image> basis_universal_unpacker(const Vector<uint8_t> &p_buffer) {
 	basist::basisu_image_info info;
 	tr.get_image_info(ptr, size, info, 0);
 
+	// Uncompressed formats are transcoded in pixels, the rest in blocks.
+	bool uncompressed = basist::basis_transcoder_format_is_uncompressed(format);
 	int block_size = basist::basis_get_bytes_per_block_or_pixel(format);
-	Vector<uint8_t> gpudata;
-	gpudata.resize(info.m_total_blocks * block_size);
 
-	{
-		uint8_t *w = gpudata.ptrw();
-		uint8_t *dst = w;
-		for (int i = 0; i < gpudata.size(); i++) {
-			dst[i] = 0x00;
-		}
+	BasisTranscodeJob job;
+	job.transcoder = &tr;
+	job.src = ptr;
+	job.src_size = size;
+	job.format = format;
+	job.levels.resize(info.m_total_levels);
+
+	uint32_t total_size = 0;
+	for (uint32_t i = 0; i < info.m_total_levels; i++) {
+		basist::basisu_image_level_info level;
+		tr.get_image_level_info(ptr, size, level, 0, i);
+
+		job.levels[i].offset = total_size;
+		job.levels[i].count = uncompressed ? level.m_orig_width * level.m_orig_height : level.m_total_blocks;
+		total_size += job.levels[i].count * block_size;
+	}
 
-		int ofs = 0;
-		tr.start_transcoding(ptr, size);
+	Vector<uint8_t> gpudata;
+	gpudata.resize(total_size);
+	memset(gpudata.ptrw(), 0, total_size);
+	job.dst = gpudata.ptrw();
+
+	// Levels can be transcoded in parallel once the codebooks are decoded, each with its own state.
+	tr.start_transcoding(ptr, size);
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (info.m_total_levels > 1 && pool && pool->get_thread_count() > 0) {
+		WorkerThreadPool::GroupID group = pool->add_native_group_task(&_basis_transcode_level, &job, info.m_total_levels);
+		pool->wait_for_group_task_completion(group);
+	} else {
 		for (uint32_t i = 0; i < info.m_total_levels; i++) {
-			basist::basisu_image_level_info level;
-			tr.get_image_level_info(ptr, size, level, 0, i);
-
-			bool ret = tr.transcode_image_level(ptr, size, 0, i, dst + ofs, level.m_total_blocks - i, format);
-			if (!ret) {
-				printf("failed! on level %i\n", i);
-				break;
-			};
+			_basis_transcode_level(&job, i);
+		}
+	}
 
-			ofs += level.m_total_blocks * block_size;
-		};
-	};
+	ERR_FAIL_COND_V_MSG(job.failed.is_set(), image, "Failed transcoding Basis Universal texture.");
 
 	image.instantiate();
 	image->create(info.m_width, info.m_height, info.m_total_levels > 1, imgfmt, gpudata);
 
+	if (!cache_path.is_empty()) {
+		_save_transcoded_cache(cache_path, image);
+	}
+
 	return image;
 }
 
@@ -273,6 +432,11 @@ void register_basis_universal_types() {
 #endif
 	Image::basis_universal_unpacker = basis_universal_unpacker;
 	//GDREGISTER_CLASS(TextureBasisU);
+
+	// The transcoder lookup tables must be ready before any (possibly threaded) transcoding happens.
+	basist::basisu_transcoder_init();
+
+	GLOBAL_DEF("rendering/textures/basis_universal/cache_transcoded_textures", false);
 }
 
 void unregister_basis_universal_types() {
@@ -231,6 +231,34 @@ int BulletPhysicsServer3D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+Vector<uint8_t> BulletPhysicsServer3D::space_save_state(RID p_space) const {
+	ERR_FAIL_V_MSG(Vector<uint8_t>(), "Space state snapshots are not supported by the Bullet physics engine.");
+}
+
+bool BulletPhysicsServer3D::space_restore_state(RID p_space, const Vector<uint8_t> &p_state) {
+	ERR_FAIL_V_MSG(false, "Space state snapshots are not supported by the Bullet physics engine.");
+}
+
+void BulletPhysicsServer3D::space_set_state_history_size(RID p_space, int p_size) {
+	ERR_FAIL_MSG("Space state snapshots are not supported by the Bullet physics engine.");
+}
+
+int BulletPhysicsServer3D::space_get_state_history_size(RID p_space) const {
+	return 0;
+}
+
+int BulletPhysicsServer3D::space_get_state_history_count(RID p_space) const {
+	return 0;
+}
+
+void BulletPhysicsServer3D::space_push_state(RID p_space) {
+	ERR_FAIL_MSG("Space state snapshots are not supported by the Bullet physics engine.");
+}
+
+bool BulletPhysicsServer3D::space_rollback_state(RID p_space, int p_steps_back) {
+	ERR_FAIL_V_MSG(false, "Space state snapshots are not supported by the Bullet physics engine.");
+}
+
 RID BulletPhysicsServer3D::area_create() {
 	AreaBullet *area = bulletnew(AreaBullet);
 	area->set_collision_layer(1);
@@ -118,6 +118,22 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	/// Not supported
+	virtual Vector<uint8_t> space_save_state(RID p_space) const override;
+	/// Not supported
+	virtual bool space_restore_state(RID p_space, const Vector<uint8_t> &p_state) override;
+
+	/// Not supported
+	virtual void space_set_state_history_size(RID p_space, int p_size) override;
+	/// Not supported
+	virtual int space_get_state_history_size(RID p_space) const override;
+	/// Not supported
+	virtual int space_get_state_history_count(RID p_space) const override;
+	/// Not supported
+	virtual void space_push_state(RID p_space) override;
+	/// Not supported
+	virtual bool space_rollback_state(RID p_space, int p_steps_back) override;
+
 	/* AREA API */
 
 	/// Bullet Physics Engine not support "Area", this must be handled by the game developer in another way.
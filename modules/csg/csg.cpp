@@ -32,14 +32,33 @@
 
 #include "core/math/geometry_2d.h"
 #include "core/math/math_funcs.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/templates/sort_array.h"
 
+// Face intersections are found and rebuilt on the WorkerThreadPool when a brush has at least this many faces.
+#define CSG_THREADED_MIN_FACES 128
+#define CSG_THREADED_BATCH 16
+
 // Static helper functions.
 
 inline static bool is_snapable(const Vector3 &p_point1, const Vector3 &p_point2, real_t p_distance) {
 	return p_point2.distance_squared_to(p_point1) < p_distance * p_distance;
 }
 
+// Faces with an edge or a height (slivers) shorter than the snap distance can't form a reliable plane.
+inline static bool is_face_degenerate(const Vector3 p_vertices[3], real_t p_vertex_snap) {
+	if (is_snapable(p_vertices[0], p_vertices[1], p_vertex_snap) ||
+			is_snapable(p_vertices[0], p_vertices[2], p_vertex_snap) ||
+			is_snapable(p_vertices[1], p_vertices[2], p_vertex_snap)) {
+		return true;
+	}
+
+	// The smallest height is twice the area over the longest edge.
+	real_t longest_edge2 = MAX(p_vertices[0].distance_squared_to(p_vertices[1]), MAX(p_vertices[0].distance_squared_to(p_vertices[2]), p_vertices[1].distance_squared_to(p_vertices[2])));
+	real_t double_area = (p_vertices[1] - p_vertices[0]).cross(p_vertices[2] - p_vertices[0]).length();
+	return double_area * double_area < p_vertex_snap * p_vertex_snap * longest_edge2;
+}
+
 inline static Vector2 interpolate_segment_uv(const Vector2 p_segment_points[2], const Vector2 p_uvs[2], const Vector2 &p_interpolation_point) {
 	if (p_segment_points[0].is_equal_approx(p_segment_points[1])) {
 		return p_uvs[0];
@@ -283,13 +302,7 @@ void CSGBrush::copy_from(const CSGBrush &p_brush, const Transform3D &p_xform) {
 void CSGBrushOperation::merge_brushes(Operation p_operation, const CSGBrush &p_brush_a, const CSGBrush &p_brush_b, CSGBrush &r_merged_brush, float p_vertex_snap) {
 	// Check for face collisions and add necessary faces.
 	Build2DFaceCollection build2DFaceCollection;
-	for (int i = 0; i < p_brush_a.faces.size(); i++) {
-		for (int j = 0; j < p_brush_b.faces.size(); j++) {
-			if (p_brush_a.faces[i].aabb.intersects_inclusive(p_brush_b.faces[j].aabb)) {
-				update_faces(p_brush_a, i, p_brush_b, j, build2DFaceCollection, p_vertex_snap);
-			}
-		}
-	}
+	update_faces(p_brush_a, p_brush_b, build2DFaceCollection, p_vertex_snap);
 
 	// Add faces to MeshMerge.
 	MeshMerge mesh_merge;
@@ -301,7 +314,7 @@ void CSGBrushOperation::merge_brushes(Operation p_operation, const CSGBrush &p_b
 			material = p_brush_a.materials[p_brush_a.faces[i].material];
 		}
 
-		if (build2DFaceCollection.build2DFacesA.has(i)) {
+		if (build2DFaceCollection.usedA[i]) {
 			build2DFaceCollection.build2DFacesA[i].addFacesToMesh(mesh_merge, p_brush_a.faces[i].smooth, p_brush_a.faces[i].invert, material, false);
 		} else {
 			Vector3 points[3];
@@ -320,7 +333,7 @@ void CSGBrushOperation::merge_brushes(Operation p_operation, const CSGBrush &p_b
 			material = p_brush_b.materials[p_brush_b.faces[i].material];
 		}
 
-		if (build2DFaceCollection.build2DFacesB.has(i)) {
+		if (build2DFaceCollection.usedB[i]) {
 			build2DFaceCollection.build2DFacesB[i].addFacesToMesh(mesh_merge, p_brush_b.faces[i].smooth, p_brush_b.faces[i].invert, material, true);
 		} else {
 			Vector3 points[3];
@@ -1354,47 +1367,16 @@ CSGBrushOperation::Build2DFaces::Build2DFaces(const CSGBrush &p_brush, int p_fac
 	faces.push_back(face);
 }
 
-void CSGBrushOperation::update_faces(const CSGBrush &p_brush_a, const int p_face_idx_a, const CSGBrush &p_brush_b, const int p_face_idx_b, Build2DFaceCollection &p_collection, float p_vertex_snap) {
-	Vector3 vertices_a[3] = {
-		p_brush_a.faces[p_face_idx_a].vertices[0],
-		p_brush_a.faces[p_face_idx_a].vertices[1],
-		p_brush_a.faces[p_face_idx_a].vertices[2],
-	};
-
-	Vector3 vertices_b[3] = {
-		p_brush_b.faces[p_face_idx_b].vertices[0],
-		p_brush_b.faces[p_face_idx_b].vertices[1],
-		p_brush_b.faces[p_face_idx_b].vertices[2],
-	};
-
-	// Don't use degenerate faces.
-	bool has_degenerate = false;
-	if (is_snapable(vertices_a[0], vertices_a[1], p_vertex_snap) ||
-			is_snapable(vertices_a[0], vertices_a[2], p_vertex_snap) ||
-			is_snapable(vertices_a[1], vertices_a[2], p_vertex_snap)) {
-		p_collection.build2DFacesA[p_face_idx_a] = Build2DFaces();
-		has_degenerate = true;
-	}
-
-	if (is_snapable(vertices_b[0], vertices_b[1], p_vertex_snap) ||
-			is_snapable(vertices_b[0], vertices_b[2], p_vertex_snap) ||
-			is_snapable(vertices_b[1], vertices_b[2], p_vertex_snap)) {
-		p_collection.build2DFacesB[p_face_idx_b] = Build2DFaces();
-		has_degenerate = true;
-	}
-	if (has_degenerate) {
-		return;
-	}
-
+static bool faces_intersect(const Vector3 p_vertices_a[3], const Vector3 p_vertices_b[3]) {
 	// Ensure B has points either side of or in the plane of A.
 	int in_plane_count = 0, over_count = 0, under_count = 0;
-	Plane plane_a(vertices_a[0], vertices_a[1], vertices_a[2]);
-	ERR_FAIL_COND_MSG(plane_a.normal == Vector3(), "Couldn't form plane from Brush A face.");
+	Plane plane_a(p_vertices_a[0], p_vertices_a[1], p_vertices_a[2]);
+	ERR_FAIL_COND_V_MSG(plane_a.normal == Vector3(), false, "Couldn't form plane from Brush A face.");
 
 	for (int i = 0; i < 3; i++) {
-		if (plane_a.has_point(vertices_b[i])) {
+		if (plane_a.has_point(p_vertices_b[i])) {
 			in_plane_count++;
-		} else if (plane_a.is_point_over(vertices_b[i])) {
+		} else if (plane_a.is_point_over(p_vertices_b[i])) {
 			over_count++;
 		} else {
 			under_count++;
@@ -1402,20 +1384,20 @@ void CSGBrushOperation::update_faces(const CSGBrush &p_brush_a, const int p_face
 	}
 	// If all points under or over the plane, there is no intersection.
 	if (over_count == 3 || under_count == 3) {
-		return;
+		return false;
 	}
 
 	// Ensure A has points either side of or in the plane of B.
 	in_plane_count = 0;
 	over_count = 0;
 	under_count = 0;
-	Plane plane_b(vertices_b[0], vertices_b[1], vertices_b[2]);
-	ERR_FAIL_COND_MSG(plane_b.normal == Vector3(), "Couldn't form plane from Brush B face.");
+	Plane plane_b(p_vertices_b[0], p_vertices_b[1], p_vertices_b[2]);
+	ERR_FAIL_COND_V_MSG(plane_b.normal == Vector3(), false, "Couldn't form plane from Brush B face.");
 
 	for (int i = 0; i < 3; i++) {
-		if (plane_b.has_point(vertices_a[i])) {
+		if (plane_b.has_point(p_vertices_a[i])) {
 			in_plane_count++;
-		} else if (plane_b.is_point_over(vertices_a[i])) {
+		} else if (plane_b.is_point_over(p_vertices_a[i])) {
 			over_count++;
 		} else {
 			under_count++;
@@ -1423,17 +1405,17 @@ void CSGBrushOperation::update_faces(const CSGBrush &p_brush_a, const int p_face
 	}
 	// If all points under or over the plane, there is no intersection.
 	if (over_count == 3 || under_count == 3) {
-		return;
+		return false;
 	}
 
 	// Check for intersection using the SAT theorem.
 	{
 		// Edge pair cross product combinations.
 		for (int i = 0; i < 3; i++) {
-			Vector3 axis_a = (vertices_a[i] - vertices_a[(i + 1) % 3]).normalized();
+			Vector3 axis_a = (p_vertices_a[i] - p_vertices_a[(i + 1) % 3]).normalized();
 
 			for (int j = 0; j < 3; j++) {
-				Vector3 axis_b = (vertices_b[j] - vertices_b[(j + 1) % 3]).normalized();
+				Vector3 axis_b = (p_vertices_b[j] - p_vertices_b[(j + 1) % 3]).normalized();
 
 				Vector3 sep_axis = axis_a.cross(axis_b);
 				if (sep_axis == Vector3()) {
@@ -1445,10 +1427,10 @@ void CSGBrushOperation::update_faces(const CSGBrush &p_brush_a, const int p_face
 				real_t min_b = 1e20, max_b = -1e20;
 
 				for (int k = 0; k < 3; k++) {
-					real_t d = sep_axis.dot(vertices_a[k]);
+					real_t d = sep_axis.dot(p_vertices_a[k]);
 					min_a = MIN(min_a, d);
 					max_a = MAX(max_a, d);
-					d = sep_axis.dot(vertices_b[k]);
+					d = sep_axis.dot(p_vertices_b[k]);
 					min_b = MIN(min_b, d);
 					max_b = MAX(max_b, d);
 				}
@@ -1460,20 +1442,158 @@ void CSGBrushOperation::update_faces(const CSGBrush &p_brush_a, const int p_face
 				real_t dmax = max_b - (min_a + max_a) * 0.5;
 
 				if (dmin > CMP_EPSILON || dmax < -CMP_EPSILON) {
-					return; // Does not contain zero, so they don't overlap.
+					return false; // Does not contain zero, so they don't overlap.
 				}
 			}
 		}
 	}
 
-	// If we're still here, the faces probably intersect, so add new faces.
-	if (!p_collection.build2DFacesA.has(p_face_idx_a)) {
-		p_collection.build2DFacesA[p_face_idx_a] = Build2DFaces(p_brush_a, p_face_idx_a, p_vertex_snap);
+	// If we're still here, the faces probably intersect.
+	return true;
+}
+
+void CSGBrushOperation::_find_face_pairs(uint32_t p_face_idx_a, FaceIntersections *p_data) {
+	struct FaceCollector {
+		LocalVector<uint32_t> *pairs = nullptr;
+		_FORCE_INLINE_ bool operator()(void *p_userdata) {
+			pairs->push_back(uint32_t(intptr_t(p_userdata)));
+			return false;
+		}
+	};
+
+	const CSGBrush::Face &face_a = p_data->brush_a->faces[p_face_idx_a];
+	LocalVector<uint32_t> &pairs = p_data->pairs_a[p_face_idx_a];
+
+	FaceCollector collector;
+	collector.pairs = &pairs;
+	p_data->faces_b_bvh->aabb_query(face_a.aabb, collector);
+	if (pairs.is_empty()) {
+		return;
 	}
-	p_collection.build2DFacesA[p_face_idx_a].insert(p_brush_b, p_face_idx_b);
 
-	if (!p_collection.build2DFacesB.has(p_face_idx_b)) {
-		p_collection.build2DFacesB[p_face_idx_b] = Build2DFaces(p_brush_b, p_face_idx_b, p_vertex_snap);
+	// Same order as testing every face of B, so faces are rebuilt the same way.
+	pairs.sort();
+
+	bool degenerate_a = p_data->degenerate_a[p_face_idx_a];
+	for (uint32_t i = 0; i < pairs.size(); i++) {
+		uint32_t face_idx_b = pairs[i];
+		bool intersects = !degenerate_a && !p_data->degenerate_b[face_idx_b] && faces_intersect(face_a.vertices, p_data->brush_b->faces[face_idx_b].vertices);
+		pairs[i] = (face_idx_b << 1) | (intersects ? 1 : 0);
+	}
+}
+
+void CSGBrushOperation::_build_faces_a(uint32_t p_face_idx_a, FaceIntersections *p_data) {
+	const LocalVector<uint32_t> &pairs = p_data->pairs_a[p_face_idx_a];
+	if (pairs.is_empty()) {
+		return;
 	}
-	p_collection.build2DFacesB[p_face_idx_b].insert(p_brush_a, p_face_idx_a);
+
+	Build2DFaceCollection &collection = *p_data->collection;
+	if (p_data->degenerate_a[p_face_idx_a]) {
+		collection.usedA[p_face_idx_a] = true; // Don't use degenerate faces.
+		return;
+	}
+
+	for (uint32_t i = 0; i < pairs.size(); i++) {
+		if (!(pairs[i] & 1)) {
+			continue;
+		}
+		if (!collection.usedA[p_face_idx_a]) {
+			collection.build2DFacesA[p_face_idx_a] = Build2DFaces(*p_data->brush_a, p_face_idx_a, p_data->vertex_snap);
+			collection.usedA[p_face_idx_a] = true;
+		}
+		collection.build2DFacesA[p_face_idx_a].insert(*p_data->brush_b, pairs[i] >> 1);
+	}
+}
+
+void CSGBrushOperation::_build_faces_b(uint32_t p_face_idx_b, FaceIntersections *p_data) {
+	const LocalVector<uint32_t> &intersections = p_data->intersections_b[p_face_idx_b];
+	if (intersections.is_empty()) {
+		return;
+	}
+
+	Build2DFaceCollection &collection = *p_data->collection;
+	collection.build2DFacesB[p_face_idx_b] = Build2DFaces(*p_data->brush_b, p_face_idx_b, p_data->vertex_snap);
+	collection.usedB[p_face_idx_b] = true;
+	for (uint32_t i = 0; i < intersections.size(); i++) {
+		collection.build2DFacesB[p_face_idx_b].insert(*p_data->brush_a, intersections[i]);
+	}
+}
+
+void CSGBrushOperation::_process_faces(void (CSGBrushOperation::*p_method)(uint32_t, FaceIntersections *), FaceIntersections *p_data, uint32_t p_face_count, bool p_threaded) {
+	if (p_threaded) {
+		WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+		WorkerThreadPool::GroupID group = pool->add_template_group_task(this, p_method, p_data, p_face_count, -1, CSG_THREADED_BATCH);
+		pool->wait_for_group_task_completion(group);
+	} else {
+		for (uint32_t i = 0; i < p_face_count; i++) {
+			(this->*p_method)(i, p_data);
+		}
+	}
+}
+
+void CSGBrushOperation::update_faces(const CSGBrush &p_brush_a, const CSGBrush &p_brush_b, Build2DFaceCollection &r_collection, float p_vertex_snap) {
+	uint32_t face_count_a = p_brush_a.faces.size();
+	uint32_t face_count_b = p_brush_b.faces.size();
+
+	r_collection.build2DFacesA.resize(face_count_a);
+	r_collection.build2DFacesB.resize(face_count_b);
+	r_collection.usedA.resize(face_count_a);
+	r_collection.usedB.resize(face_count_b);
+	for (uint32_t i = 0; i < face_count_a; i++) {
+		r_collection.usedA[i] = false;
+	}
+	for (uint32_t i = 0; i < face_count_b; i++) {
+		r_collection.usedB[i] = false;
+	}
+
+	if (face_count_a == 0 || face_count_b == 0) {
+		return;
+	}
+
+	// Faces of B go in a BVH, so each face of A is only tested against the ones its AABB overlaps.
+	DynamicBVH faces_b_bvh;
+	for (uint32_t i = 0; i < face_count_b; i++) {
+		faces_b_bvh.insert(p_brush_b.faces[i].aabb, (void *)intptr_t(i));
+	}
+
+	FaceIntersections data;
+	data.brush_a = &p_brush_a;
+	data.brush_b = &p_brush_b;
+	data.faces_b_bvh = &faces_b_bvh;
+	data.vertex_snap = p_vertex_snap;
+	data.collection = &r_collection;
+	data.degenerate_a.resize(face_count_a);
+	data.degenerate_b.resize(face_count_b);
+	data.pairs_a.resize(face_count_a);
+	data.intersections_b.resize(face_count_b);
+
+	for (uint32_t i = 0; i < face_count_a; i++) {
+		data.degenerate_a[i] = is_face_degenerate(p_brush_a.faces[i].vertices, p_vertex_snap);
+	}
+	for (uint32_t i = 0; i < face_count_b; i++) {
+		data.degenerate_b[i] = is_face_degenerate(p_brush_b.faces[i].vertices, p_vertex_snap);
+	}
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	bool threaded = MAX(face_count_a, face_count_b) >= CSG_THREADED_MIN_FACES && pool && pool->get_thread_count() > 0;
+
+	// Find the intersecting pairs, then rebuild the faces of each brush. Every face only depends on
+	// its own pairs, so faces are rebuilt independently, inserting the other faces in index order.
+	_process_faces(&CSGBrushOperation::_find_face_pairs, &data, face_count_a, threaded);
+
+	for (uint32_t i = 0; i < face_count_a; i++) {
+		const LocalVector<uint32_t> &pairs = data.pairs_a[i];
+		for (uint32_t j = 0; j < pairs.size(); j++) {
+			uint32_t face_idx_b = pairs[j] >> 1;
+			if (data.degenerate_b[face_idx_b]) {
+				r_collection.usedB[face_idx_b] = true; // Don't use degenerate faces.
+			} else if (pairs[j] & 1) {
+				data.intersections_b[face_idx_b].push_back(i);
+			}
+		}
+	}
+
+	_process_faces(&CSGBrushOperation::_build_faces_a, &data, face_count_a, threaded);
+	_process_faces(&CSGBrushOperation::_build_faces_b, &data, face_count_b, threaded);
 }
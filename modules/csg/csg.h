@@ -32,12 +32,14 @@
 #define CSG_H
 
 #include "core/math/aabb.h"
+#include "core/math/dynamic_bvh.h"
 #include "core/math/plane.h"
 #include "core/math/transform_3d.h"
 #include "core/math/vector2.h"
 #include "core/math/vector3.h"
 #include "core/object/ref_counted.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/map.h"
 #include "core/templates/oa_hash_map.h"
 #include "core/templates/vector.h"
@@ -183,12 +185,35 @@ struct CSGBrushOperation {
 		Build2DFaces(const CSGBrush &p_brush, int p_brush_face, float p_vertex_snap2);
 	};
 
+	// Faces of each brush rebuilt from their intersections with the other brush, by face index.
+	// Degenerate faces touching the other brush get an empty entry, which drops them.
 	struct Build2DFaceCollection {
-		Map<int, Build2DFaces> build2DFacesA;
-		Map<int, Build2DFaces> build2DFacesB;
+		LocalVector<Build2DFaces> build2DFacesA;
+		LocalVector<Build2DFaces> build2DFacesB;
+		LocalVector<bool> usedA;
+		LocalVector<bool> usedB;
 	};
 
-	void update_faces(const CSGBrush &p_brush_a, const int p_face_idx_a, const CSGBrush &p_brush_b, const int p_face_idx_b, Build2DFaceCollection &p_collection, float p_vertex_snap);
+	struct FaceIntersections {
+		const CSGBrush *brush_a = nullptr;
+		const CSGBrush *brush_b = nullptr;
+		DynamicBVH *faces_b_bvh = nullptr;
+		float vertex_snap = 0.0;
+
+		LocalVector<bool> degenerate_a;
+		LocalVector<bool> degenerate_b;
+		LocalVector<LocalVector<uint32_t>> pairs_a; // Faces of B overlapping each face of A, as (index << 1) | intersects.
+		LocalVector<LocalVector<uint32_t>> intersections_b; // Faces of A intersecting each face of B.
+
+		Build2DFaceCollection *collection = nullptr;
+	};
+
+	void _find_face_pairs(uint32_t p_face_idx_a, FaceIntersections *p_data);
+	void _build_faces_a(uint32_t p_face_idx_a, FaceIntersections *p_data);
+	void _build_faces_b(uint32_t p_face_idx_b, FaceIntersections *p_data);
+	void _process_faces(void (CSGBrushOperation::*p_method)(uint32_t, FaceIntersections *), FaceIntersections *p_data, uint32_t p_face_count, bool p_threaded);
+
+	void update_faces(const CSGBrush &p_brush_a, const CSGBrush &p_brush_b, Build2DFaceCollection &r_collection, float p_vertex_snap);
 };
 
 #endif // CSG_H
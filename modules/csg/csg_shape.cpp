@@ -31,6 +31,7 @@
 #include "csg_shape.h"
 
 #include "core/math/geometry_2d.h"
+#include "core/os/worker_thread_pool.h"
 
 void CSGShape3D::set_use_collision(bool p_enable) {
 	if (use_collision == p_enable) {
@@ -150,6 +151,59 @@ void CSGShape3D::_make_dirty() {
 	dirty = true;
 }
 
+struct _CSGUnionLevel {
+	CSGBrush **brushes = nullptr;
+	CSGBrush **merged = nullptr;
+	float snap = 0.0;
+};
+
+static void _csg_union_pair(void *p_userdata, uint32_t p_index) {
+	_CSGUnionLevel *level = (_CSGUnionLevel *)p_userdata;
+	CSGBrush *merged = memnew(CSGBrush);
+	CSGBrushOperation bop;
+	bop.merge_brushes(CSGBrushOperation::OPERATION_UNION, *level->brushes[p_index * 2], *level->brushes[p_index * 2 + 1], *merged, level->snap);
+	level->merged[p_index] = merged;
+}
+
+// Unions are associative, so a run of them is merged as a balanced tree. Pairs on each level are
+// independent and merged on the WorkerThreadPool, and no brush has to grow with every merge of the run.
+// Takes ownership of the brushes.
+static CSGBrush *_csg_union_brushes(LocalVector<CSGBrush *> &p_brushes, float p_snap) {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	bool threaded = pool && pool->get_thread_count() > 0;
+
+	while (p_brushes.size() > 1) {
+		uint32_t pair_count = p_brushes.size() / 2;
+
+		LocalVector<CSGBrush *> merged;
+		merged.resize(pair_count + (p_brushes.size() & 1));
+
+		_CSGUnionLevel level;
+		level.brushes = p_brushes.ptr();
+		level.merged = merged.ptr();
+		level.snap = p_snap;
+
+		if (threaded && pair_count > 1) {
+			WorkerThreadPool::GroupID group = pool->add_native_group_task(&_csg_union_pair, &level, pair_count);
+			pool->wait_for_group_task_completion(group);
+		} else {
+			for (uint32_t i = 0; i < pair_count; i++) {
+				_csg_union_pair(&level, i);
+			}
+		}
+
+		for (uint32_t i = 0; i < pair_count * 2; i++) {
+			memdelete(p_brushes[i]);
+		}
+		if (p_brushes.size() & 1) {
+			merged[pair_count] = p_brushes[p_brushes.size() - 1];
+		}
+		p_brushes = merged;
+	}
+
+	return p_brushes[0];
+}
+
 CSGBrush *CSGShape3D::_get_brush() {
 	if (dirty) {
 		if (brush) {
@@ -157,7 +211,9 @@ CSGBrush *CSGShape3D::_get_brush() {
 		}
 		brush = nullptr;
 
+		// Children keep their own brushes while they are not dirty, so only the changed branch is rebuilt.
 		CSGBrush *n = _build_brush();
+		LocalVector<CSGBrush *> union_run; // Starts with n when children are being added to it.
 
 		for (int i = 0; i < get_child_count(); i++) {
 			CSGShape3D *child = Object::cast_to<CSGShape3D>(get_child(i));
@@ -172,33 +228,48 @@ CSGBrush *CSGShape3D::_get_brush() {
 			if (!n2) {
 				continue;
 			}
-			if (!n) {
-				n = memnew(CSGBrush);
 
-				n->copy_from(*n2, child->get_transform());
+			CSGBrush *nn2 = memnew(CSGBrush);
+			nn2->copy_from(*n2, child->get_transform());
 
-			} else {
-				CSGBrush *nn = memnew(CSGBrush);
-				CSGBrush *nn2 = memnew(CSGBrush);
-				nn2->copy_from(*n2, child->get_transform());
-
-				CSGBrushOperation bop;
-
-				switch (child->get_operation()) {
-					case CSGShape3D::OPERATION_UNION:
-						bop.merge_brushes(CSGBrushOperation::OPERATION_UNION, *n, *nn2, *nn, snap);
-						break;
-					case CSGShape3D::OPERATION_INTERSECTION:
-						bop.merge_brushes(CSGBrushOperation::OPERATION_INTERSECTION, *n, *nn2, *nn, snap);
-						break;
-					case CSGShape3D::OPERATION_SUBTRACTION:
-						bop.merge_brushes(CSGBrushOperation::OPERATION_SUBTRACTION, *n, *nn2, *nn, snap);
-						break;
+			if (!n) {
+				n = nn2;
+				continue;
+			}
+
+			if (child->get_operation() == CSGShape3D::OPERATION_UNION) {
+				if (union_run.is_empty()) {
+					union_run.push_back(n);
 				}
-				memdelete(n);
-				memdelete(nn2);
-				n = nn;
+				union_run.push_back(nn2);
+				continue;
+			}
+
+			if (!union_run.is_empty()) {
+				n = _csg_union_brushes(union_run, snap);
+				union_run.clear();
+			}
+
+			CSGBrush *nn = memnew(CSGBrush);
+			CSGBrushOperation bop;
+
+			switch (child->get_operation()) {
+				case CSGShape3D::OPERATION_UNION:
+					break; // Merged above.
+				case CSGShape3D::OPERATION_INTERSECTION:
+					bop.merge_brushes(CSGBrushOperation::OPERATION_INTERSECTION, *n, *nn2, *nn, snap);
+					break;
+				case CSGShape3D::OPERATION_SUBTRACTION:
+					bop.merge_brushes(CSGBrushOperation::OPERATION_SUBTRACTION, *n, *nn2, *nn, snap);
+					break;
 			}
+			memdelete(n);
+			memdelete(nn2);
+			n = nn;
+		}
+
+		if (!union_run.is_empty()) {
+			n = _csg_union_brushes(union_run, snap);
 		}
 
 		if (n) {
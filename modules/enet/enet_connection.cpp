@@ -124,17 +124,25 @@ ENetConnection::EventType ENetConnection::service(int p_timeout, Event &r_event)
 	// Drop peers that have already been disconnected.
 	// NOTE: Forcibly disconnected peers (i.e. peers disconnected via
 	// enet_peer_disconnect*) do not trigger DISCONNECTED events.
-	List<Ref<ENetPacketPeer>>::Element *E = peers.front();
-	while (E) {
-		if (!E->get()->is_active()) {
-			peers.erase(E->get());
+	// Services are usually called until there are no events left, checking once per round is enough.
+	if (!peers_checked) {
+		List<Ref<ENetPacketPeer>>::Element *E = peers.front();
+		while (E) {
+			List<Ref<ENetPacketPeer>>::Element *N = E->next();
+			if (!E->get()->is_active()) {
+				peers.erase(E);
+			}
+			E = N;
 		}
-		E = E->next();
+		peers_checked = true;
 	}
 
 	ENetEvent event;
 	int ret = enet_host_service(host, &event, p_timeout);
 
+	if (ret <= 0) {
+		peers_checked = false;
+	}
 	if (ret < 0) {
 		return EVENT_ERROR;
 	} else if (ret == 0) {
@@ -78,6 +78,7 @@ protected:
 private:
 	ENetHost *host = nullptr;
 	List<Ref<ENetPacketPeer>> peers;
+	bool peers_checked = false;
 
 	Error _create(ENetAddress *p_address, int p_max_peers, int p_max_channels, int p_in_bandwidth, int p_out_bandwidth);
 	Array _service(int p_timeout = 0);
@@ -114,13 +114,27 @@ Error ENetMultiplayerPeer::add_mesh_peer(int p_id, Ref<ENetConnection> p_host) {
 	return OK;
 }
 
-bool ENetMultiplayerPeer::_poll_server() {
+void ENetMultiplayerPeer::_drop_inactive_peers() {
+	List<int> inactive;
 	for (const KeyValue<int, Ref<ENetPacketPeer>> &E : peers) {
 		if (!(E.value->is_active())) {
-			emit_signal(SNAME("peer_disconnected"), E.value->get_meta(SNAME("_net_id")));
-			peers.erase(E.key);
+			inactive.push_back(E.key);
 		}
 	}
+	for (const int &id : inactive) {
+		if (active_mode == MODE_SERVER) {
+			emit_signal(SNAME("peer_disconnected"), peers[id]->get_meta(SNAME("_net_id")));
+		} else {
+			emit_signal(SNAME("peer_disconnected"), id);
+			if (hosts.has(id)) {
+				hosts.erase(id);
+			}
+		}
+		peers.erase(id);
+	}
+}
+
+bool ENetMultiplayerPeer::_poll_server() {
 	ENetConnection::Event event;
 	ENetConnection::EventType ret = hosts[0]->service(0, event);
 	if (ret == ENetConnection::EVENT_ERROR) {
@@ -287,15 +301,6 @@ bool ENetMultiplayerPeer::_poll_client() {
 }
 
 bool ENetMultiplayerPeer::_poll_mesh() {
-	for (const KeyValue<int, Ref<ENetPacketPeer>> &E : peers) {
-		if (!(E.value->is_active())) {
-			emit_signal(SNAME("peer_disconnected"), E.key);
-			peers.erase(E.key);
-			if (hosts.has(E.key)) {
-				hosts.erase(E.key);
-			}
-		}
-	}
 	bool should_stop = true;
 	for (KeyValue<int, Ref<ENetConnection>> &E : hosts) {
 		ENetConnection::Event event;
@@ -348,6 +353,11 @@ void ENetMultiplayerPeer::poll() {
 
 	_pop_current_packet();
 
+	// Once per poll, not once per event, this is linear in the number of peers.
+	if (active_mode == MODE_SERVER || active_mode == MODE_MESH) {
+		_drop_inactive_peers();
+	}
+
 	while (true) {
 		switch (active_mode) {
 			case MODE_CLIENT:
@@ -478,12 +488,16 @@ Error ENetMultiplayerPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size
 			peers[target_peer]->send(channel, packet);
 		}
 		ERR_FAIL_COND_V(!hosts.has(0), ERR_BUG);
-		hosts[0]->flush();
+		if (!packet_batching) {
+			hosts[0]->flush();
+		}
 
 	} else if (active_mode == MODE_CLIENT) {
 		peers[1]->send(channel, packet); // Send to server for broadcast.
 		ERR_FAIL_COND_V(!hosts.has(0), ERR_BUG);
-		hosts[0]->flush();
+		if (!packet_batching) {
+			hosts[0]->flush();
+		}
 
 	} else {
 		if (target_peer <= 0) {
@@ -494,13 +508,17 @@ Error ENetMultiplayerPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size
 				}
 				E.value->send(channel, packet);
 				ERR_CONTINUE(!hosts.has(E.key));
-				hosts[E.key]->flush();
+				if (!packet_batching) {
+					hosts[E.key]->flush();
+				}
 			}
 			_destroy_unused(packet);
 		} else {
 			peers[target_peer]->send(channel, packet);
 			ERR_FAIL_COND_V(!hosts.has(target_peer), ERR_BUG);
-			hosts[target_peer]->flush();
+			if (!packet_batching) {
+				hosts[target_peer]->flush();
+			}
 		}
 	}
 
@@ -551,6 +569,14 @@ bool ENetMultiplayerPeer::is_server_relay_enabled() const {
 	return server_relay;
 }
 
+void ENetMultiplayerPeer::set_packet_batching_enabled(bool p_enabled) {
+	packet_batching = p_enabled;
+}
+
+bool ENetMultiplayerPeer::is_packet_batching_enabled() const {
+	return packet_batching;
+}
+
 Ref<ENetConnection> ENetMultiplayerPeer::get_host() const {
 	ERR_FAIL_COND_V(!_is_active(), nullptr);
 	ERR_FAIL_COND_V(active_mode == MODE_MESH, nullptr);
@@ -644,10 +670,13 @@ void ENetMultiplayerPeer::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("set_server_relay_enabled", "enabled"), &ENetMultiplayerPeer::set_server_relay_enabled);
 	ClassDB::bind_method(D_METHOD("is_server_relay_enabled"), &ENetMultiplayerPeer::is_server_relay_enabled);
+	ClassDB::bind_method(D_METHOD("set_packet_batching_enabled", "enabled"), &ENetMultiplayerPeer::set_packet_batching_enabled);
+	ClassDB::bind_method(D_METHOD("is_packet_batching_enabled"), &ENetMultiplayerPeer::is_packet_batching_enabled);
 	ClassDB::bind_method(D_METHOD("get_host"), &ENetMultiplayerPeer::get_host);
 	ClassDB::bind_method(D_METHOD("get_peer", "id"), &ENetMultiplayerPeer::get_peer);
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "server_relay"), "set_server_relay_enabled", "is_server_relay_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "packet_batching"), "set_packet_batching_enabled", "is_packet_batching_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "host", PROPERTY_HINT_RESOURCE_TYPE, "ENetConnection", PROPERTY_USAGE_NONE), "", "get_host");
 }
 
@@ -67,6 +67,7 @@ private:
 	int target_peer = 0;
 
 	bool server_relay = true;
+	bool packet_batching = false;
 
 	ConnectionStatus connection_status = CONNECTION_DISCONNECTED;
 
@@ -84,6 +85,7 @@ private:
 	Packet current_packet;
 
 	void _pop_current_packet();
+	void _drop_inactive_peers();
 	bool _poll_server();
 	bool _poll_client();
 	bool _poll_mesh();
@@ -127,6 +129,8 @@ public:
 	void set_bind_ip(const IPAddress &p_ip);
 	void set_server_relay_enabled(bool p_enabled);
 	bool is_server_relay_enabled() const;
+	void set_packet_batching_enabled(bool p_enabled);
+	bool is_packet_batching_enabled() const;
 
 	Ref<ENetConnection> get_host() const;
 	Ref<ENetPacketPeer> get_peer(int p_id) const;
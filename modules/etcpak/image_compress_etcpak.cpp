@@ -31,7 +31,9 @@
 #include "image_compress_etcpak.h"
 
 #include "core/os/os.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/string/print_string.h"
+#include "core/templates/local_vector.h"
 
 #include "thirdparty/etcpak/ProcessDxtc.hpp"
 #include "thirdparty/etcpak/ProcessRGB.hpp"
@@ -88,6 +90,38 @@ void _compress_bc(Image *r_img, float p_lossy_quality, Image::UsedChannels p_cha
 	_compress_etcpak(type, r_img, p_lossy_quality);
 }
 
+// Blocks (4x4 pixels) compressed per worker task, whole block rows are always used.
+#define ETCPAK_TASK_BLOCKS 4096
+
+struct EtcpakTask {
+	const uint32_t *src = nullptr;
+	uint64_t *dst = nullptr;
+	uint32_t blocks = 0;
+	uint32_t width = 0;
+};
+
+struct EtcpakJob {
+	EtcpakType type;
+	const EtcpakTask *tasks = nullptr;
+};
+
+static void _compress_etcpak_task(void *p_userdata, uint32_t p_index) {
+	const EtcpakJob *job = (const EtcpakJob *)p_userdata;
+	const EtcpakTask &task = job->tasks[p_index];
+
+	if (job->type == EtcpakType::ETCPAK_TYPE_ETC1) {
+		CompressEtc1RgbDither(task.src, task.dst, task.blocks, task.width);
+	} else if (job->type == EtcpakType::ETCPAK_TYPE_ETC2 || job->type == EtcpakType::ETCPAK_TYPE_ETC2_RA_AS_RG) {
+		CompressEtc2Rgb(task.src, task.dst, task.blocks, task.width, true);
+	} else if (job->type == EtcpakType::ETCPAK_TYPE_ETC2_ALPHA) {
+		CompressEtc2Rgba(task.src, task.dst, task.blocks, task.width, true);
+	} else if (job->type == EtcpakType::ETCPAK_TYPE_DXT1) {
+		CompressDxt1Dither(task.src, task.dst, task.blocks, task.width);
+	} else if (job->type == EtcpakType::ETCPAK_TYPE_DXT5 || job->type == EtcpakType::ETCPAK_TYPE_DXT5_RA_AS_RG) {
+		CompressDxt5(task.src, task.dst, task.blocks, task.width);
+	}
+}
+
 void _compress_etcpak(EtcpakType p_compresstype, Image *r_img, float p_lossy_quality) {
 	uint64_t start_time = OS::get_singleton()->get_ticks_msec();
 
@@ -145,6 +179,12 @@ void _compress_etcpak(EtcpakType p_compresstype, Image *r_img, float p_lossy_qua
 
 	int mip_count = mipmaps ? Image::get_image_required_mipmaps(width, height, target_format) : 0;
 
+	// Size in uint64_t of a compressed block, as written by the encoder.
+	const uint32_t block_words = (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_ALPHA || p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5 || p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5_RA_AS_RG) ? 2 : 1;
+
+	// Split every mipmap in runs of block rows that are compressed independently.
+	LocalVector<EtcpakTask> tasks;
+
 	for (int i = 0; i < mip_count + 1; i++) {
 		// Get write mip metrics for target image.
 		int mip_w, mip_h;
@@ -162,21 +202,29 @@ void _compress_etcpak(EtcpakType p_compresstype, Image *r_img, float p_lossy_qua
 		int src_mip_ofs = r_img->get_mipmap_offset(i);
 		const uint32_t *src_mip_read = (const uint32_t *)&src_read[src_mip_ofs];
 
-		if (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC1) {
-			CompressEtc1RgbDither(src_mip_read, dest_mip_write, blocks, mip_w);
-		} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2 || p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_RA_AS_RG) {
-			CompressEtc2Rgb(src_mip_read, dest_mip_write, blocks, mip_w, true);
-		} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_ALPHA) {
-			CompressEtc2Rgba(src_mip_read, dest_mip_write, blocks, mip_w, true);
-		} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_DXT1) {
-			CompressDxt1Dither(src_mip_read, dest_mip_write, blocks, mip_w);
-		} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5 || p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5_RA_AS_RG) {
-			CompressDxt5(src_mip_read, dest_mip_write, blocks, mip_w);
-		} else {
-			ERR_FAIL_MSG("Invalid or unsupported Etcpak compression format.");
+		const uint32_t row_blocks = mip_w / 4;
+		const uint32_t task_rows = MAX(ETCPAK_TASK_BLOCKS / row_blocks, 1u);
+		for (uint32_t block = 0; block < blocks; block += task_rows * row_blocks) {
+			EtcpakTask task;
+			task.src = src_mip_read + (block / row_blocks) * 4 * mip_w;
+			task.dst = dest_mip_write + block * block_words;
+			task.blocks = MIN(task_rows * row_blocks, blocks - block);
+			task.width = mip_w;
+			tasks.push_back(task);
 		}
 	}
 
+	EtcpakJob job;
+	job.type = p_compresstype;
+	job.tasks = tasks.ptr();
+
+	if (tasks.size() == 1) {
+		_compress_etcpak_task(&job, 0);
+	} else {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&_compress_etcpak_task, &job, tasks.size());
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+
 	// Replace original image with compressed one.
 	r_img->create(width, height, mipmaps, target_format, dest_data);
 
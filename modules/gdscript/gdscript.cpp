@@ -43,6 +43,7 @@
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
+#include "gdscript_sampling_profiler.h"
 #include "gdscript_warning.h"
 
 #ifdef TESTS_ENABLED
@@ -1674,6 +1675,28 @@ void GDScriptLanguage::init() {
 		_add_global(E.name, E.ptr);
 	}
 
+	// Scripts with a global class name are the ones most other scripts depend on, parse them
+	// up front and in parallel instead of one by one while the first scenes are loaded.
+	{
+		List<StringName> global_classes;
+		ScriptServer::get_global_class_list(&global_classes);
+		Vector<String> paths;
+		for (const StringName &E : global_classes) {
+			if (ScriptServer::get_global_class_language(E) == get_name()) {
+				paths.push_back(ScriptServer::get_global_class_path(E));
+			}
+		}
+		GDScriptCache::parse_scripts(paths);
+	}
+
+#ifdef DEBUG_ENABLED
+	// The sampler reads the debug call stack, which is only kept while a debugger is attached.
+	if (_call_stack) {
+		sampling_profiler = memnew(GDScriptSamplingProfiler(this));
+		sampling_profiler->register_profiler();
+	}
+#endif
+
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif
@@ -1693,6 +1716,15 @@ Error GDScriptLanguage::execute_file(const String &p_path) {
 }
 
 void GDScriptLanguage::finish() {
+	GDScriptCache::release_parsed_scripts();
+
+#ifdef DEBUG_ENABLED
+	if (sampling_profiler) {
+		sampling_profiler->unregister_profiler();
+		memdelete(sampling_profiler);
+		sampling_profiler = nullptr;
+	}
+#endif
 }
 
 void GDScriptLanguage::profiling_start() {
@@ -1948,6 +1980,9 @@ void GDScriptLanguage::reload_tool_script(const Ref<Script> &p_script, bool p_so
 void GDScriptLanguage::frame() {
 	calls = 0;
 
+	// Startup is over, dependencies loaded from now on are parsed on demand again.
+	GDScriptCache::release_parsed_scripts();
+
 #ifdef DEBUG_ENABLED
 	if (profiling) {
 		MutexLock lock(this->lock);
@@ -305,8 +305,11 @@ public:
 	~GDScriptInstance();
 };
 
+class GDScriptSamplingProfiler;
+
 class GDScriptLanguage : public ScriptLanguage {
 	friend class GDScriptFunctionState;
+	friend class GDScriptSamplingProfiler;
 
 	static GDScriptLanguage *singleton;
 
@@ -344,6 +347,9 @@ class GDScriptLanguage : public ScriptLanguage {
 	SelfList<GDScriptFunction>::List function_list;
 	bool profiling;
 	uint64_t script_frame_time;
+#ifdef DEBUG_ENABLED
+	GDScriptSamplingProfiler *sampling_profiler = nullptr;
+#endif
 
 	Map<String, ObjectID> orphan_subclasses;
 
@@ -381,6 +381,14 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_methods_count = 0;
 	}
 
+	if (inline_cache_count) {
+		function->_inline_caches_ptr = memnew_arr(GDScriptFunction::InlineCache, inline_cache_count);
+		function->_inline_caches_count = inline_cache_count;
+	} else {
+		function->_inline_caches_ptr = nullptr;
+		function->_inline_caches_count = 0;
+	}
+
 	if (lambdas_map.size()) {
 		function->lambdas.resize(lambdas_map.size());
 		function->_lambdas_ptr = function->lambdas.ptrw();
@@ -562,6 +570,48 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 			}
 		}
 
+		// Arithmetic and comparisons between two ints or two floats are evaluated inline by the VM.
+		Variant::Type left_type = p_left_operand.type.builtin_type;
+		if (left_type == p_right_operand.type.builtin_type && p_operator >= Variant::OP_EQUAL) {
+			if ((left_type == Variant::INT && p_operator <= Variant::OP_MULTIPLY) || (left_type == Variant::FLOAT && p_operator <= Variant::OP_DIVIDE)) {
+				append(left_type == Variant::INT ? GDScriptFunction::OPCODE_OPERATOR_INT : GDScriptFunction::OPCODE_OPERATOR_FLOAT, 3);
+				append(p_left_operand);
+				append(p_right_operand);
+				append(p_target);
+				append(p_operator);
+				return;
+			}
+		}
+
+		// Same for the common Vector3 math.
+		if (left_type == Variant::VECTOR3 && p_right_operand.type.builtin_type == Variant::VECTOR3) {
+			if (p_operator == Variant::OP_EQUAL || p_operator == Variant::OP_NOT_EQUAL || (p_operator >= Variant::OP_ADD && p_operator <= Variant::OP_DIVIDE)) {
+				append(GDScriptFunction::OPCODE_OPERATOR_VECTOR3, 3);
+				append(p_left_operand);
+				append(p_right_operand);
+				append(p_target);
+				append(p_operator);
+				return;
+			}
+		} else if (left_type == Variant::VECTOR3 && p_right_operand.type.builtin_type == Variant::FLOAT) {
+			if (p_operator == Variant::OP_MULTIPLY || p_operator == Variant::OP_DIVIDE) {
+				append(GDScriptFunction::OPCODE_OPERATOR_VECTOR3_FLOAT, 3);
+				append(p_left_operand);
+				append(p_right_operand);
+				append(p_target);
+				append(p_operator);
+				return;
+			}
+		} else if (left_type == Variant::FLOAT && p_right_operand.type.builtin_type == Variant::VECTOR3 && p_operator == Variant::OP_MULTIPLY) {
+			// Commutative, the VM always gets the vector first.
+			append(GDScriptFunction::OPCODE_OPERATOR_VECTOR3_FLOAT, 3);
+			append(p_right_operand);
+			append(p_left_operand);
+			append(p_target);
+			append(p_operator);
+			return;
+		}
+
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
@@ -760,6 +810,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -775,6 +826,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -918,6 +970,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(p_target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_super_call(const Address &p_target, const StringName &p_function_name, const Vector<Address> &p_arguments) {
@@ -939,6 +992,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(p_target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_call_gdscript_utility(const Address &p_target, GDScriptUtilityFunctions::FunctionPtr p_function, const Vector<Address> &p_arguments) {
@@ -1168,6 +1222,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(p_target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, const StringName &p_function_name, const Vector<Address> &p_arguments) {
@@ -1179,6 +1234,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(p_target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_target, const Address &p_base, const StringName &p_function_name, const Vector<Address> &p_arguments) {
@@ -1190,6 +1246,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(p_target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_lambda(const Address &p_target, GDScriptFunction *p_function, const Vector<Address> &p_captures) {
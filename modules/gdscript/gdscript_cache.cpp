@@ -31,6 +31,7 @@
 #include "gdscript_cache.h"
 
 #include "core/io/file_access.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/templates/vector.h"
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
@@ -239,11 +240,64 @@ Error GDScriptCache::finish_compiling(const String &p_owner) {
 	return err;
 }
 
+void GDScriptCache::_parse_script_task(void *p_userdata, uint32_t p_index) {
+	Ref<GDScriptParserRef> *refs = (Ref<GDScriptParserRef> *)p_userdata;
+	// Errors are kept in the parser ref and reported when the script is actually used.
+	refs[p_index]->raise_status(GDScriptParserRef::PARSED);
+}
+
+void GDScriptCache::parse_scripts(const Vector<String> &p_paths) {
+	Vector<Ref<GDScriptParserRef>> refs;
+	{
+		MutexLock lock(singleton->lock);
+		for (int i = 0; i < p_paths.size(); i++) {
+			const String &path = p_paths[i];
+			if (singleton->parser_map.has(path) || !FileAccess::exists(path)) {
+				continue;
+			}
+			Ref<GDScriptParserRef> ref;
+			ref.instantiate();
+			ref->parser = memnew(GDScriptParser);
+			ref->path = path;
+			singleton->parser_map[path] = ref.ptr();
+			refs.push_back(ref);
+		}
+	}
+
+	if (refs.is_empty()) {
+		return;
+	}
+
+	// Fill the lazily built builtin type table before parsers start using it concurrently.
+	GDScriptParser::get_builtin_type(StringName());
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&_parse_script_task, refs.ptrw(), refs.size());
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	MutexLock lock(singleton->lock);
+	singleton->parsed_scripts.append_array(refs);
+}
+
+void GDScriptCache::release_parsed_scripts() {
+	if (singleton->parsed_scripts.is_empty()) {
+		return;
+	}
+
+	Vector<Ref<GDScriptParserRef>> refs;
+	{
+		MutexLock lock(singleton->lock);
+		SWAP(refs, singleton->parsed_scripts);
+	}
+	// Refs are released outside of the lock, their destructor takes it.
+	refs.clear();
+}
+
 GDScriptCache::GDScriptCache() {
 	singleton = this;
 }
 
 GDScriptCache::~GDScriptCache() {
+	parsed_scripts.clear();
 	parser_map.clear();
 	shallow_gdscript_cache.clear();
 	full_gdscript_cache.clear();
@@ -75,6 +75,8 @@ class GDScriptCache {
 	HashMap<String, GDScript *> shallow_gdscript_cache;
 	HashMap<String, GDScript *> full_gdscript_cache;
 	HashMap<String, Set<String>> dependencies;
+	// Parsers created by parse_scripts(), kept alive until release_parsed_scripts().
+	Vector<Ref<GDScriptParserRef>> parsed_scripts;
 
 	friend class GDScript;
 	friend class GDScriptParserRef;
@@ -83,6 +85,7 @@ class GDScriptCache {
 
 	Mutex lock;
 	static void remove_script(const String &p_path);
+	static void _parse_script_task(void *p_userdata, uint32_t p_index);
 
 public:
 	static Ref<GDScriptParserRef> get_parser(const String &p_path, GDScriptParserRef::Status status, Error &r_error, const String &p_owner = String());
@@ -91,6 +94,11 @@ public:
 	static Ref<GDScript> get_full_script(const String &p_path, Error &r_error, const String &p_owner = String());
 	static Error finish_compiling(const String &p_owner);
 
+	// Parses the scripts in parallel on the worker thread pool, so later dependency lookups
+	// through get_parser() only have to analyze them. Must be called from the main thread.
+	static void parse_scripts(const Vector<String> &p_paths);
+	static void release_parsed_scripts();
+
 	GDScriptCache();
 	~GDScriptCache();
 };
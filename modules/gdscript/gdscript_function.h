@@ -40,6 +40,8 @@
 #include "core/variant/variant.h"
 #include "gdscript_utility_functions.h"
 
+#include <atomic>
+
 class GDScriptInstance;
 class GDScript;
 
@@ -220,6 +222,10 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_INT,
+		OPCODE_OPERATOR_FLOAT,
+		OPCODE_OPERATOR_VECTOR3,
+		OPCODE_OPERATOR_VECTOR3_FLOAT,
 		OPCODE_EXTENDS_TEST,
 		OPCODE_IS_BUILTIN,
 		OPCODE_SET_KEYED,
@@ -425,6 +431,62 @@ private:
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
 
+	// Per-instruction cache for named access and calls on native objects (no script attached),
+	// keyed by class. Entries are filled once and never change afterwards, so they can be read
+	// without locking when the same function runs on several threads.
+	struct InlineCache {
+		enum {
+			ENTRY_COUNT = 2,
+		};
+
+		enum EntryState {
+			ENTRY_EMPTY,
+			ENTRY_FILLING,
+			ENTRY_READY,
+		};
+
+		struct Entry {
+			std::atomic<uint32_t> state = { ENTRY_EMPTY };
+			StringName class_name;
+			MethodBind *method = nullptr;
+			int index = -1; // Property index passed to the accessor, -1 if none.
+		};
+
+		Entry entries[ENTRY_COUNT];
+
+		_FORCE_INLINE_ const Entry *lookup(const StringName &p_class) const {
+			for (int i = 0; i < ENTRY_COUNT; i++) {
+				const Entry &e = entries[i];
+				if (e.state.load(std::memory_order_acquire) != ENTRY_READY) {
+					return nullptr;
+				}
+				if (e.class_name == p_class) {
+					return &e;
+				}
+			}
+			return nullptr;
+		}
+
+		// Takes the first empty entry. When the cache is full the site stays polymorphic and
+		// the caller keeps using the generic path.
+		void fill(const StringName &p_class, MethodBind *p_method, int p_index) {
+			for (int i = 0; i < ENTRY_COUNT; i++) {
+				Entry &e = entries[i];
+				uint32_t expected = ENTRY_EMPTY;
+				if (e.state.compare_exchange_strong(expected, ENTRY_FILLING, std::memory_order_acquire)) {
+					e.class_name = p_class;
+					e.method = p_method;
+					e.index = p_index;
+					e.state.store(ENTRY_READY, std::memory_order_release);
+					return;
+				}
+				if (expected == ENTRY_FILLING) {
+					return; // Another thread is filling it, don't risk a duplicate.
+				}
+			}
+		}
+	};
+
 	StringName source;
 
 	mutable Variant nil;
@@ -460,6 +522,8 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	int _lambdas_count = 0;
 	GDScriptFunction **_lambdas_ptr = nullptr;
+	int _inline_caches_count = 0;
+	InlineCache *_inline_caches_ptr = nullptr;
 	const int *_code_ptr = nullptr;
 	int _code_size = 0;
 	int _argument_count = 0;
@@ -507,6 +571,7 @@ private:
 	_FORCE_INLINE_ String _get_call_error(const Callable::CallError &p_err, const String &p_where, const Variant **argptrs) const;
 
 	friend class GDScriptLanguage;
+	friend class GDScriptSamplingProfiler;
 
 	SelfList<GDScriptFunction> function_list{ this };
 #ifdef DEBUG_ENABLED
@@ -0,0 +1,202 @@
+/*************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#ifdef DEBUG_ENABLED
+
+#include "core/debugger/engine_debugger.h"
+#include "core/os/os.h"
+#include "gdscript.h"
+
+void GDScriptSamplingProfiler::_thread_func(void *p_user) {
+	GDScriptSamplingProfiler *profiler = (GDScriptSamplingProfiler *)p_user;
+
+	uint64_t next_sample = OS::get_singleton()->get_ticks_usec() + profiler->interval_usec;
+	while (!profiler->exit_thread.is_set()) {
+		uint64_t now = OS::get_singleton()->get_ticks_usec();
+		if (now < next_sample) {
+			OS::get_singleton()->delay_usec(next_sample - now);
+			continue;
+		}
+		// Don't try to catch up after a stall, that would only add samples at the same spot.
+		next_sample = MAX(next_sample + profiler->interval_usec, now);
+
+		profiler->_take_sample();
+	}
+}
+
+void GDScriptSamplingProfiler::_take_sample() {
+	stack_scratch.clear();
+
+	{
+		// Functions can't be freed while the language lock is held, so the stack entries stay valid.
+		MutexLock lock(language->lock);
+
+		const int depth = language->_debug_call_stack_pos;
+		for (int i = depth - 1; i >= 0; i--) {
+			const GDScriptLanguage::CallLevel &cl = language->_call_stack[i];
+			if (!cl.function) {
+				continue;
+			}
+
+			LineKey key;
+			key.signature = cl.function->profile.signature;
+			key.line = cl.line ? *cl.line : 0;
+			stack_scratch.push_back(key);
+		}
+	}
+
+	MutexLock lock(samples_mutex);
+
+	sample_count++;
+	for (uint32_t i = 0; i < stack_scratch.size(); i++) {
+		// Recursive calls visit the same line more than once, count it once per sample.
+		bool seen = false;
+		for (uint32_t j = 0; j < i; j++) {
+			if (stack_scratch[j] == stack_scratch[i]) {
+				seen = true;
+				break;
+			}
+		}
+		if (seen) {
+			continue;
+		}
+
+		LineSamples &ls = samples[stack_scratch[i]];
+		if (i == 0) {
+			ls.self_samples++;
+		}
+		ls.total_samples++;
+	}
+}
+
+void GDScriptSamplingProfiler::toggle(bool p_enable, const Array &p_opts) {
+	if (p_enable) {
+		uint64_t interval = 1000;
+		if (p_opts.size() >= 1 && p_opts[0].get_type() == Variant::INT) {
+			interval = CLAMP(int64_t(p_opts[0]), 100, 1000000);
+		}
+		start(interval);
+	} else {
+		stop();
+	}
+}
+
+void GDScriptSamplingProfiler::tick() {
+	Map<LineKey, LineSamples> frame_samples;
+	uint32_t frame_sample_count;
+	{
+		MutexLock lock(samples_mutex);
+		SWAP(frame_samples, samples);
+		frame_sample_count = sample_count;
+		sample_count = 0;
+	}
+
+	if (frame_sample_count == 0 || !EngineDebugger::get_singleton()) {
+		return;
+	}
+
+	Array frame;
+	frame.push_back(interval_usec);
+	frame.push_back(frame_sample_count);
+	for (const KeyValue<LineKey, LineSamples> &E : frame_samples) {
+		Map<StringName, int>::Element *id = signature_ids.find(E.key.signature);
+		if (!id) {
+			id = signature_ids.insert(E.key.signature, signature_ids.size());
+			Array sig;
+			sig.push_back(String(E.key.signature));
+			sig.push_back(id->get());
+			EngineDebugger::get_singleton()->send_message("gdscript_sampler:signature", sig);
+		}
+
+		frame.push_back(id->get());
+		frame.push_back(E.key.line);
+		frame.push_back(E.value.self_samples);
+		frame.push_back(E.value.total_samples);
+	}
+
+	EngineDebugger::get_singleton()->send_message("gdscript_sampler:frame", frame);
+}
+
+void GDScriptSamplingProfiler::start(uint64_t p_interval_usec) {
+	stop();
+
+	{
+		MutexLock lock(samples_mutex);
+		samples.clear();
+		sample_count = 0;
+	}
+	// Ids are only meaningful for one session, the receiving end starts over as well.
+	signature_ids.clear();
+
+	interval_usec = p_interval_usec;
+	exit_thread.clear();
+	thread.start(_thread_func, this);
+}
+
+void GDScriptSamplingProfiler::stop() {
+	if (!thread.is_started()) {
+		return;
+	}
+
+	exit_thread.set();
+	thread.wait_to_finish();
+}
+
+void GDScriptSamplingProfiler::register_profiler() {
+	EngineDebugger::Profiler profiler(
+			this,
+			[](void *p_user, bool p_enable, const Array &p_opts) {
+				((GDScriptSamplingProfiler *)p_user)->toggle(p_enable, p_opts);
+			},
+			nullptr,
+			[](void *p_user, double p_frame_time, double p_process_time, double p_physics_time, double p_physics_frame_time) {
+				((GDScriptSamplingProfiler *)p_user)->tick();
+			});
+	EngineDebugger::register_profiler("gdscript_sampler", profiler);
+}
+
+void GDScriptSamplingProfiler::unregister_profiler() {
+	stop();
+	if (EngineDebugger::has_profiler("gdscript_sampler")) {
+		EngineDebugger::unregister_profiler("gdscript_sampler");
+	}
+}
+
+GDScriptSamplingProfiler::GDScriptSamplingProfiler(GDScriptLanguage *p_language) {
+	language = p_language;
+}
+
+GDScriptSamplingProfiler::~GDScriptSamplingProfiler() {
+	stop();
+}
+
+#endif // DEBUG_ENABLED
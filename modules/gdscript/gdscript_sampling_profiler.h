@@ -0,0 +1,111 @@
+/*************************************************************************/
+/*  gdscript_sampling_profiler.h                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef GDSCRIPT_SAMPLING_PROFILER_H
+#define GDSCRIPT_SAMPLING_PROFILER_H
+
+#ifdef DEBUG_ENABLED
+
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/map.h"
+#include "core/templates/safe_refcount.h"
+#include "core/variant/array.h"
+
+class GDScriptLanguage;
+
+// Statistical profiler for the GDScript call stack of the main thread.
+//
+// Unlike the "scripts" profiler it doesn't time every call: a separate thread wakes up
+// at a fixed interval and records which line each function on the stack is executing,
+// so the cost paid by the running scripts doesn't depend on how often they call functions.
+// Samples are sent every frame through the "gdscript_sampler" EngineDebugger profiler:
+//
+// "gdscript_sampler:signature" [ signature, id ] once for every new function.
+// "gdscript_sampler:frame" [ interval_usec, sample_count, (id, line, self_samples, total_samples)... ]
+//
+// sample_count includes the samples taken while no script was running, self_samples counts
+// samples where the line was at the top of the stack, total_samples those where it was anywhere.
+class GDScriptSamplingProfiler {
+	struct LineKey {
+		StringName signature;
+		int line = 0;
+
+		bool operator<(const LineKey &p_key) const {
+			if (line != p_key.line) {
+				return line < p_key.line;
+			}
+			return signature < p_key.signature;
+		}
+		bool operator==(const LineKey &p_key) const {
+			return line == p_key.line && signature == p_key.signature;
+		}
+	};
+
+	struct LineSamples {
+		uint32_t self_samples = 0;
+		uint32_t total_samples = 0;
+	};
+
+	GDScriptLanguage *language = nullptr;
+
+	Thread thread;
+	SafeFlag exit_thread;
+	uint64_t interval_usec = 1000;
+
+	Mutex samples_mutex;
+	Map<LineKey, LineSamples> samples;
+	uint32_t sample_count = 0;
+
+	LocalVector<LineKey> stack_scratch; // Only used by the sampling thread.
+	Map<StringName, int> signature_ids; // Only used by the main thread.
+
+	static void _thread_func(void *p_user);
+	void _take_sample();
+
+	void toggle(bool p_enable, const Array &p_opts);
+	void tick();
+
+public:
+	void start(uint64_t p_interval_usec);
+	void stop();
+
+	void register_profiler();
+	void unregister_profiler();
+
+	GDScriptSamplingProfiler(GDScriptLanguage *p_language);
+	~GDScriptSamplingProfiler();
+};
+
+#endif // DEBUG_ENABLED
+
+#endif // GDSCRIPT_SAMPLING_PROFILER_H
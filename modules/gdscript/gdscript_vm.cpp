@@ -123,6 +123,43 @@ static String _get_var_type(const Variant *p_var) {
 }
 #endif // DEBUG_ENABLED
 
+// Object behind p_base if named access and calls on it can go through the inline caches,
+// i.e. a native object without a script instance. Anything else takes the generic path.
+static _FORCE_INLINE_ Object *_get_inline_cache_object(const Variant *p_base, bool p_validate) {
+	if (p_base->get_type() != Variant::OBJECT) {
+		return nullptr;
+	}
+
+	Object *obj;
+	if (p_validate) {
+		// Same check as Variant::get_named() and Variant::set_named().
+		obj = p_base->get_validated_object();
+	} else {
+		obj = const_cast<Object *>(*VariantInternal::get_object(p_base));
+#ifdef DEBUG_ENABLED
+		// Same check as Variant::call().
+		if (obj && EngineDebugger::is_active()) {
+			ObjectID id = VariantInternal::get_object_id(p_base);
+			if (!id.is_ref_counted() && ObjectDB::get_instance(id) == nullptr) {
+				return nullptr;
+			}
+		}
+#endif
+	}
+
+	if (!obj || obj->get_script_instance()) {
+		return nullptr;
+	}
+	return obj;
+}
+
+// Getters and setters of extension classes may be bypassed by their get/set callbacks,
+// so only core and editor classes resolve properties through the cache.
+static _FORCE_INLINE_ bool _is_inline_cache_property_class(const StringName &p_class) {
+	ClassDB::APIType api = ClassDB::get_api_type(p_class);
+	return api == ClassDB::API_CORE || api == ClassDB::API_EDITOR;
+}
+
 String GDScriptFunction::_get_call_error(const Callable::CallError &p_err, const String &p_where, const Variant **argptrs) const {
 	String err_text;
 
@@ -195,6 +232,10 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {        \
 		&&OPCODE_OPERATOR,                           \
 		&&OPCODE_OPERATOR_VALIDATED,                 \
+		&&OPCODE_OPERATOR_INT,                       \
+		&&OPCODE_OPERATOR_FLOAT,                     \
+		&&OPCODE_OPERATOR_VECTOR3,                   \
+		&&OPCODE_OPERATOR_VECTOR3_FLOAT,             \
 		&&OPCODE_EXTENDS_TEST,                       \
 		&&OPCODE_IS_BUILTIN,                         \
 		&&OPCODE_SET_KEYED,                          \
@@ -426,6 +467,7 @@ void (*type_init_function_table[])(Variant *) = {
 
 Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state) {
 	OPCODES_TABLE;
+	Memory::TagScope memory_tag(Memory::TAG_SCRIPT);
 
 	if (!_code_ptr) {
 		return Variant();
@@ -586,6 +628,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	bool exit_ok = false;
 	bool awaited = false;
 #endif
+	bool stack_moved = false; // The stack was handed over to a new function state by OPCODE_AWAIT.
 
 #ifdef DEBUG_ENABLED
 	OPCODE_WHILE(ip < _code_size) {
@@ -653,6 +696,148 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			// Same contract as OPCODE_OPERATOR_VALIDATED (operand and result types known at compile time),
+			// but evaluated inline instead of through an evaluator function.
+#define OPCODE_TYPED_ARITHMETIC_CASES(m_get)                                         \
+	case Variant::OP_EQUAL:                                                          \
+		*VariantInternal::get_bool(dst) = left == right;                             \
+		break;                                                                       \
+	case Variant::OP_NOT_EQUAL:                                                      \
+		*VariantInternal::get_bool(dst) = left != right;                             \
+		break;                                                                       \
+	case Variant::OP_LESS:                                                           \
+		*VariantInternal::get_bool(dst) = left < right;                              \
+		break;                                                                       \
+	case Variant::OP_LESS_EQUAL:                                                     \
+		*VariantInternal::get_bool(dst) = left <= right;                             \
+		break;                                                                       \
+	case Variant::OP_GREATER:                                                        \
+		*VariantInternal::get_bool(dst) = left > right;                              \
+		break;                                                                       \
+	case Variant::OP_GREATER_EQUAL:                                                  \
+		*VariantInternal::get_bool(dst) = left >= right;                             \
+		break;                                                                       \
+	case Variant::OP_ADD:                                                            \
+		*VariantInternal::m_get(dst) = left + right;                                 \
+		break;                                                                       \
+	case Variant::OP_SUBTRACT:                                                       \
+		*VariantInternal::m_get(dst) = left - right;                                 \
+		break;                                                                       \
+	case Variant::OP_MULTIPLY:                                                       \
+		*VariantInternal::m_get(dst) = left * right;                                 \
+		break;
+
+			OPCODE(OPCODE_OPERATOR_INT) {
+				CHECK_SPACE(5);
+
+				int operation = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operation < Variant::OP_EQUAL || operation > Variant::OP_MULTIPLY);
+
+				GET_INSTRUCTION_ARG(a, 0);
+				GET_INSTRUCTION_ARG(b, 1);
+				GET_INSTRUCTION_ARG(dst, 2);
+
+				int64_t left = *VariantInternal::get_int(a);
+				int64_t right = *VariantInternal::get_int(b);
+
+				switch (operation) {
+					OPCODE_TYPED_ARITHMETIC_CASES(get_int)
+					default: {
+					}
+				}
+
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_FLOAT) {
+				CHECK_SPACE(5);
+
+				int operation = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operation < Variant::OP_EQUAL || operation > Variant::OP_DIVIDE);
+
+				GET_INSTRUCTION_ARG(a, 0);
+				GET_INSTRUCTION_ARG(b, 1);
+				GET_INSTRUCTION_ARG(dst, 2);
+
+				double left = *VariantInternal::get_float(a);
+				double right = *VariantInternal::get_float(b);
+
+				switch (operation) {
+					OPCODE_TYPED_ARITHMETIC_CASES(get_float)
+					case Variant::OP_DIVIDE:
+						*VariantInternal::get_float(dst) = left / right;
+						break;
+					default: {
+					}
+				}
+
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+#undef OPCODE_TYPED_ARITHMETIC_CASES
+
+			OPCODE(OPCODE_OPERATOR_VECTOR3) {
+				CHECK_SPACE(5);
+
+				int operation = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operation > Variant::OP_DIVIDE || (operation > Variant::OP_NOT_EQUAL && operation < Variant::OP_ADD));
+
+				GET_INSTRUCTION_ARG(a, 0);
+				GET_INSTRUCTION_ARG(b, 1);
+				GET_INSTRUCTION_ARG(dst, 2);
+
+				const Vector3 left = *VariantInternal::get_vector3(a);
+				const Vector3 right = *VariantInternal::get_vector3(b);
+
+				switch (operation) {
+					case Variant::OP_EQUAL:
+						*VariantInternal::get_bool(dst) = left == right;
+						break;
+					case Variant::OP_NOT_EQUAL:
+						*VariantInternal::get_bool(dst) = left != right;
+						break;
+					case Variant::OP_ADD:
+						*VariantInternal::get_vector3(dst) = left + right;
+						break;
+					case Variant::OP_SUBTRACT:
+						*VariantInternal::get_vector3(dst) = left - right;
+						break;
+					case Variant::OP_MULTIPLY:
+						*VariantInternal::get_vector3(dst) = left * right;
+						break;
+					case Variant::OP_DIVIDE:
+						*VariantInternal::get_vector3(dst) = left / right;
+						break;
+					default: {
+					}
+				}
+
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VECTOR3_FLOAT) {
+				CHECK_SPACE(5);
+
+				int operation = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operation != Variant::OP_MULTIPLY && operation != Variant::OP_DIVIDE);
+
+				GET_INSTRUCTION_ARG(a, 0);
+				GET_INSTRUCTION_ARG(b, 1);
+				GET_INSTRUCTION_ARG(dst, 2);
+
+				const real_t scalar = *VariantInternal::get_float(b);
+				if (operation == Variant::OP_MULTIPLY) {
+					*VariantInternal::get_vector3(dst) = *VariantInternal::get_vector3(a) * scalar;
+				} else {
+					*VariantInternal::get_vector3(dst) = *VariantInternal::get_vector3(a) / scalar;
+				}
+
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_EXTENDS_TEST) {
 				CHECK_SPACE(4);
 
@@ -931,7 +1116,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(4);
 
 				GET_INSTRUCTION_ARG(dst, 0);
 				GET_INSTRUCTION_ARG(value, 1);
@@ -941,8 +1126,45 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
-				dst->set_named(*index, *value, valid);
+				bool valid = false;
+				bool cached = false;
+#ifndef TOOLS_ENABLED
+				// Object::set() flags the object as edited in editor builds, those always take the generic path.
+				Object *obj = _get_inline_cache_object(dst, true);
+				if (obj) {
+					int cache_idx = _code_ptr[ip + 4];
+					GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+					InlineCache *cache = &_inline_caches_ptr[cache_idx];
+
+					const StringName &class_name = obj->get_class_name();
+					const InlineCache::Entry *entry = cache->lookup(class_name);
+					if (!entry && _is_inline_cache_property_class(class_name)) {
+						const ClassDB::PropertySetGet *psg = ClassDB::get_property_setget(class_name, *index);
+						if (psg && psg->_setptr) {
+							cache->fill(class_name, psg->_setptr, psg->index);
+							entry = cache->lookup(class_name);
+						}
+					}
+
+					if (entry) {
+						// Matches ClassDB::set_property_setget().
+						Callable::CallError ce;
+						if (entry->index >= 0) {
+							Variant prop_index = entry->index;
+							const Variant *args[2] = { &prop_index, value };
+							entry->method->call(obj, args, 2, ce);
+						} else {
+							const Variant *args[1] = { value };
+							entry->method->call(obj, args, 1, ce);
+						}
+						valid = ce.error == Callable::CallError::CALL_OK;
+						cached = true;
+					}
+				}
+#endif
+				if (!cached) {
+					dst->set_named(*index, *value, valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -951,7 +1173,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -971,7 +1193,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_INSTRUCTION_ARG(src, 0);
 				GET_INSTRUCTION_ARG(dst, 1);
@@ -981,14 +1203,46 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
-#ifdef DEBUG_ENABLED
-				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
+				bool valid = false;
+				Variant ret;
+				bool cached = false;
+				Object *obj = _get_inline_cache_object(src, true);
+				if (obj) {
+					int cache_idx = _code_ptr[ip + 4];
+					GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+					InlineCache *cache = &_inline_caches_ptr[cache_idx];
+
+					const StringName &class_name = obj->get_class_name();
+					const InlineCache::Entry *entry = cache->lookup(class_name);
+					if (!entry && _is_inline_cache_property_class(class_name)) {
+						const ClassDB::PropertySetGet *psg = ClassDB::get_property_setget(class_name, *index);
+						if (psg && psg->getter) {
+							// Indexed getters go through Object::call() in ClassDB::get_property(), so use the most derived bind.
+							MethodBind *getter = psg->index >= 0 ? ClassDB::get_method(class_name, psg->getter) : psg->_getptr;
+							if (getter) {
+								cache->fill(class_name, getter, psg->index);
+								entry = cache->lookup(class_name);
+							}
+						}
+					}
 
-#else
-				*dst = src->get_named(*index, valid);
-#endif
+					if (entry) {
+						Callable::CallError ce;
+						if (entry->index >= 0) {
+							Variant prop_index = entry->index;
+							const Variant *args[1] = { &prop_index };
+							ret = obj->call_method_bind(entry->method, args, 1, ce);
+						} else {
+							ret = entry->method->call(obj, nullptr, 0, ce);
+						}
+						valid = true;
+						cached = true;
+					}
+				}
+				if (!cached) {
+					// Goes through a temporary to allow better error messages in cases where src and dst are the same stack position.
+					ret = src->get_named(*index, valid);
+				}
 #ifdef DEBUG_ENABLED
 				if (!valid) {
 					if (src->has_method(*index)) {
@@ -998,9 +1252,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					}
 					OPCODE_BREAK;
 				}
-				*dst = ret;
 #endif
-				ip += 4;
+				*dst = ret;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1455,7 +1709,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE(OPCODE_CALL_ASYNC)
 			OPCODE(OPCODE_CALL_RETURN)
 			OPCODE(OPCODE_CALL) {
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 				bool call_ret = (_code_ptr[ip] & INSTR_MASK) != OPCODE_CALL;
 #ifdef DEBUG_ENABLED
 				bool call_async = (_code_ptr[ip] & INSTR_MASK) == OPCODE_CALL_ASYNC;
@@ -1481,10 +1735,33 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 
 #endif
+				int cache_idx = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+
+				MethodBind *method = nullptr;
+				Object *cached_obj = _get_inline_cache_object(base, false);
+				if (cached_obj) {
+					InlineCache *cache = &_inline_caches_ptr[cache_idx];
+					const StringName &class_name = cached_obj->get_class_name();
+					const InlineCache::Entry *entry = cache->lookup(class_name);
+					if (entry) {
+						method = entry->method;
+					} else if (*methodname != CoreStringNames::get_singleton()->_free) {
+						method = ClassDB::get_method(class_name, *methodname);
+						if (method) {
+							cache->fill(class_name, method, -1);
+						}
+					}
+				}
+
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->call(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					if (method) {
+						*ret = cached_obj->call_method_bind(method, (const Variant **)argptrs, argc, err);
+					} else {
+						base->call(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					}
 #ifdef DEBUG_ENABLED
 					if (!call_async && ret->get_type() == Variant::OBJECT) {
 						// Check if getting a function state without await.
@@ -1503,7 +1780,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 				} else {
 					Variant ret;
-					base->call(*methodname, (const Variant **)argptrs, argc, ret, err);
+					if (method) {
+						ret = cached_obj->call_method_bind(method, (const Variant **)argptrs, argc, err);
+					} else {
+						base->call(*methodname, (const Variant **)argptrs, argc, ret, err);
+					}
 				}
 #ifdef DEBUG_ENABLED
 				if (GDScriptLanguage::get_singleton()->profiling) {
@@ -1548,7 +1829,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -2112,10 +2393,20 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
 					gdfs->function = this;
 
-					gdfs->state.stack.resize(alloca_size);
-					//copy variant stack
-					for (int i = 0; i < _stack_size; i++) {
-						memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
+					if (p_state) {
+						// Resumed from a previous await, the stack already lives in the previous state's buffer.
+						// Hand it over instead of allocating and copying it again, coroutines that await in a loop
+						// then keep using the same buffer.
+						gdfs->state.stack = p_state->stack;
+						p_state->stack = Vector<uint8_t>();
+						p_state->stack_size = 0;
+						stack_moved = true;
+					} else {
+						gdfs->state.stack.resize(alloca_size);
+						//copy variant stack
+						for (int i = 0; i < _stack_size; i++) {
+							memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
+						}
 					}
 					gdfs->state.stack_size = _stack_size;
 					gdfs->state.alloca_size = alloca_size;
@@ -2141,7 +2432,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 					retvalue = gdfs;
 
-					Error err = sig.connect(callable_bind(Callable(gdfs.ptr(), "_signal_callback"), retvalue), Object::CONNECT_ONESHOT);
+					// Connect with the state as a bind instead of through callable_bind(), which would allocate a custom
+					// callable for every await. The bind also keeps the state alive until the signal is emitted.
+					static StringName signal_callback = _scs_create("_signal_callback");
+					Object *sig_obj = sig.get_object();
+					Error err = sig_obj ? sig_obj->connect(sig.get_name(), Callable(gdfs.ptr(), signal_callback), varray(retvalue), Object::CONNECT_ONESHOT) : ERR_INVALID_PARAMETER;
 					if (err != OK) {
 						err_text = "Error connecting to signal: " + sig.get_name() + " during await.";
 						OPCODE_BREAK;
@@ -3343,7 +3638,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		}
 #endif
 
-		if (_stack_size) {
+		if (_stack_size && !stack_moved) {
 			//free stack
 			for (int i = 0; i < _stack_size; i++) {
 				stack[i].~Variant();
@@ -0,0 +1,23 @@
+signal step(value)
+
+var received := []
+
+
+func worker(label: String):
+	var total := 0
+	for i in 3:
+		var value = await step
+		total += value
+		received.append("%s%d:%d" % [label, i, total])
+
+
+func test():
+	worker("a")
+	worker("b")
+	step.emit(1)
+	step.emit(10)
+	step.emit(100)
+	step.emit(1000)
+	# Waiters of the same signal aren't resumed in a guaranteed order.
+	received.sort()
+	print(received)
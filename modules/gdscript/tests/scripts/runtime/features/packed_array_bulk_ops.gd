@@ -0,0 +1,27 @@
+func test():
+	var a := PackedFloat32Array([1, 2, 3, 4, 5])
+	var b := PackedFloat32Array([5, 4, 3, 2, 1])
+	a.add(b)
+	print(a)
+	a.multiply_scalar(0.5)
+	print(a)
+	a.add_scalar(1)
+	print(a)
+	a.multiply(b)
+	print(a)
+	a.fma(PackedFloat32Array([2, 2, 2, 2, 2]), b)
+	print(a)
+	print(a.sum())
+	print(a.dot(b))
+	print(a.min())
+	print(a.max())
+
+	var c := PackedFloat64Array([-2, 8, 0.25])
+	print(c.sum())
+	print(c.min())
+	print(c.max())
+	print(PackedFloat64Array().sum())
+
+	var points := PackedVector3Array([Vector3(1, 0, 0), Vector3(0, 2, 0)])
+	points.transform(Transform3D(Basis(), Vector3(1, 1, 1)))
+	print(points)
@@ -0,0 +1,29 @@
+func test():
+	var a := 7
+	var b := 2
+	print(a + b)
+	print(a - b)
+	print(a * b)
+	print(a < b)
+	print(a >= b)
+	print(a == 7)
+	print(a != b)
+
+	var x := 7.0
+	var y := 2.0
+	print(x + y)
+	print(x - y)
+	print(x * y)
+	print(x / y)
+	print(x <= y)
+	print(x > y)
+
+	var total := 0
+	for i in 10:
+		total = total + i * i
+	print(total)
+
+	var acc := 1.0
+	while acc < 100.0:
+		acc = acc * 3.0
+	print(acc)
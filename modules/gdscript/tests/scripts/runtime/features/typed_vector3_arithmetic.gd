@@ -0,0 +1,20 @@
+func test():
+	var a := Vector3(1, 2, 3)
+	var b := Vector3(4, 6, 8)
+	var s := 2.0
+	print(a + b)
+	print(b - a)
+	print(a * b)
+	print(b / Vector3(2, 3, 4))
+	print(a * s)
+	print(s * a)
+	print(b / s)
+	print(a == Vector3(1, 2, 3))
+	print(a != b)
+
+	var position := Vector3()
+	var velocity := Vector3(1, 0, -1)
+	var delta := 0.5
+	for i in 4:
+		position = position + velocity * delta
+	print(position)
@@ -32,6 +32,7 @@
 
 #include "core/io/marshalls.h"
 #include "core/object/message_queue.h"
+#include "core/os/worker_thread_pool.h"
 #include "scene/3d/light_3d.h"
 #include "scene/resources/mesh_library.h"
 #include "scene/resources/surface_tool.h"
@@ -205,6 +206,23 @@ uint32_t GridMap::get_navigation_layers() {
 	return navigation_layers;
 }
 
+void GridMap::set_octant_merge_meshes(bool p_enable) {
+	octant_merge_meshes = p_enable;
+	_recreate_octant_data();
+}
+
+bool GridMap::is_octant_merge_meshes_enabled() const {
+	return octant_merge_meshes;
+}
+
+void GridMap::set_octant_max_updates_per_frame(int p_count) {
+	octant_max_updates_per_frame = MAX(p_count, 0);
+}
+
+int GridMap::get_octant_max_updates_per_frame() const {
+	return octant_max_updates_per_frame;
+}
+
 void GridMap::set_mesh_library(const Ref<MeshLibrary> &p_mesh_library) {
 	if (!mesh_library.is_null()) {
 		mesh_library->unregister_owner(this);
@@ -404,7 +422,7 @@ void GridMap::_octant_transform(const OctantKey &p_key) {
 	}
 }
 
-bool GridMap::_octant_update(const OctantKey &p_key) {
+bool GridMap::_octant_update(const OctantKey &p_key, const OctantMeshBuild *p_mesh_build) {
 	ERR_FAIL_COND_V(!octant_map.has(p_key), false);
 	Octant &g = *octant_map[p_key];
 	if (!g.dirty) {
@@ -465,7 +483,7 @@ bool GridMap::_octant_update(const OctantKey &p_key) {
 		xform.basis.set_orthogonal_index(c.rot);
 		xform.set_origin(cellpos * cell_size + ofs);
 		xform.basis.scale(Vector3(cell_scale, cell_scale, cell_scale));
-		if (baked_meshes.size() == 0) {
+		if (baked_meshes.size() == 0 && !p_mesh_build) {
 			if (mesh_library->get_item_mesh(c.item).is_valid()) {
 				if (!multimesh_items.has(c.item)) {
 					multimesh_items[c.item] = List<Pair<Transform3D, IndexKey>>();
@@ -549,6 +567,33 @@ bool GridMap::_octant_update(const OctantKey &p_key) {
 		}
 	}
 
+	// Commit the meshes merged on worker threads.
+	if (p_mesh_build && p_mesh_build->surfaces.size()) {
+		Octant::MultimeshInstance mmi;
+
+		RID mesh = RS::get_singleton()->mesh_create();
+		for (uint32_t i = 0; i < p_mesh_build->surfaces.size(); i++) {
+			const OctantMeshBuild::Surface &surface = p_mesh_build->surfaces[i];
+			RS::get_singleton()->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, surface.arrays, Array(), surface.lods);
+			if (surface.material.is_valid()) {
+				RS::get_singleton()->mesh_surface_set_material(mesh, i, surface.material->get_rid());
+			}
+		}
+
+		RID instance = RS::get_singleton()->instance_create();
+		RS::get_singleton()->instance_set_base(instance, mesh);
+
+		if (is_inside_tree()) {
+			RS::get_singleton()->instance_set_scenario(instance, get_world_3d()->get_scenario());
+			RS::get_singleton()->instance_set_transform(instance, get_global_transform());
+		}
+
+		mmi.multimesh = mesh;
+		mmi.instance = instance;
+
+		g.multimesh_instances.push_back(mmi);
+	}
+
 	if (col_debug.size()) {
 		Array arr;
 		arr.resize(RS::ARRAY_MAX);
@@ -704,6 +749,9 @@ void GridMap::_notification(int p_what) {
 		case NOTIFICATION_VISIBILITY_CHANGED: {
 			_update_visibility();
 		} break;
+		case NOTIFICATION_INTERNAL_PROCESS: {
+			_update_octants_callback();
+		} break;
 	}
 }
 
@@ -767,15 +815,242 @@ void GridMap::resource_changed(const RES &p_res) {
 	_recreate_octant_data();
 }
 
+void GridMap::_octant_build_merged_mesh(uint32_t p_index, OctantMeshBuild *p_builds) {
+	OctantMeshBuild &build = p_builds[p_index];
+	const Octant &g = *octant_map.find(build.key)->get();
+
+	// One merged surface per material and vertex format.
+	struct MergedSurface {
+		Ref<Material> material;
+		uint32_t format = 0;
+		LocalVector<Vector3> vertices;
+		LocalVector<Vector3> normals;
+		LocalVector<float> tangents;
+		LocalVector<Color> colors;
+		LocalVector<Vector2> uvs;
+		LocalVector<Vector2> uv2s;
+		LocalVector<int> indices;
+	};
+	LocalVector<MergedSurface> merged;
+
+	Vector3 ofs = _get_offset();
+
+	for (Set<IndexKey>::Element *E = g.cells.front(); E; E = E->next()) {
+		const Map<IndexKey, Cell>::Element *C = cell_map.find(E->get());
+		if (!C) {
+			continue;
+		}
+		const Map<int, Vector<ItemSurface>>::Element *S = build.item_surfaces->find(C->get().item);
+		if (!S) {
+			continue;
+		}
+
+		Vector3 cellpos = Vector3(E->get().x, E->get().y, E->get().z);
+
+		Transform3D xform;
+		xform.basis.set_orthogonal_index(C->get().rot);
+		xform.set_origin(cellpos * cell_size + ofs);
+		xform.basis.scale(Vector3(cell_scale, cell_scale, cell_scale));
+		xform = xform * mesh_library->get_item_mesh_transform(C->get().item);
+
+		for (int i = 0; i < S->get().size(); i++) {
+			const ItemSurface &item_surface = S->get()[i];
+
+			MergedSurface *ms = nullptr;
+			for (uint32_t j = 0; j < merged.size(); j++) {
+				if (merged[j].material == item_surface.material && merged[j].format == item_surface.format) {
+					ms = &merged[j];
+					break;
+				}
+			}
+			if (!ms) {
+				merged.resize(merged.size() + 1);
+				ms = &merged[merged.size() - 1];
+				ms->material = item_surface.material;
+				ms->format = item_surface.format;
+			}
+
+			const Array &arrays = item_surface.arrays;
+			Vector<Vector3> vertices = arrays[RS::ARRAY_VERTEX];
+			int base = ms->vertices.size();
+			for (int j = 0; j < vertices.size(); j++) {
+				ms->vertices.push_back(xform.xform(vertices[j]));
+			}
+			if (ms->format & MERGE_FORMAT_NORMAL) {
+				Vector<Vector3> normals = arrays[RS::ARRAY_NORMAL];
+				for (int j = 0; j < normals.size(); j++) {
+					ms->normals.push_back(xform.basis.xform(normals[j]).normalized());
+				}
+			}
+			if (ms->format & MERGE_FORMAT_TANGENT) {
+				Vector<float> tangents = arrays[RS::ARRAY_TANGENT];
+				for (int j = 0; j < tangents.size() / 4; j++) {
+					Vector3 tangent = xform.basis.xform(Vector3(tangents[j * 4 + 0], tangents[j * 4 + 1], tangents[j * 4 + 2])).normalized();
+					ms->tangents.push_back(tangent.x);
+					ms->tangents.push_back(tangent.y);
+					ms->tangents.push_back(tangent.z);
+					ms->tangents.push_back(tangents[j * 4 + 3]);
+				}
+			}
+			if (ms->format & MERGE_FORMAT_COLOR) {
+				Vector<Color> colors = arrays[RS::ARRAY_COLOR];
+				for (int j = 0; j < colors.size(); j++) {
+					ms->colors.push_back(colors[j]);
+				}
+			}
+			if (ms->format & MERGE_FORMAT_TEX_UV) {
+				Vector<Vector2> uvs = arrays[RS::ARRAY_TEX_UV];
+				for (int j = 0; j < uvs.size(); j++) {
+					ms->uvs.push_back(uvs[j]);
+				}
+			}
+			if (ms->format & MERGE_FORMAT_TEX_UV2) {
+				Vector<Vector2> uv2s = arrays[RS::ARRAY_TEX_UV2];
+				for (int j = 0; j < uv2s.size(); j++) {
+					ms->uv2s.push_back(uv2s[j]);
+				}
+			}
+
+			Vector<int> indices = arrays[RS::ARRAY_INDEX];
+			if (indices.size()) {
+				for (int j = 0; j < indices.size(); j++) {
+					ms->indices.push_back(base + indices[j]);
+				}
+			} else {
+				for (int j = 0; j < vertices.size(); j++) {
+					ms->indices.push_back(base + j);
+				}
+			}
+		}
+	}
+
+	build.surfaces.resize(merged.size());
+	for (uint32_t i = 0; i < merged.size(); i++) {
+		MergedSurface &ms = merged[i];
+		OctantMeshBuild::Surface &surface = build.surfaces[i];
+		surface.material = ms.material;
+
+		surface.arrays.resize(RS::ARRAY_MAX);
+		surface.arrays[RS::ARRAY_VERTEX] = Variant(ms.vertices);
+		if (ms.format & MERGE_FORMAT_NORMAL) {
+			surface.arrays[RS::ARRAY_NORMAL] = Variant(ms.normals);
+		}
+		if (ms.format & MERGE_FORMAT_TANGENT) {
+			surface.arrays[RS::ARRAY_TANGENT] = Variant(ms.tangents);
+		}
+		if (ms.format & MERGE_FORMAT_COLOR) {
+			surface.arrays[RS::ARRAY_COLOR] = Variant(ms.colors);
+		}
+		if (ms.format & MERGE_FORMAT_TEX_UV) {
+			surface.arrays[RS::ARRAY_TEX_UV] = Variant(ms.uvs);
+		}
+		if (ms.format & MERGE_FORMAT_TEX_UV2) {
+			surface.arrays[RS::ARRAY_TEX_UV2] = Variant(ms.uv2s);
+		}
+		surface.arrays[RS::ARRAY_INDEX] = Variant(ms.indices);
+
+		// LODs through meshoptimizer, halving the index count until the simplifier stops making progress.
+		if (!SurfaceTool::simplify_func || !SurfaceTool::simplify_scale_func || ms.indices.size() < 24) {
+			continue;
+		}
+
+		LocalVector<float> positions;
+		positions.resize(ms.vertices.size() * 3);
+		for (uint32_t j = 0; j < ms.vertices.size(); j++) {
+			positions[j * 3 + 0] = ms.vertices[j].x;
+			positions[j * 3 + 1] = ms.vertices[j].y;
+			positions[j * 3 + 2] = ms.vertices[j].z;
+		}
+
+		float scale = SurfaceTool::simplify_scale_func(positions.ptr(), ms.vertices.size(), sizeof(float) * 3);
+		uint32_t last_index_count = ms.indices.size();
+		uint32_t index_target = last_index_count / 2;
+		while (index_target >= 12) {
+			Vector<int> lod;
+			lod.resize(ms.indices.size());
+			float error = 0.0;
+			uint32_t index_count = SurfaceTool::simplify_func((unsigned int *)lod.ptrw(), (const unsigned int *)ms.indices.ptr(), ms.indices.size(), positions.ptr(), ms.vertices.size(), sizeof(float) * 3, index_target, FLT_MAX, &error);
+			if (index_count == 0 || index_count >= last_index_count * 0.75) {
+				break;
+			}
+
+			lod.resize(index_count);
+			surface.lods[MAX(error * scale, CMP_EPSILON2)] = lod;
+			last_index_count = index_count;
+			index_target = index_count / 2;
+		}
+	}
+}
+
 void GridMap::_update_octants_callback() {
 	if (!awaiting_update) {
 		return;
 	}
 
-	List<OctantKey> to_delete;
+	LocalVector<OctantKey> dirty_octants;
+	bool throttled = false;
 	for (const KeyValue<OctantKey, Octant *> &E : octant_map) {
-		if (_octant_update(E.key)) {
-			to_delete.push_back(E.key);
+		if (!E.value->dirty) {
+			continue;
+		}
+		if (octant_max_updates_per_frame > 0 && (int)dirty_octants.size() >= octant_max_updates_per_frame) {
+			throttled = true;
+			break;
+		}
+		dirty_octants.push_back(E.key);
+	}
+
+	// Merge the octant meshes on worker threads, everything touching the servers is then done here.
+	LocalVector<OctantMeshBuild> mesh_builds;
+	Map<int, Vector<ItemSurface>> item_surfaces;
+	if (octant_merge_meshes && baked_meshes.size() == 0 && mesh_library.is_valid()) {
+		mesh_builds.resize(dirty_octants.size());
+		for (uint32_t i = 0; i < dirty_octants.size(); i++) {
+			mesh_builds[i].key = dirty_octants[i];
+			mesh_builds[i].item_surfaces = &item_surfaces;
+
+			const Octant &g = *octant_map[dirty_octants[i]];
+			for (Set<IndexKey>::Element *E = g.cells.front(); E; E = E->next()) {
+				const Map<IndexKey, Cell>::Element *C = cell_map.find(E->get());
+				if (!C || item_surfaces.has(C->get().item) || !mesh_library->has_item(C->get().item)) {
+					continue;
+				}
+
+				Vector<ItemSurface> &surfaces = item_surfaces[C->get().item];
+				Ref<Mesh> mesh = mesh_library->get_item_mesh(C->get().item);
+				if (mesh.is_null()) {
+					continue;
+				}
+				for (int j = 0; j < mesh->get_surface_count(); j++) {
+					if (mesh->surface_get_primitive_type(j) != Mesh::PRIMITIVE_TRIANGLES) {
+						continue;
+					}
+
+					ItemSurface surface;
+					surface.arrays = mesh->surface_get_arrays(j);
+					surface.material = mesh->surface_get_material(j);
+					surface.format |= Variant(surface.arrays[RS::ARRAY_NORMAL]).booleanize() ? MERGE_FORMAT_NORMAL : 0;
+					surface.format |= Variant(surface.arrays[RS::ARRAY_TANGENT]).booleanize() ? MERGE_FORMAT_TANGENT : 0;
+					surface.format |= Variant(surface.arrays[RS::ARRAY_COLOR]).booleanize() ? MERGE_FORMAT_COLOR : 0;
+					surface.format |= Variant(surface.arrays[RS::ARRAY_TEX_UV]).booleanize() ? MERGE_FORMAT_TEX_UV : 0;
+					surface.format |= Variant(surface.arrays[RS::ARRAY_TEX_UV2]).booleanize() ? MERGE_FORMAT_TEX_UV2 : 0;
+					surfaces.push_back(surface);
+				}
+			}
+		}
+
+		if (mesh_builds.size() > 1) {
+			WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GridMap::_octant_build_merged_mesh, mesh_builds.ptr(), mesh_builds.size());
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		} else if (mesh_builds.size() == 1) {
+			_octant_build_merged_mesh(0, mesh_builds.ptr());
+		}
+	}
+
+	List<OctantKey> to_delete;
+	for (uint32_t i = 0; i < dirty_octants.size(); i++) {
+		if (_octant_update(dirty_octants[i], mesh_builds.size() ? &mesh_builds[i] : nullptr)) {
+			to_delete.push_back(dirty_octants[i]);
 		}
 	}
 
@@ -785,7 +1060,10 @@ void GridMap::_update_octants_callback() {
 	}
 
 	_update_visibility();
-	awaiting_update = false;
+
+	// Keep updating the remaining octants on the next frames.
+	awaiting_update = throttled;
+	set_process_internal(throttled);
 }
 
 void GridMap::_bind_methods() {
@@ -826,6 +1104,12 @@ void GridMap::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("world_to_map", "world_position"), &GridMap::world_to_map);
 	ClassDB::bind_method(D_METHOD("map_to_world", "map_position"), &GridMap::map_to_world);
 
+	ClassDB::bind_method(D_METHOD("set_octant_merge_meshes", "enable"), &GridMap::set_octant_merge_meshes);
+	ClassDB::bind_method(D_METHOD("is_octant_merge_meshes_enabled"), &GridMap::is_octant_merge_meshes_enabled);
+
+	ClassDB::bind_method(D_METHOD("set_octant_max_updates_per_frame", "count"), &GridMap::set_octant_max_updates_per_frame);
+	ClassDB::bind_method(D_METHOD("get_octant_max_updates_per_frame"), &GridMap::get_octant_max_updates_per_frame);
+
 	ClassDB::bind_method(D_METHOD("_update_octants_callback"), &GridMap::_update_octants_callback);
 	ClassDB::bind_method(D_METHOD("resource_changed", "resource"), &GridMap::resource_changed);
 
@@ -857,6 +1141,9 @@ void GridMap::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "cell_center_y"), "set_center_y", "get_center_y");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "cell_center_z"), "set_center_z", "get_center_z");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cell_scale"), "set_cell_scale", "get_cell_scale");
+	ADD_GROUP("Octant", "octant_");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "octant_merge_meshes"), "set_octant_merge_meshes", "is_octant_merge_meshes_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "octant_max_updates_per_frame", PROPERTY_HINT_RANGE, "0,1024,1,or_greater"), "set_octant_max_updates_per_frame", "get_octant_max_updates_per_frame");
 	ADD_GROUP("Collision", "collision_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_layer", PROPERTY_HINT_LAYERS_3D_PHYSICS), "set_collision_layer", "get_collision_layer");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_mask", PROPERTY_HINT_LAYERS_3D_PHYSICS), "set_collision_mask", "get_collision_mask");
@@ -94,7 +94,7 @@ class GridMap : public Node3D {
 
 		struct MultimeshInstance {
 			RID instance;
-			RID multimesh;
+			RID multimesh; // Or the merged mesh, when merging octant meshes.
 			struct Item {
 				int index = 0;
 				Transform3D transform;
@@ -173,14 +173,46 @@ class GridMap : public Node3D {
 		return Vector3(p_key.x, p_key.y, p_key.z) * cell_size * octant_size;
 	}
 
+	// Triangle surfaces of the MeshLibrary items, fetched on the main thread so octants can be merged on worker threads.
+	struct ItemSurface {
+		Array arrays;
+		Ref<Material> material;
+		uint32_t format = 0;
+	};
+
+	enum {
+		MERGE_FORMAT_NORMAL = 1,
+		MERGE_FORMAT_TANGENT = 2,
+		MERGE_FORMAT_COLOR = 4,
+		MERGE_FORMAT_TEX_UV = 8,
+		MERGE_FORMAT_TEX_UV2 = 16,
+	};
+
+	struct OctantMeshBuild {
+		struct Surface {
+			Ref<Material> material;
+			Array arrays;
+			Dictionary lods;
+		};
+
+		OctantKey key;
+		const Map<int, Vector<ItemSurface>> *item_surfaces = nullptr;
+		LocalVector<Surface> surfaces;
+	};
+
+	void _octant_build_merged_mesh(uint32_t p_index, OctantMeshBuild *p_builds);
+
 	void _reset_physic_bodies_collision_filters();
 	void _octant_enter_world(const OctantKey &p_key);
 	void _octant_exit_world(const OctantKey &p_key);
-	bool _octant_update(const OctantKey &p_key);
+	bool _octant_update(const OctantKey &p_key, const OctantMeshBuild *p_mesh_build = nullptr);
 	void _octant_clean_up(const OctantKey &p_key);
 	void _octant_transform(const OctantKey &p_key);
 	bool awaiting_update = false;
 
+	bool octant_merge_meshes = false;
+	int octant_max_updates_per_frame = 0;
+
 	void _queue_octants_dirty();
 	void _update_octants_callback();
 
@@ -229,6 +261,12 @@ public:
 	void set_navigation_layers(uint32_t p_layers);
 	uint32_t get_navigation_layers();
 
+	void set_octant_merge_meshes(bool p_enable);
+	bool is_octant_merge_meshes_enabled() const;
+
+	void set_octant_max_updates_per_frame(int p_count);
+	int get_octant_max_updates_per_frame() const;
+
 	void set_mesh_library(const Ref<MeshLibrary> &p_mesh_library);
 	Ref<MeshLibrary> get_mesh_library() const;
 
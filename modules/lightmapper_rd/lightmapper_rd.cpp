@@ -31,6 +31,7 @@
 #include "lightmapper_rd.h"
 #include "core/config/project_settings.h"
 #include "core/math/geometry_2d.h"
+#include "core/os/worker_thread_pool.h"
 #include "lm_blendseams.glsl.gen.h"
 #include "lm_compute.glsl.gen.h"
 #include "lm_raster.glsl.gen.h"
@@ -666,6 +667,32 @@ LightmapperRD::BakeError LightmapperRD::_dilate(RenderingDevice *rd, Ref<RDShade
 	return BAKE_OK;
 }
 
+void LightmapperRD::_denoise_layer(uint32_t p_index, DenoiseData *p_data) {
+	Vector<uint8_t> s = p_data->layers[p_index];
+	Ref<Image> img;
+	img.instantiate();
+	img->create(p_data->atlas_size.width, p_data->atlas_size.height, false, Image::FORMAT_RGBAH, s);
+
+	Ref<Image> denoised = p_data->denoiser->denoise_image(img);
+	if (denoised == img) {
+		p_data->layers.write[p_index].clear(); // Failed, keep the layer as is.
+		return;
+	}
+
+	denoised->convert(Image::FORMAT_RGBAH);
+	Vector<uint8_t> ds = denoised->get_data();
+	denoised.unref(); //avoid copy on write
+	{ //restore alpha
+		uint32_t count = s.size() / 2; //uint16s
+		const uint16_t *src = (const uint16_t *)s.ptr();
+		uint16_t *dst = (uint16_t *)ds.ptrw();
+		for (uint32_t j = 0; j < count; j += 4) {
+			dst[j + 3] = src[j + 3];
+		}
+	}
+	p_data->layers.write[p_index] = ds;
+}
+
 LightmapperRD::BakeError LightmapperRD::bake(BakeQuality p_quality, bool p_use_denoiser, int p_bounces, float p_bias, int p_max_texture_size, bool p_bake_sh, GenerateProbes p_generate_probes, const Ref<Image> &p_environment_panorama, const Basis &p_environment_transform, BakeStepFunc p_step_function, void *p_bake_userdata) {
 	if (p_step_function) {
 		p_step_function(0.0, TTR("Begin Bake"), p_bake_userdata, true);
@@ -706,18 +733,27 @@ LightmapperRD::BakeError LightmapperRD::bake(BakeQuality p_quality, bool p_use_d
 	RID light_accum_tex2;
 	RID light_primary_dynamic_tex;
 	RID light_environment_tex;
+	RID bounce_variance_tex;
+
+#define FREE_TEXTURES                     \
+	rd->free(albedo_array_tex);           \
+	rd->free(emission_array_tex);         \
+	rd->free(normal_tex);                 \
+	rd->free(position_tex);               \
+	rd->free(unocclude_tex);              \
+	rd->free(light_source_tex);           \
+	rd->free(light_accum_tex2);           \
+	rd->free(light_accum_tex);            \
+	rd->free(light_primary_dynamic_tex);  \
+	rd->free(light_environment_tex);      \
+	if (bounce_variance_tex.is_valid()) { \
+		rd->free(bounce_variance_tex);    \
+	}
 
-#define FREE_TEXTURES                    \
-	rd->free(albedo_array_tex);          \
-	rd->free(emission_array_tex);        \
-	rd->free(normal_tex);                \
-	rd->free(position_tex);              \
-	rd->free(unocclude_tex);             \
-	rd->free(light_source_tex);          \
-	rd->free(light_accum_tex2);          \
-	rd->free(light_accum_tex);           \
-	rd->free(light_primary_dynamic_tex); \
-	rd->free(light_environment_tex);
+	// Indirect light rays stop early on texels where the average has converged. Directional
+	// lightmaps weight every ray into the SH coefficients by the full ray count, so they can't.
+	float adaptive_noise_threshold = GLOBAL_GET("rendering/lightmapping/bake_quality/adaptive_noise_threshold");
+	bool use_adaptive_sampling = !p_bake_sh && adaptive_noise_threshold > 0.0;
 
 	{ // create all textures
 
@@ -749,6 +785,11 @@ LightmapperRD::BakeError LightmapperRD::bake(BakeQuality p_quality, bool p_use_d
 		position_tex = rd->texture_create(tf, RD::TextureView());
 		unocclude_tex = rd->texture_create(tf, RD::TextureView());
 
+		if (use_adaptive_sampling) {
+			tf.format = RD::DATA_FORMAT_R32_SFLOAT;
+			bounce_variance_tex = rd->texture_create(tf, RD::TextureView());
+		}
+
 		tf.format = RD::DATA_FORMAT_R16G16B16A16_SFLOAT;
 		tf.usage_bits = RD::TEXTURE_USAGE_COLOR_ATTACHMENT_BIT | RD::TEXTURE_USAGE_SAMPLING_BIT | RD::TEXTURE_USAGE_STORAGE_BIT | RD::TEXTURE_USAGE_CAN_COPY_FROM_BIT | RD::TEXTURE_USAGE_CAN_COPY_TO_BIT | RD::TEXTURE_USAGE_CAN_UPDATE_BIT;
 
@@ -973,7 +1014,14 @@ LightmapperRD::BakeError LightmapperRD::bake(BakeQuality p_quality, bool p_use_d
 
 	Ref<RDShaderFile> compute_shader;
 	compute_shader.instantiate();
-	err = compute_shader->parse_versions_from_text(lm_compute_shader_glsl, p_bake_sh ? "\n#define USE_SH_LIGHTMAPS\n" : "");
+	String compute_defines;
+	if (p_bake_sh) {
+		compute_defines += "\n#define USE_SH_LIGHTMAPS\n";
+	}
+	if (use_adaptive_sampling) {
+		compute_defines += "\n#define USE_ADAPTIVE_SAMPLING\n#define ADAPTIVE_NOISE_THRESHOLD " + rtos(adaptive_noise_threshold) + "\n";
+	}
+	err = compute_shader->parse_versions_from_text(lm_compute_shader_glsl, compute_defines);
 	if (err != OK) {
 		FREE_TEXTURES
 		FREE_BUFFERS
@@ -1011,6 +1059,17 @@ LightmapperRD::BakeError LightmapperRD::bake(BakeQuality p_quality, bool p_use_d
 	rd->free(compute_shader_secondary); \
 	rd->free(compute_shader_light_probes);
 
+// Step functions return true once the user cancels the bake.
+#define RETURN_IF_ABORTED(m_aborted)    \
+	if (m_aborted) {                    \
+		FREE_TEXTURES                   \
+		FREE_BUFFERS                    \
+		FREE_RASTER_RESOURCES           \
+		FREE_COMPUTE_RESOURCES          \
+		memdelete(rd);                  \
+		return BAKE_ERROR_USER_ABORTED; \
+	}
+
 	PushConstant push_constant;
 	{
 		//set defaults
@@ -1225,6 +1284,13 @@ LightmapperRD::BakeError LightmapperRD::bake(BakeQuality p_quality, bool p_use_d
 				u.ids.push_back(light_environment_tex);
 				uniforms.push_back(u);
 			}
+			if (use_adaptive_sampling) {
+				RD::Uniform u;
+				u.uniform_type = RD::UNIFORM_TYPE_IMAGE;
+				u.binding = 7;
+				u.ids.push_back(bounce_variance_tex);
+				uniforms.push_back(u);
+			}
 		}
 
 		RID secondary_uniform_set[2];
@@ -1302,7 +1368,7 @@ LightmapperRD::BakeError LightmapperRD::bake(BakeQuality p_quality, bool p_use_d
 								int total = (atlas_slices * x_regions * y_regions * ray_iterations);
 								int percent = count * 100 / total;
 								float p = float(count) / total * 0.1;
-								p_step_function(0.6 + p, vformat(TTR("Bounce %d/%d: Integrate indirect lighting %d%%"), b + 1, p_bounces, percent), p_bake_userdata, false);
+								RETURN_IF_ABORTED(p_step_function(0.6 + p, vformat(TTR("Bounce %d/%d: Integrate indirect lighting %d%%"), b + 1, p_bounces, percent), p_bake_userdata, false));
 							}
 						}
 					}
@@ -1402,7 +1468,10 @@ LightmapperRD::BakeError LightmapperRD::bake(BakeQuality p_quality, bool p_use_d
 			if (p_step_function) {
 				int percent = i * 100 / ray_iterations;
 				float p = float(i) / ray_iterations * 0.1;
-				p_step_function(0.7 + p, vformat(TTR("Integrating light probes %d%%"), percent), p_bake_userdata, false);
+				if (p_step_function(0.7 + p, vformat(TTR("Integrating light probes %d%%"), percent), p_bake_userdata, false)) {
+					rd->free(light_probe_buffer);
+					RETURN_IF_ABORTED(true);
+				}
 			}
 		}
 
@@ -1438,31 +1507,38 @@ LightmapperRD::BakeError LightmapperRD::bake(BakeQuality p_quality, bool p_use_d
 
 	if (p_use_denoiser) {
 		if (p_step_function) {
-			p_step_function(0.8, TTR("Denoising"), p_bake_userdata, true);
+			if (p_step_function(0.8, TTR("Denoising"), p_bake_userdata, true)) {
+				if (light_probe_buffer.is_valid()) {
+					rd->free(light_probe_buffer);
+				}
+				RETURN_IF_ABORTED(true);
+			}
 		}
 
 		Ref<LightmapDenoiser> denoiser = LightmapDenoiser::create();
 		if (denoiser.is_valid()) {
-			for (int i = 0; i < atlas_slices * (p_bake_sh ? 4 : 1); i++) {
-				Vector<uint8_t> s = rd->texture_get_data(light_accum_tex, i);
-				Ref<Image> img;
-				img.instantiate();
-				img->create(atlas_size.width, atlas_size.height, false, Image::FORMAT_RGBAH, s);
-
-				Ref<Image> denoised = denoiser->denoise_image(img);
-				if (denoised != img) {
-					denoised->convert(Image::FORMAT_RGBAH);
-					Vector<uint8_t> ds = denoised->get_data();
-					denoised.unref(); //avoid copy on write
-					{ //restore alpha
-						uint32_t count = s.size() / 2; //uint16s
-						const uint16_t *src = (const uint16_t *)s.ptr();
-						uint16_t *dst = (uint16_t *)ds.ptrw();
-						for (uint32_t j = 0; j < count; j += 4) {
-							dst[j + 3] = src[j + 3];
-						}
-					}
-					rd->texture_update(light_accum_tex, i, ds);
+			// Layers are denoised whole (tiles would show seams), each layer on its own thread.
+			DenoiseData data;
+			data.denoiser = denoiser.ptr();
+			data.atlas_size = atlas_size;
+			int layer_count = atlas_slices * (p_bake_sh ? 4 : 1);
+			for (int i = 0; i < layer_count; i++) {
+				data.layers.push_back(rd->texture_get_data(light_accum_tex, i));
+			}
+
+			WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+			if (layer_count == 1 || !pool || pool->get_thread_count() == 0) {
+				for (int i = 0; i < layer_count; i++) {
+					_denoise_layer(i, &data);
+				}
+			} else {
+				WorkerThreadPool::GroupID group = pool->add_template_group_task(this, &LightmapperRD::_denoise_layer, &data, layer_count);
+				pool->wait_for_group_task_completion(group);
+			}
+
+			for (int i = 0; i < layer_count; i++) {
+				if (!data.layers[i].is_empty()) {
+					rd->texture_update(light_accum_tex, i, data.layers[i]);
 				}
 			}
 		}
@@ -60,6 +60,9 @@ layout(rgba16f, set = 1, binding = 4) uniform restrict image2DArray accum_light;
 #ifdef MODE_BOUNCE_LIGHT
 layout(rgba32f, set = 1, binding = 5) uniform restrict image2DArray bounce_accum;
 layout(set = 1, binding = 6) uniform texture2D environment;
+#ifdef USE_ADAPTIVE_SAMPLING
+layout(r32f, set = 1, binding = 7) uniform restrict image2DArray bounce_variance; // Sum of squared ray luminances.
+#endif
 #endif
 #ifdef MODE_DIRECT_LIGHT
 layout(rgba32f, set = 1, binding = 5) uniform restrict writeonly image2DArray primary_dynamic;
@@ -246,6 +249,31 @@ vec3 vogel_hemisphere(uint p_index, uint p_count, float p_offset) {
 	return vec3(l * cos(theta), l * sin(theta), y);
 }
 
+#ifdef USE_ADAPTIVE_SAMPLING
+
+#define ADAPTIVE_MIN_RAYS 16.0 // Don't trust the variance of fewer rays.
+
+// Rays are traced with a stride coprime to the ray count, so every pass covers the whole
+// hemisphere and the rays traced before stopping early are still a good estimate.
+uint get_ray_stride(uint p_count) {
+	uint stride = uint(float(p_count) * 0.618034) | 1;
+	while (true) {
+		uint a = stride;
+		uint b = p_count;
+		while (b != 0) {
+			uint t = a % b;
+			a = b;
+			b = t;
+		}
+		if (a == 1) {
+			return stride;
+		}
+		stride += 2;
+	}
+}
+
+#endif
+
 float quick_hash(vec2 pos) {
 	return fract(sin(dot(pos * 19.19, vec2(49.5791, 97.413))) * 49831.189237);
 }
@@ -404,8 +432,33 @@ void main() {
 #endif
 	vec3 light_average = vec3(0.0);
 	float active_rays = 0.0;
-	for (uint i = params.ray_from; i < params.ray_to; i++) {
-		vec3 ray_dir = normal_mat * vogel_hemisphere(i, params.ray_count, quick_hash(vec2(atlas_pos)));
+	uint ray_to = params.ray_to;
+
+#ifdef USE_ADAPTIVE_SAMPLING
+	const vec3 luminance_weights = vec3(0.2126, 0.7152, 0.0722);
+	float luminance_sq = 0.0;
+	uint ray_stride = get_ray_stride(params.ray_count);
+
+	if (params.ray_from > 0) {
+		// Stop tracing once the standard error of the average is small enough.
+		vec4 accum = imageLoad(bounce_accum, ivec3(atlas_pos, params.atlas_slice));
+		if (accum.a >= ADAPTIVE_MIN_RAYS) {
+			float mean = dot(accum.rgb, luminance_weights) / accum.a;
+			float variance = max(imageLoad(bounce_variance, ivec3(atlas_pos, params.atlas_slice)).r / accum.a - mean * mean, 0.0);
+			if (sqrt(variance / accum.a) <= ADAPTIVE_NOISE_THRESHOLD * max(mean, 0.001)) {
+				ray_to = params.ray_from;
+			}
+		}
+	}
+#endif
+
+	for (uint i = params.ray_from; i < ray_to; i++) {
+#ifdef USE_ADAPTIVE_SAMPLING
+		uint ray_index = (i * ray_stride) % params.ray_count;
+#else
+		uint ray_index = i;
+#endif
+		vec3 ray_dir = normal_mat * vogel_hemisphere(ray_index, params.ray_count, quick_hash(vec2(atlas_pos)));
 
 		uint tidx;
 		vec3 barycentric;
@@ -441,6 +494,10 @@ void main() {
 		}
 
 		light_average += light;
+#ifdef USE_ADAPTIVE_SAMPLING
+		float luminance = dot(light, luminance_weights);
+		luminance_sq += luminance * luminance;
+#endif
 
 #ifdef USE_SH_LIGHTMAPS
 
@@ -464,6 +521,9 @@ void main() {
 		vec4 accum = imageLoad(bounce_accum, ivec3(atlas_pos, params.atlas_slice));
 		light_total = accum.rgb;
 		active_rays += accum.a;
+#ifdef USE_ADAPTIVE_SAMPLING
+		luminance_sq += imageLoad(bounce_variance, ivec3(atlas_pos, params.atlas_slice)).r;
+#endif
 	}
 
 	light_total += light_average;
@@ -489,6 +549,9 @@ void main() {
 #endif
 	} else {
 		imageStore(bounce_accum, ivec3(atlas_pos, params.atlas_slice), vec4(light_total, active_rays));
+#ifdef USE_ADAPTIVE_SAMPLING
+		imageStore(bounce_variance, ivec3(atlas_pos, params.atlas_slice), vec4(luminance_sq));
+#endif
 	}
 
 #endif
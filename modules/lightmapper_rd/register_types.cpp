@@ -45,6 +45,8 @@ void register_lightmapper_rd_types() {
 	GLOBAL_DEF("rendering/lightmapping/bake_quality/medium_quality_ray_count", 64);
 	GLOBAL_DEF("rendering/lightmapping/bake_quality/high_quality_ray_count", 256);
 	GLOBAL_DEF("rendering/lightmapping/bake_quality/ultra_quality_ray_count", 1024);
+	GLOBAL_DEF("rendering/lightmapping/bake_quality/adaptive_noise_threshold", 0.02);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/lightmapping/bake_quality/adaptive_noise_threshold", PropertyInfo(Variant::FLOAT, "rendering/lightmapping/bake_quality/adaptive_noise_threshold", PROPERTY_HINT_RANGE, "0,0.2,0.001"));
 	GLOBAL_DEF("rendering/lightmapping/bake_performance/max_rays_per_pass", 32);
 	GLOBAL_DEF("rendering/lightmapping/bake_performance/region_size", 512);
 
@@ -42,6 +42,9 @@ void SSLContextMbedTLS::print_mbedtls_error(int p_ret) {
 	fflush(stdout);
 }
 
+Mutex SSLContextMbedTLS::session_cache_mutex;
+HashMap<String, mbedtls_ssl_session *> SSLContextMbedTLS::session_cache;
+
 /// CookieContextMbedTLS
 
 Error CookieContextMbedTLS::setup() {
@@ -198,6 +201,54 @@ void SSLContextMbedTLS::clear() {
 	inited = false;
 }
 
+void SSLContextMbedTLS::resume_session(const String &p_key) {
+	ERR_FAIL_COND(!inited);
+
+	MutexLock lock(session_cache_mutex);
+	mbedtls_ssl_session **session = session_cache.getptr(p_key);
+	if (session) {
+		// Copies the session, the server decides whether it can be resumed or a full handshake is needed.
+		mbedtls_ssl_set_session(&ssl, *session);
+	}
+}
+
+void SSLContextMbedTLS::store_session(const String &p_key) {
+	ERR_FAIL_COND(!inited);
+
+	mbedtls_ssl_session *session = (mbedtls_ssl_session *)memalloc(sizeof(mbedtls_ssl_session));
+	mbedtls_ssl_session_init(session);
+	if (mbedtls_ssl_get_session(&ssl, session) != 0) {
+		mbedtls_ssl_session_free(session);
+		memfree(session);
+		return;
+	}
+
+	MutexLock lock(session_cache_mutex);
+	mbedtls_ssl_session **prev = session_cache.getptr(p_key);
+	if (prev) {
+		mbedtls_ssl_session_free(*prev);
+		memfree(*prev);
+		*prev = session;
+		return;
+	}
+	if (session_cache.size() >= SESSION_CACHE_MAX) {
+		// Not worth tracking usage for this, just start over.
+		clear_session_cache();
+	}
+	session_cache[p_key] = session;
+}
+
+void SSLContextMbedTLS::clear_session_cache() {
+	MutexLock lock(session_cache_mutex);
+	const String *k = nullptr;
+	while ((k = session_cache.next(k))) {
+		mbedtls_ssl_session *session = session_cache[*k];
+		mbedtls_ssl_session_free(session);
+		memfree(session);
+	}
+	session_cache.clear();
+}
+
 mbedtls_ssl_context *SSLContextMbedTLS::get_context() {
 	ERR_FAIL_COND_V(!inited, nullptr);
 	return &ssl;
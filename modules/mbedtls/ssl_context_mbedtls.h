@@ -36,6 +36,8 @@
 #include "core/io/file_access.h"
 
 #include "core/object/ref_counted.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
 
 #include <mbedtls/config.h>
 #include <mbedtls/ctr_drbg.h>
@@ -65,8 +67,16 @@ public:
 
 class SSLContextMbedTLS : public RefCounted {
 protected:
+	enum {
+		SESSION_CACHE_MAX = 64,
+	};
+
 	bool inited = false;
 
+	// Sessions of past client handshakes by connection key, to resume them when connecting again.
+	static Mutex session_cache_mutex;
+	static HashMap<String, mbedtls_ssl_session *> session_cache;
+
 	static PackedByteArray _read_file(String p_path);
 
 public:
@@ -86,6 +96,10 @@ public:
 	Error init_client(int p_transport, int p_authmode, Ref<X509CertificateMbedTLS> p_valid_cas);
 	void clear();
 
+	void resume_session(const String &p_key);
+	void store_session(const String &p_key);
+	static void clear_session_cache();
+
 	mbedtls_ssl_context *get_context();
 
 	SSLContextMbedTLS();
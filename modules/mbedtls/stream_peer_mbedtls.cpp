@@ -98,6 +98,10 @@ Error StreamPeerMbedTLS::_do_handshake() {
 		}
 	}
 
+	if (!session_key.is_empty()) {
+		ssl_ctx->store_session(session_key);
+	}
+
 	status = STATUS_CONNECTED;
 	return OK;
 }
@@ -114,6 +118,13 @@ Error StreamPeerMbedTLS::connect_to_stream(Ref<StreamPeer> p_base, bool p_valida
 	mbedtls_ssl_set_hostname(ssl_ctx->get_context(), p_for_hostname.utf8().get_data());
 	mbedtls_ssl_set_bio(ssl_ctx->get_context(), this, bio_send, bio_recv, nullptr);
 
+	// Sessions are only resumed with the same verification settings they were established with.
+	session_key = String();
+	if (!p_for_hostname.is_empty()) {
+		session_key = vformat("%s|%d|%d", p_for_hostname, authmode, p_ca_certs.is_valid() ? (int64_t)p_ca_certs->get_instance_id() : 0);
+		ssl_ctx->resume_session(session_key);
+	}
+
 	status = STATUS_HANDSHAKING;
 
 	if (_do_handshake() != OK) {
@@ -127,6 +138,7 @@ Error StreamPeerMbedTLS::connect_to_stream(Ref<StreamPeer> p_base, bool p_valida
 Error StreamPeerMbedTLS::accept_stream(Ref<StreamPeer> p_base, Ref<CryptoKey> p_key, Ref<X509Certificate> p_cert, Ref<X509Certificate> p_ca_chain) {
 	ERR_FAIL_COND_V(p_base.is_null(), ERR_INVALID_PARAMETER);
 
+	session_key = String();
 	Error err = ssl_ctx->init_server(MBEDTLS_SSL_TRANSPORT_STREAM, MBEDTLS_SSL_VERIFY_NONE, p_key, p_cert);
 	ERR_FAIL_COND_V(err != OK, err);
 
@@ -310,4 +322,5 @@ void StreamPeerMbedTLS::initialize_ssl() {
 void StreamPeerMbedTLS::finalize_ssl() {
 	available = false;
 	_create = nullptr;
+	SSLContextMbedTLS::clear_session_cache();
 }
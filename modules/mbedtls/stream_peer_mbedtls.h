@@ -38,6 +38,7 @@ class StreamPeerMbedTLS : public StreamPeerSSL {
 private:
 	Status status = STATUS_DISCONNECTED;
 	String hostname;
+	String session_key; // Client only, identifies the connection settings in the session cache.
 
 	Ref<StreamPeer> base;
 
@@ -29,6 +29,7 @@
 /*************************************************************************/
 
 #include "register_types.h"
+#include "scene/resources/mesh.h"
 #include "scene/resources/surface_tool.h"
 #include "thirdparty/meshoptimizer/meshoptimizer.h"
 
@@ -38,6 +39,13 @@ void register_meshoptimizer_types() {
 	SurfaceTool::simplify_with_attrib_func = meshopt_simplifyWithAttributes;
 	SurfaceTool::simplify_scale_func = meshopt_simplifyScale;
 	SurfaceTool::simplify_sloppy_func = meshopt_simplifySloppy;
+
+	ArrayMesh::encode_vertex_buffer_bound_func = meshopt_encodeVertexBufferBound;
+	ArrayMesh::encode_vertex_buffer_func = meshopt_encodeVertexBuffer;
+	ArrayMesh::decode_vertex_buffer_func = meshopt_decodeVertexBuffer;
+	ArrayMesh::encode_index_buffer_bound_func = meshopt_encodeIndexBufferBound;
+	ArrayMesh::encode_index_buffer_func = meshopt_encodeIndexBuffer;
+	ArrayMesh::decode_index_buffer_func = meshopt_decodeIndexBuffer;
 }
 
 void unregister_meshoptimizer_types() {
@@ -45,4 +53,11 @@ void unregister_meshoptimizer_types() {
 	SurfaceTool::simplify_func = nullptr;
 	SurfaceTool::simplify_scale_func = nullptr;
 	SurfaceTool::simplify_sloppy_func = nullptr;
+
+	ArrayMesh::encode_vertex_buffer_bound_func = nullptr;
+	ArrayMesh::encode_vertex_buffer_func = nullptr;
+	ArrayMesh::decode_vertex_buffer_func = nullptr;
+	ArrayMesh::encode_index_buffer_bound_func = nullptr;
+	ArrayMesh::encode_index_buffer_func = nullptr;
+	ArrayMesh::decode_index_buffer_func = nullptr;
 }
@@ -40,6 +40,11 @@
 int AudioStreamPlaybackMP3::_mix_internal(AudioFrame *p_buffer, int p_frames) {
 	ERR_FAIL_COND_V(!active, 0);
 
+	if (skip_position >= 0) {
+		// Resume after being skipped by virtual voices.
+		_seek(skip_position);
+	}
+
 	int todo = p_frames;
 
 	int frames_mixed_this_step = p_frames;
@@ -59,7 +64,7 @@ int AudioStreamPlaybackMP3::_mix_internal(AudioFrame *p_buffer, int p_frames) {
 		else {
 			//EOF
 			if (mp3_stream->loop) {
-				seek(mp3_stream->loop_offset);
+				_seek(mp3_stream->loop_offset);
 				loops++;
 			} else {
 				frames_mixed_this_step = p_frames - todo;
@@ -87,6 +92,7 @@ void AudioStreamPlaybackMP3::start(float p_from_pos) {
 }
 
 void AudioStreamPlaybackMP3::stop() {
+	_prefetch_reset();
 	active = false;
 }
 
@@ -99,14 +105,25 @@ int AudioStreamPlaybackMP3::get_loop_count() const {
 }
 
 float AudioStreamPlaybackMP3::get_playback_position() const {
-	return float(frames_mixed) / mp3_stream->sample_rate;
+	if (skip_position >= 0) {
+		return skip_position;
+	}
+	// The decoder runs ahead of what was mixed.
+	return float(MAX(0, int(frames_mixed) - _get_prefetched_frames())) / mp3_stream->sample_rate;
 }
 
 void AudioStreamPlaybackMP3::seek(float p_time) {
+	_prefetch_reset();
+	_seek(p_time);
+}
+
+void AudioStreamPlaybackMP3::_seek(float p_time) {
 	if (!active) {
 		return;
 	}
 
+	skip_position = -1.0;
+
 	if (p_time >= mp3_stream->get_length()) {
 		p_time = 0;
 	}
@@ -115,7 +132,38 @@ void AudioStreamPlaybackMP3::seek(float p_time) {
 	mp3dec_ex_seek(mp3d, (uint64_t)frames_mixed * mp3_stream->channels);
 }
 
+bool AudioStreamPlaybackMP3::can_skip() const {
+	// Streams of unknown length can't be repositioned reliably.
+	return mp3_stream.is_valid() && mp3_stream->get_length() > 0;
+}
+
+void AudioStreamPlaybackMP3::skip(float p_time) {
+	if (!active) {
+		return;
+	}
+
+	// Whatever was decoded ahead was never heard.
+	int dropped = _prefetch_reset();
+
+	// Only the position moves forward here, the actual seek happens once the playback is mixed again.
+	float length = mp3_stream->get_length();
+	float position = MAX(0.0f, get_playback_position() - float(dropped) / mp3_stream->sample_rate) + p_time;
+	if (position >= length) {
+		float loop_length = length - mp3_stream->loop_offset;
+		if (!mp3_stream->loop || loop_length <= 0) {
+			active = false;
+			return;
+		}
+		float overshoot = position - length;
+		loops += 1 + int(overshoot / loop_length);
+		position = mp3_stream->loop_offset + Math::fmod(overshoot, loop_length);
+	}
+	skip_position = position;
+}
+
 AudioStreamPlaybackMP3::~AudioStreamPlaybackMP3() {
+	_prefetch_reset();
+
 	if (mp3d) {
 		mp3dec_ex_close(mp3d);
 		memfree(mp3d);
@@ -144,6 +192,8 @@ Ref<AudioStreamPlayback> AudioStreamMP3::instance_playback() {
 		ERR_FAIL_COND_V(errorcode, Ref<AudioStreamPlaybackMP3>());
 	}
 
+	mp3s->_set_prefetch_enabled(true);
+
 	return mp3s;
 }
 
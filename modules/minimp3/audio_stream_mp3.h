@@ -45,11 +45,14 @@ class AudioStreamPlaybackMP3 : public AudioStreamPlaybackResampled {
 	uint32_t frames_mixed = 0;
 	bool active = false;
 	int loops = 0;
+	float skip_position = -1.0; // Pending seek after being skipped, negative if none.
 
 	friend class AudioStreamMP3;
 
 	Ref<AudioStreamMP3> mp3_stream;
 
+	void _seek(float p_time);
+
 protected:
 	virtual int _mix_internal(AudioFrame *p_buffer, int p_frames) override;
 	virtual float get_stream_sampling_rate() override;
@@ -64,6 +67,9 @@ public:
 	virtual float get_playback_position() const override;
 	virtual void seek(float p_time) override;
 
+	virtual bool can_skip() const override;
+	virtual void skip(float p_time) override;
+
 	AudioStreamPlaybackMP3() {}
 	~AudioStreamPlaybackMP3();
 };
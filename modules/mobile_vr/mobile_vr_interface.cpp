@@ -119,6 +119,15 @@ Basis MobileVRInterface::combine_acc_mag(const Vector3 &p_grav, const Vector3 &p
 	return acc_mag_m3;
 };
 
+Basis MobileVRInterface::apply_gyro(const Basis &p_orientation, const Vector3 &p_gyro, double p_delta_time) {
+	// our gyro gives us our angular velocity around our device axes
+	Basis rotate;
+	rotate.rotate(p_orientation.get_axis(0), p_gyro.x * p_delta_time);
+	rotate.rotate(p_orientation.get_axis(1), p_gyro.y * p_delta_time);
+	rotate.rotate(p_orientation.get_axis(2), p_gyro.z * p_delta_time);
+	return rotate * p_orientation;
+};
+
 void MobileVRInterface::set_position_from_sensors() {
 	_THREAD_SAFE_METHOD_
 
@@ -126,7 +135,8 @@ void MobileVRInterface::set_position_from_sensors() {
 	// 9dof is a misleading marketing term coming from 3 accelerometer axis + 3 gyro axis + 3 magnetometer axis = 9 axis
 	// but in reality this only offers 3 dof (yaw, pitch, roll) orientation
 
-	Basis orientation;
+	// we integrate our sensor data on top of our last known orientation
+	Basis orientation = head_transform.basis;
 
 	uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 	uint64_t ticks_elapsed = ticks - last_ticks;
@@ -174,11 +184,7 @@ void MobileVRInterface::set_position_from_sensors() {
 
 	if (has_gyro) {
 		// start with applying our gyro (do NOT smooth our gyro!)
-		Basis rotate;
-		rotate.rotate(orientation.get_axis(0), gyro.x * delta_time);
-		rotate.rotate(orientation.get_axis(1), gyro.y * delta_time);
-		rotate.rotate(orientation.get_axis(2), gyro.z * delta_time);
-		orientation = rotate * orientation;
+		orientation = apply_gyro(orientation, gyro, delta_time);
 
 		tracking_state = XRInterface::XR_NORMAL_TRACKING;
 	};
@@ -330,6 +336,7 @@ bool MobileVRInterface::initialize() {
 		mag_current_max = Vector3(0, 0, 0);
 		head_transform.basis = Basis();
 		head_transform.origin = Vector3(0.0, eye_height, 0.0);
+		render_head_transform = head_transform;
 
 		// we must create a tracker for our head
 		head.instantiate();
@@ -437,8 +444,8 @@ Transform3D MobileVRInterface::get_transform_for_view(uint32_t p_view, const Tra
 			// should not have any other values..
 		};
 
-		// just scale our origin point of our transform
-		Transform3D _head_transform = head_transform;
+		// just scale our origin point of our transform, our views use the transform we latched right before rendering
+		Transform3D _head_transform = render_head_transform;
 		_head_transform.origin *= world_scale;
 
 		transform_for_eye = p_cam_transform * (xr_server->get_reference_frame()) * _head_transform * transform_for_eye;
@@ -514,9 +521,28 @@ void MobileVRInterface::process() {
 			// Set our head position, note in real space, reference frame and world scale is applied later
 			head->set_pose("default", head_transform, Vector3(), Vector3());
 		}
+
+		render_head_transform = head_transform;
 	};
 };
 
+void MobileVRInterface::pre_render() {
+	_THREAD_SAFE_METHOD_
+
+	if (initialized && has_gyro) {
+		// Our head transform was obtained in process(), before our game logic ran, and it will take a while
+		// before our frame reaches the display. Keep rotating it with our current angular velocity until then.
+		// We don't update our sensor fusion here, process() picks up from head_transform next frame.
+		uint64_t ticks = OS::get_singleton()->get_ticks_usec();
+		uint64_t display_ticks = MAX(XRServer::get_singleton()->get_predicted_display_time_usec(), ticks);
+
+		// don't extrapolate too far ahead, a hitch would throw our view around
+		double delta_time = MIN((double)(display_ticks - last_ticks) / 1000000.0, 0.1);
+
+		render_head_transform.basis = apply_gyro(head_transform.basis, Input::get_singleton()->get_gyroscope(), delta_time).orthonormalized();
+	}
+};
+
 MobileVRInterface::MobileVRInterface() {}
 
 MobileVRInterface::~MobileVRInterface() {
@@ -70,6 +70,7 @@ private:
 	// at a minimum we need a tracker for our head
 	Ref<XRPositionalTracker> head;
 	Transform3D head_transform;
+	Transform3D render_head_transform; // head_transform latched in pre_render, predicted to when our frame will be displayed
 
 	/*
 		logic for processing our sensor data, this was originally in our positional tracker logic but I think
@@ -78,6 +79,7 @@ private:
 	*/
 	Vector3 scale_magneto(const Vector3 &p_magnetometer);
 	Basis combine_acc_mag(const Vector3 &p_grav, const Vector3 &p_magneto);
+	Basis apply_gyro(const Basis &p_orientation, const Vector3 &p_gyro, double p_delta_time);
 
 	int mag_count = 0;
 	bool has_gyro = false;
@@ -155,6 +157,7 @@ public:
 	virtual Vector<BlitToScreen> commit_views(RID p_render_target, const Rect2 &p_screen_rect) override;
 
 	virtual void process() override;
+	virtual void pre_render() override;
 
 	MobileVRInterface();
 	~MobileVRInterface();
@@ -1171,8 +1171,18 @@ GDMonoClass *GDMono::get_class(MonoClass *p_raw_class) {
 		return corlib_assembly->get_class(p_raw_class);
 	}
 
+	// Most marshalled objects (math structs, engine classes) come from the API assembly,
+	// check it before searching all the assemblies of the domain.
+	if (core_api_assembly.assembly && image == core_api_assembly.assembly->get_image()) {
+		return core_api_assembly.assembly->get_class(p_raw_class);
+	}
+
 	int32_t domain_id = mono_domain_get_id(mono_domain_get());
-	HashMap<String, GDMonoAssembly *> &domain_assemblies = assemblies[domain_id];
+	HashMap<String, GDMonoAssembly *> *domain_assemblies_ptr = assemblies.getptr(domain_id);
+	if (!domain_assemblies_ptr) {
+		return nullptr;
+	}
+	HashMap<String, GDMonoAssembly *> &domain_assemblies = *domain_assemblies_ptr;
 
 	const String *k = nullptr;
 	while ((k = domain_assemblies.next(k))) {
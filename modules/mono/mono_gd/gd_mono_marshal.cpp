@@ -1446,9 +1446,21 @@ Array mono_array_to_Array(MonoArray *p_array) {
 	int length = mono_array_length(p_array);
 	ret.resize(length);
 
+	// Elements are usually all of the same class, only resolve the managed type when it changes.
+	MonoClass *elem_class = nullptr;
+	ManagedType elem_type;
+
 	for (int i = 0; i < length; i++) {
 		MonoObject *elem = mono_array_get(p_array, MonoObject *, i);
-		ret[i] = mono_object_to_variant(elem);
+		if (!elem) {
+			continue;
+		}
+		MonoClass *klass = mono_object_get_class(elem);
+		if (klass != elem_class) {
+			elem_class = klass;
+			elem_type = ManagedType::from_class(klass);
+		}
+		ret[i] = mono_object_to_variant(elem, elem_type);
 	}
 
 	return ret;
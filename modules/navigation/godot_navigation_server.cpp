@@ -30,7 +30,9 @@
 
 #include "godot_navigation_server.h"
 
+#include "core/config/project_settings.h"
 #include "core/os/mutex.h"
+#include "core/os/os.h"
 
 #ifndef _3D_DISABLED
 #include "navigation_mesh_generator.h"
@@ -115,9 +117,13 @@
 
 GodotNavigationServer::GodotNavigationServer() :
 		NavigationServer3D() {
+	max_path_queries_per_frame = GLOBAL_DEF("navigation/3d/max_path_queries_per_frame", 64);
+	ProjectSettings::get_singleton()->set_custom_property_info("navigation/3d/max_path_queries_per_frame", PropertyInfo(Variant::INT, "navigation/3d/max_path_queries_per_frame", PROPERTY_HINT_RANGE, "0,4096,1,or_greater"));
 }
 
 GodotNavigationServer::~GodotNavigationServer() {
+	_wait_path_queries();
+	_finish_flow_fields();
 	flush_queries();
 }
 
@@ -208,7 +214,27 @@ Vector<Vector3> GodotNavigationServer::map_get_path(RID p_map, Vector3 p_origin,
 	const NavMap *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_COND_V(map == nullptr, Vector<Vector3>());
 
-	return map->get_path(p_origin, p_destination, p_optimize, p_layers);
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	Vector<Vector3> path = map->get_path(p_origin, p_destination, p_optimize, p_layers);
+	path_query_time_usec.add(OS::get_singleton()->get_ticks_usec() - begin);
+	return path;
+}
+
+void GodotNavigationServer::map_get_path_async(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, const Callable &p_callback, uint32_t p_layers) const {
+	ERR_FAIL_COND(map_owner.get_or_null(p_map) == nullptr);
+	ERR_FAIL_COND(p_callback.is_null());
+
+	PathQuery query;
+	query.map = p_map;
+	query.origin = p_origin;
+	query.destination = p_destination;
+	query.optimize = p_optimize;
+	query.layers = p_layers;
+	query.callback = p_callback;
+
+	GodotNavigationServer *mut_this = const_cast<GodotNavigationServer *>(this);
+	MutexLock lock(mut_this->path_queries_mutex);
+	mut_this->pending_path_queries.push_back(query);
 }
 
 Vector3 GodotNavigationServer::map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
@@ -450,6 +476,59 @@ COMMAND_4(agent_set_callback, RID, p_agent, Object *, p_receiver, StringName, p_
 	}
 }
 
+RID GodotNavigationServer::flow_field_create() const {
+	GodotNavigationServer *mut_this = const_cast<GodotNavigationServer *>(this);
+	MutexLock lock(mut_this->operations_mutex);
+	RID rid = flow_field_owner.make_rid();
+	NavFlowField *flow_field = flow_field_owner.get_or_null(rid);
+	flow_field->set_self(rid);
+	mut_this->flow_fields.push_back(flow_field);
+	return rid;
+}
+
+COMMAND_2(flow_field_set_map, RID, p_flow_field, RID, p_map) {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND(flow_field == nullptr);
+
+	NavMap *map = nullptr;
+	if (p_map.is_valid()) {
+		map = map_owner.get_or_null(p_map);
+		ERR_FAIL_COND(map == nullptr);
+	}
+	flow_field->set_map(map);
+}
+
+RID GodotNavigationServer::flow_field_get_map(RID p_flow_field) const {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND_V(flow_field == nullptr, RID());
+
+	if (flow_field->get_map()) {
+		return flow_field->get_map()->get_self();
+	}
+	return RID();
+}
+
+COMMAND_2(flow_field_set_target, RID, p_flow_field, Vector3, p_target) {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND(flow_field == nullptr);
+
+	flow_field->set_target(p_target);
+}
+
+COMMAND_2(flow_field_set_layers, RID, p_flow_field, uint32_t, p_layers) {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND(flow_field == nullptr);
+
+	flow_field->set_layers(p_layers);
+}
+
+Vector3 GodotNavigationServer::flow_field_get_direction(RID p_flow_field, const Vector3 &p_point) const {
+	const NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND_V(flow_field == nullptr, Vector3());
+
+	return flow_field->get_direction(p_point);
+}
+
 COMMAND_1(free, RID, p_object) {
 	if (map_owner.owns(p_object)) {
 		NavMap *map = map_owner.get_or_null(p_object);
@@ -468,6 +547,13 @@ COMMAND_1(free, RID, p_object) {
 			agents[i]->set_map(nullptr);
 		}
 
+		// Detach the flow fields
+		for (uint32_t i = 0; i < flow_fields.size(); i++) {
+			if (flow_fields[i]->get_map() == map) {
+				flow_fields[i]->set_map(nullptr);
+			}
+		}
+
 		int map_index = active_maps.find(map);
 		active_maps.remove(map_index);
 		active_maps_update_id.remove(map_index);
@@ -495,6 +581,10 @@ COMMAND_1(free, RID, p_object) {
 
 		agent_owner.free(p_object);
 
+	} else if (flow_field_owner.owns(p_object)) {
+		flow_fields.erase(flow_field_owner.get_or_null(p_object));
+		flow_field_owner.free(p_object);
+
 	} else {
 		ERR_FAIL_COND("Invalid ID.");
 	}
@@ -518,10 +608,121 @@ void GodotNavigationServer::flush_queries() {
 	commands.clear();
 }
 
+void GodotNavigationServer::_solve_path_query(uint32_t p_index, PathQuery *p_queries) {
+	PathQuery &query = p_queries[p_index];
+	if (query.nav_map) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		query.path = query.nav_map->get_path(query.origin, query.destination, query.optimize, query.layers);
+		path_query_time_usec.add(OS::get_singleton()->get_ticks_usec() - begin);
+	}
+}
+
+void GodotNavigationServer::_dispatch_path_queries() {
+	ERR_FAIL_COND(path_queries_group != WorkerThreadPool::INVALID_TASK_ID);
+
+	{
+		MutexLock lock(path_queries_mutex);
+		uint32_t count = pending_path_queries.size();
+		if (max_path_queries_per_frame > 0) {
+			count = MIN(count, max_path_queries_per_frame);
+		}
+		if (count == 0) {
+			return;
+		}
+
+		// Queries over the budget wait for the next frames, in order.
+		running_path_queries.resize(count);
+		for (uint32_t i = 0; i < count; i++) {
+			running_path_queries[i] = pending_path_queries[i];
+		}
+		for (uint32_t i = count; i < pending_path_queries.size(); i++) {
+			pending_path_queries[i - count] = pending_path_queries[i];
+		}
+		pending_path_queries.resize(pending_path_queries.size() - count);
+	}
+
+	// The maps may have been freed since the queries were queued.
+	for (uint32_t i = 0; i < running_path_queries.size(); i++) {
+		running_path_queries[i].nav_map = map_owner.get_or_null(running_path_queries[i].map);
+	}
+
+	path_queries_group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotNavigationServer::_solve_path_query, running_path_queries.ptr(), running_path_queries.size());
+}
+
+void GodotNavigationServer::_wait_path_queries() {
+	if (path_queries_group != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(path_queries_group);
+		path_queries_group = WorkerThreadPool::INVALID_TASK_ID;
+	}
+}
+
+void GodotNavigationServer::_finish_path_queries() {
+	_wait_path_queries();
+
+	for (uint32_t i = 0; i < running_path_queries.size(); i++) {
+		PathQuery &query = running_path_queries[i];
+		if (!query.callback.get_object()) {
+			// The receiver is gone.
+			continue;
+		}
+
+		const Variant path = query.path;
+		const Variant *args[1] = { &path };
+		Variant ret;
+		Callable::CallError ce;
+		query.callback.call(args, 1, ret, ce);
+		if (ce.error != Callable::CallError::CALL_OK) {
+			ERR_PRINT("Error calling path query callback: " + Variant::get_callable_error_text(query.callback, args, 1, ce));
+		}
+	}
+	running_path_queries.clear();
+}
+
+void GodotNavigationServer::_update_flow_field(uint32_t p_index, NavFlowField **p_flow_fields) {
+	p_flow_fields[p_index]->update();
+}
+
+void GodotNavigationServer::_dispatch_flow_fields() {
+	ERR_FAIL_COND(flow_fields_group != WorkerThreadPool::INVALID_TASK_ID);
+
+	// Only the fields whose target or map changed are computed again.
+	updating_flow_fields.clear();
+	for (uint32_t i = 0; i < flow_fields.size(); i++) {
+		if (flow_fields[i]->needs_update()) {
+			updating_flow_fields.push_back(flow_fields[i]);
+		}
+	}
+	if (updating_flow_fields.size() == 0) {
+		return;
+	}
+
+	flow_fields_group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotNavigationServer::_update_flow_field, updating_flow_fields.ptr(), updating_flow_fields.size());
+}
+
+void GodotNavigationServer::_finish_flow_fields() {
+	if (flow_fields_group == WorkerThreadPool::INVALID_TASK_ID) {
+		return;
+	}
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(flow_fields_group);
+	flow_fields_group = WorkerThreadPool::INVALID_TASK_ID;
+
+	for (uint32_t i = 0; i < updating_flow_fields.size(); i++) {
+		updating_flow_fields[i]->publish();
+	}
+	updating_flow_fields.clear();
+}
+
 void GodotNavigationServer::process(real_t p_delta_time) {
+	// The path queries and flow fields dispatched at the end of the previous
+	// frame must be done before anything touches the maps again.
+	_finish_path_queries();
+	_finish_flow_fields();
+
 	flush_queries();
 
 	if (!active) {
+		_dispatch_path_queries();
+		_dispatch_flow_fields();
 		return;
 	}
 
@@ -540,6 +741,9 @@ void GodotNavigationServer::process(real_t p_delta_time) {
 			active_maps_update_id[i] = new_map_update_id;
 		}
 	}
+
+	_dispatch_path_queries();
+	_dispatch_flow_fields();
 }
 
 #undef COMMAND_1
@@ -31,11 +31,13 @@
 #ifndef GODOT_NAVIGATION_SERVER_H
 #define GODOT_NAVIGATION_SERVER_H
 
+#include "core/os/worker_thread_pool.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
 #include "core/templates/rid_owner.h"
 #include "servers/navigation_server_3d.h"
 
+#include "nav_flow_field.h"
 #include "nav_map.h"
 #include "nav_region.h"
 #include "rvo_agent.h"
@@ -78,11 +80,47 @@ class GodotNavigationServer : public NavigationServer3D {
 	mutable RID_Owner<NavMap> map_owner;
 	mutable RID_Owner<NavRegion> region_owner;
 	mutable RID_Owner<RvoAgent> agent_owner;
+	mutable RID_Owner<NavFlowField> flow_field_owner;
 
 	bool active = true;
 	LocalVector<NavMap *> active_maps;
 	LocalVector<uint32_t> active_maps_update_id;
 
+	struct PathQuery {
+		RID map;
+		Vector3 origin;
+		Vector3 destination;
+		bool optimize = false;
+		uint32_t layers = 1;
+		Callable callback;
+		/// Resolved when the query is dispatched.
+		const NavMap *nav_map = nullptr;
+		Vector<Vector3> path;
+	};
+
+	/// Path queries waiting to be dispatched, protected by `path_queries_mutex`.
+	Mutex path_queries_mutex;
+	LocalVector<PathQuery> pending_path_queries;
+	/// Path queries being solved on the worker threads. They run between two
+	/// syncs, so the maps they read don't change under them.
+	LocalVector<PathQuery> running_path_queries;
+	WorkerThreadPool::GroupID path_queries_group = WorkerThreadPool::INVALID_TASK_ID;
+	uint32_t max_path_queries_per_frame = 0;
+
+	void _solve_path_query(uint32_t p_index, PathQuery *p_queries);
+	void _dispatch_path_queries();
+	void _wait_path_queries();
+	void _finish_path_queries();
+
+	LocalVector<NavFlowField *> flow_fields;
+	/// Flow fields being updated on the worker threads, like the path queries.
+	LocalVector<NavFlowField *> updating_flow_fields;
+	WorkerThreadPool::GroupID flow_fields_group = WorkerThreadPool::INVALID_TASK_ID;
+
+	void _update_flow_field(uint32_t p_index, NavFlowField **p_flow_fields);
+	void _dispatch_flow_fields();
+	void _finish_flow_fields();
+
 public:
 	GodotNavigationServer();
 	virtual ~GodotNavigationServer();
@@ -103,6 +141,7 @@ public:
 	virtual real_t map_get_edge_connection_margin(RID p_map) const;
 
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_layers = 1) const;
+	virtual void map_get_path_async(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, const Callable &p_callback, uint32_t p_layers = 1) const;
 
 	virtual Vector3 map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision = false) const;
 	virtual Vector3 map_get_closest_point(RID p_map, const Vector3 &p_point) const;
@@ -134,6 +173,13 @@ public:
 	virtual bool agent_is_map_changed(RID p_agent) const;
 	COMMAND_4_DEF(agent_set_callback, RID, p_agent, Object *, p_receiver, StringName, p_method, Variant, p_udata, Variant());
 
+	virtual RID flow_field_create() const;
+	COMMAND_2(flow_field_set_map, RID, p_flow_field, RID, p_map);
+	virtual RID flow_field_get_map(RID p_flow_field) const;
+	COMMAND_2(flow_field_set_target, RID, p_flow_field, Vector3, p_target);
+	COMMAND_2(flow_field_set_layers, RID, p_flow_field, uint32_t, p_layers);
+	virtual Vector3 flow_field_get_direction(RID p_flow_field, const Vector3 &p_point) const;
+
 	COMMAND_1(free, RID, p_object);
 
 	virtual void set_active(bool p_active) const;
@@ -0,0 +1,79 @@
+/*************************************************************************/
+/*  nav_flow_field.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "nav_flow_field.h"
+
+#include "nav_map.h"
+
+void NavFlowField::set_map(NavMap *p_map) {
+	map = p_map;
+	dirty = true;
+}
+
+void NavFlowField::set_target(const Vector3 &p_target) {
+	target = p_target;
+	dirty = true;
+}
+
+void NavFlowField::set_layers(uint32_t p_layers) {
+	layers = p_layers;
+	dirty = true;
+}
+
+bool NavFlowField::needs_update() const {
+	if (!map) {
+		return false;
+	}
+	return dirty || !has_field || field.map_update_id != map->get_map_update_id();
+}
+
+void NavFlowField::update() {
+	dirty = false;
+	map->compute_flow_field(target, layers, computing_field);
+}
+
+void NavFlowField::publish() {
+	field_lock.write_lock();
+	SWAP(field, computing_field);
+	has_field = true;
+	field_lock.write_unlock();
+}
+
+Vector3 NavFlowField::get_direction(const Vector3 &p_point) const {
+	if (!map) {
+		return Vector3();
+	}
+
+	field_lock.read_lock();
+	// Until the first field is ready, head straight to the target.
+	const Vector3 direction = has_field ? map->get_flow_field_direction(field, p_point, layers) : (target - p_point).normalized();
+	field_lock.read_unlock();
+	return direction;
+}
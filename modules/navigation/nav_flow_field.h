@@ -0,0 +1,77 @@
+/*************************************************************************/
+/*  nav_flow_field.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef NAV_FLOW_FIELD_H
+#define NAV_FLOW_FIELD_H
+
+#include "nav_rid.h"
+
+#include "core/os/rw_lock.h"
+#include "nav_utils.h"
+
+class NavMap;
+
+/// Directions towards a shared target, for crowds that would otherwise run
+/// one path query per unit. The field is integrated once over the map
+/// polygons, then sampling it is a polygon lookup.
+class NavFlowField : public NavRid {
+	NavMap *map = nullptr;
+	Vector3 target;
+	uint32_t layers = 1;
+	bool dirty = true;
+
+	/// Written by the update running on the worker threads.
+	gd::FlowField computing_field;
+
+	/// The last field computed, the directions are sampled from it.
+	RWLock field_lock;
+	gd::FlowField field;
+	bool has_field = false;
+
+public:
+	void set_map(NavMap *p_map);
+	NavMap *get_map() const {
+		return map;
+	}
+
+	void set_target(const Vector3 &p_target);
+	void set_layers(uint32_t p_layers);
+
+	/// The field is outdated: its target or layers changed, or the map did.
+	bool needs_update() const;
+	/// Computes the field again, can run on any thread while the map doesn't
+	/// change. `publish` then makes it the sampled one.
+	void update();
+	void publish();
+
+	Vector3 get_direction(const Vector3 &p_point) const;
+};
+
+#endif // NAV_FLOW_FIELD_H
@@ -42,6 +42,272 @@
 
 #define THREE_POINTS_CROSS_PRODUCT(m_a, m_b, m_c) (((m_c) - (m_a)).cross((m_b) - (m_a)))
 
+// Polygons per BVH leaf.
+#define POLYGON_BVH_LEAF_SIZE 4
+// Maximum polygons per cluster.
+#define POLYGON_CLUSTER_SIZE 64
+
+struct NavMap::PathQueryScratch {
+	struct OpenEntry {
+		float cost;
+		/// Checked on pop, the entries of improved nodes are left behind.
+		float traveled_distance;
+		uint32_t id;
+
+		bool operator<(const OpenEntry &p_other) const {
+			// Lowest cost first.
+			return cost > p_other.cost;
+		}
+	};
+
+	std::vector<gd::NavigationPoly> navigation_polys;
+	/// Index in `navigation_polys` of each map polygon, -1 if not reached.
+	/// Reset after every query.
+	std::vector<int32_t> navigation_poly_ids;
+	std::vector<OpenEntry> to_visit;
+
+	/// Cluster graph search, sized to the cluster count of the map queried.
+	std::vector<float> cluster_costs;
+	std::vector<int32_t> cluster_parents;
+	std::vector<uint8_t> cluster_corridor;
+};
+
+thread_local NavMap::PathQueryScratch NavMap::path_query_scratch;
+
+static _FORCE_INLINE_ real_t aabb_distance_to_point(const AABB &p_aabb, const Vector3 &p_point) {
+	const Vector3 end = p_aabb.position + p_aabb.size;
+	const Vector3 closest(CLAMP(p_point.x, p_aabb.position.x, end.x), CLAMP(p_point.y, p_aabb.position.y, end.y), CLAMP(p_point.z, p_aabb.position.z, end.z));
+	return closest.distance_to(p_point);
+}
+
+static _FORCE_INLINE_ real_t aabb_distance_to_aabb(const AABB &p_a, const AABB &p_b) {
+	const Vector3 a_end = p_a.position + p_a.size;
+	const Vector3 b_end = p_b.position + p_b.size;
+	Vector3 gap;
+	for (int i = 0; i < 3; i++) {
+		gap[i] = MAX(0.0, MAX(p_a.position[i] - b_end[i], p_b.position[i] - a_end[i]));
+	}
+	return gap.length();
+}
+
+void NavMap::build_polygon_bvh() {
+	polygon_bvh.clear();
+	polygon_bvh_indices.clear();
+	polygon_clusters.clear();
+	polygon_cluster_links.clear();
+	if (polygons.empty()) {
+		return;
+	}
+
+	std::vector<AABB> polygon_aabbs(polygons.size());
+	polygon_bvh_indices.resize(polygons.size());
+	for (size_t i(0); i < polygons.size(); i++) {
+		const gd::Polygon &p = polygons[i];
+		AABB aabb;
+		for (size_t point_id = 0; point_id < p.points.size(); point_id++) {
+			if (point_id == 0) {
+				aabb.position = p.points[point_id].pos;
+			} else {
+				aabb.expand_to(p.points[point_id].pos);
+			}
+		}
+		// Navigation polygons are mostly flat, give their boxes some
+		// thickness so the segment tests don't miss them because of rounding.
+		aabb.grow_by(cell_size * 0.01);
+		polygon_aabbs[i] = aabb;
+		polygon_bvh_indices[i] = i;
+	}
+
+	polygon_bvh.reserve(2 * (polygons.size() / POLYGON_BVH_LEAF_SIZE + 1));
+	polygon_bvh.push_back(PolygonBVHNode());
+	build_polygon_bvh_node(0, 0, polygons.size(), polygon_aabbs, false);
+	build_polygon_cluster_links();
+}
+
+void NavMap::build_polygon_bvh_node(uint32_t p_node, uint32_t p_from, uint32_t p_to, const std::vector<AABB> &p_polygon_aabbs, bool p_clustered) {
+	AABB aabb = p_polygon_aabbs[polygon_bvh_indices[p_from]];
+	AABB centers(aabb.get_center(), Vector3());
+	for (uint32_t i = p_from + 1; i < p_to; i++) {
+		const AABB &polygon_aabb = p_polygon_aabbs[polygon_bvh_indices[i]];
+		aabb.merge_with(polygon_aabb);
+		centers.expand_to(polygon_aabb.get_center());
+	}
+	polygon_bvh[p_node].aabb = aabb;
+
+	// The first subtree small enough makes a cluster.
+	if (!p_clustered && p_to - p_from <= POLYGON_CLUSTER_SIZE) {
+		PolygonCluster cluster;
+		for (uint32_t i = p_from; i < p_to; i++) {
+			gd::Polygon &polygon = polygons[polygon_bvh_indices[i]];
+			polygon.cluster = polygon_clusters.size();
+			cluster.center += polygon.center;
+		}
+		cluster.polygon_count = p_to - p_from;
+		cluster.center /= cluster.polygon_count;
+		polygon_clusters.push_back(cluster);
+		p_clustered = true;
+	}
+
+	if (p_to - p_from <= POLYGON_BVH_LEAF_SIZE) {
+		polygon_bvh[p_node].first = p_from;
+		polygon_bvh[p_node].count = p_to - p_from;
+		return;
+	}
+
+	// Split at the median along the longest axis of the polygon centers,
+	// which keeps the tree balanced whatever the map layout.
+	const int axis = centers.get_longest_axis_index();
+	const uint32_t middle = (p_from + p_to) / 2;
+	std::nth_element(polygon_bvh_indices.begin() + p_from, polygon_bvh_indices.begin() + middle, polygon_bvh_indices.begin() + p_to, [&](uint32_t p_a, uint32_t p_b) {
+		return p_polygon_aabbs[p_a].get_center()[axis] < p_polygon_aabbs[p_b].get_center()[axis];
+	});
+
+	const uint32_t children = polygon_bvh.size();
+	polygon_bvh.resize(children + 2);
+	polygon_bvh[p_node].first = children;
+	polygon_bvh[p_node].count = 0;
+
+	build_polygon_bvh_node(children, p_from, middle, p_polygon_aabbs, p_clustered);
+	build_polygon_bvh_node(children + 1, middle, p_to, p_polygon_aabbs, p_clustered);
+}
+
+void NavMap::build_polygon_cluster_links() {
+	// Two clusters are linked when any of their polygons are connected.
+	// Region layers aren't taken into account, they can change without the
+	// links being rebuilt; a query that can't get through the clusters it
+	// was given searches the whole map instead.
+	std::vector<uint64_t> links;
+	for (size_t poly_id(0); poly_id < polygons.size(); poly_id++) {
+		const gd::Polygon &poly = polygons[poly_id];
+		for (size_t e(0); e < poly.edges.size(); e++) {
+			const gd::Edge &edge = poly.edges[e];
+			for (int c = 0; c < edge.connections.size(); c++) {
+				const uint32_t other_cluster = edge.connections[c].polygon->cluster;
+				if (other_cluster != poly.cluster) {
+					links.push_back((uint64_t(poly.cluster) << 32) | other_cluster);
+				}
+			}
+		}
+	}
+	std::sort(links.begin(), links.end());
+	links.erase(std::unique(links.begin(), links.end()), links.end());
+
+	polygon_cluster_links.resize(links.size());
+	for (size_t i(0); i < links.size(); i++) {
+		PolygonCluster &cluster = polygon_clusters[links[i] >> 32];
+		if (cluster.link_count == 0) {
+			cluster.first_link = i;
+		}
+		cluster.link_count++;
+		polygon_cluster_links[i] = links[i] & 0xFFFFFFFF;
+	}
+}
+
+bool NavMap::find_cluster_corridor(uint32_t p_begin_cluster, uint32_t p_end_cluster, const Vector3 &p_end_point, PathQueryScratch &r_scratch) const {
+	// A* over the cluster graph, between the cluster centers.
+	const uint32_t cluster_count = polygon_clusters.size();
+	r_scratch.cluster_costs.assign(cluster_count, 1e30);
+	r_scratch.cluster_parents.assign(cluster_count, -1);
+	r_scratch.to_visit.clear();
+
+	r_scratch.cluster_costs[p_begin_cluster] = 0.0;
+	r_scratch.to_visit.push_back({ polygon_clusters[p_begin_cluster].center.distance_to(p_end_point), 0.0, p_begin_cluster });
+
+	bool found = false;
+	while (!r_scratch.to_visit.empty()) {
+		std::pop_heap(r_scratch.to_visit.begin(), r_scratch.to_visit.end());
+		const PathQueryScratch::OpenEntry entry = r_scratch.to_visit.back();
+		r_scratch.to_visit.pop_back();
+		if (entry.traveled_distance != r_scratch.cluster_costs[entry.id]) {
+			continue; // Reached through a shorter route since.
+		}
+		if (entry.id == p_end_cluster) {
+			found = true;
+			break;
+		}
+
+		const PolygonCluster &cluster = polygon_clusters[entry.id];
+		for (uint32_t i = 0; i < cluster.link_count; i++) {
+			const uint32_t other_id = polygon_cluster_links[cluster.first_link + i];
+			const Vector3 &other_center = polygon_clusters[other_id].center;
+			const float traveled_distance = entry.traveled_distance + cluster.center.distance_to(other_center);
+			if (traveled_distance < r_scratch.cluster_costs[other_id]) {
+				r_scratch.cluster_costs[other_id] = traveled_distance;
+				r_scratch.cluster_parents[other_id] = entry.id;
+				r_scratch.to_visit.push_back({ traveled_distance + other_center.distance_to(p_end_point), traveled_distance, other_id });
+				std::push_heap(r_scratch.to_visit.begin(), r_scratch.to_visit.end());
+			}
+		}
+	}
+	r_scratch.to_visit.clear();
+
+	if (!found) {
+		return false;
+	}
+
+	// The corridor is made of the route clusters and their neighbours, which
+	// leaves the polygon search some room to straighten the route.
+	r_scratch.cluster_corridor.assign(cluster_count, 0);
+	for (int32_t id = p_end_cluster; id != -1; id = r_scratch.cluster_parents[id]) {
+		const PolygonCluster &cluster = polygon_clusters[id];
+		r_scratch.cluster_corridor[id] = 1;
+		for (uint32_t i = 0; i < cluster.link_count; i++) {
+			r_scratch.cluster_corridor[polygon_cluster_links[cluster.first_link + i]] = 1;
+		}
+	}
+	return true;
+}
+
+// Visits the polygons whose box is closer than the current closest distance
+// according to `p_aabb_distance`, the nearest boxes first. `p_aabb_distance`
+// must never be greater than the distance the visitor would compute for any
+// polygon inside the box.
+template <class D, class V>
+void NavMap::query_polygon_bvh(const D &p_aabb_distance, const V &p_visit_polygon, real_t &r_closest_distance) const {
+	if (polygon_bvh.empty()) {
+		return;
+	}
+
+	struct Entry {
+		uint32_t node;
+		real_t distance;
+	};
+
+	// The tree is balanced, its depth never gets close to this.
+	Entry stack[64];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = { 0, p_aabb_distance(polygon_bvh[0].aabb) };
+
+	while (stack_size > 0) {
+		const Entry entry = stack[--stack_size];
+		if (entry.distance >= r_closest_distance) {
+			continue;
+		}
+
+		const PolygonBVHNode &node = polygon_bvh[entry.node];
+		if (node.count > 0) {
+			for (uint32_t i = 0; i < node.count; i++) {
+				p_visit_polygon(polygons[polygon_bvh_indices[node.first + i]], r_closest_distance);
+			}
+			continue;
+		}
+
+		Entry near = { node.first, p_aabb_distance(polygon_bvh[node.first].aabb) };
+		Entry far = { node.first + 1, p_aabb_distance(polygon_bvh[node.first + 1].aabb) };
+		if (far.distance < near.distance) {
+			SWAP(near, far);
+		}
+
+		// Push the farther child first so the nearer one is visited first.
+		if (far.distance < r_closest_distance) {
+			stack[stack_size++] = far;
+		}
+		if (near.distance < r_closest_distance) {
+			stack[stack_size++] = near;
+		}
+	}
+}
+
 void NavMap::set_up(Vector3 p_up) {
 	up = p_up;
 	regenerate_polygons = true;
@@ -70,47 +336,44 @@ gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
 	return p;
 }
 
+const gd::Polygon *NavMap::get_closest_polygon(const Vector3 &p_point, uint32_t p_layers, Vector3 &r_point) const {
+	const gd::Polygon *closest_poly = nullptr;
+	real_t closest_point_d = 1e20;
+
+	query_polygon_bvh([&](const AABB &p_aabb) { return aabb_distance_to_point(p_aabb, p_point); },
+			[&](const gd::Polygon &p, real_t &r_closest_d) {
+				// Only consider the polygon if it in a region with compatible layers.
+				if ((p_layers & p.owner->get_layers()) == 0) {
+					return;
+				}
+
+				// For each point cast a face and check the distance to the point.
+				for (size_t point_id = 0; point_id < p.points.size(); point_id++) {
+					const Vector3 p1 = p.points[point_id].pos;
+					const Vector3 p2 = p.points[(point_id + 1) % p.points.size()].pos;
+					const Vector3 p3 = p.points[(point_id + 2) % p.points.size()].pos;
+					const Face3 face(p1, p2, p3);
+
+					const Vector3 point = face.get_closest_point_to(p_point);
+					const real_t distance_to_point = point.distance_to(p_point);
+					if (distance_to_point < r_closest_d) {
+						r_closest_d = distance_to_point;
+						closest_poly = &p;
+						r_point = point;
+					}
+				}
+			},
+			closest_point_d);
+
+	return closest_poly;
+}
+
 Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_layers) const {
 	// Find the start poly and the end poly on this map.
-	const gd::Polygon *begin_poly = nullptr;
-	const gd::Polygon *end_poly = nullptr;
 	Vector3 begin_point;
 	Vector3 end_point;
-	float begin_d = 1e20;
-	float end_d = 1e20;
-	// Find the initial poly and the end poly on this map.
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
-
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_layers & p.owner->get_layers()) == 0) {
-			continue;
-		}
-
-		// For each point cast a face and check the distance between the origin/destination
-		for (size_t point_id = 0; point_id < p.points.size(); point_id++) {
-			const Vector3 p1 = p.points[point_id].pos;
-			const Vector3 p2 = p.points[(point_id + 1) % p.points.size()].pos;
-			const Vector3 p3 = p.points[(point_id + 2) % p.points.size()].pos;
-			const Face3 face(p1, p2, p3);
-
-			Vector3 point = face.get_closest_point_to(p_origin);
-			float distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
-			}
-
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
-			}
-		}
-	}
+	const gd::Polygon *begin_poly = get_closest_polygon(p_origin, p_layers, begin_point);
+	const gd::Polygon *end_poly = get_closest_polygon(p_destination, p_layers, end_point);
 
 	// Check for trivial cases
 	if (!begin_poly || !end_poly) {
@@ -124,149 +387,179 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		return path;
 	}
 
-	// List of all reachable navigation polys.
-	std::vector<gd::NavigationPoly> navigation_polys;
-	navigation_polys.reserve(polygons.size() * 0.75);
-
-	// Add the start polygon to the reachable navigation polygons.
-	gd::NavigationPoly begin_navigation_poly = gd::NavigationPoly(begin_poly);
-	begin_navigation_poly.self_id = 0;
-	begin_navigation_poly.entry = begin_point;
-	begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
-	begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
-	navigation_polys.push_back(begin_navigation_poly);
+	PathQueryScratch &scratch = path_query_scratch;
+	std::vector<gd::NavigationPoly> &navigation_polys = scratch.navigation_polys;
+	std::vector<int32_t> &navigation_poly_ids = scratch.navigation_poly_ids;
+	std::vector<PathQueryScratch::OpenEntry> &to_visit = scratch.to_visit;
+	if (navigation_poly_ids.size() < polygons.size()) {
+		navigation_poly_ids.resize(polygons.size(), -1);
+	}
 
-	// List of polygon IDs to visit.
-	List<uint32_t> to_visit;
-	to_visit.push_back(0);
+	// When the end points are in different clusters, look for a route on the
+	// cluster graph first and only search the polygons around it. If the end
+	// polygon can't be reached that way, search the whole map.
+	const bool use_corridor = begin_poly->cluster != end_poly->cluster && find_cluster_corridor(begin_poly->cluster, end_poly->cluster, end_point, scratch);
 
 	// This is an implementation of the A* algorithm.
 	int least_cost_id = 0;
 	bool found_route = false;
 
-	const gd::Polygon *reachable_end = nullptr;
-	float reachable_d = 1e30;
-	bool is_reachable = true;
-
-	while (true) {
-		gd::NavigationPoly *least_cost_poly = &navigation_polys[least_cost_id];
-
-		// Takes the current least_cost_poly neighbors (iterating over its edges) and compute the traveled_distance.
-		for (size_t i = 0; i < least_cost_poly->poly->edges.size(); i++) {
-			const gd::Edge &edge = least_cost_poly->poly->edges[i];
-
-			// Iterate over connections in this edge, then compute the new optimized travel distance assigned to this polygon.
-			for (int connection_index = 0; connection_index < edge.connections.size(); connection_index++) {
-				const gd::Edge::Connection &connection = edge.connections[connection_index];
-
-				// Only consider the connection to another polygon if this polygon is in a region with compatible layers.
-				if ((p_layers & connection.polygon->owner->get_layers()) == 0) {
-					continue;
-				}
+	for (int attempt = use_corridor ? 0 : 1; attempt < 2 && !found_route; attempt++) {
+		const bool in_corridor = attempt == 0;
+
+		// Add the start polygon to the reachable navigation polygons.
+		gd::NavigationPoly begin_navigation_poly = gd::NavigationPoly(begin_poly);
+		begin_navigation_poly.self_id = 0;
+		begin_navigation_poly.entry = begin_point;
+		begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
+		begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
+		navigation_polys.clear();
+		navigation_polys.push_back(begin_navigation_poly);
+		navigation_poly_ids[begin_poly->id] = 0;
+		to_visit.clear();
+		least_cost_id = 0;
+
+		const gd::Polygon *reachable_end = nullptr;
+		float reachable_d = 1e30;
+		bool is_reachable = true;
+
+		while (true) {
+			gd::NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
+			least_cost_poly.closed = true;
+			const gd::Polygon *poly = least_cost_poly.poly;
+			const Vector3 entry = least_cost_poly.entry;
+			const float traveled_distance = least_cost_poly.traveled_distance;
+
+			// Takes the current least_cost_poly neighbors (iterating over its edges) and compute the traveled_distance.
+			for (size_t i = 0; i < poly->edges.size(); i++) {
+				const gd::Edge &edge = poly->edges[i];
+
+				// Iterate over connections in this edge, then compute the new optimized travel distance assigned to this polygon.
+				for (int connection_index = 0; connection_index < edge.connections.size(); connection_index++) {
+					const gd::Edge::Connection &connection = edge.connections[connection_index];
+
+					// Only consider the connection to another polygon if this polygon is in a region with compatible layers.
+					if ((p_layers & connection.polygon->owner->get_layers()) == 0) {
+						continue;
+					}
+					if (in_corridor && !scratch.cluster_corridor[connection.polygon->cluster]) {
+						continue;
+					}
 
-				Vector3 pathway[2] = { connection.pathway_start, connection.pathway_end };
-				const Vector3 new_entry = Geometry3D::get_closest_point_to_segment(least_cost_poly->entry, pathway);
-				const float new_distance = least_cost_poly->entry.distance_to(new_entry) + least_cost_poly->traveled_distance;
-
-				const std::vector<gd::NavigationPoly>::iterator it = std::find(
-						navigation_polys.begin(),
-						navigation_polys.end(),
-						gd::NavigationPoly(connection.polygon));
-
-				if (it != navigation_polys.end()) {
-					// Polygon already visited, check if we can reduce the travel cost.
-					if (new_distance < it->traveled_distance) {
-						it->back_navigation_poly_id = least_cost_id;
-						it->back_navigation_edge = connection.edge;
-						it->back_navigation_edge_pathway_start = connection.pathway_start;
-						it->back_navigation_edge_pathway_end = connection.pathway_end;
-						it->traveled_distance = new_distance;
-						it->entry = new_entry;
+					Vector3 pathway[2] = { connection.pathway_start, connection.pathway_end };
+					const Vector3 new_entry = Geometry3D::get_closest_point_to_segment(entry, pathway);
+					const float new_distance = entry.distance_to(new_entry) + traveled_distance;
+
+					int32_t navigation_poly_id = navigation_poly_ids[connection.polygon->id];
+					if (navigation_poly_id != -1) {
+						// Polygon already visited, check if we can reduce the travel cost.
+						gd::NavigationPoly &navigation_poly = navigation_polys[navigation_poly_id];
+						if (new_distance >= navigation_poly.traveled_distance) {
+							continue;
+						}
+						navigation_poly.back_navigation_poly_id = least_cost_id;
+						navigation_poly.back_navigation_edge = connection.edge;
+						navigation_poly.back_navigation_edge_pathway_start = connection.pathway_start;
+						navigation_poly.back_navigation_edge_pathway_end = connection.pathway_end;
+						navigation_poly.traveled_distance = new_distance;
+						navigation_poly.entry = new_entry;
+						if (navigation_poly.closed) {
+							continue;
+						}
+					} else {
+						// Add the neighbour polygon to the reachable ones.
+						gd::NavigationPoly new_navigation_poly = gd::NavigationPoly(connection.polygon);
+						new_navigation_poly.self_id = navigation_polys.size();
+						new_navigation_poly.back_navigation_poly_id = least_cost_id;
+						new_navigation_poly.back_navigation_edge = connection.edge;
+						new_navigation_poly.back_navigation_edge_pathway_start = connection.pathway_start;
+						new_navigation_poly.back_navigation_edge_pathway_end = connection.pathway_end;
+						new_navigation_poly.traveled_distance = new_distance;
+						new_navigation_poly.entry = new_entry;
+						navigation_poly_id = navigation_polys.size();
+						navigation_poly_ids[connection.polygon->id] = navigation_poly_id;
+						navigation_polys.push_back(new_navigation_poly);
 					}
-				} else {
-					// Add the neighbour polygon to the reachable ones.
-					gd::NavigationPoly new_navigation_poly = gd::NavigationPoly(connection.polygon);
-					new_navigation_poly.self_id = navigation_polys.size();
-					new_navigation_poly.back_navigation_poly_id = least_cost_id;
-					new_navigation_poly.back_navigation_edge = connection.edge;
-					new_navigation_poly.back_navigation_edge_pathway_start = connection.pathway_start;
-					new_navigation_poly.back_navigation_edge_pathway_end = connection.pathway_end;
-					new_navigation_poly.traveled_distance = new_distance;
-					new_navigation_poly.entry = new_entry;
-					navigation_polys.push_back(new_navigation_poly);
 
 					// Add the neighbour polygon to the polygons to visit.
-					to_visit.push_back(navigation_polys.size() - 1);
+					to_visit.push_back({ new_distance + new_entry.distance_to(end_point), new_distance, uint32_t(navigation_poly_id) });
+					std::push_heap(to_visit.begin(), to_visit.end());
 				}
 			}
-		}
-
-		// Removes the least cost polygon from the list of polygons to visit so we can advance.
-		to_visit.erase(least_cost_id);
 
-		// When the list of polygons to visit is empty at this point it means the End Polygon is not reachable
-		if (to_visit.size() == 0) {
-			// Thus use the further reachable polygon
-			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
-			is_reachable = false;
-			if (reachable_end == nullptr) {
-				// The path is not found and there is not a way out.
-				break;
+			// Find the polygon with the minimum cost from the list of polygons to visit.
+			least_cost_id = -1;
+			while (!to_visit.empty()) {
+				std::pop_heap(to_visit.begin(), to_visit.end());
+				const PathQueryScratch::OpenEntry open_entry = to_visit.back();
+				to_visit.pop_back();
+				const gd::NavigationPoly &navigation_poly = navigation_polys[open_entry.id];
+				if (!navigation_poly.closed && open_entry.traveled_distance == navigation_poly.traveled_distance) {
+					least_cost_id = open_entry.id;
+					break;
+				}
 			}
 
-			// Set as end point the furthest reachable point.
-			end_poly = reachable_end;
-			end_d = 1e20;
-			for (size_t point_id = 2; point_id < end_poly->points.size(); point_id++) {
-				Face3 f(end_poly->points[point_id - 2].pos, end_poly->points[point_id - 1].pos, end_poly->points[point_id].pos);
-				Vector3 spoint = f.get_closest_point_to(p_destination);
-				float dpoint = spoint.distance_to(p_destination);
-				if (dpoint < end_d) {
-					end_point = spoint;
-					end_d = dpoint;
+			// When the list of polygons to visit is empty at this point it means the End Polygon is not reachable
+			if (least_cost_id == -1) {
+				if (in_corridor) {
+					// Try again on the whole map.
+					break;
+				}
+
+				// Thus use the further reachable polygon
+				ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
+				is_reachable = false;
+				if (reachable_end == nullptr) {
+					// The path is not found and there is not a way out.
+					break;
 				}
-			}
 
-			// Reset open and navigation_polys
-			gd::NavigationPoly np = navigation_polys[0];
-			navigation_polys.clear();
-			navigation_polys.push_back(np);
-			to_visit.clear();
-			to_visit.push_back(0);
+				// Set as end point the furthest reachable point.
+				end_poly = reachable_end;
+				float end_d = 1e20;
+				for (size_t point_id = 2; point_id < end_poly->points.size(); point_id++) {
+					Face3 f(end_poly->points[point_id - 2].pos, end_poly->points[point_id - 1].pos, end_poly->points[point_id].pos);
+					Vector3 spoint = f.get_closest_point_to(p_destination);
+					float dpoint = spoint.distance_to(p_destination);
+					if (dpoint < end_d) {
+						end_point = spoint;
+						end_d = dpoint;
+					}
+				}
 
-			reachable_end = nullptr;
+				// Reset open and navigation_polys
+				for (size_t i = 1; i < navigation_polys.size(); i++) {
+					navigation_poly_ids[navigation_polys[i].poly->id] = -1;
+				}
+				navigation_polys.erase(navigation_polys.begin() + 1, navigation_polys.end());
+				navigation_polys[0].closed = false;
+				least_cost_id = 0;
 
-			continue;
-		}
+				reachable_end = nullptr;
 
-		// Find the polygon with the minimum cost from the list of polygons to visit.
-		least_cost_id = -1;
-		float least_cost = 1e30;
-		for (List<uint32_t>::Element *element = to_visit.front(); element != nullptr; element = element->next()) {
-			gd::NavigationPoly *np = &navigation_polys[element->get()];
-			float cost = np->traveled_distance;
-			cost += np->entry.distance_to(end_point);
-			if (cost < least_cost) {
-				least_cost_id = np->self_id;
-				least_cost = cost;
+				continue;
+			}
+
+			// Stores the further reachable end polygon, in case our goal is not reachable.
+			if (is_reachable) {
+				float d = navigation_polys[least_cost_id].entry.distance_to(p_destination);
+				if (reachable_d > d) {
+					reachable_d = d;
+					reachable_end = navigation_polys[least_cost_id].poly;
+				}
 			}
-		}
 
-		// Stores the further reachable end polygon, in case our goal is not reachable.
-		if (is_reachable) {
-			float d = navigation_polys[least_cost_id].entry.distance_to(p_destination);
-			if (reachable_d > d) {
-				reachable_d = d;
-				reachable_end = navigation_polys[least_cost_id].poly;
+			// Check if we reached the end
+			if (navigation_polys[least_cost_id].poly == end_poly) {
+				found_route = true;
+				break;
 			}
 		}
 
-		ERR_BREAK(least_cost_id == -1);
-
-		// Check if we reached the end
-		if (navigation_polys[least_cost_id].poly == end_poly) {
-			found_route = true;
-			break;
+		// Leave the polygon lookup clean for the next search.
+		for (size_t i = 0; i < navigation_polys.size(); i++) {
+			navigation_poly_ids[navigation_polys[i].poly->id] = -1;
 		}
 	}
 
@@ -369,131 +662,219 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	return path;
 }
 
-Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
-	bool use_collision = p_use_collision;
-	Vector3 closest_point;
-	real_t closest_point_d = 1e20;
+void NavMap::compute_flow_field(const Vector3 &p_target, uint32_t p_layers, gd::FlowField &r_field) const {
+	r_field.map_update_id = map_update_id;
+	r_field.target_polygon = -1;
+	r_field.waypoints.resize(polygons.size());
+	r_field.next_polygons.assign(polygons.size(), -1);
+	r_field.distances.assign(polygons.size(), 1e30);
 
-	// Find the initial poly and the end poly on this map.
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
+	const gd::Polygon *target_poly = get_closest_polygon(p_target, p_layers, r_field.target);
+	if (!target_poly) {
+		return;
+	}
+	r_field.target_polygon = target_poly->id;
+	r_field.waypoints[target_poly->id] = r_field.target;
+	r_field.distances[target_poly->id] = 0.0;
+
+	// Dijkstra from the target polygon. The polygons are entered the same
+	// way the path queries do, at the pathway point closest to the entry of
+	// the polygon the search comes from, which is also where the units of
+	// the neighbour polygon head to.
+	std::vector<PathQueryScratch::OpenEntry> &to_visit = path_query_scratch.to_visit;
+	to_visit.clear();
+	to_visit.push_back({ 0.0, 0.0, target_poly->id });
+
+	while (!to_visit.empty()) {
+		std::pop_heap(to_visit.begin(), to_visit.end());
+		const PathQueryScratch::OpenEntry open_entry = to_visit.back();
+		to_visit.pop_back();
+		if (open_entry.traveled_distance != r_field.distances[open_entry.id]) {
+			continue;
+		}
 
-		// For each point cast a face and check the distance to the segment
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[point_id - 2].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			Vector3 inters;
-			if (f.intersects_segment(p_from, p_to, &inters)) {
-				const real_t d = closest_point_d = p_from.distance_to(inters);
-				if (use_collision == false) {
-					closest_point = inters;
-					use_collision = true;
-					closest_point_d = d;
-				} else if (closest_point_d > d) {
-					closest_point = inters;
-					closest_point_d = d;
+		const gd::Polygon &poly = polygons[open_entry.id];
+		const Vector3 entry = r_field.waypoints[open_entry.id];
+
+		for (size_t i = 0; i < poly.edges.size(); i++) {
+			const gd::Edge &edge = poly.edges[i];
+			for (int connection_index = 0; connection_index < edge.connections.size(); connection_index++) {
+				const gd::Edge::Connection &connection = edge.connections[connection_index];
+
+				// Only consider the connection to another polygon if this polygon is in a region with compatible layers.
+				if ((p_layers & connection.polygon->owner->get_layers()) == 0) {
+					continue;
 				}
+
+				Vector3 pathway[2] = { connection.pathway_start, connection.pathway_end };
+				const Vector3 new_entry = Geometry3D::get_closest_point_to_segment(entry, pathway);
+				const float new_distance = entry.distance_to(new_entry) + open_entry.traveled_distance;
+
+				const uint32_t other_id = connection.polygon->id;
+				if (new_distance >= r_field.distances[other_id]) {
+					continue;
+				}
+				r_field.distances[other_id] = new_distance;
+				r_field.waypoints[other_id] = new_entry;
+				r_field.next_polygons[other_id] = open_entry.id;
+
+				to_visit.push_back({ new_distance, new_distance, other_id });
+				std::push_heap(to_visit.begin(), to_visit.end());
 			}
 		}
+	}
+}
 
-		if (use_collision == false) {
-			for (size_t point_id = 0; point_id < p.points.size(); point_id += 1) {
-				Vector3 a, b;
+Vector3 NavMap::get_flow_field_direction(const gd::FlowField &p_field, const Vector3 &p_point, uint32_t p_layers) const {
+	if (p_field.target_polygon == -1) {
+		return Vector3();
+	}
+	if (p_field.map_update_id != map_update_id) {
+		// The map changed since the field was computed, its polygon ids no
+		// longer apply. Head straight to the target until it is updated.
+		return (p_field.target - p_point).normalized();
+	}
 
-				Geometry3D::get_closest_points_between_segments(
-						p_from,
-						p_to,
-						p.points[point_id].pos,
-						p.points[(point_id + 1) % p.points.size()].pos,
-						a,
-						b);
+	Vector3 point;
+	const gd::Polygon *poly = get_closest_polygon(p_point, p_layers, point);
+	if (!poly || p_field.distances[poly->id] >= 1e30) {
+		// Off the map or can't reach the target from here.
+		return Vector3();
+	}
+
+	int32_t poly_id = poly->id;
+	Vector3 direction = p_field.waypoints[poly_id] - p_point;
+	// Already on the way out of this polygon, look at the next one.
+	while (direction.length_squared() < CMP_EPSILON2 && p_field.next_polygons[poly_id] != -1) {
+		poly_id = p_field.next_polygons[poly_id];
+		direction = p_field.waypoints[poly_id] - p_point;
+	}
 
-				const real_t d = a.distance_to(b);
-				if (d < closest_point_d) {
-					closest_point_d = d;
-					closest_point = b;
+	return direction.normalized();
+}
+
+Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
+	Vector3 closest_point;
+	real_t closest_point_d = 1e20;
+	bool intersected = false;
+
+	// Look for the intersection closest to the segment start first, only the
+	// boxes crossed by the segment can contain one.
+	query_polygon_bvh([&](const AABB &p_aabb) { return p_aabb.intersects_segment(p_from, p_to) ? aabb_distance_to_point(p_aabb, p_from) : 1e20; },
+			[&](const gd::Polygon &p, real_t &r_closest_d) {
+				// For each point cast a face and check the distance to the segment
+				for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
+					const Face3 f(p.points[point_id - 2].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+					Vector3 inters;
+					if (f.intersects_segment(p_from, p_to, &inters)) {
+						const real_t d = p_from.distance_to(inters);
+						if (d < r_closest_d) {
+							closest_point = inters;
+							r_closest_d = d;
+							intersected = true;
+						}
+					}
 				}
-			}
-		}
+			},
+			closest_point_d);
+
+	if (intersected || p_use_collision) {
+		return closest_point;
 	}
 
+	// Otherwise take the point of the polygon edges closest to the segment.
+	const AABB segment_aabb = AABB(p_from, Vector3()).expand(p_to);
+	query_polygon_bvh([&](const AABB &p_aabb) { return aabb_distance_to_aabb(p_aabb, segment_aabb); },
+			[&](const gd::Polygon &p, real_t &r_closest_d) {
+				for (size_t point_id = 0; point_id < p.points.size(); point_id += 1) {
+					Vector3 a, b;
+
+					Geometry3D::get_closest_points_between_segments(
+							p_from,
+							p_to,
+							p.points[point_id].pos,
+							p.points[(point_id + 1) % p.points.size()].pos,
+							a,
+							b);
+
+					const real_t d = a.distance_to(b);
+					if (d < r_closest_d) {
+						r_closest_d = d;
+						closest_point = b;
+					}
+				}
+			},
+			closest_point_d);
+
 	return closest_point;
 }
 
 Vector3 NavMap::get_closest_point(const Vector3 &p_point) const {
-	// TODO this is really not optimal, please redesign the API to directly return all this data
-
 	Vector3 closest_point;
 	real_t closest_point_d = 1e20;
 
-	// Find the initial poly and the end poly on this map.
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
-
-		// For each point cast a face and check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[point_id - 2].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t d = inters.distance_to(p_point);
-			if (d < closest_point_d) {
-				closest_point = inters;
-				closest_point_d = d;
-			}
-		}
-	}
+	query_polygon_bvh([&](const AABB &p_aabb) { return aabb_distance_to_point(p_aabb, p_point); },
+			[&](const gd::Polygon &p, real_t &r_closest_d) {
+				// For each point cast a face and check the distance to the point
+				for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
+					const Face3 f(p.points[point_id - 2].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+					const Vector3 inters = f.get_closest_point_to(p_point);
+					const real_t d = inters.distance_to(p_point);
+					if (d < r_closest_d) {
+						closest_point = inters;
+						r_closest_d = d;
+					}
+				}
+			},
+			closest_point_d);
 
 	return closest_point;
 }
 
 Vector3 NavMap::get_closest_point_normal(const Vector3 &p_point) const {
-	// TODO this is really not optimal, please redesign the API to directly return all this data
-
 	Vector3 closest_point;
 	Vector3 closest_point_normal;
 	real_t closest_point_d = 1e20;
 
-	// Find the initial poly and the end poly on this map.
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
-
-		// For each point cast a face and check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[point_id - 2].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t d = inters.distance_to(p_point);
-			if (d < closest_point_d) {
-				closest_point = inters;
-				closest_point_normal = f.get_plane().normal;
-				closest_point_d = d;
-			}
-		}
-	}
+	query_polygon_bvh([&](const AABB &p_aabb) { return aabb_distance_to_point(p_aabb, p_point); },
+			[&](const gd::Polygon &p, real_t &r_closest_d) {
+				// For each point cast a face and check the distance to the point
+				for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
+					const Face3 f(p.points[point_id - 2].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+					const Vector3 inters = f.get_closest_point_to(p_point);
+					const real_t d = inters.distance_to(p_point);
+					if (d < r_closest_d) {
+						closest_point = inters;
+					closest_point_normal = f.get_plane().normal;
+						r_closest_d = d;
+					}
+				}
+			},
+			closest_point_d);
 
 	return closest_point_normal;
 }
 
 RID NavMap::get_closest_point_owner(const Vector3 &p_point) const {
-	// TODO this is really not optimal, please redesign the API to directly return all this data
-
 	Vector3 closest_point;
 	RID closest_point_owner;
 	real_t closest_point_d = 1e20;
 
-	// Find the initial poly and the end poly on this map.
-	for (size_t i(0); i < polygons.size(); i++) {
-		const gd::Polygon &p = polygons[i];
-
-		// For each point cast a face and check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[point_id - 2].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t d = inters.distance_to(p_point);
-			if (d < closest_point_d) {
-				closest_point = inters;
-				closest_point_owner = p.owner->get_self();
-				closest_point_d = d;
-			}
-		}
-	}
+	query_polygon_bvh([&](const AABB &p_aabb) { return aabb_distance_to_point(p_aabb, p_point); },
+			[&](const gd::Polygon &p, real_t &r_closest_d) {
+				// For each point cast a face and check the distance to the point
+				for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
+					const Face3 f(p.points[point_id - 2].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+					const Vector3 inters = f.get_closest_point_to(p_point);
+					const real_t d = inters.distance_to(p_point);
+					if (d < r_closest_d) {
+						closest_point = inters;
+					closest_point_owner = p.owner->get_self();
+						r_closest_d = d;
+					}
+				}
+			},
+			closest_point_d);
 
 	return closest_point_owner;
 }
@@ -588,6 +969,7 @@ void NavMap::sync() {
 		Map<gd::EdgeKey, Vector<gd::Edge::Connection>> connections;
 		for (size_t poly_id(0); poly_id < polygons.size(); poly_id++) {
 			gd::Polygon &poly(polygons[poly_id]);
+			poly.id = poly_id;
 
 			for (size_t p(0); p < poly.points.size(); p++) {
 				int next_point = (p + 1) % poly.points.size();
@@ -690,18 +1072,18 @@ void NavMap::sync() {
 			}
 		}
 
+		build_polygon_bvh();
+
 		// Update the update ID.
 		map_update_id = (map_update_id + 1) % 9999999;
 	}
 
-	// Update agents tree.
+	// Update the agents of the avoidance grid, their cells are computed every step.
 	if (agents_dirty) {
-		std::vector<RVO::Agent *> raw_agents;
-		raw_agents.reserve(agents.size());
+		agent_grid.resize(agents.size());
 		for (size_t i(0); i < agents.size(); i++) {
-			raw_agents.push_back(agents[i]->get_agent());
+			agent_grid[i].agent = agents[i]->get_agent();
 		}
-		rvo.buildAgentTree(raw_agents);
 	}
 
 	regenerate_polygons = false;
@@ -709,14 +1091,108 @@ void NavMap::sync() {
 	agents_dirty = false;
 }
 
+static _FORCE_INLINE_ uint64_t agent_grid_cell_key(int64_t p_x, int64_t p_y, int64_t p_z) {
+	// Far away cells can share a key, which only costs some extra distance checks.
+	return ((uint64_t(p_x) & 0x1FFFFF) << 42) | ((uint64_t(p_y) & 0x1FFFFF) << 21) | (uint64_t(p_z) & 0x1FFFFF);
+}
+
+void NavMap::build_agent_grid() {
+	// Cells as large as the longest neighbor distance, so every query only
+	// looks at the cells around the agent.
+	float cell_size = 0.0;
+	for (size_t i(0); i < agent_grid.size(); i++) {
+		cell_size = MAX(cell_size, agent_grid[i].agent->neighborDist_);
+	}
+	agent_grid_cell_size = MAX(cell_size, CMP_EPSILON);
+
+	const float inv_cell_size = 1.0 / agent_grid_cell_size;
+	for (size_t i(0); i < agent_grid.size(); i++) {
+		const RVO::Vector3 &position = agent_grid[i].agent->position_;
+		agent_grid[i].cell = agent_grid_cell_key(Math::floor(position.x() * inv_cell_size), Math::floor(position.y() * inv_cell_size), Math::floor(position.z() * inv_cell_size));
+	}
+	// The agents barely move between two steps, the order of the previous one is almost right.
+	std::sort(agent_grid.begin(), agent_grid.end());
+
+	agent_grid_x.resize(agent_grid.size());
+	agent_grid_y.resize(agent_grid.size());
+	agent_grid_z.resize(agent_grid.size());
+	agent_grid_cells.clear();
+	agent_grid_cell_starts.clear();
+	for (size_t i(0); i < agent_grid.size(); i++) {
+		const RVO::Vector3 &position = agent_grid[i].agent->position_;
+		agent_grid_x[i] = position.x();
+		agent_grid_y[i] = position.y();
+		agent_grid_z[i] = position.z();
+		if (i == 0 || agent_grid[i].cell != agent_grid[i - 1].cell) {
+			agent_grid_cells.push_back(agent_grid[i].cell);
+			agent_grid_cell_starts.push_back(i);
+		}
+	}
+	agent_grid_cell_starts.push_back(agent_grid.size());
+}
+
+void NavMap::compute_agent_neighbors(RVO::Agent *p_agent) const {
+	// Same result as `RVO::KdTree::computeAgentNeighbors()`.
+	float range_sq = p_agent->neighborDist_ * p_agent->neighborDist_;
+	const float x = p_agent->position_.x();
+	const float y = p_agent->position_.y();
+	const float z = p_agent->position_.z();
+	const float inv_cell_size = 1.0 / agent_grid_cell_size;
+	const int64_t cell_x = Math::floor(x * inv_cell_size);
+	const int64_t cell_y = Math::floor(y * inv_cell_size);
+	const int64_t cell_z = Math::floor(z * inv_cell_size);
+
+	for (int64_t i = -1; i <= 1; i++) {
+		for (int64_t j = -1; j <= 1; j++) {
+			for (int64_t k = -1; k <= 1; k++) {
+				const uint64_t cell = agent_grid_cell_key(cell_x + i, cell_y + j, cell_z + k);
+				const std::vector<uint64_t>::const_iterator it = std::lower_bound(agent_grid_cells.begin(), agent_grid_cells.end(), cell);
+				if (it == agent_grid_cells.end() || *it != cell) {
+					continue;
+				}
+				const size_t cell_index = it - agent_grid_cells.begin();
+				const uint32_t from = agent_grid_cell_starts[cell_index];
+				const uint32_t to = agent_grid_cell_starts[cell_index + 1];
+
+				// Compute the distances in batches, this loop vectorizes, and
+				// only insert the agents in range.
+				const uint32_t BATCH_SIZE = 64;
+				float distances_sq[BATCH_SIZE];
+				for (uint32_t batch = from; batch < to; batch += BATCH_SIZE) {
+					const uint32_t count = MIN(BATCH_SIZE, to - batch);
+					const float *xs = &agent_grid_x[batch];
+					const float *ys = &agent_grid_y[batch];
+					const float *zs = &agent_grid_z[batch];
+					for (uint32_t l = 0; l < count; l++) {
+						const float dx = xs[l] - x;
+						const float dy = ys[l] - y;
+						const float dz = zs[l] - z;
+						distances_sq[l] = dx * dx + dy * dy + dz * dz;
+					}
+					for (uint32_t l = 0; l < count; l++) {
+						if (distances_sq[l] < range_sq) {
+							p_agent->insertAgentNeighbor(agent_grid[batch + l].agent, range_sq);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
 void NavMap::compute_single_step(uint32_t index, RvoAgent **agent) {
-	(*(agent + index))->get_agent()->computeNeighbors(&rvo);
-	(*(agent + index))->get_agent()->computeNewVelocity(deltatime);
+	RVO::Agent *rvo_agent = (*(agent + index))->get_agent();
+	rvo_agent->agentNeighbors_.clear();
+	if (rvo_agent->maxNeighbors_ > 0) {
+		compute_agent_neighbors(rvo_agent);
+	}
+	rvo_agent->computeNewVelocity(deltatime);
 }
 
 void NavMap::step(real_t p_deltatime) {
 	deltatime = p_deltatime;
 	if (controlled_agents.size() > 0) {
+		build_agent_grid();
 		thread_process_array(
 				controlled_agents.size(),
 				this,
@@ -33,10 +33,11 @@
 
 #include "nav_rid.h"
 
+#include "core/math/aabb.h"
 #include "core/math/math_defs.h"
 #include "core/templates/map.h"
 #include "nav_utils.h"
-#include <KdTree.h>
+#include <Agent.h>
 
 /**
 	@author AndreaCatania
@@ -65,8 +66,56 @@ class NavMap : public NavRid {
 	/// Map polygons
 	std::vector<gd::Polygon> polygons;
 
-	/// Rvo world
-	RVO::KdTree rvo;
+	/// Bounding volume hierarchy over the map polygons, rebuilt with them.
+	/// The closest point and path queries walk it instead of every polygon.
+	struct PolygonBVHNode {
+		AABB aabb;
+		/// First child for inner nodes (the second one follows it),
+		/// first entry of `polygon_bvh_indices` for leaves.
+		uint32_t first = 0;
+		/// Polygon count of leaves, zero for inner nodes.
+		uint32_t count = 0;
+	};
+
+	std::vector<PolygonBVHNode> polygon_bvh;
+	std::vector<uint32_t> polygon_bvh_indices;
+
+	/// Groups of neighbour polygons taken from the BVH. The path queries
+	/// crossing several clusters search the cluster graph first, then only
+	/// explore the polygons of the clusters along the route found.
+	struct PolygonCluster {
+		Vector3 center;
+		uint32_t polygon_count = 0;
+		/// The clusters connected to this one, in `polygon_cluster_links`.
+		uint32_t first_link = 0;
+		uint32_t link_count = 0;
+	};
+
+	std::vector<PolygonCluster> polygon_clusters;
+	std::vector<uint32_t> polygon_cluster_links;
+
+	/// Buffers reused by the path queries a thread runs.
+	struct PathQueryScratch;
+	static thread_local PathQueryScratch path_query_scratch;
+
+	/// Avoidance grid: the agents sorted by cell, with their positions laid
+	/// out contiguously for the neighbor queries. Rebuilt every step, its
+	/// cells are as large as the longest neighbor distance.
+	struct AgentGridEntry {
+		uint64_t cell = 0;
+		RVO::Agent *agent = nullptr;
+
+		bool operator<(const AgentGridEntry &p_other) const { return cell < p_other.cell; }
+	};
+
+	std::vector<AgentGridEntry> agent_grid;
+	std::vector<float> agent_grid_x;
+	std::vector<float> agent_grid_y;
+	std::vector<float> agent_grid_z;
+	/// The occupied cells, sorted, and where their agents start in the grid.
+	std::vector<uint64_t> agent_grid_cells;
+	std::vector<uint32_t> agent_grid_cell_starts;
+	float agent_grid_cell_size = 1.0;
 
 	/// Is agent array modified?
 	bool agents_dirty = false;
@@ -104,6 +153,8 @@ public:
 	gd::PointKey get_point_key(const Vector3 &p_pos) const;
 
 	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_layers = 1) const;
+	void compute_flow_field(const Vector3 &p_target, uint32_t p_layers, gd::FlowField &r_field) const;
+	Vector3 get_flow_field_direction(const gd::FlowField &p_field, const Vector3 &p_point, uint32_t p_layers) const;
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const;
 	Vector3 get_closest_point(const Vector3 &p_point) const;
 	Vector3 get_closest_point_normal(const Vector3 &p_point) const;
@@ -135,6 +186,18 @@ public:
 
 private:
 	void compute_single_step(uint32_t index, RvoAgent **agent);
+
+	void build_agent_grid();
+	void compute_agent_neighbors(RVO::Agent *p_agent) const;
+
+	const gd::Polygon *get_closest_polygon(const Vector3 &p_point, uint32_t p_layers, Vector3 &r_point) const;
+
+	void build_polygon_bvh();
+	void build_polygon_bvh_node(uint32_t p_node, uint32_t p_from, uint32_t p_to, const std::vector<AABB> &p_polygon_aabbs, bool p_clustered);
+	void build_polygon_cluster_links();
+	bool find_cluster_corridor(uint32_t p_begin_cluster, uint32_t p_end_cluster, const Vector3 &p_end_point, PathQueryScratch &r_scratch) const;
+	template <class D, class V>
+	void query_polygon_bvh(const D &p_aabb_distance, const V &p_visit_polygon, real_t &r_closest_distance) const;
 	void clip_path(const std::vector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly) const;
 };
 
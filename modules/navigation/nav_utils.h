@@ -94,6 +94,12 @@ struct Edge {
 struct Polygon {
 	NavRegion *owner;
 
+	/// The index of this `Polygon` in the map.
+	uint32_t id = 0;
+
+	/// The map cluster this `Polygon` belongs to.
+	uint32_t cluster = 0;
+
 	/// The points of this `Polygon`
 	std::vector<Point> points;
 
@@ -122,6 +128,8 @@ struct NavigationPoly {
 	Vector3 entry;
 	/// The distance to the destination.
 	float traveled_distance = 0.0;
+	/// The neighbours of this poly have been explored.
+	bool closed = false;
 
 	NavigationPoly(const Polygon *p_poly) :
 			poly(p_poly) {}
@@ -135,6 +143,24 @@ struct NavigationPoly {
 	}
 };
 
+/// Travel field towards a target over the polygons of a map.
+struct FlowField {
+	/// The map state the field was computed for.
+	uint32_t map_update_id = 0;
+
+	/// The target, moved onto the map, and its polygon; -1 if the map has
+	/// no polygon the target can be moved to.
+	Vector3 target;
+	int32_t target_polygon = -1;
+
+	/// Per map polygon: the point to head to, the polygon entered there and
+	/// the travel distance to the target from that point. Polygons the
+	/// target can't be reached from are left at a distance of 1e30.
+	std::vector<Vector3> waypoints;
+	std::vector<int32_t> next_polygons;
+	std::vector<float> distances;
+};
+
 } // namespace gd
 
 #endif // NAV_UTILS_H
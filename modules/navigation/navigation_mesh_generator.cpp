@@ -34,6 +34,7 @@
 
 #include "core/math/convex_hull.h"
 #include "core/os/thread.h"
+#include "core/os/worker_thread_pool.h"
 #include "scene/3d/collision_shape_3d.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/3d/physics_body_3d.h"
@@ -273,14 +274,13 @@ void NavigationMeshGenerator::_parse_geometry(Transform3D p_accumulated_transfor
 	}
 }
 
-void NavigationMeshGenerator::_convert_detail_mesh_to_native_navigation_mesh(const rcPolyMeshDetail *p_detail_mesh, Ref<NavigationMesh> p_nav_mesh) {
-	Vector<Vector3> nav_vertices;
-
+void NavigationMeshGenerator::_convert_detail_mesh_to_tile(const rcPolyMeshDetail *p_detail_mesh, BakedTile &r_tile) {
+	r_tile.vertices.resize(p_detail_mesh->nverts);
+	Vector3 *vertices_w = r_tile.vertices.ptrw();
 	for (int i = 0; i < p_detail_mesh->nverts; i++) {
 		const float *v = &p_detail_mesh->verts[i * 3];
-		nav_vertices.push_back(Vector3(v[0], v[1], v[2]));
+		vertices_w[i] = Vector3(v[0], v[1], v[2]);
 	}
-	p_nav_mesh->set_vertices(nav_vertices);
 
 	for (int i = 0; i < p_detail_mesh->nmeshes; i++) {
 		const unsigned int *m = &p_detail_mesh->meshes[i * 4];
@@ -289,31 +289,153 @@ void NavigationMeshGenerator::_convert_detail_mesh_to_native_navigation_mesh(con
 		const unsigned int ntris = m[3];
 		const unsigned char *tris = &p_detail_mesh->tris[btris * 4];
 		for (unsigned int j = 0; j < ntris; j++) {
-			Vector<int> nav_indices;
-			nav_indices.resize(3);
 			// Polygon order in recast is opposite than godot's
-			nav_indices.write[0] = ((int)(bverts + tris[j * 4 + 0]));
-			nav_indices.write[1] = ((int)(bverts + tris[j * 4 + 2]));
-			nav_indices.write[2] = ((int)(bverts + tris[j * 4 + 1]));
-			p_nav_mesh->add_polygon(nav_indices);
+			r_tile.triangles.push_back((int)(bverts + tris[j * 4 + 0]));
+			r_tile.triangles.push_back((int)(bverts + tris[j * 4 + 2]));
+			r_tile.triangles.push_back((int)(bverts + tris[j * 4 + 1]));
 		}
 	}
 }
 
+// Frees the Recast intermediate data of a tile build, whichever step it fails at.
+struct RecastTileData {
+	rcHeightfield *hf = nullptr;
+	rcCompactHeightfield *chf = nullptr;
+	rcContourSet *cset = nullptr;
+	rcPolyMesh *poly_mesh = nullptr;
+	rcPolyMeshDetail *detail_mesh = nullptr;
+
+	~RecastTileData() {
+		rcFreeHeightField(hf);
+		rcFreeCompactHeightfield(chf);
+		rcFreeContourSet(cset);
+		rcFreePolyMesh(poly_mesh);
+		rcFreePolyMeshDetail(detail_mesh);
+	}
+};
+
+bool NavigationMeshGenerator::_build_recast_tile(const Ref<NavigationMesh> &p_nav_mesh, const rcConfig &p_cfg, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris, BakedTile &r_tile) {
+	rcContext ctx;
+	RecastTileData data;
+
+	data.hf = rcAllocHeightfield();
+
+	ERR_FAIL_COND_V(!data.hf, false);
+	ERR_FAIL_COND_V(!rcCreateHeightfield(&ctx, *data.hf, p_cfg.width, p_cfg.height, p_cfg.bmin, p_cfg.bmax, p_cfg.cs, p_cfg.ch), false);
+
+	{
+		Vector<unsigned char> tri_areas;
+		tri_areas.resize(p_ntris);
+
+		ERR_FAIL_COND_V(tri_areas.size() == 0, false);
+
+		memset(tri_areas.ptrw(), 0, p_ntris * sizeof(unsigned char));
+		rcMarkWalkableTriangles(&ctx, p_cfg.walkableSlopeAngle, p_verts, p_nverts, p_tris, p_ntris, tri_areas.ptrw());
+
+		ERR_FAIL_COND_V(!rcRasterizeTriangles(&ctx, p_verts, p_nverts, p_tris, tri_areas.ptr(), p_ntris, *data.hf, p_cfg.walkableClimb), false);
+	}
+
+	if (p_nav_mesh->get_filter_low_hanging_obstacles()) {
+		rcFilterLowHangingWalkableObstacles(&ctx, p_cfg.walkableClimb, *data.hf);
+	}
+	if (p_nav_mesh->get_filter_ledge_spans()) {
+		rcFilterLedgeSpans(&ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *data.hf);
+	}
+	if (p_nav_mesh->get_filter_walkable_low_height_spans()) {
+		rcFilterWalkableLowHeightSpans(&ctx, p_cfg.walkableHeight, *data.hf);
+	}
+
+	data.chf = rcAllocCompactHeightfield();
+
+	ERR_FAIL_COND_V(!data.chf, false);
+	ERR_FAIL_COND_V(!rcBuildCompactHeightfield(&ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *data.hf, *data.chf), false);
+
+	rcFreeHeightField(data.hf);
+	data.hf = nullptr;
+
+	ERR_FAIL_COND_V(!rcErodeWalkableArea(&ctx, p_cfg.walkableRadius, *data.chf), false);
+
+	// The tile border is excluded from the regions, neighbour tiles then meet exactly at their edges.
+	if (p_nav_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
+		ERR_FAIL_COND_V(!rcBuildDistanceField(&ctx, *data.chf), false);
+		ERR_FAIL_COND_V(!rcBuildRegions(&ctx, *data.chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), false);
+	} else if (p_nav_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
+		ERR_FAIL_COND_V(!rcBuildRegionsMonotone(&ctx, *data.chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), false);
+	} else {
+		ERR_FAIL_COND_V(!rcBuildLayerRegions(&ctx, *data.chf, p_cfg.borderSize, p_cfg.minRegionArea), false);
+	}
+
+	data.cset = rcAllocContourSet();
+
+	ERR_FAIL_COND_V(!data.cset, false);
+	ERR_FAIL_COND_V(!rcBuildContours(&ctx, *data.chf, p_cfg.maxSimplificationError, p_cfg.maxEdgeLen, *data.cset), false);
+
+	if (data.cset->nconts == 0) {
+		// Nothing walkable in this tile.
+		return true;
+	}
+
+	data.poly_mesh = rcAllocPolyMesh();
+	ERR_FAIL_COND_V(!data.poly_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMesh(&ctx, *data.cset, p_cfg.maxVertsPerPoly, *data.poly_mesh), false);
+
+	data.detail_mesh = rcAllocPolyMeshDetail();
+	ERR_FAIL_COND_V(!data.detail_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMeshDetail(&ctx, *data.poly_mesh, *data.chf, p_cfg.detailSampleDist, p_cfg.detailSampleMaxError, *data.detail_mesh), false);
+
+	_convert_detail_mesh_to_tile(data.detail_mesh, r_tile);
+	return true;
+}
+
+void NavigationMeshGenerator::_bake_tile(uint32_t p_index, BakeJob *p_job) {
+	BakeTile &tile = p_job->tiles[p_index];
+
+	// The tile vertical bounds are the ones of its own triangles.
+	tile.cfg.bmin[1] = 1e30;
+	tile.cfg.bmax[1] = -1e30;
+	for (uint32_t i = 0; i < tile.triangles.size(); i++) {
+		const float y = p_job->verts[tile.triangles[i] * 3 + 1];
+		tile.cfg.bmin[1] = MIN(tile.cfg.bmin[1], y);
+		tile.cfg.bmax[1] = MAX(tile.cfg.bmax[1], y);
+	}
+
+	// The hash covers everything the build depends on: the configuration,
+	// the bake settings that aren't part of it and the source triangles.
+	uint64_t hash = hash_djb2_one_64(tile.key);
+	const uint32_t *cfg_data = reinterpret_cast<const uint32_t *>(&tile.cfg);
+	for (uint32_t i = 0; i < sizeof(rcConfig) / sizeof(uint32_t); i++) {
+		hash = hash_djb2_one_64(cfg_data[i], hash);
+	}
+	const Ref<NavigationMesh> &nav_mesh = p_job->nav_mesh;
+	hash = hash_djb2_one_64(nav_mesh->get_sample_partition_type(), hash);
+	hash = hash_djb2_one_64(nav_mesh->get_filter_low_hanging_obstacles() | (nav_mesh->get_filter_ledge_spans() << 1) | (nav_mesh->get_filter_walkable_low_height_spans() << 2), hash);
+	for (uint32_t i = 0; i < tile.triangles.size(); i++) {
+		const uint32_t *v = reinterpret_cast<const uint32_t *>(&p_job->verts[tile.triangles[i] * 3]);
+		hash = hash_djb2_one_64(v[0], hash);
+		hash = hash_djb2_one_64(v[1], hash);
+		hash = hash_djb2_one_64(v[2], hash);
+	}
+
+	const BakedTile *previous = p_job->previous_tiles ? p_job->previous_tiles->getptr(tile.key) : nullptr;
+	if (previous && previous->hash == hash) {
+		tile.result = *previous;
+		return;
+	}
+
+	tile.result.hash = hash;
+	if (!_build_recast_tile(nav_mesh, tile.cfg, p_job->verts, p_job->nverts, tile.triangles.ptr(), tile.triangles.size() / 3, tile.result)) {
+		// Don't let a failed build be reused.
+		tile.result = BakedTile();
+	}
+}
+
 void NavigationMeshGenerator::_build_recast_navigation_mesh(
 		Ref<NavigationMesh> p_nav_mesh,
 #ifdef TOOLS_ENABLED
 		EditorProgress *ep,
 #endif
-		rcHeightfield *hf,
-		rcCompactHeightfield *chf,
-		rcContourSet *cset,
-		rcPolyMesh *poly_mesh,
-		rcPolyMeshDetail *detail_mesh,
 		Vector<float> &vertices,
 		Vector<int> &indices) {
-	rcContext ctx;
-
 #ifdef TOOLS_ENABLED
 	if (ep) {
 		ep->step(TTR("Setting up Configuration..."), 1);
@@ -345,136 +467,157 @@ void NavigationMeshGenerator::_build_recast_navigation_mesh(
 	cfg.detailSampleDist = p_nav_mesh->get_detail_sample_distance() < 0.9f ? 0 : p_nav_mesh->get_cell_size() * p_nav_mesh->get_detail_sample_distance();
 	cfg.detailSampleMaxError = p_nav_mesh->get_cell_height() * p_nav_mesh->get_detail_sample_max_error();
 
-	cfg.bmin[0] = bmin[0];
-	cfg.bmin[1] = bmin[1];
-	cfg.bmin[2] = bmin[2];
-	cfg.bmax[0] = bmax[0];
-	cfg.bmax[1] = bmax[1];
-	cfg.bmax[2] = bmax[2];
+	// Split the source triangles among the tiles they overlap, border included.
+	// The tile grid is anchored at the origin so that geometry changes only
+	// affect the tiles they touch.
+	LocalVector<BakeTile> tiles;
+	const int tile_size = p_nav_mesh->get_tile_size();
+	if (tile_size <= 0) {
+		tiles.resize(1);
+		BakeTile &tile = tiles[0];
+		tile.cfg = cfg;
+		for (int i = 0; i < 3; i++) {
+			tile.cfg.bmin[i] = bmin[i];
+			tile.cfg.bmax[i] = bmax[i];
+		}
+		rcCalcGridSize(tile.cfg.bmin, tile.cfg.bmax, tile.cfg.cs, &tile.cfg.width, &tile.cfg.height);
+		tile.triangles.resize(ntris * 3);
+		memcpy(tile.triangles.ptr(), tris, ntris * 3 * sizeof(int));
+	} else {
+		cfg.tileSize = tile_size;
+		cfg.borderSize = cfg.walkableRadius + 3;
+		cfg.width = cfg.tileSize + cfg.borderSize * 2;
+		cfg.height = cfg.tileSize + cfg.borderSize * 2;
+
+		const float tile_width = cfg.tileSize * cfg.cs;
+		const float border_width = cfg.borderSize * cfg.cs;
+
+		HashMap<uint64_t, uint32_t> tile_indices;
+		for (int i = 0; i < ntris; i++) {
+			float tri_min[2] = { 1e30, 1e30 };
+			float tri_max[2] = { -1e30, -1e30 };
+			for (int j = 0; j < 3; j++) {
+				const float *v = &verts[tris[i * 3 + j] * 3];
+				tri_min[0] = MIN(tri_min[0], v[0]);
+				tri_min[1] = MIN(tri_min[1], v[2]);
+				tri_max[0] = MAX(tri_max[0], v[0]);
+				tri_max[1] = MAX(tri_max[1], v[2]);
+			}
 
-#ifdef TOOLS_ENABLED
-	if (ep) {
-		ep->step(TTR("Calculating grid size..."), 2);
+			const int x_from = (int)Math::floor((tri_min[0] - border_width) / tile_width);
+			const int x_to = (int)Math::floor((tri_max[0] + border_width) / tile_width);
+			const int z_from = (int)Math::floor((tri_min[1] - border_width) / tile_width);
+			const int z_to = (int)Math::floor((tri_max[1] + border_width) / tile_width);
+			for (int z = z_from; z <= z_to; z++) {
+				for (int x = x_from; x <= x_to; x++) {
+					const uint64_t key = (uint64_t(uint32_t(x)) << 32) | uint32_t(z);
+					uint32_t *index = tile_indices.getptr(key);
+					if (!index) {
+						tiles.resize(tiles.size() + 1);
+						BakeTile &tile = tiles[tiles.size() - 1];
+						tile.key = key;
+						tile.cfg = cfg;
+						tile.cfg.bmin[0] = x * tile_width - border_width;
+						tile.cfg.bmin[2] = z * tile_width - border_width;
+						tile.cfg.bmax[0] = (x + 1) * tile_width + border_width;
+						tile.cfg.bmax[2] = (z + 1) * tile_width + border_width;
+						index = &tile_indices.set(key, tiles.size() - 1)->value();
+					}
+					BakeTile &tile = tiles[*index];
+					tile.triangles.push_back(tris[i * 3 + 0]);
+					tile.triangles.push_back(tris[i * 3 + 1]);
+					tile.triangles.push_back(tris[i * 3 + 2]);
+				}
+			}
+		}
 	}
-#endif
-	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
 
 #ifdef TOOLS_ENABLED
 	if (ep) {
-		ep->step(TTR("Creating heightfield..."), 3);
+		ep->step(TTR("Building tiles..."), 2);
 	}
 #endif
-	hf = rcAllocHeightfield();
-
-	ERR_FAIL_COND(!hf);
-	ERR_FAIL_COND(!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch));
 
-#ifdef TOOLS_ENABLED
-	if (ep) {
-		ep->step(TTR("Marking walkable triangles..."), 4);
-	}
-#endif
+	const uint64_t nav_mesh_id = p_nav_mesh->get_instance_id();
+	HashMap<uint64_t, BakedTile> previous_tiles;
 	{
-		Vector<unsigned char> tri_areas;
-		tri_areas.resize(ntris);
-
-		ERR_FAIL_COND(tri_areas.size() == 0);
-
-		memset(tri_areas.ptrw(), 0, ntris * sizeof(unsigned char));
-		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts, nverts, tris, ntris, tri_areas.ptrw());
-
-		ERR_FAIL_COND(!rcRasterizeTriangles(&ctx, verts, nverts, tris, tri_areas.ptr(), ntris, *hf, cfg.walkableClimb));
-	}
-
-	if (p_nav_mesh->get_filter_low_hanging_obstacles()) {
-		rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *hf);
-	}
-	if (p_nav_mesh->get_filter_ledge_spans()) {
-		rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf);
-	}
-	if (p_nav_mesh->get_filter_walkable_low_height_spans()) {
-		rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *hf);
-	}
-
-#ifdef TOOLS_ENABLED
-	if (ep) {
-		ep->step(TTR("Constructing compact heightfield..."), 5);
+		MutexLock lock(baked_tiles_mutex);
+		const HashMap<uint64_t, BakedTile> *cached = baked_tiles.getptr(nav_mesh_id);
+		if (cached) {
+			previous_tiles = *cached;
+		}
 	}
-#endif
 
-	chf = rcAllocCompactHeightfield();
+	BakeJob job;
+	job.nav_mesh = p_nav_mesh;
+	job.verts = verts;
+	job.nverts = nverts;
+	job.tris = tris;
+	job.tiles = tiles.ptr();
+	job.previous_tiles = &previous_tiles;
 
-	ERR_FAIL_COND(!chf);
-	ERR_FAIL_COND(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf));
-
-	rcFreeHeightField(hf);
-	hf = nullptr;
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavigationMeshGenerator::_bake_tile, &job, tiles.size());
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
 
 #ifdef TOOLS_ENABLED
 	if (ep) {
-		ep->step(TTR("Eroding walkable area..."), 6);
+		ep->step(TTR("Converting to native navigation mesh..."), 3);
 	}
 #endif
 
-	ERR_FAIL_COND(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf));
-
-#ifdef TOOLS_ENABLED
-	if (ep) {
-		ep->step(TTR("Partitioning..."), 7);
-	}
-#endif
+	// Weld the tile vertices, the ones on the shared tile edges match up to
+	// the cell size.
+	Vector<Vector3> nav_vertices;
+	HashMap<uint64_t, int> vertex_indices;
+	HashMap<uint64_t, BakedTile> baked;
+	for (uint32_t i = 0; i < tiles.size(); i++) {
+		const BakedTile &result = tiles[i].result;
+		if (result.hash != 0) {
+			baked.set(tiles[i].key, result);
+		}
 
-	if (p_nav_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
-		ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *chf));
-		ERR_FAIL_COND(!rcBuildRegions(&ctx, *chf, 0, cfg.minRegionArea, cfg.mergeRegionArea));
-	} else if (p_nav_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
-		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *chf, 0, cfg.minRegionArea, cfg.mergeRegionArea));
-	} else {
-		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *chf, 0, cfg.minRegionArea));
-	}
+		LocalVector<int> remap;
+		remap.resize(result.vertices.size());
+		for (int j = 0; j < result.vertices.size(); j++) {
+			const Vector3 &v = result.vertices[j];
+			const uint64_t key = (uint64_t(int64_t(Math::round(v.x / cfg.cs)) & 0x1FFFFF) << 43) | (uint64_t(int64_t(Math::round(v.y / cfg.ch)) & 0x3FFFFF) << 21) | (uint64_t(int64_t(Math::round(v.z / cfg.cs)) & 0x1FFFFF));
+			const int *index = vertex_indices.getptr(key);
+			if (index) {
+				remap[j] = *index;
+			} else {
+				remap[j] = nav_vertices.size();
+				vertex_indices.set(key, remap[j]);
+				nav_vertices.push_back(v);
+			}
+		}
 
-#ifdef TOOLS_ENABLED
-	if (ep) {
-		ep->step(TTR("Creating contours..."), 8);
+		for (int j = 0; j < result.triangles.size(); j += 3) {
+			Vector<int> nav_indices;
+			nav_indices.resize(3);
+			nav_indices.write[0] = remap[result.triangles[j + 0]];
+			nav_indices.write[1] = remap[result.triangles[j + 1]];
+			nav_indices.write[2] = remap[result.triangles[j + 2]];
+			if (nav_indices[0] == nav_indices[1] || nav_indices[1] == nav_indices[2] || nav_indices[2] == nav_indices[0]) {
+				continue; // Collapsed by the welding.
+			}
+			p_nav_mesh->add_polygon(nav_indices);
+		}
 	}
-#endif
-
-	cset = rcAllocContourSet();
+	p_nav_mesh->set_vertices(nav_vertices);
 
-	ERR_FAIL_COND(!cset);
-	ERR_FAIL_COND(!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset));
+	MutexLock lock(baked_tiles_mutex);
+	baked_tiles.set(nav_mesh_id, baked);
 
-#ifdef TOOLS_ENABLED
-	if (ep) {
-		ep->step(TTR("Creating polymesh..."), 9);
+	// Forget about the navigation meshes that are gone.
+	LocalVector<uint64_t> stale;
+	for (const uint64_t *key = baked_tiles.next(nullptr); key; key = baked_tiles.next(key)) {
+		if (!ObjectDB::get_instance(ObjectID(*key))) {
+			stale.push_back(*key);
+		}
 	}
-#endif
-
-	poly_mesh = rcAllocPolyMesh();
-	ERR_FAIL_COND(!poly_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *poly_mesh));
-
-	detail_mesh = rcAllocPolyMeshDetail();
-	ERR_FAIL_COND(!detail_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *detail_mesh));
-
-	rcFreeCompactHeightfield(chf);
-	chf = nullptr;
-	rcFreeContourSet(cset);
-	cset = nullptr;
-
-#ifdef TOOLS_ENABLED
-	if (ep) {
-		ep->step(TTR("Converting to native navigation mesh..."), 10);
+	for (uint32_t i = 0; i < stale.size(); i++) {
+		baked_tiles.erase(stale[i]);
 	}
-#endif
-
-	_convert_detail_mesh_to_native_navigation_mesh(detail_mesh, p_nav_mesh);
-
-	rcFreePolyMesh(poly_mesh);
-	poly_mesh = nullptr;
-	rcFreePolyMeshDetail(detail_mesh);
-	detail_mesh = nullptr;
 }
 
 NavigationMeshGenerator *NavigationMeshGenerator::get_singleton() {
@@ -494,7 +637,7 @@ void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node)
 #ifdef TOOLS_ENABLED
 	EditorProgress *ep(nullptr);
 	if (Engine::get_singleton()->is_editor_hint()) {
-		ep = memnew(EditorProgress("bake", TTR("Navigation Mesh Generator Setup:"), 11));
+		ep = memnew(EditorProgress("bake", TTR("Navigation Mesh Generator Setup:"), 4));
 	}
 
 	if (ep) {
@@ -522,44 +665,18 @@ void NavigationMeshGenerator::bake(Ref<NavigationMesh> p_nav_mesh, Node *p_node)
 	}
 
 	if (vertices.size() > 0 && indices.size() > 0) {
-		rcHeightfield *hf = nullptr;
-		rcCompactHeightfield *chf = nullptr;
-		rcContourSet *cset = nullptr;
-		rcPolyMesh *poly_mesh = nullptr;
-		rcPolyMeshDetail *detail_mesh = nullptr;
-
 		_build_recast_navigation_mesh(
 				p_nav_mesh,
 #ifdef TOOLS_ENABLED
 				ep,
 #endif
-				hf,
-				chf,
-				cset,
-				poly_mesh,
-				detail_mesh,
 				vertices,
 				indices);
-
-		rcFreeHeightField(hf);
-		hf = nullptr;
-
-		rcFreeCompactHeightfield(chf);
-		chf = nullptr;
-
-		rcFreeContourSet(cset);
-		cset = nullptr;
-
-		rcFreePolyMesh(poly_mesh);
-		poly_mesh = nullptr;
-
-		rcFreePolyMeshDetail(detail_mesh);
-		detail_mesh = nullptr;
 	}
 
 #ifdef TOOLS_ENABLED
 	if (ep) {
-		ep->step(TTR("Done!"), 11);
+		ep->step(TTR("Done!"), 4);
 	}
 
 	if (ep) {
@@ -33,6 +33,9 @@
 
 #ifndef _3D_DISABLED
 
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "scene/3d/navigation_region_3d.h"
 
 #include <Recast.h>
@@ -46,6 +49,37 @@ class NavigationMeshGenerator : public Object {
 
 	static NavigationMeshGenerator *singleton;
 
+	/// The result of a tile build, kept so the next bake of the same
+	/// navigation mesh can reuse the tiles whose source geometry is the same.
+	struct BakedTile {
+		uint64_t hash = 0;
+		Vector<Vector3> vertices;
+		Vector<int> triangles;
+	};
+
+	struct BakeTile {
+		uint64_t key = 0;
+		rcConfig cfg;
+		/// The source triangles overlapping the tile and its border.
+		LocalVector<int> triangles;
+		BakedTile result;
+	};
+
+	struct BakeJob {
+		Ref<NavigationMesh> nav_mesh;
+		const float *verts = nullptr;
+		int nverts = 0;
+		const int *tris = nullptr;
+		BakeTile *tiles = nullptr;
+		const HashMap<uint64_t, BakedTile> *previous_tiles = nullptr;
+	};
+
+	/// Tiles of the last bake of each navigation mesh, by instance ID.
+	Mutex baked_tiles_mutex;
+	HashMap<uint64_t, HashMap<uint64_t, BakedTile>> baked_tiles;
+
+	void _bake_tile(uint32_t p_index, BakeJob *p_job);
+
 protected:
 	static void _bind_methods();
 
@@ -54,17 +88,13 @@ protected:
 	static void _add_faces(const PackedVector3Array &p_faces, const Transform3D &p_xform, Vector<float> &p_verticies, Vector<int> &p_indices);
 	static void _parse_geometry(Transform3D p_accumulated_transform, Node *p_node, Vector<float> &p_verticies, Vector<int> &p_indices, NavigationMesh::ParsedGeometryType p_generate_from, uint32_t p_collision_mask, bool p_recurse_children);
 
-	static void _convert_detail_mesh_to_native_navigation_mesh(const rcPolyMeshDetail *p_detail_mesh, Ref<NavigationMesh> p_nav_mesh);
-	static void _build_recast_navigation_mesh(
+	static void _convert_detail_mesh_to_tile(const rcPolyMeshDetail *p_detail_mesh, BakedTile &r_tile);
+	static bool _build_recast_tile(const Ref<NavigationMesh> &p_nav_mesh, const rcConfig &p_cfg, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris, BakedTile &r_tile);
+	void _build_recast_navigation_mesh(
 			Ref<NavigationMesh> p_nav_mesh,
 #ifdef TOOLS_ENABLED
 			EditorProgress *ep,
 #endif
-			rcHeightfield *hf,
-			rcCompactHeightfield *chf,
-			rcContourSet *cset,
-			rcPolyMesh *poly_mesh,
-			rcPolyMeshDetail *detail_mesh,
 			Vector<float> &vertices,
 			Vector<int> &indices);
 
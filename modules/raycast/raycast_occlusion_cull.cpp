@@ -78,9 +78,21 @@ void RaycastOcclusionCull::RaycastHZBuffer::resize(const Size2i &p_size) {
 	memset(camera_ray_masks.ptr(), ~0, camera_rays_tile_count * TILE_RAYS * sizeof(uint32_t));
 }
 
-void RaycastOcclusionCull::RaycastHZBuffer::update_camera_rays(const Transform3D &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, ThreadWorkPool &p_thread_work_pool) {
+void RaycastOcclusionCull::RaycastHZBuffer::apply_resolution_scale() {
+	applied_resolution_scale = resolution_scale;
+
+	if (requested_size == Size2i()) {
+		resize(Size2i());
+		return;
+	}
+
+	// The scale applies to the ray count, so each axis gets its square root.
+	float axis_scale = Math::sqrt(applied_resolution_scale);
+	resize(Size2i(MAX(1, int(requested_size.x * axis_scale)), MAX(1, int(requested_size.y * axis_scale))));
+}
+
+void RaycastOcclusionCull::RaycastHZBuffer::update_camera_rays(const Transform3D &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal) {
 	CameraRayThreadData td;
-	td.thread_count = p_thread_work_pool.get_thread_count();
 
 	td.z_near = p_cam_projection.get_z_near();
 	td.z_far = p_cam_projection.get_z_far() * 1.05f;
@@ -106,15 +118,12 @@ void RaycastOcclusionCull::RaycastHZBuffer::update_camera_rays(const Transform3D
 
 	debug_tex_range = td.z_far;
 
-	p_thread_work_pool.do_work(td.thread_count, this, &RaycastHZBuffer::_camera_rays_threaded, &td);
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RaycastHZBuffer::_camera_rays_threaded, &td, camera_rays_tile_count, -1, 64);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
 }
 
-void RaycastOcclusionCull::RaycastHZBuffer::_camera_rays_threaded(uint32_t p_thread, const CameraRayThreadData *p_data) {
-	uint32_t total_tiles = camera_rays_tile_count;
-	uint32_t total_threads = p_data->thread_count;
-	uint32_t from = p_thread * total_tiles / total_threads;
-	uint32_t to = (p_thread + 1 == total_threads) ? total_tiles : ((p_thread + 1) * total_tiles / total_threads);
-	_generate_camera_rays(p_data, from, to);
+void RaycastOcclusionCull::RaycastHZBuffer::_camera_rays_threaded(uint32_t p_tile, const CameraRayThreadData *p_data) {
+	_generate_camera_rays(p_data, p_tile, p_tile + 1);
 }
 
 void RaycastOcclusionCull::RaycastHZBuffer::_generate_camera_rays(const CameraRayThreadData *p_data, int p_from, int p_to) {
@@ -484,7 +493,7 @@ void RaycastOcclusionCull::Scenario::_raycast(uint32_t p_idx, const RaycastThrea
 	rtcIntersect16((const int *)&p_raycast_data->masks[p_idx * TILE_RAYS], ebr_scene[current_scene_idx], &ctx, &p_raycast_data->rays[p_idx]);
 }
 
-void RaycastOcclusionCull::Scenario::raycast(CameraRayTile *r_rays, const uint32_t *p_valid_masks, uint32_t p_tile_count, ThreadWorkPool &p_thread_pool) const {
+void RaycastOcclusionCull::Scenario::raycast(CameraRayTile *r_rays, const uint32_t *p_valid_masks, uint32_t p_tile_count) const {
 	ERR_FAIL_COND(singleton == nullptr);
 	if (raycast_singleton->ebr_device == nullptr) {
 		return; // Embree is initialized on demand when there is some scenario with occluders in it.
@@ -498,7 +507,8 @@ void RaycastOcclusionCull::Scenario::raycast(CameraRayTile *r_rays, const uint32
 	td.rays = r_rays;
 	td.masks = p_valid_masks;
 
-	p_thread_pool.do_work(p_tile_count, this, &Scenario::_raycast, &td);
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Scenario::_raycast, &td, p_tile_count, -1, 4);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
 }
 
 ////////////////////////////////////////////////////////
@@ -510,6 +520,7 @@ void RaycastOcclusionCull::add_buffer(RID p_buffer) {
 
 void RaycastOcclusionCull::remove_buffer(RID p_buffer) {
 	ERR_FAIL_COND(!buffers.has(p_buffer));
+	_buffer_wait(buffers[p_buffer]);
 	buffers.erase(p_buffer);
 }
 
@@ -521,7 +532,47 @@ void RaycastOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
 
 void RaycastOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
 	ERR_FAIL_COND(!buffers.has(p_buffer));
-	buffers[p_buffer].resize(p_size);
+	RaycastHZBuffer &buffer = buffers[p_buffer];
+	_buffer_wait(buffer);
+	buffer.requested_size = p_size;
+	buffer.apply_resolution_scale();
+}
+
+void RaycastOcclusionCull::_buffer_wait(RaycastHZBuffer &p_buffer) {
+	if (p_buffer.update_task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(p_buffer.update_task);
+		p_buffer.update_task = WorkerThreadPool::INVALID_TASK_ID;
+	}
+}
+
+void RaycastOcclusionCull::_buffer_update_task(RaycastHZBuffer *p_buffer) {
+	uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+
+	p_buffer->update_camera_rays(p_buffer->update_cam_transform, p_buffer->update_cam_projection, p_buffer->update_cam_orthogonal);
+
+	p_buffer->update_scenario->raycast(p_buffer->camera_rays, p_buffer->camera_ray_masks.ptr(), p_buffer->camera_rays_tile_count);
+	p_buffer->sort_rays(-p_buffer->update_cam_transform.basis.get_axis(2), p_buffer->update_cam_orthogonal);
+	p_buffer->update_mips();
+
+	p_buffer->update_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+}
+
+void RaycastOcclusionCull::_buffer_update_resolution_scale(RaycastHZBuffer &p_buffer) {
+	if (time_budget_usec == 0 || p_buffer.update_usec == 0) {
+		return;
+	}
+
+	if (p_buffer.update_usec > time_budget_usec) {
+		p_buffer.resolution_scale = MAX(p_buffer.resolution_scale * 0.9f, 0.25f);
+	} else if (p_buffer.update_usec < time_budget_usec / 2) {
+		p_buffer.resolution_scale = MIN(p_buffer.resolution_scale * 1.05f, 1.0f);
+	}
+
+	// Reallocating the rays has a cost too, only resize once the scale moved noticeably.
+	float delta = p_buffer.resolution_scale - p_buffer.applied_resolution_scale;
+	if (Math::abs(delta) >= 0.1f || (p_buffer.resolution_scale == 1.0f && delta != 0.0f)) {
+		p_buffer.apply_resolution_scale();
+	}
 }
 
 void RaycastOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, ThreadWorkPool &p_thread_pool) {
@@ -529,8 +580,16 @@ void RaycastOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_
 		return;
 	}
 
+	// Scenario updates swap and rebuild the Embree scenes, make sure no other buffer is still tracing them.
+	const RID *buffer_rid = nullptr;
+	while ((buffer_rid = buffers.next(buffer_rid))) {
+		_buffer_wait(buffers[*buffer_rid]);
+	}
+
 	RaycastHZBuffer &buffer = buffers[p_buffer];
 
+	_buffer_update_resolution_scale(buffer);
+
 	if (buffer.is_empty() || !scenarios.has(buffer.scenario_rid)) {
 		return;
 	}
@@ -544,23 +603,29 @@ void RaycastOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_
 		return;
 	}
 
-	buffer.update_camera_rays(p_cam_transform, p_cam_projection, p_cam_orthogonal, p_thread_pool);
-
-	scenario.raycast(buffer.camera_rays, buffer.camera_ray_masks.ptr(), buffer.camera_rays_tile_count, p_thread_pool);
-	buffer.sort_rays(-p_cam_transform.basis.get_axis(2), p_cam_orthogonal);
-	buffer.update_mips();
+	// Trace asynchronously, the renderer keeps setting up lights and other per-frame state meanwhile.
+	// The buffer is waited for when culling fetches it with buffer_get_ptr(), so no latency is added.
+	buffer.update_scenario = &scenario;
+	buffer.update_cam_transform = p_cam_transform;
+	buffer.update_cam_projection = p_cam_projection;
+	buffer.update_cam_orthogonal = p_cam_orthogonal;
+	buffer.update_task = WorkerThreadPool::get_singleton()->add_template_task(this, &RaycastOcclusionCull::_buffer_update_task, &buffer);
 }
 
 RaycastOcclusionCull::HZBuffer *RaycastOcclusionCull::buffer_get_ptr(RID p_buffer) {
 	if (!buffers.has(p_buffer)) {
 		return nullptr;
 	}
-	return &buffers[p_buffer];
+	RaycastHZBuffer &buffer = buffers[p_buffer];
+	_buffer_wait(buffer);
+	return &buffer;
 }
 
 RID RaycastOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
 	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
-	return buffers[p_buffer].get_debug_texture();
+	RaycastHZBuffer &buffer = buffers[p_buffer];
+	_buffer_wait(buffer);
+	return buffer.get_debug_texture();
 }
 
 ////////////////////////////////////////////////////////
@@ -592,9 +657,15 @@ RaycastOcclusionCull::RaycastOcclusionCull() {
 	raycast_singleton = this;
 	int default_quality = GLOBAL_GET("rendering/occlusion_culling/bvh_build_quality");
 	build_quality = RS::ViewportOcclusionCullingBuildQuality(default_quality);
+	time_budget_usec = uint64_t(double(GLOBAL_GET("rendering/occlusion_culling/raycast_time_budget_msec")) * 1000.0);
 }
 
 RaycastOcclusionCull::~RaycastOcclusionCull() {
+	const RID *buffer_rid = nullptr;
+	while ((buffer_rid = buffers.next(buffer_rid))) {
+		_buffer_wait(buffers[*buffer_rid]);
+	}
+
 	const RID *scenario_rid = nullptr;
 	while ((scenario_rid = scenarios.next(scenario_rid))) {
 		Scenario &scenario = scenarios[*scenario_rid];
@@ -35,6 +35,7 @@
 #include "core/math/camera_matrix.h"
 #include "core/object/object.h"
 #include "core/object/ref_counted.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rid_owner.h"
 #include "scene/resources/mesh.h"
@@ -45,13 +46,14 @@
 class RaycastOcclusionCull : public RendererSceneOcclusionCull {
 	typedef RTCRayHit16 CameraRayTile;
 
+	struct Scenario;
+
 public:
 	class RaycastHZBuffer : public HZBuffer {
 	private:
 		Size2i tile_grid_size;
 
 		struct CameraRayThreadData {
-			int thread_count;
 			float z_near;
 			float z_far;
 			Vector3 camera_dir;
@@ -63,7 +65,7 @@ public:
 			Size2i buffer_size;
 		};
 
-		void _camera_rays_threaded(uint32_t p_thread, const CameraRayThreadData *p_data);
+		void _camera_rays_threaded(uint32_t p_tile, const CameraRayThreadData *p_data);
 		void _generate_camera_rays(const CameraRayThreadData *p_data, int p_from, int p_to);
 
 	public:
@@ -73,10 +75,24 @@ public:
 		LocalVector<uint32_t> camera_ray_masks;
 		RID scenario_rid;
 
+		// The raycast runs on the worker pool while the renderer prepares the frame, see buffer_update().
+		WorkerThreadPool::TaskID update_task = WorkerThreadPool::INVALID_TASK_ID;
+		const Scenario *update_scenario = nullptr;
+		Transform3D update_cam_transform;
+		CameraMatrix update_cam_projection;
+		bool update_cam_orthogonal = false;
+		uint64_t update_usec = 0;
+
+		// Size requested by the viewport, the buffer uses it scaled down while raycasting takes longer than the time budget.
+		Size2i requested_size;
+		float resolution_scale = 1.0f;
+		float applied_resolution_scale = 1.0f;
+
 		virtual void clear() override;
 		virtual void resize(const Size2i &p_size) override;
 		void sort_rays(const Vector3 &p_camera_dir, bool p_orthogonal);
-		void update_camera_rays(const Transform3D &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, ThreadWorkPool &p_thread_work_pool);
+		void update_camera_rays(const Transform3D &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal);
+		void apply_resolution_scale();
 
 		~RaycastHZBuffer();
 	};
@@ -148,7 +164,7 @@ private:
 		bool update(ThreadWorkPool &p_thread_pool);
 
 		void _raycast(uint32_t p_thread, const RaycastThreadData *p_raycast_data) const;
-		void raycast(CameraRayTile *r_rays, const uint32_t *p_valid_masks, uint32_t p_tile_count, ThreadWorkPool &p_thread_pool) const;
+		void raycast(CameraRayTile *r_rays, const uint32_t *p_valid_masks, uint32_t p_tile_count) const;
 	};
 
 	static RaycastOcclusionCull *raycast_singleton;
@@ -161,8 +177,12 @@ private:
 	HashMap<RID, Scenario> scenarios;
 	HashMap<RID, RaycastHZBuffer> buffers;
 	RS::ViewportOcclusionCullingBuildQuality build_quality;
+	uint64_t time_budget_usec = 0;
 
 	void _init_embree();
+	void _buffer_update_task(RaycastHZBuffer *p_buffer);
+	void _buffer_wait(RaycastHZBuffer &p_buffer);
+	void _buffer_update_resolution_scale(RaycastHZBuffer &p_buffer);
 
 public:
 	virtual bool is_occluder(RID p_rid) override;
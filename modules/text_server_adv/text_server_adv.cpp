@@ -340,6 +340,7 @@ void TextServerAdvanced::free(RID p_rid) {
 		FontDataAdvanced *fd = font_owner.get_or_null(p_rid);
 		font_owner.free(p_rid);
 		memdelete(fd);
+		_shaped_cache_clear();
 	} else if (shaped_owner.owns(p_rid)) {
 		ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_rid);
 		shaped_owner.free(p_rid);
@@ -728,10 +729,8 @@ _FORCE_INLINE_ TextServerAdvanced::FontTexturePosition TextServerAdvanced::find_
 	for (int i = 0; i < p_data->textures.size(); i++) {
 		const FontTexture &ct = p_data->textures[i];
 
-		if (RenderingServer::get_singleton() != nullptr) {
-			if (ct.texture->get_format() != p_image_format) {
-				continue;
-			}
+		if (ct.format != p_image_format) {
+			continue;
 		}
 
 		if (mw > ct.texture_w || mh > ct.texture_h) { // Too big for this texture.
@@ -991,18 +990,9 @@ _FORCE_INLINE_ TextServerAdvanced::FontGlyph TextServerAdvanced::rasterize_msdf(
 			}
 		}
 
-		// Blit to image and texture.
-		{
-			if (RenderingServer::get_singleton() != nullptr) {
-				Ref<Image> img = memnew(Image(tex.texture_w, tex.texture_h, 0, Image::FORMAT_RGBA8, tex.imgdata));
-				if (tex.texture.is_null()) {
-					tex.texture.instantiate();
-					tex.texture->create_from_image(img);
-				} else {
-					tex.texture->update(img);
-				}
-			}
-		}
+		// Texture is uploaded when first used, or with the other modified textures before the next frame is drawn.
+		tex.dirty = true;
+		textures_dirty.set();
 
 		// Update height array.
 		for (int k = tex_pos.x; k < tex_pos.x + mw; k++) {
@@ -1073,19 +1063,9 @@ _FORCE_INLINE_ TextServerAdvanced::FontGlyph TextServerAdvanced::rasterize_bitma
 		}
 	}
 
-	// Blit to image and texture.
-	{
-		if (RenderingServer::get_singleton() != nullptr) {
-			Ref<Image> img = memnew(Image(tex.texture_w, tex.texture_h, 0, require_format, tex.imgdata));
-
-			if (tex.texture.is_null()) {
-				tex.texture.instantiate();
-				tex.texture->create_from_image(img);
-			} else {
-				tex.texture->update(img);
-			}
-		}
-	}
+	// Texture is uploaded when first used, or with the other modified textures before the next frame is drawn.
+	tex.dirty = true;
+	textures_dirty.set();
 
 	// Update height array.
 	for (int k = tex_pos.x; k < tex_pos.x + mw; k++) {
@@ -1607,6 +1587,47 @@ _FORCE_INLINE_ void TextServerAdvanced::_font_clear_cache(FontDataAdvanced *p_fo
 	p_font_data->supported_scripts.clear();
 }
 
+_FORCE_INLINE_ RID TextServerAdvanced::_font_get_texture_rid(FontTexture &p_tex) const {
+	if (p_tex.texture.is_null()) {
+		Ref<Image> img = memnew(Image(p_tex.texture_w, p_tex.texture_h, 0, p_tex.format, p_tex.imgdata));
+		p_tex.texture.instantiate();
+		p_tex.texture->create_from_image(img);
+		p_tex.dirty = false;
+	} else if (p_tex.dirty) {
+		MutexLock lock(texture_update_mutex);
+		if (!texture_update_connected) {
+			RenderingServer::get_singleton()->connect("frame_pre_draw", callable_mp(const_cast<TextServerAdvanced *>(this), &TextServerAdvanced::_update_dirty_textures));
+			texture_update_connected = true;
+		}
+	}
+	return p_tex.texture->get_rid();
+}
+
+void TextServerAdvanced::_update_dirty_textures() {
+	_THREAD_SAFE_METHOD_
+	if (!textures_dirty.is_set()) {
+		return;
+	}
+	textures_dirty.clear();
+
+	List<RID> fonts;
+	font_owner.get_owned_list(&fonts);
+	for (const RID &E : fonts) {
+		FontDataAdvanced *fd = font_owner.get_or_null(E);
+		MutexLock lock(fd->mutex);
+		for (const KeyValue<Vector2i, FontDataForSizeAdvanced *> &S : fd->cache) {
+			for (int i = 0; i < S.value->textures.size(); i++) {
+				FontTexture &tex = S.value->textures.write[i];
+				if (tex.dirty && tex.texture.is_valid()) {
+					Ref<Image> img = memnew(Image(tex.texture_w, tex.texture_h, 0, tex.format, tex.imgdata));
+					tex.texture->update(img);
+					tex.dirty = false;
+				}
+			}
+		}
+	}
+}
+
 hb_font_t *TextServerAdvanced::_font_get_hb_handle(RID p_font_rid, int p_size) const {
 	FontDataAdvanced *fd = font_owner.get_or_null(p_font_rid);
 	ERR_FAIL_COND_V(!fd, nullptr);
@@ -1630,6 +1651,7 @@ void TextServerAdvanced::font_set_data(RID p_font_rid, const PackedByteArray &p_
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	_font_clear_cache(fd);
 	fd->data = p_data;
 	fd->data_ptr = fd->data.ptr();
@@ -1641,6 +1663,7 @@ void TextServerAdvanced::font_set_data_ptr(RID p_font_rid, const uint8_t *p_data
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	_font_clear_cache(fd);
 	fd->data.clear();
 	fd->data_ptr = p_data_ptr;
@@ -1652,6 +1675,7 @@ void TextServerAdvanced::font_set_antialiased(RID p_font_rid, bool p_antialiased
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	if (fd->antialiased != p_antialiased) {
 		_font_clear_cache(fd);
 		fd->antialiased = p_antialiased;
@@ -1671,6 +1695,7 @@ void TextServerAdvanced::font_set_multichannel_signed_distance_field(RID p_font_
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	if (fd->msdf != p_msdf) {
 		_font_clear_cache(fd);
 		fd->msdf = p_msdf;
@@ -1690,6 +1715,7 @@ void TextServerAdvanced::font_set_msdf_pixel_range(RID p_font_rid, int p_msdf_pi
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	if (fd->msdf_range != p_msdf_pixel_range) {
 		_font_clear_cache(fd);
 		fd->msdf_range = p_msdf_pixel_range;
@@ -1709,6 +1735,7 @@ void TextServerAdvanced::font_set_msdf_size(RID p_font_rid, int p_msdf_size) {
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	if (fd->msdf_source_size != p_msdf_size) {
 		_font_clear_cache(fd);
 		fd->msdf_source_size = p_msdf_size;
@@ -1728,6 +1755,7 @@ void TextServerAdvanced::font_set_fixed_size(RID p_font_rid, int p_fixed_size) {
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	if (fd->fixed_size != p_fixed_size) {
 		fd->fixed_size = p_fixed_size;
 	}
@@ -1746,6 +1774,7 @@ void TextServerAdvanced::font_set_force_autohinter(RID p_font_rid, bool p_force_
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	if (fd->force_autohinter != p_force_autohinter) {
 		_font_clear_cache(fd);
 		fd->force_autohinter = p_force_autohinter;
@@ -1765,6 +1794,7 @@ void TextServerAdvanced::font_set_hinting(RID p_font_rid, TextServer::Hinting p_
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	if (fd->hinting != p_hinting) {
 		_font_clear_cache(fd);
 		fd->hinting = p_hinting;
@@ -1784,6 +1814,7 @@ void TextServerAdvanced::font_set_variation_coordinates(RID p_font_rid, const Di
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	if (fd->variation_coordinates != p_variation_coordinates) {
 		_font_clear_cache(fd);
 		fd->variation_coordinates = p_variation_coordinates;
@@ -1803,6 +1834,7 @@ void TextServerAdvanced::font_set_oversampling(RID p_font_rid, float p_oversampl
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	if (fd->oversampling != p_oversampling) {
 		_font_clear_cache(fd);
 		fd->oversampling = p_oversampling;
@@ -1834,6 +1866,7 @@ void TextServerAdvanced::font_clear_size_cache(RID p_font_rid) {
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	for (const KeyValue<Vector2i, FontDataForSizeAdvanced *> &E : fd->cache) {
 		memdelete(E.value);
 	}
@@ -1845,6 +1878,7 @@ void TextServerAdvanced::font_remove_size_cache(RID p_font_rid, const Vector2i &
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	if (fd->cache.has(p_size)) {
 		memdelete(fd->cache[p_size]);
 		fd->cache.erase(p_size);
@@ -1856,6 +1890,7 @@ void TextServerAdvanced::font_set_ascent(RID p_font_rid, int p_size, float p_asc
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	Vector2i size = _get_size(fd, p_size);
 
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
@@ -1882,6 +1917,7 @@ void TextServerAdvanced::font_set_descent(RID p_font_rid, int p_size, float p_de
 	FontDataAdvanced *fd = font_owner.get_or_null(p_font_rid);
 	ERR_FAIL_COND(!fd);
 
+	_shaped_cache_clear();
 	Vector2i size = _get_size(fd, p_size);
 
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
@@ -1909,6 +1945,7 @@ void TextServerAdvanced::font_set_underline_position(RID p_font_rid, int p_size,
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	Vector2i size = _get_size(fd, p_size);
 
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
@@ -1936,6 +1973,7 @@ void TextServerAdvanced::font_set_underline_thickness(RID p_font_rid, int p_size
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	Vector2i size = _get_size(fd, p_size);
 
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
@@ -1963,6 +2001,7 @@ void TextServerAdvanced::font_set_scale(RID p_font_rid, int p_size, float p_scal
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	Vector2i size = _get_size(fd, p_size);
 
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
@@ -1990,6 +2029,7 @@ void TextServerAdvanced::font_set_spacing(RID p_font_rid, int p_size, TextServer
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	Vector2i size = _get_size(fd, p_size);
 
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
@@ -2163,6 +2203,7 @@ void TextServerAdvanced::font_clear_glyphs(RID p_font_rid, const Vector2i &p_siz
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	Vector2i size = _get_size_outline(fd, p_size);
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
 
@@ -2174,6 +2215,7 @@ void TextServerAdvanced::font_remove_glyph(RID p_font_rid, const Vector2i &p_siz
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	Vector2i size = _get_size_outline(fd, p_size);
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
 
@@ -2206,6 +2248,7 @@ void TextServerAdvanced::font_set_glyph_advance(RID p_font_rid, int p_size, int3
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	Vector2i size = _get_size(fd, p_size);
 
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
@@ -2413,6 +2456,7 @@ void TextServerAdvanced::font_clear_kerning_map(RID p_font_rid, int p_size) {
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	Vector2i size = _get_size(fd, p_size);
 
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
@@ -2424,6 +2468,7 @@ void TextServerAdvanced::font_remove_kerning(RID p_font_rid, int p_size, const V
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	Vector2i size = _get_size(fd, p_size);
 
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
@@ -2435,6 +2480,7 @@ void TextServerAdvanced::font_set_kerning(RID p_font_rid, int p_size, const Vect
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	Vector2i size = _get_size(fd, p_size);
 
 	ERR_FAIL_COND(!_ensure_cache_for_size(fd, size));
@@ -2605,7 +2651,7 @@ void TextServerAdvanced::font_draw_glyph(RID p_font_rid, RID p_canvas, int p_siz
 			}
 #endif
 			if (RenderingServer::get_singleton() != nullptr) {
-				RID texture = fd->cache[size]->textures[gl.texture_idx].texture->get_rid();
+				RID texture = _font_get_texture_rid(fd->cache[size]->textures.write[gl.texture_idx]);
 				if (fd->msdf) {
 					Point2 cpos = p_pos;
 					cpos += gl.rect.position * (float)p_size / (float)fd->msdf_source_size;
@@ -2645,7 +2691,7 @@ void TextServerAdvanced::font_draw_glyph_outline(RID p_font_rid, RID p_canvas, i
 			}
 #endif
 			if (RenderingServer::get_singleton() != nullptr) {
-				RID texture = fd->cache[size]->textures[gl.texture_idx].texture->get_rid();
+				RID texture = _font_get_texture_rid(fd->cache[size]->textures.write[gl.texture_idx]);
 				if (fd->msdf) {
 					Point2 cpos = p_pos;
 					cpos += gl.rect.position * (float)p_size / (float)fd->msdf_source_size;
@@ -2679,6 +2725,7 @@ void TextServerAdvanced::font_set_language_support_override(RID p_font_rid, cons
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	fd->language_support_overrides[p_language] = p_supported;
 }
 
@@ -2695,6 +2742,7 @@ void TextServerAdvanced::font_remove_language_support_override(RID p_font_rid, c
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	fd->language_support_overrides.erase(p_language);
 }
 
@@ -2729,6 +2777,7 @@ void TextServerAdvanced::font_set_script_support_override(RID p_font_rid, const
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	fd->script_support_overrides[p_script] = p_supported;
 }
 
@@ -2745,6 +2794,7 @@ void TextServerAdvanced::font_remove_script_support_override(RID p_font_rid, con
 	ERR_FAIL_COND(!fd);
 
 	MutexLock lock(fd->mutex);
+	_shaped_cache_clear();
 	fd->script_support_overrides.erase(p_script);
 }
 
@@ -4298,6 +4348,35 @@ void TextServerAdvanced::_shape_run(ShapedTextDataAdvanced *p_sd, int32_t p_star
 	}
 }
 
+void TextServerAdvanced::_shaped_cache_clear() {
+	MutexLock lock(shaped_cache_mutex);
+	shaped_cache.clear();
+}
+
+uint64_t TextServerAdvanced::_shaped_cache_hash(const ShapedTextDataAdvanced *p_sd) const {
+	uint64_t hash = p_sd->text.hash64();
+	hash = hash_djb2_one_64(p_sd->direction, hash);
+	hash = hash_djb2_one_64(p_sd->orientation, hash);
+	hash = hash_djb2_one_64(p_sd->preserve_invalid, hash);
+	hash = hash_djb2_one_64(p_sd->preserve_control, hash);
+	for (int i = 0; i < p_sd->bidi_override.size(); i++) {
+		hash = hash_djb2_one_64(p_sd->bidi_override[i].x, hash);
+		hash = hash_djb2_one_64(p_sd->bidi_override[i].y, hash);
+	}
+	for (int i = 0; i < p_sd->spans.size(); i++) {
+		const ShapedTextDataAdvanced::Span &span = p_sd->spans[i];
+		hash = hash_djb2_one_64(span.start, hash);
+		hash = hash_djb2_one_64(span.end, hash);
+		hash = hash_djb2_one_64(span.font_size, hash);
+		for (int j = 0; j < span.fonts.size(); j++) {
+			hash = hash_djb2_one_64(span.fonts[j].get_id(), hash);
+		}
+		hash = hash_djb2_one_64(span.language.hash(), hash);
+		hash = hash_djb2_one_64(span.features.hash(), hash);
+	}
+	return hash;
+}
+
 bool TextServerAdvanced::shaped_text_shape(RID p_shaped) {
 	ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_shaped);
 	ERR_FAIL_COND_V(!sd, false);
@@ -4320,15 +4399,35 @@ bool TextServerAdvanced::shaped_text_shape(RID p_shaped) {
 	sd->utf16 = sd->text.utf16();
 	const UChar *data = sd->utf16.ptr();
 
-	// Create script iterator.
-	if (sd->script_iter == nullptr) {
-		sd->script_iter = memnew(ScriptIterator(sd->text, 0, sd->text.length()));
-	}
-
 	if (sd->bidi_override.is_empty()) {
 		sd->bidi_override.push_back(Vector2i(0, sd->end));
 	}
 
+	// Reuse the glyphs of an identical string shaped before, BiDi iterators are still needed for substrings and line breaking.
+	bool cacheable = sd->objects.is_empty() && sd->text.length() <= SHAPED_CACHE_MAX_LENGTH;
+	bool cached = false;
+	uint64_t cache_hash = 0;
+	if (cacheable) {
+		cache_hash = _shaped_cache_hash(sd);
+
+		MutexLock cache_lock(shaped_cache_mutex);
+		const ShapedCacheEntry *entry = shaped_cache.getptr(cache_hash);
+		if (entry && entry->text == sd->text) {
+			sd->glyphs = entry->glyphs;
+			sd->ascent = entry->ascent;
+			sd->descent = entry->descent;
+			sd->width = entry->width;
+			sd->upos = entry->upos;
+			sd->uthk = entry->uthk;
+			cached = true;
+		}
+	}
+
+	// Create script iterator.
+	if (!cached && sd->script_iter == nullptr) {
+		sd->script_iter = memnew(ScriptIterator(sd->text, 0, sd->text.length()));
+	}
+
 	for (int ov = 0; ov < sd->bidi_override.size(); ov++) {
 		// Create BiDi iterator.
 		int start = _convert_pos_inv(sd, sd->bidi_override[ov].x);
@@ -4363,6 +4462,10 @@ bool TextServerAdvanced::shaped_text_shape(RID p_shaped) {
 		ERR_FAIL_COND_V_MSG(U_FAILURE(err), false, u_errorName(err));
 		sd->bidi_iter.push_back(bidi_iter);
 
+		if (cached) {
+			continue;
+		}
+
 		err = U_ZERO_ERROR;
 		int bidi_run_count = ubidi_countRuns(bidi_iter, &err);
 		ERR_FAIL_COND_V_MSG(U_FAILURE(err), false, u_errorName(err));
@@ -4524,6 +4627,21 @@ bool TextServerAdvanced::shaped_text_shape(RID p_shaped) {
 	}
 	sd->ascent = full_ascent;
 	sd->descent = full_descent;
+
+	if (cacheable && !cached) {
+		ShapedCacheEntry entry;
+		entry.text = sd->text;
+		entry.glyphs = sd->glyphs;
+		entry.ascent = sd->ascent;
+		entry.descent = sd->descent;
+		entry.width = sd->width;
+		entry.upos = sd->upos;
+		entry.uthk = sd->uthk;
+
+		MutexLock cache_lock(shaped_cache_mutex);
+		shaped_cache.insert(cache_hash, entry);
+	}
+
 	sd->valid = true;
 	return sd->valid;
 }
@@ -4927,6 +5045,7 @@ TextServerAdvanced::TextServerAdvanced() {
 	_insert_num_systems_lang();
 	_insert_feature_sets();
 	_bmp_create_font_funcs();
+	shaped_cache.set_capacity(SHAPED_CACHE_SIZE);
 }
 
 TextServerAdvanced::~TextServerAdvanced() {
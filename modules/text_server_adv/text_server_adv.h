@@ -38,7 +38,9 @@
 
 #include "servers/text_server.h"
 
+#include "core/templates/lru.h"
 #include "core/templates/rid_owner.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/thread_work_pool.h"
 #include "scene/resources/texture.h"
 #include "script_iterator.h"
@@ -111,6 +113,7 @@ class TextServerAdvanced : public TextServer {
 		int texture_h = 0;
 		PackedInt32Array offsets;
 		Ref<ImageTexture> texture;
+		bool dirty = false; // Image data has changed since the last upload.
 	};
 
 	struct FontTexturePosition {
@@ -211,6 +214,7 @@ class TextServerAdvanced : public TextServer {
 	_FORCE_INLINE_ bool _ensure_glyph(FontDataAdvanced *p_font_data, const Vector2i &p_size, int32_t p_glyph) const;
 	_FORCE_INLINE_ bool _ensure_cache_for_size(FontDataAdvanced *p_font_data, const Vector2i &p_size) const;
 	_FORCE_INLINE_ void _font_clear_cache(FontDataAdvanced *p_font_data);
+	_FORCE_INLINE_ RID _font_get_texture_rid(FontTexture &p_tex) const;
 	void _generateMTSDF_threaded(uint32_t y, void *p_td) const;
 
 	_FORCE_INLINE_ Vector2i _get_size(const FontDataAdvanced *p_font_data, int p_size) const {
@@ -262,6 +266,39 @@ class TextServerAdvanced : public TextServer {
 	mutable RID_PtrOwner<FontDataAdvanced> font_owner;
 	mutable RID_PtrOwner<ShapedTextDataAdvanced> shaped_owner;
 
+	// Shaping results cache, shared by all shaped text buffers. Keyed by the hash of the text,
+	// direction, orientation, BiDi overrides and spans (fonts, size, language and features).
+	// Cleared whenever a font changes in a way that can affect shaping, or is freed.
+
+	enum {
+		SHAPED_CACHE_SIZE = 1024, // Max. number of cached strings.
+		SHAPED_CACHE_MAX_LENGTH = 128, // Longer strings are not cached, this bounds cache memory use.
+	};
+
+	struct ShapedCacheEntry {
+		String text;
+		Vector<Glyph> glyphs;
+		float ascent = 0.f;
+		float descent = 0.f;
+		float width = 0.f;
+		float upos = 0.f;
+		float uthk = 0.f;
+	};
+
+	// Glyph atlas uploads are deferred and done once per frame for all modified textures.
+
+	mutable SafeFlag textures_dirty;
+	mutable Mutex texture_update_mutex;
+	mutable bool texture_update_connected = false;
+
+	void _update_dirty_textures();
+
+	Mutex shaped_cache_mutex;
+	LRUCache<uint64_t, ShapedCacheEntry> shaped_cache;
+
+	void _shaped_cache_clear();
+	uint64_t _shaped_cache_hash(const ShapedTextDataAdvanced *p_sd) const;
+
 	int _convert_pos(const ShapedTextDataAdvanced *p_sd, int p_pos) const;
 	int _convert_pos_inv(const ShapedTextDataAdvanced *p_sd, int p_pos) const;
 	void _shape_run(ShapedTextDataAdvanced *p_sd, int32_t p_start, int32_t p_end, hb_script_t p_script, hb_direction_t p_direction, Vector<RID> p_fonts, int p_span, int p_fb_index);
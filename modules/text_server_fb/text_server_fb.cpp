@@ -185,10 +185,8 @@ _FORCE_INLINE_ TextServerFallback::FontTexturePosition TextServerFallback::find_
 	for (int i = 0; i < p_data->textures.size(); i++) {
 		const FontTexture &ct = p_data->textures[i];
 
-		if (RenderingServer::get_singleton() != nullptr) {
-			if (ct.texture->get_format() != p_image_format) {
-				continue;
-			}
+		if (ct.format != p_image_format) {
+			continue;
 		}
 
 		if (mw > ct.texture_w || mh > ct.texture_h) { // Too big for this texture.
@@ -448,18 +446,9 @@ _FORCE_INLINE_ TextServerFallback::FontGlyph TextServerFallback::rasterize_msdf(
 			}
 		}
 
-		// Blit to image and texture.
-		{
-			if (RenderingServer::get_singleton() != nullptr) {
-				Ref<Image> img = memnew(Image(tex.texture_w, tex.texture_h, 0, Image::FORMAT_RGBA8, tex.imgdata));
-				if (tex.texture.is_null()) {
-					tex.texture.instantiate();
-					tex.texture->create_from_image(img);
-				} else {
-					tex.texture->update(img);
-				}
-			}
-		}
+		// Texture is uploaded when first used, or with the other modified textures before the next frame is drawn.
+		tex.dirty = true;
+		textures_dirty.set();
 
 		// Update height array.
 		for (int k = tex_pos.x; k < tex_pos.x + mw; k++) {
@@ -530,19 +519,9 @@ _FORCE_INLINE_ TextServerFallback::FontGlyph TextServerFallback::rasterize_bitma
 		}
 	}
 
-	// Blit to image and texture.
-	{
-		if (RenderingServer::get_singleton() != nullptr) {
-			Ref<Image> img = memnew(Image(tex.texture_w, tex.texture_h, 0, require_format, tex.imgdata));
-
-			if (tex.texture.is_null()) {
-				tex.texture.instantiate();
-				tex.texture->create_from_image(img);
-			} else {
-				tex.texture->update(img);
-			}
-		}
-	}
+	// Texture is uploaded when first used, or with the other modified textures before the next frame is drawn.
+	tex.dirty = true;
+	textures_dirty.set();
 
 	// Update height array.
 	for (int k = tex_pos.x; k < tex_pos.x + mw; k++) {
@@ -797,6 +776,47 @@ _FORCE_INLINE_ void TextServerFallback::_font_clear_cache(FontDataFallback *p_fo
 	p_font_data->supported_varaitions.clear();
 }
 
+_FORCE_INLINE_ RID TextServerFallback::_font_get_texture_rid(FontTexture &p_tex) const {
+	if (p_tex.texture.is_null()) {
+		Ref<Image> img = memnew(Image(p_tex.texture_w, p_tex.texture_h, 0, p_tex.format, p_tex.imgdata));
+		p_tex.texture.instantiate();
+		p_tex.texture->create_from_image(img);
+		p_tex.dirty = false;
+	} else if (p_tex.dirty) {
+		MutexLock lock(texture_update_mutex);
+		if (!texture_update_connected) {
+			RenderingServer::get_singleton()->connect("frame_pre_draw", callable_mp(const_cast<TextServerFallback *>(this), &TextServerFallback::_update_dirty_textures));
+			texture_update_connected = true;
+		}
+	}
+	return p_tex.texture->get_rid();
+}
+
+void TextServerFallback::_update_dirty_textures() {
+	_THREAD_SAFE_METHOD_
+	if (!textures_dirty.is_set()) {
+		return;
+	}
+	textures_dirty.clear();
+
+	List<RID> fonts;
+	font_owner.get_owned_list(&fonts);
+	for (const RID &E : fonts) {
+		FontDataFallback *fd = font_owner.get_or_null(E);
+		MutexLock lock(fd->mutex);
+		for (const KeyValue<Vector2i, FontDataForSizeFallback *> &S : fd->cache) {
+			for (int i = 0; i < S.value->textures.size(); i++) {
+				FontTexture &tex = S.value->textures.write[i];
+				if (tex.dirty && tex.texture.is_valid()) {
+					Ref<Image> img = memnew(Image(tex.texture_w, tex.texture_h, 0, tex.format, tex.imgdata));
+					tex.texture->update(img);
+					tex.dirty = false;
+				}
+			}
+		}
+	}
+}
+
 RID TextServerFallback::create_font() {
 	FontDataFallback *fd = memnew(FontDataFallback);
 
@@ -1759,7 +1779,7 @@ void TextServerFallback::font_draw_glyph(RID p_font_rid, RID p_canvas, int p_siz
 			}
 #endif
 			if (RenderingServer::get_singleton() != nullptr) {
-				RID texture = fd->cache[size]->textures[gl.texture_idx].texture->get_rid();
+				RID texture = _font_get_texture_rid(fd->cache[size]->textures.write[gl.texture_idx]);
 				if (fd->msdf) {
 					Point2 cpos = p_pos;
 					cpos += gl.rect.position * (float)p_size / (float)fd->msdf_source_size;
@@ -1799,7 +1819,7 @@ void TextServerFallback::font_draw_glyph_outline(RID p_font_rid, RID p_canvas, i
 			}
 #endif
 			if (RenderingServer::get_singleton() != nullptr) {
-				RID texture = fd->cache[size]->textures[gl.texture_idx].texture->get_rid();
+				RID texture = _font_get_texture_rid(fd->cache[size]->textures.write[gl.texture_idx]);
 				if (fd->msdf) {
 					Point2 cpos = p_pos;
 					cpos += gl.rect.position * (float)p_size / (float)fd->msdf_source_size;
@@ -39,6 +39,7 @@
 #include "servers/text_server.h"
 
 #include "core/templates/rid_owner.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/thread_work_pool.h"
 #include "scene/resources/texture.h"
 
@@ -82,6 +83,7 @@ class TextServerFallback : public TextServer {
 		int texture_h = 0;
 		PackedInt32Array offsets;
 		Ref<ImageTexture> texture;
+		bool dirty = false; // Image data has changed since the last upload.
 	};
 
 	struct FontTexturePosition {
@@ -176,6 +178,7 @@ class TextServerFallback : public TextServer {
 	_FORCE_INLINE_ bool _ensure_glyph(FontDataFallback *p_font_data, const Vector2i &p_size, int32_t p_glyph) const;
 	_FORCE_INLINE_ bool _ensure_cache_for_size(FontDataFallback *p_font_data, const Vector2i &p_size) const;
 	_FORCE_INLINE_ void _font_clear_cache(FontDataFallback *p_font_data);
+	_FORCE_INLINE_ RID _font_get_texture_rid(FontTexture &p_tex) const;
 	void _generateMTSDF_threaded(uint32_t y, void *p_td) const;
 
 	_FORCE_INLINE_ Vector2i _get_size(const FontDataFallback *p_font_data, int p_size) const {
@@ -204,6 +207,14 @@ class TextServerFallback : public TextServer {
 	mutable RID_PtrOwner<FontDataFallback> font_owner;
 	mutable RID_PtrOwner<ShapedTextData> shaped_owner;
 
+	// Glyph atlas uploads are deferred and done once per frame for all modified textures.
+
+	mutable SafeFlag textures_dirty;
+	mutable Mutex texture_update_mutex;
+	mutable bool texture_update_connected = false;
+
+	void _update_dirty_textures();
+
 protected:
 	static void _bind_methods(){};
 
@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/os/os.h"
+#include "core/os/worker_thread_pool.h"
 
 #include "thirdparty/misc/yuv2rgb.h"
 
@@ -81,6 +82,26 @@ int VideoStreamPlaybackTheora::queue_page(ogg_page *page) {
 	return 0;
 }
 
+void VideoStreamPlaybackTheora::_convert_yuv_band(uint32_t p_band, YUVConversion *p_conversion) {
+	int from = p_band * YUV_BAND_ROWS;
+	int rows = MIN(int(YUV_BAND_ROWS), size.y - from);
+	// 4:2:0 has one chroma row every two luma rows, bands have an even amount of rows so they start on a pair.
+	int uv_from = px_fmt == TH_PF_420 ? from / 2 : from;
+
+	uint8_t *dst = p_conversion->dst + from * (size.x << 2);
+	const uint8_t *y = p_conversion->y + from * p_conversion->y_stride;
+	const uint8_t *u = p_conversion->u + uv_from * p_conversion->uv_stride;
+	const uint8_t *v = p_conversion->v + uv_from * p_conversion->uv_stride;
+
+	if (px_fmt == TH_PF_444) {
+		yuv444_2_rgb8888(dst, y, u, v, size.x, rows, p_conversion->y_stride, p_conversion->uv_stride, size.x << 2);
+	} else if (px_fmt == TH_PF_422) {
+		yuv422_2_rgb8888(dst, y, u, v, size.x, rows, p_conversion->y_stride, p_conversion->uv_stride, size.x << 2);
+	} else if (px_fmt == TH_PF_420) {
+		yuv420_2_rgb8888(dst, y, u, v, size.x, rows, p_conversion->y_stride, p_conversion->uv_stride, size.x << 2);
+	}
+}
+
 void VideoStreamPlaybackTheora::video_write() {
 	th_ycbcr_buffer yuv;
 	th_decode_ycbcr_out(td, yuv);
@@ -88,20 +109,24 @@ void VideoStreamPlaybackTheora::video_write() {
 	int pitch = 4;
 	frame_data.resize(size.x * size.y * pitch);
 	{
-		uint8_t *w = frame_data.ptrw();
-		char *dst = (char *)w;
+		YUVConversion conversion;
+		conversion.dst = frame_data.ptrw();
+		conversion.y = yuv[0].data;
+		conversion.u = yuv[1].data;
+		conversion.v = yuv[2].data;
+		conversion.y_stride = yuv[0].stride;
+		conversion.uv_stride = yuv[1].stride;
 
 		//uv_offset=(ti.pic_x/2)+(yuv[1].stride)*(ti.pic_y/2);
 
-		if (px_fmt == TH_PF_444) {
-			yuv444_2_rgb8888((uint8_t *)dst, (uint8_t *)yuv[0].data, (uint8_t *)yuv[1].data, (uint8_t *)yuv[2].data, size.x, size.y, yuv[0].stride, yuv[1].stride, size.x << 2);
-
-		} else if (px_fmt == TH_PF_422) {
-			yuv422_2_rgb8888((uint8_t *)dst, (uint8_t *)yuv[0].data, (uint8_t *)yuv[1].data, (uint8_t *)yuv[2].data, size.x, size.y, yuv[0].stride, yuv[1].stride, size.x << 2);
-
-		} else if (px_fmt == TH_PF_420) {
-			yuv420_2_rgb8888((uint8_t *)dst, (uint8_t *)yuv[0].data, (uint8_t *)yuv[1].data, (uint8_t *)yuv[2].data, size.x, size.y, yuv[0].stride, yuv[1].stride, size.x << 2);
-		};
+		// Bands of rows are converted in parallel, this is most of the per frame cost at high resolutions.
+		uint32_t band_count = (size.y + YUV_BAND_ROWS - 1) / YUV_BAND_ROWS;
+		if (band_count > 1) {
+			WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &VideoStreamPlaybackTheora::_convert_yuv_band, &conversion, band_count);
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		} else if (band_count == 1) {
+			_convert_yuv_band(0, &conversion);
+		}
 
 		format = Image::FORMAT_RGBA8;
 	}
@@ -50,6 +50,16 @@ class VideoStreamPlaybackTheora : public VideoStreamPlayback {
 
 	enum {
 		MAX_FRAMES = 4,
+		YUV_BAND_ROWS = 64, // Must be even, see _convert_yuv_band().
+	};
+
+	struct YUVConversion {
+		uint8_t *dst = nullptr;
+		const uint8_t *y = nullptr;
+		const uint8_t *u = nullptr;
+		const uint8_t *v = nullptr;
+		int y_stride = 0;
+		int uv_stride = 0;
 	};
 
 	//Image frames[MAX_FRAMES];
@@ -64,6 +74,7 @@ class VideoStreamPlaybackTheora : public VideoStreamPlayback {
 	int buffer_data();
 	int queue_page(ogg_page *page);
 	void video_write();
+	void _convert_yuv_band(uint32_t p_band, YUVConversion *p_conversion);
 	float get_time() const;
 
 	bool theora_eos = false;
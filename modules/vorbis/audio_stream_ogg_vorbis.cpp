@@ -38,6 +38,11 @@ int AudioStreamPlaybackOGGVorbis::_mix_internal(AudioFrame *p_buffer, int p_fram
 	ERR_FAIL_COND_V(!ready, 0);
 	ERR_FAIL_COND_V(!active, 0);
 
+	if (skip_position >= 0) {
+		// Resume after being skipped by virtual voices.
+		_seek(skip_position);
+	}
+
 	int todo = p_frames;
 
 	int start_buffer = 0;
@@ -62,7 +67,7 @@ int AudioStreamPlaybackOGGVorbis::_mix_internal(AudioFrame *p_buffer, int p_fram
 			if (vorbis_stream->loop && is_not_empty) {
 				//loop
 
-				seek(vorbis_stream->loop_offset);
+				_seek(vorbis_stream->loop_offset);
 				loops++;
 				// we still have buffer to fill, start from this element in the next iteration.
 				start_buffer = p_frames - todo;
@@ -170,6 +175,7 @@ void AudioStreamPlaybackOGGVorbis::start(float p_from_pos) {
 }
 
 void AudioStreamPlaybackOGGVorbis::stop() {
+	_prefetch_reset();
 	active = false;
 }
 
@@ -182,16 +188,27 @@ int AudioStreamPlaybackOGGVorbis::get_loop_count() const {
 }
 
 float AudioStreamPlaybackOGGVorbis::get_playback_position() const {
-	return float(frames_mixed) / vorbis_data->get_sampling_rate();
+	if (skip_position >= 0) {
+		return skip_position;
+	}
+	// The decoder runs ahead of what was mixed.
+	return float(MAX(0, int(frames_mixed) - _get_prefetched_frames())) / vorbis_data->get_sampling_rate();
 }
 
 void AudioStreamPlaybackOGGVorbis::seek(float p_time) {
+	_prefetch_reset();
+	_seek(p_time);
+}
+
+void AudioStreamPlaybackOGGVorbis::_seek(float p_time) {
 	ERR_FAIL_COND(!ready);
 	ERR_FAIL_COND(vorbis_stream.is_null());
 	if (!active) {
 		return;
 	}
 
+	skip_position = -1.0;
+
 	vorbis_synthesis_restart(&dsp_state);
 
 	if (p_time >= vorbis_stream->get_length()) {
@@ -303,7 +320,38 @@ void AudioStreamPlaybackOGGVorbis::seek(float p_time) {
 	}
 }
 
+bool AudioStreamPlaybackOGGVorbis::can_skip() const {
+	// Streams of unknown length can't be repositioned reliably.
+	return vorbis_stream.is_valid() && vorbis_stream->get_length() > 0;
+}
+
+void AudioStreamPlaybackOGGVorbis::skip(float p_time) {
+	if (!active) {
+		return;
+	}
+
+	// Whatever was decoded ahead was never heard.
+	int dropped = _prefetch_reset();
+
+	// Only the position moves forward here, the actual seek happens once the playback is mixed again.
+	float length = vorbis_stream->get_length();
+	float position = MAX(0.0f, get_playback_position() - float(dropped) / vorbis_data->get_sampling_rate()) + p_time;
+	if (position >= length) {
+		float loop_length = length - vorbis_stream->loop_offset;
+		if (!vorbis_stream->loop || loop_length <= 0) {
+			active = false;
+			return;
+		}
+		float overshoot = position - length;
+		loops += 1 + int(overshoot / loop_length);
+		position = vorbis_stream->loop_offset + Math::fmod(overshoot, loop_length);
+	}
+	skip_position = position;
+}
+
 AudioStreamPlaybackOGGVorbis::~AudioStreamPlaybackOGGVorbis() {
+	_prefetch_reset();
+
 	if (block_is_allocated) {
 		vorbis_block_clear(&block);
 	}
@@ -330,6 +378,7 @@ Ref<AudioStreamPlayback> AudioStreamOGGVorbis::instance_playback() {
 	ovs->active = false;
 	ovs->loops = 0;
 	if (ovs->_alloc_vorbis()) {
+		ovs->_set_prefetch_enabled(true);
 		return ovs;
 	}
 	// Failed to allocate data structures.
@@ -44,6 +44,7 @@ class AudioStreamPlaybackOGGVorbis : public AudioStreamPlaybackResampled {
 	uint32_t frames_mixed = 0;
 	bool active = false;
 	int loops = 0;
+	float skip_position = -1.0; // Pending seek after being skipped, negative if none.
 
 	vorbis_info info;
 	vorbis_comment comment;
@@ -71,6 +72,8 @@ class AudioStreamPlaybackOGGVorbis : public AudioStreamPlaybackResampled {
 	// Allocates vorbis data structures. Returns true upon success, false on failure.
 	bool _alloc_vorbis();
 
+	void _seek(float p_time);
+
 protected:
 	virtual int _mix_internal(AudioFrame *p_buffer, int p_frames) override;
 	virtual float get_stream_sampling_rate() override;
@@ -85,6 +88,9 @@ public:
 	virtual float get_playback_position() const override;
 	virtual void seek(float p_time) override;
 
+	virtual bool can_skip() const override;
+	virtual void skip(float p_time) override;
+
 	AudioStreamPlaybackOGGVorbis() {}
 	~AudioStreamPlaybackOGGVorbis();
 };
@@ -90,6 +90,28 @@ public:
 		return OK;
 	}
 
+	// Same as read_packet, but r_payload points to the payload inside the buffer when it does not wrap around,
+	// r_scratch is only used otherwise. The payload is valid until the next write.
+	Error read_packet_ptr(const uint8_t **r_payload, uint8_t *r_scratch, int p_bytes, T *r_info, int &r_read) {
+		ERR_FAIL_COND_V(_packets.data_left() < 1, ERR_UNAVAILABLE);
+		_Packet p;
+		_packets.read(&p, 1);
+		ERR_FAIL_COND_V(_payload.data_left() < (int)p.size, ERR_BUG);
+
+		r_read = p.size;
+		memcpy(r_info, &p.info, sizeof(T));
+		const uint8_t *ptr = _payload.get_read_ptr(p.size);
+		if (ptr) {
+			*r_payload = ptr;
+			_payload.advance_read(p.size);
+			return OK;
+		}
+		ERR_FAIL_COND_V(p_bytes < (int)p.size, ERR_OUT_OF_MEMORY);
+		_payload.read(r_scratch, p.size);
+		*r_payload = r_scratch;
+		return OK;
+	}
+
 	void discard_payload(int p_size) {
 		_packets.decrease_write(p_size);
 	}
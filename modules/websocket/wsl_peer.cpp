@@ -267,10 +267,7 @@ Error WSLPeer::get_packet(const uint8_t **r_buffer, int &r_buffer_size) {
 	}
 
 	int read = 0;
-	uint8_t *rw = _packet_buffer.ptrw();
-	_in_buffer.read_packet(rw, _packet_buffer.size(), &_is_string, read);
-
-	*r_buffer = rw;
+	_in_buffer.read_packet_ptr(r_buffer, _packet_buffer.ptrw(), _packet_buffer.size(), &_is_string, read);
 	r_buffer_size = read;
 
 	return OK;
@@ -30,6 +30,11 @@ def get_opts():
 
     return [
         ("initial_memory", "Initial WASM memory (in MiB)", 32),
+        (
+            "threads_pool_size",
+            "Number of worker threads spawned at startup in threads builds, 0 for one per logical CPU of the browser",
+            8,
+        ),
         BoolVariable("use_assertions", "Use Emscripten runtime assertions", False),
         BoolVariable("use_thinlto", "Use ThinLTO", False),
         BoolVariable("use_ubsan", "Use Emscripten undefined behavior sanitizer (UBSAN)", False),
@@ -63,6 +68,11 @@ def configure(env):
     except Exception:
         print("Initial memory must be a valid integer")
         sys.exit(255)
+    try:
+        env["threads_pool_size"] = int(env["threads_pool_size"])
+    except Exception:
+        print("Threads pool size must be a valid integer")
+        sys.exit(255)
 
     ## Build type
     if env["target"].startswith("release"):
@@ -192,7 +202,12 @@ def configure(env):
         env.Append(CPPDEFINES=["PTHREAD_NO_RENAME"])
         env.Append(CCFLAGS=["-s", "USE_PTHREADS=1"])
         env.Append(LINKFLAGS=["-s", "USE_PTHREADS=1"])
-        env.Append(LINKFLAGS=["-s", "PTHREAD_POOL_SIZE=8"])
+        # Threads beyond the pool only start once the main thread yields to the browser. The engine sizes
+        # the worker thread pool on navigator.hardwareConcurrency, so allow matching it.
+        if env["threads_pool_size"] > 0:
+            env.Append(LINKFLAGS=["-s", "PTHREAD_POOL_SIZE=%d" % env["threads_pool_size"]])
+        else:
+            env.Append(LINKFLAGS=["-s", "PTHREAD_POOL_SIZE=navigator.hardwareConcurrency+2"])
         env.Append(LINKFLAGS=["-s", "WASM_MEM_MAX=2048MB"])
         env.extra_suffix = ".threads" + env.extra_suffix
     else:
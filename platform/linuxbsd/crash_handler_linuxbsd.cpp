@@ -62,6 +62,9 @@ static void handle_crash(int sig) {
 		msg = proj_settings->get("debug/settings/crash_handler/message");
 	}
 
+	// Write out queued log messages first, so they come before the backtrace.
+	OS::get_singleton()->flush_logs();
+
 	// Dump the backtrace to stderr with a message to the user
 	fprintf(stderr, "\n================================================================\n");
 	fprintf(stderr, "%s: Program crashed with signal %d\n", __FUNCTION__, sig);
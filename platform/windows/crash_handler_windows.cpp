@@ -129,6 +129,9 @@ DWORD CrashHandlerException(EXCEPTION_POINTERS *ep) {
 		return EXCEPTION_CONTINUE_SEARCH;
 	}
 
+	// Write out queued log messages first, so they come before the backtrace.
+	OS::get_singleton()->flush_logs();
+
 	fprintf(stderr, "\n================================================================\n");
 	fprintf(stderr, "%s: Program crashed\n", __FUNCTION__);
 
@@ -169,9 +169,31 @@ void OS_Windows::initialize_debugging() {
 	SetConsoleCtrlHandler(HandlerRoutine, TRUE);
 }
 
+static void _set_thread_priority(Thread::Priority p_priority) {
+	int priority = THREAD_PRIORITY_NORMAL;
+	switch (p_priority) {
+		case Thread::PRIORITY_LOW:
+			priority = THREAD_PRIORITY_BELOW_NORMAL;
+			break;
+		case Thread::PRIORITY_NORMAL:
+			priority = THREAD_PRIORITY_NORMAL;
+			break;
+		case Thread::PRIORITY_HIGH:
+			priority = THREAD_PRIORITY_ABOVE_NORMAL;
+			break;
+	}
+	SetThreadPriority(GetCurrentThread(), priority);
+}
+
+static Error _set_thread_affinity(uint64_t p_mask) {
+	return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)p_mask) != 0 ? OK : ERR_INVALID_PARAMETER;
+}
+
 void OS_Windows::initialize() {
 	crash_handler.initialize();
 
+	Thread::_set_platform_funcs(nullptr, &_set_thread_priority, nullptr, nullptr, &_set_thread_affinity);
+
 	//RedirectIOToConsole();
 
 	FileAccess::make_default<FileAccessWindows>(FileAccess::ACCESS_RESOURCES);
@@ -620,6 +642,69 @@ BOOL is_wow64() {
 	return wow64;
 }
 
+Vector<OS::ProcessorInfo> OS_Windows::_query_processor_topology() const {
+	Vector<ProcessorInfo> topology = OS::_query_processor_topology();
+
+	DWORD length = 0;
+	GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+	if (GetLastError() != ERROR_INSUFFICIENT_BUFFER) {
+		return topology;
+	}
+	Vector<uint8_t> buffer;
+	buffer.resize(length);
+	if (!GetLogicalProcessorInformationEx(RelationAll, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buffer.ptrw(), &length)) {
+		return topology;
+	}
+
+	// Only processor group 0 is considered, as affinity masks are limited to it.
+	const int count = MIN(topology.size(), 64);
+	int core = 0;
+	int cache_domain = 0;
+	int max_cache_level = 0;
+	BYTE max_efficiency_class = 0;
+	Vector<BYTE> efficiency_classes;
+	efficiency_classes.resize(count);
+	efficiency_classes.fill(0);
+
+	for (DWORD offset = 0; offset < length;) {
+		PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buffer.ptr() + offset);
+		offset += info->Size;
+
+		if (info->Relationship == RelationProcessorCore) {
+			if (info->Processor.GroupMask[0].Group != 0) {
+				continue;
+			}
+			// Higher efficiency classes are the faster cores.
+			max_efficiency_class = MAX(max_efficiency_class, info->Processor.EfficiencyClass);
+			for (int i = 0; i < count; i++) {
+				if (info->Processor.GroupMask[0].Mask & (KAFFINITY(1) << i)) {
+					topology.write[i].core = core;
+					efficiency_classes.write[i] = info->Processor.EfficiencyClass;
+				}
+			}
+			core++;
+		} else if (info->Relationship == RelationCache && info->Cache.GroupMask.Group == 0 && info->Cache.Level >= max_cache_level) {
+			if (info->Cache.Level > max_cache_level) {
+				// Only the last level cache is used for cache domains.
+				max_cache_level = info->Cache.Level;
+				cache_domain = 0;
+			}
+			for (int i = 0; i < count; i++) {
+				if (info->Cache.GroupMask.Mask & (KAFFINITY(1) << i)) {
+					topology.write[i].cache_domain = cache_domain;
+				}
+			}
+			cache_domain++;
+		}
+	}
+
+	for (int i = 0; i < count; i++) {
+		topology.write[i].core_class = max_efficiency_class - efficiency_classes[i];
+	}
+
+	return topology;
+}
+
 int OS_Windows::get_processor_count() const {
 	SYSTEM_INFO sysinfo;
 	if (is_wow64())
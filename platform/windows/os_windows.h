@@ -162,6 +162,7 @@ public:
 	void run();
 
 	virtual bool _check_internal_feature_support(const String &p_feature) override;
+	virtual Vector<ProcessorInfo> _query_processor_topology() const override;
 
 	virtual void disable_crash_handler() override;
 	virtual bool is_disable_crash_handler() const override;
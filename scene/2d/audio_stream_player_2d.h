@@ -66,6 +66,7 @@ private:
 	bool autoplay = false;
 	StringName default_bus = SNAME("Master");
 	int max_polyphony = 1;
+	int voice_priority = 0;
 
 	void _set_playing(bool p_enable);
 	bool _is_active() const;
@@ -123,6 +124,9 @@ public:
 	void set_max_polyphony(int p_max_polyphony);
 	int get_max_polyphony() const;
 
+	void set_voice_priority(int p_priority);
+	int get_voice_priority() const;
+
 	Ref<AudioStreamPlayback> get_stream_playback();
 
 	AudioStreamPlayer2D();
@@ -31,9 +31,14 @@
 #include "cpu_particles_2d.h"
 
 #include "core/core_string_names.h"
+#include "core/os/worker_thread_pool.h"
 #include "scene/2d/gpu_particles_2d.h"
 #include "scene/resources/particles_material.h"
 
+// Emitters with fewer particles are processed on the calling thread.
+#define CPU_PARTICLES_THREADED_MIN 256
+#define CPU_PARTICLES_THREADED_BATCH 64
+
 void CPUParticles2D::set_emitting(bool p_emitting) {
 	if (emitting == p_emitting) {
 		return;
@@ -61,6 +66,7 @@ void CPUParticles2D::set_amount(int p_amount) {
 	RS::get_singleton()->multimesh_allocate_data(multimesh, p_amount, RS::MULTIMESH_TRANSFORM_2D, true, true);
 
 	particle_order.resize(p_amount);
+	particle_steps.resize(p_amount);
 }
 
 void CPUParticles2D::set_lifetime(double p_lifetime) {
@@ -543,7 +549,7 @@ static real_t rand_from_seed(uint32_t &seed) {
 }
 
 void CPUParticles2D::_update_internal() {
-	if (particles.size() == 0 || !is_visible_in_tree()) {
+	if (particles.size() == 0 || !is_visible_in_tree() || !Engine::get_singleton()->is_visual_processing_enabled()) {
 		_set_redraw(false);
 		return;
 	}
@@ -638,8 +644,14 @@ void CPUParticles2D::_particles_process(double p_delta) {
 
 	double system_phase = time / lifetime;
 
+	// Emission draws from the global random generator, so restarting particles
+	// stays serial to keep the sequence. The update runs in parallel below.
+	ParticleStep *steps = particle_steps.ptr();
+
 	for (int i = 0; i < pcount; i++) {
 		Particle &p = parray[i];
+		ParticleStep &step = steps[i];
+		step.mode = PARTICLE_STEP_SKIP;
 
 		if (!emitting && !p.active) {
 			continue;
@@ -787,13 +799,59 @@ void CPUParticles2D::_particles_process(double p_delta) {
 				p.velocity = velocity_xform.xform(p.velocity);
 				p.transform = emission_xform * p.transform;
 			}
-
+			step.mode = PARTICLE_STEP_EMITTED;
 		} else if (!p.active) {
 			continue;
 		} else if (p.time > p.lifetime) {
 			p.active = false;
-			tv = 1.0;
+			step.mode = PARTICLE_STEP_EXPIRED;
 		} else {
+			step.mode = PARTICLE_STEP_UPDATE;
+		}
+
+		step.delta = local_delta;
+	}
+
+	ProcessData data;
+	data.particles = parray;
+	data.steps = steps;
+	data.emission_origin = emission_xform[2];
+	if (draw_order == DRAW_ORDER_INDEX) {
+		// Nothing to sort, so the rows are written while the particles are hot and
+		// _update_particle_data_buffer() doesn't repack them. The render thread
+		// doesn't read the buffer until can_update is set again.
+		MutexLock lock(update_mutex);
+		can_update.clear();
+		data.rows = particle_data.ptrw();
+	}
+
+	// Gradients sort their points lazily, do it before they are read from several threads.
+	if (color_ramp.is_valid()) {
+		color_ramp->get_color_at_offset(0.0);
+	}
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (pcount < CPU_PARTICLES_THREADED_MIN || !pool || pool->get_thread_count() == 0) {
+		for (int i = 0; i < pcount; i++) {
+			_particle_update(i, &data);
+		}
+	} else {
+		WorkerThreadPool::GroupID group = pool->add_template_group_task(this, &CPUParticles2D::_particle_update, (const ProcessData *)&data, pcount, -1, CPU_PARTICLES_THREADED_BATCH);
+		pool->wait_for_group_task_completion(group);
+	}
+}
+
+void CPUParticles2D::_particle_update(uint32_t p_index, const ProcessData *p_data) {
+	Particle &p = p_data->particles[p_index];
+	const ParticleStep &step = p_data->steps[p_index];
+
+	if (step.mode != PARTICLE_STEP_SKIP) {
+		double local_delta = step.delta;
+		float tv = 0.0;
+
+		if (step.mode == PARTICLE_STEP_EXPIRED) {
+			tv = 1.0;
+		} else if (step.mode == PARTICLE_STEP_UPDATE) {
 			uint32_t alt_seed = p.seed;
 
 			p.time += local_delta;
@@ -855,7 +913,7 @@ void CPUParticles2D::_particles_process(double p_delta) {
 			//apply linear acceleration
 			force += p.velocity.length() > 0.0 ? p.velocity.normalized() * tex_linear_accel * Math::lerp(parameters_min[PARAM_LINEAR_ACCEL], parameters_max[PARAM_LINEAR_ACCEL], rand_from_seed(alt_seed)) : Vector2();
 			//apply radial acceleration
-			Vector2 org = emission_xform[2];
+			Vector2 org = p_data->emission_origin;
 			Vector2 diff = pos - org;
 			force += diff.length() > 0.0 ? diff.normalized() * (tex_radial_accel)*Math::lerp(parameters_min[PARAM_RADIAL_ACCEL], parameters_max[PARAM_RADIAL_ACCEL], rand_from_seed(alt_seed)) : Vector2();
 			//apply tangential acceleration;
@@ -892,151 +950,168 @@ void CPUParticles2D::_particles_process(double p_delta) {
 			p.rotation = Math::deg2rad(base_angle); //angle
 			p.custom[2] = tex_anim_offset * Math::lerp(parameters_min[PARAM_ANIM_OFFSET], parameters_max[PARAM_ANIM_OFFSET], p.anim_offset_rand) + p.custom[1] * tex_anim_speed * Math::lerp(parameters_min[PARAM_ANIM_SPEED], parameters_max[PARAM_ANIM_SPEED], rand_from_seed(alt_seed));
 		}
-		//apply color
-		//apply hue rotation
 
-		Vector2 tex_scale = Vector2(1.0, 1.0);
-		if (split_scale) {
-			if (scale_curve_x.is_valid()) {
-				tex_scale.x = scale_curve_x->interpolate(tv);
-			} else {
-				tex_scale.x = 1.0;
-			}
-			if (scale_curve_y.is_valid()) {
-				tex_scale.y = scale_curve_y->interpolate(tv);
+			//apply color
+			//apply hue rotation
+
+			Vector2 tex_scale = Vector2(1.0, 1.0);
+			if (split_scale) {
+				if (scale_curve_x.is_valid()) {
+					tex_scale.x = scale_curve_x->interpolate(tv);
+				} else {
+					tex_scale.x = 1.0;
+				}
+				if (scale_curve_y.is_valid()) {
+					tex_scale.y = scale_curve_y->interpolate(tv);
+				} else {
+					tex_scale.y = 1.0;
+				}
 			} else {
-				tex_scale.y = 1.0;
+				if (curve_parameters[PARAM_SCALE].is_valid()) {
+					real_t tmp_scale = curve_parameters[PARAM_SCALE]->interpolate(tv);
+					tex_scale.x = tmp_scale;
+					tex_scale.y = tmp_scale;
+				}
 			}
-		} else {
-			if (curve_parameters[PARAM_SCALE].is_valid()) {
-				real_t tmp_scale = curve_parameters[PARAM_SCALE]->interpolate(tv);
-				tex_scale.x = tmp_scale;
-				tex_scale.y = tmp_scale;
+
+			real_t tex_hue_variation = 0.0;
+			if (curve_parameters[PARAM_HUE_VARIATION].is_valid()) {
+				tex_hue_variation = curve_parameters[PARAM_HUE_VARIATION]->interpolate(tv);
 			}
-		}
 
-		real_t tex_hue_variation = 0.0;
-		if (curve_parameters[PARAM_HUE_VARIATION].is_valid()) {
-			tex_hue_variation = curve_parameters[PARAM_HUE_VARIATION]->interpolate(tv);
-		}
+			real_t hue_rot_angle = (tex_hue_variation)*Math_TAU * Math::lerp(parameters_min[PARAM_HUE_VARIATION], parameters_max[PARAM_HUE_VARIATION], p.hue_rot_rand);
+			real_t hue_rot_c = Math::cos(hue_rot_angle);
+			real_t hue_rot_s = Math::sin(hue_rot_angle);
 
-		real_t hue_rot_angle = (tex_hue_variation)*Math_TAU * Math::lerp(parameters_min[PARAM_HUE_VARIATION], parameters_max[PARAM_HUE_VARIATION], p.hue_rot_rand);
-		real_t hue_rot_c = Math::cos(hue_rot_angle);
-		real_t hue_rot_s = Math::sin(hue_rot_angle);
+			Basis hue_rot_mat;
+			{
+				Basis mat1(0.299, 0.587, 0.114, 0.299, 0.587, 0.114, 0.299, 0.587, 0.114);
+				Basis mat2(0.701, -0.587, -0.114, -0.299, 0.413, -0.114, -0.300, -0.588, 0.886);
+				Basis mat3(0.168, 0.330, -0.497, -0.328, 0.035, 0.292, 1.250, -1.050, -0.203);
 
-		Basis hue_rot_mat;
-		{
-			Basis mat1(0.299, 0.587, 0.114, 0.299, 0.587, 0.114, 0.299, 0.587, 0.114);
-			Basis mat2(0.701, -0.587, -0.114, -0.299, 0.413, -0.114, -0.300, -0.588, 0.886);
-			Basis mat3(0.168, 0.330, -0.497, -0.328, 0.035, 0.292, 1.250, -1.050, -0.203);
+				for (int j = 0; j < 3; j++) {
+					hue_rot_mat[j] = mat1[j] + mat2[j] * hue_rot_c + mat3[j] * hue_rot_s;
+				}
+			}
 
-			for (int j = 0; j < 3; j++) {
-				hue_rot_mat[j] = mat1[j] + mat2[j] * hue_rot_c + mat3[j] * hue_rot_s;
+			if (color_ramp.is_valid()) {
+				p.color = color_ramp->get_color_at_offset(tv) * color;
+			} else {
+				p.color = color;
 			}
-		}
 
-		if (color_ramp.is_valid()) {
-			p.color = color_ramp->get_color_at_offset(tv) * color;
-		} else {
-			p.color = color;
-		}
+			Vector3 color_rgb = hue_rot_mat.xform_inv(Vector3(p.color.r, p.color.g, p.color.b));
+			p.color.r = color_rgb.x;
+			p.color.g = color_rgb.y;
+			p.color.b = color_rgb.z;
 
-		Vector3 color_rgb = hue_rot_mat.xform_inv(Vector3(p.color.r, p.color.g, p.color.b));
-		p.color.r = color_rgb.x;
-		p.color.g = color_rgb.y;
-		p.color.b = color_rgb.z;
+			p.color *= p.base_color;
 
-		p.color *= p.base_color;
+			if (particle_flags[PARTICLE_FLAG_ALIGN_Y_TO_VELOCITY]) {
+				if (p.velocity.length() > 0.0) {
+					p.transform.elements[1] = p.velocity.normalized();
+					p.transform.elements[0] = p.transform.elements[1].orthogonal();
+				}
 
-		if (particle_flags[PARTICLE_FLAG_ALIGN_Y_TO_VELOCITY]) {
-			if (p.velocity.length() > 0.0) {
-				p.transform.elements[1] = p.velocity.normalized();
-				p.transform.elements[0] = p.transform.elements[1].orthogonal();
+			} else {
+				p.transform.elements[0] = Vector2(Math::cos(p.rotation), -Math::sin(p.rotation));
+				p.transform.elements[1] = Vector2(Math::sin(p.rotation), Math::cos(p.rotation));
 			}
 
-		} else {
-			p.transform.elements[0] = Vector2(Math::cos(p.rotation), -Math::sin(p.rotation));
-			p.transform.elements[1] = Vector2(Math::sin(p.rotation), Math::cos(p.rotation));
-		}
+			//scale by scale
+			Vector2 base_scale = tex_scale * Math::lerp(parameters_min[PARAM_SCALE], parameters_max[PARAM_SCALE], p.scale_rand);
+			if (base_scale.x < 0.00001) {
+				base_scale.x = 0.00001;
+			}
+			if (base_scale.y < 0.00001) {
+				base_scale.y = 0.00001;
+			}
+			p.transform.elements[0] *= base_scale.x;
+			p.transform.elements[1] *= base_scale.y;
 
-		//scale by scale
-		Vector2 base_scale = tex_scale * Math::lerp(parameters_min[PARAM_SCALE], parameters_max[PARAM_SCALE], p.scale_rand);
-		if (base_scale.x < 0.00001) {
-			base_scale.x = 0.00001;
-		}
-		if (base_scale.y < 0.00001) {
-			base_scale.y = 0.00001;
-		}
-		p.transform.elements[0] *= base_scale.x;
-		p.transform.elements[1] *= base_scale.y;
+			p.transform[2] += p.velocity * local_delta;
+	}
 
-		p.transform[2] += p.velocity * local_delta;
+	if (p_data->rows) {
+		_write_particle_row(p_data->rows + p_index * 16, p);
 	}
 }
 
-void CPUParticles2D::_update_particle_data_buffer() {
-	MutexLock lock(update_mutex);
-
-	int pc = particles.size();
-
-	int *ow;
-	int *order = nullptr;
+void CPUParticles2D::_write_particle_row(float *r_row, const Particle &p_particle) const {
+	if (p_particle.active) {
+		Transform2D t = p_particle.transform;
+		if (!local_coords) {
+			t = inv_emission_transform * t;
+		}
 
-	float *w = particle_data.ptrw();
-	const Particle *r = particles.ptr();
-	float *ptr = w;
+		r_row[0] = t.elements[0][0];
+		r_row[1] = t.elements[1][0];
+		r_row[2] = 0;
+		r_row[3] = t.elements[2][0];
+		r_row[4] = t.elements[0][1];
+		r_row[5] = t.elements[1][1];
+		r_row[6] = 0;
+		r_row[7] = t.elements[2][1];
+	} else {
+		memset(r_row, 0, sizeof(float) * 8);
+	}
 
-	if (draw_order != DRAW_ORDER_INDEX) {
-		ow = particle_order.ptrw();
-		order = ow;
+	const Color &c = p_particle.color;
 
-		for (int i = 0; i < pc; i++) {
-			order[i] = i;
-		}
-		if (draw_order == DRAW_ORDER_LIFETIME) {
-			SortArray<int, SortLifetime> sorter;
-			sorter.compare.particles = r;
-			sorter.sort(order, pc);
-		}
-	}
+	r_row[8] = c.r;
+	r_row[9] = c.g;
+	r_row[10] = c.b;
+	r_row[11] = c.a;
 
-	for (int i = 0; i < pc; i++) {
-		int idx = order ? order[i] : i;
+	r_row[12] = p_particle.custom[0];
+	r_row[13] = p_particle.custom[1];
+	r_row[14] = p_particle.custom[2];
+	r_row[15] = p_particle.custom[3];
+}
 
-		Transform2D t = r[idx].transform;
+void CPUParticles2D::_write_particle_row_ordered(uint32_t p_index, const RowData *p_data) {
+	_write_particle_row(p_data->rows + p_index * 16, p_data->particles[p_data->order[p_index]]);
+}
 
-		if (!local_coords) {
-			t = inv_emission_transform * t;
-		}
+void CPUParticles2D::_update_particle_data_buffer() {
+	MutexLock lock(update_mutex);
 
-		if (r[idx].active) {
-			ptr[0] = t.elements[0][0];
-			ptr[1] = t.elements[1][0];
-			ptr[2] = 0;
-			ptr[3] = t.elements[2][0];
-			ptr[4] = t.elements[0][1];
-			ptr[5] = t.elements[1][1];
-			ptr[6] = 0;
-			ptr[7] = t.elements[2][1];
+	if (draw_order == DRAW_ORDER_INDEX) {
+		// The rows were written by _particles_process().
+		can_update.set();
+		return;
+	}
 
-		} else {
-			memset(ptr, 0, sizeof(float) * 8);
-		}
+	int pc = particles.size();
 
-		Color c = r[idx].color;
+	int *order = particle_order.ptrw();
+	const Particle *r = particles.ptr();
 
-		ptr[8] = c.r;
-		ptr[9] = c.g;
-		ptr[10] = c.b;
-		ptr[11] = c.a;
+	for (int i = 0; i < pc; i++) {
+		order[i] = i;
+	}
+	if (draw_order == DRAW_ORDER_LIFETIME) {
+		SortArray<int, SortLifetime> sorter;
+		sorter.compare.particles = r;
+		sorter.sort(order, pc);
+	}
 
-		ptr[12] = r[idx].custom[0];
-		ptr[13] = r[idx].custom[1];
-		ptr[14] = r[idx].custom[2];
-		ptr[15] = r[idx].custom[3];
+	RowData data;
+	data.particles = r;
+	data.order = order;
+	data.rows = particle_data.ptrw();
 
-		ptr += 16;
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (pc < CPU_PARTICLES_THREADED_MIN || !pool || pool->get_thread_count() == 0) {
+		for (int i = 0; i < pc; i++) {
+			_write_particle_row_ordered(i, &data);
+		}
+	} else {
+		WorkerThreadPool::GroupID group = pool->add_template_group_task(this, &CPUParticles2D::_write_particle_row_ordered, (const RowData *)&data, pc, -1, CPU_PARTICLES_THREADED_BATCH * 4);
+		pool->wait_for_group_task_completion(group);
 	}
+
+	can_update.set();
 }
 
 void CPUParticles2D::_set_redraw(bool p_redraw) {
@@ -1069,7 +1144,10 @@ void CPUParticles2D::_set_redraw(bool p_redraw) {
 void CPUParticles2D::_update_render_thread() {
 	MutexLock lock(update_mutex);
 
-	RS::get_singleton()->multimesh_set_buffer(multimesh, particle_data);
+	if (can_update.is_set()) {
+		RS::get_singleton()->multimesh_set_buffer(multimesh, particle_data);
+		can_update.clear(); //wait for next time
+	}
 }
 
 void CPUParticles2D::_notification(int p_what) {
@@ -1129,6 +1207,8 @@ void CPUParticles2D::_notification(int p_what) {
 
 					ptr += 16;
 				}
+
+				can_update.set();
 			}
 		} break;
 	}
@@ -31,6 +31,7 @@
 #ifndef CPU_PARTICLES_2D_H
 #define CPU_PARTICLES_2D_H
 
+#include "core/templates/local_vector.h"
 #include "scene/2d/node_2d.h"
 
 class CPUParticles2D : public Node2D {
@@ -109,6 +110,35 @@ private:
 	Vector<float> particle_data;
 	Vector<int> particle_order;
 
+	// What the parallel pass of _particles_process() does with a particle,
+	// decided by the serial emission pass.
+	enum ParticleStepMode : uint8_t {
+		PARTICLE_STEP_SKIP,
+		PARTICLE_STEP_EMITTED,
+		PARTICLE_STEP_EXPIRED,
+		PARTICLE_STEP_UPDATE,
+	};
+
+	struct ParticleStep {
+		double delta = 0.0;
+		ParticleStepMode mode = PARTICLE_STEP_SKIP;
+	};
+
+	LocalVector<ParticleStep> particle_steps;
+
+	struct ProcessData {
+		Particle *particles = nullptr;
+		const ParticleStep *steps = nullptr;
+		Vector2 emission_origin;
+		float *rows = nullptr; // Rows of particle_data to write, when drawn in index order.
+	};
+
+	struct RowData {
+		const Particle *particles = nullptr;
+		const int *order = nullptr;
+		float *rows = nullptr;
+	};
+
 	struct SortLifetime {
 		const Particle *particles = nullptr;
 
@@ -141,6 +171,8 @@ private:
 
 	Transform2D inv_emission_transform;
 
+	SafeFlag can_update;
+
 	DrawOrder draw_order = DRAW_ORDER_INDEX;
 
 	Ref<Texture2D> texture;
@@ -175,6 +207,9 @@ private:
 
 	void _update_internal();
 	void _particles_process(double p_delta);
+	void _particle_update(uint32_t p_index, const ProcessData *p_data);
+	void _write_particle_row(float *r_row, const Particle &p_particle) const;
+	void _write_particle_row_ordered(uint32_t p_index, const RowData *p_data);
 	void _update_particle_data_buffer();
 
 	Mutex update_mutex;
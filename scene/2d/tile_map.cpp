@@ -31,6 +31,7 @@
 #include "tile_map.h"
 
 #include "core/io/marshalls.h"
+#include "core/os/worker_thread_pool.h"
 
 #include "servers/navigation_server_2d.h"
 
@@ -386,6 +387,17 @@ bool TileMap::is_collision_animatable() const {
 	return collision_animatable;
 }
 
+void TileMap::set_collision_merge_full_tiles(bool p_enabled) {
+	collision_merge_full_tiles = p_enabled;
+	_clear_internals();
+	_recreate_internals();
+	emit_signal(SNAME("changed"));
+}
+
+bool TileMap::is_collision_merge_full_tiles_enabled() const {
+	return collision_merge_full_tiles;
+}
+
 void TileMap::set_collision_visibility_mode(TileMap::VisibilityMode p_show_collision) {
 	collision_visibility_mode = p_show_collision;
 	_clear_internals();
@@ -476,6 +488,18 @@ void TileMap::_queue_update_dirty_quadrants() {
 	call_deferred(SNAME("_update_dirty_quadrants"));
 }
 
+void TileMap::_update_quadrant_coords_cache(uint32_t p_index, TileMapQuadrant **p_quadrants) {
+	TileMapQuadrant *q = p_quadrants[p_index];
+	q->map_to_world.clear();
+	q->world_to_map.clear();
+	for (Set<Vector2i>::Element *E = q->cells.front(); E; E = E->next()) {
+		Vector2i pk = E->get();
+		Vector2i pk_world_coords = map_to_world(pk);
+		q->map_to_world[pk] = pk_world_coords;
+		q->world_to_map[pk_world_coords] = pk;
+	}
+}
+
 void TileMap::_update_dirty_quadrants() {
 	if (!pending_update) {
 		return;
@@ -486,16 +510,16 @@ void TileMap::_update_dirty_quadrants() {
 	}
 
 	for (unsigned int layer = 0; layer < layers.size(); layer++) {
-		// Update the coords cache.
+		// Update the coords cache, quadrants are independent so they are spread over worker threads.
+		LocalVector<TileMapQuadrant *> dirty_quadrants;
 		for (SelfList<TileMapQuadrant> *q = layers[layer].dirty_quadrant_list.first(); q; q = q->next()) {
-			q->self()->map_to_world.clear();
-			q->self()->world_to_map.clear();
-			for (Set<Vector2i>::Element *E = q->self()->cells.front(); E; E = E->next()) {
-				Vector2i pk = E->get();
-				Vector2i pk_world_coords = map_to_world(pk);
-				q->self()->map_to_world[pk] = pk_world_coords;
-				q->self()->world_to_map[pk_world_coords] = pk;
-			}
+			dirty_quadrants.push_back(q->self());
+		}
+		if (dirty_quadrants.size() > 1) {
+			WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &TileMap::_update_quadrant_coords_cache, dirty_quadrants.ptr(), dirty_quadrants.size());
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		} else if (dirty_quadrants.size() == 1) {
+			_update_quadrant_coords_cache(0, dirty_quadrants.ptr());
 		}
 
 		// Call the update_dirty_quadrant method on plugins.
@@ -743,6 +767,12 @@ void TileMap::_rendering_update_dirty_quadrants(SelfList<TileMapQuadrant>::List
 		}
 		q.canvas_items.clear();
 
+		// Free the baked meshes.
+		for (const RID &mesh : q.meshes) {
+			rs->free(mesh);
+		}
+		q.meshes.clear();
+
 		// Free the occluders.
 		for (const RID &occluder : q.occluders) {
 			rs->free(occluder);
@@ -754,6 +784,10 @@ void TileMap::_rendering_update_dirty_quadrants(SelfList<TileMapQuadrant>::List
 		int prev_z_index = 0;
 		RID prev_canvas_item;
 
+		// Quadrants are a single cell when Y-sorting, baking would only add a mesh per tile.
+		bool bake_meshes = !(is_y_sort_enabled() && layers[q.layer].y_sort_enabled);
+		RenderingMeshBake bake;
+
 		Color modulate = get_self_modulate();
 		modulate *= get_layer_modulate(q.layer);
 		if (selected_layer >= 0) {
@@ -819,6 +853,9 @@ void TileMap::_rendering_update_dirty_quadrants(SelfList<TileMapQuadrant>::List
 
 						q.canvas_items.push_back(canvas_item);
 
+						_rendering_finish_mesh_bake_item(bake, q);
+						bake.canvas_item = canvas_item;
+
 						prev_canvas_item = canvas_item;
 						prev_material = mat;
 						prev_z_index = z_index;
@@ -828,8 +865,14 @@ void TileMap::_rendering_update_dirty_quadrants(SelfList<TileMapQuadrant>::List
 						canvas_item = prev_canvas_item;
 					}
 
-					// Drawing the tile in the canvas item.
-					draw_tile(canvas_item, E_cell.key - position, tile_set, c.source_id, c.get_atlas_coords(), c.alternative_tile, -1, modulate);
+					// Drawing the tile in the canvas item, static tiles are baked into a mesh and drawn in order with the others.
+					Rect2 tile_rect;
+					if (!bake_meshes || !_rendering_bake_tile(bake, q, c, E_cell.key - position, modulate, tile_rect)) {
+						_rendering_flush_mesh_bake(bake, q);
+						draw_tile(canvas_item, E_cell.key - position, tile_set, c.source_id, c.get_atlas_coords(), c.alternative_tile, -1, modulate);
+					}
+					bake.item_rect = bake.item_has_tiles ? bake.item_rect.merge(tile_rect) : tile_rect;
+					bake.item_has_tiles = true;
 
 					// --- Occluders ---
 					for (int i = 0; i < tile_set->get_occlusion_layers_count(); i++) {
@@ -849,6 +892,8 @@ void TileMap::_rendering_update_dirty_quadrants(SelfList<TileMapQuadrant>::List
 			}
 		}
 
+		_rendering_finish_mesh_bake_item(bake, q);
+
 		_rendering_quadrant_order_dirty = true;
 		q_list_element = q_list_element->next();
 	}
@@ -876,6 +921,117 @@ void TileMap::_rendering_update_dirty_quadrants(SelfList<TileMapQuadrant>::List
 	}
 }
 
+bool TileMap::_rendering_bake_tile(RenderingMeshBake &r_bake, TileMapQuadrant &r_quadrant, const TileMapCell &p_cell, Vector2 p_position, Color p_modulation, Rect2 &r_rect) {
+	TileSetAtlasSource *atlas_source = Object::cast_to<TileSetAtlasSource>(*tile_set->get_source(p_cell.source_id));
+	if (!atlas_source) {
+		return false;
+	}
+
+	Vector2i atlas_coords = p_cell.get_atlas_coords();
+	Ref<Texture2D> tex = atlas_source->get_texture();
+	Vector2i grid_size = atlas_source->get_atlas_grid_size();
+	if (!tex.is_valid() || atlas_coords.x >= grid_size.x || atlas_coords.y >= grid_size.y) {
+		return false;
+	}
+
+	TileData *tile_data = Object::cast_to<TileData>(atlas_source->get_tile_data(atlas_coords, p_cell.alternative_tile));
+
+	// Same destination rect as draw_tile().
+	Vector2i tile_offset = atlas_source->get_tile_effective_texture_offset(atlas_coords, p_cell.alternative_tile);
+	Rect2 dest_rect;
+	dest_rect.size = atlas_source->get_tile_texture_region(atlas_coords).size;
+	dest_rect.size.x += FP_ADJUST;
+	dest_rect.size.y += FP_ADJUST;
+
+	bool transpose = tile_data->get_transpose();
+	if (transpose) {
+		dest_rect.position = (p_position - Vector2(dest_rect.size.y, dest_rect.size.x) / 2 - tile_offset);
+	} else {
+		dest_rect.position = (p_position - dest_rect.size / 2 - tile_offset);
+	}
+	r_rect = dest_rect;
+
+	// Animated tiles, UV clipping and textures remapping their region when drawn (atlas and mesh textures) go through draw_tile().
+	if (atlas_source->get_tile_animation_frames_count(atlas_coords) != 1 || tile_set->is_uv_clipping() || Object::cast_to<AtlasTexture>(*tex) || Object::cast_to<MeshTexture>(*tex)) {
+		return false;
+	}
+
+	Size2 tex_size = tex->get_size();
+	if (tex_size.x <= 0 || tex_size.y <= 0) {
+		return false;
+	}
+
+	if (r_bake.texture != tex) {
+		_rendering_flush_mesh_bake(r_bake, r_quadrant);
+		r_bake.texture = tex;
+	}
+
+	// Match the vertex and UV placement of the canvas renderer for flipped and transposed rects.
+	Rect2 source_rect = atlas_source->get_tile_texture_region(atlas_coords, 0);
+	Color modulate = tile_data->get_modulate() * p_modulation;
+	bool flip_h = tile_data->get_flip_h();
+	bool flip_v = tile_data->get_flip_v();
+
+	static const Vector2 corners[4] = { Vector2(0, 0), Vector2(1, 0), Vector2(1, 1), Vector2(0, 1) };
+	int base = r_bake.vertices.size();
+	for (int i = 0; i < 4; i++) {
+		Vector2 uv_base = transpose ? Vector2(corners[i].y, corners[i].x) : corners[i];
+		Vector2 vertex_base(flip_h ? 1.0 - corners[i].x : corners[i].x, flip_v ? 1.0 - corners[i].y : corners[i].y);
+		r_bake.vertices.push_back(dest_rect.position + dest_rect.size * vertex_base);
+		r_bake.uvs.push_back((source_rect.position + source_rect.size * uv_base) / tex_size);
+		r_bake.colors.push_back(modulate);
+	}
+
+	r_bake.indices.push_back(base + 0);
+	r_bake.indices.push_back(base + 1);
+	r_bake.indices.push_back(base + 2);
+	r_bake.indices.push_back(base + 2);
+	r_bake.indices.push_back(base + 3);
+	r_bake.indices.push_back(base + 0);
+
+	return true;
+}
+
+void TileMap::_rendering_flush_mesh_bake(RenderingMeshBake &r_bake, TileMapQuadrant &r_quadrant) {
+	if (r_bake.vertices.is_empty()) {
+		return;
+	}
+
+	RenderingServer *rs = RenderingServer::get_singleton();
+
+	Array arr;
+	arr.resize(RS::ARRAY_MAX);
+	arr[RS::ARRAY_VERTEX] = r_bake.vertices;
+	arr[RS::ARRAY_TEX_UV] = r_bake.uvs;
+	arr[RS::ARRAY_COLOR] = r_bake.colors;
+	arr[RS::ARRAY_INDEX] = r_bake.indices;
+
+	RID mesh = rs->mesh_create();
+	rs->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, arr, Array(), Dictionary(), RS::ARRAY_FLAG_USE_2D_VERTICES);
+	rs->canvas_item_add_mesh(r_bake.canvas_item, mesh, Transform2D(), Color(1, 1, 1, 1), r_bake.texture->get_rid());
+	r_quadrant.meshes.push_back(mesh);
+
+	r_bake.vertices.clear();
+	r_bake.uvs.clear();
+	r_bake.colors.clear();
+	r_bake.indices.clear();
+	r_bake.item_has_mesh = true;
+}
+
+void TileMap::_rendering_finish_mesh_bake_item(RenderingMeshBake &r_bake, TileMapQuadrant &r_quadrant) {
+	_rendering_flush_mesh_bake(r_bake, r_quadrant);
+
+	// The meshes never change, give the canvas item an explicit rect so it can still be culled without looking at mesh AABBs.
+	if (r_bake.item_has_mesh) {
+		RenderingServer::get_singleton()->canvas_item_set_custom_rect(r_bake.canvas_item, true, r_bake.item_rect.abs());
+	}
+
+	r_bake.canvas_item = RID();
+	r_bake.texture.unref();
+	r_bake.item_has_tiles = false;
+	r_bake.item_has_mesh = false;
+}
+
 void TileMap::_rendering_create_quadrant(TileMapQuadrant *p_quadrant) {
 	ERR_FAIL_COND(!tile_set.is_valid());
 
@@ -889,6 +1045,12 @@ void TileMap::_rendering_cleanup_quadrant(TileMapQuadrant *p_quadrant) {
 	}
 	p_quadrant->canvas_items.clear();
 
+	// Free the baked meshes.
+	for (const RID &mesh : p_quadrant->meshes) {
+		RenderingServer::get_singleton()->free(mesh);
+	}
+	p_quadrant->meshes.clear();
+
 	// Free the occluders.
 	for (const RID &occluder : p_quadrant->occluders) {
 		RenderingServer::get_singleton()->free(occluder);
@@ -1096,6 +1258,132 @@ void TileMap::_physics_notification(int p_what) {
 	}
 }
 
+bool TileMap::_physics_is_full_tile(TileData *p_tile_data, int p_physics_layer) const {
+	if (p_tile_data->get_collision_polygons_count(p_physics_layer) != 1 || p_tile_data->is_collision_polygon_one_way(p_physics_layer, 0)) {
+		return false;
+	}
+	if (p_tile_data->get_constant_linear_velocity(p_physics_layer) != Vector2() || p_tile_data->get_constant_angular_velocity(p_physics_layer) != 0.0) {
+		return false;
+	}
+
+	Vector<Vector2> points = p_tile_data->get_collision_polygon_points(p_physics_layer, 0);
+	if (points.size() != 4) {
+		return false;
+	}
+
+	// The four corners of the tile, in any order.
+	Vector2 half_size = tile_set->get_tile_size() / 2;
+	uint32_t corners = 0;
+	for (int i = 0; i < 4; i++) {
+		if (!Math::is_equal_approx(Math::abs(points[i].x), half_size.x) || !Math::is_equal_approx(Math::abs(points[i].y), half_size.y)) {
+			return false;
+		}
+		corners |= 1 << ((points[i].x > 0 ? 1 : 0) | (points[i].y > 0 ? 2 : 0));
+	}
+	return corners == 0xF;
+}
+
+void TileMap::_physics_build_quadrant(uint32_t p_index, PhysicsQuadrantBuild *p_builds) {
+	PhysicsQuadrantBuild &build = p_builds[p_index];
+	const TileMapQuadrant &q = *build.quadrant;
+
+	build.merged_rects.resize(tile_set->get_physics_layers_count());
+	build.merged_cells.resize(tile_set->get_physics_layers_count());
+
+	for (int tile_set_physics_layer = 0; tile_set_physics_layer < tile_set->get_physics_layers_count(); tile_set_physics_layer++) {
+		// Gather the cells fully covered by a square collision polygon.
+		Set<Vector2i> remaining;
+		for (Set<Vector2i>::Element *E_cell = q.cells.front(); E_cell; E_cell = E_cell->next()) {
+			TileMapCell c = get_cell(q.layer, E_cell->get(), true);
+			if (!tile_set->has_source(c.source_id)) {
+				continue;
+			}
+			TileSetSource *source = *tile_set->get_source(c.source_id);
+			if (!source->has_tile(c.get_atlas_coords()) || !source->has_alternative_tile(c.get_atlas_coords(), c.alternative_tile)) {
+				continue;
+			}
+			TileSetAtlasSource *atlas_source = Object::cast_to<TileSetAtlasSource>(source);
+			if (atlas_source) {
+				TileData *tile_data = Object::cast_to<TileData>(atlas_source->get_tile_data(c.get_atlas_coords(), c.alternative_tile));
+				if (_physics_is_full_tile(tile_data, tile_set_physics_layer)) {
+					remaining.insert(E_cell->get());
+				}
+			}
+		}
+
+		// Greedily grow rectangles, first along Y then along X.
+		while (remaining.front()) {
+			Vector2i start = remaining.front()->get();
+			int height = 1;
+			while (remaining.has(start + Vector2i(0, height))) {
+				height++;
+			}
+			int width = 1;
+			while (true) {
+				bool column_full = true;
+				for (int y = 0; y < height && column_full; y++) {
+					column_full = remaining.has(start + Vector2i(width, y));
+				}
+				if (!column_full) {
+					break;
+				}
+				width++;
+			}
+
+			for (int x = 0; x < width; x++) {
+				for (int y = 0; y < height; y++) {
+					remaining.erase(start + Vector2i(x, y));
+					if (width * height > 1) {
+						build.merged_cells[tile_set_physics_layer].insert(start + Vector2i(x, y));
+					}
+				}
+			}
+
+			// Single tiles keep their own body, like unmerged ones.
+			if (width * height > 1) {
+				build.merged_rects[tile_set_physics_layer].push_back(Rect2i(start, Size2i(width, height)));
+			}
+		}
+	}
+}
+
+RID TileMap::_physics_create_body(TileMapQuadrant &r_quadrant, const Vector2i &p_coords, int p_tile_set_physics_layer, TileData *p_tile_data, const Transform2D &p_global_transform, RID p_space) {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+
+	Ref<PhysicsMaterial> physics_material = tile_set->get_physics_layer_physics_material(p_tile_set_physics_layer);
+	uint32_t physics_layer = tile_set->get_physics_layer_collision_layer(p_tile_set_physics_layer);
+	uint32_t physics_mask = tile_set->get_physics_layer_collision_mask(p_tile_set_physics_layer);
+
+	// Create the body.
+	RID body = ps->body_create();
+	bodies_coords[body] = p_coords;
+	ps->body_set_mode(body, collision_animatable ? PhysicsServer2D::BODY_MODE_KINEMATIC : PhysicsServer2D::BODY_MODE_STATIC);
+	ps->body_set_space(body, p_space);
+
+	Transform2D xform;
+	xform.set_origin(map_to_world(p_coords));
+	xform = p_global_transform * xform;
+	ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, xform);
+
+	ps->body_attach_object_instance_id(body, get_instance_id());
+	ps->body_set_collision_layer(body, physics_layer);
+	ps->body_set_collision_mask(body, physics_mask);
+	ps->body_set_pickable(body, false);
+	ps->body_set_state(body, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, p_tile_data->get_constant_linear_velocity(p_tile_set_physics_layer));
+	ps->body_set_state(body, PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY, p_tile_data->get_constant_angular_velocity(p_tile_set_physics_layer));
+
+	if (!physics_material.is_valid()) {
+		ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_BOUNCE, 0);
+		ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_FRICTION, 1);
+	} else {
+		ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_BOUNCE, physics_material->computed_bounce());
+		ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_FRICTION, physics_material->computed_friction());
+	}
+
+	r_quadrant.bodies.push_back(body);
+	return body;
+}
+
 void TileMap::_physics_update_dirty_quadrants(SelfList<TileMapQuadrant>::List &r_dirty_quadrant_list) {
 	ERR_FAIL_COND(!is_inside_tree());
 	ERR_FAIL_COND(!tile_set.is_valid());
@@ -1106,9 +1394,27 @@ void TileMap::_physics_update_dirty_quadrants(SelfList<TileMapQuadrant>::List &r
 	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
 	RID space = get_world_2d()->get_space();
 
+	// Find the full tiles to merge on worker threads, bodies are then created here.
+	LocalVector<PhysicsQuadrantBuild> builds;
+	if (collision_merge_full_tiles && tile_set->get_tile_shape() == TileSet::TILE_SHAPE_SQUARE && tile_set->get_physics_layers_count() > 0) {
+		for (SelfList<TileMapQuadrant> *q = r_dirty_quadrant_list.first(); q; q = q->next()) {
+			PhysicsQuadrantBuild build;
+			build.quadrant = q->self();
+			builds.push_back(build);
+		}
+		if (builds.size() > 1) {
+			WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &TileMap::_physics_build_quadrant, builds.ptr(), builds.size());
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		} else if (builds.size() == 1) {
+			_physics_build_quadrant(0, builds.ptr());
+		}
+	}
+
+	uint32_t build_index = 0;
 	SelfList<TileMapQuadrant> *q_list_element = r_dirty_quadrant_list.first();
 	while (q_list_element) {
 		TileMapQuadrant &q = *q_list_element->self();
+		const PhysicsQuadrantBuild *build = build_index < builds.size() ? &builds[build_index++] : nullptr;
 
 		// Clear bodies.
 		for (RID body : q.bodies) {
@@ -1117,6 +1423,11 @@ void TileMap::_physics_update_dirty_quadrants(SelfList<TileMapQuadrant>::List &r
 		}
 		q.bodies.clear();
 
+		for (RID shape : q.merged_shapes) {
+			ps->free(shape);
+		}
+		q.merged_shapes.clear();
+
 		// Recreate bodies and shapes.
 		for (Set<Vector2i>::Element *E_cell = q.cells.front(); E_cell; E_cell = E_cell->next()) {
 			TileMapCell c = get_cell(q.layer, E_cell->get(), true);
@@ -1134,37 +1445,20 @@ void TileMap::_physics_update_dirty_quadrants(SelfList<TileMapQuadrant>::List &r
 					TileData *tile_data = Object::cast_to<TileData>(atlas_source->get_tile_data(c.get_atlas_coords(), c.alternative_tile));
 
 					for (int tile_set_physics_layer = 0; tile_set_physics_layer < tile_set->get_physics_layers_count(); tile_set_physics_layer++) {
-						Ref<PhysicsMaterial> physics_material = tile_set->get_physics_layer_physics_material(tile_set_physics_layer);
-						uint32_t physics_layer = tile_set->get_physics_layer_collision_layer(tile_set_physics_layer);
-						uint32_t physics_mask = tile_set->get_physics_layer_collision_mask(tile_set_physics_layer);
-
-						// Create the body.
-						RID body = ps->body_create();
-						bodies_coords[body] = E_cell->get();
-						ps->body_set_mode(body, collision_animatable ? PhysicsServer2D::BODY_MODE_KINEMATIC : PhysicsServer2D::BODY_MODE_STATIC);
-						ps->body_set_space(body, space);
+						if (build && build->merged_cells[tile_set_physics_layer].has(E_cell->get())) {
+							continue;
+						}
 
-						Transform2D xform;
-						xform.set_origin(map_to_world(E_cell->get()));
-						xform = global_transform * xform;
-						ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, xform);
-
-						ps->body_attach_object_instance_id(body, get_instance_id());
-						ps->body_set_collision_layer(body, physics_layer);
-						ps->body_set_collision_mask(body, physics_mask);
-						ps->body_set_pickable(body, false);
-						ps->body_set_state(body, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, tile_data->get_constant_linear_velocity(tile_set_physics_layer));
-						ps->body_set_state(body, PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY, tile_data->get_constant_angular_velocity(tile_set_physics_layer));
-
-						if (!physics_material.is_valid()) {
-							ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_BOUNCE, 0);
-							ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_FRICTION, 1);
-						} else {
-							ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_BOUNCE, physics_material->computed_bounce());
-							ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_FRICTION, physics_material->computed_friction());
+						// Tiles without collision shapes on this layer don't need a body.
+						int shapes_count = 0;
+						for (int polygon_index = 0; polygon_index < tile_data->get_collision_polygons_count(tile_set_physics_layer); polygon_index++) {
+							shapes_count += tile_data->get_collision_polygon_shapes_count(tile_set_physics_layer, polygon_index);
+						}
+						if (shapes_count == 0) {
+							continue;
 						}
 
-						q.bodies.push_back(body);
+						RID body = _physics_create_body(q, E_cell->get(), tile_set_physics_layer, tile_data, global_transform, space);
 
 						// Add the shapes to the body.
 						int body_shape_index = 0;
@@ -1172,8 +1466,8 @@ void TileMap::_physics_update_dirty_quadrants(SelfList<TileMapQuadrant>::List &r
 							// Iterate over the polygons.
 							bool one_way_collision = tile_data->is_collision_polygon_one_way(tile_set_physics_layer, polygon_index);
 							float one_way_collision_margin = tile_data->get_collision_polygon_one_way_margin(tile_set_physics_layer, polygon_index);
-							int shapes_count = tile_data->get_collision_polygon_shapes_count(tile_set_physics_layer, polygon_index);
-							for (int shape_index = 0; shape_index < shapes_count; shape_index++) {
+							int polygon_shapes_count = tile_data->get_collision_polygon_shapes_count(tile_set_physics_layer, polygon_index);
+							for (int shape_index = 0; shape_index < polygon_shapes_count; shape_index++) {
 								// Add decomposed convex shapes.
 								Ref<ConvexPolygonShape2D> shape = tile_data->get_collision_polygon_shape(tile_set_physics_layer, polygon_index, shape_index);
 								ps->body_add_shape(body, shape->get_rid());
@@ -1187,6 +1481,34 @@ void TileMap::_physics_update_dirty_quadrants(SelfList<TileMapQuadrant>::List &r
 			}
 		}
 
+		// One body per merged rectangle, placed on its top-left cell.
+		if (build) {
+			Vector2 tile_size = tile_set->get_tile_size();
+			for (int tile_set_physics_layer = 0; tile_set_physics_layer < (int)build->merged_rects.size(); tile_set_physics_layer++) {
+				for (uint32_t rect_index = 0; rect_index < build->merged_rects[tile_set_physics_layer].size(); rect_index++) {
+					const Rect2i &rect = build->merged_rects[tile_set_physics_layer][rect_index];
+					TileMapCell c = get_cell(q.layer, rect.position, true);
+					TileSetAtlasSource *atlas_source = Object::cast_to<TileSetAtlasSource>(*tile_set->get_source(c.source_id));
+					TileData *tile_data = Object::cast_to<TileData>(atlas_source->get_tile_data(c.get_atlas_coords(), c.alternative_tile));
+
+					RID body = _physics_create_body(q, rect.position, tile_set_physics_layer, tile_data, global_transform, space);
+
+					Vector2 from = -tile_size / 2;
+					Vector2 to = Vector2(rect.size) * tile_size - tile_size / 2;
+					Vector<Vector2> points;
+					points.push_back(from);
+					points.push_back(Vector2(to.x, from.y));
+					points.push_back(to);
+					points.push_back(Vector2(from.x, to.y));
+
+					RID shape = ps->convex_polygon_shape_create();
+					ps->shape_set_data(shape, points);
+					ps->body_add_shape(body, shape);
+					q.merged_shapes.push_back(shape);
+				}
+			}
+		}
+
 		q_list_element = q_list_element->next();
 	}
 }
@@ -1198,6 +1520,11 @@ void TileMap::_physics_cleanup_quadrant(TileMapQuadrant *p_quadrant) {
 		PhysicsServer2D::get_singleton()->free(body);
 	}
 	p_quadrant->bodies.clear();
+
+	for (RID shape : p_quadrant->merged_shapes) {
+		PhysicsServer2D::get_singleton()->free(shape);
+	}
+	p_quadrant->merged_shapes.clear();
 }
 
 void TileMap::_physics_draw_quadrant_debug(TileMapQuadrant *p_quadrant) {
@@ -2972,6 +3299,8 @@ void TileMap::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("set_collision_animatable", "enabled"), &TileMap::set_collision_animatable);
 	ClassDB::bind_method(D_METHOD("is_collision_animatable"), &TileMap::is_collision_animatable);
+	ClassDB::bind_method(D_METHOD("set_collision_merge_full_tiles", "enabled"), &TileMap::set_collision_merge_full_tiles);
+	ClassDB::bind_method(D_METHOD("is_collision_merge_full_tiles_enabled"), &TileMap::is_collision_merge_full_tiles_enabled);
 	ClassDB::bind_method(D_METHOD("set_collision_visibility_mode", "collision_visibility_mode"), &TileMap::set_collision_visibility_mode);
 	ClassDB::bind_method(D_METHOD("get_collision_visibility_mode"), &TileMap::get_collision_visibility_mode);
 
@@ -3013,6 +3342,7 @@ void TileMap::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "tile_set", PROPERTY_HINT_RESOURCE_TYPE, "TileSet"), "set_tileset", "get_tileset");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "cell_quadrant_size", PROPERTY_HINT_RANGE, "1,128,1"), "set_quadrant_size", "get_quadrant_size");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "collision_animatable"), "set_collision_animatable", "is_collision_animatable");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "collision_merge_full_tiles"), "set_collision_merge_full_tiles", "is_collision_merge_full_tiles_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_visibility_mode", PROPERTY_HINT_ENUM, "Default,Force Show,Force Hide"), "set_collision_visibility_mode", "get_collision_visibility_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "navigation_visibility_mode", PROPERTY_HINT_ENUM, "Default,Force Show,Force Hide"), "set_navigation_visibility_mode", "get_navigation_visibility_mode");
 
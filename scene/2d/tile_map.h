@@ -68,10 +68,12 @@ struct TileMapQuadrant {
 
 	// Rendering.
 	List<RID> canvas_items;
+	List<RID> meshes;
 	List<RID> occluders;
 
 	// Physics.
 	List<RID> bodies;
+	List<RID> merged_shapes;
 
 	// Navigation.
 	Map<Vector2i, Vector<RID>> navigation_regions;
@@ -84,8 +86,10 @@ struct TileMapQuadrant {
 		coords = q.coords;
 		debug_canvas_item = q.debug_canvas_item;
 		canvas_items = q.canvas_items;
+		meshes = q.meshes;
 		occluders = q.occluders;
 		bodies = q.bodies;
+		merged_shapes = q.merged_shapes;
 		navigation_regions = q.navigation_regions;
 	}
 
@@ -95,8 +99,10 @@ struct TileMapQuadrant {
 		coords = q.coords;
 		debug_canvas_item = q.debug_canvas_item;
 		canvas_items = q.canvas_items;
+		meshes = q.meshes;
 		occluders = q.occluders;
 		bodies = q.bodies;
+		merged_shapes = q.merged_shapes;
 		navigation_regions = q.navigation_regions;
 	}
 
@@ -132,6 +138,7 @@ private:
 	Ref<TileSet> tile_set;
 	int quadrant_size = 16;
 	bool collision_animatable = false;
+	bool collision_merge_full_tiles = false;
 	VisibilityMode collision_visibility_mode = VISIBILITY_MODE_DEFAULT;
 	VisibilityMode navigation_visibility_mode = VISIBILITY_MODE_DEFAULT;
 
@@ -172,6 +179,7 @@ private:
 	void _make_all_quadrants_dirty();
 	void _queue_update_dirty_quadrants();
 
+	void _update_quadrant_coords_cache(uint32_t p_index, TileMapQuadrant **p_quadrants);
 	void _update_dirty_quadrants();
 
 	void _recreate_internals();
@@ -185,6 +193,22 @@ private:
 
 	// Per-system methods.
 	bool _rendering_quadrant_order_dirty = false;
+
+	// Consecutive static tiles sharing a canvas item and a texture, drawn as a single mesh.
+	struct RenderingMeshBake {
+		RID canvas_item;
+		Ref<Texture2D> texture;
+		Vector<Vector2> vertices;
+		Vector<Vector2> uvs;
+		Vector<Color> colors;
+		Vector<int> indices;
+		Rect2 item_rect;
+		bool item_has_tiles = false;
+		bool item_has_mesh = false;
+	};
+	bool _rendering_bake_tile(RenderingMeshBake &r_bake, TileMapQuadrant &r_quadrant, const TileMapCell &p_cell, Vector2 p_position, Color p_modulation, Rect2 &r_rect);
+	void _rendering_flush_mesh_bake(RenderingMeshBake &r_bake, TileMapQuadrant &r_quadrant);
+	void _rendering_finish_mesh_bake_item(RenderingMeshBake &r_bake, TileMapQuadrant &r_quadrant);
 	void _rendering_notification(int p_what);
 	void _rendering_update_layer(int p_layer);
 	void _rendering_cleanup_layer(int p_layer);
@@ -196,6 +220,15 @@ private:
 	Transform2D last_valid_transform;
 	Transform2D new_transform;
 	void _physics_notification(int p_what);
+	// Full tiles merged into rectangles, per TileSet physics layer.
+	struct PhysicsQuadrantBuild {
+		TileMapQuadrant *quadrant = nullptr;
+		LocalVector<LocalVector<Rect2i>> merged_rects;
+		LocalVector<Set<Vector2i>> merged_cells;
+	};
+	bool _physics_is_full_tile(TileData *p_tile_data, int p_physics_layer) const;
+	void _physics_build_quadrant(uint32_t p_index, PhysicsQuadrantBuild *p_builds);
+	RID _physics_create_body(TileMapQuadrant &r_quadrant, const Vector2i &p_coords, int p_tile_set_physics_layer, TileData *p_tile_data, const Transform2D &p_global_transform, RID p_space);
 	void _physics_update_dirty_quadrants(SelfList<TileMapQuadrant>::List &r_dirty_quadrant_list);
 	void _physics_cleanup_quadrant(TileMapQuadrant *p_quadrant);
 	void _physics_draw_quadrant_debug(TileMapQuadrant *p_quadrant);
@@ -267,6 +300,9 @@ public:
 	void set_collision_animatable(bool p_enabled);
 	bool is_collision_animatable() const;
 
+	void set_collision_merge_full_tiles(bool p_enabled);
+	bool is_collision_merge_full_tiles_enabled() const;
+
 	void set_collision_visibility_mode(VisibilityMode p_show_collision);
 	VisibilityMode get_collision_visibility_mode();
 
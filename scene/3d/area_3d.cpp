@@ -165,14 +165,14 @@ void Area3D::_body_enter_tree(ObjectID p_id) {
 	Node *node = Object::cast_to<Node>(obj);
 	ERR_FAIL_COND(!node);
 
-	Map<ObjectID, BodyState>::Element *E = body_map.find(p_id);
+	BodyState *E = body_map.getptr(p_id);
 	ERR_FAIL_COND(!E);
-	ERR_FAIL_COND(E->get().in_tree);
+	ERR_FAIL_COND(E->in_tree);
 
-	E->get().in_tree = true;
+	E->in_tree = true;
 	emit_signal(SceneStringNames::get_singleton()->body_entered, node);
-	for (int i = 0; i < E->get().shapes.size(); i++) {
-		emit_signal(SceneStringNames::get_singleton()->body_shape_entered, E->get().rid, node, E->get().shapes[i].body_shape, E->get().shapes[i].area_shape);
+	for (int i = 0; i < E->shapes.size(); i++) {
+		emit_signal(SceneStringNames::get_singleton()->body_shape_entered, E->rid, node, E->shapes[i].body_shape, E->shapes[i].area_shape);
 	}
 }
 
@@ -180,13 +180,26 @@ void Area3D::_body_exit_tree(ObjectID p_id) {
 	Object *obj = ObjectDB::get_instance(p_id);
 	Node *node = Object::cast_to<Node>(obj);
 	ERR_FAIL_COND(!node);
-	Map<ObjectID, BodyState>::Element *E = body_map.find(p_id);
+	BodyState *E = body_map.getptr(p_id);
 	ERR_FAIL_COND(!E);
-	ERR_FAIL_COND(!E->get().in_tree);
-	E->get().in_tree = false;
+	ERR_FAIL_COND(!E->in_tree);
+	E->in_tree = false;
 	emit_signal(SceneStringNames::get_singleton()->body_exited, node);
-	for (int i = 0; i < E->get().shapes.size(); i++) {
-		emit_signal(SceneStringNames::get_singleton()->body_shape_exited, E->get().rid, node, E->get().shapes[i].body_shape, E->get().shapes[i].area_shape);
+	for (int i = 0; i < E->shapes.size(); i++) {
+		emit_signal(SceneStringNames::get_singleton()->body_shape_exited, E->rid, node, E->shapes[i].body_shape, E->shapes[i].area_shape);
+	}
+}
+
+void Area3D::_monitor_events_callback(void *p_instance, const PhysicsServer3D::AreaMonitorEvent *p_events, int p_count) {
+	Area3D *area = (Area3D *)p_instance;
+	for (int i = 0; i < p_count; i++) {
+		const PhysicsServer3D::AreaMonitorEvent &event = p_events[i];
+		int status = event.added ? PhysicsServer3D::AREA_BODY_ADDED : PhysicsServer3D::AREA_BODY_REMOVED;
+		if (event.is_area) {
+			area->_area_inout(status, event.rid, event.instance_id, event.other_shape, event.self_shape);
+		} else {
+			area->_body_inout(status, event.rid, event.instance_id, event.other_shape, event.self_shape);
+		}
 	}
 }
 
@@ -194,50 +207,67 @@ void Area3D::_body_inout(int p_status, const RID &p_body, ObjectID p_instance, i
 	bool body_in = p_status == PhysicsServer3D::AREA_BODY_ADDED;
 	ObjectID objid = p_instance;
 
-	Object *obj = ObjectDB::get_instance(objid);
-	Node *node = Object::cast_to<Node>(obj);
-
-	Map<ObjectID, BodyState>::Element *E = body_map.find(objid);
+	BodyState *E = body_map.getptr(objid);
 
 	if (!body_in && !E) {
 		return; //likely removed from the tree
 	}
 
+	if (!overlap_signals) {
+		// Only keep track of the overlaps, for get_overlapping_bodies() and overlaps_body().
+		if (body_in) {
+			if (!E) {
+				E = &body_map[objid];
+				E->rid = p_body;
+			}
+			E->rc++;
+		} else {
+			E->rc--;
+			if (E->rc == 0) {
+				body_map.erase(objid);
+			}
+		}
+		return;
+	}
+
+	Object *obj = ObjectDB::get_instance(objid);
+	Node *node = Object::cast_to<Node>(obj);
+
 	locked = true;
 
 	if (body_in) {
 		if (!E) {
-			E = body_map.insert(objid, BodyState());
-			E->get().rid = p_body;
-			E->get().rc = 0;
-			E->get().in_tree = node && node->is_inside_tree();
+			E = &body_map[objid];
+			E->rid = p_body;
+			E->rc = 0;
+			E->in_tree = node && node->is_inside_tree();
 			if (node) {
 				node->connect(SceneStringNames::get_singleton()->tree_entered, callable_mp(this, &Area3D::_body_enter_tree), make_binds(objid));
 				node->connect(SceneStringNames::get_singleton()->tree_exiting, callable_mp(this, &Area3D::_body_exit_tree), make_binds(objid));
-				if (E->get().in_tree) {
+				if (E->in_tree) {
 					emit_signal(SceneStringNames::get_singleton()->body_entered, node);
 				}
 			}
 		}
-		E->get().rc++;
+		E->rc++;
 		if (node) {
-			E->get().shapes.insert(ShapePair(p_body_shape, p_area_shape));
+			E->shapes.insert(ShapePair(p_body_shape, p_area_shape));
 		}
 
-		if (E->get().in_tree) {
+		if (E->in_tree) {
 			emit_signal(SceneStringNames::get_singleton()->body_shape_entered, p_body, node, p_body_shape, p_area_shape);
 		}
 
 	} else {
-		E->get().rc--;
+		E->rc--;
 
 		if (node) {
-			E->get().shapes.erase(ShapePair(p_body_shape, p_area_shape));
+			E->shapes.erase(ShapePair(p_body_shape, p_area_shape));
 		}
 
-		bool in_tree = E->get().in_tree;
-		if (E->get().rc == 0) {
-			body_map.erase(E);
+		bool in_tree = E->in_tree;
+		if (E->rc == 0) {
+			body_map.erase(objid);
 			if (node) {
 				node->disconnect(SceneStringNames::get_singleton()->tree_entered, callable_mp(this, &Area3D::_body_enter_tree));
 				node->disconnect(SceneStringNames::get_singleton()->tree_exiting, callable_mp(this, &Area3D::_body_exit_tree));
@@ -257,13 +287,21 @@ void Area3D::_body_inout(int p_status, const RID &p_body, ObjectID p_instance, i
 void Area3D::_clear_monitoring() {
 	ERR_FAIL_COND_MSG(locked, "This function can't be used during the in/out signal.");
 
+	if (!overlap_signals) {
+		// Nothing was connected nor announced.
+		body_map.clear();
+		area_map.clear();
+		return;
+	}
+
 	{
-		Map<ObjectID, BodyState> bmcopy = body_map;
+		HashMap<ObjectID, BodyState> bmcopy = body_map;
 		body_map.clear();
 		//disconnect all monitored stuff
 
-		for (const KeyValue<ObjectID, BodyState> &E : bmcopy) {
-			Object *obj = ObjectDB::get_instance(E.key);
+		const ObjectID *K = nullptr;
+		while ((K = bmcopy.next(K))) {
+			Object *obj = ObjectDB::get_instance(*K);
 			Node *node = Object::cast_to<Node>(obj);
 
 			if (!node) { //node may have been deleted in previous frame or at other legitimate point
@@ -274,12 +312,13 @@ void Area3D::_clear_monitoring() {
 			node->disconnect(SceneStringNames::get_singleton()->tree_entered, callable_mp(this, &Area3D::_body_enter_tree));
 			node->disconnect(SceneStringNames::get_singleton()->tree_exiting, callable_mp(this, &Area3D::_body_exit_tree));
 
-			if (!E.value.in_tree) {
+			const BodyState &state = bmcopy[*K];
+			if (!state.in_tree) {
 				continue;
 			}
 
-			for (int i = 0; i < E.value.shapes.size(); i++) {
-				emit_signal(SceneStringNames::get_singleton()->body_shape_exited, E.value.rid, node, E.value.shapes[i].body_shape, E.value.shapes[i].area_shape);
+			for (int i = 0; i < state.shapes.size(); i++) {
+				emit_signal(SceneStringNames::get_singleton()->body_shape_exited, state.rid, node, state.shapes[i].body_shape, state.shapes[i].area_shape);
 			}
 
 			emit_signal(SceneStringNames::get_singleton()->body_exited, node);
@@ -287,12 +326,13 @@ void Area3D::_clear_monitoring() {
 	}
 
 	{
-		Map<ObjectID, AreaState> bmcopy = area_map;
+		HashMap<ObjectID, AreaState> bmcopy = area_map;
 		area_map.clear();
 		//disconnect all monitored stuff
 
-		for (const KeyValue<ObjectID, AreaState> &E : bmcopy) {
-			Object *obj = ObjectDB::get_instance(E.key);
+		const ObjectID *K = nullptr;
+		while ((K = bmcopy.next(K))) {
+			Object *obj = ObjectDB::get_instance(*K);
 			Node *node = Object::cast_to<Node>(obj);
 
 			if (!node) { //node may have been deleted in previous frame or at other legitimate point
@@ -303,12 +343,13 @@ void Area3D::_clear_monitoring() {
 			node->disconnect(SceneStringNames::get_singleton()->tree_entered, callable_mp(this, &Area3D::_area_enter_tree));
 			node->disconnect(SceneStringNames::get_singleton()->tree_exiting, callable_mp(this, &Area3D::_area_exit_tree));
 
-			if (!E.value.in_tree) {
+			const AreaState &state = bmcopy[*K];
+			if (!state.in_tree) {
 				continue;
 			}
 
-			for (int i = 0; i < E.value.shapes.size(); i++) {
-				emit_signal(SceneStringNames::get_singleton()->area_shape_exited, E.value.rid, node, E.value.shapes[i].area_shape, E.value.shapes[i].self_shape);
+			for (int i = 0; i < state.shapes.size(); i++) {
+				emit_signal(SceneStringNames::get_singleton()->area_shape_exited, state.rid, node, state.shapes[i].area_shape, state.shapes[i].self_shape);
 			}
 
 			emit_signal(SceneStringNames::get_singleton()->area_exited, obj);
@@ -334,11 +375,20 @@ void Area3D::set_monitoring(bool p_enable) {
 	monitoring = p_enable;
 
 	if (monitoring) {
-		PhysicsServer3D::get_singleton()->area_set_monitor_callback(get_rid(), this, SceneStringNames::get_singleton()->_body_inout);
-		PhysicsServer3D::get_singleton()->area_set_area_monitor_callback(get_rid(), this, SceneStringNames::get_singleton()->_area_inout);
+		// Prefer getting all the changes of a step in one call, without going through Variant.
+		monitor_events = PhysicsServer3D::get_singleton()->area_set_monitor_events_callback(get_rid(), this, &Area3D::_monitor_events_callback);
+		if (!monitor_events) {
+			PhysicsServer3D::get_singleton()->area_set_monitor_callback(get_rid(), this, SceneStringNames::get_singleton()->_body_inout);
+			PhysicsServer3D::get_singleton()->area_set_area_monitor_callback(get_rid(), this, SceneStringNames::get_singleton()->_area_inout);
+		}
 	} else {
-		PhysicsServer3D::get_singleton()->area_set_monitor_callback(get_rid(), nullptr, StringName());
-		PhysicsServer3D::get_singleton()->area_set_area_monitor_callback(get_rid(), nullptr, StringName());
+		if (monitor_events) {
+			PhysicsServer3D::get_singleton()->area_set_monitor_events_callback(get_rid(), nullptr, nullptr);
+			monitor_events = false;
+		} else {
+			PhysicsServer3D::get_singleton()->area_set_monitor_callback(get_rid(), nullptr, StringName());
+			PhysicsServer3D::get_singleton()->area_set_area_monitor_callback(get_rid(), nullptr, StringName());
+		}
 		_clear_monitoring();
 	}
 }
@@ -348,14 +398,14 @@ void Area3D::_area_enter_tree(ObjectID p_id) {
 	Node *node = Object::cast_to<Node>(obj);
 	ERR_FAIL_COND(!node);
 
-	Map<ObjectID, AreaState>::Element *E = area_map.find(p_id);
+	AreaState *E = area_map.getptr(p_id);
 	ERR_FAIL_COND(!E);
-	ERR_FAIL_COND(E->get().in_tree);
+	ERR_FAIL_COND(E->in_tree);
 
-	E->get().in_tree = true;
+	E->in_tree = true;
 	emit_signal(SceneStringNames::get_singleton()->area_entered, node);
-	for (int i = 0; i < E->get().shapes.size(); i++) {
-		emit_signal(SceneStringNames::get_singleton()->area_shape_entered, E->get().rid, node, E->get().shapes[i].area_shape, E->get().shapes[i].self_shape);
+	for (int i = 0; i < E->shapes.size(); i++) {
+		emit_signal(SceneStringNames::get_singleton()->area_shape_entered, E->rid, node, E->shapes[i].area_shape, E->shapes[i].self_shape);
 	}
 }
 
@@ -363,13 +413,13 @@ void Area3D::_area_exit_tree(ObjectID p_id) {
 	Object *obj = ObjectDB::get_instance(p_id);
 	Node *node = Object::cast_to<Node>(obj);
 	ERR_FAIL_COND(!node);
-	Map<ObjectID, AreaState>::Element *E = area_map.find(p_id);
+	AreaState *E = area_map.getptr(p_id);
 	ERR_FAIL_COND(!E);
-	ERR_FAIL_COND(!E->get().in_tree);
-	E->get().in_tree = false;
+	ERR_FAIL_COND(!E->in_tree);
+	E->in_tree = false;
 	emit_signal(SceneStringNames::get_singleton()->area_exited, node);
-	for (int i = 0; i < E->get().shapes.size(); i++) {
-		emit_signal(SceneStringNames::get_singleton()->area_shape_exited, E->get().rid, node, E->get().shapes[i].area_shape, E->get().shapes[i].self_shape);
+	for (int i = 0; i < E->shapes.size(); i++) {
+		emit_signal(SceneStringNames::get_singleton()->area_shape_exited, E->rid, node, E->shapes[i].area_shape, E->shapes[i].self_shape);
 	}
 }
 
@@ -377,50 +427,67 @@ void Area3D::_area_inout(int p_status, const RID &p_area, ObjectID p_instance, i
 	bool area_in = p_status == PhysicsServer3D::AREA_BODY_ADDED;
 	ObjectID objid = p_instance;
 
-	Object *obj = ObjectDB::get_instance(objid);
-	Node *node = Object::cast_to<Node>(obj);
-
-	Map<ObjectID, AreaState>::Element *E = area_map.find(objid);
+	AreaState *E = area_map.getptr(objid);
 
 	if (!area_in && !E) {
 		return; //likely removed from the tree
 	}
 
+	if (!overlap_signals) {
+		// Only keep track of the overlaps, for get_overlapping_areas() and overlaps_area().
+		if (area_in) {
+			if (!E) {
+				E = &area_map[objid];
+				E->rid = p_area;
+			}
+			E->rc++;
+		} else {
+			E->rc--;
+			if (E->rc == 0) {
+				area_map.erase(objid);
+			}
+		}
+		return;
+	}
+
+	Object *obj = ObjectDB::get_instance(objid);
+	Node *node = Object::cast_to<Node>(obj);
+
 	locked = true;
 
 	if (area_in) {
 		if (!E) {
-			E = area_map.insert(objid, AreaState());
-			E->get().rid = p_area;
-			E->get().rc = 0;
-			E->get().in_tree = node && node->is_inside_tree();
+			E = &area_map[objid];
+			E->rid = p_area;
+			E->rc = 0;
+			E->in_tree = node && node->is_inside_tree();
 			if (node) {
 				node->connect(SceneStringNames::get_singleton()->tree_entered, callable_mp(this, &Area3D::_area_enter_tree), make_binds(objid));
 				node->connect(SceneStringNames::get_singleton()->tree_exiting, callable_mp(this, &Area3D::_area_exit_tree), make_binds(objid));
-				if (E->get().in_tree) {
+				if (E->in_tree) {
 					emit_signal(SceneStringNames::get_singleton()->area_entered, node);
 				}
 			}
 		}
-		E->get().rc++;
+		E->rc++;
 		if (node) {
-			E->get().shapes.insert(AreaShapePair(p_area_shape, p_self_shape));
+			E->shapes.insert(AreaShapePair(p_area_shape, p_self_shape));
 		}
 
-		if (!node || E->get().in_tree) {
+		if (!node || E->in_tree) {
 			emit_signal(SceneStringNames::get_singleton()->area_shape_entered, p_area, node, p_area_shape, p_self_shape);
 		}
 
 	} else {
-		E->get().rc--;
+		E->rc--;
 
 		if (node) {
-			E->get().shapes.erase(AreaShapePair(p_area_shape, p_self_shape));
+			E->shapes.erase(AreaShapePair(p_area_shape, p_self_shape));
 		}
 
-		bool in_tree = E->get().in_tree;
-		if (E->get().rc == 0) {
-			area_map.erase(E);
+		bool in_tree = E->in_tree;
+		if (E->rc == 0) {
+			area_map.erase(objid);
 			if (node) {
 				node->disconnect(SceneStringNames::get_singleton()->tree_entered, callable_mp(this, &Area3D::_area_enter_tree));
 				node->disconnect(SceneStringNames::get_singleton()->tree_exiting, callable_mp(this, &Area3D::_area_exit_tree));
@@ -446,8 +513,9 @@ TypedArray<Node3D> Area3D::get_overlapping_bodies() const {
 	Array ret;
 	ret.resize(body_map.size());
 	int idx = 0;
-	for (const KeyValue<ObjectID, BodyState> &E : body_map) {
-		Object *obj = ObjectDB::get_instance(E.key);
+	const ObjectID *K = nullptr;
+	while ((K = body_map.next(K))) {
+		Object *obj = ObjectDB::get_instance(*K);
 		if (!obj) {
 			ret.resize(ret.size() - 1); //ops
 		} else {
@@ -474,13 +542,32 @@ bool Area3D::is_monitorable() const {
 	return monitorable;
 }
 
+void Area3D::set_overlap_signals(bool p_enable) {
+	ERR_FAIL_COND_MSG(locked, "Function blocked during in/out signal. Use set_deferred(\"overlap_signals\", true/false).");
+
+	if (p_enable == overlap_signals) {
+		return;
+	}
+
+	// Restart monitoring, so the current overlaps are reported again in the new mode.
+	bool was_monitoring = monitoring;
+	set_monitoring(false);
+	overlap_signals = p_enable;
+	set_monitoring(was_monitoring);
+}
+
+bool Area3D::is_emitting_overlap_signals() const {
+	return overlap_signals;
+}
+
 TypedArray<Area3D> Area3D::get_overlapping_areas() const {
 	ERR_FAIL_COND_V(!monitoring, Array());
 	Array ret;
 	ret.resize(area_map.size());
 	int idx = 0;
-	for (const KeyValue<ObjectID, AreaState> &E : area_map) {
-		Object *obj = ObjectDB::get_instance(E.key);
+	const ObjectID *K = nullptr;
+	while ((K = area_map.next(K))) {
+		Object *obj = ObjectDB::get_instance(*K);
 		if (!obj) {
 			ret.resize(ret.size() - 1); //ops
 		} else {
@@ -493,20 +580,21 @@ TypedArray<Area3D> Area3D::get_overlapping_areas() const {
 
 bool Area3D::overlaps_area(Node *p_area) const {
 	ERR_FAIL_NULL_V(p_area, false);
-	const Map<ObjectID, AreaState>::Element *E = area_map.find(p_area->get_instance_id());
+	const AreaState *E = area_map.getptr(p_area->get_instance_id());
 	if (!E) {
 		return false;
 	}
-	return E->get().in_tree;
+	// Without signals, tree changes aren't tracked.
+	return overlap_signals ? E->in_tree : p_area->is_inside_tree();
 }
 
 bool Area3D::overlaps_body(Node *p_body) const {
 	ERR_FAIL_NULL_V(p_body, false);
-	const Map<ObjectID, BodyState>::Element *E = body_map.find(p_body->get_instance_id());
+	const BodyState *E = body_map.getptr(p_body->get_instance_id());
 	if (!E) {
 		return false;
 	}
-	return E->get().in_tree;
+	return overlap_signals ? E->in_tree : p_body->is_inside_tree();
 }
 
 void Area3D::set_audio_bus_override(bool p_override) {
@@ -622,6 +710,9 @@ void Area3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_monitoring", "enable"), &Area3D::set_monitoring);
 	ClassDB::bind_method(D_METHOD("is_monitoring"), &Area3D::is_monitoring);
 
+	ClassDB::bind_method(D_METHOD("set_overlap_signals", "enable"), &Area3D::set_overlap_signals);
+	ClassDB::bind_method(D_METHOD("is_emitting_overlap_signals"), &Area3D::is_emitting_overlap_signals);
+
 	ClassDB::bind_method(D_METHOD("get_overlapping_bodies"), &Area3D::get_overlapping_bodies);
 	ClassDB::bind_method(D_METHOD("get_overlapping_areas"), &Area3D::get_overlapping_areas);
 
@@ -661,6 +752,7 @@ void Area3D::_bind_methods() {
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "monitoring"), "set_monitoring", "is_monitoring");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "monitorable"), "set_monitorable", "is_monitorable");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "overlap_signals"), "set_overlap_signals", "is_emitting_overlap_signals");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "priority", PROPERTY_HINT_RANGE, "0,128,1"), "set_priority", "get_priority");
 
 	ADD_GROUP("Physics Overrides", "");
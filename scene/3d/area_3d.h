@@ -31,6 +31,7 @@
 #ifndef AREA_3D_H
 #define AREA_3D_H
 
+#include "core/templates/hash_map.h"
 #include "core/templates/vset.h"
 #include "scene/3d/collision_object_3d.h"
 
@@ -60,8 +61,12 @@ private:
 	NodePath wind_source_path;
 	bool monitoring = false;
 	bool monitorable = false;
+	bool overlap_signals = true;
+	bool monitor_events = false;
 	bool locked = false;
 
+	static void _monitor_events_callback(void *p_instance, const PhysicsServer3D::AreaMonitorEvent *p_events, int p_count);
+
 	void _body_inout(int p_status, const RID &p_body, ObjectID p_instance, int p_body_shape, int p_area_shape);
 
 	void _body_enter_tree(ObjectID p_id);
@@ -92,7 +97,7 @@ private:
 		VSet<ShapePair> shapes;
 	};
 
-	Map<ObjectID, BodyState> body_map;
+	HashMap<ObjectID, BodyState> body_map;
 
 	void _area_inout(int p_status, const RID &p_area, ObjectID p_instance, int p_area_shape, int p_self_shape);
 
@@ -124,7 +129,7 @@ private:
 		VSet<AreaShapePair> shapes;
 	};
 
-	Map<ObjectID, AreaState> area_map;
+	HashMap<ObjectID, AreaState> area_map;
 	void _clear_monitoring();
 
 	bool audio_bus_override = false;
@@ -183,6 +188,9 @@ public:
 	void set_monitorable(bool p_enable);
 	bool is_monitorable() const;
 
+	void set_overlap_signals(bool p_enable);
+	bool is_emitting_overlap_signals() const;
+
 	TypedArray<Node3D> get_overlapping_bodies() const;
 	TypedArray<Area3D> get_overlapping_areas() const; //function for script
 
@@ -283,6 +283,7 @@ void AudioStreamPlayer3D::_notification(int p_what) {
 			Map<StringName, Vector<AudioFrame>> bus_map;
 			bus_map[_get_actual_bus()] = volume_vector;
 			AudioServer::get_singleton()->start_playback_stream(new_playback, bus_map, setplay.get(), actual_pitch_scale, linear_attenuation, attenuation_filter_cutoff_hz);
+			AudioServer::get_singleton()->set_playback_priority(new_playback, voice_priority);
 			stream_playbacks.push_back(new_playback);
 			setplay.set(-1);
 		}
@@ -382,6 +383,8 @@ Vector<AudioFrame> AudioStreamPlayer3D::_update_panning() {
 
 	PhysicsDirectSpaceState3D *space_state = PhysicsServer3D::get_singleton()->space_get_direct_state(world_3d->get_space());
 
+	bool heard = false;
+
 	for (Camera3D *camera : cameras) {
 		Viewport *vp = camera->get_viewport();
 		if (!vp->is_audio_listener_3d()) {
@@ -422,6 +425,8 @@ Vector<AudioFrame> AudioStreamPlayer3D::_update_panning() {
 			}
 		}
 
+		heard = true;
+
 		float multiplier = Math::db2linear(_get_attenuation_db(dist));
 		if (max_distance > 0) {
 			multiplier *= MAX(0, 1.0 - (dist / max_distance));
@@ -439,9 +444,6 @@ Vector<AudioFrame> AudioStreamPlayer3D::_update_panning() {
 		}
 
 		linear_attenuation = Math::db2linear(db_att);
-		for (Ref<AudioStreamPlayback> &playback : stream_playbacks) {
-			AudioServer::get_singleton()->set_playback_highshelf_params(playback, linear_attenuation, attenuation_filter_cutoff_hz);
-		}
 		//TODO: The lower the second parameter (tightness) the more the sound will "enclose" the listener (more undirected / playing from
 		//      speakers not facing the source) - this could be made distance dependent.
 		_calc_output_vol(local_pos.normalized(), 4.0, output_volume_vector);
@@ -467,10 +469,6 @@ Vector<AudioFrame> AudioStreamPlayer3D::_update_panning() {
 			bus_volumes[bus] = output_volume_vector;
 		}
 
-		for (Ref<AudioStreamPlayback> &playback : stream_playbacks) {
-			AudioServer::get_singleton()->set_playback_bus_volumes_linear(playback, bus_volumes);
-		}
-
 		if (doppler_tracking != DOPPLER_TRACKING_DISABLED) {
 			Vector3 listener_velocity;
 
@@ -495,13 +493,41 @@ Vector<AudioFrame> AudioStreamPlayer3D::_update_panning() {
 		} else {
 			actual_pitch_scale = pitch_scale;
 		}
-		for (Ref<AudioStreamPlayback> &playback : stream_playbacks) {
-			AudioServer::get_singleton()->set_playback_pitch_scale(playback, actual_pitch_scale);
-		}
+
+		_queue_playback_updates(bus_volumes);
+	}
+
+	if (!heard) {
+		// Out of range of every listener, silence it so the AudioServer can virtualize it.
+		Map<StringName, Vector<AudioFrame>> bus_volumes;
+		bus_volumes[_get_actual_bus()] = output_volume_vector;
+		_queue_playback_updates(bus_volumes);
 	}
 	return output_volume_vector;
 }
 
+void AudioStreamPlayer3D::_queue_playback_updates(const Map<StringName, Vector<AudioFrame>> &p_bus_volumes) {
+	AudioServer::PlaybackParamsUpdate update;
+	for (const KeyValue<StringName, Vector<AudioFrame>> &E : p_bus_volumes) {
+		if (update.bus_count == AudioServer::MAX_BUSES_PER_PLAYBACK) {
+			break;
+		}
+		update.bus[update.bus_count] = E.key;
+		for (int i = 0; i < AudioServer::MAX_CHANNELS_PER_BUS; i++) {
+			update.volume[update.bus_count][i] = E.value[i];
+		}
+		update.bus_count++;
+	}
+	update.pitch_scale = actual_pitch_scale;
+	update.highshelf_gain = linear_attenuation;
+	update.attenuation_cutoff_hz = attenuation_filter_cutoff_hz;
+
+	for (const Ref<AudioStreamPlayback> &playback : stream_playbacks) {
+		update.playback = playback;
+		AudioServer::get_singleton()->queue_playback_params_update(update);
+	}
+}
+
 void AudioStreamPlayer3D::set_stream(Ref<AudioStream> p_stream) {
 	stop();
 	stream = p_stream;
@@ -590,10 +616,7 @@ float AudioStreamPlayer3D::get_playback_position() {
 }
 
 void AudioStreamPlayer3D::set_bus(const StringName &p_bus) {
-	//if audio is active, must lock this
-	AudioServer::get_singleton()->lock();
-	bus = p_bus;
-	AudioServer::get_singleton()->unlock();
+	bus = p_bus; // This will be pushed to the audio server during the next physics timestep, which is fast enough.
 }
 
 StringName AudioStreamPlayer3D::get_bus() const {
@@ -767,6 +790,17 @@ int AudioStreamPlayer3D::get_max_polyphony() const {
 	return max_polyphony;
 }
 
+void AudioStreamPlayer3D::set_voice_priority(int p_priority) {
+	voice_priority = p_priority;
+	for (Ref<AudioStreamPlayback> &playback : stream_playbacks) {
+		AudioServer::get_singleton()->set_playback_priority(playback, voice_priority);
+	}
+}
+
+int AudioStreamPlayer3D::get_voice_priority() const {
+	return voice_priority;
+}
+
 void AudioStreamPlayer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_stream", "stream"), &AudioStreamPlayer3D::set_stream);
 	ClassDB::bind_method(D_METHOD("get_stream"), &AudioStreamPlayer3D::get_stream);
@@ -832,6 +866,9 @@ void AudioStreamPlayer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_max_polyphony", "max_polyphony"), &AudioStreamPlayer3D::set_max_polyphony);
 	ClassDB::bind_method(D_METHOD("get_max_polyphony"), &AudioStreamPlayer3D::get_max_polyphony);
 
+	ClassDB::bind_method(D_METHOD("set_voice_priority", "priority"), &AudioStreamPlayer3D::set_voice_priority);
+	ClassDB::bind_method(D_METHOD("get_voice_priority"), &AudioStreamPlayer3D::get_voice_priority);
+
 	ClassDB::bind_method(D_METHOD("get_stream_playback"), &AudioStreamPlayer3D::get_stream_playback);
 
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "stream", PROPERTY_HINT_RESOURCE_TYPE, "AudioStream"), "set_stream", "get_stream");
@@ -845,6 +882,7 @@ void AudioStreamPlayer3D::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "stream_paused", PROPERTY_HINT_NONE, ""), "set_stream_paused", "get_stream_paused");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "max_distance", PROPERTY_HINT_RANGE, "0,4096,0.01,or_greater"), "set_max_distance", "get_max_distance");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_polyphony", PROPERTY_HINT_NONE, ""), "set_max_polyphony", "get_max_polyphony");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "voice_priority"), "set_voice_priority", "get_voice_priority");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "bus", PROPERTY_HINT_ENUM, ""), "set_bus", "get_bus");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "area_mask", PROPERTY_HINT_LAYERS_2D_PHYSICS), "set_area_mask", "get_area_mask");
 	ADD_GROUP("Emission Angle", "emission_angle");
@@ -80,6 +80,7 @@ private:
 	bool autoplay = false;
 	StringName bus = SNAME("Master");
 	int max_polyphony = 1;
+	int voice_priority = 0;
 
 	uint64_t last_mix_count = -1;
 
@@ -94,6 +95,7 @@ private:
 	StringName _get_actual_bus();
 	Area3D *_get_overriding_area();
 	Vector<AudioFrame> _update_panning();
+	void _queue_playback_updates(const Map<StringName, Vector<AudioFrame>> &p_bus_volumes);
 
 	void _bus_layout_changed();
 
@@ -148,6 +150,9 @@ public:
 	void set_max_polyphony(int p_max_polyphony);
 	int get_max_polyphony() const;
 
+	void set_voice_priority(int p_priority);
+	int get_voice_priority() const;
+
 	void set_autoplay(bool p_enable);
 	bool is_autoplay_enabled();
 
@@ -102,6 +102,8 @@ void Camera3D::_notification(int p_what) {
 			viewport = get_viewport();
 			ERR_FAIL_COND(!viewport);
 
+			RenderingServer::get_singleton()->camera_set_interpolated(camera, get_tree()->is_physics_interpolation_enabled());
+
 			bool first_camera = viewport->_camera_3d_add(this);
 			if (current || first_camera) {
 				viewport->_camera_3d_set(this);
@@ -114,6 +116,9 @@ void Camera3D::_notification(int p_what) {
 				velocity_tracker->update_position(get_global_transform().origin);
 			}
 		} break;
+		case NOTIFICATION_RESET_PHYSICS_INTERPOLATION: {
+			RenderingServer::get_singleton()->camera_reset_physics_interpolation(camera);
+		} break;
 		case NOTIFICATION_EXIT_WORLD: {
 			if (!get_tree()->is_node_being_edited(this)) {
 				if (is_current()) {
@@ -125,6 +130,8 @@ void Camera3D::_notification(int p_what) {
 				}
 			}
 
+			RenderingServer::get_singleton()->camera_set_interpolated(camera, false);
+
 			if (viewport) {
 				viewport->_camera_3d_remove(this);
 				viewport = nullptr;
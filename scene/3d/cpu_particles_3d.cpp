@@ -30,11 +30,16 @@
 
 #include "cpu_particles_3d.h"
 
+#include "core/os/worker_thread_pool.h"
 #include "scene/3d/camera_3d.h"
 #include "scene/3d/gpu_particles_3d.h"
 #include "scene/main/viewport.h"
 #include "scene/resources/particles_material.h"
 
+// Emitters with fewer particles are processed on the calling thread.
+#define CPU_PARTICLES_THREADED_MIN 256
+#define CPU_PARTICLES_THREADED_BATCH 64
+
 AABB CPUParticles3D::get_aabb() const {
 	return AABB();
 }
@@ -76,6 +81,7 @@ void CPUParticles3D::set_amount(int p_amount) {
 	RS::get_singleton()->multimesh_allocate_data(multimesh, p_amount, RS::MULTIMESH_TRANSFORM_3D, true, true);
 
 	particle_order.resize(p_amount);
+	particle_steps.resize(p_amount);
 }
 
 void CPUParticles3D::set_lifetime(double p_lifetime) {
@@ -556,7 +562,7 @@ static real_t rand_from_seed(uint32_t &seed) {
 }
 
 void CPUParticles3D::_update_internal() {
-	if (particles.size() == 0 || !is_visible_in_tree()) {
+	if (particles.size() == 0 || !is_visible_in_tree() || !Engine::get_singleton()->is_visual_processing_enabled()) {
 		_set_redraw(false);
 		return;
 	}
@@ -657,8 +663,14 @@ void CPUParticles3D::_particles_process(double p_delta) {
 
 	double system_phase = time / lifetime;
 
+	// Emission draws from the global random generator, so restarting particles
+	// stays serial to keep the sequence. The update runs in parallel below.
+	ParticleStep *steps = particle_steps.ptr();
+
 	for (int i = 0; i < pcount; i++) {
 		Particle &p = parray[i];
+		ParticleStep &step = steps[i];
+		step.mode = PARTICLE_STEP_SKIP;
 
 		if (!emitting && !p.active) {
 			continue;
@@ -866,13 +878,59 @@ void CPUParticles3D::_particles_process(double p_delta) {
 				p.velocity.z = 0.0;
 				p.transform.origin.z = 0.0;
 			}
-
+			step.mode = PARTICLE_STEP_EMITTED;
 		} else if (!p.active) {
 			continue;
 		} else if (p.time > p.lifetime) {
 			p.active = false;
-			tv = 1.0;
+			step.mode = PARTICLE_STEP_EXPIRED;
 		} else {
+			step.mode = PARTICLE_STEP_UPDATE;
+		}
+
+		step.delta = local_delta;
+	}
+
+	ProcessData data;
+	data.particles = parray;
+	data.steps = steps;
+	data.emission_origin = emission_xform.origin;
+	if (draw_order == DRAW_ORDER_INDEX) {
+		// Nothing to sort, so the rows are written while the particles are hot and
+		// _update_particle_data_buffer() doesn't repack them. The render thread
+		// doesn't read the buffer until can_update is set again.
+		MutexLock lock(update_mutex);
+		can_update.clear();
+		data.rows = particle_data.ptrw();
+	}
+
+	// Gradients sort their points lazily, do it before they are read from several threads.
+	if (color_ramp.is_valid()) {
+		color_ramp->get_color_at_offset(0.0);
+	}
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (pcount < CPU_PARTICLES_THREADED_MIN || !pool || pool->get_thread_count() == 0) {
+		for (int i = 0; i < pcount; i++) {
+			_particle_update(i, &data);
+		}
+	} else {
+		WorkerThreadPool::GroupID group = pool->add_template_group_task(this, &CPUParticles3D::_particle_update, (const ProcessData *)&data, pcount, -1, CPU_PARTICLES_THREADED_BATCH);
+		pool->wait_for_group_task_completion(group);
+	}
+}
+
+void CPUParticles3D::_particle_update(uint32_t p_index, const ProcessData *p_data) {
+	Particle &p = p_data->particles[p_index];
+	const ParticleStep &step = p_data->steps[p_index];
+
+	if (step.mode != PARTICLE_STEP_SKIP) {
+		double local_delta = step.delta;
+		float tv = 0.0;
+
+		if (step.mode == PARTICLE_STEP_EXPIRED) {
+			tv = 1.0;
+		} else if (step.mode == PARTICLE_STEP_UPDATE) {
 			uint32_t alt_seed = p.seed;
 
 			p.time += local_delta;
@@ -938,7 +996,7 @@ void CPUParticles3D::_particles_process(double p_delta) {
 			//apply linear acceleration
 			force += p.velocity.length() > 0.0 ? p.velocity.normalized() * tex_linear_accel * Math::lerp(parameters_min[PARAM_LINEAR_ACCEL], parameters_max[PARAM_LINEAR_ACCEL], rand_from_seed(alt_seed)) : Vector3();
 			//apply radial acceleration
-			Vector3 org = emission_xform.origin;
+			Vector3 org = p_data->emission_origin;
 			Vector3 diff = position - org;
 			force += diff.length() > 0.0 ? diff.normalized() * (tex_radial_accel)*Math::lerp(parameters_min[PARAM_RADIAL_ACCEL], parameters_max[PARAM_RADIAL_ACCEL], rand_from_seed(alt_seed)) : Vector3();
 			if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
@@ -984,219 +1042,235 @@ void CPUParticles3D::_particles_process(double p_delta) {
 			p.custom[0] = Math::deg2rad(base_angle); //angle
 			p.custom[2] = tex_anim_offset * Math::lerp(parameters_min[PARAM_ANIM_OFFSET], parameters_max[PARAM_ANIM_OFFSET], p.anim_offset_rand) + p.custom[1] * tex_anim_speed * Math::lerp(parameters_min[PARAM_ANIM_SPEED], parameters_max[PARAM_ANIM_SPEED], rand_from_seed(alt_seed)); //angle
 		}
-		//apply color
-		//apply hue rotation
 
-		Vector3 tex_scale = Vector3(1.0, 1.0, 1.0);
-		if (split_scale) {
-			if (scale_curve_x.is_valid()) {
-				tex_scale.x = scale_curve_x->interpolate(tv);
-			} else {
-				tex_scale.x = 1.0;
-			}
-			if (scale_curve_y.is_valid()) {
-				tex_scale.y = scale_curve_y->interpolate(tv);
-			} else {
-				tex_scale.y = 1.0;
-			}
-			if (scale_curve_z.is_valid()) {
-				tex_scale.z = scale_curve_z->interpolate(tv);
+			//apply color
+			//apply hue rotation
+
+			Vector3 tex_scale = Vector3(1.0, 1.0, 1.0);
+			if (split_scale) {
+				if (scale_curve_x.is_valid()) {
+					tex_scale.x = scale_curve_x->interpolate(tv);
+				} else {
+					tex_scale.x = 1.0;
+				}
+				if (scale_curve_y.is_valid()) {
+					tex_scale.y = scale_curve_y->interpolate(tv);
+				} else {
+					tex_scale.y = 1.0;
+				}
+				if (scale_curve_z.is_valid()) {
+					tex_scale.z = scale_curve_z->interpolate(tv);
+				} else {
+					tex_scale.z = 1.0;
+				}
 			} else {
-				tex_scale.z = 1.0;
+				if (curve_parameters[PARAM_SCALE].is_valid()) {
+					float tmp_scale = curve_parameters[PARAM_SCALE]->interpolate(tv);
+					tex_scale.x = tmp_scale;
+					tex_scale.y = tmp_scale;
+					tex_scale.z = tmp_scale;
+				}
 			}
-		} else {
-			if (curve_parameters[PARAM_SCALE].is_valid()) {
-				float tmp_scale = curve_parameters[PARAM_SCALE]->interpolate(tv);
-				tex_scale.x = tmp_scale;
-				tex_scale.y = tmp_scale;
-				tex_scale.z = tmp_scale;
+
+			real_t tex_hue_variation = 0.0;
+			if (curve_parameters[PARAM_HUE_VARIATION].is_valid()) {
+				tex_hue_variation = curve_parameters[PARAM_HUE_VARIATION]->interpolate(tv);
 			}
-		}
 
-		real_t tex_hue_variation = 0.0;
-		if (curve_parameters[PARAM_HUE_VARIATION].is_valid()) {
-			tex_hue_variation = curve_parameters[PARAM_HUE_VARIATION]->interpolate(tv);
-		}
+			real_t hue_rot_angle = (tex_hue_variation)*Math_TAU * Math::lerp(parameters_min[PARAM_HUE_VARIATION], parameters_max[PARAM_HUE_VARIATION], p.hue_rot_rand);
+			real_t hue_rot_c = Math::cos(hue_rot_angle);
+			real_t hue_rot_s = Math::sin(hue_rot_angle);
 
-		real_t hue_rot_angle = (tex_hue_variation)*Math_TAU * Math::lerp(parameters_min[PARAM_HUE_VARIATION], parameters_max[PARAM_HUE_VARIATION], p.hue_rot_rand);
-		real_t hue_rot_c = Math::cos(hue_rot_angle);
-		real_t hue_rot_s = Math::sin(hue_rot_angle);
+			Basis hue_rot_mat;
+			{
+				Basis mat1(0.299, 0.587, 0.114, 0.299, 0.587, 0.114, 0.299, 0.587, 0.114);
+				Basis mat2(0.701, -0.587, -0.114, -0.299, 0.413, -0.114, -0.300, -0.588, 0.886);
+				Basis mat3(0.168, 0.330, -0.497, -0.328, 0.035, 0.292, 1.250, -1.050, -0.203);
 
-		Basis hue_rot_mat;
-		{
-			Basis mat1(0.299, 0.587, 0.114, 0.299, 0.587, 0.114, 0.299, 0.587, 0.114);
-			Basis mat2(0.701, -0.587, -0.114, -0.299, 0.413, -0.114, -0.300, -0.588, 0.886);
-			Basis mat3(0.168, 0.330, -0.497, -0.328, 0.035, 0.292, 1.250, -1.050, -0.203);
+				for (int j = 0; j < 3; j++) {
+					hue_rot_mat[j] = mat1[j] + mat2[j] * hue_rot_c + mat3[j] * hue_rot_s;
+				}
+			}
 
-			for (int j = 0; j < 3; j++) {
-				hue_rot_mat[j] = mat1[j] + mat2[j] * hue_rot_c + mat3[j] * hue_rot_s;
+			if (color_ramp.is_valid()) {
+				p.color = color_ramp->get_color_at_offset(tv) * color;
+			} else {
+				p.color = color;
 			}
-		}
 
-		if (color_ramp.is_valid()) {
-			p.color = color_ramp->get_color_at_offset(tv) * color;
-		} else {
-			p.color = color;
-		}
+			Vector3 color_rgb = hue_rot_mat.xform_inv(Vector3(p.color.r, p.color.g, p.color.b));
+			p.color.r = color_rgb.x;
+			p.color.g = color_rgb.y;
+			p.color.b = color_rgb.z;
 
-		Vector3 color_rgb = hue_rot_mat.xform_inv(Vector3(p.color.r, p.color.g, p.color.b));
-		p.color.r = color_rgb.x;
-		p.color.g = color_rgb.y;
-		p.color.b = color_rgb.z;
+			p.color *= p.base_color;
 
-		p.color *= p.base_color;
+			if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
+				if (particle_flags[PARTICLE_FLAG_ALIGN_Y_TO_VELOCITY]) {
+					if (p.velocity.length() > 0.0) {
+						p.transform.basis.set_axis(1, p.velocity.normalized());
+					} else {
+						p.transform.basis.set_axis(1, p.transform.basis.get_axis(1));
+					}
+					p.transform.basis.set_axis(0, p.transform.basis.get_axis(1).cross(p.transform.basis.get_axis(2)).normalized());
+					p.transform.basis.set_axis(2, Vector3(0, 0, 1));
 
-		if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
-			if (particle_flags[PARTICLE_FLAG_ALIGN_Y_TO_VELOCITY]) {
-				if (p.velocity.length() > 0.0) {
-					p.transform.basis.set_axis(1, p.velocity.normalized());
 				} else {
-					p.transform.basis.set_axis(1, p.transform.basis.get_axis(1));
+					p.transform.basis.set_axis(0, Vector3(Math::cos(p.custom[0]), -Math::sin(p.custom[0]), 0.0));
+					p.transform.basis.set_axis(1, Vector3(Math::sin(p.custom[0]), Math::cos(p.custom[0]), 0.0));
+					p.transform.basis.set_axis(2, Vector3(0, 0, 1));
 				}
-				p.transform.basis.set_axis(0, p.transform.basis.get_axis(1).cross(p.transform.basis.get_axis(2)).normalized());
-				p.transform.basis.set_axis(2, Vector3(0, 0, 1));
 
 			} else {
-				p.transform.basis.set_axis(0, Vector3(Math::cos(p.custom[0]), -Math::sin(p.custom[0]), 0.0));
-				p.transform.basis.set_axis(1, Vector3(Math::sin(p.custom[0]), Math::cos(p.custom[0]), 0.0));
-				p.transform.basis.set_axis(2, Vector3(0, 0, 1));
-			}
-
-		} else {
-			//orient particle Y towards velocity
-			if (particle_flags[PARTICLE_FLAG_ALIGN_Y_TO_VELOCITY]) {
-				if (p.velocity.length() > 0.0) {
-					p.transform.basis.set_axis(1, p.velocity.normalized());
+				//orient particle Y towards velocity
+				if (particle_flags[PARTICLE_FLAG_ALIGN_Y_TO_VELOCITY]) {
+					if (p.velocity.length() > 0.0) {
+						p.transform.basis.set_axis(1, p.velocity.normalized());
+					} else {
+						p.transform.basis.set_axis(1, p.transform.basis.get_axis(1).normalized());
+					}
+					if (p.transform.basis.get_axis(1) == p.transform.basis.get_axis(0)) {
+						p.transform.basis.set_axis(0, p.transform.basis.get_axis(1).cross(p.transform.basis.get_axis(2)).normalized());
+						p.transform.basis.set_axis(2, p.transform.basis.get_axis(0).cross(p.transform.basis.get_axis(1)).normalized());
+					} else {
+						p.transform.basis.set_axis(2, p.transform.basis.get_axis(0).cross(p.transform.basis.get_axis(1)).normalized());
+						p.transform.basis.set_axis(0, p.transform.basis.get_axis(1).cross(p.transform.basis.get_axis(2)).normalized());
+					}
 				} else {
-					p.transform.basis.set_axis(1, p.transform.basis.get_axis(1).normalized());
+					p.transform.basis.orthonormalize();
 				}
-				if (p.transform.basis.get_axis(1) == p.transform.basis.get_axis(0)) {
-					p.transform.basis.set_axis(0, p.transform.basis.get_axis(1).cross(p.transform.basis.get_axis(2)).normalized());
-					p.transform.basis.set_axis(2, p.transform.basis.get_axis(0).cross(p.transform.basis.get_axis(1)).normalized());
-				} else {
-					p.transform.basis.set_axis(2, p.transform.basis.get_axis(0).cross(p.transform.basis.get_axis(1)).normalized());
-					p.transform.basis.set_axis(0, p.transform.basis.get_axis(1).cross(p.transform.basis.get_axis(2)).normalized());
+
+				//turn particle by rotation in Y
+				if (particle_flags[PARTICLE_FLAG_ROTATE_Y]) {
+					Basis rot_y(Vector3(0, 1, 0), p.custom[0]);
+					p.transform.basis = p.transform.basis * rot_y;
 				}
-			} else {
-				p.transform.basis.orthonormalize();
 			}
 
-			//turn particle by rotation in Y
-			if (particle_flags[PARTICLE_FLAG_ROTATE_Y]) {
-				Basis rot_y(Vector3(0, 1, 0), p.custom[0]);
-				p.transform.basis = p.transform.basis * rot_y;
+			p.transform.basis = p.transform.basis.orthonormalized();
+			//scale by scale
+
+			Vector3 base_scale = tex_scale * Math::lerp(parameters_min[PARAM_SCALE], parameters_max[PARAM_SCALE], p.scale_rand);
+			if (base_scale.x < CMP_EPSILON) {
+				base_scale.x = CMP_EPSILON;
+			}
+			if (base_scale.y < CMP_EPSILON) {
+				base_scale.y = CMP_EPSILON;
+			}
+			if (base_scale.z < CMP_EPSILON) {
+				base_scale.z = CMP_EPSILON;
 			}
-		}
 
-		p.transform.basis = p.transform.basis.orthonormalized();
-		//scale by scale
+			p.transform.basis.scale(base_scale);
 
-		Vector3 base_scale = tex_scale * Math::lerp(parameters_min[PARAM_SCALE], parameters_max[PARAM_SCALE], p.scale_rand);
-		if (base_scale.x < CMP_EPSILON) {
-			base_scale.x = CMP_EPSILON;
-		}
-		if (base_scale.y < CMP_EPSILON) {
-			base_scale.y = CMP_EPSILON;
-		}
-		if (base_scale.z < CMP_EPSILON) {
-			base_scale.z = CMP_EPSILON;
-		}
+			if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
+				p.velocity.z = 0.0;
+				p.transform.origin.z = 0.0;
+			}
 
-		p.transform.basis.scale(base_scale);
+			p.transform.origin += p.velocity * local_delta;
+	}
 
-		if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
-			p.velocity.z = 0.0;
-			p.transform.origin.z = 0.0;
+	if (p_data->rows) {
+		_write_particle_row(p_data->rows + p_index * 20, p);
+	}
+}
+
+void CPUParticles3D::_write_particle_row(float *r_row, const Particle &p_particle) const {
+	if (p_particle.active) {
+		Transform3D t = p_particle.transform;
+		if (!local_coords) {
+			t = inv_emission_transform * t;
 		}
 
-		p.transform.origin += p.velocity * local_delta;
+		r_row[0] = t.basis.elements[0][0];
+		r_row[1] = t.basis.elements[0][1];
+		r_row[2] = t.basis.elements[0][2];
+		r_row[3] = t.origin.x;
+		r_row[4] = t.basis.elements[1][0];
+		r_row[5] = t.basis.elements[1][1];
+		r_row[6] = t.basis.elements[1][2];
+		r_row[7] = t.origin.y;
+		r_row[8] = t.basis.elements[2][0];
+		r_row[9] = t.basis.elements[2][1];
+		r_row[10] = t.basis.elements[2][2];
+		r_row[11] = t.origin.z;
+	} else {
+		memset(r_row, 0, sizeof(float) * 12);
 	}
+
+	const Color &c = p_particle.color;
+
+	r_row[12] = c.r;
+	r_row[13] = c.g;
+	r_row[14] = c.b;
+	r_row[15] = c.a;
+
+	r_row[16] = p_particle.custom[0];
+	r_row[17] = p_particle.custom[1];
+	r_row[18] = p_particle.custom[2];
+	r_row[19] = p_particle.custom[3];
+}
+
+void CPUParticles3D::_write_particle_row_ordered(uint32_t p_index, const RowData *p_data) {
+	_write_particle_row(p_data->rows + p_index * 20, p_data->particles[p_data->order[p_index]]);
 }
 
 void CPUParticles3D::_update_particle_data_buffer() {
 	MutexLock lock(update_mutex);
 
-	int pc = particles.size();
+	if (draw_order == DRAW_ORDER_INDEX) {
+		// The rows were written by _particles_process().
+		can_update.set();
+		return;
+	}
 
-	int *ow;
-	int *order = nullptr;
+	int pc = particles.size();
 
-	float *w = particle_data.ptrw();
+	int *order = particle_order.ptrw();
 	const Particle *r = particles.ptr();
-	float *ptr = w;
 
-	if (draw_order != DRAW_ORDER_INDEX) {
-		ow = particle_order.ptrw();
-		order = ow;
+	for (int i = 0; i < pc; i++) {
+		order[i] = i;
+	}
+	if (draw_order == DRAW_ORDER_LIFETIME) {
+		SortArray<int, SortLifetime> sorter;
+		sorter.compare.particles = r;
+		sorter.sort(order, pc);
+	} else if (draw_order == DRAW_ORDER_VIEW_DEPTH) {
+		ERR_FAIL_NULL(get_viewport());
+		Camera3D *c = get_viewport()->get_camera_3d();
+		if (c) {
+			Vector3 dir = c->get_global_transform().basis.get_axis(2); //far away to close
+
+			if (local_coords) {
+				// will look different from Particles in editor as this is based on the camera in the scenetree
+				// and not the editor camera
+				dir = inv_emission_transform.xform(dir).normalized();
+			} else {
+				dir = dir.normalized();
+			}
 
-		for (int i = 0; i < pc; i++) {
-			order[i] = i;
-		}
-		if (draw_order == DRAW_ORDER_LIFETIME) {
-			SortArray<int, SortLifetime> sorter;
+			SortArray<int, SortAxis> sorter;
 			sorter.compare.particles = r;
+			sorter.compare.axis = dir;
 			sorter.sort(order, pc);
-		} else if (draw_order == DRAW_ORDER_VIEW_DEPTH) {
-			ERR_FAIL_NULL(get_viewport());
-			Camera3D *c = get_viewport()->get_camera_3d();
-			if (c) {
-				Vector3 dir = c->get_global_transform().basis.get_axis(2); //far away to close
-
-				if (local_coords) {
-					// will look different from Particles in editor as this is based on the camera in the scenetree
-					// and not the editor camera
-					dir = inv_emission_transform.xform(dir).normalized();
-				} else {
-					dir = dir.normalized();
-				}
-
-				SortArray<int, SortAxis> sorter;
-				sorter.compare.particles = r;
-				sorter.compare.axis = dir;
-				sorter.sort(order, pc);
-			}
 		}
 	}
 
-	for (int i = 0; i < pc; i++) {
-		int idx = order ? order[i] : i;
-
-		Transform3D t = r[idx].transform;
+	RowData data;
+	data.particles = r;
+	data.order = order;
+	data.rows = particle_data.ptrw();
 
-		if (!local_coords) {
-			t = inv_emission_transform * t;
-		}
-
-		if (r[idx].active) {
-			ptr[0] = t.basis.elements[0][0];
-			ptr[1] = t.basis.elements[0][1];
-			ptr[2] = t.basis.elements[0][2];
-			ptr[3] = t.origin.x;
-			ptr[4] = t.basis.elements[1][0];
-			ptr[5] = t.basis.elements[1][1];
-			ptr[6] = t.basis.elements[1][2];
-			ptr[7] = t.origin.y;
-			ptr[8] = t.basis.elements[2][0];
-			ptr[9] = t.basis.elements[2][1];
-			ptr[10] = t.basis.elements[2][2];
-			ptr[11] = t.origin.z;
-		} else {
-			memset(ptr, 0, sizeof(Transform3D));
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (pc < CPU_PARTICLES_THREADED_MIN || !pool || pool->get_thread_count() == 0) {
+		for (int i = 0; i < pc; i++) {
+			_write_particle_row_ordered(i, &data);
 		}
-
-		Color c = r[idx].color;
-
-		ptr[12] = c.r;
-		ptr[13] = c.g;
-		ptr[14] = c.b;
-		ptr[15] = c.a;
-
-		ptr[16] = r[idx].custom[0];
-		ptr[17] = r[idx].custom[1];
-		ptr[18] = r[idx].custom[2];
-		ptr[19] = r[idx].custom[3];
-
-		ptr += 20;
+	} else {
+		WorkerThreadPool::GroupID group = pool->add_template_group_task(this, &CPUParticles3D::_write_particle_row_ordered, (const RowData *)&data, pc, -1, CPU_PARTICLES_THREADED_BATCH * 4);
+		pool->wait_for_group_task_completion(group);
 	}
 
 	can_update.set();
@@ -0,0 +1,321 @@
+/*************************************************************************/
+/*  hlod_instance_3d.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "hlod_instance_3d.h"
+#include "core/templates/map.h"
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/resources/skin.h"
+#include "scene/resources/surface_tool.h"
+
+void HLODInstance3D::set_bake_mask(uint32_t p_mask) {
+	bake_mask = p_mask;
+	update_configuration_warnings();
+}
+
+uint32_t HLODInstance3D::get_bake_mask() const {
+	return bake_mask;
+}
+
+void HLODInstance3D::set_bake_mask_value(int p_layer_number, bool p_value) {
+	ERR_FAIL_COND_MSG(p_layer_number < 1, "Render layer number must be between 1 and 20 inclusive.");
+	ERR_FAIL_COND_MSG(p_layer_number > 20, "Render layer number must be between 1 and 20 inclusive.");
+	uint32_t mask = get_bake_mask();
+	if (p_value) {
+		mask |= 1 << (p_layer_number - 1);
+	} else {
+		mask &= ~(1 << (p_layer_number - 1));
+	}
+	set_bake_mask(mask);
+}
+
+bool HLODInstance3D::get_bake_mask_value(int p_layer_number) const {
+	ERR_FAIL_COND_V_MSG(p_layer_number < 1, false, "Render layer number must be between 1 and 20 inclusive.");
+	ERR_FAIL_COND_V_MSG(p_layer_number > 20, false, "Render layer number must be between 1 and 20 inclusive.");
+	return bake_mask & (1 << (p_layer_number - 1));
+}
+
+void HLODInstance3D::set_bake_cluster_size(float p_size) {
+	bake_cluster_size = MAX(p_size, 0.01f);
+}
+
+float HLODInstance3D::get_bake_cluster_size() const {
+	return bake_cluster_size;
+}
+
+void HLODInstance3D::set_bake_simplification_ratio(float p_ratio) {
+	bake_simplification_ratio = CLAMP(p_ratio, 0.0f, 1.0f);
+}
+
+float HLODInstance3D::get_bake_simplification_ratio() const {
+	return bake_simplification_ratio;
+}
+
+void HLODInstance3D::set_proxy_distance(float p_distance) {
+	proxy_distance = MAX(p_distance, 0.0f);
+	for (int i = 0; i < proxies.size(); i++) {
+		GeometryInstance3D *proxy = Object::cast_to<GeometryInstance3D>(get_node_or_null(proxies[i]));
+		if (proxy) {
+			proxy->set_visibility_range_begin(proxy_distance);
+		}
+	}
+}
+
+float HLODInstance3D::get_proxy_distance() const {
+	return proxy_distance;
+}
+
+void HLODInstance3D::set_proxies(const Array &p_proxies) {
+	proxies.resize(p_proxies.size());
+	for (int i = 0; i < p_proxies.size(); i++) {
+		proxies.write[i] = p_proxies[i];
+	}
+	update_configuration_warnings();
+}
+
+Array HLODInstance3D::get_proxies() const {
+	Array ret;
+	ret.resize(proxies.size());
+	for (int i = 0; i < proxies.size(); i++) {
+		ret[i] = proxies[i];
+	}
+	return ret;
+}
+
+void HLODInstance3D::_bake_collect(Node *p_node, List<MeshInstance3D *> &r_meshes) {
+	MeshInstance3D *mi = Object::cast_to<MeshInstance3D>(p_node);
+	// Only static, unskinned meshes saved with the scene can be merged. Meshes already using a
+	// visibility parent are managed by hand and left alone.
+	if (mi && mi->get_mesh().is_valid() && mi->get_skin().is_null() && mi->is_visible_in_tree() && (mi->get_layer_mask() & bake_mask) && mi->get_visibility_parent().is_empty() && (mi == get_owner() || mi->get_owner() == get_owner() || mi->get_owner() == this)) {
+		r_meshes.push_back(mi);
+	}
+
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		_bake_collect(p_node->get_child(i), r_meshes);
+	}
+}
+
+void HLODInstance3D::_clear_proxies() {
+	Set<Node *> old_proxies;
+	for (int i = 0; i < proxies.size(); i++) {
+		Node *proxy = get_node_or_null(proxies[i]);
+		if (proxy) {
+			old_proxies.insert(proxy);
+		}
+	}
+	proxies.clear();
+
+	if (old_proxies.is_empty()) {
+		return;
+	}
+
+	// Detach the meshes the proxies were hiding, so they get clustered again.
+	List<Node *> stack;
+	stack.push_back(this);
+	while (!stack.is_empty()) {
+		Node *node = stack.front()->get();
+		stack.pop_front();
+
+		Node3D *n3d = Object::cast_to<Node3D>(node);
+		if (n3d && !n3d->get_visibility_parent().is_empty() && old_proxies.has(n3d->get_node_or_null(n3d->get_visibility_parent()))) {
+			n3d->set_visibility_parent(NodePath());
+		}
+
+		for (int i = 0; i < node->get_child_count(); i++) {
+			stack.push_back(node->get_child(i));
+		}
+	}
+
+	for (Set<Node *>::Element *E = old_proxies.front(); E; E = E->next()) {
+		E->get()->get_parent()->remove_child(E->get());
+		E->get()->queue_delete();
+	}
+}
+
+void HLODInstance3D::clear() {
+	_clear_proxies();
+	update_configuration_warnings();
+}
+
+HLODInstance3D::BakeError HLODInstance3D::bake() {
+	ERR_FAIL_COND_V(!is_inside_tree(), BAKE_ERROR_NO_MESHES);
+
+	_clear_proxies();
+
+	List<MeshInstance3D *> meshes;
+	_bake_collect(this, meshes);
+
+	// Group the meshes in a grid by the center of their bounds, so every cluster ends up as
+	// a single proxy instance with one draw per material.
+	struct Cluster {
+		Vector<Ref<Material>> materials;
+		Vector<Ref<SurfaceTool>> surfaces;
+		Vector<MeshInstance3D *> sources;
+	};
+
+	Map<Vector3i, Cluster> clusters;
+	Transform3D to_local = get_global_transform().affine_inverse();
+
+	for (List<MeshInstance3D *>::Element *E = meshes.front(); E; E = E->next()) {
+		MeshInstance3D *mi = E->get();
+		Ref<Mesh> mesh = mi->get_mesh();
+		Transform3D xform = to_local * mi->get_global_transform();
+
+		Vector3 center = xform.xform(mesh->get_aabb().get_center());
+		Vector3i key = Vector3i((center / bake_cluster_size).floor());
+		Cluster &cluster = clusters[key];
+
+		bool merged = false;
+		for (int i = 0; i < mesh->get_surface_count(); i++) {
+			if (mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES || mesh->surface_get_array_index_len(i) == 0) {
+				continue;
+			}
+
+			Ref<Material> material = mi->get_active_material(i);
+			int index = cluster.materials.find(material);
+			if (index == -1) {
+				Ref<SurfaceTool> st;
+				st.instantiate();
+				index = cluster.materials.size();
+				cluster.materials.push_back(material);
+				cluster.surfaces.push_back(st);
+			}
+			cluster.surfaces.write[index]->append_from(mesh, i, xform);
+			merged = true;
+		}
+
+		if (merged) {
+			cluster.sources.push_back(mi);
+		}
+	}
+
+	Node *owner = get_owner() ? get_owner() : this;
+
+	for (Map<Vector3i, Cluster>::Element *E = clusters.front(); E; E = E->next()) {
+		Cluster &cluster = E->get();
+		if (cluster.sources.is_empty()) {
+			continue;
+		}
+
+		Ref<ArrayMesh> proxy_mesh;
+		proxy_mesh.instantiate();
+
+		for (int i = 0; i < cluster.surfaces.size(); i++) {
+			Ref<SurfaceTool> st = cluster.surfaces[i];
+			Array arrays = st->commit_to_arrays();
+
+			int index_count = PackedInt32Array(arrays[Mesh::ARRAY_INDEX]).size();
+			int target_count = int(index_count * bake_simplification_ratio) / 3 * 3;
+			if (SurfaceTool::simplify_func && bake_simplification_ratio < 1.0 && target_count >= 3) {
+				Vector<int> lod = st->generate_lod(1.0, target_count);
+				if (lod.size()) {
+					arrays[Mesh::ARRAY_INDEX] = lod;
+				}
+			}
+
+			proxy_mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays);
+			proxy_mesh->surface_set_material(proxy_mesh->get_surface_count() - 1, cluster.materials[i]);
+		}
+
+		MeshInstance3D *proxy = memnew(MeshInstance3D);
+		proxy->set_name("HLODProxy");
+		proxy->set_mesh(proxy_mesh);
+		proxy->set_visibility_range_begin(proxy_distance);
+		add_child(proxy, true);
+		proxy->set_owner(owner);
+
+		proxies.push_back(get_path_to(proxy));
+
+		// The sources stay visible up close, past the proxy distance the proxy takes over.
+		for (int i = 0; i < cluster.sources.size(); i++) {
+			MeshInstance3D *mi = cluster.sources[i];
+			mi->set_visibility_parent(mi->get_path_to(proxy));
+		}
+	}
+
+	update_configuration_warnings();
+
+	if (proxies.is_empty()) {
+		return BAKE_ERROR_NO_MESHES;
+	}
+
+	return BAKE_ERROR_OK;
+}
+
+TypedArray<String> HLODInstance3D::get_configuration_warnings() const {
+	TypedArray<String> warnings = Node::get_configuration_warnings();
+
+	if (bake_mask == 0) {
+		warnings.push_back(TTR("The Bake Mask has no bits enabled, which means baking will not produce any proxy meshes for this HLODInstance3D.\nTo resolve this, enable at least one bit in the Bake Mask property."));
+	}
+
+	if (proxies.is_empty()) {
+		warnings.push_back(TTR("No proxy meshes have been baked, so the child meshes of this HLODInstance3D are always drawn in full detail.\nTo resolve this, select the HLODInstance3D then use the Bake HLOD button at the top of the 3D editor viewport."));
+	}
+
+	return warnings;
+}
+
+void HLODInstance3D::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_bake_mask", "mask"), &HLODInstance3D::set_bake_mask);
+	ClassDB::bind_method(D_METHOD("get_bake_mask"), &HLODInstance3D::get_bake_mask);
+	ClassDB::bind_method(D_METHOD("set_bake_mask_value", "layer_number", "value"), &HLODInstance3D::set_bake_mask_value);
+	ClassDB::bind_method(D_METHOD("get_bake_mask_value", "layer_number"), &HLODInstance3D::get_bake_mask_value);
+
+	ClassDB::bind_method(D_METHOD("set_bake_cluster_size", "size"), &HLODInstance3D::set_bake_cluster_size);
+	ClassDB::bind_method(D_METHOD("get_bake_cluster_size"), &HLODInstance3D::get_bake_cluster_size);
+
+	ClassDB::bind_method(D_METHOD("set_bake_simplification_ratio", "ratio"), &HLODInstance3D::set_bake_simplification_ratio);
+	ClassDB::bind_method(D_METHOD("get_bake_simplification_ratio"), &HLODInstance3D::get_bake_simplification_ratio);
+
+	ClassDB::bind_method(D_METHOD("set_proxy_distance", "distance"), &HLODInstance3D::set_proxy_distance);
+	ClassDB::bind_method(D_METHOD("get_proxy_distance"), &HLODInstance3D::get_proxy_distance);
+
+	ClassDB::bind_method(D_METHOD("set_proxies", "proxies"), &HLODInstance3D::set_proxies);
+	ClassDB::bind_method(D_METHOD("get_proxies"), &HLODInstance3D::get_proxies);
+
+	ClassDB::bind_method(D_METHOD("bake"), &HLODInstance3D::bake);
+	ClassDB::bind_method(D_METHOD("clear"), &HLODInstance3D::clear);
+
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "proxy_distance", PROPERTY_HINT_RANGE, "0.0,4096.0,0.01,or_greater"), "set_proxy_distance", "get_proxy_distance");
+	ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "proxies", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL), "set_proxies", "get_proxies");
+	ADD_GROUP("Bake", "bake_");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "bake_mask", PROPERTY_HINT_LAYERS_3D_RENDER), "set_bake_mask", "get_bake_mask");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "bake_cluster_size", PROPERTY_HINT_RANGE, "0.01,1024.0,0.01,or_greater"), "set_bake_cluster_size", "get_bake_cluster_size");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "bake_simplification_ratio", PROPERTY_HINT_RANGE, "0.0,1.0,0.01"), "set_bake_simplification_ratio", "get_bake_simplification_ratio");
+
+	BIND_ENUM_CONSTANT(BAKE_ERROR_OK);
+	BIND_ENUM_CONSTANT(BAKE_ERROR_NO_MESHES);
+}
+
+HLODInstance3D::HLODInstance3D() {
+}
+
+HLODInstance3D::~HLODInstance3D() {
+}
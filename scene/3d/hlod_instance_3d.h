@@ -0,0 +1,91 @@
+/*************************************************************************/
+/*  hlod_instance_3d.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef HLOD_INSTANCE_3D_H
+#define HLOD_INSTANCE_3D_H
+
+#include "scene/3d/node_3d.h"
+
+class MeshInstance3D;
+
+class HLODInstance3D : public Node3D {
+	GDCLASS(HLODInstance3D, Node3D);
+
+private:
+	uint32_t bake_mask = 0xFFFFFFFF;
+	float bake_cluster_size = 50.0;
+	float bake_simplification_ratio = 0.25;
+	float proxy_distance = 100.0;
+
+	// Proxies created by the last bake, relative to this node.
+	Vector<NodePath> proxies;
+
+	void _bake_collect(Node *p_node, List<MeshInstance3D *> &r_meshes);
+	void _clear_proxies();
+
+protected:
+	static void _bind_methods();
+
+public:
+	virtual TypedArray<String> get_configuration_warnings() const override;
+
+	enum BakeError {
+		BAKE_ERROR_OK,
+		BAKE_ERROR_NO_MESHES,
+	};
+
+	void set_bake_mask(uint32_t p_mask);
+	uint32_t get_bake_mask() const;
+
+	void set_bake_mask_value(int p_layer_number, bool p_enable);
+	bool get_bake_mask_value(int p_layer_number) const;
+
+	void set_bake_cluster_size(float p_size);
+	float get_bake_cluster_size() const;
+
+	void set_bake_simplification_ratio(float p_ratio);
+	float get_bake_simplification_ratio() const;
+
+	void set_proxy_distance(float p_distance);
+	float get_proxy_distance() const;
+
+	void set_proxies(const Array &p_proxies);
+	Array get_proxies() const;
+
+	BakeError bake();
+	void clear();
+
+	HLODInstance3D();
+	~HLODInstance3D();
+};
+
+VARIANT_ENUM_CAST(HLODInstance3D::BakeError);
+
+#endif // HLOD_INSTANCE_3D_H
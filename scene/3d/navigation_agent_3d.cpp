@@ -75,6 +75,7 @@ void NavigationAgent3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_final_location"), &NavigationAgent3D::get_final_location);
 
 	ClassDB::bind_method(D_METHOD("_avoidance_done", "new_velocity"), &NavigationAgent3D::_avoidance_done);
+	ClassDB::bind_method(D_METHOD("_path_query_done", "path"), &NavigationAgent3D::_path_query_done);
 
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "target_desired_distance", PROPERTY_HINT_RANGE, "0.1,100,0.01"), "set_target_desired_distance", "get_target_desired_distance");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "radius", PROPERTY_HINT_RANGE, "0.1,100,0.01"), "set_radius", "get_radius");
@@ -180,6 +181,7 @@ real_t NavigationAgent3D::get_path_max_distance() {
 void NavigationAgent3D::set_target_location(Vector3 p_location) {
 	target_location = p_location;
 	navigation_path.clear();
+	path_query_outdated = path_query_pending;
 	target_reached = false;
 	navigation_finished = false;
 	update_frame_id = 0;
@@ -244,6 +246,20 @@ void NavigationAgent3D::_avoidance_done(Vector3 p_new_velocity) {
 	emit_signal(SNAME("velocity_computed"), p_new_velocity);
 }
 
+void NavigationAgent3D::_path_query_done(const Vector<Vector3> &p_path) {
+	path_query_pending = false;
+	if (path_query_outdated) {
+		// Computed for a previous target, the next update asks again.
+		path_query_outdated = false;
+		return;
+	}
+
+	navigation_path = p_path;
+	navigation_finished = false;
+	nav_path_index = 0;
+	emit_signal(SNAME("path_changed"));
+}
+
 TypedArray<String> NavigationAgent3D::get_configuration_warnings() const {
 	TypedArray<String> warnings = Node::get_configuration_warnings();
 
@@ -291,11 +307,10 @@ void NavigationAgent3D::update_navigation() {
 		}
 	}
 
-	if (reload_path) {
-		navigation_path = NavigationServer3D::get_singleton()->map_get_path(agent_parent->get_world_3d()->get_navigation_map(), o, target_location, true);
-		navigation_finished = false;
-		nav_path_index = 0;
-		emit_signal(SNAME("path_changed"));
+	if (reload_path && !path_query_pending) {
+		// The current path, if any, is followed until the new one is ready.
+		NavigationServer3D::get_singleton()->map_get_path_async(agent_parent->get_world_3d()->get_navigation_map(), o, target_location, true, Callable(this, "_path_query_done"));
+		path_query_pending = true;
 	}
 
 	if (navigation_path.size() == 0) {
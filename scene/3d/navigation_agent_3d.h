@@ -62,6 +62,10 @@ class NavigationAgent3D : public Node {
 	Vector3 target_velocity;
 	bool target_reached = false;
 	bool navigation_finished = true;
+	/// A path query is being solved by the navigation server.
+	bool path_query_pending = false;
+	/// The target changed after the pending path query was issued.
+	bool path_query_outdated = false;
 	// No initialized on purpose
 	uint32_t update_frame_id;
 
@@ -141,6 +145,7 @@ public:
 
 	void set_velocity(Vector3 p_velocity);
 	void _avoidance_done(Vector3 p_new_velocity);
+	void _path_query_done(const Vector<Vector3> &p_path);
 
 	TypedArray<String> get_configuration_warnings() const override;
 
@@ -31,6 +31,7 @@
 #include "node_3d.h"
 
 #include "core/object/message_queue.h"
+#include "core/os/worker_thread_pool.h"
 #include "scene/3d/visual_instance_3d.h"
 #include "scene/main/viewport.h"
 #include "scene/scene_string_names.h"
@@ -245,28 +246,76 @@ Transform3D Node3D::get_transform() const {
 
 	return data.local_transform;
 }
+// Expects the parent's global transform to be up to date.
+void Node3D::_update_global_transform() const {
+	if (data.dirty & DIRTY_LOCAL) {
+		_update_local_transform();
+	}
+
+	if (data.parent && !data.top_level_active) {
+		data.global_transform = data.parent->data.global_transform * data.local_transform;
+	} else {
+		data.global_transform = data.local_transform;
+	}
+
+	if (data.disable_scale) {
+		data.global_transform.basis.orthonormalize();
+	}
+
+	data.dirty &= ~DIRTY_GLOBAL;
+}
+
 Transform3D Node3D::get_global_transform() const {
 	ERR_FAIL_COND_V(!is_inside_tree(), Transform3D());
 
 	if (data.dirty & DIRTY_GLOBAL) {
-		if (data.dirty & DIRTY_LOCAL) {
-			_update_local_transform();
+		if (data.parent && !data.top_level_active) {
+			data.parent->get_global_transform();
 		}
+		_update_global_transform();
+	}
 
-		if (data.parent && !data.top_level_active) {
-			data.global_transform = data.parent->get_global_transform() * data.local_transform;
-		} else {
-			data.global_transform = data.local_transform;
+	return data.global_transform;
+}
+
+void Node3D::_update_global_transform_task(void *p_nodes, uint32_t p_index) {
+	const Node3D *node = static_cast<Node3D *const *>(p_nodes)[p_index];
+	if (node->data.dirty & DIRTY_GLOBAL) {
+		node->_update_global_transform();
+	}
+}
+
+// The nodes must be sorted by their depth in the tree, which p_depths holds.
+void Node3D::_update_global_transforms(Node3D *const *p_nodes, const int *p_depths, uint32_t p_count) {
+	// Going down one tree level at a time, every node only needs its parent resolved,
+	// which either happened in the previous level or is done here first. Each node then
+	// only writes its own transform, so large levels are split over the worker threads.
+	uint32_t begin = 0;
+	while (begin < p_count) {
+		uint32_t end = begin + 1;
+		while (end < p_count && p_depths[end] == p_depths[begin]) {
+			end++;
 		}
 
-		if (data.disable_scale) {
-			data.global_transform.basis.orthonormalize();
+		for (uint32_t i = begin; i < end; i++) {
+			const Node3D *node = p_nodes[i];
+			if ((node->data.dirty & DIRTY_GLOBAL) && node->data.parent && !node->data.top_level_active && (node->data.parent->data.dirty & DIRTY_GLOBAL)) {
+				node->data.parent->get_global_transform();
+			}
 		}
 
-		data.dirty &= ~DIRTY_GLOBAL;
-	}
+		uint32_t level_count = end - begin;
+		if (level_count >= PARALLEL_TRANSFORM_UPDATE_MIN) {
+			WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&Node3D::_update_global_transform_task, (void *)&p_nodes[begin], level_count, -1, PARALLEL_TRANSFORM_UPDATE_BATCH);
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		} else {
+			for (uint32_t i = begin; i < end; i++) {
+				_update_global_transform_task((void *)&p_nodes[begin], i - begin);
+			}
+		}
 
-	return data.global_transform;
+		begin = end;
+	}
 }
 
 #ifdef TOOLS_ENABLED
@@ -736,6 +785,13 @@ void Node3D::force_update_transform() {
 	notification(NOTIFICATION_TRANSFORM_CHANGED);
 }
 
+void Node3D::reset_physics_interpolation() {
+	ERR_FAIL_COND(!is_inside_tree());
+	// Pending transform notifications would reach the rendering server after the reset, send them first.
+	get_tree()->flush_transform_notifications();
+	propagate_notification(NOTIFICATION_RESET_PHYSICS_INTERPOLATION);
+}
+
 void Node3D::_update_visibility_parent(bool p_update_root) {
 	RID new_parent;
 
@@ -800,6 +856,7 @@ void Node3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_world_3d"), &Node3D::get_world_3d);
 
 	ClassDB::bind_method(D_METHOD("force_update_transform"), &Node3D::force_update_transform);
+	ClassDB::bind_method(D_METHOD("reset_physics_interpolation"), &Node3D::reset_physics_interpolation);
 
 	ClassDB::bind_method(D_METHOD("set_visibility_parent", "path"), &Node3D::set_visibility_parent);
 	ClassDB::bind_method(D_METHOD("get_visibility_parent"), &Node3D::get_visibility_parent);
@@ -847,6 +904,7 @@ void Node3D::_bind_methods() {
 	BIND_CONSTANT(NOTIFICATION_ENTER_WORLD);
 	BIND_CONSTANT(NOTIFICATION_EXIT_WORLD);
 	BIND_CONSTANT(NOTIFICATION_VISIBILITY_CHANGED);
+	BIND_CONSTANT(NOTIFICATION_RESET_PHYSICS_INTERPOLATION);
 
 	//ADD_PROPERTY( PropertyInfo(Variant::TRANSFORM3D,"transform/global",PROPERTY_HINT_NONE, "", PROPERTY_USAGE_EDITOR ), "set_global_transform", "get_global_transform") ;
 	ADD_GROUP("Transform", "");
@@ -103,6 +103,17 @@ class Node3D : public Node {
 	void _notify_dirty();
 	void _propagate_transform_changed(Node3D *p_origin);
 
+	enum {
+		PARALLEL_TRANSFORM_UPDATE_MIN = 1024, // Tree depth levels with fewer pending nodes are updated on the calling thread.
+		PARALLEL_TRANSFORM_UPDATE_BATCH = 256,
+	};
+
+	_FORCE_INLINE_ void _update_global_transform() const;
+	static void _update_global_transform_task(void *p_nodes, uint32_t p_index);
+
+	friend class SceneTree;
+	static void _update_global_transforms(Node3D *const *p_nodes, const int *p_depths, uint32_t p_count);
+
 	void _propagate_visibility_changed();
 
 	void _propagate_visibility_parent();
@@ -123,6 +134,7 @@ public:
 		NOTIFICATION_EXIT_WORLD = 42,
 		NOTIFICATION_VISIBILITY_CHANGED = 43,
 		NOTIFICATION_LOCAL_TRANSFORM_CHANGED = 44,
+		NOTIFICATION_RESET_PHYSICS_INTERPOLATION = 45,
 	};
 
 	Node3D *get_parent_node_3d() const;
@@ -207,6 +219,7 @@ public:
 	bool is_visible_in_tree() const;
 
 	void force_update_transform();
+	void reset_physics_interpolation();
 
 	void set_visibility_parent(const NodePath &p_path);
 	NodePath get_visibility_parent() const;
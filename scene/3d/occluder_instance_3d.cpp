@@ -31,6 +31,7 @@
 #include "occluder_instance_3d.h"
 #include "core/core_string_names.h"
 #include "scene/3d/mesh_instance_3d.h"
+#include "scene/resources/surface_tool.h"
 
 RID Occluder3D::get_rid() const {
 	if (!occluder.is_valid()) {
@@ -213,6 +214,14 @@ bool OccluderInstance3D::get_bake_mask_value(int p_layer_number) const {
 	return bake_mask & (1 << (p_layer_number - 1));
 }
 
+void OccluderInstance3D::set_bake_simplification_distance(float p_dist) {
+	bake_simplification_dist = MAX(p_dist, 0.0f);
+}
+
+float OccluderInstance3D::get_bake_simplification_distance() const {
+	return bake_simplification_dist;
+}
+
 bool OccluderInstance3D::_bake_material_check(Ref<Material> p_material) {
 	StandardMaterial3D *standard_mat = Object::cast_to<StandardMaterial3D>(p_material.ptr());
 	if (standard_mat && standard_mat->get_transparency() != StandardMaterial3D::TRANSPARENCY_DISABLED) {
@@ -290,6 +299,80 @@ void OccluderInstance3D::_bake_node(Node *p_node, PackedVector3Array &r_vertices
 	}
 }
 
+void OccluderInstance3D::_bake_simplify(PackedVector3Array &r_vertices, PackedInt32Array &r_indices) {
+	if (bake_simplification_dist <= 0.0f || SurfaceTool::simplify_func == nullptr || SurfaceTool::simplify_scale_func == nullptr) {
+		return;
+	}
+
+	// Source meshes split vertices along UV and normal seams, the occluder only cares about positions.
+	// Weld them first, otherwise the simplifier can't collapse any edge touching a seam.
+	Map<Vector3, int> unique_vertices;
+	LocalVector<int> vertex_remap;
+	LocalVector<float> welded_vertices;
+	vertex_remap.resize(r_vertices.size());
+
+	for (int i = 0; i < r_vertices.size(); i++) {
+		const Vector3 &v = r_vertices[i];
+		Map<Vector3, int>::Element *E = unique_vertices.find(v);
+		if (E) {
+			vertex_remap[i] = E->get();
+		} else {
+			int idx = welded_vertices.size() / 3;
+			unique_vertices[v] = idx;
+			vertex_remap[i] = idx;
+			welded_vertices.push_back(v.x);
+			welded_vertices.push_back(v.y);
+			welded_vertices.push_back(v.z);
+		}
+	}
+
+	uint32_t vertex_count = welded_vertices.size() / 3;
+	LocalVector<uint32_t> welded_indices;
+	welded_indices.resize(r_indices.size());
+	for (int i = 0; i < r_indices.size(); i++) {
+		welded_indices[i] = vertex_remap[r_indices[i]];
+	}
+
+	// The simplifier error is relative to the mesh extents.
+	float scale = SurfaceTool::simplify_scale_func(welded_vertices.ptr(), vertex_count, sizeof(float) * 3);
+	if (scale <= 0.0f) {
+		return;
+	}
+
+	LocalVector<uint32_t> simplified_indices;
+	simplified_indices.resize(welded_indices.size());
+
+	float error = 0.0f;
+	size_t index_count = SurfaceTool::simplify_func(simplified_indices.ptr(), welded_indices.ptr(), welded_indices.size(), welded_vertices.ptr(), vertex_count, sizeof(float) * 3, 0, bake_simplification_dist / scale, &error);
+	if (index_count == 0) {
+		return;
+	}
+
+	// Compact the vertices still referenced by the simplified mesh.
+	LocalVector<int> compact_remap;
+	compact_remap.resize(vertex_count);
+	for (uint32_t i = 0; i < vertex_count; i++) {
+		compact_remap[i] = -1;
+	}
+
+	PackedVector3Array vertices;
+	PackedInt32Array indices;
+	indices.resize(index_count);
+	int *idx_ptr = indices.ptrw();
+
+	for (size_t i = 0; i < index_count; i++) {
+		uint32_t src = simplified_indices[i];
+		if (compact_remap[src] == -1) {
+			compact_remap[src] = vertices.size();
+			vertices.push_back(Vector3(welded_vertices[src * 3 + 0], welded_vertices[src * 3 + 1], welded_vertices[src * 3 + 2]));
+		}
+		idx_ptr[i] = compact_remap[src];
+	}
+
+	r_vertices = vertices;
+	r_indices = indices;
+}
+
 OccluderInstance3D::BakeError OccluderInstance3D::bake(Node *p_from_node, String p_occluder_path) {
 	if (p_occluder_path == "") {
 		if (get_occluder().is_null()) {
@@ -306,6 +389,8 @@ OccluderInstance3D::BakeError OccluderInstance3D::bake(Node *p_from_node, String
 		return BAKE_ERROR_NO_MESHES;
 	}
 
+	_bake_simplify(vertices, indices);
+
 	Ref<Occluder3D> occ;
 	if (get_occluder().is_valid()) {
 		occ = get_occluder();
@@ -352,12 +437,16 @@ void OccluderInstance3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_bake_mask_value", "layer_number", "value"), &OccluderInstance3D::set_bake_mask_value);
 	ClassDB::bind_method(D_METHOD("get_bake_mask_value", "layer_number"), &OccluderInstance3D::get_bake_mask_value);
 
+	ClassDB::bind_method(D_METHOD("set_bake_simplification_distance", "distance"), &OccluderInstance3D::set_bake_simplification_distance);
+	ClassDB::bind_method(D_METHOD("get_bake_simplification_distance"), &OccluderInstance3D::get_bake_simplification_distance);
+
 	ClassDB::bind_method(D_METHOD("set_occluder", "occluder"), &OccluderInstance3D::set_occluder);
 	ClassDB::bind_method(D_METHOD("get_occluder"), &OccluderInstance3D::get_occluder);
 
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "occluder", PROPERTY_HINT_RESOURCE_TYPE, "Occluder3D"), "set_occluder", "get_occluder");
 	ADD_GROUP("Bake", "bake_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "bake_mask", PROPERTY_HINT_LAYERS_3D_RENDER), "set_bake_mask", "get_bake_mask");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "bake_simplification_distance", PROPERTY_HINT_RANGE, "0.0,2.0,0.01,or_greater"), "set_bake_simplification_distance", "get_bake_simplification_distance");
 }
 
 OccluderInstance3D::OccluderInstance3D() {
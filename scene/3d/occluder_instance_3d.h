@@ -72,11 +72,13 @@ class OccluderInstance3D : public VisualInstance3D {
 private:
 	Ref<Occluder3D> occluder;
 	uint32_t bake_mask = 0xFFFFFFFF;
+	float bake_simplification_dist = 0.1f;
 
 	void _occluder_changed();
 
 	bool _bake_material_check(Ref<Material> p_material);
 	void _bake_node(Node *p_node, PackedVector3Array &r_vertices, PackedInt32Array &r_indices);
+	void _bake_simplify(PackedVector3Array &r_vertices, PackedInt32Array &r_indices);
 
 protected:
 	static void _bind_methods();
@@ -102,6 +104,9 @@ public:
 	void set_bake_mask_value(int p_layer_number, bool p_enable);
 	bool get_bake_mask_value(int p_layer_number) const;
 
+	void set_bake_simplification_distance(float p_dist);
+	float get_bake_simplification_distance() const;
+
 	BakeError bake(Node *p_from_node, String p_occluder_path = "");
 
 	OccluderInstance3D();
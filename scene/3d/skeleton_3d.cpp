@@ -31,6 +31,7 @@
 #include "skeleton_3d.h"
 
 #include "core/object/message_queue.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/variant/type_info.h"
 #include "editor/plugins/skeleton_3d_editor_plugin.h"
 #include "scene/3d/physics_body_3d.h"
@@ -38,6 +39,9 @@
 #include "scene/resources/surface_tool.h"
 #include "scene/scene_string_names.h"
 
+#define SKELETON_3D_THREADED_MIN_SKELETONS 4
+#define SKELETON_3D_THREADED_BATCH 4
+
 void SkinReference::_skin_changed() {
 	if (skeleton_node) {
 		skeleton_node->_make_dirty();
@@ -248,81 +252,28 @@ void Skeleton3D::_update_process_order() {
 		}
 	}
 
+	process_order.clear();
+	for (int i = 0; i < parentless_bones.size(); i++) {
+		uint32_t from = process_order.size();
+		process_order.push_back(parentless_bones[i]);
+		while (from < process_order.size()) {
+			const Bone &b = bonesptr[process_order[from++]];
+			for (int j = 0; j < b.child_bones.size(); j++) {
+				process_order.push_back(b.child_bones[j]);
+			}
+		}
+	}
+
 	process_order_dirty = false;
 }
 
 void Skeleton3D::_notification(int p_what) {
 	switch (p_what) {
 		case NOTIFICATION_UPDATE_SKELETON: {
-			RenderingServer *rs = RenderingServer::get_singleton();
-			Bone *bonesptr = bones.ptrw();
-
-			int len = bones.size();
-			dirty = false;
-
-			// Update bone transforms.
-			force_update_all_bone_transforms();
-
-			// Update skins.
-			for (Set<SkinReference *>::Element *E = skin_bindings.front(); E; E = E->next()) {
-				const Skin *skin = E->get()->skin.operator->();
-				RID skeleton = E->get()->skeleton;
-				uint32_t bind_count = skin->get_bind_count();
-
-				if (E->get()->bind_count != bind_count) {
-					RS::get_singleton()->skeleton_allocate_data(skeleton, bind_count);
-					E->get()->bind_count = bind_count;
-					E->get()->skin_bone_indices.resize(bind_count);
-					E->get()->skin_bone_indices_ptrs = E->get()->skin_bone_indices.ptrw();
-				}
-
-				if (E->get()->skeleton_version != version) {
-					for (uint32_t i = 0; i < bind_count; i++) {
-						StringName bind_name = skin->get_bind_name(i);
-
-						if (bind_name != StringName()) {
-							// Bind name used, use this.
-							bool found = false;
-							for (int j = 0; j < len; j++) {
-								if (bonesptr[j].name == bind_name) {
-									E->get()->skin_bone_indices_ptrs[i] = j;
-									found = true;
-									break;
-								}
-							}
-
-							if (!found) {
-								ERR_PRINT("Skin bind #" + itos(i) + " contains named bind '" + String(bind_name) + "' but Skeleton3D has no bone by that name.");
-								E->get()->skin_bone_indices_ptrs[i] = 0;
-							}
-						} else if (skin->get_bind_bone(i) >= 0) {
-							int bind_index = skin->get_bind_bone(i);
-							if (bind_index >= len) {
-								ERR_PRINT("Skin bind #" + itos(i) + " contains bone index bind: " + itos(bind_index) + " , which is greater than the skeleton bone count: " + itos(len) + ".");
-								E->get()->skin_bone_indices_ptrs[i] = 0;
-							} else {
-								E->get()->skin_bone_indices_ptrs[i] = bind_index;
-							}
-						} else {
-							ERR_PRINT("Skin bind #" + itos(i) + " does not contain a name nor a bone index.");
-							E->get()->skin_bone_indices_ptrs[i] = 0;
-						}
-					}
-
-					E->get()->skeleton_version = version;
-				}
-
-				for (uint32_t i = 0; i < bind_count; i++) {
-					uint32_t bone_index = E->get()->skin_bone_indices_ptrs[i];
-					ERR_CONTINUE(bone_index >= (uint32_t)len);
-					rs->skeleton_bone_set_transform(skeleton, i, bonesptr[bone_index].pose_global * skin->get_bind_pose(i));
-				}
+			if (!dirty) {
+				break; // Already updated along with other dirty skeletons.
 			}
-
-#ifdef TOOLS_ENABLED
-			emit_signal(SceneStringNames::get_singleton()->pose_updated);
-#endif // TOOLS_ENABLED
-
+			_update_dirty_skeletons();
 		} break;
 
 #ifndef _3D_DISABLED
@@ -369,6 +320,139 @@ void Skeleton3D::_notification(int p_what) {
 	}
 }
 
+void Skeleton3D::_update_skins() {
+	if (!Engine::get_singleton()->is_visual_processing_enabled()) {
+		return; // Skins are only needed for display.
+	}
+
+	RenderingServer *rs = RenderingServer::get_singleton();
+	const Bone *bonesptr = bones.ptr();
+	int len = bones.size();
+
+	// Update skins.
+	for (Set<SkinReference *>::Element *E = skin_bindings.front(); E; E = E->next()) {
+		const Skin *skin = E->get()->skin.operator->();
+		RID skeleton = E->get()->skeleton;
+		uint32_t bind_count = skin->get_bind_count();
+
+		if (E->get()->bind_count != bind_count) {
+			RS::get_singleton()->skeleton_allocate_data(skeleton, bind_count);
+			E->get()->bind_count = bind_count;
+			E->get()->skin_bone_indices.resize(bind_count);
+			E->get()->skin_bone_indices_ptrs = E->get()->skin_bone_indices.ptrw();
+		}
+
+		if (E->get()->skeleton_version != version) {
+			for (uint32_t i = 0; i < bind_count; i++) {
+				StringName bind_name = skin->get_bind_name(i);
+
+				if (bind_name != StringName()) {
+					// Bind name used, use this.
+					bool found = false;
+					for (int j = 0; j < len; j++) {
+						if (bonesptr[j].name == bind_name) {
+							E->get()->skin_bone_indices_ptrs[i] = j;
+							found = true;
+							break;
+						}
+					}
+
+					if (!found) {
+						ERR_PRINT("Skin bind #" + itos(i) + " contains named bind '" + String(bind_name) + "' but Skeleton3D has no bone by that name.");
+						E->get()->skin_bone_indices_ptrs[i] = 0;
+					}
+				} else if (skin->get_bind_bone(i) >= 0) {
+					int bind_index = skin->get_bind_bone(i);
+					if (bind_index >= len) {
+						ERR_PRINT("Skin bind #" + itos(i) + " contains bone index bind: " + itos(bind_index) + " , which is greater than the skeleton bone count: " + itos(len) + ".");
+						E->get()->skin_bone_indices_ptrs[i] = 0;
+					} else {
+						E->get()->skin_bone_indices_ptrs[i] = bind_index;
+					}
+				} else {
+					ERR_PRINT("Skin bind #" + itos(i) + " does not contain a name nor a bone index.");
+					E->get()->skin_bone_indices_ptrs[i] = 0;
+				}
+			}
+
+			E->get()->skeleton_version = version;
+		}
+
+		E->get()->bone_transforms.resize(bind_count * 12);
+		float *dataptr = E->get()->bone_transforms.ptrw();
+		for (uint32_t i = 0; i < bind_count; i++) {
+			uint32_t bone_index = E->get()->skin_bone_indices_ptrs[i];
+			ERR_CONTINUE(bone_index >= (uint32_t)len);
+			const Transform3D xform = bonesptr[bone_index].pose_global * skin->get_bind_pose(i);
+
+			float *bone_data = dataptr + i * 12;
+			for (int j = 0; j < 3; j++) {
+				bone_data[j * 4 + 0] = xform.basis.elements[j][0];
+				bone_data[j * 4 + 1] = xform.basis.elements[j][1];
+				bone_data[j * 4 + 2] = xform.basis.elements[j][2];
+				bone_data[j * 4 + 3] = xform.origin[j];
+			}
+		}
+		rs->skeleton_set_bone_transforms(skeleton, E->get()->bone_transforms);
+	}
+
+#ifdef TOOLS_ENABLED
+	emit_signal(SceneStringNames::get_singleton()->pose_updated);
+#endif // TOOLS_ENABLED
+}
+
+void Skeleton3D::_update_skeleton() {
+	dirty = false;
+	dirty_list_item.remove_from_list();
+
+	force_update_all_bone_transforms();
+	_update_skins();
+}
+
+void Skeleton3D::_update_bone_poses_thread(void *p_userdata, uint32_t p_index) {
+	Skeleton3D **skeletons = (Skeleton3D **)p_userdata;
+	skeletons[p_index]->_update_bone_poses();
+}
+
+void Skeleton3D::_update_dirty_skeletons() {
+	LocalVector<Skeleton3D *> skeletons;
+	while (dirty_skeletons.first()) {
+		Skeleton3D *skeleton = dirty_skeletons.first()->self();
+		skeleton->dirty = false;
+		dirty_skeletons.remove(&skeleton->dirty_list_item);
+		skeletons.push_back(skeleton);
+	}
+
+	// Poses only depend on each skeleton's own bones, so they can be computed in parallel.
+	// Signals and skin uploads happen afterwards on this thread.
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (skeletons.size() < SKELETON_3D_THREADED_MIN_SKELETONS || !pool || pool->get_thread_count() == 0) {
+		for (uint32_t i = 0; i < skeletons.size(); i++) {
+			skeletons[i]->_update_bone_poses();
+		}
+	} else {
+		WorkerThreadPool::GroupID group = pool->add_native_group_task(_update_bone_poses_thread, skeletons.ptr(), skeletons.size(), -1, SKELETON_3D_THREADED_BATCH);
+		pool->wait_for_group_task_completion(group);
+	}
+
+	LocalVector<ObjectID> ids;
+	ids.resize(skeletons.size());
+	for (uint32_t i = 0; i < skeletons.size(); i++) {
+		ids[i] = skeletons[i]->get_instance_id();
+	}
+
+	for (uint32_t i = 0; i < skeletons.size(); i++) {
+		// Signal callbacks may free the other skeletons.
+		if (!ObjectDB::get_instance(ids[i])) {
+			continue;
+		}
+		skeletons[i]->_emit_bone_pose_changed();
+		if (ObjectDB::get_instance(ids[i])) {
+			skeletons[i]->_update_skins();
+		}
+	}
+}
+
 void Skeleton3D::clear_bones_global_pose_override() {
 	for (int i = 0; i < bones.size(); i += 1) {
 		bones.write[i].global_pose_override_amount = 0;
@@ -396,7 +480,7 @@ Transform3D Skeleton3D::get_bone_global_pose(int p_bone) const {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX_V(p_bone, bone_size, Transform3D());
 	if (dirty) {
-		const_cast<Skeleton3D *>(this)->notification(NOTIFICATION_UPDATE_SKELETON);
+		const_cast<Skeleton3D *>(this)->_update_skeleton();
 	}
 	return bones[p_bone].pose_global;
 }
@@ -405,7 +489,7 @@ Transform3D Skeleton3D::get_bone_global_pose_no_override(int p_bone) const {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX_V(p_bone, bone_size, Transform3D());
 	if (dirty) {
-		const_cast<Skeleton3D *>(this)->notification(NOTIFICATION_UPDATE_SKELETON);
+		const_cast<Skeleton3D *>(this)->_update_skeleton();
 	}
 	return bones[p_bone].pose_global_no_override;
 }
@@ -685,6 +769,15 @@ bool Skeleton3D::is_show_rest_only() const {
 	return show_rest_only;
 }
 
+void Skeleton3D::set_lod_bone_count(int p_count) {
+	ERR_FAIL_COND(p_count < 0);
+	lod_bone_count = p_count;
+}
+
+int Skeleton3D::get_lod_bone_count() const {
+	return lod_bone_count;
+}
+
 void Skeleton3D::clear_bones() {
 	bones.clear();
 	process_order_dirty = true;
@@ -757,6 +850,7 @@ void Skeleton3D::_make_dirty() {
 
 	MessageQueue::get_singleton()->push_notification(this, NOTIFICATION_UPDATE_SKELETON);
 	dirty = true;
+	dirty_skeletons.add_last(&dirty_list_item);
 }
 
 void Skeleton3D::localize_rests() {
@@ -1019,79 +1113,94 @@ Ref<SkinReference> Skeleton3D::register_skin(const Ref<Skin> &p_skin) {
 
 void Skeleton3D::force_update_all_dirty_bones() {
 	if (dirty) {
-		const_cast<Skeleton3D *>(this)->notification(NOTIFICATION_UPDATE_SKELETON);
+		_update_skeleton();
 	}
 }
 
 void Skeleton3D::force_update_all_bone_transforms() {
-	_update_process_order();
-
-	for (int i = 0; i < parentless_bones.size(); i++) {
-		force_update_bone_children_transforms(parentless_bones[i]);
-	}
+	_update_bone_poses();
+	_emit_bone_pose_changed();
 }
 
-void Skeleton3D::force_update_bone_children_transforms(int p_bone_idx) {
-	const int bone_size = bones.size();
-	ERR_FAIL_INDEX(p_bone_idx, bone_size);
-
+void Skeleton3D::_update_bone_global_pose(int p_bone) {
+	// The parent pose, if any, must be up to date.
 	Bone *bonesptr = bones.ptrw();
-	List<int> bones_to_process = List<int>();
-	bones_to_process.push_back(p_bone_idx);
-
-	while (bones_to_process.size() > 0) {
-		int current_bone_idx = bones_to_process[0];
-		bones_to_process.erase(current_bone_idx);
+	Bone &b = bonesptr[p_bone];
+	bool bone_enabled = b.enabled && !show_rest_only;
 
-		Bone &b = bonesptr[current_bone_idx];
-		bool bone_enabled = b.enabled && !show_rest_only;
+	if (bone_enabled) {
+		b.update_pose_cache();
+		Transform3D pose = b.pose_cache;
 
-		if (bone_enabled) {
-			b.update_pose_cache();
-			Transform3D pose = b.pose_cache;
-
-			if (b.parent >= 0) {
-				b.pose_global = bonesptr[b.parent].pose_global * pose;
-				b.pose_global_no_override = b.pose_global;
-			} else {
-				b.pose_global = pose;
-				b.pose_global_no_override = b.pose_global;
-			}
+		if (b.parent >= 0) {
+			b.pose_global = bonesptr[b.parent].pose_global * pose;
+			b.pose_global_no_override = b.pose_global;
 		} else {
-			if (b.parent >= 0) {
-				b.pose_global = bonesptr[b.parent].pose_global * b.rest;
-				b.pose_global_no_override = b.pose_global;
-			} else {
-				b.pose_global = b.rest;
-				b.pose_global_no_override = b.pose_global;
-			}
+			b.pose_global = pose;
+			b.pose_global_no_override = b.pose_global;
 		}
-
-		if (b.local_pose_override_amount >= CMP_EPSILON) {
-			Transform3D override_local_pose;
-			if (b.parent >= 0) {
-				override_local_pose = bonesptr[b.parent].pose_global * b.local_pose_override;
-			} else {
-				override_local_pose = b.local_pose_override;
-			}
-			b.pose_global = b.pose_global.interpolate_with(override_local_pose, b.local_pose_override_amount);
+	} else {
+		if (b.parent >= 0) {
+			b.pose_global = bonesptr[b.parent].pose_global * b.rest;
+			b.pose_global_no_override = b.pose_global;
+		} else {
+			b.pose_global = b.rest;
+			b.pose_global_no_override = b.pose_global;
 		}
+	}
 
-		if (b.global_pose_override_amount >= CMP_EPSILON) {
-			b.pose_global = b.pose_global.interpolate_with(b.global_pose_override, b.global_pose_override_amount);
+	if (b.local_pose_override_amount >= CMP_EPSILON) {
+		Transform3D override_local_pose;
+		if (b.parent >= 0) {
+			override_local_pose = bonesptr[b.parent].pose_global * b.local_pose_override;
+		} else {
+			override_local_pose = b.local_pose_override;
 		}
+		b.pose_global = b.pose_global.interpolate_with(override_local_pose, b.local_pose_override_amount);
+	}
 
-		if (b.local_pose_override_reset) {
-			b.local_pose_override_amount = 0.0;
-		}
-		if (b.global_pose_override_reset) {
-			b.global_pose_override_amount = 0.0;
-		}
+	if (b.global_pose_override_amount >= CMP_EPSILON) {
+		b.pose_global = b.pose_global.interpolate_with(b.global_pose_override, b.global_pose_override_amount);
+	}
+
+	if (b.local_pose_override_reset) {
+		b.local_pose_override_amount = 0.0;
+	}
+	if (b.global_pose_override_reset) {
+		b.global_pose_override_amount = 0.0;
+	}
+}
+
+void Skeleton3D::_update_bone_poses() {
+	_update_process_order();
+
+	for (uint32_t i = 0; i < process_order.size(); i++) {
+		_update_bone_global_pose(process_order[i]);
+	}
+}
+
+void Skeleton3D::_emit_bone_pose_changed() {
+	for (uint32_t i = 0; i < process_order.size(); i++) {
+		emit_signal(SceneStringNames::get_singleton()->bone_pose_changed, process_order[i]);
+	}
+}
+
+void Skeleton3D::force_update_bone_children_transforms(int p_bone_idx) {
+	const int bone_size = bones.size();
+	ERR_FAIL_INDEX(p_bone_idx, bone_size);
+
+	LocalVector<int> bones_to_process;
+	bones_to_process.push_back(p_bone_idx);
+
+	for (uint32_t i = 0; i < bones_to_process.size(); i++) {
+		int current_bone_idx = bones_to_process[i];
+		_update_bone_global_pose(current_bone_idx);
 
 		// Add the bone's children to the list of bones to be processed.
+		const Bone &b = bones[current_bone_idx];
 		int child_bone_size = b.child_bones.size();
-		for (int i = 0; i < child_bone_size; i++) {
-			bones_to_process.push_back(b.child_bones[i]);
+		for (int j = 0; j < child_bone_size; j++) {
+			bones_to_process.push_back(b.child_bones[j]);
 		}
 
 		emit_signal(SceneStringNames::get_singleton()->bone_pose_changed, current_bone_idx);
@@ -1257,6 +1366,9 @@ void Skeleton3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_show_rest_only", "enabled"), &Skeleton3D::set_show_rest_only);
 	ClassDB::bind_method(D_METHOD("is_show_rest_only"), &Skeleton3D::is_show_rest_only);
 
+	ClassDB::bind_method(D_METHOD("set_lod_bone_count", "count"), &Skeleton3D::set_lod_bone_count);
+	ClassDB::bind_method(D_METHOD("get_lod_bone_count"), &Skeleton3D::get_lod_bone_count);
+
 	ClassDB::bind_method(D_METHOD("set_animate_physical_bones", "enabled"), &Skeleton3D::set_animate_physical_bones);
 	ClassDB::bind_method(D_METHOD("get_animate_physical_bones"), &Skeleton3D::get_animate_physical_bones);
 
@@ -1273,6 +1385,7 @@ void Skeleton3D::_bind_methods() {
 #ifndef _3D_DISABLED
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "show_rest_only"), "set_show_rest_only", "is_show_rest_only");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "animate_physical_bones"), "set_animate_physical_bones", "get_animate_physical_bones");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_bone_count", PROPERTY_HINT_RANGE, "0,1024,1,or_greater"), "set_lod_bone_count", "get_lod_bone_count");
 #endif // _3D_DISABLED
 
 #ifdef TOOLS_ENABLED
@@ -1286,7 +1399,10 @@ void Skeleton3D::_bind_methods() {
 	BIND_CONSTANT(NOTIFICATION_UPDATE_SKELETON);
 }
 
-Skeleton3D::Skeleton3D() {
+SelfList<Skeleton3D>::List Skeleton3D::dirty_skeletons;
+
+Skeleton3D::Skeleton3D() :
+		dirty_list_item(this) {
 }
 
 Skeleton3D::~Skeleton3D() {
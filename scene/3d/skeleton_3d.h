@@ -31,6 +31,8 @@
 #ifndef SKELETON_3D_H
 #define SKELETON_3D_H
 
+#include "core/templates/local_vector.h"
+#include "core/templates/self_list.h"
 #include "scene/3d/node_3d.h"
 #include "scene/resources/skeleton_modification_3d.h"
 #include "scene/resources/skin.h"
@@ -51,6 +53,7 @@ class SkinReference : public RefCounted {
 	uint64_t skeleton_version = 0;
 	Vector<uint32_t> skin_bone_indices;
 	uint32_t *skin_bone_indices_ptrs;
+	Vector<float> bone_transforms; // Uploaded in one call, see RenderingServer::skeleton_set_bone_transforms().
 	void _skin_changed();
 
 protected:
@@ -139,15 +142,29 @@ private:
 	bool process_order_dirty;
 
 	Vector<int> parentless_bones;
+	LocalVector<int> process_order; // Parents before children, same order as walking each parentless bone.
 
 	void _make_dirty();
 	bool dirty = false;
 
+	// Dirty skeletons are updated together, so bone poses can be computed on the worker threads.
+	SelfList<Skeleton3D> dirty_list_item;
+	static SelfList<Skeleton3D>::List dirty_skeletons;
+
 	bool show_rest_only = false;
+	int lod_bone_count = 0;
 
 	uint64_t version = 1;
 
 	void _update_process_order();
+	void _update_bone_global_pose(int p_bone);
+	void _update_bone_poses();
+	void _emit_bone_pose_changed();
+	void _update_skins();
+	void _update_skeleton();
+
+	static void _update_bone_poses_thread(void *p_userdata, uint32_t p_index);
+	static void _update_dirty_skeletons();
 
 protected:
 	bool _get(const StringName &p_path, Variant &r_ret) const;
@@ -206,6 +223,9 @@ public:
 
 	void set_show_rest_only(bool p_enabled);
 	bool is_show_rest_only() const;
+
+	void set_lod_bone_count(int p_count);
+	int get_lod_bone_count() const;
 	void clear_bones();
 
 	// posing api
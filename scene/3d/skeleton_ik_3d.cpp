@@ -36,6 +36,12 @@
 
 #ifndef _3D_DISABLED
 
+#include "core/object/message_queue.h"
+#include "core/os/worker_thread_pool.h"
+
+#define SKELETON_IK_3D_THREADED_MIN_CHAINS 4
+#define SKELETON_IK_3D_THREADED_BATCH 2
+
 FabrikInverseKinematic::ChainItem *FabrikInverseKinematic::ChainItem::find_child(const BoneId p_bone_id) {
 	for (int i = children.size() - 1; 0 <= i; --i) {
 		if (p_bone_id == children[i].bone) {
@@ -254,6 +260,14 @@ void FabrikInverseKinematic::make_goal(Task *p_task, const Transform3D &p_invers
 }
 
 void FabrikInverseKinematic::solve(Task *p_task, real_t blending_delta, bool override_tip_basis, bool p_use_magnet, const Vector3 &p_magnet_position) {
+	if (!begin_solve(p_task, blending_delta, p_use_magnet, p_magnet_position)) {
+		return;
+	}
+	solve_chain(p_task);
+	end_solve(p_task, override_tip_basis);
+}
+
+bool FabrikInverseKinematic::begin_solve(Task *p_task, real_t blending_delta, bool p_use_magnet, const Vector3 &p_magnet_position) {
 	if (blending_delta <= 0.01f) {
 		// Before skipping, make sure we undo the global pose overrides
 		ChainItem *ci(&p_task->chain.chain_root);
@@ -267,23 +281,34 @@ void FabrikInverseKinematic::solve(Task *p_task, real_t blending_delta, bool ove
 			}
 		}
 
-		return; // Skip solving
+		return false; // Skip solving
 	}
 
 	// Update the initial root transform so its synced with any animation changes
 	_update_chain(p_task->skeleton, &p_task->chain.chain_root);
 
 	p_task->skeleton->set_bone_global_pose_override(p_task->chain.chain_root.bone, Transform3D(), 0.0, false);
-	Vector3 origin_pos = p_task->skeleton->get_bone_global_pose(p_task->chain.chain_root.bone).origin;
+	p_task->origin_pos = p_task->skeleton->get_bone_global_pose(p_task->chain.chain_root.bone).origin;
 
 	make_goal(p_task, p_task->skeleton->get_global_transform().affine_inverse(), blending_delta);
 
-	if (p_use_magnet && p_task->chain.middle_chain_item) {
+	p_task->solve_magnet = p_use_magnet && p_task->chain.middle_chain_item;
+	if (p_task->solve_magnet) {
 		p_task->chain.magnet_position = p_task->chain.middle_chain_item->initial_transform.origin.lerp(p_magnet_position, blending_delta);
-		solve_simple(p_task, true, origin_pos);
 	}
-	solve_simple(p_task, false, origin_pos);
 
+	return true;
+}
+
+void FabrikInverseKinematic::solve_chain(Task *p_task) {
+	// Only touches the chain, the skeleton was read in begin_solve().
+	if (p_task->solve_magnet) {
+		solve_simple(p_task, true, p_task->origin_pos);
+	}
+	solve_simple(p_task, false, p_task->origin_pos);
+}
+
+void FabrikInverseKinematic::end_solve(Task *p_task, bool override_tip_basis) {
 	// Assign new bone position.
 	ChainItem *ci(&p_task->chain.chain_root);
 	while (ci) {
@@ -414,16 +439,20 @@ void SkeletonIK3D::_notification(int p_what) {
 				reload_goal();
 			}
 
-			_solve_chain();
+			_queue_solve();
 
 		} break;
 		case NOTIFICATION_EXIT_TREE: {
+			pending_item.remove_from_list();
 			reload_chain();
 		} break;
 	}
 }
 
-SkeletonIK3D::SkeletonIK3D() {
+SelfList<SkeletonIK3D>::List SkeletonIK3D::pending_solves;
+
+SkeletonIK3D::SkeletonIK3D() :
+		pending_item(this) {
 }
 
 SkeletonIK3D::~SkeletonIK3D() {
@@ -528,6 +557,7 @@ void SkeletonIK3D::start(bool p_one_time) {
 
 void SkeletonIK3D::stop() {
 	set_process_internal(false);
+	pending_item.remove_from_list();
 	if (skeleton) {
 		skeleton->clear_bones_global_pose_override();
 	}
@@ -575,4 +605,90 @@ void SkeletonIK3D::_solve_chain() {
 	FabrikInverseKinematic::solve(task, interpolation, override_tip_basis, use_magnet, magnet_position);
 }
 
+void SkeletonIK3D::_queue_solve() {
+	if (!task || pending_item.in_list()) {
+		return;
+	}
+
+	pending_solves.add_last(&pending_item);
+	MessageQueue::get_singleton()->push_callable(callable_mp(this, &SkeletonIK3D::_solve_pending));
+}
+
+void SkeletonIK3D::_solve_pending() {
+	if (!pending_item.in_list()) {
+		return; // Already solved along with other pending chains.
+	}
+	_solve_pending_chains();
+}
+
+void SkeletonIK3D::_solve_chain_thread(void *p_userdata, uint32_t p_index) {
+	FabrikInverseKinematic::Task **tasks = (FabrikInverseKinematic::Task **)p_userdata;
+	FabrikInverseKinematic::solve_chain(tasks[p_index]);
+}
+
+void SkeletonIK3D::_solve_pending_chains() {
+	LocalVector<ObjectID> pending;
+	Map<Skeleton3D *, int> chains_per_skeleton;
+	while (pending_solves.first()) {
+		SkeletonIK3D *ik = pending_solves.first()->self();
+		pending_solves.remove(&ik->pending_item);
+		if (!ik->task) {
+			continue;
+		}
+		pending.push_back(ik->get_instance_id());
+		chains_per_skeleton[ik->skeleton]++;
+	}
+
+	// Reading and writing the skeleton happens here, only the solver runs on the worker threads.
+	// Chains on the same skeleton depend on each other's result, so those are fully solved in order.
+	// Callbacks of the skeleton signals may free other nodes, hence the ObjectIDs.
+	LocalVector<ObjectID> solving;
+	LocalVector<ObjectID> in_order;
+	for (uint32_t i = 0; i < pending.size(); i++) {
+		SkeletonIK3D *ik = Object::cast_to<SkeletonIK3D>(ObjectDB::get_instance(pending[i]));
+		if (!ik || !ik->task) {
+			continue;
+		}
+		if (chains_per_skeleton[ik->skeleton] > 1) {
+			in_order.push_back(pending[i]);
+		} else if (FabrikInverseKinematic::begin_solve(ik->task, ik->interpolation, ik->use_magnet, ik->magnet_position)) {
+			solving.push_back(pending[i]);
+		}
+	}
+
+	LocalVector<ObjectID> ids;
+	LocalVector<FabrikInverseKinematic::Task *> tasks;
+	for (uint32_t i = 0; i < solving.size(); i++) {
+		SkeletonIK3D *ik = Object::cast_to<SkeletonIK3D>(ObjectDB::get_instance(solving[i]));
+		if (ik && ik->task) {
+			ids.push_back(solving[i]);
+			tasks.push_back(ik->task);
+		}
+	}
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (tasks.size() < SKELETON_IK_3D_THREADED_MIN_CHAINS || !pool || pool->get_thread_count() == 0) {
+		for (uint32_t i = 0; i < tasks.size(); i++) {
+			FabrikInverseKinematic::solve_chain(tasks[i]);
+		}
+	} else {
+		WorkerThreadPool::GroupID group = pool->add_native_group_task(_solve_chain_thread, tasks.ptr(), tasks.size(), -1, SKELETON_IK_3D_THREADED_BATCH);
+		pool->wait_for_group_task_completion(group);
+	}
+
+	for (uint32_t i = 0; i < ids.size(); i++) {
+		SkeletonIK3D *ik = Object::cast_to<SkeletonIK3D>(ObjectDB::get_instance(ids[i]));
+		if (ik && ik->task == tasks[i]) {
+			FabrikInverseKinematic::end_solve(ik->task, ik->override_tip_basis);
+		}
+	}
+
+	for (uint32_t i = 0; i < in_order.size(); i++) {
+		SkeletonIK3D *ik = Object::cast_to<SkeletonIK3D>(ObjectDB::get_instance(in_order[i]));
+		if (ik) {
+			ik->_solve_chain();
+		}
+	}
+}
+
 #endif // _3D_DISABLED
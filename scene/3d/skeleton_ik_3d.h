@@ -94,6 +94,10 @@ public:
 
 		Transform3D goal_global_transform;
 
+		// Solve state, set by begin_solve().
+		Vector3 origin_pos;
+		bool solve_magnet = false;
+
 		Task() {}
 	};
 
@@ -114,6 +118,12 @@ public:
 	static void make_goal(Task *p_task, const Transform3D &p_inverse_transf, real_t blending_delta);
 	static void solve(Task *p_task, real_t blending_delta, bool override_tip_basis, bool p_use_magnet, const Vector3 &p_magnet_position);
 
+	// solve() in steps, only solve_chain() is safe to call outside of the main thread.
+	// begin_solve() returns false if there is nothing to solve.
+	static bool begin_solve(Task *p_task, real_t blending_delta, bool p_use_magnet, const Vector3 &p_magnet_position);
+	static void solve_chain(Task *p_task);
+	static void end_solve(Task *p_task, bool override_tip_basis);
+
 	static void _update_chain(const Skeleton3D *p_skeleton, ChainItem *p_chain_item);
 };
 
@@ -136,6 +146,10 @@ class SkeletonIK3D : public Node {
 	Node3D *target_node_override = nullptr;
 	FabrikInverseKinematic::Task *task = nullptr;
 
+	// Chains are solved together when the message queue is flushed, so the solver can run on the worker threads.
+	SelfList<SkeletonIK3D> pending_item;
+	static SelfList<SkeletonIK3D>::List pending_solves;
+
 protected:
 	virtual void
 	_validate_property(PropertyInfo &property) const override;
@@ -189,6 +203,11 @@ private:
 	void reload_chain();
 	void reload_goal();
 	void _solve_chain();
+	void _queue_solve();
+	void _solve_pending();
+
+	static void _solve_chain_thread(void *p_userdata, uint32_t p_index);
+	static void _solve_pending_chains();
 };
 
 #endif // _3D_DISABLED
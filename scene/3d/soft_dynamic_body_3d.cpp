@@ -86,6 +86,21 @@ void SoftDynamicBodyRenderingServerHandler::set_normal(int p_vertex_id, const vo
 	memcpy(&write_buffer[p_vertex_id * stride + offset_normal], p_vector3, sizeof(float) * 3);
 }
 
+void SoftDynamicBodyRenderingServerHandler::set_vertices_and_normals(int p_vertex_count, const Vector3 *p_vertices, const Vector3 *p_normals) {
+	ERR_FAIL_COND(p_vertex_count * stride > (uint32_t)buffer.size());
+
+	uint8_t *vertex_ptr = &write_buffer[offset_vertices];
+	uint8_t *normal_ptr = &write_buffer[offset_normal];
+	for (int i = 0; i < p_vertex_count; i++) {
+		const float vertex[3] = { (float)p_vertices[i].x, (float)p_vertices[i].y, (float)p_vertices[i].z };
+		const float normal[3] = { (float)p_normals[i].x, (float)p_normals[i].y, (float)p_normals[i].z };
+		memcpy(vertex_ptr, vertex, sizeof(vertex));
+		memcpy(normal_ptr, normal, sizeof(normal));
+		vertex_ptr += stride;
+		normal_ptr += stride;
+	}
+}
+
 void SoftDynamicBodyRenderingServerHandler::set_aabb(const AABB &p_aabb) {
 	RS::get_singleton()->mesh_set_custom_aabb(mesh, p_aabb);
 }
@@ -60,6 +60,7 @@ private:
 public:
 	void set_vertex(int p_vertex_id, const void *p_vector3) override;
 	void set_normal(int p_vertex_id, const void *p_vector3) override;
+	void set_vertices_and_normals(int p_vertex_count, const Vector3 *p_vertices, const Vector3 *p_normals) override;
 	void set_aabb(const AABB &p_aabb) override;
 };
 
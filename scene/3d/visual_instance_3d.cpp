@@ -30,6 +30,7 @@
 
 #include "visual_instance_3d.h"
 
+#include "scene/main/scene_tree.h"
 #include "scene/scene_string_names.h"
 
 AABB VisualInstance3D::get_transformed_aabb() const {
@@ -55,16 +56,22 @@ void VisualInstance3D::_notification(int p_what) {
 			*/
 			ERR_FAIL_COND(get_world_3d().is_null());
 			RenderingServer::get_singleton()->instance_set_scenario(instance, get_world_3d()->get_scenario());
+			RenderingServer::get_singleton()->instance_set_interpolated(instance, get_tree()->is_physics_interpolation_enabled());
 			_update_visibility();
 
 		} break;
 		case NOTIFICATION_TRANSFORM_CHANGED: {
 			Transform3D gt = get_global_transform();
-			RenderingServer::get_singleton()->instance_set_transform(instance, gt);
+			get_tree()->set_instance_transform(instance, gt);
+		} break;
+		case NOTIFICATION_RESET_PHYSICS_INTERPOLATION: {
+			RenderingServer::get_singleton()->instance_reset_physics_interpolation(instance);
 		} break;
 		case NOTIFICATION_EXIT_WORLD: {
 			RenderingServer::get_singleton()->instance_set_scenario(instance, RID());
 			RenderingServer::get_singleton()->instance_attach_skeleton(instance, RID());
+			// Re-entering starts over, with nothing to interpolate from.
+			RenderingServer::get_singleton()->instance_set_interpolated(instance, false);
 			//RS::get_singleton()->instance_geometry_set_baked_light_sampler(instance, RID() );
 
 		} break;
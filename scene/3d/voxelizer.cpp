@@ -30,6 +30,13 @@
 
 #include "voxelizer.h"
 
+#include "core/os/worker_thread_pool.h"
+
+#define VOXELIZER_THREADED_MIN_FACES 32
+#define VOXELIZER_THREADED_FACE_BATCH 64
+#define VOXELIZER_THREADED_MIN_CELLS 4096
+#define VOXELIZER_THREADED_CELL_BATCH 512
+
 static _FORCE_INLINE_ void get_uv_and_normal(const Vector3 &p_pos, const Vector3 *p_vtx, const Vector2 *p_uv, const Vector3 *p_normal, Vector2 &r_uv, Vector3 &r_normal) {
 	if (p_pos.is_equal_approx(p_vtx[0])) {
 		r_uv = p_uv[0];
@@ -70,7 +77,27 @@ static _FORCE_INLINE_ void get_uv_and_normal(const Vector3 &p_pos, const Vector3
 	r_normal = (p_normal[0] * u + p_normal[1] * v + p_normal[2] * w).normalized();
 }
 
-void Voxelizer::_plot_face(int p_idx, int p_level, int p_x, int p_y, int p_z, const Vector3 *p_vtx, const Vector3 *p_normal, const Vector2 *p_uv, const MaterialCache &p_material, const AABB &p_aabb) {
+bool Voxelizer::_get_child_cell(int p_level, int p_child, int &r_x, int &r_y, int &r_z, AABB &r_aabb) const {
+	int half = (1 << cell_subdiv) >> (p_level + 1);
+	r_aabb.size *= 0.5;
+
+	if (p_child & 1) {
+		r_aabb.position.x += r_aabb.size.x;
+		r_x += half;
+	}
+	if (p_child & 2) {
+		r_aabb.position.y += r_aabb.size.y;
+		r_y += half;
+	}
+	if (p_child & 4) {
+		r_aabb.position.z += r_aabb.size.z;
+		r_z += half;
+	}
+	//make sure to not plot beyond limits
+	return r_x >= 0 && r_x < axis_cell_size[0] && r_y >= 0 && r_y < axis_cell_size[1] && r_z >= 0 && r_z < axis_cell_size[2];
+}
+
+void Voxelizer::_plot_face(Vector<Cell> &r_cells, int p_idx, int p_level, int p_x, int p_y, int p_z, const Vector3 *p_vtx, const Vector3 *p_normal, const Vector2 *p_uv, const MaterialCache &p_material, const AABB &p_aabb) {
 	if (p_level == cell_subdiv) {
 		//plot the face by guessing its albedo and emission value
 
@@ -217,16 +244,17 @@ void Voxelizer::_plot_face(int p_idx, int p_level, int p_x, int p_y, int p_z, co
 		}
 
 		//put this temporarily here, corrected in a later step
-		bake_cells.write[p_idx].albedo[0] += albedo_accum.r;
-		bake_cells.write[p_idx].albedo[1] += albedo_accum.g;
-		bake_cells.write[p_idx].albedo[2] += albedo_accum.b;
-		bake_cells.write[p_idx].emission[0] += emission_accum.r;
-		bake_cells.write[p_idx].emission[1] += emission_accum.g;
-		bake_cells.write[p_idx].emission[2] += emission_accum.b;
-		bake_cells.write[p_idx].normal[0] += normal_accum.x;
-		bake_cells.write[p_idx].normal[1] += normal_accum.y;
-		bake_cells.write[p_idx].normal[2] += normal_accum.z;
-		bake_cells.write[p_idx].alpha += alpha;
+		Cell &cell = r_cells.write[p_idx];
+		cell.albedo[0] += albedo_accum.r;
+		cell.albedo[1] += albedo_accum.g;
+		cell.albedo[2] += albedo_accum.b;
+		cell.emission[0] += emission_accum.r;
+		cell.emission[1] += emission_accum.g;
+		cell.emission[2] += emission_accum.b;
+		cell.normal[0] += normal_accum.x;
+		cell.normal[1] += normal_accum.y;
+		cell.normal[2] += normal_accum.z;
+		cell.alpha += alpha;
 
 	} else {
 		//go down
@@ -234,54 +262,36 @@ void Voxelizer::_plot_face(int p_idx, int p_level, int p_x, int p_y, int p_z, co
 		int half = (1 << cell_subdiv) >> (p_level + 1);
 		for (int i = 0; i < 8; i++) {
 			AABB aabb = p_aabb;
-			aabb.size *= 0.5;
-
 			int nx = p_x;
 			int ny = p_y;
 			int nz = p_z;
 
-			if (i & 1) {
-				aabb.position.x += aabb.size.x;
-				nx += half;
-			}
-			if (i & 2) {
-				aabb.position.y += aabb.size.y;
-				ny += half;
-			}
-			if (i & 4) {
-				aabb.position.z += aabb.size.z;
-				nz += half;
-			}
-			//make sure to not plot beyond limits
-			if (nx < 0 || nx >= axis_cell_size[0] || ny < 0 || ny >= axis_cell_size[1] || nz < 0 || nz >= axis_cell_size[2]) {
+			if (!_get_child_cell(p_level, i, nx, ny, nz, aabb)) {
 				continue;
 			}
 
 			{
-				AABB test_aabb = aabb;
-				//test_aabb.grow_by(test_aabb.get_longest_axis_size()*0.05); //grow a bit to avoid numerical error in real-time
-				Vector3 qsize = test_aabb.size * 0.5; //quarter size, for fast aabb test
+				Vector3 qsize = aabb.size * 0.5; //quarter size, for fast aabb test
 
-				if (!Geometry3D::triangle_box_overlap(test_aabb.position + qsize, qsize, p_vtx)) {
-					//if (!Face3(p_vtx[0],p_vtx[1],p_vtx[2]).intersects_aabb2(aabb)) {
+				if (!Geometry3D::triangle_box_overlap(aabb.position + qsize, qsize, p_vtx)) {
 					//does not fit in child, go on
 					continue;
 				}
 			}
 
-			if (bake_cells[p_idx].children[i] == CHILD_EMPTY) {
+			if (r_cells[p_idx].children[i] == CHILD_EMPTY) {
 				//sub cell must be created
 
-				uint32_t child_idx = bake_cells.size();
-				bake_cells.write[p_idx].children[i] = child_idx;
-				bake_cells.resize(bake_cells.size() + 1);
-				bake_cells.write[child_idx].level = p_level + 1;
-				bake_cells.write[child_idx].x = nx / half;
-				bake_cells.write[child_idx].y = ny / half;
-				bake_cells.write[child_idx].z = nz / half;
+				uint32_t child_idx = r_cells.size();
+				r_cells.write[p_idx].children[i] = child_idx;
+				r_cells.resize(r_cells.size() + 1);
+				r_cells.write[child_idx].level = p_level + 1;
+				r_cells.write[child_idx].x = nx / half;
+				r_cells.write[child_idx].y = ny / half;
+				r_cells.write[child_idx].z = nz / half;
 			}
 
-			_plot_face(bake_cells[p_idx].children[i], p_level + 1, nx, ny, nz, p_vtx, p_normal, p_uv, p_material, aabb);
+			_plot_face(r_cells, r_cells[p_idx].children[i], p_level + 1, nx, ny, nz, p_vtx, p_normal, p_uv, p_material, aabb);
 		}
 	}
 }
@@ -373,7 +383,68 @@ Voxelizer::MaterialCache Voxelizer::_get_material_cache(Ref<Material> p_material
 	return mc;
 }
 
+void Voxelizer::_find_face_fragments(uint32_t p_index, PlotData *p_data) {
+	PlotFace &face = p_data->faces[p_index];
+
+	// Same descent as _plot_face(), stopping at the split level.
+	for (int i = 0; i < 8; i++) {
+		AABB aabb = po2_bounds;
+		int x = 0;
+		int y = 0;
+		int z = 0;
+
+		if (!_get_child_cell(0, i, x, y, z, aabb) || !Geometry3D::triangle_box_overlap(aabb.position + aabb.size * 0.5, aabb.size * 0.5, face.vtx)) {
+			continue;
+		}
+
+		face.split_cells |= 1 << i;
+
+		for (int j = 0; j < 8; j++) {
+			AABB child_aabb = aabb;
+			int cx = x;
+			int cy = y;
+			int cz = z;
+
+			if (!_get_child_cell(1, j, cx, cy, cz, child_aabb) || !Geometry3D::triangle_box_overlap(child_aabb.position + child_aabb.size * 0.5, child_aabb.size * 0.5, face.vtx)) {
+				continue;
+			}
+
+			face.fragments |= uint64_t(1) << (i * 8 + j);
+		}
+	}
+}
+
+void Voxelizer::_plot_fragment(uint32_t p_index, PlotData *p_data) {
+	uint32_t fragment = p_data->fragment_list[p_index];
+
+	AABB aabb = po2_bounds;
+	int x = 0;
+	int y = 0;
+	int z = 0;
+	_get_child_cell(0, fragment / 8, x, y, z, aabb);
+	_get_child_cell(1, fragment % 8, x, y, z, aabb);
+
+	Vector<Cell> &cells = fragments[fragment];
+	if (cells.is_empty()) {
+		int half = (1 << cell_subdiv) >> SPLIT_LEVEL;
+		cells.resize(1);
+		cells.write[0].level = SPLIT_LEVEL;
+		cells.write[0].x = x / half;
+		cells.write[0].y = y / half;
+		cells.write[0].z = z / half;
+	}
+
+	// Faces are plotted in the same order as on a single thread, so the accumulated values match.
+	const LocalVector<uint32_t> &faces = p_data->fragment_faces[fragment];
+	for (uint32_t i = 0; i < faces.size(); i++) {
+		const PlotFace &face = p_data->faces[faces[i]];
+		_plot_face(cells, 0, SPLIT_LEVEL, x, y, z, face.vtx, face.normal, face.uv, p_data->surface_materials[face.surface], aabb);
+	}
+}
+
 void Voxelizer::plot_mesh(const Transform3D &p_xform, Ref<Mesh> &p_mesh, const Vector<Ref<Material>> &p_materials, const Ref<Material> &p_override_material) {
+	PlotData data;
+
 	for (int i = 0; i < p_mesh->get_surface_count(); i++) {
 		if (p_mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
 			continue; //only triangles
@@ -388,7 +459,8 @@ void Voxelizer::plot_mesh(const Transform3D &p_xform, Ref<Mesh> &p_mesh, const V
 		} else {
 			src_material = p_mesh->surface_get_material(i);
 		}
-		MaterialCache material = _get_material_cache(src_material);
+		uint32_t surface = data.surface_materials.size();
+		data.surface_materials.push_back(_get_material_cache(src_material));
 
 		Array a = p_mesh->surface_get_arrays(i);
 
@@ -408,74 +480,134 @@ void Voxelizer::plot_mesh(const Transform3D &p_xform, Ref<Mesh> &p_mesh, const V
 			nr = normals.ptr();
 		}
 
-		if (index.size()) {
-			int facecount = index.size() / 3;
-			const int *ir = index.ptr();
+		const int *ir = index.size() ? index.ptr() : nullptr;
+		int facecount = (ir ? index.size() : vertices.size()) / 3;
 
-			for (int j = 0; j < facecount; j++) {
-				Vector3 vtxs[3];
-				Vector2 uvs[3];
-				Vector3 normal[3];
+		for (int j = 0; j < facecount; j++) {
+			PlotFace face;
+			face.surface = surface;
 
-				for (int k = 0; k < 3; k++) {
-					vtxs[k] = p_xform.xform(vr[ir[j * 3 + k]]);
-				}
+			for (int k = 0; k < 3; k++) {
+				int vtx = ir ? ir[j * 3 + k] : j * 3 + k;
 
+				face.vtx[k] = p_xform.xform(vr[vtx]);
 				if (uvr) {
-					for (int k = 0; k < 3; k++) {
-						uvs[k] = uvr[ir[j * 3 + k]];
-					}
+					face.uv[k] = uvr[vtx];
 				}
-
 				if (nr) {
-					for (int k = 0; k < 3; k++) {
-						normal[k] = nr[ir[j * 3 + k]];
-					}
+					face.normal[k] = nr[vtx];
 				}
+			}
 
-				//test against original bounds
-				if (!Geometry3D::triangle_box_overlap(original_bounds.get_center(), original_bounds.size * 0.5, vtxs)) {
-					continue;
-				}
-				//plot
-				_plot_face(0, 0, 0, 0, 0, vtxs, normal, uvs, material, po2_bounds);
+			//test against original bounds
+			if (!Geometry3D::triangle_box_overlap(original_bounds.get_center(), original_bounds.size * 0.5, face.vtx)) {
+				continue;
 			}
 
-		} else {
-			int facecount = vertices.size() / 3;
+			data.faces.push_back(face);
+		}
+	}
 
-			for (int j = 0; j < facecount; j++) {
-				Vector3 vtxs[3];
-				Vector2 uvs[3];
-				Vector3 normal[3];
+	uint32_t face_count = data.faces.size();
 
-				for (int k = 0; k < 3; k++) {
-					vtxs[k] = p_xform.xform(vr[j * 3 + k]);
-				}
+	if (cell_subdiv <= SPLIT_LEVEL) {
+		// Too shallow to split, plot from the root.
+		for (uint32_t i = 0; i < face_count; i++) {
+			const PlotFace &face = data.faces[i];
+			_plot_face(bake_cells, 0, 0, 0, 0, 0, face.vtx, face.normal, face.uv, data.surface_materials[face.surface], po2_bounds);
+		}
+		return;
+	}
 
-				if (uvr) {
-					for (int k = 0; k < 3; k++) {
-						uvs[k] = uvr[j * 3 + k];
-					}
-				}
+	// Find the subtrees each face overlaps, then plot every subtree separately. Faces spanning
+	// several subtrees are plotted into each of them, the same as the recursion would do.
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	bool threaded = face_count >= VOXELIZER_THREADED_MIN_FACES && pool && pool->get_thread_count() > 0;
 
-				if (nr) {
-					for (int k = 0; k < 3; k++) {
-						normal[k] = nr[j * 3 + k];
-					}
-				}
+	if (threaded) {
+		WorkerThreadPool::GroupID group = pool->add_template_group_task(this, &Voxelizer::_find_face_fragments, &data, face_count, -1, VOXELIZER_THREADED_FACE_BATCH);
+		pool->wait_for_group_task_completion(group);
+	} else {
+		for (uint32_t i = 0; i < face_count; i++) {
+			_find_face_fragments(i, &data);
+		}
+	}
 
-				//test against original bounds
-				if (!Geometry3D::triangle_box_overlap(original_bounds.get_center(), original_bounds.size * 0.5, vtxs)) {
-					continue;
+	for (uint32_t i = 0; i < face_count; i++) {
+		const PlotFace &face = data.faces[i];
+		split_cells |= face.split_cells;
+
+		for (uint32_t j = 0; j < SPLIT_FRAGMENTS; j++) {
+			if (face.fragments & (uint64_t(1) << j)) {
+				data.fragment_faces[j].push_back(i);
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < SPLIT_FRAGMENTS; i++) {
+		if (data.fragment_faces[i].size()) {
+			data.fragment_list.push_back(i);
+		}
+	}
+
+	if (threaded && data.fragment_list.size() > 1) {
+		WorkerThreadPool::GroupID group = pool->add_template_group_task(this, &Voxelizer::_plot_fragment, &data, data.fragment_list.size(), -1, 1);
+		pool->wait_for_group_task_completion(group);
+	} else {
+		for (uint32_t i = 0; i < data.fragment_list.size(); i++) {
+			_plot_fragment(i, &data);
+		}
+	}
+}
+
+void Voxelizer::_merge_fragments() {
+	// Recreate the cells above the split level and append every fragment, remapping its children.
+	for (int i = 0; i < 8; i++) {
+		if (!(split_cells & (1 << i))) {
+			continue;
+		}
+
+		AABB aabb = po2_bounds;
+		int x = 0;
+		int y = 0;
+		int z = 0;
+		_get_child_cell(0, i, x, y, z, aabb);
+
+		int half = (1 << cell_subdiv) >> 1;
+		uint32_t split_idx = bake_cells.size();
+		bake_cells.write[0].children[i] = split_idx;
+		bake_cells.resize(split_idx + 1);
+		bake_cells.write[split_idx].level = 1;
+		bake_cells.write[split_idx].x = x / half;
+		bake_cells.write[split_idx].y = y / half;
+		bake_cells.write[split_idx].z = z / half;
+
+		for (int j = 0; j < 8; j++) {
+			Vector<Cell> &fragment = fragments[i * 8 + j];
+			if (fragment.is_empty()) {
+				continue;
+			}
+
+			uint32_t offset = bake_cells.size();
+			bake_cells.write[split_idx].children[j] = offset;
+			bake_cells.resize(offset + fragment.size());
+
+			Cell *w = bake_cells.ptrw() + offset;
+			const Cell *r = fragment.ptr();
+			for (int k = 0; k < fragment.size(); k++) {
+				w[k] = r[k];
+				for (int l = 0; l < 8; l++) {
+					if (w[k].children[l] != CHILD_EMPTY) {
+						w[k].children[l] += offset;
+					}
 				}
-				//plot face
-				_plot_face(0, 0, 0, 0, 0, vtxs, normal, uvs, material, po2_bounds);
 			}
+
+			fragment.clear();
 		}
 	}
 
-	max_original_cells = bake_cells.size();
+	split_cells = 0;
 }
 
 void Voxelizer::_sort() {
@@ -540,74 +672,66 @@ void Voxelizer::_sort() {
 	sorted = true;
 }
 
-void Voxelizer::_fixup_plot(int p_idx, int p_level) {
-	if (p_level == cell_subdiv) {
-		leaf_voxel_count++;
-		float alpha = bake_cells[p_idx].alpha;
+void Voxelizer::_fixup_cell(uint32_t p_index, FixupData *p_data) {
+	Cell &cell = p_data->cells[p_data->from + p_index];
+
+	if (cell.level == cell_subdiv) {
+		float alpha = cell.alpha;
 
-		bake_cells.write[p_idx].albedo[0] /= alpha;
-		bake_cells.write[p_idx].albedo[1] /= alpha;
-		bake_cells.write[p_idx].albedo[2] /= alpha;
+		cell.albedo[0] /= alpha;
+		cell.albedo[1] /= alpha;
+		cell.albedo[2] /= alpha;
 
 		//transfer emission to light
-		bake_cells.write[p_idx].emission[0] /= alpha;
-		bake_cells.write[p_idx].emission[1] /= alpha;
-		bake_cells.write[p_idx].emission[2] /= alpha;
+		cell.emission[0] /= alpha;
+		cell.emission[1] /= alpha;
+		cell.emission[2] /= alpha;
 
-		bake_cells.write[p_idx].normal[0] /= alpha;
-		bake_cells.write[p_idx].normal[1] /= alpha;
-		bake_cells.write[p_idx].normal[2] /= alpha;
+		cell.normal[0] /= alpha;
+		cell.normal[1] /= alpha;
+		cell.normal[2] /= alpha;
 
-		Vector3 n(bake_cells[p_idx].normal[0], bake_cells[p_idx].normal[1], bake_cells[p_idx].normal[2]);
+		Vector3 n(cell.normal[0], cell.normal[1], cell.normal[2]);
 		if (n.length() < 0.01) {
 			//too much fight over normal, zero it
-			bake_cells.write[p_idx].normal[0] = 0;
-			bake_cells.write[p_idx].normal[1] = 0;
-			bake_cells.write[p_idx].normal[2] = 0;
+			cell.normal[0] = 0;
+			cell.normal[1] = 0;
+			cell.normal[2] = 0;
 		} else {
 			n.normalize();
-			bake_cells.write[p_idx].normal[0] = n.x;
-			bake_cells.write[p_idx].normal[1] = n.y;
-			bake_cells.write[p_idx].normal[2] = n.z;
+			cell.normal[0] = n.x;
+			cell.normal[1] = n.y;
+			cell.normal[2] = n.z;
 		}
 
-		bake_cells.write[p_idx].alpha = 1.0;
-
-		/*if (bake_light.size()) {
-			for(int i=0;i<6;i++) {
-			}
-		}*/
+		cell.alpha = 1.0;
 
 	} else {
-		//go down
-
-		bake_cells.write[p_idx].emission[0] = 0;
-		bake_cells.write[p_idx].emission[1] = 0;
-		bake_cells.write[p_idx].emission[2] = 0;
-		bake_cells.write[p_idx].normal[0] = 0;
-		bake_cells.write[p_idx].normal[1] = 0;
-		bake_cells.write[p_idx].normal[2] = 0;
-		bake_cells.write[p_idx].albedo[0] = 0;
-		bake_cells.write[p_idx].albedo[1] = 0;
-		bake_cells.write[p_idx].albedo[2] = 0;
+		//children are in a deeper level, already fixed up
+
+		cell.emission[0] = 0;
+		cell.emission[1] = 0;
+		cell.emission[2] = 0;
+		cell.normal[0] = 0;
+		cell.normal[1] = 0;
+		cell.normal[2] = 0;
+		cell.albedo[0] = 0;
+		cell.albedo[1] = 0;
+		cell.albedo[2] = 0;
 
 		float alpha_average = 0;
-		int children_found = 0;
 
 		for (int i = 0; i < 8; i++) {
-			uint32_t child = bake_cells[p_idx].children[i];
+			uint32_t child = cell.children[i];
 
 			if (child == CHILD_EMPTY) {
 				continue;
 			}
 
-			_fixup_plot(child, p_level + 1);
-			alpha_average += bake_cells[child].alpha;
-
-			children_found++;
+			alpha_average += p_data->cells[child].alpha;
 		}
 
-		bake_cells.write[p_idx].alpha = alpha_average / 8.0;
+		cell.alpha = alpha_average / 8.0;
 	}
 }
 
@@ -617,6 +741,10 @@ void Voxelizer::begin_bake(int p_subdiv, const AABB &p_bounds) {
 	cell_subdiv = p_subdiv;
 	bake_cells.resize(1);
 	material_cache.clear();
+	for (int i = 0; i < SPLIT_FRAGMENTS; i++) {
+		fragments[i].clear();
+	}
+	split_cells = 0;
 
 	//find out the actual real bounds, power of 2, which gets the highest subdivision
 	po2_bounds = p_bounds;
@@ -654,10 +782,37 @@ void Voxelizer::begin_bake(int p_subdiv, const AABB &p_bounds) {
 }
 
 void Voxelizer::end_bake() {
+	_merge_fragments();
+	max_original_cells = bake_cells.size();
+
 	if (!sorted) {
 		_sort();
 	}
-	_fixup_plot(0, 0);
+
+	// Cells are sorted by level, fix them up one level at a time, from the leaves up to the root.
+	Vector<int> level_count = get_voxel_gi_level_cell_count();
+	leaf_voxel_count = level_count[cell_subdiv];
+
+	uint32_t level_end = bake_cells.size();
+	FixupData data;
+	data.cells = bake_cells.ptrw();
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+
+	for (int i = cell_subdiv; i >= 0; i--) {
+		uint32_t count = level_count[i];
+		data.from = level_end - count;
+		level_end = data.from;
+
+		if (count < VOXELIZER_THREADED_MIN_CELLS || !pool || pool->get_thread_count() == 0) {
+			for (uint32_t j = 0; j < count; j++) {
+				_fixup_cell(j, &data);
+			}
+		} else {
+			WorkerThreadPool::GroupID group = pool->add_template_group_task(this, &Voxelizer::_fixup_cell, &data, count, -1, VOXELIZER_THREADED_CELL_BATCH);
+			pool->wait_for_group_task_completion(group);
+		}
+	}
 }
 
 //create the data for rendering server
@@ -694,55 +849,67 @@ Vector<uint8_t> Voxelizer::get_voxel_gi_octree_cells() const {
 	return data;
 }
 
-Vector<uint8_t> Voxelizer::get_voxel_gi_data_cells() const {
-	Vector<uint8_t> data;
-	data.resize((4 * 4) * bake_cells.size()); //8 uint32t values
-	{
-		uint8_t *w = data.ptrw();
-		uint32_t *dataptr = (uint32_t *)w;
-		const Cell *cells = bake_cells.ptr();
+void Voxelizer::_fill_data_cell(uint32_t p_index, uint32_t *p_data) const {
+	const Cell &cell = bake_cells[p_index];
+	uint32_t *dataptr = p_data + p_index * 4;
 
-		uint32_t cell_count = bake_cells.size();
+	{ //position
 
-		for (uint32_t i = 0; i < cell_count; i++) {
-			{ //position
+		uint32_t x = cell.x;
+		uint32_t y = cell.y;
+		uint32_t z = cell.z;
 
-				uint32_t x = cells[i].x;
-				uint32_t y = cells[i].y;
-				uint32_t z = cells[i].z;
+		uint32_t position = x;
+		position |= y << 11;
+		position |= z << 21;
 
-				uint32_t position = x;
-				position |= y << 11;
-				position |= z << 21;
+		dataptr[0] = position;
+	}
 
-				dataptr[i * 4 + 0] = position;
-			}
+	{ //albedo + alpha
+		uint32_t rgba = uint32_t(CLAMP(cell.alpha * 255.0, 0, 255)) << 24; //a
+		rgba |= uint32_t(CLAMP(cell.albedo[2] * 255.0, 0, 255)) << 16; //b
+		rgba |= uint32_t(CLAMP(cell.albedo[1] * 255.0, 0, 255)) << 8; //g
+		rgba |= uint32_t(CLAMP(cell.albedo[0] * 255.0, 0, 255)); //r
 
-			{ //albedo + alpha
-				uint32_t rgba = uint32_t(CLAMP(cells[i].alpha * 255.0, 0, 255)) << 24; //a
-				rgba |= uint32_t(CLAMP(cells[i].albedo[2] * 255.0, 0, 255)) << 16; //b
-				rgba |= uint32_t(CLAMP(cells[i].albedo[1] * 255.0, 0, 255)) << 8; //g
-				rgba |= uint32_t(CLAMP(cells[i].albedo[0] * 255.0, 0, 255)); //r
+		dataptr[1] = rgba;
+	}
 
-				dataptr[i * 4 + 1] = rgba;
-			}
+	{ //emission, as rgbe9995
+		Color emission = Color(cell.emission[0], cell.emission[1], cell.emission[2]);
+		dataptr[2] = emission.to_rgbe9995();
+	}
 
-			{ //emission, as rgbe9995
-				Color emission = Color(cells[i].emission[0], cells[i].emission[1], cells[i].emission[2]);
-				dataptr[i * 4 + 2] = emission.to_rgbe9995();
-			}
+	{ //normal
 
-			{ //normal
+		Vector3 n(cell.normal[0], cell.normal[1], cell.normal[2]);
+		n.normalize();
 
-				Vector3 n(bake_cells[i].normal[0], bake_cells[i].normal[1], bake_cells[i].normal[2]);
-				n.normalize();
+		uint32_t normal = uint32_t(uint8_t(int8_t(CLAMP(n.x * 127.0, -128, 127))));
+		normal |= uint32_t(uint8_t(int8_t(CLAMP(n.y * 127.0, -128, 127)))) << 8;
+		normal |= uint32_t(uint8_t(int8_t(CLAMP(n.z * 127.0, -128, 127)))) << 16;
 
-				uint32_t normal = uint32_t(uint8_t(int8_t(CLAMP(n.x * 127.0, -128, 127))));
-				normal |= uint32_t(uint8_t(int8_t(CLAMP(n.y * 127.0, -128, 127)))) << 8;
-				normal |= uint32_t(uint8_t(int8_t(CLAMP(n.z * 127.0, -128, 127)))) << 16;
+		dataptr[3] = normal;
+	}
+}
 
-				dataptr[i * 4 + 3] = normal;
+Vector<uint8_t> Voxelizer::get_voxel_gi_data_cells() const {
+	Vector<uint8_t> data;
+	data.resize((4 * 4) * bake_cells.size()); //4 uint32t values
+	{
+		uint8_t *w = data.ptrw();
+		uint32_t *dataptr = (uint32_t *)w;
+
+		uint32_t cell_count = bake_cells.size();
+
+		WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+		if (cell_count < VOXELIZER_THREADED_MIN_CELLS || !pool || pool->get_thread_count() == 0) {
+			for (uint32_t i = 0; i < cell_count; i++) {
+				_fill_data_cell(i, dataptr);
 			}
+		} else {
+			WorkerThreadPool::GroupID group = pool->add_template_group_task(this, &Voxelizer::_fill_data_cell, dataptr, cell_count, -1, VOXELIZER_THREADED_CELL_BATCH);
+			pool->wait_for_group_task_completion(group);
 		}
 	}
 
@@ -812,6 +979,41 @@ static void edt(float *f, int stride, int n) {
 
 #undef square
 
+struct EDTPass {
+	float *work_memory = nullptr;
+	uint32_t line_width = 0; // Lines along the first axis.
+	uint32_t first_mult = 0;
+	uint32_t second_mult = 0;
+	int stride = 0;
+	int length = 0;
+};
+
+static void edt_line(void *p_userdata, uint32_t p_line) {
+	const EDTPass *pass = (const EDTPass *)p_userdata;
+	uint32_t from = (p_line % pass->line_width) * pass->first_mult + (p_line / pass->line_width) * pass->second_mult;
+	edt(&pass->work_memory[from], pass->stride, pass->length);
+}
+
+static void edt_pass(EDTPass &p_pass, uint32_t p_line_width, uint32_t p_first_mult, uint32_t p_line_height, uint32_t p_second_mult, int p_stride, int p_length) {
+	p_pass.line_width = p_line_width;
+	p_pass.first_mult = p_first_mult;
+	p_pass.second_mult = p_second_mult;
+	p_pass.stride = p_stride;
+	p_pass.length = p_length;
+
+	// Every line is transformed independently.
+	uint32_t line_count = p_line_width * p_line_height;
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (line_count * p_length < VOXELIZER_THREADED_MIN_CELLS || !pool || pool->get_thread_count() == 0) {
+		for (uint32_t i = 0; i < line_count; i++) {
+			edt_line(&p_pass, i);
+		}
+	} else {
+		WorkerThreadPool::GroupID group = pool->add_native_group_task(edt_line, &p_pass, line_count, -1, 16);
+		pool->wait_for_group_task_completion(group);
+	}
+}
+
 Vector<uint8_t> Voxelizer::get_sdf_3d_image() const {
 	Vector3i octree_size = get_voxel_gi_octree_size();
 
@@ -840,28 +1042,17 @@ Vector<uint8_t> Voxelizer::get_sdf_3d_image() const {
 
 	//process in each direction
 
-	//xy->z
+	EDTPass pass;
+	pass.work_memory = work_memory;
 
-	for (int i = 0; i < octree_size.x; i++) {
-		for (int j = 0; j < octree_size.y; j++) {
-			edt(&work_memory[i + j * y_mult], z_mult, octree_size.z);
-		}
-	}
+	//xy->z
+	edt_pass(pass, octree_size.x, 1, octree_size.y, y_mult, z_mult, octree_size.z);
 
 	//xz->y
-
-	for (int i = 0; i < octree_size.x; i++) {
-		for (int j = 0; j < octree_size.z; j++) {
-			edt(&work_memory[i + j * z_mult], y_mult, octree_size.y);
-		}
-	}
+	edt_pass(pass, octree_size.x, 1, octree_size.z, z_mult, y_mult, octree_size.y);
 
 	//yz->x
-	for (int i = 0; i < octree_size.y; i++) {
-		for (int j = 0; j < octree_size.z; j++) {
-			edt(&work_memory[i * y_mult + j * z_mult], 1, octree_size.x);
-		}
-	}
+	edt_pass(pass, octree_size.y, y_mult, octree_size.z, z_mult, 1, octree_size.x);
 
 	Vector<uint8_t> image3d;
 	image3d.resize(float_count);
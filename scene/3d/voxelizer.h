@@ -31,6 +31,7 @@
 #ifndef VOXEL_LIGHT_BAKER_H
 #define VOXEL_LIGHT_BAKER_H
 
+#include "core/templates/local_vector.h"
 #include "scene/resources/multimesh.h"
 
 class Voxelizer {
@@ -40,6 +41,13 @@ private:
 
 	};
 
+	// Cells below this level are plotted into a separate fragment per subtree, so that
+	// subtrees can be plotted from several threads. Fragments are merged in end_bake().
+	enum {
+		SPLIT_LEVEL = 2,
+		SPLIT_FRAGMENTS = 64, // One bit per fragment in a 64 bits mask.
+	};
+
 	struct Cell {
 		uint32_t children[8];
 		float albedo[3] = {}; //albedo in RGB24
@@ -87,6 +95,30 @@ private:
 	};
 
 	Map<Ref<Material>, MaterialCache> material_cache;
+
+	struct PlotFace {
+		Vector3 vtx[3];
+		Vector3 normal[3];
+		Vector2 uv[3];
+		uint32_t surface = 0;
+		uint8_t split_cells = 0; // Level 1 cells overlapped.
+		uint64_t fragments = 0; // Level 2 cells overlapped.
+	};
+
+	struct PlotData {
+		LocalVector<PlotFace> faces;
+		LocalVector<MaterialCache> surface_materials;
+		LocalVector<uint32_t> fragment_faces[SPLIT_FRAGMENTS];
+		LocalVector<uint32_t> fragment_list;
+	};
+
+	Vector<Cell> fragments[SPLIT_FRAGMENTS];
+	uint8_t split_cells = 0;
+
+	struct FixupData {
+		Cell *cells = nullptr;
+		uint32_t from = 0;
+	};
 	AABB original_bounds;
 	AABB po2_bounds;
 	int axis_cell_size[3] = {};
@@ -103,8 +135,13 @@ private:
 	Vector<Color> _get_bake_texture(Ref<Image> p_image, const Color &p_color_mul, const Color &p_color_add);
 	MaterialCache _get_material_cache(Ref<Material> p_material);
 
-	void _plot_face(int p_idx, int p_level, int p_x, int p_y, int p_z, const Vector3 *p_vtx, const Vector3 *p_normal, const Vector2 *p_uv, const MaterialCache &p_material, const AABB &p_aabb);
-	void _fixup_plot(int p_idx, int p_level);
+	bool _get_child_cell(int p_level, int p_child, int &r_x, int &r_y, int &r_z, AABB &r_aabb) const;
+	void _plot_face(Vector<Cell> &r_cells, int p_idx, int p_level, int p_x, int p_y, int p_z, const Vector3 *p_vtx, const Vector3 *p_normal, const Vector2 *p_uv, const MaterialCache &p_material, const AABB &p_aabb);
+	void _find_face_fragments(uint32_t p_index, PlotData *p_data);
+	void _plot_fragment(uint32_t p_index, PlotData *p_data);
+	void _merge_fragments();
+	void _fixup_cell(uint32_t p_index, FixupData *p_data);
+	void _fill_data_cell(uint32_t p_index, uint32_t *p_data) const;
 	void _debug_mesh(int p_idx, int p_level, const AABB &p_aabb, Ref<MultiMesh> &p_multimesh, int &idx);
 
 	bool sorted = false;
@@ -0,0 +1,127 @@
+/*************************************************************************/
+/*  animation_lod.cpp                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "animation_lod.h"
+
+#include "core/config/engine.h"
+#include "scene/main/node.h"
+#include "scene/main/viewport.h"
+
+#ifndef _3D_DISABLED
+#include "scene/3d/camera_3d.h"
+#include "scene/3d/skeleton_3d.h"
+#include "scene/3d/visible_on_screen_notifier_3d.h"
+#endif // _3D_DISABLED
+
+int AnimationLOD::_get_update_interval(const Node *p_owner) {
+	far = false;
+
+#ifndef _3D_DISABLED
+	if (Engine::get_singleton()->is_editor_hint() || !p_owner->is_inside_tree()) {
+		return 1;
+	}
+
+	const VisibleOnScreenNotifier3D *notifier = nullptr;
+	if (!visibility_notifier.is_empty()) {
+		notifier = Object::cast_to<VisibleOnScreenNotifier3D>(p_owner->get_node_or_null(visibility_notifier));
+		if (notifier && !notifier->is_on_screen()) {
+			return offscreen_update_interval;
+		}
+	}
+
+	if (distance > 0.0) {
+		const Camera3D *camera = p_owner->get_viewport()->get_camera_3d();
+
+		// Measure from the notifier bounds, or from the closest 3D ancestor.
+		Vector3 position;
+		bool has_position = false;
+		if (notifier) {
+			position = notifier->get_global_transform().xform(notifier->get_aabb().get_center());
+			has_position = true;
+		} else {
+			for (const Node *node = p_owner->get_parent(); node && !has_position; node = node->get_parent()) {
+				const Node3D *node_3d = Object::cast_to<Node3D>(node);
+				if (node_3d) {
+					position = node_3d->get_global_transform().origin;
+					has_position = true;
+				}
+			}
+		}
+
+		if (camera && has_position && camera->get_camera_transform().origin.distance_to(position) > distance) {
+			far = true;
+			return MAX(far_update_interval, 1);
+		}
+	}
+#endif // _3D_DISABLED
+
+	return 1;
+}
+
+bool AnimationLOD::update(const Node *p_owner, double p_delta, double &r_delta) {
+	const int new_interval = _get_update_interval(p_owner);
+	if (new_interval == 0) {
+		// Paused, the time off screen is dropped.
+		frame = 0;
+		accumulated_delta = 0.0;
+		return false;
+	}
+
+	accumulated_delta += p_delta;
+	frame++;
+	if (frame < new_interval) {
+		return false;
+	}
+
+	r_delta = accumulated_delta;
+	accumulated_delta = 0.0;
+	frame = 0;
+	interval = new_interval;
+	return true;
+}
+
+void AnimationLOD::reset() {
+	accumulated_delta = 0.0;
+	far = false;
+	interval = 1;
+	frame = 0;
+}
+
+bool AnimationLOD::is_bone_skipped(const Skeleton3D *p_skeleton, int p_bone) const {
+#ifndef _3D_DISABLED
+	if (!far || !p_skeleton) {
+		return false;
+	}
+	const int bone_count = p_skeleton->get_lod_bone_count();
+	return bone_count > 0 && p_bone >= bone_count;
+#else
+	return false;
+#endif // _3D_DISABLED
+}
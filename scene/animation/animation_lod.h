@@ -0,0 +1,70 @@
+/*************************************************************************/
+/*  animation_lod.h                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef ANIMATION_LOD_H
+#define ANIMATION_LOD_H
+
+#include "core/math/math_defs.h"
+#include "core/string/node_path.h"
+
+class Node;
+class Skeleton3D;
+
+// Throttles the updates of an AnimationPlayer or AnimationTree that is off
+// screen, as reported by a VisibleOnScreenNotifier3D, or far from the
+// current camera. The time of the skipped frames is added to the next update.
+class AnimationLOD {
+	double accumulated_delta = 0.0;
+	bool far = false;
+	int interval = 1;
+	int frame = 0;
+
+	int _get_update_interval(const Node *p_owner);
+
+public:
+	NodePath visibility_notifier;
+	real_t distance = 0.0; // Disabled when zero.
+	int far_update_interval = 4;
+	int offscreen_update_interval = 8; // Pauses when zero.
+
+	// Returns whether the owner updates this frame, with the time since the last update.
+	bool update(const Node *p_owner, double p_delta, double &r_delta);
+	void reset();
+
+	// Frames between the last update and the next one, and the frames elapsed since the last one.
+	_FORCE_INLINE_ int get_interval() const { return interval; }
+	_FORCE_INLINE_ int get_frame() const { return frame; }
+	_FORCE_INLINE_ bool is_far() const { return far; }
+
+	// Bones past Skeleton3D::lod_bone_count aren't animated while far.
+	bool is_bone_skipped(const Skeleton3D *p_skeleton, int p_bone) const;
+};
+
+#endif // ANIMATION_LOD_H
@@ -214,8 +214,9 @@ void AnimationPlayer::_notification(int p_what) {
 				break;
 			}
 
-			if (processing) {
-				_animation_process(get_process_delta_time());
+			double delta = 0.0;
+			if (processing && lod.update(this, get_process_delta_time(), delta)) {
+				_animation_process(delta);
 			}
 		} break;
 		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
@@ -223,8 +224,9 @@ void AnimationPlayer::_notification(int p_what) {
 				break;
 			}
 
-			if (processing) {
-				_animation_process(get_physics_process_delta_time());
+			double delta = 0.0;
+			if (processing && lod.update(this, get_physics_process_delta_time(), delta)) {
+				_animation_process(delta);
 			}
 		} break;
 		case NOTIFICATION_EXIT_TREE: {
@@ -427,7 +429,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, double
 		switch (a->track_get_type(i)) {
 			case Animation::TYPE_POSITION_3D: {
 #ifndef _3D_DISABLED
-				if (!nc->node_3d) {
+				if (!nc->node_3d || lod.is_bone_skipped(nc->skeleton, nc->bone_idx)) {
 					continue;
 				}
 
@@ -454,7 +456,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, double
 			} break;
 			case Animation::TYPE_ROTATION_3D: {
 #ifndef _3D_DISABLED
-				if (!nc->node_3d) {
+				if (!nc->node_3d || lod.is_bone_skipped(nc->skeleton, nc->bone_idx)) {
 					continue;
 				}
 
@@ -481,7 +483,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, double
 			} break;
 			case Animation::TYPE_SCALE_3D: {
 #ifndef _3D_DISABLED
-				if (!nc->node_3d) {
+				if (!nc->node_3d || lod.is_bone_skipped(nc->skeleton, nc->bone_idx)) {
 					continue;
 				}
 
@@ -1590,6 +1592,40 @@ AnimationPlayer::AnimationMethodCallMode AnimationPlayer::get_method_call_mode()
 	return method_call_mode;
 }
 
+void AnimationPlayer::set_lod_visibility_notifier(const NodePath &p_path) {
+	lod.visibility_notifier = p_path;
+}
+
+NodePath AnimationPlayer::get_lod_visibility_notifier() const {
+	return lod.visibility_notifier;
+}
+
+void AnimationPlayer::set_lod_distance(real_t p_distance) {
+	lod.distance = MAX(p_distance, 0.0);
+}
+
+real_t AnimationPlayer::get_lod_distance() const {
+	return lod.distance;
+}
+
+void AnimationPlayer::set_lod_far_update_interval(int p_frames) {
+	ERR_FAIL_COND(p_frames < 1);
+	lod.far_update_interval = p_frames;
+}
+
+int AnimationPlayer::get_lod_far_update_interval() const {
+	return lod.far_update_interval;
+}
+
+void AnimationPlayer::set_lod_offscreen_update_interval(int p_frames) {
+	ERR_FAIL_COND(p_frames < 0);
+	lod.offscreen_update_interval = p_frames;
+}
+
+int AnimationPlayer::get_lod_offscreen_update_interval() const {
+	return lod.offscreen_update_interval;
+}
+
 void AnimationPlayer::_set_process(bool p_process, bool p_force) {
 	if (processing == p_process && !p_force) {
 		return;
@@ -1802,6 +1838,18 @@ void AnimationPlayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_method_call_mode", "mode"), &AnimationPlayer::set_method_call_mode);
 	ClassDB::bind_method(D_METHOD("get_method_call_mode"), &AnimationPlayer::get_method_call_mode);
 
+	ClassDB::bind_method(D_METHOD("set_lod_visibility_notifier", "path"), &AnimationPlayer::set_lod_visibility_notifier);
+	ClassDB::bind_method(D_METHOD("get_lod_visibility_notifier"), &AnimationPlayer::get_lod_visibility_notifier);
+
+	ClassDB::bind_method(D_METHOD("set_lod_distance", "distance"), &AnimationPlayer::set_lod_distance);
+	ClassDB::bind_method(D_METHOD("get_lod_distance"), &AnimationPlayer::get_lod_distance);
+
+	ClassDB::bind_method(D_METHOD("set_lod_far_update_interval", "frames"), &AnimationPlayer::set_lod_far_update_interval);
+	ClassDB::bind_method(D_METHOD("get_lod_far_update_interval"), &AnimationPlayer::get_lod_far_update_interval);
+
+	ClassDB::bind_method(D_METHOD("set_lod_offscreen_update_interval", "frames"), &AnimationPlayer::set_lod_offscreen_update_interval);
+	ClassDB::bind_method(D_METHOD("get_lod_offscreen_update_interval"), &AnimationPlayer::get_lod_offscreen_update_interval);
+
 	ClassDB::bind_method(D_METHOD("get_current_animation_position"), &AnimationPlayer::get_current_animation_position);
 	ClassDB::bind_method(D_METHOD("get_current_animation_length"), &AnimationPlayer::get_current_animation_length);
 
@@ -1823,6 +1871,12 @@ void AnimationPlayer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "playback_speed", PROPERTY_HINT_RANGE, "-64,64,0.01"), "set_speed_scale", "get_speed_scale");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "method_call_mode", PROPERTY_HINT_ENUM, "Deferred,Immediate"), "set_method_call_mode", "get_method_call_mode");
 
+	ADD_GROUP("LOD", "lod_");
+	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "lod_visibility_notifier", PROPERTY_HINT_NODE_PATH_VALID_TYPES, "VisibleOnScreenNotifier3D"), "set_lod_visibility_notifier", "get_lod_visibility_notifier");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lod_distance", PROPERTY_HINT_RANGE, "0,1000,0.1,or_greater"), "set_lod_distance", "get_lod_distance");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_far_update_interval", PROPERTY_HINT_RANGE, "1,60,1,or_greater"), "set_lod_far_update_interval", "get_lod_far_update_interval");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_offscreen_update_interval", PROPERTY_HINT_RANGE, "0,60,1,or_greater"), "set_lod_offscreen_update_interval", "get_lod_offscreen_update_interval");
+
 	ADD_SIGNAL(MethodInfo("animation_finished", PropertyInfo(Variant::STRING_NAME, "anim_name")));
 	ADD_SIGNAL(MethodInfo("animation_changed", PropertyInfo(Variant::STRING_NAME, "old_name"), PropertyInfo(Variant::STRING_NAME, "new_name")));
 	ADD_SIGNAL(MethodInfo("animation_started", PropertyInfo(Variant::STRING_NAME, "anim_name")));
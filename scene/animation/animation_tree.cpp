@@ -32,6 +32,7 @@
 
 #include "animation_blend_tree.h"
 #include "core/config/engine.h"
+#include "core/os/worker_thread_pool.h"
 #include "scene/scene_string_names.h"
 #include "servers/audio/audio_stream.h"
 
@@ -784,6 +785,8 @@ bool AnimationTree::_update_caches(AnimationPlayer *player) {
 }
 
 void AnimationTree::_clear_caches() {
+	_cancel_pending_process();
+
 	const NodePath *K = nullptr;
 	while ((K = track_cache.next(K))) {
 		memdelete(track_cache[*K]);
@@ -794,7 +797,7 @@ void AnimationTree::_clear_caches() {
 	cache_valid = false;
 }
 
-void AnimationTree::_process_graph(real_t p_delta) {
+bool AnimationTree::_process_graph_begin(real_t p_delta) {
 	_update_properties(); //if properties need updating, update them
 
 	//check all tracks, see if they need modification
@@ -805,14 +808,14 @@ void AnimationTree::_process_graph(real_t p_delta) {
 		ERR_PRINT("AnimationTree: root AnimationNode is not set, disabling playback.");
 		set_active(false);
 		cache_valid = false;
-		return;
+		return false;
 	}
 
 	if (!has_node(animation_player)) {
 		ERR_PRINT("AnimationTree: no valid AnimationPlayer path set, disabling playback");
 		set_active(false);
 		cache_valid = false;
-		return;
+		return false;
 	}
 
 	AnimationPlayer *player = Object::cast_to<AnimationPlayer>(get_node(animation_player));
@@ -842,12 +845,12 @@ void AnimationTree::_process_graph(real_t p_delta) {
 		ERR_PRINT("AnimationTree: path points to a node not an AnimationPlayer, disabling playback");
 		set_active(false);
 		cache_valid = false;
-		return;
+		return false;
 	}
 
 	if (!cache_valid) {
 		if (!_update_caches(player)) {
-			return;
+			return false;
 		}
 	}
 
@@ -885,21 +888,76 @@ void AnimationTree::_process_graph(real_t p_delta) {
 	}
 
 	if (!state.valid) {
-		return; //state is not valid. do nothing.
+		return false; //state is not valid. do nothing.
+	}
+
+	// Keep the blends of this pass, the nodes holding them can be shared
+	// with other trees processed before the tracks are blended.
+	blended_animations.resize(state.animation_states.size());
+	blended_track_blends.resize(state.animation_states.size() * state.track_count);
+	uint32_t animation_index = 0;
+	for (const AnimationNode::AnimationState &as : state.animation_states) {
+		BlendedAnimation &ba = blended_animations[animation_index];
+		ba.animation = as.animation;
+		ba.time = as.time;
+		ba.delta = as.delta;
+		ba.weight = as.blend;
+		ba.seeked = as.seeked;
+
+		real_t *track_blends = blended_track_blends.ptr() + animation_index * state.track_count;
+		const int track_blend_count = MIN(as.track_blends->size(), state.track_count);
+		for (int i = 0; i < state.track_count; i++) {
+			track_blends[i] = i < track_blend_count ? (*as.track_blends)[i] : 0.0;
+		}
+		ba.track_blends = track_blends;
+		animation_index++;
+	}
+
+	return true;
+}
+
+// Tracks only blending values into their caches, they don't touch any
+// other object until the values are set and can blend on any thread.
+static bool _is_sampled_track(const Ref<Animation> &p_animation, int p_track) {
+	switch (p_animation->track_get_type(p_track)) {
+		case Animation::TYPE_POSITION_3D:
+		case Animation::TYPE_ROTATION_3D:
+		case Animation::TYPE_SCALE_3D:
+		case Animation::TYPE_BLEND_SHAPE:
+		case Animation::TYPE_BEZIER:
+			return true;
+		case Animation::TYPE_VALUE: {
+			const Animation::UpdateMode update_mode = p_animation->value_track_get_update_mode(p_track);
+			return update_mode == Animation::UPDATE_CONTINUOUS || update_mode == Animation::UPDATE_CAPTURE;
+		}
+		default:
+			return false;
 	}
+}
+
+void AnimationTree::_blend_tracks(bool p_sampled_tracks) {
 	//apply value/transform/bezier blends to track caches and execute method/audio/animation tracks
 
 	{
 		bool can_call = is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
 
-		for (const AnimationNode::AnimationState &as : state.animation_states) {
-			Ref<Animation> a = as.animation;
-			double time = as.time;
-			double delta = as.delta;
-			real_t weight = as.blend;
-			bool seeked = as.seeked;
+		for (uint32_t animation_index = 0; animation_index < blended_animations.size(); animation_index++) {
+			const BlendedAnimation &ba = blended_animations[animation_index];
+			const Ref<Animation> &a = ba.animation;
+			double time = ba.time;
+			double delta = ba.delta;
+			real_t weight = ba.weight;
+			bool seeked = ba.seeked;
+
+			if (p_sampled_tracks && weight < lod_min_blend_weight) {
+				continue; // Too light to matter, the discrete tracks still run.
+			}
 
 			for (int i = 0; i < a->get_track_count(); i++) {
+				if (_is_sampled_track(a, i) != p_sampled_tracks) {
+					continue;
+				}
+
 				NodePath path = a->track_get_path(i);
 
 				ERR_CONTINUE(!track_cache.has(path));
@@ -919,12 +977,21 @@ void AnimationTree::_process_graph(real_t p_delta) {
 
 				ERR_CONTINUE(blend_idx < 0 || blend_idx >= state.track_count);
 
-				real_t blend = (*as.track_blends)[blend_idx] * weight;
+				real_t blend = ba.track_blends[blend_idx] * weight;
 
 				if (blend < CMP_EPSILON) {
 					continue; //nothing to blend
 				}
 
+#ifndef _3D_DISABLED
+				if (ttype == Animation::TYPE_POSITION_3D || ttype == Animation::TYPE_ROTATION_3D || ttype == Animation::TYPE_SCALE_3D) {
+					const TrackCacheTransform *t = static_cast<const TrackCacheTransform *>(track);
+					if (lod.is_bone_skipped(t->skeleton, t->bone_idx)) {
+						continue;
+					}
+				}
+#endif // _3D_DISABLED
+
 				switch (ttype) {
 					case Animation::TYPE_POSITION_3D: {
 #ifndef _3D_DISABLED
@@ -1391,6 +1458,11 @@ void AnimationTree::_process_graph(real_t p_delta) {
 			}
 		}
 	}
+}
+
+void AnimationTree::_process_graph_end() {
+	// Side effect tracks go first, then the values are set.
+	_blend_tracks(false);
 
 	{
 		// finally, set the tracks
@@ -1413,27 +1485,20 @@ void AnimationTree::_process_graph(real_t p_delta) {
 
 						root_motion_transform = xform;
 
-					} else if (t->skeleton && t->bone_idx >= 0) {
-						if (t->loc_used) {
-							t->skeleton->set_bone_pose_position(t->bone_idx, t->loc);
-						}
-						if (t->rot_used) {
-							t->skeleton->set_bone_pose_rotation(t->bone_idx, t->rot);
-						}
-						if (t->scale_used) {
-							t->skeleton->set_bone_pose_scale(t->bone_idx, t->scale);
-						}
-
-					} else if (!t->skeleton) {
-						if (t->loc_used) {
-							t->node_3d->set_position(t->loc);
-						}
-						if (t->rot_used) {
-							t->node_3d->set_rotation(t->rot.get_euler());
-						}
-						if (t->scale_used) {
-							t->node_3d->set_scale(t->scale);
+					} else if (lod_interpolation && lod.get_interval() > 1) {
+						// Move from the pose shown now to the new one until the next update.
+						if (t->lod_shown) {
+							t->lod_from_loc = t->lod_shown_loc;
+							t->lod_from_rot = t->lod_shown_rot;
+							t->lod_from_scale = t->lod_shown_scale;
+						} else {
+							t->lod_from_loc = t->loc;
+							t->lod_from_rot = t->rot;
+							t->lod_from_scale = t->scale;
 						}
+						_set_transform_cache(t, 1.0 / lod.get_interval());
+					} else {
+						_set_transform_cache(t, 1.0);
 					}
 #endif // _3D_DISABLED
 				} break;
@@ -1463,6 +1528,128 @@ void AnimationTree::_process_graph(real_t p_delta) {
 			}
 		}
 	}
+
+	blended_animations.clear();
+}
+
+#ifndef _3D_DISABLED
+void AnimationTree::_set_transform_cache(TrackCacheTransform *p_track, real_t p_lod_c) {
+	Vector3 loc = p_track->loc;
+	Quaternion rot = p_track->rot;
+	Vector3 scale = p_track->scale;
+	if (p_lod_c < 1.0) {
+		loc = p_track->lod_from_loc.lerp(loc, p_lod_c);
+		rot = p_track->lod_from_rot.slerp(rot, p_lod_c);
+		scale = p_track->lod_from_scale.lerp(scale, p_lod_c);
+	}
+	p_track->lod_shown = true;
+	p_track->lod_shown_loc = loc;
+	p_track->lod_shown_rot = rot;
+	p_track->lod_shown_scale = scale;
+
+	if (p_track->skeleton && p_track->bone_idx >= 0) {
+		if (p_track->loc_used) {
+			p_track->skeleton->set_bone_pose_position(p_track->bone_idx, loc);
+		}
+		if (p_track->rot_used) {
+			p_track->skeleton->set_bone_pose_rotation(p_track->bone_idx, rot);
+		}
+		if (p_track->scale_used) {
+			p_track->skeleton->set_bone_pose_scale(p_track->bone_idx, scale);
+		}
+
+	} else if (!p_track->skeleton) {
+		if (p_track->loc_used) {
+			p_track->node_3d->set_position(loc);
+		}
+		if (p_track->rot_used) {
+			p_track->node_3d->set_rotation(rot.get_euler());
+		}
+		if (p_track->scale_used) {
+			p_track->node_3d->set_scale(scale);
+		}
+	}
+}
+#endif // _3D_DISABLED
+
+void AnimationTree::_interpolate_lod_poses() {
+#ifndef _3D_DISABLED
+	if (!lod_interpolation || !cache_valid || lod.get_interval() <= 1) {
+		return;
+	}
+
+	const real_t c = MIN(real_t(lod.get_frame() + 1) / lod.get_interval(), 1.0);
+
+	const NodePath *K = nullptr;
+	while ((K = track_cache.next(K))) {
+		TrackCache *track = track_cache[*K];
+		if (track->type != Animation::TYPE_POSITION_3D || track->process_pass != process_pass || track->root_motion) {
+			continue; // Only the transforms set by the last update move.
+		}
+		_set_transform_cache(static_cast<TrackCacheTransform *>(track), c);
+	}
+#endif // _3D_DISABLED
+}
+
+void AnimationTree::_process_graph(real_t p_delta) {
+	if (_process_graph_begin(p_delta)) {
+		_blend_tracks(true);
+		_process_graph_end();
+	}
+}
+
+void AnimationTree::_blend_pending_tree(void *p_userdata, uint32_t p_index) {
+	AnimationTree *tree = static_cast<AnimationTree **>(p_userdata)[p_index];
+	if (tree) {
+		tree->_blend_tracks(true);
+	}
+}
+
+void AnimationTree::_queue_process(real_t p_delta) {
+	double delta = p_delta;
+	if (!lod.update(this, p_delta, delta)) {
+		// Skipped by the LOD, there's no root motion in this frame.
+		root_motion_transform = Transform3D();
+		_interpolate_lod_poses();
+		return;
+	}
+
+	// Evaluate the graph now, nodes and scripts see the tree parameters in
+	// processing order. The tracks are blended with the other trees of this
+	// pass when the pass is done.
+	if (_process_graph_begin(delta)) {
+		pending_trees.push_back(this);
+	}
+}
+
+void AnimationTree::_cancel_pending_process() {
+	for (uint32_t i = 0; i < pending_trees.size(); i++) {
+		if (pending_trees[i] == this) {
+			pending_trees[i] = nullptr;
+		}
+	}
+}
+
+void AnimationTree::flush_pending_processes() {
+	if (pending_trees.is_empty()) {
+		return;
+	}
+
+	if (pending_trees.size() > 1) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&AnimationTree::_blend_pending_tree, pending_trees.ptr(), pending_trees.size());
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	} else {
+		_blend_pending_tree(pending_trees.ptr(), 0);
+	}
+
+	// Setting the values calls into other nodes, one tree at a time. Trees
+	// removed meanwhile leave a null behind.
+	for (uint32_t i = 0; i < pending_trees.size(); i++) {
+		if (pending_trees[i]) {
+			pending_trees[i]->_process_graph_end();
+		}
+	}
+	pending_trees.clear();
 }
 
 void AnimationTree::advance(real_t p_time) {
@@ -1471,11 +1658,11 @@ void AnimationTree::advance(real_t p_time) {
 
 void AnimationTree::_notification(int p_what) {
 	if (active && p_what == NOTIFICATION_INTERNAL_PHYSICS_PROCESS && process_callback == ANIMATION_PROCESS_PHYSICS) {
-		_process_graph(get_physics_process_delta_time());
+		_queue_process(get_physics_process_delta_time());
 	}
 
 	if (active && p_what == NOTIFICATION_INTERNAL_PROCESS && process_callback == ANIMATION_PROCESS_IDLE) {
-		_process_graph(get_process_delta_time());
+		_queue_process(get_process_delta_time());
 	}
 
 	if (p_what == NOTIFICATION_EXIT_TREE) {
@@ -1551,6 +1738,56 @@ Transform3D AnimationTree::get_root_motion_transform() const {
 	return root_motion_transform;
 }
 
+void AnimationTree::set_lod_visibility_notifier(const NodePath &p_path) {
+	lod.visibility_notifier = p_path;
+}
+
+NodePath AnimationTree::get_lod_visibility_notifier() const {
+	return lod.visibility_notifier;
+}
+
+void AnimationTree::set_lod_distance(real_t p_distance) {
+	lod.distance = MAX(p_distance, 0.0);
+}
+
+real_t AnimationTree::get_lod_distance() const {
+	return lod.distance;
+}
+
+void AnimationTree::set_lod_far_update_interval(int p_frames) {
+	ERR_FAIL_COND(p_frames < 1);
+	lod.far_update_interval = p_frames;
+}
+
+int AnimationTree::get_lod_far_update_interval() const {
+	return lod.far_update_interval;
+}
+
+void AnimationTree::set_lod_offscreen_update_interval(int p_frames) {
+	ERR_FAIL_COND(p_frames < 0);
+	lod.offscreen_update_interval = p_frames;
+}
+
+int AnimationTree::get_lod_offscreen_update_interval() const {
+	return lod.offscreen_update_interval;
+}
+
+void AnimationTree::set_lod_interpolation_enabled(bool p_enabled) {
+	lod_interpolation = p_enabled;
+}
+
+bool AnimationTree::is_lod_interpolation_enabled() const {
+	return lod_interpolation;
+}
+
+void AnimationTree::set_lod_min_blend_weight(real_t p_weight) {
+	lod_min_blend_weight = CLAMP(p_weight, 0.0, 1.0);
+}
+
+real_t AnimationTree::get_lod_min_blend_weight() const {
+	return lod_min_blend_weight;
+}
+
 void AnimationTree::_tree_changed() {
 	if (properties_dirty) {
 		return;
@@ -1705,6 +1942,24 @@ void AnimationTree::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_root_motion_transform"), &AnimationTree::get_root_motion_transform);
 
+	ClassDB::bind_method(D_METHOD("set_lod_visibility_notifier", "path"), &AnimationTree::set_lod_visibility_notifier);
+	ClassDB::bind_method(D_METHOD("get_lod_visibility_notifier"), &AnimationTree::get_lod_visibility_notifier);
+
+	ClassDB::bind_method(D_METHOD("set_lod_distance", "distance"), &AnimationTree::set_lod_distance);
+	ClassDB::bind_method(D_METHOD("get_lod_distance"), &AnimationTree::get_lod_distance);
+
+	ClassDB::bind_method(D_METHOD("set_lod_far_update_interval", "frames"), &AnimationTree::set_lod_far_update_interval);
+	ClassDB::bind_method(D_METHOD("get_lod_far_update_interval"), &AnimationTree::get_lod_far_update_interval);
+
+	ClassDB::bind_method(D_METHOD("set_lod_offscreen_update_interval", "frames"), &AnimationTree::set_lod_offscreen_update_interval);
+	ClassDB::bind_method(D_METHOD("get_lod_offscreen_update_interval"), &AnimationTree::get_lod_offscreen_update_interval);
+
+	ClassDB::bind_method(D_METHOD("set_lod_interpolation_enabled", "enabled"), &AnimationTree::set_lod_interpolation_enabled);
+	ClassDB::bind_method(D_METHOD("is_lod_interpolation_enabled"), &AnimationTree::is_lod_interpolation_enabled);
+
+	ClassDB::bind_method(D_METHOD("set_lod_min_blend_weight", "weight"), &AnimationTree::set_lod_min_blend_weight);
+	ClassDB::bind_method(D_METHOD("get_lod_min_blend_weight"), &AnimationTree::get_lod_min_blend_weight);
+
 	ClassDB::bind_method(D_METHOD("_update_properties"), &AnimationTree::_update_properties);
 
 	ClassDB::bind_method(D_METHOD("rename_parameter", "old_name", "new_name"), &AnimationTree::rename_parameter);
@@ -1717,14 +1972,24 @@ void AnimationTree::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_callback", PROPERTY_HINT_ENUM, "Physics,Idle,Manual"), "set_process_callback", "get_process_callback");
 	ADD_GROUP("Root Motion", "root_motion_");
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_motion_track"), "set_root_motion_track", "get_root_motion_track");
+	ADD_GROUP("LOD", "lod_");
+	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "lod_visibility_notifier", PROPERTY_HINT_NODE_PATH_VALID_TYPES, "VisibleOnScreenNotifier3D"), "set_lod_visibility_notifier", "get_lod_visibility_notifier");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lod_distance", PROPERTY_HINT_RANGE, "0,1000,0.1,or_greater"), "set_lod_distance", "get_lod_distance");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_far_update_interval", PROPERTY_HINT_RANGE, "1,60,1,or_greater"), "set_lod_far_update_interval", "get_lod_far_update_interval");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_offscreen_update_interval", PROPERTY_HINT_RANGE, "0,60,1,or_greater"), "set_lod_offscreen_update_interval", "get_lod_offscreen_update_interval");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "lod_interpolation"), "set_lod_interpolation_enabled", "is_lod_interpolation_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lod_min_blend_weight", PROPERTY_HINT_RANGE, "0,1,0.001"), "set_lod_min_blend_weight", "get_lod_min_blend_weight");
 
 	BIND_ENUM_CONSTANT(ANIMATION_PROCESS_PHYSICS);
 	BIND_ENUM_CONSTANT(ANIMATION_PROCESS_IDLE);
 	BIND_ENUM_CONSTANT(ANIMATION_PROCESS_MANUAL);
 }
 
+LocalVector<AnimationTree *> AnimationTree::pending_trees;
+
 AnimationTree::AnimationTree() {
 }
 
 AnimationTree::~AnimationTree() {
+	_cancel_pending_process();
 }
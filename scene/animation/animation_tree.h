@@ -31,7 +31,9 @@
 #ifndef ANIMATION_GRAPH_PLAYER_H
 #define ANIMATION_GRAPH_PLAYER_H
 
+#include "animation_lod.h"
 #include "animation_player.h"
+#include "core/templates/local_vector.h"
 #include "scene/3d/node_3d.h"
 #include "scene/3d/skeleton_3d.h"
 #include "scene/resources/animation.h"
@@ -205,6 +207,15 @@ private:
 		real_t rot_blend_accum = 0.0;
 		Vector3 scale;
 
+		// Pose shown between LOD updates, moving from the previous target.
+		bool lod_shown = false;
+		Vector3 lod_from_loc;
+		Quaternion lod_from_rot;
+		Vector3 lod_from_scale = Vector3(1, 1, 1);
+		Vector3 lod_shown_loc;
+		Quaternion lod_shown_rot;
+		Vector3 lod_shown_scale = Vector3(1, 1, 1);
+
 		TrackCacheTransform() {
 			type = Animation::TYPE_POSITION_3D;
 		}
@@ -269,8 +280,43 @@ private:
 
 	void _clear_caches();
 	bool _update_caches(AnimationPlayer *player);
+
+	// The animations blended in this pass, with their track blends.
+	struct BlendedAnimation {
+		Ref<Animation> animation;
+		double time = 0.0;
+		double delta = 0.0;
+		real_t weight = 0.0;
+		bool seeked = false;
+		const real_t *track_blends = nullptr;
+	};
+
+	LocalVector<BlendedAnimation> blended_animations;
+	LocalVector<real_t> blended_track_blends;
+
+	// Processing is split in three steps: evaluating the graph, blending
+	// the sampled tracks into the caches, which doesn't touch other objects,
+	// and setting the values and running the other tracks.
+	bool _process_graph_begin(real_t p_delta);
+	void _blend_tracks(bool p_sampled_tracks);
+	void _process_graph_end();
 	void _process_graph(real_t p_delta);
 
+	// Trees waiting for the end of the process pass to blend their tracks.
+	static LocalVector<AnimationTree *> pending_trees;
+	static void _blend_pending_tree(void *p_userdata, uint32_t p_index);
+	void _queue_process(real_t p_delta);
+	void _cancel_pending_process();
+
+	AnimationLOD lod;
+	bool lod_interpolation = false;
+	real_t lod_min_blend_weight = 0.0;
+
+#ifndef _3D_DISABLED
+	void _set_transform_cache(TrackCacheTransform *p_track, real_t p_lod_c);
+#endif // _3D_DISABLED
+	void _interpolate_lod_poses();
+
 	uint64_t setup_pass = 1;
 	uint64_t process_pass = 1;
 
@@ -330,12 +376,34 @@ public:
 
 	Transform3D get_root_motion_transform() const;
 
+	void set_lod_visibility_notifier(const NodePath &p_path);
+	NodePath get_lod_visibility_notifier() const;
+
+	void set_lod_distance(real_t p_distance);
+	real_t get_lod_distance() const;
+
+	void set_lod_far_update_interval(int p_frames);
+	int get_lod_far_update_interval() const;
+
+	void set_lod_offscreen_update_interval(int p_frames);
+	int get_lod_offscreen_update_interval() const;
+
+	void set_lod_interpolation_enabled(bool p_enabled);
+	bool is_lod_interpolation_enabled() const;
+
+	void set_lod_min_blend_weight(real_t p_weight);
+	real_t get_lod_min_blend_weight() const;
+
 	real_t get_connection_activity(const StringName &p_path, int p_connection) const;
 	void advance(real_t p_time);
 
 	void rename_parameter(const String &p_base, const String &p_new_base);
 
 	uint64_t get_last_process_pass() const;
+
+	// Blends the tracks of the trees processed in this pass on the worker threads, then sets their values.
+	static void flush_pending_processes();
+
 	AnimationTree();
 	~AnimationTree();
 };
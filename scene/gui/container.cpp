@@ -29,7 +29,7 @@
 /*************************************************************************/
 
 #include "container.h"
-#include "core/object/message_queue.h"
+#include "scene/main/viewport.h"
 #include "scene/scene_string_names.h"
 
 void Container::_child_minsize_changed() {
@@ -139,7 +139,7 @@ void Container::queue_sort() {
 		return;
 	}
 
-	MessageQueue::get_singleton()->push_callable(callable_mp(this, &Container::_sort_children));
+	get_viewport()->_gui_queue_sort(this);
 	pending_sort = true;
 }
 
@@ -149,6 +149,12 @@ void Container::_notification(int p_what) {
 			pending_sort = false;
 			queue_sort();
 		} break;
+		case NOTIFICATION_EXIT_TREE: {
+			if (pending_sort) {
+				get_viewport()->_gui_unqueue_sort(this);
+				pending_sort = false;
+			}
+		} break;
 		case NOTIFICATION_RESIZED: {
 			queue_sort();
 		} break;
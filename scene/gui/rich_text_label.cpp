@@ -375,6 +375,7 @@ void RichTextLabel::_shape_line(ItemFrame *p_frame, int p_line, const Ref<Font>
 	Line &l = p_frame->lines.write[p_line];
 
 	// Clear cache.
+	l.resize_pending = false;
 	l.text_buf->clear();
 	l.text_buf->set_flags(TextServer::BREAK_MANDATORY | TextServer::BREAK_WORD_BOUND | TextServer::JUSTIFICATION_KASHIDA | TextServer::JUSTIFICATION_WORD_BOUND | TextServer::JUSTIFICATION_TRIM_EDGE_SPACES);
 	l.char_offset = *r_char_offset;
@@ -1418,6 +1419,11 @@ void RichTextLabel::_notification(int p_what) {
 			update();
 
 		} break;
+		case NOTIFICATION_EXIT_TREE: {
+			if (get_tree()->is_connected("process_frame", callable_mp(this, &RichTextLabel::_process_pending_resizes))) {
+				get_tree()->disconnect("process_frame", callable_mp(this, &RichTextLabel::_process_pending_resizes));
+			}
+		} break;
 		case NOTIFICATION_THEME_CHANGED:
 		case NOTIFICATION_ENTER_TREE: {
 			if (text != "") {
@@ -1452,15 +1458,7 @@ void RichTextLabel::_notification(int p_what) {
 			float vofs = vscroll->get_value();
 
 			// Search for the first line.
-			int from_line = 0;
-
-			//TODO, change to binary search ?
-			while (from_line < main->lines.size()) {
-				if (main->lines[from_line].offset.y + main->lines[from_line].text_buf->get_size().y >= vofs) {
-					break;
-				}
-				from_line++;
-			}
+			int from_line = _find_first_line(main, vofs);
 
 			if (from_line >= main->lines.size()) {
 				break; //nothing to draw
@@ -2146,49 +2144,44 @@ bool RichTextLabel::_find_layout_subitem(Item *from, Item *to) {
 void RichTextLabel::_validate_line_caches(ItemFrame *p_frame) {
 	if (p_frame->first_invalid_line == p_frame->lines.size()) {
 		if (p_frame->first_resized_line == p_frame->lines.size()) {
+			if (p_frame == main && _resize_visible_lines()) {
+				_update_scroll_range(p_frame);
+			}
 			return;
 		}
 
 		// Resize lines without reshaping.
-		Size2 size = get_size();
-		if (fixed_width != -1) {
-			size.width = fixed_width;
-		}
 		Rect2 text_rect = _get_text_rect();
 
 		Ref<Font> base_font = get_theme_font(SNAME("normal_font"));
 		int base_font_size = get_theme_font_size(SNAME("normal_font_size"));
 
+		// Only the visible lines are resized right away, others keep their previous layout until processed in the background.
+		bool deferred = p_frame == main && is_inside_tree() && !fit_content_height;
 		for (int i = p_frame->first_resized_line; i < p_frame->lines.size(); i++) {
-			_resize_line(p_frame, i, base_font, base_font_size, text_rect.get_size().width - scroll_w);
+			if (deferred) {
+				p_frame->lines.write[i].resize_pending = true;
+			} else {
+				_resize_line(p_frame, i, base_font, base_font_size, text_rect.get_size().width - scroll_w);
+				p_frame->lines.write[i].resize_pending = false;
+			}
 		}
-
-		int total_height = 0;
-		if (p_frame->lines.size()) {
-			total_height = p_frame->lines[p_frame->lines.size() - 1].offset.y + p_frame->lines[p_frame->lines.size() - 1].text_buf->get_size().y;
+		if (deferred) {
+			_update_line_offsets(p_frame, p_frame->first_resized_line);
+			pending_resize_line = MIN(pending_resize_line, p_frame->first_resized_line);
+			_resize_visible_lines();
+			if (!get_tree()->is_connected("process_frame", callable_mp(this, &RichTextLabel::_process_pending_resizes))) {
+				get_tree()->connect("process_frame", callable_mp(this, &RichTextLabel::_process_pending_resizes));
+			}
 		}
 
 		p_frame->first_resized_line = p_frame->lines.size();
 
-		updating_scroll = true;
-		vscroll->set_max(total_height);
-		vscroll->set_page(text_rect.size.height);
-		if (scroll_follow && scroll_following) {
-			vscroll->set_value(total_height - size.height);
-		}
-		updating_scroll = false;
-
-		if (fit_content_height) {
-			minimum_size_changed();
-		}
+		_update_scroll_range(p_frame);
 		return;
 	}
 
 	// Shape invalid lines.
-	Size2 size = get_size();
-	if (fixed_width != -1) {
-		size.width = fixed_width;
-	}
 	Rect2 text_rect = _get_text_rect();
 
 	Ref<Font> base_font = get_theme_font(SNAME("normal_font"));
@@ -2199,14 +2192,27 @@ void RichTextLabel::_validate_line_caches(ItemFrame *p_frame) {
 		_shape_line(p_frame, i, base_font, base_font_size, text_rect.get_size().width - scroll_w, &total_chars);
 	}
 
+	p_frame->first_invalid_line = p_frame->lines.size();
+	p_frame->first_resized_line = p_frame->lines.size();
+
+	if (p_frame == main) {
+		_resize_visible_lines();
+	}
+	_update_scroll_range(p_frame);
+}
+
+void RichTextLabel::_update_scroll_range(ItemFrame *p_frame) {
+	Size2 size = get_size();
+	if (fixed_width != -1) {
+		size.width = fixed_width;
+	}
+	Rect2 text_rect = _get_text_rect();
+
 	int total_height = 0;
 	if (p_frame->lines.size()) {
 		total_height = p_frame->lines[p_frame->lines.size() - 1].offset.y + p_frame->lines[p_frame->lines.size() - 1].text_buf->get_size().y;
 	}
 
-	p_frame->first_invalid_line = p_frame->lines.size();
-	p_frame->first_resized_line = p_frame->lines.size();
-
 	updating_scroll = true;
 	vscroll->set_max(total_height);
 	vscroll->set_page(text_rect.size.height);
@@ -2220,6 +2226,115 @@ void RichTextLabel::_validate_line_caches(ItemFrame *p_frame) {
 	}
 }
 
+void RichTextLabel::_update_line_offsets(ItemFrame *p_frame, int p_from) {
+	int line_separation = get_theme_constant(SNAME("line_separation"));
+	for (int i = MAX(p_from, 0); i < p_frame->lines.size(); i++) {
+		if (i > 0) {
+			p_frame->lines.write[i].offset.y = p_frame->lines[i - 1].offset.y + p_frame->lines[i - 1].text_buf->get_size().y + line_separation;
+		} else {
+			p_frame->lines.write[i].offset.y = 0;
+		}
+	}
+}
+
+int RichTextLabel::_find_first_line(const ItemFrame *p_frame, float p_ofs) const {
+	// First line ending at or below the offset, main frame lines are sorted by offset.
+	int from = 0;
+	int to = p_frame->lines.size();
+	while (from < to) {
+		int mid = (from + to) / 2;
+		const Line &l = p_frame->lines[mid];
+		if (l.offset.y + l.text_buf->get_size().y >= p_ofs) {
+			to = mid;
+		} else {
+			from = mid + 1;
+		}
+	}
+	return from;
+}
+
+bool RichTextLabel::_resize_visible_lines() {
+	if (pending_resize_line >= main->lines.size()) {
+		return false;
+	}
+
+	Rect2 text_rect = _get_text_rect();
+	float margin = text_rect.size.height; // Resize one extra page above and below.
+	float vofs = vscroll->get_value();
+	if (scroll_follow && scroll_following && main->lines.size()) {
+		vofs = main->lines[main->lines.size() - 1].offset.y + main->lines[main->lines.size() - 1].text_buf->get_size().y - get_size().height;
+	}
+	float to_ofs = vofs + get_size().height + margin;
+
+	Ref<Font> base_font = get_theme_font(SNAME("normal_font"));
+	int base_font_size = get_theme_font_size(SNAME("normal_font_size"));
+	int line_separation = get_theme_constant(SNAME("line_separation"));
+
+	bool resized = false;
+	int i = MAX(_find_first_line(main, vofs - margin), pending_resize_line);
+	for (; i < main->lines.size(); i++) {
+		if (resized) {
+			main->lines.write[i].offset.y = main->lines[i - 1].offset.y + main->lines[i - 1].text_buf->get_size().y + line_separation;
+		}
+		if (main->lines[i].offset.y >= to_ofs) {
+			break;
+		}
+		if (main->lines[i].resize_pending) {
+			_resize_line(main, i, base_font, base_font_size, text_rect.get_size().width - scroll_w);
+			main->lines.write[i].resize_pending = false;
+			resized = true;
+		}
+	}
+	if (resized) {
+		_update_line_offsets(main, i);
+	}
+	return resized;
+}
+
+void RichTextLabel::_process_pending_resizes() {
+	if (main->first_invalid_line < main->lines.size() || main->first_resized_line < main->lines.size()) {
+		return; // Full update pending, will be rescheduled.
+	}
+
+	Rect2 text_rect = _get_text_rect();
+	Ref<Font> base_font = get_theme_font(SNAME("normal_font"));
+	int base_font_size = get_theme_font_size(SNAME("normal_font_size"));
+
+	// Keep the first visible line in place while the lines above it change height.
+	float vofs = vscroll->get_value();
+	int anchor = MIN(_find_first_line(main, vofs), main->lines.size() - 1);
+	float anchor_ofs = main->lines[anchor].offset.y;
+
+	const uint64_t budget_usec = 2000;
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	int from = -1;
+	while (pending_resize_line < main->lines.size() && OS::get_singleton()->get_ticks_usec() - start < budget_usec) {
+		if (main->lines[pending_resize_line].resize_pending) {
+			_resize_line(main, pending_resize_line, base_font, base_font_size, text_rect.get_size().width - scroll_w);
+			main->lines.write[pending_resize_line].resize_pending = false;
+			if (from == -1) {
+				from = pending_resize_line;
+			}
+		}
+		pending_resize_line++;
+	}
+
+	if (from != -1) {
+		_update_line_offsets(main, from);
+		_update_scroll_range(main);
+		if (!(scroll_follow && scroll_following) && anchor > from) {
+			updating_scroll = true;
+			vscroll->set_value(vofs + main->lines[anchor].offset.y - anchor_ofs);
+			updating_scroll = false;
+		}
+		update();
+	}
+
+	if (pending_resize_line >= main->lines.size()) {
+		get_tree()->disconnect("process_frame", callable_mp(this, &RichTextLabel::_process_pending_resizes));
+	}
+}
+
 void RichTextLabel::_invalidate_current_line(ItemFrame *p_frame) {
 	if (p_frame->lines.size() - 1 <= p_frame->first_invalid_line) {
 		p_frame->first_invalid_line = p_frame->lines.size() - 1;
@@ -101,6 +101,8 @@ private:
 		int char_offset = 0;
 		int char_count = 0;
 
+		bool resize_pending = false; // Still laid out for the previous width, height is used as an estimate.
+
 		Line() { text_buf.instantiate(); }
 	};
 
@@ -367,8 +369,16 @@ private:
 
 	Array custom_effects;
 
+	// Off-screen lines of the main frame are resized in the background after a width change.
+	int pending_resize_line = 0; // No line before this one is pending resize.
+
 	void _invalidate_current_line(ItemFrame *p_frame);
 	void _validate_line_caches(ItemFrame *p_frame);
+	void _update_scroll_range(ItemFrame *p_frame);
+	void _update_line_offsets(ItemFrame *p_frame, int p_from);
+	int _find_first_line(const ItemFrame *p_frame, float p_ofs) const;
+	bool _resize_visible_lines();
+	void _process_pending_resizes();
 
 	void _add_item(Item *p_item, bool p_enter = false, bool p_ensure_newline = false);
 	void _remove_item(Item *p_item, const int p_line, const int p_subitem_line);
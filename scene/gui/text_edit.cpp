@@ -114,9 +114,9 @@ void TextEdit::Text::set_draw_control_chars(bool p_enabled) {
 int TextEdit::Text::get_line_width(int p_line, int p_wrap_index) const {
 	ERR_FAIL_INDEX_V(p_line, text.size(), 0);
 	if (p_wrap_index != -1) {
-		return text[p_line].data_buf->get_line_width(p_wrap_index);
+		return _get_shaped_line(p_line)->get_line_width(p_wrap_index);
 	}
-	return text[p_line].data_buf->get_size().x;
+	return _get_shaped_line(p_line)->get_size().x;
 }
 
 int TextEdit::Text::get_line_height() const {
@@ -130,21 +130,42 @@ void TextEdit::Text::set_width(float p_width) {
 int TextEdit::Text::get_line_wrap_amount(int p_line) const {
 	ERR_FAIL_INDEX_V(p_line, text.size(), 0);
 
-	return text[p_line].data_buf->get_line_count() - 1;
+	if (text[p_line].wrap_amount < 0) {
+		if (width <= 0) {
+			// Nothing to wrap, no need to shape the line for this.
+			text.write[p_line].wrap_amount = 0;
+		} else {
+			text.write[p_line].wrap_amount = _get_shaped_line(p_line)->get_line_count() - 1;
+		}
+	}
+	return text[p_line].wrap_amount;
 }
 
 Vector<Vector2i> TextEdit::Text::get_line_wrap_ranges(int p_line) const {
 	Vector<Vector2i> ret;
 	ERR_FAIL_INDEX_V(p_line, text.size(), ret);
 
-	for (int i = 0; i < text[p_line].data_buf->get_line_count(); i++) {
-		ret.push_back(text[p_line].data_buf->get_line_range(i));
+	const Ref<TextParagraph> &data_buf = _get_shaped_line(p_line);
+	for (int i = 0; i < data_buf->get_line_count(); i++) {
+		ret.push_back(data_buf->get_line_range(i));
 	}
 	return ret;
 }
 
 const Ref<TextParagraph> TextEdit::Text::get_line_data(int p_line) const {
 	ERR_FAIL_INDEX_V(p_line, text.size(), Ref<TextParagraph>());
+	return _get_shaped_line(p_line);
+}
+
+const Ref<TextParagraph> &TextEdit::Text::_get_shaped_line(int p_line) const {
+	Line &line = text.write[p_line];
+	line.last_used = ++use_tick;
+	if (line.data_buf.is_null()) {
+		_shape_line(p_line, line.data, line.bidi_override);
+		if (shaped_lines > MAX_SHAPED_LINES) {
+			_release_unused_lines();
+		}
+	}
 	return text[p_line].data_buf;
 }
 
@@ -152,7 +173,7 @@ _FORCE_INLINE_ const String &TextEdit::Text::operator[](int p_line) const {
 	return text[p_line].data;
 }
 
-void TextEdit::Text::_calculate_line_height() {
+void TextEdit::Text::_calculate_line_height() const {
 	int height = 0;
 	for (int i = 0; i < text.size(); i++) {
 		// Found another line with the same height...nothing to update.
@@ -165,7 +186,7 @@ void TextEdit::Text::_calculate_line_height() {
 	line_height = height;
 }
 
-void TextEdit::Text::_calculate_max_line_width() {
+void TextEdit::Text::_calculate_max_line_width() const {
 	int width = 0;
 	for (int i = 0; i < text.size(); i++) {
 		if (is_hidden(i)) {
@@ -182,76 +203,143 @@ void TextEdit::Text::_calculate_max_line_width() {
 	max_width = width;
 }
 
-void TextEdit::Text::invalidate_cache(int p_line, int p_column, const String &p_ime_text, const Array &p_bidi_override) {
-	ERR_FAIL_INDEX(p_line, text.size());
+void TextEdit::Text::_update_line_size(int p_line, int p_height, int p_width) const {
+	// Update height.
+	const int old_height = text[p_line].height;
+	text.write[p_line].height = p_height;
+
+	// If this line has shrunk, this may no longer the the tallest line.
+	if (old_height == line_height && p_height < line_height) {
+		_calculate_line_height();
+	} else {
+		line_height = MAX(p_height, line_height);
+	}
+
+	// Update width.
+	const int old_width = text[p_line].width;
+	text.write[p_line].width = p_width;
+
+	// If this line has shrunk, this may no longer the the longest line.
+	if (old_width == max_width && p_width < max_width) {
+		_calculate_max_line_width();
+	} else if (!is_hidden(p_line)) {
+		max_width = MAX(p_width, max_width);
+	}
+}
+
+int TextEdit::Text::_estimate_line_width(const String &p_text) const {
+	int chars = 0;
+	const char32_t *str = p_text.get_data();
+	for (int i = 0; i < p_text.length(); i++) {
+		if (str[i] == '\t' && tab_size > 0) {
+			chars += tab_size - (chars % tab_size);
+		} else {
+			chars++;
+		}
+	}
+	return chars * font->get_char_size(' ', 0, font_size).width;
+}
+
+void TextEdit::Text::_shape_line(int p_line, const String &p_text, const Array &p_bidi_override) const {
+	Line &line = text.write[p_line];
+	if (line.data_buf.is_null()) {
+		line.data_buf.instantiate();
+		shaped_lines++;
+	}
 
 	if (font.is_null() || font_size <= 0) {
 		return; // Not in tree?
 	}
 
-	text.write[p_line].data_buf->clear();
-	text.write[p_line].data_buf->set_width(width);
-	text.write[p_line].data_buf->set_direction((TextServer::Direction)direction);
-	text.write[p_line].data_buf->set_preserve_control(draw_control_chars);
-	if (p_ime_text.length() > 0) {
-		text.write[p_line].data_buf->add_string(p_ime_text, font, font_size, opentype_features, language);
-		if (!p_bidi_override.is_empty()) {
-			TS->shaped_text_set_bidi_override(text.write[p_line].data_buf->get_rid(), p_bidi_override);
-		}
-	} else {
-		text.write[p_line].data_buf->add_string(text[p_line].data, font, font_size, opentype_features, language);
-		if (!text[p_line].bidi_override.is_empty()) {
-			TS->shaped_text_set_bidi_override(text.write[p_line].data_buf->get_rid(), text[p_line].bidi_override);
-		}
+	line.data_buf->clear();
+	line.data_buf->set_width(width);
+	line.data_buf->set_direction((TextServer::Direction)direction);
+	line.data_buf->set_preserve_control(draw_control_chars);
+	line.data_buf->add_string(p_text, font, font_size, opentype_features, language);
+	if (!p_bidi_override.is_empty()) {
+		TS->shaped_text_set_bidi_override(line.data_buf->get_rid(), p_bidi_override);
 	}
 
 	// Apply tab align.
 	if (tab_size > 0) {
 		Vector<float> tabs;
 		tabs.push_back(font->get_char_size(' ', 0, font_size).width * tab_size);
-		text.write[p_line].data_buf->tab_align(tabs);
+		line.data_buf->tab_align(tabs);
 	}
 
-	// Update height.
-	const int old_height = text.write[p_line].height;
-	const int wrap_amount = get_line_wrap_amount(p_line);
+	line.wrap_amount = line.data_buf->get_line_count() - 1;
 	int height = font->get_height(font_size);
-	for (int i = 0; i <= wrap_amount; i++) {
-		height = MAX(height, text[p_line].data_buf->get_line_size(i).y);
+	for (int i = 0; i <= line.wrap_amount; i++) {
+		height = MAX(height, line.data_buf->get_line_size(i).y);
 	}
-	text.write[p_line].height = height;
+	_update_line_size(p_line, height, line.data_buf->get_size().x);
+}
 
-	// If this line has shrunk, this may no longer the the tallest line.
-	if (old_height == line_height && height < line_height) {
-		_calculate_line_height();
-	} else {
-		line_height = MAX(height, line_height);
+void TextEdit::Text::_release_line(int p_line) const {
+	if (text[p_line].data_buf.is_valid()) {
+		text.write[p_line].data_buf.unref();
+		shaped_lines--;
 	}
+}
 
-	// Update width.
-	const int old_width = text.write[p_line].width;
-	int width = get_line_width(p_line);
-	text.write[p_line].width = width;
+void TextEdit::Text::_release_unused_lines() const {
+	// Find the median use tick of the shaped lines and release everything used before it.
+	Vector<uint64_t> ticks;
+	ticks.resize(shaped_lines);
+	int count = 0;
+	for (int i = 0; i < text.size(); i++) {
+		if (text[i].data_buf.is_valid()) {
+			ticks.write[count++] = text[i].last_used;
+		}
+	}
+	ticks.sort();
+	const uint64_t threshold = ticks[count / 2];
 
-	// If this line has shrunk, this may no longer the the longest line.
-	if (old_width == max_width && width < max_width) {
-		_calculate_max_line_width();
-	} else if (!is_hidden(p_line)) {
-		max_width = MAX(width, max_width);
+	for (int i = 0; i < text.size(); i++) {
+		if (text[i].last_used < threshold) {
+			_release_line(i);
+		}
 	}
 }
 
+void TextEdit::Text::invalidate_cache(int p_line, int p_column, const String &p_ime_text, const Array &p_bidi_override) {
+	ERR_FAIL_INDEX(p_line, text.size());
+
+	if (font.is_null() || font_size <= 0) {
+		return; // Not in tree?
+	}
+
+	if (p_ime_text.length() > 0) {
+		_shape_line(p_line, p_ime_text, p_bidi_override);
+		return;
+	}
+
+	// Shaping is deferred until the line is first accessed, until then its size is estimated from a monospace layout.
+	_release_line(p_line);
+	text.write[p_line].wrap_amount = -1;
+	_update_line_size(p_line, font->get_height(font_size), _estimate_line_width(text[p_line].data));
+}
+
 void TextEdit::Text::invalidate_all_lines() {
 	for (int i = 0; i < text.size(); i++) {
-		text.write[i].data_buf->set_width(width);
+		Line &line = text.write[i];
+		line.wrap_amount = -1;
+		if (line.data_buf.is_null()) {
+			if (tab_size_dirty && font.is_valid() && font_size > 0) {
+				line.width = _estimate_line_width(line.data);
+			}
+			continue;
+		}
+
+		line.data_buf->set_width(width);
 		if (tab_size_dirty) {
 			if (tab_size > 0) {
 				Vector<float> tabs;
 				tabs.push_back(font->get_char_size(' ', 0, font_size).width * tab_size);
-				text.write[i].data_buf->tab_align(tabs);
+				line.data_buf->tab_align(tabs);
 			}
 			// Tabs have changes, force width update.
-			text.write[i].width = get_line_width(i);
+			line.width = line.data_buf->get_size().x;
 		}
 	}
 
@@ -274,6 +362,7 @@ void TextEdit::Text::invalidate_all() {
 
 void TextEdit::Text::clear() {
 	text.clear();
+	shaped_lines = 0;
 	insert(0, "", Array());
 }
 
@@ -304,6 +393,7 @@ void TextEdit::Text::remove(int p_at) {
 	int height = text[p_at].height;
 	int width = text[p_at].width;
 
+	_release_line(p_at);
 	text.remove(p_at);
 
 	// If this is the tallest line, we need to get the next tallest.
@@ -140,16 +140,19 @@ private:
 
 			String data;
 			Array bidi_override;
-			Ref<TextParagraph> data_buf;
+			Ref<TextParagraph> data_buf; // Shaped on first use, see _shape_line().
+			uint64_t last_used = 0;
+			int wrap_amount = -1; // Kept when the buffer is released, -1 when unknown.
 
 			Color background_color = Color(0, 0, 0, 0);
 			bool hidden = false;
 			int height = 0;
 			int width = 0;
+		};
 
-			Line() {
-				data_buf.instantiate();
-			}
+		enum {
+			// Shaped lines kept around, the least recently used half is released above this.
+			MAX_SHAPED_LINES = 4096,
 		};
 
 	private:
@@ -165,15 +168,24 @@ private:
 		TextServer::Direction direction = TextServer::DIRECTION_AUTO;
 		bool draw_control_chars = false;
 
-		int line_height = -1;
-		int max_width = -1;
+		mutable int line_height = -1;
+		mutable int max_width = -1;
 		int width = -1;
 
 		int tab_size = 4;
 		int gutter_count = 0;
 
-		void _calculate_line_height();
-		void _calculate_max_line_width();
+		mutable uint64_t use_tick = 0;
+		mutable int shaped_lines = 0;
+
+		void _calculate_line_height() const;
+		void _calculate_max_line_width() const;
+		void _update_line_size(int p_line, int p_height, int p_width) const;
+		int _estimate_line_width(const String &p_text) const;
+		void _shape_line(int p_line, const String &p_text, const Array &p_bidi_override) const;
+		void _release_line(int p_line) const;
+		void _release_unused_lines() const;
+		const Ref<TextParagraph> &_get_shaped_line(int p_line) const;
 
 	public:
 		void set_tab_size(int p_tab_size);
@@ -69,10 +69,12 @@ void TreeItem::Cell::draw_icon(const RID &p_where, const Point2 &p_pos, const Si
 }
 
 void TreeItem::_changed_notify(int p_cell) {
+	_invalidate_height();
 	tree->item_changed(p_cell, this);
 }
 
 void TreeItem::_changed_notify() {
+	_invalidate_height();
 	tree->item_changed(-1, this);
 }
 
@@ -89,6 +91,9 @@ void TreeItem::_change_tree(Tree *p_tree) {
 		return;
 	}
 
+	label_height_version = 0;
+	subtree_height_version = 0;
+
 	TreeItem *c = first_child;
 	while (c) {
 		c->_change_tree(p_tree);
@@ -547,6 +552,7 @@ TreeItem *TreeItem::create_child(int p_idx) {
 	}
 
 	ti->parent = this;
+	_invalidate_subtree_height();
 
 	return ti;
 }
@@ -715,6 +721,7 @@ void TreeItem::move_before(TreeItem *p_item) {
 	prev = item_prev;
 	next = p_item;
 	p_item->prev = this;
+	parent->_invalidate_subtree_height();
 
 	if (tree && old_tree == tree) {
 		tree->update();
@@ -753,6 +760,7 @@ void TreeItem::move_after(TreeItem *p_item) {
 	} else {
 		parent->children_cache.append(this);
 	}
+	parent->_invalidate_subtree_height();
 
 	if (tree && old_tree == tree) {
 		tree->update();
@@ -938,6 +946,7 @@ void TreeItem::set_custom_font(int p_column, const Ref<Font> &p_font) {
 
 	cells.write[p_column].custom_font = p_font;
 	cells.write[p_column].cached_minimum_size_dirty = true;
+	_changed_notify(p_column);
 }
 
 Ref<Font> TreeItem::get_custom_font(int p_column) const {
@@ -950,6 +959,7 @@ void TreeItem::set_custom_font_size(int p_column, int p_font_size) {
 
 	cells.write[p_column].custom_font_size = p_font_size;
 	cells.write[p_column].cached_minimum_size_dirty = true;
+	_changed_notify(p_column);
 }
 
 int TreeItem::get_custom_font_size(int p_column) const {
@@ -995,6 +1005,7 @@ void TreeItem::set_custom_as_button(int p_column, bool p_button) {
 
 	cells.write[p_column].custom_button = p_button;
 	cells.write[p_column].cached_minimum_size_dirty = true;
+	_changed_notify(p_column);
 }
 
 bool TreeItem::is_custom_set_as_button(int p_column) const {
@@ -1294,6 +1305,7 @@ void TreeItem::clear_children() {
 	}
 
 	first_child = nullptr;
+	_invalidate_subtree_height();
 };
 
 TreeItem::TreeItem(Tree *p_tree) {
@@ -1383,6 +1395,10 @@ int Tree::compute_item_height(TreeItem *p_item) const {
 		return 0;
 	}
 
+	if (p_item->label_height_version == item_height_version) {
+		return p_item->label_height;
+	}
+
 	ERR_FAIL_COND_V(cache.font.is_null(), 0);
 	int height = 0;
 
@@ -1436,10 +1452,17 @@ int Tree::compute_item_height(TreeItem *p_item) const {
 
 	height += cache.vseparation;
 
+	p_item->label_height = height;
+	p_item->label_height_version = item_height_version;
+
 	return height;
 }
 
 int Tree::get_item_height(TreeItem *p_item) const {
+	if (p_item->subtree_height_version == item_height_version) {
+		return p_item->subtree_height;
+	}
+
 	int height = compute_item_height(p_item);
 	height += cache.vseparation;
 
@@ -1454,6 +1477,9 @@ int Tree::get_item_height(TreeItem *p_item) const {
 		}
 	}
 
+	p_item->subtree_height = height;
+	p_item->subtree_height_version = item_height_version;
+
 	return height;
 }
 
@@ -1545,6 +1571,8 @@ void Tree::update_column(int p_col) {
 void Tree::update_item_cell(TreeItem *p_item, int p_col) {
 	String valtext;
 
+	p_item->_invalidate_height();
+
 	p_item->cells.write[p_col].text_buf->clear();
 	if (p_item->cells[p_col].mode == TreeItem::CELL_MODE_RANGE) {
 		if (p_item->cells[p_col].text != "") {
@@ -2032,7 +2060,12 @@ int Tree::draw_item(const Point2i &p_pos, const Point2 &p_draw_ofs, const Size2
 
 		while (c) {
 			if (htotal >= 0) {
-				int child_h = draw_item(children_pos, p_draw_ofs, p_draw_size, c);
+				int child_h;
+				if (children_pos.y + get_item_height(c) - cache.offset.y <= 0) {
+					child_h = get_item_height(c); // Whole branch is above the visible area, skip it.
+				} else {
+					child_h = draw_item(children_pos, p_draw_ofs, p_draw_size, c);
+				}
 
 				// Draw relationship lines.
 				if (cache.draw_relationship_lines > 0 && (!hide_root || c->parent != root)) {
@@ -2634,7 +2667,12 @@ int Tree::propagate_mouse_event(const Point2i &p_pos, int x_ofs, int y_ofs, int
 			TreeItem *c = p_item->first_child;
 
 			while (c) {
-				int child_h = propagate_mouse_event(new_pos, x_ofs, y_ofs, x_limit, p_double_click, c, p_button, p_mod);
+				int child_h;
+				if (new_pos.y >= get_item_height(c)) {
+					child_h = get_item_height(c); // Event is below this branch.
+				} else {
+					child_h = propagate_mouse_event(new_pos, x_ofs, y_ofs, x_limit, p_double_click, c, p_button, p_mod);
+				}
 
 				if (child_h < 0) {
 					return -1; // break, stop propagating, no need to anymore
@@ -3724,6 +3762,7 @@ void Tree::_notification(int p_what) {
 
 	if (p_what == NOTIFICATION_THEME_CHANGED || p_what == NOTIFICATION_LAYOUT_DIRECTION_CHANGED || p_what == NOTIFICATION_TRANSLATION_CHANGED) {
 		update_cache();
+		item_height_version++;
 		_update_all();
 	}
 
@@ -3917,6 +3956,7 @@ void Tree::clear() {
 
 void Tree::set_hide_root(bool p_enabled) {
 	hide_root = p_enabled;
+	item_height_version++;
 	update();
 }
 
@@ -4121,6 +4161,7 @@ void Tree::set_columns(int p_columns) {
 	ERR_FAIL_COND(p_columns < 1);
 	ERR_FAIL_COND(blocked > 0);
 	columns.resize(p_columns);
+	item_height_version++;
 
 	if (root) {
 		propagate_set_columns(root);
@@ -4144,40 +4185,31 @@ Rect2 Tree::get_custom_popup_rect() const {
 }
 
 int Tree::get_item_offset(TreeItem *p_item) const {
-	TreeItem *it = root;
-	int ofs = _get_title_button_height();
-	if (!it) {
+	if (!root) {
 		return 0;
 	}
 
-	while (true) {
-		if (it == p_item) {
-			return ofs;
+	// Sum the heights of everything above the item, using the cached branch heights of the previous siblings.
+	int ofs = 0;
+	TreeItem *it = p_item;
+	while (it != root) {
+		TreeItem *parent = it->parent;
+		if (!parent || parent->collapsed) {
+			return 0; // Not visible.
 		}
 
-		ofs += compute_item_height(it);
-		if (it != root || !hide_root) {
-			ofs += cache.vseparation;
+		for (TreeItem *c = parent->first_child; c != it; c = c->next) {
+			ofs += get_item_height(c);
 		}
 
-		if (it->first_child && !it->collapsed) {
-			it = it->first_child;
-
-		} else if (it->next) {
-			it = it->next;
-		} else {
-			while (!it->next) {
-				it = it->parent;
-				if (it == nullptr) {
-					return 0;
-				}
-			}
-
-			it = it->next;
+		ofs += compute_item_height(parent);
+		if (parent != root || !hide_root) {
+			ofs += cache.vseparation;
 		}
+		it = parent;
 	}
 
-	return -1; //not found
+	return ofs + _get_title_button_height();
 }
 
 void Tree::ensure_cursor_is_visible() {
@@ -4504,7 +4536,13 @@ TreeItem *Tree::_find_item_at_pos(TreeItem *p_item, const Point2 &p_pos, int &r_
 
 	TreeItem *n = p_item->get_first_child();
 	while (n) {
-		int ch;
+		int ch = get_item_height(n);
+		if (pos.y >= ch) { // Position is below this branch.
+			pos.y -= ch;
+			h += ch;
+			n = n->get_next();
+			continue;
+		}
 		TreeItem *r = _find_item_at_pos(n, pos, r_column, ch, section);
 		pos.y -= ch;
 		h += ch;
@@ -133,6 +133,12 @@ private:
 	bool disable_folding = false;
 	int custom_min_height = 0;
 
+	// Cached Tree::compute_item_height() and Tree::get_item_height() results, valid while their version matches the tree's.
+	int label_height = 0;
+	int subtree_height = 0;
+	uint32_t label_height_version = 0;
+	uint32_t subtree_height_version = 0;
+
 	TreeItem *parent = nullptr; // parent item
 	TreeItem *prev = nullptr; // previous in list
 	TreeItem *next = nullptr; // next in list
@@ -151,6 +157,19 @@ private:
 
 	void _change_tree(Tree *p_tree);
 
+	_FORCE_INLINE_ void _invalidate_subtree_height() {
+		TreeItem *it = this;
+		while (it) {
+			it->subtree_height_version = 0;
+			it = it->parent;
+		}
+	}
+
+	_FORCE_INLINE_ void _invalidate_height() {
+		label_height_version = 0;
+		_invalidate_subtree_height();
+	}
+
 	_FORCE_INLINE_ void _create_children_cache() {
 		if (children_cache.is_empty()) {
 			TreeItem *c = first_child;
@@ -162,6 +181,9 @@ private:
 	}
 
 	_FORCE_INLINE_ void _unlink_from_tree() {
+		if (parent) {
+			parent->_invalidate_subtree_height();
+		}
 		TreeItem *p = get_prev();
 		if (p) {
 			p->next = next;
@@ -413,6 +435,7 @@ private:
 	int selected_col = -1;
 	int popup_edited_item_col = -1;
 	bool hide_root = false;
+	uint32_t item_height_version = 1; // Incremented to invalidate all cached item heights.
 	SelectMode select_mode = SELECT_SINGLE;
 
 	int blocked = 0;
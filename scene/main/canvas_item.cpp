@@ -365,7 +365,7 @@ bool CanvasItem::is_visible() const {
 }
 
 void CanvasItem::update() {
-	if (!is_inside_tree()) {
+	if (!is_inside_tree() || !Engine::get_singleton()->is_visual_processing_enabled()) {
 		return;
 	}
 	if (pending_update) {
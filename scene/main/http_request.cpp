@@ -36,6 +36,19 @@ void HTTPRequest::_redirect_request(const String &p_new_url) {
 }
 
 Error HTTPRequest::_request() {
+	if (client->get_status() == HTTPClient::STATUS_CONNECTED) {
+		// Connection kept alive by the previous request, reuse it for the same host.
+		client->poll();
+		if (client->get_status() == HTTPClient::STATUS_CONNECTED && url == connected_host && port == connected_port && use_ssl == connected_ssl && validate_ssl == connected_validate_ssl) {
+			return OK;
+		}
+	}
+	client->close();
+
+	connected_host = url;
+	connected_port = port;
+	connected_ssl = use_ssl;
+	connected_validate_ssl = validate_ssl;
 	return client->connect_to_host(url, port, use_ssl, validate_ssl);
 }
 
@@ -184,6 +197,10 @@ void HTTPRequest::_thread_func(void *p_userdata) {
 }
 
 void HTTPRequest::cancel_request() {
+	_finish_request(false);
+}
+
+void HTTPRequest::_finish_request(bool p_keep_connection) {
 	timer->stop();
 
 	if (!requesting) {
@@ -201,7 +218,9 @@ void HTTPRequest::cancel_request() {
 		memdelete(file);
 		file = nullptr;
 	}
-	client->close();
+	if (!p_keep_connection) {
+		client->close();
+	}
 	body.resize(0);
 	got_response = false;
 	response_code = -1;
@@ -426,7 +445,8 @@ bool HTTPRequest::_update_connection() {
 }
 
 void HTTPRequest::_request_done(int p_status, int p_code, const PackedStringArray &p_headers, const PackedByteArray &p_data) {
-	cancel_request();
+	// The whole response has been read if the client is back to connected, the next request can use the same connection.
+	_finish_request(keep_alive && p_status == RESULT_SUCCESS && client->get_status() == HTTPClient::STATUS_CONNECTED);
 
 	// Determine if the request body is compressed
 	bool is_compressed;
@@ -483,12 +503,14 @@ void HTTPRequest::_notification(int p_what) {
 	if (p_what == NOTIFICATION_EXIT_TREE) {
 		if (requesting) {
 			cancel_request();
+		} else {
+			client->close();
 		}
 	}
 }
 
 void HTTPRequest::set_use_threads(bool p_use) {
-	ERR_FAIL_COND(get_http_client_status() != HTTPClient::STATUS_DISCONNECTED);
+	ERR_FAIL_COND(requesting);
 	use_threads.set_to(p_use);
 }
 
@@ -504,8 +526,19 @@ bool HTTPRequest::is_accepting_gzip() const {
 	return accept_gzip;
 }
 
+void HTTPRequest::set_keep_alive(bool p_keep_alive) {
+	keep_alive = p_keep_alive;
+	if (!keep_alive && !requesting) {
+		client->close();
+	}
+}
+
+bool HTTPRequest::is_keeping_alive() const {
+	return keep_alive;
+}
+
 void HTTPRequest::set_body_size_limit(int p_bytes) {
-	ERR_FAIL_COND(get_http_client_status() != HTTPClient::STATUS_DISCONNECTED);
+	ERR_FAIL_COND(requesting);
 
 	body_size_limit = p_bytes;
 }
@@ -515,7 +548,7 @@ int HTTPRequest::get_body_size_limit() const {
 }
 
 void HTTPRequest::set_download_file(const String &p_file) {
-	ERR_FAIL_COND(get_http_client_status() != HTTPClient::STATUS_DISCONNECTED);
+	ERR_FAIL_COND(requesting);
 
 	download_to_file = p_file;
 }
@@ -525,7 +558,7 @@ String HTTPRequest::get_download_file() const {
 }
 
 void HTTPRequest::set_download_chunk_size(int p_chunk_size) {
-	ERR_FAIL_COND(get_http_client_status() != HTTPClient::STATUS_DISCONNECTED);
+	ERR_FAIL_COND(requesting);
 
 	client->set_read_chunk_size(p_chunk_size);
 }
@@ -581,6 +614,9 @@ void HTTPRequest::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_accept_gzip", "enable"), &HTTPRequest::set_accept_gzip);
 	ClassDB::bind_method(D_METHOD("is_accepting_gzip"), &HTTPRequest::is_accepting_gzip);
 
+	ClassDB::bind_method(D_METHOD("set_keep_alive", "enable"), &HTTPRequest::set_keep_alive);
+	ClassDB::bind_method(D_METHOD("is_keeping_alive"), &HTTPRequest::is_keeping_alive);
+
 	ClassDB::bind_method(D_METHOD("set_body_size_limit", "bytes"), &HTTPRequest::set_body_size_limit);
 	ClassDB::bind_method(D_METHOD("get_body_size_limit"), &HTTPRequest::get_body_size_limit);
 
@@ -606,6 +642,7 @@ void HTTPRequest::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "download_chunk_size", PROPERTY_HINT_RANGE, "256,16777216"), "set_download_chunk_size", "get_download_chunk_size");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_threads"), "set_use_threads", "is_using_threads");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "accept_gzip"), "set_accept_gzip", "is_accepting_gzip");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "keep_alive"), "set_keep_alive", "is_keeping_alive");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "body_size_limit", PROPERTY_HINT_RANGE, "-1,2000000000"), "set_body_size_limit", "get_body_size_limit");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_redirects", PROPERTY_HINT_RANGE, "-1,64"), "set_max_redirects", "get_max_redirects");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "timeout", PROPERTY_HINT_RANGE, "0,86400"), "set_timeout", "get_timeout");
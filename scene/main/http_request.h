@@ -70,6 +70,12 @@ private:
 	bool validate_ssl = false;
 	bool use_ssl = false;
 	HTTPClient::Method method;
+
+	bool keep_alive = false;
+	String connected_host;
+	int connected_port = 0;
+	bool connected_ssl = false;
+	bool connected_validate_ssl = false;
 	Vector<uint8_t> request_data;
 
 	bool request_sent = false;
@@ -113,6 +119,7 @@ private:
 
 	Thread thread;
 
+	void _finish_request(bool p_keep_connection);
 	void _request_done(int p_status, int p_code, const PackedStringArray &p_headers, const PackedByteArray &p_data);
 	static void _thread_func(void *p_userdata);
 
@@ -132,6 +139,9 @@ public:
 	void set_accept_gzip(bool p_gzip);
 	bool is_accepting_gzip() const;
 
+	void set_keep_alive(bool p_keep_alive);
+	bool is_keeping_alive() const;
+
 	void set_download_file(const String &p_file);
 	String get_download_file() const;
 
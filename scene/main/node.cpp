@@ -33,6 +33,7 @@
 #include "core/core_string_names.h"
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
+#include "core/os/thread.h"
 #include "core/string/print_string.h"
 #include "instance_placeholder.h"
 #include "scene/animation/tween.h"
@@ -44,6 +45,7 @@
 #include <stdint.h>
 
 VARIANT_ENUM_CAST(Node::ProcessMode);
+VARIANT_ENUM_CAST(Node::ProcessThreadGroup);
 VARIANT_ENUM_CAST(Node::InternalMode);
 
 int Node::orphan_node_count = 0;
@@ -74,6 +76,12 @@ void Node::_notification(int p_notification) {
 				data.process_owner = this;
 			}
 
+			if (data.process_thread_group == PROCESS_THREAD_GROUP_INHERIT) {
+				data.process_in_thread = data.parent && data.parent->data.process_in_thread;
+			} else {
+				data.process_in_thread = data.process_thread_group == PROCESS_THREAD_GROUP_SUB_THREAD;
+			}
+
 			if (data.input) {
 				add_to_group("_vp_input" + itos(get_viewport()->get_instance_id()));
 			}
@@ -210,6 +218,7 @@ void Node::_propagate_enter_tree() {
 	for (KeyValue<StringName, GroupData> &E : data.grouped) {
 		E.value.group = data.tree->add_to_group(E.key, this);
 	}
+	_add_to_process_lists();
 
 	notification(NOTIFICATION_ENTER_TREE);
 
@@ -274,6 +283,7 @@ void Node::_propagate_exit_tree() {
 		data.tree->remove_from_group(E.key, this);
 		E.value.group = nullptr;
 	}
+	_remove_from_process_lists();
 
 	data.viewport = nullptr;
 
@@ -289,6 +299,7 @@ void Node::_propagate_exit_tree() {
 
 void Node::move_child(Node *p_child, int p_pos) {
 	ERR_FAIL_NULL(p_child);
+	ERR_FAIL_COND_MSG(data.tree && data.tree->is_processing_in_threads(), "Can't move a child while nodes are processed in threads, use call_deferred(\"move_child\", ...) instead.");
 	ERR_FAIL_COND_MSG(p_child->data.parent != this, "Child is not a child of this node.");
 
 	// We need to check whether node is internal and move it only in the relevant node range.
@@ -354,6 +365,11 @@ void Node::_move_child(Node *p_child, int p_pos, bool p_ignore_end) {
 			E.value.group->changed = true;
 		}
 	}
+	for (int i = 0; i < SceneTree::PROCESS_LIST_MAX; i++) {
+		if (p_child->data.process_list_index[i] != -1) {
+			data.tree->_make_process_list_changed(SceneTree::ProcessListType(i));
+		}
+	}
 
 	data.blocked--;
 }
@@ -390,13 +406,9 @@ void Node::set_physics_process(bool p_process) {
 		return;
 	}
 
+	ERR_FAIL_COND_MSG(data.tree && data.tree->is_processing_in_threads(), "Can't change processing while nodes are processed in threads, use call_deferred() instead.");
 	data.physics_process = p_process;
-
-	if (data.physics_process) {
-		add_to_group("physics_process", false);
-	} else {
-		remove_from_group("physics_process");
-	}
+	_set_in_process_list(SceneTree::PROCESS_LIST_PHYSICS_PROCESS, data.physics_process);
 }
 
 bool Node::is_physics_processing() const {
@@ -408,13 +420,9 @@ void Node::set_physics_process_internal(bool p_process_internal) {
 		return;
 	}
 
+	ERR_FAIL_COND_MSG(data.tree && data.tree->is_processing_in_threads(), "Can't change processing while nodes are processed in threads, use call_deferred() instead.");
 	data.physics_process_internal = p_process_internal;
-
-	if (data.physics_process_internal) {
-		add_to_group("physics_process_internal", false);
-	} else {
-		remove_from_group("physics_process_internal");
-	}
+	_set_in_process_list(SceneTree::PROCESS_LIST_PHYSICS_PROCESS_INTERNAL, data.physics_process_internal);
 }
 
 bool Node::is_physics_processing_internal() const {
@@ -495,6 +503,37 @@ Node::ProcessMode Node::get_process_mode() const {
 	return data.process_mode;
 }
 
+void Node::set_process_thread_group(ProcessThreadGroup p_group) {
+	ERR_FAIL_INDEX(p_group, PROCESS_THREAD_GROUP_SUB_THREAD + 1);
+	ERR_FAIL_COND_MSG(data.tree && data.tree->is_processing_in_threads(), "Can't change the process thread group while nodes are processed in threads, use call_deferred() instead.");
+	data.process_thread_group = p_group;
+
+	if (!is_inside_tree()) {
+		return;
+	}
+
+	if (p_group == PROCESS_THREAD_GROUP_INHERIT) {
+		_propagate_process_in_thread(data.parent && data.parent->data.process_in_thread);
+	} else {
+		_propagate_process_in_thread(p_group == PROCESS_THREAD_GROUP_SUB_THREAD);
+	}
+}
+
+Node::ProcessThreadGroup Node::get_process_thread_group() const {
+	return data.process_thread_group;
+}
+
+void Node::_propagate_process_in_thread(bool p_in_thread) {
+	data.process_in_thread = p_in_thread;
+
+	for (int i = 0; i < data.children.size(); i++) {
+		Node *c = data.children[i];
+		if (c->data.process_thread_group == PROCESS_THREAD_GROUP_INHERIT) {
+			c->_propagate_process_in_thread(p_in_thread);
+		}
+	}
+}
+
 void Node::_propagate_process_owner(Node *p_owner, int p_pause_notification, int p_enabled_notification) {
 	data.process_owner = p_owner;
 
@@ -760,13 +799,9 @@ void Node::set_process(bool p_process) {
 		return;
 	}
 
+	ERR_FAIL_COND_MSG(data.tree && data.tree->is_processing_in_threads(), "Can't change processing while nodes are processed in threads, use call_deferred() instead.");
 	data.process = p_process;
-
-	if (data.process) {
-		add_to_group("process", false);
-	} else {
-		remove_from_group("process");
-	}
+	_set_in_process_list(SceneTree::PROCESS_LIST_PROCESS, data.process);
 }
 
 bool Node::is_processing() const {
@@ -778,13 +813,9 @@ void Node::set_process_internal(bool p_process_internal) {
 		return;
 	}
 
+	ERR_FAIL_COND_MSG(data.tree && data.tree->is_processing_in_threads(), "Can't change processing while nodes are processed in threads, use call_deferred() instead.");
 	data.process_internal = p_process_internal;
-
-	if (data.process_internal) {
-		add_to_group("process_internal", false);
-	} else {
-		remove_from_group("process_internal");
-	}
+	_set_in_process_list(SceneTree::PROCESS_LIST_PROCESS_INTERNAL, data.process_internal);
 }
 
 bool Node::is_processing_internal() const {
@@ -792,32 +823,62 @@ bool Node::is_processing_internal() const {
 }
 
 void Node::set_process_priority(int p_priority) {
+	if (data.process_priority == p_priority) {
+		return;
+	}
+	ERR_FAIL_COND_MSG(data.tree && data.tree->is_processing_in_threads(), "Can't change processing while nodes are processed in threads, use call_deferred() instead.");
+
 	data.process_priority = p_priority;
 
-	// Make sure we are in SceneTree.
-	if (data.tree == nullptr) {
+	if (!data.inside_tree) {
 		return;
 	}
 
-	if (is_processing()) {
-		data.tree->make_group_changed("process");
+	// Adding the node again sorts it into its new place, the rest of the list stays as is.
+	for (int i = 0; i < SceneTree::PROCESS_LIST_MAX; i++) {
+		if (data.process_list_index[i] != -1) {
+			data.tree->_remove_from_process_list(SceneTree::ProcessListType(i), this);
+			data.tree->_add_to_process_list(SceneTree::ProcessListType(i), this);
+		}
 	}
+}
 
-	if (is_processing_internal()) {
-		data.tree->make_group_changed("process_internal");
-	}
+int Node::get_process_priority() const {
+	return data.process_priority;
+}
 
-	if (is_physics_processing()) {
-		data.tree->make_group_changed("physics_process");
+void Node::_set_in_process_list(SceneTree::ProcessListType p_list, bool p_enabled) {
+	if (!data.inside_tree) {
+		return; // Added when entering the tree.
 	}
+	if (p_enabled) {
+		data.tree->_add_to_process_list(p_list, this);
+	} else {
+		data.tree->_remove_from_process_list(p_list, this);
+	}
+}
 
-	if (is_physics_processing_internal()) {
-		data.tree->make_group_changed("physics_process_internal");
+void Node::_add_to_process_lists() {
+	if (data.process) {
+		data.tree->_add_to_process_list(SceneTree::PROCESS_LIST_PROCESS, this);
+	}
+	if (data.process_internal) {
+		data.tree->_add_to_process_list(SceneTree::PROCESS_LIST_PROCESS_INTERNAL, this);
+	}
+	if (data.physics_process) {
+		data.tree->_add_to_process_list(SceneTree::PROCESS_LIST_PHYSICS_PROCESS, this);
+	}
+	if (data.physics_process_internal) {
+		data.tree->_add_to_process_list(SceneTree::PROCESS_LIST_PHYSICS_PROCESS_INTERNAL, this);
 	}
 }
 
-int Node::get_process_priority() const {
-	return data.process_priority;
+void Node::_remove_from_process_lists() {
+	for (int i = 0; i < SceneTree::PROCESS_LIST_MAX; i++) {
+		if (data.process_list_index[i] != -1) {
+			data.tree->_remove_from_process_list(SceneTree::ProcessListType(i), this);
+		}
+	}
 }
 
 void Node::set_process_input(bool p_enable) {
@@ -1112,6 +1173,7 @@ void Node::_add_child_nocheck(Node *p_child, const StringName &p_name) {
 
 void Node::add_child(Node *p_child, bool p_legible_unique_name, InternalMode p_internal) {
 	ERR_FAIL_NULL(p_child);
+	ERR_FAIL_COND_MSG(data.tree && data.tree->is_processing_in_threads(), "Can't add a child while nodes are processed in threads, use call_deferred(\"add_child\", ...) instead.");
 	ERR_FAIL_COND_MSG(p_child == this, vformat("Can't add child '%s' to itself.", p_child->get_name())); // adding to itself!
 	ERR_FAIL_COND_MSG(p_child->data.parent, vformat("Can't add child '%s' to '%s', already has a parent '%s'.", p_child->get_name(), get_name(), p_child->data.parent->get_name())); //Fail if node has a parent
 #ifdef DEBUG_ENABLED
@@ -1177,6 +1239,7 @@ void Node::_propagate_validate_owner() {
 
 void Node::remove_child(Node *p_child) {
 	ERR_FAIL_NULL(p_child);
+	ERR_FAIL_COND_MSG(data.tree && data.tree->is_processing_in_threads(), "Can't remove a child while nodes are processed in threads, use call_deferred(\"remove_child\", ...) instead.");
 	ERR_FAIL_COND_MSG(data.blocked > 0, "Parent node is busy setting up children, remove_node() failed. Consider using call_deferred(\"remove_child\", child) instead.");
 
 	int child_count = data.children.size();
@@ -1281,6 +1344,50 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 
 	ERR_FAIL_COND_V_MSG(!data.inside_tree && p_path.is_absolute(), nullptr, "Can't use get_node() with absolute paths from outside the active scene tree.");
 
+	// Nodes processed on worker threads can share a parent, so the cache isn't touched there.
+	if (p_path.is_absolute() || Thread::get_caller_id() != Thread::get_main_id()) {
+		return _resolve_node_path(p_path);
+	}
+
+	const ObjectID *cached = data.node_cache.getptr(p_path);
+	if (cached) {
+		// IDs are never reused, so a live object with this ID is still the node that was cached.
+		Node *node = static_cast<Node *>(ObjectDB::get_instance(*cached));
+		if (node && _is_node_cache_valid(p_path, node)) {
+			return node;
+		}
+	}
+
+	Node *node = _resolve_node_path(p_path);
+	if (node && _is_node_cache_valid(p_path, node)) {
+		if (!cached && data.node_cache.size() >= NODE_CACHE_MAX) {
+			data.node_cache.clear();
+		}
+		data.node_cache.set(p_path, node->get_instance_id());
+	} else if (cached) {
+		data.node_cache.erase(p_path);
+	}
+
+	return node;
+}
+
+// Sibling names are unique, so if walking up from the node matches the path back to this node,
+// resolving the path would find it again. This only compares names and parents, unlike the lookup,
+// which searches the children at every step. Paths going up or through "." never match, so they aren't cached.
+bool Node::_is_node_cache_valid(const NodePath &p_path, const Node *p_node) const {
+	for (int i = p_path.get_name_count() - 1; i >= 0; i--) {
+		if (p_node->data.name != p_path.get_name(i)) {
+			return false;
+		}
+		p_node = p_node->data.parent;
+		if (!p_node) {
+			return false;
+		}
+	}
+	return p_node == this;
+}
+
+Node *Node::_resolve_node_path(const NodePath &p_path) const {
 	Node *current = nullptr;
 	Node *root = nullptr;
 
@@ -1632,6 +1739,7 @@ bool Node::is_in_group(const StringName &p_identifier) const {
 
 void Node::add_to_group(const StringName &p_identifier, bool p_persistent) {
 	ERR_FAIL_COND(!p_identifier.operator String().length());
+	ERR_FAIL_COND_MSG(data.tree && data.tree->is_processing_in_threads(), "Can't change groups while nodes are processed in threads, use call_deferred() instead.");
 
 	if (data.grouped.has(p_identifier)) {
 		return;
@@ -1652,6 +1760,7 @@ void Node::add_to_group(const StringName &p_identifier, bool p_persistent) {
 
 void Node::remove_from_group(const StringName &p_identifier) {
 	ERR_FAIL_COND(!data.grouped.has(p_identifier));
+	ERR_FAIL_COND_MSG(data.tree && data.tree->is_processing_in_threads(), "Can't change groups while nodes are processed in threads, use call_deferred() instead.");
 
 	Map<StringName, GroupData>::Element *E = data.grouped.find(p_identifier);
 
@@ -1760,6 +1869,16 @@ void Node::propagate_notification(int p_notification) {
 	data.blocked--;
 }
 
+void Node::propagate_pool_reset() {
+	data.blocked++;
+	for (int i = 0; i < data.children.size(); i++) {
+		data.children[i]->propagate_pool_reset();
+	}
+	data.blocked--;
+
+	GDVIRTUAL_CALL(_pool_reset);
+}
+
 void Node::propagate_call(const StringName &p_method, const Array &p_args, const bool p_parent_first) {
 	data.blocked++;
 
@@ -2705,6 +2824,8 @@ void Node::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_processing_unhandled_key_input"), &Node::is_processing_unhandled_key_input);
 	ClassDB::bind_method(D_METHOD("set_process_mode", "mode"), &Node::set_process_mode);
 	ClassDB::bind_method(D_METHOD("get_process_mode"), &Node::get_process_mode);
+	ClassDB::bind_method(D_METHOD("set_process_thread_group", "group"), &Node::set_process_thread_group);
+	ClassDB::bind_method(D_METHOD("get_process_thread_group"), &Node::get_process_thread_group);
 	ClassDB::bind_method(D_METHOD("can_process"), &Node::can_process);
 	ClassDB::bind_method(D_METHOD("print_stray_nodes"), &Node::_print_stray_nodes);
 
@@ -2815,6 +2936,10 @@ void Node::_bind_methods() {
 	BIND_ENUM_CONSTANT(PROCESS_MODE_ALWAYS);
 	BIND_ENUM_CONSTANT(PROCESS_MODE_DISABLED);
 
+	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_INHERIT);
+	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_MAIN_THREAD);
+	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_SUB_THREAD);
+
 	BIND_ENUM_CONSTANT(DUPLICATE_SIGNALS);
 	BIND_ENUM_CONSTANT(DUPLICATE_GROUPS);
 	BIND_ENUM_CONSTANT(DUPLICATE_SCRIPTS);
@@ -2839,6 +2964,7 @@ void Node::_bind_methods() {
 	ADD_GROUP("Process", "process_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_mode", PROPERTY_HINT_ENUM, "Inherit,Pausable,When Paused,Always,Disabled"), "set_process_mode", "get_process_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_priority"), "set_process_priority", "get_process_priority");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_group", PROPERTY_HINT_ENUM, "Inherit,Main Thread,Sub Thread"), "set_process_thread_group", "get_process_thread_group");
 
 	ADD_GROUP("Editor Description", "editor_");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "editor_description", PROPERTY_HINT_MULTILINE_TEXT, "", PROPERTY_USAGE_EDITOR | PROPERTY_USAGE_INTERNAL), "set_editor_description", "get_editor_description");
@@ -2849,6 +2975,7 @@ void Node::_bind_methods() {
 	GDVIRTUAL_BIND(_exit_tree);
 	GDVIRTUAL_BIND(_ready);
 	GDVIRTUAL_BIND(_get_configuration_warnings);
+	GDVIRTUAL_BIND(_pool_reset);
 	GDVIRTUAL_BIND(_input, "event");
 	GDVIRTUAL_BIND(_unhandled_input, "event");
 	GDVIRTUAL_BIND(_unhandled_key_input, "event");
@@ -35,6 +35,7 @@
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
 #include "core/string/node_path.h"
+#include "core/templates/hash_map.h"
 #include "core/templates/map.h"
 #include "core/variant/typed_array.h"
 #include "scene/main/scene_tree.h"
@@ -57,6 +58,12 @@ public:
 		PROCESS_MODE_DISABLED, // never process
 	};
 
+	enum ProcessThreadGroup {
+		PROCESS_THREAD_GROUP_INHERIT,
+		PROCESS_THREAD_GROUP_MAIN_THREAD,
+		PROCESS_THREAD_GROUP_SUB_THREAD,
+	};
+
 	enum DuplicateFlags {
 		DUPLICATE_SIGNALS = 1,
 		DUPLICATE_GROUPS = 2,
@@ -127,6 +134,9 @@ private:
 		ProcessMode process_mode = PROCESS_MODE_INHERIT;
 		Node *process_owner = nullptr;
 
+		ProcessThreadGroup process_thread_group = PROCESS_THREAD_GROUP_INHERIT;
+		bool process_in_thread = false; // Resolved from the process thread group of the ancestors.
+
 		int multiplayer_authority = 1; // Server by default.
 		Vector<Multiplayer::RPCConfig> rpc_methods;
 
@@ -138,6 +148,7 @@ private:
 
 		bool physics_process_internal = false;
 		bool process_internal = false;
+		int32_t process_list_index[SceneTree::PROCESS_LIST_MAX] = { -1, -1, -1, -1 }; // Slot in the SceneTree process lists, -1 when not in them.
 
 		bool input = false;
 		bool unhandled_input = false;
@@ -152,14 +163,24 @@ private:
 
 		mutable NodePath *path_cache = nullptr;
 
+		// Nodes found by get_node_or_null() for relative paths, only used on the main thread.
+		// Entries are checked against the tree when hit, see _is_node_cache_valid().
+		mutable HashMap<NodePath, ObjectID> node_cache;
+
 	} data;
 
+	enum {
+		NODE_CACHE_MAX = 32
+	};
+
 	Ref<MultiplayerAPI> multiplayer;
 
 	void _print_tree_pretty(const String &prefix, const bool last);
 	void _print_tree(const Node *p_node);
 
 	Node *_get_child_by_name(const StringName &p_name) const;
+	Node *_resolve_node_path(const NodePath &p_path) const;
+	bool _is_node_cache_valid(const NodePath &p_path, const Node *p_node) const;
 
 	void _replace_connections_target(Node *p_new_target);
 
@@ -175,6 +196,10 @@ private:
 	void _propagate_validate_owner();
 	void _print_stray_nodes();
 	void _propagate_process_owner(Node *p_owner, int p_pause_notification, int p_enabled_notification);
+	void _propagate_process_in_thread(bool p_in_thread);
+	void _set_in_process_list(SceneTree::ProcessListType p_list, bool p_enabled);
+	void _add_to_process_lists();
+	void _remove_from_process_lists();
 	Array _get_node_and_resource(const NodePath &p_path);
 
 	void _duplicate_signals(const Node *p_original, Node *p_copy) const;
@@ -235,6 +260,7 @@ protected:
 	GDVIRTUAL0(_exit_tree)
 	GDVIRTUAL0(_ready)
 	GDVIRTUAL0RC(Vector<String>, _get_configuration_warnings)
+	GDVIRTUAL0(_pool_reset)
 
 	GDVIRTUAL1(_input, Ref<InputEvent>)
 	GDVIRTUAL1(_unhandled_input, Ref<InputEvent>)
@@ -371,6 +397,9 @@ public:
 
 	void propagate_call(const StringName &p_method, const Array &p_args = Array(), const bool p_parent_first = false);
 
+	// Used by ScenePool when an instance is returned to it, children first.
+	void propagate_pool_reset();
+
 	/* PROCESSING */
 	void set_physics_process(bool p_process);
 	double get_physics_process_delta_time() const;
@@ -422,6 +451,11 @@ public:
 
 	void set_process_mode(ProcessMode p_mode);
 	ProcessMode get_process_mode() const;
+
+	void set_process_thread_group(ProcessThreadGroup p_group);
+	ProcessThreadGroup get_process_thread_group() const;
+	_FORCE_INLINE_ bool is_processing_in_thread() const { return data.process_in_thread; }
+
 	bool can_process() const;
 	bool can_process_notification(int p_what) const;
 	bool is_enabled() const;
@@ -0,0 +1,228 @@
+/*************************************************************************/
+/*  scene_pool.cpp                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "scene_pool.h"
+
+#include "scene/main/node.h"
+
+ScenePool::Instance ScenePool::_instantiate(Ref<PackedScene> p_scene) {
+	Instance instance;
+	instance.root = p_scene->instantiate();
+	ERR_FAIL_COND_V(!instance.root, instance);
+
+	instance.scene = p_scene->get_instance_id();
+
+	// Remember the nodes coming from the scene now, as names can change while the instance is in use.
+	Ref<SceneState> state = p_scene->get_state();
+	instance.nodes.resize(state->get_node_count());
+	for (int i = 0; i < state->get_node_count(); i++) {
+		Node *node = instance.root->get_node_or_null(state->get_node_path(i));
+		instance.nodes[i] = node ? node->get_instance_id() : ObjectID();
+	}
+
+	return instance;
+}
+
+bool ScenePool::_reset(const Instance &p_instance, const Ref<SceneState> &p_state) {
+	if ((int)p_instance.nodes.size() != p_state->get_node_count()) {
+		return false; // Scene changed meanwhile.
+	}
+
+	for (uint32_t i = 0; i < p_instance.nodes.size(); i++) {
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(p_instance.nodes[i]));
+		if (!node || (node != p_instance.root && !p_instance.root->is_ancestor_of(node))) {
+			return false; // Freed or moved away, the instance can't be reused.
+		}
+
+		for (int j = 0; j < p_state->get_node_property_count(i); j++) {
+			Variant value = p_state->get_node_property_value(i, j);
+			if (value.get_type() == Variant::OBJECT) {
+				Resource *res = Object::cast_to<Resource>(value);
+				if (res && res->is_local_to_scene()) {
+					continue; // The node owns a duplicate, keep it.
+				}
+			}
+			node->set(p_state->get_node_property_name(i, j), value);
+		}
+	}
+
+	p_instance.root->propagate_pool_reset();
+	return true;
+}
+
+void ScenePool::_free_instance(Instance &p_instance) {
+	if (p_instance.root) {
+		memdelete(p_instance.root);
+		p_instance.root = nullptr;
+	}
+}
+
+ScenePool::Pool *ScenePool::_get_pool(const Ref<PackedScene> &p_scene) {
+	ObjectID id = p_scene->get_instance_id();
+	Pool *pool = pools.getptr(id);
+	if (!pool) {
+		Pool new_pool;
+		new_pool.scene = p_scene;
+		pools.set(id, new_pool);
+		pool = pools.getptr(id);
+	}
+	return pool;
+}
+
+Node *ScenePool::acquire(const Ref<PackedScene> &p_scene) {
+	ERR_FAIL_COND_V(p_scene.is_null(), nullptr);
+
+	Pool *pool = _get_pool(p_scene);
+	Instance instance;
+	if (pool->instances.size()) {
+		instance = pool->instances[pool->instances.size() - 1];
+		pool->instances.resize(pool->instances.size() - 1);
+	} else {
+		instance = _instantiate(p_scene);
+		ERR_FAIL_COND_V(!instance.root, nullptr);
+	}
+
+	acquired.set(instance.root->get_instance_id(), instance);
+	return instance.root;
+}
+
+void ScenePool::release(Node *p_node) {
+	ERR_FAIL_NULL(p_node);
+	Instance *acquired_instance = acquired.getptr(p_node->get_instance_id());
+	ERR_FAIL_COND_MSG(!acquired_instance, "Node '" + p_node->get_name() + "' was not acquired from this pool.");
+
+	Instance instance = *acquired_instance;
+	acquired.erase(p_node->get_instance_id());
+
+	if (p_node->get_parent()) {
+		p_node->get_parent()->remove_child(p_node);
+	}
+
+	Pool *pool = pools.getptr(instance.scene);
+	if (!pool || (int)pool->instances.size() >= max_pooled || !_reset(instance, pool->scene->get_state())) {
+		_free_instance(instance);
+		return;
+	}
+
+	pool->instances.push_back(instance);
+}
+
+bool ScenePool::is_acquired(Node *p_node) const {
+	ERR_FAIL_NULL_V(p_node, false);
+	return acquired.has(p_node->get_instance_id());
+}
+
+void ScenePool::prewarm(const Ref<PackedScene> &p_scene, int p_count) {
+	ERR_FAIL_COND(p_scene.is_null());
+	ERR_FAIL_COND(p_count < 0);
+
+	Pool *pool = _get_pool(p_scene);
+	while ((int)pool->instances.size() < MIN(p_count, max_pooled)) {
+		Instance instance = _instantiate(p_scene);
+		ERR_FAIL_COND(!instance.root);
+		pool->instances.push_back(instance);
+	}
+}
+
+int ScenePool::get_pooled_count(const Ref<PackedScene> &p_scene) const {
+	ERR_FAIL_COND_V(p_scene.is_null(), 0);
+	const Pool *pool = pools.getptr(p_scene->get_instance_id());
+	return pool ? pool->instances.size() : 0;
+}
+
+void ScenePool::clear(const Ref<PackedScene> &p_scene) {
+	if (p_scene.is_valid()) {
+		Pool *pool = pools.getptr(p_scene->get_instance_id());
+		if (pool) {
+			for (uint32_t i = 0; i < pool->instances.size(); i++) {
+				_free_instance(pool->instances[i]);
+			}
+			pools.erase(p_scene->get_instance_id());
+		}
+		return;
+	}
+
+	const ObjectID *k = nullptr;
+	while ((k = pools.next(k))) {
+		Pool &pool = pools[*k];
+		for (uint32_t i = 0; i < pool.instances.size(); i++) {
+			_free_instance(pool.instances[i]);
+		}
+	}
+	pools.clear();
+
+	// Instances in use stay alive, they'll just be freed when released. Forget the ones freed by the user.
+	List<ObjectID> stale;
+	k = nullptr;
+	while ((k = acquired.next(k))) {
+		if (!ObjectDB::get_instance(*k)) {
+			stale.push_back(*k);
+		}
+	}
+	for (List<ObjectID>::Element *E = stale.front(); E; E = E->next()) {
+		acquired.erase(E->get());
+	}
+}
+
+void ScenePool::set_max_pooled(int p_max) {
+	ERR_FAIL_COND(p_max < 0);
+	max_pooled = p_max;
+
+	const ObjectID *k = nullptr;
+	while ((k = pools.next(k))) {
+		Pool &pool = pools[*k];
+		while ((int)pool.instances.size() > max_pooled) {
+			_free_instance(pool.instances[pool.instances.size() - 1]);
+			pool.instances.resize(pool.instances.size() - 1);
+		}
+	}
+}
+
+int ScenePool::get_max_pooled() const {
+	return max_pooled;
+}
+
+void ScenePool::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("acquire", "scene"), &ScenePool::acquire);
+	ClassDB::bind_method(D_METHOD("release", "node"), &ScenePool::release);
+	ClassDB::bind_method(D_METHOD("is_acquired", "node"), &ScenePool::is_acquired);
+	ClassDB::bind_method(D_METHOD("prewarm", "scene", "count"), &ScenePool::prewarm);
+	ClassDB::bind_method(D_METHOD("get_pooled_count", "scene"), &ScenePool::get_pooled_count);
+	ClassDB::bind_method(D_METHOD("clear", "scene"), &ScenePool::clear, DEFVAL(Ref<PackedScene>()));
+
+	ClassDB::bind_method(D_METHOD("set_max_pooled", "max"), &ScenePool::set_max_pooled);
+	ClassDB::bind_method(D_METHOD("get_max_pooled"), &ScenePool::get_max_pooled);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_pooled", PROPERTY_HINT_RANGE, "0,4096,1,or_greater"), "set_max_pooled", "get_max_pooled");
+}
+
+ScenePool::~ScenePool() {
+	clear();
+}
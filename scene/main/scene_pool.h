@@ -0,0 +1,86 @@
+/*************************************************************************/
+/*  scene_pool.h                                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef SCENE_POOL_H
+#define SCENE_POOL_H
+
+#include "core/object/ref_counted.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "scene/resources/packed_scene.h"
+
+class Node;
+
+// Keeps detached instances of packed scenes around, so they can be reused instead of freed and instantiated again.
+// Released instances are removed from the tree and reset to the values stored in their scene; anything else must be
+// reset by the nodes themselves, in Node._pool_reset().
+class ScenePool : public RefCounted {
+	GDCLASS(ScenePool, RefCounted);
+
+	struct Instance {
+		ObjectID scene;
+		Node *root = nullptr;
+		LocalVector<ObjectID> nodes; // Indexed like the nodes of the SceneState.
+	};
+
+	struct Pool {
+		Ref<PackedScene> scene;
+		LocalVector<Instance> instances;
+	};
+
+	HashMap<ObjectID, Pool> pools; // Keyed by PackedScene.
+	HashMap<ObjectID, Instance> acquired; // Keyed by instance root.
+	int max_pooled = 64;
+
+	Instance _instantiate(Ref<PackedScene> p_scene);
+	bool _reset(const Instance &p_instance, const Ref<SceneState> &p_state);
+	void _free_instance(Instance &p_instance);
+	Pool *_get_pool(const Ref<PackedScene> &p_scene);
+
+protected:
+	static void _bind_methods();
+
+public:
+	Node *acquire(const Ref<PackedScene> &p_scene);
+	void release(Node *p_node);
+	bool is_acquired(Node *p_node) const;
+
+	void prewarm(const Ref<PackedScene> &p_scene, int p_count);
+	int get_pooled_count(const Ref<PackedScene> &p_scene) const;
+	void clear(const Ref<PackedScene> &p_scene = Ref<PackedScene>());
+
+	void set_max_pooled(int p_max);
+	int get_max_pooled() const;
+
+	ScenePool() {}
+	~ScenePool();
+};
+
+#endif // SCENE_POOL_H
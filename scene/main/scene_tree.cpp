@@ -32,17 +32,23 @@
 
 #include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/trace_zones.h"
 #include "core/input/input.h"
 #include "core/io/dir_access.h"
 #include "core/io/marshalls.h"
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
+#include "core/os/frame_allocator.h"
 #include "core/os/keyboard.h"
 #include "core/os/os.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/string/print_string.h"
 #include "node.h"
+#include "scene/3d/node_3d.h"
+#include "scene/animation/animation_tree.h"
 #include "scene/animation/tween.h"
 #include "scene/debugger/scene_debugger.h"
+#include "scene/main/scene_pool.h"
 #include "scene/resources/font.h"
 #include "scene/resources/material.h"
 #include "scene/resources/mesh.h"
@@ -154,7 +160,65 @@ void SceneTree::make_group_changed(const StringName &p_group) {
 	}
 }
 
+#ifndef _3D_DISABLED
+void SceneTree::_update_pending_global_transforms() {
+	struct PendingTransform {
+		Node3D *node;
+		int depth;
+
+		bool operator<(const PendingTransform &p_other) const { return depth < p_other.depth; }
+	};
+
+	uint32_t count = 0;
+	for (SelfList<Node> *n = xform_change_list.first(); n; n = n->next()) {
+		count++;
+	}
+	if (count == 0) {
+		return;
+	}
+
+	FrameAllocator::Scope scope;
+	PendingTransform *pending = FrameAllocator::alloc_array<PendingTransform>(count);
+	uint32_t pending_count = 0;
+
+	for (SelfList<Node> *n = xform_change_list.first(); n; n = n->next()) {
+		Node3D *node = Object::cast_to<Node3D>(n->self());
+		if (node && (node->data.dirty & Node3D::DIRTY_GLOBAL)) {
+			pending[pending_count].node = node;
+			pending[pending_count].depth = node->Node::data.depth;
+			pending_count++;
+		}
+	}
+	if (pending_count == 0) {
+		return;
+	}
+
+	SortArray<PendingTransform> sorter;
+	sorter.sort(pending, pending_count);
+
+	Node3D **nodes = FrameAllocator::alloc_array<Node3D *>(pending_count);
+	int *depths = FrameAllocator::alloc_array<int>(pending_count);
+	for (uint32_t i = 0; i < pending_count; i++) {
+		nodes[i] = pending[i].node;
+		depths[i] = pending[i].depth;
+	}
+
+	Node3D::_update_global_transforms(nodes, depths, pending_count);
+}
+#endif // _3D_DISABLED
+
 void SceneTree::flush_transform_notifications() {
+	bool was_batching = xform_batching;
+	xform_batching = true;
+
+#ifndef _3D_DISABLED
+	if (!was_batching) {
+		// Resolve all the pending global transforms top-down before notifying,
+		// instead of each notified node walking up its parents.
+		_update_pending_global_transforms();
+	}
+#endif
+
 	SelfList<Node> *n = xform_change_list.first();
 	while (n) {
 		Node *node = n->self();
@@ -163,6 +227,26 @@ void SceneTree::flush_transform_notifications() {
 		n = nx;
 		node->notification(NOTIFICATION_TRANSFORM_CHANGED);
 	}
+
+	if (was_batching) {
+		return; // Flushed from within a notification, the outer flush submits.
+	}
+	xform_batching = false;
+
+	if (xform_batch_instances.size()) {
+		RS::get_singleton()->instance_set_transforms(xform_batch_instances, xform_batch_transforms);
+		xform_batch_instances.clear();
+		xform_batch_transforms.clear();
+	}
+}
+
+void SceneTree::set_instance_transform(RID p_instance, const Transform3D &p_transform) {
+	if (!xform_batching) {
+		RS::get_singleton()->instance_set_transform(p_instance, p_transform);
+		return;
+	}
+	xform_batch_instances.push_back(p_instance);
+	xform_batch_transforms.push_back(p_transform);
 }
 
 void SceneTree::_flush_ugc() {
@@ -244,7 +328,7 @@ void SceneTree::call_group_flags(uint32_t p_call_flags, const StringName &p_grou
 	_update_group_order(g);
 
 	Vector<Node *> nodes_copy = g.nodes;
-	Node **nodes = nodes_copy.ptrw();
+	Node *const *nodes = nodes_copy.ptr();
 	int node_count = nodes_copy.size();
 
 	call_lock++;
@@ -295,7 +379,7 @@ void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_gr
 	_update_group_order(g);
 
 	Vector<Node *> nodes_copy = g.nodes;
-	Node **nodes = nodes_copy.ptrw();
+	Node *const *nodes = nodes_copy.ptr();
 	int node_count = nodes_copy.size();
 
 	call_lock++;
@@ -346,7 +430,7 @@ void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group
 	_update_group_order(g);
 
 	Vector<Node *> nodes_copy = g.nodes;
-	Node **nodes = nodes_copy.ptrw();
+	Node *const *nodes = nodes_copy.ptr();
 	int node_count = nodes_copy.size();
 
 	call_lock++;
@@ -404,6 +488,9 @@ void SceneTree::initialize() {
 }
 
 bool SceneTree::physics_process(double p_time) {
+	Memory::TagScope memory_tag(Memory::TAG_SCENE);
+	TRACE_ZONE("SceneTree::physics_process");
+
 	root_lock++;
 
 	current_frame++;
@@ -415,9 +502,10 @@ bool SceneTree::physics_process(double p_time) {
 
 	emit_signal(SNAME("physics_frame"));
 
-	_notify_group_pause(SNAME("physics_process_internal"), Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
+	_notify_process_list(PROCESS_LIST_PHYSICS_PROCESS_INTERNAL, Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
+	AnimationTree::flush_pending_processes();
 	call_group_flags(GROUP_CALL_REALTIME, SNAME("_picking_viewports"), SNAME("_process_picking"));
-	_notify_group_pause(SNAME("physics_process"), Node::NOTIFICATION_PHYSICS_PROCESS);
+	_notify_process_list(PROCESS_LIST_PHYSICS_PROCESS, Node::NOTIFICATION_PHYSICS_PROCESS);
 	_flush_ugc();
 	MessageQueue::get_singleton()->flush(); //small little hack
 
@@ -433,6 +521,9 @@ bool SceneTree::physics_process(double p_time) {
 }
 
 bool SceneTree::process(double p_time) {
+	Memory::TagScope memory_tag(Memory::TAG_SCENE);
+	TRACE_ZONE("SceneTree::process");
+
 	root_lock++;
 
 	MainLoop::process(p_time);
@@ -449,8 +540,9 @@ bool SceneTree::process(double p_time) {
 
 	flush_transform_notifications();
 
-	_notify_group_pause(SNAME("process_internal"), Node::NOTIFICATION_INTERNAL_PROCESS);
-	_notify_group_pause(SNAME("process"), Node::NOTIFICATION_PROCESS);
+	_notify_process_list(PROCESS_LIST_PROCESS_INTERNAL, Node::NOTIFICATION_INTERNAL_PROCESS);
+	AnimationTree::flush_pending_processes();
+	_notify_process_list(PROCESS_LIST_PROCESS, Node::NOTIFICATION_PROCESS);
 
 	_flush_ugc();
 	MessageQueue::get_singleton()->flush(); //small little hack
@@ -563,6 +655,11 @@ void SceneTree::finalize() {
 
 	MainLoop::finalize();
 
+	if (scene_pool.is_valid()) {
+		scene_pool->clear();
+		scene_pool.unref();
+	}
+
 	if (root) {
 		root->_set_tree(nullptr);
 		root->_propagate_after_exit_tree();
@@ -818,30 +915,116 @@ bool SceneTree::is_paused() const {
 	return paused;
 }
 
-void SceneTree::_notify_group_pause(const StringName &p_group, int p_notification) {
-	Map<StringName, Group>::Element *E = group_map.find(p_group);
-	if (!E) {
+void SceneTree::_process_thread_node(uint32_t p_index, ThreadedProcessData *p_data) {
+	p_data->nodes[p_index]->notification(p_data->notification);
+}
+
+void SceneTree::_add_to_process_list(ProcessListType p_list, Node *p_node) {
+	int32_t &index = p_node->data.process_list_index[p_list];
+	ERR_FAIL_COND(index != -1);
+
+	ProcessList &list = process_lists[p_list];
+	index = list.nodes.size();
+	list.nodes.push_back(p_node);
+}
+
+void SceneTree::_remove_from_process_list(ProcessListType p_list, Node *p_node) {
+	int32_t &index = p_node->data.process_list_index[p_list];
+	ERR_FAIL_COND(index == -1);
+
+	ProcessList &list = process_lists[p_list];
+	list.nodes[index] = nullptr;
+	list.removed++;
+	index = -1;
+}
+
+void SceneTree::_make_process_list_changed(ProcessListType p_list) {
+	process_lists[p_list].changed = true;
+}
+
+void SceneTree::_update_process_list(ProcessListType p_list) {
+	ProcessList &list = process_lists[p_list];
+	uint32_t size = list.nodes.size();
+	if (list.sorted == size && !list.removed && !list.changed) {
 		return;
 	}
-	Group &g = E->get();
-	if (g.nodes.is_empty()) {
-		return;
+
+	Node **nodes = list.nodes.ptr();
+	uint32_t first_moved = size; // Nodes from here on need their index updated.
+
+	// Drop the empty slots, keeping the order.
+	if (list.removed) {
+		uint32_t to = 0;
+		uint32_t sorted = 0;
+		for (uint32_t from = 0; from < size; from++) {
+			if (!nodes[from]) {
+				first_moved = MIN(first_moved, to);
+				continue;
+			}
+			if (from < list.sorted) {
+				sorted++;
+			}
+			nodes[to++] = nodes[from];
+		}
+		size = to;
+		list.nodes.resize(size);
+		list.sorted = sorted;
+		list.removed = 0;
 	}
 
-	_update_group_order(g, p_notification == Node::NOTIFICATION_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PROCESS || p_notification == Node::NOTIFICATION_PHYSICS_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
+	if (list.changed) {
+		SortArray<Node *, Node::ComparatorWithPriority> node_sort;
+		node_sort.sort(nodes, size);
+		list.changed = false;
+		first_moved = 0;
+	} else if (list.sorted < size) {
+		// Only sort what was added, then merge it into the rest from the back.
+		uint32_t added = size - list.sorted;
+		SortArray<Node *, Node::ComparatorWithPriority> node_sort;
+		node_sort.sort(&nodes[list.sorted], added);
+
+		process_list_merge_buffer.resize(added);
+		Node **merge = process_list_merge_buffer.ptr();
+		memcpy(merge, &nodes[list.sorted], added * sizeof(Node *));
+
+		Node::ComparatorWithPriority compare;
+		int64_t src = int64_t(list.sorted) - 1;
+		int64_t dst = int64_t(size) - 1;
+		int64_t pending = int64_t(added) - 1;
+		while (pending >= 0) {
+			if (src >= 0 && compare(merge[pending], nodes[src])) {
+				nodes[dst--] = nodes[src--];
+			} else {
+				nodes[dst--] = merge[pending--];
+			}
+		}
+		first_moved = MIN(first_moved, uint32_t(src + 1));
+	}
 
-	//copy, so copy on write happens in case something is removed from process while being called
-	//performance is not lost because only if something is added/removed the vector is copied.
-	Vector<Node *> nodes_copy = g.nodes;
+	for (uint32_t i = first_moved; i < size; i++) {
+		nodes[i]->data.process_list_index[p_list] = i;
+	}
+	list.sorted = size;
+}
 
-	int node_count = nodes_copy.size();
-	Node **nodes = nodes_copy.ptrw();
+void SceneTree::_notify_process_list(ProcessListType p_list, int p_notification) {
+	_update_process_list(p_list);
+	ProcessList &list = process_lists[p_list];
 
-	call_lock++;
+	// Nodes added meanwhile are appended past the end and wait for the next frame,
+	// removed ones leave an empty slot behind, so the list can be walked by index.
+	uint32_t node_count = list.nodes.size();
+	if (node_count == 0) {
+		return;
+	}
 
-	for (int i = 0; i < node_count; i++) {
-		Node *n = nodes[i];
-		if (call_lock && call_skip.has(n)) {
+	// Only the script callbacks can run in threads, internal processing always happens here.
+	bool allow_threads = !processing_in_threads && (p_notification == Node::NOTIFICATION_PROCESS || p_notification == Node::NOTIFICATION_PHYSICS_PROCESS);
+	bool has_threaded = false;
+
+	for (uint32_t i = 0; i < node_count; i++) {
+		Node *n = list.nodes[i];
+		if (!n) {
 			continue;
 		}
 
@@ -852,13 +1035,39 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
 			continue;
 		}
 
+		if (allow_threads && n->is_processing_in_thread()) {
+			has_threaded = true;
+			continue;
+		}
+
 		n->notification(p_notification);
-		//ERR_FAIL_COND(node_count != g.nodes.size());
 	}
 
-	call_lock--;
-	if (call_lock == 0) {
-		call_skip.clear();
+	if (!has_threaded) {
+		return;
+	}
+
+	// Nodes processed in threads go after the main thread ones, in no particular order.
+	// They are gathered only now, as the main thread callbacks may have removed some.
+	FrameAllocator::Scope threaded_scope;
+	ThreadedProcessData threaded;
+	threaded.nodes = FrameAllocator::alloc_array<Node *>(node_count);
+	threaded.notification = p_notification;
+	int threaded_count = 0;
+
+	for (uint32_t i = 0; i < node_count; i++) {
+		Node *n = list.nodes[i];
+		if (n && n->is_processing_in_thread() && n->can_process() && n->can_process_notification(p_notification)) {
+			threaded.nodes[threaded_count++] = n;
+		}
+	}
+
+	if (threaded_count) {
+		// The tree is locked meanwhile, changes to it must be deferred.
+		processing_in_threads = true;
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneTree::_process_thread_node, &threaded, threaded_count);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		processing_in_threads = false;
 	}
 }
 
@@ -879,7 +1088,7 @@ void SceneTree::_call_input_pause(const StringName &p_group, CallInputType p_cal
 	Vector<Node *> nodes_copy = g.nodes;
 
 	int node_count = nodes_copy.size();
-	Node **nodes = nodes_copy.ptrw();
+	Node *const *nodes = nodes_copy.ptr();
 
 	call_lock++;
 
@@ -1148,6 +1357,13 @@ Array SceneTree::get_processed_tweens() {
 	return ret;
 }
 
+Ref<ScenePool> SceneTree::get_scene_pool() {
+	if (scene_pool.is_null()) {
+		scene_pool.instantiate();
+	}
+	return scene_pool;
+}
+
 Ref<MultiplayerAPI> SceneTree::get_multiplayer() const {
 	return multiplayer;
 }
@@ -1187,6 +1403,7 @@ void SceneTree::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("create_timer", "time_sec", "process_always"), &SceneTree::create_timer, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("create_tween"), &SceneTree::create_tween);
+	ClassDB::bind_method(D_METHOD("get_scene_pool"), &SceneTree::get_scene_pool);
 	ClassDB::bind_method(D_METHOD("get_processed_tweens"), &SceneTree::get_processed_tweens);
 
 	ClassDB::bind_method(D_METHOD("get_node_count"), &SceneTree::get_node_count);
@@ -1355,6 +1572,19 @@ SceneTree::SceneTree() {
 	const bool use_occlusion_culling = GLOBAL_DEF("rendering/occlusion_culling/use_occlusion_culling", false);
 	root->set_use_occlusion_culling(use_occlusion_culling);
 
+#ifndef _3D_DISABLED
+	const float dynamic_resolution_target_frame_time = GLOBAL_DEF("rendering/3d/viewport/dynamic_resolution/target_frame_time_msec", 16.6);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/3d/viewport/dynamic_resolution/target_frame_time_msec", PropertyInfo(Variant::FLOAT, "rendering/3d/viewport/dynamic_resolution/target_frame_time_msec", PROPERTY_HINT_RANGE, "1,100,0.1"));
+	root->set_dynamic_resolution_target_frame_time(dynamic_resolution_target_frame_time);
+
+	const float dynamic_resolution_min_scale = GLOBAL_DEF("rendering/3d/viewport/dynamic_resolution/min_scale", 0.5);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/3d/viewport/dynamic_resolution/min_scale", PropertyInfo(Variant::FLOAT, "rendering/3d/viewport/dynamic_resolution/min_scale", PROPERTY_HINT_RANGE, "0.25,1.0,0.01"));
+	root->set_dynamic_resolution_min_scale(dynamic_resolution_min_scale);
+
+	const bool dynamic_resolution = GLOBAL_DEF("rendering/3d/viewport/dynamic_resolution/enabled", false);
+	root->set_dynamic_resolution_enabled(dynamic_resolution);
+#endif // _3D_DISABLED
+
 	float lod_threshold = GLOBAL_DEF("rendering/mesh_lod/lod_change/threshold_pixels", 1.0);
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/mesh_lod/lod_change/threshold_pixels", PropertyInfo(Variant::FLOAT, "rendering/mesh_lod/lod_change/threshold_pixels", PROPERTY_HINT_RANGE, "0,1024,0.1"));
 	root->set_lod_threshold(lod_threshold);
@@ -1428,6 +1658,7 @@ SceneTree::SceneTree() {
 #endif // _3D_DISABLED
 
 	root->set_physics_object_picking(GLOBAL_DEF("physics/common/enable_object_picking", true));
+	physics_interpolation = bool(GLOBAL_GET("physics/common/physics_interpolation")) && !Engine::get_singleton()->is_editor_hint();
 
 	root->connect("close_requested", callable_mp(this, &SceneTree::_main_window_close));
 	root->connect("go_back_requested", callable_mp(this, &SceneTree::_main_window_go_back));
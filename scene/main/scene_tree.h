@@ -34,6 +34,7 @@
 #include "core/multiplayer/multiplayer_api.h"
 #include "core/os/main_loop.h"
 #include "core/os/thread_safe.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/self_list.h"
 #include "scene/resources/mesh.h"
 #include "scene/resources/world_2d.h"
@@ -47,6 +48,7 @@ class Window;
 class Material;
 class Mesh;
 class SceneDebugger;
+class ScenePool;
 class Tween;
 
 class SceneTreeTimer : public RefCounted {
@@ -88,6 +90,23 @@ private:
 		bool changed = false;
 	};
 
+	// Nodes with (internal) processing enabled are kept in flat lists rather than groups,
+	// so toggling processing doesn't go through the group map.
+	enum ProcessListType {
+		PROCESS_LIST_PROCESS,
+		PROCESS_LIST_PROCESS_INTERNAL,
+		PROCESS_LIST_PHYSICS_PROCESS,
+		PROCESS_LIST_PHYSICS_PROCESS_INTERNAL,
+		PROCESS_LIST_MAX
+	};
+
+	struct ProcessList {
+		LocalVector<Node *> nodes; // Removed nodes leave a null slot until the next update.
+		uint32_t sorted = 0; // Nodes from this index on were added since the last update and still need to be merged in.
+		uint32_t removed = 0;
+		bool changed = false; // The tree order changed, everything needs sorting again.
+	};
+
 	Window *root = nullptr;
 
 	uint64_t tree_version = 1;
@@ -128,6 +147,8 @@ private:
 	// Safety for when a node is deleted while a group is being called.
 	int call_lock = 0;
 	Set<Node *> call_skip; // Skip erased nodes.
+	bool processing_in_threads = false;
+	bool physics_interpolation = false;
 
 	List<ObjectID> delete_queue;
 
@@ -136,6 +157,13 @@ private:
 	void _flush_ugc();
 
 	_FORCE_INLINE_ void _update_group_order(Group &g, bool p_use_priority = false);
+
+	ProcessList process_lists[PROCESS_LIST_MAX];
+	LocalVector<Node *> process_list_merge_buffer;
+	void _add_to_process_list(ProcessListType p_list, Node *p_node);
+	void _remove_from_process_list(ProcessListType p_list, Node *p_node);
+	void _make_process_list_changed(ProcessListType p_list);
+	void _update_process_list(ProcessListType p_list);
 	void _update_listener();
 
 	Array _get_nodes_in_group(const StringName &p_group);
@@ -157,6 +185,7 @@ private:
 
 	List<Ref<SceneTreeTimer>> timers;
 	List<Ref<Tween>> tweens;
+	Ref<ScenePool> scene_pool;
 
 	///network///
 
@@ -176,7 +205,12 @@ private:
 	void remove_from_group(const StringName &p_group, Node *p_node);
 	void make_group_changed(const StringName &p_group);
 
-	void _notify_group_pause(const StringName &p_group, int p_notification);
+	void _notify_process_list(ProcessListType p_list, int p_notification);
+	struct ThreadedProcessData {
+		Node **nodes = nullptr;
+		int notification = 0;
+	};
+	void _process_thread_node(uint32_t p_index, ThreadedProcessData *p_data);
 	Variant _call_group_flags(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	Variant _call_group(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 
@@ -188,6 +222,14 @@ private:
 
 	SelfList<Node>::List xform_change_list;
 
+	// Visual instance transforms set while flushing transform notifications are sent to the RenderingServer in one call.
+	bool xform_batching = false;
+	Vector<RID> xform_batch_instances;
+	Vector<Transform3D> xform_batch_transforms;
+#ifndef _3D_DISABLED
+	void _update_pending_global_transforms();
+#endif
+
 #ifdef DEBUG_ENABLED // No live editor in release build.
 	friend class LiveEditor;
 #endif
@@ -240,6 +282,7 @@ public:
 	void set_group(const StringName &p_group, const String &p_name, const Variant &p_value);
 
 	void flush_transform_notifications();
+	void set_instance_transform(RID p_instance, const Transform3D &p_transform);
 
 	virtual void initialize() override;
 
@@ -264,6 +307,10 @@ public:
 
 	void set_pause(bool p_enabled);
 	bool is_paused() const;
+	// True while nodes in a sub thread process group run their _process() or _physics_process().
+	_FORCE_INLINE_ bool is_processing_in_threads() const { return processing_in_threads; }
+	// True when 3D nodes should be drawn interpolated between physics ticks.
+	_FORCE_INLINE_ bool is_physics_interpolation_enabled() const { return physics_interpolation; }
 
 	void set_camera(const RID &p_camera);
 	RID get_camera() const;
@@ -327,6 +374,8 @@ public:
 	Ref<Tween> create_tween();
 	Array get_processed_tweens();
 
+	Ref<ScenePool> get_scene_pool();
+
 	//used by Main::start, don't use otherwise
 	void add_current_scene(Node *p_current);
 
@@ -44,6 +44,7 @@
 #include "scene/3d/collision_object_3d.h"
 #include "scene/3d/world_environment.h"
 #endif // _3D_DISABLED
+#include "scene/gui/container.h"
 #include "scene/gui/control.h"
 #include "scene/gui/label.h"
 #include "scene/gui/popup.h"
@@ -548,6 +549,16 @@ void Viewport::_process_picking() {
 		}
 	}
 
+	physics_picking_merged_event.unref();
+
+#ifndef _3D_DISABLED
+	// Kept between events, so events at the same position reuse the ray query of the previous one.
+	Vector2 last_pos(1e20, 1e20);
+	CollisionObject3D *last_object = nullptr;
+	ObjectID last_id;
+	PhysicsDirectSpaceState3D::RayResult result;
+#endif // _3D_DISABLED
+
 	while (physics_picking_events.size()) {
 		Ref<InputEvent> ev = physics_picking_events.front()->get();
 		physics_picking_events.pop_front();
@@ -679,10 +690,6 @@ void Viewport::_process_picking() {
 		}
 
 #ifndef _3D_DISABLED
-		Vector2 last_pos(1e20, 1e20);
-		CollisionObject3D *last_object = nullptr;
-		ObjectID last_id;
-		PhysicsDirectSpaceState3D::RayResult result;
 		bool captured = false;
 
 		if (physics_object_capture.is_valid()) {
@@ -1084,6 +1091,10 @@ Ref<InputEvent> Viewport::_make_input_local(const Ref<InputEvent> &ev) {
 	}
 
 	Transform2D ai = get_final_transform().affine_inverse() * _get_input_pre_xform();
+	if (ai == Transform2D()) {
+		// Nothing to transform (as usual for the root window), so avoid copying the event.
+		return ev;
+	}
 	return ev->xformed_by(ai);
 }
 
@@ -1106,6 +1117,49 @@ void Viewport::_gui_sort_roots() {
 	gui.roots_order_dirty = false;
 }
 
+void Viewport::_gui_queue_sort(Container *p_container) {
+	gui.pending_sorts.push_back(p_container);
+	if (!gui.sort_flush_queued) {
+		MessageQueue::get_singleton()->push_callable(callable_mp(this, &Viewport::_gui_flush_sorts));
+		gui.sort_flush_queued = true;
+	}
+}
+
+void Viewport::_gui_unqueue_sort(Container *p_container) {
+	gui.pending_sorts.erase(p_container);
+	int64_t idx = gui.flushing_sorts.find(p_container);
+	if (idx >= 0) {
+		gui.flushing_sorts[idx] = nullptr;
+	}
+}
+
+struct _ContainerTreeOrder {
+	_FORCE_INLINE_ bool operator()(const Container *p_a, const Container *p_b) const {
+		return p_b->is_greater_than(p_a);
+	}
+};
+
+void Viewport::_gui_flush_sorts() {
+	gui.sort_flush_queued = false;
+
+	// Sort parents before their children. A child resized by its parent's
+	// sort is already pending, so it's sorted once, with its final size.
+	// Containers queued again meanwhile (e.g. from a minimum size change) are
+	// done in the next round.
+	while (gui.pending_sorts.size()) {
+		SWAP(gui.flushing_sorts, gui.pending_sorts);
+		gui.flushing_sorts.sort_custom<_ContainerTreeOrder>();
+
+		for (uint32_t i = 0; i < gui.flushing_sorts.size(); i++) {
+			Container *container = gui.flushing_sorts[i];
+			if (container) {
+				container->_sort_children();
+			}
+		}
+		gui.flushing_sorts.clear();
+	}
+}
+
 void Viewport::_gui_cancel_tooltip() {
 	gui.tooltip_control = nullptr;
 	if (gui.tooltip_timer.is_valid()) {
@@ -2718,17 +2772,40 @@ void Viewport::push_unhandled_input(const Ref<InputEvent> &p_event, bool p_local
 						Object::cast_to<InputEventKey>(*ev) // To remember state.
 
 						)) {
-			physics_picking_events.push_back(ev);
+			_push_picking_event(ev);
 		}
 	}
 }
 
+void Viewport::_push_picking_event(const Ref<InputEvent> &p_event) {
+	// Consecutive motion of the same pointer is merged, so picking does one query for all of it instead of
+	// one per event, like Input does with accumulated input.
+	if (!physics_picking_events.is_empty() && p_event->get_device() == physics_picking_events.back()->get()->get_device() &&
+			(Object::cast_to<InputEventMouseMotion>(*p_event) || Object::cast_to<InputEventScreenDrag>(*p_event))) {
+		Ref<InputEvent> &last = physics_picking_events.back()->get();
+		if (last != physics_picking_merged_event) {
+			// The queued event is shared with the rest of input handling, so only a copy can be modified.
+			Ref<InputEvent> merged = last->duplicate();
+			if (merged->accumulate(p_event)) {
+				last = merged;
+				physics_picking_merged_event = merged;
+				return;
+			}
+		} else if (last->accumulate(p_event)) {
+			return;
+		}
+	}
+
+	physics_picking_events.push_back(p_event);
+}
+
 void Viewport::set_physics_object_picking(bool p_enable) {
 	physics_object_picking = p_enable;
 	if (physics_object_picking) {
 		add_to_group("_picking_viewports");
 	} else {
 		physics_picking_events.clear();
+		physics_picking_merged_event.unref();
 		if (is_in_group("_picking_viewports")) {
 			remove_from_group("_picking_viewports");
 		}
@@ -3467,6 +3544,46 @@ float Viewport::get_scale_3d() const {
 	return scale_3d;
 }
 
+void Viewport::_update_dynamic_resolution() {
+	RS::get_singleton()->viewport_set_dynamic_resolution(viewport, dynamic_resolution_enabled, dynamic_resolution_target_frame_time, dynamic_resolution_min_scale);
+}
+
+void Viewport::set_dynamic_resolution_enabled(bool p_enabled) {
+	if (dynamic_resolution_enabled == p_enabled) {
+		return;
+	}
+
+	dynamic_resolution_enabled = p_enabled;
+	_update_dynamic_resolution();
+}
+
+bool Viewport::is_dynamic_resolution_enabled() const {
+	return dynamic_resolution_enabled;
+}
+
+void Viewport::set_dynamic_resolution_target_frame_time(float p_msec) {
+	ERR_FAIL_COND(p_msec <= 0.0);
+	dynamic_resolution_target_frame_time = p_msec;
+	_update_dynamic_resolution();
+}
+
+float Viewport::get_dynamic_resolution_target_frame_time() const {
+	return dynamic_resolution_target_frame_time;
+}
+
+void Viewport::set_dynamic_resolution_min_scale(float p_scale) {
+	dynamic_resolution_min_scale = CLAMP(p_scale, 0.1, 1.0);
+	_update_dynamic_resolution();
+}
+
+float Viewport::get_dynamic_resolution_min_scale() const {
+	return dynamic_resolution_min_scale;
+}
+
+float Viewport::get_dynamic_resolution_scale() const {
+	return RS::get_singleton()->viewport_get_dynamic_resolution_scale(viewport);
+}
+
 #endif // _3D_DISABLED
 
 void Viewport::_bind_methods() {
@@ -3594,9 +3711,22 @@ void Viewport::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_scale_3d", "scale"), &Viewport::set_scale_3d);
 	ClassDB::bind_method(D_METHOD("get_scale_3d"), &Viewport::get_scale_3d);
 
+	ClassDB::bind_method(D_METHOD("set_dynamic_resolution_enabled", "enable"), &Viewport::set_dynamic_resolution_enabled);
+	ClassDB::bind_method(D_METHOD("is_dynamic_resolution_enabled"), &Viewport::is_dynamic_resolution_enabled);
+	ClassDB::bind_method(D_METHOD("set_dynamic_resolution_target_frame_time", "msec"), &Viewport::set_dynamic_resolution_target_frame_time);
+	ClassDB::bind_method(D_METHOD("get_dynamic_resolution_target_frame_time"), &Viewport::get_dynamic_resolution_target_frame_time);
+	ClassDB::bind_method(D_METHOD("set_dynamic_resolution_min_scale", "scale"), &Viewport::set_dynamic_resolution_min_scale);
+	ClassDB::bind_method(D_METHOD("get_dynamic_resolution_min_scale"), &Viewport::get_dynamic_resolution_min_scale);
+	ClassDB::bind_method(D_METHOD("get_dynamic_resolution_scale"), &Viewport::get_dynamic_resolution_scale);
+
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "disable_3d"), "set_disable_3d", "is_3d_disabled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_xr"), "set_use_xr", "is_using_xr");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "scale_3d", PROPERTY_HINT_RANGE, "0.25,2.0,0.01"), "set_scale_3d", "get_scale_3d");
+	ADD_GROUP("Dynamic Resolution", "dynamic_resolution_");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "dynamic_resolution_enabled"), "set_dynamic_resolution_enabled", "is_dynamic_resolution_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "dynamic_resolution_target_frame_time", PROPERTY_HINT_RANGE, "1,100,0.1,suffix:ms"), "set_dynamic_resolution_target_frame_time", "get_dynamic_resolution_target_frame_time");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "dynamic_resolution_min_scale", PROPERTY_HINT_RANGE, "0.25,1.0,0.01"), "set_dynamic_resolution_min_scale", "get_dynamic_resolution_min_scale");
+	ADD_GROUP("", "");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "audio_listener_enable_3d"), "set_as_audio_listener_3d", "is_audio_listener_3d");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "own_world_3d"), "set_use_own_world_3d", "is_using_own_world_3d");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "world_3d", PROPERTY_HINT_RESOURCE_TYPE, "World3D"), "set_world_3d", "get_world_3d");
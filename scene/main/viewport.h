@@ -31,6 +31,7 @@
 #ifndef VIEWPORT_H
 #define VIEWPORT_H
 
+#include "core/templates/local_vector.h"
 #include "scene/main/node.h"
 #include "scene/resources/texture.h"
 
@@ -45,6 +46,7 @@ class AudioListener2D;
 class Camera2D;
 class CanvasItem;
 class CanvasLayer;
+class Container;
 class Control;
 class Label;
 class SceneTreeTimer;
@@ -232,6 +234,7 @@ private:
 
 	bool physics_object_picking = false;
 	List<Ref<InputEvent>> physics_picking_events;
+	Ref<InputEvent> physics_picking_merged_event; // Copy owned by the viewport at the back of the picking events, motion is merged into it.
 	ObjectID physics_object_capture;
 	ObjectID physics_object_over;
 	Transform3D physics_last_object_transform;
@@ -361,6 +364,11 @@ private:
 		Rect2i subwindow_resize_from_rect;
 
 		Vector<SubWindow> sub_windows;
+
+		// Containers waiting for a sort, resolved in tree order by _gui_flush_sorts().
+		LocalVector<Container *> pending_sorts;
+		LocalVector<Container *> flushing_sorts;
+		bool sort_flush_queued = false;
 	} gui;
 
 	DefaultCanvasItemTextureFilter default_canvas_item_texture_filter = DEFAULT_CANVAS_ITEM_TEXTURE_FILTER_LINEAR;
@@ -381,6 +389,11 @@ private:
 	Ref<InputEvent> _make_input_local(const Ref<InputEvent> &ev);
 
 	friend class Control;
+	friend class Container;
+
+	void _gui_queue_sort(Container *p_container);
+	void _gui_unqueue_sort(Container *p_container);
+	void _gui_flush_sorts();
 
 	List<Control *>::Element *_gui_add_root_control(Control *p_control);
 
@@ -450,6 +463,7 @@ protected:
 
 	void _notification(int p_what);
 	void _process_picking();
+	void _push_picking_event(const Ref<InputEvent> &p_event);
 	static void _bind_methods();
 
 public:
@@ -585,6 +599,10 @@ public:
 #ifndef _3D_DISABLED
 	bool use_xr = false;
 	float scale_3d = 1.0;
+	bool dynamic_resolution_enabled = false;
+	float dynamic_resolution_target_frame_time = 16.6;
+	float dynamic_resolution_min_scale = 0.5;
+	void _update_dynamic_resolution();
 	friend class AudioListener3D;
 	AudioListener3D *audio_listener_3d = nullptr;
 	Set<AudioListener3D *> audio_listener_3d_set;
@@ -658,6 +676,14 @@ public:
 
 	void set_scale_3d(float p_scale_3d);
 	float get_scale_3d() const;
+
+	void set_dynamic_resolution_enabled(bool p_enabled);
+	bool is_dynamic_resolution_enabled() const;
+	void set_dynamic_resolution_target_frame_time(float p_msec);
+	float get_dynamic_resolution_target_frame_time() const;
+	void set_dynamic_resolution_min_scale(float p_scale);
+	float get_dynamic_resolution_min_scale() const;
+	float get_dynamic_resolution_scale() const;
 #endif // _3D_DISABLED
 
 	Viewport();
@@ -33,6 +33,101 @@
 #include "core/math/geometry_3d.h"
 #include "scene/scene_string_names.h"
 
+// Longest run of frames between two compressed keys, bounds the cost of the key reduction.
+#define COMPRESSION_MAX_SEGMENT_FRAMES 64
+
+static _FORCE_INLINE_ real_t _compression_error(const Vector3 &p_a, const Vector3 &p_b) {
+	return p_a.distance_to(p_b);
+}
+
+static _FORCE_INLINE_ real_t _compression_error(const Quaternion &p_a, const Quaternion &p_b) {
+	return p_a.angle_to(p_b);
+}
+
+static _FORCE_INLINE_ real_t _compression_error(float p_a, float p_b) {
+	return Math::abs(p_a - p_b);
+}
+
+static _FORCE_INLINE_ Vector3 _compression_interpolate(const Vector3 &p_a, const Vector3 &p_b, real_t p_c) {
+	return p_a.lerp(p_b, p_c);
+}
+
+static _FORCE_INLINE_ Quaternion _compression_interpolate(const Quaternion &p_a, const Quaternion &p_b, real_t p_c) {
+	return p_a.slerp(p_b, p_c);
+}
+
+static _FORCE_INLINE_ float _compression_interpolate(float p_a, float p_b, real_t p_c) {
+	return Math::lerp(p_a, p_b, float(p_c));
+}
+
+// Value of the reduced curve at a frame, the segment cursor only moves forward.
+template <class T>
+static T _compression_curve_value(const LocalVector<T> &p_samples, const LocalVector<uint32_t> &p_key_frames, uint32_t p_frame, uint32_t &r_segment) {
+	while (r_segment + 1 < p_key_frames.size() && p_key_frames[r_segment + 1] <= p_frame) {
+		r_segment++;
+	}
+	const uint32_t from = p_key_frames[r_segment];
+	if (r_segment + 1 == p_key_frames.size() || from == p_frame) {
+		return p_samples[from];
+	}
+	const uint32_t to = p_key_frames[r_segment + 1];
+	return _compression_interpolate(p_samples[from], p_samples[to], real_t(p_frame - from) / (to - from));
+}
+
+static _FORCE_INLINE_ uint16_t _compression_quantize(float p_value, float p_offset, float p_scale) {
+	if (p_scale == 0) {
+		return 0;
+	}
+	return CLAMP(Math::round((p_value - p_offset) / p_scale), 0.0f, 65535.0f);
+}
+
+static _FORCE_INLINE_ Vector3 _compression_decode_vector3(const float *p_offset, const float *p_scale, const uint16_t *p_value) {
+	return Vector3(p_offset[0] + p_scale[0] * p_value[0], p_offset[1] + p_scale[1] * p_value[1], p_offset[2] + p_scale[2] * p_value[2]);
+}
+
+// Rotations keep their three smallest components in 15 bits each, the
+// largest one follows from them. Its index goes in the top bits of the
+// first two values.
+static void _compression_encode_rotation(const Quaternion &p_rotation, uint16_t *r_value) {
+	const Quaternion rotation = p_rotation.normalized();
+	real_t components[4] = { rotation.x, rotation.y, rotation.z, rotation.w };
+	int largest = 0;
+	for (int i = 1; i < 4; i++) {
+		if (Math::abs(components[i]) > Math::abs(components[largest])) {
+			largest = i;
+		}
+	}
+	const real_t sign = components[largest] < 0 ? -1.0 : 1.0;
+
+	int j = 0;
+	for (int i = 0; i < 4; i++) {
+		if (i == largest) {
+			continue;
+		}
+		// The other components are within [-sqrt(1/2), sqrt(1/2)].
+		const real_t unit = (components[i] * sign * Math_SQRT2 + 1.0) * 0.5;
+		r_value[j++] = CLAMP(Math::round(unit * 32767.0), 0.0, 32767.0);
+	}
+	r_value[0] |= (largest & 1) << 15;
+	r_value[1] |= (largest >> 1) << 15;
+}
+
+static Quaternion _compression_decode_rotation(const uint16_t *p_value) {
+	const int largest = (p_value[0] >> 15) | ((p_value[1] >> 15) << 1);
+	real_t components[4];
+	real_t sum = 0.0;
+	int j = 0;
+	for (int i = 0; i < 4; i++) {
+		if (i == largest) {
+			continue;
+		}
+		components[i] = ((p_value[j++] & 0x7FFF) * (2.0 / 32767.0) - 1.0) * Math_SQRT12;
+		sum += components[i] * components[i];
+	}
+	components[largest] = Math::sqrt(MAX(1.0 - sum, 0.0));
+	return Quaternion(components[0], components[1], components[2], components[3]).normalized();
+}
+
 bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 	String name = p_name;
 
@@ -80,6 +175,11 @@ bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 			track_set_imported(track, p_value);
 		} else if (what == "enabled") {
 			track_set_enabled(track, p_value);
+		} else if (what == "compressed_track") {
+			int compressed_track = p_value;
+			ERR_FAIL_COND_V(compressed_track < 0, false);
+			ERR_FAIL_COND_V(tracks[track]->type < TYPE_POSITION_3D || tracks[track]->type > TYPE_BLEND_SHAPE, false);
+			tracks[track]->compressed_track = compressed_track;
 		} else if (what == "keys" || what == "key_values") {
 			if (track_get_type(track) == TYPE_POSITION_3D) {
 				PositionTrack *tt = static_cast<PositionTrack *>(tracks[track]);
@@ -359,6 +459,22 @@ bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 		} else {
 			return false;
 		}
+	} else if (name == "_compression") {
+		Dictionary comp = p_value;
+		ERR_FAIL_COND_V(!comp.has("fps") || !comp.has("page_frames") || !comp.has("track_count") || !comp.has("pages"), false);
+		Array pages = comp["pages"];
+		Compression new_compression;
+		new_compression.fps = comp["fps"];
+		new_compression.page_frames = comp["page_frames"];
+		new_compression.track_count = comp["track_count"];
+		ERR_FAIL_COND_V(new_compression.fps == 0 || new_compression.page_frames == 0 || pages.is_empty(), false);
+		new_compression.pages.resize(pages.size());
+		for (int i = 0; i < pages.size(); i++) {
+			Vector<uint8_t> page = pages[i];
+			ERR_FAIL_COND_V(uint32_t(page.size()) < new_compression.track_count * sizeof(CompressedTrackHeader), false);
+			new_compression.pages.write[i] = page;
+		}
+		compression = new_compression;
 	} else {
 		return false;
 	}
@@ -422,6 +538,8 @@ bool Animation::_get(const StringName &p_name, Variant &r_ret) const {
 			r_ret = track_is_imported(track);
 		} else if (what == "enabled") {
 			r_ret = track_is_enabled(track);
+		} else if (what == "compressed_track") {
+			r_ret = tracks[track]->compressed_track;
 		} else if (what == "keys") {
 			if (track_get_type(track) == TYPE_POSITION_3D) {
 				Vector<real_t> keys;
@@ -684,6 +802,18 @@ bool Animation::_get(const StringName &p_name, Variant &r_ret) const {
 		} else {
 			return false;
 		}
+	} else if (name == "_compression") {
+		ERR_FAIL_COND_V(compression.track_count == 0, false);
+		Dictionary comp;
+		comp["fps"] = compression.fps;
+		comp["page_frames"] = compression.page_frames;
+		comp["track_count"] = compression.track_count;
+		Array pages;
+		for (int i = 0; i < compression.pages.size(); i++) {
+			pages.push_back(compression.pages[i]);
+		}
+		comp["pages"] = pages;
+		r_ret = comp;
 	} else {
 		return false;
 	}
@@ -692,6 +822,9 @@ bool Animation::_get(const StringName &p_name, Variant &r_ret) const {
 }
 
 void Animation::_get_property_list(List<PropertyInfo> *p_list) const {
+	if (compression.track_count > 0) {
+		p_list->push_back(PropertyInfo(Variant::DICTIONARY, "_compression", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+	}
 	for (int i = 0; i < tracks.size(); i++) {
 		p_list->push_back(PropertyInfo(Variant::STRING, "tracks/" + itos(i) + "/type", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::NODE_PATH, "tracks/" + itos(i) + "/path", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
@@ -699,7 +832,11 @@ void Animation::_get_property_list(List<PropertyInfo> *p_list) const {
 		p_list->push_back(PropertyInfo(Variant::BOOL, "tracks/" + itos(i) + "/loop_wrap", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::BOOL, "tracks/" + itos(i) + "/imported", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::BOOL, "tracks/" + itos(i) + "/enabled", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
-		p_list->push_back(PropertyInfo(Variant::ARRAY, "tracks/" + itos(i) + "/keys", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+		if (tracks[i]->compressed_track >= 0) {
+			p_list->push_back(PropertyInfo(Variant::INT, "tracks/" + itos(i) + "/compressed_track", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+		} else {
+			p_list->push_back(PropertyInfo(Variant::ARRAY, "tracks/" + itos(i) + "/keys", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NOEDITOR | PROPERTY_USAGE_INTERNAL));
+		}
 	}
 }
 
@@ -904,6 +1041,7 @@ int Animation::position_track_insert_key(int p_track, double p_time, const Vecto
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), -1);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_POSITION_3D, -1);
+	ERR_FAIL_COND_V_MSG(t->compressed_track >= 0, -1, "Compressed tracks can't be edited.");
 
 	PositionTrack *tt = static_cast<PositionTrack *>(t);
 
@@ -922,6 +1060,14 @@ Error Animation::position_track_get_key(int p_track, int p_key, Vector3 *r_posit
 
 	PositionTrack *tt = static_cast<PositionTrack *>(t);
 	ERR_FAIL_COND_V(t->type != TYPE_POSITION_3D, ERR_INVALID_PARAMETER);
+
+	if (t->compressed_track >= 0) {
+		Variant value = _compressed_track_get_key_value(t, p_key);
+		ERR_FAIL_COND_V(value.get_type() == Variant::NIL, ERR_INVALID_PARAMETER);
+		*r_position = value;
+		return OK;
+	}
+
 	ERR_FAIL_INDEX_V(p_key, tt->positions.size(), ERR_INVALID_PARAMETER);
 
 	*r_position = tt->positions[p_key].value;
@@ -936,6 +1082,18 @@ Error Animation::position_track_interpolate(int p_track, double p_time, Vector3
 
 	PositionTrack *tt = static_cast<PositionTrack *>(t);
 
+	if (t->compressed_track >= 0) {
+		const CompressedTrackHeader *header = nullptr;
+		const uint16_t *from = nullptr;
+		const uint16_t *to = nullptr;
+		real_t c = 0.0;
+		if (!_compressed_track_find_keys(t->compressed_track, 3, p_time, &header, &from, &to, &c)) {
+			return ERR_UNAVAILABLE;
+		}
+		*r_interpolation = _compression_decode_vector3(header->offset, header->scale, from).lerp(_compression_decode_vector3(header->offset, header->scale, to), c);
+		return OK;
+	}
+
 	bool ok = false;
 
 	Vector3 tk = _interpolate(tt->positions, p_time, tt->interpolation, tt->loop_wrap, &ok);
@@ -953,6 +1111,7 @@ int Animation::rotation_track_insert_key(int p_track, double p_time, const Quate
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), -1);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_ROTATION_3D, -1);
+	ERR_FAIL_COND_V_MSG(t->compressed_track >= 0, -1, "Compressed tracks can't be edited.");
 
 	RotationTrack *rt = static_cast<RotationTrack *>(t);
 
@@ -971,6 +1130,14 @@ Error Animation::rotation_track_get_key(int p_track, int p_key, Quaternion *r_ro
 
 	RotationTrack *rt = static_cast<RotationTrack *>(t);
 	ERR_FAIL_COND_V(t->type != TYPE_ROTATION_3D, ERR_INVALID_PARAMETER);
+
+	if (t->compressed_track >= 0) {
+		Variant value = _compressed_track_get_key_value(t, p_key);
+		ERR_FAIL_COND_V(value.get_type() == Variant::NIL, ERR_INVALID_PARAMETER);
+		*r_rotation = value;
+		return OK;
+	}
+
 	ERR_FAIL_INDEX_V(p_key, rt->rotations.size(), ERR_INVALID_PARAMETER);
 
 	*r_rotation = rt->rotations[p_key].value;
@@ -985,6 +1152,18 @@ Error Animation::rotation_track_interpolate(int p_track, double p_time, Quaterni
 
 	RotationTrack *rt = static_cast<RotationTrack *>(t);
 
+	if (t->compressed_track >= 0) {
+		const CompressedTrackHeader *header = nullptr;
+		const uint16_t *from = nullptr;
+		const uint16_t *to = nullptr;
+		real_t c = 0.0;
+		if (!_compressed_track_find_keys(t->compressed_track, 3, p_time, &header, &from, &to, &c)) {
+			return ERR_UNAVAILABLE;
+		}
+		*r_interpolation = _compression_decode_rotation(from).slerp(_compression_decode_rotation(to), c);
+		return OK;
+	}
+
 	bool ok = false;
 
 	Quaternion tk = _interpolate(rt->rotations, p_time, rt->interpolation, rt->loop_wrap, &ok);
@@ -1002,6 +1181,7 @@ int Animation::scale_track_insert_key(int p_track, double p_time, const Vector3
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), -1);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_SCALE_3D, -1);
+	ERR_FAIL_COND_V_MSG(t->compressed_track >= 0, -1, "Compressed tracks can't be edited.");
 
 	ScaleTrack *st = static_cast<ScaleTrack *>(t);
 
@@ -1020,6 +1200,14 @@ Error Animation::scale_track_get_key(int p_track, int p_key, Vector3 *r_scale) c
 
 	ScaleTrack *st = static_cast<ScaleTrack *>(t);
 	ERR_FAIL_COND_V(t->type != TYPE_SCALE_3D, ERR_INVALID_PARAMETER);
+
+	if (t->compressed_track >= 0) {
+		Variant value = _compressed_track_get_key_value(t, p_key);
+		ERR_FAIL_COND_V(value.get_type() == Variant::NIL, ERR_INVALID_PARAMETER);
+		*r_scale = value;
+		return OK;
+	}
+
 	ERR_FAIL_INDEX_V(p_key, st->scales.size(), ERR_INVALID_PARAMETER);
 
 	*r_scale = st->scales[p_key].value;
@@ -1034,6 +1222,18 @@ Error Animation::scale_track_interpolate(int p_track, double p_time, Vector3 *r_
 
 	ScaleTrack *st = static_cast<ScaleTrack *>(t);
 
+	if (t->compressed_track >= 0) {
+		const CompressedTrackHeader *header = nullptr;
+		const uint16_t *from = nullptr;
+		const uint16_t *to = nullptr;
+		real_t c = 0.0;
+		if (!_compressed_track_find_keys(t->compressed_track, 3, p_time, &header, &from, &to, &c)) {
+			return ERR_UNAVAILABLE;
+		}
+		*r_interpolation = _compression_decode_vector3(header->offset, header->scale, from).lerp(_compression_decode_vector3(header->offset, header->scale, to), c);
+		return OK;
+	}
+
 	bool ok = false;
 
 	Vector3 tk = _interpolate(st->scales, p_time, st->interpolation, st->loop_wrap, &ok);
@@ -1049,6 +1249,7 @@ int Animation::blend_shape_track_insert_key(int p_track, double p_time, float p_
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), -1);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_BLEND_SHAPE, -1);
+	ERR_FAIL_COND_V_MSG(t->compressed_track >= 0, -1, "Compressed tracks can't be edited.");
 
 	BlendShapeTrack *st = static_cast<BlendShapeTrack *>(t);
 
@@ -1067,6 +1268,14 @@ Error Animation::blend_shape_track_get_key(int p_track, int p_key, float *r_blen
 
 	BlendShapeTrack *st = static_cast<BlendShapeTrack *>(t);
 	ERR_FAIL_COND_V(t->type != TYPE_BLEND_SHAPE, ERR_INVALID_PARAMETER);
+
+	if (t->compressed_track >= 0) {
+		Variant value = _compressed_track_get_key_value(t, p_key);
+		ERR_FAIL_COND_V(value.get_type() == Variant::NIL, ERR_INVALID_PARAMETER);
+		*r_blend_shape = value;
+		return OK;
+	}
+
 	ERR_FAIL_INDEX_V(p_key, st->blend_shapes.size(), ERR_INVALID_PARAMETER);
 
 	*r_blend_shape = st->blend_shapes[p_key].value;
@@ -1081,6 +1290,18 @@ Error Animation::blend_shape_track_interpolate(int p_track, double p_time, float
 
 	BlendShapeTrack *st = static_cast<BlendShapeTrack *>(t);
 
+	if (t->compressed_track >= 0) {
+		const CompressedTrackHeader *header = nullptr;
+		const uint16_t *from = nullptr;
+		const uint16_t *to = nullptr;
+		real_t c = 0.0;
+		if (!_compressed_track_find_keys(t->compressed_track, 1, p_time, &header, &from, &to, &c)) {
+			return ERR_UNAVAILABLE;
+		}
+		*r_interpolation = header->offset[0] + header->scale[0] * Math::lerp(float(from[0]), float(to[0]), float(c));
+		return OK;
+	}
+
 	bool ok = false;
 
 	float tk = _interpolate(st->blend_shapes, p_time, st->interpolation, st->loop_wrap, &ok);
@@ -1101,6 +1322,7 @@ void Animation::track_remove_key_at_time(int p_track, double p_time) {
 void Animation::track_remove_key(int p_track, int p_idx) {
 	ERR_FAIL_INDEX(p_track, tracks.size());
 	Track *t = tracks[p_track];
+	ERR_FAIL_COND_MSG(t->compressed_track >= 0, "Compressed tracks can't be edited.");
 
 	switch (t->type) {
 		case TYPE_POSITION_3D: {
@@ -1165,6 +1387,9 @@ void Animation::track_remove_key(int p_track, int p_idx) {
 int Animation::track_find_key(int p_track, double p_time, bool p_exact) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), -1);
 	Track *t = tracks[p_track];
+	if (t->compressed_track >= 0) {
+		return _compressed_track_find_key(t->compressed_track, p_time, p_exact);
+	}
 
 	switch (t->type) {
 		case TYPE_POSITION_3D: {
@@ -1388,6 +1613,9 @@ void Animation::track_insert_key(int p_track, double p_time, const Variant &p_ke
 int Animation::track_get_key_count(int p_track) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), -1);
 	Track *t = tracks[p_track];
+	if (t->compressed_track >= 0) {
+		return _compressed_track_get_key_count(t->compressed_track);
+	}
 
 	switch (t->type) {
 		case TYPE_POSITION_3D: {
@@ -1435,6 +1663,9 @@ int Animation::track_get_key_count(int p_track) const {
 Variant Animation::track_get_key_value(int p_track, int p_key_idx) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), Variant());
 	Track *t = tracks[p_track];
+	if (t->compressed_track >= 0) {
+		return _compressed_track_get_key_value(t, p_key_idx);
+	}
 
 	switch (t->type) {
 		case TYPE_POSITION_3D: {
@@ -1516,6 +1747,13 @@ Variant Animation::track_get_key_value(int p_track, int p_key_idx) const {
 double Animation::track_get_key_time(int p_track, int p_key_idx) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), -1);
 	Track *t = tracks[p_track];
+	if (t->compressed_track >= 0) {
+		const CompressedTrackHeader *header = nullptr;
+		const uint16_t *value = nullptr;
+		double time = 0.0;
+		ERR_FAIL_COND_V(!_compressed_track_get_key(t->compressed_track, 0, p_key_idx, &header, &value, &time), -1);
+		return time;
+	}
 
 	switch (t->type) {
 		case TYPE_POSITION_3D: {
@@ -1576,6 +1814,7 @@ double Animation::track_get_key_time(int p_track, int p_key_idx) const {
 void Animation::track_set_key_time(int p_track, int p_key_idx, double p_time) {
 	ERR_FAIL_INDEX(p_track, tracks.size());
 	Track *t = tracks[p_track];
+	ERR_FAIL_COND_MSG(t->compressed_track >= 0, "Compressed tracks can't be edited.");
 
 	switch (t->type) {
 		case TYPE_POSITION_3D: {
@@ -1667,6 +1906,9 @@ void Animation::track_set_key_time(int p_track, int p_key_idx, double p_time) {
 real_t Animation::track_get_key_transition(int p_track, int p_key_idx) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), -1);
 	Track *t = tracks[p_track];
+	if (t->compressed_track >= 0) {
+		return 1.0;
+	}
 
 	switch (t->type) {
 		case TYPE_POSITION_3D: {
@@ -1718,6 +1960,7 @@ real_t Animation::track_get_key_transition(int p_track, int p_key_idx) const {
 void Animation::track_set_key_value(int p_track, int p_key_idx, const Variant &p_value) {
 	ERR_FAIL_INDEX(p_track, tracks.size());
 	Track *t = tracks[p_track];
+	ERR_FAIL_COND_MSG(t->compressed_track >= 0, "Compressed tracks can't be edited.");
 
 	switch (t->type) {
 		case TYPE_POSITION_3D: {
@@ -1816,6 +2059,7 @@ void Animation::track_set_key_value(int p_track, int p_key_idx, const Variant &p
 void Animation::track_set_key_transition(int p_track, int p_key_idx, real_t p_transition) {
 	ERR_FAIL_INDEX(p_track, tracks.size());
 	Track *t = tracks[p_track];
+	ERR_FAIL_COND_MSG(t->compressed_track >= 0, "Compressed tracks can't be edited.");
 
 	switch (t->type) {
 		case TYPE_POSITION_3D: {
@@ -3110,6 +3354,10 @@ void Animation::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("clear"), &Animation::clear);
 	ClassDB::bind_method(D_METHOD("copy_track", "track_idx", "to_animation"), &Animation::copy_track);
 
+	ClassDB::bind_method(D_METHOD("compress", "page_size", "fps", "allowed_linear_error", "allowed_angular_error"), &Animation::compress, DEFVAL(8192), DEFVAL(120), DEFVAL(0.001), DEFVAL(0.001));
+	ClassDB::bind_method(D_METHOD("is_compressed"), &Animation::is_compressed);
+	ClassDB::bind_method(D_METHOD("track_is_compressed", "track_idx"), &Animation::track_is_compressed);
+
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "length", PROPERTY_HINT_RANGE, "0.001,99999,0.001"), "set_length", "get_length");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "loop"), "set_loop", "has_loop");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "step", PROPERTY_HINT_RANGE, "0,4096,0.001"), "set_step", "get_step");
@@ -3143,6 +3391,7 @@ void Animation::clear() {
 	tracks.clear();
 	loop = false;
 	length = 1;
+	compression = Compression();
 	emit_changed();
 	emit_signal(SceneStringNames::get_singleton()->tracks_changed);
 }
@@ -3459,6 +3708,372 @@ void Animation::optimize(real_t p_allowed_linear_err, real_t p_allowed_angular_e
 	}
 }
 
+template <class T>
+void Animation::_compress_track_keys(const Vector<TKey<T>> &p_keys, InterpolationType p_interp, bool p_loop_wrap, uint32_t p_fps, uint32_t p_frame_count, real_t p_allowed_error, LocalVector<T> &r_samples, LocalVector<uint32_t> &r_key_frames) const {
+	// Resample the track at a fixed rate, cubic interpolation and loop
+	// wrapping included, the compressed keys are only interpolated linearly.
+	r_samples.resize(p_frame_count);
+	for (uint32_t i = 0; i < p_frame_count; i++) {
+		r_samples[i] = _interpolate(p_keys, MIN(double(i) / p_fps, double(length)), p_interp, p_loop_wrap, nullptr);
+	}
+
+	r_key_frames.clear();
+	r_key_frames.push_back(0);
+
+	bool constant = true;
+	for (uint32_t i = 1; i < p_frame_count && constant; i++) {
+		constant = _compression_error(r_samples[i], r_samples[0]) <= p_allowed_error;
+	}
+	if (constant) {
+		// A single key.
+		return;
+	}
+
+	// Extend every segment while interpolating between its ends stays within
+	// the allowed error of all the samples it covers.
+	uint32_t from = 0;
+	while (from + 1 < p_frame_count) {
+		uint32_t to = from + 1;
+		while (to + 1 < p_frame_count && to + 1 - from <= COMPRESSION_MAX_SEGMENT_FRAMES) {
+			const uint32_t next = to + 1;
+			bool fits = true;
+			for (uint32_t i = from + 1; i < next && fits; i++) {
+				const T value = _compression_interpolate(r_samples[from], r_samples[next], real_t(i - from) / (next - from));
+				fits = _compression_error(value, r_samples[i]) <= p_allowed_error;
+			}
+			if (!fits) {
+				break;
+			}
+			to = next;
+		}
+		r_key_frames.push_back(to);
+		from = to;
+	}
+}
+
+void Animation::compress(uint32_t p_page_size, uint32_t p_fps, real_t p_allowed_linear_err, real_t p_allowed_angular_err) {
+	ERR_FAIL_COND(p_fps == 0);
+	ERR_FAIL_COND_MSG(compression.track_count > 0, "The animation is already compressed.");
+
+	struct TrackKeys {
+		Track *track = nullptr;
+		uint32_t components = 3;
+		LocalVector<Vector3> vectors; // Positions, scales and blend shapes (in x).
+		LocalVector<Quaternion> rotations;
+		LocalVector<uint32_t> key_frames;
+		uint32_t segment = 0;
+	};
+
+	const uint32_t last_frame = uint32_t(Math::ceil(length * p_fps));
+	const uint32_t frame_count = last_frame + 1;
+
+	LocalVector<TrackKeys> track_keys;
+	uint64_t total_size = 0;
+
+	for (int i = 0; i < tracks.size(); i++) {
+		Track *t = tracks[i];
+		// Nearest interpolation doesn't resample well, keep those tracks as they are.
+		if (t->interpolation == INTERPOLATION_NEAREST) {
+			continue;
+		}
+
+		TrackKeys keys;
+		keys.track = t;
+		switch (t->type) {
+			case TYPE_POSITION_3D: {
+				const PositionTrack *tt = static_cast<const PositionTrack *>(t);
+				if (tt->positions.is_empty()) {
+					continue;
+				}
+				_compress_track_keys(tt->positions, t->interpolation, t->loop_wrap, p_fps, frame_count, p_allowed_linear_err, keys.vectors, keys.key_frames);
+			} break;
+			case TYPE_ROTATION_3D: {
+				const RotationTrack *rt = static_cast<const RotationTrack *>(t);
+				if (rt->rotations.is_empty()) {
+					continue;
+				}
+				_compress_track_keys(rt->rotations, t->interpolation, t->loop_wrap, p_fps, frame_count, p_allowed_angular_err, keys.rotations, keys.key_frames);
+			} break;
+			case TYPE_SCALE_3D: {
+				const ScaleTrack *st = static_cast<const ScaleTrack *>(t);
+				if (st->scales.is_empty()) {
+					continue;
+				}
+				_compress_track_keys(st->scales, t->interpolation, t->loop_wrap, p_fps, frame_count, p_allowed_linear_err, keys.vectors, keys.key_frames);
+			} break;
+			case TYPE_BLEND_SHAPE: {
+				const BlendShapeTrack *bst = static_cast<const BlendShapeTrack *>(t);
+				if (bst->blend_shapes.is_empty()) {
+					continue;
+				}
+				LocalVector<float> blend_shapes;
+				_compress_track_keys(bst->blend_shapes, t->interpolation, t->loop_wrap, p_fps, frame_count, p_allowed_linear_err, blend_shapes, keys.key_frames);
+				keys.components = 1;
+				keys.vectors.resize(blend_shapes.size());
+				for (uint32_t j = 0; j < blend_shapes.size(); j++) {
+					keys.vectors[j] = Vector3(blend_shapes[j], 0, 0);
+				}
+			} break;
+			default: {
+				continue;
+			}
+		}
+
+		total_size += keys.key_frames.size() * (1 + keys.components) * sizeof(uint16_t);
+		track_keys.push_back(keys);
+	}
+
+	if (track_keys.is_empty()) {
+		return;
+	}
+
+	// Split the frames in pages of about the requested size.
+	total_size += track_keys.size() * sizeof(CompressedTrackHeader);
+	const uint32_t page_count_hint = MAX(uint32_t((total_size + p_page_size - 1) / MAX(p_page_size, 1u)), 1u);
+	const uint32_t page_frames = CLAMP((last_frame + page_count_hint - 1) / page_count_hint, 1u, 65535u);
+	const uint32_t page_count = MAX((last_frame + page_frames - 1) / page_frames, 1u);
+
+	compression.fps = p_fps;
+	compression.page_frames = page_frames;
+	compression.track_count = track_keys.size();
+	compression.pages.resize(page_count);
+
+	LocalVector<uint32_t> frames;
+	LocalVector<Vector3> vectors;
+	LocalVector<Quaternion> rotations;
+
+	for (uint32_t p = 0; p < page_count; p++) {
+		const uint32_t page_start = p * page_frames;
+		const uint32_t page_end = MIN(page_start + page_frames, last_frame);
+
+		Vector<uint8_t> &page = compression.pages.write[p];
+		page.resize(track_keys.size() * sizeof(CompressedTrackHeader));
+
+		for (uint32_t i = 0; i < track_keys.size(); i++) {
+			TrackKeys &keys = track_keys[i];
+			const bool is_rotation = keys.track->type == TYPE_ROTATION_3D;
+
+			// The keys in the page, plus keys on its boundaries.
+			frames.clear();
+			frames.push_back(page_start);
+			if (keys.key_frames.size() > 1) {
+				for (uint32_t k = keys.segment; k < keys.key_frames.size(); k++) {
+					if (keys.key_frames[k] > page_start && keys.key_frames[k] < page_end) {
+						frames.push_back(keys.key_frames[k]);
+					}
+				}
+				if (page_end > page_start) {
+					frames.push_back(page_end);
+				}
+			}
+
+			vectors.resize(frames.size());
+			rotations.resize(frames.size());
+			for (uint32_t k = 0; k < frames.size(); k++) {
+				if (is_rotation) {
+					rotations[k] = _compression_curve_value(keys.rotations, keys.key_frames, frames[k], keys.segment);
+				} else {
+					vectors[k] = _compression_curve_value(keys.vectors, keys.key_frames, frames[k], keys.segment);
+				}
+			}
+
+			CompressedTrackHeader header;
+			header.key_offset = page.size();
+			header.key_count = frames.size();
+
+			if (!is_rotation) {
+				// Quantize against the bounds of the keys in this page.
+				Vector3 min = vectors[0];
+				Vector3 max = vectors[0];
+				for (uint32_t k = 1; k < vectors.size(); k++) {
+					for (int c = 0; c < 3; c++) {
+						min[c] = MIN(min[c], vectors[k][c]);
+						max[c] = MAX(max[c], vectors[k][c]);
+					}
+				}
+				for (int c = 0; c < 3; c++) {
+					header.offset[c] = min[c];
+					header.scale[c] = (max[c] - min[c]) / 65535.0;
+				}
+			}
+
+			const uint32_t key_size = header.key_count * (1 + keys.components) * sizeof(uint16_t);
+			page.resize(header.key_offset + ((key_size + 3) & ~3));
+
+			uint8_t *page_ptr = page.ptrw();
+			uint16_t *times = reinterpret_cast<uint16_t *>(page_ptr + header.key_offset);
+			uint16_t *values = times + header.key_count;
+			for (uint32_t k = 0; k < frames.size(); k++) {
+				times[k] = frames[k] - page_start;
+				uint16_t *value = values + k * keys.components;
+				if (is_rotation) {
+					_compression_encode_rotation(rotations[k], value);
+				} else {
+					for (uint32_t c = 0; c < keys.components; c++) {
+						value[c] = _compression_quantize(vectors[k][c], header.offset[c], header.scale[c]);
+					}
+				}
+			}
+			memcpy(page_ptr + i * sizeof(CompressedTrackHeader), &header, sizeof(CompressedTrackHeader));
+		}
+	}
+
+	// The original keys aren't needed anymore.
+	for (uint32_t i = 0; i < track_keys.size(); i++) {
+		Track *t = track_keys[i].track;
+		t->compressed_track = i;
+		t->interpolation = INTERPOLATION_LINEAR;
+		switch (t->type) {
+			case TYPE_POSITION_3D: {
+				static_cast<PositionTrack *>(t)->positions.clear();
+			} break;
+			case TYPE_ROTATION_3D: {
+				static_cast<RotationTrack *>(t)->rotations.clear();
+			} break;
+			case TYPE_SCALE_3D: {
+				static_cast<ScaleTrack *>(t)->scales.clear();
+			} break;
+			case TYPE_BLEND_SHAPE: {
+				static_cast<BlendShapeTrack *>(t)->blend_shapes.clear();
+			} break;
+			default: {
+			}
+		}
+	}
+
+	emit_changed();
+}
+
+bool Animation::is_compressed() const {
+	return compression.track_count > 0;
+}
+
+bool Animation::track_is_compressed(int p_track) const {
+	ERR_FAIL_INDEX_V(p_track, tracks.size(), false);
+	return tracks[p_track]->compressed_track >= 0;
+}
+
+const uint16_t *Animation::_compressed_track_get_page_keys(uint32_t p_compressed_track, uint32_t p_page, const CompressedTrackHeader **r_header, uint32_t *r_key_count) const {
+	const uint8_t *page = compression.pages[p_page].ptr();
+	const CompressedTrackHeader *header = reinterpret_cast<const CompressedTrackHeader *>(page) + p_compressed_track;
+	*r_header = header;
+	*r_key_count = header->key_count;
+	return reinterpret_cast<const uint16_t *>(page + header->key_offset);
+}
+
+bool Animation::_compressed_track_find_keys(uint32_t p_compressed_track, uint32_t p_components, double p_time, const CompressedTrackHeader **r_header, const uint16_t **r_from, const uint16_t **r_to, real_t *r_c) const {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_compressed_track, compression.track_count, false);
+
+	// The page comes straight from the time.
+	const double frame = CLAMP(p_time, 0.0, double(length)) * compression.fps;
+	const uint32_t page = MIN(uint32_t(frame / compression.page_frames), uint32_t(compression.pages.size() - 1));
+
+	uint32_t key_count = 0;
+	const uint16_t *times = _compressed_track_get_page_keys(p_compressed_track, page, r_header, &key_count);
+	if (key_count == 0) {
+		return false;
+	}
+	const uint16_t *values = times + key_count;
+	const double page_frame = frame - double(page) * compression.page_frames;
+
+	// Last key not after the time.
+	uint32_t low = 0;
+	uint32_t high = key_count - 1;
+	while (low < high) {
+		const uint32_t middle = (low + high + 1) / 2;
+		if (times[middle] <= page_frame) {
+			low = middle;
+		} else {
+			high = middle - 1;
+		}
+	}
+
+	*r_from = values + low * p_components;
+	if (low + 1 < key_count) {
+		*r_to = values + (low + 1) * p_components;
+		*r_c = CLAMP((page_frame - times[low]) / (times[low + 1] - times[low]), 0.0, 1.0);
+	} else {
+		*r_to = *r_from;
+		*r_c = 0.0;
+	}
+	return true;
+}
+
+bool Animation::_compressed_track_get_key(uint32_t p_compressed_track, uint32_t p_components, int p_key, const CompressedTrackHeader **r_header, const uint16_t **r_value, double *r_time) const {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_compressed_track, compression.track_count, false);
+	ERR_FAIL_COND_V(p_key < 0, false);
+
+	uint32_t key = p_key;
+	for (int p = 0; p < compression.pages.size(); p++) {
+		uint32_t key_count = 0;
+		const uint16_t *times = _compressed_track_get_page_keys(p_compressed_track, p, r_header, &key_count);
+
+		uint32_t page_key_count = key_count;
+		if (key_count == 1 && p > 0) {
+			// Constant track, its first page has the key.
+			page_key_count = 0;
+		} else if (key_count > 1 && p + 1 < compression.pages.size()) {
+			// The last key is the first one of the next page.
+			page_key_count--;
+		}
+
+		if (key < page_key_count) {
+			*r_value = times + key_count + key * p_components;
+			*r_time = double(p * compression.page_frames + times[key]) / compression.fps;
+			return true;
+		}
+		key -= page_key_count;
+	}
+	return false;
+}
+
+int Animation::_compressed_track_get_key_count(uint32_t p_compressed_track) const {
+	int count = 0;
+	const CompressedTrackHeader *header = nullptr;
+	const uint16_t *value = nullptr;
+	double time = 0.0;
+	while (_compressed_track_get_key(p_compressed_track, 0, count, &header, &value, &time)) {
+		count++;
+	}
+	return count;
+}
+
+int Animation::_compressed_track_find_key(uint32_t p_compressed_track, double p_time, bool p_exact) const {
+	int found = -1;
+	double found_time = 0.0;
+	const CompressedTrackHeader *header = nullptr;
+	const uint16_t *value = nullptr;
+	double time = 0.0;
+	for (int key = 0; _compressed_track_get_key(p_compressed_track, 0, key, &header, &value, &time) && time <= p_time; key++) {
+		found = key;
+		found_time = time;
+	}
+	if (found >= 0 && p_exact && found_time != p_time) {
+		return -1;
+	}
+	return found;
+}
+
+Variant Animation::_compressed_track_get_key_value(const Track *p_track, int p_key) const {
+	const uint32_t components = p_track->type == TYPE_BLEND_SHAPE ? 1 : 3;
+	const CompressedTrackHeader *header = nullptr;
+	const uint16_t *value = nullptr;
+	double time = 0.0;
+	ERR_FAIL_COND_V(!_compressed_track_get_key(p_track->compressed_track, components, p_key, &header, &value, &time), Variant());
+
+	switch (p_track->type) {
+		case TYPE_ROTATION_3D: {
+			return _compression_decode_rotation(value);
+		} break;
+		case TYPE_BLEND_SHAPE: {
+			return header->offset[0] + header->scale[0] * value[0];
+		} break;
+		default: {
+			return _compression_decode_vector3(header->offset, header->scale, value);
+		}
+	}
+}
+
 Animation::Animation() {}
 
 Animation::~Animation() {
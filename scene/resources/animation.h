@@ -32,6 +32,7 @@
 #define ANIMATION_H
 
 #include "core/io/resource.h"
+#include "core/templates/local_vector.h"
 
 #define ANIM_MIN_LENGTH 0.001
 
@@ -74,6 +75,7 @@ private:
 		NodePath path; // path to something
 		bool imported = false;
 		bool enabled = true;
+		int compressed_track = -1; // Keys stored in the compressed pages, see compress().
 		Track() {}
 		virtual ~Track() {}
 	};
@@ -194,6 +196,39 @@ private:
 
 	Vector<Track *> tracks;
 
+	/* COMPRESSION */
+
+	// Compressed tracks keep their keys in pages instead, each page covering
+	// the same amount of frames for all of them. A page starts with the
+	// header of every compressed track, followed by their key frames (from
+	// the page start) and quantized values. The first and last keys of a
+	// page are on its boundaries, so a page is all it takes to sample it.
+	struct CompressedTrackHeader {
+		uint32_t key_offset = 0; // In bytes, from the page start.
+		uint32_t key_count = 0;
+		float offset[3] = {};
+		float scale[3] = {};
+	};
+
+	struct Compression {
+		Vector<Vector<uint8_t>> pages;
+		uint32_t fps = 0;
+		uint32_t page_frames = 0;
+		uint32_t track_count = 0;
+	};
+
+	Compression compression;
+
+	template <class T>
+	void _compress_track_keys(const Vector<TKey<T>> &p_keys, InterpolationType p_interp, bool p_loop_wrap, uint32_t p_fps, uint32_t p_frame_count, real_t p_allowed_error, LocalVector<T> &r_samples, LocalVector<uint32_t> &r_key_frames) const;
+
+	const uint16_t *_compressed_track_get_page_keys(uint32_t p_compressed_track, uint32_t p_page, const CompressedTrackHeader **r_header, uint32_t *r_key_count) const;
+	bool _compressed_track_find_keys(uint32_t p_compressed_track, uint32_t p_components, double p_time, const CompressedTrackHeader **r_header, const uint16_t **r_from, const uint16_t **r_to, real_t *r_c) const;
+	bool _compressed_track_get_key(uint32_t p_compressed_track, uint32_t p_components, int p_key, const CompressedTrackHeader **r_header, const uint16_t **r_value, double *r_time) const;
+	int _compressed_track_get_key_count(uint32_t p_compressed_track) const;
+	int _compressed_track_find_key(uint32_t p_compressed_track, double p_time, bool p_exact) const;
+	Variant _compressed_track_get_key_value(const Track *p_track, int p_key) const;
+
 	/*
 	template<class T>
 	int _insert_pos(double p_time, T& p_keys);*/
@@ -377,6 +412,10 @@ public:
 
 	void optimize(real_t p_allowed_linear_err = 0.05, real_t p_allowed_angular_err = 0.01, real_t p_max_optimizable_angle = Math_PI * 0.125);
 
+	void compress(uint32_t p_page_size = 8192, uint32_t p_fps = 120, real_t p_allowed_linear_err = 0.001, real_t p_allowed_angular_err = 0.001);
+	bool is_compressed() const;
+	bool track_is_compressed(int p_track) const;
+
 	Animation();
 	~Animation();
 };
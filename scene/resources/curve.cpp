@@ -31,6 +31,7 @@
 #include "curve.h"
 
 #include "core/core_string_names.h"
+#include "core/templates/local_vector.h"
 
 template <class T>
 static _FORCE_INLINE_ T _bezier_interp(real_t t, T start, T control_1, T control_2, T end) {
@@ -663,6 +664,7 @@ void Curve2D::_bake() const {
 	if (points.size() == 0) {
 		baked_point_cache.resize(0);
 		baked_dist_cache.resize(0);
+		baked_chunk_cache.resize(0);
 		return;
 	}
 
@@ -672,14 +674,15 @@ void Curve2D::_bake() const {
 
 		baked_dist_cache.resize(1);
 		baked_dist_cache.set(0, 0.0);
+		baked_chunk_cache.resize(0);
 		return;
 	}
 
 	Vector2 pos = points[0].pos;
 	float dist = 0.0;
 
-	List<Vector2> pointlist;
-	List<float> distlist;
+	LocalVector<Vector2> pointlist;
+	LocalVector<float> distlist;
 
 	pointlist.push_back(pos); //start always from origin
 	distlist.push_back(0.0);
@@ -744,10 +747,92 @@ void Curve2D::_bake() const {
 	Vector2 *w = baked_point_cache.ptrw();
 	float *wd = baked_dist_cache.ptrw();
 
-	for (int i = 0; i < pointlist.size(); i++) {
+	for (uint32_t i = 0; i < pointlist.size(); i++) {
 		w[i] = pointlist[i];
 		wd[i] = distlist[i];
 	}
+
+	_bake_chunks();
+}
+
+void Curve2D::_bake_chunks() const {
+	int pc = baked_point_cache.size();
+	int chunk_count = pc > 1 ? (pc - 2) / BAKED_CHUNK_SIZE + 1 : 0;
+	baked_chunk_cache.resize(chunk_count);
+
+	const Vector2 *r = baked_point_cache.ptr();
+	Rect2 *w = baked_chunk_cache.ptrw();
+
+	for (int i = 0; i < chunk_count; i++) {
+		int from = i * BAKED_CHUNK_SIZE;
+		int to = MIN(from + BAKED_CHUNK_SIZE, pc - 1);
+
+		Rect2 bounds = Rect2(r[from], Vector2());
+		for (int j = from + 1; j <= to; j++) {
+			bounds.expand_to(r[j]);
+		}
+		w[i] = bounds;
+	}
+}
+
+void Curve2D::_find_closest_segment(const Vector2 &p_to_point, int &r_segment, float &r_offset) const {
+	// Baked segments are grouped in chunks with a bounding box, so chunks that can't contain anything
+	// closer than the nearest segment found so far are skipped. The chunk with the closest box is
+	// searched first to get a good bound early.
+
+	int pc = baked_point_cache.size();
+	const Vector2 *r = baked_point_cache.ptr();
+
+	int chunk_count = baked_chunk_cache.size();
+	const Rect2 *chunks = baked_chunk_cache.ptr();
+
+	int first_chunk = 0;
+	float first_chunk_dist = -1.0f;
+	for (int i = 0; i < chunk_count; i++) {
+		Vector2 box_end = chunks[i].position + chunks[i].size;
+		float dist = p_to_point.clamp(chunks[i].position, box_end).distance_squared_to(p_to_point);
+		if (first_chunk_dist < 0.0f || dist < first_chunk_dist) {
+			first_chunk = i;
+			first_chunk_dist = dist;
+		}
+	}
+
+	r_segment = 0;
+	r_offset = 0.0f;
+	float nearest_dist = -1.0f;
+
+	for (int c = -1; c < chunk_count; c++) {
+		int chunk = c < 0 ? first_chunk : c;
+		if (c >= 0) {
+			if (chunk == first_chunk) {
+				continue;
+			}
+			Vector2 box_end = chunks[chunk].position + chunks[chunk].size;
+			if (p_to_point.clamp(chunks[chunk].position, box_end).distance_squared_to(p_to_point) > nearest_dist) {
+				continue;
+			}
+		}
+
+		int from = chunk * BAKED_CHUNK_SIZE;
+		int to = MIN(from + BAKED_CHUNK_SIZE, pc - 1);
+
+		for (int i = from; i < to; i++) {
+			Vector2 origin = r[i];
+			Vector2 direction = (r[i + 1] - origin) / bake_interval;
+
+			float d = CLAMP((p_to_point - origin).dot(direction), 0.0f, bake_interval);
+			Vector2 proj = origin + direction * d;
+
+			float dist = proj.distance_squared_to(p_to_point);
+
+			// Ties go to the earliest segment, same as a linear search would.
+			if (nearest_dist < 0.0f || dist < nearest_dist || (dist == nearest_dist && i < r_segment)) {
+				r_segment = i;
+				r_offset = d;
+				nearest_dist = dist;
+			}
+		}
+	}
 }
 
 float Curve2D::get_baked_length() const {
@@ -781,10 +866,12 @@ Vector2 Curve2D::interpolate_baked(float p_offset, bool p_cubic) const {
 		return r[bpc - 1];
 	}
 
+	const float *rd = baked_dist_cache.ptr();
+
 	int start = 0, end = bpc, idx = (end + start) / 2;
 	// binary search to find baked points
 	while (start < idx) {
-		float offset = baked_dist_cache[idx];
+		float offset = rd[idx];
 		if (p_offset <= offset) {
 			end = idx;
 		} else {
@@ -793,8 +880,8 @@ Vector2 Curve2D::interpolate_baked(float p_offset, bool p_cubic) const {
 		idx = (end + start) / 2;
 	}
 
-	float offset_begin = baked_dist_cache[idx];
-	float offset_end = baked_dist_cache[idx + 1];
+	float offset_begin = rd[idx];
+	float offset_end = rd[idx + 1];
 
 	float idx_interval = offset_end - offset_begin;
 	ERR_FAIL_COND_V_MSG(p_offset < offset_begin || p_offset > offset_end, Vector2(), "failed to find baked segment");
@@ -829,8 +916,6 @@ float Curve2D::get_bake_interval() const {
 }
 
 Vector2 Curve2D::get_closest_point(const Vector2 &p_to_point) const {
-	// Brute force method
-
 	if (baked_cache_dirty) {
 		_bake();
 	}
@@ -845,30 +930,16 @@ Vector2 Curve2D::get_closest_point(const Vector2 &p_to_point) const {
 
 	const Vector2 *r = baked_point_cache.ptr();
 
-	Vector2 nearest;
-	float nearest_dist = -1.0f;
-
-	for (int i = 0; i < pc - 1; i++) {
-		Vector2 origin = r[i];
-		Vector2 direction = (r[i + 1] - origin) / bake_interval;
-
-		float d = CLAMP((p_to_point - origin).dot(direction), 0.0f, bake_interval);
-		Vector2 proj = origin + direction * d;
-
-		float dist = proj.distance_squared_to(p_to_point);
-
-		if (nearest_dist < 0.0f || dist < nearest_dist) {
-			nearest = proj;
-			nearest_dist = dist;
-		}
-	}
+	int segment;
+	float offset;
+	_find_closest_segment(p_to_point, segment, offset);
 
-	return nearest;
+	Vector2 origin = r[segment];
+	Vector2 direction = (r[segment + 1] - origin) / bake_interval;
+	return origin + direction * offset;
 }
 
 float Curve2D::get_closest_offset(const Vector2 &p_to_point) const {
-	// Brute force method
-
 	if (baked_cache_dirty) {
 		_bake();
 	}
@@ -881,30 +952,11 @@ float Curve2D::get_closest_offset(const Vector2 &p_to_point) const {
 		return 0.0f;
 	}
 
-	const Vector2 *r = baked_point_cache.ptr();
-
-	float nearest = 0.0f;
-	float nearest_dist = -1.0f;
-	float offset = 0.0f;
-
-	for (int i = 0; i < pc - 1; i++) {
-		Vector2 origin = r[i];
-		Vector2 direction = (r[i + 1] - origin) / bake_interval;
-
-		float d = CLAMP((p_to_point - origin).dot(direction), 0.0f, bake_interval);
-		Vector2 proj = origin + direction * d;
-
-		float dist = proj.distance_squared_to(p_to_point);
-
-		if (nearest_dist < 0.0f || dist < nearest_dist) {
-			nearest = offset + d;
-			nearest_dist = dist;
-		}
-
-		offset += bake_interval;
-	}
+	int segment;
+	float offset;
+	_find_closest_segment(p_to_point, segment, offset);
 
-	return nearest;
+	return segment * bake_interval + offset;
 }
 
 Dictionary Curve2D::_get_data() const {
@@ -1168,6 +1220,7 @@ void Curve3D::_bake() const {
 		baked_tilt_cache.resize(0);
 		baked_up_vector_cache.resize(0);
 		baked_dist_cache.resize(0);
+		baked_chunk_cache.resize(0);
 		return;
 	}
 
@@ -1186,13 +1239,14 @@ void Curve3D::_bake() const {
 			baked_up_vector_cache.resize(0);
 		}
 
+		baked_chunk_cache.resize(0);
 		return;
 	}
 
 	Vector3 pos = points[0].pos;
 	float dist = 0.0;
-	List<Plane> pointlist;
-	List<float> distlist;
+	LocalVector<Plane> pointlist;
+	LocalVector<float> distlist;
 
 	pointlist.push_back(Plane(pos, points[0].tilt));
 	distlist.push_back(0.0);
@@ -1257,7 +1311,6 @@ void Curve3D::_bake() const {
 
 	baked_point_cache.resize(pointlist.size());
 	Vector3 *w = baked_point_cache.ptrw();
-	int idx = 0;
 
 	baked_tilt_cache.resize(pointlist.size());
 	real_t *wt = baked_tilt_cache.ptrw();
@@ -1276,13 +1329,13 @@ void Curve3D::_bake() const {
 	Vector3 prev_up = Vector3(0, 1, 0);
 	Vector3 prev_forward = Vector3(0, 0, 1);
 
-	for (const Plane &E : pointlist) {
+	for (uint32_t idx = 0; idx < pointlist.size(); idx++) {
+		const Plane &E = pointlist[idx];
 		w[idx] = E.normal;
 		wt[idx] = E.d;
 		wd[idx] = distlist[idx];
 
 		if (!up_vector_enabled) {
-			idx++;
 			continue;
 		}
 
@@ -1310,8 +1363,88 @@ void Curve3D::_bake() const {
 		prev_sideways = sideways;
 		prev_up = up;
 		prev_forward = forward;
+	}
+
+	_bake_chunks();
+}
+
+void Curve3D::_bake_chunks() const {
+	int pc = baked_point_cache.size();
+	int chunk_count = pc > 1 ? (pc - 2) / BAKED_CHUNK_SIZE + 1 : 0;
+	baked_chunk_cache.resize(chunk_count);
+
+	const Vector3 *r = baked_point_cache.ptr();
+	AABB *w = baked_chunk_cache.ptrw();
 
-		idx++;
+	for (int i = 0; i < chunk_count; i++) {
+		int from = i * BAKED_CHUNK_SIZE;
+		int to = MIN(from + BAKED_CHUNK_SIZE, pc - 1);
+
+		AABB bounds = AABB(r[from], Vector3());
+		for (int j = from + 1; j <= to; j++) {
+			bounds.expand_to(r[j]);
+		}
+		w[i] = bounds;
+	}
+}
+
+void Curve3D::_find_closest_segment(const Vector3 &p_to_point, int &r_segment, float &r_offset) const {
+	// Baked segments are grouped in chunks with a bounding box, so chunks that can't contain anything
+	// closer than the nearest segment found so far are skipped. The chunk with the closest box is
+	// searched first to get a good bound early.
+
+	int pc = baked_point_cache.size();
+	const Vector3 *r = baked_point_cache.ptr();
+
+	int chunk_count = baked_chunk_cache.size();
+	const AABB *chunks = baked_chunk_cache.ptr();
+
+	int first_chunk = 0;
+	float first_chunk_dist = -1.0f;
+	for (int i = 0; i < chunk_count; i++) {
+		Vector3 box_end = chunks[i].position + chunks[i].size;
+		float dist = p_to_point.clamp(chunks[i].position, box_end).distance_squared_to(p_to_point);
+		if (first_chunk_dist < 0.0f || dist < first_chunk_dist) {
+			first_chunk = i;
+			first_chunk_dist = dist;
+		}
+	}
+
+	r_segment = 0;
+	r_offset = 0.0f;
+	float nearest_dist = -1.0f;
+
+	for (int c = -1; c < chunk_count; c++) {
+		int chunk = c < 0 ? first_chunk : c;
+		if (c >= 0) {
+			if (chunk == first_chunk) {
+				continue;
+			}
+			Vector3 box_end = chunks[chunk].position + chunks[chunk].size;
+			if (p_to_point.clamp(chunks[chunk].position, box_end).distance_squared_to(p_to_point) > nearest_dist) {
+				continue;
+			}
+		}
+
+		int from = chunk * BAKED_CHUNK_SIZE;
+		int to = MIN(from + BAKED_CHUNK_SIZE, pc - 1);
+
+		for (int i = from; i < to; i++) {
+			Vector3 origin = r[i];
+			Vector3 direction = (r[i + 1] - origin) / bake_interval;
+
+			float d = CLAMP((p_to_point - origin).dot(direction), 0.0f, bake_interval);
+			Vector3 proj = origin + direction * d;
+
+			float dist = proj.distance_squared_to(p_to_point);
+
+			// Ties go to the earliest segment, same as a linear search would.
+			if (nearest_dist < 0.0f || dist < nearest_dist || (dist == nearest_dist && i < r_segment)) {
+				r_segment = i;
+				r_offset = d;
+				nearest_dist = dist;
+			}
+		}
 	}
 }
 
@@ -1346,10 +1479,12 @@ Vector3 Curve3D::interpolate_baked(float p_offset, bool p_cubic) const {
 		return r[bpc - 1];
 	}
 
+	const float *rd = baked_dist_cache.ptr();
+
 	int start = 0, end = bpc, idx = (end + start) / 2;
 	// binary search to find baked points
 	while (start < idx) {
-		float offset = baked_dist_cache[idx];
+		float offset = rd[idx];
 		if (p_offset <= offset) {
 			end = idx;
 		} else {
@@ -1358,8 +1493,8 @@ Vector3 Curve3D::interpolate_baked(float p_offset, bool p_cubic) const {
 		idx = (end + start) / 2;
 	}
 
-	float offset_begin = baked_dist_cache[idx];
-	float offset_end = baked_dist_cache[idx + 1];
+	float offset_begin = rd[idx];
+	float offset_end = rd[idx + 1];
 
 	float idx_interval = offset_end - offset_begin;
 	ERR_FAIL_COND_V_MSG(p_offset < offset_begin || p_offset > offset_end, Vector3(), "failed to find baked segment");
@@ -1486,8 +1621,6 @@ PackedVector3Array Curve3D::get_baked_up_vectors() const {
 }
 
 Vector3 Curve3D::get_closest_point(const Vector3 &p_to_point) const {
-	// Brute force method
-
 	if (baked_cache_dirty) {
 		_bake();
 	}
@@ -1502,30 +1635,16 @@ Vector3 Curve3D::get_closest_point(const Vector3 &p_to_point) const {
 
 	const Vector3 *r = baked_point_cache.ptr();
 
-	Vector3 nearest;
-	float nearest_dist = -1.0f;
-
-	for (int i = 0; i < pc - 1; i++) {
-		Vector3 origin = r[i];
-		Vector3 direction = (r[i + 1] - origin) / bake_interval;
-
-		float d = CLAMP((p_to_point - origin).dot(direction), 0.0f, bake_interval);
-		Vector3 proj = origin + direction * d;
+	int segment;
+	float offset;
+	_find_closest_segment(p_to_point, segment, offset);
 
-		float dist = proj.distance_squared_to(p_to_point);
-
-		if (nearest_dist < 0.0f || dist < nearest_dist) {
-			nearest = proj;
-			nearest_dist = dist;
-		}
-	}
-
-	return nearest;
+	Vector3 origin = r[segment];
+	Vector3 direction = (r[segment + 1] - origin) / bake_interval;
+	return origin + direction * offset;
 }
 
 float Curve3D::get_closest_offset(const Vector3 &p_to_point) const {
-	// Brute force method
-
 	if (baked_cache_dirty) {
 		_bake();
 	}
@@ -1538,30 +1657,11 @@ float Curve3D::get_closest_offset(const Vector3 &p_to_point) const {
 		return 0.0f;
 	}
 
-	const Vector3 *r = baked_point_cache.ptr();
-
-	float nearest = 0.0f;
-	float nearest_dist = -1.0f;
-	float offset = 0.0f;
-
-	for (int i = 0; i < pc - 1; i++) {
-		Vector3 origin = r[i];
-		Vector3 direction = (r[i + 1] - origin) / bake_interval;
-
-		float d = CLAMP((p_to_point - origin).dot(direction), 0.0f, bake_interval);
-		Vector3 proj = origin + direction * d;
-
-		float dist = proj.distance_squared_to(p_to_point);
-
-		if (nearest_dist < 0.0f || dist < nearest_dist) {
-			nearest = offset + d;
-			nearest_dist = dist;
-		}
-
-		offset += bake_interval;
-	}
+	int segment;
+	float offset;
+	_find_closest_segment(p_to_point, segment, offset);
 
-	return nearest;
+	return segment * bake_interval + offset;
 }
 
 void Curve3D::set_bake_interval(float p_tolerance) {
@@ -146,6 +146,10 @@ VARIANT_ENUM_CAST(Curve::TangentMode)
 class Curve2D : public Resource {
 	GDCLASS(Curve2D, Resource);
 
+	enum {
+		BAKED_CHUNK_SIZE = 16
+	};
+
 	struct Point {
 		Vector2 in;
 		Vector2 out;
@@ -163,8 +167,12 @@ class Curve2D : public Resource {
 	mutable PackedVector2Array baked_point_cache;
 	mutable PackedFloat32Array baked_dist_cache;
 	mutable float baked_max_ofs = 0.0;
+	// Bounds of every BAKED_CHUNK_SIZE baked segments, to skip most of the curve in closest point queries.
+	mutable Vector<Rect2> baked_chunk_cache;
 
 	void _bake() const;
+	void _bake_chunks() const;
+	void _find_closest_segment(const Vector2 &p_to_point, int &r_segment, float &r_offset) const;
 
 	float bake_interval = 5.0;
 
@@ -207,6 +215,10 @@ public:
 class Curve3D : public Resource {
 	GDCLASS(Curve3D, Resource);
 
+	enum {
+		BAKED_CHUNK_SIZE = 16
+	};
+
 	struct Point {
 		Vector3 in;
 		Vector3 out;
@@ -227,8 +239,12 @@ class Curve3D : public Resource {
 	mutable PackedVector3Array baked_up_vector_cache;
 	mutable PackedFloat32Array baked_dist_cache;
 	mutable float baked_max_ofs = 0.0;
+	// Bounds of every BAKED_CHUNK_SIZE baked segments, to skip most of the curve in closest point queries.
+	mutable Vector<AABB> baked_chunk_cache;
 
 	void _bake() const;
+	void _bake_chunks() const;
+	void _find_closest_segment(const Vector3 &p_to_point, int &r_segment, float &r_offset) const;
 
 	float bake_interval = 0.2;
 	bool up_vector_enabled = true;
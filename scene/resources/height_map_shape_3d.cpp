@@ -91,6 +91,7 @@ void HeightMapShape3D::_update_shape() {
 	d["heights"] = map_data;
 	d["min_height"] = min_height;
 	d["max_height"] = max_height;
+	d["quantized"] = use_quantized_heights;
 	PhysicsServer3D::get_singleton()->shape_set_data(get_shape(), d);
 	Shape3D::_update_shape();
 }
@@ -178,6 +179,21 @@ Vector<real_t> HeightMapShape3D::get_map_data() const {
 	return map_data;
 }
 
+void HeightMapShape3D::set_use_quantized_heights(bool p_enable) {
+	if (use_quantized_heights == p_enable) {
+		return;
+	}
+
+	use_quantized_heights = p_enable;
+
+	_update_shape();
+	notify_change_to_owners();
+}
+
+bool HeightMapShape3D::is_using_quantized_heights() const {
+	return use_quantized_heights;
+}
+
 void HeightMapShape3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_map_width", "width"), &HeightMapShape3D::set_map_width);
 	ClassDB::bind_method(D_METHOD("get_map_width"), &HeightMapShape3D::get_map_width);
@@ -185,10 +201,13 @@ void HeightMapShape3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_map_depth"), &HeightMapShape3D::get_map_depth);
 	ClassDB::bind_method(D_METHOD("set_map_data", "data"), &HeightMapShape3D::set_map_data);
 	ClassDB::bind_method(D_METHOD("get_map_data"), &HeightMapShape3D::get_map_data);
+	ClassDB::bind_method(D_METHOD("set_use_quantized_heights", "enable"), &HeightMapShape3D::set_use_quantized_heights);
+	ClassDB::bind_method(D_METHOD("is_using_quantized_heights"), &HeightMapShape3D::is_using_quantized_heights);
 
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "map_width", PROPERTY_HINT_RANGE, "1,4096,1"), "set_map_width", "get_map_width");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "map_depth", PROPERTY_HINT_RANGE, "1,4096,1"), "set_map_depth", "get_map_depth");
 	ADD_PROPERTY(PropertyInfo(Variant::PACKED_FLOAT32_ARRAY, "map_data"), "set_map_data", "get_map_data");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_quantized_heights"), "set_use_quantized_heights", "is_using_quantized_heights");
 }
 
 HeightMapShape3D::HeightMapShape3D() :
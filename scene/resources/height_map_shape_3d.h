@@ -41,6 +41,7 @@ class HeightMapShape3D : public Shape3D {
 	Vector<real_t> map_data;
 	real_t min_height = 0.0;
 	real_t max_height = 0.0;
+	bool use_quantized_heights = false;
 
 protected:
 	static void _bind_methods();
@@ -53,6 +54,8 @@ public:
 	int get_map_depth() const;
 	void set_map_data(Vector<real_t> p_new);
 	Vector<real_t> get_map_data() const;
+	void set_use_quantized_heights(bool p_enable);
+	bool is_using_quantized_heights() const;
 
 	virtual Vector<Vector3> get_debug_mesh_lines() const override;
 	virtual real_t get_enclosing_radius() const override;
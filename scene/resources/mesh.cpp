@@ -30,7 +30,9 @@
 
 #include "mesh.h"
 
+#include "core/config/project_settings.h"
 #include "core/math/convex_hull.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
 #include "scene/resources/concave_polygon_shape_3d.h"
 #include "scene/resources/convex_polygon_shape_3d.h"
@@ -40,6 +42,13 @@
 
 Mesh::ConvexDecompositionFunc Mesh::convex_decomposition_function = nullptr;
 
+ArrayMesh::EncodeVertexBufferBoundFunc ArrayMesh::encode_vertex_buffer_bound_func = nullptr;
+ArrayMesh::EncodeVertexBufferFunc ArrayMesh::encode_vertex_buffer_func = nullptr;
+ArrayMesh::DecodeVertexBufferFunc ArrayMesh::decode_vertex_buffer_func = nullptr;
+ArrayMesh::EncodeIndexBufferBoundFunc ArrayMesh::encode_index_buffer_bound_func = nullptr;
+ArrayMesh::EncodeIndexBufferFunc ArrayMesh::encode_index_buffer_func = nullptr;
+ArrayMesh::DecodeIndexBufferFunc ArrayMesh::decode_index_buffer_func = nullptr;
+
 Ref<TriangleMesh> Mesh::generate_triangle_mesh() const {
 	if (triangle_mesh.is_valid()) {
 		return triangle_mesh;
@@ -499,6 +508,7 @@ void Mesh::_bind_methods() {
 	BIND_ENUM_CONSTANT(ARRAY_FLAG_USE_2D_VERTICES);
 	BIND_ENUM_CONSTANT(ARRAY_FLAG_USE_DYNAMIC_UPDATE);
 	BIND_ENUM_CONSTANT(ARRAY_FLAG_USE_8_BONE_WEIGHTS);
+	BIND_ENUM_CONSTANT(ARRAY_FLAG_COMPRESS_UV);
 
 	BIND_ENUM_CONSTANT(BLEND_SHAPE_MODE_NORMALIZED);
 	BIND_ENUM_CONSTANT(BLEND_SHAPE_MODE_RELATIVE);
@@ -1053,15 +1063,173 @@ PackedStringArray ArrayMesh::_get_blend_shape_names() const {
 	return sarr;
 }
 
+// Buffers of a saved surface packed with the vertex or index codec, stored as "compression".
+enum {
+	SURFACE_COMPRESSION_VERTEX_CODEC = 1,
+	SURFACE_COMPRESSION_INDEX_CODEC = 2,
+};
+
+static Vector<uint8_t> _encode_vertex_buffer(const Vector<uint8_t> &p_data, uint32_t p_stride) {
+	size_t count = p_data.size() / p_stride;
+	Vector<uint8_t> ret;
+	ret.resize(ArrayMesh::encode_vertex_buffer_bound_func(count, p_stride));
+	size_t size = ArrayMesh::encode_vertex_buffer_func(ret.ptrw(), ret.size(), p_data.ptr(), count, p_stride);
+	ret.resize(size);
+	return ret;
+}
+
+static Vector<uint8_t> _decode_vertex_buffer(const Vector<uint8_t> &p_data, uint32_t p_count, uint32_t p_stride) {
+	Vector<uint8_t> ret;
+	ret.resize(p_count * p_stride);
+	int err = ArrayMesh::decode_vertex_buffer_func(ret.ptrw(), p_count, p_stride, p_data.ptr(), p_data.size());
+	ERR_FAIL_COND_V_MSG(err != 0, Vector<uint8_t>(), "Corrupt compressed mesh vertex data.");
+	return ret;
+}
+
+static Vector<uint8_t> _encode_index_buffer(const Vector<uint8_t> &p_data, uint32_t p_index_size, uint32_t p_vertex_count) {
+	uint32_t count = p_data.size() / p_index_size;
+	LocalVector<uint32_t> indices;
+	indices.resize(count);
+	if (p_index_size == 2) {
+		const uint16_t *r = (const uint16_t *)p_data.ptr();
+		for (uint32_t i = 0; i < count; i++) {
+			indices[i] = r[i];
+		}
+	} else {
+		memcpy(indices.ptr(), p_data.ptr(), count * sizeof(uint32_t));
+	}
+
+	Vector<uint8_t> ret;
+	ret.resize(ArrayMesh::encode_index_buffer_bound_func(count, p_vertex_count));
+	size_t size = ArrayMesh::encode_index_buffer_func(ret.ptrw(), ret.size(), indices.ptr(), count);
+	ret.resize(size);
+	return ret;
+}
+
+static Vector<uint8_t> _decode_index_buffer(const Vector<uint8_t> &p_data, uint32_t p_count, uint32_t p_index_size) {
+	Vector<uint8_t> ret;
+	ret.resize(p_count * p_index_size);
+	int err = ArrayMesh::decode_index_buffer_func(ret.ptrw(), p_count, p_index_size, p_data.ptr(), p_data.size());
+	ERR_FAIL_COND_V_MSG(err != 0, Vector<uint8_t>(), "Corrupt compressed mesh index data.");
+	return ret;
+}
+
+// Packs the surface buffers with the codecs that accept them, returns the SURFACE_COMPRESSION_* used.
+static uint32_t _compress_surface_data(RS::SurfaceData &r_surface) {
+	uint32_t offsets[RS::ARRAY_MAX];
+	uint32_t vertex_stride, attrib_stride, skin_stride;
+	RS::get_singleton()->mesh_surface_make_offsets_from_format(r_surface.format, r_surface.vertex_count, r_surface.index_count, offsets, vertex_stride, attrib_stride, skin_stride);
+
+	uint32_t compression = 0;
+
+	// The vertex codec works on elements of up to 256 bytes, in multiples of 4.
+	bool vertex_codec = ArrayMesh::encode_vertex_buffer_func && r_surface.vertex_count > 0;
+	uint32_t strides[3] = { vertex_stride, attrib_stride, skin_stride };
+	for (int i = 0; i < 3; i++) {
+		if (strides[i] % 4 != 0 || strides[i] > 256) {
+			vertex_codec = false;
+		}
+	}
+	if (vertex_codec) {
+		r_surface.vertex_data = _encode_vertex_buffer(r_surface.vertex_data, vertex_stride);
+		if (r_surface.attribute_data.size()) {
+			r_surface.attribute_data = _encode_vertex_buffer(r_surface.attribute_data, attrib_stride);
+		}
+		if (r_surface.skin_data.size()) {
+			r_surface.skin_data = _encode_vertex_buffer(r_surface.skin_data, skin_stride);
+		}
+		if (r_surface.blend_shape_data.size()) {
+			// Blend shapes are whole copies of the vertex buffer, back to back.
+			r_surface.blend_shape_data = _encode_vertex_buffer(r_surface.blend_shape_data, vertex_stride);
+		}
+		compression |= SURFACE_COMPRESSION_VERTEX_CODEC;
+	}
+
+	// The index codec only takes triangle lists.
+	bool index_codec = ArrayMesh::encode_index_buffer_func && r_surface.index_count > 0 && r_surface.primitive == RS::PRIMITIVE_TRIANGLES && r_surface.index_count % 3 == 0;
+	uint32_t index_size = offsets[RS::ARRAY_INDEX];
+	for (int i = 0; i < r_surface.lods.size() && index_codec; i++) {
+		if ((r_surface.lods[i].index_data.size() / index_size) % 3 != 0) {
+			index_codec = false;
+		}
+	}
+	if (index_codec) {
+		r_surface.index_data = _encode_index_buffer(r_surface.index_data, index_size, r_surface.vertex_count);
+		for (int i = 0; i < r_surface.lods.size(); i++) {
+			r_surface.lods.write[i].index_data = _encode_index_buffer(r_surface.lods[i].index_data, index_size, r_surface.vertex_count);
+		}
+		compression |= SURFACE_COMPRESSION_INDEX_CODEC;
+	}
+
+	return compression;
+}
+
+static Error _decompress_surface_data(RS::SurfaceData &r_surface, uint32_t p_compression, const Array &p_lod_index_counts, int p_blend_shape_count) {
+	uint32_t offsets[RS::ARRAY_MAX];
+	uint32_t vertex_stride, attrib_stride, skin_stride;
+	RS::get_singleton()->mesh_surface_make_offsets_from_format(r_surface.format, r_surface.vertex_count, r_surface.index_count, offsets, vertex_stride, attrib_stride, skin_stride);
+
+	if (p_compression & SURFACE_COMPRESSION_VERTEX_CODEC) {
+		ERR_FAIL_COND_V_MSG(!ArrayMesh::decode_vertex_buffer_func, ERR_UNAVAILABLE, "Loading compressed mesh vertex data requires the meshoptimizer module.");
+		r_surface.vertex_data = _decode_vertex_buffer(r_surface.vertex_data, r_surface.vertex_count, vertex_stride);
+		ERR_FAIL_COND_V(r_surface.vertex_data.is_empty(), ERR_FILE_CORRUPT);
+		if (r_surface.attribute_data.size()) {
+			r_surface.attribute_data = _decode_vertex_buffer(r_surface.attribute_data, r_surface.vertex_count, attrib_stride);
+			ERR_FAIL_COND_V(r_surface.attribute_data.is_empty(), ERR_FILE_CORRUPT);
+		}
+		if (r_surface.skin_data.size()) {
+			r_surface.skin_data = _decode_vertex_buffer(r_surface.skin_data, r_surface.vertex_count, skin_stride);
+			ERR_FAIL_COND_V(r_surface.skin_data.is_empty(), ERR_FILE_CORRUPT);
+		}
+		if (r_surface.blend_shape_data.size()) {
+			r_surface.blend_shape_data = _decode_vertex_buffer(r_surface.blend_shape_data, r_surface.vertex_count * p_blend_shape_count, vertex_stride);
+			ERR_FAIL_COND_V(r_surface.blend_shape_data.is_empty(), ERR_FILE_CORRUPT);
+		}
+	}
+
+	if (p_compression & SURFACE_COMPRESSION_INDEX_CODEC) {
+		ERR_FAIL_COND_V_MSG(!ArrayMesh::decode_index_buffer_func, ERR_UNAVAILABLE, "Loading compressed mesh index data requires the meshoptimizer module.");
+		ERR_FAIL_COND_V(p_lod_index_counts.size() != r_surface.lods.size(), ERR_FILE_CORRUPT);
+		uint32_t index_size = offsets[RS::ARRAY_INDEX];
+		r_surface.index_data = _decode_index_buffer(r_surface.index_data, r_surface.index_count, index_size);
+		ERR_FAIL_COND_V(r_surface.index_data.is_empty(), ERR_FILE_CORRUPT);
+		for (int i = 0; i < r_surface.lods.size(); i++) {
+			r_surface.lods.write[i].index_data = _decode_index_buffer(r_surface.lods[i].index_data, p_lod_index_counts[i], index_size);
+			ERR_FAIL_COND_V(r_surface.lods[i].index_data.is_empty(), ERR_FILE_CORRUPT);
+		}
+	}
+
+	return OK;
+}
+
 Array ArrayMesh::_get_surfaces() const {
 	if (mesh.is_null()) {
 		return Array();
 	}
 
+	bool compress = GLOBAL_GET("rendering/mesh_storage/compress_surfaces");
+
 	Array ret;
 	for (int i = 0; i < surfaces.size(); i++) {
 		RenderingServer::SurfaceData surface = RS::get_singleton()->mesh_get_surface(mesh, i);
 		Dictionary data;
+
+		if (compress) {
+			// Decoding needs the element counts of the LOD index buffers, the rest are known.
+			Array lod_index_counts;
+			uint32_t index_size = surface.vertex_count >= (1 << 16) ? 4 : 2;
+			for (int j = 0; j < surface.lods.size(); j++) {
+				lod_index_counts.push_back(surface.lods[j].index_data.size() / index_size);
+			}
+			uint32_t compression = _compress_surface_data(surface);
+			if (compression) {
+				data["compression"] = compression;
+				if ((compression & SURFACE_COMPRESSION_INDEX_CODEC) && lod_index_counts.size()) {
+					data["lod_index_counts"] = lod_index_counts;
+				}
+			}
+		}
+
 		data["format"] = surface.format;
 		data["primitive"] = surface.primitive;
 		data["vertex_data"] = surface.vertex_data;
@@ -1180,6 +1348,15 @@ void ArrayMesh::_set_surfaces(const Array &p_surfaces) {
 			surface.blend_shape_data = d["blend_shapes"];
 		}
 
+		if (d.has("compression")) {
+			Array lod_index_counts;
+			if (d.has("lod_index_counts")) {
+				lod_index_counts = d["lod_index_counts"];
+			}
+			Error err = _decompress_surface_data(surface, d["compression"], lod_index_counts, blend_shapes.size());
+			ERR_FAIL_COND(err != OK);
+		}
+
 		Ref<Material> material;
 		if (d.has("material")) {
 			material = d["material"];
@@ -117,6 +117,7 @@ public:
 		ARRAY_FLAG_USE_2D_VERTICES = RS::ARRAY_FLAG_USE_2D_VERTICES,
 		ARRAY_FLAG_USE_DYNAMIC_UPDATE = RS::ARRAY_FLAG_USE_DYNAMIC_UPDATE,
 		ARRAY_FLAG_USE_8_BONE_WEIGHTS = RS::ARRAY_FLAG_USE_8_BONE_WEIGHTS,
+		ARRAY_FLAG_COMPRESS_UV = RS::ARRAY_FLAG_COMPRESS_UV,
 
 	};
 
@@ -247,6 +248,20 @@ protected:
 	static void _bind_methods();
 
 public:
+	// Vertex and index codecs used to compress surfaces when saving, provided by the meshoptimizer module.
+	typedef size_t (*EncodeVertexBufferBoundFunc)(size_t p_vertex_count, size_t p_vertex_size);
+	static EncodeVertexBufferBoundFunc encode_vertex_buffer_bound_func;
+	typedef size_t (*EncodeVertexBufferFunc)(unsigned char *r_buffer, size_t p_buffer_size, const void *p_vertices, size_t p_vertex_count, size_t p_vertex_size);
+	static EncodeVertexBufferFunc encode_vertex_buffer_func;
+	typedef int (*DecodeVertexBufferFunc)(void *r_vertices, size_t p_vertex_count, size_t p_vertex_size, const unsigned char *p_buffer, size_t p_buffer_size);
+	static DecodeVertexBufferFunc decode_vertex_buffer_func;
+	typedef size_t (*EncodeIndexBufferBoundFunc)(size_t p_index_count, size_t p_vertex_count);
+	static EncodeIndexBufferBoundFunc encode_index_buffer_bound_func;
+	typedef size_t (*EncodeIndexBufferFunc)(unsigned char *r_buffer, size_t p_buffer_size, const unsigned int *p_indices, size_t p_index_count);
+	static EncodeIndexBufferFunc encode_index_buffer_func;
+	typedef int (*DecodeIndexBufferFunc)(void *r_indices, size_t p_index_count, size_t p_index_size, const unsigned char *p_buffer, size_t p_buffer_size);
+	static DecodeIndexBufferFunc decode_index_buffer_func;
+
 	void add_surface_from_arrays(PrimitiveType p_primitive, const Array &p_arrays, const Array &p_blend_shapes = Array(), const Dictionary &p_lods = Dictionary(), uint32_t p_flags = 0);
 
 	void add_surface(uint32_t p_format, PrimitiveType p_primitive, const Vector<uint8_t> &p_array, const Vector<uint8_t> &p_attribute_array, const Vector<uint8_t> &p_skin_array, int p_vertex_count, const Vector<uint8_t> &p_index_array, int p_index_count, const AABB &p_aabb, const Vector<uint8_t> &p_blend_shape_data = Vector<uint8_t>(), const Vector<AABB> &p_bone_aabbs = Vector<AABB>(), const Vector<RS::SurfaceData::LOD> &p_lods = Vector<RS::SurfaceData::LOD>());
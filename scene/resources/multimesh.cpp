@@ -202,6 +202,10 @@ Vector<float> MultiMesh::get_buffer() const {
 	return RS::get_singleton()->multimesh_get_buffer(multimesh);
 }
 
+void MultiMesh::set_buffer_range(int p_from_instance, const Vector<float> &p_buffer) {
+	RS::get_singleton()->multimesh_set_buffer_range(multimesh, p_from_instance, p_buffer);
+}
+
 void MultiMesh::set_mesh(const Ref<Mesh> &p_mesh) {
 	mesh = p_mesh;
 	if (!mesh.is_null()) {
@@ -329,6 +333,7 @@ void MultiMesh::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_buffer"), &MultiMesh::get_buffer);
 	ClassDB::bind_method(D_METHOD("set_buffer", "buffer"), &MultiMesh::set_buffer);
+	ClassDB::bind_method(D_METHOD("set_buffer_range", "from_instance", "buffer"), &MultiMesh::set_buffer_range);
 
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "transform_format", PROPERTY_HINT_ENUM, "2D,3D"), "set_transform_format", "get_transform_format");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_colors"), "set_use_colors", "is_using_colors");
@@ -73,6 +73,8 @@ protected:
 	void set_buffer(const Vector<float> &p_buffer);
 	Vector<float> get_buffer() const;
 
+	void set_buffer_range(int p_from_instance, const Vector<float> &p_buffer);
+
 public:
 	void set_mesh(const Ref<Mesh> &p_mesh);
 	Ref<Mesh> get_mesh() const;
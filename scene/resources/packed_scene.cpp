@@ -45,6 +45,44 @@ bool SceneState::can_instantiate() const {
 	return nodes.size() > 0;
 }
 
+void SceneState::_build_node_templates() const {
+	MutexLock lock(node_templates_mutex);
+	if (node_templates_built.is_set()) {
+		return; // Built by another thread meanwhile.
+	}
+
+	node_templates.resize(nodes.size());
+	for (int i = 0; i < nodes.size(); i++) {
+		const NodeData &n = nodes[i];
+		NodeTemplate &t = node_templates[i];
+		t.creation_func = nullptr;
+		t.setters.clear();
+
+		if ((i == 0 && base_scene_idx >= 0) || n.instance >= 0 || n.type == TYPE_INSTANCED || n.type < 0 || n.type >= names.size()) {
+			continue; // Created from another scene, the exact class isn't known here.
+		}
+
+		const StringName &type = names[n.type];
+		t.creation_func = ClassDB::get_creation_func(type);
+		if (!t.creation_func) {
+			continue;
+		}
+
+		t.setters.resize(n.properties.size());
+		for (int j = 0; j < n.properties.size(); j++) {
+			int name = n.properties[j].name;
+			const StringName &property = name >= 0 && name < names.size() ? names[name] : StringName();
+			if (property == StringName() || property == CoreStringNames::get_singleton()->_script) {
+				t.setters[j] = nullptr;
+			} else {
+				t.setters[j] = ClassDB::get_property_setget(type, property);
+			}
+		}
+	}
+
+	node_templates_built.set();
+}
+
 Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	// nodes where instancing failed (because something is missing)
 	List<Node *> stray_instances;
@@ -82,6 +120,15 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 	bool gen_node_path_cache = p_edit_state != GEN_EDIT_STATE_DISABLED && node_path_cache.is_empty();
 
+	// Editing needs Object::set() side effects (edited flags, editor validation), so only spawn from templates at runtime.
+	const NodeTemplate *templates = nullptr;
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED && !Engine::get_singleton()->is_editor_hint()) {
+		if (!node_templates_built.is_set()) {
+			_build_node_templates();
+		}
+		templates = node_templates.ptr();
+	}
+
 	Map<Ref<Resource>, Ref<Resource>> resources_local_to_scene;
 
 	for (int i = 0; i < nc; i++) {
@@ -151,7 +198,9 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 		} else {
 			Object *obj = nullptr;
 
-			if (ClassDB::is_class_enabled(snames[n.type])) {
+			if (templates && templates[i].creation_func) {
+				obj = templates[i].creation_func();
+			} else if (ClassDB::is_class_enabled(snames[n.type])) {
 				//node belongs to this scene and must be created
 				obj = ClassDB::instantiate(snames[n.type]);
 			}
@@ -182,6 +231,8 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			node = Object::cast_to<Node>(obj);
 		}
 
+		const NodeTemplate *node_template = templates && templates[i].creation_func && node && node->get_class_name() == snames[n.type] ? &templates[i] : nullptr;
+
 		if (node) {
 			// may not have found the node (part of instantiated scene and removed)
 			// if found all is good, otherwise ignore
@@ -247,7 +298,14 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 						} else if (p_edit_state == GEN_EDIT_STATE_INSTANCE) {
 							value = value.duplicate(true); // Duplicate arrays and dictionaries for the editor
 						}
-						node->set(snames[nprops[j].name], value, &valid);
+						if (node_template && node_template->setters[j] && !node->get_script_instance()) {
+							ClassDB::set_property_setget(node, node_template->setters[j], value, &valid);
+#ifdef TOOLS_ENABLED
+							node->set_edited(true);
+#endif
+						} else {
+							node->set(snames[nprops[j].name], value, &valid);
+						}
 					}
 				}
 			}
@@ -922,6 +980,7 @@ String SceneState::get_path() const {
 }
 
 void SceneState::clear() {
+	_invalidate_node_templates();
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1072,6 +1131,8 @@ bool SceneState::is_connection(int p_node, const StringName &p_signal, int p_to_
 }
 
 void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
+	_invalidate_node_templates();
+
 	ERR_FAIL_COND(!p_dictionary.has("names"));
 	ERR_FAIL_COND(!p_dictionary.has("variants"));
 	ERR_FAIL_COND(!p_dictionary.has("node_count"));
@@ -1516,6 +1577,8 @@ int SceneState::add_node_path(const NodePath &p_path) {
 }
 
 int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int p_instance, int p_index) {
+	_invalidate_node_templates();
+
 	NodeData nd;
 	nd.parent = p_parent;
 	nd.owner = p_owner;
@@ -1534,6 +1597,8 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value) {
 	ERR_FAIL_INDEX(p_name, names.size());
 	ERR_FAIL_INDEX(p_value, variants.size());
 
+	_invalidate_node_templates();
+
 	NodeData::Property prop;
 	prop.name = p_name;
 	prop.value = p_value;
@@ -1660,6 +1725,20 @@ Node *PackedScene::instantiate(GenEditState p_edit_state) const {
 	return s;
 }
 
+TypedArray<Node> PackedScene::instantiate_many(int p_count) const {
+	ERR_FAIL_COND_V(p_count < 0, TypedArray<Node>());
+
+	TypedArray<Node> instances;
+	instances.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		Node *s = instantiate();
+		ERR_FAIL_COND_V(!s, TypedArray<Node>());
+		instances[i] = s;
+	}
+
+	return instances;
+}
+
 void PackedScene::replace_state(Ref<SceneState> p_by) {
 	state = p_by;
 	state->set_path(get_path());
@@ -1691,6 +1770,7 @@ void PackedScene::reset_state() {
 void PackedScene::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pack", "path"), &PackedScene::pack);
 	ClassDB::bind_method(D_METHOD("instantiate", "edit_state"), &PackedScene::instantiate, DEFVAL(GEN_EDIT_STATE_DISABLED));
+	ClassDB::bind_method(D_METHOD("instantiate_many", "count"), &PackedScene::instantiate_many);
 	ClassDB::bind_method(D_METHOD("can_instantiate"), &PackedScene::can_instantiate);
 	ClassDB::bind_method(D_METHOD("_set_bundled_scene"), &PackedScene::_set_bundled_scene);
 	ClassDB::bind_method(D_METHOD("_get_bundled_scene"), &PackedScene::_get_bundled_scene);
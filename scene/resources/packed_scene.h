@@ -32,6 +32,9 @@
 #define PACKED_SCENE_H
 
 #include "core/io/resource.h"
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "scene/main/node.h"
 
 class SceneState : public RefCounted {
@@ -87,6 +90,19 @@ class SceneState : public RefCounted {
 
 	Vector<ConnectionData> connections;
 
+	// Constructors and property setters resolved once, so runtime instantiation skips the ClassDB lookups.
+	struct NodeTemplate {
+		Object *(*creation_func)() = nullptr; // nullptr when the node isn't created from its type, or needs ClassDB::instantiate().
+		LocalVector<const ClassDB::PropertySetGet *> setters; // Per property, nullptr when it must go through Object::set().
+	};
+
+	mutable LocalVector<NodeTemplate> node_templates;
+	mutable SafeFlag node_templates_built;
+	mutable BinaryMutex node_templates_mutex;
+
+	void _build_node_templates() const;
+	_FORCE_INLINE_ void _invalidate_node_templates() { node_templates_built.clear(); }
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, Map<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, Map<Node *, int> &node_map, Map<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, Map<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, Map<Node *, int> &node_map, Map<Node *, int> &nodepath_map);
 
@@ -215,6 +231,7 @@ public:
 
 	bool can_instantiate() const;
 	Node *instantiate(GenEditState p_edit_state = GEN_EDIT_STATE_DISABLED) const;
+	TypedArray<Node> instantiate_many(int p_count) const;
 
 	void recreate_state();
 	void replace_state(Ref<SceneState> p_by);
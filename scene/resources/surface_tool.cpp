@@ -30,9 +30,17 @@
 
 #include "surface_tool.h"
 
+#include "core/os/worker_thread_pool.h"
+
 #define _VERTEX_SNAP 0.0001
 #define EQ_VERTEX_DIST 0.00001
 
+#define SURFACE_TOOL_THREADED_MIN_VERTICES 4096
+#define SURFACE_TOOL_THREADED_BATCH 1024
+
+static const uint32_t custom_mask[RS::ARRAY_CUSTOM_COUNT] = { Mesh::ARRAY_FORMAT_CUSTOM0, Mesh::ARRAY_FORMAT_CUSTOM1, Mesh::ARRAY_FORMAT_CUSTOM2, Mesh::ARRAY_FORMAT_CUSTOM3 };
+static const uint32_t custom_shift[RS::ARRAY_CUSTOM_COUNT] = { Mesh::ARRAY_FORMAT_CUSTOM0_SHIFT, Mesh::ARRAY_FORMAT_CUSTOM1_SHIFT, Mesh::ARRAY_FORMAT_CUSTOM2_SHIFT, Mesh::ARRAY_FORMAT_CUSTOM3_SHIFT };
+
 SurfaceTool::OptimizeVertexCacheFunc SurfaceTool::optimize_vertex_cache_func = nullptr;
 SurfaceTool::SimplifyFunc SurfaceTool::simplify_func = nullptr;
 SurfaceTool::SimplifyWithAttribFunc SurfaceTool::simplify_with_attrib_func = nullptr;
@@ -602,6 +610,202 @@ Array SurfaceTool::commit_to_arrays() {
 	return a;
 }
 
+void SurfaceTool::_pack_vertex(uint32_t p_index, const PackData *p_data) const {
+	const Vertex &v = vertex_array[p_index];
+	uint8_t *vw = p_data->vertex_ptr + p_index * p_data->vertex_stride;
+	uint8_t *aw = p_data->attrib_ptr + p_index * p_data->attrib_stride;
+
+	// Same encoding as RenderingServer::_surface_set_data() applies to the arrays from commit_to_arrays().
+	{
+		float vector[3] = { (float)v.vertex.x, (float)v.vertex.y, (float)v.vertex.z };
+		memcpy(&vw[p_data->offsets[RS::ARRAY_VERTEX]], vector, sizeof(float) * 3);
+	}
+
+	if (p_data->format & RS::ARRAY_FORMAT_NORMAL) {
+		Vector3 n = v.normal * Vector3(0.5, 0.5, 0.5) + Vector3(0.5, 0.5, 0.5);
+
+		uint32_t value = 0;
+		value |= CLAMP(int(n.x * 1023.0), 0, 1023);
+		value |= CLAMP(int(n.y * 1023.0), 0, 1023) << 10;
+		value |= CLAMP(int(n.z * 1023.0), 0, 1023) << 20;
+
+		memcpy(&vw[p_data->offsets[RS::ARRAY_NORMAL]], &value, 4);
+	}
+
+	if (p_data->format & RS::ARRAY_FORMAT_TANGENT) {
+		uint32_t value = 0;
+		value |= CLAMP(int(((float)v.tangent.x * 0.5 + 0.5) * 1023.0), 0, 1023);
+		value |= CLAMP(int(((float)v.tangent.y * 0.5 + 0.5) * 1023.0), 0, 1023) << 10;
+		value |= CLAMP(int(((float)v.tangent.z * 0.5 + 0.5) * 1023.0), 0, 1023) << 20;
+
+		float d = v.binormal.dot(v.normal.cross(v.tangent));
+		if (!(d < 0)) {
+			value |= 3 << 30;
+		}
+
+		memcpy(&vw[p_data->offsets[RS::ARRAY_TANGENT]], &value, 4);
+	}
+
+	if (p_data->format & RS::ARRAY_FORMAT_COLOR) {
+		uint8_t color8[4] = {
+			uint8_t(CLAMP(v.color.r * 255.0, 0.0, 255.0)),
+			uint8_t(CLAMP(v.color.g * 255.0, 0.0, 255.0)),
+			uint8_t(CLAMP(v.color.b * 255.0, 0.0, 255.0)),
+			uint8_t(CLAMP(v.color.a * 255.0, 0.0, 255.0))
+		};
+		memcpy(&aw[p_data->offsets[RS::ARRAY_COLOR]], color8, 4);
+	}
+
+	if (p_data->format & RS::ARRAY_FORMAT_TEX_UV) {
+		if (p_data->format & RS::ARRAY_FLAG_COMPRESS_UV) {
+			uint16_t uv[2] = { Math::make_half_float(v.uv.x), Math::make_half_float(v.uv.y) };
+			memcpy(&aw[p_data->offsets[RS::ARRAY_TEX_UV]], uv, 2 * 2);
+		} else {
+			float uv[2] = { (float)v.uv.x, (float)v.uv.y };
+			memcpy(&aw[p_data->offsets[RS::ARRAY_TEX_UV]], uv, 2 * 4);
+		}
+	}
+
+	if (p_data->format & RS::ARRAY_FORMAT_TEX_UV2) {
+		if (p_data->format & RS::ARRAY_FLAG_COMPRESS_UV) {
+			uint16_t uv[2] = { Math::make_half_float(v.uv2.x), Math::make_half_float(v.uv2.y) };
+			memcpy(&aw[p_data->offsets[RS::ARRAY_TEX_UV2]], uv, 2 * 2);
+		} else {
+			float uv[2] = { (float)v.uv2.x, (float)v.uv2.y };
+			memcpy(&aw[p_data->offsets[RS::ARRAY_TEX_UV2]], uv, 2 * 4);
+		}
+	}
+
+	for (int i = 0; i < RS::ARRAY_CUSTOM_COUNT; i++) {
+		if (!(p_data->format & custom_mask[i])) {
+			continue;
+		}
+
+		const Color &c = v.custom[i];
+		uint8_t *w = &aw[p_data->offsets[RS::ARRAY_CUSTOM0 + i]];
+
+		switch (last_custom_format[i]) {
+			case CUSTOM_RGBA8_UNORM: {
+				w[0] = CLAMP(int32_t(c.r * 255.0), 0, 255);
+				w[1] = CLAMP(int32_t(c.g * 255.0), 0, 255);
+				w[2] = CLAMP(int32_t(c.b * 255.0), 0, 255);
+				w[3] = CLAMP(int32_t(c.a * 255.0), 0, 255);
+			} break;
+			case CUSTOM_RGBA8_SNORM: {
+				w[0] = uint8_t(int8_t(CLAMP(int32_t(c.r * 127.0), -128, 127)));
+				w[1] = uint8_t(int8_t(CLAMP(int32_t(c.g * 127.0), -128, 127)));
+				w[2] = uint8_t(int8_t(CLAMP(int32_t(c.b * 127.0), -128, 127)));
+				w[3] = uint8_t(int8_t(CLAMP(int32_t(c.a * 127.0), -128, 127)));
+			} break;
+			case CUSTOM_RG_HALF: {
+				uint16_t half[2] = { Math::make_half_float(c.r), Math::make_half_float(c.g) };
+				memcpy(w, half, 4);
+			} break;
+			case CUSTOM_RGBA_HALF: {
+				uint16_t half[4] = { Math::make_half_float(c.r), Math::make_half_float(c.g), Math::make_half_float(c.b), Math::make_half_float(c.a) };
+				memcpy(w, half, 8);
+			} break;
+			case CUSTOM_R_FLOAT:
+			case CUSTOM_RG_FLOAT:
+			case CUSTOM_RGB_FLOAT:
+			case CUSTOM_RGBA_FLOAT: {
+				float value[4] = { c.r, c.g, c.b, c.a };
+				memcpy(w, value, (last_custom_format[i] - CUSTOM_R_FLOAT + 1) * 4);
+			} break;
+			default: {
+			} //unreachable but compiler warning anyway
+		}
+	}
+}
+
+Error SurfaceTool::commit_to_surface_data(RS::SurfaceData &r_surface_data, uint32_t p_flags) {
+	uint32_t vertex_count = vertex_array.size();
+	ERR_FAIL_COND_V(vertex_count == 0, ERR_INVALID_DATA);
+
+	uint32_t array_format = format & ((1 << RS::ARRAY_MAX) - 1);
+	ERR_FAIL_COND_V(!(array_format & RS::ARRAY_FORMAT_VERTEX), ERR_INVALID_PARAMETER);
+	if (index_array.size() == 0) {
+		array_format &= ~RS::ARRAY_FORMAT_INDEX;
+	}
+
+	// Skinned surfaces need their bone AABBs and 2D ones are rejected, leave both to the RenderingServer.
+	bool packable = !(array_format & (RS::ARRAY_FORMAT_BONES | RS::ARRAY_FORMAT_WEIGHTS)) && !(p_flags & RS::ARRAY_FLAG_USE_2D_VERTICES);
+	for (int i = 0; i < RS::ARRAY_CUSTOM_COUNT; i++) {
+		if (array_format & custom_mask[i]) {
+			// The custom type comes from the flags like in add_surface_from_arrays(), anything not
+			// matching the packed one has to go through the arrays to be validated.
+			array_format |= (RS::ARRAY_FORMAT_CUSTOM_MASK << custom_shift[i]) & p_flags;
+			if (((p_flags >> custom_shift[i]) & RS::ARRAY_FORMAT_CUSTOM_MASK) != (uint32_t)last_custom_format[i]) {
+				packable = false;
+			}
+		}
+	}
+
+	if (!packable) {
+		return RS::get_singleton()->mesh_create_surface_data_from_arrays(&r_surface_data, RS::PrimitiveType(primitive), commit_to_arrays(), Array(), Dictionary(), p_flags);
+	}
+
+	uint32_t index_count = (array_format & RS::ARRAY_FORMAT_INDEX) ? index_array.size() : 0;
+
+	PackData data;
+	uint32_t mask = (1 << RS::ARRAY_MAX) - 1;
+	data.format = array_format | ((~mask) & p_flags);
+
+	uint32_t skin_stride = 0;
+	RS::get_singleton()->mesh_surface_make_offsets_from_format(data.format, vertex_count, index_count, data.offsets, data.vertex_stride, data.attrib_stride, skin_stride);
+
+	Vector<uint8_t> vertex_data;
+	vertex_data.resize(data.vertex_stride * vertex_count);
+	data.vertex_ptr = vertex_data.ptrw();
+
+	Vector<uint8_t> attrib_data;
+	attrib_data.resize(data.attrib_stride * vertex_count);
+	data.attrib_ptr = attrib_data.ptrw();
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (vertex_count < SURFACE_TOOL_THREADED_MIN_VERTICES || !pool || pool->get_thread_count() == 0) {
+		for (uint32_t i = 0; i < vertex_count; i++) {
+			_pack_vertex(i, &data);
+		}
+	} else {
+		WorkerThreadPool::GroupID group = pool->add_template_group_task(this, &SurfaceTool::_pack_vertex, (const PackData *)&data, vertex_count, -1, SURFACE_TOOL_THREADED_BATCH);
+		pool->wait_for_group_task_completion(group);
+	}
+
+	AABB aabb = AABB(vertex_array[0].vertex, Vector3(0.00001, 0.00001, 0.00001));
+	for (uint32_t i = 1; i < vertex_count; i++) {
+		aabb.expand_to(vertex_array[i].vertex);
+	}
+
+	Vector<uint8_t> index_data;
+	if (index_count) {
+		index_data.resize(data.offsets[RS::ARRAY_INDEX] * index_count);
+		if (vertex_count < (1 << 16)) {
+			uint16_t *iw = (uint16_t *)index_data.ptrw();
+			for (uint32_t i = 0; i < index_count; i++) {
+				iw[i] = index_array[i];
+			}
+		} else {
+			uint32_t *iw = (uint32_t *)index_data.ptrw();
+			for (uint32_t i = 0; i < index_count; i++) {
+				iw[i] = index_array[i];
+			}
+		}
+	}
+
+	r_surface_data = RS::SurfaceData();
+	r_surface_data.format = data.format;
+	r_surface_data.primitive = RS::PrimitiveType(primitive);
+	r_surface_data.aabb = aabb;
+	r_surface_data.vertex_data = vertex_data;
+	r_surface_data.attribute_data = attrib_data;
+	r_surface_data.vertex_count = vertex_count;
+	r_surface_data.index_data = index_data;
+	r_surface_data.index_count = index_count;
+
+	return OK;
+}
+
 Ref<ArrayMesh> SurfaceTool::commit(const Ref<ArrayMesh> &p_existing, uint32_t p_flags) {
 	Ref<ArrayMesh> mesh;
 	if (p_existing.is_valid()) {
@@ -618,9 +822,11 @@ Ref<ArrayMesh> SurfaceTool::commit(const Ref<ArrayMesh> &p_existing, uint32_t p_
 
 	int surface = mesh->get_surface_count();
 
-	Array a = commit_to_arrays();
+	RS::SurfaceData sd;
+	Error err = commit_to_surface_data(sd, p_flags);
+	ERR_FAIL_COND_V(err != OK, mesh);
 
-	mesh->add_surface_from_arrays(primitive, a, Array(), Dictionary(), p_flags);
+	mesh->add_surface(sd.format, Mesh::PrimitiveType(sd.primitive), sd.vertex_data, sd.attribute_data, sd.skin_data, sd.vertex_count, sd.index_data, sd.index_count, sd.aabb, sd.blend_shape_data, sd.bone_aabbs, sd.lods);
 
 	if (material.is_valid()) {
 		mesh->surface_set_material(surface, material);
@@ -629,29 +835,65 @@ Ref<ArrayMesh> SurfaceTool::commit(const Ref<ArrayMesh> &p_existing, uint32_t p_
 	return mesh;
 }
 
+void SurfaceTool::_hash_vertex(uint32_t p_index, uint32_t *r_hashes) const {
+	r_hashes[p_index] = VertexHasher::hash(vertex_array[p_index]);
+}
+
 void SurfaceTool::index() {
 	if (index_array.size()) {
 		return; //already indexed
 	}
 
-	HashMap<Vertex, int, VertexHasher> indices;
-	LocalVector<Vertex> old_vertex_array = vertex_array;
-	vertex_array.clear();
+	uint32_t vertex_count = vertex_array.size();
 
-	for (uint32_t i = 0; i < old_vertex_array.size(); i++) {
-		int *idxptr = indices.getptr(old_vertex_array[i]);
-		int idx;
-		if (!idxptr) {
-			idx = indices.size();
-			vertex_array.push_back(old_vertex_array[i]);
-			indices[old_vertex_array[i]] = idx;
-		} else {
-			idx = *idxptr;
+	LocalVector<uint32_t> hashes;
+	hashes.resize(vertex_count);
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (vertex_count < SURFACE_TOOL_THREADED_MIN_VERTICES || !pool || pool->get_thread_count() == 0) {
+		for (uint32_t i = 0; i < vertex_count; i++) {
+			_hash_vertex(i, hashes.ptr());
 		}
+	} else {
+		WorkerThreadPool::GroupID group = pool->add_template_group_task(this, &SurfaceTool::_hash_vertex, hashes.ptr(), vertex_count, -1, SURFACE_TOOL_THREADED_BATCH);
+		pool->wait_for_group_task_completion(group);
+	}
 
-		index_array.push_back(idx);
+	// Open addressing table of unique vertex indices. Unique vertices are moved to the front
+	// of the array as they are found, so no copy of it (or of the keys) is needed.
+	uint32_t table_size = next_power_of_2(MAX(vertex_count * 2, 16u));
+	uint32_t table_mask = table_size - 1;
+	LocalVector<uint32_t> table;
+	table.resize(table_size);
+	memset(table.ptr(), 0xFF, table_size * sizeof(uint32_t));
+
+	index_array.resize(vertex_count);
+	uint32_t unique_count = 0;
+
+	for (uint32_t i = 0; i < vertex_count; i++) {
+		uint32_t h = hashes[i];
+		uint32_t slot = h & table_mask;
+		while (true) {
+			uint32_t entry = table[slot];
+			if (entry == UINT32_MAX) {
+				if (unique_count != i) {
+					vertex_array[unique_count] = vertex_array[i];
+					hashes[unique_count] = h;
+				}
+				table[slot] = unique_count;
+				index_array[i] = unique_count++;
+				break;
+			}
+			if (hashes[entry] == h && vertex_array[entry] == vertex_array[i]) {
+				index_array[i] = entry;
+				break;
+			}
+			slot = (slot + 1) & table_mask;
+		}
 	}
 
+	vertex_array.resize(unique_count);
+
 	format |= Mesh::ARRAY_FORMAT_INDEX;
 }
 
@@ -679,9 +921,6 @@ void SurfaceTool::_create_list(const Ref<Mesh> &p_existing, int p_surface, Local
 	_create_list_from_arrays(arr, r_vertex, r_index, lformat);
 }
 
-static const uint32_t custom_mask[RS::ARRAY_CUSTOM_COUNT] = { Mesh::ARRAY_FORMAT_CUSTOM0, Mesh::ARRAY_FORMAT_CUSTOM1, Mesh::ARRAY_FORMAT_CUSTOM2, Mesh::ARRAY_FORMAT_CUSTOM3 };
-static const uint32_t custom_shift[RS::ARRAY_CUSTOM_COUNT] = { Mesh::ARRAY_FORMAT_CUSTOM0_SHIFT, Mesh::ARRAY_FORMAT_CUSTOM1_SHIFT, Mesh::ARRAY_FORMAT_CUSTOM2_SHIFT, Mesh::ARRAY_FORMAT_CUSTOM3_SHIFT };
-
 void SurfaceTool::create_vertex_array_from_triangle_arrays(const Array &p_arrays, LocalVector<SurfaceTool::Vertex> &ret, uint32_t *r_format) {
 	ret.clear();
 
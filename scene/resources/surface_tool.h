@@ -90,6 +90,15 @@ private:
 		static _FORCE_INLINE_ uint32_t hash(const Vertex &p_vtx);
 	};
 
+	struct PackData {
+		uint32_t format = 0;
+		uint32_t offsets[RS::ARRAY_MAX] = {};
+		uint32_t vertex_stride = 0;
+		uint32_t attrib_stride = 0;
+		uint8_t *vertex_ptr = nullptr;
+		uint8_t *attrib_ptr = nullptr;
+	};
+
 	struct WeightSort {
 		int index = 0;
 		float weight = 0.0;
@@ -123,6 +132,9 @@ private:
 
 	CustomFormat last_custom_format[RS::ARRAY_CUSTOM_COUNT];
 
+	void _hash_vertex(uint32_t p_index, uint32_t *r_hashes) const;
+	void _pack_vertex(uint32_t p_index, const PackData *p_data) const;
+
 	void _create_list_from_arrays(Array arr, LocalVector<Vertex> *r_vertex, LocalVector<int> *r_index, uint32_t &lformat);
 	void _create_list(const Ref<Mesh> &p_existing, int p_surface, LocalVector<Vertex> *r_vertex, LocalVector<int> *r_index, uint32_t &lformat);
 
@@ -184,6 +196,7 @@ public:
 	void create_from_triangle_arrays(const Array &p_arrays);
 	static void create_vertex_array_from_triangle_arrays(const Array &p_arrays, LocalVector<Vertex> &ret, uint32_t *r_format = nullptr);
 	Array commit_to_arrays();
+	Error commit_to_surface_data(RS::SurfaceData &r_surface_data, uint32_t p_flags = 0);
 	void create_from(const Ref<Mesh> &p_existing, int p_surface);
 	void create_from_blend_shape(const Ref<Mesh> &p_existing, int p_surface, const String &p_blend_shape_name);
 	void append_from(const Ref<Mesh> &p_existing, int p_surface, const Transform3D &p_xform);
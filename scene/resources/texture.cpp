@@ -31,7 +31,9 @@
 #include "texture.h"
 
 #include "core/core_string_names.h"
+#include "core/config/project_settings.h"
 #include "core/io/image_loader.h"
+#include "core/object/message_queue.h"
 #include "core/os/os.h"
 #include "mesh.h"
 #include "scene/resources/bit_map.h"
@@ -314,7 +316,7 @@ Ref<Image> StreamTexture2D::load_image_from_file(FileAccess *f, int p_size_limit
 		for (uint32_t i = 0; i < mipmaps + 1; i++) {
 			uint32_t size = f->get_32();
 
-			if (p_size_limit > 0 && i < (mipmaps - 1) && (sw > p_size_limit || sh > p_size_limit)) {
+			if (p_size_limit > 0 && i < mipmaps && (sw > p_size_limit || sh > p_size_limit)) {
 				//can't load this due to size limit
 				sw = MAX(sw >> 1, 1);
 				sh = MAX(sh >> 1, 1);
@@ -322,20 +324,31 @@ Ref<Image> StreamTexture2D::load_image_from_file(FileAccess *f, int p_size_limit
 				continue;
 			}
 
-			Vector<uint8_t> pv;
-			pv.resize(size);
-			{
-				uint8_t *wr = pv.ptrw();
-				f->get_buffer(wr, size);
-			}
-
 			Ref<Image> img;
-			if (data_format == DATA_FORMAT_BASIS_UNIVERSAL && Image::basis_universal_unpacker) {
-				img = Image::basis_universal_unpacker(pv);
-			} else if (data_format == DATA_FORMAT_PNG && Image::png_unpacker) {
-				img = Image::png_unpacker(pv);
-			} else if (data_format == DATA_FORMAT_WEBP && Image::webp_unpacker) {
-				img = Image::webp_unpacker(pv);
+
+			// PNG and WebP levels can be decoded straight from the file mapping, skipping the copy.
+			const uint8_t *view = data_format != DATA_FORMAT_BASIS_UNIVERSAL && size > 4 ? f->get_buffer_view(size) : nullptr;
+			if (view) {
+				if (data_format == DATA_FORMAT_PNG && Image::_png_mem_loader_func && memcmp(view, "PNG ", 4) == 0) {
+					img = Image::_png_mem_loader_func(view + 4, size - 4);
+				} else if (data_format == DATA_FORMAT_WEBP && Image::_webp_mem_loader_func && memcmp(view, "WEBP", 4) == 0) {
+					img = Image::_webp_mem_loader_func(view + 4, size - 4);
+				}
+			} else {
+				Vector<uint8_t> pv;
+				pv.resize(size);
+				{
+					uint8_t *wr = pv.ptrw();
+					f->get_buffer(wr, size);
+				}
+
+				if (data_format == DATA_FORMAT_BASIS_UNIVERSAL && Image::basis_universal_unpacker) {
+					img = Image::basis_universal_unpacker(pv);
+				} else if (data_format == DATA_FORMAT_PNG && Image::png_unpacker) {
+					img = Image::png_unpacker(pv);
+				} else if (data_format == DATA_FORMAT_WEBP && Image::webp_unpacker) {
+					img = Image::webp_unpacker(pv);
+				}
 			}
 
 			if (img.is_null() || img->is_empty()) {
@@ -387,24 +400,24 @@ Ref<Image> StreamTexture2D::load_image_from_file(FileAccess *f, int p_size_limit
 				}
 			}
 
-			image->create(w, h, true, mipmap_images[0]->get_format(), img_data);
+			image->create(mipmap_images[0]->get_width(), mipmap_images[0]->get_height(), true, mipmap_images[0]->get_format(), img_data);
 			return image;
 		}
 
 	} else if (data_format == DATA_FORMAT_IMAGE) {
 		int size = Image::get_image_data_size(w, h, format, mipmaps ? true : false);
+		uint64_t data_start = f->get_position();
 
 		for (uint32_t i = 0; i < mipmaps + 1; i++) {
 			int tw, th;
 			int ofs = Image::get_image_mipmap_offset_and_dimensions(w, h, format, i, tw, th);
 
-			if (p_size_limit > 0 && i < mipmaps && (p_size_limit > tw || p_size_limit > th)) {
-				if (ofs) {
-					f->seek(f->get_position() + ofs);
-				}
+			if (p_size_limit > 0 && i < mipmaps && (tw > p_size_limit || th > p_size_limit)) {
 				continue; //oops, size limit enforced, go to next
 			}
 
+			f->seek(data_start + ofs);
+
 			Vector<uint8_t> data;
 			data.resize(size - ofs);
 
@@ -454,6 +467,54 @@ void StreamTexture2D::_requested_normal(void *p_ud) {
 	request_normal_callback(stex);
 }
 
+void StreamTexture2D::_requested_stream_size(void *p_ud, int p_max_size) {
+	// Called from the render thread, only does the file reading in a worker.
+	StreamTexture2D *st = (StreamTexture2D *)p_ud;
+	MutexLock lock(st->stream_mutex);
+	if (st->stream_task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(st->stream_task);
+	}
+	st->stream_task = WorkerThreadPool::get_singleton()->add_template_task(st, &StreamTexture2D::_stream_load, p_max_size);
+}
+
+void StreamTexture2D::_stream_load(int p_max_size) {
+	Ref<Image> image;
+
+	FileAccess *f = FileAccess::open(path_to_file, FileAccess::READ);
+	if (f) {
+		f->seek(HEADER_SIZE);
+		image = load_image_from_file(f, p_max_size >= MAX(w, h) ? 0 : p_max_size);
+		memdelete(f);
+	}
+
+	// Textures can only be replaced from the main thread, if this one is gone by then the call is dropped.
+	MessageQueue::get_singleton()->push_callable(callable_mp(this, &StreamTexture2D::_stream_loaded), image);
+}
+
+void StreamTexture2D::_stream_loaded(const Ref<Image> &p_image) {
+	if (!streamed || !texture.is_valid()) {
+		return;
+	}
+
+	if (p_image.is_null() || p_image->is_empty()) {
+		// Keep what is loaded instead of failing again every frame.
+		ERR_PRINT("Unable to stream texture: " + path_to_file + ".");
+		RS::get_singleton()->texture_set_stream_callback(texture, nullptr, nullptr);
+		return;
+	}
+
+	RID new_texture = RS::get_singleton()->texture_2d_create(p_image);
+	RS::get_singleton()->texture_replace(texture, new_texture);
+}
+
+void StreamTexture2D::_stream_wait() {
+	MutexLock lock(stream_mutex);
+	if (stream_task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(stream_task);
+		stream_task = WorkerThreadPool::INVALID_TASK_ID;
+	}
+}
+
 StreamTexture2D::TextureFormatRequestCallback StreamTexture2D::request_3d_callback = nullptr;
 StreamTexture2D::TextureFormatRoughnessRequestCallback StreamTexture2D::request_roughness_callback = nullptr;
 StreamTexture2D::TextureFormatRequestCallback StreamTexture2D::request_normal_callback = nullptr;
@@ -462,7 +523,7 @@ Image::Format StreamTexture2D::get_format() const {
 	return format;
 }
 
-Error StreamTexture2D::_load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit) {
+Error StreamTexture2D::_load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, bool &r_streamed, int &mipmap_limit, int p_size_limit) {
 	alpha_cache.unref();
 
 	ERR_FAIL_COND_V(image.is_null(), ERR_INVALID_PARAMETER);
@@ -507,7 +568,8 @@ Error StreamTexture2D::_load_data(const String &p_path, int &r_width, int &r_hei
 	r_request_normal = false;
 
 #endif
-	if (!(df & FORMAT_BIT_STREAM)) {
+	r_streamed = df & FORMAT_BIT_STREAM;
+	if (!r_streamed) {
 		p_size_limit = 0;
 	}
 
@@ -530,9 +592,14 @@ Error StreamTexture2D::load(const String &p_path) {
 	bool request_3d;
 	bool request_normal;
 	bool request_roughness;
+	bool request_stream;
 	int mipmap_limit;
 
-	Error err = _load_data(p_path, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit);
+	// Streamed textures start small, the rendering server asks for more once they are drawn.
+	_stream_wait();
+	int size_limit = next_power_of_2(MAX(1, int(GLOBAL_GET("rendering/textures/streaming/min_size"))));
+
+	Error err = _load_data(p_path, lw, lh, image, request_3d, request_normal, request_roughness, request_stream, mipmap_limit, size_limit);
 	if (err) {
 		return err;
 	}
@@ -552,6 +619,13 @@ Error StreamTexture2D::load(const String &p_path) {
 	path_to_file = p_path;
 	format = image->get_format();
 
+	streamed = request_stream;
+	if (streamed) {
+		RS::get_singleton()->texture_set_stream_callback(texture, _requested_stream_size, this);
+	} else {
+		RS::get_singleton()->texture_set_stream_callback(texture, nullptr, nullptr);
+	}
+
 	if (get_path() == String()) {
 		//temporarily set path if no path set for resource, helps find errors
 		RenderingServer::get_singleton()->texture_set_path(texture, p_path);
@@ -703,6 +777,10 @@ void StreamTexture2D::_bind_methods() {
 StreamTexture2D::StreamTexture2D() {}
 
 StreamTexture2D::~StreamTexture2D() {
+	if (streamed) {
+		RS::get_singleton()->texture_set_stream_callback(texture, nullptr, nullptr);
+	}
+	_stream_wait();
 	if (texture.is_valid()) {
 		RS::get_singleton()->free(texture);
 	}
@@ -38,6 +38,7 @@
 #include "core/os/mutex.h"
 #include "core/os/rw_lock.h"
 #include "core/os/thread_safe.h"
+#include "core/os/worker_thread_pool.h"
 #include "scene/resources/curve.h"
 #include "scene/resources/gradient.h"
 #include "servers/camera_server.h"
@@ -153,7 +154,11 @@ public:
 	};
 
 private:
-	Error _load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit = 0);
+	enum {
+		HEADER_SIZE = 36, // Magic, version, size, data format, mipmap limit and three reserved words.
+	};
+
+	Error _load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, bool &r_streamed, int &mipmap_limit, int p_size_limit = 0);
 	String path_to_file;
 	mutable RID texture;
 	Image::Format format = Image::FORMAT_MAX;
@@ -167,6 +172,16 @@ private:
 	static void _requested_roughness(void *p_ud, const String &p_normal_path, RS::TextureDetectRoughnessChannel p_roughness_channel);
 	static void _requested_normal(void *p_ud);
 
+	// Texture streaming, the rendering server asks for a new size and the image is loaded in a worker thread.
+	bool streamed = false;
+	BinaryMutex stream_mutex;
+	WorkerThreadPool::TaskID stream_task = WorkerThreadPool::INVALID_TASK_ID;
+
+	static void _requested_stream_size(void *p_ud, int p_max_size);
+	void _stream_load(int p_max_size);
+	void _stream_loaded(const Ref<Image> &p_image);
+	void _stream_wait();
+
 protected:
 	static void _bind_methods();
 	void _validate_property(PropertyInfo &property) const override;
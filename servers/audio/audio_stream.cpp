@@ -74,6 +74,13 @@ void AudioStreamPlayback::seek(float p_time) {
 	}
 }
 
+bool AudioStreamPlayback::can_skip() const {
+	return false;
+}
+
+void AudioStreamPlayback::skip(float p_time) {
+}
+
 int AudioStreamPlayback::mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames) {
 	int ret;
 	if (GDVIRTUAL_CALL(_mix, p_buffer, p_rate_scale, p_frames, ret)) {
@@ -101,10 +108,106 @@ void AudioStreamPlaybackResampled::_begin_resample() {
 	internal_buffer[2] = AudioFrame(0.0, 0.0);
 	internal_buffer[3] = AudioFrame(0.0, 0.0);
 	//mix buffer
-	_mix_internal(internal_buffer + 4, INTERNAL_BUFFER_LEN);
+	_fill_internal(internal_buffer + 4, INTERNAL_BUFFER_LEN);
 	mix_offset = 0;
 }
 
+void AudioStreamPlaybackResampled::_set_prefetch_enabled(bool p_enabled) {
+	_prefetch_reset();
+	prefetch_enabled = p_enabled && WorkerThreadPool::get_singleton()->get_thread_count() > 0;
+	if (prefetch_enabled && prefetch_buffer.size() <= 1) {
+		prefetch_buffer.resize(PREFETCH_BUFFER_BITS);
+		prefetch_chunk.resize(PREFETCH_CHUNK_LEN);
+	}
+}
+
+void AudioStreamPlaybackResampled::_prefetch_task_func(void *p_userdata) {
+	AudioStreamPlaybackResampled *playback = (AudioStreamPlaybackResampled *)p_userdata;
+	playback->prefetch_chunk_frames = playback->_mix_internal(playback->prefetch_chunk.ptr(), PREFETCH_CHUNK_LEN);
+}
+
+void AudioStreamPlaybackResampled::_prefetch_collect(bool p_wait) {
+	if (prefetch_task == WorkerThreadPool::INVALID_TASK_ID) {
+		return;
+	}
+	if (!p_wait && !WorkerThreadPool::get_singleton()->is_task_completed(prefetch_task)) {
+		return;
+	}
+
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(prefetch_task);
+	prefetch_task = WorkerThreadPool::INVALID_TASK_ID;
+
+	prefetch_buffer.write(prefetch_chunk.ptr(), prefetch_chunk_frames);
+	if (prefetch_chunk_frames < PREFETCH_CHUNK_LEN) {
+		prefetch_ended = true;
+	}
+}
+
+void AudioStreamPlaybackResampled::_prefetch_request() {
+	if (prefetch_task != WorkerThreadPool::INVALID_TASK_ID || prefetch_ended || prefetch_buffer.space_left() < PREFETCH_CHUNK_LEN || !is_playing()) {
+		return;
+	}
+
+	prefetch_task = WorkerThreadPool::get_singleton()->add_native_task(&AudioStreamPlaybackResampled::_prefetch_task_func, this);
+}
+
+int AudioStreamPlaybackResampled::_prefetch_reset() {
+	int dropped = _get_prefetched_frames();
+	if (prefetch_task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(prefetch_task);
+		prefetch_task = WorkerThreadPool::INVALID_TASK_ID;
+		dropped += prefetch_chunk_frames;
+	}
+	prefetch_buffer.clear();
+	prefetch_ended = false;
+	return dropped;
+}
+
+int AudioStreamPlaybackResampled::_get_prefetched_frames() const {
+	return prefetch_enabled ? prefetch_buffer.data_left() : 0;
+}
+
+bool AudioStreamPlaybackResampled::_has_frames_left() const {
+	if (prefetch_task != WorkerThreadPool::INVALID_TASK_ID || _get_prefetched_frames() > 0) {
+		return true;
+	}
+	return is_playing(); // Only safe to ask once no chunk is being decoded.
+}
+
+int AudioStreamPlaybackResampled::_fill_internal(AudioFrame *p_buffer, int p_frames) {
+	if (!prefetch_enabled) {
+		return _mix_internal(p_buffer, p_frames);
+	}
+
+	_prefetch_collect(false);
+
+	if (prefetch_buffer.data_left() < p_frames && !prefetch_ended) {
+		// Underrun (or just started), decode what's missing right here, like without prefetching.
+		_prefetch_collect(true);
+		int missing = MIN(p_frames - prefetch_buffer.data_left(), (int)PREFETCH_CHUNK_LEN);
+		if (missing > 0 && !prefetch_ended && is_playing()) {
+			int mixed = _mix_internal(prefetch_chunk.ptr(), missing);
+			prefetch_buffer.write(prefetch_chunk.ptr(), mixed);
+			if (mixed < missing) {
+				prefetch_ended = true;
+			}
+		}
+	}
+
+	int mixed = prefetch_buffer.read(p_buffer, p_frames);
+	for (int i = mixed; i < p_frames; i++) {
+		p_buffer[i] = AudioFrame(0, 0);
+	}
+
+	_prefetch_request();
+
+	return mixed;
+}
+
+AudioStreamPlaybackResampled::~AudioStreamPlaybackResampled() {
+	_prefetch_reset();
+}
+
 int AudioStreamPlaybackResampled::mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames) {
 	float target_rate = AudioServer::get_singleton()->get_mix_rate();
 	float playback_speed_scale = AudioServer::get_singleton()->get_playback_speed_scale();
@@ -143,8 +246,8 @@ int AudioStreamPlaybackResampled::mix(AudioFrame *p_buffer, float p_rate_scale,
 			internal_buffer[1] = internal_buffer[INTERNAL_BUFFER_LEN + 1];
 			internal_buffer[2] = internal_buffer[INTERNAL_BUFFER_LEN + 2];
 			internal_buffer[3] = internal_buffer[INTERNAL_BUFFER_LEN + 3];
-			if (is_playing()) {
-				int mixed_frames = _mix_internal(internal_buffer + 4, INTERNAL_BUFFER_LEN);
+			if (_has_frames_left()) {
+				int mixed_frames = _fill_internal(internal_buffer + 4, INTERNAL_BUFFER_LEN);
 				if (mixed_frames != INTERNAL_BUFFER_LEN) {
 					// internal_buffer[mixed_frames] is the first frame of silence.
 					internal_buffer_end = mixed_frames;
@@ -33,6 +33,9 @@
 
 #include "core/io/image.h"
 #include "core/io/resource.h"
+#include "core/os/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/ring_buffer.h"
 #include "servers/audio/audio_filter_sw.h"
 #include "servers/audio_server.h"
 
@@ -62,6 +65,11 @@ public:
 	virtual float get_playback_position() const;
 	virtual void seek(float p_time);
 
+	// Used for virtual voices. A playback that can skip is only moved forward while it's
+	// virtual, and must resume from the new position on the next mix. The others keep being mixed.
+	virtual bool can_skip() const;
+	virtual void skip(float p_time);
+
 	virtual int mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames);
 };
 
@@ -80,16 +88,46 @@ class AudioStreamPlaybackResampled : public AudioStreamPlayback {
 	unsigned int internal_buffer_end = -1;
 	uint64_t mix_offset;
 
+	// Decoding ahead. Chunks are decoded by _mix_internal() on the worker threads and queued in
+	// prefetch_buffer, so the audio thread mostly just copies frames. Only one chunk is in flight,
+	// and only the thread mixing the playback touches the queue.
+	enum {
+		PREFETCH_CHUNK_LEN = 1024,
+		PREFETCH_BUFFER_BITS = 12,
+	};
+
+	bool prefetch_enabled = false;
+	bool prefetch_ended = false; // The decoder ran out of frames, nothing left to prefetch.
+	RingBuffer<AudioFrame> prefetch_buffer;
+	LocalVector<AudioFrame> prefetch_chunk;
+	int prefetch_chunk_frames = 0;
+	WorkerThreadPool::TaskID prefetch_task = WorkerThreadPool::INVALID_TASK_ID;
+
+	static void _prefetch_task_func(void *p_userdata);
+	void _prefetch_collect(bool p_wait);
+	void _prefetch_request();
+	int _fill_internal(AudioFrame *p_buffer, int p_frames);
+	bool _has_frames_left() const;
+
 protected:
 	void _begin_resample();
 	// Returns the number of frames that were mixed.
 	virtual int _mix_internal(AudioFrame *p_buffer, int p_frames) = 0;
 	virtual float get_stream_sampling_rate() = 0;
 
+	// For playbacks whose _mix_internal() decodes. _prefetch_reset() waits for the chunk in flight
+	// and drops the prefetched frames, returning how many. It must be called before the decoder state
+	// is changed outside _mix_internal() (start, seek, stop...), and at the start of the destructor.
+	void _set_prefetch_enabled(bool p_enabled);
+	int _prefetch_reset();
+	// Frames decoded but not mixed yet, the playback position lags behind the decoder by this much.
+	int _get_prefetched_frames() const;
+
 public:
 	virtual int mix(AudioFrame *p_buffer, float p_rate_scale, int p_frames) override;
 
 	AudioStreamPlaybackResampled() { mix_offset = 0; }
+	~AudioStreamPlaybackResampled();
 };
 
 class AudioStream : public Resource {
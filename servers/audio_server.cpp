@@ -37,6 +37,7 @@
 #include "core/io/resource_loader.h"
 #include "core/math/audio_frame.h"
 #include "core/os/os.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/string/string_name.h"
 #include "core/templates/pair.h"
 #include "scene/resources/audio_stream_sample.h"
@@ -77,6 +78,13 @@ void AudioDriver::update_mix_time(int p_frames) {
 	}
 }
 
+Thread::Settings AudioDriver::get_thread_settings() {
+	Thread::Settings settings;
+	settings.priority = Thread::PRIORITY_HIGH;
+	settings.core_class = Thread::CoreClass(int(GLOBAL_GET("audio/driver/thread_core_class")));
+	return settings;
+}
+
 double AudioDriver::get_time_since_last_mix() {
 	lock();
 	uint64_t last_mix_time = _last_mix_time;
@@ -199,6 +207,8 @@ void AudioDriverManager::initialize(int p_driver) {
 	GLOBAL_DEF_RST("audio/driver/mix_rate.web", 0); // Safer default output_latency for web (use browser default).
 	GLOBAL_DEF_RST("audio/driver/output_latency", DEFAULT_OUTPUT_LATENCY);
 	GLOBAL_DEF_RST("audio/driver/output_latency.web", 50); // Safer default output_latency for web.
+	GLOBAL_DEF_RST("audio/driver/thread_core_class", Thread::CORE_CLASS_ANY);
+	ProjectSettings::get_singleton()->set_custom_property_info("audio/driver/thread_core_class", PropertyInfo(Variant::INT, "audio/driver/thread_core_class", PROPERTY_HINT_ENUM, "Any,Performance,Efficiency"));
 
 	int failed_driver = -1;
 
@@ -241,12 +251,12 @@ AudioDriver *AudioDriverManager::get_driver(int p_driver) {
 //////////////////////////////////////////////
 
 void AudioServer::_driver_process(int p_frames, int32_t *p_buffer) {
+	Memory::TagScope memory_tag(Memory::TAG_AUDIO);
+
 	mix_count++;
 	int todo = p_frames;
 
-#ifdef DEBUG_ENABLED
 	uint64_t prof_ticks = OS::get_singleton()->get_ticks_usec();
-#endif
 
 	if (channel_count != get_channel_count()) {
 		// Amount of channels changed due to a device change
@@ -297,12 +307,19 @@ void AudioServer::_driver_process(int p_frames, int32_t *p_buffer) {
 		to_mix -= to_copy;
 	}
 
+	uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - prof_ticks;
+	if (elapsed * (double)get_mix_rate() > p_frames * 1000000.0) {
+		mix_deadline_miss_count.increment();
+	}
+
 #ifdef DEBUG_ENABLED
-	prof_time += OS::get_singleton()->get_ticks_usec() - prof_ticks;
+	prof_time += elapsed;
 #endif
 }
 
 void AudioServer::_mix_step() {
+	_flush_bus_commands();
+
 	bool solo_mode = false;
 
 	for (int i = 0; i < buses.size(); i++) {
@@ -312,7 +329,7 @@ void AudioServer::_mix_step() {
 			bus->channels.write[k].used = false;
 		}
 
-		if (bus->solo) {
+		if (bus->mix_state.solo) {
 			//solo chain
 			solo_mode = true;
 			bus->soloed = true;
@@ -343,113 +360,125 @@ void AudioServer::_mix_step() {
 		ci->callback(ci->userdata);
 	}
 
+	_update_virtual_voices();
+
 	for (AudioStreamPlaybackListNode *playback : playback_list) {
 		// Paused streams are no-ops. Don't even mix audio from the stream playback.
 		if (playback->state.load() == AudioStreamPlaybackListNode::PAUSED) {
 			continue;
 		}
 
-		bool fading_out = playback->state.load() == AudioStreamPlaybackListNode::FADE_OUT_TO_DELETION || playback->state.load() == AudioStreamPlaybackListNode::FADE_OUT_TO_PAUSE;
-
-		AudioFrame *buf = mix_buffer.ptrw();
-
-		// Copy the lookeahead buffer into the mix buffer.
-		for (int i = 0; i < LOOKAHEAD_BUFFER_SIZE; i++) {
-			buf[i] = playback->lookahead[i];
-		}
-
-		// Mix the audio stream
-		unsigned int mixed_frames = playback->stream_playback->mix(&buf[LOOKAHEAD_BUFFER_SIZE], playback->pitch_scale.get(), buffer_size);
+		if (playback->is_virtual) {
+			_mix_step_virtual(playback);
+		} else {
+			bool fading_out = playback->state.load() == AudioStreamPlaybackListNode::FADE_OUT_TO_DELETION || playback->state.load() == AudioStreamPlaybackListNode::FADE_OUT_TO_PAUSE || playback->fading_to_virtual;
 
-		if (mixed_frames != buffer_size) {
-			// We know we have at least the size of our lookahead buffer for fade-out purposes.
+			AudioFrame *buf = mix_buffer.ptrw();
 
-			float fadeout_base = 0.94;
-			float fadeout_coefficient = 1;
-			static_assert(LOOKAHEAD_BUFFER_SIZE == 64, "Update fadeout_base and comment here if you change LOOKAHEAD_BUFFER_SIZE.");
-			// 0.94 ^ 64 = 0.01906. There might still be a pop but it'll be way better than if we didn't do this.
-			for (unsigned int idx = mixed_frames; idx < buffer_size; idx++) {
-				fadeout_coefficient *= fadeout_base;
-				buf[idx] *= fadeout_coefficient;
-			}
-			AudioStreamPlaybackListNode::PlaybackState new_state;
-			new_state = AudioStreamPlaybackListNode::AWAITING_DELETION;
-			playback->state.store(new_state);
-		} else {
-			// Move the last little bit of what we just mixed into our lookahead buffer.
+			// Copy the lookeahead buffer into the mix buffer.
 			for (int i = 0; i < LOOKAHEAD_BUFFER_SIZE; i++) {
-				playback->lookahead[i] = buf[buffer_size + i];
+				buf[i] = playback->lookahead[i];
 			}
-		}
 
-		AudioStreamPlaybackBusDetails *ptr = playback->bus_details.load();
-		ERR_FAIL_COND(ptr == nullptr);
-		// By putting null into the bus details pointers, we're taking ownership of their memory for the duration of this mix.
-		AudioStreamPlaybackBusDetails bus_details = *ptr;
+			// Mix the audio stream
+			unsigned int mixed_frames = playback->stream_playback->mix(&buf[LOOKAHEAD_BUFFER_SIZE], playback->pitch_scale.get(), buffer_size);
 
-		// Mix to any active buses.
-		for (int idx = 0; idx < MAX_BUSES_PER_PLAYBACK; idx++) {
-			if (!bus_details.bus_active[idx]) {
-				continue;
-			}
-			int bus_idx = thread_find_bus_index(bus_details.bus[idx]);
+			if (mixed_frames != buffer_size) {
+				// We know we have at least the size of our lookahead buffer for fade-out purposes.
 
-			int prev_bus_idx = -1;
-			for (int search_idx = 0; search_idx < MAX_BUSES_PER_PLAYBACK; search_idx++) {
-				if (!playback->prev_bus_details->bus_active[search_idx]) {
-					continue;
+				float fadeout_base = 0.94;
+				float fadeout_coefficient = 1;
+				static_assert(LOOKAHEAD_BUFFER_SIZE == 64, "Update fadeout_base and comment here if you change LOOKAHEAD_BUFFER_SIZE.");
+				// 0.94 ^ 64 = 0.01906. There might still be a pop but it'll be way better than if we didn't do this.
+				for (unsigned int idx = mixed_frames; idx < buffer_size; idx++) {
+					fadeout_coefficient *= fadeout_base;
+					buf[idx] *= fadeout_coefficient;
 				}
-				if (playback->prev_bus_details->bus[search_idx].hash() == bus_details.bus[idx].hash()) {
-					prev_bus_idx = search_idx;
+				AudioStreamPlaybackListNode::PlaybackState new_state;
+				new_state = AudioStreamPlaybackListNode::AWAITING_DELETION;
+				playback->state.store(new_state);
+			} else {
+				// Move the last little bit of what we just mixed into our lookahead buffer.
+				for (int i = 0; i < LOOKAHEAD_BUFFER_SIZE; i++) {
+					playback->lookahead[i] = buf[buffer_size + i];
 				}
 			}
 
-			for (int channel_idx = 0; channel_idx < channel_count; channel_idx++) {
-				AudioFrame *channel_buf = thread_get_channel_mix_buffer(bus_idx, channel_idx);
-				if (fading_out) {
-					bus_details.volume[idx][channel_idx] = AudioFrame(0, 0);
+			AudioStreamPlaybackBusDetails *ptr = playback->bus_details.load();
+			ERR_FAIL_COND(ptr == nullptr);
+			// By putting null into the bus details pointers, we're taking ownership of their memory for the duration of this mix.
+			AudioStreamPlaybackBusDetails bus_details = *ptr;
+
+			// Mix to any active buses.
+			for (int idx = 0; idx < MAX_BUSES_PER_PLAYBACK; idx++) {
+				if (!bus_details.bus_active[idx]) {
+					continue;
 				}
-				AudioFrame channel_vol = bus_details.volume[idx][channel_idx];
+				int bus_idx = thread_find_bus_index(bus_details.bus[idx]);
 
-				AudioFrame prev_channel_vol = AudioFrame(0, 0);
-				if (prev_bus_idx != -1) {
-					prev_channel_vol = playback->prev_bus_details->volume[prev_bus_idx][channel_idx];
+				int prev_bus_idx = -1;
+				for (int search_idx = 0; search_idx < MAX_BUSES_PER_PLAYBACK; search_idx++) {
+					if (!playback->prev_bus_details->bus_active[search_idx]) {
+						continue;
+					}
+					if (playback->prev_bus_details->bus[search_idx].hash() == bus_details.bus[idx].hash()) {
+						prev_bus_idx = search_idx;
+					}
 				}
-				_mix_step_for_channel(channel_buf, buf, prev_channel_vol, channel_vol, playback->attenuation_filter_cutoff_hz.get(), playback->highshelf_gain.get(), &playback->filter_process[channel_idx * 2], &playback->filter_process[channel_idx * 2 + 1]);
-			}
-		}
 
-		// Now go through and fade-out any buses that were being played to previously that we missed by going through current data.
-		for (int idx = 0; idx < MAX_BUSES_PER_PLAYBACK; idx++) {
-			if (!playback->prev_bus_details->bus_active[idx]) {
-				continue;
-			}
-			int bus_idx = thread_find_bus_index(playback->prev_bus_details->bus[idx]);
+				for (int channel_idx = 0; channel_idx < channel_count; channel_idx++) {
+					AudioFrame *channel_buf = thread_get_channel_mix_buffer(bus_idx, channel_idx);
+					if (fading_out) {
+						bus_details.volume[idx][channel_idx] = AudioFrame(0, 0);
+					}
+					AudioFrame channel_vol = bus_details.volume[idx][channel_idx];
 
-			int current_bus_idx = -1;
-			for (int search_idx = 0; search_idx < MAX_BUSES_PER_PLAYBACK; search_idx++) {
-				if (bus_details.bus[search_idx] == playback->prev_bus_details->bus[idx]) {
-					current_bus_idx = search_idx;
+					AudioFrame prev_channel_vol = AudioFrame(0, 0);
+					if (prev_bus_idx != -1) {
+						prev_channel_vol = playback->prev_bus_details->volume[prev_bus_idx][channel_idx];
+					}
+					_mix_step_for_channel(channel_buf, buf, prev_channel_vol, channel_vol, playback->attenuation_filter_cutoff_hz.get(), playback->highshelf_gain.get(), &playback->filter_process[channel_idx * 2], &playback->filter_process[channel_idx * 2 + 1]);
 				}
 			}
-			if (current_bus_idx != -1) {
-				// If we found a corresponding bus in the current bus assignments, we've already mixed to this bus.
-				continue;
+
+			// Now go through and fade-out any buses that were being played to previously that we missed by going through current data.
+			for (int idx = 0; idx < MAX_BUSES_PER_PLAYBACK; idx++) {
+				if (!playback->prev_bus_details->bus_active[idx]) {
+					continue;
+				}
+				int bus_idx = thread_find_bus_index(playback->prev_bus_details->bus[idx]);
+
+				int current_bus_idx = -1;
+				for (int search_idx = 0; search_idx < MAX_BUSES_PER_PLAYBACK; search_idx++) {
+					if (bus_details.bus[search_idx] == playback->prev_bus_details->bus[idx]) {
+						current_bus_idx = search_idx;
+					}
+				}
+				if (current_bus_idx != -1) {
+					// If we found a corresponding bus in the current bus assignments, we've already mixed to this bus.
+					continue;
+				}
+
+				for (int channel_idx = 0; channel_idx < channel_count; channel_idx++) {
+					AudioFrame *channel_buf = thread_get_channel_mix_buffer(bus_idx, channel_idx);
+					AudioFrame prev_channel_vol = playback->prev_bus_details->volume[idx][channel_idx];
+					// Fade out to silence
+					_mix_step_for_channel(channel_buf, buf, prev_channel_vol, AudioFrame(0, 0), playback->attenuation_filter_cutoff_hz.get(), playback->highshelf_gain.get(), &playback->filter_process[channel_idx * 2], &playback->filter_process[channel_idx * 2 + 1]);
+				}
 			}
 
-			for (int channel_idx = 0; channel_idx < channel_count; channel_idx++) {
-				AudioFrame *channel_buf = thread_get_channel_mix_buffer(bus_idx, channel_idx);
-				AudioFrame prev_channel_vol = playback->prev_bus_details->volume[idx][channel_idx];
-				// Fade out to silence
-				_mix_step_for_channel(channel_buf, buf, prev_channel_vol, AudioFrame(0, 0), playback->attenuation_filter_cutoff_hz.get(), playback->highshelf_gain.get(), &playback->filter_process[channel_idx * 2], &playback->filter_process[channel_idx * 2 + 1]);
+			// Copy the bus details we mixed with to the previous bus details to maintain volume ramps.
+			std::copy(std::begin(bus_details.bus_active), std::end(bus_details.bus_active), std::begin(playback->prev_bus_details->bus_active));
+			std::copy(std::begin(bus_details.bus), std::end(bus_details.bus), std::begin(playback->prev_bus_details->bus));
+			for (int bus_idx = 0; bus_idx < MAX_BUSES_PER_PLAYBACK; bus_idx++) {
+				std::copy(std::begin(bus_details.volume[bus_idx]), std::end(bus_details.volume[bus_idx]), std::begin(playback->prev_bus_details->volume[bus_idx]));
 			}
-		}
 
-		// Copy the bus details we mixed with to the previous bus details to maintain volume ramps.
-		std::copy(std::begin(bus_details.bus_active), std::end(bus_details.bus_active), std::begin(playback->prev_bus_details->bus_active));
-		std::copy(std::begin(bus_details.bus), std::end(bus_details.bus), std::begin(playback->prev_bus_details->bus));
-		for (int bus_idx = 0; bus_idx < MAX_BUSES_PER_PLAYBACK; bus_idx++) {
-			std::copy(std::begin(bus_details.volume[bus_idx]), std::end(bus_details.volume[bus_idx]), std::begin(playback->prev_bus_details->volume[bus_idx]));
+			if (playback->fading_to_virtual) {
+				// Faded to silence in this mix, so resuming ramps the volume back up.
+				playback->fading_to_virtual = false;
+				playback->is_virtual = true;
+			}
 		}
 
 		switch (playback->state.load()) {
@@ -479,131 +508,248 @@ void AudioServer::_mix_step() {
 		}
 	}
 
-	for (int i = buses.size() - 1; i >= 0; i--) {
-		//go bus by bus
-		Bus *bus = buses[i];
-
-		for (int k = 0; k < bus->channels.size(); k++) {
-			if (bus->channels[k].active && !bus->channels[k].used) {
-				//buffer was not used, but it's still active, so it must be cleaned
-				AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+	// Resolve the sends and sort the buses into levels. A bus can be processed once every
+	// bus sending to it is done, and buses only send to lower indices.
+	int bus_count = buses.size();
+	bus_send_cache.resize(bus_count);
+	bus_level_cache.resize(bus_count);
+	int level_count = 0;
 
-				for (uint32_t j = 0; j < buffer_size; j++) {
-					buf[j] = AudioFrame(0, 0);
+	for (int i = bus_count - 1; i >= 0; i--) {
+		bus_level_cache[i] = 0;
+	}
+	for (int i = bus_count - 1; i >= 0; i--) {
+		Bus *bus = buses[i];
+		int send = -1;
+		if (i > 0) {
+			//everything has a send save for master bus
+			send = 0;
+			if (bus_map.has(bus->send)) {
+				int send_index = bus_map[bus->send]->index_cache;
+				if (send_index < bus->index_cache) { //otherwise invalid, send to master
+					send = send_index;
 				}
 			}
+			bus_level_cache[send] = MAX(bus_level_cache[send], bus_level_cache[i] + 1);
 		}
+		bus_send_cache[i] = send;
+		level_count = MAX(level_count, bus_level_cache[i] + 1);
+	}
 
-		//process effects
-		if (!bus->bypass) {
-			for (int j = 0; j < bus->effects.size(); j++) {
-				if (!bus->effects[j].enabled) {
-					continue;
+	for (int level = 0; level < level_count; level++) {
+		bus_level_work.clear();
+		int buses_with_effects = 0;
+		for (int i = bus_count - 1; i >= 0; i--) {
+			if (bus_level_cache[i] != level) {
+				continue;
+			}
+			Bus *bus = buses[i];
+			bus_level_work.push_back(bus);
+			if (!bus->mix_state.bypass) {
+				for (int j = 0; j < bus->effects.size(); j++) {
+					if (bus->effects[j].mix_enabled) {
+						buses_with_effects++;
+						break;
+					}
 				}
+			}
+		}
 
-#ifdef DEBUG_ENABLED
-				uint64_t ticks = OS::get_singleton()->get_ticks_usec();
-#endif
+		if (threaded_effects && buses_with_effects > 1 && WorkerThreadPool::get_singleton()->get_thread_count() > 0) {
+			WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &AudioServer::_mix_step_bus_group, solo_mode, bus_level_work.size());
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		} else {
+			for (uint32_t i = 0; i < bus_level_work.size(); i++) {
+				_mix_step_bus(bus_level_work[i], solo_mode);
+			}
+		}
 
-				for (int k = 0; k < bus->channels.size(); k++) {
-					if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence())) {
-						continue;
-					}
-					bus->channels.write[k].effect_instances.write[j]->process(bus->channels[k].buffer.ptr(), temp_buffer.write[k].ptrw(), buffer_size);
-				}
+		//process sends, serially since buses of a level may share their target
+		for (uint32_t i = 0; i < bus_level_work.size(); i++) {
+			Bus *bus = bus_level_work[i];
+			int send = bus_send_cache[bus->index_cache];
+			if (send < 0) {
+				continue; //master bus
+			}
 
-				//swap buffers, so internal buffer always has the right data
-				for (int k = 0; k < bus->channels.size(); k++) {
-					if (!(buses[i]->channels[k].active || bus->channels[k].effect_instances[j]->process_silence())) {
-						continue;
-					}
-					SWAP(bus->channels.write[k].buffer, temp_buffer.write[k]);
+			for (int k = 0; k < bus->channels.size(); k++) {
+				if (!bus->channels[k].active) {
+					continue;
 				}
 
-#ifdef DEBUG_ENABLED
-				bus->effects.write[j].prof_time += OS::get_singleton()->get_ticks_usec() - ticks;
-#endif
+				const AudioFrame *buf = bus->channels[k].buffer.ptr();
+				AudioFrame *target_buf = thread_get_channel_mix_buffer(send, k);
+
+				for (uint32_t j = 0; j < buffer_size; j++) {
+					target_buf[j] += buf[j];
+				}
 			}
 		}
+	}
 
-		//process send
+	mix_frames += buffer_size;
+	to_mix = buffer_size;
+}
 
-		Bus *send = nullptr;
+void AudioServer::_update_virtual_voices() {
+	voice_candidates.clear();
 
-		if (i > 0) {
-			//everything has a send save for master bus
-			if (!bus_map.has(bus->send)) {
-				send = buses[0];
-			} else {
-				send = bus_map[bus->send];
-				if (send->index_cache >= bus->index_cache) { //invalid, send to master
-					send = buses[0];
-				}
-			}
+	for (AudioStreamPlaybackListNode *playback : playback_list) {
+		if (playback->state.load() != AudioStreamPlaybackListNode::PLAYING) {
+			// Paused or fading out, virtual voices stay virtual and audible ones keep fading.
+			continue;
 		}
 
-		for (int k = 0; k < bus->channels.size(); k++) {
-			if (!bus->channels[k].active) {
-				bus->channels.write[k].peak_volume = AudioFrame(AUDIO_MIN_PEAK_DB, AUDIO_MIN_PEAK_DB);
+		float loudness = 0.0;
+		AudioStreamPlaybackBusDetails *bus_details = playback->bus_details.load();
+		for (int idx = 0; idx < MAX_BUSES_PER_PLAYBACK; idx++) {
+			if (!bus_details->bus_active[idx]) {
 				continue;
 			}
+			for (int channel_idx = 0; channel_idx < channel_count; channel_idx++) {
+				const AudioFrame &vol = bus_details->volume[idx][channel_idx];
+				loudness = MAX(loudness, MAX(ABS(vol.l), ABS(vol.r)));
+			}
+		}
 
-			AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+		if (loudness < voice_virtualize_threshold) {
+			if (!playback->is_virtual) {
+				playback->fading_to_virtual = true;
+			}
+			continue;
+		}
 
-			AudioFrame peak = AudioFrame(0, 0);
+		VoiceCandidate candidate;
+		candidate.playback = playback;
+		candidate.priority = playback->priority.get();
+		candidate.loudness = loudness;
+		voice_candidates.push_back(candidate);
+	}
 
-			float volume = Math::db2linear(bus->volume_db);
+	uint32_t audible_voices = voice_candidates.size();
+	if (max_voices > 0 && audible_voices > (uint32_t)max_voices) {
+		// Over the limit, keep the highest priority and then loudest voices.
+		voice_candidates.sort();
+		audible_voices = max_voices;
+	}
 
-			if (solo_mode) {
-				if (!bus->soloed) {
-					volume = 0.0;
-				}
-			} else {
-				if (bus->mute) {
-					volume = 0.0;
-				}
-			}
+	for (uint32_t i = 0; i < voice_candidates.size(); i++) {
+		AudioStreamPlaybackListNode *playback = voice_candidates[i].playback;
+		if (i < audible_voices) {
+			playback->is_virtual = false;
+			playback->fading_to_virtual = false;
+		} else if (!playback->is_virtual) {
+			playback->fading_to_virtual = true;
+		}
+	}
+}
 
-			//apply volume and compute peak
-			for (uint32_t j = 0; j < buffer_size; j++) {
-				buf[j] *= volume;
+void AudioServer::_mix_step_virtual(AudioStreamPlaybackListNode *p_playback) {
+	bool ended = false;
+	if (p_playback->stream_playback->can_skip()) {
+		p_playback->stream_playback->skip(buffer_size / get_mix_rate() * p_playback->pitch_scale.get() * playback_speed_scale);
+		ended = !p_playback->stream_playback->is_playing();
+	} else {
+		// Keep the position by mixing it anyway, the result just doesn't go to any bus.
+		ended = p_playback->stream_playback->mix(mix_buffer.ptrw(), p_playback->pitch_scale.get(), buffer_size) != (int)buffer_size;
+	}
 
-				float l = ABS(buf[j].l);
-				if (l > peak.l) {
-					peak.l = l;
-				}
-				float r = ABS(buf[j].r);
-				if (r > peak.r) {
-					peak.r = r;
-				}
+	// Whatever was ahead is stale once the voice resumes.
+	for (AudioFrame &frame : p_playback->lookahead) {
+		frame = AudioFrame(0, 0);
+	}
+
+	if (ended) {
+		p_playback->state.store(AudioStreamPlaybackListNode::AWAITING_DELETION);
+	}
+}
+
+void AudioServer::_mix_step_bus(Bus *p_bus, bool p_solo_mode) {
+	for (int k = 0; k < p_bus->channels.size(); k++) {
+		if (p_bus->channels[k].active && !p_bus->channels[k].used) {
+			//buffer was not used, but it's still active, so it must be cleaned
+			AudioFrame *buf = p_bus->channels.write[k].buffer.ptrw();
+
+			for (uint32_t j = 0; j < buffer_size; j++) {
+				buf[j] = AudioFrame(0, 0);
 			}
+		}
+	}
 
-			bus->channels.write[k].peak_volume = AudioFrame(Math::linear2db(peak.l + AUDIO_PEAK_OFFSET), Math::linear2db(peak.r + AUDIO_PEAK_OFFSET));
+	//process effects
+	if (!p_bus->mix_state.bypass) {
+		for (int j = 0; j < p_bus->effects.size(); j++) {
+			if (!p_bus->effects[j].mix_enabled) {
+				continue;
+			}
 
-			if (!bus->channels[k].used) {
-				//see if any audio is contained, because channel was not used
+#ifdef DEBUG_ENABLED
+			uint64_t ticks = OS::get_singleton()->get_ticks_usec();
+#endif
 
-				if (MAX(peak.r, peak.l) > Math::db2linear(channel_disable_threshold_db)) {
-					bus->channels.write[k].last_mix_with_audio = mix_frames;
-				} else if (mix_frames - bus->channels[k].last_mix_with_audio > channel_disable_frames) {
-					bus->channels.write[k].active = false;
-					continue; //went inactive, don't mix.
+			for (int k = 0; k < p_bus->channels.size(); k++) {
+				Bus::Channel &channel = p_bus->channels.write[k];
+				if (!(channel.active || channel.effect_instances[j]->process_silence())) {
+					continue;
 				}
+				channel.effect_instances.write[j]->process(channel.buffer.ptr(), channel.effect_buffer.ptrw(), buffer_size);
+				//swap buffers, so internal buffer always has the right data
+				SWAP(channel.buffer, channel.effect_buffer);
 			}
 
-			if (send) {
-				//if not master bus, send
-				AudioFrame *target_buf = thread_get_channel_mix_buffer(send->index_cache, k);
+#ifdef DEBUG_ENABLED
+			p_bus->effects.write[j].prof_time += OS::get_singleton()->get_ticks_usec() - ticks;
+#endif
+		}
+	}
 
-				for (uint32_t j = 0; j < buffer_size; j++) {
-					target_buf[j] += buf[j];
-				}
+	float volume = Math::db2linear(p_bus->mix_state.volume_db);
+
+	if (p_solo_mode) {
+		if (!p_bus->soloed) {
+			volume = 0.0;
+		}
+	} else {
+		if (p_bus->mix_state.mute) {
+			volume = 0.0;
+		}
+	}
+
+	for (int k = 0; k < p_bus->channels.size(); k++) {
+		Bus::Channel &channel = p_bus->channels.write[k];
+		if (!channel.active) {
+			channel.peak_volume = AudioFrame(AUDIO_MIN_PEAK_DB, AUDIO_MIN_PEAK_DB);
+			continue;
+		}
+
+		AudioFrame *buf = channel.buffer.ptrw();
+
+		float peak_l = 0.0;
+		float peak_r = 0.0;
+
+		//apply volume and compute peak, kept branchless so it vectorizes
+		for (uint32_t j = 0; j < buffer_size; j++) {
+			buf[j] *= volume;
+			peak_l = MAX(peak_l, ABS(buf[j].l));
+			peak_r = MAX(peak_r, ABS(buf[j].r));
+		}
+
+		channel.peak_volume = AudioFrame(Math::linear2db(peak_l + AUDIO_PEAK_OFFSET), Math::linear2db(peak_r + AUDIO_PEAK_OFFSET));
+
+		if (!channel.used) {
+			//see if any audio is contained, because channel was not used
+
+			if (MAX(peak_r, peak_l) > Math::db2linear(channel_disable_threshold_db)) {
+				channel.last_mix_with_audio = mix_frames;
+			} else if (mix_frames - channel.last_mix_with_audio > channel_disable_frames) {
+				channel.active = false; //went inactive, don't send.
 			}
 		}
 	}
+}
 
-	mix_frames += buffer_size;
-	to_mix = buffer_size;
+void AudioServer::_mix_step_bus_group(uint32_t p_index, bool p_solo_mode) {
+	_mix_step_bus(bus_level_work[p_index], p_solo_mode);
 }
 
 void AudioServer::_mix_step_for_channel(AudioFrame *p_out_buf, AudioFrame *p_source_buf, AudioFrame p_vol_start, AudioFrame p_vol_final, float p_attenuation_filter_cutoff_hz, float p_highshelf_gain, AudioFilterSW::Processor *p_processor_l, AudioFilterSW::Processor *p_processor_r) {
@@ -625,21 +771,32 @@ void AudioServer::_mix_step_for_channel(AudioFrame *p_out_buf, AudioFrame *p_sou
 		p_processor_r->set_filter(&filter, /* clear_history= */ is_just_started);
 		p_processor_r->update_coeffs(buffer_size);
 
+		// The biquads are recursive, so they can't be vectorized over time. Left and right
+		// are independent though, and run interleaved.
+		// Make this buffer size invariant if buffer_size ever becomes a project setting.
+		const float inv_size = 1.0f / buffer_size;
+		const AudioFrame vol_delta = p_vol_final - p_vol_start;
 		for (unsigned int frame_idx = 0; frame_idx < buffer_size; frame_idx++) {
-			// Make this buffer size invariant if buffer_size ever becomes a project setting.
-			float lerp_param = (float)frame_idx / buffer_size;
-			AudioFrame vol = p_vol_final * lerp_param + (1 - lerp_param) * p_vol_start;
+			AudioFrame vol = p_vol_start + vol_delta * (frame_idx * inv_size);
 			AudioFrame mixed = vol * p_source_buf[frame_idx];
 			p_processor_l->process_one_interp(mixed.l);
 			p_processor_r->process_one_interp(mixed.r);
 			p_out_buf[frame_idx] += mixed;
 		}
 
+	} else if (p_vol_start.l == p_vol_final.l && p_vol_start.r == p_vol_final.r) {
+		// Constant volume, the common case for playbacks that don't move.
+		for (unsigned int frame_idx = 0; frame_idx < buffer_size; frame_idx++) {
+			p_out_buf[frame_idx] += p_vol_final * p_source_buf[frame_idx];
+		}
 	} else {
+		// Computing the ramp from the index (instead of accumulating a step) keeps the
+		// iterations independent, so the loop vectorizes.
+		// Make this buffer size invariant if buffer_size ever becomes a project setting.
+		const float inv_size = 1.0f / buffer_size;
+		const AudioFrame vol_delta = p_vol_final - p_vol_start;
 		for (unsigned int frame_idx = 0; frame_idx < buffer_size; frame_idx++) {
-			// Make this buffer size invariant if buffer_size ever becomes a project setting.
-			float lerp_param = (float)frame_idx / buffer_size;
-			p_out_buf[frame_idx] += (p_vol_final * lerp_param + (1 - lerp_param) * p_vol_start) * p_source_buf[frame_idx];
+			p_out_buf[frame_idx] += (p_vol_start + vol_delta * (frame_idx * inv_size)) * p_source_buf[frame_idx];
 		}
 	}
 }
@@ -735,6 +892,7 @@ void AudioServer::set_bus_count(int p_count) {
 		buses.write[i]->channels.resize(channel_count);
 		for (int j = 0; j < channel_count; j++) {
 			buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+			buses.write[i]->channels.write[j].effect_buffer.resize(buffer_size);
 		}
 		buses[i]->name = attempt;
 		buses[i]->solo = false;
@@ -744,6 +902,7 @@ void AudioServer::set_bus_count(int p_count) {
 		if (i > 0) {
 			buses[i]->send = "Master";
 		}
+		_sync_bus_mix_state(buses[i]);
 
 		bus_map[attempt] = buses[i];
 	}
@@ -804,13 +963,16 @@ void AudioServer::add_bus(int p_at_pos) {
 	bus->channels.resize(channel_count);
 	for (int j = 0; j < channel_count; j++) {
 		bus->channels.write[j].buffer.resize(buffer_size);
+		bus->channels.write[j].effect_buffer.resize(buffer_size);
 	}
 	bus->name = attempt;
 	bus->solo = false;
 	bus->mute = false;
 	bus->bypass = false;
 	bus->volume_db = 0;
+	_sync_bus_mix_state(bus);
 
+	lock();
 	bus_map[attempt] = bus;
 
 	if (p_at_pos == -1) {
@@ -818,6 +980,7 @@ void AudioServer::add_bus(int p_at_pos) {
 	} else {
 		buses.insert(p_at_pos, bus);
 	}
+	unlock();
 
 	emit_signal(SNAME("bus_layout_changed"));
 }
@@ -832,6 +995,7 @@ void AudioServer::move_bus(int p_bus, int p_to_pos) {
 		return;
 	}
 
+	lock();
 	Bus *bus = buses[p_bus];
 	buses.remove(p_bus);
 
@@ -842,6 +1006,7 @@ void AudioServer::move_bus(int p_bus, int p_to_pos) {
 	} else {
 		buses.insert(p_to_pos - 1, bus);
 	}
+	unlock();
 
 	emit_signal(SNAME("bus_layout_changed"));
 }
@@ -912,6 +1077,12 @@ void AudioServer::set_bus_volume_db(int p_bus, float p_volume_db) {
 	MARK_EDITED
 
 	buses[p_bus]->volume_db = p_volume_db;
+
+	BusCommand command;
+	command.type = BusCommand::SET_VOLUME_DB;
+	command.bus = buses[p_bus];
+	command.value = p_volume_db;
+	_push_bus_command(command);
 }
 
 float AudioServer::get_bus_volume_db(int p_bus) const {
@@ -929,7 +1100,9 @@ void AudioServer::set_bus_send(int p_bus, const StringName &p_send) {
 
 	MARK_EDITED
 
+	lock();
 	buses[p_bus]->send = p_send;
+	unlock();
 }
 
 StringName AudioServer::get_bus_send(int p_bus) const {
@@ -943,6 +1116,12 @@ void AudioServer::set_bus_solo(int p_bus, bool p_enable) {
 	MARK_EDITED
 
 	buses[p_bus]->solo = p_enable;
+
+	BusCommand command;
+	command.type = BusCommand::SET_SOLO;
+	command.bus = buses[p_bus];
+	command.enabled = p_enable;
+	_push_bus_command(command);
 }
 
 bool AudioServer::is_bus_solo(int p_bus) const {
@@ -957,6 +1136,12 @@ void AudioServer::set_bus_mute(int p_bus, bool p_enable) {
 	MARK_EDITED
 
 	buses[p_bus]->mute = p_enable;
+
+	BusCommand command;
+	command.type = BusCommand::SET_MUTE;
+	command.bus = buses[p_bus];
+	command.enabled = p_enable;
+	_push_bus_command(command);
 }
 
 bool AudioServer::is_bus_mute(int p_bus) const {
@@ -971,6 +1156,12 @@ void AudioServer::set_bus_bypass_effects(int p_bus, bool p_enable) {
 	MARK_EDITED
 
 	buses[p_bus]->bypass = p_enable;
+
+	BusCommand command;
+	command.type = BusCommand::SET_BYPASS;
+	command.bus = buses[p_bus];
+	command.enabled = p_enable;
+	_push_bus_command(command);
 }
 
 bool AudioServer::is_bus_bypassing_effects(int p_bus) const {
@@ -979,6 +1170,67 @@ bool AudioServer::is_bus_bypassing_effects(int p_bus) const {
 	return buses[p_bus]->bypass;
 }
 
+void AudioServer::_push_bus_command(const BusCommand &p_command) {
+	while (true) {
+		bus_command_producer_lock.lock();
+		uint32_t write = bus_command_write.load(std::memory_order_relaxed);
+		if (write - bus_command_read.load(std::memory_order_acquire) < BUS_COMMAND_QUEUE_SIZE) {
+			bus_commands[write & (BUS_COMMAND_QUEUE_SIZE - 1)] = p_command;
+			bus_command_write.store(write + 1, std::memory_order_release);
+			bus_command_producer_lock.unlock();
+			return;
+		}
+		bus_command_producer_lock.unlock();
+
+		// Full, the audio thread isn't keeping up (or isn't running). Taking the lock flushes the queue.
+		lock();
+		unlock();
+	}
+}
+
+void AudioServer::_apply_bus_command(const BusCommand &p_command) {
+	Bus *bus = p_command.bus;
+	switch (p_command.type) {
+		case BusCommand::SET_VOLUME_DB: {
+			bus->mix_state.volume_db = p_command.value;
+		} break;
+		case BusCommand::SET_SOLO: {
+			bus->mix_state.solo = p_command.enabled;
+		} break;
+		case BusCommand::SET_MUTE: {
+			bus->mix_state.mute = p_command.enabled;
+		} break;
+		case BusCommand::SET_BYPASS: {
+			bus->mix_state.bypass = p_command.enabled;
+		} break;
+		case BusCommand::SET_EFFECT_ENABLED: {
+			if (p_command.effect < bus->effects.size()) {
+				bus->effects.write[p_command.effect].mix_enabled = p_command.enabled;
+			}
+		} break;
+	}
+}
+
+void AudioServer::_flush_bus_commands() {
+	uint32_t read = bus_command_read.load(std::memory_order_relaxed);
+	uint32_t write = bus_command_write.load(std::memory_order_acquire);
+	while (read != write) {
+		_apply_bus_command(bus_commands[read & (BUS_COMMAND_QUEUE_SIZE - 1)]);
+		read++;
+	}
+	bus_command_read.store(read, std::memory_order_release);
+}
+
+void AudioServer::_sync_bus_mix_state(Bus *p_bus) {
+	p_bus->mix_state.volume_db = p_bus->volume_db;
+	p_bus->mix_state.solo = p_bus->solo;
+	p_bus->mix_state.mute = p_bus->mute;
+	p_bus->mix_state.bypass = p_bus->bypass;
+	for (int i = 0; i < p_bus->effects.size(); i++) {
+		p_bus->effects.write[i].mix_enabled = p_bus->effects[i].enabled;
+	}
+}
+
 void AudioServer::_update_bus_effects(int p_bus) {
 	for (int i = 0; i < buses[p_bus]->channels.size(); i++) {
 		buses.write[p_bus]->channels.write[i].effect_instances.resize(buses[p_bus]->effects.size());
@@ -1015,6 +1267,7 @@ void AudioServer::add_bus_effect(int p_bus, const Ref<AudioEffect> &p_effect, in
 	}
 
 	_update_bus_effects(p_bus);
+	_sync_bus_mix_state(buses[p_bus]);
 
 	unlock();
 }
@@ -1028,6 +1281,7 @@ void AudioServer::remove_bus_effect(int p_bus, int p_effect) {
 
 	buses[p_bus]->effects.remove(p_effect);
 	_update_bus_effects(p_bus);
+	_sync_bus_mix_state(buses[p_bus]);
 
 	unlock();
 }
@@ -1063,6 +1317,7 @@ void AudioServer::swap_bus_effects(int p_bus, int p_effect, int p_by_effect) {
 	lock();
 	SWAP(buses.write[p_bus]->effects.write[p_effect], buses.write[p_bus]->effects.write[p_by_effect]);
 	_update_bus_effects(p_bus);
+	_sync_bus_mix_state(buses[p_bus]);
 	unlock();
 }
 
@@ -1073,6 +1328,13 @@ void AudioServer::set_bus_effect_enabled(int p_bus, int p_effect, bool p_enabled
 	MARK_EDITED
 
 	buses.write[p_bus]->effects.write[p_effect].enabled = p_enabled;
+
+	BusCommand command;
+	command.type = BusCommand::SET_EFFECT_ENABLED;
+	command.bus = buses[p_bus];
+	command.effect = p_effect;
+	command.enabled = p_enabled;
+	_push_bus_command(command);
 }
 
 bool AudioServer::is_bus_effect_enabled(int p_bus, int p_effect) const {
@@ -1250,6 +1512,17 @@ void AudioServer::set_playback_pitch_scale(Ref<AudioStreamPlayback> p_playback,
 	playback_node->pitch_scale.set(p_pitch_scale);
 }
 
+void AudioServer::set_playback_priority(Ref<AudioStreamPlayback> p_playback, int p_priority) {
+	ERR_FAIL_COND(p_playback.is_null());
+
+	AudioStreamPlaybackListNode *playback_node = _find_playback_list_node(p_playback);
+	if (!playback_node) {
+		return;
+	}
+
+	playback_node->priority.set(p_priority);
+}
+
 void AudioServer::set_playback_paused(Ref<AudioStreamPlayback> p_playback, bool p_paused) {
 	ERR_FAIL_COND(p_playback.is_null());
 
@@ -1284,6 +1557,57 @@ void AudioServer::set_playback_highshelf_params(Ref<AudioStreamPlayback> p_playb
 	playback_node->highshelf_gain.set(p_gain);
 }
 
+void AudioServer::queue_playback_params_update(const PlaybackParamsUpdate &p_update) {
+	ERR_FAIL_COND(p_update.playback.is_null());
+	ERR_FAIL_INDEX(p_update.bus_count, MAX_BUSES_PER_PLAYBACK + 1);
+
+	MutexLock lock(queued_playback_updates_mutex);
+	queued_playback_updates.push_back(p_update);
+}
+
+void AudioServer::_apply_queued_playback_updates() {
+	MutexLock lock(queued_playback_updates_mutex);
+	if (queued_playback_updates.is_empty()) {
+		return;
+	}
+
+	// Only the latest update of every playback matters.
+	queued_playback_update_map.clear();
+	for (uint32_t i = 0; i < queued_playback_updates.size(); i++) {
+		queued_playback_update_map.set(queued_playback_updates[i].playback->get_instance_id(), i);
+	}
+
+	// One pass over the playbacks instead of one lookup per setter call.
+	for (AudioStreamPlaybackListNode *playback_node : playback_list) {
+		const uint32_t *idx = queued_playback_update_map.getptr(playback_node->stream_playback->get_instance_id());
+		if (!idx) {
+			continue;
+		}
+		const PlaybackParamsUpdate &update = queued_playback_updates[*idx];
+
+		AudioStreamPlaybackBusDetails *old_bus_details, *new_bus_details = new AudioStreamPlaybackBusDetails();
+		for (int i = 0; i < update.bus_count; i++) {
+			new_bus_details->bus_active[i] = true;
+			new_bus_details->bus[i] = update.bus[i];
+			for (int channel_idx = 0; channel_idx < MAX_CHANNELS_PER_BUS; channel_idx++) {
+				new_bus_details->volume[i][channel_idx] = update.volume[i][channel_idx];
+			}
+		}
+
+		do {
+			old_bus_details = playback_node->bus_details.load();
+		} while (!playback_node->bus_details.compare_exchange_strong(old_bus_details, new_bus_details));
+
+		bus_details_graveyard.insert(old_bus_details);
+
+		playback_node->pitch_scale.set(update.pitch_scale);
+		playback_node->attenuation_filter_cutoff_hz.set(update.attenuation_cutoff_hz);
+		playback_node->highshelf_gain.set(update.highshelf_gain);
+	}
+
+	queued_playback_updates.clear();
+}
+
 bool AudioServer::is_playback_active(Ref<AudioStreamPlayback> p_playback) {
 	ERR_FAIL_COND_V(p_playback.is_null(), false);
 
@@ -1317,10 +1641,25 @@ bool AudioServer::is_playback_paused(Ref<AudioStreamPlayback> p_playback) {
 	return playback_node->state.load() == AudioStreamPlaybackListNode::PAUSED || playback_node->state.load() == AudioStreamPlaybackListNode::FADE_OUT_TO_PAUSE;
 }
 
+bool AudioServer::is_playback_virtual(Ref<AudioStreamPlayback> p_playback) {
+	ERR_FAIL_COND_V(p_playback.is_null(), false);
+
+	AudioStreamPlaybackListNode *playback_node = _find_playback_list_node(p_playback);
+	if (!playback_node) {
+		return false;
+	}
+
+	return playback_node->is_virtual;
+}
+
 uint64_t AudioServer::get_mix_count() const {
 	return mix_count;
 }
 
+uint64_t AudioServer::get_mix_deadline_miss_count() const {
+	return mix_deadline_miss_count.get();
+}
+
 void AudioServer::notify_listener_changed() {
 	for (CallbackItem *ci : listener_changed_callback_list) {
 		ci->callback(ci->userdata);
@@ -1329,17 +1668,13 @@ void AudioServer::notify_listener_changed() {
 
 void AudioServer::init_channels_and_buffers() {
 	channel_count = get_channel_count();
-	temp_buffer.resize(channel_count);
 	mix_buffer.resize(buffer_size + LOOKAHEAD_BUFFER_SIZE);
 
-	for (int i = 0; i < temp_buffer.size(); i++) {
-		temp_buffer.write[i].resize(buffer_size);
-	}
-
 	for (int i = 0; i < buses.size(); i++) {
 		buses[i]->channels.resize(channel_count);
 		for (int j = 0; j < channel_count; j++) {
 			buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+			buses.write[i]->channels.write[j].effect_buffer.resize(buffer_size);
 		}
 	}
 }
@@ -1347,6 +1682,11 @@ void AudioServer::init_channels_and_buffers() {
 void AudioServer::init() {
 	channel_disable_threshold_db = GLOBAL_DEF_RST("audio/buses/channel_disable_threshold_db", -60.0);
 	channel_disable_frames = float(GLOBAL_DEF_RST("audio/buses/channel_disable_time", 2.0)) * get_mix_rate();
+	threaded_effects = GLOBAL_DEF("audio/buses/threaded_effects", true);
+	max_voices = GLOBAL_DEF("audio/voices/max_voices", 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("audio/voices/max_voices", PropertyInfo(Variant::INT, "audio/voices/max_voices", PROPERTY_HINT_RANGE, "0,4096,1,or_greater"));
+	voice_virtualize_threshold = Math::db2linear(float(GLOBAL_DEF("audio/voices/virtualize_threshold_db", -80.0)));
+	ProjectSettings::get_singleton()->set_custom_property_info("audio/voices/virtualize_threshold_db", PropertyInfo(Variant::FLOAT, "audio/voices/virtualize_threshold_db", PROPERTY_HINT_RANGE, "-200,0,0.1"));
 	ProjectSettings::get_singleton()->set_custom_property_info("audio/buses/channel_disable_time", PropertyInfo(Variant::FLOAT, "audio/buses/channel_disable_time", PROPERTY_HINT_RANGE, "0,5,0.01,or_greater"));
 	buffer_size = 512; //hardcoded for now
 
@@ -1368,6 +1708,8 @@ void AudioServer::init() {
 }
 
 void AudioServer::update() {
+	_apply_queued_playback_updates();
+
 #ifdef DEBUG_ENABLED
 	if (EngineDebugger::is_profiling("servers")) {
 		// Driver time includes server time + effects times
@@ -1474,12 +1816,16 @@ void AudioServer::finish() {
 	}
 
 	buses.clear();
+	bus_command_read.store(bus_command_write.load());
 }
 
 /* MISC config */
 
 void AudioServer::lock() {
 	AudioDriver::get_singleton()->lock();
+	// Nothing is mixing now, so bus commands can't be consumed anywhere else and must not
+	// point to buses or effects that are about to be removed.
+	_flush_bus_commands();
 }
 
 void AudioServer::unlock() {
@@ -1604,8 +1950,10 @@ void AudioServer::set_bus_layout(const Ref<AudioBusLayout> &p_bus_layout) {
 		buses[i]->channels.resize(channel_count);
 		for (int j = 0; j < channel_count; j++) {
 			buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+			buses.write[i]->channels.write[j].effect_buffer.resize(buffer_size);
 		}
 		_update_bus_effects(i);
+		_sync_bus_mix_state(bus);
 	}
 #ifdef TOOLS_ENABLED
 	set_edited(false);
@@ -34,6 +34,9 @@
 #include "core/math/audio_frame.h"
 #include "core/object/class_db.h"
 #include "core/os/os.h"
+#include "core/os/spin_lock.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/safe_list.h"
 #include "core/variant/variant.h"
 #include "servers/audio/audio_effect.h"
@@ -75,6 +78,9 @@ protected:
 #endif
 
 public:
+	// Settings for the threads mixing audio: high priority, on the cores set in the project settings.
+	static Thread::Settings get_thread_settings();
+
 	double get_time_since_last_mix(); //useful for video -> audio sync
 	double get_time_to_next_mix();
 
@@ -168,6 +174,17 @@ public:
 
 	typedef void (*AudioCallback)(void *p_userdata);
 
+	// Everything a spatialized source changes every frame, see queue_playback_params_update().
+	struct PlaybackParamsUpdate {
+		Ref<AudioStreamPlayback> playback;
+		int bus_count = 0;
+		StringName bus[MAX_BUSES_PER_PLAYBACK];
+		AudioFrame volume[MAX_BUSES_PER_PLAYBACK][MAX_CHANNELS_PER_BUS];
+		float pitch_scale = 1.0;
+		float highshelf_gain = 0.0;
+		float attenuation_cutoff_hz = 0.0;
+	};
+
 private:
 	uint64_t mix_time;
 	int mix_size;
@@ -175,12 +192,14 @@ private:
 	uint32_t buffer_size;
 	uint64_t mix_count;
 	uint64_t mix_frames;
+	SafeNumeric<uint64_t> mix_deadline_miss_count;
 #ifdef DEBUG_ENABLED
 	uint64_t prof_time;
 #endif
 
 	float channel_disable_threshold_db;
 	uint32_t channel_disable_frames;
+	bool threaded_effects = true;
 
 	int channel_count;
 	int to_mix;
@@ -201,6 +220,7 @@ private:
 			bool active;
 			AudioFrame peak_volume;
 			Vector<AudioFrame> buffer;
+			Vector<AudioFrame> effect_buffer; // Swapped with buffer after each effect, so buses can run their effects in parallel.
 			Vector<Ref<AudioEffectInstance>> effect_instances;
 			uint64_t last_mix_with_audio;
 			Channel() {
@@ -216,6 +236,7 @@ private:
 		struct Effect {
 			Ref<AudioEffect> effect;
 			bool enabled;
+			bool mix_enabled = true; // Audio thread copy of enabled.
 #ifdef DEBUG_ENABLED
 			uint64_t prof_time;
 #endif
@@ -225,8 +246,49 @@ private:
 		float volume_db;
 		StringName send;
 		int index_cache;
+
+		// Audio thread copies of the parameters above. The setters update them through the bus
+		// command queue, so changing them doesn't need the lock.
+		struct MixState {
+			float volume_db = 0.0;
+			bool solo = false;
+			bool mute = false;
+			bool bypass = false;
+		} mix_state;
 	};
 
+	// Lock-free single consumer queue of bus parameter changes, consumed by the audio thread at the
+	// start of every mix, or by whoever takes the lock. Producers only wait for each other.
+	struct BusCommand {
+		enum Type {
+			SET_VOLUME_DB,
+			SET_SOLO,
+			SET_MUTE,
+			SET_BYPASS,
+			SET_EFFECT_ENABLED,
+		};
+
+		Type type = SET_VOLUME_DB;
+		Bus *bus = nullptr;
+		int effect = 0;
+		float value = 0.0;
+		bool enabled = false;
+	};
+
+	enum {
+		BUS_COMMAND_QUEUE_SIZE = 1024, // Power of two.
+	};
+
+	BusCommand bus_commands[BUS_COMMAND_QUEUE_SIZE];
+	std::atomic<uint32_t> bus_command_write = { 0 };
+	std::atomic<uint32_t> bus_command_read = { 0 };
+	SpinLock bus_command_producer_lock;
+
+	void _push_bus_command(const BusCommand &p_command);
+	void _apply_bus_command(const BusCommand &p_command);
+	void _flush_bus_commands();
+	void _sync_bus_mix_state(Bus *p_bus);
+
 	struct AudioStreamPlaybackBusDetails {
 		bool bus_active[MAX_BUSES_PER_PLAYBACK] = { false, false, false, false, false, false };
 		StringName bus[MAX_BUSES_PER_PLAYBACK];
@@ -247,6 +309,12 @@ private:
 		SafeNumeric<float> highshelf_gain;
 		SafeNumeric<float> attenuation_filter_cutoff_hz; // This isn't used unless highshelf_gain is nonzero.
 		AudioFilterSW::Processor filter_process[8];
+		// Higher priority voices are the last ones to be virtualized when over the voice limit.
+		SafeNumeric<int> priority;
+		// Virtual voices are inaudible or over the voice limit. They aren't mixed to any bus, and
+		// aren't even decoded if the playback can skip. Only accessed on the audio thread.
+		bool is_virtual = false;
+		bool fading_to_virtual = false;
 		// Updating this ref after the list node is created breaks consistency guarantees, don't do it!
 		Ref<AudioStreamPlayback> stream_playback;
 		// Playback state determines the fate of a particular AudioStreamListNode during the mix step. Must be atomically replaced.
@@ -260,12 +328,31 @@ private:
 	};
 
 	SafeList<AudioStreamPlaybackListNode *> playback_list;
+
+	BinaryMutex queued_playback_updates_mutex;
+	LocalVector<PlaybackParamsUpdate> queued_playback_updates;
+	HashMap<ObjectID, uint32_t> queued_playback_update_map;
+
+	void _apply_queued_playback_updates();
+
+	struct VoiceCandidate {
+		AudioStreamPlaybackListNode *playback = nullptr;
+		int priority = 0;
+		float loudness = 0.0;
+
+		bool operator<(const VoiceCandidate &p_other) const {
+			return priority == p_other.priority ? loudness > p_other.loudness : priority > p_other.priority;
+		}
+	};
+
+	int max_voices = 0;
+	float voice_virtualize_threshold = 0.0;
+	LocalVector<VoiceCandidate> voice_candidates;
 	SafeList<AudioStreamPlaybackBusDetails *> bus_details_graveyard;
 
 	// TODO document if this is necessary.
 	SafeList<AudioStreamPlaybackBusDetails *> bus_details_graveyard_frame_old;
 
-	Vector<Vector<AudioFrame>> temp_buffer; //temp_buffer for each level
 	Vector<AudioFrame> mix_buffer;
 	Vector<Bus *> buses;
 	Map<StringName, Bus *> bus_map;
@@ -276,7 +363,17 @@ private:
 
 	void init_channels_and_buffers();
 
+	// Buses only send to buses with a lower index, so they are processed in levels:
+	// every bus of a level only receives audio from buses of earlier levels.
+	LocalVector<int> bus_send_cache;
+	LocalVector<int> bus_level_cache;
+	LocalVector<Bus *> bus_level_work;
+
 	void _mix_step();
+	void _update_virtual_voices();
+	void _mix_step_virtual(AudioStreamPlaybackListNode *p_playback);
+	void _mix_step_bus(Bus *p_bus, bool p_solo_mode);
+	void _mix_step_bus_group(uint32_t p_index, bool p_solo_mode);
 	void _mix_step_for_channel(AudioFrame *p_out_buf, AudioFrame *p_source_buf, AudioFrame p_vol_start, AudioFrame p_vol_final, float p_attenuation_filter_cutoff_hz, float p_highshelf_gain, AudioFilterSW::Processor *p_processor_l, AudioFilterSW::Processor *p_processor_r);
 
 	// Should only be called on the main thread.
@@ -379,12 +476,19 @@ public:
 	void set_playback_pitch_scale(Ref<AudioStreamPlayback> p_playback, float p_pitch_scale);
 	void set_playback_paused(Ref<AudioStreamPlayback> p_playback, bool p_paused);
 	void set_playback_highshelf_params(Ref<AudioStreamPlayback> p_playback, float p_gain, float p_attenuation_cutoff_hz);
+	void set_playback_priority(Ref<AudioStreamPlayback> p_playback, int p_priority);
+	// Batched version of the setters above, for sources updated every frame like 3D players.
+	// The updates are applied together in update(), later ones replacing earlier ones.
+	void queue_playback_params_update(const PlaybackParamsUpdate &p_update);
 
 	bool is_playback_active(Ref<AudioStreamPlayback> p_playback);
 	float get_playback_position(Ref<AudioStreamPlayback> p_playback);
 	bool is_playback_paused(Ref<AudioStreamPlayback> p_playback);
+	bool is_playback_virtual(Ref<AudioStreamPlayback> p_playback);
 
 	uint64_t get_mix_count() const;
+	// Driver callbacks that took longer to mix than the audio they produced lasts.
+	uint64_t get_mix_deadline_miss_count() const;
 
 	void notify_listener_changed();
 
@@ -37,6 +37,7 @@
 
 #include "core/object/class_db.h"
 #include "core/templates/rid.h"
+#include "core/templates/safe_refcount.h"
 #include "scene/3d/navigation_region_3d.h"
 
 /// This server uses the concept of internal mutability.
@@ -53,10 +54,15 @@ class NavigationServer3D : public Object {
 protected:
 	static void _bind_methods();
 
+	/// Time spent solving path queries, synchronous and asynchronous. Never reset.
+	mutable SafeNumeric<uint64_t> path_query_time_usec;
+
 public:
 	/// Thread safe, can be used across many threads.
 	static NavigationServer3D *get_singleton();
 
+	uint64_t get_path_query_time_usec() const { return path_query_time_usec.get(); }
+
 	/// MUST be used in single thread!
 	static NavigationServer3D *get_singleton_mut();
 
@@ -90,6 +96,10 @@ public:
 	/// Returns the navigation path to reach the destination from the origin.
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigable_layers = 1) const = 0;
 
+	/// Queues a path query solved on the worker threads, the callback
+	/// receives the path once it's ready.
+	virtual void map_get_path_async(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, const Callable &p_callback, uint32_t p_navigable_layers = 1) const = 0;
+
 	virtual Vector3 map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision = false) const = 0;
 	virtual Vector3 map_get_closest_point(RID p_map, const Vector3 &p_point) const = 0;
 	virtual Vector3 map_get_closest_point_normal(RID p_map, const Vector3 &p_point) const = 0;
@@ -178,6 +188,22 @@ public:
 	/// Callback called at the end of the RVO process
 	virtual void agent_set_callback(RID p_agent, Object *p_receiver, StringName p_method, Variant p_udata = Variant()) const = 0;
 
+	/// Creates the flow field.
+	virtual RID flow_field_create() const = 0;
+
+	/// Put the flow field in the map.
+	virtual void flow_field_set_map(RID p_flow_field, RID p_map) const = 0;
+	virtual RID flow_field_get_map(RID p_flow_field) const = 0;
+
+	/// The location all the directions of the field lead to.
+	virtual void flow_field_set_target(RID p_flow_field, Vector3 p_target) const = 0;
+
+	/// The navigation layers the field goes through.
+	virtual void flow_field_set_layers(RID p_flow_field, uint32_t p_layers) const = 0;
+
+	/// The direction to move in from this point to reach the target.
+	virtual Vector3 flow_field_get_direction(RID p_flow_field, const Vector3 &p_point) const = 0;
+
 	/// Destroy the `RID`
 	virtual void free(RID p_object) const = 0;
 
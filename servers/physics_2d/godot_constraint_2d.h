@@ -33,6 +33,8 @@
 
 #include "godot_body_2d.h"
 
+#include "core/templates/safe_refcount.h"
+
 class GodotConstraint2D {
 	GodotBody2D **_body_ptr;
 	int _body_count;
@@ -41,16 +43,27 @@ class GodotConstraint2D {
 
 	RID self;
 
+	// Increasing with every constraint created, used to order constraints the same way on every run.
+	uint64_t creation_id = 0;
+
+	_FORCE_INLINE_ static uint64_t _next_creation_id() {
+		static SafeNumeric<uint64_t> last_creation_id;
+		return last_creation_id.increment();
+	}
+
 protected:
 	GodotConstraint2D(GodotBody2D **p_body_ptr = nullptr, int p_body_count = 0) {
 		_body_ptr = p_body_ptr;
 		_body_count = p_body_count;
+		creation_id = _next_creation_id();
 	}
 
 public:
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
 
+	_FORCE_INLINE_ uint64_t get_creation_id() const { return creation_id; }
+
 	_FORCE_INLINE_ uint64_t get_island_step() const { return island_step; }
 	_FORCE_INLINE_ void set_island_step(uint64_t p_step) { island_step = p_step; }
 
@@ -36,6 +36,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/trace_zones.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -1238,6 +1239,9 @@ void GodotPhysicsServer2D::init() {
 };
 
 void GodotPhysicsServer2D::step(real_t p_step) {
+	Memory::TagScope memory_tag(Memory::TAG_PHYSICS);
+	TRACE_ZONE("PhysicsServer2D::step");
+
 	if (!active) {
 		return;
 	}
@@ -1260,6 +1264,8 @@ void GodotPhysicsServer2D::sync() {
 };
 
 void GodotPhysicsServer2D::flush_queries() {
+	Memory::TagScope memory_tag(Memory::TAG_PHYSICS);
+
 	if (!active) {
 		return;
 	}
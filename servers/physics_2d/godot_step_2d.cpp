@@ -30,6 +30,8 @@
 
 #include "godot_step_2d.h"
 
+#include "core/config/project_settings.h"
+#include "core/debugger/trace_zones.h"
 #include "core/os/os.h"
 
 #define BODY_ISLAND_COUNT_RESERVE 128
@@ -155,6 +157,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta, int p_iterations)
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		TRACE_ZONE_ADD("Physics 2D integrate forces", profile_begtime, profile_endtime);
 		profile_begtime = profile_endtime;
 	}
 
@@ -165,8 +168,17 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta, int p_iterations)
 	const SelfList<GodotArea2D>::List &aml = p_space->get_moved_area_list();
 
 	while (aml.first()) {
+		// Area constraints are kept sorted by address, use their creation order instead when it must not depend on memory layout.
+		area_constraints.clear();
 		for (const Set<GodotConstraint2D *>::Element *E = aml.first()->self()->get_constraints().front(); E; E = E->next()) {
-			GodotConstraint2D *constraint = E->get();
+			area_constraints.push_back(E->get());
+		}
+		if (deterministic) {
+			area_constraints.sort_custom<ConstraintCreationComparator>();
+		}
+
+		for (uint32_t constraint_index = 0; constraint_index < area_constraints.size(); ++constraint_index) {
+			GodotConstraint2D *constraint = area_constraints[constraint_index];
 			if (constraint->get_island_step() == _step) {
 				continue;
 			}
@@ -230,17 +242,26 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta, int p_iterations)
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_GENERATE_ISLANDS, profile_endtime - profile_begtime);
+		TRACE_ZONE_ADD("Physics 2D generate islands", profile_begtime, profile_endtime);
 		profile_begtime = profile_endtime;
 	}
 
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_contraint_count = all_constraints.size();
-	work_pool.do_work(total_contraint_count, this, &GodotStep2D::_setup_contraint, nullptr);
+	if (deterministic) {
+		// Setup also reports contacts to the bodies, keep the order they're added in.
+		for (uint32_t constraint_index = 0; constraint_index < total_contraint_count; ++constraint_index) {
+			_setup_contraint(constraint_index);
+		}
+	} else {
+		work_pool.do_work_batched(total_contraint_count, this, &GodotStep2D::_setup_contraint, nullptr);
+	}
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_SETUP_CONSTRAINTS, profile_endtime - profile_begtime);
+		TRACE_ZONE_ADD("Physics 2D setup constraints", profile_begtime, profile_endtime);
 		profile_begtime = profile_endtime;
 	}
 
@@ -255,15 +276,18 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta, int p_iterations)
 
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	if (island_count > 1) {
+	if (island_count > 1 && !deterministic) {
 		work_pool.do_work(island_count, this, &GodotStep2D::_solve_island, nullptr);
-	} else if (island_count > 0) {
-		_solve_island(0);
+	} else {
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			_solve_island(island_index);
+		}
 	}
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
+		TRACE_ZONE_ADD("Physics 2D solve constraints", profile_begtime, profile_endtime);
 		profile_begtime = profile_endtime;
 	}
 
@@ -285,6 +309,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta, int p_iterations)
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_INTEGRATE_VELOCITIES, profile_endtime - profile_begtime);
+		TRACE_ZONE_ADD("Physics 2D integrate velocities", profile_begtime, profile_endtime);
 		//profile_begtime=profile_endtime;
 	}
 
@@ -296,6 +321,8 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta, int p_iterations)
 }
 
 GodotStep2D::GodotStep2D() {
+	deterministic = GLOBAL_DEF_RST("physics/2d/deterministic", false);
+
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
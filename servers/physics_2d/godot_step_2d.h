@@ -39,6 +39,9 @@
 class GodotStep2D {
 	uint64_t _step = 1;
 
+	// Same results for the same inputs, regardless of memory layout and thread timing.
+	bool deterministic = false;
+
 	int iterations = 0;
 	real_t delta = 0.0;
 
@@ -47,6 +50,11 @@ class GodotStep2D {
 	LocalVector<LocalVector<GodotBody2D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint2D *>> constraint_islands;
 	LocalVector<GodotConstraint2D *> all_constraints;
+	LocalVector<GodotConstraint2D *> area_constraints;
+
+	struct ConstraintCreationComparator {
+		_FORCE_INLINE_ bool operator()(const GodotConstraint2D *p_a, const GodotConstraint2D *p_b) const { return p_a->get_creation_id() < p_b->get_creation_id(); }
+	};
 
 	void _populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island);
 	void _setup_contraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
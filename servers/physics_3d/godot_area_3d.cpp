@@ -107,6 +107,26 @@ void GodotArea3D::set_monitor_callback(ObjectID p_id, const StringName &p_method
 	}
 }
 
+void GodotArea3D::set_monitor_events_callback(void *p_instance, PhysicsServer3D::AreaMonitorEventsCallback p_callback) {
+	monitor_events_instance = p_instance;
+	if (p_callback == monitor_events_callback) {
+		return;
+	}
+
+	_unregister_shapes();
+
+	monitor_events_callback = p_callback;
+
+	monitored_bodies.clear();
+	monitored_areas.clear();
+
+	_shape_changed();
+
+	if (!moved_list.in_list() && get_space()) {
+		get_space()->area_add_to_moved_list(&moved_list);
+	}
+}
+
 void GodotArea3D::set_area_monitor_callback(ObjectID p_id, const StringName &p_method) {
 	if (p_id == area_monitor_callback_id) {
 		area_monitor_callback_method = p_method;
@@ -229,7 +249,52 @@ void GodotArea3D::set_monitorable(bool p_monitorable) {
 	_set_static(!monitorable);
 }
 
+void GodotArea3D::_call_monitor_events() {
+	monitor_events.clear();
+
+	for (const KeyValue<BodyKey, BodyState> &E : monitored_bodies) {
+		if (E.value.state == 0) { // Nothing happened
+			continue;
+		}
+
+		PhysicsServer3D::AreaMonitorEvent event;
+		event.rid = E.key.rid;
+		event.instance_id = E.key.instance_id;
+		event.other_shape = E.key.body_shape;
+		event.self_shape = E.key.area_shape;
+		event.added = E.value.state > 0;
+		monitor_events.push_back(event);
+	}
+
+	for (const KeyValue<BodyKey, BodyState> &E : monitored_areas) {
+		if (E.value.state == 0) { // Nothing happened
+			continue;
+		}
+
+		PhysicsServer3D::AreaMonitorEvent event;
+		event.rid = E.key.rid;
+		event.instance_id = E.key.instance_id;
+		event.other_shape = E.key.body_shape;
+		event.self_shape = E.key.area_shape;
+		event.added = E.value.state > 0;
+		event.is_area = true;
+		monitor_events.push_back(event);
+	}
+
+	monitored_bodies.clear();
+	monitored_areas.clear();
+
+	if (!monitor_events.is_empty()) {
+		monitor_events_callback(monitor_events_instance, monitor_events.ptr(), monitor_events.size());
+	}
+}
+
 void GodotArea3D::call_queries() {
+	if (monitor_events_callback) {
+		_call_monitor_events();
+		return;
+	}
+
 	if (monitor_callback_id.is_valid() && !monitored_bodies.is_empty()) {
 		Variant res[5];
 		Variant *resptr[5];
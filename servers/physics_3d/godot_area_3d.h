@@ -33,6 +33,7 @@
 
 #include "godot_collision_object_3d.h"
 
+#include "core/templates/local_vector.h"
 #include "core/templates/self_list.h"
 #include "servers/physics_server_3d.h"
 
@@ -63,6 +64,10 @@ class GodotArea3D : public GodotCollisionObject3D {
 	ObjectID area_monitor_callback_id;
 	StringName area_monitor_callback_method;
 
+	void *monitor_events_instance = nullptr;
+	PhysicsServer3D::AreaMonitorEventsCallback monitor_events_callback = nullptr;
+	LocalVector<PhysicsServer3D::AreaMonitorEvent> monitor_events;
+
 	SelfList<GodotArea3D> monitor_query_list;
 	SelfList<GodotArea3D> moved_list;
 
@@ -104,13 +109,16 @@ class GodotArea3D : public GodotCollisionObject3D {
 
 	virtual void _shapes_changed();
 	void _queue_monitor_update();
+	void _call_monitor_events();
 
 public:
 	void set_monitor_callback(ObjectID p_id, const StringName &p_method);
-	_FORCE_INLINE_ bool has_monitor_callback() const { return monitor_callback_id.is_valid(); }
+	_FORCE_INLINE_ bool has_monitor_callback() const { return monitor_callback_id.is_valid() || monitor_events_callback; }
 
 	void set_area_monitor_callback(ObjectID p_id, const StringName &p_method);
-	_FORCE_INLINE_ bool has_area_monitor_callback() const { return area_monitor_callback_id.is_valid(); }
+	_FORCE_INLINE_ bool has_area_monitor_callback() const { return area_monitor_callback_id.is_valid() || monitor_events_callback; }
+
+	void set_monitor_events_callback(void *p_instance, PhysicsServer3D::AreaMonitorEventsCallback p_callback);
 
 	_FORCE_INLINE_ void add_body_to_query(GodotBody3D *p_body, uint32_t p_body_shape, uint32_t p_area_shape);
 	_FORCE_INLINE_ void remove_body_from_query(GodotBody3D *p_body, uint32_t p_body_shape, uint32_t p_area_shape);
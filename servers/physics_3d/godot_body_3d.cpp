@@ -170,6 +170,27 @@ void GodotBody3D::reset_mass_properties() {
 	_mass_properties_changed();
 }
 
+void GodotBody3D::add_constraint(GodotConstraint3D *p_constraint, int p_pos) {
+	constraint_map[p_constraint] = p_pos;
+	if (get_space()) {
+		get_space()->invalidate_islands();
+	}
+}
+
+void GodotBody3D::remove_constraint(GodotConstraint3D *p_constraint) {
+	constraint_map.erase(p_constraint);
+	if (get_space()) {
+		get_space()->invalidate_islands();
+	}
+}
+
+void GodotBody3D::clear_constraint_map() {
+	constraint_map.clear();
+	if (get_space()) {
+		get_space()->invalidate_islands();
+	}
+}
+
 void GodotBody3D::set_active(bool p_active) {
 	if (active == p_active) {
 		return;
@@ -282,6 +303,10 @@ void GodotBody3D::set_mode(PhysicsServer3D::BodyMode p_mode) {
 	PhysicsServer3D::BodyMode prev = mode;
 	mode = p_mode;
 
+	if (get_space() && prev != mode) {
+		get_space()->invalidate_islands(); // Static and kinematic bodies don't connect islands the same way.
+	}
+
 	switch (p_mode) {
 		case PhysicsServer3D::BODY_MODE_STATIC:
 		case PhysicsServer3D::BODY_MODE_KINEMATIC: {
@@ -418,6 +443,42 @@ Variant GodotBody3D::get_state(PhysicsServer3D::BodyState p_state) const {
 	return Variant();
 }
 
+void GodotBody3D::get_snapshot_state(SnapshotState &r_state) const {
+	r_state.transform = get_transform();
+	r_state.linear_velocity = linear_velocity;
+	r_state.angular_velocity = angular_velocity;
+	r_state.applied_force = applied_force;
+	r_state.applied_torque = applied_torque;
+	r_state.still_time = still_time;
+	r_state.active = active;
+}
+
+void GodotBody3D::set_snapshot_state(const SnapshotState &p_state) {
+	ERR_FAIL_COND(mode == PhysicsServer3D::BODY_MODE_STATIC);
+
+	// Also reset the kinematic target, otherwise the body would move back on the next step.
+	new_transform = p_state.transform;
+	_set_transform(p_state.transform);
+	_set_inv_transform(p_state.transform.affine_inverse());
+	_update_transform_dependent();
+
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	biased_linear_velocity = Vector3();
+	biased_angular_velocity = Vector3();
+	applied_force = p_state.applied_force;
+	applied_torque = p_state.applied_torque;
+	still_time = p_state.still_time;
+	first_time_kinematic = false;
+
+	set_active(p_state.active);
+
+	if (get_space() && (fi_callback_data || body_state_callback) && !direct_state_query_list.in_list()) {
+		// Sync the new state back to the node on the next query flush.
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+}
+
 void GodotBody3D::set_space(GodotSpace3D *p_space) {
 	if (get_space()) {
 		if (mass_properties_update_list.in_list()) {
@@ -30,6 +30,7 @@
 
 #include "godot_body_pair_3d.h"
 
+#include "gjk_epa.h"
 #include "godot_collision_solver_3d.h"
 #include "godot_space_3d.h"
 
@@ -162,6 +163,114 @@ void GodotBodyPair3D::validate_contacts() {
 	}
 }
 
+// Continuous collision detection uses conservative advancement: shapes are moved forward by a time that can't make them
+// overlap, computed from their distance and an upper bound of their approaching speed, until they touch or the step ends.
+#define CCD_MAX_ITERATIONS 32
+
+struct _CCDMotion {
+	Transform3D xform; // Shape transform at the start of the step.
+	Vector3 center; // Rotation center (center of mass).
+	Vector3 linear_velocity;
+	Vector3 angular_velocity;
+	real_t radius = 0.0; // Furthest point of the shape from the rotation center.
+
+	_FORCE_INLINE_ Transform3D get_xform(real_t p_time) const {
+		Transform3D t = xform;
+		real_t angular_speed = angular_velocity.length();
+		if (angular_speed > CMP_EPSILON) {
+			Basis rot(angular_velocity / angular_speed, angular_speed * p_time);
+			t.basis = rot * t.basis;
+			t.origin = center + rot.xform(t.origin - center);
+		}
+		t.origin += linear_velocity * p_time;
+		return t;
+	}
+
+	void setup(const GodotBody3D *p_body, const GodotShape3D *p_shape, const Transform3D &p_xform, const Vector3 &p_offset) {
+		xform = p_xform;
+		center = p_body->get_transform().origin - p_offset + p_body->get_center_of_mass();
+		if (p_body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC) {
+			linear_velocity = Vector3();
+			angular_velocity = Vector3();
+		} else {
+			linear_velocity = p_body->get_linear_velocity();
+			angular_velocity = p_body->get_angular_velocity();
+		}
+
+		AABB aabb = p_xform.xform(p_shape->get_aabb());
+		real_t radius_squared = 0.0;
+		for (int i = 0; i < 8; i++) {
+			radius_squared = MAX(radius_squared, aabb.get_endpoint(i).distance_squared_to(center));
+		}
+		radius = Math::sqrt(radius_squared);
+	}
+};
+
+// Returns in r_toi the time at which the convex shapes come within p_tolerance of each other, if they do before p_step.
+static bool _ccd_time_of_impact(const GodotShape3D *p_shape_A, const _CCDMotion &p_motion_A, const GodotShape3D *p_shape_B, const _CCDMotion &p_motion_B, real_t p_step, real_t p_tolerance, real_t &r_toi) {
+	const Vector3 linear_velocity = p_motion_A.linear_velocity - p_motion_B.linear_velocity;
+	const real_t angular_bound = p_motion_A.angular_velocity.length() * p_motion_A.radius + p_motion_B.angular_velocity.length() * p_motion_B.radius;
+
+	real_t t = 0.0;
+	for (int i = 0; i < CCD_MAX_ITERATIONS; i++) {
+		Vector3 point_A, point_B;
+		if (!gjk_epa_calculate_distance(p_shape_A, p_motion_A.get_xform(t), p_shape_B, p_motion_B.get_xform(t), point_A, point_B)) {
+			// Overlapping already, regular contacts take care of it at the start of the step.
+			if (t == 0.0) {
+				return false;
+			}
+			break;
+		}
+
+		Vector3 dir = point_B - point_A;
+		real_t distance = dir.length();
+		if (distance < CMP_EPSILON) {
+			break;
+		}
+
+		real_t approach_speed = linear_velocity.dot(dir / distance) + angular_bound;
+		if (approach_speed <= CMP_EPSILON) {
+			return false; // Separating.
+		}
+
+		if (distance <= p_tolerance) {
+			break;
+		}
+
+		t += (distance - p_tolerance * 0.5) / approach_speed;
+		if (t >= p_step) {
+			return false;
+		}
+	}
+
+	// Running out of iterations is fine, t never goes past the actual impact.
+	r_toi = t;
+	return true;
+}
+
+struct _CCDConcaveInfo {
+	const GodotShape3D *shape_A = nullptr;
+	const _CCDMotion *motion_A = nullptr;
+	const _CCDMotion *motion_B = nullptr;
+	real_t step = 0.0;
+	real_t tolerance = 0.0;
+	real_t toi = 0.0;
+	bool hit = false;
+};
+
+static bool _ccd_concave_callback(void *p_userdata, GodotShape3D *p_convex) {
+	_CCDConcaveInfo &info = *(_CCDConcaveInfo *)p_userdata;
+
+	// The time limit shrinks with every hit, so only earlier impacts are searched for.
+	real_t toi;
+	if (_ccd_time_of_impact(info.shape_A, *info.motion_A, p_convex, *info.motion_B, info.hit ? info.toi : info.step, info.tolerance, toi)) {
+		info.toi = toi;
+		info.hit = true;
+	}
+
+	return false;
+}
+
 bool GodotBodyPair3D::_test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B) {
 	Vector3 motion = p_A->get_linear_velocity() * p_step;
 	real_t mlen = motion.length();
@@ -175,13 +284,65 @@ bool GodotBodyPair3D::_test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A,
 	p_A->get_shape(p_shape_A)->project_range(mnormal, p_xform_A, min, max);
 	bool fast_object = mlen > (max - min) * 0.3; //going too fast in that direction
 
-	if (!fast_object) { //did it move enough in this direction to even attempt raycast? let's say it should move more than 1/3 the size of the object in that axis
+	if (!fast_object) { //did it move enough in this direction to even attempt a sweep? let's say it should move more than 1/3 the size of the object in that axis
 		return false;
 	}
 
+	const GodotShape3D *shape_A_ptr = p_A->get_shape(p_shape_A);
+	const GodotShape3D *shape_B_ptr = p_B->get_shape(p_shape_B);
+
+	bool sweep_supported = !shape_A_ptr->is_concave() && shape_A_ptr->get_type() != PhysicsServer3D::SHAPE_SEPARATION_RAY && shape_A_ptr->get_type() != PhysicsServer3D::SHAPE_SOFT_BODY;
+	sweep_supported = sweep_supported && shape_B_ptr->get_type() != PhysicsServer3D::SHAPE_WORLD_BOUNDARY && shape_B_ptr->get_type() != PhysicsServer3D::SHAPE_SEPARATION_RAY && shape_B_ptr->get_type() != PhysicsServer3D::SHAPE_SOFT_BODY;
+
+	if (sweep_supported) {
+		// Transforms are relative to the origin of A (the pair's, not necessarily p_A).
+		const Vector3 &offset = A->get_transform().get_origin();
+
+		_CCDMotion motion_A;
+		motion_A.setup(p_A, shape_A_ptr, p_xform_A, offset);
+		_CCDMotion motion_B;
+		motion_B.setup(p_B, shape_B_ptr, p_xform_B, offset);
+
+		// Stop a little before touching, the contact is resolved on the next step.
+		real_t tolerance = MAX((max - min) * 0.01, (real_t)CMP_EPSILON);
+
+		real_t toi = 0.0;
+		bool hit = false;
+
+		if (shape_B_ptr->is_concave()) {
+			// Sweep against every face the motion might reach.
+			AABB sweep_aabb = p_xform_A.xform(shape_A_ptr->get_aabb());
+			sweep_aabb = sweep_aabb.merge(AABB(sweep_aabb.position + (motion_A.linear_velocity - motion_B.linear_velocity) * p_step, sweep_aabb.size));
+			sweep_aabb.grow_by((motion_A.angular_velocity.length() * motion_A.radius + motion_B.angular_velocity.length() * motion_B.radius) * p_step);
+
+			_CCDConcaveInfo info;
+			info.shape_A = shape_A_ptr;
+			info.motion_A = &motion_A;
+			info.motion_B = &motion_B;
+			info.step = p_step;
+			info.tolerance = tolerance;
+
+			static_cast<const GodotConcaveShape3D *>(shape_B_ptr)->cull(p_xform_B.affine_inverse().xform(sweep_aabb), _ccd_concave_callback, &info);
+			hit = info.hit;
+			toi = info.toi;
+		} else {
+			hit = _ccd_time_of_impact(shape_A_ptr, motion_A, shape_B_ptr, motion_B, p_step, tolerance, toi);
+		}
+
+		if (!hit) {
+			return false;
+		}
+
+		//shorten the linear velocity so it does not hit, but gets close enough, next frame will hit softly or soft enough
+		p_A->set_linear_velocity(p_A->get_linear_velocity() * (toi / p_step));
+
+		return true;
+	}
+
+	// Fall back to a raycast for shapes that can't be swept.
 	//cast a segment from support in motion normal, in the same direction of motion by motion length
 	//support is the worst case collision point, so real collision happened before
-	Vector3 s = p_A->get_shape(p_shape_A)->get_support(p_xform_A.basis.xform(mnormal).normalized());
+	Vector3 s = shape_A_ptr->get_support(p_xform_A.basis.xform(mnormal).normalized());
 	Vector3 from = p_xform_A.xform(s);
 	Vector3 to = from + motion;
 
@@ -191,7 +352,7 @@ bool GodotBodyPair3D::_test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A,
 	Vector3 local_to = from_inv.xform(to);
 
 	Vector3 rpos, rnorm;
-	if (!p_B->get_shape(p_shape_B)->intersect_segment(local_from, local_to, rpos, rnorm)) {
+	if (!shape_B_ptr->intersect_segment(local_from, local_to, rpos, rnorm)) {
 		return false;
 	}
 
@@ -249,7 +410,7 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
 
 	if (!collided) {
-		//test ccd (currently just a raycast)
+		//test ccd
 
 		if (A->is_continuous_collision_detection_enabled() && collide_A) {
 			_test_ccd(p_step, A, shape_A, xform_A, B, shape_B, xform_B);
@@ -524,8 +685,61 @@ void GodotBodyPair3D::solve(real_t p_step) {
 	}
 }
 
+void GodotBodyPair3D::get_snapshot_state(SnapshotState &r_state) const {
+	r_state.sep_axis = sep_axis;
+	r_state.collided = collided;
+	r_state.contact_count = contact_count;
+	for (int i = 0; i < contact_count; i++) {
+		const Contact &c = contacts[i];
+		SnapshotContact &sc = r_state.contacts[i];
+		sc.position = c.position;
+		sc.normal = c.normal;
+		sc.local_A = c.local_A;
+		sc.local_B = c.local_B;
+		sc.index_A = c.index_A;
+		sc.index_B = c.index_B;
+		sc.acc_normal_impulse = c.acc_normal_impulse;
+		sc.acc_tangent_impulse = c.acc_tangent_impulse;
+		sc.acc_bias_impulse = c.acc_bias_impulse;
+		sc.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
+		sc.depth = c.depth;
+		sc.active = c.active;
+	}
+}
+
+void GodotBodyPair3D::set_snapshot_state(const SnapshotState &p_state) {
+	ERR_FAIL_INDEX(p_state.contact_count, MAX_CONTACTS + 1);
+
+	sep_axis = p_state.sep_axis;
+	collided = p_state.collided;
+	contact_count = p_state.contact_count;
+	for (int i = 0; i < contact_count; i++) {
+		const SnapshotContact &sc = p_state.contacts[i];
+		Contact &c = contacts[i];
+		c.position = sc.position;
+		c.normal = sc.normal;
+		c.local_A = sc.local_A;
+		c.local_B = sc.local_B;
+		c.index_A = sc.index_A;
+		c.index_B = sc.index_B;
+		c.acc_normal_impulse = sc.acc_normal_impulse;
+		c.acc_tangent_impulse = sc.acc_tangent_impulse;
+		c.acc_bias_impulse = sc.acc_bias_impulse;
+		c.acc_bias_impulse_center_of_mass = sc.acc_bias_impulse_center_of_mass;
+		c.depth = sc.depth;
+		c.active = sc.active;
+	}
+}
+
+void GodotBodyPair3D::clear_contacts() {
+	sep_axis = Vector3();
+	collided = false;
+	contact_count = 0;
+}
+
 GodotBodyPair3D::GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B) :
-		GodotBodyContact3D(_arr, 2) {
+		GodotBodyContact3D(_arr, 2),
+		snapshot_list(this) {
 	A = p_A;
 	B = p_B;
 	shape_A = p_shape_A;
@@ -533,9 +747,11 @@ GodotBodyPair3D::GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p
 	space = A->get_space();
 	A->add_constraint(this, 0);
 	B->add_constraint(this, 1);
+	space->body_pair_add_to_snapshot_list(&snapshot_list);
 }
 
 GodotBodyPair3D::~GodotBodyPair3D() {
+	space->body_pair_remove_from_snapshot_list(&snapshot_list);
 	A->remove_constraint(this);
 	B->remove_constraint(this);
 }
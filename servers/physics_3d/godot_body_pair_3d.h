@@ -36,6 +36,7 @@
 #include "godot_soft_body_3d.h"
 
 #include "core/templates/local_vector.h"
+#include "core/templates/self_list.h"
 
 class GodotBodyContact3D : public GodotConstraint3D {
 protected:
@@ -94,6 +95,8 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
+	SelfList<GodotBodyPair3D> snapshot_list;
+
 	static void _contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B);
@@ -102,6 +105,39 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
 
 public:
+	// Contact cache stored in space snapshots, see GodotSpace3D::save_state().
+	// Only what carries over between steps is kept, the rest is recomputed in setup() and pre_solve().
+	struct SnapshotContact {
+		Vector3 position;
+		Vector3 normal;
+		Vector3 local_A;
+		Vector3 local_B;
+		int index_A = 0;
+		int index_B = 0;
+		real_t acc_normal_impulse = 0.0;
+		Vector3 acc_tangent_impulse;
+		real_t acc_bias_impulse = 0.0;
+		real_t acc_bias_impulse_center_of_mass = 0.0;
+		real_t depth = 0.0;
+		bool active = false;
+	};
+
+	struct SnapshotState {
+		Vector3 sep_axis;
+		bool collided = false;
+		int contact_count = 0;
+		SnapshotContact contacts[MAX_CONTACTS];
+	};
+
+	_FORCE_INLINE_ GodotBody3D *get_body_A() const { return A; }
+	_FORCE_INLINE_ GodotBody3D *get_body_B() const { return B; }
+	_FORCE_INLINE_ int get_shape_A() const { return shape_A; }
+	_FORCE_INLINE_ int get_shape_B() const { return shape_B; }
+
+	void get_snapshot_state(SnapshotState &r_state) const;
+	void set_snapshot_state(const SnapshotState &p_state);
+	void clear_contacts();
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -605,6 +605,82 @@ static void _generate_contacts_from_supports(const Vector3 *p_points_A, int p_po
 	contacts_func(points_A, pointcount_A, points_B, pointcount_B, p_callback);
 }
 
+// Projection of shapes onto batches of separating axes.
+//
+// Spheres, boxes and capsules are the most common pairs and their projections only depend on the axis expressed in
+// the local space of the shape, so they are computed here without going through the virtual project_range(). The axes
+// are processed as separate x/y/z arrays, which lets the compiler vectorize the loops for the target instruction set
+// (with either float or double real_t).
+
+#define SAT_MAX_BATCH_AXES 16
+
+struct _SATAxisBatch {
+	real_t x[SAT_MAX_BATCH_AXES];
+	real_t y[SAT_MAX_BATCH_AXES];
+	real_t z[SAT_MAX_BATCH_AXES];
+	int count = 0;
+};
+
+// Center distance along each axis, and the axes in the local space of the shape (unnormalized if the basis is scaled).
+static _FORCE_INLINE_ void _sat_localize_axes(const _SATAxisBatch &p_axes, const Transform3D &p_transform, real_t *r_distance, real_t *r_local_x, real_t *r_local_y, real_t *r_local_z) {
+	const Basis &b = p_transform.basis;
+	const Vector3 &o = p_transform.origin;
+	for (int i = 0; i < p_axes.count; i++) {
+		const real_t x = p_axes.x[i];
+		const real_t y = p_axes.y[i];
+		const real_t z = p_axes.z[i];
+		r_distance[i] = o.x * x + o.y * y + o.z * z;
+		r_local_x[i] = b.elements[0][0] * x + b.elements[1][0] * y + b.elements[2][0] * z;
+		r_local_y[i] = b.elements[0][1] * x + b.elements[1][1] * y + b.elements[2][1] * z;
+		r_local_z[i] = b.elements[0][2] * x + b.elements[1][2] * y + b.elements[2][2] * z;
+	}
+}
+
+template <class Shape>
+static _FORCE_INLINE_ void _sat_project_axes(const Shape *p_shape, const Transform3D &p_transform, const Vector3 *p_axes, const _SATAxisBatch &p_batch, real_t *r_min, real_t *r_max) {
+	for (int i = 0; i < p_batch.count; i++) {
+		p_shape->project_range(p_axes[i], p_transform, r_min[i], r_max[i]);
+	}
+}
+
+static _FORCE_INLINE_ void _sat_project_axes(const GodotSphereShape3D *p_shape, const Transform3D &p_transform, const Vector3 *p_axes, const _SATAxisBatch &p_batch, real_t *r_min, real_t *r_max) {
+	real_t d[SAT_MAX_BATCH_AXES], lx[SAT_MAX_BATCH_AXES], ly[SAT_MAX_BATCH_AXES], lz[SAT_MAX_BATCH_AXES];
+	_sat_localize_axes(p_batch, p_transform, d, lx, ly, lz);
+
+	const real_t radius = p_shape->get_radius();
+	for (int i = 0; i < p_batch.count; i++) {
+		const real_t extent = radius * Math::sqrt(lx[i] * lx[i] + ly[i] * ly[i] + lz[i] * lz[i]);
+		r_min[i] = d[i] - extent;
+		r_max[i] = d[i] + extent;
+	}
+}
+
+static _FORCE_INLINE_ void _sat_project_axes(const GodotBoxShape3D *p_shape, const Transform3D &p_transform, const Vector3 *p_axes, const _SATAxisBatch &p_batch, real_t *r_min, real_t *r_max) {
+	real_t d[SAT_MAX_BATCH_AXES], lx[SAT_MAX_BATCH_AXES], ly[SAT_MAX_BATCH_AXES], lz[SAT_MAX_BATCH_AXES];
+	_sat_localize_axes(p_batch, p_transform, d, lx, ly, lz);
+
+	const Vector3 he = p_shape->get_half_extents();
+	for (int i = 0; i < p_batch.count; i++) {
+		const real_t extent = Math::abs(lx[i]) * he.x + Math::abs(ly[i]) * he.y + Math::abs(lz[i]) * he.z;
+		r_min[i] = d[i] - extent;
+		r_max[i] = d[i] + extent;
+	}
+}
+
+static _FORCE_INLINE_ void _sat_project_axes(const GodotCapsuleShape3D *p_shape, const Transform3D &p_transform, const Vector3 *p_axes, const _SATAxisBatch &p_batch, real_t *r_min, real_t *r_max) {
+	real_t d[SAT_MAX_BATCH_AXES], lx[SAT_MAX_BATCH_AXES], ly[SAT_MAX_BATCH_AXES], lz[SAT_MAX_BATCH_AXES];
+	_sat_localize_axes(p_batch, p_transform, d, lx, ly, lz);
+
+	// Same as GodotCapsuleShape3D::project_range(): a sphere swept along the local Y axis.
+	const real_t radius = p_shape->get_radius();
+	const real_t h = p_shape->get_height() * 0.5 - radius;
+	for (int i = 0; i < p_batch.count; i++) {
+		const real_t extent = radius * Math::sqrt(lx[i] * lx[i] + ly[i] * ly[i] + lz[i] * lz[i]) + h * Math::abs(ly[i]);
+		r_min[i] = d[i] - extent;
+		r_max[i] = d[i] + extent;
+	}
+}
+
 template <class ShapeA, class ShapeB, bool withMargin = false>
 class SeparatorAxisTest {
 	const ShapeA *shape_A = nullptr;
@@ -635,11 +711,52 @@ public:
 			axis = Vector3(0.0, 1.0, 0.0);
 		}
 
+		_SATAxisBatch batch;
+		batch.x[0] = axis.x;
+		batch.y[0] = axis.y;
+		batch.z[0] = axis.z;
+		batch.count = 1;
+
 		real_t min_A, max_A, min_B, max_B;
 
-		shape_A->project_range(axis, *transform_A, min_A, max_A);
-		shape_B->project_range(axis, *transform_B, min_B, max_B);
+		_sat_project_axes(shape_A, *transform_A, &axis, batch, &min_A, &max_A);
+		_sat_project_axes(shape_B, *transform_B, &axis, batch, &min_B, &max_B);
+
+		return _test_projection(axis, min_A, max_A, min_B, max_B, p_directional);
+	}
+
+	// Same as calling test_axis() on every axis in order, stopping at the first separating one, but projects all the
+	// axes at once.
+	_FORCE_INLINE_ bool test_axes(const Vector3 *p_axes, int p_count) {
+		Vector3 axes[SAT_MAX_BATCH_AXES];
+		_SATAxisBatch batch;
+		batch.count = p_count;
+
+		for (int i = 0; i < p_count; i++) {
+			axes[i] = p_axes[i];
+			if (axes[i].is_equal_approx(Vector3())) {
+				// strange case, try an upwards separator
+				axes[i] = Vector3(0.0, 1.0, 0.0);
+			}
+			batch.x[i] = axes[i].x;
+			batch.y[i] = axes[i].y;
+			batch.z[i] = axes[i].z;
+		}
+
+		real_t min_A[SAT_MAX_BATCH_AXES], max_A[SAT_MAX_BATCH_AXES], min_B[SAT_MAX_BATCH_AXES], max_B[SAT_MAX_BATCH_AXES];
+
+		_sat_project_axes(shape_A, *transform_A, axes, batch, min_A, max_A);
+		_sat_project_axes(shape_B, *transform_B, axes, batch, min_B, max_B);
 
+		for (int i = 0; i < p_count; i++) {
+			if (!_test_projection(axes[i], min_A[i], max_A[i], min_B[i], max_B[i], false)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	_FORCE_INLINE_ bool _test_projection(Vector3 axis, real_t min_A, real_t max_A, real_t min_B, real_t max_B, bool p_directional) {
 		if (withMargin) {
 			min_A -= margin_A;
 			max_A += margin_A;
@@ -795,14 +912,12 @@ static void _collision_sphere_box(const GodotShape3D *p_a, const Transform3D &p_
 		return;
 	}
 
+	Vector3 axes[7];
+
 	// test faces
 
 	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_b.basis.get_axis(i).normalized();
-
-		if (!separator.test_axis(axis)) {
-			return;
-		}
+		axes[i] = p_transform_b.basis.get_axis(i).normalized();
 	}
 
 	// calculate closest point to sphere
@@ -817,19 +932,16 @@ static void _collision_sphere_box(const GodotShape3D *p_a, const Transform3D &p_
 
 	// use point to test axis
 	Vector3 point_axis = (p_transform_a.origin - cpoint).normalized();
-
-	if (!separator.test_axis(point_axis)) {
-		return;
-	}
+	axes[3] = point_axis;
 
 	// test edges
 
 	for (int i = 0; i < 3; i++) {
-		Vector3 axis = point_axis.cross(p_transform_b.basis.get_axis(i)).cross(p_transform_b.basis.get_axis(i)).normalized();
+		axes[4 + i] = point_axis.cross(p_transform_b.basis.get_axis(i)).cross(p_transform_b.basis.get_axis(i)).normalized();
+	}
 
-		if (!separator.test_axis(axis)) {
-			return;
-		}
+	if (!separator.test_axes(axes, 7)) {
+		return;
 	}
 
 	separator.generate_contacts();
@@ -852,25 +964,21 @@ static void _collision_sphere_capsule(const GodotShape3D *p_a, const Transform3D
 
 	Vector3 capsule_ball_1 = p_transform_b.origin + capsule_axis;
 
-	if (!separator.test_axis((capsule_ball_1 - p_transform_a.origin).normalized())) {
-		return;
-	}
-
 	//capsule sphere 2, sphere
 
 	Vector3 capsule_ball_2 = p_transform_b.origin - capsule_axis;
 
-	if (!separator.test_axis((capsule_ball_2 - p_transform_a.origin).normalized())) {
-		return;
-	}
-
 	//capsule edge, sphere
 
 	Vector3 b2a = p_transform_a.origin - p_transform_b.origin;
 
-	Vector3 axis = b2a.cross(capsule_axis).cross(capsule_axis).normalized();
+	const Vector3 axes[3] = {
+		(capsule_ball_1 - p_transform_a.origin).normalized(),
+		(capsule_ball_2 - p_transform_a.origin).normalized(),
+		b2a.cross(capsule_axis).cross(capsule_axis).normalized(),
+	};
 
-	if (!separator.test_axis(axis)) {
+	if (!separator.test_axes(axes, 3)) {
 		return;
 	}
 
@@ -1055,24 +1163,19 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 		return;
 	}
 
+	Vector3 axes[15];
+	int axis_count = 0;
+
 	// test faces of A
 
 	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_a.basis.get_axis(i).normalized();
-
-		if (!separator.test_axis(axis)) {
-			return;
-		}
+		axes[axis_count++] = p_transform_a.basis.get_axis(i).normalized();
 	}
 
 	// test faces of B
 
 	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_b.basis.get_axis(i).normalized();
-
-		if (!separator.test_axis(axis)) {
-			return;
-		}
+		axes[axis_count++] = p_transform_b.basis.get_axis(i).normalized();
 	}
 
 	// test combined edges
@@ -1083,14 +1186,14 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 			if (Math::is_zero_approx(axis.length_squared())) {
 				continue;
 			}
-			axis.normalize();
-
-			if (!separator.test_axis(axis)) {
-				return;
-			}
+			axes[axis_count++] = axis.normalized();
 		}
 	}
 
+	if (!separator.test_axes(axes, axis_count)) {
+		return;
+	}
+
 	if (withMargin) {
 		//add endpoint test between closest vertices and edges
 
@@ -1153,13 +1256,12 @@ static void _collision_box_capsule(const GodotShape3D *p_a, const Transform3D &p
 		return;
 	}
 
+	Vector3 axes[14];
+	int axis_count = 0;
+
 	// faces of A
 	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_a.basis.get_axis(i).normalized();
-
-		if (!separator.test_axis(axis)) {
-			return;
-		}
+		axes[axis_count++] = p_transform_a.basis.get_axis(i).normalized();
 	}
 
 	Vector3 cyl_axis = p_transform_b.basis.get_axis(1).normalized();
@@ -1174,36 +1276,32 @@ static void _collision_box_capsule(const GodotShape3D *p_a, const Transform3D &p
 			continue;
 		}
 
-		if (!separator.test_axis(axis.normalized())) {
-			return;
-		}
+		axes[axis_count++] = axis.normalized();
 	}
 
 	// points of A, capsule cylinder
-	// this sure could be made faster somehow..
+
+	const Vector3 he = box_A->get_half_extents();
+	const Vector3 box_x = p_transform_a.basis.get_axis(0) * he.x;
+	const Vector3 box_y = p_transform_a.basis.get_axis(1) * he.y;
+	const Vector3 box_z = p_transform_a.basis.get_axis(2) * he.z;
+	const Plane cyl_plane(cyl_axis);
 
 	for (int i = 0; i < 2; i++) {
 		for (int j = 0; j < 2; j++) {
 			for (int k = 0; k < 2; k++) {
-				Vector3 he = box_A->get_half_extents();
-				he.x *= (i * 2 - 1);
-				he.y *= (j * 2 - 1);
-				he.z *= (k * 2 - 1);
-				Vector3 point = p_transform_a.origin;
-				for (int l = 0; l < 3; l++) {
-					point += p_transform_a.basis.get_axis(l) * he[l];
-				}
+				Vector3 point = p_transform_a.origin + box_x * (i * 2 - 1) + box_y * (j * 2 - 1) + box_z * (k * 2 - 1);
 
 				//Vector3 axis = (point - cyl_axis * cyl_axis.dot(point)).normalized();
-				Vector3 axis = Plane(cyl_axis).project(point).normalized();
-
-				if (!separator.test_axis(axis)) {
-					return;
-				}
+				axes[axis_count++] = cyl_plane.project(point).normalized();
 			}
 		}
 	}
 
+	if (!separator.test_axes(axes, axis_count)) {
+		return;
+	}
+
 	// capsule balls, edges of A
 
 	for (int i = 0; i < 2; i++) {
@@ -1615,43 +1713,22 @@ static void _collision_capsule_capsule(const GodotShape3D *p_a, const Transform3
 	Vector3 capsule_B_ball_1 = p_transform_b.origin + capsule_B_axis;
 	Vector3 capsule_B_ball_2 = p_transform_b.origin - capsule_B_axis;
 
-	//balls-balls
-
-	if (!separator.test_axis((capsule_A_ball_1 - capsule_B_ball_1).normalized())) {
-		return;
-	}
-	if (!separator.test_axis((capsule_A_ball_1 - capsule_B_ball_2).normalized())) {
-		return;
-	}
-
-	if (!separator.test_axis((capsule_A_ball_2 - capsule_B_ball_1).normalized())) {
-		return;
-	}
-	if (!separator.test_axis((capsule_A_ball_2 - capsule_B_ball_2).normalized())) {
-		return;
-	}
-
-	// edges-balls
-
-	if (!separator.test_axis((capsule_A_ball_1 - capsule_B_ball_1).cross(capsule_A_axis).cross(capsule_A_axis).normalized())) {
-		return;
-	}
-
-	if (!separator.test_axis((capsule_A_ball_1 - capsule_B_ball_2).cross(capsule_A_axis).cross(capsule_A_axis).normalized())) {
-		return;
-	}
-
-	if (!separator.test_axis((capsule_B_ball_1 - capsule_A_ball_1).cross(capsule_B_axis).cross(capsule_B_axis).normalized())) {
-		return;
-	}
-
-	if (!separator.test_axis((capsule_B_ball_1 - capsule_A_ball_2).cross(capsule_B_axis).cross(capsule_B_axis).normalized())) {
-		return;
-	}
-
-	// edges
+	const Vector3 axes[9] = {
+		//balls-balls
+		(capsule_A_ball_1 - capsule_B_ball_1).normalized(),
+		(capsule_A_ball_1 - capsule_B_ball_2).normalized(),
+		(capsule_A_ball_2 - capsule_B_ball_1).normalized(),
+		(capsule_A_ball_2 - capsule_B_ball_2).normalized(),
+		// edges-balls
+		(capsule_A_ball_1 - capsule_B_ball_1).cross(capsule_A_axis).cross(capsule_A_axis).normalized(),
+		(capsule_A_ball_1 - capsule_B_ball_2).cross(capsule_A_axis).cross(capsule_A_axis).normalized(),
+		(capsule_B_ball_1 - capsule_A_ball_1).cross(capsule_B_axis).cross(capsule_B_axis).normalized(),
+		(capsule_B_ball_1 - capsule_A_ball_2).cross(capsule_B_axis).cross(capsule_B_axis).normalized(),
+		// edges
+		capsule_A_axis.cross(capsule_B_axis).normalized(),
+	};
 
-	if (!separator.test_axis(capsule_A_axis.cross(capsule_B_axis).normalized())) {
+	if (!separator.test_axes(axes, 9)) {
 		return;
 	}
 
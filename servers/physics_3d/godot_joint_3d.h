@@ -40,6 +40,8 @@ protected:
 	bool dynamic_B = false;
 
 public:
+	virtual bool is_joint() const override { return true; }
+
 	virtual bool setup(real_t p_step) override { return false; }
 	virtual bool pre_solve(real_t p_step) override { return true; }
 	virtual void solve(real_t p_step) override {}
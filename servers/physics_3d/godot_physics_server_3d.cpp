@@ -39,6 +39,7 @@
 #include "joints/godot_slider_joint_3d.h"
 
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/trace_zones.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -214,6 +215,53 @@ int GodotPhysicsServer3D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+Vector<uint8_t> GodotPhysicsServer3D::space_save_state(RID p_space) const {
+	const GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND_V(!space, Vector<uint8_t>());
+	ERR_FAIL_COND_V_MSG(space->is_locked(), Vector<uint8_t>(), "Space state can't be saved while the space is being stepped.");
+
+	Vector<uint8_t> state;
+	space->save_state(state);
+	return state;
+}
+
+bool GodotPhysicsServer3D::space_restore_state(RID p_space, const Vector<uint8_t> &p_state) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND_V(!space, false);
+	return space->restore_state(p_state);
+}
+
+void GodotPhysicsServer3D::space_set_state_history_size(RID p_space, int p_size) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND(!space);
+	space->set_state_history_size(p_size);
+}
+
+int GodotPhysicsServer3D::space_get_state_history_size(RID p_space) const {
+	const GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND_V(!space, 0);
+	return space->get_state_history_size();
+}
+
+int GodotPhysicsServer3D::space_get_state_history_count(RID p_space) const {
+	const GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND_V(!space, 0);
+	return space->get_state_history_count();
+}
+
+void GodotPhysicsServer3D::space_push_state(RID p_space) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND(!space);
+	ERR_FAIL_COND_MSG(space->is_locked(), "Space state can't be saved while the space is being stepped.");
+	space->push_state();
+}
+
+bool GodotPhysicsServer3D::space_rollback_state(RID p_space, int p_steps_back) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND_V(!space, false);
+	return space->rollback_state(p_steps_back);
+}
+
 RID GodotPhysicsServer3D::area_create() {
 	GodotArea3D *area = memnew(GodotArea3D);
 	RID rid = area_owner.make_rid(area);
@@ -437,6 +485,14 @@ void GodotPhysicsServer3D::area_set_area_monitor_callback(RID p_area, Object *p_
 	area->set_area_monitor_callback(p_receiver ? p_receiver->get_instance_id() : ObjectID(), p_method);
 }
 
+bool GodotPhysicsServer3D::area_set_monitor_events_callback(RID p_area, void *p_instance, AreaMonitorEventsCallback p_callback) {
+	GodotArea3D *area = area_owner.get_or_null(p_area);
+	ERR_FAIL_COND_V(!area, false);
+
+	area->set_monitor_events_callback(p_instance, p_callback);
+	return true;
+}
+
 /* BODY API */
 
 RID GodotPhysicsServer3D::body_create() {
@@ -880,6 +936,59 @@ bool GodotPhysicsServer3D::body_test_motion(RID p_body, const MotionParameters &
 	return body->get_space()->test_body_motion(body, p_parameters, r_result);
 }
 
+struct GodotPhysicsServer3D::MotionBatch {
+	GodotBody3D **bodies;
+	const MotionParameters *parameters;
+	MotionResult *results;
+	bool *collided;
+};
+
+void GodotPhysicsServer3D::_test_motion_batch_item(uint32_t p_index, MotionBatch *p_batch) {
+	// The thread pool runs one item at a time per thread, and the calling thread (index -1) takes the first slot.
+	GodotSpace3D::MotionScratch &scratch = motion_scratch[WorkerThreadPool::get_thread_index() + 1];
+
+	GodotBody3D *body = p_batch->bodies[p_index];
+	p_batch->collided[p_index] = body->get_space()->test_body_motion(body, p_batch->parameters[p_index], &p_batch->results[p_index], &scratch);
+}
+
+int GodotPhysicsServer3D::body_test_motions(const RID *p_bodies, const MotionParameters *p_parameters, MotionResult *r_results, bool *r_collided, int p_count) {
+	ERR_FAIL_COND_V(p_count < 0, 0);
+
+	// Resolve and validate everything up front, the tests only read the spaces so they can run in parallel.
+	LocalVector<GodotBody3D *> bodies;
+	bodies.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		GodotBody3D *body = body_owner.get_or_null(p_bodies[i]);
+		ERR_FAIL_COND_V(!body, 0);
+		ERR_FAIL_COND_V(!body->get_space(), 0);
+		ERR_FAIL_COND_V(body->get_space()->is_locked(), 0);
+		bodies[i] = body;
+	}
+
+	_update_shapes();
+
+	if (motion_scratch.is_empty()) {
+		WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+		motion_scratch.resize((pool ? pool->get_thread_count() : 0) + 1);
+	}
+
+	MotionBatch batch;
+	batch.bodies = bodies.ptr();
+	batch.parameters = p_parameters;
+	batch.results = r_results;
+	batch.collided = r_collided;
+
+	motion_work_pool.do_work_batched(p_count, this, &GodotPhysicsServer3D::_test_motion_batch_item, &batch);
+
+	int collided_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		if (r_collided[i]) {
+			collided_count++;
+		}
+	}
+	return collided_count;
+}
+
 PhysicsDirectBodyState3D *GodotPhysicsServer3D::body_get_direct_state(RID p_body) {
 	ERR_FAIL_COND_V_MSG((using_threads && !doing_sync), nullptr, "Body state is inaccessible right now, wait for iteration or physics process notification.");
 
@@ -1596,9 +1705,13 @@ void GodotPhysicsServer3D::set_collision_iterations(int p_iterations) {
 void GodotPhysicsServer3D::init() {
 	iterations = 8; // 8?
 	stepper = memnew(GodotStep3D);
+	motion_work_pool.init();
 };
 
 void GodotPhysicsServer3D::step(real_t p_step) {
+	Memory::TagScope memory_tag(Memory::TAG_PHYSICS);
+	TRACE_ZONE("PhysicsServer3D::step");
+
 #ifndef _3D_DISABLED
 
 	if (!active) {
@@ -1610,11 +1723,15 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	bodies_woken = 0;
+	pairs_created = 0;
 	for (Set<const GodotSpace3D *>::Element *E = active_spaces.front(); E; E = E->next()) {
 		stepper->step((GodotSpace3D *)E->get(), p_step, iterations);
 		island_count += E->get()->get_island_count();
 		active_objects += E->get()->get_active_objects();
 		collision_pairs += E->get()->get_collision_pairs();
+		bodies_woken += E->get()->get_last_step_bodies_woken();
+		pairs_created += E->get()->get_last_step_pairs_created();
 	}
 #endif
 }
@@ -1624,6 +1741,8 @@ void GodotPhysicsServer3D::sync() {
 };
 
 void GodotPhysicsServer3D::flush_queries() {
+	Memory::TagScope memory_tag(Memory::TAG_PHYSICS);
+
 #ifndef _3D_DISABLED
 
 	if (!active) {
@@ -1646,9 +1765,12 @@ void GodotPhysicsServer3D::flush_queries() {
 		static const char *time_name[GodotSpace3D::ELAPSED_TIME_MAX] = {
 			"integrate_forces",
 			"generate_islands",
+			"narrowphase",
 			"setup_constraints",
 			"solve_constraints",
-			"integrate_velocities"
+			"integrate_velocities",
+			"broadphase_update",
+			"area_callbacks" // Also part of flush_queries.
 		};
 
 		for (int i = 0; i < GodotSpace3D::ELAPSED_TIME_MAX; i++) {
@@ -1682,6 +1804,8 @@ void GodotPhysicsServer3D::end_sync() {
 
 void GodotPhysicsServer3D::finish() {
 	memdelete(stepper);
+	motion_work_pool.finish();
+	motion_scratch.clear();
 };
 
 int GodotPhysicsServer3D::get_process_info(ProcessInfo p_info) {
@@ -1695,6 +1819,12 @@ int GodotPhysicsServer3D::get_process_info(ProcessInfo p_info) {
 		case INFO_ISLAND_COUNT: {
 			return island_count;
 		} break;
+		case INFO_BODIES_WOKEN: {
+			return bodies_woken;
+		} break;
+		case INFO_PAIRS_CREATED: {
+			return pairs_created;
+		} break;
 	}
 
 	return 0;
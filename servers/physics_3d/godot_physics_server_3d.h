@@ -49,6 +49,8 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	int bodies_woken = 0;
+	int pairs_created = 0;
 
 	bool using_threads = false;
 	bool doing_sync = false;
@@ -69,6 +71,13 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	SelfList<GodotCollisionObject3D>::List pending_shape_update_list;
 	void _update_shapes();
 
+	struct MotionBatch;
+
+	ThreadWorkPool motion_work_pool;
+	LocalVector<GodotSpace3D::MotionScratch> motion_scratch;
+
+	void _test_motion_batch_item(uint32_t p_index, MotionBatch *p_batch);
+
 	static GodotPhysicsServer3D *godot_singleton;
 
 public:
@@ -118,6 +127,15 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	virtual Vector<uint8_t> space_save_state(RID p_space) const override;
+	virtual bool space_restore_state(RID p_space, const Vector<uint8_t> &p_state) override;
+
+	virtual void space_set_state_history_size(RID p_space, int p_size) override;
+	virtual int space_get_state_history_size(RID p_space) const override;
+	virtual int space_get_state_history_count(RID p_space) const override;
+	virtual void space_push_state(RID p_space) override;
+	virtual bool space_rollback_state(RID p_space, int p_steps_back) override;
+
 	/* AREA API */
 
 	virtual RID area_create() override;
@@ -159,6 +177,7 @@ public:
 
 	virtual void area_set_monitor_callback(RID p_area, Object *p_receiver, const StringName &p_method) override;
 	virtual void area_set_area_monitor_callback(RID p_area, Object *p_receiver, const StringName &p_method) override;
+	virtual bool area_set_monitor_events_callback(RID p_area, void *p_instance, AreaMonitorEventsCallback p_callback) override;
 
 	/* BODY API */
 
@@ -244,6 +263,7 @@ public:
 	virtual void body_set_ray_pickable(RID p_body, bool p_enable) override;
 
 	virtual bool body_test_motion(RID p_body, const MotionParameters &p_parameters, MotionResult *r_result = nullptr) override;
+	virtual int body_test_motions(const RID *p_bodies, const MotionParameters *p_parameters, MotionResult *r_results, bool *r_collided, int p_count) override;
 
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectBodyState3D *body_get_direct_state(RID p_body) override;
@@ -1628,7 +1628,18 @@ GodotConcavePolygonShape3D::GodotConcavePolygonShape3D() {
 /* HEIGHT MAP SHAPE */
 
 Vector<real_t> GodotHeightMapShape3D::get_heights() const {
-	return heights;
+	if (!quantized) {
+		return heights;
+	}
+
+	Vector<real_t> dequantized_heights;
+	dequantized_heights.resize(quantized_heights.size());
+	real_t *w = dequantized_heights.ptrw();
+	const uint16_t *r = quantized_heights.ptr();
+	for (int i = 0; i < quantized_heights.size(); i++) {
+		w[i] = quantized_min + r[i] * quantized_step;
+	}
+	return dequantized_heights;
 }
 
 int GodotHeightMapShape3D::get_width() const {
@@ -1685,10 +1696,31 @@ _FORCE_INLINE_ bool _heightmap_face_cull_segment(_HeightmapSegmentCullParams &p_
 }
 
 _FORCE_INLINE_ bool _heightmap_cell_cull_segment(_HeightmapSegmentCullParams &p_params, const _HeightmapGridCullState &p_state) {
+	Vector3 cell_point;
+	p_params.heightmap->_get_point(p_state.x + 1, p_state.z + 1, cell_point);
+
 	// First triangle.
 	p_params.heightmap->_get_point(p_state.x, p_state.z, p_params.face->vertex[0]);
 	p_params.heightmap->_get_point(p_state.x + 1, p_state.z, p_params.face->vertex[1]);
 	p_params.heightmap->_get_point(p_state.x, p_state.z + 1, p_params.face->vertex[2]);
+
+	if (p_state.length_flat > CMP_EPSILON) {
+		// Skip the triangle tests when the segment passes entirely above or below the cell.
+		real_t cell_min = MIN(MIN(p_params.face->vertex[0].y, p_params.face->vertex[1].y), MIN(p_params.face->vertex[2].y, cell_point.y));
+		real_t cell_max = MAX(MAX(p_params.face->vertex[0].y, p_params.face->vertex[1].y), MAX(p_params.face->vertex[2].y, cell_point.y));
+
+		real_t flat_to_3d = p_state.length / p_state.length_flat;
+		real_t enter_y = p_params.from.y + p_params.dir.y * (p_state.prev_dist * flat_to_3d);
+		real_t exit_y = p_params.from.y + p_params.dir.y * (p_state.dist * flat_to_3d);
+
+		if ((enter_y > cell_max) && (exit_y > cell_max)) {
+			return false;
+		}
+		if ((enter_y < cell_min) && (exit_y < cell_min)) {
+			return false;
+		}
+	}
+
 	p_params.face->normal = Plane(p_params.face->vertex[0], p_params.face->vertex[1], p_params.face->vertex[2]).normal;
 	if (_heightmap_face_cull_segment(p_params)) {
 		return true;
@@ -1696,7 +1728,7 @@ _FORCE_INLINE_ bool _heightmap_cell_cull_segment(_HeightmapSegmentCullParams &p_
 
 	// Second triangle.
 	p_params.face->vertex[0] = p_params.face->vertex[1];
-	p_params.heightmap->_get_point(p_state.x + 1, p_state.z + 1, p_params.face->vertex[1]);
+	p_params.face->vertex[1] = cell_point;
 	p_params.face->normal = Plane(p_params.face->vertex[0], p_params.face->vertex[1], p_params.face->vertex[2]).normal;
 	if (_heightmap_face_cull_segment(p_params)) {
 		return true;
@@ -1882,7 +1914,7 @@ bool GodotHeightMapShape3D::_intersect_grid_segment(ProcessFunction &p_process,
 }
 
 bool GodotHeightMapShape3D::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const {
-	if (heights.is_empty()) {
+	if (!_has_heights()) {
 		return false;
 	}
 
@@ -1962,7 +1994,7 @@ void GodotHeightMapShape3D::_get_cell(const Vector3 &p_point, int &r_x, int &r_y
 }
 
 void GodotHeightMapShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callback, void *p_userdata) const {
-	if (heights.is_empty()) {
+	if (!_has_heights()) {
 		return;
 	}
 
@@ -1987,31 +2019,85 @@ void GodotHeightMapShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callb
 	int start_z = MAX(0, aabb_min[2]);
 	int end_z = MIN(depth - 1, aabb_max[2]);
 
+	if (start_x >= end_x || start_z >= end_z) {
+		return;
+	}
+
+	const real_t aabb_min_y = local_aabb.position.y;
+	const real_t aabb_max_y = local_aabb.position.y + local_aabb.size.y;
+
 	GodotFaceShape3D face;
 	face.backface_collision = true;
 
-	for (int z = start_z; z < end_z; z++) {
-		for (int x = start_x; x < end_x; x++) {
-			// First triangle.
-			_get_point(x, z, face.vertex[0]);
-			_get_point(x + 1, z, face.vertex[1]);
-			_get_point(x, z + 1, face.vertex[2]);
-			face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
-			if (p_callback(p_userdata, &face)) {
-				return;
+	if (bounds_grid.is_empty()) {
+		_cull_cells(start_x, end_x, start_z, end_z, aabb_min_y, aabb_max_y, p_callback, p_userdata, face);
+		return;
+	}
+
+	// Skip whole chunks when the aabb is above or below them, which is the common case for bodies resting on terrain.
+	const int start_chunk_x = start_x / BOUNDS_CHUNK_SIZE;
+	const int end_chunk_x = (end_x - 1) / BOUNDS_CHUNK_SIZE;
+	const int start_chunk_z = start_z / BOUNDS_CHUNK_SIZE;
+	const int end_chunk_z = (end_z - 1) / BOUNDS_CHUNK_SIZE;
+
+	for (int chunk_z = start_chunk_z; chunk_z <= end_chunk_z; chunk_z++) {
+		for (int chunk_x = start_chunk_x; chunk_x <= end_chunk_x; chunk_x++) {
+			const Range &chunk = _get_bounds_chunk(chunk_x, chunk_z);
+			if (chunk.max < aabb_min_y || chunk.min > aabb_max_y) {
+				continue;
 			}
 
-			// Second triangle.
-			face.vertex[0] = face.vertex[1];
-			_get_point(x + 1, z + 1, face.vertex[1]);
-			face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
-			if (p_callback(p_userdata, &face)) {
+			const int chunk_start_x = MAX(start_x, chunk_x * BOUNDS_CHUNK_SIZE);
+			const int chunk_end_x = MIN(end_x, (chunk_x + 1) * BOUNDS_CHUNK_SIZE);
+			const int chunk_start_z = MAX(start_z, chunk_z * BOUNDS_CHUNK_SIZE);
+			const int chunk_end_z = MIN(end_z, (chunk_z + 1) * BOUNDS_CHUNK_SIZE);
+			if (_cull_cells(chunk_start_x, chunk_end_x, chunk_start_z, chunk_end_z, aabb_min_y, aabb_max_y, p_callback, p_userdata, face)) {
 				return;
 			}
 		}
 	}
 }
 
+bool GodotHeightMapShape3D::_cull_cells(int p_start_x, int p_end_x, int p_start_z, int p_end_z, real_t p_min_y, real_t p_max_y, QueryCallback p_callback, void *p_userdata, GodotFaceShape3D &r_face) const {
+	for (int z = p_start_z; z < p_end_z; z++) {
+		// Heights of the cell corners, the right column of one cell is the left column of the next.
+		real_t height_00 = _get_height(p_start_x, z);
+		real_t height_01 = _get_height(p_start_x, z + 1);
+
+		for (int x = p_start_x; x < p_end_x; x++) {
+			const real_t height_10 = _get_height(x + 1, z);
+			const real_t height_11 = _get_height(x + 1, z + 1);
+
+			const real_t cell_min = MIN(MIN(height_00, height_01), MIN(height_10, height_11));
+			const real_t cell_max = MAX(MAX(height_00, height_01), MAX(height_10, height_11));
+
+			if (cell_max >= p_min_y && cell_min <= p_max_y) {
+				// First triangle.
+				_get_point(x, z, r_face.vertex[0]);
+				_get_point(x + 1, z, r_face.vertex[1]);
+				_get_point(x, z + 1, r_face.vertex[2]);
+				r_face.normal = Plane(r_face.vertex[0], r_face.vertex[1], r_face.vertex[2]).normal;
+				if (p_callback(p_userdata, &r_face)) {
+					return true;
+				}
+
+				// Second triangle.
+				r_face.vertex[0] = r_face.vertex[1];
+				_get_point(x + 1, z + 1, r_face.vertex[1]);
+				r_face.normal = Plane(r_face.vertex[0], r_face.vertex[1], r_face.vertex[2]).normal;
+				if (p_callback(p_userdata, &r_face)) {
+					return true;
+				}
+			}
+
+			height_00 = height_10;
+			height_01 = height_11;
+		}
+	}
+
+	return false;
+}
+
 Vector3 GodotHeightMapShape3D::get_moment_of_inertia(real_t p_mass) const {
 	// use bad AABB approximation
 	Vector3 extents = get_aabb().size * 0.5;
@@ -2091,10 +2177,37 @@ void GodotHeightMapShape3D::_build_accelerator() {
 	}
 }
 
-void GodotHeightMapShape3D::_setup(const Vector<real_t> &p_heights, int p_width, int p_depth, real_t p_min_height, real_t p_max_height) {
-	heights = p_heights;
+void GodotHeightMapShape3D::_setup(const Vector<real_t> &p_heights, int p_width, int p_depth, real_t p_min_height, real_t p_max_height, bool p_quantized) {
 	width = p_width;
 	depth = p_depth;
+	quantized = p_quantized;
+
+	if (quantized) {
+		heights.clear();
+
+		// Quantize over the actual range of the data, the given min/max heights may be wider.
+		const real_t *r = p_heights.ptr();
+		const int heights_size = p_heights.size();
+		real_t data_min = heights_size > 0 ? r[0] : 0.0;
+		real_t data_max = data_min;
+		for (int i = 1; i < heights_size; ++i) {
+			data_min = MIN(data_min, r[i]);
+			data_max = MAX(data_max, r[i]);
+		}
+
+		quantized_min = data_min;
+		quantized_step = (data_max - data_min) / 65535.0;
+
+		quantized_heights.resize(heights_size);
+		uint16_t *w = quantized_heights.ptrw();
+		const real_t inv_step = quantized_step > 0.0 ? 1.0 / quantized_step : 0.0;
+		for (int i = 0; i < heights_size; ++i) {
+			w[i] = (uint16_t)CLAMP(Math::round((r[i] - data_min) * inv_step), (real_t)0.0, (real_t)65535.0);
+		}
+	} else {
+		heights = p_heights;
+		quantized_heights.clear();
+	}
 
 	// Initialize aabb.
 	AABB aabb;
@@ -2165,9 +2278,9 @@ void GodotHeightMapShape3D::set_data(const Variant &p_data) {
 		min_height = d["min_height"];
 		max_height = d["max_height"];
 	} else {
-		int heights_size = heights.size();
+		int heights_size = heights_buffer.size();
 		for (int i = 0; i < heights_size; ++i) {
-			real_t h = heights[i];
+			real_t h = heights_buffer[i];
 			if (h < min_height) {
 				min_height = h;
 			} else if (h > max_height) {
@@ -2180,8 +2293,10 @@ void GodotHeightMapShape3D::set_data(const Variant &p_data) {
 
 	ERR_FAIL_COND(heights_buffer.size() != (width * depth));
 
+	bool quantize = d.has("quantized") && bool(d["quantized"]);
+
 	// If specified, min and max height will be used as precomputed values.
-	_setup(heights_buffer, width, depth, min_height, max_height);
+	_setup(heights_buffer, width, depth, min_height, max_height, quantize);
 }
 
 Variant GodotHeightMapShape3D::get_data() const {
@@ -2193,7 +2308,8 @@ Variant GodotHeightMapShape3D::get_data() const {
 	d["min_height"] = aabb.position.y;
 	d["max_height"] = aabb.position.y + aabb.size.y;
 
-	d["heights"] = heights;
+	d["heights"] = get_heights();
+	d["quantized"] = quantized;
 
 	return d;
 }
@@ -382,6 +382,11 @@ public:
 
 struct GodotHeightMapShape3D : public GodotConcaveShape3D {
 	Vector<real_t> heights;
+	// When quantized, heights are stored here instead, as 16-bit steps above quantized_min.
+	Vector<uint16_t> quantized_heights;
+	real_t quantized_min = 0.0;
+	real_t quantized_step = 0.0;
+	bool quantized = false;
 	int width = 0;
 	int depth = 0;
 	Vector3 local_origin;
@@ -401,7 +406,14 @@ struct GodotHeightMapShape3D : public GodotConcaveShape3D {
 		return bounds_grid[(p_z * bounds_grid_width) + p_x];
 	}
 
+	_FORCE_INLINE_ bool _has_heights() const {
+		return quantized ? !quantized_heights.is_empty() : !heights.is_empty();
+	}
+
 	_FORCE_INLINE_ real_t _get_height(int p_x, int p_z) const {
+		if (quantized) {
+			return quantized_min + quantized_heights[(p_z * width) + p_x] * quantized_step;
+		}
 		return heights[(p_z * width) + p_x];
 	}
 
@@ -415,13 +427,16 @@ struct GodotHeightMapShape3D : public GodotConcaveShape3D {
 
 	void _build_accelerator();
 
+	bool _cull_cells(int p_start_x, int p_end_x, int p_start_z, int p_end_z, real_t p_min_y, real_t p_max_y, QueryCallback p_callback, void *p_userdata, GodotFaceShape3D &r_face) const;
+
 	template <typename ProcessFunction>
 	bool _intersect_grid_segment(ProcessFunction &p_process, const Vector3 &p_begin, const Vector3 &p_end, int p_width, int p_depth, const Vector3 &offset, Vector3 &r_point, Vector3 &r_normal) const;
 
-	void _setup(const Vector<real_t> &p_heights, int p_width, int p_depth, real_t p_min_height, real_t p_max_height);
+	void _setup(const Vector<real_t> &p_heights, int p_width, int p_depth, real_t p_min_height, real_t p_max_height, bool p_quantized);
 
 public:
 	Vector<real_t> get_heights() const;
+	bool is_quantized() const { return quantized; }
 	int get_width() const;
 	int get_depth() const;
 
@@ -58,6 +58,10 @@ GodotSoftBody3D::GodotSoftBody3D() :
 		GodotCollisionObject3D(TYPE_SOFT_BODY),
 		active_list(this) {
 	_set_static(false);
+
+	link_work_pool.init();
+	face_work_pool.init();
+	node_work_pool.init();
 }
 
 void GodotSoftBody3D::_shapes_changed() {
@@ -111,6 +115,27 @@ Variant GodotSoftBody3D::get_state(PhysicsServer3D::BodyState p_state) const {
 	return Variant();
 }
 
+void GodotSoftBody3D::add_constraint(GodotConstraint3D *p_constraint) {
+	constraints.insert(p_constraint);
+	if (get_space()) {
+		get_space()->invalidate_islands();
+	}
+}
+
+void GodotSoftBody3D::remove_constraint(GodotConstraint3D *p_constraint) {
+	constraints.erase(p_constraint);
+	if (get_space()) {
+		get_space()->invalidate_islands();
+	}
+}
+
+void GodotSoftBody3D::clear_constraints() {
+	constraints.clear();
+	if (get_space()) {
+		get_space()->invalidate_islands();
+	}
+}
+
 void GodotSoftBody3D::set_space(GodotSpace3D *p_space) {
 	if (get_space()) {
 		get_space()->soft_body_remove_from_active_list(&active_list);
@@ -152,43 +177,57 @@ void GodotSoftBody3D::update_rendering_server(RenderingServerHandler *p_renderin
 	}
 
 	const uint32_t vertex_count = map_visual_to_physics.size();
+	render_vertices.resize(vertex_count);
+	render_normals.resize(vertex_count);
 	for (uint32_t i = 0; i < vertex_count; ++i) {
 		const uint32_t node_index = map_visual_to_physics[i];
 		const Node &node = nodes[node_index];
-		const Vector3 &vertex_position = node.x;
-		const Vector3 &vertex_normal = node.n;
-
-		p_rendering_server_handler->set_vertex(i, &vertex_position);
-		p_rendering_server_handler->set_normal(i, &vertex_normal);
+		render_vertices[i] = node.x;
+		render_normals[i] = node.n;
 	}
 
+	p_rendering_server_handler->set_vertices_and_normals(vertex_count, render_vertices.ptr(), render_normals.ptr());
 	p_rendering_server_handler->set_aabb(bounds);
 }
 
 void GodotSoftBody3D::update_normals_and_centroids() {
-	uint32_t i, ni;
-
-	for (i = 0, ni = nodes.size(); i < ni; ++i) {
-		nodes[i].n = Vector3();
+	node_work_pool.do_work_batched(nodes.size(), this, &GodotSoftBody3D::_reset_node_normal, nullptr);
+
+	for (uint32_t batch = 0; batch + 1 < face_batches.size(); ++batch) {
+		const uint32_t offset = face_batches[batch];
+		const uint32_t count = face_batches[batch + 1] - offset;
+		if (batch == BATCH_COLOR_MAX) {
+			for (uint32_t i = 0; i < count; ++i) {
+				_update_face_normal(i, offset);
+			}
+		} else {
+			face_work_pool.do_work_batched(count, this, &GodotSoftBody3D::_update_face_normal, offset);
+		}
 	}
 
-	for (i = 0, ni = faces.size(); i < ni; ++i) {
-		Face &face = faces[i];
-		const Vector3 n = vec3_cross(face.n[0]->x - face.n[2]->x, face.n[0]->x - face.n[1]->x);
-		face.n[0]->n += n;
-		face.n[1]->n += n;
-		face.n[2]->n += n;
-		face.normal = n;
-		face.normal.normalize();
-		face.centroid = 0.33333333333 * (face.n[0]->x + face.n[1]->x + face.n[2]->x);
-	}
+	node_work_pool.do_work_batched(nodes.size(), this, &GodotSoftBody3D::_normalize_node_normal, nullptr);
+}
 
-	for (i = 0, ni = nodes.size(); i < ni; ++i) {
-		Node &node = nodes[i];
-		real_t len = node.n.length();
-		if (len > CMP_EPSILON) {
-			node.n /= len;
-		}
+void GodotSoftBody3D::_reset_node_normal(uint32_t p_index, void *p_userdata) {
+	nodes[p_index].n = Vector3();
+}
+
+void GodotSoftBody3D::_update_face_normal(uint32_t p_index, uint32_t p_offset) {
+	Face &face = faces[p_offset + p_index];
+	const Vector3 n = vec3_cross(face.n[0]->x - face.n[2]->x, face.n[0]->x - face.n[1]->x);
+	face.n[0]->n += n;
+	face.n[1]->n += n;
+	face.n[2]->n += n;
+	face.normal = n;
+	face.normal.normalize();
+	face.centroid = 0.33333333333 * (face.n[0]->x + face.n[1]->x + face.n[2]->x);
+}
+
+void GodotSoftBody3D::_normalize_node_normal(uint32_t p_index, void *p_userdata) {
+	Node &node = nodes[p_index];
+	real_t len = node.n.length();
+	if (len > CMP_EPSILON) {
+		node.n /= len;
 	}
 }
 
@@ -587,7 +626,12 @@ bool GodotSoftBody3D::create_from_trimesh(const Vector<int> &p_indices, const Ve
 	}
 
 	generate_bending_constraints(2);
-	reoptimize_link_order();
+
+	build_batches(links, link_batches);
+	build_batches(faces, face_batches);
+	for (uint32_t i = 0; i < faces.size(); ++i) {
+		faces[i].index = i;
+	}
 
 	update_constants();
 	update_normals_and_centroids();
@@ -695,133 +739,66 @@ void GodotSoftBody3D::generate_bending_constraints(int p_distance) {
 	}
 }
 
-//===================================================================
-//
-//
-// This function takes in a list of interdependent Links and tries
-// to maximize the distance between calculation
-// of dependent links. This increases the amount of parallelism that can
-// be exploited by out-of-order instruction processors with large but
-// (inevitably) finite instruction windows.
-//
-//===================================================================
-
-// A small structure to track lists of dependent link calculations.
-class LinkDeps {
-public:
-	int value; // A link calculation that is dependent on this one
-			// Positive values = "input A" while negative values = "input B"
-	LinkDeps *next; // Next dependence in the list
-};
-typedef LinkDeps *LinkDepsPtr;
-
-void GodotSoftBody3D::reoptimize_link_order() {
-	const int reop_not_dependent = -1;
-	const int reop_node_complete = -2;
-
-	uint32_t i, link_count = links.size(), node_count = nodes.size();
-	Link *lr;
-	int ar, br;
-	Node *node0 = &(nodes[0]);
-	Node *node1 = &(nodes[1]);
-	LinkDepsPtr link_dep;
-	int ready_list_head, ready_list_tail, link_num, link_dep_frees, dep_link;
-
-	// Allocate temporary buffers.
-	int *node_written_at = memnew_arr(int, node_count + 1); // What link calculation produced this node's current values?
-	int *link_dep_A = memnew_arr(int, link_count); // Link calculation input is dependent upon prior calculation #N
-	int *link_dep_B = memnew_arr(int, link_count);
-	int *ready_list = memnew_arr(int, link_count); // List of ready-to-process link calculations (# of links, maximum)
-	LinkDeps *link_dep_free_list = memnew_arr(LinkDeps, 2 * link_count); // Dependent-on-me list elements (2x# of links, maximum)
-	LinkDepsPtr *link_dep_list_starts = memnew_arr(LinkDepsPtr, link_count); // Start nodes of dependent-on-me lists, one for each link
-
-	// Copy the original, unsorted links to a side buffer.
-	Link *link_buffer = memnew_arr(Link, link_count);
-	memcpy(link_buffer, &(links[0]), sizeof(Link) * link_count);
-
-	// Clear out the node setup and ready list.
-	for (i = 0; i < node_count + 1; i++) {
-		node_written_at[i] = reop_not_dependent;
-	}
-	for (i = 0; i < link_count; i++) {
-		link_dep_list_starts[i] = nullptr;
-	}
-	ready_list_head = ready_list_tail = link_dep_frees = 0;
-
-	// Initial link analysis to set up data structures.
-	for (i = 0; i < link_count; i++) {
-		// Note which prior link calculations we are dependent upon & build up dependence lists.
-		lr = &(links[i]);
-		ar = (lr->n[0] - node0) / (node1 - node0);
-		br = (lr->n[1] - node0) / (node1 - node0);
-		if (node_written_at[ar] > reop_not_dependent) {
-			link_dep_A[i] = node_written_at[ar];
-			link_dep = &link_dep_free_list[link_dep_frees++];
-			link_dep->value = i;
-			link_dep->next = link_dep_list_starts[node_written_at[ar]];
-			link_dep_list_starts[node_written_at[ar]] = link_dep;
-		} else {
-			link_dep_A[i] = reop_not_dependent;
-		}
-		if (node_written_at[br] > reop_not_dependent) {
-			link_dep_B[i] = node_written_at[br];
-			link_dep = &link_dep_free_list[link_dep_frees++];
-			link_dep->value = -(int)(i + 1);
-			link_dep->next = link_dep_list_starts[node_written_at[br]];
-			link_dep_list_starts[node_written_at[br]] = link_dep;
-		} else {
-			link_dep_B[i] = reop_not_dependent;
+// Greedy graph coloring: every element gets the first color not used yet by any of its nodes,
+// then the elements are sorted by color. Consecutive elements of a batch share no node.
+template <class T>
+void GodotSoftBody3D::build_batches(LocalVector<T> &r_elements, LocalVector<uint32_t> &r_batches) {
+	const uint32_t element_count = r_elements.size();
+	const uint32_t node_count = nodes.size();
+	const int element_node_count = sizeof(r_elements[0].n) / sizeof(r_elements[0].n[0]);
+
+	LocalVector<uint64_t> node_colors;
+	node_colors.resize(node_count);
+	if (node_count > 0) {
+		memset(node_colors.ptr(), 0, node_count * sizeof(uint64_t));
+	}
+
+	LocalVector<uint32_t> element_colors;
+	element_colors.resize(element_count);
+
+	uint32_t batch_sizes[BATCH_COLOR_MAX + 1] = {};
+	uint32_t batch_count = 0;
+
+	for (uint32_t i = 0; i < element_count; ++i) {
+		const T &element = r_elements[i];
+
+		uint64_t used_colors = 0;
+		for (int j = 0; j < element_node_count; ++j) {
+			used_colors |= node_colors[element.n[j] - nodes.ptr()];
 		}
 
-		// Add this link to the initial ready list, if it is not dependent on any other links.
-		if ((link_dep_A[i] == reop_not_dependent) && (link_dep_B[i] == reop_not_dependent)) {
-			ready_list[ready_list_tail++] = i;
-			link_dep_A[i] = link_dep_B[i] = reop_node_complete; // Probably not needed now.
+		uint32_t color = 0;
+		while (color < BATCH_COLOR_MAX && (used_colors & (uint64_t(1) << color))) {
+			color++;
 		}
 
-		// Update the nodes to mark which ones are calculated by this link.
-		node_written_at[ar] = node_written_at[br] = i;
-	}
-
-	// Process the ready list and create the sorted list of links:
-	// -- By treating the ready list as a queue, we maximize the distance between any
-	//    inter-dependent node calculations.
-	// -- All other (non-related) nodes in the ready list will automatically be inserted
-	//    in between each set of inter-dependent link calculations by this loop.
-	i = 0;
-	while (ready_list_head != ready_list_tail) {
-		// Use ready list to select the next link to process.
-		link_num = ready_list[ready_list_head++];
-		// Copy the next-to-calculate link back into the original link array.
-		links[i++] = link_buffer[link_num];
-
-		// Free up any link inputs that are dependent on this one.
-		link_dep = link_dep_list_starts[link_num];
-		while (link_dep) {
-			dep_link = link_dep->value;
-			if (dep_link >= 0) {
-				link_dep_A[dep_link] = reop_not_dependent;
-			} else {
-				dep_link = -dep_link - 1;
-				link_dep_B[dep_link] = reop_not_dependent;
-			}
-			// Add this dependent link calculation to the ready list if *both* inputs are clear.
-			if ((link_dep_A[dep_link] == reop_not_dependent) && (link_dep_B[dep_link] == reop_not_dependent)) {
-				ready_list[ready_list_tail++] = dep_link;
-				link_dep_A[dep_link] = link_dep_B[dep_link] = reop_node_complete; // Probably not needed now.
+		if (color < BATCH_COLOR_MAX) {
+			for (int j = 0; j < element_node_count; ++j) {
+				node_colors[element.n[j] - nodes.ptr()] |= uint64_t(1) << color;
 			}
-			link_dep = link_dep->next;
 		}
+
+		element_colors[i] = color;
+		batch_sizes[color]++;
+		batch_count = MAX(batch_count, color + 1);
+	}
+
+	r_batches.resize(batch_count + 1);
+	r_batches[0] = 0;
+	for (uint32_t batch = 0; batch < batch_count; ++batch) {
+		r_batches[batch + 1] = r_batches[batch] + batch_sizes[batch];
+	}
+
+	LocalVector<T> sorted_elements;
+	sorted_elements.resize(element_count);
+
+	uint32_t batch_fill[BATCH_COLOR_MAX + 1] = {};
+	for (uint32_t i = 0; i < element_count; ++i) {
+		const uint32_t color = element_colors[i];
+		sorted_elements[r_batches[color] + batch_fill[color]++] = r_elements[i];
 	}
 
-	// Delete the temporary buffers.
-	memdelete_arr(node_written_at);
-	memdelete_arr(link_dep_A);
-	memdelete_arr(link_dep_B);
-	memdelete_arr(ready_list);
-	memdelete_arr(link_dep_free_list);
-	memdelete_arr(link_dep_list_starts);
-	memdelete_arr(link_buffer);
+	r_elements = sorted_elements;
 }
 
 void GodotSoftBody3D::append_link(uint32_t p_node1, uint32_t p_node2) {
@@ -922,48 +899,30 @@ void GodotSoftBody3D::apply_forces(bool p_has_wind_forces) {
 	}
 
 	uint32_t i, ni;
-	int32_t j;
 
-	real_t volume = 0.0;
-	const Vector3 &org = nodes[0].x;
+	FaceForceBatch face_batch;
+	face_batch.origin = nodes[0].x;
+	face_batch.has_wind_forces = ac && p_has_wind_forces;
 
 	// Iterate over faces (try not to iterate elsewhere if possible).
-	for (i = 0, ni = faces.size(); i < ni; ++i) {
-		bool stopped = false;
-		const Face &face = faces[i];
-
-		Vector3 wind_force(0, 0, 0);
-
-		// Compute volume.
-		volume += vec3_dot(face.n[0]->x - org, vec3_cross(face.n[1]->x - org, face.n[2]->x - org));
-
-		// Compute nodal forces from area winds.
-		if (ac && p_has_wind_forces) {
-			const AreaCMP *aa = &areas[0];
-			for (j = ac - 1; j >= 0 && !stopped; j--) {
-				PhysicsServer3D::AreaSpaceOverrideMode mode = aa[j].area->get_space_override_mode();
-				switch (mode) {
-					case PhysicsServer3D::AREA_SPACE_OVERRIDE_COMBINE:
-					case PhysicsServer3D::AREA_SPACE_OVERRIDE_COMBINE_REPLACE: {
-						wind_force += _compute_area_windforce(aa[j].area, &face);
-						stopped = mode == PhysicsServer3D::AREA_SPACE_OVERRIDE_COMBINE_REPLACE;
-					} break;
-					case PhysicsServer3D::AREA_SPACE_OVERRIDE_REPLACE:
-					case PhysicsServer3D::AREA_SPACE_OVERRIDE_REPLACE_COMBINE: {
-						wind_force = _compute_area_windforce(aa[j].area, &face);
-						stopped = mode == PhysicsServer3D::AREA_SPACE_OVERRIDE_REPLACE;
-					} break;
-					default: {
-					}
-				}
-			}
-
-			for (j = 0; j < 3; j++) {
-				Node *current_node = face.n[j];
-				current_node->f += wind_force;
+	face_volumes.resize(faces.size());
+	for (uint32_t batch = 0; batch + 1 < face_batches.size(); ++batch) {
+		face_batch.offset = face_batches[batch];
+		const uint32_t count = face_batches[batch + 1] - face_batch.offset;
+		if (batch == BATCH_COLOR_MAX) {
+			for (i = 0; i < count; ++i) {
+				_apply_face_forces(i, face_batch);
 			}
+		} else {
+			face_work_pool.do_work_batched(count, this, &GodotSoftBody3D::_apply_face_forces, face_batch);
 		}
 	}
+
+	// Summed in face order, so the result doesn't depend on threading.
+	real_t volume = 0.0;
+	for (i = 0, ni = face_volumes.size(); i < ni; ++i) {
+		volume += face_volumes[i];
+	}
 	volume /= 6.0;
 
 	// Apply nodal pressure forces.
@@ -978,6 +937,45 @@ void GodotSoftBody3D::apply_forces(bool p_has_wind_forces) {
 	}
 }
 
+void GodotSoftBody3D::_apply_face_forces(uint32_t p_index, FaceForceBatch p_batch) {
+	const uint32_t face_index = p_batch.offset + p_index;
+	const Face &face = faces[face_index];
+	const Vector3 &org = p_batch.origin;
+
+	// Compute volume.
+	face_volumes[face_index] = vec3_dot(face.n[0]->x - org, vec3_cross(face.n[1]->x - org, face.n[2]->x - org));
+
+	// Compute nodal forces from area winds.
+	if (p_batch.has_wind_forces) {
+		bool stopped = false;
+		Vector3 wind_force(0, 0, 0);
+
+		const AreaCMP *aa = &areas[0];
+		for (int j = areas.size() - 1; j >= 0 && !stopped; j--) {
+			PhysicsServer3D::AreaSpaceOverrideMode mode = aa[j].area->get_space_override_mode();
+			switch (mode) {
+				case PhysicsServer3D::AREA_SPACE_OVERRIDE_COMBINE:
+				case PhysicsServer3D::AREA_SPACE_OVERRIDE_COMBINE_REPLACE: {
+					wind_force += _compute_area_windforce(aa[j].area, &face);
+					stopped = mode == PhysicsServer3D::AREA_SPACE_OVERRIDE_COMBINE_REPLACE;
+				} break;
+				case PhysicsServer3D::AREA_SPACE_OVERRIDE_REPLACE:
+				case PhysicsServer3D::AREA_SPACE_OVERRIDE_REPLACE_COMBINE: {
+					wind_force = _compute_area_windforce(aa[j].area, &face);
+					stopped = mode == PhysicsServer3D::AREA_SPACE_OVERRIDE_REPLACE;
+				} break;
+				default: {
+				}
+			}
+		}
+
+		for (int j = 0; j < 3; j++) {
+			Node *current_node = face.n[j];
+			current_node->f += wind_force;
+		}
+	}
+}
+
 void GodotSoftBody3D::_compute_area_gravity(const GodotArea3D *p_area) {
 	Vector3 area_gravity;
 	p_area->compute_gravity(get_transform().get_origin(), area_gravity);
@@ -1087,53 +1085,75 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 void GodotSoftBody3D::solve_constraints(real_t p_delta) {
 	const real_t inv_delta = 1.0 / p_delta;
 
-	uint32_t i, ni;
-
-	for (i = 0, ni = links.size(); i < ni; ++i) {
-		Link &link = links[i];
-		link.c3 = link.n[1]->q - link.n[0]->q;
-		link.c2 = 1 / (link.c3.length_squared() * link.c0);
-	}
+	link_work_pool.do_work_batched(links.size(), this, &GodotSoftBody3D::_prepare_link, nullptr);
 
 	// Solve velocities.
-	for (i = 0, ni = nodes.size(); i < ni; ++i) {
-		Node &node = nodes[i];
-		node.x = node.q + node.v * p_delta;
-	}
+	node_work_pool.do_work_batched(nodes.size(), this, &GodotSoftBody3D::_predict_node_position, p_delta);
 
 	// Solve positions.
 	for (int isolve = 0; isolve < iteration_count; ++isolve) {
 		const real_t ti = isolve / (real_t)iteration_count;
 		solve_links(1.0, ti);
 	}
-	const real_t vc = (1.0 - damping_coefficient) * inv_delta;
-	for (i = 0, ni = nodes.size(); i < ni; ++i) {
-		Node &node = nodes[i];
 
-		node.x += node.bv * p_delta;
-		node.bv = Vector3();
+	NodeMotion motion;
+	motion.delta = p_delta;
+	motion.velocity_scale = (1.0 - damping_coefficient) * inv_delta;
+	node_work_pool.do_work_batched(nodes.size(), this, &GodotSoftBody3D::_finish_node_motion, motion);
 
-		node.v = (node.x - node.q) * vc;
+	update_normals_and_centroids();
+}
 
-		node.q = node.x;
-	}
+void GodotSoftBody3D::_prepare_link(uint32_t p_index, void *p_userdata) {
+	Link &link = links[p_index];
+	link.c3 = link.n[1]->q - link.n[0]->q;
+	link.c2 = 1 / (link.c3.length_squared() * link.c0);
+}
 
-	update_normals_and_centroids();
+void GodotSoftBody3D::_predict_node_position(uint32_t p_index, real_t p_delta) {
+	Node &node = nodes[p_index];
+	node.x = node.q + node.v * p_delta;
+}
+
+void GodotSoftBody3D::_finish_node_motion(uint32_t p_index, NodeMotion p_motion) {
+	Node &node = nodes[p_index];
+
+	node.x += node.bv * p_motion.delta;
+	node.bv = Vector3();
+
+	node.v = (node.x - node.q) * p_motion.velocity_scale;
+
+	node.q = node.x;
 }
 
 void GodotSoftBody3D::solve_links(real_t kst, real_t ti) {
-	for (uint32_t i = 0, ni = links.size(); i < ni; ++i) {
-		Link &link = links[i];
-		if (link.c0 > 0) {
-			Node &node_a = *link.n[0];
-			Node &node_b = *link.n[1];
-			const Vector3 del = node_b.x - node_a.x;
-			const real_t len = del.length_squared();
-			if (link.c1 + len > CMP_EPSILON) {
-				const real_t k = ((link.c1 - len) / (link.c0 * (link.c1 + len))) * kst;
-				node_a.x -= del * (k * node_a.im);
-				node_b.x += del * (k * node_b.im);
+	LinkBatch link_batch;
+	link_batch.kst = kst;
+
+	for (uint32_t batch = 0; batch + 1 < link_batches.size(); ++batch) {
+		link_batch.offset = link_batches[batch];
+		const uint32_t count = link_batches[batch + 1] - link_batch.offset;
+		if (batch == BATCH_COLOR_MAX) {
+			for (uint32_t i = 0; i < count; ++i) {
+				_solve_link(i, link_batch);
 			}
+		} else {
+			link_work_pool.do_work_batched(count, this, &GodotSoftBody3D::_solve_link, link_batch);
+		}
+	}
+}
+
+void GodotSoftBody3D::_solve_link(uint32_t p_index, LinkBatch p_batch) {
+	Link &link = links[p_batch.offset + p_index];
+	if (link.c0 > 0) {
+		Node &node_a = *link.n[0];
+		Node &node_b = *link.n[1];
+		const Vector3 del = node_b.x - node_a.x;
+		const real_t len = del.length_squared();
+		if (link.c1 + len > CMP_EPSILON) {
+			const real_t k = ((link.c1 - len) / (link.c0 * (link.c1 + len))) * p_batch.kst;
+			node_a.x -= del * (k * node_a.im);
+			node_b.x += del * (k * node_b.im);
 		}
 	}
 }
@@ -1251,6 +1271,9 @@ void GodotSoftBody3D::destroy() {
 	links.clear();
 	faces.clear();
 
+	link_batches.clear();
+	face_batches.clear();
+
 	bounds = AABB();
 	deinitialize_shape();
 }
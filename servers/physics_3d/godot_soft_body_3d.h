@@ -39,6 +39,7 @@
 #include "core/math/vector3.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/set.h"
+#include "core/templates/thread_work_pool.h"
 #include "core/templates/vset.h"
 
 class GodotConstraint3D;
@@ -82,6 +83,42 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 	LocalVector<Link> links;
 	LocalVector<Face> faces;
 
+	// Links and faces are sorted into batches (graph colors) that never share a node,
+	// so the elements of a batch can be solved in parallel. These are the offsets of
+	// each batch in links/faces, followed by the total count.
+	// Elements that didn't fit in any color go in a last batch, which is solved serially.
+	enum {
+		BATCH_COLOR_MAX = 64,
+	};
+	LocalVector<uint32_t> link_batches;
+	LocalVector<uint32_t> face_batches;
+
+	struct LinkBatch {
+		uint32_t offset = 0;
+		real_t kst = 1.0;
+	};
+
+	struct FaceForceBatch {
+		uint32_t offset = 0;
+		Vector3 origin;
+		bool has_wind_forces = false;
+	};
+
+	struct NodeMotion {
+		real_t delta = 0.0;
+		real_t velocity_scale = 0.0;
+	};
+
+	LocalVector<real_t> face_volumes;
+
+	LocalVector<Vector3> render_vertices;
+	LocalVector<Vector3> render_normals;
+
+	// Separate pools because each one estimates the cost of its own kind of work.
+	ThreadWorkPool link_work_pool;
+	ThreadWorkPool face_work_pool;
+	ThreadWorkPool node_work_pool;
+
 	DynamicBVH node_tree;
 	DynamicBVH face_tree;
 
@@ -124,10 +161,10 @@ public:
 	void set_state(PhysicsServer3D::BodyState p_state, const Variant &p_variant);
 	Variant get_state(PhysicsServer3D::BodyState p_state) const;
 
-	_FORCE_INLINE_ void add_constraint(GodotConstraint3D *p_constraint) { constraints.insert(p_constraint); }
-	_FORCE_INLINE_ void remove_constraint(GodotConstraint3D *p_constraint) { constraints.erase(p_constraint); }
+	void add_constraint(GodotConstraint3D *p_constraint);
+	void remove_constraint(GodotConstraint3D *p_constraint);
 	_FORCE_INLINE_ const Set<GodotConstraint3D *> &get_constraints() const { return constraints; }
-	_FORCE_INLINE_ void clear_constraints() { constraints.clear(); }
+	void clear_constraints();
 
 	_FORCE_INLINE_ void add_exception(const RID &p_exception) { exceptions.insert(p_exception); }
 	_FORCE_INLINE_ void remove_exception(const RID &p_exception) { exceptions.erase(p_exception); }
@@ -236,12 +273,22 @@ private:
 
 	bool create_from_trimesh(const Vector<int> &p_indices, const Vector<Vector3> &p_vertices);
 	void generate_bending_constraints(int p_distance);
-	void reoptimize_link_order();
+	template <class T>
+	void build_batches(LocalVector<T> &r_elements, LocalVector<uint32_t> &r_batches);
 	void append_link(uint32_t p_node1, uint32_t p_node2);
 	void append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p_node3);
 
 	void solve_links(real_t kst, real_t ti);
 
+	void _prepare_link(uint32_t p_index, void *p_userdata);
+	void _solve_link(uint32_t p_index, LinkBatch p_batch);
+	void _update_face_normal(uint32_t p_index, uint32_t p_offset);
+	void _apply_face_forces(uint32_t p_index, FaceForceBatch p_batch);
+	void _reset_node_normal(uint32_t p_index, void *p_userdata);
+	void _normalize_node_normal(uint32_t p_index, void *p_userdata);
+	void _predict_node_position(uint32_t p_index, real_t p_delta);
+	void _finish_node_motion(uint32_t p_index, NodeMotion p_motion);
+
 	void initialize_face_tree();
 	void update_face_tree(real_t p_delta);
 
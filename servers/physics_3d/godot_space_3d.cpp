@@ -34,6 +34,7 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/os/os.h"
 
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
 
@@ -104,17 +105,14 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const Vector3 &p_point, Shap
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_ray) {
-	ERR_FAIL_COND_V(space->locked, false);
-
+// Finds the closest hit of the segment among the broadphase cull results.
+static bool _intersect_ray_culled(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D *const *p_cull_results, const int *p_cull_subindices, int p_cull_count, PhysicsDirectSpaceState3D::RayResult &r_result, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_ray) {
 	Vector3 begin, end;
 	Vector3 normal;
 	begin = p_from;
 	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
 	bool collided = false;
@@ -123,22 +121,22 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const Vector3 &p_from, const
 	const GodotCollisionObject3D *res_obj;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
+	for (int i = 0; i < p_cull_count; i++) {
+		if (!_can_collide_with(p_cull_results[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
 			continue;
 		}
 
-		if (p_pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_pick_ray && !(p_cull_results[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_exclude.has(p_cull_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = p_cull_results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_cull_subindices[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -183,6 +181,113 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const Vector3 &p_from, const
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_ray) {
+	ERR_FAIL_COND_V(space->locked, false);
+
+	int amount = space->broadphase->cull_segment(p_from, p_to, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	return _intersect_ray_culled(p_from, p_to, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_result, p_exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas, p_pick_ray);
+}
+
+// Below this amount of rays, a batch is just run as separate queries.
+#define INTERSECT_RAYS_MIN_BATCH 32
+
+struct GodotPhysicsDirectSpaceState3D::RayBatch {
+	const Vector3 *from = nullptr;
+	const Vector3 *to = nullptr;
+	RayResult *results = nullptr;
+	bool *collided = nullptr;
+	const uint32_t *order = nullptr;
+	const Set<RID> *exclude = nullptr;
+	uint32_t collision_mask = 0;
+	bool collide_with_bodies = true;
+	bool collide_with_areas = false;
+};
+
+// Spreads the lower 10 bits of p_value so there are two zero bits between every bit.
+static _FORCE_INLINE_ uint32_t _morton_spread_bits(uint32_t p_value) {
+	p_value &= 0x3FF;
+	p_value = (p_value | (p_value << 16)) & 0x030000FF;
+	p_value = (p_value | (p_value << 8)) & 0x0300F00F;
+	p_value = (p_value | (p_value << 4)) & 0x030C30C3;
+	p_value = (p_value | (p_value << 2)) & 0x09249249;
+	return p_value;
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_ray_batch_item(uint32_t p_index, RayBatch *p_batch) {
+	// The thread pool runs one item at a time per thread, and the calling thread (index -1) takes the first slot.
+	RayScratch &scratch = ray_scratch[WorkerThreadPool::get_thread_index() + 1];
+
+	uint32_t ray = p_batch->order[p_index];
+	const Vector3 &from = p_batch->from[ray];
+	const Vector3 &to = p_batch->to[ray];
+
+	int amount = space->broadphase->cull_segment_concurrent(from, to, scratch.cull_results.ptr(), GodotSpace3D::INTERSECTION_QUERY_MAX, scratch.cull_hits, scratch.cull_subindices.ptr());
+	p_batch->collided[ray] = _intersect_ray_culled(from, to, scratch.cull_results.ptr(), scratch.cull_subindices.ptr(), amount, p_batch->results[ray], *p_batch->exclude, p_batch->collision_mask, p_batch->collide_with_bodies, p_batch->collide_with_areas, false);
+}
+
+int GodotPhysicsDirectSpaceState3D::intersect_rays(const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool *r_collided, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+	ERR_FAIL_COND_V(space->locked, 0);
+	ERR_FAIL_COND_V(p_ray_count < 0, 0);
+
+	if (p_ray_count < INTERSECT_RAYS_MIN_BATCH) {
+		return PhysicsDirectSpaceState3D::intersect_rays(p_from, p_to, p_ray_count, r_results, r_collided, p_exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
+	}
+
+	// Sort the rays along a Z-order curve of their origins, so consecutive rays (and thus each thread) walk mostly the same BVH nodes.
+	AABB bounds(p_from[0], Vector3());
+	for (int i = 1; i < p_ray_count; i++) {
+		bounds.expand_to(p_from[i]);
+	}
+	Vector3 scale;
+	for (int i = 0; i < 3; i++) {
+		scale[i] = bounds.size[i] > CMP_EPSILON ? 1023.0 / bounds.size[i] : 0.0;
+	}
+
+	ray_order_keys.resize(p_ray_count);
+	for (int i = 0; i < p_ray_count; i++) {
+		Vector3 cell = (p_from[i] - bounds.position) * scale;
+		uint32_t code = _morton_spread_bits(uint32_t(cell.x)) | (_morton_spread_bits(uint32_t(cell.y)) << 1) | (_morton_spread_bits(uint32_t(cell.z)) << 2);
+		ray_order_keys[i] = (uint64_t(code) << 32) | uint32_t(i);
+	}
+	ray_order_keys.sort();
+
+	ray_order.resize(p_ray_count);
+	for (int i = 0; i < p_ray_count; i++) {
+		ray_order[i] = uint32_t(ray_order_keys[i]);
+	}
+
+	if (ray_scratch.is_empty()) {
+		WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+		ray_scratch.resize((pool ? pool->get_thread_count() : 0) + 1);
+		for (uint32_t i = 0; i < ray_scratch.size(); i++) {
+			ray_scratch[i].cull_results.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+			ray_scratch[i].cull_subindices.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+		}
+	}
+
+	RayBatch batch;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	batch.collided = r_collided;
+	batch.order = ray_order.ptr();
+	batch.exclude = &p_exclude;
+	batch.collision_mask = p_collision_mask;
+	batch.collide_with_bodies = p_collide_with_bodies;
+	batch.collide_with_areas = p_collide_with_areas;
+
+	ray_work_pool.do_work_batched(p_ray_count, this, &GodotPhysicsDirectSpaceState3D::_intersect_ray_batch_item, &batch);
+
+	int hit_count = 0;
+	for (int i = 0; i < p_ray_count; i++) {
+		if (r_collided[i]) {
+			hit_count++;
+		}
+	}
+	return hit_count;
+}
+
 int GodotPhysicsDirectSpaceState3D::intersect_shape(const RID &p_shape, const Transform3D &p_xform, real_t p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 	if (p_result_max <= 0) {
 		return 0;
@@ -585,32 +690,38 @@ Vector3 GodotPhysicsDirectSpaceState3D::get_closest_point_to_object_volume(RID p
 
 GodotPhysicsDirectSpaceState3D::GodotPhysicsDirectSpaceState3D() {
 	space = nullptr;
+	ray_work_pool.init();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-int GodotSpace3D::_cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb) {
-	int amount = broadphase->cull_aabb(p_aabb, intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
+int GodotSpace3D::_cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb, GodotCollisionObject3D **r_results, int *r_subindices, GodotBroadPhase3D::CullScratch *r_hits) {
+	int amount;
+	if (r_hits) {
+		amount = broadphase->cull_aabb_concurrent(p_aabb, r_results, INTERSECTION_QUERY_MAX, *r_hits, r_subindices);
+	} else {
+		amount = broadphase->cull_aabb(p_aabb, r_results, INTERSECTION_QUERY_MAX, r_subindices);
+	}
 
 	for (int i = 0; i < amount; i++) {
 		bool keep = true;
 
-		if (intersection_query_results[i] == p_body) {
+		if (r_results[i] == p_body) {
 			keep = false;
-		} else if (intersection_query_results[i]->get_type() == GodotCollisionObject3D::TYPE_AREA) {
+		} else if (r_results[i]->get_type() == GodotCollisionObject3D::TYPE_AREA) {
 			keep = false;
-		} else if (intersection_query_results[i]->get_type() == GodotCollisionObject3D::TYPE_SOFT_BODY) {
+		} else if (r_results[i]->get_type() == GodotCollisionObject3D::TYPE_SOFT_BODY) {
 			keep = false;
-		} else if (!p_body->collides_with(static_cast<GodotBody3D *>(intersection_query_results[i]))) {
+		} else if (!p_body->collides_with(static_cast<GodotBody3D *>(r_results[i]))) {
 			keep = false;
-		} else if (static_cast<GodotBody3D *>(intersection_query_results[i])->has_exception(p_body->get_self()) || p_body->has_exception(intersection_query_results[i]->get_self())) {
+		} else if (static_cast<GodotBody3D *>(r_results[i])->has_exception(p_body->get_self()) || p_body->has_exception(r_results[i]->get_self())) {
 			keep = false;
 		}
 
 		if (!keep) {
 			if (i < amount - 1) {
-				SWAP(intersection_query_results[i], intersection_query_results[amount - 1]);
-				SWAP(intersection_query_subindex_results[i], intersection_query_subindex_results[amount - 1]);
+				SWAP(r_results[i], r_results[amount - 1]);
+				SWAP(r_subindices[i], r_subindices[amount - 1]);
 			}
 
 			amount--;
@@ -621,7 +732,7 @@ int GodotSpace3D::_cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb) {
 	return amount;
 }
 
-bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result) {
+bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result, MotionScratch *p_scratch) {
 	//give me back regular physics engine logic
 	//this is madness
 	//and most people using this function will think
@@ -635,6 +746,10 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 		*r_result = PhysicsServer3D::MotionResult();
 	}
 
+	GodotCollisionObject3D **query_results = p_scratch ? p_scratch->cull_results.ptr() : intersection_query_results;
+	int *query_subindices = p_scratch ? p_scratch->cull_subindices.ptr() : intersection_query_subindex_results;
+	GodotBroadPhase3D::CullScratch *query_hits = p_scratch ? &p_scratch->cull_hits : nullptr;
+
 	AABB body_aabb;
 	bool shapes_found = false;
 
@@ -690,7 +805,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 
 			bool collided = false;
 
-			int amount = _cull_aabb_for_body(p_body, body_aabb);
+			int amount = _cull_aabb_for_body(p_body, body_aabb, query_results, query_subindices, query_hits);
 
 			for (int j = 0; j < p_body->get_shape_count(); j++) {
 				if (p_body->is_shape_disabled(j)) {
@@ -701,7 +816,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 				GodotShape3D *body_shape = p_body->get_shape(j);
 
 				for (int i = 0; i < amount; i++) {
-					const GodotCollisionObject3D *col_obj = intersection_query_results[i];
+					const GodotCollisionObject3D *col_obj = query_results[i];
 					if (p_parameters.exclude_bodies.has(col_obj->get_self())) {
 						continue;
 					}
@@ -709,7 +824,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 						continue;
 					}
 
-					int shape_idx = intersection_query_subindex_results[i];
+					int shape_idx = query_subindices[i];
 
 					if (GodotCollisionSolver3D::solve_static(body_shape, body_shape_xform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), cbkres, cbkptr, nullptr, p_parameters.margin)) {
 						collided = cbk.amount > 0;
@@ -764,7 +879,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 		motion_aabb.position += p_parameters.motion;
 		motion_aabb = motion_aabb.merge(body_aabb);
 
-		int amount = _cull_aabb_for_body(p_body, motion_aabb);
+		int amount = _cull_aabb_for_body(p_body, motion_aabb, query_results, query_subindices, query_hits);
 
 		for (int j = 0; j < p_body->get_shape_count(); j++) {
 			if (p_body->is_shape_disabled(j)) {
@@ -795,7 +910,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 			real_t best_unsafe = 1;
 
 			for (int i = 0; i < amount; i++) {
-				const GodotCollisionObject3D *col_obj = intersection_query_results[i];
+				const GodotCollisionObject3D *col_obj = query_results[i];
 				if (p_parameters.exclude_bodies.has(col_obj->get_self())) {
 					continue;
 				}
@@ -803,7 +918,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 					continue;
 				}
 
-				int shape_idx = intersection_query_subindex_results[i];
+				int shape_idx = query_subindices[i];
 
 				//test initial overlap, does it collide if going all the way?
 				Vector3 point_A, point_B;
@@ -916,10 +1031,10 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 
 			body_aabb.position += p_parameters.motion * unsafe;
 
-			int amount = _cull_aabb_for_body(p_body, body_aabb);
+			int amount = _cull_aabb_for_body(p_body, body_aabb, query_results, query_subindices, query_hits);
 
 			for (int i = 0; i < amount; i++) {
-				const GodotCollisionObject3D *col_obj = intersection_query_results[i];
+				const GodotCollisionObject3D *col_obj = query_results[i];
 				if (p_parameters.exclude_bodies.has(col_obj->get_self())) {
 					continue;
 				}
@@ -927,7 +1042,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 					continue;
 				}
 
-				int shape_idx = intersection_query_subindex_results[i];
+				int shape_idx = query_subindices[i];
 
 				rcd.object = col_obj;
 				rcd.shape = shape_idx;
@@ -1001,6 +1116,7 @@ void *GodotSpace3D::_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A
 	GodotSpace3D *self = (GodotSpace3D *)p_self;
 
 	self->collision_pairs++;
+	self->pairs_created++;
 
 	if (type_A == GodotCollisionObject3D::TYPE_AREA) {
 		GodotArea3D *area = static_cast<GodotArea3D *>(A);
@@ -1049,10 +1165,13 @@ const SelfList<GodotBody3D>::List &GodotSpace3D::get_active_body_list() const {
 
 void GodotSpace3D::body_add_to_active_list(SelfList<GodotBody3D> *p_body) {
 	active_list.add(p_body);
+	bodies_woken++;
+	invalidate_islands();
 }
 
 void GodotSpace3D::body_remove_from_active_list(SelfList<GodotBody3D> *p_body) {
 	active_list.remove(p_body);
+	invalidate_islands();
 }
 
 void GodotSpace3D::body_add_to_mass_properties_update_list(SelfList<GodotBody3D> *p_body) {
@@ -1070,11 +1189,13 @@ GodotBroadPhase3D *GodotSpace3D::get_broadphase() {
 void GodotSpace3D::add_object(GodotCollisionObject3D *p_object) {
 	ERR_FAIL_COND(objects.has(p_object));
 	objects.insert(p_object);
+	invalidate_islands();
 }
 
 void GodotSpace3D::remove_object(GodotCollisionObject3D *p_object) {
 	ERR_FAIL_COND(!objects.has(p_object));
 	objects.erase(p_object);
+	invalidate_islands();
 }
 
 const Set<GodotCollisionObject3D *> &GodotSpace3D::get_objects() const {
@@ -1115,10 +1236,20 @@ const SelfList<GodotSoftBody3D>::List &GodotSpace3D::get_active_soft_body_list()
 
 void GodotSpace3D::soft_body_add_to_active_list(SelfList<GodotSoftBody3D> *p_soft_body) {
 	active_soft_body_list.add(p_soft_body);
+	invalidate_islands();
 }
 
 void GodotSpace3D::soft_body_remove_from_active_list(SelfList<GodotSoftBody3D> *p_soft_body) {
 	active_soft_body_list.remove(p_soft_body);
+	invalidate_islands();
+}
+
+void GodotSpace3D::body_pair_add_to_snapshot_list(SelfList<GodotBodyPair3D> *p_pair) {
+	body_pair_snapshot_list.add(p_pair);
+}
+
+void GodotSpace3D::body_pair_remove_from_snapshot_list(SelfList<GodotBodyPair3D> *p_pair) {
+	body_pair_snapshot_list.remove(p_pair);
 }
 
 void GodotSpace3D::call_queries() {
@@ -1128,11 +1259,15 @@ void GodotSpace3D::call_queries() {
 		b->call_queries();
 	}
 
+	uint64_t area_time_beg = OS::get_singleton()->get_ticks_usec();
+
 	while (monitor_query_list.first()) {
 		GodotArea3D *a = monitor_query_list.first()->self();
 		monitor_query_list.remove(monitor_query_list.first());
 		a->call_queries();
 	}
+
+	elapsed_time[ELAPSED_TIME_AREA_CALLBACKS] = OS::get_singleton()->get_ticks_usec() - area_time_beg;
 }
 
 void GodotSpace3D::setup() {
@@ -1147,6 +1282,13 @@ void GodotSpace3D::update() {
 	broadphase->update();
 }
 
+void GodotSpace3D::finish_step_counters() {
+	last_step_bodies_woken = bodies_woken;
+	last_step_pairs_created = pairs_created;
+	bodies_woken = 0;
+	pairs_created = 0;
+}
+
 void GodotSpace3D::set_param(PhysicsServer3D::SpaceParameter p_param, real_t p_value) {
 	switch (p_param) {
 		case PhysicsServer3D::SPACE_PARAM_CONTACT_RECYCLE_RADIUS:
@@ -1210,6 +1352,285 @@ bool GodotSpace3D::is_locked() const {
 	return locked;
 }
 
+/* STATE SNAPSHOTS */
+
+// Snapshots are raw native values, meant to be restored by the same build (real_t size is checked).
+// Bodies and body pairs are identified by RID, objects missing from either side are left alone.
+
+enum {
+	SNAPSHOT_MAGIC = 0x33535047, // "GPS3"
+	SNAPSHOT_FORMAT = 1,
+	SNAPSHOT_HEADER_SIZE = 5 * sizeof(uint32_t),
+	SNAPSHOT_BODY_SIZE = sizeof(uint64_t) + sizeof(Transform3D) + 4 * sizeof(Vector3) + sizeof(real_t) + 1,
+	SNAPSHOT_PAIR_SIZE = 2 * (sizeof(uint64_t) + sizeof(uint32_t)) + sizeof(Vector3) + 2,
+	SNAPSHOT_CONTACT_SIZE = 5 * sizeof(Vector3) + 2 * sizeof(uint32_t) + 4 * sizeof(real_t) + 1,
+};
+
+template <class T>
+static _FORCE_INLINE_ void _snapshot_write(uint8_t *&w, const T &p_value) {
+	memcpy(w, &p_value, sizeof(T));
+	w += sizeof(T);
+}
+
+template <class T>
+static _FORCE_INLINE_ void _snapshot_read(const uint8_t *&r, T &r_value) {
+	memcpy(&r_value, r, sizeof(T));
+	r += sizeof(T);
+}
+
+struct BodyPairSnapshotKey {
+	uint64_t body_A = 0;
+	uint64_t body_B = 0;
+	uint32_t shape_A = 0;
+	uint32_t shape_B = 0;
+
+	static _FORCE_INLINE_ uint32_t hash(const BodyPairSnapshotKey &p_key) {
+		uint32_t h = hash_one_uint64(p_key.body_A);
+		h = hash_djb2_one_32(hash_one_uint64(p_key.body_B), h);
+		h = hash_djb2_one_32(p_key.shape_A, h);
+		return hash_djb2_one_32(p_key.shape_B, h);
+	}
+
+	_FORCE_INLINE_ bool operator==(const BodyPairSnapshotKey &p_key) const {
+		return body_A == p_key.body_A && body_B == p_key.body_B && shape_A == p_key.shape_A && shape_B == p_key.shape_B;
+	}
+};
+
+void GodotSpace3D::save_state(Vector<uint8_t> &r_state) const {
+	uint32_t body_count = 0;
+	for (const Set<GodotCollisionObject3D *>::Element *E = objects.front(); E; E = E->next()) {
+		if (E->get()->get_type() == GodotCollisionObject3D::TYPE_BODY && static_cast<const GodotBody3D *>(E->get())->get_mode() != PhysicsServer3D::BODY_MODE_STATIC) {
+			body_count++;
+		}
+	}
+
+	// Pairs without contacts restore to the same state as pairs missing from the snapshot, so they are skipped.
+	uint32_t pair_count = 0;
+	uint32_t contact_count = 0;
+	GodotBodyPair3D::SnapshotState pair_state;
+	for (const SelfList<GodotBodyPair3D> *P = body_pair_snapshot_list.first(); P; P = P->next()) {
+		P->self()->get_snapshot_state(pair_state);
+		if (pair_state.collided || pair_state.contact_count > 0) {
+			pair_count++;
+			contact_count += pair_state.contact_count;
+		}
+	}
+
+	r_state.resize(SNAPSHOT_HEADER_SIZE + body_count * SNAPSHOT_BODY_SIZE + pair_count * SNAPSHOT_PAIR_SIZE + contact_count * SNAPSHOT_CONTACT_SIZE);
+	uint8_t *w = r_state.ptrw();
+
+	_snapshot_write(w, uint32_t(SNAPSHOT_MAGIC));
+	_snapshot_write(w, uint32_t(SNAPSHOT_FORMAT));
+	_snapshot_write(w, uint32_t(sizeof(real_t)));
+	_snapshot_write(w, body_count);
+	_snapshot_write(w, pair_count);
+
+	GodotBody3D::SnapshotState body_state;
+	for (const Set<GodotCollisionObject3D *>::Element *E = objects.front(); E; E = E->next()) {
+		if (E->get()->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			continue;
+		}
+		const GodotBody3D *body = static_cast<const GodotBody3D *>(E->get());
+		if (body->get_mode() == PhysicsServer3D::BODY_MODE_STATIC) {
+			continue;
+		}
+
+		body->get_snapshot_state(body_state);
+		_snapshot_write(w, body->get_self().get_id());
+		_snapshot_write(w, body_state.transform);
+		_snapshot_write(w, body_state.linear_velocity);
+		_snapshot_write(w, body_state.angular_velocity);
+		_snapshot_write(w, body_state.applied_force);
+		_snapshot_write(w, body_state.applied_torque);
+		_snapshot_write(w, body_state.still_time);
+		_snapshot_write(w, uint8_t(body_state.active));
+	}
+
+	for (const SelfList<GodotBodyPair3D> *P = body_pair_snapshot_list.first(); P; P = P->next()) {
+		const GodotBodyPair3D *pair = P->self();
+		pair->get_snapshot_state(pair_state);
+		if (!pair_state.collided && pair_state.contact_count == 0) {
+			continue;
+		}
+
+		_snapshot_write(w, pair->get_body_A()->get_self().get_id());
+		_snapshot_write(w, uint32_t(pair->get_shape_A()));
+		_snapshot_write(w, pair->get_body_B()->get_self().get_id());
+		_snapshot_write(w, uint32_t(pair->get_shape_B()));
+		_snapshot_write(w, pair_state.sep_axis);
+		_snapshot_write(w, uint8_t(pair_state.collided));
+		_snapshot_write(w, uint8_t(pair_state.contact_count));
+
+		for (int i = 0; i < pair_state.contact_count; i++) {
+			const GodotBodyPair3D::SnapshotContact &c = pair_state.contacts[i];
+			_snapshot_write(w, c.position);
+			_snapshot_write(w, c.normal);
+			_snapshot_write(w, c.local_A);
+			_snapshot_write(w, c.local_B);
+			_snapshot_write(w, uint32_t(c.index_A));
+			_snapshot_write(w, uint32_t(c.index_B));
+			_snapshot_write(w, c.acc_normal_impulse);
+			_snapshot_write(w, c.acc_tangent_impulse);
+			_snapshot_write(w, c.acc_bias_impulse);
+			_snapshot_write(w, c.acc_bias_impulse_center_of_mass);
+			_snapshot_write(w, c.depth);
+			_snapshot_write(w, uint8_t(c.active));
+		}
+	}
+}
+
+bool GodotSpace3D::restore_state(const Vector<uint8_t> &p_state) {
+	ERR_FAIL_COND_V_MSG(locked, false, "Can't restore a space state while the space is being stepped.");
+
+	const uint32_t size = p_state.size();
+	ERR_FAIL_COND_V_MSG(size < SNAPSHOT_HEADER_SIZE, false, "Invalid physics space state.");
+
+	const uint8_t *r = p_state.ptr();
+	uint32_t magic, format, real_size, body_count, pair_count;
+	_snapshot_read(r, magic);
+	_snapshot_read(r, format);
+	_snapshot_read(r, real_size);
+	_snapshot_read(r, body_count);
+	_snapshot_read(r, pair_count);
+	ERR_FAIL_COND_V_MSG(magic != SNAPSHOT_MAGIC || format != SNAPSHOT_FORMAT, false, "Invalid physics space state.");
+	ERR_FAIL_COND_V_MSG(real_size != sizeof(real_t), false, "Physics space state was saved by a build with a different floating-point precision.");
+
+	// Validate the whole buffer before applying anything, so a bad state can't be half restored.
+	const uint32_t max_contacts = sizeof(GodotBodyPair3D::SnapshotState::contacts) / sizeof(GodotBodyPair3D::SnapshotContact);
+	uint64_t offset = SNAPSHOT_HEADER_SIZE + uint64_t(body_count) * SNAPSHOT_BODY_SIZE;
+	for (uint32_t i = 0; i < pair_count; i++) {
+		ERR_FAIL_COND_V_MSG(offset + SNAPSHOT_PAIR_SIZE > size, false, "Invalid physics space state.");
+		const uint8_t pair_contact_count = p_state[offset + SNAPSHOT_PAIR_SIZE - 1];
+		ERR_FAIL_COND_V_MSG(pair_contact_count > max_contacts, false, "Invalid physics space state.");
+		offset += SNAPSHOT_PAIR_SIZE + pair_contact_count * SNAPSHOT_CONTACT_SIZE;
+	}
+	ERR_FAIL_COND_V_MSG(offset != size, false, "Invalid physics space state.");
+
+	HashMap<uint64_t, GodotBody3D *> bodies;
+	for (Set<GodotCollisionObject3D *>::Element *E = objects.front(); E; E = E->next()) {
+		if (E->get()->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+			GodotBody3D *body = static_cast<GodotBody3D *>(E->get());
+			if (body->get_mode() != PhysicsServer3D::BODY_MODE_STATIC) {
+				bodies.set(body->get_self().get_id(), body);
+			}
+		}
+	}
+
+	GodotBody3D::SnapshotState body_state;
+	for (uint32_t i = 0; i < body_count; i++) {
+		uint64_t id;
+		uint8_t active;
+		_snapshot_read(r, id);
+		_snapshot_read(r, body_state.transform);
+		_snapshot_read(r, body_state.linear_velocity);
+		_snapshot_read(r, body_state.angular_velocity);
+		_snapshot_read(r, body_state.applied_force);
+		_snapshot_read(r, body_state.applied_torque);
+		_snapshot_read(r, body_state.still_time);
+		_snapshot_read(r, active);
+		body_state.active = active;
+
+		GodotBody3D **body = bodies.getptr(id);
+		if (body) {
+			(*body)->set_snapshot_state(body_state);
+		}
+	}
+
+	// Pairs not in the snapshot had no contacts when it was saved.
+	HashMap<BodyPairSnapshotKey, GodotBodyPair3D *, BodyPairSnapshotKey> pairs;
+	for (SelfList<GodotBodyPair3D> *P = body_pair_snapshot_list.first(); P; P = P->next()) {
+		GodotBodyPair3D *pair = P->self();
+		pair->clear_contacts();
+
+		BodyPairSnapshotKey key;
+		key.body_A = pair->get_body_A()->get_self().get_id();
+		key.body_B = pair->get_body_B()->get_self().get_id();
+		key.shape_A = pair->get_shape_A();
+		key.shape_B = pair->get_shape_B();
+		pairs.set(key, pair);
+	}
+
+	GodotBodyPair3D::SnapshotState pair_state;
+	for (uint32_t i = 0; i < pair_count; i++) {
+		BodyPairSnapshotKey key;
+		uint8_t collided, pair_contact_count;
+		_snapshot_read(r, key.body_A);
+		_snapshot_read(r, key.shape_A);
+		_snapshot_read(r, key.body_B);
+		_snapshot_read(r, key.shape_B);
+		_snapshot_read(r, pair_state.sep_axis);
+		_snapshot_read(r, collided);
+		_snapshot_read(r, pair_contact_count);
+		pair_state.collided = collided;
+		pair_state.contact_count = pair_contact_count;
+
+		for (int j = 0; j < pair_state.contact_count; j++) {
+			GodotBodyPair3D::SnapshotContact &c = pair_state.contacts[j];
+			uint32_t index_A, index_B;
+			uint8_t contact_active;
+			_snapshot_read(r, c.position);
+			_snapshot_read(r, c.normal);
+			_snapshot_read(r, c.local_A);
+			_snapshot_read(r, c.local_B);
+			_snapshot_read(r, index_A);
+			_snapshot_read(r, index_B);
+			_snapshot_read(r, c.acc_normal_impulse);
+			_snapshot_read(r, c.acc_tangent_impulse);
+			_snapshot_read(r, c.acc_bias_impulse);
+			_snapshot_read(r, c.acc_bias_impulse_center_of_mass);
+			_snapshot_read(r, c.depth);
+			_snapshot_read(r, contact_active);
+			c.index_A = index_A;
+			c.index_B = index_B;
+			c.active = contact_active;
+		}
+
+		GodotBodyPair3D **pair = pairs.getptr(key);
+		if (pair) {
+			(*pair)->set_snapshot_state(pair_state);
+		}
+	}
+
+	return true;
+}
+
+void GodotSpace3D::set_state_history_size(int p_size) {
+	ERR_FAIL_COND(p_size < 0);
+	state_history.clear();
+	state_history.resize(p_size);
+	state_history_first = 0;
+	state_history_count = 0;
+}
+
+void GodotSpace3D::push_state() {
+	ERR_FAIL_COND_MSG(state_history.is_empty(), "The space state history is disabled, set its size first.");
+
+	uint32_t index;
+	if (state_history_count == state_history.size()) {
+		// Full, overwrite the oldest one. Its buffer is reused as is when the size doesn't change.
+		index = state_history_first;
+		state_history_first = (state_history_first + 1) % state_history.size();
+	} else {
+		index = (state_history_first + state_history_count) % state_history.size();
+		state_history_count++;
+	}
+
+	save_state(state_history[index]);
+}
+
+bool GodotSpace3D::rollback_state(int p_steps_back) {
+	ERR_FAIL_INDEX_V(p_steps_back, (int)state_history_count, false);
+
+	const uint32_t index = (state_history_first + state_history_count - 1 - p_steps_back) % state_history.size();
+	if (!restore_state(state_history[index])) {
+		return false;
+	}
+
+	// The restored state becomes the latest one, newer ones are going to be simulated again.
+	state_history_count -= p_steps_back;
+	return true;
+}
+
 GodotPhysicsDirectSpaceState3D *GodotSpace3D::get_direct_state() {
 	return direct_access;
 }
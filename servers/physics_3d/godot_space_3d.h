@@ -41,16 +41,35 @@
 
 #include "core/config/project_settings.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/thread_work_pool.h"
 #include "core/typedefs.h"
 
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	struct RayBatch;
+
+	// Broadphase results of one thread running intersect_rays().
+	struct RayScratch {
+		LocalVector<GodotCollisionObject3D *> cull_results;
+		LocalVector<int> cull_subindices;
+		GodotBroadPhase3D::CullScratch cull_hits;
+	};
+
+	ThreadWorkPool ray_work_pool;
+	LocalVector<RayScratch> ray_scratch;
+	LocalVector<uint64_t> ray_order_keys;
+	LocalVector<uint32_t> ray_order;
+
+	void _intersect_ray_batch_item(uint32_t p_index, RayBatch *p_batch);
+
 public:
 	GodotSpace3D *space;
 
 	virtual int intersect_point(const Vector3 &p_point, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = UINT32_MAX, bool p_collide_with_bodies = true, bool p_collide_with_areas = false) override;
 	virtual bool intersect_ray(const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = UINT32_MAX, bool p_collide_with_bodies = true, bool p_collide_with_areas = false, bool p_pick_ray = false) override;
+	virtual int intersect_rays(const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool *r_collided, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = UINT32_MAX, bool p_collide_with_bodies = true, bool p_collide_with_areas = false) override;
 	virtual int intersect_shape(const RID &p_shape, const Transform3D &p_xform, real_t p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = UINT32_MAX, bool p_collide_with_bodies = true, bool p_collide_with_areas = false) override;
 	virtual bool cast_motion(const RID &p_shape, const Transform3D &p_xform, const Vector3 &p_motion, real_t p_margin, real_t &p_closest_safe, real_t &p_closest_unsafe, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = UINT32_MAX, bool p_collide_with_bodies = true, bool p_collide_with_areas = false, ShapeRestInfo *r_info = nullptr) override;
 	virtual bool collide_shape(RID p_shape, const Transform3D &p_shape_xform, real_t p_margin, Vector3 *r_results, int p_result_max, int &r_result_count, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = UINT32_MAX, bool p_collide_with_bodies = true, bool p_collide_with_areas = false) override;
@@ -65,9 +84,12 @@ public:
 	enum ElapsedTime {
 		ELAPSED_TIME_INTEGRATE_FORCES,
 		ELAPSED_TIME_GENERATE_ISLANDS,
+		ELAPSED_TIME_NARROWPHASE,
 		ELAPSED_TIME_SETUP_CONSTRAINTS,
 		ELAPSED_TIME_SOLVE_CONSTRAINTS,
 		ELAPSED_TIME_INTEGRATE_VELOCITIES,
+		ELAPSED_TIME_BROADPHASE,
+		ELAPSED_TIME_AREA_CALLBACKS, // Measured while flushing queries, not during the step.
 		ELAPSED_TIME_MAX
 
 	};
@@ -85,6 +107,7 @@ private:
 	SelfList<GodotArea3D>::List monitor_query_list;
 	SelfList<GodotArea3D>::List area_moved_list;
 	SelfList<GodotSoftBody3D>::List active_soft_body_list;
+	SelfList<GodotBodyPair3D>::List body_pair_snapshot_list;
 
 	static void *_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_self);
 	static void _broadphase_unpair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_data, void *p_self);
@@ -115,19 +138,50 @@ private:
 	real_t last_step = 0.001;
 
 	int island_count = 0;
+
+	// Islands of the active bodies, kept between steps by GodotStep3D.
+	// They only need to be rebuilt when island_version changes, meaning constraints were added or removed,
+	// or bodies were activated, deactivated, added, removed or changed mode.
+	uint64_t island_version = 1;
+	uint64_t cached_island_version = 0;
+	LocalVector<LocalVector<GodotBody3D *>> cached_body_islands;
+	LocalVector<LocalVector<GodotConstraint3D *>> cached_constraint_islands;
 	int active_objects = 0;
 	int collision_pairs = 0;
 
+	// Counted as things happen, then moved to the last step values at the end of every step.
+	int bodies_woken = 0;
+	int pairs_created = 0;
+	int last_step_bodies_woken = 0;
+	int last_step_pairs_created = 0;
+
 	RID static_global_body;
 
+	// Ring of snapshots saved with push_state(), oldest first starting at state_history_first.
+	LocalVector<Vector<uint8_t>> state_history;
+	uint32_t state_history_first = 0;
+	uint32_t state_history_count = 0;
+
 	Vector<Vector3> contact_debug;
 	int contact_debug_count = 0;
 
 	friend class GodotPhysicsDirectSpaceState3D;
 
-	int _cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb);
+	int _cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb, GodotCollisionObject3D **r_results, int *r_subindices, GodotBroadPhase3D::CullScratch *r_hits);
 
 public:
+	// Broadphase results of one thread running test_body_motion() concurrently.
+	struct MotionScratch {
+		LocalVector<GodotCollisionObject3D *> cull_results;
+		LocalVector<int> cull_subindices;
+		GodotBroadPhase3D::CullScratch cull_hits;
+
+		MotionScratch() {
+			cull_results.resize(INTERSECTION_QUERY_MAX);
+			cull_subindices.resize(INTERSECTION_QUERY_MAX);
+		}
+	};
+
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
 
@@ -153,6 +207,9 @@ public:
 	void soft_body_add_to_active_list(SelfList<GodotSoftBody3D> *p_soft_body);
 	void soft_body_remove_from_active_list(SelfList<GodotSoftBody3D> *p_soft_body);
 
+	void body_pair_add_to_snapshot_list(SelfList<GodotBodyPair3D> *p_pair);
+	void body_pair_remove_from_snapshot_list(SelfList<GodotBodyPair3D> *p_pair);
+
 	GodotBroadPhase3D *get_broadphase();
 
 	void add_object(GodotCollisionObject3D *p_object);
@@ -185,11 +242,21 @@ public:
 	void set_island_count(int p_island_count) { island_count = p_island_count; }
 	int get_island_count() const { return island_count; }
 
+	_FORCE_INLINE_ void invalidate_islands() { island_version++; }
+	_FORCE_INLINE_ bool are_cached_islands_valid() const { return cached_island_version == island_version; }
+	_FORCE_INLINE_ void set_cached_islands_valid() { cached_island_version = island_version; }
+	_FORCE_INLINE_ LocalVector<LocalVector<GodotBody3D *>> &get_cached_body_islands() { return cached_body_islands; }
+	_FORCE_INLINE_ LocalVector<LocalVector<GodotConstraint3D *>> &get_cached_constraint_islands() { return cached_constraint_islands; }
+
 	void set_active_objects(int p_active_objects) { active_objects = p_active_objects; }
 	int get_active_objects() const { return active_objects; }
 
 	int get_collision_pairs() const { return collision_pairs; }
 
+	void finish_step_counters();
+	int get_last_step_bodies_woken() const { return last_step_bodies_woken; }
+	int get_last_step_pairs_created() const { return last_step_pairs_created; }
+
 	GodotPhysicsDirectSpaceState3D *get_direct_state();
 
 	void set_debug_contacts(int p_amount) { contact_debug.resize(p_amount); }
@@ -208,7 +275,18 @@ public:
 	void set_elapsed_time(ElapsedTime p_time, uint64_t p_msec) { elapsed_time[p_time] = p_msec; }
 	uint64_t get_elapsed_time(ElapsedTime p_time) const { return elapsed_time[p_time]; }
 
-	bool test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result);
+	void save_state(Vector<uint8_t> &r_state) const;
+	bool restore_state(const Vector<uint8_t> &p_state);
+
+	void set_state_history_size(int p_size);
+	int get_state_history_size() const { return state_history.size(); }
+	int get_state_history_count() const { return state_history_count; }
+	void push_state();
+	bool rollback_state(int p_steps_back);
+
+	// Without scratch, the shared intersection query buffers are used. With it, several tests can run at once
+	// as long as nothing modifies the space meanwhile.
+	bool test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result, MotionScratch *p_scratch = nullptr);
 
 	GodotSpace3D();
 	~GodotSpace3D();
@@ -32,9 +32,9 @@
 
 #include "godot_joint_3d.h"
 
+#include "core/debugger/trace_zones.h"
 #include "core/os/os.h"
 
-#define BODY_ISLAND_COUNT_RESERVE 128
 #define BODY_ISLAND_SIZE_RESERVE 512
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
@@ -56,8 +56,6 @@ void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D
 		constraint->set_island_step(_step);
 		p_constraint_island.push_back(constraint);
 
-		all_constraints.push_back(constraint);
-
 		// Find connected rigid bodies.
 		for (int i = 0; i < constraint->get_body_count(); i++) {
 			if (i == E.value) {
@@ -95,8 +93,6 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 		constraint->set_island_step(_step);
 		p_constraint_island.push_back(constraint);
 
-		all_constraints.push_back(constraint);
-
 		// Find connected rigid bodies.
 		for (int i = 0; i < constraint->get_body_count(); i++) {
 			GodotBody3D *body = constraint->get_body_ptr()[i];
@@ -111,8 +107,88 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
-void GodotStep3D::_setup_contraint(uint32_t p_constraint_index, void *p_userdata) {
-	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
+void GodotStep3D::_generate_islands(GodotSpace3D *p_space, LocalVector<LocalVector<GodotBody3D *>> &r_body_islands, LocalVector<LocalVector<GodotConstraint3D *>> &r_constraint_islands) {
+	uint32_t body_island_count = 0;
+	uint32_t island_count = 0;
+
+	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
+
+	const SelfList<GodotBody3D> *b = p_space->get_active_body_list().first();
+	while (b) {
+		GodotBody3D *body = b->self();
+
+		if (body->get_island_step() != _step) {
+			++body_island_count;
+			if (r_body_islands.size() < body_island_count) {
+				r_body_islands.resize(body_island_count);
+			}
+			LocalVector<GodotBody3D *> &body_island = r_body_islands[body_island_count - 1];
+			body_island.clear();
+			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
+
+			++island_count;
+			if (r_constraint_islands.size() < island_count) {
+				r_constraint_islands.resize(island_count);
+			}
+			LocalVector<GodotConstraint3D *> &constraint_island = r_constraint_islands[island_count - 1];
+			constraint_island.clear();
+			constraint_island.reserve(ISLAND_SIZE_RESERVE);
+
+			_populate_island(body, body_island, constraint_island);
+
+			if (body_island.is_empty()) {
+				--body_island_count;
+			}
+
+			if (constraint_island.is_empty()) {
+				--island_count;
+			}
+		}
+		b = b->next();
+	}
+
+	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE SOFT BODIES */
+
+	const SelfList<GodotSoftBody3D> *sb = p_space->get_active_soft_body_list().first();
+	while (sb) {
+		GodotSoftBody3D *soft_body = sb->self();
+
+		if (soft_body->get_island_step() != _step) {
+			++body_island_count;
+			if (r_body_islands.size() < body_island_count) {
+				r_body_islands.resize(body_island_count);
+			}
+			LocalVector<GodotBody3D *> &body_island = r_body_islands[body_island_count - 1];
+			body_island.clear();
+			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
+
+			++island_count;
+			if (r_constraint_islands.size() < island_count) {
+				r_constraint_islands.resize(island_count);
+			}
+			LocalVector<GodotConstraint3D *> &constraint_island = r_constraint_islands[island_count - 1];
+			constraint_island.clear();
+			constraint_island.reserve(ISLAND_SIZE_RESERVE);
+
+			_populate_island_soft_body(soft_body, body_island, constraint_island);
+
+			if (body_island.is_empty()) {
+				--body_island_count;
+			}
+
+			if (constraint_island.is_empty()) {
+				--island_count;
+			}
+		}
+		sb = sb->next();
+	}
+
+	r_body_islands.resize(body_island_count);
+	r_constraint_islands.resize(island_count);
+}
+
+void GodotStep3D::_setup_contraint(uint32_t p_constraint_index, uint32_t p_offset) {
+	GodotConstraint3D *constraint = all_constraints[p_offset + p_constraint_index];
 	constraint->setup(delta);
 }
 
@@ -157,6 +233,10 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	}
 }
 
+void GodotStep3D::_solve_soft_body(uint32_t p_soft_body_index, void *p_userdata) {
+	active_soft_bodies[p_soft_body_index]->solve_constraints(delta);
+}
+
 void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
 	bool can_sleep = true;
 
@@ -223,9 +303,25 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta, int p_iterations)
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		TRACE_ZONE_ADD("Physics 3D integrate forces", profile_begtime, profile_endtime);
 		profile_begtime = profile_endtime;
 	}
 
+	/* GENERATE ISLANDS FOR ACTIVE BODIES */
+
+	// Islands are kept by the space and only rebuilt when the constraint graph or the set of active bodies changed,
+	// so steps where nothing started or stopped touching (like piles of resting debris) skip walking the graph.
+	LocalVector<LocalVector<GodotBody3D *>> &cached_body_islands = p_space->get_cached_body_islands();
+	LocalVector<LocalVector<GodotConstraint3D *>> &cached_constraint_islands = p_space->get_cached_constraint_islands();
+
+	bool rebuild_islands = !p_space->are_cached_islands_valid();
+	if (rebuild_islands) {
+		_generate_islands(p_space, cached_body_islands, cached_constraint_islands);
+		p_space->set_cached_islands_valid();
+	}
+
+	uint32_t body_island_count = cached_body_islands.size();
+
 	/* GENERATE CONSTRAINT ISLANDS FOR MOVING AREAS */
 
 	uint32_t island_count = 0;
@@ -254,97 +350,72 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta, int p_iterations)
 		p_space->area_remove_from_moved_list((SelfList<GodotArea3D> *)aml.first()); //faster to remove here
 	}
 
-	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
-
-	b = body_list->first();
+	/* COPY CONSTRAINT ISLANDS FOR ACTIVE BODIES */
 
-	uint32_t body_island_count = 0;
+	// Solving reorders and trims the islands, so work on a copy.
+	for (uint32_t cached_index = 0; cached_index < cached_constraint_islands.size(); ++cached_index) {
+		const LocalVector<GodotConstraint3D *> &cached_island = cached_constraint_islands[cached_index];
 
-	while (b) {
-		GodotBody3D *body = b->self();
-
-		if (body->get_island_step() != _step) {
-			++body_island_count;
-			if (body_islands.size() < body_island_count) {
-				body_islands.resize(body_island_count);
-			}
-			LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
-
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
-
-			_populate_island(body, body_island, constraint_island);
-
-			if (body_island.is_empty()) {
-				--body_island_count;
+		++island_count;
+		if (constraint_islands.size() < island_count) {
+			constraint_islands.resize(island_count);
+		}
+		LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
+		constraint_island.clear();
+		constraint_island.reserve(cached_island.size());
+
+		for (uint32_t constraint_index = 0; constraint_index < cached_island.size(); ++constraint_index) {
+			GodotConstraint3D *constraint = cached_island[constraint_index];
+			if (!rebuild_islands && constraint->get_island_step() == _step) {
+				continue; // Already added by a moving area above.
 			}
+			all_constraints.push_back(constraint);
+			constraint_island.push_back(constraint);
+		}
 
-			if (constraint_island.is_empty()) {
-				--island_count;
-			}
+		if (constraint_island.is_empty()) {
+			--island_count;
 		}
-		b = b->next();
 	}
 
-	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE SOFT BODIES */
-
-	sb = soft_body_list->first();
-	while (sb) {
-		GodotSoftBody3D *soft_body = sb->self();
-
-		if (soft_body->get_island_step() != _step) {
-			++body_island_count;
-			if (body_islands.size() < body_island_count) {
-				body_islands.resize(body_island_count);
-			}
-			LocalVector<GodotBody3D *> &body_island = body_islands[body_island_count - 1];
-			body_island.clear();
-			body_island.reserve(BODY_ISLAND_SIZE_RESERVE);
+	p_space->set_island_count((int)island_count);
 
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
-			constraint_island.reserve(ISLAND_SIZE_RESERVE);
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_GENERATE_ISLANDS, profile_endtime - profile_begtime);
+		TRACE_ZONE_ADD("Physics 3D generate islands", profile_begtime, profile_endtime);
+		profile_begtime = profile_endtime;
+	}
 
-			_populate_island_soft_body(soft_body, body_island, constraint_island);
+	/* PROCESS COLLISIONS */
 
-			if (body_island.is_empty()) {
-				--body_island_count;
-			}
-
-			if (constraint_island.is_empty()) {
-				--island_count;
-			}
+	// Move joints after the collision pairs, so narrowphase and joint setup can be timed apart.
+	uint32_t total_contraint_count = all_constraints.size();
+	uint32_t pair_count = 0;
+	for (uint32_t constraint_index = 0; constraint_index < total_contraint_count; ++constraint_index) {
+		if (!all_constraints[constraint_index]->is_joint()) {
+			SWAP(all_constraints[constraint_index], all_constraints[pair_count]);
+			++pair_count;
 		}
-		sb = sb->next();
 	}
 
-	p_space->set_island_count((int)island_count);
+	work_pool.do_work_batched(pair_count, this, &GodotStep3D::_setup_contraint, 0u);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_GENERATE_ISLANDS, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_NARROWPHASE, profile_endtime - profile_begtime);
+		TRACE_ZONE_ADD("Physics 3D narrowphase", profile_begtime, profile_endtime);
 		profile_begtime = profile_endtime;
 	}
 
-	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
+	/* SETUP JOINTS */
 
-	uint32_t total_contraint_count = all_constraints.size();
-	work_pool.do_work(total_contraint_count, this, &GodotStep3D::_setup_contraint, nullptr);
+	joint_work_pool.do_work_batched(total_contraint_count - pair_count, this, &GodotStep3D::_setup_contraint, pair_count);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS, profile_endtime - profile_begtime);
+		TRACE_ZONE_ADD("Physics 3D setup constraints", profile_begtime, profile_endtime);
 		profile_begtime = profile_endtime;
 	}
 
@@ -368,6 +439,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta, int p_iterations)
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
+		TRACE_ZONE_ADD("Physics 3D solve constraints", profile_begtime, profile_endtime);
 		profile_begtime = profile_endtime;
 	}
 
@@ -383,38 +455,56 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta, int p_iterations)
 	/* SLEEP / WAKE UP ISLANDS */
 
 	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
-		_check_suspend(body_islands[island_index]);
+		_check_suspend(cached_body_islands[island_index]);
 	}
 
 	/* UPDATE SOFT BODY CONSTRAINTS */
 
+	// Soft bodies only touch their own nodes here, so they can be solved in parallel.
 	sb = soft_body_list->first();
 	while (sb) {
-		sb->self()->solve_constraints(p_delta);
+		active_soft_bodies.push_back(sb->self());
 		sb = sb->next();
 	}
 
+	work_pool.do_work(active_soft_bodies.size(), this, &GodotStep3D::_solve_soft_body, nullptr);
+
+	active_soft_bodies.clear();
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_VELOCITIES, profile_endtime - profile_begtime);
+		TRACE_ZONE_ADD("Physics 3D integrate velocities", profile_begtime, profile_endtime);
 		profile_begtime = profile_endtime;
 	}
 
 	all_constraints.clear();
 
+	/* UPDATE BROADPHASE */
+
 	p_space->update();
+
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_BROADPHASE, profile_endtime - profile_begtime);
+		TRACE_ZONE_ADD("Physics 3D broadphase", profile_begtime, profile_endtime);
+		profile_begtime = profile_endtime;
+	}
+
+	p_space->finish_step_counters();
 	p_space->unlock();
 	_step++;
 }
 
 GodotStep3D::GodotStep3D() {
-	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
 
 	work_pool.init();
+	joint_work_pool.init();
 }
 
 GodotStep3D::~GodotStep3D() {
 	work_pool.finish();
+	joint_work_pool.finish();
 }
@@ -43,16 +43,19 @@ class GodotStep3D {
 	real_t delta = 0.0;
 
 	ThreadWorkPool work_pool;
+	ThreadWorkPool joint_work_pool; // Separate from work_pool, which estimates the cost of collision pairs.
 
-	LocalVector<LocalVector<GodotBody3D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
+	LocalVector<GodotSoftBody3D *> active_soft_bodies;
 
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
-	void _setup_contraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
+	void _generate_islands(GodotSpace3D *p_space, LocalVector<LocalVector<GodotBody3D *>> &r_body_islands, LocalVector<LocalVector<GodotConstraint3D *>> &r_constraint_islands);
+	void _setup_contraint(uint32_t p_constraint_index, uint32_t p_offset);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _solve_soft_body(uint32_t p_soft_body_index, void *p_userdata = nullptr);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
@@ -275,6 +275,35 @@ Dictionary PhysicsDirectSpaceState3D::_intersect_ray(const Vector3 &p_from, cons
 	return d;
 }
 
+int PhysicsDirectSpaceState3D::_intersect_rays(const Vector<Vector3> &p_from, const Vector<Vector3> &p_to, const Ref<PhysicsRayBatchResult3D> &p_result, const Vector<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+	ERR_FAIL_COND_V(p_result.is_null(), 0);
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), 0, "The amount of ray origins and ray ends must be the same.");
+
+	Set<RID> exclude;
+	for (int i = 0; i < p_exclude.size(); i++) {
+		exclude.insert(p_exclude[i]);
+	}
+
+	// Storage is kept between calls, so reusing the same result for every batch doesn't allocate.
+	Ref<PhysicsRayBatchResult3D> result = p_result;
+	result->results.resize(p_from.size());
+	result->collided.resize(p_from.size());
+	result->hit_count = intersect_rays(p_from.ptr(), p_to.ptr(), p_from.size(), result->results.ptr(), result->collided.ptr(), exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
+
+	return result->hit_count;
+}
+
+int PhysicsDirectSpaceState3D::intersect_rays(const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool *r_collided, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+	int hit_count = 0;
+	for (int i = 0; i < p_ray_count; i++) {
+		r_collided[i] = intersect_ray(p_from[i], p_to[i], r_results[i], p_exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
+		if (r_collided[i]) {
+			hit_count++;
+		}
+	}
+	return hit_count;
+}
+
 Array PhysicsDirectSpaceState3D::_intersect_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results) {
 	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Array());
 
@@ -354,6 +383,7 @@ PhysicsDirectSpaceState3D::PhysicsDirectSpaceState3D() {
 
 void PhysicsDirectSpaceState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_ray", "from", "to", "exclude", "collision_mask", "collide_with_bodies", "collide_with_areas"), &PhysicsDirectSpaceState3D::_intersect_ray, DEFVAL(Array()), DEFVAL(UINT32_MAX), DEFVAL(true), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("intersect_rays", "from", "to", "result", "exclude", "collision_mask", "collide_with_bodies", "collide_with_areas"), &PhysicsDirectSpaceState3D::_intersect_rays, DEFVAL(Array()), DEFVAL(UINT32_MAX), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("intersect_shape", "shape", "max_results"), &PhysicsDirectSpaceState3D::_intersect_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "shape", "motion"), &PhysicsDirectSpaceState3D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "shape", "max_results"), &PhysicsDirectSpaceState3D::_collide_shape, DEFVAL(32));
@@ -362,6 +392,109 @@ void PhysicsDirectSpaceState3D::_bind_methods() {
 
 ///////////////////////////////
 
+int PhysicsRayBatchResult3D::get_ray_count() const {
+	return results.size();
+}
+
+int PhysicsRayBatchResult3D::get_hit_count() const {
+	return hit_count;
+}
+
+bool PhysicsRayBatchResult3D::is_ray_colliding(int p_ray_index) const {
+	ERR_FAIL_INDEX_V(p_ray_index, (int)collided.size(), false);
+	return collided[p_ray_index];
+}
+
+Vector3 PhysicsRayBatchResult3D::get_collision_point(int p_ray_index) const {
+	ERR_FAIL_INDEX_V(p_ray_index, (int)collided.size(), Vector3());
+	return collided[p_ray_index] ? results[p_ray_index].position : Vector3();
+}
+
+Vector3 PhysicsRayBatchResult3D::get_collision_normal(int p_ray_index) const {
+	ERR_FAIL_INDEX_V(p_ray_index, (int)collided.size(), Vector3());
+	return collided[p_ray_index] ? results[p_ray_index].normal : Vector3();
+}
+
+ObjectID PhysicsRayBatchResult3D::get_collider_id(int p_ray_index) const {
+	ERR_FAIL_INDEX_V(p_ray_index, (int)collided.size(), ObjectID());
+	return collided[p_ray_index] ? results[p_ray_index].collider_id : ObjectID();
+}
+
+RID PhysicsRayBatchResult3D::get_collider_rid(int p_ray_index) const {
+	ERR_FAIL_INDEX_V(p_ray_index, (int)collided.size(), RID());
+	return collided[p_ray_index] ? results[p_ray_index].rid : RID();
+}
+
+Object *PhysicsRayBatchResult3D::get_collider(int p_ray_index) const {
+	ERR_FAIL_INDEX_V(p_ray_index, (int)collided.size(), nullptr);
+	return collided[p_ray_index] ? ObjectDB::get_instance(results[p_ray_index].collider_id) : nullptr;
+}
+
+int PhysicsRayBatchResult3D::get_collider_shape(int p_ray_index) const {
+	ERR_FAIL_INDEX_V(p_ray_index, (int)collided.size(), 0);
+	return collided[p_ray_index] ? results[p_ray_index].shape : 0;
+}
+
+Vector<int32_t> PhysicsRayBatchResult3D::get_colliding_rays() const {
+	Vector<int32_t> rays;
+	rays.resize(hit_count);
+	int32_t *w = rays.ptrw();
+	for (uint32_t i = 0; i < collided.size(); i++) {
+		if (collided[i]) {
+			*w++ = i;
+		}
+	}
+	return rays;
+}
+
+Vector<Vector3> PhysicsRayBatchResult3D::get_collision_points() const {
+	Vector<Vector3> points;
+	points.resize(results.size());
+	Vector3 *w = points.ptrw();
+	for (uint32_t i = 0; i < results.size(); i++) {
+		w[i] = collided[i] ? results[i].position : Vector3();
+	}
+	return points;
+}
+
+Vector<Vector3> PhysicsRayBatchResult3D::get_collision_normals() const {
+	Vector<Vector3> normals;
+	normals.resize(results.size());
+	Vector3 *w = normals.ptrw();
+	for (uint32_t i = 0; i < results.size(); i++) {
+		w[i] = collided[i] ? results[i].normal : Vector3();
+	}
+	return normals;
+}
+
+Vector<int64_t> PhysicsRayBatchResult3D::get_collider_ids() const {
+	Vector<int64_t> ids;
+	ids.resize(results.size());
+	int64_t *w = ids.ptrw();
+	for (uint32_t i = 0; i < results.size(); i++) {
+		w[i] = collided[i] ? int64_t(results[i].collider_id) : 0;
+	}
+	return ids;
+}
+
+void PhysicsRayBatchResult3D::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("get_ray_count"), &PhysicsRayBatchResult3D::get_ray_count);
+	ClassDB::bind_method(D_METHOD("get_hit_count"), &PhysicsRayBatchResult3D::get_hit_count);
+	ClassDB::bind_method(D_METHOD("is_ray_colliding", "ray_index"), &PhysicsRayBatchResult3D::is_ray_colliding);
+	ClassDB::bind_method(D_METHOD("get_collision_point", "ray_index"), &PhysicsRayBatchResult3D::get_collision_point);
+	ClassDB::bind_method(D_METHOD("get_collision_normal", "ray_index"), &PhysicsRayBatchResult3D::get_collision_normal);
+	ClassDB::bind_method(D_METHOD("get_collider_id", "ray_index"), &PhysicsRayBatchResult3D::get_collider_id);
+	ClassDB::bind_method(D_METHOD("get_collider_rid", "ray_index"), &PhysicsRayBatchResult3D::get_collider_rid);
+	ClassDB::bind_method(D_METHOD("get_collider", "ray_index"), &PhysicsRayBatchResult3D::get_collider);
+	ClassDB::bind_method(D_METHOD("get_collider_shape", "ray_index"), &PhysicsRayBatchResult3D::get_collider_shape);
+	ClassDB::bind_method(D_METHOD("get_colliding_rays"), &PhysicsRayBatchResult3D::get_colliding_rays);
+	ClassDB::bind_method(D_METHOD("get_collision_points"), &PhysicsRayBatchResult3D::get_collision_points);
+	ClassDB::bind_method(D_METHOD("get_collision_normals"), &PhysicsRayBatchResult3D::get_collision_normals);
+	ClassDB::bind_method(D_METHOD("get_collider_ids"), &PhysicsRayBatchResult3D::get_collider_ids);
+}
+
+///////////////////////////////
+
 Vector<RID> PhysicsTestMotionParameters3D::get_exclude_bodies() const {
 	Vector<RID> exclude;
 	exclude.resize(parameters.exclude_bodies.size());
@@ -528,6 +661,47 @@ bool PhysicsServer3D::_body_test_motion(RID p_body, const Ref<PhysicsTestMotionP
 	return body_test_motion(p_body, p_parameters->get_parameters(), result_ptr);
 }
 
+int PhysicsServer3D::_body_test_motions(const Vector<RID> &p_bodies, const Array &p_parameters, const Array &p_results) {
+	int count = p_bodies.size();
+	ERR_FAIL_COND_V_MSG(p_parameters.size() != count || p_results.size() != count, 0, "Bodies, parameters and results must have the same size.");
+
+	Vector<MotionParameters> parameters;
+	parameters.resize(count);
+	MotionParameters *parameters_ptrw = parameters.ptrw();
+	for (int i = 0; i < count; i++) {
+		Ref<PhysicsTestMotionParameters3D> motion_parameters = p_parameters[i];
+		ERR_FAIL_COND_V(!motion_parameters.is_valid(), 0);
+		parameters_ptrw[i] = motion_parameters->get_parameters();
+	}
+
+	Vector<MotionResult> results;
+	results.resize(count);
+	LocalVector<bool> collided;
+	collided.resize(count);
+
+	int collided_count = body_test_motions(p_bodies.ptr(), parameters.ptr(), results.ptrw(), collided.ptr(), count);
+
+	for (int i = 0; i < count; i++) {
+		Ref<PhysicsTestMotionResult3D> motion_result = p_results[i];
+		if (motion_result.is_valid()) {
+			*motion_result->get_result_ptr() = results[i];
+		}
+	}
+
+	return collided_count;
+}
+
+int PhysicsServer3D::body_test_motions(const RID *p_bodies, const MotionParameters *p_parameters, MotionResult *r_results, bool *r_collided, int p_count) {
+	int collided_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		r_collided[i] = body_test_motion(p_bodies[i], p_parameters[i], &r_results[i]);
+		if (r_collided[i]) {
+			collided_count++;
+		}
+	}
+	return collided_count;
+}
+
 RID PhysicsServer3D::shape_create(ShapeType p_shape) {
 	switch (p_shape) {
 		case SHAPE_WORLD_BOUNDARY:
@@ -580,6 +754,13 @@ void PhysicsServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer3D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer3D::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer3D::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_save_state", "space"), &PhysicsServer3D::space_save_state);
+	ClassDB::bind_method(D_METHOD("space_restore_state", "space", "state"), &PhysicsServer3D::space_restore_state);
+	ClassDB::bind_method(D_METHOD("space_set_state_history_size", "space", "size"), &PhysicsServer3D::space_set_state_history_size);
+	ClassDB::bind_method(D_METHOD("space_get_state_history_size", "space"), &PhysicsServer3D::space_get_state_history_size);
+	ClassDB::bind_method(D_METHOD("space_get_state_history_count", "space"), &PhysicsServer3D::space_get_state_history_count);
+	ClassDB::bind_method(D_METHOD("space_push_state", "space"), &PhysicsServer3D::space_push_state);
+	ClassDB::bind_method(D_METHOD("space_rollback_state", "space", "steps_back"), &PhysicsServer3D::space_rollback_state);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer3D::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer3D::area_set_space);
@@ -684,6 +865,7 @@ void PhysicsServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("body_set_ray_pickable", "body", "enable"), &PhysicsServer3D::body_set_ray_pickable);
 
 	ClassDB::bind_method(D_METHOD("body_test_motion", "body", "parameters", "result"), &PhysicsServer3D::_body_test_motion, DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("body_test_motions", "bodies", "parameters", "results"), &PhysicsServer3D::_body_test_motions);
 
 	ClassDB::bind_method(D_METHOD("body_get_direct_state", "body"), &PhysicsServer3D::body_get_direct_state);
 
@@ -879,6 +1061,8 @@ void PhysicsServer3D::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_ACTIVE_OBJECTS);
 	BIND_ENUM_CONSTANT(INFO_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(INFO_ISLAND_COUNT);
+	BIND_ENUM_CONSTANT(INFO_BODIES_WOKEN);
+	BIND_ENUM_CONSTANT(INFO_PAIRS_CREATED);
 
 	BIND_ENUM_CONSTANT(SPACE_PARAM_CONTACT_RECYCLE_RADIUS);
 	BIND_ENUM_CONSTANT(SPACE_PARAM_CONTACT_MAX_SEPARATION);
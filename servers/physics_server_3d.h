@@ -33,6 +33,7 @@
 
 #include "core/io/resource.h"
 #include "core/object/class_db.h"
+#include "core/templates/local_vector.h"
 
 class PhysicsDirectSpaceState3D;
 
@@ -138,11 +139,14 @@ public:
 	bool is_collide_with_areas_enabled() const;
 };
 
+class PhysicsRayBatchResult3D;
+
 class PhysicsDirectSpaceState3D : public Object {
 	GDCLASS(PhysicsDirectSpaceState3D, Object);
 
 private:
 	Dictionary _intersect_ray(const Vector3 &p_from, const Vector3 &p_to, const Vector<RID> &p_exclude = Vector<RID>(), uint32_t p_collision_mask = UINT32_MAX, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
+	int _intersect_rays(const Vector<Vector3> &p_from, const Vector<Vector3> &p_to, const Ref<PhysicsRayBatchResult3D> &p_result, const Vector<RID> &p_exclude = Vector<RID>(), uint32_t p_collision_mask = UINT32_MAX, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	Array _intersect_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results = 32);
 	Array _cast_motion(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const Vector3 &p_motion);
 	Array _collide_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results = 32);
@@ -172,6 +176,10 @@ public:
 
 	virtual bool intersect_ray(const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = UINT32_MAX, bool p_collide_with_bodies = true, bool p_collide_with_areas = false, bool p_pick_ray = false) = 0;
 
+	// Casts p_ray_count rays at once, r_collided tells which of r_results were written. Returns the amount of rays that hit something.
+	// The default implementation just calls intersect_ray() for each of them.
+	virtual int intersect_rays(const Vector3 *p_from, const Vector3 *p_to, int p_ray_count, RayResult *r_results, bool *r_collided, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = UINT32_MAX, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
+
 	virtual int intersect_shape(const RID &p_shape, const Transform3D &p_xform, real_t p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = UINT32_MAX, bool p_collide_with_bodies = true, bool p_collide_with_areas = false) = 0;
 
 	struct ShapeRestInfo {
@@ -194,12 +202,50 @@ public:
 	PhysicsDirectSpaceState3D();
 };
 
+class PhysicsRayBatchResult3D : public RefCounted {
+	GDCLASS(PhysicsRayBatchResult3D, RefCounted);
+
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+	LocalVector<bool> collided;
+	int hit_count = 0;
+
+	friend class PhysicsDirectSpaceState3D;
+
+protected:
+	static void _bind_methods();
+
+public:
+	int get_ray_count() const;
+	int get_hit_count() const;
+
+	bool is_ray_colliding(int p_ray_index) const;
+	Vector3 get_collision_point(int p_ray_index) const;
+	Vector3 get_collision_normal(int p_ray_index) const;
+	ObjectID get_collider_id(int p_ray_index) const;
+	RID get_collider_rid(int p_ray_index) const;
+	Object *get_collider(int p_ray_index) const;
+	int get_collider_shape(int p_ray_index) const;
+
+	Vector<int32_t> get_colliding_rays() const;
+	Vector<Vector3> get_collision_points() const;
+	Vector<Vector3> get_collision_normals() const;
+	Vector<int64_t> get_collider_ids() const;
+};
+
 class RenderingServerHandler {
 public:
 	virtual void set_vertex(int p_vertex_id, const void *p_vector3) = 0;
 	virtual void set_normal(int p_vertex_id, const void *p_vector3) = 0;
 	virtual void set_aabb(const AABB &p_aabb) = 0;
 
+	// Sets the first p_vertex_count vertices and normals in one call, override it to avoid the per-vertex calls.
+	virtual void set_vertices_and_normals(int p_vertex_count, const Vector3 *p_vertices, const Vector3 *p_normals) {
+		for (int i = 0; i < p_vertex_count; i++) {
+			set_vertex(i, &p_vertices[i]);
+			set_normal(i, &p_normals[i]);
+		}
+	}
+
 	virtual ~RenderingServerHandler() {}
 };
 
@@ -212,6 +258,7 @@ class PhysicsServer3D : public Object {
 	static PhysicsServer3D *singleton;
 
 	virtual bool _body_test_motion(RID p_body, const Ref<PhysicsTestMotionParameters3D> &p_parameters, const Ref<PhysicsTestMotionResult3D> &p_result = Ref<PhysicsTestMotionResult3D>());
+	int _body_test_motions(const Vector<RID> &p_bodies, const Array &p_parameters, const Array &p_results);
 
 protected:
 	static void _bind_methods();
@@ -284,6 +331,16 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	// Snapshots of the simulation state, for rollback and resimulation.
+	virtual Vector<uint8_t> space_save_state(RID p_space) const = 0;
+	virtual bool space_restore_state(RID p_space, const Vector<uint8_t> &p_state) = 0;
+
+	virtual void space_set_state_history_size(RID p_space, int p_size) = 0;
+	virtual int space_get_state_history_size(RID p_space) const = 0;
+	virtual int space_get_state_history_count(RID p_space) const = 0;
+	virtual void space_push_state(RID p_space) = 0;
+	virtual bool space_rollback_state(RID p_space, int p_steps_back) = 0;
+
 	//missing space parameters
 
 	/* AREA API */
@@ -351,6 +408,20 @@ public:
 	virtual void area_set_monitor_callback(RID p_area, Object *p_receiver, const StringName &p_method) = 0;
 	virtual void area_set_area_monitor_callback(RID p_area, Object *p_receiver, const StringName &p_method) = 0;
 
+	// Callback for C++ use only, delivers every body and area that entered or exited in a single call per step.
+	struct AreaMonitorEvent {
+		RID rid;
+		ObjectID instance_id;
+		int other_shape = 0;
+		int self_shape = 0;
+		bool added = false;
+		bool is_area = false;
+	};
+
+	typedef void (*AreaMonitorEventsCallback)(void *p_instance, const AreaMonitorEvent *p_events, int p_count);
+	// Replaces both monitor callbacks above. Returns false if the server doesn't support it, use those instead then.
+	virtual bool area_set_monitor_events_callback(RID p_area, void *p_instance, AreaMonitorEventsCallback p_callback) { return false; }
+
 	virtual void area_set_ray_pickable(RID p_area, bool p_enable) = 0;
 
 	/* BODY API */
@@ -529,6 +600,10 @@ public:
 
 	virtual bool body_test_motion(RID p_body, const MotionParameters &p_parameters, MotionResult *r_result = nullptr) = 0;
 
+	// Tests p_count motions at once, r_collided tells which of them collided. Returns the amount of motions that collided.
+	// The default implementation just calls body_test_motion() for each of them.
+	virtual int body_test_motions(const RID *p_bodies, const MotionParameters *p_parameters, MotionResult *r_results, bool *r_collided, int p_count);
+
 	/* SOFT BODY */
 
 	virtual RID soft_body_create() = 0;
@@ -769,7 +844,9 @@ public:
 	enum ProcessInfo {
 		INFO_ACTIVE_OBJECTS,
 		INFO_COLLISION_PAIRS,
-		INFO_ISLAND_COUNT
+		INFO_ISLAND_COUNT,
+		INFO_BODIES_WOKEN,
+		INFO_PAIRS_CREATED
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) = 0;
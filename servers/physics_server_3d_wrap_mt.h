@@ -131,6 +131,15 @@ public:
 		return physics_3d_server->space_get_contact_count(p_space);
 	}
 
+	FUNC1RC(Vector<uint8_t>, space_save_state, RID);
+	FUNC2R(bool, space_restore_state, RID, const Vector<uint8_t> &);
+
+	FUNC2(space_set_state_history_size, RID, int);
+	FUNC1RC(int, space_get_state_history_size, RID);
+	FUNC1RC(int, space_get_state_history_count, RID);
+	FUNC1(space_push_state, RID);
+	FUNC2R(bool, space_rollback_state, RID, int);
+
 	/* AREA API */
 
 	//FUNC0RID(area);
@@ -170,6 +179,7 @@ public:
 
 	FUNC3(area_set_monitor_callback, RID, Object *, const StringName &);
 	FUNC3(area_set_area_monitor_callback, RID, Object *, const StringName &);
+	FUNC3R(bool, area_set_monitor_events_callback, RID, void *, AreaMonitorEventsCallback);
 
 	/* BODY API */
 
@@ -258,6 +268,11 @@ public:
 		return physics_3d_server->body_test_motion(p_body, p_parameters, r_result);
 	}
 
+	int body_test_motions(const RID *p_bodies, const MotionParameters *p_parameters, MotionResult *r_results, bool *r_collided, int p_count) override {
+		ERR_FAIL_COND_V(main_thread != Thread::get_caller_id(), 0);
+		return physics_3d_server->body_test_motions(p_bodies, p_parameters, r_results, r_collided, p_count);
+	}
+
 	// this function only works on physics process, errors and returns null otherwise
 	PhysicsDirectBodyState3D *body_get_direct_state(RID p_body) override {
 		ERR_FAIL_COND_V(main_thread != Thread::get_caller_id(), nullptr);
@@ -258,6 +258,7 @@ public:
 	void texture_set_detect_3d_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata) override {}
 	void texture_set_detect_normal_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata) override {}
 	void texture_set_detect_roughness_callback(RID p_texture, RS::TextureDetectRoughnessCallback p_callback, void *p_userdata) override {}
+	void texture_set_stream_callback(RID p_texture, RS::TextureStreamCallback p_callback, void *p_userdata) override {}
 
 	void texture_debug_usage(List<RS::TextureInfo> *r_info) override {}
 	void texture_set_force_redraw_if_visible(RID p_texture, bool p_enable) override {}
@@ -366,6 +367,7 @@ public:
 	Color multimesh_instance_get_color(RID p_multimesh, int p_index) const override { return Color(); }
 	Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const override { return Color(); }
 	void multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_buffer) override {}
+	void multimesh_set_buffer_range(RID p_multimesh, int p_from_instance, const Vector<float> &p_buffer) override {}
 	Vector<float> multimesh_get_buffer(RID p_multimesh) const override { return Vector<float>(); }
 
 	void multimesh_set_visible_instances(RID p_multimesh, int p_visible) override {}
@@ -382,6 +384,7 @@ public:
 	Transform3D skeleton_bone_get_transform(RID p_skeleton, int p_bone) const override { return Transform3D(); }
 	void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform) override {}
 	Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const override { return Transform2D(); }
+	void skeleton_set_bone_transforms(RID p_skeleton, const Vector<float> &p_buffer) override {}
 
 	/* Light API */
 
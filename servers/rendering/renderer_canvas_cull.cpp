@@ -97,6 +97,61 @@ void _collect_ysort_children(RendererCanvasCull::Item *p_canvas_item, Transform2
 	}
 }
 
+// Recomputes the local bounds of a subtree, only descending into the children that changed.
+void _update_subtree_rect(RendererCanvasCull::Item *p_canvas_item) {
+	RendererCanvasCull::Item *ci = p_canvas_item;
+
+	// Content that can move without the item being updated (or that is drawn regardless of its rect) makes the subtree impossible to skip.
+	bool subtree_volatile = ci->canvas_group != nullptr || ci->copy_back_buffer != nullptr || ci->vp_render != nullptr;
+	bool empty = true;
+	Rect2 rect;
+
+	if (ci->commands != nullptr) {
+		rect = ci->get_rect();
+		empty = false;
+
+		// A custom rect is trusted as is.
+		for (const RendererCanvasCull::Item::Command *c = ci->commands; c && !subtree_volatile && !ci->custom_rect; c = c->next) {
+			subtree_volatile = c->type == RendererCanvasCull::Item::Command::TYPE_MESH || c->type == RendererCanvasCull::Item::Command::TYPE_MULTIMESH || c->type == RendererCanvasCull::Item::Command::TYPE_PARTICLES;
+		}
+	}
+
+	if (ci->visibility_notifier) {
+		if (ci->visibility_notifier->area.size != Vector2()) {
+			rect = rect.merge(ci->visibility_notifier->area);
+		}
+		empty = false;
+	}
+
+	int child_item_count = ci->child_items.size();
+	RendererCanvasCull::Item **child_items = ci->child_items.ptrw();
+	for (int i = 0; i < child_item_count; i++) {
+		RendererCanvasCull::Item *child = child_items[i];
+		// Dirty children are always updated, even hidden ones, so marking can stop at the first dirty ancestor.
+		if (child->subtree_rect_dirty) {
+			_update_subtree_rect(child);
+		}
+		if (!child->visible) {
+			continue;
+		}
+
+		subtree_volatile = subtree_volatile || child->subtree_volatile;
+		if (child->subtree_rect_empty) {
+			continue;
+		}
+
+		// Grown by a pixel to cover the origin snapping done when snapping 2D transforms to pixels.
+		Rect2 child_rect = child->xform.xform(child->subtree_rect).grow(1);
+		rect = empty ? child_rect : rect.merge(child_rect);
+		empty = false;
+	}
+
+	ci->subtree_rect = rect;
+	ci->subtree_rect_empty = empty;
+	ci->subtree_volatile = subtree_volatile;
+	ci->subtree_rect_dirty = false;
+}
+
 void _mark_ysort_dirty(RendererCanvasCull::Item *ysort_owner, RID_Owner<RendererCanvasCull::Item, true> &canvas_item_owner) {
 	do {
 		ysort_owner->ysort_children_count = -1;
@@ -240,6 +295,23 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 	}
 	xform = p_transform * xform;
 
+	if (ci->subtree_rect_dirty) {
+		_update_subtree_rect(ci);
+	}
+
+	if (!ci->subtree_volatile) {
+		// Nothing in this subtree can be visible, skip it entirely.
+		if (ci->subtree_rect_empty) {
+			return;
+		}
+
+		Rect2 subtree_global_rect = xform.xform(ci->subtree_rect);
+		subtree_global_rect.position += p_clip_rect.position;
+		if (!p_clip_rect.intersects(subtree_global_rect, true)) {
+			return;
+		}
+	}
+
 	Rect2 global_rect = xform.xform(rect);
 	global_rect.position += p_clip_rect.position;
 
@@ -442,6 +514,7 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 		} else if (canvas_item_owner.owns(canvas_item->parent)) {
 			Item *item_owner = canvas_item_owner.get_or_null(canvas_item->parent);
 			item_owner->child_items.erase(canvas_item);
+			_mark_subtree_rect_dirty(item_owner);
 
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -462,6 +535,7 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 			Item *item_owner = canvas_item_owner.get_or_null(p_parent);
 			item_owner->child_items.push_back(canvas_item);
 			item_owner->children_order_dirty = true;
+			_mark_subtree_rect_dirty(item_owner);
 
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -478,6 +552,7 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 void RendererCanvasCull::canvas_item_set_visible(RID p_item, bool p_visible) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	canvas_item->visible = p_visible;
 
@@ -494,6 +569,7 @@ void RendererCanvasCull::canvas_item_set_light_mask(RID p_item, int p_mask) {
 void RendererCanvasCull::canvas_item_set_transform(RID p_item, const Transform2D &p_transform) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	canvas_item->xform = p_transform;
 }
@@ -515,6 +591,7 @@ void RendererCanvasCull::canvas_item_set_distance_field_mode(RID p_item, bool p_
 void RendererCanvasCull::canvas_item_set_custom_rect(RID p_item, bool p_custom_rect, const Rect2 &p_rect) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	canvas_item->custom_rect = p_custom_rect;
 	canvas_item->rect = p_rect;
@@ -551,6 +628,7 @@ void RendererCanvasCull::canvas_item_set_update_when_visible(RID p_item, bool p_
 void RendererCanvasCull::canvas_item_add_line(RID p_item, const Point2 &p_from, const Point2 &p_to, const Color &p_color, float p_width) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandPrimitive *line = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_COND(!line);
@@ -575,6 +653,7 @@ void RendererCanvasCull::canvas_item_add_polyline(RID p_item, const Vector<Point
 	ERR_FAIL_COND(p_points.size() < 2);
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Color color = Color(1, 1, 1, 1);
 
@@ -716,6 +795,7 @@ void RendererCanvasCull::canvas_item_add_multiline(RID p_item, const Vector<Poin
 	ERR_FAIL_COND(p_points.size() < 2);
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandPolygon *pline = canvas_item->alloc_command<Item::CommandPolygon>();
 	ERR_FAIL_COND(!pline);
@@ -732,6 +812,7 @@ void RendererCanvasCull::canvas_item_add_multiline(RID p_item, const Vector<Poin
 void RendererCanvasCull::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, const Color &p_color) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_COND(!rect);
@@ -742,6 +823,7 @@ void RendererCanvasCull::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, c
 void RendererCanvasCull::canvas_item_add_circle(RID p_item, const Point2 &p_pos, float p_radius, const Color &p_color) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandPolygon *circle = canvas_item->alloc_command<Item::CommandPolygon>();
 	ERR_FAIL_COND(!circle);
@@ -778,6 +860,7 @@ void RendererCanvasCull::canvas_item_add_circle(RID p_item, const Point2 &p_pos,
 void RendererCanvasCull::canvas_item_add_texture_rect(RID p_item, const Rect2 &p_rect, RID p_texture, bool p_tile, const Color &p_modulate, bool p_transpose) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_COND(!rect);
@@ -809,6 +892,7 @@ void RendererCanvasCull::canvas_item_add_texture_rect(RID p_item, const Rect2 &p
 void RendererCanvasCull::canvas_item_add_msdf_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, int p_outline_size, float p_px_range) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_COND(!rect);
@@ -843,6 +927,7 @@ void RendererCanvasCull::canvas_item_add_msdf_texture_rect_region(RID p_item, co
 void RendererCanvasCull::canvas_item_add_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, bool p_transpose, bool p_clip_uv) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_COND(!rect);
@@ -884,6 +969,7 @@ void RendererCanvasCull::canvas_item_add_texture_rect_region(RID p_item, const R
 void RendererCanvasCull::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_rect, const Rect2 &p_source, RID p_texture, const Vector2 &p_topleft, const Vector2 &p_bottomright, RS::NinePatchAxisMode p_x_axis_mode, RS::NinePatchAxisMode p_y_axis_mode, bool p_draw_center, const Color &p_modulate) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandNinePatch *style = canvas_item->alloc_command<Item::CommandNinePatch>();
 	ERR_FAIL_COND(!style);
@@ -908,6 +994,7 @@ void RendererCanvasCull::canvas_item_add_primitive(RID p_item, const Vector<Poin
 
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandPrimitive *prim = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_COND(!prim);
@@ -934,6 +1021,7 @@ void RendererCanvasCull::canvas_item_add_primitive(RID p_item, const Vector<Poin
 void RendererCanvasCull::canvas_item_add_polygon(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 #ifdef DEBUG_ENABLED
 	int pointcount = p_points.size();
 	ERR_FAIL_COND(pointcount < 3);
@@ -955,6 +1043,7 @@ void RendererCanvasCull::canvas_item_add_polygon(RID p_item, const Vector<Point2
 void RendererCanvasCull::canvas_item_add_triangle_array(RID p_item, const Vector<int> &p_indices, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, const Vector<int> &p_bones, const Vector<float> &p_weights, RID p_texture, int p_count) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	int vertex_count = p_points.size();
 	ERR_FAIL_COND(vertex_count == 0);
@@ -978,6 +1067,7 @@ void RendererCanvasCull::canvas_item_add_triangle_array(RID p_item, const Vector
 void RendererCanvasCull::canvas_item_add_set_transform(RID p_item, const Transform2D &p_transform) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandTransform *tr = canvas_item->alloc_command<Item::CommandTransform>();
 	ERR_FAIL_COND(!tr);
@@ -987,6 +1077,7 @@ void RendererCanvasCull::canvas_item_add_set_transform(RID p_item, const Transfo
 void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, const Transform2D &p_transform, const Color &p_modulate, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 	ERR_FAIL_COND(!p_mesh.is_valid());
 
 	Item::CommandMesh *m = canvas_item->alloc_command<Item::CommandMesh>();
@@ -1006,6 +1097,7 @@ void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, con
 void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandParticles *part = canvas_item->alloc_command<Item::CommandParticles>();
 	ERR_FAIL_COND(!part);
@@ -1020,6 +1112,7 @@ void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles,
 void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandMultiMesh *mm = canvas_item->alloc_command<Item::CommandMultiMesh>();
 	ERR_FAIL_COND(!mm);
@@ -1031,6 +1124,7 @@ void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p
 void RendererCanvasCull::canvas_item_add_clip_ignore(RID p_item, bool p_ignore) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandClipIgnore *ci = canvas_item->alloc_command<Item::CommandClipIgnore>();
 	ERR_FAIL_COND(!ci);
@@ -1040,6 +1134,7 @@ void RendererCanvasCull::canvas_item_add_clip_ignore(RID p_item, bool p_ignore)
 void RendererCanvasCull::canvas_item_add_animation_slice(RID p_item, double p_animation_length, double p_slice_begin, double p_slice_end, double p_offset) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	Item::CommandAnimationSlice *as = canvas_item->alloc_command<Item::CommandAnimationSlice>();
 	ERR_FAIL_COND(!as);
@@ -1106,6 +1201,7 @@ void RendererCanvasCull::canvas_item_attach_skeleton(RID p_item, RID p_skeleton)
 void RendererCanvasCull::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_enable, const Rect2 &p_rect) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 	if (p_enable && (canvas_item->copy_back_buffer == nullptr)) {
 		canvas_item->copy_back_buffer = memnew(RendererCanvasRender::Item::CopyBackBuffer);
 	}
@@ -1123,6 +1219,7 @@ void RendererCanvasCull::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_e
 void RendererCanvasCull::canvas_item_clear(RID p_item) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	canvas_item->clear();
 }
@@ -1163,6 +1260,7 @@ void RendererCanvasCull::canvas_item_set_use_parent_material(RID p_item, bool p_
 void RendererCanvasCull::canvas_item_set_visibility_notifier(RID p_item, bool p_enable, const Rect2 &p_area, const Callable &p_enter_callable, const Callable &p_exit_callable) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	if (p_enable) {
 		if (!canvas_item->visibility_notifier) {
@@ -1183,6 +1281,7 @@ void RendererCanvasCull::canvas_item_set_visibility_notifier(RID p_item, bool p_
 void RendererCanvasCull::canvas_item_set_canvas_group_mode(RID p_item, RS::CanvasGroupMode p_mode, float p_clear_margin, bool p_fit_empty, float p_fit_margin, bool p_blur_mipmaps) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_subtree_rect_dirty(canvas_item);
 
 	if (p_mode == RS::CANVAS_GROUP_MODE_DISABLED) {
 		if (canvas_item->canvas_group != nullptr) {
@@ -1397,6 +1496,33 @@ void RendererCanvasCull::canvas_light_set_shadow_smooth(RID p_light, float p_smo
 	clight->shadow_smooth = p_smooth;
 }
 
+void RendererCanvasCull::_light_occluder_update_bvh(RendererCanvasRender::LightOccluderInstance *p_occluder) {
+	if (p_occluder->canvas.is_null()) {
+		return;
+	}
+
+	Canvas *canvas = canvas_owner.get_or_null(p_occluder->canvas);
+	Rect2 bounds = p_occluder->xform.xform(p_occluder->aabb_cache);
+
+	if (p_occluder->bvh_id == 0) {
+		p_occluder->bvh_id = canvas->occluder_bvh.create(p_occluder, true, bounds) + 1;
+	} else {
+		canvas->occluder_bvh.move(p_occluder->bvh_id - 1, bounds);
+	}
+}
+
+void RendererCanvasCull::_light_occluder_remove_from_bvh(RendererCanvasRender::LightOccluderInstance *p_occluder) {
+	if (p_occluder->bvh_id == 0) {
+		return;
+	}
+
+	Canvas *canvas = canvas_owner.get_or_null(p_occluder->canvas);
+	if (canvas) {
+		canvas->occluder_bvh.erase(p_occluder->bvh_id - 1);
+	}
+	p_occluder->bvh_id = 0;
+}
+
 RID RendererCanvasCull::canvas_light_occluder_allocate() {
 	return canvas_light_occluder_owner.allocate_rid();
 }
@@ -1409,6 +1535,7 @@ void RendererCanvasCull::canvas_light_occluder_attach_to_canvas(RID p_occluder,
 	ERR_FAIL_COND(!occluder);
 
 	if (occluder->canvas.is_valid()) {
+		_light_occluder_remove_from_bvh(occluder);
 		Canvas *canvas = canvas_owner.get_or_null(occluder->canvas);
 		canvas->occluders.erase(occluder);
 	}
@@ -1422,6 +1549,7 @@ void RendererCanvasCull::canvas_light_occluder_attach_to_canvas(RID p_occluder,
 	if (occluder->canvas.is_valid()) {
 		Canvas *canvas = canvas_owner.get_or_null(occluder->canvas);
 		canvas->occluders.insert(occluder);
+		_light_occluder_update_bvh(occluder);
 	}
 }
 
@@ -1458,6 +1586,8 @@ void RendererCanvasCull::canvas_light_occluder_set_polygon(RID p_occluder, RID p
 			occluder->cull_cache = occluder_poly->cull_mode;
 		}
 	}
+
+	_light_occluder_update_bvh(occluder);
 }
 
 void RendererCanvasCull::canvas_light_occluder_set_as_sdf_collision(RID p_occluder, bool p_enable) {
@@ -1470,6 +1600,7 @@ void RendererCanvasCull::canvas_light_occluder_set_transform(RID p_occluder, con
 	ERR_FAIL_COND(!occluder);
 
 	occluder->xform = p_xform;
+	_light_occluder_update_bvh(occluder);
 }
 
 void RendererCanvasCull::canvas_light_occluder_set_light_mask(RID p_occluder, int p_mask) {
@@ -1509,6 +1640,7 @@ void RendererCanvasCull::canvas_occluder_polygon_set_shape(RID p_occluder_polygo
 
 	for (Set<RendererCanvasRender::LightOccluderInstance *>::Element *E = occluder_poly->owners.front(); E; E = E->next()) {
 		E->get()->aabb_cache = occluder_poly->aabb;
+		_light_occluder_update_bvh(E->get());
 	}
 }
 
@@ -1598,6 +1730,17 @@ void RendererCanvasCull::update_visibility_notifiers() {
 	}
 }
 
+void RendererCanvasCull::_mark_subtree_rect_dirty(Item *p_canvas_item) {
+	p_canvas_item->subtree_rect_dirty = true;
+
+	// Ancestors of a dirty item are always dirty too, so stop at the first one.
+	Item *ci = canvas_item_owner.owns(p_canvas_item->parent) ? canvas_item_owner.get_or_null(p_canvas_item->parent) : nullptr;
+	while (ci && !ci->subtree_rect_dirty) {
+		ci->subtree_rect_dirty = true;
+		ci = canvas_item_owner.owns(ci->parent) ? canvas_item_owner.get_or_null(ci->parent) : nullptr;
+	}
+}
+
 bool RendererCanvasCull::free(RID p_rid) {
 	if (canvas_owner.owns(p_rid)) {
 		Canvas *canvas = canvas_owner.get_or_null(p_rid);
@@ -1624,6 +1767,7 @@ bool RendererCanvasCull::free(RID p_rid) {
 
 		for (Set<RendererCanvasRender::LightOccluderInstance *>::Element *E = canvas->occluders.front(); E; E = E->next()) {
 			E->get()->canvas = RID();
+			E->get()->bvh_id = 0;
 		}
 
 		canvas_owner.free(p_rid);
@@ -1639,6 +1783,7 @@ bool RendererCanvasCull::free(RID p_rid) {
 			} else if (canvas_item_owner.owns(canvas_item->parent)) {
 				Item *item_owner = canvas_item_owner.get_or_null(canvas_item->parent);
 				item_owner->child_items.erase(canvas_item);
+				_mark_subtree_rect_dirty(item_owner);
 
 				if (item_owner->sort_y) {
 					_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -1689,6 +1834,7 @@ bool RendererCanvasCull::free(RID p_rid) {
 		}
 
 		if (occluder->canvas.is_valid() && canvas_owner.owns(occluder->canvas)) {
+			_light_occluder_remove_from_bvh(occluder);
 			Canvas *canvas = canvas_owner.get_or_null(occluder->canvas);
 			canvas->occluders.erase(occluder);
 		}
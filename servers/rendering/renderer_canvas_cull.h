@@ -31,6 +31,7 @@
 #ifndef RENDERING_SERVER_CANVAS_CULL_H
 #define RENDERING_SERVER_CANVAS_CULL_H
 
+#include "core/math/bvh.h"
 #include "core/templates/paged_allocator.h"
 #include "renderer_compositor.h"
 #include "renderer_viewport.h"
@@ -56,6 +57,12 @@ public:
 
 		Vector<Item *> child_items;
 
+		// Bounds of the item and its visible descendants in local space, so subtrees outside the viewport can be skipped without visiting them.
+		Rect2 subtree_rect;
+		bool subtree_rect_dirty;
+		bool subtree_rect_empty;
+		bool subtree_volatile; // Contains content whose rect can change on its own, never skipped.
+
 		struct VisibilityNotifierData {
 			Rect2 area;
 			Callable enter_callable;
@@ -84,6 +91,9 @@ public:
 			ysort_xform = Transform2D();
 			ysort_pos = Vector2();
 			ysort_index = 0;
+			subtree_rect_dirty = true;
+			subtree_rect_empty = true;
+			subtree_volatile = false;
 		}
 	};
 
@@ -134,6 +144,8 @@ public:
 		Set<RendererCanvasRender::Light *> directional_lights;
 
 		Set<RendererCanvasRender::LightOccluderInstance *> occluders;
+		//occluder bounds in canvas space, so each light only looks at the ones around it
+		BVH_Manager<RendererCanvasRender::LightOccluderInstance, false, 32, Rect2, Vector2> occluder_bvh;
 
 		bool children_order_dirty;
 		Vector<ChildItem> child_items;
@@ -178,6 +190,9 @@ public:
 
 private:
 	void _render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel);
+	void _mark_subtree_rect_dirty(Item *p_canvas_item);
+	void _light_occluder_update_bvh(RendererCanvasRender::LightOccluderInstance *p_occluder);
+	void _light_occluder_remove_from_bvh(RendererCanvasRender::LightOccluderInstance *p_occluder);
 	void _cull_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **z_list, RendererCanvasRender::Item **z_last_list, Item *p_canvas_clip, Item *p_material_owner, bool allow_y_sort);
 
 	RendererCanvasRender::Item **z_list;
@@ -588,11 +588,13 @@ public:
 		int light_mask;
 		bool sdf_collision;
 		RS::CanvasOccluderPolygonCullMode cull_cache;
+		uint32_t bvh_id; //handle in the canvas occluder BVH plus one, zero if not in it
 
 		LightOccluderInstance *next;
 
 		LightOccluderInstance() {
 			enabled = true;
+			bvh_id = 0;
 			sdf_collision = false;
 			next = nullptr;
 			light_mask = 1;
@@ -1425,6 +1425,7 @@ void EffectsRD::generate_ssao(RID p_depth_buffer, RID p_normal_buffer, RID p_dep
 		ssao.gather_push_constant.detail_intensity = p_settings.detail;
 		ssao.gather_push_constant.quality = MAX(0, p_settings.quality - 1);
 		ssao.gather_push_constant.size_multiplier = p_settings.half_size ? 2 : 1;
+		ssao.gather_push_constant.rotation_offset = p_settings.rotation_offset;
 
 		if (p_invalidate_uniform_sets) {
 			Vector<RD::Uniform> uniforms;
@@ -1618,6 +1619,30 @@ void EffectsRD::generate_ssao(RID p_depth_buffer, RID p_normal_buffer, RID p_dep
 	RD::get_singleton()->buffer_update(ssao.importance_map_load_counter, 0, sizeof(uint32_t), &zero, 0); //no barrier
 }
 
+void EffectsRD::ssao_temporal_reprojection(RID p_depth_buffer, RID p_ao, RID p_history, RID p_dest_history, const CameraMatrix &p_projection, const CameraMatrix &p_reprojection, const Size2i &p_screen_size, float p_amount, bool p_use_history) {
+	store_camera(p_reprojection, ssao.temporal_push_constant.reprojection);
+	ssao.temporal_push_constant.screen_size[0] = p_screen_size.x;
+	ssao.temporal_push_constant.screen_size[1] = p_screen_size.y;
+	ssao.temporal_push_constant.z_near = p_projection.get_z_near();
+	ssao.temporal_push_constant.z_far = p_projection.get_z_far();
+	ssao.temporal_push_constant.blend = p_amount;
+	ssao.temporal_push_constant.depth_tolerance = 0.05;
+	ssao.temporal_push_constant.orthogonal = p_projection.is_orthogonal();
+	ssao.temporal_push_constant.use_history = p_use_history;
+
+	RD::ComputeListID compute_list = RD::get_singleton()->compute_list_begin();
+	RD::get_singleton()->draw_command_begin_label("SSAO Temporal Reprojection");
+	RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, ssao.pipelines[SSAO_TEMPORAL]);
+	RD::get_singleton()->compute_list_bind_uniform_set(compute_list, _get_compute_uniform_set_from_texture(p_depth_buffer), 0);
+	RD::get_singleton()->compute_list_bind_uniform_set(compute_list, _get_compute_uniform_set_from_texture(p_history), 1);
+	RD::get_singleton()->compute_list_bind_uniform_set(compute_list, _get_uniform_set_from_image(p_ao), 2);
+	RD::get_singleton()->compute_list_bind_uniform_set(compute_list, _get_uniform_set_from_image(p_dest_history), 3);
+	RD::get_singleton()->compute_list_set_push_constant(compute_list, &ssao.temporal_push_constant, sizeof(SSAOTemporalPushConstant));
+	RD::get_singleton()->compute_list_dispatch_threads(compute_list, p_screen_size.x, p_screen_size.y, 1);
+	RD::get_singleton()->draw_command_end_label();
+	RD::get_singleton()->compute_list_end();
+}
+
 void EffectsRD::roughness_limit(RID p_source_normal, RID p_roughness, const Size2i &p_size, float p_curve) {
 	roughness_limiter.push_constant.screen_size[0] = p_size.x;
 	roughness_limiter.push_constant.screen_size[1] = p_size.y;
@@ -1887,6 +1912,85 @@ void EffectsRD::sort_buffer(RID p_uniform_set, int p_size) {
 	RD::get_singleton()->compute_list_end();
 }
 
+#define RADIX_SORT_TILE_SIZE 1024
+
+uint32_t EffectsRD::radix_sort_get_histogram_size(uint32_t p_size) {
+	uint32_t tile_count = (p_size + RADIX_SORT_TILE_SIZE - 1) / RADIX_SORT_TILE_SIZE;
+	return MAX(1u, tile_count) * 256 * sizeof(uint32_t);
+}
+
+void EffectsRD::radix_sort_buffer(RID p_buffer, RID p_temp_buffer, RID p_histogram_buffer, uint32_t p_size) {
+	if (p_size == 0) {
+		return;
+	}
+
+	RID uniform_set;
+	if (radix_sort.uniform_set_cache.has(p_buffer)) {
+		uniform_set = radix_sort.uniform_set_cache[p_buffer];
+	}
+
+	if (!uniform_set.is_valid() || !RD::get_singleton()->uniform_set_is_valid(uniform_set)) {
+		Vector<RD::Uniform> uniforms;
+		{
+			RD::Uniform u;
+			u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.binding = 0;
+			u.ids.push_back(p_buffer);
+			uniforms.push_back(u);
+		}
+		{
+			RD::Uniform u;
+			u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.binding = 1;
+			u.ids.push_back(p_temp_buffer);
+			uniforms.push_back(u);
+		}
+		{
+			RD::Uniform u;
+			u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.binding = 2;
+			u.ids.push_back(p_histogram_buffer);
+			uniforms.push_back(u);
+		}
+		uniform_set = RD::get_singleton()->uniform_set_create(uniforms, radix_sort.shader.version_get_shader(radix_sort.shader_version, 0), 0);
+		radix_sort.uniform_set_cache[p_buffer] = uniform_set;
+	}
+
+	RadixSort::PushConstant push_constant;
+	push_constant.total_elements = p_size;
+	push_constant.tile_count = (p_size + RADIX_SORT_TILE_SIZE - 1) / RADIX_SORT_TILE_SIZE;
+
+	RD::ComputeListID compute_list = RD::get_singleton()->compute_list_begin();
+
+	// Four passes of 8 bits, the even count leaves the result in p_buffer.
+	for (uint32_t i = 0; i < 4; i++) {
+		push_constant.shift = i * 8;
+		push_constant.from_temp = i & 1;
+
+		RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, radix_sort.pipelines[RADIX_SORT_MODE_HISTOGRAM]);
+		RD::get_singleton()->compute_list_bind_uniform_set(compute_list, uniform_set, 0);
+		RD::get_singleton()->compute_list_set_push_constant(compute_list, &push_constant, sizeof(RadixSort::PushConstant));
+		RD::get_singleton()->compute_list_dispatch(compute_list, push_constant.tile_count, 1, 1);
+		RD::get_singleton()->compute_list_add_barrier(compute_list);
+
+		RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, radix_sort.pipelines[RADIX_SORT_MODE_SCAN]);
+		RD::get_singleton()->compute_list_bind_uniform_set(compute_list, uniform_set, 0);
+		RD::get_singleton()->compute_list_set_push_constant(compute_list, &push_constant, sizeof(RadixSort::PushConstant));
+		RD::get_singleton()->compute_list_dispatch(compute_list, 1, 1, 1);
+		RD::get_singleton()->compute_list_add_barrier(compute_list);
+
+		RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, radix_sort.pipelines[RADIX_SORT_MODE_SCATTER]);
+		RD::get_singleton()->compute_list_bind_uniform_set(compute_list, uniform_set, 0);
+		RD::get_singleton()->compute_list_set_push_constant(compute_list, &push_constant, sizeof(RadixSort::PushConstant));
+		RD::get_singleton()->compute_list_dispatch(compute_list, push_constant.tile_count, 1, 1);
+		if (i < 3) {
+			RD::get_singleton()->compute_list_add_barrier(compute_list);
+		}
+	}
+
+	RD::get_singleton()->compute_list_end();
+}
+
 EffectsRD::EffectsRD(bool p_prefer_raster_effects) {
 	prefer_raster_effects = p_prefer_raster_effects;
 
@@ -2252,6 +2356,16 @@ EffectsRD::EffectsRD(bool p_prefer_raster_effects) {
 				pipeline++;
 			}
 		}
+		{
+			Vector<String> ssao_modes;
+			ssao_modes.push_back("\n");
+
+			ssao.temporal_shader.initialize(ssao_modes);
+
+			ssao.temporal_shader_version = ssao.temporal_shader.version_create();
+			ssao.pipelines[pipeline] = RD::get_singleton()->compute_pipeline_create(ssao.temporal_shader.version_get_shader(ssao.temporal_shader_version, 0));
+			pipeline++;
+		}
 
 		ERR_FAIL_COND(pipeline != SSAO_MAX);
 	}
@@ -2476,6 +2590,21 @@ EffectsRD::EffectsRD(bool p_prefer_raster_effects) {
 		}
 	}
 
+	{
+		Vector<String> radix_sort_modes;
+		radix_sort_modes.push_back("\n#define MODE_HISTOGRAM\n");
+		radix_sort_modes.push_back("\n#define MODE_SCAN\n");
+		radix_sort_modes.push_back("\n#define MODE_SCATTER\n");
+
+		radix_sort.shader.initialize(radix_sort_modes);
+
+		radix_sort.shader_version = radix_sort.shader.version_create();
+
+		for (int i = 0; i < RADIX_SORT_MODE_MAX; i++) {
+			radix_sort.pipelines[i] = RD::get_singleton()->compute_pipeline_create(radix_sort.shader.version_get_shader(radix_sort.shader_version, i));
+		}
+	}
+
 	RD::SamplerState sampler;
 	sampler.mag_filter = RD::SAMPLER_FILTER_LINEAR;
 	sampler.min_filter = RD::SAMPLER_FILTER_LINEAR;
@@ -2545,6 +2674,7 @@ EffectsRD::~EffectsRD() {
 		ssao.gather_shader.version_free(ssao.gather_shader_version);
 		ssao.downsample_shader.version_free(ssao.downsample_shader_version);
 		ssao.interleave_shader.version_free(ssao.interleave_shader_version);
+		ssao.temporal_shader.version_free(ssao.temporal_shader_version);
 		ssao.importance_map_shader.version_free(ssao.importance_map_shader_version);
 		roughness_limiter.shader.version_free(roughness_limiter.shader_version);
 		ssr.shader.version_free(ssr.shader_version);
@@ -2559,5 +2689,6 @@ EffectsRD::~EffectsRD() {
 	copy_to_fb.shader.version_free(copy_to_fb.shader_version);
 	cube_to_dp.shader.version_free(cube_to_dp.shader_version);
 	sort.shader.version_free(sort.shader_version);
+	radix_sort.shader.version_free(radix_sort.shader_version);
 	tonemap.shader.version_free(tonemap.shader_version);
 }
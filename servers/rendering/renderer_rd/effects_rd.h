@@ -47,6 +47,7 @@
 #include "servers/rendering/renderer_rd/shaders/cubemap_roughness_raster.glsl.gen.h"
 #include "servers/rendering/renderer_rd/shaders/luminance_reduce.glsl.gen.h"
 #include "servers/rendering/renderer_rd/shaders/luminance_reduce_raster.glsl.gen.h"
+#include "servers/rendering/renderer_rd/shaders/radix_sort.glsl.gen.h"
 #include "servers/rendering/renderer_rd/shaders/resolve.glsl.gen.h"
 #include "servers/rendering/renderer_rd/shaders/roughness_limiter.glsl.gen.h"
 #include "servers/rendering/renderer_rd/shaders/screen_space_reflection.glsl.gen.h"
@@ -59,6 +60,7 @@
 #include "servers/rendering/renderer_rd/shaders/ssao_downsample.glsl.gen.h"
 #include "servers/rendering/renderer_rd/shaders/ssao_importance_map.glsl.gen.h"
 #include "servers/rendering/renderer_rd/shaders/ssao_interleave.glsl.gen.h"
+#include "servers/rendering/renderer_rd/shaders/ssao_temporal.glsl.gen.h"
 #include "servers/rendering/renderer_rd/shaders/subsurface_scattering.glsl.gen.h"
 #include "servers/rendering/renderer_rd/shaders/tonemap.glsl.gen.h"
 #include "servers/rendering/renderer_scene_render.h"
@@ -395,6 +397,7 @@ private:
 		SSAO_INTERLEAVE,
 		SSAO_INTERLEAVE_SMART,
 		SSAO_INTERLEAVE_HALF,
+		SSAO_TEMPORAL,
 		SSAO_MAX
 	};
 
@@ -419,7 +422,8 @@ private:
 		float NDC_to_view_mul[2];
 		float NDC_to_view_add[2];
 
-		float pad[2];
+		uint32_t rotation_offset;
+		float pad;
 		float half_screen_pixel_size_x025[2];
 
 		float radius;
@@ -463,6 +467,19 @@ private:
 		float pixel_size[2];
 	};
 
+	struct SSAOTemporalPushConstant {
+		float reprojection[16];
+
+		int32_t screen_size[2];
+		float z_near;
+		float z_far;
+
+		float blend;
+		float depth_tolerance;
+		uint32_t orthogonal;
+		uint32_t use_history;
+	};
+
 	struct SSAO {
 		SSAODownsamplePushConstant downsample_push_constant;
 		SsaoDownsampleShaderRD downsample_shader;
@@ -488,6 +505,10 @@ private:
 		SsaoInterleaveShaderRD interleave_shader;
 		RID interleave_shader_version;
 
+		SSAOTemporalPushConstant temporal_push_constant;
+		SsaoTemporalShaderRD temporal_shader;
+		RID temporal_shader_version;
+
 		RID mirror_sampler;
 		RID pipelines[SSAO_MAX];
 	} ssao;
@@ -704,6 +725,27 @@ private:
 		RID pipelines[SORT_MODE_MAX];
 	} sort;
 
+	enum RadixSortMode {
+		RADIX_SORT_MODE_HISTOGRAM,
+		RADIX_SORT_MODE_SCAN,
+		RADIX_SORT_MODE_SCATTER,
+		RADIX_SORT_MODE_MAX
+	};
+
+	struct RadixSort {
+		struct PushConstant {
+			uint32_t total_elements;
+			uint32_t tile_count;
+			uint32_t shift;
+			uint32_t from_temp;
+		};
+
+		RadixSortShaderRD shader;
+		RID shader_version;
+		RID pipelines[RADIX_SORT_MODE_MAX];
+		Map<RID, RID> uniform_set_cache; // Keyed by the buffer being sorted.
+	} radix_sort;
+
 	RID default_sampler;
 	RID default_mipmap_sampler;
 	RID index_buffer;
@@ -849,6 +891,7 @@ public:
 		int blur_passes = 2;
 		float fadeout_from = 50.0;
 		float fadeout_to = 300.0;
+		uint32_t rotation_offset = 0;
 
 		Size2i full_screen_size = Size2i();
 		Size2i half_screen_size = Size2i();
@@ -860,6 +903,7 @@ public:
 
 	void gather_ssao(RD::ComputeListID p_compute_list, const Vector<RID> p_ao_slices, const SSAOSettings &p_settings, bool p_adaptive_base_pass, RID p_gather_uniform_set, RID p_importance_map_uniform_set);
 	void generate_ssao(RID p_depth_buffer, RID p_normal_buffer, RID p_depth_mipmaps_texture, const Vector<RID> &depth_mipmaps, RID p_ao, const Vector<RID> p_ao_slices, RID p_ao_pong, const Vector<RID> p_ao_pong_slices, RID p_upscale_buffer, RID p_importance_map, RID p_importance_map_pong, const CameraMatrix &p_projection, const SSAOSettings &p_settings, bool p_invalidate_uniform_sets, RID &r_downsample_uniform_set, RID &r_gather_uniform_set, RID &r_importance_map_uniform_set);
+	void ssao_temporal_reprojection(RID p_depth_buffer, RID p_ao, RID p_history, RID p_dest_history, const CameraMatrix &p_projection, const CameraMatrix &p_reprojection, const Size2i &p_screen_size, float p_amount, bool p_use_history);
 
 	void roughness_limit(RID p_source_normal, RID p_roughness, const Size2i &p_size, float p_curve);
 	void cubemap_downsample(RID p_source_cubemap, RID p_dest_cubemap, const Size2i &p_size);
@@ -876,6 +920,11 @@ public:
 
 	void sort_buffer(RID p_uniform_set, int p_size);
 
+	// Sorts the same vec2 elements as sort_buffer() in linear time, for large buffers. The temp buffer must hold as many elements,
+	// and the histogram buffer radix_sort_get_histogram_size() bytes.
+	static uint32_t radix_sort_get_histogram_size(uint32_t p_size);
+	void radix_sort_buffer(RID p_buffer, RID p_temp_buffer, RID p_histogram_buffer, uint32_t p_size);
+
 	EffectsRD(bool p_prefer_raster_effects);
 	~EffectsRD();
 };
@@ -386,7 +386,8 @@ void RenderForwardClustered::_render_list_template(RenderingDevice::DrawListID p
 		}
 
 		RS::PrimitiveType primitive = surf->primitive;
-		RID xforms_uniform_set = surf->owner->transforms_uniform_set;
+		bool use_indirect = p_params->use_indirect_draws && surf->owner->indirect_pass == indirect_draw_pass;
+		RID xforms_uniform_set = use_indirect ? surf->owner->culled_transforms_uniform_set : surf->owner->transforms_uniform_set;
 
 		SceneShaderForwardClustered::ShaderVersion shader_version = SceneShaderForwardClustered::SHADER_VERSION_MAX; // Assigned to silence wrong -Wmaybe-initialized.
 
@@ -499,13 +500,20 @@ void RenderForwardClustered::_render_list_template(RenderingDevice::DrawListID p
 
 		RD::get_singleton()->draw_list_set_push_constant(draw_list, &push_constant, sizeof(SceneState::PushConstant));
 
-		uint32_t instance_count = surf->owner->instance_count > 1 ? surf->owner->instance_count : element_info.repeat;
+		// When rendering with threads a run of equal elements can be cut by the end of this range, the rest is drawn by the next thread.
+		uint32_t repeat = MIN(element_info.repeat, p_to_element - i);
+		uint32_t instance_count = surf->owner->instance_count > 1 ? surf->owner->instance_count : repeat;
 		if (surf->flags & GeometryInstanceSurfaceDataCache::FLAG_USES_PARTICLE_TRAILS) {
 			instance_count /= surf->owner->trail_steps;
 		}
 
-		RD::get_singleton()->draw_list_draw(draw_list, index_array_rd.is_valid(), instance_count);
-		i += element_info.repeat - 1; //skip equal elements
+		if (use_indirect) {
+			// Instance count was written by the culling or particle compaction shaders.
+			RD::get_singleton()->draw_list_draw_indirect(draw_list, index_array_rd.is_valid(), surf->owner->indirect_command_buffer, surf->indirect_command * sizeof(uint32_t) * 5, 1, sizeof(uint32_t) * 5);
+		} else {
+			RD::get_singleton()->draw_list_draw(draw_list, index_array_rd.is_valid(), instance_count);
+		}
+		i += repeat - 1; //skip equal elements
 	}
 
 	// Make the actual redraw request
@@ -563,7 +571,7 @@ void RenderForwardClustered::_render_list_with_threads(RenderListParameters *p_p
 	RD::FramebufferFormatID fb_format = RD::get_singleton()->framebuffer_get_format(p_framebuffer);
 	p_params->framebuffer_format = fb_format;
 
-	if ((uint32_t)p_params->element_count > render_list_thread_threshold && false) { // secondary command buffers need more testing at this time
+	if ((uint32_t)p_params->element_count > render_list_thread_threshold) {
 		//multi threaded
 		thread_draw_lists.resize(RendererThreadPool::singleton->thread_work_pool.get_thread_count());
 		RD::get_singleton()->draw_list_begin_split(p_framebuffer, thread_draw_lists.size(), thread_draw_lists.ptr(), p_initial_color_action, p_final_color_action, p_initial_depth_action, p_final_depth_action, p_clear_color_values, p_clear_depth, p_clear_stencil, p_region, p_storage_textures);
@@ -907,6 +915,92 @@ _FORCE_INLINE_ static uint32_t _indices_to_primitives(RS::PrimitiveType p_primit
 	static const uint32_t subtractor[RS::PRIMITIVE_MAX] = { 0, 0, 1, 0, 1 };
 	return (p_indices - subtractor[p_primitive]) / divisor[p_primitive];
 }
+void RenderForwardClustered::_cull_multimeshes_gpu(const RenderDataRD *p_render_data) {
+	if (p_render_data->view_count > 1) {
+		return; // A single frustum can't cull for all views.
+	}
+
+	Vector<Plane> planes = p_render_data->cam_projection.get_projection_planes(p_render_data->cam_transform);
+	ERR_FAIL_COND(planes.size() != 6);
+
+	LocalVector<uint32_t> draw_counts;
+
+	for (int l = RENDER_LIST_OPAQUE; l <= RENDER_LIST_ALPHA; l++) {
+		RenderList *rl = &render_list[l];
+		for (uint32_t i = 0; i < rl->elements.size(); i++) {
+			GeometryInstanceForwardClustered *inst = rl->elements[i]->owner;
+			if (inst->indirect_pass == indirect_draw_pass || inst->data->base_type != RS::INSTANCE_MULTIMESH || !storage->multimesh_uses_gpu_culling(inst->data->base)) {
+				continue;
+			}
+
+			RID mesh = storage->multimesh_get_mesh(inst->data->base);
+			uint32_t surface_count = storage->mesh_get_surface_count(mesh);
+			if (surface_count == 0) {
+				continue;
+			}
+
+			// The LOD was already chosen when filling the list, use its index count.
+			draw_counts.resize(surface_count);
+			for (uint32_t j = 0; j < surface_count; j++) {
+				draw_counts[j] = 0;
+			}
+			for (GeometryInstanceSurfaceDataCache *surf = inst->surface_caches; surf; surf = surf->next) {
+				if (surf->surface && surf->surface_index < surface_count) {
+					draw_counts[surf->surface_index] = storage->mesh_surface_get_draw_count(surf->surface, surf->sort.lod_index);
+				}
+				surf->indirect_command = surf->surface_index;
+			}
+
+			Transform3D inv_xform = inst->transform.affine_inverse();
+			Plane local_planes[6];
+			for (int j = 0; j < 6; j++) {
+				local_planes[j] = inv_xform.xform(planes[j]);
+			}
+
+			if (!storage->multimesh_gpu_cull(inst->data->base, indirect_draw_pass, local_planes, draw_counts.ptr(), surface_count)) {
+				continue;
+			}
+
+			inst->culled_transforms_uniform_set = storage->multimesh_get_culled_3d_uniform_set(inst->data->base, scene_shader.default_shader_rd, TRANSFORMS_UNIFORM_SET);
+			inst->indirect_command_buffer = storage->multimesh_get_command_buffer(inst->data->base);
+			inst->indirect_pass = indirect_draw_pass;
+		}
+	}
+}
+
+void RenderForwardClustered::_write_particles_draw_commands() {
+	LocalVector<uint32_t> draw_counts;
+	LocalVector<uint32_t> instance_multipliers;
+
+	for (int l = RENDER_LIST_OPAQUE; l <= RENDER_LIST_ALPHA; l++) {
+		RenderList *rl = &render_list[l];
+		for (uint32_t i = 0; i < rl->elements.size(); i++) {
+			GeometryInstanceForwardClustered *inst = rl->elements[i]->owner;
+			if (inst->indirect_pass == indirect_draw_pass || inst->data->base_type != RS::INSTANCE_PARTICLES || !storage->particles_uses_compaction(inst->data->base)) {
+				continue;
+			}
+
+			// One command per surface cache, as trail and non trail materials draw different instance counts.
+			draw_counts.clear();
+			instance_multipliers.clear();
+			for (GeometryInstanceSurfaceDataCache *surf = inst->surface_caches; surf; surf = surf->next) {
+				surf->indirect_command = draw_counts.size();
+				draw_counts.push_back(surf->surface ? storage->mesh_surface_get_draw_count(surf->surface, surf->sort.lod_index) : 0);
+				instance_multipliers.push_back((surf->flags & GeometryInstanceSurfaceDataCache::FLAG_USES_PARTICLE_TRAILS) ? 1 : inst->trail_steps);
+			}
+
+			if (draw_counts.is_empty() || !storage->particles_write_draw_commands(inst->data->base, indirect_draw_pass, draw_counts.ptr(), instance_multipliers.ptr(), draw_counts.size())) {
+				continue;
+			}
+
+			// Compaction happens in place, only the instance counts change.
+			inst->culled_transforms_uniform_set = inst->transforms_uniform_set;
+			inst->indirect_command_buffer = storage->particles_get_command_buffer(inst->data->base);
+			inst->indirect_pass = indirect_draw_pass;
+		}
+	}
+}
+
 void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, const RenderDataRD *p_render_data, PassMode p_pass_mode, bool p_using_sdfgi, bool p_using_opaque_gi, bool p_append) {
 	if (p_render_list == RENDER_LIST_OPAQUE) {
 		scene_state.used_sss = false;
@@ -1022,9 +1116,22 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 		}
 		inst->flags_cache = flags;
 
+		// Streamed textures are assumed to be mapped once over the longest side of the instance, so they need about as many texels as it covers pixels.
+		float stream_screen_size = 0.0;
+		if (p_render_list == RENDER_LIST_OPAQUE && p_render_data->texture_stream_pixel_scale > 0.0) {
+			stream_screen_size = inst->transformed_aabb.get_longest_axis_size() * p_render_data->texture_stream_pixel_scale;
+			if (!p_render_data->cam_ortogonal) {
+				stream_screen_size /= MAX(inst->depth + p_render_data->z_near, p_render_data->z_near);
+			}
+		}
+
 		GeometryInstanceSurfaceDataCache *surf = inst->surface_caches;
 
 		while (surf) {
+			if (stream_screen_size > 0.0 && surf->material->streamed_textures.size()) {
+				storage->material_data_request_streamed_textures(surf->material, stream_screen_size);
+			}
+
 			surf->sort.uses_forward_gi = 0;
 			surf->sort.uses_lightmap = 0;
 
@@ -1278,6 +1385,9 @@ void RenderForwardClustered::_render_scene(RenderDataRD *p_render_data, const Co
 	render_list[RENDER_LIST_ALPHA].sort_by_reverse_depth_and_priority();
 	_fill_instance_data(RENDER_LIST_OPAQUE, p_render_data->render_info ? p_render_data->render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE] : (int *)nullptr);
 	_fill_instance_data(RENDER_LIST_ALPHA);
+	indirect_draw_pass++;
+	_cull_multimeshes_gpu(p_render_data);
+	_write_particles_draw_commands();
 
 	RD::get_singleton()->draw_command_end_label();
 
@@ -1391,6 +1501,7 @@ void RenderForwardClustered::_render_scene(RenderDataRD *p_render_data, const Co
 
 		bool finish_depth = using_ssao || using_sdfgi || using_voxelgi;
 		RenderListParameters render_list_params(render_list[RENDER_LIST_OPAQUE].elements.ptr(), render_list[RENDER_LIST_OPAQUE].element_info.ptr(), render_list[RENDER_LIST_OPAQUE].elements.size(), reverse_cull, depth_pass_mode, render_buffer == nullptr, p_render_data->directional_light_soft_shadows, rp_uniform_set, get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_WIREFRAME, Vector2(), p_render_data->lod_camera_plane, p_render_data->lod_distance_multiplier, p_render_data->screen_lod_threshold);
+		render_list_params.use_indirect_draws = true;
 		_render_list_with_threads(&render_list_params, depth_framebuffer, needs_pre_resolve ? RD::INITIAL_ACTION_CONTINUE : RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_READ, needs_pre_resolve ? RD::INITIAL_ACTION_CONTINUE : RD::INITIAL_ACTION_CLEAR, finish_depth ? RD::FINAL_ACTION_READ : RD::FINAL_ACTION_CONTINUE, needs_pre_resolve ? Vector<Color>() : depth_pass_clear);
 
 		RD::get_singleton()->draw_command_end_label();
@@ -1448,6 +1559,7 @@ void RenderForwardClustered::_render_scene(RenderDataRD *p_render_data, const Co
 
 		RID framebuffer = using_separate_specular ? opaque_specular_framebuffer : opaque_framebuffer;
 		RenderListParameters render_list_params(render_list[RENDER_LIST_OPAQUE].elements.ptr(), render_list[RENDER_LIST_OPAQUE].element_info.ptr(), render_list[RENDER_LIST_OPAQUE].elements.size(), reverse_cull, using_separate_specular ? PASS_MODE_COLOR_SPECULAR : PASS_MODE_COLOR, render_buffer == nullptr, p_render_data->directional_light_soft_shadows, rp_uniform_set, get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_WIREFRAME, Vector2(), p_render_data->lod_camera_plane, p_render_data->lod_distance_multiplier, p_render_data->screen_lod_threshold);
+		render_list_params.use_indirect_draws = true;
 		_render_list_with_threads(&render_list_params, framebuffer, keep_color ? RD::INITIAL_ACTION_KEEP : RD::INITIAL_ACTION_CLEAR, will_continue_color ? RD::FINAL_ACTION_CONTINUE : RD::FINAL_ACTION_READ, depth_pre_pass ? (continue_depth ? RD::INITIAL_ACTION_CONTINUE : RD::INITIAL_ACTION_KEEP) : RD::INITIAL_ACTION_CLEAR, will_continue_depth ? RD::FINAL_ACTION_CONTINUE : RD::FINAL_ACTION_READ, c, 1.0, 0);
 		if (will_continue_color && using_separate_specular) {
 			// close the specular framebuffer, as it's no longer used
@@ -1555,6 +1667,7 @@ void RenderForwardClustered::_render_scene(RenderDataRD *p_render_data, const Co
 
 	{
 		RenderListParameters render_list_params(render_list[RENDER_LIST_ALPHA].elements.ptr(), render_list[RENDER_LIST_ALPHA].element_info.ptr(), render_list[RENDER_LIST_ALPHA].elements.size(), false, PASS_MODE_COLOR, render_buffer == nullptr, p_render_data->directional_light_soft_shadows, rp_uniform_set, get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_WIREFRAME, Vector2(), p_render_data->lod_camera_plane, p_render_data->lod_distance_multiplier, p_render_data->screen_lod_threshold);
+		render_list_params.use_indirect_draws = true;
 		_render_list_with_threads(&render_list_params, alpha_framebuffer, can_continue_color ? RD::INITIAL_ACTION_CONTINUE : RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_READ, can_continue_depth ? RD::INITIAL_ACTION_CONTINUE : RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_READ);
 	}
 
@@ -1586,7 +1699,7 @@ void RenderForwardClustered::_render_shadow_begin() {
 	scene_state.instance_data[RENDER_LIST_SECONDARY].clear();
 }
 
-void RenderForwardClustered::_render_shadow_append(RID p_framebuffer, const PagedArray<GeometryInstance *> &p_instances, const CameraMatrix &p_projection, const Transform3D &p_transform, float p_zfar, float p_bias, float p_normal_bias, bool p_use_dp, bool p_use_dp_flip, bool p_use_pancake, const Plane &p_camera_plane, float p_lod_distance_multiplier, float p_screen_lod_threshold, const Rect2i &p_rect, bool p_flip_y, bool p_clear_region, bool p_begin, bool p_end, RendererScene::RenderInfo *p_render_info) {
+void RenderForwardClustered::_render_shadow_append(RID p_framebuffer, const PagedArray<GeometryInstance *> &p_instances, const CameraMatrix &p_projection, const Transform3D &p_transform, float p_zfar, float p_bias, float p_normal_bias, bool p_use_dp, bool p_use_dp_flip, bool p_use_pancake, const Plane &p_camera_plane, float p_lod_distance_multiplier, float p_screen_lod_threshold, const Rect2i &p_rect, bool p_flip_y, bool p_clear_region, bool p_begin, bool p_end, RendererScene::RenderInfo *p_render_info, const ShadowStaticCache &p_static_cache) {
 	uint32_t shadow_pass_index = scene_state.shadow_passes.size();
 
 	SceneState::ShadowPass shadow_pass;
@@ -1642,6 +1755,13 @@ void RenderForwardClustered::_render_shadow_append(RID p_framebuffer, const Page
 		shadow_pass.initial_depth_action = p_begin ? (p_clear_region ? RD::INITIAL_ACTION_CLEAR_REGION : RD::INITIAL_ACTION_CLEAR) : (p_clear_region ? RD::INITIAL_ACTION_CLEAR_REGION_CONTINUE : RD::INITIAL_ACTION_CONTINUE);
 		shadow_pass.final_depth_action = p_end ? RD::FINAL_ACTION_READ : RD::FINAL_ACTION_CONTINUE;
 		shadow_pass.rect = p_rect;
+		shadow_pass.static_cache = p_static_cache;
+
+		if (p_static_cache.mode != SHADOW_STATIC_CACHE_DISABLED) {
+			// Copied from or to between passes, so the atlas must be readable before and after.
+			shadow_pass.initial_depth_action = p_static_cache.mode == SHADOW_STATIC_CACHE_STORE ? RD::INITIAL_ACTION_CLEAR_REGION : RD::INITIAL_ACTION_KEEP;
+			shadow_pass.final_depth_action = RD::FINAL_ACTION_READ;
+		}
 
 		scene_state.shadow_passes.push_back(shadow_pass);
 	}
@@ -1664,8 +1784,16 @@ void RenderForwardClustered::_render_shadow_end(uint32_t p_barrier) {
 
 	for (uint32_t i = 0; i < scene_state.shadow_passes.size(); i++) {
 		SceneState::ShadowPass &shadow_pass = scene_state.shadow_passes[i];
+		if (shadow_pass.static_cache.mode == SHADOW_STATIC_CACHE_RESTORE) {
+			_shadow_static_cache_copy(shadow_pass.static_cache.cache, shadow_pass.static_cache.atlas, shadow_pass.rect);
+		}
+
 		RenderListParameters render_list_parameters(render_list[RENDER_LIST_SECONDARY].elements.ptr() + shadow_pass.element_from, render_list[RENDER_LIST_SECONDARY].element_info.ptr() + shadow_pass.element_from, shadow_pass.element_count, shadow_pass.flip_cull, shadow_pass.pass_mode, true, false, shadow_pass.rp_uniform_set, false, Vector2(), shadow_pass.camera_plane, shadow_pass.lod_distance_multiplier, shadow_pass.screen_lod_threshold, shadow_pass.element_from, RD::BARRIER_MASK_NO_BARRIER);
 		_render_list_with_threads(&render_list_parameters, shadow_pass.framebuffer, RD::INITIAL_ACTION_DROP, RD::FINAL_ACTION_DISCARD, shadow_pass.initial_depth_action, shadow_pass.final_depth_action, Vector<Color>(), 1.0, 0, shadow_pass.rect);
+
+		if (shadow_pass.static_cache.mode == SHADOW_STATIC_CACHE_STORE) {
+			_shadow_static_cache_copy(shadow_pass.static_cache.atlas, shadow_pass.static_cache.cache, shadow_pass.rect);
+		}
 	}
 
 	if (p_barrier != RD::BARRIER_MASK_NO_BARRIER) {
@@ -2573,6 +2701,7 @@ void RenderForwardClustered::_geometry_instance_add_surface_with_material(Geomet
 	sdcache->flags = flags;
 
 	sdcache->shader = p_material->shader_data;
+	sdcache->material = p_material;
 	sdcache->material_uniform_set = p_material->uniform_set;
 	sdcache->surface = storage->mesh_get_surface(p_mesh, p_surface);
 	sdcache->primitive = storage->mesh_surface_get_primitive(sdcache->surface);
@@ -2617,17 +2746,17 @@ void RenderForwardClustered::_geometry_instance_add_surface(GeometryInstanceForw
 	SceneShaderForwardClustered::MaterialData *material = nullptr;
 
 	if (m_src.is_valid()) {
+		// Track the material even when falling back, so the instance is updated once its shader finishes compiling.
+		if (ginstance->data->dirty_dependencies) {
+			storage->material_update_dependency(m_src, &ginstance->data->dependency_tracker);
+		}
 		material = (SceneShaderForwardClustered::MaterialData *)storage->material_get_data(m_src, RendererStorageRD::SHADER_TYPE_3D);
 		if (!material || !material->shader_data->valid) {
 			material = nullptr;
 		}
 	}
 
-	if (material) {
-		if (ginstance->data->dirty_dependencies) {
-			storage->material_update_dependency(m_src, &ginstance->data->dependency_tracker);
-		}
-	} else {
+	if (!material) {
 		material = (SceneShaderForwardClustered::MaterialData *)storage->material_get_data(scene_shader.default_material, RendererStorageRD::SHADER_TYPE_3D);
 		m_src = scene_shader.default_material;
 	}
@@ -2638,13 +2767,13 @@ void RenderForwardClustered::_geometry_instance_add_surface(GeometryInstanceForw
 
 	while (material->next_pass.is_valid()) {
 		RID next_pass = material->next_pass;
+		if (ginstance->data->dirty_dependencies) {
+			storage->material_update_dependency(next_pass, &ginstance->data->dependency_tracker);
+		}
 		material = (SceneShaderForwardClustered::MaterialData *)storage->material_get_data(next_pass, RendererStorageRD::SHADER_TYPE_3D);
 		if (!material || !material->shader_data->valid) {
 			break;
 		}
-		if (ginstance->data->dirty_dependencies) {
-			storage->material_update_dependency(next_pass, &ginstance->data->dependency_tracker);
-		}
 		_geometry_instance_add_surface_with_material(ginstance, p_surface, material, next_pass.get_local_index(), storage->material_get_shader_id(next_pass), p_mesh);
 	}
 }
@@ -32,6 +32,7 @@
 #define RENDERING_SERVER_SCENE_RENDER_FORWARD_CLUSTERED_H
 
 #include "core/templates/paged_allocator.h"
+#include "core/templates/parallel_algorithms.h"
 #include "servers/rendering/renderer_rd/forward_clustered/scene_shader_forward_clustered.h"
 #include "servers/rendering/renderer_rd/pipeline_cache_rd.h"
 #include "servers/rendering/renderer_rd/renderer_scene_render_rd.h"
@@ -166,6 +167,7 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 		uint32_t element_offset = 0;
 		uint32_t barrier = RD::BARRIER_MASK_ALL;
 		bool use_directional_soft_shadow = false;
+		bool use_indirect_draws = false; // Only for the camera passes, other views must see every instance.
 
 		RenderListParameters(GeometryInstanceSurfaceDataCache **p_elements, RenderElementInfo *p_element_info, int p_element_count, bool p_reverse_cull, PassMode p_pass_mode, bool p_no_gi, bool p_use_directional_soft_shadows, RID p_render_pass_uniform_set, bool p_force_wireframe = false, const Vector2 &p_uv_offset = Vector2(), const Plane &p_lod_plane = Plane(), float p_lod_distance_multiplier = 0.0, float p_screen_lod_threshold = 0.0, uint32_t p_element_offset = 0, uint32_t p_barrier = RD::BARRIER_MASK_ALL) {
 			elements = p_elements;
@@ -344,6 +346,7 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 			RD::InitialAction initial_depth_action;
 			RD::FinalAction final_depth_action;
 			Rect2i rect;
+			ShadowStaticCache static_cache;
 		};
 
 		LocalVector<ShadowPass> shadow_passes;
@@ -380,6 +383,10 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 	void _update_instance_data_buffer(RenderListType p_render_list);
 	void _fill_instance_data(RenderListType p_render_list, int *p_render_info = nullptr, uint32_t p_offset = 0, int32_t p_max_elements = -1, bool p_update_buffer = true);
 	void _fill_render_list(RenderListType p_render_list, const RenderDataRD *p_render_data, PassMode p_pass_mode, bool p_using_sdfgi = false, bool p_using_opaque_gi = false, bool p_append = false);
+	void _cull_multimeshes_gpu(const RenderDataRD *p_render_data);
+	void _write_particles_draw_commands();
+
+	uint64_t indirect_draw_pass = 0;
 
 	Map<Size2i, RID> sdfgi_framebuffer_size_cache;
 
@@ -431,10 +438,12 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 		RS::PrimitiveType primitive = RS::PRIMITIVE_MAX;
 		uint32_t flags = 0;
 		uint32_t surface_index = 0;
+		uint32_t indirect_command = 0; // Offset of the draw command in the owner's indirect_command_buffer, in commands.
 
 		void *surface = nullptr;
 		RID material_uniform_set;
 		SceneShaderForwardClustered::ShaderData *shader = nullptr;
+		SceneShaderForwardClustered::MaterialData *material = nullptr; // Only used to request streamed textures.
 
 		void *surface_shadow = nullptr;
 		RID material_uniform_set_shadow;
@@ -460,6 +469,9 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 		Rect2 lightmap_uv_scale;
 		uint32_t layer_mask = 1;
 		RID transforms_uniform_set;
+		RID culled_transforms_uniform_set;
+		RID indirect_command_buffer;
+		uint64_t indirect_pass = 0; // Drawn with indirect commands when it matches indirect_draw_pass.
 		uint32_t instance_count = 0;
 		uint32_t trail_steps = 1;
 		RID mesh_instance;
@@ -535,7 +547,7 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 		};
 
 		void sort_by_key() {
-			SortArray<GeometryInstanceSurfaceDataCache *, SortByKey> sorter;
+			ParallelSortArray<GeometryInstanceSurfaceDataCache *, SortByKey> sorter;
 			sorter.sort(elements.ptr(), elements.size());
 		}
 
@@ -581,7 +593,7 @@ protected:
 	virtual void _render_scene(RenderDataRD *p_render_data, const Color &p_default_bg_color) override;
 
 	virtual void _render_shadow_begin() override;
-	virtual void _render_shadow_append(RID p_framebuffer, const PagedArray<GeometryInstance *> &p_instances, const CameraMatrix &p_projection, const Transform3D &p_transform, float p_zfar, float p_bias, float p_normal_bias, bool p_use_dp, bool p_use_dp_flip, bool p_use_pancake, const Plane &p_camera_plane = Plane(), float p_lod_distance_multiplier = 0.0, float p_screen_lod_threshold = 0.0, const Rect2i &p_rect = Rect2i(), bool p_flip_y = false, bool p_clear_region = true, bool p_begin = true, bool p_end = true, RendererScene::RenderInfo *p_render_info = nullptr) override;
+	virtual void _render_shadow_append(RID p_framebuffer, const PagedArray<GeometryInstance *> &p_instances, const CameraMatrix &p_projection, const Transform3D &p_transform, float p_zfar, float p_bias, float p_normal_bias, bool p_use_dp, bool p_use_dp_flip, bool p_use_pancake, const Plane &p_camera_plane = Plane(), float p_lod_distance_multiplier = 0.0, float p_screen_lod_threshold = 0.0, const Rect2i &p_rect = Rect2i(), bool p_flip_y = false, bool p_clear_region = true, bool p_begin = true, bool p_end = true, RendererScene::RenderInfo *p_render_info = nullptr, const ShadowStaticCache &p_static_cache = ShadowStaticCache()) override;
 	virtual void _render_shadow_process() override;
 	virtual void _render_shadow_end(uint32_t p_barrier = RD::BARRIER_MASK_ALL) override;
 
@@ -147,10 +147,21 @@ public:
 		bool writes_modelview_or_projection;
 		bool uses_world_coordinates;
 
+		// Render modes, kept to set up the pipelines once the shader is compiled.
+		int blend_mode = BLEND_MODE_MIX;
+		int alpha_antialiasing_mode = ALPHA_ANTIALIASING_OFF;
+		int cull_mode = CULL_BACK;
+		bool wireframe = false;
+		bool compile_pending = false;
+
 		uint64_t last_pass = 0;
 		uint32_t index = 0;
 
+		void _setup_pipelines();
+
 		virtual void set_code(const String &p_Code);
+		virtual bool is_compiling();
+		virtual void finish_compile();
 		virtual void set_default_texture_param(const StringName &p_name, RID p_texture);
 		virtual void get_param_list(List<PropertyInfo> *p_param_list) const;
 		void get_instance_param_list(List<RendererStorage::InstanceShaderParam> *p_param_list) const;
@@ -435,6 +435,15 @@ RID RenderForwardMobile::_setup_render_pass_uniform_set(RenderListType p_render_
 		uniforms.push_back(u);
 	}
 
+	{
+		RD::Uniform u;
+		u.binding = 11;
+		u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+		RID cb = (p_render_data && p_render_data->cluster_buffer.is_valid()) ? p_render_data->cluster_buffer : scene_shader.default_vec4_xform_buffer;
+		u.ids.push_back(cb);
+		uniforms.push_back(u);
+	}
+
 	if (p_index >= (int)render_pass_uniform_sets.size()) {
 		render_pass_uniform_sets.resize(p_index + 1);
 	}
@@ -686,6 +695,11 @@ void RenderForwardMobile::_render_scene(RenderDataRD *p_render_data, const Color
 		if (!is_environment(p_render_data->environment) || environment_is_fog_enabled(p_render_data->environment)) {
 			spec_constant_base_flags |= 1 << SPEC_CONSTANT_DISABLE_FOG;
 		}
+
+		// The clusters are built for the main view only, multiview keeps the per object light lists.
+		if (p_render_data->cluster_buffer.is_valid() && p_render_data->view_count == 1) {
+			spec_constant_base_flags |= 1 << SPEC_CONSTANT_USING_CLUSTERED_LIGHTS;
+		}
 	}
 	{
 		if (render_buffer) {
@@ -730,6 +744,7 @@ void RenderForwardMobile::_render_scene(RenderDataRD *p_render_data, const Color
 
 			RD::FramebufferFormatID fb_format = RD::get_singleton()->framebuffer_get_format(framebuffer);
 			RenderListParameters render_list_params(render_list[RENDER_LIST_OPAQUE].elements.ptr(), render_list[RENDER_LIST_OPAQUE].element_info.ptr(), render_list[RENDER_LIST_OPAQUE].elements.size(), reverse_cull, PASS_MODE_COLOR, rp_uniform_set, spec_constant_base_flags, get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_WIREFRAME, Vector2(), p_render_data->lod_camera_plane, p_render_data->lod_distance_multiplier, p_render_data->screen_lod_threshold, p_render_data->view_count);
+			render_list_params.instancing_uniform_set = scene_state.instancing_uniform_set[RENDER_LIST_OPAQUE];
 			render_list_params.framebuffer_format = fb_format;
 			if ((uint32_t)render_list_params.element_count > render_list_thread_threshold && false) {
 				// secondary command buffers need more testing at this time
@@ -794,6 +809,7 @@ void RenderForwardMobile::_render_scene(RenderDataRD *p_render_data, const Color
 		if (using_subpass_transparent) {
 			RD::FramebufferFormatID fb_format = RD::get_singleton()->framebuffer_get_format(framebuffer);
 			RenderListParameters render_list_params(render_list[RENDER_LIST_ALPHA].elements.ptr(), render_list[RENDER_LIST_ALPHA].element_info.ptr(), render_list[RENDER_LIST_ALPHA].elements.size(), reverse_cull, PASS_MODE_COLOR, rp_uniform_set, spec_constant_base_flags, get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_WIREFRAME, Vector2(), p_render_data->lod_camera_plane, p_render_data->lod_distance_multiplier, p_render_data->screen_lod_threshold, p_render_data->view_count);
+			render_list_params.instancing_uniform_set = scene_state.instancing_uniform_set[RENDER_LIST_ALPHA];
 			render_list_params.framebuffer_format = fb_format;
 			if ((uint32_t)render_list_params.element_count > render_list_thread_threshold && false) {
 				// secondary command buffers need more testing at this time
@@ -831,6 +847,7 @@ void RenderForwardMobile::_render_scene(RenderDataRD *p_render_data, const Color
 
 			RD::FramebufferFormatID fb_format = RD::get_singleton()->framebuffer_get_format(framebuffer);
 			RenderListParameters render_list_params(render_list[RENDER_LIST_ALPHA].elements.ptr(), render_list[RENDER_LIST_ALPHA].element_info.ptr(), render_list[RENDER_LIST_ALPHA].elements.size(), reverse_cull, PASS_MODE_COLOR, rp_uniform_set, spec_constant_base_flags, get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_WIREFRAME, Vector2(), p_render_data->lod_camera_plane, p_render_data->lod_distance_multiplier, p_render_data->screen_lod_threshold, p_render_data->view_count);
+			render_list_params.instancing_uniform_set = scene_state.instancing_uniform_set[RENDER_LIST_ALPHA];
 			render_list_params.framebuffer_format = fb_format;
 			if ((uint32_t)render_list_params.element_count > render_list_thread_threshold && false) {
 				// secondary command buffers need more testing at this time
@@ -876,7 +893,7 @@ void RenderForwardMobile::_render_shadow_begin() {
 	render_list[RENDER_LIST_SECONDARY].clear();
 }
 
-void RenderForwardMobile::_render_shadow_append(RID p_framebuffer, const PagedArray<GeometryInstance *> &p_instances, const CameraMatrix &p_projection, const Transform3D &p_transform, float p_zfar, float p_bias, float p_normal_bias, bool p_use_dp, bool p_use_dp_flip, bool p_use_pancake, const Plane &p_camera_plane, float p_lod_distance_multiplier, float p_screen_lod_threshold, const Rect2i &p_rect, bool p_flip_y, bool p_clear_region, bool p_begin, bool p_end, RendererScene::RenderInfo *p_render_info) {
+void RenderForwardMobile::_render_shadow_append(RID p_framebuffer, const PagedArray<GeometryInstance *> &p_instances, const CameraMatrix &p_projection, const Transform3D &p_transform, float p_zfar, float p_bias, float p_normal_bias, bool p_use_dp, bool p_use_dp_flip, bool p_use_pancake, const Plane &p_camera_plane, float p_lod_distance_multiplier, float p_screen_lod_threshold, const Rect2i &p_rect, bool p_flip_y, bool p_clear_region, bool p_begin, bool p_end, RendererScene::RenderInfo *p_render_info, const ShadowStaticCache &p_static_cache) {
 	uint32_t shadow_pass_index = scene_state.shadow_passes.size();
 
 	SceneState::ShadowPass shadow_pass;
@@ -912,7 +929,7 @@ void RenderForwardMobile::_render_shadow_append(RID p_framebuffer, const PagedAr
 	_fill_render_list(RENDER_LIST_SECONDARY, &render_data, pass_mode, true);
 	uint32_t render_list_size = render_list[RENDER_LIST_SECONDARY].elements.size() - render_list_from;
 	render_list[RENDER_LIST_SECONDARY].sort_by_key_range(render_list_from, render_list_size);
-	_fill_element_info(RENDER_LIST_SECONDARY, render_list_from, render_list_size);
+	_fill_element_info(RENDER_LIST_SECONDARY, render_list_from, render_list_size, false);
 
 	{
 		//regular forward for now
@@ -935,6 +952,13 @@ void RenderForwardMobile::_render_shadow_append(RID p_framebuffer, const PagedAr
 		shadow_pass.initial_depth_action = p_begin ? (p_clear_region ? RD::INITIAL_ACTION_CLEAR_REGION : RD::INITIAL_ACTION_CLEAR) : (p_clear_region ? RD::INITIAL_ACTION_CLEAR_REGION_CONTINUE : RD::INITIAL_ACTION_CONTINUE);
 		shadow_pass.final_depth_action = p_end ? RD::FINAL_ACTION_READ : RD::FINAL_ACTION_CONTINUE;
 		shadow_pass.rect = p_rect;
+		shadow_pass.static_cache = p_static_cache;
+
+		if (p_static_cache.mode != SHADOW_STATIC_CACHE_DISABLED) {
+			// Copied from or to between passes, so the atlas must be readable before and after.
+			shadow_pass.initial_depth_action = p_static_cache.mode == SHADOW_STATIC_CACHE_STORE ? RD::INITIAL_ACTION_CLEAR_REGION : RD::INITIAL_ACTION_KEEP;
+			shadow_pass.final_depth_action = RD::FINAL_ACTION_READ;
+		}
 
 		scene_state.shadow_passes.push_back(shadow_pass);
 	}
@@ -943,6 +967,8 @@ void RenderForwardMobile::_render_shadow_append(RID p_framebuffer, const PagedAr
 void RenderForwardMobile::_render_shadow_process() {
 	//render shadows one after the other, so this can be done un-barriered and the driver can optimize (as well as allow us to run compute at the same time)
 
+	_update_instancing_buffer(RENDER_LIST_SECONDARY);
+
 	for (uint32_t i = 0; i < scene_state.shadow_passes.size(); i++) {
 		//render passes need to be configured after instance buffer is done, since they need the latest version
 		SceneState::ShadowPass &shadow_pass = scene_state.shadow_passes[i];
@@ -957,8 +983,17 @@ void RenderForwardMobile::_render_shadow_end(uint32_t p_barrier) {
 
 	for (uint32_t i = 0; i < scene_state.shadow_passes.size(); i++) {
 		SceneState::ShadowPass &shadow_pass = scene_state.shadow_passes[i];
+		if (shadow_pass.static_cache.mode == SHADOW_STATIC_CACHE_RESTORE) {
+			_shadow_static_cache_copy(shadow_pass.static_cache.cache, shadow_pass.static_cache.atlas, shadow_pass.rect);
+		}
+
 		RenderListParameters render_list_parameters(render_list[RENDER_LIST_SECONDARY].elements.ptr() + shadow_pass.element_from, render_list[RENDER_LIST_SECONDARY].element_info.ptr() + shadow_pass.element_from, shadow_pass.element_count, shadow_pass.flip_cull, shadow_pass.pass_mode, shadow_pass.rp_uniform_set, 0, false, Vector2(), shadow_pass.camera_plane, shadow_pass.lod_distance_multiplier, shadow_pass.screen_lod_threshold, 1, shadow_pass.element_from, RD::BARRIER_MASK_NO_BARRIER);
+		render_list_parameters.instancing_uniform_set = scene_state.instancing_uniform_set[RENDER_LIST_SECONDARY];
 		_render_list_with_threads(&render_list_parameters, shadow_pass.framebuffer, RD::INITIAL_ACTION_DROP, RD::FINAL_ACTION_DISCARD, shadow_pass.initial_depth_action, shadow_pass.final_depth_action, Vector<Color>(), 1.0, 0, shadow_pass.rect);
+
+		if (shadow_pass.static_cache.mode == SHADOW_STATIC_CACHE_STORE) {
+			_shadow_static_cache_copy(shadow_pass.static_cache.atlas, shadow_pass.static_cache.cache, shadow_pass.rect);
+		}
 	}
 
 	if (p_barrier != RD::BARRIER_MASK_NO_BARRIER) {
@@ -998,6 +1033,7 @@ void RenderForwardMobile::_render_material(const Transform3D &p_cam_transform, c
 
 	{
 		RenderListParameters render_list_params(render_list[RENDER_LIST_SECONDARY].elements.ptr(), render_list[RENDER_LIST_SECONDARY].element_info.ptr(), render_list[RENDER_LIST_SECONDARY].elements.size(), true, pass_mode, rp_uniform_set, 0);
+		render_list_params.instancing_uniform_set = scene_state.instancing_uniform_set[RENDER_LIST_SECONDARY];
 		//regular forward for now
 		Vector<Color> clear;
 		clear.push_back(Color(0, 0, 0, 0));
@@ -1039,6 +1075,7 @@ void RenderForwardMobile::_render_uv2(const PagedArray<GeometryInstance *> &p_in
 
 	{
 		RenderListParameters render_list_params(render_list[RENDER_LIST_SECONDARY].elements.ptr(), render_list[RENDER_LIST_SECONDARY].element_info.ptr(), render_list[RENDER_LIST_SECONDARY].elements.size(), true, pass_mode, rp_uniform_set, true, 0);
+		render_list_params.instancing_uniform_set = scene_state.instancing_uniform_set[RENDER_LIST_SECONDARY];
 		//regular forward for now
 		Vector<Color> clear;
 		clear.push_back(Color(0, 0, 0, 0));
@@ -1113,6 +1150,7 @@ void RenderForwardMobile::_render_particle_collider_heightfield(RID p_fb, const
 	{
 		//regular forward for now
 		RenderListParameters render_list_params(render_list[RENDER_LIST_SECONDARY].elements.ptr(), render_list[RENDER_LIST_SECONDARY].element_info.ptr(), render_list[RENDER_LIST_SECONDARY].elements.size(), false, pass_mode, rp_uniform_set, 0);
+		render_list_params.instancing_uniform_set = scene_state.instancing_uniform_set[RENDER_LIST_SECONDARY];
 		_render_list_with_threads(&render_list_params, p_fb, RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_READ, RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_READ);
 	}
 	RD::get_singleton()->draw_command_end_label();
@@ -1396,9 +1434,22 @@ void RenderForwardMobile::_fill_render_list(RenderListType p_render_list, const
 		}
 		inst->flags_cache = flags;
 
+		// Streamed textures are assumed to be mapped once over the longest side of the instance, so they need about as many texels as it covers pixels.
+		float stream_screen_size = 0.0;
+		if (p_render_list == RENDER_LIST_OPAQUE && p_render_data->texture_stream_pixel_scale > 0.0) {
+			stream_screen_size = inst->transformed_aabb.get_longest_axis_size() * p_render_data->texture_stream_pixel_scale;
+			if (!p_render_data->cam_ortogonal) {
+				stream_screen_size /= MAX(inst->depth + p_render_data->z_near, p_render_data->z_near);
+			}
+		}
+
 		GeometryInstanceSurfaceDataCache *surf = inst->surface_caches;
 
 		while (surf) {
+			if (stream_screen_size > 0.0 && surf->material->streamed_textures.size()) {
+				storage->material_data_request_streamed_textures(surf->material, stream_screen_size);
+			}
+
 			surf->sort.uses_lightmap = 0;
 
 			// LOD
@@ -1522,6 +1573,21 @@ void RenderForwardMobile::_setup_environment(const RenderDataRD *p_render_data,
 
 	scene_state.ubo.pancake_shadows = p_pancake_shadows;
 
+	if (p_render_data->cluster_buffer.is_valid() && p_render_data->cluster_size > 0) {
+		scene_state.ubo.cluster_shift = get_shift_from_power_of_2(p_render_data->cluster_size);
+		scene_state.ubo.max_cluster_element_count_div_32 = p_render_data->cluster_max_elements / 32;
+
+		uint32_t cluster_screen_width = (p_screen_size.width - 1) / p_render_data->cluster_size + 1;
+		uint32_t cluster_screen_height = (p_screen_size.height - 1) / p_render_data->cluster_size + 1;
+		scene_state.ubo.cluster_type_size = cluster_screen_width * cluster_screen_height * (scene_state.ubo.max_cluster_element_count_div_32 + 32);
+		scene_state.ubo.cluster_width = cluster_screen_width;
+	} else {
+		scene_state.ubo.cluster_shift = 0;
+		scene_state.ubo.max_cluster_element_count_div_32 = 0;
+		scene_state.ubo.cluster_type_size = 0;
+		scene_state.ubo.cluster_width = 0;
+	}
+
 	RendererStorageRD::store_soft_shadow_kernel(directional_penumbra_shadow_kernel_get(), scene_state.ubo.directional_penumbra_shadow_kernel);
 	RendererStorageRD::store_soft_shadow_kernel(directional_soft_shadow_kernel_get(), scene_state.ubo.directional_soft_shadow_kernel);
 	RendererStorageRD::store_soft_shadow_kernel(penumbra_shadow_kernel_get(), scene_state.ubo.penumbra_shadow_kernel);
@@ -1681,21 +1747,125 @@ void RenderForwardMobile::_setup_environment(const RenderDataRD *p_render_data,
 	RD::get_singleton()->buffer_update(scene_state.uniform_buffers[p_index], 0, sizeof(SceneState::UBO), &scene_state.ubo, RD::BARRIER_MASK_RASTER);
 }
 
-void RenderForwardMobile::_fill_element_info(RenderListType p_render_list, uint32_t p_offset, int32_t p_max_elements) {
+// Elements can only share a draw call if everything in their push constant but the transform is the same.
+bool RenderForwardMobile::_geometry_instances_can_share_draw(const GeometryInstanceForwardMobile *p_a, const GeometryInstanceForwardMobile *p_b) {
+	if (p_a->flags_cache != p_b->flags_cache || p_a->gi_offset_cache != p_b->gi_offset_cache || p_a->layer_mask != p_b->layer_mask || p_a->mirror != p_b->mirror || p_a->use_projector != p_b->use_projector || p_a->use_soft_shadow != p_b->use_soft_shadow || p_a->lightmap_uv_scale != p_b->lightmap_uv_scale) {
+		return false;
+	}
+	if (p_a->omni_light_count != p_b->omni_light_count || p_a->spot_light_count != p_b->spot_light_count || p_a->reflection_probe_count != p_b->reflection_probe_count || p_a->decals_count != p_b->decals_count) {
+		return false;
+	}
+	for (uint32_t i = 0; i < p_a->omni_light_count; i++) {
+		if (p_a->omni_lights[i] != p_b->omni_lights[i]) {
+			return false;
+		}
+	}
+	for (uint32_t i = 0; i < p_a->spot_light_count; i++) {
+		if (p_a->spot_lights[i] != p_b->spot_lights[i]) {
+			return false;
+		}
+	}
+	for (uint32_t i = 0; i < p_a->reflection_probe_count; i++) {
+		if (p_a->reflection_probes[i] != p_b->reflection_probes[i]) {
+			return false;
+		}
+	}
+	for (uint32_t i = 0; i < p_a->decals_count; i++) {
+		if (p_a->decals[i] != p_b->decals[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void RenderForwardMobile::_fill_element_info(RenderListType p_render_list, uint32_t p_offset, int32_t p_max_elements, bool p_update_buffer) {
 	RenderList *rl = &render_list[p_render_list];
 	uint32_t element_total = p_max_elements >= 0 ? uint32_t(p_max_elements) : rl->elements.size();
 
 	rl->element_info.resize(p_offset + element_total);
 
-	for (uint32_t i = 0; i < element_total; i++) {
-		GeometryInstanceSurfaceDataCache *surface = rl->elements[i + p_offset];
-		RenderElementInfo &element_info = rl->element_info[p_offset + i];
+	LocalVector<float> &instancing_data = scene_state.instancing_data[p_render_list];
+	if (p_offset == 0) {
+		instancing_data.clear();
+	}
+
+	uint32_t run_from = 0;
+	for (uint32_t i = 0; i <= element_total; i++) {
+		bool can_instance = false;
 
-		element_info.lod_index = surface->lod_index;
-		element_info.uses_lightmap = surface->sort.uses_lightmap;
+		if (i < element_total) {
+			GeometryInstanceSurfaceDataCache *surface = rl->elements[i + p_offset];
+			GeometryInstanceForwardMobile *inst = surface->owner;
+			RenderElementInfo &element_info = rl->element_info[p_offset + i];
+
+			element_info.lod_index = surface->lod_index;
+			element_info.uses_lightmap = surface->sort.uses_lightmap;
+			element_info.repeat = 1;
+			element_info.instancing_index = 0;
+
+			// Multimeshes, particles and skinned meshes already use the transforms set, non uniform scale would need a normal matrix per instance.
+			can_instance = !(inst->flags_cache & INSTANCE_DATA_FLAG_MULTIMESH) && inst->mesh_instance.is_null() && inst->store_transform_cache && !inst->non_uniform_scale && inst->shader_parameters_offset < 0;
+
+			if (i > run_from && can_instance && i - run_from < RenderElementInfo::MAX_REPEATS) {
+				GeometryInstanceSurfaceDataCache *prev_surface = rl->elements[i + p_offset - 1];
+				if (prev_surface->sort.sort_key1 == surface->sort.sort_key1 && prev_surface->sort.sort_key2 == surface->sort.sort_key2 && prev_surface->lod_index == surface->lod_index && _geometry_instances_can_share_draw(prev_surface->owner, inst)) {
+					continue;
+				}
+			}
+		}
+
+		if (i - run_from > 1) {
+			// Close the previous run, every element of it gets its own slot so drawing can start anywhere in it.
+			for (uint32_t j = run_from; j < i; j++) {
+				RenderElementInfo &run_info = rl->element_info[p_offset + j];
+				run_info.repeat = i - j;
+				run_info.instancing_index = instancing_data.size() / 12;
+
+				const Transform3D &xform = rl->elements[p_offset + j]->owner->transform;
+				for (int k = 0; k < 3; k++) {
+					instancing_data.push_back(xform.basis.elements[k][0]);
+					instancing_data.push_back(xform.basis.elements[k][1]);
+					instancing_data.push_back(xform.basis.elements[k][2]);
+					instancing_data.push_back(xform.origin[k]);
+				}
+			}
+		}
+
+		run_from = can_instance ? i : i + 1;
+	}
+
+	if (p_update_buffer) {
+		_update_instancing_buffer(p_render_list);
 	}
 }
 
+void RenderForwardMobile::_update_instancing_buffer(RenderListType p_render_list) {
+	LocalVector<float> &instancing_data = scene_state.instancing_data[p_render_list];
+	if (instancing_data.size() == 0) {
+		return;
+	}
+
+	uint32_t instances = instancing_data.size() / 12;
+	if (scene_state.instancing_buffer[p_render_list].is_null() || scene_state.instancing_buffer_size[p_render_list] < instances) {
+		if (scene_state.instancing_buffer[p_render_list].is_valid()) {
+			RD::get_singleton()->free(scene_state.instancing_buffer[p_render_list]); // Also frees the uniform set.
+		}
+		uint32_t new_size = nearest_power_of_2_templated(MAX(uint32_t(INSTANCE_DATA_BUFFER_MIN_SIZE), instances));
+		scene_state.instancing_buffer[p_render_list] = RD::get_singleton()->storage_buffer_create(new_size * 12 * sizeof(float));
+		scene_state.instancing_buffer_size[p_render_list] = new_size;
+
+		Vector<RD::Uniform> uniforms;
+		RD::Uniform u;
+		u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+		u.binding = 0;
+		u.ids.push_back(scene_state.instancing_buffer[p_render_list]);
+		uniforms.push_back(u);
+		scene_state.instancing_uniform_set[p_render_list] = RD::get_singleton()->uniform_set_create(uniforms, scene_shader.default_shader_rd, TRANSFORMS_UNIFORM_SET);
+	}
+
+	RD::get_singleton()->buffer_update(scene_state.instancing_buffer[p_render_list], 0, instancing_data.size() * sizeof(float), instancing_data.ptr(), RD::BARRIER_MASK_RASTER);
+}
+
 /// RENDERING ///
 
 void RenderForwardMobile::_render_list(RenderingDevice::DrawListID p_draw_list, RenderingDevice::FramebufferFormatID p_framebuffer_Format, RenderListParameters *p_params, uint32_t p_from_element, uint32_t p_to_element) {
@@ -1749,22 +1919,27 @@ void RenderForwardMobile::_render_list_with_threads(RenderListParameters *p_para
 void RenderForwardMobile::_fill_push_constant_instance_indices(GeometryInstanceForwardMobile::PushConstant *p_push_constant, uint32_t &spec_constants, const GeometryInstanceForwardMobile *p_instance) {
 	// first zero out our indices
 
-	p_push_constant->omni_lights[0] = 0xFFFF;
-	p_push_constant->omni_lights[1] = 0xFFFF;
+	p_push_constant->omni_lights[0] = 0xFFFFFFFF;
+	p_push_constant->omni_lights[1] = 0xFFFFFFFF;
+
+	p_push_constant->spot_lights[0] = 0xFFFFFFFF;
+	p_push_constant->spot_lights[1] = 0xFFFFFFFF;
 
-	p_push_constant->spot_lights[0] = 0xFFFF;
-	p_push_constant->spot_lights[1] = 0xFFFF;
+	p_push_constant->decals[0] = 0xFFFFFFFF;
+	p_push_constant->decals[1] = 0xFFFFFFFF;
 
-	p_push_constant->decals[0] = 0xFFFF;
-	p_push_constant->decals[1] = 0xFFFF;
+	p_push_constant->reflection_probes[0] = 0xFFFFFFFF;
+	p_push_constant->reflection_probes[1] = 0xFFFFFFFF;
 
-	p_push_constant->reflection_probes[0] = 0xFFFF;
-	p_push_constant->reflection_probes[1] = 0xFFFF;
+	// Clustered lights are looked up per pixel, only the per object lists of the remaining types are needed.
+	bool clustered_lights = spec_constants & (1 << SPEC_CONSTANT_USING_CLUSTERED_LIGHTS);
+	uint32_t omni_light_count = clustered_lights ? 0 : p_instance->omni_light_count;
+	uint32_t spot_light_count = clustered_lights ? 0 : p_instance->spot_light_count;
 
-	if (p_instance->omni_light_count == 0) {
+	if (!clustered_lights && omni_light_count == 0) {
 		spec_constants |= 1 << SPEC_CONSTANT_DISABLE_OMNI_LIGHTS;
 	}
-	if (p_instance->spot_light_count == 0) {
+	if (!clustered_lights && spot_light_count == 0) {
 		spec_constants |= 1 << SPEC_CONSTANT_DISABLE_SPOT_LIGHTS;
 	}
 	if (p_instance->reflection_probe_count == 0) {
@@ -1778,11 +1953,11 @@ void RenderForwardMobile::_fill_push_constant_instance_indices(GeometryInstanceF
 		uint32_t ofs = i < 4 ? 0 : 1;
 		uint32_t shift = (i & 0x3) << 3;
 		uint32_t mask = ~(0xFF << shift);
-		if (i < p_instance->omni_light_count) {
+		if (i < omni_light_count) {
 			p_push_constant->omni_lights[ofs] &= mask;
 			p_push_constant->omni_lights[ofs] |= uint32_t(forward_id_allocators[FORWARD_ID_TYPE_OMNI_LIGHT].map[p_instance->omni_lights[i]]) << shift;
 		}
-		if (i < p_instance->spot_light_count) {
+		if (i < spot_light_count) {
 			p_push_constant->spot_lights[ofs] &= mask;
 			p_push_constant->spot_lights[ofs] |= uint32_t(forward_id_allocators[FORWARD_ID_TYPE_SPOT_LIGHT].map[p_instance->spot_lights[i]]) << shift;
 		}
@@ -1826,13 +2001,19 @@ void RenderForwardMobile::_render_list_template(RenderingDevice::DrawListID p_dr
 		// GeometryInstanceForwardMobile::PushConstant push_constant = inst->push_constant;
 		GeometryInstanceForwardMobile::PushConstant push_constant;
 
-		if (inst->store_transform_cache) {
+		// A run of equal elements is drawn with one instanced call, their transforms are read like a multimesh.
+		uint32_t repeat = p_params->instancing_uniform_set.is_valid() ? MIN(uint32_t(element_info.repeat), p_to_element - i) : 1;
+
+		if (inst->store_transform_cache && repeat == 1) {
 			RendererStorageRD::store_transform(inst->transform, push_constant.transform);
 		} else {
 			RendererStorageRD::store_transform(Transform3D(), push_constant.transform);
 		}
 
 		push_constant.flags = inst->flags_cache;
+		if (repeat > 1) {
+			push_constant.flags |= INSTANCE_DATA_FLAG_MULTIMESH;
+		}
 		push_constant.gi_offset = inst->gi_offset_cache;
 		push_constant.layer_mask = inst->layer_mask;
 		push_constant.instance_uniforms_ofs = uint32_t(inst->shader_parameters_offset);
@@ -1901,7 +2082,7 @@ void RenderForwardMobile::_render_list_template(RenderingDevice::DrawListID p_dr
 		}
 
 		RS::PrimitiveType primitive = surf->primitive;
-		RID xforms_uniform_set = surf->owner->transforms_uniform_set;
+		RID xforms_uniform_set = repeat > 1 ? p_params->instancing_uniform_set : surf->owner->transforms_uniform_set;
 
 		SceneShaderForwardMobile::ShaderVersion shader_version = SceneShaderForwardMobile::SHADER_VERSION_MAX; // Assigned to silence wrong -Wmaybe-initialized.
 
@@ -1981,6 +2162,12 @@ void RenderForwardMobile::_render_list_template(RenderingDevice::DrawListID p_dr
 
 		RD::get_singleton()->draw_list_set_push_constant(draw_list, &push_constant, sizeof(GeometryInstanceForwardMobile::PushConstant));
 
+		if (repeat > 1) {
+			RD::get_singleton()->draw_list_draw(draw_list, index_array_rd.is_valid(), repeat, 0, element_info.instancing_index);
+			i += repeat - 1; //skip equal elements
+			continue;
+		}
+
 		uint32_t instance_count = surf->owner->instance_count > 1 ? surf->owner->instance_count : 1;
 		if (surf->flags & GeometryInstanceSurfaceDataCache::FLAG_USES_PARTICLE_TRAILS) {
 			instance_count /= surf->owner->trail_steps;
@@ -2308,6 +2495,7 @@ void RenderForwardMobile::_geometry_instance_add_surface_with_material(GeometryI
 	sdcache->flags = flags;
 
 	sdcache->shader = p_material->shader_data;
+	sdcache->material = p_material;
 	sdcache->material_uniform_set = p_material->uniform_set;
 	sdcache->surface = storage->mesh_get_surface(p_mesh, p_surface);
 	sdcache->primitive = storage->mesh_surface_get_primitive(sdcache->surface);
@@ -2558,7 +2746,7 @@ bool RenderForwardMobile::is_dynamic_gi_supported() const {
 }
 
 bool RenderForwardMobile::is_clustered_enabled() const {
-	return false;
+	return use_clustered_lights;
 }
 
 bool RenderForwardMobile::is_volumetric_supported() const {
@@ -2619,6 +2807,8 @@ RenderForwardMobile::RenderForwardMobile(RendererStorageRD *p_storage) :
 
 	sky.set_texture_format(_render_buffers_get_color_format());
 
+	use_clustered_lights = GLOBAL_GET("rendering/limits/cluster_builder/mobile_use_clustered_lights");
+
 	String defines;
 
 	defines += "\n#define MAX_ROUGHNESS_LOD " + itos(get_roughness_layers() - 1) + ".0\n";
@@ -2671,5 +2861,10 @@ RenderForwardMobile::~RenderForwardMobile() {
 		RD::get_singleton()->free(scene_state.lightmap_buffer);
 		RD::get_singleton()->free(scene_state.lightmap_capture_buffer);
 		memdelete_arr(scene_state.lightmap_captures);
+		for (int i = 0; i < RENDER_LIST_MAX; i++) {
+			if (scene_state.instancing_buffer[i].is_valid()) {
+				RD::get_singleton()->free(scene_state.instancing_buffer[i]);
+			}
+		}
 	}
 }
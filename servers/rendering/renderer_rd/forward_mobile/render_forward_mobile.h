@@ -32,6 +32,7 @@
 #define RENDERING_SERVER_SCENE_RENDER_FORWARD_MOBILE_H
 
 #include "core/templates/paged_allocator.h"
+#include "core/templates/parallel_algorithms.h"
 #include "servers/rendering/renderer_rd/forward_mobile/scene_shader_forward_mobile.h"
 #include "servers/rendering/renderer_rd/pipeline_cache_rd.h"
 #include "servers/rendering/renderer_rd/renderer_scene_render_rd.h"
@@ -86,6 +87,8 @@ protected:
 		SPEC_CONSTANT_DISABLE_DECALS = 13,
 		SPEC_CONSTANT_DISABLE_FOG = 14,
 
+		SPEC_CONSTANT_USING_CLUSTERED_LIGHTS = 15,
+
 	};
 
 	enum {
@@ -181,6 +184,7 @@ protected:
 		uint32_t element_offset = 0;
 		uint32_t barrier = RD::BARRIER_MASK_ALL;
 		uint32_t subpass = 0;
+		RID instancing_uniform_set; // Transforms of repeated elements, drawn one by one when not set.
 
 		RenderListParameters(GeometryInstanceSurfaceDataCache **p_elements, RenderElementInfo *p_element_info, int p_element_count, bool p_reverse_cull, PassMode p_pass_mode, RID p_render_pass_uniform_set, uint32_t p_spec_constant_base_flags = 0, bool p_force_wireframe = false, const Vector2 &p_uv_offset = Vector2(), const Plane &p_lod_plane = Plane(), float p_lod_distance_multiplier = 0.0, float p_screen_lod_threshold = 0.0, uint32_t p_view_count = 1, uint32_t p_element_offset = 0, uint32_t p_barrier = RD::BARRIER_MASK_ALL) {
 			elements = p_elements;
@@ -210,7 +214,7 @@ protected:
 	virtual void _render_scene(RenderDataRD *p_render_data, const Color &p_default_bg_color) override;
 
 	virtual void _render_shadow_begin() override;
-	virtual void _render_shadow_append(RID p_framebuffer, const PagedArray<GeometryInstance *> &p_instances, const CameraMatrix &p_projection, const Transform3D &p_transform, float p_zfar, float p_bias, float p_normal_bias, bool p_use_dp, bool p_use_dp_flip, bool p_use_pancake, const Plane &p_camera_plane = Plane(), float p_lod_distance_multiplier = 0.0, float p_screen_lod_threshold = 0.0, const Rect2i &p_rect = Rect2i(), bool p_flip_y = false, bool p_clear_region = true, bool p_begin = true, bool p_end = true, RendererScene::RenderInfo *p_render_info = nullptr) override;
+	virtual void _render_shadow_append(RID p_framebuffer, const PagedArray<GeometryInstance *> &p_instances, const CameraMatrix &p_projection, const Transform3D &p_transform, float p_zfar, float p_bias, float p_normal_bias, bool p_use_dp, bool p_use_dp_flip, bool p_use_pancake, const Plane &p_camera_plane = Plane(), float p_lod_distance_multiplier = 0.0, float p_screen_lod_threshold = 0.0, const Rect2i &p_rect = Rect2i(), bool p_flip_y = false, bool p_clear_region = true, bool p_begin = true, bool p_end = true, RendererScene::RenderInfo *p_render_info = nullptr, const ShadowStaticCache &p_static_cache = ShadowStaticCache()) override;
 	virtual void _render_shadow_process() override;
 	virtual void _render_shadow_end(uint32_t p_barrier = RD::BARRIER_MASK_ALL) override;
 
@@ -226,7 +230,8 @@ protected:
 	virtual RID _render_buffers_get_normal_texture(RID p_render_buffers) override;
 
 	void _fill_render_list(RenderListType p_render_list, const RenderDataRD *p_render_data, PassMode p_pass_mode, bool p_append = false);
-	void _fill_element_info(RenderListType p_render_list, uint32_t p_offset = 0, int32_t p_max_elements = -1);
+	void _fill_element_info(RenderListType p_render_list, uint32_t p_offset = 0, int32_t p_max_elements = -1, bool p_update_buffer = true);
+	void _update_instancing_buffer(RenderListType p_render_list);
 	// void _update_instance_data_buffer(RenderListType p_render_list);
 
 	static RenderForwardMobile *singleton;
@@ -313,6 +318,12 @@ protected:
 			uint32_t pad1;
 			uint32_t pad2;
 			uint32_t pad3;
+
+			// Only used with clustered lights.
+			uint32_t cluster_shift;
+			uint32_t cluster_width;
+			uint32_t cluster_type_size;
+			uint32_t max_cluster_element_count_div_32;
 		};
 
 		UBO ubo;
@@ -351,9 +362,16 @@ protected:
 			RD::InitialAction initial_depth_action;
 			RD::FinalAction final_depth_action;
 			Rect2i rect;
+			ShadowStaticCache static_cache;
 		};
 
 		LocalVector<ShadowPass> shadow_passes;
+
+		// Runs of identical elements are drawn instanced, their transforms go here in the 3D multimesh format.
+		LocalVector<float> instancing_data[RENDER_LIST_MAX];
+		RID instancing_buffer[RENDER_LIST_MAX];
+		uint32_t instancing_buffer_size[RENDER_LIST_MAX] = {};
+		RID instancing_uniform_set[RENDER_LIST_MAX];
 	} scene_state;
 
 	/* Render List */
@@ -377,7 +395,7 @@ protected:
 		};
 
 		void sort_by_key() {
-			SortArray<GeometryInstanceSurfaceDataCache *, SortByKey> sorter;
+			ParallelSortArray<GeometryInstanceSurfaceDataCache *, SortByKey> sorter;
 			sorter.sort(elements.ptr(), elements.size());
 		}
 
@@ -416,9 +434,12 @@ protected:
 	};
 
 	struct RenderElementInfo {
+		enum { MAX_REPEATS = (1 << 9) - 1 };
 		uint32_t uses_lightmap : 1;
 		uint32_t lod_index : 8;
-		uint32_t reserved : 23;
+		uint32_t repeat : 9; // Elements left in the run starting here, including this one.
+		uint32_t reserved : 14;
+		uint32_t instancing_index; // Slot of this element in the instancing buffer, only valid when repeat > 1.
 	};
 
 	template <PassMode p_pass_mode>
@@ -432,6 +453,9 @@ protected:
 
 	uint32_t render_list_thread_threshold = 500;
 
+	// Bin omni and spot lights with the cluster builder instead of assigning them per object on the CPU.
+	bool use_clustered_lights = false;
+
 	RenderList render_list[RENDER_LIST_MAX];
 
 	/* Geometry instance */
@@ -504,6 +528,7 @@ protected:
 		void *surface = nullptr;
 		RID material_uniform_set;
 		SceneShaderForwardMobile::ShaderData *shader = nullptr;
+		SceneShaderForwardMobile::MaterialData *material = nullptr; // Only used to request streamed textures.
 
 		void *surface_shadow = nullptr;
 		RID material_uniform_set_shadow;
@@ -602,6 +627,7 @@ protected:
 				dirty_list_element(this) {}
 	};
 
+	static bool _geometry_instances_can_share_draw(const GeometryInstanceForwardMobile *p_a, const GeometryInstanceForwardMobile *p_b);
 	_FORCE_INLINE_ void _fill_push_constant_instance_indices(GeometryInstanceForwardMobile::PushConstant *p_push_constant, uint32_t &spec_constants, const GeometryInstanceForwardMobile *p_instance);
 
 	void _update_shader_quality_settings() override;
@@ -30,6 +30,7 @@
 
 #include "renderer_canvas_render_rd.h"
 #include "core/config/project_settings.h"
+#include "core/debugger/trace_zones.h"
 #include "core/math/geometry_2d.h"
 #include "core/math/math_defs.h"
 #include "core/math/math_funcs.h"
@@ -365,6 +366,8 @@ void RendererCanvasRenderRD::_bind_canvas_texture(RD::DrawListID p_draw_list, RI
 	}
 
 	RD::get_singleton()->draw_list_bind_uniform_set(p_draw_list, uniform_set, CANVAS_TEXTURE_UNIFORM_SET);
+	rect_batch.texture_filter = p_base_filter;
+	rect_batch.texture_repeat = p_base_repeat;
 
 	if (specular_shininess.a < 0.999) {
 		push_constant.flags |= FLAGS_DEFAULT_SPECULAR_MAP_USED;
@@ -423,8 +426,8 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 	push_constant.color_texture_pixel_size[0] = 0;
 	push_constant.color_texture_pixel_size[1] = 0;
 
-	push_constant.pad[0] = 0;
-	push_constant.pad[1] = 0;
+	push_constant.rect_batch_offset = 0;
+	push_constant.pad = 0;
 
 	push_constant.lights[0] = 0;
 	push_constant.lights[1] = 0;
@@ -465,80 +468,68 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 	RID last_texture;
 	Size2 texpixel_size;
 
+	if (rect_batch.count && rect_batch.texture_filter == current_filter && rect_batch.texture_repeat == current_repeat) {
+		// Rects of the previous items are still pending, keep using their texture so the ones here can join them.
+		const PushConstant &batch = rect_batch.push_constant;
+		last_texture = rect_batch.texture;
+		texpixel_size = Size2(batch.color_texture_pixel_size[0], batch.color_texture_pixel_size[1]);
+		push_constant.flags = batch.flags & (FLAGS_DEFAULT_NORMAL_MAP_USED | FLAGS_DEFAULT_SPECULAR_MAP_USED);
+		push_constant.specular_shininess = batch.specular_shininess;
+		push_constant.color_texture_pixel_size[0] = batch.color_texture_pixel_size[0];
+		push_constant.color_texture_pixel_size[1] = batch.color_texture_pixel_size[1];
+	}
+
 	bool skipping = false;
 
 	const Item::Command *c = p_item->commands;
 	while (c) {
 		if (skipping && c->type != Item::Command::TYPE_ANIMATION_SLICE) {
+			if (c->type == Item::Command::TYPE_RECT) {
+				rect_batch.next++; // Keep in step with the instances.
+			}
 			c = c->next;
 			continue;
 		}
 
 		push_constant.flags = base_flags | (push_constant.flags & (FLAGS_DEFAULT_NORMAL_MAP_USED | FLAGS_DEFAULT_SPECULAR_MAP_USED)); //reset on each command for sanity, keep canvastexture binding config
 
+		if (c->type != Item::Command::TYPE_RECT && c->type != Item::Command::TYPE_TRANSFORM && c->type != Item::Command::TYPE_ANIMATION_SLICE) {
+			// Everything else binds state of its own.
+			_rect_batch_flush(p_draw_list);
+		}
+
 		switch (c->type) {
 			case Item::Command::TYPE_RECT: {
 				const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
+				uint32_t rect_index = rect_batch.next++;
 
 				if (rect->flags & CANVAS_RECT_TILE) {
 					current_repeat = RenderingServer::CanvasItemTextureRepeat::CANVAS_ITEM_TEXTURE_REPEAT_ENABLED;
 				}
 
-				//bind pipeline
-				{
-					RID pipeline = pipeline_variants->variants[light_mode][PIPELINE_VARIANT_QUAD].get_render_pipeline(RD::INVALID_ID, p_framebuffer_format);
-					RD::get_singleton()->draw_list_bind_render_pipeline(p_draw_list, pipeline);
+				// Rect geometry and color were written by _rect_batch_prepare(), only the state shared by a batch is set up here.
+				RID pipeline = pipeline_variants->variants[light_mode][PIPELINE_VARIANT_QUAD].get_render_pipeline(RD::INVALID_ID, p_framebuffer_format);
+				RID texture = rect->texture != RID() ? rect->texture : default_canvas_texture;
+
+				if (rect_batch.count && (pipeline != rect_batch.pipeline || texture != last_texture)) {
+					_rect_batch_flush(p_draw_list);
 				}
 
+				//bind pipeline
+				RD::get_singleton()->draw_list_bind_render_pipeline(p_draw_list, pipeline);
+
 				//bind textures
 
 				_bind_canvas_texture(p_draw_list, rect->texture, current_filter, current_repeat, last_texture, push_constant, texpixel_size);
 
-				Rect2 src_rect;
-				Rect2 dst_rect;
-
-				if (rect->texture != RID()) {
-					src_rect = (rect->flags & CANVAS_RECT_REGION) ? Rect2(rect->source.position * texpixel_size, rect->source.size * texpixel_size) : Rect2(0, 0, 1, 1);
-					dst_rect = Rect2(rect->rect.position, rect->rect.size);
-
-					if (dst_rect.size.width < 0) {
-						dst_rect.position.x += dst_rect.size.width;
-						dst_rect.size.width *= -1;
-					}
-					if (dst_rect.size.height < 0) {
-						dst_rect.position.y += dst_rect.size.height;
-						dst_rect.size.height *= -1;
-					}
+				push_constant.flags |= FLAGS_USING_RECT_BATCH;
 
-					if (rect->flags & CANVAS_RECT_FLIP_H) {
-						src_rect.size.x *= -1;
+				if (rect->texture != RID() && (rect->flags & CANVAS_RECT_CLIP_UV)) {
+					push_constant.flags |= FLAGS_CLIP_RECT_UV;
+					const float *src_rect = &rect_batch.instances[(rect_index * RECT_INSTANCE_STRIDE + 4) * 4];
+					for (int j = 0; j < 4; j++) {
+						push_constant.src_rect[j] = src_rect[j];
 					}
-
-					if (rect->flags & CANVAS_RECT_FLIP_V) {
-						src_rect.size.y *= -1;
-					}
-
-					if (rect->flags & CANVAS_RECT_TRANSPOSE) {
-						dst_rect.size.x *= -1; // Encoding in the dst_rect.z uniform
-					}
-
-					if (rect->flags & CANVAS_RECT_CLIP_UV) {
-						push_constant.flags |= FLAGS_CLIP_RECT_UV;
-					}
-
-				} else {
-					dst_rect = Rect2(rect->rect.position, rect->rect.size);
-
-					if (dst_rect.size.width < 0) {
-						dst_rect.position.x += dst_rect.size.width;
-						dst_rect.size.width *= -1;
-					}
-					if (dst_rect.size.height < 0) {
-						dst_rect.position.y += dst_rect.size.height;
-						dst_rect.size.height *= -1;
-					}
-
-					src_rect = Rect2(0, 0, 1, 1);
 				}
 
 				if (rect->flags & CANVAS_RECT_MSDF) {
@@ -549,24 +540,37 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 					push_constant.msdf[3] = 0.f; // Reserved.
 				}
 
-				push_constant.modulation[0] = rect->modulate.r * base_color.r;
-				push_constant.modulation[1] = rect->modulate.g * base_color.g;
-				push_constant.modulation[2] = rect->modulate.b * base_color.b;
-				push_constant.modulation[3] = rect->modulate.a * base_color.a;
+				bool lit = light_mode == PIPELINE_LIGHT_MODE_ENABLED;
+
+				if (rect_batch.count) {
+					const PushConstant &batch = rect_batch.push_constant;
+					bool compatible = rect_index == rect_batch.from + rect_batch.count && lit == rect_batch.lit;
+					// Clipped UVs are read back from the push constant, so those rects are drawn on their own.
+					compatible = compatible && push_constant.flags == batch.flags && !(push_constant.flags & FLAGS_CLIP_RECT_UV);
+					compatible = compatible && push_constant.specular_shininess == batch.specular_shininess;
+					compatible = compatible && push_constant.color_texture_pixel_size[0] == batch.color_texture_pixel_size[0] && push_constant.color_texture_pixel_size[1] == batch.color_texture_pixel_size[1];
+					for (int j = 0; j < 4 && compatible; j++) {
+						compatible = push_constant.lights[j] == batch.lights[j] && (!(push_constant.flags & FLAGS_USE_MSDF) || push_constant.msdf[j] == batch.msdf[j]);
+					}
+					// Lighting uses the world transform in the fragment shader.
+					for (int j = 0; j < 6 && compatible && lit; j++) {
+						compatible = push_constant.world[j] == batch.world[j];
+					}
 
-				push_constant.src_rect[0] = src_rect.position.x;
-				push_constant.src_rect[1] = src_rect.position.y;
-				push_constant.src_rect[2] = src_rect.size.width;
-				push_constant.src_rect[3] = src_rect.size.height;
+					if (!compatible) {
+						_rect_batch_flush(p_draw_list);
+					}
+				}
 
-				push_constant.dst_rect[0] = dst_rect.position.x;
-				push_constant.dst_rect[1] = dst_rect.position.y;
-				push_constant.dst_rect[2] = dst_rect.size.width;
-				push_constant.dst_rect[3] = dst_rect.size.height;
+				if (rect_batch.count == 0) {
+					rect_batch.from = rect_index;
+					rect_batch.texture = last_texture;
+					rect_batch.pipeline = pipeline;
+					rect_batch.lit = lit;
+					rect_batch.push_constant = push_constant;
+				}
 
-				RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
-				RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
-				RD::get_singleton()->draw_list_draw(p_draw_list, true);
+				rect_batch.count++;
 
 			} break;
 
@@ -1062,6 +1066,9 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 
 	RD::FramebufferFormatID fb_format = RD::get_singleton()->framebuffer_get_format(framebuffer);
 
+	// Buffers can't be updated once the draw list is open.
+	_rect_batch_prepare(p_item_count, canvas_transform_inverse);
+
 	RD::DrawListID draw_list = RD::get_singleton()->draw_list_begin(framebuffer, clear ? RD::INITIAL_ACTION_CLEAR : RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_READ, RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_DISCARD, clear_colors);
 
 	RD::get_singleton()->draw_list_bind_uniform_set(draw_list, fb_uniform_set, BASE_UNIFORM_SET);
@@ -1075,6 +1082,7 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 		Item *ci = items[i];
 
 		if (current_clip != ci->final_clip_owner) {
+			_rect_batch_flush(draw_list);
 			current_clip = ci->final_clip_owner;
 
 			//setup clip
@@ -1093,6 +1101,7 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 		}
 
 		if (material != prev_material) {
+			_rect_batch_flush(draw_list);
 			MaterialData *material_data = nullptr;
 			if (material.is_valid()) {
 				material_data = (MaterialData *)storage->material_get_data(material, RendererStorageRD::SHADER_TYPE_2D);
@@ -1118,10 +1127,162 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 		prev_material = material;
 	}
 
+	_rect_batch_flush(draw_list);
+
 	RD::get_singleton()->draw_list_end();
 }
 
+void RendererCanvasRenderRD::_rect_batch_prepare(int p_item_count, const Transform2D &p_canvas_transform_inverse) {
+	uint64_t frame = RendererCompositorRD::singleton->get_frame_number();
+	if (rect_batch.frame != frame) {
+		rect_batch.frame = frame;
+		rect_batch.buffer_used = 0;
+	}
+
+	rect_batch.instances.clear();
+	rect_batch.next = 0;
+	rect_batch.count = 0;
+
+	// Must match what _render_item() does with the rects, one instance per rect command.
+	for (int i = 0; i < p_item_count; i++) {
+		const Item *ci = items[i];
+
+		RS::CanvasItemTextureFilter current_filter = ci->texture_filter != RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT ? ci->texture_filter : default_filter;
+		RS::CanvasItemTextureRepeat current_repeat = ci->texture_repeat != RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT ? ci->texture_repeat : default_repeat;
+
+		Transform2D base_transform = p_canvas_transform_inverse * ci->final_transform;
+		Transform2D world = base_transform;
+		Color base_color = ci->final_modulate;
+
+		RID last_texture;
+		Size2 texpixel_size;
+
+		for (const Item::Command *c = ci->commands; c; c = c->next) {
+			if (c->type == Item::Command::TYPE_TRANSFORM) {
+				world = base_transform * static_cast<const Item::CommandTransform *>(c)->xform;
+				continue;
+			} else if (c->type != Item::Command::TYPE_RECT) {
+				continue;
+			}
+
+			const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
+
+			if (rect->flags & CANVAS_RECT_TILE) {
+				current_repeat = RenderingServer::CanvasItemTextureRepeat::CANVAS_ITEM_TEXTURE_REPEAT_ENABLED;
+			}
+
+			Rect2 src_rect(0, 0, 1, 1);
+			Rect2 dst_rect = Rect2(rect->rect.position, rect->rect.size);
+
+			if (dst_rect.size.width < 0) {
+				dst_rect.position.x += dst_rect.size.width;
+				dst_rect.size.width *= -1;
+			}
+			if (dst_rect.size.height < 0) {
+				dst_rect.position.y += dst_rect.size.height;
+				dst_rect.size.height *= -1;
+			}
+
+			if (rect->texture != RID()) {
+				if (rect->flags & CANVAS_RECT_REGION) {
+					if (rect->texture != last_texture) {
+						RID uniform_set;
+						Size2i size = Size2i(1, 1);
+						Color specular_shininess;
+						bool use_normal;
+						bool use_specular;
+						storage->canvas_texture_get_uniform_set(rect->texture, current_filter, current_repeat, shader.default_version_rd_shader, CANVAS_TEXTURE_UNIFORM_SET, uniform_set, size, specular_shininess, use_normal, use_specular);
+						texpixel_size = Size2(1.0 / float(size.x), 1.0 / float(size.y));
+						last_texture = rect->texture;
+					}
+					src_rect = Rect2(rect->source.position * texpixel_size, rect->source.size * texpixel_size);
+				}
+
+				if (rect->flags & CANVAS_RECT_FLIP_H) {
+					src_rect.size.x *= -1;
+				}
+
+				if (rect->flags & CANVAS_RECT_FLIP_V) {
+					src_rect.size.y *= -1;
+				}
+
+				if (rect->flags & CANVAS_RECT_TRANSPOSE) {
+					dst_rect.size.x *= -1; // Encoding in the dst_rect.z uniform
+				}
+			}
+
+			uint32_t ofs = rect_batch.instances.size();
+			rect_batch.instances.resize(ofs + RECT_INSTANCE_STRIDE * 4);
+			float *instance = &rect_batch.instances[ofs];
+
+			_update_transform_2d_to_mat2x3(world, instance);
+			instance[6] = 0;
+			instance[7] = 0;
+
+			instance[8] = rect->modulate.r * base_color.r;
+			instance[9] = rect->modulate.g * base_color.g;
+			instance[10] = rect->modulate.b * base_color.b;
+			instance[11] = rect->modulate.a * base_color.a;
+
+			instance[12] = dst_rect.position.x;
+			instance[13] = dst_rect.position.y;
+			instance[14] = dst_rect.size.width;
+			instance[15] = dst_rect.size.height;
+
+			instance[16] = src_rect.position.x;
+			instance[17] = src_rect.position.y;
+			instance[18] = src_rect.size.width;
+			instance[19] = src_rect.size.height;
+		}
+	}
+
+	uint32_t rect_count = rect_batch.instances.size() / (RECT_INSTANCE_STRIDE * 4);
+	if (rect_count == 0) {
+		return;
+	}
+
+	if (rect_batch.buffer_used + rect_count > rect_batch.buffer_size) {
+		// Draws recorded earlier keep the old buffer, freeing it is deferred until they are done.
+		if (rect_batch.buffer.is_valid()) {
+			RD::get_singleton()->free(rect_batch.buffer);
+		}
+
+		rect_batch.buffer_size = MAX(next_power_of_2(rect_batch.buffer_used + rect_count), uint32_t(RECT_BATCH_INITIAL_SIZE));
+		rect_batch.buffer_used = 0;
+		rect_batch.buffer = RD::get_singleton()->storage_buffer_create(rect_batch.buffer_size * RECT_INSTANCE_STRIDE * 4 * sizeof(float));
+
+		Vector<RD::Uniform> uniforms;
+		RD::Uniform u;
+		u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+		u.binding = 0;
+		u.ids.push_back(rect_batch.buffer);
+		uniforms.push_back(u);
+		rect_batch.uniform_set = RD::get_singleton()->uniform_set_create(uniforms, shader.default_version_rd_shader, TRANSFORMS_UNIFORM_SET);
+	}
+
+	rect_batch.base = rect_batch.buffer_used;
+	RD::get_singleton()->buffer_update(rect_batch.buffer, rect_batch.base * RECT_INSTANCE_STRIDE * 4 * sizeof(float), rect_count * RECT_INSTANCE_STRIDE * 4 * sizeof(float), rect_batch.instances.ptr());
+	rect_batch.buffer_used += rect_count;
+}
+
+void RendererCanvasRenderRD::_rect_batch_flush(RD::DrawListID p_draw_list) {
+	if (rect_batch.count == 0) {
+		return;
+	}
+
+	rect_batch.push_constant.rect_batch_offset = (rect_batch.base + rect_batch.from) * RECT_INSTANCE_STRIDE;
+
+	RD::get_singleton()->draw_list_bind_uniform_set(p_draw_list, rect_batch.uniform_set, TRANSFORMS_UNIFORM_SET);
+	RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &rect_batch.push_constant, sizeof(PushConstant));
+	RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
+	RD::get_singleton()->draw_list_draw(p_draw_list, true, rect_batch.count);
+
+	rect_batch.count = 0;
+}
+
 void RendererCanvasRenderRD::canvas_render_items(RID p_to_render_target, Item *p_item_list, const Color &p_modulate, Light *p_light_list, Light *p_directional_light_list, const Transform2D &p_canvas_transform, RenderingServer::CanvasItemTextureFilter p_default_filter, RenderingServer::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, bool &r_sdf_used) {
+	TRACE_ZONE("RendererCanvasRenderRD::canvas_render_items");
+
 	r_sdf_used = false;
 	int item_count = 0;
 
@@ -1501,6 +1662,12 @@ void RendererCanvasRenderRD::light_set_use_shadow(RID p_rid, bool p_enable) {
 	ERR_FAIL_COND(!cl);
 
 	cl->shadow.enabled = p_enable;
+
+	if (!p_enable && cl->shadow.cache_texture.is_valid()) {
+		RD::get_singleton()->free(cl->shadow.cache_texture);
+		cl->shadow.cache_texture = RID();
+		cl->shadow.cache_valid = false;
+	}
 }
 
 void RendererCanvasRenderRD::_update_shadow_atlas() {
@@ -1515,7 +1682,7 @@ void RendererCanvasRenderRD::_update_shadow_atlas() {
 			tf.texture_type = RD::TEXTURE_TYPE_2D;
 			tf.width = state.shadow_texture_size;
 			tf.height = state.max_lights_per_render * 2;
-			tf.usage_bits = RD::TEXTURE_USAGE_COLOR_ATTACHMENT_BIT | RD::TEXTURE_USAGE_SAMPLING_BIT;
+			tf.usage_bits = RD::TEXTURE_USAGE_COLOR_ATTACHMENT_BIT | RD::TEXTURE_USAGE_SAMPLING_BIT | RD::TEXTURE_USAGE_CAN_COPY_FROM_BIT | RD::TEXTURE_USAGE_CAN_COPY_TO_BIT;
 			tf.format = RD::DATA_FORMAT_R32_SFLOAT;
 
 			state.shadow_texture = RD::get_singleton()->texture_create(tf, RD::TextureView());
@@ -1544,6 +1711,44 @@ void RendererCanvasRenderRD::light_update_shadow(RID p_rid, int p_shadow_index,
 
 	cl->shadow.z_far = p_far;
 	cl->shadow.y_offset = float(p_shadow_index * 2 + 1) / float(state.max_lights_per_render * 2);
+
+	// Occluders are hashed relative to the light, so scrolling the canvas does not invalidate the cache.
+	// Their hashes are summed, as the culling order is not guaranteed to stay the same between frames.
+	uint64_t occluders_hash = 0;
+	for (LightOccluderInstance *instance = p_occluders; instance; instance = instance->next) {
+		OccluderPolygon *co = occluder_polygon_owner.get_or_null(instance->occluder);
+		if (!co || co->index_array.is_null() || !(p_light_mask & instance->light_mask)) {
+			continue;
+		}
+
+		Transform2D modelview = p_light_xform * instance->xform_cache;
+		uint64_t occluder_hash = hash_djb2_one_64(instance->occluder.get_id());
+		occluder_hash = hash_djb2_one_64(co->version, occluder_hash);
+		for (int j = 0; j < 3; j++) {
+			occluder_hash = hash_djb2_one_float_64(modelview.elements[j].x, occluder_hash);
+			occluder_hash = hash_djb2_one_float_64(modelview.elements[j].y, occluder_hash);
+		}
+		occluders_hash += occluder_hash;
+	}
+
+	uint64_t hash = hash_djb2_one_64(state.shadow_texture_size);
+	hash = hash_djb2_one_float_64(p_near, hash);
+	hash = hash_djb2_one_float_64(p_far, hash);
+	hash = hash_djb2_one_64(occluders_hash, hash);
+
+	Vector3 row_position(0, p_shadow_index * 2, 0);
+	Vector3 row_size(state.shadow_texture_size, 2, 1);
+
+	if (cl->shadow.cache_valid && cl->shadow.cache_hash == hash) {
+		RD::get_singleton()->texture_copy(cl->shadow.cache_texture, state.shadow_texture, Vector3(), row_position, row_size, 0, 0, 0, 0);
+		return;
+	}
+
+	// Only lights that stayed the same for two frames in a row are stored, moving ones would just pay for the copy.
+	bool store_cache = cl->shadow.cache_hash == hash;
+	cl->shadow.cache_hash = hash;
+	cl->shadow.cache_valid = false;
+
 	Vector<Color> cc;
 	cc.push_back(Color(p_far, p_far, p_far, 1.0));
 
@@ -1612,6 +1817,28 @@ void RendererCanvasRenderRD::light_update_shadow(RID p_rid, int p_shadow_index,
 
 		RD::get_singleton()->draw_list_end();
 	}
+
+	if (store_cache) {
+		if (cl->shadow.cache_texture.is_valid() && cl->shadow.cache_size != state.shadow_texture_size) {
+			RD::get_singleton()->free(cl->shadow.cache_texture);
+			cl->shadow.cache_texture = RID();
+		}
+
+		if (cl->shadow.cache_texture.is_null()) {
+			RD::TextureFormat tf;
+			tf.texture_type = RD::TEXTURE_TYPE_2D;
+			tf.width = state.shadow_texture_size;
+			tf.height = 2;
+			tf.usage_bits = RD::TEXTURE_USAGE_CAN_COPY_FROM_BIT | RD::TEXTURE_USAGE_CAN_COPY_TO_BIT;
+			tf.format = RD::DATA_FORMAT_R32_SFLOAT;
+
+			cl->shadow.cache_texture = RD::get_singleton()->texture_create(tf, RD::TextureView());
+			cl->shadow.cache_size = state.shadow_texture_size;
+		}
+
+		RD::get_singleton()->texture_copy(state.shadow_texture, cl->shadow.cache_texture, row_position, Vector3(), row_size, 0, 0, 0, 0);
+		cl->shadow.cache_valid = true;
+	}
 }
 
 void RendererCanvasRenderRD::light_update_directional_shadow(RID p_rid, int p_shadow_index, const Transform2D &p_light_xform, int p_light_mask, float p_cull_distance, const Rect2 &p_clip_rect, LightOccluderInstance *p_occluders) {
@@ -1762,6 +1989,7 @@ RID RendererCanvasRenderRD::occluder_polygon_create() {
 	occluder.sdf_point_count = 0;
 	occluder.sdf_index_count = 0;
 	occluder.cull_mode = RS::CANVAS_OCCLUDER_POLYGON_CULL_DISABLED;
+	occluder.version = 0;
 	return occluder_polygon_owner.make_rid(occluder);
 }
 
@@ -1769,6 +1997,8 @@ void RendererCanvasRenderRD::occluder_polygon_set_shape(RID p_occluder, const Ve
 	OccluderPolygon *oc = occluder_polygon_owner.get_or_null(p_occluder);
 	ERR_FAIL_COND(!oc);
 
+	oc->version++;
+
 	Vector<Vector2> lines;
 
 	if (p_points.size()) {
@@ -1938,6 +2168,7 @@ void RendererCanvasRenderRD::occluder_polygon_set_cull_mode(RID p_occluder, RS::
 	OccluderPolygon *oc = occluder_polygon_owner.get_or_null(p_occluder);
 	ERR_FAIL_COND(!oc);
 	oc->cull_mode = p_mode;
+	oc->version++;
 }
 
 void RendererCanvasRenderRD::ShaderData::set_code(const String &p_code) {
@@ -1950,6 +2181,7 @@ void RendererCanvasRenderRD::ShaderData::set_code(const String &p_code) {
 	uses_screen_texture = false;
 	uses_sdf = false;
 	uses_time = false;
+	compile_pending = false;
 
 	if (code == String()) {
 		return; //just invalid, but no error
@@ -1957,7 +2189,7 @@ void RendererCanvasRenderRD::ShaderData::set_code(const String &p_code) {
 
 	ShaderCompilerRD::GeneratedCode gen_code;
 
-	int blend_mode = BLEND_MODE_MIX;
+	blend_mode = BLEND_MODE_MIX;
 	uses_screen_texture = false;
 
 	ShaderCompilerRD::IdentifierActions actions;
@@ -2001,12 +2233,40 @@ void RendererCanvasRenderRD::ShaderData::set_code(const String &p_code) {
 	print_line("\n**light_code:\n" + gen_code.light);
 #endif
 	canvas_singleton->shader.canvas_shader.version_set_code(version, gen_code.code, gen_code.uniforms, gen_code.stage_globals[ShaderCompilerRD::STAGE_VERTEX], gen_code.stage_globals[ShaderCompilerRD::STAGE_FRAGMENT], gen_code.defines);
-	ERR_FAIL_COND(!canvas_singleton->shader.canvas_shader.version_is_valid(version));
 
 	ubo_size = gen_code.uniform_total_size;
 	ubo_offsets = gen_code.uniform_offsets;
 	texture_uniforms = gen_code.texture_uniforms;
 
+	if (!canvas_singleton->shader.canvas_shader.version_is_valid(version)) {
+		ERR_FAIL_COND(!canvas_singleton->shader.canvas_shader.version_is_compiling(version));
+		compile_pending = true; // Pipelines are set up in finish_compile().
+		return;
+	}
+
+	_setup_pipelines();
+}
+
+bool RendererCanvasRenderRD::ShaderData::is_compiling() {
+	RendererCanvasRenderRD *canvas_singleton = (RendererCanvasRenderRD *)RendererCanvasRender::singleton;
+	return compile_pending && canvas_singleton->shader.canvas_shader.version_is_compiling(version);
+}
+
+void RendererCanvasRenderRD::ShaderData::finish_compile() {
+	if (!compile_pending) {
+		return;
+	}
+	compile_pending = false;
+
+	RendererCanvasRenderRD *canvas_singleton = (RendererCanvasRenderRD *)RendererCanvasRender::singleton;
+	ERR_FAIL_COND(!canvas_singleton->shader.canvas_shader.version_is_valid(version));
+
+	_setup_pipelines();
+}
+
+void RendererCanvasRenderRD::ShaderData::_setup_pipelines() {
+	RendererCanvasRenderRD *canvas_singleton = (RendererCanvasRenderRD *)RendererCanvasRender::singleton;
+
 	//update them pipelines
 
 	RD::PipelineColorBlendState::Attachment attachment;
@@ -2606,6 +2866,9 @@ void fragment() {
 		storage->material_set_shader(default_canvas_group_material, default_canvas_group_shader);
 	}
 
+	// Only enabled now, the default shader above is what gets drawn while user shaders compile.
+	shader.canvas_shader.set_async_compile_enabled(GLOBAL_GET("rendering/shader_compiler/async_compile/enabled"));
+
 	static_assert(sizeof(PushConstant) == 128);
 }
 
@@ -2663,6 +2926,9 @@ RendererCanvasRenderRD::~RendererCanvasRenderRD() {
 
 		memdelete_arr(state.light_uniforms);
 		RD::get_singleton()->free(state.lights_uniform_buffer);
+		if (rect_batch.buffer.is_valid()) {
+			RD::get_singleton()->free(rect_batch.buffer);
+		}
 		RD::get_singleton()->free(shader.default_skeleton_uniform_buffer);
 		RD::get_singleton()->free(shader.default_skeleton_texture_buffer);
 	}
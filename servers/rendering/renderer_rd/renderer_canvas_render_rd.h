@@ -77,7 +77,7 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 
 		FLAGS_NINEPACH_DRAW_CENTER = (1 << 12),
 		FLAGS_USING_PARTICLES = (1 << 13),
-
+		FLAGS_USING_RECT_BATCH = (1 << 14),
 		FLAGS_USE_SKELETON = (1 << 15),
 		FLAGS_NINEPATCH_H_MODE_SHIFT = 16,
 		FLAGS_NINEPATCH_V_MODE_SHIFT = 18,
@@ -179,7 +179,14 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 		bool uses_sdf = false;
 		bool uses_time = false;
 
+		int blend_mode = BLEND_MODE_MIX; // Kept to set up the pipelines once the shader is compiled.
+		bool compile_pending = false;
+
+		void _setup_pipelines();
+
 		virtual void set_code(const String &p_Code);
+		virtual bool is_compiling();
+		virtual void finish_compile();
 		virtual void set_default_texture_param(const StringName &p_name, RID p_texture);
 		virtual void get_param_list(List<PropertyInfo> *p_param_list) const;
 		virtual void get_instance_param_list(List<RendererStorage::InstanceShaderParam> *p_param_list) const;
@@ -264,6 +271,12 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 			float z_far;
 			float y_offset;
 			Transform2D directional_xform;
+
+			//copy of the last render, reused while the light and its occluders don't change
+			RID cache_texture;
+			int cache_size = 0;
+			uint64_t cache_hash = 0;
+			bool cache_valid = false;
 		} shadow;
 	};
 
@@ -279,6 +292,7 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 
 	struct OccluderPolygon {
 		RS::CanvasOccluderPolygonCullMode cull_mode;
+		uint32_t version;
 		int line_point_count;
 		RID vertex_buffer;
 		RID vertex_array;
@@ -395,7 +409,8 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 				};
 				float dst_rect[4];
 				float src_rect[4];
-				float pad[2];
+				uint32_t rect_batch_offset;
+				float pad;
 			};
 			//primitive
 			struct {
@@ -413,6 +428,36 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 		float skeleton_inverse[16];
 	};
 
+	// Rects are drawn instanced from a storage buffer, so runs of compatible ones (also across items) take a single draw.
+	enum {
+		RECT_INSTANCE_STRIDE = 5, // vec4s per rect: world basis, world origin, modulation, dst_rect and src_rect.
+		RECT_BATCH_INITIAL_SIZE = 1024,
+	};
+
+	struct RectBatch {
+		LocalVector<float> instances; // One per rect command of the current _render_items() call, in order, skipped ones included.
+		RID buffer;
+		RID uniform_set;
+		uint32_t buffer_size = 0; // In rects.
+		uint32_t buffer_used = 0; // Rects uploaded so far this frame, later uploads go after them.
+		uint64_t frame = 0;
+
+		uint32_t base = 0; // Where the instances of the current _render_items() call start in the buffer.
+		uint32_t next = 0; // Index of the next rect command.
+
+		// What the last texture was bound with, see _bind_canvas_texture().
+		RS::CanvasItemTextureFilter texture_filter = RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT;
+		RS::CanvasItemTextureRepeat texture_repeat = RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT;
+
+		// Pending draw, the pipeline and texture are already bound.
+		uint32_t from = 0;
+		uint32_t count = 0;
+		RID texture;
+		RID pipeline;
+		bool lit = false;
+		PushConstant push_constant;
+	} rect_batch;
+
 	Item *items[MAX_RENDER_ITEMS];
 
 	bool using_directional_lights = false;
@@ -430,6 +475,9 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 	void _render_item(RenderingDevice::DrawListID p_draw_list, RID p_render_target, const Item *p_item, RenderingDevice::FramebufferFormatID p_framebuffer_format, const Transform2D &p_canvas_transform_inverse, Item *&current_clip, Light *p_lights, PipelineVariants *p_pipeline_variants);
 	void _render_items(RID p_to_render_target, int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights, bool p_to_backbuffer = false);
 
+	void _rect_batch_prepare(int p_item_count, const Transform2D &p_canvas_transform_inverse);
+	void _rect_batch_flush(RD::DrawListID p_draw_list);
+
 	_FORCE_INLINE_ void _update_transform_2d_to_mat2x4(const Transform2D &p_transform, float *p_mat2x4);
 	_FORCE_INLINE_ void _update_transform_2d_to_mat2x3(const Transform2D &p_transform, float *p_mat2x3);
 
@@ -270,6 +270,10 @@ RendererCompositorRD::RendererCompositorRD() {
 					ShaderRD::set_shader_cache_save_compressed(compress);
 					ShaderRD::set_shader_cache_save_compressed_zstd(use_zstd);
 					ShaderRD::set_shader_cache_save_debug(!strip_debug);
+					ShaderCompilerRD::set_cache_dir(shader_cache_dir);
+
+					// The driver pipeline cache only works on the device and driver that wrote it, key the file by them.
+					RD::get_singleton()->set_pipeline_cache_path(shader_cache_dir.plus_file("pipelines-" + RD::get_singleton()->get_device_pipeline_cache_uuid() + ".cache"));
 				}
 			}
 		}
@@ -299,4 +303,5 @@ RendererCompositorRD::RendererCompositorRD() {
 
 RendererCompositorRD::~RendererCompositorRD() {
 	ShaderRD::set_shader_cache_dir(String());
+	ShaderCompilerRD::set_cache_dir(String());
 }
@@ -788,10 +788,19 @@ void RendererSceneGIRD::SDFGI::update(RendererSceneEnvironmentRD *p_env, const V
 	reads_sky = p_env->sdfgi_read_sky_light;
 
 	int32_t drag_margin = (cascade_size / SDFGI::PROBE_DIVISOR) / 2;
+	uint32_t total_volume = cascade_size * cascade_size * cascade_size;
+
+	// Work out where every cascade wants to scroll to, then only apply as many scrolls as the budget allows.
+	Vector3i positions[SDFGI::MAX_CASCADES];
+	Vector3i dirty_regions[SDFGI::MAX_CASCADES];
+	float costs[SDFGI::MAX_CASCADES];
+	int32_t lags[SDFGI::MAX_CASCADES];
 
 	for (uint32_t i = 0; i < cascades.size(); i++) {
-		SDFGI::Cascade &cascade = cascades[i];
+		SDFGI::Cascade cascade = cascades[i];
 		cascade.dirty_regions = Vector3i();
+		costs[i] = 0.0;
+		lags[i] = 0;
 
 		Vector3 probe_half_size = Vector3(1, 1, 1) * cascade.cell_size * float(cascade_size / SDFGI::PROBE_DIVISOR) * 0.5;
 		probe_half_size = Vector3(0, 0, 0);
@@ -800,6 +809,10 @@ void RendererSceneGIRD::SDFGI::update(RendererSceneEnvironmentRD *p_env, const V
 		world_position.y *= y_mult;
 		Vector3i pos_in_cascade = Vector3i((world_position + probe_half_size) / cascade.cell_size);
 
+		for (int j = 0; j < 3; j++) {
+			lags[i] = MAX(lags[i], ABS(pos_in_cascade[j] - cascade.position[j]));
+		}
+
 		for (int j = 0; j < 3; j++) {
 			if (pos_in_cascade[j] < cascade.position[j]) {
 				while (pos_in_cascade[j] < (cascade.position[j] - drag_margin)) {
@@ -824,7 +837,6 @@ void RendererSceneGIRD::SDFGI::update(RendererSceneEnvironmentRD *p_env, const V
 
 		if (cascade.dirty_regions != Vector3i() && cascade.dirty_regions != SDFGI::Cascade::DIRTY_ALL) {
 			//see how much the total dirty volume represents from the total volume
-			uint32_t total_volume = cascade_size * cascade_size * cascade_size;
 			uint32_t safe_volume = 1;
 			for (int j = 0; j < 3; j++) {
 				safe_volume *= cascade_size - ABS(cascade.dirty_regions[j]);
@@ -833,8 +845,52 @@ void RendererSceneGIRD::SDFGI::update(RendererSceneEnvironmentRD *p_env, const V
 			if (dirty_volume > (safe_volume / 2)) {
 				//more than half the volume is dirty, make all dirty so its only rendered once
 				cascade.dirty_regions = SDFGI::Cascade::DIRTY_ALL;
+			} else {
+				costs[i] = 1.0 + float(dirty_volume) / float(total_volume);
 			}
 		}
+
+		if (cascade.dirty_regions == SDFGI::Cascade::DIRTY_ALL) {
+			costs[i] = 2.0;
+		}
+
+		positions[i] = cascade.position;
+		dirty_regions[i] = cascade.dirty_regions;
+	}
+
+	// Every scroll re-voxelizes the dirty part of the cascade, then runs the SDF, occlusion and light passes over all of it.
+	// That cost is 1.0 plus the dirty fraction, compare it against the budget. The cascades the camera has drifted furthest
+	// from go first, those left out keep their position and will want to scroll a bit more next frame.
+	uint32_t order[SDFGI::MAX_CASCADES];
+	for (uint32_t i = 0; i < cascades.size(); i++) {
+		order[i] = i;
+	}
+	for (uint32_t i = 1; i < cascades.size(); i++) {
+		for (uint32_t j = i; j > 0 && lags[order[j]] > lags[order[j - 1]]; j--) {
+			SWAP(order[j], order[j - 1]);
+		}
+	}
+
+	float budget = gi->sdfgi_cascade_update_budget;
+	float used = 0.0;
+	for (uint32_t i = 0; i < cascades.size(); i++) {
+		uint32_t c = order[i];
+		SDFGI::Cascade &cascade = cascades[c];
+		cascade.dirty_regions = Vector3i();
+
+		if (costs[c] == 0.0) {
+			continue;
+		}
+
+		// Never let the camera get close to the border of a cascade, no matter the budget.
+		bool forced = lags[c] >= int32_t(cascade_size / 4);
+		if (budget > 0.0 && used > 0.0 && used + costs[c] > budget && !forced) {
+			continue;
+		}
+
+		used += costs[c];
+		cascade.position = positions[c];
+		cascade.dirty_regions = dirty_regions[c];
 	}
 }
 
@@ -2799,6 +2855,7 @@ RendererSceneGIRD::RendererSceneGIRD() {
 	sdfgi_ray_count = RS::EnvironmentSDFGIRayCount(CLAMP(int32_t(GLOBAL_GET("rendering/global_illumination/sdfgi/probe_ray_count")), 0, int32_t(RS::ENV_SDFGI_RAY_COUNT_MAX - 1)));
 	sdfgi_frames_to_converge = RS::EnvironmentSDFGIFramesToConverge(CLAMP(int32_t(GLOBAL_GET("rendering/global_illumination/sdfgi/frames_to_converge")), 0, int32_t(RS::ENV_SDFGI_CONVERGE_MAX - 1)));
 	sdfgi_frames_to_update_light = RS::EnvironmentSDFGIFramesToUpdateLight(CLAMP(int32_t(GLOBAL_GET("rendering/global_illumination/sdfgi/frames_to_update_lights")), 0, int32_t(RS::ENV_SDFGI_UPDATE_LIGHT_MAX - 1)));
+	sdfgi_cascade_update_budget = MAX(0.0, float(GLOBAL_GET("rendering/global_illumination/sdfgi/cascade_update_budget")));
 }
 
 RendererSceneGIRD::~RendererSceneGIRD() {
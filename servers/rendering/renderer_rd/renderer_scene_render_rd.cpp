@@ -31,6 +31,7 @@
 #include "renderer_scene_render_rd.h"
 
 #include "core/config/project_settings.h"
+#include "core/debugger/trace_zones.h"
 #include "core/os/os.h"
 #include "renderer_compositor_rd.h"
 #include "servers/rendering/rendering_server_default.h"
@@ -814,11 +815,20 @@ void RendererSceneRenderRD::_update_shadow_atlas(ShadowAtlas *shadow_atlas) {
 		tf.width = shadow_atlas->size;
 		tf.height = shadow_atlas->size;
 		tf.usage_bits = RD::TEXTURE_USAGE_SAMPLING_BIT | RD::TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+		if (shadow_atlas_static_cache) {
+			tf.usage_bits |= RD::TEXTURE_USAGE_CAN_COPY_FROM_BIT | RD::TEXTURE_USAGE_CAN_COPY_TO_BIT;
+		}
 
 		shadow_atlas->depth = RD::get_singleton()->texture_create(tf, RD::TextureView());
 		Vector<RID> fb_tex;
 		fb_tex.push_back(shadow_atlas->depth);
 		shadow_atlas->fb = RD::get_singleton()->framebuffer_create(fb_tex);
+
+		if (shadow_atlas_static_cache) {
+			// Only ever copied from and to, the attachment bit is needed for depth formats.
+			tf.usage_bits = RD::TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | RD::TEXTURE_USAGE_CAN_COPY_FROM_BIT | RD::TEXTURE_USAGE_CAN_COPY_TO_BIT;
+			shadow_atlas->static_cache = RD::get_singleton()->texture_create(tf, RD::TextureView());
+		}
 	}
 }
 
@@ -837,6 +847,10 @@ void RendererSceneRenderRD::shadow_atlas_set_size(RID p_atlas, int p_size, bool
 		RD::get_singleton()->free(shadow_atlas->depth);
 		shadow_atlas->depth = RID();
 	}
+	if (shadow_atlas->static_cache.is_valid()) {
+		RD::get_singleton()->free(shadow_atlas->static_cache);
+		shadow_atlas->static_cache = RID();
+	}
 	for (int i = 0; i < 4; i++) {
 		//clear subdivisions
 		shadow_atlas->quadrants[i].shadows.resize(0);
@@ -1130,10 +1144,12 @@ bool RendererSceneRenderRD::shadow_atlas_update_light(RID p_atlas, RID p_light_i
 	if (found_shadow) {
 		if (old_quadrant != ShadowAtlas::SHADOW_INVALID) {
 			shadow_atlas->quadrants[old_quadrant].shadows.write[old_shadow].version = 0;
+			shadow_atlas->quadrants[old_quadrant].shadows.write[old_shadow].static_version = 0;
 			shadow_atlas->quadrants[old_quadrant].shadows.write[old_shadow].owner = RID();
 
 			if (old_key & ShadowAtlas::OMNI_LIGHT_FLAG) {
 				shadow_atlas->quadrants[old_quadrant].shadows.write[old_shadow + 1].version = 0;
+				shadow_atlas->quadrants[old_quadrant].shadows.write[old_shadow + 1].static_version = 0;
 				shadow_atlas->quadrants[old_quadrant].shadows.write[old_shadow + 1].owner = RID();
 			}
 		}
@@ -1181,10 +1197,12 @@ void RendererSceneRenderRD::_shadow_atlas_invalidate_shadow(RendererSceneRenderR
 			uint32_t omni_shadow_idx = p_shadow_idx + (s == (uint32_t)p_shadow_idx ? 1 : -1);
 			RendererSceneRenderRD::ShadowAtlas::Quadrant::Shadow *omni_shadow = &p_shadow_atlas->quadrants[p_quadrant].shadows.write[omni_shadow_idx];
 			omni_shadow->version = 0;
+			omni_shadow->static_version = 0;
 			omni_shadow->owner = RID();
 		}
 
 		p_shadow->version = 0;
+		p_shadow->static_version = 0;
 		p_shadow->owner = RID();
 		sli->shadow_atlases.erase(p_atlas);
 		p_shadow_atlas->shadow_owners.erase(p_shadow->owner);
@@ -1761,6 +1779,13 @@ void RendererSceneRenderRD::_free_render_buffer_data(RenderBuffers *rb) {
 		rb->ssao.ao_pong_slices.clear();
 	}
 
+	if (rb->ssao.history[0].is_valid()) {
+		RD::get_singleton()->free(rb->ssao.history[0]);
+		RD::get_singleton()->free(rb->ssao.history[1]);
+		rb->ssao.history[0] = RID();
+		rb->ssao.history[1] = RID();
+	}
+
 	if (rb->ssr.blur_radius[0].is_valid()) {
 		RD::get_singleton()->free(rb->ssr.blur_radius[0]);
 		RD::get_singleton()->free(rb->ssr.blur_radius[1]);
@@ -1853,7 +1878,7 @@ void RendererSceneRenderRD::_process_ssr(RID p_render_buffers, RID p_dest_frameb
 	storage->get_effects()->merge_specular(p_dest_framebuffer, p_specular_buffer, p_use_additive ? RID() : rb->texture, rb->blur[0].mipmaps[1].texture);
 }
 
-void RendererSceneRenderRD::_process_ssao(RID p_render_buffers, RID p_environment, RID p_normal_buffer, const CameraMatrix &p_projection) {
+void RendererSceneRenderRD::_process_ssao(RID p_render_buffers, RID p_environment, RID p_normal_buffer, const CameraMatrix &p_projection, const Transform3D &p_cam_transform) {
 	RenderBuffers *rb = render_buffers_owner.get_or_null(p_render_buffers);
 	ERR_FAIL_COND(!rb);
 
@@ -1977,6 +2002,26 @@ void RendererSceneRenderRD::_process_ssao(RID p_render_buffers, RID p_environmen
 		uniform_sets_are_invalid = true;
 	}
 
+	if (ssao_temporal_reprojection && rb->ssao.history[0].is_null()) {
+		RD::TextureFormat tf;
+		tf.format = RD::DATA_FORMAT_R16G16_SFLOAT;
+		tf.width = rb->width;
+		tf.height = rb->height;
+		tf.usage_bits = RD::TEXTURE_USAGE_SAMPLING_BIT | RD::TEXTURE_USAGE_STORAGE_BIT;
+		for (int i = 0; i < 2; i++) {
+			rb->ssao.history[i] = RD::get_singleton()->texture_create(tf, RD::TextureView());
+			RD::get_singleton()->set_resource_name(rb->ssao.history[i], "SSAO History " + itos(i));
+		}
+		rb->ssao.history_frame = 0;
+	} else if (!ssao_temporal_reprojection && rb->ssao.history[0].is_valid()) {
+		RD::get_singleton()->free(rb->ssao.history[0]);
+		RD::get_singleton()->free(rb->ssao.history[1]);
+		rb->ssao.history[0] = RID();
+		rb->ssao.history[1] = RID();
+	}
+
+	uint64_t frame = RSG::rasterizer->get_frame_number();
+
 	EffectsRD::SSAOSettings settings;
 	settings.radius = env->ssao_radius;
 	settings.intensity = env->ssao_intensity;
@@ -1991,11 +2036,26 @@ void RendererSceneRenderRD::_process_ssao(RID p_render_buffers, RID p_environmen
 	settings.blur_passes = ssao_blur_passes;
 	settings.fadeout_from = ssao_fadeout_from;
 	settings.fadeout_to = ssao_fadeout_to;
+	settings.rotation_offset = ssao_temporal_reprojection ? frame % 5 : 0;
 	settings.full_screen_size = Size2i(rb->width, rb->height);
 	settings.half_screen_size = Size2i(buffer_width, buffer_height);
 	settings.quarter_screen_size = Size2i(half_width, half_height);
 
 	storage->get_effects()->generate_ssao(rb->depth_texture, p_normal_buffer, rb->ssao.depth, rb->ssao.depth_slices, rb->ssao.ao_deinterleaved, rb->ssao.ao_deinterleaved_slices, rb->ssao.ao_pong, rb->ssao.ao_pong_slices, rb->ssao.ao_final, rb->ssao.importance_map[0], rb->ssao.importance_map[1], p_projection, settings, uniform_sets_are_invalid, rb->ssao.downsample_uniform_set, rb->ssao.gather_uniform_set, rb->ssao.importance_map_uniform_set);
+
+	if (ssao_temporal_reprojection) {
+		// History is only usable if it was written last frame, otherwise the camera may have cut.
+		bool use_history = rb->ssao.history_frame != 0 && rb->ssao.history_frame + 1 == frame;
+		CameraMatrix reprojection = rb->ssao.prev_projection * CameraMatrix(rb->ssao.prev_cam_transform.affine_inverse() * p_cam_transform) * p_projection.inverse();
+
+		RID history = rb->ssao.history[rb->ssao.history_index];
+		rb->ssao.history_index = (rb->ssao.history_index + 1) % 2;
+		storage->get_effects()->ssao_temporal_reprojection(rb->depth_texture, rb->ssao.ao_final, history, rb->ssao.history[rb->ssao.history_index], p_projection, reprojection, Size2i(rb->width, rb->height), ssao_temporal_reprojection_amount, use_history);
+
+		rb->ssao.history_frame = frame;
+		rb->ssao.prev_cam_transform = p_cam_transform;
+		rb->ssao.prev_projection = p_projection;
+	}
 }
 
 void RendererSceneRenderRD::_render_buffers_copy_screen_texture(const RenderDataRD *p_render_data) {
@@ -3978,8 +4038,18 @@ void RendererSceneRenderRD::_pre_opaque_render(RenderDataRD *p_render_data, bool
 			_render_shadow_pass(render_state.render_shadows[render_state.directional_shadows[i]].light, p_render_data->shadow_atlas, render_state.render_shadows[render_state.directional_shadows[i]].pass, render_state.render_shadows[render_state.directional_shadows[i]].instances, camera_plane, lod_distance_multiplier, p_render_data->screen_lod_threshold, false, i == render_state.directional_shadows.size() - 1, false, p_render_data->render_info);
 		}
 		//render positional shadows
+		bool separate_passes = false;
+		if (render_state.shadows.size()) {
+			ShadowAtlas *shadow_atlas = shadow_atlas_owner.get_or_null(p_render_data->shadow_atlas);
+			if (shadow_atlas) {
+				_update_shadow_atlas(shadow_atlas);
+				// Copies to and from the static cache happen between passes, so each one must leave the atlas readable.
+				separate_passes = shadow_atlas->static_cache.is_valid();
+			}
+		}
 		for (uint32_t i = 0; i < render_state.shadows.size(); i++) {
-			_render_shadow_pass(render_state.render_shadows[render_state.shadows[i]].light, p_render_data->shadow_atlas, render_state.render_shadows[render_state.shadows[i]].pass, render_state.render_shadows[render_state.shadows[i]].instances, camera_plane, lod_distance_multiplier, p_render_data->screen_lod_threshold, i == 0, i == render_state.shadows.size() - 1, true, p_render_data->render_info);
+			const RenderShadowData &shadow_data = render_state.render_shadows[render_state.shadows[i]];
+			_render_shadow_pass(shadow_data.light, p_render_data->shadow_atlas, shadow_data.pass, shadow_data.instances, camera_plane, lod_distance_multiplier, p_render_data->screen_lod_threshold, separate_passes || i == 0, separate_passes || i == render_state.shadows.size() - 1, true, p_render_data->render_info, &shadow_data.static_instances, shadow_data.static_version);
 		}
 
 		_render_shadow_process();
@@ -4001,7 +4071,7 @@ void RendererSceneRenderRD::_pre_opaque_render(RenderDataRD *p_render_data, bool
 
 	if (p_render_data->render_buffers.is_valid()) {
 		if (p_use_ssao) {
-			_process_ssao(p_render_data->render_buffers, p_render_data->environment, p_normal_roughness_buffer, p_render_data->cam_projection);
+			_process_ssao(p_render_data->render_buffers, p_render_data->environment, p_normal_roughness_buffer, p_render_data->cam_projection, p_render_data->cam_transform);
 		}
 	}
 
@@ -4049,6 +4119,8 @@ void RendererSceneRenderRD::_pre_opaque_render(RenderDataRD *p_render_data, bool
 }
 
 void RendererSceneRenderRD::render_scene(RID p_render_buffers, const CameraData *p_camera_data, const PagedArray<GeometryInstance *> &p_instances, const PagedArray<RID> &p_lights, const PagedArray<RID> &p_reflection_probes, const PagedArray<RID> &p_voxel_gi_instances, const PagedArray<RID> &p_decals, const PagedArray<RID> &p_lightmaps, RID p_environment, RID p_camera_effects, RID p_shadow_atlas, RID p_occluder_debug_tex, RID p_reflection_atlas, RID p_reflection_probe, int p_reflection_probe_pass, float p_screen_lod_threshold, const RenderShadowData *p_render_shadows, int p_render_shadow_count, const RenderSDFGIData *p_render_sdfgi_regions, int p_render_sdfgi_region_count, const RenderSDFGIUpdateData *p_sdfgi_update_data, RendererScene::RenderInfo *r_render_info) {
+	TRACE_ZONE("RendererSceneRenderRD::render_scene");
+
 	// getting this here now so we can direct call a bunch of things more easily
 	RenderBuffers *rb = nullptr;
 	if (p_render_buffers.is_valid()) {
@@ -4091,6 +4163,9 @@ void RendererSceneRenderRD::render_scene(RID p_render_buffers, const CameraData
 		// this should be the same for all cameras..
 		render_data.lod_distance_multiplier = p_camera_data->main_projection.get_lod_multiplier();
 		render_data.lod_camera_plane = Plane(-p_camera_data->main_transform.basis.get_axis(Vector3::AXIS_Z), p_camera_data->main_transform.get_origin());
+		if (rb && render_data.lod_distance_multiplier > 0.0) {
+			render_data.texture_stream_pixel_scale = rb->width / (p_camera_data->is_ortogonal ? 2.0 * render_data.lod_distance_multiplier : render_data.lod_distance_multiplier);
+		}
 
 		if (get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_DISABLE_LOD) {
 			render_data.screen_lod_threshold = 0.0;
@@ -4223,7 +4298,13 @@ void RendererSceneRenderRD::_debug_draw_cluster(RID p_render_buffers) {
 	}
 }
 
-void RendererSceneRenderRD::_render_shadow_pass(RID p_light, RID p_shadow_atlas, int p_pass, const PagedArray<GeometryInstance *> &p_instances, const Plane &p_camera_plane, float p_lod_distance_multiplier, float p_screen_lod_threshold, bool p_open_pass, bool p_close_pass, bool p_clear_region, RendererScene::RenderInfo *p_render_info) {
+void RendererSceneRenderRD::_shadow_static_cache_copy(RID p_from, RID p_to, const Rect2i &p_rect) {
+	// The copy doesn't wait for earlier depth writes by itself.
+	RD::get_singleton()->barrier(RD::BARRIER_MASK_RASTER | RD::BARRIER_MASK_TRANSFER, RD::BARRIER_MASK_TRANSFER);
+	RD::get_singleton()->texture_copy(p_from, p_to, Vector3(p_rect.position.x, p_rect.position.y, 0), Vector3(p_rect.position.x, p_rect.position.y, 0), Vector3(p_rect.size.x, p_rect.size.y, 1), 0, 0, 0, 0, RD::BARRIER_MASK_RASTER);
+}
+
+void RendererSceneRenderRD::_render_shadow_pass(RID p_light, RID p_shadow_atlas, int p_pass, const PagedArray<GeometryInstance *> &p_instances, const Plane &p_camera_plane, float p_lod_distance_multiplier, float p_screen_lod_threshold, bool p_open_pass, bool p_close_pass, bool p_clear_region, RendererScene::RenderInfo *p_render_info, const PagedArray<GeometryInstance *> *p_static_instances, uint64_t p_static_version) {
 	LightInstance *light_instance = light_instance_owner.get_or_null(p_light);
 	ERR_FAIL_COND(!light_instance);
 
@@ -4244,6 +4325,9 @@ void RendererSceneRenderRD::_render_shadow_pass(RID p_light, RID p_shadow_atlas,
 
 	bool flip_y = false;
 
+	ShadowAtlas::Quadrant::Shadow *static_shadow = nullptr;
+	ShadowStaticCache static_cache;
+
 	CameraMatrix light_projection;
 	Transform3D light_transform;
 
@@ -4359,6 +4443,9 @@ void RendererSceneRenderRD::_render_shadow_pass(RID p_light, RID p_shadow_atlas,
 				using_dual_paraboloid_flip = p_pass == 1;
 				render_fb = shadow_atlas->fb;
 				flip_y = true;
+
+				// Each paraboloid uses its own slot.
+				static_shadow = &shadow_atlas->quadrants[quadrant].shadows.write[shadow + p_pass];
 			}
 
 		} else if (storage->light_get_type(light_instance->light) == RS::LIGHT_SPOT) {
@@ -4368,6 +4455,13 @@ void RendererSceneRenderRD::_render_shadow_pass(RID p_light, RID p_shadow_atlas,
 			render_fb = shadow_atlas->fb;
 
 			flip_y = true;
+
+			static_shadow = &shadow_atlas->quadrants[quadrant].shadows.write[shadow];
+		}
+
+		if (shadow_atlas->static_cache.is_valid()) {
+			static_cache.atlas = shadow_atlas->depth;
+			static_cache.cache = shadow_atlas->static_cache;
 		}
 	}
 
@@ -4389,7 +4483,25 @@ void RendererSceneRenderRD::_render_shadow_pass(RID p_light, RID p_shadow_atlas,
 			light_instance_set_shadow_transform(p_light, CameraMatrix(), light_instance->transform, zfar, 0, 0, 0);
 		}
 
+	} else if (static_shadow && static_cache.cache.is_valid() && p_static_version) {
+		// Static casters are only drawn when they changed, the rest always goes on top of the cached copy.
+		if (static_shadow->static_version != p_static_version) {
+			static_cache.mode = SHADOW_STATIC_CACHE_STORE;
+			_render_shadow_append(render_fb, *p_static_instances, light_projection, light_transform, zfar, 0, 0, using_dual_paraboloid, using_dual_paraboloid_flip, use_pancake, p_camera_plane, p_lod_distance_multiplier, p_screen_lod_threshold, atlas_rect, flip_y, true, true, true, p_render_info, static_cache);
+			static_shadow->static_version = p_static_version;
+			static_cache.mode = SHADOW_STATIC_CACHE_OVERLAY;
+		} else {
+			static_cache.mode = SHADOW_STATIC_CACHE_RESTORE;
+		}
+
+		if (static_cache.mode == SHADOW_STATIC_CACHE_RESTORE || p_instances.size()) {
+			_render_shadow_append(render_fb, p_instances, light_projection, light_transform, zfar, 0, 0, using_dual_paraboloid, using_dual_paraboloid_flip, use_pancake, p_camera_plane, p_lod_distance_multiplier, p_screen_lod_threshold, atlas_rect, flip_y, false, true, true, p_render_info, static_cache);
+		}
 	} else {
+		if (static_shadow) {
+			static_shadow->static_version = 0;
+		}
+
 		//render shadow
 		_render_shadow_append(render_fb, p_instances, light_projection, light_transform, zfar, 0, 0, using_dual_paraboloid, using_dual_paraboloid_flip, use_pancake, p_camera_plane, p_lod_distance_multiplier, p_screen_lod_threshold, atlas_rect, flip_y, p_clear_region, p_open_pass, p_close_pass, p_render_info);
 	}
@@ -4697,6 +4809,7 @@ void RendererSceneRenderRD::init() {
 
 	directional_shadow.size = GLOBAL_GET("rendering/shadows/directional_shadow/size");
 	directional_shadow.use_16_bits = GLOBAL_GET("rendering/shadows/directional_shadow/16_bits");
+	shadow_atlas_static_cache = GLOBAL_GET("rendering/shadows/shadow_atlas/static_cache");
 
 	/* SKY SHADER */
 
@@ -4769,6 +4882,8 @@ void RendererSceneRenderRD::init() {
 	camera_effects_set_dof_blur_bokeh_shape(RS::DOFBokehShape(int(GLOBAL_GET("rendering/camera/depth_of_field/depth_of_field_bokeh_shape"))));
 	camera_effects_set_dof_blur_quality(RS::DOFBlurQuality(int(GLOBAL_GET("rendering/camera/depth_of_field/depth_of_field_bokeh_quality"))), GLOBAL_GET("rendering/camera/depth_of_field/depth_of_field_use_jitter"));
 	environment_set_ssao_quality(RS::EnvironmentSSAOQuality(int(GLOBAL_GET("rendering/environment/ssao/quality"))), GLOBAL_GET("rendering/environment/ssao/half_size"), GLOBAL_GET("rendering/environment/ssao/adaptive_target"), GLOBAL_GET("rendering/environment/ssao/blur_passes"), GLOBAL_GET("rendering/environment/ssao/fadeout_from"), GLOBAL_GET("rendering/environment/ssao/fadeout_to"));
+	ssao_temporal_reprojection = GLOBAL_GET("rendering/environment/ssao/temporal_reprojection");
+	ssao_temporal_reprojection_amount = GLOBAL_GET("rendering/environment/ssao/temporal_reprojection_amount");
 	screen_space_roughness_limiter = GLOBAL_GET("rendering/anti_aliasing/screen_space_roughness_limiter/enabled");
 	screen_space_roughness_limiter_amount = GLOBAL_GET("rendering/anti_aliasing/screen_space_roughness_limiter/amount");
 	screen_space_roughness_limiter_limit = GLOBAL_GET("rendering/anti_aliasing/screen_space_roughness_limiter/limit");
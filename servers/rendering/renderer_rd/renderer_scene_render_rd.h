@@ -74,6 +74,7 @@ struct RenderDataRD {
 	float lod_distance_multiplier = 0.0;
 	Plane lod_camera_plane = Plane();
 	float screen_lod_threshold = 0.0;
+	float texture_stream_pixel_scale = 0.0; // Screen pixels per world unit at distance 1 (or at any distance for orthogonal cameras).
 
 	RID cluster_buffer = RID();
 	uint32_t cluster_size = 0;
@@ -106,8 +107,28 @@ protected:
 
 	virtual void _render_scene(RenderDataRD *p_render_data, const Color &p_default_color) = 0;
 
+	// How a positional shadow pass uses the static cache of the shadow atlas, see _render_shadow_pass().
+	enum ShadowStaticCacheMode {
+		SHADOW_STATIC_CACHE_DISABLED,
+		SHADOW_STATIC_CACHE_STORE, // Clear the region, draw and copy it to the cache.
+		SHADOW_STATIC_CACHE_RESTORE, // Copy the region from the cache and draw on top.
+		SHADOW_STATIC_CACHE_OVERLAY, // Draw on top of what is already in the region.
+	};
+
+	struct ShadowStaticCache {
+		ShadowStaticCacheMode mode;
+		RID atlas;
+		RID cache;
+
+		ShadowStaticCache() {
+			mode = SHADOW_STATIC_CACHE_DISABLED;
+		}
+	};
+
+	void _shadow_static_cache_copy(RID p_from, RID p_to, const Rect2i &p_rect);
+
 	virtual void _render_shadow_begin() = 0;
-	virtual void _render_shadow_append(RID p_framebuffer, const PagedArray<GeometryInstance *> &p_instances, const CameraMatrix &p_projection, const Transform3D &p_transform, float p_zfar, float p_bias, float p_normal_bias, bool p_use_dp, bool p_use_dp_flip, bool p_use_pancake, const Plane &p_camera_plane = Plane(), float p_lod_distance_multiplier = 0.0, float p_screen_lod_threshold = 0.0, const Rect2i &p_rect = Rect2i(), bool p_flip_y = false, bool p_clear_region = true, bool p_begin = true, bool p_end = true, RendererScene::RenderInfo *p_render_info = nullptr) = 0;
+	virtual void _render_shadow_append(RID p_framebuffer, const PagedArray<GeometryInstance *> &p_instances, const CameraMatrix &p_projection, const Transform3D &p_transform, float p_zfar, float p_bias, float p_normal_bias, bool p_use_dp, bool p_use_dp_flip, bool p_use_pancake, const Plane &p_camera_plane = Plane(), float p_lod_distance_multiplier = 0.0, float p_screen_lod_threshold = 0.0, const Rect2i &p_rect = Rect2i(), bool p_flip_y = false, bool p_clear_region = true, bool p_begin = true, bool p_end = true, RendererScene::RenderInfo *p_render_info = nullptr, const ShadowStaticCache &p_static_cache = ShadowStaticCache()) = 0;
 	virtual void _render_shadow_process() = 0;
 	virtual void _render_shadow_end(uint32_t p_barrier = RD::BARRIER_MASK_ALL) = 0;
 
@@ -124,7 +145,7 @@ protected:
 	virtual void _base_uniforms_changed() = 0;
 	virtual RID _render_buffers_get_normal_texture(RID p_render_buffers) = 0;
 
-	void _process_ssao(RID p_render_buffers, RID p_environment, RID p_normal_buffer, const CameraMatrix &p_projection);
+	void _process_ssao(RID p_render_buffers, RID p_environment, RID p_normal_buffer, const CameraMatrix &p_projection, const Transform3D &p_cam_transform);
 	void _process_ssr(RID p_render_buffers, RID p_dest_framebuffer, RID p_normal_buffer, RID p_specular_buffer, RID p_metallic, const Color &p_metallic_mask, RID p_environment, const CameraMatrix &p_projection, bool p_use_additive);
 	void _process_sss(RID p_render_buffers, const CameraMatrix &p_camera);
 
@@ -268,11 +289,13 @@ private:
 				uint64_t version;
 				uint64_t fog_version; // used for fog
 				uint64_t alloc_tick;
+				uint64_t static_version; // static casters held in the cache for this slot, zero if none
 
 				Shadow() {
 					version = 0;
 					fog_version = 0;
 					alloc_tick = 0;
+					static_version = 0;
 				}
 			};
 
@@ -292,6 +315,7 @@ private:
 
 		RID depth;
 		RID fb; //for copying
+		RID static_cache; // copy of the static casters' depth, when enabled
 
 		Map<RID, uint32_t> shadow_owners;
 	};
@@ -402,6 +426,8 @@ private:
 	int ssao_blur_passes = 2;
 	float ssao_fadeout_from = 50.0;
 	float ssao_fadeout_to = 300.0;
+	bool ssao_temporal_reprojection = false;
+	float ssao_temporal_reprojection_amount = 0.9;
 
 	bool glow_bicubic_upscale = false;
 	bool glow_high_quality = false;
@@ -515,6 +541,13 @@ private:
 			RID ao_final;
 			RID importance_map[2];
 
+			// Accumulated AO and linear depth of the previous frames, ping-ponged every frame.
+			RID history[2];
+			uint32_t history_index = 0;
+			uint64_t history_frame = 0;
+			Transform3D prev_cam_transform;
+			CameraMatrix prev_projection;
+
 			RID downsample_uniform_set;
 			RID gather_uniform_set;
 			RID importance_map_uniform_set;
@@ -791,6 +824,7 @@ private:
 
 	uint64_t scene_pass = 0;
 	uint64_t shadow_atlas_realloc_tolerance_msec = 500;
+	bool shadow_atlas_static_cache = false;
 
 	/* !BAS! is this used anywhere?
 	struct SDFGICosineNeighbour {
@@ -801,7 +835,7 @@ private:
 
 	uint32_t max_cluster_elements = 512;
 
-	void _render_shadow_pass(RID p_light, RID p_shadow_atlas, int p_pass, const PagedArray<GeometryInstance *> &p_instances, const Plane &p_camera_plane = Plane(), float p_lod_distance_multiplier = 0, float p_screen_lod_threshold = 0.0, bool p_open_pass = true, bool p_close_pass = true, bool p_clear_region = true, RendererScene::RenderInfo *p_render_info = nullptr);
+	void _render_shadow_pass(RID p_light, RID p_shadow_atlas, int p_pass, const PagedArray<GeometryInstance *> &p_instances, const Plane &p_camera_plane = Plane(), float p_lod_distance_multiplier = 0, float p_screen_lod_threshold = 0.0, bool p_open_pass = true, bool p_close_pass = true, bool p_clear_region = true, RendererScene::RenderInfo *p_render_info = nullptr, const PagedArray<GeometryInstance *> *p_static_instances = nullptr, uint64_t p_static_version = 0);
 
 public:
 	virtual Transform3D geometry_instance_get_transform(GeometryInstance *p_instance) = 0;
@@ -750,6 +750,8 @@ RendererSceneSkyRD::RendererSceneSkyRD() {
 	roughness_layers = GLOBAL_GET("rendering/reflections/sky_reflections/roughness_layers");
 	sky_ggx_samples_quality = GLOBAL_GET("rendering/reflections/sky_reflections/ggx_samples");
 	sky_use_cubemap_array = GLOBAL_GET("rendering/reflections/sky_reflections/texture_array_reflections");
+	sky_light_change_tolerance = GLOBAL_GET("rendering/reflections/sky_reflections/light_change_tolerance");
+	sky_max_updates_per_second = GLOBAL_GET("rendering/reflections/sky_reflections/max_updates_per_second");
 }
 
 void RendererSceneSkyRD::init(RendererStorageRD *p_storage) {
@@ -1141,6 +1143,11 @@ void RendererSceneSkyRD::setup(RendererSceneEnvironmentRD *p_env, RID p_render_b
 				sky_scene_state.last_frame_directional_lights = sky_scene_state.directional_lights;
 				sky_scene_state.directional_lights = temp;
 				sky_scene_state.last_frame_directional_light_count = sky_scene_state.ubo.directional_light_count;
+			}
+
+			// The background always uses the current lights, but the radiance is only updated
+			// once they moved past the tolerance.
+			if (_sky_lights_changed(sky)) {
 				sky->reflection.dirty = true;
 			}
 		}
@@ -1190,6 +1197,31 @@ void RendererSceneSkyRD::setup(RendererSceneEnvironmentRD *p_env, RID p_render_b
 	RD::get_singleton()->buffer_update(sky_scene_state.uniform_buffer, 0, sizeof(SkySceneState::UBO), &sky_scene_state.ubo);
 }
 
+bool RendererSceneSkyRD::_sky_lights_changed(const Sky *p_sky) const {
+	if (p_sky->radiance_lights.size() != sky_scene_state.last_frame_directional_light_count) {
+		return true;
+	}
+
+	for (uint32_t i = 0; i < p_sky->radiance_lights.size(); i++) {
+		const SkyDirectionalLightData &rendered = p_sky->radiance_lights[i];
+		const SkyDirectionalLightData &current = sky_scene_state.last_frame_directional_lights[i];
+
+		if (rendered.enabled != current.enabled) {
+			return true;
+		}
+		for (int j = 0; j < 3; j++) {
+			if (Math::abs(rendered.direction[j] - current.direction[j]) > sky_light_change_tolerance || Math::abs(rendered.color[j] - current.color[j]) > sky_light_change_tolerance) {
+				return true;
+			}
+		}
+		if (Math::abs(rendered.energy - current.energy) > sky_light_change_tolerance * MAX(rendered.energy, 1.0f) || Math::abs(rendered.size - current.size) > sky_light_change_tolerance) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 void RendererSceneSkyRD::update(RendererSceneEnvironmentRD *p_env, const CameraMatrix &p_projection, const Transform3D &p_transform, double p_time, float p_luminance_multiplier) {
 	ERR_FAIL_COND(!p_env);
 
@@ -1244,8 +1276,18 @@ void RendererSceneSkyRD::update(RendererSceneEnvironmentRD *p_env, const CameraM
 
 	int max_processing_layer = sky_use_cubemap_array ? sky->reflection.layers.size() : sky->reflection.layers[0].mipmaps.size();
 
+	// Limit how often an already rendered radiance cubemap is refreshed, skies animated by TIME
+	// or by a moving sun would otherwise update every frame.
+	bool throttled = false;
+	if (sky->reflection.dirty && sky_max_updates_per_second > 0 && sky->radiance_update_usec != 0) {
+		throttled = OS::get_singleton()->get_ticks_usec() - sky->radiance_update_usec < uint64_t(1000000 / sky_max_updates_per_second);
+		if (throttled) {
+			RenderingServerDefault::redraw_request();
+		}
+	}
+
 	// Update radiance cubemap
-	if (sky->reflection.dirty && (sky->processing_layer >= max_processing_layer || update_single_frame)) {
+	if (sky->reflection.dirty && !throttled && (sky->processing_layer >= max_processing_layer || update_single_frame)) {
 		static const Vector3 view_normals[6] = {
 			Vector3(+1, 0, 0),
 			Vector3(-1, 0, 0),
@@ -1344,6 +1386,14 @@ void RendererSceneSkyRD::update(RendererSceneEnvironmentRD *p_env, const CameraM
 		}
 
 		sky->reflection.dirty = false;
+		sky->radiance_update_usec = MAX(OS::get_singleton()->get_ticks_usec(), uint64_t(1));
+
+		if (shader_data->uses_light) {
+			sky->radiance_lights.resize(sky_scene_state.last_frame_directional_light_count);
+			for (uint32_t i = 0; i < sky->radiance_lights.size(); i++) {
+				sky->radiance_lights[i] = sky_scene_state.last_frame_directional_lights[i];
+			}
+		}
 
 	} else {
 		if (sky_mode == RS::SKY_MODE_INCREMENTAL && sky->processing_layer < max_processing_layer) {
@@ -1728,6 +1778,7 @@ void RendererSceneSkyRD::update_dirty_skys() {
 
 		sky->reflection.dirty = true;
 		sky->processing_layer = 0;
+		sky->radiance_update_usec = 0;
 
 		Sky *next = sky->dirty_list;
 		sky->dirty_list = nullptr;
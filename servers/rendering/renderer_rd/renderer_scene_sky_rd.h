@@ -267,6 +267,10 @@ public:
 		Vector3 prev_position;
 		float prev_time;
 
+		// Directional lights the radiance cubemap was last rendered with, and when.
+		LocalVector<SkyDirectionalLightData> radiance_lights;
+		uint64_t radiance_update_usec = 0;
+
 		void free(RendererStorageRD *p_storage);
 
 		RID get_textures(RendererStorageRD *p_storage, SkyTextureSetVersion p_version, RID p_default_shader_rd);
@@ -278,10 +282,14 @@ public:
 
 	uint32_t sky_ggx_samples_quality;
 	bool sky_use_cubemap_array;
+	float sky_light_change_tolerance = 0.0;
+	int sky_max_updates_per_second = 0;
 	Sky *dirty_sky_list = nullptr;
 	mutable RID_Owner<Sky, true> sky_owner;
 	int roughness_layers;
 
+	bool _sky_lights_changed(const Sky *p_sky) const;
+
 	RendererStorageRD::ShaderData *_create_sky_shader_func();
 	static RendererStorageRD::ShaderData *_create_sky_shader_funcs();
 
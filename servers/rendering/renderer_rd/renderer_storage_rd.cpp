@@ -1130,10 +1130,32 @@ void RendererStorageRD::texture_replace(RID p_texture, RID p_by_texture) {
 	Vector<RID> proxies_to_update = tex->proxies;
 	Vector<RID> proxies_to_redirect = by_tex->proxies;
 
+	// Callbacks belong to the owner of the RID, not to its contents.
+	Texture callbacks = *tex;
+
 	*tex = *by_tex;
 
 	tex->proxies = proxies_to_update; //restore proxies, so they can be updated
 
+	tex->detect_3d_callback = callbacks.detect_3d_callback;
+	tex->detect_3d_callback_ud = callbacks.detect_3d_callback_ud;
+	tex->detect_normal_callback = callbacks.detect_normal_callback;
+	tex->detect_normal_callback_ud = callbacks.detect_normal_callback_ud;
+	tex->detect_roughness_callback = callbacks.detect_roughness_callback;
+	tex->detect_roughness_callback_ud = callbacks.detect_roughness_callback_ud;
+
+	if (callbacks.stream_callback) {
+		// A streamed size arrived (or the texture was reloaded), it keeps its full size as the logical one.
+		tex->stream_callback = callbacks.stream_callback;
+		tex->stream_callback_ud = callbacks.stream_callback_ud;
+		tex->stream_requested_size = callbacks.stream_requested_size;
+		tex->stream_last_used = callbacks.stream_last_used;
+		tex->stream_pending = false;
+		tex->stream_mipmaps = callbacks.stream_mipmaps;
+		tex->width_2d = callbacks.width_2d;
+		tex->height_2d = callbacks.height_2d;
+	}
+
 	if (tex->canvas_texture) {
 		tex->canvas_texture->diffuse = p_texture; //update
 	}
@@ -1193,6 +1215,129 @@ void RendererStorageRD::texture_set_detect_roughness_callback(RID p_texture, RS:
 	tex->detect_roughness_callback = p_callback;
 }
 
+void RendererStorageRD::texture_set_stream_callback(RID p_texture, RS::TextureStreamCallback p_callback, void *p_userdata) {
+	Texture *tex = texture_owner.get_or_null(p_texture);
+	ERR_FAIL_COND(!tex);
+	ERR_FAIL_COND(tex->type != Texture::TYPE_2D);
+	tex->stream_callback_ud = p_userdata;
+	tex->stream_callback = p_callback;
+	tex->stream_requested_size = 0;
+	tex->stream_last_used = 0;
+	tex->stream_pending = false;
+	tex->stream_mipmaps = tex->mipmaps > 1 || tex->width != tex->width_2d || tex->height != tex->height_2d;
+
+	if (p_callback) {
+		texture_streaming.textures.insert(p_texture);
+	} else {
+		texture_streaming.textures.erase(p_texture);
+	}
+}
+
+Size2i RendererStorageRD::_texture_stream_fit_size(const Texture *p_texture, uint32_t p_max_size) const {
+	// Mipmaps are skipped until both sides fit, like StreamTexture2D does when loading with a size limit.
+	Size2i size(p_texture->width_2d, p_texture->height_2d);
+	while (p_texture->stream_mipmaps && (uint32_t)MAX(size.width, size.height) > p_max_size && (size.width > 1 || size.height > 1)) {
+		size.width = MAX(1, size.width >> 1);
+		size.height = MAX(1, size.height >> 1);
+	}
+	return size;
+}
+
+uint64_t RendererStorageRD::_texture_stream_get_size_bytes(const Texture *p_texture, uint32_t p_max_size) const {
+	Size2i size = _texture_stream_fit_size(p_texture, p_max_size);
+	return Image::get_image_data_size(size.width, size.height, p_texture->validated_format, p_texture->mipmaps > 1);
+}
+
+void RendererStorageRD::_update_texture_streaming() {
+	uint64_t frame = texture_streaming.frame++; // Requests so far were made while drawing this frame.
+
+	if (texture_streaming.textures.is_empty()) {
+		return;
+	}
+
+	struct StreamedTexture {
+		Texture *texture = nullptr;
+		uint32_t size = 0;
+		uint32_t requested_size = 0;
+		uint64_t last_used = 0;
+
+		bool operator<(const StreamedTexture &p_texture) const {
+			// Least recently used first, then the ones covering the least of the screen.
+			if (last_used == p_texture.last_used) {
+				return requested_size < p_texture.requested_size;
+			}
+			return last_used < p_texture.last_used;
+		}
+	};
+
+	LocalVector<StreamedTexture> streamed;
+	streamed.reserve(texture_streaming.textures.size());
+	uint64_t total_bytes = 0;
+
+	for (Set<RID>::Element *E = texture_streaming.textures.front(); E; E = E->next()) {
+		Texture *tex = texture_owner.get_or_null(E->get());
+		ERR_CONTINUE(!tex);
+
+		uint32_t full_size = MAX(tex->width_2d, tex->height_2d);
+		uint32_t resident_size = MAX(tex->width, tex->height);
+
+		StreamedTexture st;
+		st.texture = tex;
+		st.last_used = tex->stream_last_used;
+		st.requested_size = CLAMP(next_power_of_2(tex->stream_requested_size), texture_streaming.min_size, full_size);
+
+		if (tex->stream_requested_size > 0) {
+			// Only grow while drawn, shrinking is left to eviction and the budget so sizes don't flip back and forth.
+			st.size = MAX(st.requested_size, resident_size);
+		} else if (frame - tex->stream_last_used < TEXTURE_STREAM_UNUSED_FRAMES) {
+			st.size = resident_size;
+		} else {
+			st.size = texture_streaming.min_size;
+		}
+		st.size = CLAMP(st.size, MIN(texture_streaming.min_size, full_size), full_size);
+
+		tex->stream_requested_size = 0;
+		total_bytes += _texture_stream_get_size_bytes(tex, st.size);
+		streamed.push_back(st);
+	}
+
+	if (total_bytes > texture_streaming.budget) {
+		streamed.sort();
+
+		// First drop what is resident beyond the size things are drawn at, then go below that.
+		for (int pass = 0; pass < 2 && total_bytes > texture_streaming.budget; pass++) {
+			for (uint32_t i = 0; i < streamed.size() && total_bytes > texture_streaming.budget; i++) {
+				StreamedTexture &st = streamed[i];
+				uint32_t min_size = pass == 0 ? st.requested_size : texture_streaming.min_size;
+
+				while (st.size > min_size && total_bytes > texture_streaming.budget) {
+					total_bytes -= _texture_stream_get_size_bytes(st.texture, st.size);
+					st.size = MAX(st.size >> 1, min_size);
+					total_bytes += _texture_stream_get_size_bytes(st.texture, st.size);
+				}
+			}
+		}
+	}
+
+	uint32_t loads = 0;
+
+	for (uint32_t i = 0; i < streamed.size() && loads < texture_streaming.max_loads_per_frame; i++) {
+		Texture *tex = streamed[i].texture;
+		if (tex->stream_pending) {
+			continue;
+		}
+
+		Size2i size = _texture_stream_fit_size(tex, streamed[i].size);
+		if (size.width == tex->width && size.height == tex->height) {
+			continue;
+		}
+
+		tex->stream_pending = true;
+		tex->stream_callback(tex->stream_callback_ud, MAX(size.width, size.height));
+		loads++;
+	}
+}
+
 void RendererStorageRD::texture_debug_usage(List<RS::TextureInfo> *r_info) {
 }
 
@@ -1278,6 +1423,11 @@ bool RendererStorageRD::canvas_texture_get_uniform_set(RID p_texture, RS::Canvas
 	Texture *t = texture_owner.get_or_null(p_texture);
 
 	if (t) {
+		if (t->stream_callback) {
+			// 2D draws at most one texel per pixel, so the full size is the one needed.
+			_texture_stream_request(t, MAX(t->width_2d, t->height_2d));
+		}
+
 		//regular texture
 		if (!t->canvas_texture) {
 			t->canvas_texture = memnew(CanvasTexture);
@@ -1446,6 +1596,10 @@ void RendererStorageRD::shader_set_code(RID p_shader, const String &p_code) {
 
 	if (shader->data) {
 		shader->data->set_code(p_code);
+
+		if (shader->data->is_compiling() && compiling_shaders.find(p_shader) < 0) {
+			compiling_shaders.push_back(p_shader);
+		}
 	}
 
 	for (Set<Material *>::Element *E = shader->owners.front(); E; E = E->next()) {
@@ -1455,6 +1609,29 @@ void RendererStorageRD::shader_set_code(RID p_shader, const String &p_code) {
 	}
 }
 
+void RendererStorageRD::_update_compiling_shaders() {
+	for (uint32_t i = 0; i < compiling_shaders.size(); i++) {
+		Shader *shader = shader_owner.get_or_null(compiling_shaders[i]);
+		if (shader && shader->data) {
+			if (shader->data->is_compiling()) {
+				continue;
+			}
+
+			shader->data->finish_compile();
+
+			// Materials were using a fallback, update them to the compiled shader.
+			for (Set<Material *>::Element *E = shader->owners.front(); E; E = E->next()) {
+				Material *material = E->get();
+				material->dependency.changed_notify(DEPENDENCY_CHANGED_MATERIAL);
+				_material_queue_update(material, true, true);
+			}
+		}
+
+		compiling_shaders.remove_unordered(i);
+		i--;
+	}
+}
+
 String RendererStorageRD::shader_get_code(RID p_shader) const {
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_COND_V(!shader, String());
@@ -2603,6 +2780,10 @@ RendererStorageRD::MaterialData::~MaterialData() {
 		rs->global_variables.materials_using_texture.erase(global_texture_E);
 	}
 
+	if (uniform_buffer_upload_pending) {
+		base_singleton->material_uniform_uploads.erase(this);
+	}
+
 	if (uniform_buffer.is_valid()) {
 		RD::get_singleton()->free(uniform_buffer);
 	}
@@ -2619,6 +2800,8 @@ void RendererStorageRD::MaterialData::update_textures(const Map<StringName, Vari
 	bool uses_global_textures = false;
 	global_textures_pass++;
 
+	streamed_textures.clear();
+
 	for (int i = 0, k = 0; i < p_texture_uniforms.size(); i++) {
 		const StringName &uniform_name = p_texture_uniforms[i].name;
 		int uniform_array_size = p_texture_uniforms[i].array_size;
@@ -2727,6 +2910,9 @@ void RendererStorageRD::MaterialData::update_textures(const Map<StringName, Vari
 
 				if (tex) {
 					rd_texture = (srgb && tex->rd_texture_srgb.is_valid()) ? tex->rd_texture_srgb : tex->rd_texture;
+					if (tex->stream_callback) {
+						streamed_textures.push_back(textures[j]);
+					}
 #ifdef TOOLS_ENABLED
 					if (tex->detect_3d_callback && p_use_linear_color) {
 						tex->detect_3d_callback(tex->detect_3d_callback_ud);
@@ -2796,6 +2982,10 @@ void RendererStorageRD::MaterialData::free_parameters_uniform_set(RID p_uniform_
 }
 
 bool RendererStorageRD::MaterialData::update_parameters_uniform_set(const Map<StringName, Variant> &p_parameters, bool p_uniform_dirty, bool p_textures_dirty, const Map<StringName, ShaderLanguage::ShaderNode::Uniform> &p_uniforms, const uint32_t *p_uniform_offsets, const Vector<ShaderCompilerRD::GeneratedCode::Texture> &p_texture_uniforms, const Map<StringName, RID> &p_default_texture_params, uint32_t p_ubo_size, RID &uniform_set, RID p_shader, uint32_t p_shader_uniform_set, uint32_t p_barrier) {
+	if (p_shader.is_null()) {
+		return false; // Shader is still compiling (or failed to), the material is updated again once it's ready.
+	}
+
 	if ((uint32_t)ubo_data.size() != p_ubo_size) {
 		p_uniform_dirty = true;
 		if (uniform_buffer.is_valid()) {
@@ -2820,7 +3010,16 @@ bool RendererStorageRD::MaterialData::update_parameters_uniform_set(const Map<St
 	//check whether buffer changed
 	if (p_uniform_dirty && ubo_data.size()) {
 		update_uniform_buffer(p_uniforms, p_uniform_offsets, p_parameters, ubo_data.ptrw(), ubo_data.size(), false);
-		RD::get_singleton()->buffer_update(uniform_buffer, 0, ubo_data.size(), ubo_data.ptrw(), p_barrier);
+		RendererStorageRD *rs = base_singleton;
+		if (rs->material_uniform_uploads_deferred) {
+			if (!uniform_buffer_upload_pending) {
+				uniform_buffer_upload_pending = true;
+				rs->material_uniform_uploads.push_back(this);
+			}
+			rs->material_uniform_upload_barrier |= p_barrier;
+		} else {
+			RD::get_singleton()->buffer_update(uniform_buffer, 0, ubo_data.size(), ubo_data.ptrw(), p_barrier);
+		}
 	}
 
 	uint32_t tex_uniform_count = 0U;
@@ -2908,7 +3107,29 @@ void RendererStorageRD::material_force_update_textures(RID p_material, ShaderTyp
 	}
 }
 
+void RendererStorageRD::_flush_material_uniform_uploads() {
+	if (material_uniform_uploads.is_empty()) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < material_uniform_uploads.size(); i++) {
+		MaterialData *data = material_uniform_uploads[i];
+		data->uniform_buffer_upload_pending = false;
+		if (data->uniform_buffer.is_null()) {
+			continue; // Shader changed to one without uniforms since.
+		}
+		RD::get_singleton()->buffer_update(data->uniform_buffer, 0, data->ubo_data.size(), data->ubo_data.ptr(), RD::BARRIER_MASK_NO_BARRIER);
+	}
+	material_uniform_uploads.clear();
+
+	// The stages reading the buffers wait once for all the copies, instead of once per material.
+	RD::get_singleton()->barrier(RD::BARRIER_MASK_TRANSFER, material_uniform_upload_barrier & RD::BARRIER_MASK_ALL);
+	material_uniform_upload_barrier = 0;
+}
+
 void RendererStorageRD::_update_queued_materials() {
+	material_uniform_uploads_deferred = true;
+
 	while (material_update_list.first()) {
 		Material *material = material_update_list.first()->self();
 		bool uniforms_changed = false;
@@ -2926,6 +3147,9 @@ void RendererStorageRD::_update_queued_materials() {
 			material->dependency.changed_notify(DEPENDENCY_CHANGED_MATERIAL);
 		}
 	}
+
+	material_uniform_uploads_deferred = false;
+	_flush_material_uniform_uploads();
 }
 
 /* MESH API */
@@ -2984,13 +3208,9 @@ void RendererStorageRD::mesh_add_surface(RID p_mesh, const RS::SurfaceData &p_su
 					case RS::ARRAY_COLOR: {
 						attrib_stride += sizeof(uint32_t);
 					} break;
-					case RS::ARRAY_TEX_UV: {
-						attrib_stride += sizeof(float) * 2;
-
-					} break;
+					case RS::ARRAY_TEX_UV:
 					case RS::ARRAY_TEX_UV2: {
-						attrib_stride += sizeof(float) * 2;
-
+						attrib_stride += (p_surface.format & RS::ARRAY_FLAG_COMPRESS_UV) ? sizeof(uint16_t) * 2 : sizeof(float) * 2;
 					} break;
 					case RS::ARRAY_CUSTOM0:
 					case RS::ARRAY_CUSTOM1:
@@ -3057,22 +3277,39 @@ void RendererStorageRD::mesh_add_surface(RID p_mesh, const RS::SurfaceData &p_su
 
 	if (p_surface.index_count) {
 		bool is_index_16 = p_surface.vertex_count <= 65536;
+		// When streaming, only the coarsest level is uploaded now, the others once something is drawn with them.
+		bool stream_lods = mesh_lod_streaming.enabled && p_surface.lods.size();
 
-		s->index_buffer = RD::get_singleton()->index_buffer_create(p_surface.index_count, is_index_16 ? RD::INDEX_BUFFER_FORMAT_UINT16 : RD::INDEX_BUFFER_FORMAT_UINT32, p_surface.index_data, false);
 		s->index_count = p_surface.index_count;
-		s->index_array = RD::get_singleton()->index_array_create(s->index_buffer, 0, s->index_count);
+		if (stream_lods) {
+			s->index_data = p_surface.index_data;
+		} else {
+			s->index_buffer = RD::get_singleton()->index_buffer_create(p_surface.index_count, is_index_16 ? RD::INDEX_BUFFER_FORMAT_UINT16 : RD::INDEX_BUFFER_FORMAT_UINT32, p_surface.index_data, false);
+			s->index_array = RD::get_singleton()->index_array_create(s->index_buffer, 0, s->index_count);
+		}
 		if (p_surface.lods.size()) {
 			s->lods = memnew_arr(Mesh::Surface::LOD, p_surface.lods.size());
 			s->lod_count = p_surface.lods.size();
 
 			for (int i = 0; i < p_surface.lods.size(); i++) {
 				uint32_t indices = p_surface.lods[i].index_data.size() / (is_index_16 ? 2 : 4);
-				s->lods[i].index_buffer = RD::get_singleton()->index_buffer_create(indices, is_index_16 ? RD::INDEX_BUFFER_FORMAT_UINT16 : RD::INDEX_BUFFER_FORMAT_UINT32, p_surface.lods[i].index_data);
-				s->lods[i].index_array = RD::get_singleton()->index_array_create(s->lods[i].index_buffer, 0, indices);
+				if (stream_lods && i < p_surface.lods.size() - 1) {
+					s->lods[i].index_data = p_surface.lods[i].index_data;
+				} else {
+					s->lods[i].index_buffer = RD::get_singleton()->index_buffer_create(indices, is_index_16 ? RD::INDEX_BUFFER_FORMAT_UINT16 : RD::INDEX_BUFFER_FORMAT_UINT32, p_surface.lods[i].index_data);
+					s->lods[i].index_array = RD::get_singleton()->index_array_create(s->lods[i].index_buffer, 0, indices);
+				}
 				s->lods[i].edge_length = p_surface.lods[i].edge_length;
 				s->lods[i].index_count = indices;
 			}
 		}
+
+		if (stream_lods) {
+			s->lod_resident = s->lod_count;
+			s->lod_resident_last_used = mesh_lod_streaming.frame;
+			s->lod_stream_index = mesh_lod_streaming.surfaces.size();
+			mesh_lod_streaming.surfaces.push_back(s);
+		}
 	}
 
 	s->aabb = p_surface.aabb;
@@ -3247,13 +3484,13 @@ RS::SurfaceData RendererStorageRD::mesh_get_surface(RID p_mesh, int p_surface) c
 	sd.primitive = s.primitive;
 
 	if (sd.index_count) {
-		sd.index_data = RD::get_singleton()->buffer_get_data(s.index_buffer);
+		sd.index_data = s.index_buffer.is_valid() ? RD::get_singleton()->buffer_get_data(s.index_buffer) : s.index_data;
 	}
 	sd.aabb = s.aabb;
 	for (uint32_t i = 0; i < s.lod_count; i++) {
 		RS::SurfaceData::LOD lod;
 		lod.edge_length = s.lods[i].edge_length;
-		lod.index_data = RD::get_singleton()->buffer_get_data(s.lods[i].index_buffer);
+		lod.index_data = s.lods[i].index_buffer.is_valid() ? RD::get_singleton()->buffer_get_data(s.lods[i].index_buffer) : s.lods[i].index_data;
 		sd.lods.push_back(lod);
 	}
 
@@ -3408,6 +3645,65 @@ void RendererStorageRD::mesh_set_shadow_mesh(RID p_mesh, RID p_shadow_mesh) {
 	mesh->dependency.changed_notify(DEPENDENCY_CHANGED_MESH);
 }
 
+void RendererStorageRD::_mesh_surface_set_lod_resident(Mesh::Surface *p_surface, uint32_t p_lod, bool p_resident) {
+	RID *index_buffer;
+	RID *index_array;
+	const Vector<uint8_t> *index_data;
+	uint32_t index_count;
+
+	if (p_lod == 0) {
+		index_buffer = &p_surface->index_buffer;
+		index_array = &p_surface->index_array;
+		index_data = &p_surface->index_data;
+		index_count = p_surface->index_count;
+	} else {
+		Mesh::Surface::LOD &lod = p_surface->lods[p_lod - 1];
+		index_buffer = &lod.index_buffer;
+		index_array = &lod.index_array;
+		index_data = &lod.index_data;
+		index_count = lod.index_count;
+	}
+
+	if (p_resident) {
+		ERR_FAIL_COND(index_buffer->is_valid());
+		bool is_index_16 = p_surface->vertex_count <= 65536;
+		*index_buffer = RD::get_singleton()->index_buffer_create(index_count, is_index_16 ? RD::INDEX_BUFFER_FORMAT_UINT16 : RD::INDEX_BUFFER_FORMAT_UINT32, *index_data);
+		*index_array = RD::get_singleton()->index_array_create(*index_buffer, 0, index_count);
+	} else {
+		ERR_FAIL_COND(!index_buffer->is_valid());
+		RD::get_singleton()->free(*index_buffer); // Frees the index array too.
+		*index_buffer = RID();
+		*index_array = RID();
+	}
+}
+
+void RendererStorageRD::_update_mesh_lod_streaming() {
+	uint64_t frame = mesh_lod_streaming.frame++;
+
+	for (uint32_t i = 0; i < mesh_lod_streaming.surfaces.size(); i++) {
+		Mesh::Surface *s = mesh_lod_streaming.surfaces[i];
+
+		if (s->lod_requested < s->lod_resident) {
+			// Upload everything down to the requested level, it was drawn coarser meanwhile.
+			while (s->lod_resident > s->lod_requested) {
+				s->lod_resident--;
+				_mesh_surface_set_lod_resident(s, s->lod_resident, true);
+			}
+		}
+
+		if (s->lod_requested <= s->lod_resident) {
+			s->lod_resident_last_used = frame;
+		} else if (s->lod_resident < s->lod_count && frame - s->lod_resident_last_used > MESH_LOD_STREAM_UNUSED_FRAMES) {
+			// Drop one level at a time, so meshes moving away lose detail gradually.
+			_mesh_surface_set_lod_resident(s, s->lod_resident, false);
+			s->lod_resident++;
+			s->lod_resident_last_used = frame;
+		}
+
+		s->lod_requested = 0xFFFFFFFF;
+	}
+}
+
 void RendererStorageRD::mesh_clear(RID p_mesh) {
 	Mesh *mesh = mesh_owner.get_or_null(p_mesh);
 	ERR_FAIL_COND(!mesh);
@@ -3430,11 +3726,20 @@ void RendererStorageRD::mesh_clear(RID p_mesh) {
 
 		if (s.lod_count) {
 			for (uint32_t j = 0; j < s.lod_count; j++) {
-				RD::get_singleton()->free(s.lods[j].index_buffer);
+				if (s.lods[j].index_buffer.is_valid()) {
+					RD::get_singleton()->free(s.lods[j].index_buffer);
+				}
 			}
 			memdelete_arr(s.lods);
 		}
 
+		if (s.lod_stream_index >= 0) {
+			mesh_lod_streaming.surfaces.remove_unordered(s.lod_stream_index);
+			if (uint32_t(s.lod_stream_index) < mesh_lod_streaming.surfaces.size()) {
+				mesh_lod_streaming.surfaces[s.lod_stream_index]->lod_stream_index = s.lod_stream_index;
+			}
+		}
+
 		if (s.blend_shape_buffer.is_valid()) {
 			RD::get_singleton()->free(s.blend_shape_buffer);
 		}
@@ -3779,19 +4084,18 @@ void RendererStorageRD::_mesh_surface_generate_version_for_input_mask(Mesh::Surf
 					attribute_stride += sizeof(int8_t) * 4;
 					buffer = s->attribute_buffer;
 				} break;
-				case RS::ARRAY_TEX_UV: {
-					vd.offset = attribute_stride;
-
-					vd.format = RD::DATA_FORMAT_R32G32_SFLOAT;
-					attribute_stride += sizeof(float) * 2;
-					buffer = s->attribute_buffer;
-
-				} break;
+				case RS::ARRAY_TEX_UV:
 				case RS::ARRAY_TEX_UV2: {
 					vd.offset = attribute_stride;
 
-					vd.format = RD::DATA_FORMAT_R32G32_SFLOAT;
-					attribute_stride += sizeof(float) * 2;
+					if (s->format & RS::ARRAY_FLAG_COMPRESS_UV) {
+						// Half floats, expanded by the vertex fetch so shaders don't change.
+						vd.format = RD::DATA_FORMAT_R16G16_SFLOAT;
+						attribute_stride += sizeof(uint16_t) * 2;
+					} else {
+						vd.format = RD::DATA_FORMAT_R32G32_SFLOAT;
+						attribute_stride += sizeof(float) * 2;
+					}
 					buffer = s->attribute_buffer;
 				} break;
 				case RS::ARRAY_CUSTOM0:
@@ -3877,6 +4181,21 @@ void RendererStorageRD::multimesh_allocate_data(RID p_multimesh, int p_instances
 		multimesh->buffer = RID();
 		multimesh->uniform_set_2d = RID(); //cleared by dependency
 		multimesh->uniform_set_3d = RID(); //cleared by dependency
+		multimesh->cull_uniform_set = RID(); //cleared by dependency
+	}
+
+	if (multimesh->culled_buffer.is_valid()) {
+		RD::get_singleton()->free(multimesh->culled_buffer);
+		multimesh->culled_buffer = RID();
+		multimesh->culled_uniform_set_3d = RID(); //cleared by dependency
+		multimesh->cull_uniform_set = RID(); //cleared by dependency
+	}
+
+	if (multimesh->command_buffer.is_valid()) {
+		RD::get_singleton()->free(multimesh->command_buffer);
+		multimesh->command_buffer = RID();
+		multimesh->command_buffer_surfaces = 0;
+		multimesh->cull_uniform_set = RID(); //cleared by dependency
 	}
 
 	if (multimesh->data_cache_dirty_regions) {
@@ -3907,6 +4226,99 @@ void RendererStorageRD::multimesh_allocate_data(RID p_multimesh, int p_instances
 	multimesh->dependency.changed_notify(DEPENDENCY_CHANGED_MULTIMESH);
 }
 
+bool RendererStorageRD::multimesh_gpu_cull(RID p_multimesh, uint64_t p_pass, const Plane *p_planes, const uint32_t *p_surface_draw_counts, uint32_t p_surface_count) {
+	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+	ERR_FAIL_COND_V(!multimesh, false);
+	ERR_FAIL_COND_V(multimesh->xform_format != RS::MULTIMESH_TRANSFORM_3D, false);
+	ERR_FAIL_COND_V(p_surface_count == 0 || p_surface_count > 0xFFFFFF, false);
+
+	uint32_t instances = multimesh_get_instances_to_draw(p_multimesh);
+	if (instances == 0 || multimesh->cull_pass == p_pass) {
+		return false;
+	}
+	multimesh->cull_pass = p_pass;
+
+	if (!multimesh->culled_buffer.is_valid()) {
+		multimesh->culled_buffer = RD::get_singleton()->storage_buffer_create(multimesh->instances * multimesh->stride_cache * 4);
+	}
+
+	if (multimesh->command_buffer_surfaces != p_surface_count) {
+		if (multimesh->command_buffer.is_valid()) {
+			RD::get_singleton()->free(multimesh->command_buffer);
+			multimesh->cull_uniform_set = RID(); //cleared by dependency
+		}
+		multimesh->command_buffer = RD::get_singleton()->storage_buffer_create(p_surface_count * 5 * sizeof(uint32_t), Vector<uint8_t>(), RD::STORAGE_BUFFER_USAGE_DISPATCH_INDIRECT);
+		multimesh->command_buffer_surfaces = p_surface_count;
+	}
+
+	if (!multimesh->cull_uniform_set.is_valid() || !RD::get_singleton()->uniform_set_is_valid(multimesh->cull_uniform_set)) {
+		Vector<RD::Uniform> uniforms;
+		{
+			RD::Uniform u;
+			u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.binding = 0;
+			u.ids.push_back(multimesh->buffer);
+			uniforms.push_back(u);
+		}
+		{
+			RD::Uniform u;
+			u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.binding = 1;
+			u.ids.push_back(multimesh->culled_buffer);
+			uniforms.push_back(u);
+		}
+		{
+			RD::Uniform u;
+			u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.binding = 2;
+			u.ids.push_back(multimesh->command_buffer);
+			uniforms.push_back(u);
+		}
+		multimesh->cull_uniform_set = RD::get_singleton()->uniform_set_create(uniforms, multimesh_cull_shader.shader.version_get_shader(multimesh_cull_shader.version, 0), 0);
+	}
+
+	// Reset the commands, the shader only adds to the instance counts.
+	LocalVector<uint32_t> commands;
+	commands.resize(p_surface_count * 5);
+	for (uint32_t i = 0; i < p_surface_count; i++) {
+		commands[i * 5 + 0] = p_surface_draw_counts[i]; // Index or vertex count.
+		commands[i * 5 + 1] = 0; // Instance count.
+		commands[i * 5 + 2] = 0; // First index or vertex.
+		commands[i * 5 + 3] = 0; // Vertex offset or first instance.
+		commands[i * 5 + 4] = 0; // First instance.
+	}
+	RD::get_singleton()->buffer_update(multimesh->command_buffer, 0, commands.size() * sizeof(uint32_t), commands.ptr(), RD::BARRIER_MASK_COMPUTE);
+
+	MultiMeshCullShader::PushConstant push_constant;
+	for (int i = 0; i < 6; i++) {
+		push_constant.planes[i][0] = p_planes[i].normal.x;
+		push_constant.planes[i][1] = p_planes[i].normal.y;
+		push_constant.planes[i][2] = p_planes[i].normal.z;
+		push_constant.planes[i][3] = p_planes[i].d;
+	}
+
+	AABB aabb = mesh_get_aabb(multimesh->mesh, RID());
+	Vector3 center = aabb.position + aabb.size * 0.5;
+	Vector3 extents = aabb.size * 0.5;
+	push_constant.aabb_center[0] = center.x;
+	push_constant.aabb_center[1] = center.y;
+	push_constant.aabb_center[2] = center.z;
+	push_constant.total_instances = instances;
+	push_constant.aabb_extents[0] = extents.x;
+	push_constant.aabb_extents[1] = extents.y;
+	push_constant.aabb_extents[2] = extents.z;
+	push_constant.stride_and_surfaces = (multimesh->stride_cache / 4) | (p_surface_count << 8);
+
+	RD::ComputeListID compute_list = RD::get_singleton()->compute_list_begin();
+	RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, multimesh_cull_shader.pipeline);
+	RD::get_singleton()->compute_list_bind_uniform_set(compute_list, multimesh->cull_uniform_set, 0);
+	RD::get_singleton()->compute_list_set_push_constant(compute_list, &push_constant, sizeof(MultiMeshCullShader::PushConstant));
+	RD::get_singleton()->compute_list_dispatch_threads(compute_list, instances, 1, 1);
+	RD::get_singleton()->compute_list_end(RD::BARRIER_MASK_RASTER);
+
+	return true;
+}
+
 int RendererStorageRD::multimesh_get_instance_count(RID p_multimesh) const {
 	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
 	ERR_FAIL_COND_V(!multimesh, 0);
@@ -4301,6 +4713,36 @@ void RendererStorageRD::multimesh_set_buffer(RID p_multimesh, const Vector<float
 	}
 }
 
+void RendererStorageRD::multimesh_set_buffer_range(RID p_multimesh, int p_from_instance, const Vector<float> &p_buffer) {
+	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+	ERR_FAIL_COND(!multimesh);
+	ERR_FAIL_COND(multimesh->stride_cache == 0 || p_buffer.size() % multimesh->stride_cache != 0);
+
+	int count = p_buffer.size() / multimesh->stride_cache;
+	ERR_FAIL_COND(p_from_instance < 0 || p_from_instance + count > multimesh->instances);
+
+	if (count == 0) {
+		return;
+	}
+
+	if (count == multimesh->instances) {
+		multimesh_set_buffer(p_multimesh, p_buffer);
+		return;
+	}
+
+	// The AABB needs the instances outside the range too, so keep the data local like the
+	// per instance setters do. Only the dirty regions get uploaded.
+	_multimesh_make_local(multimesh);
+
+	memcpy(multimesh->data_cache.ptrw() + p_from_instance * multimesh->stride_cache, p_buffer.ptr(), p_buffer.size() * sizeof(float));
+
+	int from_region = p_from_instance / MULTIMESH_DIRTY_REGION_SIZE;
+	int to_region = (p_from_instance + count - 1) / MULTIMESH_DIRTY_REGION_SIZE;
+	for (int i = from_region; i <= to_region; i++) {
+		_multimesh_mark_dirty(multimesh, i * MULTIMESH_DIRTY_REGION_SIZE, true);
+	}
+}
+
 Vector<float> RendererStorageRD::multimesh_get_buffer(RID p_multimesh) const {
 	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
 	ERR_FAIL_COND_V(!multimesh, Vector<float>());
@@ -4372,17 +4814,35 @@ void RendererStorageRD::_update_dirty_multimeshes() {
 
 				uint32_t region_size = multimesh->stride_cache * MULTIMESH_DIRTY_REGION_SIZE * sizeof(float);
 
-				if (multimesh->data_cache_used_dirty_regions > 32 || multimesh->data_cache_used_dirty_regions > visible_region_count / 2) {
+				// Consecutive dirty regions are uploaded together, count how many updates that takes.
+				uint32_t dirty_runs = 0;
+				for (uint32_t i = 0; i < visible_region_count; i++) {
+					if (multimesh->data_cache_dirty_regions[i] && (i == 0 || !multimesh->data_cache_dirty_regions[i - 1])) {
+						dirty_runs++;
+					}
+				}
+
+				uint32_t size = multimesh->stride_cache * (uint32_t)multimesh->instances * (uint32_t)sizeof(float);
+
+				if (dirty_runs > 32 || multimesh->data_cache_used_dirty_regions > visible_region_count / 2) {
 					//if there too many dirty regions, or represent the majority of regions, just copy all, else transfer cost piles up too much
-					RD::get_singleton()->buffer_update(multimesh->buffer, 0, MIN(visible_region_count * region_size, multimesh->instances * (uint32_t)multimesh->stride_cache * (uint32_t)sizeof(float)), data);
+					RD::get_singleton()->buffer_update(multimesh->buffer, 0, MIN(visible_region_count * region_size, size), data);
 				} else {
-					//not that many regions? update them all
-					for (uint32_t i = 0; i < visible_region_count; i++) {
-						if (multimesh->data_cache_dirty_regions[i]) {
-							uint32_t offset = i * region_size;
-							uint32_t size = multimesh->stride_cache * (uint32_t)multimesh->instances * (uint32_t)sizeof(float);
-							RD::get_singleton()->buffer_update(multimesh->buffer, offset, MIN(region_size, size - offset), &data[i * region_size]);
+					//not that many regions? update each run of them
+					uint32_t i = 0;
+					while (i < visible_region_count) {
+						if (!multimesh->data_cache_dirty_regions[i]) {
+							i++;
+							continue;
+						}
+
+						uint32_t from = i;
+						while (i < visible_region_count && multimesh->data_cache_dirty_regions[i]) {
+							i++;
 						}
+
+						uint32_t offset = from * region_size;
+						RD::get_singleton()->buffer_update(multimesh->buffer, offset, MIN((i - from) * region_size, size - offset), &data[offset / sizeof(float)]);
 					}
 				}
 
@@ -4480,6 +4940,26 @@ void RendererStorageRD::_particles_free_data(Particles *particles) {
 		particles->particles_sort_uniform_set = RID();
 	}
 
+	if (particles->particles_sort_temp_buffer.is_valid()) {
+		RD::get_singleton()->free(particles->particles_sort_temp_buffer);
+		particles->particles_sort_temp_buffer = RID();
+		RD::get_singleton()->free(particles->particles_sort_histogram_buffer);
+		particles->particles_sort_histogram_buffer = RID();
+	}
+
+	if (particles->alive_buffer.is_valid()) {
+		RD::get_singleton()->free(particles->alive_buffer);
+		particles->alive_buffer = RID();
+		particles->alive_uniform_set = RID();
+	}
+
+	if (particles->command_buffer.is_valid()) {
+		RD::get_singleton()->free(particles->command_buffer);
+		particles->command_buffer = RID();
+		particles->command_buffer_count = 0;
+		particles->command_uniform_set = RID();
+	}
+
 	if (particles->emission_buffer != nullptr) {
 		particles->emission_buffer = nullptr;
 		particles->emission_buffer_data.clear();
@@ -5254,7 +5734,7 @@ void RendererStorageRD::_particles_process(Particles *p_particles, double p_delt
 	RD::get_singleton()->buffer_update(p_particles->frame_params_buffer, 0, sizeof(ParticlesFrameParams) * p_particles->trail_params.size(), p_particles->trail_params.ptr());
 
 	ParticlesMaterialData *m = (ParticlesMaterialData *)material_get_data(p_particles->process_material, SHADER_TYPE_PARTICLES);
-	if (!m) {
+	if (!m || !m->shader_data->valid) {
 		m = (ParticlesMaterialData *)material_get_data(particles_shader.default_material, SHADER_TYPE_PARTICLES);
 	}
 
@@ -5291,6 +5771,9 @@ void RendererStorageRD::_particles_process(Particles *p_particles, double p_delt
 	RD::get_singleton()->compute_list_end();
 }
 
+// Below this the bitonic sort needs few enough passes to be faster than the radix sort.
+#define PARTICLES_RADIX_SORT_MIN_AMOUNT 65536
+
 void RendererStorageRD::particles_set_view_axis(RID p_particles, const Vector3 &p_axis, const Vector3 &p_up_axis) {
 	Particles *particles = particles_owner.get_or_null(p_particles);
 	ERR_FAIL_COND(!particles);
@@ -5327,6 +5810,11 @@ void RendererStorageRD::particles_set_view_axis(RID p_particles, const Vector3 &
 
 			particles->particles_sort_uniform_set = RD::get_singleton()->uniform_set_create(uniforms, particles_shader.copy_shader.version_get_shader(particles_shader.copy_shader_version, ParticlesShader::COPY_MODE_FILL_SORT_BUFFER), 1);
 		}
+
+		if (particles->amount >= PARTICLES_RADIX_SORT_MIN_AMOUNT) {
+			particles->particles_sort_temp_buffer = RD::get_singleton()->storage_buffer_create(size);
+			particles->particles_sort_histogram_buffer = RD::get_singleton()->storage_buffer_create(EffectsRD::radix_sort_get_histogram_size(particles->amount));
+		}
 	}
 
 	ParticlesShader::CopyPushConstant copy_push_constant;
@@ -5381,26 +5869,143 @@ void RendererStorageRD::particles_set_view_axis(RID p_particles, const Vector3 &
 		RD::get_singleton()->compute_list_dispatch_threads(compute_list, particles->amount, 1, 1);
 
 		RD::get_singleton()->compute_list_end();
-		effects->sort_buffer(particles->particles_sort_uniform_set, particles->amount);
+		if (particles->particles_sort_temp_buffer.is_valid()) {
+			effects->radix_sort_buffer(particles->particles_sort_buffer, particles->particles_sort_temp_buffer, particles->particles_sort_histogram_buffer, particles->amount);
+		} else {
+			effects->sort_buffer(particles->particles_sort_uniform_set, particles->amount);
+		}
 	}
 
-	copy_push_constant.total_particles *= copy_push_constant.total_particles;
+	copy_push_constant.total_particles *= copy_push_constant.trail_size;
+
+	_particles_fill_instances(particles, copy_push_constant, do_sort);
+}
 
+void RendererStorageRD::_particles_fill_instances(Particles *particles, const ParticlesShader::CopyPushConstant &p_push_constant, bool p_use_sort_buffer) {
 	RD::ComputeListID compute_list = RD::get_singleton()->compute_list_begin();
-	RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, particles_shader.copy_pipelines[do_sort ? ParticlesShader::COPY_MODE_FILL_INSTANCES_WITH_SORT_BUFFER : (particles->mode == RS::PARTICLES_MODE_2D ? ParticlesShader::COPY_MODE_FILL_INSTANCES_2D : ParticlesShader::COPY_MODE_FILL_INSTANCES)]);
+
+	if (!_particles_uses_compaction(particles)) {
+		RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, particles_shader.copy_pipelines[p_use_sort_buffer ? ParticlesShader::COPY_MODE_FILL_INSTANCES_WITH_SORT_BUFFER : (particles->mode == RS::PARTICLES_MODE_2D ? ParticlesShader::COPY_MODE_FILL_INSTANCES_2D : ParticlesShader::COPY_MODE_FILL_INSTANCES)]);
+		RD::get_singleton()->compute_list_bind_uniform_set(compute_list, particles->particles_copy_uniform_set, 0);
+		if (p_use_sort_buffer) {
+			RD::get_singleton()->compute_list_bind_uniform_set(compute_list, particles->particles_sort_uniform_set, 1);
+		}
+		RD::get_singleton()->compute_list_bind_uniform_set(compute_list, particles->trail_bind_pose_uniform_set, 2);
+		RD::get_singleton()->compute_list_set_push_constant(compute_list, &p_push_constant, sizeof(ParticlesShader::CopyPushConstant));
+
+		RD::get_singleton()->compute_list_dispatch_threads(compute_list, p_push_constant.total_particles, 1, 1);
+
+		RD::get_singleton()->compute_list_end();
+		return;
+	}
+
+	// Particles (with their whole trail) still drawn are packed to the front of the instance buffer, keeping
+	// their draw order: count them per work group, scan the counts to write offsets, then fill.
+	uint32_t amount = particles->amount;
+
+	if (particles->alive_buffer.is_null()) {
+		uint32_t groups = (amount + 63) / 64;
+		particles->alive_buffer = RD::get_singleton()->storage_buffer_create((4 + groups) * sizeof(uint32_t));
+
+		Vector<RD::Uniform> uniforms;
+		{
+			RD::Uniform u;
+			u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.binding = 0;
+			u.ids.push_back(particles->alive_buffer);
+			uniforms.push_back(u);
+		}
+		particles->alive_uniform_set = RD::get_singleton()->uniform_set_create(uniforms, particles_shader.copy_shader.version_get_shader(particles_shader.copy_shader_version, ParticlesShader::COPY_MODE_SCAN_ALIVE), 3);
+	}
+
+	RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, particles_shader.copy_pipelines[p_use_sort_buffer ? ParticlesShader::COPY_MODE_COUNT_ALIVE_WITH_SORT_BUFFER : ParticlesShader::COPY_MODE_COUNT_ALIVE]);
 	RD::get_singleton()->compute_list_bind_uniform_set(compute_list, particles->particles_copy_uniform_set, 0);
-	if (do_sort) {
+	if (p_use_sort_buffer) {
 		RD::get_singleton()->compute_list_bind_uniform_set(compute_list, particles->particles_sort_uniform_set, 1);
 	}
 	RD::get_singleton()->compute_list_bind_uniform_set(compute_list, particles->trail_bind_pose_uniform_set, 2);
+	RD::get_singleton()->compute_list_bind_uniform_set(compute_list, particles->alive_uniform_set, 3);
+	RD::get_singleton()->compute_list_set_push_constant(compute_list, &p_push_constant, sizeof(ParticlesShader::CopyPushConstant));
+	RD::get_singleton()->compute_list_dispatch_threads(compute_list, amount, 1, 1);
+	RD::get_singleton()->compute_list_add_barrier(compute_list);
 
-	RD::get_singleton()->compute_list_set_push_constant(compute_list, &copy_push_constant, sizeof(ParticlesShader::CopyPushConstant));
+	RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, particles_shader.copy_pipelines[ParticlesShader::COPY_MODE_SCAN_ALIVE]);
+	RD::get_singleton()->compute_list_bind_uniform_set(compute_list, particles->alive_uniform_set, 3);
+	RD::get_singleton()->compute_list_set_push_constant(compute_list, &p_push_constant, sizeof(ParticlesShader::CopyPushConstant));
+	RD::get_singleton()->compute_list_dispatch(compute_list, 1, 1, 1);
+	RD::get_singleton()->compute_list_add_barrier(compute_list);
 
-	RD::get_singleton()->compute_list_dispatch_threads(compute_list, copy_push_constant.total_particles, 1, 1);
+	RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, particles_shader.copy_pipelines[p_use_sort_buffer ? ParticlesShader::COPY_MODE_FILL_INSTANCES_COMPACT_WITH_SORT_BUFFER : ParticlesShader::COPY_MODE_FILL_INSTANCES_COMPACT]);
+	RD::get_singleton()->compute_list_bind_uniform_set(compute_list, particles->particles_copy_uniform_set, 0);
+	if (p_use_sort_buffer) {
+		RD::get_singleton()->compute_list_bind_uniform_set(compute_list, particles->particles_sort_uniform_set, 1);
+	}
+	RD::get_singleton()->compute_list_bind_uniform_set(compute_list, particles->trail_bind_pose_uniform_set, 2);
+	RD::get_singleton()->compute_list_bind_uniform_set(compute_list, particles->alive_uniform_set, 3);
+	RD::get_singleton()->compute_list_set_push_constant(compute_list, &p_push_constant, sizeof(ParticlesShader::CopyPushConstant));
+	RD::get_singleton()->compute_list_dispatch_threads(compute_list, amount, 1, 1);
 
 	RD::get_singleton()->compute_list_end();
 }
 
+bool RendererStorageRD::particles_write_draw_commands(RID p_particles, uint64_t p_pass, const uint32_t *p_draw_counts, const uint32_t *p_instance_multipliers, uint32_t p_command_count) {
+	Particles *particles = particles_owner.get_or_null(p_particles);
+	ERR_FAIL_COND_V(!particles, false);
+	ERR_FAIL_COND_V(p_command_count == 0, false);
+
+	if (particles->alive_buffer.is_null() || particles->command_pass == p_pass) {
+		return false; // Not compacted yet, or already written by another instance.
+	}
+	particles->command_pass = p_pass;
+
+	if (particles->command_buffer_count != p_command_count) {
+		if (particles->command_buffer.is_valid()) {
+			RD::get_singleton()->free(particles->command_buffer);
+			particles->command_uniform_set = RID(); //cleared by dependency
+		}
+		particles->command_buffer = RD::get_singleton()->storage_buffer_create(p_command_count * 5 * sizeof(uint32_t), Vector<uint8_t>(), RD::STORAGE_BUFFER_USAGE_DISPATCH_INDIRECT);
+		particles->command_buffer_count = p_command_count;
+	}
+
+	if (!particles->command_uniform_set.is_valid() || !RD::get_singleton()->uniform_set_is_valid(particles->command_uniform_set)) {
+		Vector<RD::Uniform> uniforms;
+		{
+			RD::Uniform u;
+			u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.binding = 0;
+			u.ids.push_back(particles->command_buffer);
+			uniforms.push_back(u);
+		}
+		particles->command_uniform_set = RD::get_singleton()->uniform_set_create(uniforms, particles_shader.copy_shader.version_get_shader(particles_shader.copy_shader_version, ParticlesShader::COPY_MODE_WRITE_COMMANDS), 4);
+	}
+
+	// The shader multiplies the instance counts by the alive particles.
+	LocalVector<uint32_t> commands;
+	commands.resize(p_command_count * 5);
+	for (uint32_t i = 0; i < p_command_count; i++) {
+		commands[i * 5 + 0] = p_draw_counts[i]; // Index or vertex count.
+		commands[i * 5 + 1] = p_instance_multipliers[i]; // Instance count.
+		commands[i * 5 + 2] = 0; // First index or vertex.
+		commands[i * 5 + 3] = 0; // Vertex offset or first instance.
+		commands[i * 5 + 4] = 0; // First instance.
+	}
+	RD::get_singleton()->buffer_update(particles->command_buffer, 0, commands.size() * sizeof(uint32_t), commands.ptr(), RD::BARRIER_MASK_COMPUTE);
+
+	ParticlesShader::CopyPushConstant push_constant;
+	memset(&push_constant, 0, sizeof(ParticlesShader::CopyPushConstant));
+	push_constant.command_count = p_command_count;
+
+	RD::ComputeListID compute_list = RD::get_singleton()->compute_list_begin();
+	RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, particles_shader.copy_pipelines[ParticlesShader::COPY_MODE_WRITE_COMMANDS]);
+	RD::get_singleton()->compute_list_bind_uniform_set(compute_list, particles->alive_uniform_set, 3);
+	RD::get_singleton()->compute_list_bind_uniform_set(compute_list, particles->command_uniform_set, 4);
+	RD::get_singleton()->compute_list_set_push_constant(compute_list, &push_constant, sizeof(ParticlesShader::CopyPushConstant));
+	RD::get_singleton()->compute_list_dispatch_threads(compute_list, p_command_count, 1, 1);
+	RD::get_singleton()->compute_list_end(RD::BARRIER_MASK_RASTER);
+
+	return true;
+}
+
 void RendererStorageRD::_particles_update_buffers(Particles *particles) {
 	if (particles->amount > 0 && particles->particle_buffer.is_null()) {
 		int total_amount = particles->amount;
@@ -5633,15 +6238,7 @@ void RendererStorageRD::update_particles() {
 			copy_push_constant.lifetime_split = MIN(particles->amount * particles->phase, particles->amount - 1);
 			copy_push_constant.lifetime_reverse = particles->draw_order == RS::PARTICLES_DRAW_ORDER_REVERSE_LIFETIME;
 
-			RD::ComputeListID compute_list = RD::get_singleton()->compute_list_begin();
-			RD::get_singleton()->compute_list_bind_compute_pipeline(compute_list, particles_shader.copy_pipelines[particles->mode == RS::PARTICLES_MODE_2D ? ParticlesShader::COPY_MODE_FILL_INSTANCES_2D : ParticlesShader::COPY_MODE_FILL_INSTANCES]);
-			RD::get_singleton()->compute_list_bind_uniform_set(compute_list, particles->particles_copy_uniform_set, 0);
-			RD::get_singleton()->compute_list_bind_uniform_set(compute_list, particles->trail_bind_pose_uniform_set, 2);
-			RD::get_singleton()->compute_list_set_push_constant(compute_list, &copy_push_constant, sizeof(ParticlesShader::CopyPushConstant));
-
-			RD::get_singleton()->compute_list_dispatch_threads(compute_list, total_amount, 1, 1);
-
-			RD::get_singleton()->compute_list_end();
+			_particles_fill_instances(particles, copy_push_constant, false);
 		}
 
 		particles->dependency.changed_notify(DEPENDENCY_CHANGED_AABB);
@@ -5665,6 +6262,7 @@ void RendererStorageRD::ParticlesShaderData::set_code(const String &p_code) {
 	ubo_size = 0;
 	uniforms.clear();
 	uses_collision = false;
+	compile_pending = false;
 
 	if (code == String()) {
 		return; //just invalid, but no error
@@ -5696,12 +6294,17 @@ void RendererStorageRD::ParticlesShaderData::set_code(const String &p_code) {
 	}
 
 	base_singleton->particles_shader.shader.version_set_compute_code(version, gen_code.code, gen_code.uniforms, gen_code.stage_globals[ShaderCompilerRD::STAGE_COMPUTE], gen_code.defines);
-	ERR_FAIL_COND(!base_singleton->particles_shader.shader.version_is_valid(version));
 
 	ubo_size = gen_code.uniform_total_size;
 	ubo_offsets = gen_code.uniform_offsets;
 	texture_uniforms = gen_code.texture_uniforms;
 
+	if (!base_singleton->particles_shader.shader.version_is_valid(version)) {
+		ERR_FAIL_COND(!base_singleton->particles_shader.shader.version_is_compiling(version));
+		compile_pending = true; // Pipeline is created in finish_compile().
+		return;
+	}
+
 	//update pipelines
 
 	pipeline = RD::get_singleton()->compute_pipeline_create(base_singleton->particles_shader.shader.version_get_shader(version, 0));
@@ -5709,6 +6312,23 @@ void RendererStorageRD::ParticlesShaderData::set_code(const String &p_code) {
 	valid = true;
 }
 
+bool RendererStorageRD::ParticlesShaderData::is_compiling() {
+	return compile_pending && base_singleton->particles_shader.shader.version_is_compiling(version);
+}
+
+void RendererStorageRD::ParticlesShaderData::finish_compile() {
+	if (!compile_pending) {
+		return;
+	}
+	compile_pending = false;
+
+	ERR_FAIL_COND(!base_singleton->particles_shader.shader.version_is_valid(version));
+
+	pipeline = RD::get_singleton()->compute_pipeline_create(base_singleton->particles_shader.shader.version_get_shader(version, 0));
+
+	valid = true;
+}
+
 void RendererStorageRD::ParticlesShaderData::set_default_texture_param(const StringName &p_name, RID p_texture) {
 	if (!p_texture.is_valid()) {
 		default_texture_params.erase(p_name);
@@ -6215,6 +6835,18 @@ Transform2D RendererStorageRD::skeleton_bone_get_transform_2d(RID p_skeleton, in
 	return t;
 }
 
+void RendererStorageRD::skeleton_set_bone_transforms(RID p_skeleton, const Vector<float> &p_buffer) {
+	Skeleton *skeleton = skeleton_owner.get_or_null(p_skeleton);
+
+	ERR_FAIL_COND(!skeleton);
+	ERR_FAIL_COND(p_buffer.size() != skeleton->data.size());
+
+	// Same layout as the GPU buffer, share it instead of copying.
+	skeleton->data = p_buffer;
+
+	_skeleton_make_dirty(skeleton);
+}
+
 void RendererStorageRD::skeleton_set_base_transform_2d(RID p_skeleton, const Transform2D &p_base_transform) {
 	Skeleton *skeleton = skeleton_owner.get_or_null(p_skeleton);
 
@@ -6224,11 +6856,15 @@ void RendererStorageRD::skeleton_set_base_transform_2d(RID p_skeleton, const Tra
 }
 
 void RendererStorageRD::_update_dirty_skeletons() {
+	// Upload all the skeletons first and wait for them once, before skinning and drawing.
+	bool uploaded = false;
+
 	while (skeleton_dirty_list) {
 		Skeleton *skeleton = skeleton_dirty_list;
 
 		if (skeleton->size) {
-			RD::get_singleton()->buffer_update(skeleton->buffer, 0, skeleton->data.size() * sizeof(float), skeleton->data.ptr());
+			RD::get_singleton()->buffer_update(skeleton->buffer, 0, skeleton->data.size() * sizeof(float), skeleton->data.ptr(), RD::BARRIER_MASK_NO_BARRIER);
+			uploaded = true;
 		}
 
 		skeleton_dirty_list = skeleton->dirty_list;
@@ -6242,6 +6878,10 @@ void RendererStorageRD::_update_dirty_skeletons() {
 	}
 
 	skeleton_dirty_list = nullptr;
+
+	if (uploaded) {
+		RD::get_singleton()->barrier(RD::BARRIER_MASK_TRANSFER, RD::BARRIER_MASK_RASTER | RD::BARRIER_MASK_COMPUTE);
+	}
 }
 
 /* LIGHT */
@@ -9029,10 +9669,13 @@ void RendererStorageRD::_update_global_variables() {
 
 void RendererStorageRD::update_dirty_resources() {
 	_update_global_variables(); //must do before materials, so it can queue them for update
+	_update_compiling_shaders();
 	_update_queued_materials();
 	_update_dirty_multimeshes();
 	_update_dirty_skeletons();
 	_update_decal_atlas();
+	_update_texture_streaming();
+	_update_mesh_lod_streaming();
 }
 
 bool RendererStorageRD::has_os_feature(const String &p_feature) const {
@@ -9086,6 +9729,10 @@ bool RendererStorageRD::free(RID p_rid) {
 			//there is not much a point of making it dirty, just let it be.
 		}
 
+		if (t->stream_callback) {
+			texture_streaming.textures.erase(p_rid);
+		}
+
 		for (int i = 0; i < t->proxies.size(); i++) {
 			Texture *p = texture_owner.get_or_null(t->proxies[i]);
 			ERR_CONTINUE(!p);
@@ -9748,6 +10395,12 @@ RendererStorageRD::RendererStorageRD() {
 
 	lightmap_probe_capture_update_speed = GLOBAL_GET("rendering/lightmapping/probe_capture/update_speed");
 
+	mesh_lod_streaming.enabled = GLOBAL_GET("rendering/mesh_lod/streaming/enabled");
+
+	texture_streaming.budget = uint64_t(MAX(1, int(GLOBAL_GET("rendering/textures/streaming/vram_budget_mb")))) * 1024 * 1024;
+	texture_streaming.min_size = next_power_of_2(MAX(1, int(GLOBAL_GET("rendering/textures/streaming/min_size"))));
+	texture_streaming.max_loads_per_frame = MAX(1, int(GLOBAL_GET("rendering/textures/streaming/max_loads_per_frame")));
+
 	/* Particles */
 
 	{
@@ -9866,6 +10519,9 @@ void process() {
 		}
 
 		particles_shader.base_uniform_set = RD::get_singleton()->uniform_set_create(uniforms, particles_shader.default_shader_rd, 0);
+
+		// Only enabled now, the default shader above is what processes particles while user shaders compile.
+		particles_shader.shader.set_async_compile_enabled(GLOBAL_GET("rendering/shader_compiler/async_compile/enabled"));
 	}
 
 	default_rd_storage_buffer = RD::get_singleton()->storage_buffer_create(sizeof(uint32_t) * 4);
@@ -9876,6 +10532,12 @@ void process() {
 		copy_modes.push_back("\n#define MODE_FILL_INSTANCES\n#define MODE_2D\n");
 		copy_modes.push_back("\n#define MODE_FILL_SORT_BUFFER\n#define USE_SORT_BUFFER\n");
 		copy_modes.push_back("\n#define MODE_FILL_INSTANCES\n#define USE_SORT_BUFFER\n");
+		copy_modes.push_back("\n#define MODE_COUNT_ALIVE\n#define USE_COMPACTION\n");
+		copy_modes.push_back("\n#define MODE_COUNT_ALIVE\n#define USE_COMPACTION\n#define USE_SORT_BUFFER\n");
+		copy_modes.push_back("\n#define MODE_SCAN_ALIVE\n#define USE_COMPACTION\n");
+		copy_modes.push_back("\n#define MODE_FILL_INSTANCES\n#define USE_COMPACTION\n");
+		copy_modes.push_back("\n#define MODE_FILL_INSTANCES\n#define USE_COMPACTION\n#define USE_SORT_BUFFER\n");
+		copy_modes.push_back("\n#define MODE_WRITE_COMMANDS\n#define USE_COMPACTION\n");
 
 		particles_shader.copy_shader.initialize(copy_modes);
 
@@ -9884,6 +10546,18 @@ void process() {
 		for (int i = 0; i < ParticlesShader::COPY_MODE_MAX; i++) {
 			particles_shader.copy_pipelines[i] = RD::get_singleton()->compute_pipeline_create(particles_shader.copy_shader.version_get_shader(particles_shader.copy_shader_version, i));
 		}
+
+		particles_shader.compaction_min_particles = MAX(0, int(GLOBAL_GET("rendering/3d/particles/gpu_compaction_min_particles")));
+	}
+
+	{
+		Vector<String> cull_modes;
+		cull_modes.push_back("");
+
+		multimesh_cull_shader.shader.initialize(cull_modes);
+		multimesh_cull_shader.version = multimesh_cull_shader.shader.version_create();
+		multimesh_cull_shader.pipeline = RD::get_singleton()->compute_pipeline_create(multimesh_cull_shader.shader.version_get_shader(multimesh_cull_shader.version, 0));
+		multimesh_cull_shader.min_instances = MAX(0, int(GLOBAL_GET("rendering/3d/multimesh/gpu_culling_min_instances")));
 	}
 
 	{
@@ -9953,6 +10627,7 @@ RendererStorageRD::~RendererStorageRD() {
 	}
 
 	particles_shader.copy_shader.version_free(particles_shader.copy_shader_version);
+	multimesh_cull_shader.shader.version_free(multimesh_cull_shader.version);
 	rt_sdf.shader.version_free(rt_sdf.shader_version);
 
 	skeleton_shader.shader.version_free(skeleton_shader.version);
@@ -38,6 +38,7 @@
 #include "servers/rendering/renderer_rd/effects_rd.h"
 #include "servers/rendering/renderer_rd/shader_compiler_rd.h"
 #include "servers/rendering/renderer_rd/shaders/canvas_sdf.glsl.gen.h"
+#include "servers/rendering/renderer_rd/shaders/multimesh_cull.glsl.gen.h"
 #include "servers/rendering/renderer_rd/shaders/particles.glsl.gen.h"
 #include "servers/rendering/renderer_rd/shaders/particles_copy.glsl.gen.h"
 #include "servers/rendering/renderer_rd/shaders/skeleton.glsl.gen.h"
@@ -144,6 +145,11 @@ public:
 		virtual Variant get_default_parameter(const StringName &p_parameter) const = 0;
 		virtual RS::ShaderNativeSourceCode get_native_source_code() const { return RS::ShaderNativeSourceCode(); }
 
+		// Shaders compiled asynchronously stay invalid (materials draw with a fallback) until compiled,
+		// the storage polls is_compiling() every frame and calls finish_compile() once it returns false.
+		virtual bool is_compiling() { return false; }
+		virtual void finish_compile() {}
+
 		virtual ~ShaderData() {}
 	};
 
@@ -158,6 +164,8 @@ public:
 		virtual bool update_parameters(const Map<StringName, Variant> &p_parameters, bool p_uniform_dirty, bool p_textures_dirty) = 0;
 		virtual ~MaterialData();
 
+		LocalVector<RID> streamed_textures; // Filled by update_textures, see material_data_request_streamed_textures().
+
 		//to be used internally by update_parameters, in the most common configuration of material parameters
 		bool update_parameters_uniform_set(const Map<StringName, Variant> &p_parameters, bool p_uniform_dirty, bool p_textures_dirty, const Map<StringName, ShaderLanguage::ShaderNode::Uniform> &p_uniforms, const uint32_t *p_uniform_offsets, const Vector<ShaderCompilerRD::GeneratedCode::Texture> &p_texture_uniforms, const Map<StringName, RID> &p_default_texture_params, uint32_t p_ubo_size, RID &uniform_set, RID p_shader, uint32_t p_shader_uniform_set, uint32_t p_barrier = RD::BARRIER_MASK_ALL);
 		void free_parameters_uniform_set(RID p_uniform_set);
@@ -174,6 +182,7 @@ public:
 		Vector<uint8_t> ubo_data;
 		RID uniform_buffer;
 		Vector<RID> texture_cache;
+		bool uniform_buffer_upload_pending = false;
 	};
 	typedef MaterialData *(*MaterialDataRequestFunction)(ShaderData *);
 	static void _material_uniform_set_erased(const RID &p_set, void *p_material);
@@ -291,6 +300,13 @@ private:
 		RS::TextureDetectRoughnessCallback detect_roughness_callback = nullptr;
 		void *detect_roughness_callback_ud = nullptr;
 
+		RS::TextureStreamCallback stream_callback = nullptr;
+		void *stream_callback_ud = nullptr;
+		uint32_t stream_requested_size = 0; // Largest size drawn with since the last streaming update.
+		uint64_t stream_last_used = 0;
+		bool stream_pending = false; // Waiting for the owner to replace the texture.
+		bool stream_mipmaps = false; // Without mipmaps only the full size can be loaded.
+
 		CanvasTexture *canvas_texture = nullptr;
 	};
 
@@ -364,6 +380,33 @@ private:
 
 	void _update_decal_atlas();
 
+	/* TEXTURE STREAMING */
+
+	// Textures with a stream callback get the size they are drawn at reported by the renderers.
+	// Once per frame, textures are asked to grow to that size, or shrink once unused for a while, and
+	// the least recently used ones are shrunk further while the total would go over the budget.
+
+	enum {
+		TEXTURE_STREAM_UNUSED_FRAMES = 120,
+	};
+
+	struct TextureStreaming {
+		Set<RID> textures;
+		uint64_t frame = 1;
+		uint64_t budget = 0;
+		uint32_t min_size = 0;
+		uint32_t max_loads_per_frame = 0;
+	} texture_streaming;
+
+	Size2i _texture_stream_fit_size(const Texture *p_texture, uint32_t p_max_size) const;
+	uint64_t _texture_stream_get_size_bytes(const Texture *p_texture, uint32_t p_max_size) const;
+	void _update_texture_streaming();
+
+	_FORCE_INLINE_ void _texture_stream_request(Texture *p_texture, uint32_t p_size) {
+		p_texture->stream_requested_size = MAX(p_texture->stream_requested_size, p_size);
+		p_texture->stream_last_used = texture_streaming.frame;
+	}
+
 	/* SHADER */
 
 	struct Material;
@@ -379,6 +422,9 @@ private:
 	ShaderDataRequestFunction shader_data_request_func[SHADER_TYPE_MAX];
 	mutable RID_Owner<Shader, true> shader_owner;
 
+	LocalVector<RID> compiling_shaders;
+	void _update_compiling_shaders();
+
 	/* Material */
 
 	struct Material {
@@ -408,6 +454,12 @@ private:
 	void _material_queue_update(Material *material, bool p_uniform, bool p_texture);
 	void _update_queued_materials();
 
+	// While updating queued materials, uniform buffers are uploaded together and followed by a single barrier.
+	bool material_uniform_uploads_deferred = false;
+	LocalVector<MaterialData *> material_uniform_uploads;
+	uint32_t material_uniform_upload_barrier = 0;
+	void _flush_material_uniform_uploads();
+
 	/* Mesh */
 
 	struct MeshInstance;
@@ -450,11 +502,19 @@ private:
 				uint32_t index_count = 0;
 				RID index_buffer;
 				RID index_array;
+				Vector<uint8_t> index_data; // Only kept when streaming LODs.
 			};
 
 			LOD *lods = nullptr;
 			uint32_t lod_count = 0;
 
+			// LOD streaming, only the levels from lod_resident (0 being the full mesh) to the coarsest one have index buffers.
+			Vector<uint8_t> index_data; // Only kept when streaming LODs.
+			uint32_t lod_resident = 0;
+			uint32_t lod_requested = 0xFFFFFFFF; // Finest level drawn with since the last streaming update.
+			uint64_t lod_resident_last_used = 0;
+			int32_t lod_stream_index = -1;
+
 			AABB aabb;
 
 			Vector<AABB> bone_aabbs;
@@ -500,6 +560,21 @@ private:
 
 	mutable RID_Owner<Mesh, true> mesh_owner;
 
+	/* MESH LOD STREAMING */
+
+	enum {
+		MESH_LOD_STREAM_UNUSED_FRAMES = 300, // Frames a level can go undrawn before leaving video memory.
+	};
+
+	struct MeshLODStreaming {
+		bool enabled = false;
+		uint64_t frame = 1;
+		LocalVector<Mesh::Surface *> surfaces;
+	} mesh_lod_streaming;
+
+	void _mesh_surface_set_lod_resident(Mesh::Surface *p_surface, uint32_t p_lod, bool p_resident);
+	void _update_mesh_lod_streaming();
+
 	struct MeshInstance {
 		Mesh *mesh;
 		RID skeleton;
@@ -596,6 +671,14 @@ private:
 		RID uniform_set_3d;
 		RID uniform_set_2d;
 
+		// GPU culling, the visible instances are compacted into culled_buffer and drawn with indirect commands.
+		RID culled_buffer;
+		RID command_buffer; // One indirect draw command per mesh surface.
+		uint32_t command_buffer_surfaces = 0;
+		uint64_t cull_pass = 0; // The buffers hold a single result, so instances sharing this multimesh are only culled once per pass.
+		RID cull_uniform_set;
+		RID culled_uniform_set_3d;
+
 		bool dirty = false;
 		MultiMesh *dirty_list = nullptr;
 
@@ -606,6 +689,24 @@ private:
 
 	MultiMesh *multimesh_dirty_list = nullptr;
 
+	struct MultiMeshCullShader {
+		struct PushConstant {
+			float planes[6][4];
+
+			float aabb_center[3];
+			uint32_t total_instances;
+
+			float aabb_extents[3];
+			uint32_t stride_and_surfaces;
+		};
+
+		MultimeshCullShaderRD shader;
+		RID version;
+		RID pipeline;
+
+		uint32_t min_instances = 0; // Zero disables GPU culling.
+	} multimesh_cull_shader;
+
 	_FORCE_INLINE_ void _multimesh_make_local(MultiMesh *multimesh) const;
 	_FORCE_INLINE_ void _multimesh_mark_dirty(MultiMesh *multimesh, int p_index, bool p_aabb);
 	_FORCE_INLINE_ void _multimesh_mark_all_dirty(MultiMesh *multimesh, bool p_data, bool p_aabb);
@@ -759,6 +860,17 @@ private:
 
 		RID particles_sort_buffer;
 		RID particles_sort_uniform_set;
+		RID particles_sort_temp_buffer; // Used by the radix sort, with its histogram, for large amounts.
+		RID particles_sort_histogram_buffer;
+
+		// Compaction, the drawn particles are packed to the front of the instance buffer and counted in alive_buffer,
+		// so indirect draws skip the dead ones.
+		RID alive_buffer;
+		RID alive_uniform_set;
+		RID command_buffer; // One indirect draw command per surface drawing these particles.
+		uint32_t command_buffer_count = 0;
+		uint64_t command_pass = 0; // Instances sharing these particles only write commands once per pass.
+		RID command_uniform_set;
 
 		bool dirty = false;
 		Particles *update_list = nullptr;
@@ -846,7 +958,7 @@ private:
 			uint32_t order_by_lifetime;
 			uint32_t lifetime_split;
 			uint32_t lifetime_reverse;
-			uint32_t pad;
+			uint32_t command_count;
 		};
 
 		enum {
@@ -854,6 +966,12 @@ private:
 			COPY_MODE_FILL_INSTANCES_2D,
 			COPY_MODE_FILL_SORT_BUFFER,
 			COPY_MODE_FILL_INSTANCES_WITH_SORT_BUFFER,
+			COPY_MODE_COUNT_ALIVE,
+			COPY_MODE_COUNT_ALIVE_WITH_SORT_BUFFER,
+			COPY_MODE_SCAN_ALIVE,
+			COPY_MODE_FILL_INSTANCES_COMPACT,
+			COPY_MODE_FILL_INSTANCES_COMPACT_WITH_SORT_BUFFER,
+			COPY_MODE_WRITE_COMMANDS,
 			COPY_MODE_MAX,
 		};
 
@@ -861,10 +979,18 @@ private:
 		RID copy_shader_version;
 		RID copy_pipelines[COPY_MODE_MAX];
 
+		uint32_t compaction_min_particles = 0; // Zero disables compaction.
+
 		LocalVector<float> pose_update_buffer;
 
 	} particles_shader;
 
+	_FORCE_INLINE_ bool _particles_uses_compaction(const Particles *particles) const {
+		return particles_shader.compaction_min_particles > 0 && particles->mode == RS::PARTICLES_MODE_3D && particles->amount >= int(particles_shader.compaction_min_particles);
+	}
+
+	void _particles_fill_instances(Particles *particles, const ParticlesShader::CopyPushConstant &p_push_constant, bool p_use_sort_buffer);
+
 	Particles *particle_update_list = nullptr;
 
 	struct ParticlesShaderData : public ShaderData {
@@ -886,8 +1012,11 @@ private:
 		RID pipeline;
 
 		bool uses_time;
+		bool compile_pending = false;
 
 		virtual void set_code(const String &p_Code);
+		virtual bool is_compiling();
+		virtual void finish_compile();
 		virtual void set_default_texture_param(const StringName &p_name, RID p_texture);
 		virtual void get_param_list(List<PropertyInfo> *p_param_list) const;
 		virtual void get_instance_param_list(List<RendererStorage::InstanceShaderParam> *p_param_list) const;
@@ -1322,6 +1451,7 @@ public:
 	virtual void texture_set_detect_3d_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata);
 	virtual void texture_set_detect_normal_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata);
 	virtual void texture_set_detect_roughness_callback(RID p_texture, RS::TextureDetectRoughnessCallback p_callback, void *p_userdata);
+	virtual void texture_set_stream_callback(RID p_texture, RS::TextureStreamCallback p_callback, void *p_userdata);
 
 	virtual void texture_debug_usage(List<RS::TextureInfo> *r_info);
 
@@ -1346,6 +1476,16 @@ public:
 
 	//internal usage
 
+	// Called by the renderers for every drawn surface, with the size it covers on screen in pixels.
+	_FORCE_INLINE_ void material_data_request_streamed_textures(const MaterialData *p_material, float p_screen_size) {
+		for (uint32_t i = 0; i < p_material->streamed_textures.size(); i++) {
+			Texture *tex = texture_owner.get_or_null(p_material->streamed_textures[i]);
+			if (tex) {
+				_texture_stream_request(tex, p_screen_size);
+			}
+		}
+	}
+
 	_FORCE_INLINE_ RID texture_get_rd_texture(RID p_texture, bool p_srgb = false) {
 		if (p_texture.is_null()) {
 			return RID();
@@ -1534,6 +1674,15 @@ public:
 		return s->index_count ? s->index_count : s->vertex_count;
 	}
 
+	// Index count (or vertex count when not indexed) drawn for the given LOD.
+	_FORCE_INLINE_ uint32_t mesh_surface_get_draw_count(void *p_surface, uint32_t p_lod) const {
+		Mesh::Surface *s = reinterpret_cast<Mesh::Surface *>(p_surface);
+		if (s->index_count == 0) {
+			return s->vertex_count;
+		}
+		return p_lod == 0 ? s->index_count : s->lods[p_lod - 1].index_count;
+	}
+
 	_FORCE_INLINE_ uint32_t mesh_surface_get_lod(void *p_surface, float p_model_scale, float p_distance_threshold, float p_lod_threshold, uint32_t *r_index_count = nullptr) const {
 		Mesh::Surface *s = reinterpret_cast<Mesh::Surface *>(p_surface);
 
@@ -1548,19 +1697,29 @@ public:
 			}
 			current_lod = i;
 		}
-		if (current_lod == -1) {
-			return 0;
-		} else {
-			if (r_index_count) {
-				*r_index_count = s->lods[current_lod].index_count;
-			}
-			return current_lod + 1;
+		uint32_t lod = mesh_surface_request_lod(p_surface, current_lod + 1);
+		if (r_index_count && lod > 0) {
+			*r_index_count = s->lods[lod - 1].index_count;
 		}
+		return lod;
+	}
+
+	// Returns the level to draw with instead of p_lod, which is coarser while finer levels are not streamed in yet.
+	_FORCE_INLINE_ uint32_t mesh_surface_request_lod(void *p_surface, uint32_t p_lod) const {
+		Mesh::Surface *s = reinterpret_cast<Mesh::Surface *>(p_surface);
+		if (s->lod_stream_index < 0) {
+			return p_lod;
+		}
+		s->lod_requested = MIN(s->lod_requested, p_lod);
+		return MAX(p_lod, s->lod_resident);
 	}
 
 	_FORCE_INLINE_ RID mesh_surface_get_index_array(void *p_surface, uint32_t p_lod) const {
 		Mesh::Surface *s = reinterpret_cast<Mesh::Surface *>(p_surface);
 
+		// Also covers shadow meshes, which are drawn with the LOD picked for the main one.
+		p_lod = mesh_surface_request_lod(p_surface, p_lod);
+
 		if (p_lod == 0) {
 			return s->index_array;
 		} else {
@@ -1700,6 +1859,7 @@ public:
 	Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const;
 
 	void multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_buffer);
+	void multimesh_set_buffer_range(RID p_multimesh, int p_from_instance, const Vector<float> &p_buffer);
 	Vector<float> multimesh_get_buffer(RID p_multimesh) const;
 
 	void multimesh_set_visible_instances(RID p_multimesh, int p_visible);
@@ -1745,6 +1905,35 @@ public:
 		return multimesh->uniform_set_3d;
 	}
 
+	// Only 3D transforms are culled, the shader reads the instance basis and origin from the first three vec4s.
+	_FORCE_INLINE_ bool multimesh_uses_gpu_culling(RID p_multimesh) const {
+		MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+		return multimesh_cull_shader.min_instances > 0 && multimesh->xform_format == RS::MULTIMESH_TRANSFORM_3D && multimesh->mesh.is_valid() && multimesh_get_instances_to_draw(p_multimesh) >= multimesh_cull_shader.min_instances;
+	}
+
+	// Compacts the instances inside the frustum planes (in multimesh space) and writes one indirect draw command per surface. Returns false when nothing was dispatched.
+	bool multimesh_gpu_cull(RID p_multimesh, uint64_t p_pass, const Plane *p_planes, const uint32_t *p_surface_draw_counts, uint32_t p_surface_count);
+
+	_FORCE_INLINE_ RID multimesh_get_culled_3d_uniform_set(RID p_multimesh, RID p_shader, uint32_t p_set) const {
+		MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+		if (!multimesh->culled_uniform_set_3d.is_valid()) {
+			Vector<RD::Uniform> uniforms;
+			RD::Uniform u;
+			u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.binding = 0;
+			u.ids.push_back(multimesh->culled_buffer);
+			uniforms.push_back(u);
+			multimesh->culled_uniform_set_3d = RD::get_singleton()->uniform_set_create(uniforms, p_shader, p_set);
+		}
+
+		return multimesh->culled_uniform_set_3d;
+	}
+
+	_FORCE_INLINE_ RID multimesh_get_command_buffer(RID p_multimesh) const {
+		MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+		return multimesh->command_buffer;
+	}
+
 	_FORCE_INLINE_ RID multimesh_get_2d_uniform_set(RID p_multimesh, RID p_shader, uint32_t p_set) const {
 		MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
 		if (!multimesh->uniform_set_2d.is_valid()) {
@@ -1773,6 +1962,7 @@ public:
 	Transform3D skeleton_bone_get_transform(RID p_skeleton, int p_bone) const;
 	void skeleton_bone_set_transform_2d(RID p_skeleton, int p_bone, const Transform2D &p_transform);
 	Transform2D skeleton_bone_get_transform_2d(RID p_skeleton, int p_bone) const;
+	void skeleton_set_bone_transforms(RID p_skeleton, const Vector<float> &p_buffer);
 
 	_FORCE_INLINE_ bool skeleton_is_valid(RID p_skeleton) {
 		return skeleton_owner.get_or_null(p_skeleton) != nullptr;
@@ -2199,6 +2389,24 @@ public:
 		return particles->amount * r_trail_divisor;
 	}
 
+	// Only 3D particles are compacted, see _particles_fill_instances().
+	_FORCE_INLINE_ bool particles_uses_compaction(RID p_particles) {
+		Particles *particles = particles_owner.get_or_null(p_particles);
+		ERR_FAIL_COND_V(!particles, false);
+
+		return _particles_uses_compaction(particles);
+	}
+
+	// Writes one indirect draw command per surface, drawing p_instance_multipliers[i] instances per alive particle. Returns false when nothing was written.
+	bool particles_write_draw_commands(RID p_particles, uint64_t p_pass, const uint32_t *p_draw_counts, const uint32_t *p_instance_multipliers, uint32_t p_command_count);
+
+	_FORCE_INLINE_ RID particles_get_command_buffer(RID p_particles) {
+		Particles *particles = particles_owner.get_or_null(p_particles);
+		ERR_FAIL_COND_V(!particles, RID());
+
+		return particles->command_buffer;
+	}
+
 	_FORCE_INLINE_ bool particles_has_collision(RID p_particles) {
 		Particles *particles = particles_owner.get_or_null(p_particles);
 		ERR_FAIL_COND_V(!particles, 0);
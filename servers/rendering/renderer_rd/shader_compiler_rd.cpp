@@ -30,8 +30,12 @@
 
 #include "shader_compiler_rd.h"
 
+#include "core/config/engine.h"
 #include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
 #include "core/os/os.h"
+#include "core/string/string_builder.h"
 #include "renderer_storage_rd.h"
 #include "servers/rendering_server.h"
 
@@ -916,6 +920,7 @@ String ShaderCompilerRD::_dump_node_code(const SL::Node *p_node, int p_level, Ge
 
 			if (p_assigning && p_actions.write_flag_pointers.has(vnode->name)) {
 				*p_actions.write_flag_pointers[vnode->name] = true;
+				used_write_flags.insert(vnode->name);
 			}
 
 			if (p_default_actions.usage_defines.has(vnode->name) && !used_name_defines.has(vnode->name)) {
@@ -1070,6 +1075,7 @@ String ShaderCompilerRD::_dump_node_code(const SL::Node *p_node, int p_level, Ge
 
 			if (p_assigning && p_actions.write_flag_pointers.has(anode->name)) {
 				*p_actions.write_flag_pointers[anode->name] = true;
+				used_write_flags.insert(anode->name);
 			}
 
 			if (p_default_actions.usage_defines.has(anode->name) && !used_name_defines.has(anode->name)) {
@@ -1406,7 +1412,226 @@ ShaderLanguage::DataType ShaderCompilerRD::_get_variable_type(const StringName &
 	return RS::global_variable_type_get_shader_datatype(gvt);
 }
 
+static const char *cache_file_header = "GSCT";
+static const uint32_t cache_file_version = 1;
+
+static void _store_string_names(FileAccess *p_file, const Vector<StringName> &p_names) {
+	p_file->store_32(p_names.size());
+	for (int i = 0; i < p_names.size(); i++) {
+		p_file->store_pascal_string(p_names[i]);
+	}
+}
+
+static Vector<StringName> _get_string_names(FileAccess *p_file) {
+	Vector<StringName> names;
+	uint32_t count = p_file->get_32();
+	for (uint32_t i = 0; i < count && !p_file->eof_reached(); i++) {
+		names.push_back(p_file->get_pascal_string());
+	}
+	return names;
+}
+
+bool ShaderCompilerRD::_load_from_cache(const String &p_file, IdentifierActions *p_actions, GeneratedCode &r_gen_code) {
+	FileAccessRef f = FileAccess::open(p_file, FileAccess::READ);
+	if (!f) {
+		return false;
+	}
+
+	char header[5] = { 0, 0, 0, 0, 0 };
+	f->get_buffer((uint8_t *)header, 4);
+	ERR_FAIL_COND_V(header != String(cache_file_header), false);
+	if (f->get_32() != cache_file_version) {
+		return false; // wrong version
+	}
+
+	Vector<StringName> render_modes = _get_string_names(f);
+	Vector<StringName> usage_flags = _get_string_names(f);
+	Vector<StringName> write_flags = _get_string_names(f);
+
+	Map<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	uint32_t uniform_count = f->get_32();
+	for (uint32_t i = 0; i < uniform_count; i++) {
+		StringName name = f->get_pascal_string();
+		ShaderLanguage::ShaderNode::Uniform uniform;
+		uniform.order = int32_t(f->get_32());
+		uniform.texture_order = int32_t(f->get_32());
+		uniform.texture_binding = int32_t(f->get_32());
+		uniform.type = ShaderLanguage::DataType(f->get_32());
+		uniform.precision = ShaderLanguage::DataPrecision(f->get_32());
+		uniform.array_size = int32_t(f->get_32());
+		uniform.scope = ShaderLanguage::ShaderNode::Uniform::Scope(f->get_32());
+		uniform.hint = ShaderLanguage::ShaderNode::Uniform::Hint(f->get_32());
+		uniform.filter = ShaderLanguage::TextureFilter(f->get_32());
+		uniform.repeat = ShaderLanguage::TextureRepeat(f->get_32());
+		for (int j = 0; j < 3; j++) {
+			uniform.hint_range[j] = f->get_float();
+		}
+		uniform.instance_index = int32_t(f->get_32());
+		uint32_t value_count = f->get_32();
+		ERR_FAIL_COND_V(f->eof_reached(), false);
+		for (uint32_t j = 0; j < value_count; j++) {
+			ShaderLanguage::ConstantNode::Value value;
+			value.uint = f->get_32();
+			uniform.default_value.push_back(value);
+		}
+
+		if (uniform.scope == ShaderLanguage::ShaderNode::Uniform::SCOPE_GLOBAL && _get_variable_type(name) != uniform.type) {
+			return false; // The global variable changed since, parse again to report it.
+		}
+		uniforms.insert(name, uniform);
+	}
+
+	GeneratedCode gen_code;
+	uint32_t define_count = f->get_32();
+	for (uint32_t i = 0; i < define_count && !f->eof_reached(); i++) {
+		gen_code.defines.push_back(f->get_pascal_string());
+	}
+	uint32_t texture_count = f->get_32();
+	for (uint32_t i = 0; i < texture_count && !f->eof_reached(); i++) {
+		GeneratedCode::Texture texture;
+		texture.name = f->get_pascal_string();
+		texture.type = ShaderLanguage::DataType(f->get_32());
+		texture.hint = ShaderLanguage::ShaderNode::Uniform::Hint(f->get_32());
+		texture.filter = ShaderLanguage::TextureFilter(f->get_32());
+		texture.repeat = ShaderLanguage::TextureRepeat(f->get_32());
+		texture.global = f->get_8();
+		texture.array_size = int32_t(f->get_32());
+		gen_code.texture_uniforms.push_back(texture);
+	}
+	uint32_t offset_count = f->get_32();
+	for (uint32_t i = 0; i < offset_count && !f->eof_reached(); i++) {
+		gen_code.uniform_offsets.push_back(f->get_32());
+	}
+	gen_code.uniform_total_size = f->get_32();
+	gen_code.uniforms = f->get_pascal_string();
+	for (int i = 0; i < STAGE_MAX; i++) {
+		gen_code.stage_globals[i] = f->get_pascal_string();
+	}
+	uint32_t code_count = f->get_32();
+	for (uint32_t i = 0; i < code_count && !f->eof_reached(); i++) {
+		String key = f->get_pascal_string();
+		gen_code.code[key] = f->get_pascal_string();
+	}
+	gen_code.uses_global_textures = f->get_8();
+	gen_code.uses_fragment_time = f->get_8();
+	gen_code.uses_vertex_time = f->get_8();
+	ERR_FAIL_COND_V(f->eof_reached(), false);
+
+	// Same effects on the actions as _dump_node_code() has.
+	for (int i = 0; i < render_modes.size(); i++) {
+		if (p_actions->render_mode_flags.has(render_modes[i])) {
+			*p_actions->render_mode_flags[render_modes[i]] = true;
+		}
+		if (p_actions->render_mode_values.has(render_modes[i])) {
+			Pair<int *, int> &p = p_actions->render_mode_values[render_modes[i]];
+			*p.first = p.second;
+		}
+	}
+	for (int i = 0; i < usage_flags.size(); i++) {
+		if (p_actions->usage_flag_pointers.has(usage_flags[i])) {
+			*p_actions->usage_flag_pointers[usage_flags[i]] = true;
+		}
+	}
+	for (int i = 0; i < write_flags.size(); i++) {
+		if (p_actions->write_flag_pointers.has(write_flags[i])) {
+			*p_actions->write_flag_pointers[write_flags[i]] = true;
+		}
+	}
+	for (const KeyValue<StringName, ShaderLanguage::ShaderNode::Uniform> &E : uniforms) {
+		p_actions->uniforms->insert(E.key, E.value);
+	}
+
+	r_gen_code = gen_code;
+	return true;
+}
+
+void ShaderCompilerRD::_save_to_cache(const String &p_file, const GeneratedCode &p_gen_code) {
+	FileAccessRef f = FileAccess::open(p_file, FileAccess::WRITE);
+	ERR_FAIL_COND(!f);
+	f->store_buffer((const uint8_t *)cache_file_header, 4);
+	f->store_32(cache_file_version);
+
+	_store_string_names(f, shader->render_modes);
+	Vector<StringName> names;
+	for (Set<StringName>::Element *E = used_flag_pointers.front(); E; E = E->next()) {
+		names.push_back(E->get());
+	}
+	_store_string_names(f, names);
+	names.clear();
+	for (Set<StringName>::Element *E = used_write_flags.front(); E; E = E->next()) {
+		names.push_back(E->get());
+	}
+	_store_string_names(f, names);
+
+	f->store_32(shader->uniforms.size());
+	for (const KeyValue<StringName, ShaderLanguage::ShaderNode::Uniform> &E : shader->uniforms) {
+		const ShaderLanguage::ShaderNode::Uniform &uniform = E.value;
+		f->store_pascal_string(E.key);
+		f->store_32(uniform.order);
+		f->store_32(uniform.texture_order);
+		f->store_32(uniform.texture_binding);
+		f->store_32(uniform.type);
+		f->store_32(uniform.precision);
+		f->store_32(uniform.array_size);
+		f->store_32(uniform.scope);
+		f->store_32(uniform.hint);
+		f->store_32(uniform.filter);
+		f->store_32(uniform.repeat);
+		for (int j = 0; j < 3; j++) {
+			f->store_float(uniform.hint_range[j]);
+		}
+		f->store_32(uniform.instance_index);
+		f->store_32(uniform.default_value.size());
+		for (int j = 0; j < uniform.default_value.size(); j++) {
+			f->store_32(uniform.default_value[j].uint);
+		}
+	}
+
+	f->store_32(p_gen_code.defines.size());
+	for (int i = 0; i < p_gen_code.defines.size(); i++) {
+		f->store_pascal_string(p_gen_code.defines[i]);
+	}
+	f->store_32(p_gen_code.texture_uniforms.size());
+	for (int i = 0; i < p_gen_code.texture_uniforms.size(); i++) {
+		const GeneratedCode::Texture &texture = p_gen_code.texture_uniforms[i];
+		f->store_pascal_string(texture.name);
+		f->store_32(texture.type);
+		f->store_32(texture.hint);
+		f->store_32(texture.filter);
+		f->store_32(texture.repeat);
+		f->store_8(texture.global);
+		f->store_32(texture.array_size);
+	}
+	f->store_32(p_gen_code.uniform_offsets.size());
+	for (int i = 0; i < p_gen_code.uniform_offsets.size(); i++) {
+		f->store_32(p_gen_code.uniform_offsets[i]);
+	}
+	f->store_32(p_gen_code.uniform_total_size);
+	f->store_pascal_string(p_gen_code.uniforms);
+	for (int i = 0; i < STAGE_MAX; i++) {
+		f->store_pascal_string(p_gen_code.stage_globals[i]);
+	}
+	f->store_32(p_gen_code.code.size());
+	for (const KeyValue<String, String> &E : p_gen_code.code) {
+		f->store_pascal_string(E.key);
+		f->store_pascal_string(E.value);
+	}
+	f->store_8(p_gen_code.uses_global_textures);
+	f->store_8(p_gen_code.uses_fragment_time);
+	f->store_8(p_gen_code.uses_vertex_time);
+
+	f->close();
+}
+
 Error ShaderCompilerRD::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+	String cache_file;
+	if (cache_path != String()) {
+		cache_file = cache_path.plus_file((itos(p_mode) + ":" + p_code).sha256_text() + ".cache");
+		if (_load_from_cache(cache_file, p_actions, r_gen_code)) {
+			return OK;
+		}
+	}
+
 	Error err = parser.compile(p_code, ShaderTypes::get_singleton()->get_functions(p_mode), ShaderTypes::get_singleton()->get_modes(p_mode), ShaderLanguage::VaryingFunctionNames(), ShaderTypes::get_singleton()->get_types(), _get_variable_type);
 
 	if (err != OK) {
@@ -1437,12 +1662,17 @@ Error ShaderCompilerRD::compile(RS::ShaderMode p_mode, const String &p_code, Ide
 	used_name_defines.clear();
 	used_rmode_defines.clear();
 	used_flag_pointers.clear();
+	used_write_flags.clear();
 	fragment_varyings.clear();
 
 	shader = parser.get_shader();
 	function = nullptr;
 	_dump_node_code(shader, 1, r_gen_code, *p_actions, actions, false);
 
+	if (cache_file != String()) {
+		_save_to_cache(cache_file, r_gen_code);
+	}
+
 	return OK;
 }
 
@@ -1466,8 +1696,47 @@ void ShaderCompilerRD::initialize(DefaultIdentifierActions p_actions) {
 	texture_functions.insert("textureGather");
 	texture_functions.insert("textureSize");
 	texture_functions.insert("texelFetch");
+
+	if (cache_dir != String()) {
+		// Anything changing the generated code has to change the folder.
+		StringBuilder hash_build;
+		hash_build.append("[engine]");
+		hash_build.append(String(Engine::get_singleton()->get_version_info()["hash"]));
+		Map<StringName, String> *tables[4] = { &actions.renames, &actions.render_mode_defines, &actions.usage_defines, &actions.custom_samplers };
+		for (int i = 0; i < 4; i++) {
+			hash_build.append("[table:" + itos(i) + "]");
+			for (const KeyValue<StringName, String> &E : *tables[i]) {
+				hash_build.append(String(E.key) + "=" + E.value + "\n");
+			}
+		}
+		hash_build.append("[settings]");
+		hash_build.append(itos(actions.default_filter) + "," + itos(actions.default_repeat) + "," + actions.sampler_array_name + ",");
+		hash_build.append(itos(actions.base_texture_binding_index) + "," + itos(actions.texture_layout_set) + "," + actions.base_uniform_string + ",");
+		hash_build.append(actions.global_buffer_array_variable + "," + actions.instance_uniform_index_variable + ",");
+		hash_build.append(itos(actions.base_varying_index) + "," + itos(actions.apply_luminance_multiplier));
+		String actions_sha256 = hash_build.as_string().sha256_text();
+
+		DirAccessRef d = DirAccess::open(cache_dir);
+		ERR_FAIL_COND(!d);
+		if (d->change_dir("ShaderCompilerRD") != OK) {
+			Error err = d->make_dir("ShaderCompilerRD");
+			ERR_FAIL_COND(err != OK);
+			d->change_dir("ShaderCompilerRD");
+		}
+		if (d->change_dir(actions_sha256) != OK) {
+			Error err = d->make_dir(actions_sha256);
+			ERR_FAIL_COND(err != OK);
+		}
+		cache_path = cache_dir.plus_file("ShaderCompilerRD").plus_file(actions_sha256);
+	}
+}
+
+void ShaderCompilerRD::set_cache_dir(const String &p_dir) {
+	cache_dir = p_dir;
 }
 
+String ShaderCompilerRD::cache_dir;
+
 ShaderCompilerRD::ShaderCompilerRD() {
 #if 0
 
@@ -115,6 +115,7 @@ private:
 
 	Set<StringName> used_name_defines;
 	Set<StringName> used_flag_pointers;
+	Set<StringName> used_write_flags;
 	Set<StringName> used_rmode_defines;
 	Set<StringName> internal_functions;
 	Set<StringName> fragment_varyings;
@@ -123,10 +124,21 @@ private:
 
 	static ShaderLanguage::DataType _get_variable_type(const StringName &p_type);
 
+	// Translated shaders are saved with the render modes and identifiers they used, so loading
+	// one can set the same action flags without parsing. Keyed by mode and code, in a folder
+	// named after the engine build and the default actions.
+	static String cache_dir;
+	String cache_path;
+
+	bool _load_from_cache(const String &p_file, IdentifierActions *p_actions, GeneratedCode &r_gen_code);
+	void _save_to_cache(const String &p_file, const GeneratedCode &p_gen_code);
+
 public:
 	Error compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
 
 	void initialize(DefaultIdentifierActions p_actions);
+
+	static void set_cache_dir(const String &p_dir);
 	ShaderCompilerRD();
 };
 
@@ -474,8 +474,13 @@ void ShaderRD::_compile_version(Version *p_version) {
 	}
 
 #if 1
-
-	RendererThreadPool::singleton->thread_work_pool.do_work(variant_defines.size(), this, &ShaderRD::_compile_variant, p_version);
+	if (async_compile) {
+		// Running as a task, RendererThreadPool may be busy on the render thread.
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &ShaderRD::_compile_variant, p_version, variant_defines.size());
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	} else {
+		RendererThreadPool::singleton->thread_work_pool.do_work(variant_defines.size(), this, &ShaderRD::_compile_variant, p_version);
+	}
 #else
 	for (int i = 0; i < variant_defines.size(); i++) {
 		_compile_variant(i, p_version);
@@ -521,11 +526,42 @@ void ShaderRD::_compile_version(Version *p_version) {
 	p_version->valid = true;
 }
 
+void ShaderRD::_wait_for_compile(Version *p_version) {
+	if (p_version->compile_task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(p_version->compile_task);
+		p_version->compile_task = WorkerThreadPool::INVALID_TASK_ID;
+	}
+}
+
+bool ShaderRD::_update_version(Version *p_version, bool p_wait) {
+	if (p_version->compile_task == WorkerThreadPool::INVALID_TASK_ID && p_version->dirty) {
+		if (!async_compile) {
+			_compile_version(p_version);
+			return true;
+		}
+
+		p_version->dirty = false;
+		p_version->valid = false;
+		p_version->compile_task = WorkerThreadPool::get_singleton()->add_template_task(this, &ShaderRD::_compile_version, p_version);
+	}
+
+	if (p_version->compile_task != WorkerThreadPool::INVALID_TASK_ID) {
+		if (!p_wait && !WorkerThreadPool::get_singleton()->is_task_completed(p_version->compile_task)) {
+			return false;
+		}
+		_wait_for_compile(p_version);
+	}
+
+	return true;
+}
+
 void ShaderRD::version_set_code(RID p_version, const Map<String, String> &p_code, const String &p_uniforms, const String &p_vertex_globals, const String &p_fragment_globals, const Vector<String> &p_custom_defines) {
 	ERR_FAIL_COND(is_compute);
 
 	Version *version = version_owner.get_or_null(p_version);
 	ERR_FAIL_COND(!version);
+
+	_wait_for_compile(version); // The task reads the code being replaced.
 	version->vertex_globals = p_vertex_globals.utf8();
 	version->fragment_globals = p_fragment_globals.utf8();
 	version->uniforms = p_uniforms.utf8();
@@ -541,7 +577,7 @@ void ShaderRD::version_set_code(RID p_version, const Map<String, String> &p_code
 
 	version->dirty = true;
 	if (version->initialize_needed) {
-		_compile_version(version);
+		_update_version(version, false);
 		version->initialize_needed = false;
 	}
 }
@@ -552,6 +588,8 @@ void ShaderRD::version_set_compute_code(RID p_version, const Map<String, String>
 	Version *version = version_owner.get_or_null(p_version);
 	ERR_FAIL_COND(!version);
 
+	_wait_for_compile(version); // The task reads the code being replaced.
+
 	version->compute_globals = p_compute_globals.utf8();
 	version->uniforms = p_uniforms.utf8();
 
@@ -567,7 +605,7 @@ void ShaderRD::version_set_compute_code(RID p_version, const Map<String, String>
 
 	version->dirty = true;
 	if (version->initialize_needed) {
-		_compile_version(version);
+		_update_version(version, false);
 		version->initialize_needed = false;
 	}
 }
@@ -576,16 +614,29 @@ bool ShaderRD::version_is_valid(RID p_version) {
 	Version *version = version_owner.get_or_null(p_version);
 	ERR_FAIL_COND_V(!version, false);
 
-	if (version->dirty) {
-		_compile_version(version);
+	if (version->compile_task != WorkerThreadPool::INVALID_TASK_ID || version->dirty) {
+		if (!_update_version(version, false)) {
+			return false;
+		}
 	}
 
 	return version->valid;
 }
 
+bool ShaderRD::version_is_compiling(RID p_version) {
+	Version *version = version_owner.get_or_null(p_version);
+	ERR_FAIL_COND_V(!version, false);
+
+	if (version->compile_task == WorkerThreadPool::INVALID_TASK_ID) {
+		return false;
+	}
+	return !_update_version(version, false);
+}
+
 bool ShaderRD::version_free(RID p_version) {
 	if (version_owner.owns(p_version)) {
 		Version *version = version_owner.get_or_null(p_version);
+		_wait_for_compile(version);
 		_clear_version(version);
 		version_owner.free(p_version);
 	} else {
@@ -671,6 +722,14 @@ void ShaderRD::initialize(const Vector<String> &p_variant_defines, const String
 	}
 }
 
+void ShaderRD::set_async_compile_enabled(bool p_enabled) {
+	async_compile = p_enabled;
+}
+
+bool ShaderRD::is_async_compile_enabled() const {
+	return async_compile;
+}
+
 void ShaderRD::set_shader_cache_dir(const String &p_dir) {
 	shader_cache_dir = p_dir;
 }
@@ -32,6 +32,7 @@
 #define SHADER_RD_H
 
 #include "core/os/mutex.h"
+#include "core/os/worker_thread_pool.h"
 #include "core/string/string_builder.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
@@ -65,6 +66,9 @@ class ShaderRD {
 		bool valid;
 		bool dirty;
 		bool initialize_needed;
+
+		// Set while the version compiles in the background, nothing else may touch the variants until it's waited for.
+		WorkerThreadPool::TaskID compile_task = WorkerThreadPool::INVALID_TASK_ID;
 	};
 
 	Mutex variant_set_mutex;
@@ -73,6 +77,10 @@ class ShaderRD {
 
 	void _clear_version(Version *p_version);
 	void _compile_version(Version *p_version);
+	void _wait_for_compile(Version *p_version);
+	bool _update_version(Version *p_version, bool p_wait);
+
+	bool async_compile = false;
 
 	RID_Owner<Version> version_owner;
 
@@ -144,8 +152,10 @@ public:
 		Version *version = version_owner.get_or_null(p_version);
 		ERR_FAIL_COND_V(!version, RID());
 
-		if (version->dirty) {
-			_compile_version(version);
+		if (version->compile_task != WorkerThreadPool::INVALID_TASK_ID || version->dirty) {
+			if (!_update_version(version, false)) {
+				return RID(); // Still compiling.
+			}
 		}
 
 		if (!version->valid) {
@@ -156,12 +166,19 @@ public:
 	}
 
 	bool version_is_valid(RID p_version);
+	// Only true with async compilation, while the version is compiled on a worker thread.
+	bool version_is_compiling(RID p_version);
 
 	bool version_free(RID p_version);
 
 	void set_variant_enabled(int p_variant, bool p_enabled);
 	bool is_variant_enabled(int p_variant) const;
 
+	// When enabled, dirty versions are compiled on the WorkerThreadPool instead of stalling the caller.
+	// Only meant for shaders that have a fallback to draw with meanwhile (materials).
+	void set_async_compile_enabled(bool p_enabled);
+	bool is_async_compile_enabled() const;
+
 	static void set_shader_cache_dir(const String &p_dir);
 	static void set_shader_cache_save_compressed(bool p_enable);
 	static void set_shader_cache_save_compressed_zstd(bool p_enable);
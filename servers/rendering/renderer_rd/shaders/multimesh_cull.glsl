@@ -0,0 +1,96 @@
+#[compute]
+
+#version 450
+
+#VERSION_DEFINES
+
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+layout(set = 0, binding = 0, std430) restrict readonly buffer SourceInstances {
+	vec4 data[];
+}
+src_instances;
+
+layout(set = 0, binding = 1, std430) restrict writeonly buffer CulledInstances {
+	vec4 data[];
+}
+dst_instances;
+
+// One indexed draw command (5 uints) per surface, instance counts start at zero.
+layout(set = 0, binding = 2, std430) restrict buffer DrawCommands {
+	uint data[];
+}
+draw_commands;
+
+layout(push_constant, binding = 0, std430) uniform Params {
+	vec4 planes[6]; // In multimesh space, pointing outwards.
+
+	vec3 aabb_center;
+	uint total_instances;
+
+	vec3 aabb_extents;
+	uint stride_and_surfaces; // Instance stride in vec4s (low 8 bits), surface count above.
+}
+params;
+
+shared uint local_visible;
+shared uint local_base;
+
+void main() {
+	uint instance = gl_GlobalInvocationID.x;
+	uint stride = params.stride_and_surfaces & 0xFF;
+
+	bool visible = false;
+	if (instance < params.total_instances) {
+		uint ofs = instance * stride;
+		vec4 row0 = src_instances.data[ofs + 0];
+		vec4 row1 = src_instances.data[ofs + 1];
+		vec4 row2 = src_instances.data[ofs + 2];
+
+		// Mesh AABB under the instance transform.
+		vec3 center = vec3(dot(row0.xyz, params.aabb_center) + row0.w, dot(row1.xyz, params.aabb_center) + row1.w, dot(row2.xyz, params.aabb_center) + row2.w);
+		vec3 extents = vec3(dot(abs(row0.xyz), params.aabb_extents), dot(abs(row1.xyz), params.aabb_extents), dot(abs(row2.xyz), params.aabb_extents));
+
+		visible = true;
+		for (uint i = 0; i < 6; i++) {
+			vec4 plane = params.planes[i];
+			if (dot(plane.xyz, center) - plane.w > dot(abs(plane.xyz), extents)) {
+				visible = false;
+				break;
+			}
+		}
+	}
+
+	// Compact the visible instances, one global atomic per work group.
+
+	if (gl_LocalInvocationIndex == 0) {
+		local_visible = 0;
+	}
+
+	barrier();
+
+	uint local_index = 0;
+	if (visible) {
+		local_index = atomicAdd(local_visible, 1);
+	}
+
+	barrier();
+
+	if (gl_LocalInvocationIndex == 0 && local_visible > 0) {
+		uint surfaces = params.stride_and_surfaces >> 8;
+		local_base = atomicAdd(draw_commands.data[1], local_visible);
+		for (uint i = 1; i < surfaces; i++) {
+			atomicAdd(draw_commands.data[i * 5 + 1], local_visible);
+		}
+	}
+
+	barrier();
+
+	if (visible) {
+		uint src_ofs = instance * stride;
+		uint dst_ofs = (local_base + local_index) * stride;
+		for (uint i = 0; i < stride; i++) {
+			dst_instances.data[dst_ofs + i] = src_instances.data[src_ofs + i];
+		}
+	}
+}
@@ -18,6 +18,9 @@ struct ParticleData {
 	vec4 custom;
 };
 
+#ifndef MODE_SCAN_ALIVE
+#ifndef MODE_WRITE_COMMANDS
+
 layout(set = 0, binding = 1, std430) restrict readonly buffer Particles {
 	ParticleData data[];
 }
@@ -42,6 +45,30 @@ layout(set = 2, binding = 0, std430) restrict readonly buffer TrailBindPoses {
 }
 trail_bind_poses;
 
+#endif // !MODE_WRITE_COMMANDS
+#endif // !MODE_SCAN_ALIVE
+
+#ifdef USE_COMPACTION
+
+// Particles (or trail chunks) still drawn, counted per work group and scanned in place to write offsets.
+layout(set = 3, binding = 0, std430) restrict buffer AliveCounts {
+	uint total;
+	uint pad[3];
+	uint groups[];
+}
+alive;
+
+#endif // USE_COMPACTION
+
+#ifdef MODE_WRITE_COMMANDS
+
+layout(set = 4, binding = 0, std430) restrict buffer DrawCommands {
+	uint data[];
+}
+draw_commands;
+
+#endif // MODE_WRITE_COMMANDS
+
 layout(push_constant, binding = 0, std430) uniform Params {
 	vec3 sort_direction;
 	uint total_particles;
@@ -57,7 +84,7 @@ layout(push_constant, binding = 0, std430) uniform Params {
 	bool order_by_lifetime;
 	uint lifetime_split;
 	bool lifetime_reverse;
-	uint pad;
+	uint command_count;
 }
 params;
 
@@ -66,84 +93,75 @@ params;
 #define TRANSFORM_ALIGN_Y_TO_VELOCITY 2
 #define TRANSFORM_ALIGN_Z_BILLBOARD_Y_TO_VELOCITY 3
 
-void main() {
-#ifdef MODE_FILL_SORT_BUFFER
+#if defined(MODE_FILL_INSTANCES) || defined(MODE_COUNT_ALIVE)
 
-	uint particle = gl_GlobalInvocationID.x;
-	if (particle >= params.total_particles) {
-		return; //discard
-	}
+// Particle (or trail chunk) drawn at the given position, trails take trail_size instances each.
+uint get_source_particle(uint p_index) {
+#ifdef USE_SORT_BUFFER
+	return uint(sort_buffer.data[p_index].y); //use index from sort buffer
+#else
+	if (params.order_by_lifetime) {
+		uint amount = params.total_particles / params.trail_size;
+		uint limit = amount - params.lifetime_split;
 
-	uint src_particle = particle;
-	if (params.trail_size > 1) {
-		src_particle = src_particle * params.trail_size + params.trail_size / 2; //use trail center for sorting
+		if (params.lifetime_reverse) {
+			p_index = amount - p_index - 1;
+		}
+
+		if (p_index < limit) {
+			p_index = params.lifetime_split + p_index;
+		} else {
+			p_index -= limit;
+		}
 	}
-	sort_buffer.data[particle].x = dot(params.sort_direction, particles.data[src_particle].xform[3].xyz);
-	sort_buffer.data[particle].y = float(particle);
-#endif
+	return p_index;
+#endif // USE_SORT_BUFFER
+}
 
-#ifdef MODE_FILL_INSTANCES
+bool is_particle_drawn(uint p_particle) {
+	return bool(particles.data[p_particle].flags & PARTICLE_FLAG_ACTIVE) || bool(particles.data[p_particle].flags & PARTICLE_FLAG_TRAILED);
+}
 
-	uint particle = gl_GlobalInvocationID.x;
+#ifdef USE_COMPACTION
 
-	if (particle >= params.total_particles) {
-		return; //discard
+// Whether any instance of the particle (or trail chunk) drawn at this position is visible.
+bool is_chunk_drawn(uint p_index) {
+	if (p_index >= params.total_particles / params.trail_size) {
+		return false;
 	}
-
-#ifdef USE_SORT_BUFFER
-
-	if (params.trail_size > 1) {
-		particle = uint(sort_buffer.data[particle / params.trail_size].y) + (particle % params.trail_size);
-	} else {
-		particle = uint(sort_buffer.data[particle].y); //use index from sort buffer
+	uint from = get_source_particle(p_index) * params.trail_size;
+	for (uint i = 0; i < params.trail_size; i++) {
+		if (is_particle_drawn(from + i)) {
+			return true;
+		}
 	}
-#else
-	if (params.order_by_lifetime) {
-		if (params.trail_size > 1) {
-			uint limit = (params.total_particles / params.trail_size) - params.lifetime_split;
-
-			uint base_index = particle / params.trail_size;
-			uint base_offset = particle % params.trail_size;
+	return false;
+}
 
-			if (params.lifetime_reverse) {
-				base_index = (params.total_particles / params.trail_size) - base_index - 1;
-			}
+#endif // USE_COMPACTION
 
-			if (base_index < limit) {
-				base_index = params.lifetime_split + base_index;
-			} else {
-				base_index -= limit;
-			}
+#endif
 
-			particle = base_index * params.trail_size + base_offset;
+#ifdef USE_COMPACTION
 
-		} else {
-			uint limit = params.total_particles - params.lifetime_split;
+shared uint group_alive[64];
 
-			if (params.lifetime_reverse) {
-				particle = params.total_particles - particle - 1;
-			}
+#endif // USE_COMPACTION
 
-			if (particle < limit) {
-				particle = params.lifetime_split + particle;
-			} else {
-				particle -= limit;
-			}
-		}
-	}
-#endif // USE_SORT_BUFFER
+#ifdef MODE_FILL_INSTANCES
 
+void write_instance(uint p_index, uint p_particle) {
 	mat4 txform;
 
-	if (bool(particles.data[particle].flags & PARTICLE_FLAG_ACTIVE) || bool(particles.data[particle].flags & PARTICLE_FLAG_TRAILED)) {
-		txform = particles.data[particle].xform;
+	if (is_particle_drawn(p_particle)) {
+		txform = particles.data[p_particle].xform;
 		if (params.trail_size > 1) {
 			// Since the steps don't fit precisely in the history frames, must do a tiny bit of
 			// interpolation to get them close to their intended location.
-			uint part_ofs = particle % params.trail_size;
+			uint part_ofs = p_particle % params.trail_size;
 			float natural_ofs = fract((float(part_ofs) / float(params.trail_size)) * float(params.trail_total)) * params.frame_delta;
 
-			txform[3].xyz -= particles.data[particle].velocity * natural_ofs;
+			txform[3].xyz -= particles.data[p_particle].velocity * natural_ofs;
 		}
 
 		switch (params.align_mode) {
@@ -158,7 +176,7 @@ void main() {
 
 			} break;
 			case TRANSFORM_ALIGN_Y_TO_VELOCITY: {
-				vec3 v = particles.data[particle].velocity;
+				vec3 v = particles.data[p_particle].velocity;
 				float s = (length(txform[0]) + length(txform[1]) + length(txform[2])) / 3.0;
 				if (length(v) > 0.0) {
 					txform[1].xyz = normalize(v);
@@ -172,7 +190,7 @@ void main() {
 				txform[1].xyz *= s;
 			} break;
 			case TRANSFORM_ALIGN_Z_BILLBOARD_Y_TO_VELOCITY: {
-				vec3 v = particles.data[particle].velocity;
+				vec3 v = particles.data[p_particle].velocity;
 				vec3 sv = v - params.sort_direction * dot(params.sort_direction, v); //screen velocity
 				float s = (length(txform[0]) + length(txform[1]) + length(txform[2])) / 3.0;
 
@@ -189,10 +207,10 @@ void main() {
 			} break;
 		}
 
-		txform[3].xyz += particles.data[particle].velocity * params.frame_remainder;
+		txform[3].xyz += particles.data[p_particle].velocity * params.frame_remainder;
 
 		if (params.trail_size > 1) {
-			uint part_ofs = particle % params.trail_size;
+			uint part_ofs = p_particle % params.trail_size;
 			txform = txform * trail_bind_poses.data[part_ofs];
 		}
 
@@ -203,23 +221,164 @@ void main() {
 
 #ifdef MODE_2D
 
-	uint write_offset = gl_GlobalInvocationID.x * (2 + 1 + 1); //xform + color + custom
+	uint write_offset = p_index * (2 + 1 + 1); //xform + color + custom
 
 	instances.data[write_offset + 0] = txform[0];
 	instances.data[write_offset + 1] = txform[1];
-	instances.data[write_offset + 2] = particles.data[particle].color;
-	instances.data[write_offset + 3] = particles.data[particle].custom;
+	instances.data[write_offset + 2] = particles.data[p_particle].color;
+	instances.data[write_offset + 3] = particles.data[p_particle].custom;
 
 #else
 
-	uint write_offset = gl_GlobalInvocationID.x * (3 + 1 + 1); //xform + color + custom
+	uint write_offset = p_index * (3 + 1 + 1); //xform + color + custom
 
 	instances.data[write_offset + 0] = txform[0];
 	instances.data[write_offset + 1] = txform[1];
 	instances.data[write_offset + 2] = txform[2];
-	instances.data[write_offset + 3] = particles.data[particle].color;
-	instances.data[write_offset + 4] = particles.data[particle].custom;
+	instances.data[write_offset + 3] = particles.data[p_particle].color;
+	instances.data[write_offset + 4] = particles.data[p_particle].custom;
 #endif //MODE_2D
+}
+
+#endif // MODE_FILL_INSTANCES
+
+void main() {
+#ifdef MODE_FILL_SORT_BUFFER
+
+	uint particle = gl_GlobalInvocationID.x;
+	if (particle >= params.total_particles) {
+		return; //discard
+	}
+
+	uint src_particle = particle;
+	if (params.trail_size > 1) {
+		src_particle = src_particle * params.trail_size + params.trail_size / 2; //use trail center for sorting
+	}
+	sort_buffer.data[particle].x = dot(params.sort_direction, particles.data[src_particle].xform[3].xyz);
+	sort_buffer.data[particle].y = float(particle);
+#endif
+
+#ifdef MODE_COUNT_ALIVE
+
+	// One thread per particle (or trail chunk), counts how many of the work group are drawn.
+	uint local = gl_LocalInvocationID.x;
+	group_alive[local] = is_chunk_drawn(gl_GlobalInvocationID.x) ? 1 : 0;
+
+	groupMemoryBarrier();
+	barrier();
+
+	for (uint step = 32; step > 0; step >>= 1) {
+		if (local < step) {
+			group_alive[local] += group_alive[local + step];
+		}
+		groupMemoryBarrier();
+		barrier();
+	}
+
+	if (local == 0) {
+		alive.groups[gl_WorkGroupID.x] = group_alive[0];
+	}
+#endif
+
+#ifdef MODE_SCAN_ALIVE
+
+	// Single work group, turns the per group counts into write offsets and stores the total.
+	uint local = gl_LocalInvocationID.x;
+	uint group_count = (params.total_particles / params.trail_size + 63) / 64;
+	uint per_thread = (group_count + 63) / 64;
+	uint from = min(local * per_thread, group_count);
+	uint to = min(from + per_thread, group_count);
+
+	uint sum = 0;
+	for (uint i = from; i < to; i++) {
+		sum += alive.groups[i];
+	}
+	group_alive[local] = sum;
+
+	groupMemoryBarrier();
+	barrier();
+
+	if (local == 0) {
+		uint offset = 0;
+		for (uint i = 0; i < 64; i++) {
+			uint count = group_alive[i];
+			group_alive[i] = offset;
+			offset += count;
+		}
+		alive.total = offset;
+	}
+
+	groupMemoryBarrier();
+	barrier();
+
+	uint offset = group_alive[local];
+	for (uint i = from; i < to; i++) {
+		uint count = alive.groups[i];
+		alive.groups[i] = offset;
+		offset += count;
+	}
+#endif
+
+#ifdef MODE_WRITE_COMMANDS
+
+	// The instance counts hold a multiplier (instances per particle), scale them by the particles drawn.
+	uint command = gl_GlobalInvocationID.x;
+	if (command >= params.command_count) {
+		return;
+	}
+	draw_commands.data[command * 5 + 1] *= alive.total;
+#endif
+
+#ifdef MODE_FILL_INSTANCES
+
+#ifdef USE_COMPACTION
+
+	// One thread per particle (or trail chunk). Drawn ones are packed to the front keeping their
+	// order, the rest of the buffer is cleared so draws not using the alive count stay correct.
+	uint index = gl_GlobalInvocationID.x;
+	uint local = gl_LocalInvocationID.x;
+	bool drawn = is_chunk_drawn(index);
+
+	group_alive[local] = drawn ? 1 : 0;
+
+	groupMemoryBarrier();
+	barrier();
+
+	uint rank = 0;
+	for (uint i = 0; i < local; i++) {
+		rank += group_alive[i];
+	}
+
+	if (index >= params.total_particles / params.trail_size) {
+		return; //discard
+	}
+
+	if (drawn) {
+		uint to = (alive.groups[gl_WorkGroupID.x] + rank) * params.trail_size;
+		uint from = get_source_particle(index) * params.trail_size;
+		for (uint i = 0; i < params.trail_size; i++) {
+			write_instance(to + i, from + i);
+		}
+	}
+
+	if (index >= alive.total) {
+		uint write_offset = index * params.trail_size * (3 + 1 + 1);
+		for (uint i = 0; i < params.trail_size * (3 + 1 + 1); i++) {
+			instances.data[write_offset + i] = vec4(0.0);
+		}
+	}
+
+#else
+
+	uint particle = gl_GlobalInvocationID.x;
+
+	if (particle >= params.total_particles) {
+		return; //discard
+	}
+
+	write_instance(particle, get_source_particle(particle / params.trail_size) * params.trail_size + particle % params.trail_size);
+
+#endif // USE_COMPACTION
 
 #endif
 }
@@ -0,0 +1,207 @@
+#[compute]
+
+#version 450
+
+#VERSION_DEFINES
+
+// Stable least significant digit radix sort of vec2 elements by their x component, in ascending
+// order (same as sort.glsl). Keys are sorted 8 bits per pass, ping-ponging between two buffers,
+// so after the four passes the result is back in the first one.
+
+#define RADIX_BITS 8
+#define RADIX_SIZE 256
+#define ELEMENTS_PER_THREAD 4
+#define TILE_SIZE (RADIX_SIZE * ELEMENTS_PER_THREAD)
+
+layout(local_size_x = RADIX_SIZE, local_size_y = 1, local_size_z = 1) in;
+
+layout(set = 0, binding = 0, std430) restrict buffer SortBuffer {
+	vec2 data[];
+}
+sort_buffer;
+
+layout(set = 0, binding = 1, std430) restrict buffer TempBuffer {
+	vec2 data[];
+}
+temp_buffer;
+
+// Element count of every digit in every tile, digit major so a linear scan gives write offsets.
+layout(set = 0, binding = 2, std430) restrict buffer Histogram {
+	uint data[];
+}
+histogram;
+
+layout(push_constant, binding = 0, std430) uniform Params {
+	uint total_elements;
+	uint tile_count;
+	uint shift;
+	bool from_temp;
+}
+params;
+
+#ifdef MODE_SCATTER
+
+shared uint local_scan[RADIX_SIZE];
+shared uint local_digits[RADIX_SIZE];
+shared uint digit_start[RADIX_SIZE];
+shared uint digit_offset[RADIX_SIZE];
+
+#else
+
+shared uint local_counts[RADIX_SIZE];
+
+#endif
+
+vec2 read_element(uint p_index) {
+	return params.from_temp ? temp_buffer.data[p_index] : sort_buffer.data[p_index];
+}
+
+uint get_digit(float p_key) {
+	// Flip the float bits so they sort as unsigned integers.
+	uint key = floatBitsToUint(p_key);
+	key ^= bool(key & 0x80000000) ? 0xFFFFFFFF : 0x80000000;
+	return (key >> params.shift) & (RADIX_SIZE - 1);
+}
+
+void main() {
+	uint local = gl_LocalInvocationID.x;
+	uint tile = gl_WorkGroupID.x;
+
+#ifdef MODE_HISTOGRAM
+
+	local_counts[local] = 0;
+
+	groupMemoryBarrier();
+	barrier();
+
+	for (uint i = 0; i < ELEMENTS_PER_THREAD; i++) {
+		uint index = tile * TILE_SIZE + i * RADIX_SIZE + local;
+		if (index < params.total_elements) {
+			atomicAdd(local_counts[get_digit(read_element(index).x)], 1);
+		}
+	}
+
+	groupMemoryBarrier();
+	barrier();
+
+	histogram.data[local * params.tile_count + tile] = local_counts[local];
+
+#endif
+
+#ifdef MODE_SCAN
+
+	// Single work group, each thread scans the row of one digit, then rows are offset by the
+	// totals of the digits before them.
+	uint row = local * params.tile_count;
+	uint sum = 0;
+	for (uint i = 0; i < params.tile_count; i++) {
+		sum += histogram.data[row + i];
+	}
+	local_counts[local] = sum;
+
+	groupMemoryBarrier();
+	barrier();
+
+	for (uint step = 1; step < RADIX_SIZE; step <<= 1) {
+		uint value = local_counts[local];
+		if (local >= step) {
+			value += local_counts[local - step];
+		}
+
+		groupMemoryBarrier();
+		barrier();
+
+		local_counts[local] = value;
+
+		groupMemoryBarrier();
+		barrier();
+	}
+
+	uint offset = local_counts[local] - sum;
+	for (uint i = 0; i < params.tile_count; i++) {
+		uint count = histogram.data[row + i];
+		histogram.data[row + i] = offset;
+		offset += count;
+	}
+
+#endif
+
+#ifdef MODE_SCATTER
+
+	digit_offset[local] = histogram.data[local * params.tile_count + tile];
+
+	for (uint i = 0; i < ELEMENTS_PER_THREAD; i++) {
+		// Elements are ranked in rounds of RADIX_SIZE, in index order to keep the sort stable.
+		uint index = tile * TILE_SIZE + i * RADIX_SIZE + local;
+		bool valid = index < params.total_elements;
+		vec2 element = valid ? read_element(index) : vec2(0.0);
+		// Missing elements only exist at the end of the last tile, so they can go last.
+		uint digit = valid ? get_digit(element.x) : RADIX_SIZE - 1;
+
+		// Stable split by each bit of the digit, leaves equal digits together in index order.
+		uint position = local;
+		for (uint bit = 0; bit < RADIX_BITS; bit++) {
+			uint is_set = (digit >> bit) & 1;
+			local_scan[position] = is_set;
+
+			groupMemoryBarrier();
+			barrier();
+
+			for (uint step = 1; step < RADIX_SIZE; step <<= 1) {
+				uint value = local_scan[local];
+				if (local >= step) {
+					value += local_scan[local - step];
+				}
+
+				groupMemoryBarrier();
+				barrier();
+
+				local_scan[local] = value;
+
+				groupMemoryBarrier();
+				barrier();
+			}
+
+			uint set_before = local_scan[position] - is_set;
+			uint set_total = local_scan[RADIX_SIZE - 1];
+			position = bool(is_set) ? (RADIX_SIZE - set_total) + set_before : position - set_before;
+
+			groupMemoryBarrier();
+			barrier();
+		}
+
+		local_digits[position] = digit;
+
+		groupMemoryBarrier();
+		barrier();
+
+		if (position == 0 || local_digits[position - 1] != digit) {
+			digit_start[digit] = position;
+		}
+
+		groupMemoryBarrier();
+		barrier();
+
+		uint rank = position - digit_start[digit];
+		if (valid) {
+			if (params.from_temp) {
+				sort_buffer.data[digit_offset[digit] + rank] = element;
+			} else {
+				temp_buffer.data[digit_offset[digit] + rank] = element;
+			}
+		}
+
+		groupMemoryBarrier();
+		barrier();
+
+		// The last element of each digit advances the write offset for the next round.
+		if (position == RADIX_SIZE - 1 || local_digits[position + 1] != digit) {
+			digit_offset[digit] += rank + 1;
+		}
+
+		groupMemoryBarrier();
+		barrier();
+	}
+
+#endif
+}
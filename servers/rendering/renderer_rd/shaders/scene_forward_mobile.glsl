@@ -393,6 +393,9 @@ layout(constant_id = 10) const bool sc_disable_spot_lights = false;
 layout(constant_id = 11) const bool sc_disable_reflection_probes = false;
 layout(constant_id = 12) const bool sc_disable_directional_lights = false;
 
+// Omni and spot lights come from the cluster buffer instead of the per object lists in the push constant.
+layout(constant_id = 15) const bool sc_use_clustered_lights = false;
+
 #endif //!MODE_UNSHADED
 
 layout(constant_id = 7) const bool sc_decal_use_mipmaps = true;
@@ -565,6 +568,21 @@ vec4 fog_process(vec3 vertex) {
 	return vec4(fog_color, fog_amount);
 }
 
+void cluster_get_item_range(uint p_offset, out uint item_min, out uint item_max, out uint item_from, out uint item_to) {
+	uint item_min_max = cluster_buffer.data[p_offset];
+	item_min = item_min_max & 0xFFFF;
+	item_max = item_min_max >> 16;
+
+	item_from = item_min >> 5;
+	item_to = (item_max == 0) ? 0 : ((item_max - 1) >> 5) + 1; //side effect of how it is stored, as item_max 0 means no elements
+}
+
+uint cluster_get_range_clip_mask(uint i, uint z_min, uint z_max) {
+	int local_min = clamp(int(z_min) - int(i) * 32, 0, 31);
+	int mask_width = min(int(z_max) - int(z_min), 32 - local_min);
+	return bitfieldInsert(uint(0), uint(0xFFFFFFFF), local_min, mask_width);
+}
+
 #endif //!MODE_RENDER DEPTH
 
 void main() {
@@ -768,7 +786,7 @@ void main() {
 		uint decal_indices = draw_call.decals.x;
 		for (uint i = 0; i < 8; i++) {
 			uint decal_index = decal_indices & 0xFF;
-			if (i == 4) {
+			if (i == 3) {
 				decal_indices = draw_call.decals.y;
 			} else {
 				decal_indices = decal_indices >> 8;
@@ -986,7 +1004,7 @@ void main() {
 		uint reflection_indices = draw_call.reflection_probes.x;
 		for (uint i = 0; i < 8; i++) {
 			uint reflection_index = reflection_indices & 0xFF;
-			if (i == 4) {
+			if (i == 3) {
 				reflection_indices = draw_call.reflection_probes.y;
 			} else {
 				reflection_indices = reflection_indices >> 8;
@@ -1375,98 +1393,174 @@ void main() {
 		}
 	} //directional light
 
+	uint cluster_offset = 0;
+	uint cluster_z = 0;
+	if (sc_use_clustered_lights) {
+		uvec2 cluster_pos = uvec2(gl_FragCoord.xy) >> scene_data.cluster_shift;
+		cluster_offset = (scene_data.cluster_width * cluster_pos.y + cluster_pos.x) * (scene_data.max_cluster_element_count_div_32 + 32);
+		cluster_z = uint(clamp((-vertex.z / scene_data.z_far) * 32.0, 0.0, 31.0));
+	}
+
 	if (!sc_disable_omni_lights) { //omni lights
 		uint light_indices = draw_call.omni_lights.x;
-		for (uint i = 0; i < 8; i++) {
-			uint light_index = light_indices & 0xFF;
-			if (i == 4) {
-				light_indices = draw_call.omni_lights.y;
-			} else {
-				light_indices = light_indices >> 8;
-			}
+		uint cluster_omni_offset = cluster_offset;
+		uint item_min = 0;
+		uint item_max = 0;
+		uint item_from = 0;
+		uint item_to = 8;
+		if (sc_use_clustered_lights) {
+			cluster_get_item_range(cluster_omni_offset + scene_data.max_cluster_element_count_div_32 + cluster_z, item_min, item_max, item_from, item_to);
+		}
 
-			if (light_index == 0xFF) {
-				break;
+		for (uint i = item_from; i < item_to; i++) {
+			// Either one cluster mask word of 32 lights, or a single light from the per object list.
+			uint mask = 1;
+			if (sc_use_clustered_lights) {
+				mask = cluster_buffer.data[cluster_omni_offset + i] & cluster_get_range_clip_mask(i, item_min, item_max);
 			}
 
-			float shadow = light_process_omni_shadow(light_index, vertex, normal);
+			while (mask != 0) {
+				uint light_index;
+				if (sc_use_clustered_lights) {
+					uint bit = findMSB(mask);
+					mask &= ~(1 << bit);
+					light_index = 32 * i + bit;
 
-			shadow = blur_shadow(shadow);
+					if (!bool(omni_lights.data[light_index].mask & draw_call.layer_mask)) {
+						continue; //not masked
+					}
 
-			light_process_omni(light_index, vertex, view, normal, vertex_ddx, vertex_ddy, f0, orms, shadow,
+					if (omni_lights.data[light_index].bake_mode == LIGHT_BAKE_STATIC && bool(draw_call.flags & INSTANCE_FLAGS_USE_LIGHTMAP)) {
+						continue; // Statically baked light and object uses lightmap, skip
+					}
+				} else {
+					mask = 0;
+					light_index = light_indices & 0xFF;
+					if (i == 3) {
+						light_indices = draw_call.omni_lights.y;
+					} else {
+						light_indices = light_indices >> 8;
+					}
+
+					if (light_index == 0xFF) {
+						i = item_to; // End of the list.
+						break;
+					}
+				}
+
+				float shadow = light_process_omni_shadow(light_index, vertex, normal);
+
+				shadow = blur_shadow(shadow);
+
+				light_process_omni(light_index, vertex, view, normal, vertex_ddx, vertex_ddy, f0, orms, shadow,
 #ifdef LIGHT_BACKLIGHT_USED
-					backlight,
+						backlight,
 #endif
 /*
 #ifdef LIGHT_TRANSMITTANCE_USED
-					transmittance_color,
-					transmittance_depth,
-					transmittance_boost,
+						transmittance_color,
+						transmittance_depth,
+						transmittance_boost,
 #endif
 */
 #ifdef LIGHT_RIM_USED
-					rim,
-					rim_tint,
-					albedo,
+						rim,
+						rim_tint,
+						albedo,
 #endif
 #ifdef LIGHT_CLEARCOAT_USED
-					clearcoat, clearcoat_gloss,
+						clearcoat, clearcoat_gloss,
 #endif
 #ifdef LIGHT_ANISOTROPY_USED
-					tangent, binormal, anisotropy,
+						tangent, binormal, anisotropy,
 #endif
 #ifdef USE_SHADOW_TO_OPACITY
-					alpha,
+						alpha,
 #endif
-					diffuse_light, specular_light);
+						diffuse_light, specular_light);
+			}
 		}
 	} //omni lights
 
 	if (!sc_disable_spot_lights) { //spot lights
 
 		uint light_indices = draw_call.spot_lights.x;
-		for (uint i = 0; i < 8; i++) {
-			uint light_index = light_indices & 0xFF;
-			if (i == 4) {
-				light_indices = draw_call.spot_lights.y;
-			} else {
-				light_indices = light_indices >> 8;
-			}
+		uint cluster_spot_offset = cluster_offset + scene_data.cluster_type_size;
+		uint item_min = 0;
+		uint item_max = 0;
+		uint item_from = 0;
+		uint item_to = 8;
+		if (sc_use_clustered_lights) {
+			cluster_get_item_range(cluster_spot_offset + scene_data.max_cluster_element_count_div_32 + cluster_z, item_min, item_max, item_from, item_to);
+		}
 
-			if (light_index == 0xFF) {
-				break;
+		for (uint i = item_from; i < item_to; i++) {
+			// Either one cluster mask word of 32 lights, or a single light from the per object list.
+			uint mask = 1;
+			if (sc_use_clustered_lights) {
+				mask = cluster_buffer.data[cluster_spot_offset + i] & cluster_get_range_clip_mask(i, item_min, item_max);
 			}
 
-			float shadow = light_process_spot_shadow(light_index, vertex, normal);
+			while (mask != 0) {
+				uint light_index;
+				if (sc_use_clustered_lights) {
+					uint bit = findMSB(mask);
+					mask &= ~(1 << bit);
+					light_index = 32 * i + bit;
 
-			shadow = blur_shadow(shadow);
+					if (!bool(spot_lights.data[light_index].mask & draw_call.layer_mask)) {
+						continue; //not masked
+					}
 
-			light_process_spot(light_index, vertex, view, normal, vertex_ddx, vertex_ddy, f0, orms, shadow,
+					if (spot_lights.data[light_index].bake_mode == LIGHT_BAKE_STATIC && bool(draw_call.flags & INSTANCE_FLAGS_USE_LIGHTMAP)) {
+						continue; // Statically baked light and object uses lightmap, skip
+					}
+				} else {
+					mask = 0;
+					light_index = light_indices & 0xFF;
+					if (i == 3) {
+						light_indices = draw_call.spot_lights.y;
+					} else {
+						light_indices = light_indices >> 8;
+					}
+
+					if (light_index == 0xFF) {
+						i = item_to; // End of the list.
+						break;
+					}
+				}
+
+				float shadow = light_process_spot_shadow(light_index, vertex, normal);
+
+				shadow = blur_shadow(shadow);
+
+				light_process_spot(light_index, vertex, view, normal, vertex_ddx, vertex_ddy, f0, orms, shadow,
 #ifdef LIGHT_BACKLIGHT_USED
-					backlight,
+						backlight,
 #endif
 /*
 #ifdef LIGHT_TRANSMITTANCE_USED
-					transmittance_color,
-					transmittance_depth,
-					transmittance_boost,
+						transmittance_color,
+						transmittance_depth,
+						transmittance_boost,
 #endif
 */
 #ifdef LIGHT_RIM_USED
-					rim,
-					rim_tint,
-					albedo,
+						rim,
+						rim_tint,
+						albedo,
 #endif
 #ifdef LIGHT_CLEARCOAT_USED
-					clearcoat, clearcoat_gloss,
+						clearcoat, clearcoat_gloss,
 #endif
 #ifdef LIGHT_ANISOTROPY_USED
-					tangent, binormal, anisotropy,
+						tangent, binormal, anisotropy,
 #endif
 #ifdef USE_SHADOW_TO_OPACITY
-					alpha,
+						alpha,
 #endif
-					diffuse_light, specular_light);
+						diffuse_light, specular_light);
+			}
 		}
 	} //spot lights
 
@@ -100,7 +100,8 @@ layout(push_constant, binding = 3, std430) uniform Params {
 	vec2 NDC_to_view_mul;
 	vec2 NDC_to_view_add;
 
-	vec2 pad2;
+	uint rotation_offset;
+	float pad2;
 	vec2 half_screen_pixel_size_x025;
 
 	float radius;
@@ -298,7 +299,8 @@ void generate_SSAO_shadows_internal(out float r_shadow_term, out vec4 r_edges, o
 		}
 
 		// load & update pseudo-random rotation matrix
-		pseudo_random_index = uint(pos_rounded.y * 2 + pos_rounded.x) % 5;
+		// rotation_offset cycles the matrices every frame when SSAO is accumulated over time.
+		pseudo_random_index = (uint(pos_rounded.y * 2 + pos_rounded.x) + params.rotation_offset) % 5;
 		rotation_scale = constants.rotation_matrices[params.pass * 5 + pseudo_random_index];
 		rot_scale_matrix = mat2(rotation_scale.x * pixel_lookup_radius, rotation_scale.y * pixel_lookup_radius, rotation_scale.z * pixel_lookup_radius, rotation_scale.w * pixel_lookup_radius);
 	}
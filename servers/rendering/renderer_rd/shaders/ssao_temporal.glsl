@@ -0,0 +1,67 @@
+#[compute]
+
+#version 450
+
+#VERSION_DEFINES
+
+// Blends the final SSAO with the previous frames, reprojected using the depth buffer and the camera
+// motion. Geometry is assumed static, history from a different surface is rejected by comparing
+// the depth it was stored with.
+
+layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+
+layout(set = 0, binding = 0) uniform sampler2D source_depth;
+layout(set = 1, binding = 0) uniform sampler2D source_history;
+layout(r8, set = 2, binding = 0) uniform restrict image2D ao_image;
+layout(rg16f, set = 3, binding = 0) uniform restrict writeonly image2D dest_history;
+
+layout(push_constant, binding = 1, std430) uniform Params {
+	mat4 reprojection;
+
+	ivec2 screen_size;
+	float z_near;
+	float z_far;
+
+	float blend;
+	float depth_tolerance;
+	bool orthogonal;
+	bool use_history;
+}
+params;
+
+float get_linear_depth(float p_ndc_depth) {
+	if (params.orthogonal) {
+		return ((p_ndc_depth + (params.z_far + params.z_near) / (params.z_far - params.z_near)) * (params.z_far - params.z_near)) / 2.0;
+	} else {
+		return 2.0 * params.z_near * params.z_far / (params.z_far + params.z_near - p_ndc_depth * (params.z_far - params.z_near));
+	}
+}
+
+void main() {
+	ivec2 pos = ivec2(gl_GlobalInvocationID.xy);
+	if (any(greaterThanEqual(pos, params.screen_size))) { //too large, do nothing
+		return;
+	}
+
+	float ao = imageLoad(ao_image, pos).r;
+	float depth = texelFetch(source_depth, pos, 0).r * 2.0 - 1.0;
+	float linear_depth = get_linear_depth(depth);
+
+	if (params.use_history) {
+		vec2 uv = (vec2(pos) + 0.5) / vec2(params.screen_size);
+		vec4 prev_pos = params.reprojection * vec4(uv.x * 2.0 - 1.0, 1.0 - uv.y * 2.0, depth, 1.0);
+		prev_pos.xyz /= prev_pos.w;
+		vec2 prev_uv = vec2(prev_pos.x * 0.5 + 0.5, 0.5 - prev_pos.y * 0.5);
+
+		if (all(greaterThanEqual(prev_uv, vec2(0.0))) && all(lessThanEqual(prev_uv, vec2(1.0)))) {
+			vec2 history = textureLod(source_history, prev_uv, 0.0).xy;
+			float prev_depth = get_linear_depth(prev_pos.z);
+			if (abs(history.y - prev_depth) < prev_depth * params.depth_tolerance) {
+				ao = mix(ao, history.x, params.blend);
+			}
+		}
+	}
+
+	imageStore(ao_image, pos, vec4(ao));
+	imageStore(dest_history, pos, vec4(ao, linear_depth, 0.0, 0.0));
+}
@@ -31,6 +31,7 @@
 #include "renderer_scene_cull.h"
 
 #include "core/config/project_settings.h"
+#include "core/debugger/trace_zones.h"
 #include "core/os/os.h"
 #include "rendering_server_default.h"
 #include "rendering_server_globals.h"
@@ -74,10 +75,23 @@ void RendererSceneCull::camera_set_frustum(RID p_camera, float p_size, Vector2 p
 	camera->zfar = p_z_far;
 }
 
+void RendererSceneCull::_camera_apply_transform(Camera *p_camera, const Transform3D &p_transform) {
+	p_camera->transform = p_transform.orthonormalized();
+}
+
 void RendererSceneCull::camera_set_transform(RID p_camera, const Transform3D &p_transform) {
 	Camera *camera = camera_owner.get_or_null(p_camera);
 	ERR_FAIL_COND(!camera);
-	camera->transform = p_transform.orthonormalized();
+
+	if (camera->interpolated) {
+		camera->transform_curr = p_transform;
+		if (camera->interpolation_reset) {
+			camera->transform_prev = p_transform;
+			camera->interpolation_reset = false;
+		}
+		return; // Applied when drawing, see set_physics_interpolation_fraction().
+	}
+	_camera_apply_transform(camera, p_transform);
 }
 
 void RendererSceneCull::camera_set_cull_mask(RID p_camera, uint32_t p_layers) {
@@ -105,6 +119,37 @@ void RendererSceneCull::camera_set_use_vertical_aspect(RID p_camera, bool p_enab
 	camera->vaspect = p_enable;
 }
 
+void RendererSceneCull::camera_set_interpolated(RID p_camera, bool p_interpolated) {
+	Camera *camera = camera_owner.get_or_null(p_camera);
+	ERR_FAIL_COND(!camera);
+
+	if (camera->interpolated == p_interpolated) {
+		return;
+	}
+
+	camera->interpolated = p_interpolated;
+	if (p_interpolated) {
+		camera->transform_prev = camera->transform;
+		camera->transform_curr = camera->transform;
+		// Whatever transform comes next places the camera, there is nothing to interpolate from.
+		camera->interpolation_reset = true;
+		interpolated_cameras.add(&camera->interpolated_item);
+	} else {
+		interpolated_cameras.remove(&camera->interpolated_item);
+		_camera_apply_transform(camera, camera->transform_curr);
+	}
+}
+
+void RendererSceneCull::camera_reset_physics_interpolation(RID p_camera) {
+	Camera *camera = camera_owner.get_or_null(p_camera);
+	ERR_FAIL_COND(!camera);
+
+	if (camera->interpolated) {
+		camera->transform_prev = camera->transform_curr;
+		_camera_apply_transform(camera, camera->transform_curr);
+	}
+}
+
 bool RendererSceneCull::is_camera(RID p_camera) const {
 	return camera_owner.owns(p_camera);
 }
@@ -819,10 +864,7 @@ void RendererSceneCull::instance_set_layer_mask(RID p_instance, uint32_t p_mask)
 	}
 }
 
-void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D &p_transform) {
-	Instance *instance = instance_owner.get_or_null(p_instance);
-	ERR_FAIL_COND(!instance);
-
+void RendererSceneCull::_instance_apply_transform(Instance *instance, const Transform3D &p_transform) {
 	if (instance->transform == p_transform) {
 		return; //must be checked to avoid worst evil
 	}
@@ -844,6 +886,39 @@ void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D
 	_instance_queue_update(instance, true);
 }
 
+void RendererSceneCull::_instance_set_transform(Instance *instance, const Transform3D &p_transform) {
+	if (instance->interpolated) {
+		instance->transform_curr = p_transform;
+		if (instance->interpolation_reset) {
+			instance->transform_prev = p_transform;
+			instance->interpolation_reset = false;
+		}
+		return; // Applied when drawing, see set_physics_interpolation_fraction().
+	}
+	_instance_apply_transform(instance, p_transform);
+}
+
+void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D &p_transform) {
+	Instance *instance = instance_owner.get_or_null(p_instance);
+	ERR_FAIL_COND(!instance);
+
+	_instance_set_transform(instance, p_transform);
+}
+
+void RendererSceneCull::instance_set_transforms(const Vector<RID> &p_instances, const Vector<Transform3D> &p_transforms) {
+	ERR_FAIL_COND(p_instances.size() != p_transforms.size());
+
+	const RID *instances = p_instances.ptr();
+	const Transform3D *transforms = p_transforms.ptr();
+	for (int i = 0; i < p_instances.size(); i++) {
+		Instance *instance = instance_owner.get_or_null(instances[i]);
+		if (!instance) {
+			continue; // May have been freed after being queued.
+		}
+		_instance_set_transform(instance, transforms[i]);
+	}
+}
+
 void RendererSceneCull::instance_attach_object_instance_id(RID p_instance, ObjectID p_id) {
 	Instance *instance = instance_owner.get_or_null(p_instance);
 	ERR_FAIL_COND(!instance);
@@ -921,6 +996,37 @@ void RendererSceneCull::instance_set_visible(RID p_instance, bool p_visible) {
 	}
 }
 
+void RendererSceneCull::instance_set_interpolated(RID p_instance, bool p_interpolated) {
+	Instance *instance = instance_owner.get_or_null(p_instance);
+	ERR_FAIL_COND(!instance);
+
+	if (instance->interpolated == p_interpolated) {
+		return;
+	}
+
+	instance->interpolated = p_interpolated;
+	if (p_interpolated) {
+		instance->transform_prev = instance->transform;
+		instance->transform_curr = instance->transform;
+		// Whatever transform comes next places the instance, there is nothing to interpolate from.
+		instance->interpolation_reset = true;
+		interpolated_instances.add(&instance->interpolated_item);
+	} else {
+		interpolated_instances.remove(&instance->interpolated_item);
+		_instance_apply_transform(instance, instance->transform_curr);
+	}
+}
+
+void RendererSceneCull::instance_reset_physics_interpolation(RID p_instance) {
+	Instance *instance = instance_owner.get_or_null(p_instance);
+	ERR_FAIL_COND(!instance);
+
+	if (instance->interpolated) {
+		instance->transform_prev = instance->transform_curr;
+		_instance_apply_transform(instance, instance->transform_curr);
+	}
+}
+
 inline bool is_geometry_instance(RenderingServer::InstanceType p_type) {
 	return p_type == RS::INSTANCE_MESH || p_type == RS::INSTANCE_MULTIMESH || p_type == RS::INSTANCE_PARTICLES;
 }
@@ -1415,6 +1521,7 @@ void RendererSceneCull::instance_geometry_get_shader_parameter_list(RID p_instan
 
 void RendererSceneCull::_update_instance(Instance *p_instance) {
 	p_instance->version++;
+	p_instance->last_update_frame = RSG::rasterizer->get_frame_number();
 
 	if (p_instance->base_type == RS::INSTANCE_LIGHT) {
 		InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
@@ -2128,14 +2235,92 @@ void RendererSceneCull::_light_instance_setup_directional_shadow(int p_shadow_in
 	}
 }
 
+void RendererSceneCull::_light_instance_add_shadow_cull(Instance *p_instance, const Vector<Plane> &p_planes, uint32_t p_pass, Scenario *p_scenario) {
+	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
+
+	RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used];
+	shadow_data.light = light->instance;
+	shadow_data.pass = p_pass;
+	shadow_data.static_version = 0;
+
+	ShadowCullJob job;
+	job.light = light;
+	job.scenario = p_scenario;
+	job.shadow_index = max_shadows_used;
+	job.planes = p_planes;
+	job.light_version = p_instance->version;
+	if (shadow_static_cache) {
+		// Cube shadows are rendered to a cubemap and copied into the atlas afterwards, so they are not cached.
+		job.static_cache = RSG::storage->light_get_type(p_instance->base) == RS::LIGHT_SPOT || RSG::storage->light_omni_get_shadow_mode(p_instance->base) == RS::LIGHT_OMNI_SHADOW_DUAL_PARABOLOID || !scene_render->light_instances_can_render_shadow_cube();
+	}
+	shadow_cull_jobs.push_back(job);
+
+	max_shadows_used++;
+}
+
+void RendererSceneCull::_light_shadow_cull_threaded(uint32_t p_job, ShadowCullJob *p_jobs) {
+	ShadowCullJob &job = p_jobs[p_job];
+
+	Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&job.planes[0], job.planes.size());
+
+	struct CullConvex {
+		ShadowCullJob *job;
+		PagedArray<RendererSceneRender::GeometryInstance *> *result;
+		PagedArray<RendererSceneRender::GeometryInstance *> *static_result; // Null when not caching.
+		uint64_t frame;
+		uint64_t static_hash;
+		_FORCE_INLINE_ bool operator()(void *p_data) {
+			Instance *instance = (Instance *)p_data;
+			if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
+				return false;
+			}
+
+			InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(instance->base_data);
+			if (geom->material_is_animated) {
+				job->animated_material_found = true;
+			}
+			if (instance->mesh_instance.is_valid()) {
+				job->mesh_instances.push_back(instance);
+			}
+
+			// Plain meshes that have not changed for a while can be kept in the cached part of the shadow.
+			if (static_result && instance->base_type == RS::INSTANCE_MESH && !geom->material_is_animated && instance->mesh_instance.is_null() && frame - instance->last_update_frame > SHADOW_STATIC_CASTER_FRAMES) {
+				// Summed so the result does not depend on the traversal order.
+				uint64_t h = hash_djb2_one_64(instance->version, hash_djb2_one_64((uint64_t)instance));
+				static_hash += (uint64_t(hash_one_uint64(h)) << 32) | hash_one_uint64(h ^ 0x9E3779B97F4A7C15);
+				static_result->push_back(geom->geometry_instance);
+				return false;
+			}
+
+			result->push_back(geom->geometry_instance);
+			return false;
+		}
+	};
+
+	RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[job.shadow_index];
+
+	CullConvex cull_convex;
+	cull_convex.job = &job;
+	cull_convex.result = &shadow_data.instances;
+	cull_convex.static_result = job.static_cache ? &shadow_data.static_instances : nullptr;
+	cull_convex.frame = RSG::rasterizer->get_frame_number();
+	cull_convex.static_hash = 0;
+
+	job.scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(job.planes.ptr(), job.planes.size(), points.ptr(), points.size(), cull_convex);
+
+	if (shadow_data.static_instances.size()) {
+		uint64_t version = hash_djb2_one_64(job.light_version, cull_convex.static_hash);
+		shadow_data.static_version = version ? version : 1;
+	}
+}
+
 bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_screen_lod_threshold) {
+	// Only sets up the passes, the instances are culled afterwards for all lights at once, see _light_shadow_cull_threaded().
 	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
 	Transform3D light_transform = p_instance->transform;
 	light_transform.orthonormalize(); //scale does not count on lights
 
-	bool animated_material_found = false;
-
 	switch (RSG::storage->light_get_type(p_instance->base)) {
 		case RS::LIGHT_DIRECTIONAL: {
 		} break;
@@ -2148,8 +2333,6 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 				}
 				for (int i = 0; i < 2; i++) {
 					//using this one ensures that raster deferred will have it
-					RENDER_TIMESTAMP("Culling Shadow Paraboloid" + itos(i));
-
 					real_t radius = RSG::storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
 
 					real_t z = i == 0 ? -1 : 1;
@@ -2162,48 +2345,9 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 					planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
 					planes.write[5] = light_transform.xform(Plane(Vector3(0, 0, -z), 0));
 
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
-
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
-
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
-					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
-
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-
-							if (instance->mesh_instance.is_valid()) {
-								RSG::storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
-
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-					}
-
-					RSG::storage->update_mesh_instances();
+					_light_instance_add_shadow_cull(p_instance, planes, i, p_scenario);
 
 					scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, radius, 0, i, 0);
-					shadow_data.light = light->instance;
-					shadow_data.pass = i;
 				}
 			} else { //shadow cube
 
@@ -2216,7 +2360,6 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 				cm.set_perspective(90, 1, radius * 0.005f, radius);
 
 				for (int i = 0; i < 6; i++) {
-					RENDER_TIMESTAMP("Culling Shadow Cube side" + itos(i));
 					//using this one ensures that raster deferred will have it
 
 					static const Vector3 view_normals[6] = {
@@ -2240,47 +2383,9 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 					Vector<Plane> planes = cm.get_projection_planes(xform);
 
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
+					_light_instance_add_shadow_cull(p_instance, planes, i, p_scenario);
 
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
-
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
-
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
-					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
-
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-							if (instance->mesh_instance.is_valid()) {
-								RSG::storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
-
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-					}
-
-					RSG::storage->update_mesh_instances();
 					scene_render->light_instance_set_shadow_transform(light->instance, cm, xform, radius, 0, i, 0);
-
-					shadow_data.light = light->instance;
-					shadow_data.pass = i;
 				}
 
 				//restore the regular DP matrix
@@ -2289,8 +2394,6 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 		} break;
 		case RS::LIGHT_SPOT: {
-			RENDER_TIMESTAMP("Culling Spot Light");
-
 			if (max_shadows_used + 1 > MAX_UPDATE_SHADOWS) {
 				return true;
 			}
@@ -2303,56 +2406,19 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 			Vector<Plane> planes = cm.get_projection_planes(light_transform);
 
-			instance_shadow_cull_result.clear();
-
-			Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-			struct CullConvex {
-				PagedArray<Instance *> *result;
-				_FORCE_INLINE_ bool operator()(void *p_data) {
-					Instance *p_instance = (Instance *)p_data;
-					result->push_back(p_instance);
-					return false;
-				}
-			};
-
-			CullConvex cull_convex;
-			cull_convex.result = &instance_shadow_cull_result;
-
-			p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
-			RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
-
-			for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-				Instance *instance = instance_shadow_cull_result[j];
-				if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-					continue;
-				} else {
-					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-						animated_material_found = true;
-					}
-
-					if (instance->mesh_instance.is_valid()) {
-						RSG::storage->mesh_instance_check_for_update(instance->mesh_instance);
-					}
-				}
-				shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-			}
-
-			RSG::storage->update_mesh_instances();
+			_light_instance_add_shadow_cull(p_instance, planes, 0, p_scenario);
 
 			scene_render->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0, 0);
-			shadow_data.light = light->instance;
-			shadow_data.pass = 0;
 
 		} break;
 	}
 
-	return animated_material_found;
+	return false;
 }
 
 void RendererSceneCull::render_camera(RID p_render_buffers, RID p_camera, RID p_scenario, RID p_viewport, Size2 p_viewport_size, float p_screen_lod_threshold, RID p_shadow_atlas, Ref<XRInterface> &p_xr_interface, RenderInfo *r_render_info) {
 #ifndef _3D_DISABLED
+	TRACE_ZONE("RendererSceneCull::render_camera");
 
 	Camera *camera = camera_owner.get_or_null(p_camera);
 	ERR_FAIL_COND(!camera);
@@ -2916,6 +2982,7 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 	//render shadows
 
 	max_shadows_used = 0;
+	shadow_cull_jobs.clear();
 
 	if (p_using_shadows) { //setup shadow maps
 
@@ -2931,6 +2998,7 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 				}
 				render_shadow_data[max_shadows_used].light = cull.shadows[i].light_instance;
 				render_shadow_data[max_shadows_used].pass = j;
+				render_shadow_data[max_shadows_used].static_version = 0;
 				render_shadow_data[max_shadows_used].instances.merge_unordered(scene_cull_result.directional_shadows[i].cascade_geometry_instances[j]);
 				max_shadows_used++;
 			}
@@ -3032,6 +3100,29 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 				light->shadow_dirty = redraw;
 			}
 		}
+
+		if (shadow_cull_jobs.size()) {
+			RENDER_TIMESTAMP("Cull Light Shadows");
+
+			// Every pass (cube side, paraboloid or spot) fills its own shadow data, so they can all run at once.
+			if (shadow_cull_jobs.size() > 1) {
+				RendererThreadPool::singleton->thread_work_pool.do_work(shadow_cull_jobs.size(), this, &RendererSceneCull::_light_shadow_cull_threaded, shadow_cull_jobs.ptr());
+			} else {
+				_light_shadow_cull_threaded(0, shadow_cull_jobs.ptr());
+			}
+
+			for (uint32_t i = 0; i < shadow_cull_jobs.size(); i++) {
+				ShadowCullJob &job = shadow_cull_jobs[i];
+				if (job.animated_material_found) {
+					job.light->shadow_dirty = true;
+				}
+				for (uint32_t j = 0; j < job.mesh_instances.size(); j++) {
+					RSG::storage->mesh_instance_check_for_update(job.mesh_instances[j]->mesh_instance);
+				}
+			}
+
+			RSG::storage->update_mesh_instances();
+		}
 	}
 
 	//render SDFGI
@@ -3092,6 +3183,7 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 
 	for (uint32_t i = 0; i < max_shadows_used; i++) {
 		render_shadow_data[i].instances.clear();
+		render_shadow_data[i].static_instances.clear();
 	}
 	max_shadows_used = 0;
 
@@ -3249,14 +3341,17 @@ void RendererSceneCull::render_probes() {
 				busy = true; //do not render another one of this kind
 			} break;
 			case RS::REFLECTION_PROBE_UPDATE_ALWAYS: {
-				int step = 0;
+				// With a budget below the six faces plus filtering, the probe is updated over several frames and
+				// stays in the list (and keeps its step) until done.
 				bool done = false;
-				while (!done) {
-					done = _render_reflection_probe_step(ref_probe->self()->owner, step);
-					step++;
+				for (int i = 0; i < reflection_probe_always_steps && !done; i++) {
+					done = _render_reflection_probe_step(ref_probe->self()->owner, ref_probe->self()->render_step);
+					ref_probe->self()->render_step++;
 				}
 
-				reflection_probe_render_list.remove(ref_probe);
+				if (done) {
+					reflection_probe_render_list.remove(ref_probe);
+				}
 			} break;
 		}
 
@@ -3731,16 +3826,42 @@ void RendererSceneCull::update_dirty_instances() {
 
 void RendererSceneCull::update() {
 	//optimize bvhs
-	for (uint32_t i = 0; i < scenario_owner.get_rid_count(); i++) {
-		Scenario *s = scenario_owner.get_ptr_by_index(i);
-		s->indexers[Scenario::INDEXER_GEOMETRY].optimize_incremental(indexer_update_iterations);
-		s->indexers[Scenario::INDEXER_VOLUMES].optimize_incremental(indexer_update_iterations);
-	}
+	scenario_owner.for_each_owned([this](Scenario *p_scenario) {
+		p_scenario->indexers[Scenario::INDEXER_GEOMETRY].optimize_incremental(indexer_update_iterations);
+		p_scenario->indexers[Scenario::INDEXER_VOLUMES].optimize_incremental(indexer_update_iterations);
+	});
 	scene_render->update();
 	update_dirty_instances();
 	render_particle_colliders();
 }
 
+void RendererSceneCull::tick() {
+	// The transforms set since the last tick become the ones to interpolate from.
+	for (SelfList<Instance> *E = interpolated_instances.first(); E; E = E->next()) {
+		Instance *instance = E->self();
+		instance->transform_prev = instance->transform_curr;
+	}
+	for (SelfList<Camera> *E = interpolated_cameras.first(); E; E = E->next()) {
+		Camera *camera = E->self();
+		camera->transform_prev = camera->transform_curr;
+	}
+}
+
+void RendererSceneCull::set_physics_interpolation_fraction(float p_fraction) {
+	for (SelfList<Instance> *E = interpolated_instances.first(); E; E = E->next()) {
+		Instance *instance = E->self();
+		if (instance->transform_prev == instance->transform_curr) {
+			_instance_apply_transform(instance, instance->transform_curr); // Not moving, most of them.
+		} else {
+			_instance_apply_transform(instance, instance->transform_prev.interpolate_with(instance->transform_curr, p_fraction));
+		}
+	}
+	for (SelfList<Camera> *E = interpolated_cameras.first(); E; E = E->next()) {
+		Camera *camera = E->self();
+		_camera_apply_transform(camera, camera->transform_prev.interpolate_with(camera->transform_curr, p_fraction));
+	}
+}
+
 bool RendererSceneCull::free(RID p_rid) {
 	if (scene_render->free(p_rid)) {
 		return true;
@@ -3837,10 +3958,10 @@ RendererSceneCull::RendererSceneCull() {
 	singleton = this;
 
 	instance_cull_result.set_page_pool(&instance_cull_page_pool);
-	instance_shadow_cull_result.set_page_pool(&instance_cull_page_pool);
 
 	for (uint32_t i = 0; i < MAX_UPDATE_SHADOWS; i++) {
 		render_shadow_data[i].instances.set_page_pool(&geometry_instance_cull_page_pool);
+		render_shadow_data[i].static_instances.set_page_pool(&geometry_instance_cull_page_pool);
 	}
 	for (uint32_t i = 0; i < SDFGI_MAX_CASCADES * SDFGI_MAX_REGIONS_PER_CASCADE; i++) {
 		render_sdfgi_data[i].instances.set_page_pool(&geometry_instance_cull_page_pool);
@@ -3854,6 +3975,8 @@ RendererSceneCull::RendererSceneCull() {
 
 	indexer_update_iterations = GLOBAL_GET("rendering/limits/spatial_indexer/update_iterations_per_frame");
 	thread_cull_threshold = GLOBAL_GET("rendering/limits/spatial_indexer/threaded_cull_minimum_instances");
+	shadow_static_cache = GLOBAL_GET("rendering/shadows/shadow_atlas/static_cache");
+	reflection_probe_always_steps = MAX(1, int(GLOBAL_GET("rendering/reflections/reflection_probes/update_always_steps_per_frame")));
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)RendererThreadPool::singleton->thread_work_pool.get_thread_count()); //make sure there is at least one thread per CPU
 
 	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
@@ -3861,10 +3984,10 @@ RendererSceneCull::RendererSceneCull() {
 
 RendererSceneCull::~RendererSceneCull() {
 	instance_cull_result.reset();
-	instance_shadow_cull_result.reset();
 
 	for (uint32_t i = 0; i < MAX_UPDATE_SHADOWS; i++) {
 		render_shadow_data[i].instances.reset();
+		render_shadow_data[i].static_instances.reset();
 	}
 	for (uint32_t i = 0; i < SDFGI_MAX_CASCADES * SDFGI_MAX_REGIONS_PER_CASCADE; i++) {
 		render_sdfgi_data[i].instances.reset();
@@ -85,7 +85,15 @@ public:
 
 		Transform3D transform;
 
-		Camera() {
+		// Physics interpolation, transform is set between the last two physics ticks when drawing.
+		bool interpolated = false;
+		bool interpolation_reset = false;
+		Transform3D transform_prev;
+		Transform3D transform_curr;
+		SelfList<Camera> interpolated_item;
+
+		Camera() :
+				interpolated_item(this) {
 			visible_layers = 0xFFFFFFFF;
 			fov = 75;
 			type = PERSPECTIVE;
@@ -98,6 +106,9 @@ public:
 	};
 
 	mutable RID_Owner<Camera, true> camera_owner;
+	SelfList<Camera>::List interpolated_cameras;
+
+	void _camera_apply_transform(Camera *p_camera, const Transform3D &p_transform);
 
 	virtual RID camera_allocate();
 	virtual void camera_initialize(RID p_rid);
@@ -110,6 +121,8 @@ public:
 	virtual void camera_set_environment(RID p_camera, RID p_env);
 	virtual void camera_set_camera_effects(RID p_camera, RID p_fx);
 	virtual void camera_set_use_vertical_aspect(RID p_camera, bool p_enable);
+	virtual void camera_set_interpolated(RID p_camera, bool p_interpolated);
+	virtual void camera_reset_physics_interpolation(RID p_camera);
 	virtual bool is_camera(RID p_camera) const;
 
 	/* OCCLUDER API */
@@ -391,6 +404,12 @@ public:
 
 		Transform3D transform;
 
+		// Physics interpolation, transform is set between the last two physics ticks when drawing.
+		bool interpolated = false;
+		bool interpolation_reset = false;
+		Transform3D transform_prev;
+		Transform3D transform_curr;
+
 		float lod_bias;
 
 		bool ignore_occlusion_culling;
@@ -449,6 +468,7 @@ public:
 		bool update_dependencies;
 
 		SelfList<Instance> update_item;
+		SelfList<Instance> interpolated_item; // In the physics interpolation list.
 
 		AABB *custom_aabb; // <Zylann> would using aabb directly with a bool be better?
 		float extra_margin;
@@ -459,6 +479,7 @@ public:
 		uint64_t last_frame_pass;
 
 		uint64_t version; // changes to this, and changes to base increase version
+		uint64_t last_update_frame; // frame of the last change, used to tell static shadow casters apart
 
 		InstanceBaseData *base_data;
 
@@ -515,7 +536,8 @@ public:
 
 		Instance() :
 				scenario_item(this),
-				update_item(this) {
+				update_item(this),
+				interpolated_item(this) {
 			base_type = RS::INSTANCE_NONE;
 			cast_shadows = RS::SHADOW_CASTING_SETTING_ON;
 			receive_shadows = true;
@@ -546,6 +568,7 @@ public:
 
 			last_frame_pass = 0;
 			version = 1;
+			last_update_frame = 0;
 			base_data = nullptr;
 
 			custom_aabb = nullptr;
@@ -569,6 +592,7 @@ public:
 	};
 
 	SelfList<Instance>::List _instance_update_list;
+	SelfList<Instance>::List interpolated_instances;
 	void _instance_queue_update(Instance *p_instance, bool p_update_aabb, bool p_update_dependencies = false);
 
 	struct InstanceGeometryData : public InstanceBaseData {
@@ -777,7 +801,6 @@ public:
 	PagedArrayPool<RID> rid_cull_page_pool;
 
 	PagedArray<Instance *> instance_cull_result;
-	PagedArray<Instance *> instance_shadow_cull_result;
 
 	struct InstanceCullResult {
 		PagedArray<RendererSceneRender::GeometryInstance *> geometry_instances;
@@ -900,6 +923,28 @@ public:
 	RendererSceneRender::RenderShadowData render_shadow_data[MAX_UPDATE_SHADOWS];
 	uint32_t max_shadows_used = 0;
 
+	// One per positional shadow pass that needs redrawing, culled in parallel.
+	struct ShadowCullJob {
+		InstanceLightData *light = nullptr;
+		Scenario *scenario = nullptr;
+		uint32_t shadow_index = 0;
+		Vector<Plane> planes;
+		uint64_t light_version = 0;
+		bool static_cache = false; // Split out the casters that can be cached, see RenderShadowData::static_instances.
+		bool animated_material_found = false;
+		LocalVector<Instance *> mesh_instances; // Updated afterwards, mesh_instance_check_for_update() is not thread safe.
+	};
+
+	LocalVector<ShadowCullJob> shadow_cull_jobs;
+
+	enum {
+		SHADOW_STATIC_CASTER_FRAMES = 60 // Frames without changes before a caster is cached with the static shadow.
+	};
+
+	bool shadow_static_cache = false;
+
+	int reflection_probe_always_steps = 7; // Cubemap faces or filtering passes done per frame for each UPDATE_ALWAYS probe.
+
 	RendererSceneRender::RenderSDFGIData render_sdfgi_data[SDFGI_MAX_CASCADES * SDFGI_MAX_REGIONS_PER_CASCADE];
 	RendererSceneRender::RenderSDFGIUpdateData sdfgi_update_data;
 
@@ -915,11 +960,16 @@ public:
 	virtual void instance_set_base(RID p_instance, RID p_base);
 	virtual void instance_set_scenario(RID p_instance, RID p_scenario);
 	virtual void instance_set_layer_mask(RID p_instance, uint32_t p_mask);
+	void _instance_apply_transform(Instance *p_instance, const Transform3D &p_transform);
+	void _instance_set_transform(Instance *p_instance, const Transform3D &p_transform);
 	virtual void instance_set_transform(RID p_instance, const Transform3D &p_transform);
+	virtual void instance_set_transforms(const Vector<RID> &p_instances, const Vector<Transform3D> &p_transforms);
 	virtual void instance_attach_object_instance_id(RID p_instance, ObjectID p_id);
 	virtual void instance_set_blend_shape_weight(RID p_instance, int p_shape, float p_weight);
 	virtual void instance_set_surface_override_material(RID p_instance, int p_surface, RID p_material);
 	virtual void instance_set_visible(RID p_instance, bool p_visible);
+	virtual void instance_set_interpolated(RID p_instance, bool p_interpolated);
+	virtual void instance_reset_physics_interpolation(RID p_instance);
 
 	virtual void instance_set_custom_aabb(RID p_instance, AABB p_aabb);
 
@@ -962,6 +1012,8 @@ public:
 	void _light_instance_setup_directional_shadow(int p_shadow_index, Instance *p_instance, const Transform3D p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect);
 
 	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_scren_lod_threshold);
+	void _light_instance_add_shadow_cull(Instance *p_instance, const Vector<Plane> &p_planes, uint32_t p_pass, Scenario *p_scenario);
+	void _light_shadow_cull_threaded(uint32_t p_job, ShadowCullJob *p_jobs);
 
 	RID _render_get_environment(RID p_camera, RID p_scenario);
 
@@ -1148,6 +1200,9 @@ public:
 
 	virtual void update();
 
+	virtual void tick();
+	virtual void set_physics_interpolation_fraction(float p_fraction);
+
 	bool free(RID p_rid);
 
 	void set_scene_render(RendererSceneRender *p_scene_render);
@@ -202,6 +202,9 @@ public:
 		RID light;
 		int pass = 0;
 		PagedArray<GeometryInstance *> instances;
+		// Casters that can be cached in the shadow atlas, drawn before the regular instances.
+		PagedArray<GeometryInstance *> static_instances;
+		uint64_t static_version = 0; // Changes when static_instances do, zero disables caching.
 	};
 
 	struct RenderSDFGIData {
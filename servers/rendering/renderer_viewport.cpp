@@ -31,6 +31,7 @@
 #include "renderer_viewport.h"
 
 #include "core/config/project_settings.h"
+#include "core/debugger/trace_zones.h"
 #include "renderer_canvas_cull.h"
 #include "renderer_scene_cull.h"
 #include "rendering_server_globals.h"
@@ -82,6 +83,8 @@ void RendererViewport::_configure_3d_render_buffers(Viewport *p_viewport) {
 				// Ignore the 3D viewport render scaling inside of the editor.
 				// The Half Resolution 3D editor viewport option should be used instead.
 				scale_3d = 1.0;
+			} else if (p_viewport->dynamic_resolution) {
+				scale_3d *= p_viewport->dynamic_resolution_scale;
 			}
 
 			// Clamp 3D rendering resolution to reasonable values supported on most hardware.
@@ -93,6 +96,54 @@ void RendererViewport::_configure_3d_render_buffers(Viewport *p_viewport) {
 	}
 }
 
+void RendererViewport::_update_dynamic_resolution(Viewport *p_viewport) {
+	if (!p_viewport->dynamic_resolution || Engine::get_singleton()->is_editor_hint()) {
+		return;
+	}
+
+	// Only react to timestamps we haven't seen yet, they arrive a few frames late.
+	if (p_viewport->time_gpu_end <= p_viewport->time_gpu_begin || p_viewport->time_gpu_end == p_viewport->dynamic_resolution_last_sample) {
+		return;
+	}
+	p_viewport->dynamic_resolution_last_sample = p_viewport->time_gpu_end;
+
+	if (draw_viewports_pass < p_viewport->dynamic_resolution_next_pass) {
+		// Still measuring frames rendered at the previous resolution.
+		return;
+	}
+
+	const float gpu_msec = double(p_viewport->time_gpu_end - p_viewport->time_gpu_begin) / 1000000.0;
+	if (p_viewport->dynamic_resolution_avg_msec == 0.0) {
+		p_viewport->dynamic_resolution_avg_msec = gpu_msec;
+	} else {
+		p_viewport->dynamic_resolution_avg_msec = Math::lerp(p_viewport->dynamic_resolution_avg_msec, gpu_msec, 0.1f);
+	}
+
+	const float target = p_viewport->dynamic_resolution_target_msec;
+	const float avg = MAX(p_viewport->dynamic_resolution_avg_msec, 0.001f);
+	const float scale = p_viewport->dynamic_resolution_scale;
+
+	// Keep some headroom below the target so the scale doesn't oscillate around it.
+	if (avg <= target && (avg >= target * 0.85 || scale >= 1.0)) {
+		return;
+	}
+
+	// GPU time grows roughly with the pixel count, so with the square of the scale.
+	// Drop quickly when over budget, recover slowly.
+	float new_scale = scale * Math::sqrt(target * 0.925 / avg);
+	new_scale = CLAMP(new_scale, scale - 0.25, scale + 0.05);
+	new_scale = CLAMP(Math::snapped(new_scale, 0.05), p_viewport->dynamic_resolution_min_scale, 1.0);
+
+	if (Math::is_equal_approx(new_scale, scale)) {
+		return;
+	}
+
+	p_viewport->dynamic_resolution_scale = new_scale;
+	p_viewport->dynamic_resolution_avg_msec = 0.0;
+	p_viewport->dynamic_resolution_next_pass = draw_viewports_pass + 8;
+	_configure_3d_render_buffers(p_viewport);
+}
+
 void RendererViewport::_draw_3d(Viewport *p_viewport) {
 	RENDER_TIMESTAMP(">Begin Rendering 3D Scene");
 
@@ -123,7 +174,7 @@ void RendererViewport::_draw_3d(Viewport *p_viewport) {
 }
 
 void RendererViewport::_draw_viewport(Viewport *p_viewport) {
-	if (p_viewport->measure_render_time) {
+	if (p_viewport->measure_render_time || p_viewport->dynamic_resolution) {
 		String rt_id = "vp_begin_" + itos(p_viewport->self.get_id());
 		RSG::storage->capture_timestamp(rt_id);
 		timestamp_vp_map[rt_id] = p_viewport->self;
@@ -219,8 +270,6 @@ void RendererViewport::_draw_viewport(Viewport *p_viewport) {
 			RSG::storage->render_target_mark_sdf_enabled(p_viewport->render_target, false);
 		}
 
-		Rect2 shadow_rect;
-
 		int light_count = 0;
 		int shadow_count = 0;
 		int directional_light_count = 0;
@@ -255,11 +304,6 @@ void RendererViewport::_draw_viewport(Viewport *p_viewport) {
 						//cl->light_shader_pos = cl->xform_cache[2];
 						if (cl->use_shadow) {
 							cl->shadows_next_ptr = lights_with_shadow;
-							if (lights_with_shadow == nullptr) {
-								shadow_rect = cl->xform_cache.xform(cl->rect_cache);
-							} else {
-								shadow_rect = shadow_rect.merge(cl->xform_cache.xform(cl->rect_cache));
-							}
 							lights_with_shadow = cl;
 							cl->radius_cache = cl->rect_cache.size.length();
 						}
@@ -297,31 +341,42 @@ void RendererViewport::_draw_viewport(Viewport *p_viewport) {
 		if (lights_with_shadow) {
 			//update shadows if any
 
-			RendererCanvasRender::LightOccluderInstance *occluders = nullptr;
-
 			RENDER_TIMESTAMP(">Render 2D Shadows");
-			RENDER_TIMESTAMP("Cull Occluders");
 
-			//make list of occluders
 			for (KeyValue<RID, Viewport::CanvasData> &E : p_viewport->canvas_map) {
 				RendererCanvasCull::Canvas *canvas = static_cast<RendererCanvasCull::Canvas *>(E.value.canvas);
-				Transform2D xf = _canvas_get_transform(p_viewport, canvas, &E.value, clip_rect.size);
-
-				for (Set<RendererCanvasRender::LightOccluderInstance *>::Element *F = canvas->occluders.front(); F; F = F->next()) {
-					if (!F->get()->enabled) {
-						continue;
-					}
-					F->get()->xform_cache = xf * F->get()->xform;
-					if (shadow_rect.intersects_transformed(F->get()->xform_cache, F->get()->aabb_cache)) {
-						F->get()->next = occluders;
-						occluders = F->get();
-					}
-				}
+				canvas->occluder_bvh.update();
 			}
-			//update the light shadowmaps with them
+
+			//update the light shadowmaps, each with the occluders around it
 
 			RendererCanvasRender::Light *light = lights_with_shadow;
 			while (light) {
+				RENDER_TIMESTAMP("Cull Occluders");
+
+				Rect2 light_rect = light->xform_cache.xform(light->rect_cache);
+				RendererCanvasRender::LightOccluderInstance *occluders = nullptr;
+
+				for (KeyValue<RID, Viewport::CanvasData> &E : p_viewport->canvas_map) {
+					RendererCanvasCull::Canvas *canvas = static_cast<RendererCanvasCull::Canvas *>(E.value.canvas);
+					Transform2D xf = _canvas_get_transform(p_viewport, canvas, &E.value, clip_rect.size);
+
+					occluder_cull_result.resize(canvas->occluders.size());
+					int occluder_count = canvas->occluder_bvh.cull_aabb(xf.affine_inverse().xform(light_rect), occluder_cull_result.ptr(), occluder_cull_result.size());
+
+					for (int j = 0; j < occluder_count; j++) {
+						RendererCanvasRender::LightOccluderInstance *occluder = occluder_cull_result[j];
+						if (!occluder->enabled) {
+							continue;
+						}
+						occluder->xform_cache = xf * occluder->xform;
+						if (light_rect.intersects_transformed(occluder->xform_cache, occluder->aabb_cache)) {
+							occluder->next = occluders;
+							occluders = occluder;
+						}
+					}
+				}
+
 				RENDER_TIMESTAMP("Render Shadow");
 
 				RSG::canvas_render->light_update_shadow(light->light_internal, shadow_count++, light->xform_cache.affine_inverse(), light->item_shadow_mask, light->radius_cache / 1000.0, light->radius_cache * 1.1, occluders);
@@ -480,7 +535,7 @@ void RendererViewport::_draw_viewport(Viewport *p_viewport) {
 		RSG::storage->render_target_do_clear_request(p_viewport->render_target);
 	}
 
-	if (p_viewport->measure_render_time) {
+	if (p_viewport->measure_render_time || p_viewport->dynamic_resolution) {
 		String rt_id = "vp_end_" + itos(p_viewport->self.get_id());
 		RSG::storage->capture_timestamp(rt_id);
 		timestamp_vp_map[rt_id] = p_viewport->self;
@@ -488,6 +543,8 @@ void RendererViewport::_draw_viewport(Viewport *p_viewport) {
 }
 
 void RendererViewport::draw_viewports() {
+	TRACE_ZONE("RendererViewport::draw_viewports");
+
 	timestamp_vp_map.clear();
 
 	// get our xr interface in case we need it
@@ -561,6 +618,8 @@ void RendererViewport::draw_viewports() {
 
 		RENDER_TIMESTAMP(">Rendering Viewport " + itos(i));
 
+		_update_dynamic_resolution(vp);
+
 		RSG::storage->render_target_set_as_unused(vp->render_target);
 		if (vp->use_xr && xr_interface.is_valid()) {
 			// override our size, make sure it matches our required size and is created as a stereo target
@@ -575,6 +634,9 @@ void RendererViewport::draw_viewports() {
 			// render...
 			RSG::scene->set_debug_draw_mode(vp->debug_draw);
 
+			// latch our tracking data as late as possible, our views get their transforms while drawing
+			XRServer::get_singleton()->_pre_render();
+
 			// and draw viewport
 			_draw_viewport(vp);
 
@@ -686,6 +748,36 @@ void RendererViewport::viewport_set_scale_3d(RID p_viewport, float p_scale_3d) {
 	_configure_3d_render_buffers(viewport);
 }
 
+void RendererViewport::viewport_set_dynamic_resolution(RID p_viewport, bool p_enabled, float p_target_frame_time_msec, float p_min_scale) {
+	Viewport *viewport = viewport_owner.get_or_null(p_viewport);
+	ERR_FAIL_COND(!viewport);
+	ERR_FAIL_COND(p_target_frame_time_msec <= 0.0);
+
+	viewport->dynamic_resolution_target_msec = p_target_frame_time_msec;
+	viewport->dynamic_resolution_min_scale = CLAMP(p_min_scale, 0.1, 1.0);
+
+	if (viewport->dynamic_resolution == p_enabled) {
+		if (p_enabled && viewport->dynamic_resolution_scale < viewport->dynamic_resolution_min_scale) {
+			viewport->dynamic_resolution_scale = viewport->dynamic_resolution_min_scale;
+			_configure_3d_render_buffers(viewport);
+		}
+		return;
+	}
+
+	viewport->dynamic_resolution = p_enabled;
+	viewport->dynamic_resolution_scale = 1.0;
+	viewport->dynamic_resolution_avg_msec = 0.0;
+	viewport->dynamic_resolution_next_pass = 0;
+	_configure_3d_render_buffers(viewport);
+}
+
+float RendererViewport::viewport_get_dynamic_resolution_scale(RID p_viewport) const {
+	Viewport *viewport = viewport_owner.get_or_null(p_viewport);
+	ERR_FAIL_COND_V(!viewport, 1.0);
+
+	return viewport->dynamic_resolution ? viewport->dynamic_resolution_scale : 1.0;
+}
+
 uint32_t RendererViewport::Viewport::get_view_count() {
 	uint32_t view_count = 1;
 
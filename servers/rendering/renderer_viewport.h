@@ -51,6 +51,15 @@ public:
 
 		float scale_3d = 1.0;
 
+		// Dynamic resolution: the 3D render scale is adjusted on top of scale_3d to keep the measured GPU time under the target.
+		bool dynamic_resolution = false;
+		float dynamic_resolution_target_msec = 16.6;
+		float dynamic_resolution_min_scale = 0.5;
+		float dynamic_resolution_scale = 1.0;
+		float dynamic_resolution_avg_msec = 0.0;
+		uint64_t dynamic_resolution_last_sample = 0;
+		uint64_t dynamic_resolution_next_pass = 0;
+
 		Size2i size;
 		RID camera;
 		RID scenario;
@@ -195,6 +204,7 @@ public:
 
 private:
 	void _configure_3d_render_buffers(Viewport *p_viewport);
+	void _update_dynamic_resolution(Viewport *p_viewport);
 	void _draw_3d(Viewport *p_viewport);
 	void _draw_viewport(Viewport *p_viewport);
 
@@ -202,12 +212,16 @@ private:
 
 	void _resize_occlusion_culling_buffer(const Size2i &p_size);
 
+	LocalVector<RendererCanvasRender::LightOccluderInstance *> occluder_cull_result;
+
 public:
 	RID viewport_allocate();
 	void viewport_initialize(RID p_rid);
 
 	void viewport_set_use_xr(RID p_viewport, bool p_use_xr);
 	void viewport_set_scale_3d(RID p_viewport, float p_scale_3d);
+	void viewport_set_dynamic_resolution(RID p_viewport, bool p_enabled, float p_target_frame_time_msec, float p_min_scale);
+	float viewport_get_dynamic_resolution_scale(RID p_viewport) const;
 
 	void viewport_set_size(RID p_viewport, int p_width, int p_height);
 
@@ -32,6 +32,7 @@
 #define RENDERING_DEVICE_H
 
 #include "core/object/class_db.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/typed_array.h"
 #include "servers/display_server.h"
 
@@ -120,6 +121,7 @@ public:
 
 		// features
 		bool supports_multiview = false; // If true this device supports multiview options
+		bool supports_descriptor_indexing = false; // If true texture arrays can be partially bound and indexed non uniformly
 	};
 
 	typedef String (*ShaderSPIRVGetCacheKeyFunction)(const Capabilities *p_capabilities);
@@ -138,6 +140,11 @@ protected:
 
 	Capabilities device_capabilities;
 
+	// Cost counters, incremented by the drivers and never reset.
+	SafeNumeric<uint64_t> shader_create_count;
+	SafeNumeric<uint64_t> pipeline_create_count;
+	SafeNumeric<uint64_t> staging_buffer_flush_count;
+
 public:
 	//base numeric ID for all types
 	enum {
@@ -745,6 +752,26 @@ public:
 	virtual Error buffer_clear(RID p_buffer, uint32_t p_offset, uint32_t p_size, uint32_t p_post_barrier = BARRIER_MASK_ALL) = 0;
 	virtual Vector<uint8_t> buffer_get_data(RID p_buffer) = 0; //this causes stall, only use to retrieve large buffers for saving
 
+	/*************************/
+	/**** ASYNC TRANSFERS ****/
+	/*************************/
+
+	// Uploads that go through their own staging ring and are submitted between frames. Instead of stalling
+	// when staging memory runs out, the calling thread waits for earlier transfers to finish.
+	// The returned ID can be polled or waited on, the resource must not be freed until it completes.
+
+	typedef int64_t TransferID;
+
+	virtual TransferID buffer_update_async(RID p_buffer, uint32_t p_offset, uint32_t p_size, const void *p_data) = 0;
+	virtual TransferID texture_update_async(RID p_texture, uint32_t p_layer, const Vector<uint8_t> &p_data) = 0;
+	virtual bool transfer_is_complete(TransferID p_transfer) = 0;
+	virtual void transfer_wait(TransferID p_transfer) = 0;
+
+	// Readbacks are copied at the end of the current frame and handed to the callback (deferred, as a
+	// PackedByteArray) once that frame is cycled, so they never stall the GPU like buffer_get_data().
+	virtual Error buffer_get_data_async(RID p_buffer, const Callable &p_callback) = 0;
+	virtual Error texture_get_data_async(RID p_texture, uint32_t p_layer, const Callable &p_callback) = 0;
+
 	/******************************************/
 	/**** PIPELINE SPECIALIZATION CONSTANT ****/
 	/******************************************/
@@ -1078,7 +1105,9 @@ public:
 	virtual void draw_list_set_line_width(DrawListID p_list, float p_width) = 0;
 	virtual void draw_list_set_push_constant(DrawListID p_list, const void *p_data, uint32_t p_data_size) = 0;
 
-	virtual void draw_list_draw(DrawListID p_list, bool p_use_indices, uint32_t p_instances = 1, uint32_t p_procedural_vertices = 0) = 0;
+	virtual void draw_list_draw(DrawListID p_list, bool p_use_indices, uint32_t p_instances = 1, uint32_t p_procedural_vertices = 0, uint32_t p_first_instance = 0) = 0;
+	// Draw parameters are read from p_buffer (a storage buffer created with STORAGE_BUFFER_USAGE_DISPATCH_INDIRECT), so they can be written by compute.
+	virtual void draw_list_draw_indirect(DrawListID p_list, bool p_use_indices, RID p_buffer, uint32_t p_offset = 0, uint32_t p_draw_count = 1, uint32_t p_stride = 0) = 0;
 
 	virtual void draw_list_enable_scissor(DrawListID p_list, const Rect2 &p_rect) = 0;
 	virtual void draw_list_disable_scissor(DrawListID p_list) = 0;
@@ -1166,6 +1195,7 @@ public:
 		LIMIT_MAX_COMPUTE_WORKGROUP_SIZE_X,
 		LIMIT_MAX_COMPUTE_WORKGROUP_SIZE_Y,
 		LIMIT_MAX_COMPUTE_WORKGROUP_SIZE_Z,
+		LIMIT_MAX_BINDLESS_TEXTURES,
 	};
 
 	virtual int limit_get(Limit p_limit) = 0;
@@ -1188,6 +1218,12 @@ public:
 
 	virtual uint64_t get_memory_usage(MemoryType p_type) const = 0;
 
+	uint64_t get_shader_create_count() const { return shader_create_count.get(); }
+	// Pipelines not found in any cache, so compiled by the driver.
+	uint64_t get_pipeline_create_count() const { return pipeline_create_count.get(); }
+	// Times the staging buffer ran out of space and had to wait for the GPU.
+	uint64_t get_staging_buffer_flush_count() const { return staging_buffer_flush_count.get(); }
+
 	virtual RenderingDevice *create_local_device() = 0;
 
 	virtual void set_resource_name(RID p_id, const String p_name) = 0;
@@ -1200,6 +1236,13 @@ public:
 	virtual String get_device_name() const = 0;
 	virtual String get_device_pipeline_cache_uuid() const = 0;
 
+	// Time the last frame spent blocked waiting for the GPU and presentation engine.
+	virtual uint64_t get_present_wait_time_usec() const = 0;
+	// Refresh cycle reported by the presentation engine for the main window, 0 if unknown.
+	virtual uint64_t get_refresh_cycle_duration_usec() const = 0;
+	// Loads the driver pipeline cache from this file, and saves it there when the device is finalized.
+	virtual void set_pipeline_cache_path(const String &p_path) = 0;
+
 	virtual uint64_t get_driver_resource(DriverResource p_resource, RID p_rid = RID(), uint64_t p_index = 0) = 0;
 
 	static RenderingDevice *get_singleton();
@@ -1226,6 +1269,7 @@ protected:
 	RID _uniform_set_create(const Array &p_uniforms, RID p_shader, uint32_t p_shader_set);
 
 	Error _buffer_update(RID p_buffer, uint32_t p_offset, uint32_t p_size, const Vector<uint8_t> &p_data, uint32_t p_post_barrier = BARRIER_MASK_ALL);
+	TransferID _buffer_update_async(RID p_buffer, uint32_t p_offset, uint32_t p_size, const Vector<uint8_t> &p_data);
 
 	RID _render_pipeline_create(RID p_shader, FramebufferFormatID p_framebuffer_format, VertexFormatID p_vertex_format, RenderPrimitive p_render_primitive, const Ref<RDPipelineRasterizationState> &p_rasterization_state, const Ref<RDPipelineMultisampleState> &p_multisample_state, const Ref<RDPipelineDepthStencilState> &p_depth_stencil_state, const Ref<RDPipelineColorBlendState> &p_blend_state, int p_dynamic_state_flags, uint32_t p_for_render_pass, const TypedArray<RDPipelineSpecializationConstant> &p_specialization_constants);
 	RID _compute_pipeline_create(RID p_shader, const TypedArray<RDPipelineSpecializationConstant> &p_specialization_constants);
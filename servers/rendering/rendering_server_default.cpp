@@ -31,6 +31,7 @@
 #include "rendering_server_default.h"
 
 #include "core/config/project_settings.h"
+#include "core/debugger/trace_zones.h"
 #include "core/io/marshalls.h"
 #include "core/os/os.h"
 #include "core/templates/sort_array.h"
@@ -75,6 +76,9 @@ void RenderingServerDefault::request_frame_drawn_callback(Object *p_where, const
 }
 
 void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step) {
+	Memory::TagScope memory_tag(Memory::TAG_RENDERING);
+	TRACE_ZONE("RenderingServer::draw");
+
 	//needs to be done before changes is reset to 0, to not force the editor to redraw
 	RS::get_singleton()->emit_signal(SNAME("frame_pre_draw"));
 
@@ -343,6 +347,8 @@ void RenderingServerDefault::_thread_callback(void *_instance) {
 }
 
 void RenderingServerDefault::_thread_loop() {
+	Memory::TagScope memory_tag(Memory::TAG_RENDERING);
+
 	server_thread = Thread::get_caller_id();
 
 	DisplayServer::get_singleton()->make_rendering_thread();
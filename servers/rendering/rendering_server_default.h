@@ -213,6 +213,7 @@ public:
 	FUNC3(texture_set_detect_3d_callback, RID, TextureDetectCallback, void *)
 	FUNC3(texture_set_detect_normal_callback, RID, TextureDetectCallback, void *)
 	FUNC3(texture_set_detect_roughness_callback, RID, TextureDetectRoughnessCallback, void *)
+	FUNC3(texture_set_stream_callback, RID, TextureStreamCallback, void *)
 
 	FUNC2(texture_set_path, RID, const String &)
 	FUNC1RC(String, texture_get_path, RID)
@@ -324,6 +325,7 @@ public:
 	FUNC2RC(Color, multimesh_instance_get_custom_data, RID, int)
 
 	FUNC2(multimesh_set_buffer, RID, const Vector<float> &)
+	FUNC3(multimesh_set_buffer_range, RID, int, const Vector<float> &)
 	FUNC1RC(Vector<float>, multimesh_get_buffer, RID)
 
 	FUNC2(multimesh_set_visible_instances, RID, int)
@@ -338,6 +340,7 @@ public:
 	FUNC2RC(Transform3D, skeleton_bone_get_transform, RID, int)
 	FUNC3(skeleton_bone_set_transform_2d, RID, int, const Transform2D &)
 	FUNC2RC(Transform2D, skeleton_bone_get_transform_2d, RID, int)
+	FUNC2(skeleton_set_bone_transforms, RID, const Vector<float> &)
 	FUNC2(skeleton_set_base_transform_2d, RID, const Transform2D &)
 
 	/* Light API */
@@ -510,6 +513,8 @@ public:
 	FUNC2(camera_set_environment, RID, RID)
 	FUNC2(camera_set_camera_effects, RID, RID)
 	FUNC2(camera_set_use_vertical_aspect, RID, bool)
+	FUNC2(camera_set_interpolated, RID, bool)
+	FUNC1(camera_reset_physics_interpolation, RID)
 
 	/* OCCLUDER */
 	FUNCRIDSPLIT(occluder)
@@ -527,6 +532,8 @@ public:
 
 	FUNC2(viewport_set_use_xr, RID, bool)
 	FUNC2(viewport_set_scale_3d, RID, float)
+	FUNC4(viewport_set_dynamic_resolution, RID, bool, float, float)
+	FUNC1RC(float, viewport_get_dynamic_resolution_scale, RID)
 	FUNC3(viewport_set_size, RID, int, int)
 
 	FUNC2(viewport_set_active, RID, bool)
@@ -681,10 +688,13 @@ public:
 	FUNC2(instance_set_scenario, RID, RID)
 	FUNC2(instance_set_layer_mask, RID, uint32_t)
 	FUNC2(instance_set_transform, RID, const Transform3D &)
+	FUNC2(instance_set_transforms, const Vector<RID> &, const Vector<Transform3D> &)
 	FUNC2(instance_attach_object_instance_id, RID, ObjectID)
 	FUNC3(instance_set_blend_shape_weight, RID, int, float)
 	FUNC3(instance_set_surface_override_material, RID, int, RID)
 	FUNC2(instance_set_visible, RID, bool)
+	FUNC2(instance_set_interpolated, RID, bool)
+	FUNC1(instance_reset_physics_interpolation, RID)
 
 	FUNC2(instance_set_custom_aabb, RID, AABB)
 
@@ -715,6 +725,11 @@ public:
 
 	FUNC1(gi_set_use_half_resolution, bool)
 
+	/* PHYSICS INTERPOLATION */
+
+	FUNC0(tick)
+	FUNC1(set_physics_interpolation_fraction, float)
+
 #undef server_name
 #undef ServerName
 //from now on, calls forwarded to this singleton
@@ -31,6 +31,7 @@
 #include "rendering_server.h"
 
 #include "core/config/project_settings.h"
+#include "core/io/json.h"
 #include "servers/rendering/rendering_server_globals.h"
 RenderingServer *RenderingServer::singleton = nullptr;
 RenderingServer *(*RenderingServer::create_func)() = nullptr;
@@ -67,6 +68,107 @@ Array RenderingServer::_texture_debug_usage_bind() {
 	return arr;
 }
 
+// Turns the flat list of captured timestamps into one entry per pass.
+// ">Name" and "<Name" delimit a scope, any other timestamp lasts until the next one.
+Array RenderingServer::_get_frame_profile_bind() {
+	Vector<FrameProfileArea> areas = get_frame_profile();
+	Array arr;
+	if (areas.size() == 0) {
+		return arr;
+	}
+
+	LocalVector<int> scopes; // Indices in arr of the scopes that are still open.
+	for (int i = 0; i < areas.size(); i++) {
+		const FrameProfileArea &area = areas[i];
+		bool begin = area.name.begins_with(">");
+		bool end = area.name.begins_with("<");
+
+		if (end) {
+			if (scopes.size()) {
+				Dictionary dict = arr[scopes[scopes.size() - 1]];
+				dict["cpu_msec"] = area.cpu_msec - double(dict["cpu_begin_msec"]);
+				dict["gpu_msec"] = area.gpu_msec - double(dict["gpu_begin_msec"]);
+				scopes.resize(scopes.size() - 1);
+			}
+			continue;
+		}
+
+		Dictionary dict;
+		dict["name"] = begin ? area.name.substr(1) : area.name;
+		dict["parent"] = scopes.size() ? Dictionary(arr[scopes[scopes.size() - 1]])["name"] : Variant(String());
+		dict["depth"] = scopes.size();
+		dict["cpu_begin_msec"] = area.cpu_msec;
+		dict["gpu_begin_msec"] = area.gpu_msec;
+		if (begin || i == areas.size() - 1) {
+			// Filled in when the scope closes.
+			dict["cpu_msec"] = 0.0;
+			dict["gpu_msec"] = 0.0;
+		} else {
+			dict["cpu_msec"] = areas[i + 1].cpu_msec - area.cpu_msec;
+			dict["gpu_msec"] = areas[i + 1].gpu_msec - area.gpu_msec;
+		}
+
+		if (begin) {
+			scopes.push_back(arr.size());
+		}
+		arr.push_back(dict);
+	}
+
+	// Close whatever was left open at the last timestamp.
+	const FrameProfileArea &last = areas[areas.size() - 1];
+	for (uint32_t i = 0; i < scopes.size(); i++) {
+		Dictionary dict = arr[scopes[i]];
+		dict["cpu_msec"] = last.cpu_msec - double(dict["cpu_begin_msec"]);
+		dict["gpu_msec"] = last.gpu_msec - double(dict["gpu_begin_msec"]);
+	}
+
+	return arr;
+}
+
+// Chrome trace event format (chrome://tracing, Perfetto), CPU and GPU as separate threads.
+String RenderingServer::get_frame_profile_chrome_trace() {
+	Array passes = _get_frame_profile_bind();
+	uint64_t frame = get_frame_profile_frame();
+
+	Array events;
+	for (int t = 0; t < 2; t++) {
+		Dictionary thread_name;
+		thread_name["name"] = "thread_name";
+		thread_name["ph"] = "M";
+		thread_name["pid"] = 0;
+		thread_name["tid"] = t;
+		Dictionary args;
+		args["name"] = t == 0 ? "CPU" : "GPU";
+		thread_name["args"] = args;
+		events.push_back(thread_name);
+	}
+
+	for (int i = 0; i < passes.size(); i++) {
+		Dictionary pass = passes[i];
+		for (int t = 0; t < 2; t++) {
+			const char *prefix = t == 0 ? "cpu_" : "gpu_";
+			Dictionary event;
+			event["name"] = pass["name"];
+			event["cat"] = "rendering";
+			event["ph"] = "X";
+			event["pid"] = 0;
+			event["tid"] = t;
+			event["ts"] = double(pass[String(prefix) + "begin_msec"]) * 1000.0;
+			event["dur"] = double(pass[String(prefix) + "msec"]) * 1000.0;
+			Dictionary args;
+			args["frame"] = frame;
+			event["args"] = args;
+			events.push_back(event);
+		}
+	}
+
+	Dictionary trace;
+	trace["traceEvents"] = events;
+	trace["displayTimeUnit"] = "ms";
+	JSON json;
+	return json.stringify(trace);
+}
+
 static Array to_array(const Vector<ObjectID> &ids) {
 	Array a;
 	a.resize(ids.size());
@@ -474,10 +576,16 @@ Error RenderingServer::_surface_set_data(Array p_arrays, uint32_t p_format, uint
 
 				const Vector2 *src = array.ptr();
 
-				for (int i = 0; i < p_vertex_array_len; i++) {
-					float uv[2] = { (float)src[i].x, (float)src[i].y };
-
-					memcpy(&aw[p_offsets[ai] + i * p_attrib_stride], uv, 2 * 4);
+				if (p_format & ARRAY_FLAG_COMPRESS_UV) {
+					for (int i = 0; i < p_vertex_array_len; i++) {
+						uint16_t uv[2] = { Math::make_half_float(src[i].x), Math::make_half_float(src[i].y) };
+						memcpy(&aw[p_offsets[ai] + i * p_attrib_stride], uv, 2 * 2);
+					}
+				} else {
+					for (int i = 0; i < p_vertex_array_len; i++) {
+						float uv[2] = { (float)src[i].x, (float)src[i].y };
+						memcpy(&aw[p_offsets[ai] + i * p_attrib_stride], uv, 2 * 4);
+					}
 				}
 
 			} break;
@@ -491,9 +599,16 @@ Error RenderingServer::_surface_set_data(Array p_arrays, uint32_t p_format, uint
 
 				const Vector2 *src = array.ptr();
 
-				for (int i = 0; i < p_vertex_array_len; i++) {
-					float uv[2] = { (float)src[i].x, (float)src[i].y };
-					memcpy(&aw[p_offsets[ai] + i * p_attrib_stride], uv, 2 * 4);
+				if (p_format & ARRAY_FLAG_COMPRESS_UV) {
+					for (int i = 0; i < p_vertex_array_len; i++) {
+						uint16_t uv[2] = { Math::make_half_float(src[i].x), Math::make_half_float(src[i].y) };
+						memcpy(&aw[p_offsets[ai] + i * p_attrib_stride], uv, 2 * 2);
+					}
+				} else {
+					for (int i = 0; i < p_vertex_array_len; i++) {
+						float uv[2] = { (float)src[i].x, (float)src[i].y };
+						memcpy(&aw[p_offsets[ai] + i * p_attrib_stride], uv, 2 * 4);
+					}
 				}
 			} break;
 			case RS::ARRAY_CUSTOM0:
@@ -792,14 +907,9 @@ void RenderingServer::mesh_surface_make_offsets_from_format(uint32_t p_format, i
 			case RS::ARRAY_COLOR: {
 				elem_size = 4;
 			} break;
-			case RS::ARRAY_TEX_UV: {
-				elem_size = 8;
-
-			} break;
-
+			case RS::ARRAY_TEX_UV:
 			case RS::ARRAY_TEX_UV2: {
-				elem_size = 8;
-
+				elem_size = (p_format & ARRAY_FLAG_COMPRESS_UV) ? 4 : 8;
 			} break;
 			case RS::ARRAY_CUSTOM0:
 			case RS::ARRAY_CUSTOM1:
@@ -1172,9 +1282,16 @@ Array RenderingServer::_get_array_from_surface(uint32_t p_format, Vector<uint8_t
 
 				Vector2 *w = arr.ptrw();
 
-				for (int j = 0; j < p_vertex_len; j++) {
-					const float *v = (const float *)&ar[j * attrib_elem_size + offsets[i]];
-					w[j] = Vector2(v[0], v[1]);
+				if (p_format & ARRAY_FLAG_COMPRESS_UV) {
+					for (int j = 0; j < p_vertex_len; j++) {
+						const uint16_t *v = (const uint16_t *)&ar[j * attrib_elem_size + offsets[i]];
+						w[j] = Vector2(Math::half_to_float(v[0]), Math::half_to_float(v[1]));
+					}
+				} else {
+					for (int j = 0; j < p_vertex_len; j++) {
+						const float *v = (const float *)&ar[j * attrib_elem_size + offsets[i]];
+						w[j] = Vector2(v[0], v[1]);
+					}
 				}
 
 				ret[i] = arr;
@@ -1186,9 +1303,16 @@ Array RenderingServer::_get_array_from_surface(uint32_t p_format, Vector<uint8_t
 
 				Vector2 *w = arr.ptrw();
 
-				for (int j = 0; j < p_vertex_len; j++) {
-					const float *v = (const float *)&ar[j * attrib_elem_size + offsets[i]];
-					w[j] = Vector2(v[0], v[1]);
+				if (p_format & ARRAY_FLAG_COMPRESS_UV) {
+					for (int j = 0; j < p_vertex_len; j++) {
+						const uint16_t *v = (const uint16_t *)&ar[j * attrib_elem_size + offsets[i]];
+						w[j] = Vector2(Math::half_to_float(v[0]), Math::half_to_float(v[1]));
+					}
+				} else {
+					for (int j = 0; j < p_vertex_len; j++) {
+						const float *v = (const float *)&ar[j * attrib_elem_size + offsets[i]];
+						w[j] = Vector2(v[0], v[1]);
+					}
 				}
 
 				ret[i] = arr;
@@ -1662,6 +1786,21 @@ void RenderingServer::_particles_set_trail_bind_poses(RID p_particles, const Typ
 	particles_set_trail_bind_poses(p_particles, tbposes);
 }
 
+void RenderingServer::_instance_set_transforms(const TypedArray<RID> &p_instances, const TypedArray<Transform3D> &p_transforms) {
+	ERR_FAIL_COND(p_instances.size() != p_transforms.size());
+	Vector<RID> instances;
+	Vector<Transform3D> transforms;
+	instances.resize(p_instances.size());
+	transforms.resize(p_transforms.size());
+	RID *instancesw = instances.ptrw();
+	Transform3D *transformsw = transforms.ptrw();
+	for (int i = 0; i < p_instances.size(); i++) {
+		instancesw[i] = p_instances[i];
+		transformsw[i] = p_transforms[i];
+	}
+	instance_set_transforms(instances, transforms);
+}
+
 void RenderingServer::_bind_methods() {
 	BIND_CONSTANT(NO_INDEX_ARRAY);
 	BIND_CONSTANT(ARRAY_WEIGHTS_SIZE);
@@ -1824,6 +1963,7 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(ARRAY_FLAG_USE_2D_VERTICES);
 	BIND_ENUM_CONSTANT(ARRAY_FLAG_USE_DYNAMIC_UPDATE);
 	BIND_ENUM_CONSTANT(ARRAY_FLAG_USE_8_BONE_WEIGHTS);
+	BIND_ENUM_CONSTANT(ARRAY_FLAG_COMPRESS_UV);
 
 	BIND_ENUM_CONSTANT(PRIMITIVE_POINTS);
 	BIND_ENUM_CONSTANT(PRIMITIVE_LINES);
@@ -1854,6 +1994,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("multimesh_set_visible_instances", "multimesh", "visible"), &RenderingServer::multimesh_set_visible_instances);
 	ClassDB::bind_method(D_METHOD("multimesh_get_visible_instances", "multimesh"), &RenderingServer::multimesh_get_visible_instances);
 	ClassDB::bind_method(D_METHOD("multimesh_set_buffer", "multimesh", "buffer"), &RenderingServer::multimesh_set_buffer);
+	ClassDB::bind_method(D_METHOD("multimesh_set_buffer_range", "multimesh", "from_instance", "buffer"), &RenderingServer::multimesh_set_buffer_range);
 	ClassDB::bind_method(D_METHOD("multimesh_get_buffer", "multimesh"), &RenderingServer::multimesh_get_buffer);
 
 	BIND_ENUM_CONSTANT(MULTIMESH_TRANSFORM_2D);
@@ -1868,6 +2009,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("skeleton_bone_get_transform", "skeleton", "bone"), &RenderingServer::skeleton_bone_get_transform);
 	ClassDB::bind_method(D_METHOD("skeleton_bone_set_transform_2d", "skeleton", "bone", "transform"), &RenderingServer::skeleton_bone_set_transform_2d);
 	ClassDB::bind_method(D_METHOD("skeleton_bone_get_transform_2d", "skeleton", "bone"), &RenderingServer::skeleton_bone_get_transform_2d);
+	ClassDB::bind_method(D_METHOD("skeleton_set_bone_transforms", "skeleton", "buffer"), &RenderingServer::skeleton_set_bone_transforms);
 	ClassDB::bind_method(D_METHOD("skeleton_set_base_transform_2d", "skeleton", "base_transform"), &RenderingServer::skeleton_set_base_transform_2d);
 
 	/* Light API */
@@ -2147,12 +2289,16 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("camera_set_environment", "camera", "env"), &RenderingServer::camera_set_environment);
 	ClassDB::bind_method(D_METHOD("camera_set_camera_effects", "camera", "effects"), &RenderingServer::camera_set_camera_effects);
 	ClassDB::bind_method(D_METHOD("camera_set_use_vertical_aspect", "camera", "enable"), &RenderingServer::camera_set_use_vertical_aspect);
+	ClassDB::bind_method(D_METHOD("camera_set_interpolated", "camera", "interpolated"), &RenderingServer::camera_set_interpolated);
+	ClassDB::bind_method(D_METHOD("camera_reset_physics_interpolation", "camera"), &RenderingServer::camera_reset_physics_interpolation);
 
 	/* VIEWPORT */
 
 	ClassDB::bind_method(D_METHOD("viewport_create"), &RenderingServer::viewport_create);
 	ClassDB::bind_method(D_METHOD("viewport_set_use_xr", "viewport", "use_xr"), &RenderingServer::viewport_set_use_xr);
 	ClassDB::bind_method(D_METHOD("viewport_set_scale_3d", "viewport", "scale"), &RenderingServer::viewport_set_scale_3d);
+	ClassDB::bind_method(D_METHOD("viewport_set_dynamic_resolution", "viewport", "enabled", "target_frame_time_msec", "min_scale"), &RenderingServer::viewport_set_dynamic_resolution);
+	ClassDB::bind_method(D_METHOD("viewport_get_dynamic_resolution_scale", "viewport"), &RenderingServer::viewport_get_dynamic_resolution_scale);
 	ClassDB::bind_method(D_METHOD("viewport_set_size", "viewport", "width", "height"), &RenderingServer::viewport_set_size);
 	ClassDB::bind_method(D_METHOD("viewport_set_active", "viewport", "active"), &RenderingServer::viewport_set_active);
 	ClassDB::bind_method(D_METHOD("viewport_set_parent_viewport", "viewport", "parent_viewport"), &RenderingServer::viewport_set_parent_viewport);
@@ -2428,10 +2574,13 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("instance_set_scenario", "instance", "scenario"), &RenderingServer::instance_set_scenario);
 	ClassDB::bind_method(D_METHOD("instance_set_layer_mask", "instance", "mask"), &RenderingServer::instance_set_layer_mask);
 	ClassDB::bind_method(D_METHOD("instance_set_transform", "instance", "transform"), &RenderingServer::instance_set_transform);
+	ClassDB::bind_method(D_METHOD("instance_set_transforms", "instances", "transforms"), &RenderingServer::_instance_set_transforms);
 	ClassDB::bind_method(D_METHOD("instance_attach_object_instance_id", "instance", "id"), &RenderingServer::instance_attach_object_instance_id);
 	ClassDB::bind_method(D_METHOD("instance_set_blend_shape_weight", "instance", "shape", "weight"), &RenderingServer::instance_set_blend_shape_weight);
 	ClassDB::bind_method(D_METHOD("instance_set_surface_override_material", "instance", "surface", "material"), &RenderingServer::instance_set_surface_override_material);
 	ClassDB::bind_method(D_METHOD("instance_set_visible", "instance", "visible"), &RenderingServer::instance_set_visible);
+	ClassDB::bind_method(D_METHOD("instance_set_interpolated", "instance", "interpolated"), &RenderingServer::instance_set_interpolated);
+	ClassDB::bind_method(D_METHOD("instance_reset_physics_interpolation", "instance"), &RenderingServer::instance_reset_physics_interpolation);
 
 	ClassDB::bind_method(D_METHOD("instance_set_custom_aabb", "instance", "aabb"), &RenderingServer::instance_set_custom_aabb);
 
@@ -2687,6 +2836,11 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_video_adapter_name"), &RenderingServer::get_video_adapter_name);
 	ClassDB::bind_method(D_METHOD("get_video_adapter_vendor"), &RenderingServer::get_video_adapter_vendor);
 
+	ClassDB::bind_method(D_METHOD("set_frame_profiling_enabled", "enable"), &RenderingServer::set_frame_profiling_enabled);
+	ClassDB::bind_method(D_METHOD("get_frame_profile"), &RenderingServer::_get_frame_profile_bind);
+	ClassDB::bind_method(D_METHOD("get_frame_profile_frame"), &RenderingServer::get_frame_profile_frame);
+	ClassDB::bind_method(D_METHOD("get_frame_profile_chrome_trace"), &RenderingServer::get_frame_profile_chrome_trace);
+
 	ClassDB::bind_method(D_METHOD("make_sphere_mesh", "latitudes", "longitudes", "radius"), &RenderingServer::make_sphere_mesh);
 	ClassDB::bind_method(D_METHOD("get_test_cube"), &RenderingServer::get_test_cube);
 
@@ -2798,6 +2952,8 @@ RenderingServer::RenderingServer() {
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/shadows/directional_shadow/soft_shadow_quality", PropertyInfo(Variant::INT, "rendering/shadows/directional_shadow/soft_shadow_quality", PROPERTY_HINT_ENUM, "Hard (Fastest),Soft Low (Fast),Soft Medium (Average),Soft High (Slow),Soft Ultra (Slowest)"));
 	GLOBAL_DEF("rendering/shadows/directional_shadow/16_bits", true);
 
+	GLOBAL_DEF_RST("rendering/shadows/shadow_atlas/static_cache", false);
+
 	GLOBAL_DEF("rendering/shadows/shadows/soft_shadow_quality", 2);
 	GLOBAL_DEF("rendering/shadows/shadows/soft_shadow_quality.mobile", 0);
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/shadows/shadows/soft_shadow_quality", PropertyInfo(Variant::INT, "rendering/shadows/shadows/soft_shadow_quality", PROPERTY_HINT_ENUM, "Hard (Fastest),Soft Low (Fast),Soft Medium (Average),Soft High (Slow),Soft Ultra (Slowest)"));
@@ -2812,6 +2968,8 @@ RenderingServer::RenderingServer() {
 					PROPERTY_HINT_ENUM, "Forward Clustered (Supports Desktop Only),Forward Mobile (Supports Desktop and Mobile)"));
 	// Already defined in RenderingDeviceVulkan::initialize which runs before this code.
 	// We re-define them here just for doctool's sake. Make sure to keep default values in sync.
+	GLOBAL_DEF("rendering/vulkan/staging_buffer/async_ring_size_mb", 64);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/vulkan/staging_buffer/async_ring_size_mb", PropertyInfo(Variant::INT, "rendering/vulkan/staging_buffer/async_ring_size_mb", PROPERTY_HINT_RANGE, "4,2048,1"));
 	GLOBAL_DEF("rendering/vulkan/staging_buffer/block_size_kb", 256);
 	GLOBAL_DEF("rendering/vulkan/staging_buffer/max_size_mb", 128);
 	GLOBAL_DEF("rendering/vulkan/staging_buffer/texture_upload_region_size_px", 64);
@@ -2823,6 +2981,12 @@ RenderingServer::RenderingServer() {
 					"rendering/3d/viewport/scale",
 					PROPERTY_HINT_RANGE, "0.25,2.0,0.01"));
 
+	GLOBAL_DEF("rendering/3d/multimesh/gpu_culling_min_instances", 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/3d/multimesh/gpu_culling_min_instances", PropertyInfo(Variant::INT, "rendering/3d/multimesh/gpu_culling_min_instances", PROPERTY_HINT_RANGE, "0,1048576,1,or_greater"));
+	GLOBAL_DEF("rendering/3d/particles/gpu_compaction_min_particles", 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/3d/particles/gpu_compaction_min_particles", PropertyInfo(Variant::INT, "rendering/3d/particles/gpu_compaction_min_particles", PROPERTY_HINT_RANGE, "0,1048576,1,or_greater"));
+
+	GLOBAL_DEF("rendering/shader_compiler/async_compile/enabled", false);
 	GLOBAL_DEF("rendering/shader_compiler/shader_cache/enabled", true);
 	GLOBAL_DEF("rendering/shader_compiler/shader_cache/compress", true);
 	GLOBAL_DEF("rendering/shader_compiler/shader_cache/use_zstd_compression", true);
@@ -2835,9 +2999,15 @@ RenderingServer::RenderingServer() {
 	GLOBAL_DEF("rendering/reflections/sky_reflections/ggx_samples", 1024);
 	GLOBAL_DEF("rendering/reflections/sky_reflections/ggx_samples.mobile", 128);
 	GLOBAL_DEF("rendering/reflections/sky_reflections/fast_filter_high_quality", false);
+	GLOBAL_DEF("rendering/reflections/sky_reflections/light_change_tolerance", 0.0);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/reflections/sky_reflections/light_change_tolerance", PropertyInfo(Variant::FLOAT, "rendering/reflections/sky_reflections/light_change_tolerance", PROPERTY_HINT_RANGE, "0.0,0.1,0.0001"));
+	GLOBAL_DEF("rendering/reflections/sky_reflections/max_updates_per_second", 0);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/reflections/sky_reflections/max_updates_per_second", PropertyInfo(Variant::INT, "rendering/reflections/sky_reflections/max_updates_per_second", PROPERTY_HINT_RANGE, "0,120,1"));
 	GLOBAL_DEF("rendering/reflections/reflection_atlas/reflection_size", 256);
 	GLOBAL_DEF("rendering/reflections/reflection_atlas/reflection_size.mobile", 128);
 	GLOBAL_DEF("rendering/reflections/reflection_atlas/reflection_count", 64);
+	GLOBAL_DEF("rendering/reflections/reflection_probes/update_always_steps_per_frame", 7);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/reflections/reflection_probes/update_always_steps_per_frame", PropertyInfo(Variant::INT, "rendering/reflections/reflection_probes/update_always_steps_per_frame", PROPERTY_HINT_RANGE, "1,7,1"));
 
 	GLOBAL_DEF("rendering/global_illumination/gi/use_half_resolution", false);
 
@@ -2876,6 +3046,9 @@ RenderingServer::RenderingServer() {
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/environment/ssao/fadeout_from", PropertyInfo(Variant::FLOAT, "rendering/environment/ssao/fadeout_from", PROPERTY_HINT_RANGE, "0.0,512,0.1,or_greater"));
 	GLOBAL_DEF("rendering/environment/ssao/fadeout_to", 300.0);
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/environment/ssao/fadeout_to", PropertyInfo(Variant::FLOAT, "rendering/environment/ssao/fadeout_to", PROPERTY_HINT_RANGE, "64,65536,0.1,or_greater"));
+	GLOBAL_DEF("rendering/environment/ssao/temporal_reprojection", false);
+	GLOBAL_DEF("rendering/environment/ssao/temporal_reprojection_amount", 0.9);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/environment/ssao/temporal_reprojection_amount", PropertyInfo(Variant::FLOAT, "rendering/environment/ssao/temporal_reprojection_amount", PROPERTY_HINT_RANGE, "0.5,0.99,0.001"));
 
 	GLOBAL_DEF("rendering/anti_aliasing/screen_space_roughness_limiter/enabled", true);
 	GLOBAL_DEF("rendering/anti_aliasing/screen_space_roughness_limiter/amount", 0.25);
@@ -2888,7 +3061,19 @@ RenderingServer::RenderingServer() {
 	GLOBAL_DEF("rendering/textures/light_projectors/filter", LIGHT_PROJECTOR_FILTER_LINEAR_MIPMAPS);
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/textures/light_projectors/filter", PropertyInfo(Variant::INT, "rendering/textures/light_projectors/filter", PROPERTY_HINT_ENUM, "Nearest (Fast),Nearest+Mipmaps,Linear,Linear+Mipmaps,Linear+Mipmaps Anisotropic (Slow)"));
 
+	GLOBAL_DEF_RST("rendering/mesh_lod/streaming/enabled", false);
+	GLOBAL_DEF("rendering/mesh_storage/compress_surfaces", false);
+
+	GLOBAL_DEF("rendering/textures/streaming/vram_budget_mb", 1024);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/textures/streaming/vram_budget_mb", PropertyInfo(Variant::INT, "rendering/textures/streaming/vram_budget_mb", PROPERTY_HINT_RANGE, "16,16384,1,or_greater"));
+	GLOBAL_DEF("rendering/textures/streaming/min_size", 128);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/textures/streaming/min_size", PropertyInfo(Variant::INT, "rendering/textures/streaming/min_size", PROPERTY_HINT_RANGE, "16,4096,1"));
+	GLOBAL_DEF("rendering/textures/streaming/max_loads_per_frame", 4);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/textures/streaming/max_loads_per_frame", PropertyInfo(Variant::INT, "rendering/textures/streaming/max_loads_per_frame", PROPERTY_HINT_RANGE, "1,64,1"));
+
 	GLOBAL_DEF_RST("rendering/occlusion_culling/occlusion_rays_per_thread", 512);
+	GLOBAL_DEF_RST("rendering/occlusion_culling/raycast_time_budget_msec", 0.0);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/occlusion_culling/raycast_time_budget_msec", PropertyInfo(Variant::FLOAT, "rendering/occlusion_culling/raycast_time_budget_msec", PROPERTY_HINT_RANGE, "0,16,0.1,or_greater"));
 	GLOBAL_DEF_RST("rendering/occlusion_culling/bvh_build_quality", 2);
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/occlusion_culling/bvh_build_quality", PropertyInfo(Variant::INT, "rendering/occlusion_culling/bvh_build_quality", PROPERTY_HINT_ENUM, "Low,Medium,High"));
 
@@ -2918,6 +3103,8 @@ RenderingServer::RenderingServer() {
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/global_illumination/sdfgi/frames_to_converge", PropertyInfo(Variant::INT, "rendering/global_illumination/sdfgi/frames_to_converge", PROPERTY_HINT_ENUM, "5 (Less Latency but Lower Quality),10,15,20,25,30 (More Latency but Higher Quality)"));
 	GLOBAL_DEF("rendering/global_illumination/sdfgi/frames_to_update_lights", 2);
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/global_illumination/sdfgi/frames_to_update_lights", PropertyInfo(Variant::INT, "rendering/global_illumination/sdfgi/frames_to_update_lights", PROPERTY_HINT_ENUM, "1 (Slower),2,4,8,16 (Faster)"));
+	GLOBAL_DEF_RST("rendering/global_illumination/sdfgi/cascade_update_budget", 2.0);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/global_illumination/sdfgi/cascade_update_budget", PropertyInfo(Variant::FLOAT, "rendering/global_illumination/sdfgi/cascade_update_budget", PROPERTY_HINT_RANGE, "0,8,0.1"));
 
 	GLOBAL_DEF("rendering/environment/volumetric_fog/volume_size", 64);
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/environment/volumetric_fog/volume_size", PropertyInfo(Variant::INT, "rendering/environment/volumetric_fog/volume_size", PROPERTY_HINT_RANGE, "16,512,1"));
@@ -2935,6 +3122,7 @@ RenderingServer::RenderingServer() {
 
 	GLOBAL_DEF("rendering/limits/cluster_builder/max_clustered_elements", 512);
 	ProjectSettings::get_singleton()->set_custom_property_info("rendering/limits/cluster_builder/max_clustered_elements", PropertyInfo(Variant::FLOAT, "rendering/limits/cluster_builder/max_clustered_elements", PROPERTY_HINT_RANGE, "32,8192,1"));
+	GLOBAL_DEF_RST("rendering/limits/cluster_builder/mobile_use_clustered_lights", false);
 
 	GLOBAL_DEF_RST("rendering/xr/enabled", false);
 }
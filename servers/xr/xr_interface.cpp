@@ -171,5 +171,8 @@ XRInterface::TrackingStatus XRInterface::get_tracking_status() const {
 void XRInterface::notification(int p_what) {
 }
 
+void XRInterface::pre_render() {
+}
+
 void XRInterface::trigger_haptic_pulse(const String &p_action_name, const StringName &p_tracker_name, double p_frequency, double p_amplitude, double p_duration_sec, double p_delay_sec) {
 }
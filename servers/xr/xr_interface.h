@@ -128,6 +128,7 @@ public:
 	virtual Vector<BlitToScreen> commit_views(RID p_render_target, const Rect2 &p_screen_rect) = 0; /* commit rendered views to the XR interface */
 
 	virtual void process() = 0;
+	virtual void pre_render(); /* called on the rendering thread right before our views are set up, latch the freshest tracking data (predicted to display time) for them here */
 	virtual void notification(int p_what);
 
 	XRInterface();
@@ -68,6 +68,7 @@ void XRServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_last_process_usec"), &XRServer::get_last_process_usec);
 	ClassDB::bind_method(D_METHOD("get_last_commit_usec"), &XRServer::get_last_commit_usec);
 	ClassDB::bind_method(D_METHOD("get_last_frame_usec"), &XRServer::get_last_frame_usec);
+	ClassDB::bind_method(D_METHOD("get_predicted_display_time_usec"), &XRServer::get_predicted_display_time_usec);
 
 	BIND_ENUM_CONSTANT(TRACKER_HEAD);
 	BIND_ENUM_CONSTANT(TRACKER_CONTROLLER);
@@ -363,6 +364,12 @@ uint64_t XRServer::get_last_frame_usec() {
 	return last_frame_usec;
 };
 
+uint64_t XRServer::get_predicted_display_time_usec() {
+	/* we're done rendering once we commit, after which our frame should be shown at the next refresh */
+	uint64_t from = last_pre_render_usec > 0 ? last_pre_render_usec : OS::get_singleton()->get_ticks_usec();
+	return from + render_usec + commit_interval_usec;
+};
+
 void XRServer::_process() {
 	/* called from renderer_viewport.draw_viewports right before we start drawing our viewports */
 
@@ -379,9 +386,32 @@ void XRServer::_process() {
 	};
 };
 
+void XRServer::_pre_render() {
+	/* called from renderer_viewport.draw_viewports on the rendering thread, right before we draw an XR viewport */
+	last_pre_render_usec = OS::get_singleton()->get_ticks_usec();
+
+	/* our tracking data was obtained in _process, before a whole frame of game logic ran, let our interface latch fresh data for our views */
+	if (primary_interface.is_valid()) {
+		primary_interface->pre_render();
+	}
+};
+
 void XRServer::_mark_commit() {
 	/* time this */
-	last_commit_usec = OS::get_singleton()->get_ticks_usec();
+	uint64_t ticks = OS::get_singleton()->get_ticks_usec();
+
+	/* keep running averages for predicting when our frames are displayed */
+	if (last_commit_usec > 0 && ticks - last_commit_usec < 100000) {
+		/* longer gaps are hitches or pauses, not our refresh interval */
+		uint64_t interval = ticks - last_commit_usec;
+		commit_interval_usec = commit_interval_usec > 0 ? (commit_interval_usec * 7 + interval) / 8 : interval;
+	}
+	if (last_pre_render_usec > 0) {
+		uint64_t render = ticks - last_pre_render_usec;
+		render_usec = render_usec > 0 ? (render_usec * 7 + render) / 8 : render;
+	}
+
+	last_commit_usec = ticks;
 
 	/* now store our difference as we may overwrite last_process_usec before this is accessed */
 	last_frame_usec = last_commit_usec - last_process_usec;
@@ -86,9 +86,12 @@ private:
 	Transform3D world_origin; /* our world origin point, maps a location in our virtual world to the origin point in our real world tracking volume */
 	Transform3D reference_frame; /* our reference frame */
 
-	uint64_t last_process_usec; /* for frame timing, usec when we did our processing */
-	uint64_t last_commit_usec; /* for frame timing, usec when we finished committing both eyes */
-	uint64_t last_frame_usec; /* time it took between process and committing, we should probably average this over the last x frames */
+	uint64_t last_process_usec = 0; /* for frame timing, usec when we did our processing */
+	uint64_t last_commit_usec = 0; /* for frame timing, usec when we finished committing both eyes */
+	uint64_t last_frame_usec = 0; /* time it took between process and committing, we should probably average this over the last x frames */
+	uint64_t last_pre_render_usec = 0; /* usec when we started rendering our XR views */
+	uint64_t render_usec = 0; /* running average of the time between starting to render our XR views and committing them */
+	uint64_t commit_interval_usec = 0; /* running average of the time between commits, normally our display refresh interval */
 
 protected:
 	static XRServer *singleton;
@@ -181,7 +184,14 @@ public:
 	uint64_t get_last_commit_usec();
 	uint64_t get_last_frame_usec();
 
+	/*
+		Estimated absolute timestamp (in usec) at which the frame currently being rendered will be on display.
+		Interfaces without a compositor that tells them can use this to predict poses when latching them in pre_render.
+	*/
+	uint64_t get_predicted_display_time_usec();
+
 	void _process();
+	void _pre_render();
 	void _mark_commit();
 
 	XRServer();
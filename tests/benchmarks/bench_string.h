@@ -0,0 +1,119 @@
+/*************************************************************************/
+/*  bench_string.h                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef BENCH_STRING_H
+#define BENCH_STRING_H
+
+#include "core/string/string_name.h"
+#include "core/string/ustring.h"
+#include "core/variant/variant.h"
+
+#include "tests/benchmarks/benchmark.h"
+
+namespace BenchString {
+
+static const char *LOREM = "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.";
+
+BENCHMARK("[String] Concatenate 100 words") {
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		String string;
+		for (int j = 0; j < 100; j++) {
+			string += "word ";
+		}
+		benchmark_keep(string);
+	}
+}
+
+BENCHMARK("[String] Find") {
+	String string = LOREM;
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		benchmark_keep(string.find("aliqua"));
+	}
+}
+
+BENCHMARK("[String] Split") {
+	String string = LOREM;
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		benchmark_keep(string.split(" "));
+	}
+}
+
+BENCHMARK("[String] Format with vformat") {
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		benchmark_keep(vformat("%s: %d (%.2f)", "value", int(i), 0.5));
+	}
+}
+
+BENCHMARK("[String] UTF-8 round trip") {
+	String string = LOREM;
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		CharString utf8 = string.utf8();
+		benchmark_keep(String::utf8(utf8.get_data(), utf8.length()));
+	}
+}
+
+BENCHMARK("[String] Integer and float conversion") {
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		benchmark_keep(itos(i).to_int());
+		benchmark_keep(rtos(i * 0.25).to_float());
+	}
+}
+
+BENCHMARK("[StringName] Create from interned String") {
+	String string = "position";
+	StringName interned = string;
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		benchmark_keep(StringName(string));
+	}
+}
+
+BENCHMARK("[StringName] Create from static C string") {
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		benchmark_keep(StringName("position", true));
+	}
+}
+
+BENCHMARK("[StringName] Create and free unique names") {
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		benchmark_keep(StringName(itos(i)));
+	}
+}
+
+BENCHMARK("[StringName] Compare") {
+	StringName a = "position";
+	StringName b = "rotation";
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		benchmark_keep(a == b);
+	}
+}
+
+} // namespace BenchString
+
+#endif // BENCH_STRING_H
@@ -0,0 +1,212 @@
+/*************************************************************************/
+/*  bench_templates.h                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef BENCH_TEMPLATES_H
+#define BENCH_TEMPLATES_H
+
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/map.h"
+#include "core/templates/oa_hash_map.h"
+#include "core/templates/sort_array.h"
+#include "core/templates/vector.h"
+
+#include "tests/benchmarks/benchmark.h"
+
+namespace BenchTemplates {
+
+// Workloads operate on this many elements per iteration.
+static const int ELEMENT_COUNT = 1000;
+
+// Scattered but reproducible keys, so hashing and tree balancing see something realistic.
+static inline int get_key(int p_index) {
+	return int((uint32_t)p_index * 2654435761u >> 1);
+}
+
+BENCHMARK("[HashMap] Insert 1000 int keys") {
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		HashMap<int, int> map;
+		for (int j = 0; j < ELEMENT_COUNT; j++) {
+			map.set(get_key(j), j);
+		}
+		benchmark_keep(map);
+	}
+}
+
+BENCHMARK("[HashMap] Lookup 1000 int keys") {
+	HashMap<int, int> map;
+	for (int j = 0; j < ELEMENT_COUNT; j++) {
+		map.set(get_key(j), j);
+	}
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		int sum = 0;
+		for (int j = 0; j < ELEMENT_COUNT; j++) {
+			sum += *map.getptr(get_key(j));
+		}
+		benchmark_keep(sum);
+	}
+}
+
+BENCHMARK("[OAHashMap] Insert 1000 int keys") {
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		OAHashMap<int, int> map;
+		for (int j = 0; j < ELEMENT_COUNT; j++) {
+			map.set(get_key(j), j);
+		}
+		benchmark_keep(map);
+	}
+}
+
+BENCHMARK("[OAHashMap] Lookup 1000 int keys") {
+	OAHashMap<int, int> map;
+	for (int j = 0; j < ELEMENT_COUNT; j++) {
+		map.set(get_key(j), j);
+	}
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		int sum = 0;
+		for (int j = 0; j < ELEMENT_COUNT; j++) {
+			sum += *map.lookup_ptr(get_key(j));
+		}
+		benchmark_keep(sum);
+	}
+}
+
+BENCHMARK("[Map] Insert 1000 int keys") {
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		Map<int, int> map;
+		for (int j = 0; j < ELEMENT_COUNT; j++) {
+			map.insert(get_key(j), j);
+		}
+		benchmark_keep(map);
+	}
+}
+
+BENCHMARK("[Map] Lookup 1000 int keys") {
+	Map<int, int> map;
+	for (int j = 0; j < ELEMENT_COUNT; j++) {
+		map.insert(get_key(j), j);
+	}
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		int sum = 0;
+		for (int j = 0; j < ELEMENT_COUNT; j++) {
+			sum += map.find(get_key(j))->get();
+		}
+		benchmark_keep(sum);
+	}
+}
+
+BENCHMARK("[Vector] Push back 1000 ints") {
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		Vector<int> vector;
+		for (int j = 0; j < ELEMENT_COUNT; j++) {
+			vector.push_back(j);
+		}
+		benchmark_keep(vector);
+	}
+}
+
+BENCHMARK("[Vector] Copy on write of 1000 ints") {
+	Vector<int> source;
+	source.resize(ELEMENT_COUNT);
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		Vector<int> copy = source;
+		copy.write[0] = int(i);
+		benchmark_keep(copy);
+	}
+}
+
+BENCHMARK("[Vector] Iterate 1000 ints") {
+	Vector<int> vector;
+	for (int j = 0; j < ELEMENT_COUNT; j++) {
+		vector.push_back(j);
+	}
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		int sum = 0;
+		for (int j = 0; j < vector.size(); j++) {
+			sum += vector[j];
+		}
+		benchmark_keep(sum);
+	}
+}
+
+BENCHMARK("[LocalVector] Push back 1000 ints") {
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		LocalVector<int> vector;
+		for (int j = 0; j < ELEMENT_COUNT; j++) {
+			vector.push_back(j);
+		}
+		benchmark_keep(vector);
+	}
+}
+
+BENCHMARK("[LocalVector] Iterate 1000 ints") {
+	LocalVector<int> vector;
+	for (int j = 0; j < ELEMENT_COUNT; j++) {
+		vector.push_back(j);
+	}
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		int sum = 0;
+		for (uint32_t j = 0; j < vector.size(); j++) {
+			sum += vector[j];
+		}
+		benchmark_keep(sum);
+	}
+}
+
+BENCHMARK("[SortArray] Sort 1000 ints") {
+	LocalVector<int> source;
+	for (int j = 0; j < ELEMENT_COUNT; j++) {
+		source.push_back(get_key(j));
+	}
+	LocalVector<int> data;
+	data.resize(ELEMENT_COUNT);
+	SortArray<int> sorter;
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		memcpy(data.ptr(), source.ptr(), ELEMENT_COUNT * sizeof(int));
+		sorter.sort(data.ptr(), ELEMENT_COUNT);
+		benchmark_keep(data);
+	}
+}
+
+BENCHMARK("[SortArray] Sort 1000 sorted ints") {
+	LocalVector<int> data;
+	for (int j = 0; j < ELEMENT_COUNT; j++) {
+		data.push_back(j);
+	}
+	SortArray<int> sorter;
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		sorter.sort(data.ptr(), ELEMENT_COUNT);
+		benchmark_keep(data);
+	}
+}
+
+} // namespace BenchTemplates
+
+#endif // BENCH_TEMPLATES_H
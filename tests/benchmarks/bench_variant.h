@@ -0,0 +1,175 @@
+/*************************************************************************/
+/*  bench_variant.h                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef BENCH_VARIANT_H
+#define BENCH_VARIANT_H
+
+#include "core/io/marshalls.h"
+#include "core/object/callable_method_pointer.h"
+#include "core/object/object.h"
+#include "core/variant/callable.h"
+#include "core/variant/dictionary.h"
+#include "core/variant/variant.h"
+
+#include "tests/benchmarks/benchmark.h"
+
+namespace BenchVariant {
+
+class CallTarget : public Object {
+	GDCLASS(CallTarget, Object);
+
+public:
+	int total = 0;
+
+	void add(int p_value) {
+		total += p_value;
+	}
+};
+
+static Dictionary make_dictionary() {
+	Dictionary dictionary;
+	dictionary["name"] = "player";
+	dictionary["position"] = Vector3(1, 2, 3);
+	dictionary["health"] = 100;
+	dictionary["speed"] = 4.5;
+	Array inventory;
+	for (int i = 0; i < 10; i++) {
+		inventory.push_back(itos(i));
+	}
+	dictionary["inventory"] = inventory;
+	return dictionary;
+}
+
+BENCHMARK("[Variant] Add ints") {
+	Variant a = 1;
+	Variant b = 2;
+	Variant result;
+	bool valid;
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		Variant::evaluate(Variant::OP_ADD, a, b, result, valid);
+		benchmark_keep(result);
+	}
+}
+
+BENCHMARK("[Variant] Multiply Vector3 by float") {
+	Variant a = Vector3(1, 2, 3);
+	Variant b = 0.5;
+	Variant result;
+	bool valid;
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		Variant::evaluate(Variant::OP_MULTIPLY, a, b, result, valid);
+		benchmark_keep(result);
+	}
+}
+
+BENCHMARK("[Variant] Validated operator evaluator") {
+	Variant a = 1;
+	Variant b = 2;
+	Variant result = 0;
+	Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::OP_ADD, Variant::INT, Variant::INT);
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		evaluator(&a, &b, &result);
+		benchmark_keep(result);
+	}
+}
+
+BENCHMARK("[Variant] Call builtin method") {
+	Variant vector = Vector3(1, 2, 3);
+	StringName method = "length";
+	Variant result;
+	Callable::CallError error;
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		vector.call(method, nullptr, 0, result, error);
+		benchmark_keep(result);
+	}
+}
+
+BENCHMARK("[Variant] Duplicate Dictionary") {
+	Dictionary dictionary = make_dictionary();
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		benchmark_keep(dictionary.duplicate());
+	}
+}
+
+BENCHMARK("[Variant] encode_variant Dictionary") {
+	Variant dictionary = make_dictionary();
+	int len = 0;
+	encode_variant(dictionary, nullptr, len);
+	Vector<uint8_t> buffer;
+	buffer.resize(len);
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		encode_variant(dictionary, buffer.ptrw(), len);
+		benchmark_keep(buffer);
+	}
+}
+
+BENCHMARK("[Variant] decode_variant Dictionary") {
+	Variant dictionary = make_dictionary();
+	int len = 0;
+	encode_variant(dictionary, nullptr, len);
+	Vector<uint8_t> buffer;
+	buffer.resize(len);
+	encode_variant(dictionary, buffer.ptrw(), len);
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		Variant decoded;
+		decode_variant(decoded, buffer.ptr(), len);
+		benchmark_keep(decoded);
+	}
+}
+
+BENCHMARK("[Callable] Call method pointer") {
+	CallTarget *target = memnew(CallTarget);
+	Callable callable = callable_mp(target, &CallTarget::add);
+	Variant argument = 1;
+	const Variant *arguments[1] = { &argument };
+	Variant result;
+	Callable::CallError error;
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		callable.call(arguments, 1, result, error);
+	}
+	benchmark_keep(target->total);
+	memdelete(target);
+}
+
+BENCHMARK("[Callable] Call bound method by name") {
+	Object *object = memnew(Object);
+	Callable callable(object, "get_instance_id");
+	Variant result;
+	Callable::CallError error;
+	for (uint64_t i = 0; i < p_iterations; i++) {
+		callable.call(nullptr, 0, result, error);
+		benchmark_keep(result);
+	}
+	memdelete(object);
+}
+
+} // namespace BenchVariant
+
+#endif // BENCH_VARIANT_H
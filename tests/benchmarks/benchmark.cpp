@@ -0,0 +1,229 @@
+/*************************************************************************/
+/*  benchmark.cpp                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "benchmark.h"
+
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/sort_array.h"
+#include "core/variant/dictionary.h"
+
+#include "tests/test_macros.h"
+
+const void *volatile benchmark_sink = nullptr;
+
+struct BenchmarkEntry {
+	const char *name = nullptr;
+	BenchmarkFunc function = nullptr;
+};
+
+static LocalVector<BenchmarkEntry> *benchmarks = nullptr;
+
+// A run should take at least this long for the timer resolution and noise to not matter.
+static const uint64_t BENCHMARK_TARGET_RUN_USEC = 20000;
+static const uint64_t BENCHMARK_MAX_ITERATIONS = 1ULL << 40;
+static const int BENCHMARK_WARMUP_RUNS = 2;
+static const int BENCHMARK_DEFAULT_SAMPLES = 10;
+static const double BENCHMARK_DEFAULT_THRESHOLD = 5.0;
+
+int register_benchmark(const char *p_name, BenchmarkFunc p_function) {
+	if (!benchmarks) {
+		benchmarks = new LocalVector<BenchmarkEntry>;
+	}
+	BenchmarkEntry entry;
+	entry.name = p_name;
+	entry.function = p_function;
+	benchmarks->push_back(entry);
+	return 0;
+}
+
+struct BenchmarkResult {
+	uint64_t iterations = 0;
+	// All in nanoseconds per iteration.
+	double median = 0.0;
+	double mean = 0.0;
+	double min = 0.0;
+	double deviation = 0.0;
+};
+
+static uint64_t _benchmark_time_run(BenchmarkFunc p_function, uint64_t p_iterations) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	p_function(p_iterations);
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+// Finds the iterations needed for a run to last about BENCHMARK_TARGET_RUN_USEC.
+static uint64_t _benchmark_calibrate(BenchmarkFunc p_function) {
+	uint64_t iterations = 1;
+	while (iterations < BENCHMARK_MAX_ITERATIONS) {
+		uint64_t usec = _benchmark_time_run(p_function, iterations);
+		if (usec >= BENCHMARK_TARGET_RUN_USEC) {
+			break;
+		}
+		if (usec >= BENCHMARK_TARGET_RUN_USEC / 10) {
+			// Long enough to extrapolate from.
+			return MIN(iterations * BENCHMARK_TARGET_RUN_USEC / usec + 1, BENCHMARK_MAX_ITERATIONS);
+		}
+		iterations *= 2;
+	}
+	return iterations;
+}
+
+static BenchmarkResult _benchmark_run(BenchmarkFunc p_function, int p_samples) {
+	BenchmarkResult result;
+	result.iterations = _benchmark_calibrate(p_function);
+
+	for (int i = 0; i < BENCHMARK_WARMUP_RUNS; i++) {
+		p_function(result.iterations);
+	}
+
+	LocalVector<double> samples;
+	samples.resize(p_samples);
+	for (int i = 0; i < p_samples; i++) {
+		samples[i] = _benchmark_time_run(p_function, result.iterations) * 1000.0 / result.iterations;
+	}
+
+	SortArray<double> sorter;
+	sorter.sort(samples.ptr(), samples.size());
+
+	result.min = samples[0];
+	result.median = (p_samples % 2) ? samples[p_samples / 2] : (samples[p_samples / 2 - 1] + samples[p_samples / 2]) * 0.5;
+
+	for (int i = 0; i < p_samples; i++) {
+		result.mean += samples[i];
+	}
+	result.mean /= p_samples;
+
+	for (int i = 0; i < p_samples; i++) {
+		result.deviation += (samples[i] - result.mean) * (samples[i] - result.mean);
+	}
+	result.deviation = Math::sqrt(result.deviation / p_samples);
+
+	return result;
+}
+
+void run_benchmarks() {
+	String filter;
+	String save_path;
+	String baseline_path;
+	int samples = BENCHMARK_DEFAULT_SAMPLES;
+	double threshold = BENCHMARK_DEFAULT_THRESHOLD;
+
+	List<String> args = OS::get_singleton()->get_cmdline_args();
+	for (List<String>::Element *E = args.front(); E; E = E->next()) {
+		if (!E->next()) {
+			break;
+		}
+		const String &arg = E->get();
+		if (arg == "--filter") {
+			filter = E->next()->get();
+		} else if (arg == "--samples") {
+			samples = MAX(E->next()->get().to_int(), 1);
+		} else if (arg == "--save") {
+			save_path = E->next()->get();
+		} else if (arg == "--baseline") {
+			baseline_path = E->next()->get();
+		} else if (arg == "--threshold") {
+			threshold = E->next()->get().to_float();
+		}
+	}
+
+	Dictionary baseline;
+	if (!baseline_path.is_empty()) {
+		Error err;
+		String text = FileAccess::get_file_as_string(baseline_path, &err);
+		ERR_FAIL_COND_MSG(err != OK, "Cannot open benchmark baseline '" + baseline_path + "'.");
+		JSON json;
+		err = json.parse(text);
+		ERR_FAIL_COND_MSG(err != OK, "Cannot parse benchmark baseline '" + baseline_path + "': " + json.get_error_message());
+		Dictionary data = json.get_data();
+		baseline = data.get("benchmarks", Dictionary());
+	}
+
+	if (!benchmarks) {
+		print_line("No benchmarks registered.");
+		return;
+	}
+
+	Dictionary results;
+	int regressions = 0;
+
+	print_line(vformat("%-56s %12s %12s %12s %9s", "Benchmark", "median ns", "mean ns", "min ns", "stddev"));
+	for (uint32_t i = 0; i < benchmarks->size(); i++) {
+		const BenchmarkEntry &entry = (*benchmarks)[i];
+		String name = String::utf8(entry.name);
+		if (!filter.is_empty() && name.findn(filter) == -1) {
+			continue;
+		}
+
+		BenchmarkResult result = _benchmark_run(entry.function, samples);
+		String line = vformat("%-56s %12.2f %12.2f %12.2f %8.1f%%", name, result.median, result.mean, result.min, result.mean > 0.0 ? result.deviation * 100.0 / result.mean : 0.0);
+
+		if (baseline.has(name)) {
+			Dictionary base = baseline[name];
+			double base_median = base.get("median_ns", 0.0);
+			if (base_median > 0.0) {
+				double change = (result.median - base_median) * 100.0 / base_median;
+				line += vformat(" %+8.1f%%", change);
+				if (change > threshold) {
+					line += " REGRESSION";
+					regressions++;
+				}
+			}
+		}
+		print_line(line);
+
+		Dictionary data;
+		data["iterations"] = result.iterations;
+		data["median_ns"] = result.median;
+		data["mean_ns"] = result.mean;
+		data["min_ns"] = result.min;
+		data["stddev_ns"] = result.deviation;
+		results[name] = data;
+	}
+
+	if (!save_path.is_empty()) {
+		Dictionary data;
+		data["benchmarks"] = results;
+		JSON json;
+		Error err = json.stringify_to_file(data, save_path, "\t");
+		ERR_FAIL_COND_MSG(err != OK, "Cannot save benchmark results to '" + save_path + "'.");
+		print_line("Saved benchmark results to " + save_path + ".");
+	}
+
+	if (regressions > 0) {
+		print_line(vformat("%d benchmark(s) regressed by more than %.1f%% against the baseline.", regressions, threshold));
+		OS::get_singleton()->set_exit_code(EXIT_FAILURE);
+	}
+}
+
+REGISTER_TEST_COMMAND("benchmark", &run_benchmarks);
@@ -0,0 +1,77 @@
+/*************************************************************************/
+/*  benchmark.h                                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "core/string/ustring.h"
+#include "core/typedefs.h"
+
+// Microbenchmarks, built with `scons benchmarks=yes` and run with:
+//
+//   godot --test benchmark [--filter <text>] [--samples <count>]
+//         [--save <file.json>] [--baseline <file.json>] [--threshold <percent>]
+//
+// Each benchmark is a function running its operation `p_iterations` times. The runner
+// first doubles the iterations until a run takes long enough to time reliably (which
+// also warms up caches and allocators), then times a number of samples and reports the
+// median, mean, minimum and deviation per operation. Results can be saved as JSON and
+// later compared against, runs slower than the baseline by more than the threshold are
+// reported as regressions and make the process exit with a non-zero code.
+
+typedef void (*BenchmarkFunc)(uint64_t p_iterations);
+
+int register_benchmark(const char *p_name, BenchmarkFunc p_function);
+void run_benchmarks();
+
+extern const void *volatile benchmark_sink;
+
+// Keeps the compiler from optimizing away a value only computed to be measured.
+template <class T>
+_FORCE_INLINE_ void benchmark_keep(const T &p_value) {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r"(&p_value) : "memory");
+#else
+	benchmark_sink = &p_value;
+#endif
+}
+
+#define BENCHMARK_CONCAT_IMPL(m_a, m_b) m_a##m_b
+#define BENCHMARK_CONCAT(m_a, m_b) BENCHMARK_CONCAT_IMPL(m_a, m_b)
+
+#define BENCHMARK_IMPL(m_name, m_id)                                                                                            \
+	static void BENCHMARK_CONCAT(_benchmark_func_, m_id)(uint64_t p_iterations);                                                \
+	static int BENCHMARK_CONCAT(_benchmark_reg_, m_id) = register_benchmark(m_name, &BENCHMARK_CONCAT(_benchmark_func_, m_id)); \
+	static void BENCHMARK_CONCAT(_benchmark_func_, m_id)(uint64_t p_iterations)
+
+// Defines a benchmark, for instance: BENCHMARK("[Vector] Push back") { ... }.
+#define BENCHMARK(m_name) BENCHMARK_IMPL(m_name, __COUNTER__)
+
+#endif // BENCHMARK_H
@@ -32,6 +32,7 @@
 #define TEST_ASTAR_H
 
 #include "core/math/a_star.h"
+#include "core/math/a_star_grid_2d.h"
 #include "core/math/math_funcs.h"
 #include "core/os/os.h"
 
@@ -362,6 +363,91 @@ TEST_CASE("[Stress][AStar] Find paths") {
 		CHECK_MESSAGE(match, "Found all paths.");
 	}
 }
+
+static real_t grid_path_cost(const Array &p_path) {
+	real_t cost = 0;
+	for (int i = 1; i < p_path.size(); i++) {
+		cost += Vector2(p_path[i - 1]).distance_to(Vector2(p_path[i]));
+	}
+	return cost;
+}
+
+TEST_CASE("[AStarGrid2D] Paths") {
+	AStarGrid2D grid;
+	grid.set_size(Vector2i(5, 5));
+	grid.set_cell_size(Vector2(16, 16));
+	grid.set_offset(Vector2(8, 8));
+	CHECK(grid.is_dirty());
+	grid.update();
+	CHECK(!grid.is_dirty());
+
+	// A wall with a single gap at the bottom.
+	for (int y = 0; y < 4; y++) {
+		grid.set_point_solid(Vector2i(2, y));
+	}
+	CHECK(grid.is_point_solid(Vector2i(2, 0)));
+	CHECK(!grid.is_point_solid(Vector2i(2, 4)));
+
+	Array path = grid.get_id_path(Vector2i(0, 0), Vector2i(4, 0));
+	REQUIRE(path.size() > 0);
+	CHECK(Vector2i(path[0]) == Vector2i(0, 0));
+	CHECK(Vector2i(path[path.size() - 1]) == Vector2i(4, 0));
+	for (int i = 0; i < path.size(); i++) {
+		CHECK(!grid.is_point_solid(path[i]));
+	}
+	CHECK(path.has(Vector2i(2, 4)));
+
+	Vector<Vector2> point_path = grid.get_point_path(Vector2i(0, 0), Vector2i(4, 0));
+	REQUIRE(point_path.size() == path.size());
+	CHECK(point_path[0] == Vector2(8, 8));
+	CHECK(point_path[point_path.size() - 1] == Vector2(72, 8));
+
+	grid.set_point_solid(Vector2i(2, 4));
+	CHECK(grid.get_id_path(Vector2i(0, 0), Vector2i(4, 0)).is_empty());
+
+	grid.set_point_solid(Vector2i(2, 4), false);
+	grid.set_diagonal_mode(AStarGrid2D::DIAGONAL_MODE_NEVER);
+	path = grid.get_id_path(Vector2i(0, 0), Vector2i(4, 0));
+	REQUIRE(path.size() > 0);
+	for (int i = 1; i < path.size(); i++) {
+		Vector2i step = Vector2i(path[i]) - Vector2i(path[i - 1]);
+		CHECK(ABS(step.x) + ABS(step.y) == 1);
+	}
+}
+
+TEST_CASE("[AStarGrid2D] Jumping finds paths of the same cost") {
+	const int diagonal_modes[2] = { AStarGrid2D::DIAGONAL_MODE_ALWAYS, AStarGrid2D::DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES };
+	for (int mode = 0; mode < 2; mode++) {
+		AStarGrid2D grid;
+		grid.set_size(Vector2i(24, 24));
+		grid.set_diagonal_mode(AStarGrid2D::DiagonalMode(diagonal_modes[mode]));
+		grid.update();
+
+		uint32_t seed = 12345;
+		for (int y = 0; y < 24; y++) {
+			for (int x = 0; x < 24; x++) {
+				seed = seed * 1103515245 + 12345;
+				if ((seed >> 16) % 4 == 0) {
+					grid.set_point_solid(Vector2i(x, y));
+				}
+			}
+		}
+		grid.set_point_solid(Vector2i(0, 0), false);
+		grid.set_point_solid(Vector2i(23, 23), false);
+
+		Array path = grid.get_id_path(Vector2i(0, 0), Vector2i(23, 23));
+		grid.set_jumping_enabled(true);
+		Array jump_path = grid.get_id_path(Vector2i(0, 0), Vector2i(23, 23));
+
+		CHECK(path.is_empty() == jump_path.is_empty());
+		CHECK(Math::is_equal_approx(grid_path_cost(path), grid_path_cost(jump_path)));
+		for (int i = 1; i < jump_path.size(); i++) {
+			Vector2i step = Vector2i(jump_path[i]) - Vector2i(jump_path[i - 1]);
+			CHECK(MAX(ABS(step.x), ABS(step.y)) == 1);
+			CHECK(!grid.is_point_solid(jump_path[i]));
+		}
+	}
+}
 } // namespace TestAStar
 
 #endif // TEST_ASTAR_H
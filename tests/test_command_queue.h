@@ -426,6 +426,72 @@ TEST_CASE("[Stress][CommandQueue] Stress test command queue") {
 	ProjectSettings::get_singleton()->set_setting(COMMAND_QUEUE_SETTING,
 			ProjectSettings::get_singleton()->property_get_revert(COMMAND_QUEUE_SETTING));
 }
+
+class MultiProducerState {
+public:
+	enum {
+		PRODUCERS = 4,
+		COMMANDS_PER_PRODUCER = 2000,
+	};
+
+	CommandQueueMT command_queue = CommandQueueMT(false);
+	Thread producer_threads[PRODUCERS];
+	int last_received[PRODUCERS] = {};
+	int out_of_order = 0;
+	int received = 0;
+
+	void receive(int p_producer, int p_sequence) {
+		if (p_sequence != last_received[p_producer] + 1) {
+			out_of_order++;
+		}
+		last_received[p_producer] = p_sequence;
+		received++;
+	}
+
+	struct ProducerData {
+		MultiProducerState *state;
+		int producer;
+	};
+	ProducerData producer_data[PRODUCERS];
+
+	static void static_producer_loop(void *p_data) {
+		ProducerData *data = static_cast<ProducerData *>(p_data);
+		for (int i = 1; i <= COMMANDS_PER_PRODUCER; i++) {
+			data->state->command_queue.push(data->state, &MultiProducerState::receive, data->producer, i);
+		}
+	}
+
+	void run() {
+		for (int i = 0; i < PRODUCERS; i++) {
+			producer_data[i].state = this;
+			producer_data[i].producer = i;
+			producer_threads[i].start(&MultiProducerState::static_producer_loop, &producer_data[i]);
+		}
+		// Flush while producers are still pushing.
+		while (received < PRODUCERS * COMMANDS_PER_PRODUCER) {
+			command_queue.flush_if_pending();
+		}
+		for (int i = 0; i < PRODUCERS; i++) {
+			producer_threads[i].wait_to_finish();
+		}
+		command_queue.flush_all();
+	}
+};
+
+TEST_CASE("[CommandQueue] Multiple producers keep their order") {
+	MultiProducerState state;
+	state.run();
+
+	CHECK_MESSAGE(state.received == MultiProducerState::PRODUCERS * MultiProducerState::COMMANDS_PER_PRODUCER,
+			"Every pushed command should have been executed.");
+	CHECK_MESSAGE(state.out_of_order == 0,
+			"Commands from the same producer should be executed in the order they were pushed.");
+	CHECK_MESSAGE(state.command_queue.get_pending_command_count() == 0,
+			"No commands should be pending after flushing.");
+	CHECK_MESSAGE(state.command_queue.get_max_pending_command_count() > 0,
+			"The pending command high watermark should have been recorded.");
+}
+
 } // namespace TestCommandQueue
 
 #endif // !defined(NO_THREADS)
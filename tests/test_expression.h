@@ -321,6 +321,81 @@ TEST_CASE("[Expression] Expressions with variables") {
 	ERR_PRINT_ON;
 }
 
+TEST_CASE("[Expression] Repeated and batch execution") {
+	Expression expression;
+
+	PackedStringArray parameter_names;
+	parameter_names.push_back("x");
+	parameter_names.push_back("y");
+	CHECK_MESSAGE(
+			expression.parse("x * (2 + 3) - Vector2(1, 2).x + y", parameter_names) == OK,
+			"The expression should parse successfully.");
+
+	// Operand types changing between executions.
+	Array values;
+	values.push_back(3);
+	values.push_back(1);
+	CHECK_MESSAGE(
+			int(expression.execute(values)) == 15,
+			"The expression should return the expected value.");
+	values[0] = 0.5;
+	CHECK_MESSAGE(
+			double(expression.execute(values)) == doctest::Approx(2.5),
+			"The expression should return the expected value after the input types change.");
+	values[1] = "text";
+	ERR_PRINT_OFF;
+	expression.execute(values);
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(
+			expression.has_execute_failed(),
+			"Invalid operand types should fail to execute.");
+	values[1] = 1;
+	CHECK_MESSAGE(
+			double(expression.execute(values)) == doctest::Approx(2.5),
+			"The expression should execute successfully again.");
+
+	Array xs;
+	PackedFloat64Array ys;
+	for (int i = 0; i < 4; i++) {
+		xs.push_back(i);
+		ys.push_back(i * 0.5);
+	}
+	Array inputs;
+	inputs.push_back(xs);
+	inputs.push_back(ys);
+	Array results = expression.execute_batch(inputs);
+	CHECK_MESSAGE(
+			results.size() == 4,
+			"Batch execution should return one result per value.");
+	for (int i = 0; i < results.size(); i++) {
+		CHECK_MESSAGE(
+				double(results[i]) == doctest::Approx(i * 5 - 1 + i * 0.5),
+				"Batch execution should return the expected values.");
+	}
+
+	// Results that are references must not be shared between executions.
+	CHECK_MESSAGE(
+			expression.parse("[x, y]", parameter_names) == OK,
+			"The expression should parse successfully.");
+	results = expression.execute_batch(inputs);
+	CHECK_MESSAGE(
+			Array(results[0]) != Array(results[1]),
+			"Every execution should create a new array.");
+	CHECK_MESSAGE(
+			int(Array(results[3])[0]) == 3,
+			"Batch execution should return the expected values.");
+
+	CHECK_MESSAGE(
+			expression.parse("1 / 0") == OK,
+			"Division by zero is only an error when executing.");
+	ERR_PRINT_OFF;
+	expression.execute();
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(
+			expression.has_execute_failed(),
+			"Division by zero should fail to execute.");
+}
+
 TEST_CASE("[Expression] Invalid expressions") {
 	Expression expression;
 
@@ -31,7 +31,10 @@
 #ifndef TEST_FILE_ACCESS_H
 #define TEST_FILE_ACCESS_H
 
+#include "core/io/compression.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_compressed.h"
+#include "core/os/os.h"
 #include "test_utils.h"
 
 namespace TestFileAccess {
@@ -79,6 +82,133 @@ TEST_CASE("[FileAccess] CSV read") {
 
 	f->close();
 }
+
+TEST_CASE("[FileAccess] Buffer view") {
+	Vector<uint8_t> contents = FileAccess::get_file_as_array(TestUtils::get_data_path("translations.csv"));
+	REQUIRE(contents.size() > 16);
+
+	FileAccessRef f = FileAccess::open(TestUtils::get_data_path("translations.csv"), FileAccess::READ);
+	f->seek(4);
+	const uint8_t *view = f->get_buffer_view(8);
+	if (view) {
+		CHECK_MESSAGE(memcmp(view, contents.ptr() + 4, 8) == 0, "The view should point at the file contents.");
+		CHECK(f->get_position() == 12);
+		CHECK_MESSAGE(f->get_8() == contents[12], "Regular reads should continue after the view.");
+	} else {
+		CHECK_MESSAGE(f->get_position() == 4, "A failed view shouldn't move the position.");
+	}
+
+	f->seek(0);
+	CHECK_MESSAGE(f->get_buffer_view(contents.size() + 1) == nullptr, "Views past the end of the file should fail.");
+	CHECK(f->get_position() == 0);
+
+	f->close();
+}
+
+TEST_CASE("[FileAccess] Compressed file round trip") {
+	const String path = OS::get_singleton()->get_cache_path().plus_file("compressed.bin");
+
+	// Enough blocks for the parallel paths, with a partial last block.
+	Vector<uint8_t> data;
+	data.resize(4096 * 37 + 123);
+	for (int i = 0; i < data.size(); i++) {
+		data.write[i] = (i % 4096 < 2048) ? uint8_t(i * 2654435761u >> 24) : uint8_t(i / 7);
+	}
+
+	FileAccessCompressed *fac = memnew(FileAccessCompressed);
+	fac->configure("TEST", Compression::MODE_ZSTD, 4096);
+	REQUIRE(fac->_open(path, FileAccess::WRITE) == OK);
+	fac->store_buffer(data.ptr(), data.size());
+	fac->close();
+
+	REQUIRE(fac->_open(path, FileAccess::READ) == OK);
+	CHECK(fac->get_length() == (uint64_t)data.size());
+
+	// Mix reads inside a block, across block boundaries and spanning many blocks.
+	Vector<uint8_t> read;
+	read.resize(data.size());
+	uint64_t pos = 0;
+	const uint64_t lengths[] = { 10, 4086, 1, 4096 * 3, 5000, 4096 * 20 + 17 };
+	for (uint64_t length : lengths) {
+		CHECK(fac->get_buffer(read.ptrw() + pos, length) == length);
+		pos += length;
+		CHECK(fac->get_position() == pos);
+	}
+	CHECK(fac->get_buffer(read.ptrw() + pos, data.size() - pos) == data.size() - pos);
+	CHECK_FALSE(fac->eof_reached());
+	CHECK_MESSAGE(read == data, "The data read should match the data written.");
+
+	CHECK_MESSAGE(fac->get_buffer(read.ptrw(), 1) == 0, "Reading past the end should return nothing.");
+	CHECK(fac->eof_reached());
+
+	fac->seek(4096 * 2 + 5);
+	CHECK(fac->get_buffer(read.ptrw(), 4096 * 10) == 4096 * 10);
+	CHECK(memcmp(read.ptr(), data.ptr() + 4096 * 2 + 5, 4096 * 10) == 0);
+
+	fac->seek(data.size() - 100);
+	CHECK_MESSAGE(fac->get_buffer(read.ptrw(), 200) == 100, "Short reads should return the amount read.");
+	CHECK(fac->eof_reached());
+
+	fac->close();
+	memdelete(fac);
+}
+
+TEST_CASE("[FileAccess] Compression streams") {
+	Vector<uint8_t> data;
+	data.resize(100000);
+	for (int i = 0; i < data.size(); i++) {
+		data.write[i] = uint8_t((i / 13) ^ (i % 5));
+	}
+
+	const Compression::Mode modes[] = { Compression::MODE_DEFLATE, Compression::MODE_GZIP, Compression::MODE_ZSTD };
+	for (Compression::Mode mode : modes) {
+		Compression::Stream stream;
+		Vector<uint8_t> compressed;
+		REQUIRE(stream.start_compression(mode) == OK);
+		for (int i = 0; i < data.size(); i += 7000) {
+			CHECK(stream.process(data.ptr() + i, MIN(7000, data.size() - i), compressed) == OK);
+		}
+		CHECK(stream.finish(compressed) == OK);
+		CHECK(compressed.size() < data.size());
+
+		Vector<uint8_t> decompressed;
+		REQUIRE(stream.start_decompression(mode) == OK);
+		for (int i = 0; i < compressed.size(); i += 1000) {
+			CHECK(stream.process(compressed.ptr() + i, MIN(1000, compressed.size() - i), decompressed) == OK);
+		}
+		CHECK(stream.finish(decompressed) == OK);
+		CHECK_MESSAGE(decompressed == data, "Streamed data should survive the round trip.");
+
+		decompressed.clear();
+		REQUIRE(stream.start_decompression(mode) == OK);
+		stream.process(compressed.ptr(), compressed.size() / 2, decompressed);
+		ERR_PRINT_OFF;
+		CHECK_MESSAGE(stream.finish(decompressed) == ERR_FILE_CORRUPT, "Truncated data should be reported.");
+		ERR_PRINT_ON;
+	}
+}
+
+TEST_CASE("[FileAccess] Compression with dictionary") {
+	String sample = "{\"name\": \"enemy\", \"health\": 100, \"position\": [0, 0, 0], \"tags\": [\"hostile\", \"spawned\"]}";
+	CharString dictionary = (sample + sample.replace("enemy", "player").replace("hostile", "friendly")).utf8();
+	CharString message = sample.replace("100", "250").replace("enemy", "boss").utf8();
+
+	Vector<uint8_t> compressed;
+	compressed.resize(Compression::get_max_compressed_buffer_size(message.length(), Compression::MODE_ZSTD));
+	int size = Compression::compress_with_dictionary(compressed.ptrw(), (const uint8_t *)message.get_data(), message.length(), (const uint8_t *)dictionary.get_data(), dictionary.length());
+	REQUIRE(size > 0);
+
+	Vector<uint8_t> plain;
+	plain.resize(compressed.size());
+	int plain_size = Compression::compress(plain.ptrw(), (const uint8_t *)message.get_data(), message.length(), Compression::MODE_ZSTD);
+	CHECK_MESSAGE(size < plain_size, "Small similar content should compress better with a dictionary.");
+
+	Vector<uint8_t> decompressed;
+	decompressed.resize(message.length());
+	int decompressed_size = Compression::decompress_with_dictionary(decompressed.ptrw(), decompressed.size(), compressed.ptr(), size, (const uint8_t *)dictionary.get_data(), dictionary.length());
+	REQUIRE(decompressed_size == message.length());
+	CHECK(memcmp(decompressed.ptr(), message.get_data(), decompressed_size) == 0);
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
@@ -33,6 +33,7 @@
 
 #include "core/io/file_access_pack.h"
 #include "core/io/image.h"
+#include "core/io/image_decoder.h"
 #include "test_utils.h"
 
 #include "thirdparty/doctest/doctest.h"
@@ -148,6 +149,70 @@ TEST_CASE("[Image] Saving and loading") {
 			"The TGA image should load successfully.");
 }
 
+TEST_CASE("[Image] Loading files decodes them in place") {
+	// On desktop platforms, the loaders decode these straight from the file mapping.
+	const char *files[] = { "images/icon.jpg", "images/icon.webp", "images/icon.png" };
+	for (const char *file : files) {
+		const String path = TestUtils::get_data_path(file);
+
+		Ref<Image> image_file = memnew(Image());
+		CHECK_MESSAGE(
+				image_file->load(path) == OK,
+				"The image should load successfully from its file.");
+
+		Ref<Image> image_buffer = memnew(Image());
+		const Vector<uint8_t> data = FileAccess::get_file_as_array(path);
+		if (path.ends_with(".jpg")) {
+			image_buffer->load_jpg_from_buffer(data);
+		} else if (path.ends_with(".webp")) {
+			image_buffer->load_webp_from_buffer(data);
+		} else {
+			image_buffer->load_png_from_buffer(data);
+		}
+		CHECK_MESSAGE(
+				image_file->get_data() == image_buffer->get_data(),
+				"The image loaded from its file should match the one loaded from a buffer.");
+	}
+}
+
+TEST_CASE("[Image] Decoding on worker threads") {
+	Error err;
+	FileAccessRef f_png = FileAccess::open(TestUtils::get_data_path("images/icon.png"), FileAccess::READ, &err);
+	PackedByteArray data_png;
+	data_png.resize(f_png->get_length());
+	f_png->get_buffer(data_png.ptrw(), f_png->get_length());
+
+	Ref<Image> image_png = memnew(Image());
+	image_png->load_png_from_buffer(data_png);
+
+	Ref<ImageDecoder> decoder = memnew(ImageDecoder);
+	CHECK(decoder->decode_buffer(data_png) == OK);
+	CHECK_MESSAGE(
+			decoder->wait() == OK,
+			"The PNG image should be decoded successfully.");
+	CHECK_MESSAGE(
+			decoder->get_image()->get_data() == image_png->get_data(),
+			"The decoded image should match the one loaded on the calling thread.");
+
+	CHECK(decoder->decode_buffer(data_png, Image::FORMAT_RGBA8, true, 16) == OK);
+	Ref<Image> thumbnail = decoder->get_image();
+	CHECK_MESSAGE(
+			(thumbnail.is_valid() && thumbnail->get_format() == Image::FORMAT_RGBA8 && thumbnail->has_mipmaps()),
+			"The decoded image should be converted and have mipmaps.");
+	CHECK_MESSAGE(
+			(MAX(thumbnail->get_width(), thumbnail->get_height()) == 16),
+			"The decoded image should be shrunk to the requested size.");
+
+	PackedByteArray garbage;
+	garbage.resize(64);
+	garbage.fill(0);
+	CHECK(decoder->decode_buffer(garbage) == OK);
+	CHECK_MESSAGE(
+			decoder->wait() == ERR_FILE_UNRECOGNIZED,
+			"Unknown data should fail to decode.");
+	CHECK(decoder->get_image().is_null());
+}
+
 TEST_CASE("[Image] Basic getters") {
 	Ref<Image> image = memnew(Image(8, 4, false, Image::FORMAT_LA8));
 	CHECK(image->get_width() == 8);
@@ -146,6 +146,51 @@ TEST_CASE("[JSON] Parsing objects (dictionaries)") {
 			dictionary["empty_object"].hash() == Dictionary().hash(),
 			"The parsed JSON should contain the expected values.");
 }
+
+TEST_CASE("[JSON] Parsing UTF-8 buffers") {
+	JSON json;
+	const String text = String::utf8(R"({"name": "Gödot \u00e9\"ngine\"", "list": [1, -2.5, true, null], "π": "\\ü"})");
+
+	Error err = json.parse_utf8(text.to_utf8_buffer());
+	CHECK_MESSAGE(
+			err == OK,
+			"Parsing a UTF-8 JSON buffer should parse successfully.");
+	const Dictionary dictionary = json.get_data();
+
+	CHECK_MESSAGE(
+			dictionary["name"] == String::utf8("Gödot é\"ngine\""),
+			"Non-ASCII characters and escapes in UTF-8 buffers should be decoded.");
+	CHECK_MESSAGE(
+			dictionary[String::utf8("π")] == String::utf8("\\ü"),
+			"Non-ASCII keys in UTF-8 buffers should be decoded.");
+
+	json.parse(text);
+	CHECK_MESSAGE(
+			json.get_data().hash() == Variant(dictionary).hash(),
+			"Parsing from a String or from a UTF-8 buffer should give the same result.");
+
+	Vector<uint8_t> truncated = String(R"(["unterminated)").to_utf8_buffer();
+	CHECK_MESSAGE(
+			json.parse_utf8(truncated) == ERR_PARSE_ERROR,
+			"Parsing a truncated UTF-8 buffer should fail.");
+}
+
+TEST_CASE("[JSON] Stringify round trip") {
+	JSON json;
+	Dictionary dictionary;
+	Array array;
+	array.push_back("a");
+	array.push_back(String::utf8("ü\n"));
+	dictionary["array"] = array;
+	dictionary["number"] = 3.5;
+	dictionary["empty"] = Dictionary();
+
+	CHECK(json.stringify(dictionary) == String::utf8(R"({"array":["a","ü\n"],"empty":{},"number":3.5})"));
+	CHECK(json.stringify(array, "\t") == String::utf8("[\n\t\"a\",\n\t\"ü\\n\"\n]"));
+
+	CHECK(json.parse(json.stringify(dictionary, "  ")) == OK);
+	CHECK(json.get_data().hash() == Variant(dictionary).hash());
+}
 } // namespace TestJSON
 
 #endif // TEST_JSON_H
@@ -58,12 +58,15 @@
 #include "test_lru.h"
 #include "test_marshalls.h"
 #include "test_math.h"
+#include "test_message_queue.h"
 #include "test_method_bind.h"
+#include "test_node.h"
 #include "test_node_path.h"
 #include "test_oa_hash_map.h"
 #include "test_object.h"
 #include "test_ordered_hash_map.h"
 #include "test_paged_array.h"
+#include "test_parallel_algorithms.h"
 #include "test_path_3d.h"
 #include "test_pck_packer.h"
 #include "test_physics_2d.h"
@@ -72,6 +75,7 @@
 #include "test_rect2.h"
 #include "test_render.h"
 #include "test_resource.h"
+#include "test_rid.h"
 #include "test_shader_lang.h"
 #include "test_string.h"
 #include "test_text_server.h"
@@ -80,10 +84,17 @@
 #include "test_validate_testing.h"
 #include "test_variant.h"
 #include "test_vector.h"
+#include "test_worker_thread_pool.h"
 #include "test_xml_parser.h"
 
 #include "modules/modules_tests.gen.h"
 
+#ifdef BENCHMARKS_ENABLED
+#include "benchmarks/bench_string.h"
+#include "benchmarks/bench_templates.h"
+#include "benchmarks/bench_variant.h"
+#endif
+
 #include "tests/test_macros.h"
 
 int test_main(int argc, char *argv[]) {
@@ -97,8 +108,9 @@ int test_main(int argc, char *argv[]) {
 	}
 	OS::get_singleton()->set_cmdline("", args);
 
-	// Run custom test tools.
+	// Run custom test tools, they can report a failure through the exit code.
 	if (test_commands) {
+		OS::get_singleton()->set_exit_code(EXIT_SUCCESS);
 		for (Map<String, TestFunc>::Element *E = test_commands->front(); E; E = E->next()) {
 			if (args.find(E->key())) {
 				const TestFunc &test_func = E->get();
@@ -109,7 +121,7 @@ int test_main(int argc, char *argv[]) {
 		}
 		if (!run_tests) {
 			delete test_commands;
-			return 0;
+			return OS::get_singleton()->get_exit_code();
 		}
 	}
 	// Doctest runner.
@@ -324,6 +324,61 @@ TEST_CASE("[Marshalls] FLOAT double precision Variant decoding") {
 	CHECK(r_len == 12);
 	CHECK(variant == Variant(0.33333333333333333));
 }
+
+TEST_CASE("[Marshalls] Compact Variant encoding round trip") {
+	Vector<String> tags;
+	tags.push_back("a");
+	tags.push_back("b");
+	Vector<int32_t> ints;
+	ints.push_back(-1);
+	ints.push_back(0);
+	ints.push_back(INT32_MAX);
+	ints.push_back(INT32_MIN);
+	Vector<int64_t> longs;
+	longs.push_back(INT64_MIN);
+	longs.push_back(INT64_MAX);
+
+	Array records;
+	for (int i = 0; i < 100; i++) {
+		Dictionary record;
+		record["name"] = "enemy";
+		record["health"] = i * 1000 - 50000;
+		record["speed"] = 0.5 + i;
+		record["tags"] = tags;
+		records.push_back(record);
+	}
+	Dictionary mixed;
+	mixed[1] = Vector2(1, 2);
+	mixed[StringName("id")] = 0.33333333333333333;
+	mixed["nested"] = records[0];
+	records.push_back(mixed);
+	records.push_back(Variant());
+	records.push_back(true);
+	records.push_back(ints);
+	records.push_back(longs);
+
+	Vector<uint8_t> compact;
+	CHECK(encode_variant_compact(records, compact) == OK);
+
+	int regular_len;
+	CHECK(encode_variant(records, nullptr, regular_len) == OK);
+	CHECK_MESSAGE(compact.size() * 4 < regular_len, "Repetitive data should encode much smaller than with encode_variant().");
+
+	Variant decoded;
+	int r_len;
+	CHECK(decode_variant_compact(decoded, compact.ptr(), compact.size(), &r_len) == OK);
+	CHECK(r_len == compact.size());
+	CHECK(decoded.hash() == Variant(records).hash());
+	CHECK(Array(decoded)[103].get_type() == Variant::PACKED_INT32_ARRAY);
+
+	const Dictionary decoded_mixed = Array(decoded)[100];
+	CHECK(decoded_mixed.keys()[1].get_type() == Variant::STRING_NAME);
+	CHECK(decoded_mixed[1] == Variant(Vector2(1, 2)));
+
+	ERR_PRINT_OFF;
+	CHECK(decode_variant_compact(decoded, compact.ptr(), compact.size() / 2) != OK);
+	ERR_PRINT_ON;
+}
 } // namespace TestMarshalls
 
 #endif // TEST_MARSHALLS_H
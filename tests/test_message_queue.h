@@ -0,0 +1,119 @@
+/*************************************************************************/
+/*  test_message_queue.h                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_MESSAGE_QUEUE_H
+#define TEST_MESSAGE_QUEUE_H
+
+#include "core/object/message_queue.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMessageQueue {
+
+class CallRecorder : public Object {
+public:
+	LocalVector<int> calls;
+
+	void record(int p_value) {
+		calls.push_back(p_value);
+	}
+};
+
+TEST_CASE("[MessageQueue] Calls run in push order") {
+	CallRecorder *recorder = memnew(CallRecorder);
+	Callable callable = callable_mp(recorder, &CallRecorder::record);
+
+	MessageQueue::get_singleton()->push_callable(callable, 0);
+	MessageQueue::get_singleton()->push_callable(callable, 1);
+	MessageQueue::get_singleton()->flush();
+
+	REQUIRE(recorder->calls.size() == 2);
+	CHECK(recorder->calls[0] == 0);
+	CHECK(recorder->calls[1] == 1);
+
+	memdelete(recorder);
+}
+
+#if !defined(NO_THREADS)
+
+struct AlternatingPushState {
+	Callable callable;
+	Semaphore turn[2];
+	int pushes = 0;
+};
+
+template <int INDEX>
+static void alternating_push_thread(void *p_userdata) {
+	AlternatingPushState *state = (AlternatingPushState *)p_userdata;
+	for (int i = 0; i < state->pushes; i++) {
+		state->turn[INDEX].wait();
+		MessageQueue::get_singleton()->push_callable(state->callable, i * 2 + INDEX);
+		state->turn[1 - INDEX].post();
+	}
+}
+
+TEST_CASE("[MessageQueue] Calls pushed from several threads run in push order") {
+	CallRecorder *recorder = memnew(CallRecorder);
+
+	// Two threads take turns pushing, so each call is pushed after the previous one, from the other thread.
+	AlternatingPushState state;
+	state.callable = callable_mp(recorder, &CallRecorder::record);
+	state.pushes = 500;
+
+	Thread threads[2];
+	threads[0].start(&alternating_push_thread<0>, &state);
+	threads[1].start(&alternating_push_thread<1>, &state);
+	state.turn[0].post();
+	threads[0].wait_to_finish();
+	threads[1].wait_to_finish();
+
+	MessageQueue::get_singleton()->flush();
+
+	REQUIRE(recorder->calls.size() == uint32_t(state.pushes * 2));
+	bool in_order = true;
+	for (uint32_t i = 0; i < recorder->calls.size(); i++) {
+		if (recorder->calls[i] != int(i)) {
+			in_order = false;
+			break;
+		}
+	}
+	CHECK_MESSAGE(in_order, "Calls from both threads should run in the order they were pushed.");
+
+	memdelete(recorder);
+}
+
+#endif // NO_THREADS
+
+} // namespace TestMessageQueue
+
+#endif // TEST_MESSAGE_QUEUE_H
@@ -0,0 +1,79 @@
+/*************************************************************************/
+/*  test_node.h                                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_NODE_H
+#define TEST_NODE_H
+
+#include "scene/main/node.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNode {
+
+TEST_CASE("[Node] Repeated get_node() follows tree changes") {
+	Node *root = memnew(Node);
+	Node *child = memnew(Node);
+	child->set_name("Child");
+	root->add_child(child);
+	Node *grandchild = memnew(Node);
+	grandchild->set_name("Grandchild");
+	child->add_child(grandchild);
+
+	const NodePath path("Child/Grandchild");
+	CHECK(root->get_node_or_null(path) == grandchild);
+	CHECK_MESSAGE(root->get_node_or_null(path) == grandchild, "A cached lookup should find the same node.");
+
+	grandchild->set_name("Renamed");
+	CHECK_MESSAGE(root->get_node_or_null(path) == nullptr, "Renamed nodes should no longer be found by their old name.");
+	CHECK(root->get_node_or_null(NodePath("Child/Renamed")) == grandchild);
+
+	child->remove_child(grandchild);
+	root->add_child(grandchild);
+	CHECK_MESSAGE(root->get_node_or_null(NodePath("Child/Renamed")) == nullptr, "Moved nodes should no longer be found at their old path.");
+	CHECK(root->get_node_or_null(NodePath("Renamed")) == grandchild);
+
+	root->remove_child(grandchild);
+	memdelete(grandchild);
+	CHECK_MESSAGE(root->get_node_or_null(NodePath("Renamed")) == nullptr, "Freed nodes should not be returned.");
+
+	Node *replacement = memnew(Node);
+	replacement->set_name("Renamed");
+	root->add_child(replacement);
+	CHECK_MESSAGE(root->get_node_or_null(NodePath("Renamed")) == replacement, "A new node with the same name should be found.");
+
+	CHECK(replacement->get_node_or_null(NodePath("../Child")) == child);
+	CHECK(replacement->get_node_or_null(NodePath("../Child")) == child);
+
+	memdelete(root);
+}
+
+} // namespace TestNode
+
+#endif // TEST_NODE_H
@@ -273,6 +273,63 @@ TEST_CASE("[Object] Absent name getter") {
 			actual_value == Variant(),
 			"The returned value should equal nil variant.");
 }
+
+class _SignalReceiver : public Object {
+public:
+	int calls = 0;
+	Vector<Variant> last_args;
+
+	void receive_none() {
+		calls++;
+		last_args.clear();
+	}
+	void receive_one(int p_value) {
+		calls++;
+		last_args.clear();
+		last_args.push_back(p_value);
+	}
+	void receive_two(int p_value, const String &p_text) {
+		calls++;
+		last_args.clear();
+		last_args.push_back(p_value);
+		last_args.push_back(p_text);
+	}
+};
+
+TEST_CASE("[Object] Emitting signals with arguments from C++") {
+	Object object;
+	object.add_user_signal(MethodInfo("no_args"));
+	object.add_user_signal(MethodInfo("one_arg", PropertyInfo(Variant::INT, "value")));
+	object.add_user_signal(MethodInfo("two_args", PropertyInfo(Variant::INT, "value"), PropertyInfo(Variant::STRING, "text")));
+
+	_SignalReceiver receiver;
+	object.connect("no_args", callable_mp(&receiver, &_SignalReceiver::receive_none));
+	object.connect("one_arg", callable_mp(&receiver, &_SignalReceiver::receive_one));
+	object.connect("two_args", callable_mp(&receiver, &_SignalReceiver::receive_two));
+
+	CHECK(object.emit_signal("no_args") == OK);
+	CHECK(receiver.calls == 1);
+	CHECK(receiver.last_args.is_empty());
+
+	CHECK(object.emit_signal("one_arg", 42) == OK);
+	CHECK(receiver.calls == 2);
+	REQUIRE(receiver.last_args.size() == 1);
+	CHECK(receiver.last_args[0] == Variant(42));
+
+	CHECK(object.emit_signal("two_args", 7, "seven") == OK);
+	CHECK(receiver.calls == 3);
+	REQUIRE(receiver.last_args.size() == 2);
+	CHECK(receiver.last_args[0] == Variant(7));
+	CHECK(receiver.last_args[1] == Variant("seven"));
+
+	// Arguments given as an array of pointers go to the same emission.
+	Variant value = 3;
+	const Variant *argptrs[1] = { &value };
+	CHECK(object.emit_signal("one_arg", argptrs, 1) == OK);
+	CHECK(receiver.calls == 4);
+	REQUIRE(receiver.last_args.size() == 1);
+	CHECK(receiver.last_args[0] == Variant(3));
+}
 } // namespace TestObject
 
 #endif // TEST_OBJECT_H
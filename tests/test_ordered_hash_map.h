@@ -133,6 +133,35 @@ TEST_CASE("[OrderedHashMap] Const iteration") {
 		++idx;
 	}
 }
+
+TEST_CASE("[OrderedHashMap] Many insertions and erasures") {
+	OrderedHashMap<int, int> map;
+	for (int i = 0; i < 1000; i++) {
+		map.insert(i, i * 2);
+	}
+	// Erase every other element, so the index needs to shift probe sequences back.
+	for (int i = 0; i < 1000; i += 2) {
+		CHECK(map.erase(i));
+	}
+
+	CHECK(map.size() == 500);
+	for (int i = 0; i < 1000; i++) {
+		CHECK(map.has(i) == (i % 2 == 1));
+	}
+
+	int expected = 1;
+	for (OrderedHashMap<int, int>::Element E = map.front(); E; E = E.next()) {
+		CHECK(E.key() == expected);
+		CHECK(E.value() == expected * 2);
+		expected += 2;
+	}
+
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK(!map.has(1));
+	map.insert(1, 2);
+	CHECK(map[1] == 2);
+}
 } // namespace TestOrderedHashMap
 
 #endif // TEST_ORDERED_HASH_MAP_H
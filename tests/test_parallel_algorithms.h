@@ -0,0 +1,174 @@
+/*************************************************************************/
+/*  test_parallel_algorithms.h                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_PARALLEL_ALGORITHMS_H
+#define TEST_PARALLEL_ALGORITHMS_H
+
+#include "core/math/random_pcg.h"
+#include "core/templates/parallel_algorithms.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestParallelAlgorithms {
+
+// Large enough to be split in several chunks.
+static const uint32_t TEST_SIZE = 100003;
+
+struct KeyValue {
+	uint32_t key;
+	uint32_t index;
+};
+
+struct KeyValueComparator {
+	_FORCE_INLINE_ bool operator()(const KeyValue &p_a, const KeyValue &p_b) const {
+		return p_a.key < p_b.key;
+	}
+};
+
+struct KeyValueKey {
+	_FORCE_INLINE_ uint64_t operator()(const KeyValue &p_a) const {
+		return p_a.key;
+	}
+};
+
+static void fill_random(LocalVector<KeyValue> &r_array, uint32_t p_max_key) {
+	RandomPCG rng(1234);
+	r_array.resize(TEST_SIZE);
+	for (uint32_t i = 0; i < TEST_SIZE; i++) {
+		r_array[i].key = rng.rand() % p_max_key;
+		r_array[i].index = i;
+	}
+}
+
+static bool is_sorted_stable(const LocalVector<KeyValue> &p_array) {
+	for (uint32_t i = 1; i < p_array.size(); i++) {
+		if (p_array[i - 1].key > p_array[i].key) {
+			return false;
+		}
+		if (p_array[i - 1].key == p_array[i].key && p_array[i - 1].index > p_array[i].index) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[ParallelAlgorithms] Parallel sort") {
+	LocalVector<KeyValue> array;
+	fill_random(array, 1000);
+
+	ParallelSortArray<KeyValue, KeyValueComparator> sorter;
+	sorter.sort(array.ptr(), array.size());
+
+	CHECK(array.size() == TEST_SIZE);
+	bool sorted = true;
+	for (uint32_t i = 1; i < array.size(); i++) {
+		sorted = sorted && array[i - 1].key <= array[i].key;
+	}
+	CHECK_MESSAGE(sorted, "Elements should be in ascending order.");
+
+	LocalVector<int> small;
+	small.push_back(3);
+	small.push_back(1);
+	small.push_back(2);
+	ParallelSortArray<int> small_sorter;
+	small_sorter.sort(small.ptr(), small.size());
+	CHECK(small[0] == 1);
+	CHECK(small[1] == 2);
+	CHECK(small[2] == 3);
+}
+
+TEST_CASE("[ParallelAlgorithms] Parallel radix sort") {
+	LocalVector<KeyValue> array;
+	fill_random(array, 1 << 20);
+
+	ParallelRadixSort<KeyValue, KeyValueKey> sorter;
+	sorter.sort(array.ptr(), array.size());
+
+	CHECK(array.size() == TEST_SIZE);
+	CHECK_MESSAGE(is_sorted_stable(array), "Elements should be in ascending order, keeping the order of equal keys.");
+
+	// Few distinct keys, most passes are skipped.
+	fill_random(array, 4);
+	sorter.sort(array.ptr(), array.size());
+	CHECK_MESSAGE(is_sorted_stable(array), "Elements should be in ascending order, keeping the order of equal keys.");
+}
+
+TEST_CASE("[ParallelAlgorithms] Prefix sum and reduce") {
+	LocalVector<uint32_t> values;
+	values.resize(TEST_SIZE);
+	for (uint32_t i = 0; i < TEST_SIZE; i++) {
+		values[i] = i % 7;
+	}
+
+	LocalVector<uint32_t> sums;
+	sums.resize(TEST_SIZE);
+	uint32_t total = parallel_prefix_sum(values.ptr(), sums.ptr(), TEST_SIZE);
+
+	uint32_t expected = 0;
+	bool sums_match = true;
+	for (uint32_t i = 0; i < TEST_SIZE; i++) {
+		sums_match = sums_match && sums[i] == expected;
+		expected += values[i];
+	}
+	CHECK_MESSAGE(sums_match, "Every element should hold the sum of the elements before it.");
+	CHECK(total == expected);
+
+	uint32_t maximum = parallel_reduce(values.ptr(), TEST_SIZE, 0u, [](uint32_t p_a, uint32_t p_b) { return MAX(p_a, p_b); });
+	CHECK(maximum == 6);
+
+	// In place.
+	total = parallel_prefix_sum(values.ptr(), values.ptr(), TEST_SIZE);
+	CHECK(total == expected);
+	CHECK(values[TEST_SIZE - 1] == sums[TEST_SIZE - 1]);
+}
+
+TEST_CASE("[ParallelAlgorithms] Stable partition") {
+	LocalVector<uint32_t> values;
+	values.resize(TEST_SIZE);
+	for (uint32_t i = 0; i < TEST_SIZE; i++) {
+		values[i] = i;
+	}
+
+	uint32_t count = parallel_partition(values.ptr(), TEST_SIZE, [](uint32_t p_value) { return p_value % 3 == 0; });
+	CHECK(count == (TEST_SIZE + 2) / 3);
+
+	bool partitioned = true;
+	for (uint32_t i = 0; i < TEST_SIZE; i++) {
+		partitioned = partitioned && (values[i] % 3 == 0) == (i < count);
+		if (i > 0 && i != count) {
+			partitioned = partitioned && values[i - 1] < values[i];
+		}
+	}
+	CHECK_MESSAGE(partitioned, "Matching elements should come first, both groups keeping their order.");
+}
+
+} // namespace TestParallelAlgorithms
+
+#endif // TEST_PARALLEL_ALGORITHMS_H
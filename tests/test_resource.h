@@ -32,6 +32,7 @@
 #define TEST_RESOURCE
 
 #include "core/io/resource.h"
+#include "core/io/resource_format_binary.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/os/os.h"
@@ -109,6 +110,38 @@ TEST_CASE("[Resource] Saving and loading") {
 			loaded_child_resource_text->get_name() == "I'm a child resource",
 			"The loaded child resource name should be equal to the expected value.");
 }
+
+TEST_CASE("[Resource] Loading a single binary sub-resource") {
+	Ref<Resource> resource = memnew(Resource);
+	Ref<Resource> child_resource = memnew(Resource);
+	child_resource->set_name("I'm a child resource");
+	Ref<Resource> grandchild_resource = memnew(Resource);
+	grandchild_resource->set_name("I'm a grandchild resource");
+	child_resource->set_meta("other_resource", grandchild_resource);
+	Ref<Resource> unrelated_resource = memnew(Resource);
+	resource->set_meta("child", child_resource);
+	resource->set_meta("unrelated", unrelated_resource);
+	const String save_path_binary = OS::get_singleton()->get_cache_path().plus_file("sub_resource.res");
+	ResourceSaver::save(save_path_binary, resource);
+
+	Error err;
+	Ref<Resource> loaded_child = ResourceFormatLoaderBinary::load_sub_resource(save_path_binary, child_resource->get_scene_unique_id(), &err, ResourceFormatLoader::CACHE_MODE_IGNORE);
+	CHECK(err == OK);
+	REQUIRE(loaded_child.is_valid());
+	CHECK_MESSAGE(
+			loaded_child->get_name() == "I'm a child resource",
+			"The loaded sub-resource name should be equal to the expected value.");
+	const Ref<Resource> &loaded_grandchild = loaded_child->get_meta("other_resource");
+	REQUIRE(loaded_grandchild.is_valid());
+	CHECK_MESSAGE(
+			loaded_grandchild->get_name() == "I'm a grandchild resource",
+			"Resources referenced by the sub-resource should be loaded along with it.");
+
+	ERR_PRINT_OFF;
+	CHECK(ResourceFormatLoaderBinary::load_sub_resource(save_path_binary, "missing", &err, ResourceFormatLoader::CACHE_MODE_IGNORE).is_null());
+	ERR_PRINT_ON;
+	CHECK(err == ERR_DOES_NOT_EXIST);
+}
 } // namespace TestResource
 
 #endif // TEST_RESOURCE
@@ -0,0 +1,122 @@
+/*************************************************************************/
+/*  test_rid.h                                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_RID_H
+#define TEST_RID_H
+
+#include "core/os/thread.h"
+#include "core/templates/rid_owner.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestRID {
+
+TEST_CASE("[RID_Owner] Make, lookup and free") {
+	RID_Owner<int> owner;
+	RID rid = owner.make_rid(5);
+
+	CHECK(owner.owns(rid));
+	CHECK(owner.get_rid_count() == 1);
+	int *value = owner.get_or_null(rid);
+	REQUIRE(value != nullptr);
+	CHECK(*value == 5);
+
+	owner.free(rid);
+	CHECK_FALSE(owner.owns(rid));
+	CHECK(owner.get_or_null(rid) == nullptr);
+	CHECK(owner.get_rid_count() == 0);
+}
+
+#if !defined(NO_THREADS)
+
+struct ThreadedAllocState {
+	RID_Owner<uint64_t, true> owner;
+	SafeNumeric<uint32_t> errors;
+
+	// Small chunks, so threads grow the tables concurrently.
+	ThreadedAllocState() :
+			owner(256) {}
+
+	static void thread_func(void *p_userdata) {
+		ThreadedAllocState *state = (ThreadedAllocState *)p_userdata;
+		RID rids[500];
+		for (int round = 0; round < 4; round++) {
+			for (uint64_t i = 0; i < 500; i++) {
+				rids[i] = state->owner.make_rid(i);
+			}
+			for (uint64_t i = 0; i < 500; i++) {
+				uint64_t *value = state->owner.get_or_null(rids[i]);
+				if (!value || *value != i) {
+					state->errors.increment();
+				}
+			}
+			for (uint64_t i = 0; i < 500; i++) {
+				state->owner.free(rids[i]);
+			}
+		}
+	}
+};
+
+TEST_CASE("[RID_Owner] Thread safe allocation from several threads") {
+	ThreadedAllocState state;
+	Thread threads[8];
+	for (int i = 0; i < 8; i++) {
+		threads[i].start(&ThreadedAllocState::thread_func, &state);
+	}
+	for (int i = 0; i < 8; i++) {
+		threads[i].wait_to_finish();
+	}
+
+	CHECK_MESSAGE(state.errors.get() == 0, "Every thread should read back the values it stored.");
+	CHECK_MESSAGE(state.owner.get_rid_count() == 0, "Every RID should have been freed.");
+
+	RID rid = state.owner.make_rid(7);
+	CHECK(state.owner.get_rid_count() == 1);
+	CHECK(state.owner.get_rid_by_index(0) == rid);
+	CHECK(*state.owner.get_ptr_by_index(0) == 7);
+
+	RID uninitialized = state.owner.allocate_rid();
+	int visited = 0;
+	state.owner.for_each_owned([&visited](uint64_t *p_value) {
+		CHECK(*p_value == 7);
+		visited++;
+	});
+	CHECK_MESSAGE(visited == 1, "Only initialized elements should be visited.");
+
+	state.owner.initialize_rid(uninitialized, 7);
+	state.owner.free(uninitialized);
+	state.owner.free(rid);
+}
+
+#endif // NO_THREADS
+
+} // namespace TestRID
+
+#endif // TEST_RID_H
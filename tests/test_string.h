@@ -1186,6 +1186,21 @@ TEST_CASE("[String] hash") {
 
 	CHECK(a.hash64() == b.hash64());
 	CHECK(a.hash64() != c.hash64());
+
+	// All overloads must agree, StringName relies on it to look up C strings.
+	const char *cstr = "res://some/longer/resource_path.tscn";
+	String d = cstr;
+	CHECK(d.hash() == String::hash(cstr));
+	CHECK(d.hash() == String::hash(cstr, strlen(cstr)));
+	CHECK(d.hash() == String::hash(d.get_data()));
+	CHECK(d.hash() == String::hash(d.get_data(), d.length()));
+	CHECK(d.hash() == hash_djb2(cstr));
+
+	uint32_t djb2 = 5381;
+	for (int i = 0; i < d.length(); i++) {
+		djb2 = ((djb2 << 5) + djb2) + d[i];
+	}
+	CHECK(d.hash() == djb2);
 }
 
 TEST_CASE("[String] uri_encode/unescape") {
@@ -149,6 +149,44 @@ TEST_CASE("[OptimizedTranslation] Generate from Translation and read messages")
 	CHECK(messages.size() == 0);
 }
 
+TEST_CASE("[TranslationServer] Cached lookups follow translation changes") {
+	TranslationServer *ts = TranslationServer::get_singleton();
+	String previous_locale = ts->get_locale();
+
+	Ref<Translation> french = memnew(Translation);
+	french->set_locale("fr");
+	french->add_message("Hello", "Bonjour");
+	french->add_message("Goodbye", "Au revoir");
+	Ref<Translation> canadian_french = memnew(Translation);
+	canadian_french->set_locale("fr_CA");
+	canadian_french->add_message("Hello", "Allo");
+	ts->add_translation(french);
+	ts->add_translation(canadian_french);
+
+	ts->set_locale("fr_CA");
+	// Exact locale matches win, near matches fill the gaps.
+	CHECK(ts->translate("Hello") == "Allo");
+	CHECK(ts->translate("Goodbye") == "Au revoir");
+	CHECK(ts->translate("Missing") == "Missing");
+
+	canadian_french->add_message("Goodbye", "Bye");
+	canadian_french->add_message("Missing", "Manquant");
+	CHECK(ts->translate("Goodbye") == "Bye");
+	CHECK(ts->translate("Missing") == "Manquant");
+
+	ts->set_locale("fr");
+	CHECK(ts->translate("Hello") == "Bonjour");
+	CHECK(ts->translate("Goodbye") == "Au revoir");
+
+	ts->remove_translation(french);
+	CHECK(ts->translate("Hello") == "Allo");
+
+	ts->remove_translation(canadian_french);
+	CHECK(ts->translate("Hello") == "Hello");
+
+	ts->set_locale(previous_locale);
+}
+
 #ifdef TOOLS_ENABLED
 TEST_CASE("[Translation] CSV import") {
 	Ref<ResourceImporterCSVTranslation> import_csv_translation = memnew(ResourceImporterCSVTranslation);
@@ -700,6 +700,28 @@ TEST_CASE("[Variant] Assignment To Color from Bool,Int,Float,String,Vec2,Vec2i,V
 	vec3i_v = col_v;
 	CHECK(vec3i_v.get_type() == Variant::COLOR);
 }
+
+TEST_CASE("[Variant] Moving packed arrays") {
+	PackedByteArray bytes;
+	bytes.push_back(1);
+	bytes.push_back(2);
+	const uint8_t *data = bytes.ptr();
+
+	Variant packed = std::move(bytes);
+	CHECK(bytes.is_empty());
+	CHECK(packed.get_type() == Variant::PACKED_BYTE_ARRAY);
+
+	Variant moved = std::move(packed);
+	CHECK(packed.get_type() == Variant::NIL);
+	PackedByteArray result = moved;
+	CHECK(result.size() == 2);
+	CHECK(result.ptr() == data);
+
+	Variant assigned = "replaced";
+	assigned = std::move(moved);
+	CHECK(moved.get_type() == Variant::NIL);
+	CHECK(assigned.get_type() == Variant::PACKED_BYTE_ARRAY);
+}
 } // namespace TestVariant
 
 #endif // TEST_VARIANT_H
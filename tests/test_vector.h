@@ -504,6 +504,28 @@ TEST_CASE("[Vector] Operators") {
 	CHECK(vector != vector_other);
 }
 
+TEST_CASE("[Vector] Move") {
+	Vector<int> vector;
+	vector.push_back(2);
+	vector.push_back(8);
+	const int *data = vector.ptr();
+
+	Vector<int> moved = std::move(vector);
+	CHECK(vector.is_empty());
+	CHECK(moved.size() == 2);
+	// Moving hands the buffer over instead of sharing it, so writing doesn't copy.
+	CHECK(moved.ptrw_unique() == data);
+	CHECK(moved.ptrw() == data);
+
+	Vector<int> assigned;
+	assigned.push_back(1);
+	assigned = std::move(moved);
+	CHECK(moved.is_empty());
+	CHECK(assigned.size() == 2);
+	CHECK(assigned[1] == 8);
+	CHECK(assigned.ptr() == data);
+}
+
 } // namespace TestVector
 
 #endif // TEST_VECTOR_H
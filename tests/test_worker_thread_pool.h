@@ -0,0 +1,137 @@
+/*************************************************************************/
+/*  test_worker_thread_pool.h                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2021 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2021 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_WORKER_THREAD_POOL_H
+#define TEST_WORKER_THREAD_POOL_H
+
+#include "core/os/worker_thread_pool.h"
+#include "core/templates/thread_work_pool.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestWorkerThreadPool {
+
+struct Counter {
+	SafeNumeric<uint32_t> calls;
+	uint32_t values[256] = {};
+	uint32_t chain = 0;
+
+	void add_indexed(uint32_t p_index, uint32_t p_amount) {
+		values[p_index] += p_amount;
+		calls.increment();
+	}
+	void add_nested(uint32_t p_amount) {
+		// Nested submission from inside a task must not deadlock.
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Counter::add_indexed, p_amount, 256);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+	void chain_step(uint32_t p_digit) {
+		chain = chain * 10 + p_digit;
+	}
+};
+
+TEST_CASE("[WorkerThreadPool] Group task processes every element once") {
+	Counter counter;
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&counter, &Counter::add_indexed, 1u, 256);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	CHECK_MESSAGE(counter.calls.get() == 256, "All elements should have been processed.");
+	bool all_once = true;
+	for (uint32_t i = 0; i < 256; i++) {
+		all_once = all_once && counter.values[i] == 1;
+	}
+	CHECK_MESSAGE(all_once, "Every element should have been processed exactly once.");
+}
+
+TEST_CASE("[WorkerThreadPool] Nested submission") {
+	Counter counter;
+	WorkerThreadPool::TaskID tasks[4];
+	for (uint32_t i = 0; i < 4; i++) {
+		tasks[i] = WorkerThreadPool::get_singleton()->add_template_task(&counter, &Counter::add_nested, 1u);
+	}
+	for (uint32_t i = 0; i < 4; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+	}
+
+	CHECK_MESSAGE(counter.calls.get() == 4 * 256, "All nested elements should have been processed.");
+}
+
+TEST_CASE("[WorkerThreadPool] Task dependencies are respected") {
+	Counter counter;
+	WorkerThreadPool::TaskID tasks[5];
+	tasks[0] = WorkerThreadPool::get_singleton()->add_template_task(&counter, &Counter::chain_step, 1u);
+	for (uint32_t i = 1; i < 5; i++) {
+		tasks[i] = WorkerThreadPool::get_singleton()->add_template_task(&counter, &Counter::chain_step, i + 1, &tasks[i - 1], 1);
+	}
+	for (int i = 4; i >= 0; i--) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+	}
+
+	CHECK_MESSAGE(counter.chain == 12345, "Dependent tasks should run in dependency order.");
+}
+
+TEST_CASE("[ThreadWorkPool] Compatibility layer") {
+	Counter counter;
+	ThreadWorkPool pool;
+	pool.init();
+	CHECK(pool.get_thread_count() >= 1);
+
+	pool.begin_work(256, &counter, &Counter::add_indexed, 2u);
+	CHECK(pool.is_working());
+	pool.end_work();
+	CHECK_FALSE(pool.is_working());
+
+	CHECK_MESSAGE(counter.calls.get() == 256, "All elements should have been processed.");
+	CHECK_MESSAGE(counter.values[255] == 2, "Userdata should be passed to every call.");
+	pool.finish();
+}
+
+TEST_CASE("[ThreadWorkPool] Batched work processes every element once") {
+	ThreadWorkPool pool;
+	pool.init();
+
+	// Run a few times so both the unmeasured and the measured paths are exercised.
+	for (int run = 0; run < 4; run++) {
+		Counter counter;
+		pool.do_work_batched(256, &counter, &Counter::add_indexed, 1u);
+
+		CHECK_MESSAGE(counter.calls.get() == 256, "All elements should have been processed.");
+		bool all_once = true;
+		for (uint32_t i = 0; i < 256; i++) {
+			all_once = all_once && counter.values[i] == 1;
+		}
+		CHECK_MESSAGE(all_once, "Every element should have been processed exactly once.");
+	}
+	pool.finish();
+}
+
+} // namespace TestWorkerThreadPool
+
+#endif // TEST_WORKER_THREAD_POOL_H
@@ -65,10 +65,20 @@ class ENetUDP : public ENetGodotSocket {
 	friend class ENetDTLSServer;
 
 private:
+	enum {
+		RECV_BATCH_SIZE = 16,
+	};
+
 	Ref<NetSocket> sock;
 	IPAddress local_address;
 	bool bound = false;
 
+	// Datagrams are received in batches, and handed to ENet one at a time.
+	uint8_t recv_buffer[RECV_BATCH_SIZE * ENET_PROTOCOL_MAXIMUM_MTU];
+	NetSocket::Datagram recv_datagrams[RECV_BATCH_SIZE];
+	int recv_count = 0;
+	int recv_next = 0;
+
 public:
 	ENetUDP() {
 		sock = Ref<NetSocket>(NetSocket::create());
@@ -103,11 +113,28 @@ public:
 	}
 
 	Error recvfrom(uint8_t *p_buffer, int p_len, int &r_read, IPAddress &r_ip, uint16_t &r_port) {
-		Error err = sock->poll(NetSocket::POLL_TYPE_IN, 0);
-		if (err != OK) {
-			return err;
+		if (recv_next == recv_count) {
+			Error err = sock->poll(NetSocket::POLL_TYPE_IN, 0);
+			if (err != OK) {
+				return err;
+			}
+			for (int i = 0; i < RECV_BATCH_SIZE; i++) {
+				recv_datagrams[i].buffer = &recv_buffer[i * ENET_PROTOCOL_MAXIMUM_MTU];
+				recv_datagrams[i].length = ENET_PROTOCOL_MAXIMUM_MTU;
+			}
+			recv_next = 0;
+			err = sock->recvfrom_batch(recv_datagrams, RECV_BATCH_SIZE, recv_count);
+			if (err != OK) {
+				recv_count = 0;
+				return err;
+			}
 		}
-		return sock->recvfrom(p_buffer, p_len, r_read, r_ip, r_port);
+		const NetSocket::Datagram &datagram = recv_datagrams[recv_next++];
+		r_read = MIN(datagram.length, p_len);
+		memcpy(p_buffer, datagram.buffer, r_read);
+		r_ip = datagram.ip;
+		r_port = datagram.port;
+		return OK;
 	}
 
 	int set_option(ENetSocketOption p_option, int p_value) {
@@ -155,6 +182,8 @@ public:
 	void close() {
 		sock->close();
 		local_address.clear();
+		recv_count = 0;
+		recv_next = 0;
 	}
 };
 
@@ -491,17 +520,15 @@ int enet_socket_send(ENetSocket socket, const ENetAddress *address, const ENetBu
 
 	dest.set_ipv6(address->host);
 
-	// Create a single packet.
-	Vector<uint8_t> out;
-	uint8_t *w;
+	// Create a single packet, ENet never sends more than ENET_PROTOCOL_MAXIMUM_MTU at once.
+	uint8_t w[ENET_PROTOCOL_MAXIMUM_MTU];
 	int size = 0;
 	int pos = 0;
 	for (i = 0; i < bufferCount; i++) {
 		size += buffers[i].dataLength;
 	}
+	ERR_FAIL_COND_V(size > ENET_PROTOCOL_MAXIMUM_MTU, -1);
 
-	out.resize(size);
-	w = out.ptrw();
 	for (i = 0; i < bufferCount; i++) {
 		memcpy(&w[pos], buffers[i].data, buffers[i].dataLength);
 		pos += buffers[i].dataLength;